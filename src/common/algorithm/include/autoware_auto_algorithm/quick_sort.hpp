@@ -12,11 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 /// \file
-/// \brief This file provides an iterative quick sort implementation.
+/// \brief This file provides an iterative introsort implementation.
 #ifndef AUTOWARE_AUTO_ALGORITHM__QUICK_SORT_HPP_
 #define AUTOWARE_AUTO_ALGORITHM__QUICK_SORT_HPP_
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -30,11 +31,19 @@ namespace common
 namespace algorithm
 {
 
-/// \brief Iterative quick sort implementation based on a stack.
+/// \brief Iterative introsort implementation based on a stack.
+/// \details The pivot is the median of the first, middle and last elements, ranges of at most
+/// INSERTION_SORT_THRESHOLD elements are finished by insertion sort and a range that is still
+/// unsorted after 2 * log2(n) partitions is heap sorted, so the sort is O(n log n) in the worst
+/// case. The smaller part of a partition is sorted first, which bounds the stack to log2(n) + 1
+/// ranges, and no step recurses.
 template<typename Container, typename RandomIt = typename Container::iterator>
 class QuickSorter
 {
 public:
+  /// \brief Ranges of at most this many elements are sorted by insertion sort
+  static constexpr ::std::ptrdiff_t INSERTION_SORT_THRESHOLD = 16;
+
   QuickSorter(QuickSorter const &) = delete;
   QuickSorter & operator=(QuickSorter const &) = delete;
   QuickSorter(QuickSorter &&) = default;
@@ -51,7 +60,7 @@ public:
     reserve(capacity);
   }
 
-  /// \brief Iterative quick sort implementation using a stack, sorts
+  /// \brief Iterative introsort implementation using a stack, sorts
   /// range [first, last) using the given comparison function
   /// \param[in] first Start of the range to sort
   /// \param[in] last End of the range to sort (not included)
@@ -59,40 +68,13 @@ public:
   template<typename Compare>
   void sort(RandomIt first, RandomIt last, Compare comp) const
   {
-    if (::std::distance(first, last) < 2) {
-      return;
-    }
-
     // Make sure we do not accidently have an already partially filled stack,
     // capacity does not change
     m_stack.clear();
-
-    // Add first interval to the stack for sorting, from here on last is really
-    // the last element and not the element after, i.e. not end
-    m_stack.push_back(first);
-    m_stack.push_back(last - 1);
-
-    while (!m_stack.empty()) {
-      last = m_stack.back();
-      m_stack.pop_back();
-      first = m_stack.back();
-      m_stack.pop_back();
-
-      auto part = QuickSorter::partition(first, last, comp);
-
-      if (part > first + 1) {
-        m_stack.push_back(first);
-        m_stack.push_back(part - 1);
-      }
-
-      if (part < last - 1) {
-        m_stack.push_back(part + 1);
-        m_stack.push_back(last);
-      }
-    }
+    QuickSorter::sort_range(Range{first, last, depth_limit(last - first)}, comp, m_stack);
   }
 
-  /// \brief Iterative quick sort implementation using a stack, sorts
+  /// \brief Iterative introsort implementation using a stack, sorts
   /// range [first, last) using the default less operation
   /// \param[in] first Start of the range to sort
   /// \param[in] last End of the range to sort (not included)
@@ -101,15 +83,14 @@ public:
     sort(first, last, ::std::less<const decltype(*first)>());
   }
 
-  /// \brief Reserves helper stack capacity for the iterative quick sort
+  /// \brief Reserves helper stack capacity for the iterative introsort
   /// algorithm based on the capacity of the container to be sorted such that
   /// no heap allocation is done during the algorithm.
   /// \param[in] capacity - The maximum capacity of the container to be sorted
   void reserve(::std::size_t capacity)
   {
-    // The maximum partition depth is n/2 + 1, which means we need a maximum
-    // capacity of n + 2 to hold store the iterators in the stack.
-    m_stack.reserve(capacity + 2);
+    m_capacity = ::std::max(m_capacity, capacity);
+    m_stack.reserve(stack_size(m_capacity));
   }
 
   /// \brief Returns the maximum capacity that is allowed for a container to be
@@ -118,13 +99,122 @@ public:
   /// using this sorter.
   ::std::size_t capacity() const
   {
-    if (m_stack.capacity() < 2) {
-      return 0;
-    }
-    return m_stack.capacity() - 2;
+    return m_capacity;
   }
 
 private:
+  /// \brief A range [first, last) to sort, and the number of partitions it may still take
+  struct Range
+  {
+    RandomIt first;
+    RandomIt last;
+    ::std::size_t depth;
+  };
+
+  /// \brief Floor of the base 2 logarithm of a size, 0 for sizes below 2
+  static ::std::size_t floor_log2(::std::size_t size)
+  {
+    ::std::size_t result = 0U;
+    while (size > 1U) {
+      size >>= 1U;
+      ++result;
+    }
+    return result;
+  }
+
+  /// \brief The number of partitions after which a range of the given size is heap sorted
+  static ::std::size_t depth_limit(const ::std::ptrdiff_t size)
+  {
+    return 2U * floor_log2(static_cast<::std::size_t>(::std::max(size, ::std::ptrdiff_t{0})));
+  }
+
+  /// \brief The maximum number of stacked ranges when sorting a container of the given capacity
+  static ::std::size_t stack_size(const ::std::size_t capacity)
+  {
+    return floor_log2(capacity) + 2U;
+  }
+
+  /// \brief Sort a range with an introsort on the given helper stack
+  /// \param[in] initial The range to sort
+  /// \param[in] comp Element comparison function
+  /// \param[in] stack The helper stack, which is empty before and after the sort
+  template<typename Compare>
+  static void sort_range(const Range initial, Compare comp, ::std::vector<Range> & stack)
+  {
+    if ((initial.last - initial.first) < 2) {
+      return;
+    }
+    stack.push_back(initial);
+
+    while (!stack.empty()) {
+      Range range = stack.back();
+      stack.pop_back();
+
+      // Keep partitioning the smaller part and defer the larger one
+      while ((range.last - range.first) > INSERTION_SORT_THRESHOLD) {
+        if (range.depth == 0U) {
+          // Too many unbalanced partitions: fall back to a heap sort, which does not recurse
+          ::std::make_heap(range.first, range.last, comp);
+          ::std::sort_heap(range.first, range.last, comp);
+          range.last = range.first;
+          break;
+        }
+        --range.depth;
+        QuickSorter::move_median_to_last(range.first, range.last - 1, comp);
+        const auto part = QuickSorter::partition(range.first, range.last - 1, comp);
+        if ((part - range.first) < (range.last - part)) {
+          stack.push_back(Range{part + 1, range.last, range.depth});
+          range.last = part;
+        } else {
+          stack.push_back(Range{range.first, part, range.depth});
+          range.first = part + 1;
+        }
+      }
+      QuickSorter::insertion_sort(range.first, range.last, comp);
+    }
+  }
+
+  /// \brief Sort a small range [first, last) by insertion
+  /// \param[in] first Start of the range to sort
+  /// \param[in] last End of the range to sort (not included)
+  /// \param[in] comp Element comparison function
+  template<typename Compare>
+  static void insertion_sort(RandomIt first, RandomIt last, Compare comp)
+  {
+    if ((last - first) < 2) {
+      return;
+    }
+    for (auto it = first + 1; it < last; ++it) {
+      auto value = ::std::move(*it);
+      auto hole = it;
+      for (; (hole > first) && comp(value, *(hole - 1)); --hole) {
+        *hole = ::std::move(*(hole - 1));
+      }
+      *hole = ::std::move(value);
+    }
+  }
+
+  /// \brief Move the median of the first, middle and last elements of [first, last] to last,
+  /// which guards the partition against sorted and reverse sorted ranges
+  /// \param[in] first Start of the range
+  /// \param[in] last End (included) of the range
+  /// \param[in] comp Element comparison function
+  template<typename Compare>
+  static void move_median_to_last(RandomIt first, RandomIt last, Compare comp)
+  {
+    const auto middle = first + ((last - first) / 2);
+    if (comp(*middle, *first)) {
+      ::std::iter_swap(middle, first);
+    }
+    if (comp(*last, *first)) {
+      ::std::iter_swap(last, first);
+    }
+    // *first is now the smallest of the three, the median is the smaller of the others
+    if (comp(*middle, *last)) {
+      ::std::iter_swap(middle, last);
+    }
+  }
+
   /// \brief Partition range [first, last], based on pivot element last. After
   /// execution all elements smaller than the pivot element are left of it and
   /// all bigger elements right of it.
@@ -152,8 +242,10 @@ private:
   }
 
 private:
-  /// Helper stack used for sorting, needs to have capacity (last-first)+2
-  mutable ::std::vector<RandomIt> m_stack;
+  /// The maximum size of a range that can be sorted without allocation
+  ::std::size_t m_capacity{0U};
+  /// Helper stack used for sorting, needs to have capacity log2(last-first)+2
+  mutable ::std::vector<Range> m_stack;
 };
 
 }  // namespace algorithm
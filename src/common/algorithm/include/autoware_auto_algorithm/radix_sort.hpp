@@ -0,0 +1,235 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// \file
+/// \brief This file provides a radix sort for integer and floating point keys.
+#ifndef AUTOWARE_AUTO_ALGORITHM__RADIX_SORT_HPP_
+#define AUTOWARE_AUTO_ALGORITHM__RADIX_SORT_HPP_
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace autoware
+{
+
+namespace common
+{
+
+namespace algorithm
+{
+
+/// \brief Map an unsigned integer key to its radix key, which is the key itself
+/// \param[in] key The key
+/// \return An unsigned integer ordered as the key
+template<typename KeyT>
+typename ::std::enable_if<::std::is_integral<KeyT>::value && ::std::is_unsigned<KeyT>::value,
+  KeyT>::type to_radix_key(const KeyT key)
+{
+  return key;
+}
+
+/// \brief Map a signed integer key to its radix key by flipping the sign bit
+/// \param[in] key The key
+/// \return An unsigned integer ordered as the key
+template<typename KeyT>
+typename ::std::enable_if<::std::is_integral<KeyT>::value && ::std::is_signed<KeyT>::value,
+  typename ::std::make_unsigned<KeyT>::type>::type to_radix_key(const KeyT key)
+{
+  using UnsignedT = typename ::std::make_unsigned<KeyT>::type;
+  constexpr UnsignedT sign_bit =
+    static_cast<UnsignedT>(UnsignedT{1U} << ((sizeof(KeyT) * 8U) - 1U));
+  return static_cast<UnsignedT>(static_cast<UnsignedT>(key) ^ sign_bit);
+}
+
+/// \brief Map a floating point key to its radix key: the bits of negative numbers are flipped
+/// so that they are ordered downwards, the sign bit of the others is set
+/// \param[in] key The key, -0 is ordered before +0 and NaNs are ordered by their bits
+/// \return An unsigned integer ordered as the key
+inline uint32_t to_radix_key(const float key)
+{
+  static_assert(sizeof(float) == sizeof(uint32_t), "Unexpected float size");
+  uint32_t bits;
+  ::std::memcpy(&bits, &key, sizeof(bits));
+  constexpr uint32_t sign_bit = 1U << 31U;
+  return (0U != (bits & sign_bit)) ? ~bits : (bits | sign_bit);
+}
+
+/// \brief Map a floating point key to its radix key: the bits of negative numbers are flipped
+/// so that they are ordered downwards, the sign bit of the others is set
+/// \param[in] key The key, -0 is ordered before +0 and NaNs are ordered by their bits
+/// \return An unsigned integer ordered as the key
+inline uint64_t to_radix_key(const double key)
+{
+  static_assert(sizeof(double) == sizeof(uint64_t), "Unexpected double size");
+  uint64_t bits;
+  ::std::memcpy(&bits, &key, sizeof(bits));
+  constexpr uint64_t sign_bit = 1UL << 63U;
+  return (0U != (bits & sign_bit)) ? ~bits : (bits | sign_bit);
+}
+
+/// \brief Stable least significant digit radix sort of elements by an integer or floating point
+/// key, e.g. voxel indices or ray radii.
+/// \details All digit histograms are counted in one pass, and a digit shared by all elements is
+/// not sorted, so that only as many passes as the keys need are done. The elements are moved to
+/// and from a helper buffer, which is allocated by reserve() so that no heap allocation is done
+/// during the sort. No step recurses.
+/// \tparam T The type of the elements, which must be default constructible
+template<typename T>
+class RadixSorter
+{
+public:
+  /// \brief Number of bits sorted per pass
+  static constexpr uint32_t RADIX_BITS = 8U;
+  /// \brief Number of buckets per pass
+  static constexpr ::std::size_t RADIX_BUCKETS = ::std::size_t{1U} << RADIX_BITS;
+
+  RadixSorter(RadixSorter const &) = delete;
+  RadixSorter & operator=(RadixSorter const &) = delete;
+  RadixSorter(RadixSorter &&) = default;
+  /// \brief Move equals operator
+  RadixSorter & operator=(RadixSorter &&) = default;
+
+  /// \brief Default constructor, do not reserve capacity for the buffer
+  RadixSorter() = default;
+
+  /// \brief Construct and reserve capacity for the buffer
+  /// \param[in] capacity - The maximum capacity of the container to be sorted
+  explicit RadixSorter(::std::size_t capacity)
+  {
+    reserve(capacity);
+  }
+
+  /// \brief Sorts range [first, last) by ascending key, keeping the order of equal keys
+  /// \param[in] first Start of the range to sort
+  /// \param[in] last End of the range to sort (not included)
+  /// \param[in] key_function Returns the integer or floating point key of an element
+  template<typename RandomIt, typename KeyFunction>
+  void sort(RandomIt first, RandomIt last, KeyFunction key_function)
+  {
+    static_assert(
+      ::std::is_same<typename ::std::iterator_traits<RandomIt>::value_type, T>::value,
+      "RadixSorter sorts elements of type T only");
+    using RadixKeyT = decltype(to_radix_key(key_function(*first)));
+    constexpr ::std::size_t NUM_DIGITS = (sizeof(RadixKeyT) * 8U) / RADIX_BITS;
+    static_assert(NUM_DIGITS <= MAX_DIGITS, "Radix keys are at most 64 bits wide");
+
+    const auto size = static_cast<::std::size_t>(::std::distance(first, last));
+    if (size < 2U) {
+      return;
+    }
+    m_buffer.resize(size);
+
+    for (::std::size_t digit = 0U; digit < NUM_DIGITS; ++digit) {
+      m_offsets[digit].fill(0U);
+    }
+    for (auto it = first; it != last; ++it) {
+      const auto key = to_radix_key(key_function(*it));
+      for (::std::size_t digit = 0U; digit < NUM_DIGITS; ++digit) {
+        ++m_offsets[digit][bucket(key, digit)];
+      }
+    }
+
+    bool in_buffer = false;
+    const auto first_key = to_radix_key(key_function(*first));
+    for (::std::size_t digit = 0U; digit < NUM_DIGITS; ++digit) {
+      auto & offsets = m_offsets[digit];
+      if (offsets[bucket(first_key, digit)] == size) {
+        // All elements share this digit
+        continue;
+      }
+      // Exclusive prefix sum gives the output position of each bucket
+      ::std::size_t sum = 0U;
+      for (auto & offset : offsets) {
+        const ::std::size_t count = offset;
+        offset = sum;
+        sum += count;
+      }
+      if (in_buffer) {
+        scatter(m_buffer.begin(), m_buffer.end(), first, key_function, digit, offsets);
+      } else {
+        scatter(first, last, m_buffer.begin(), key_function, digit, offsets);
+      }
+      in_buffer = !in_buffer;
+    }
+    if (in_buffer) {
+      ::std::move(m_buffer.begin(), m_buffer.end(), first);
+    }
+  }
+
+  /// \brief Sorts range [first, last) of integers or floating point numbers
+  /// \param[in] first Start of the range to sort
+  /// \param[in] last End of the range to sort (not included)
+  template<typename RandomIt>
+  void sort(RandomIt first, RandomIt last)
+  {
+    sort(first, last, [](const T & value) {return value;});
+  }
+
+  /// \brief Reserves helper buffer capacity based on the capacity of the container to be sorted
+  /// such that no heap allocation is done during the sort.
+  /// \param[in] capacity - The maximum capacity of the container to be sorted
+  void reserve(::std::size_t capacity)
+  {
+    m_buffer.reserve(capacity);
+  }
+
+  /// \brief Returns the maximum capacity that is allowed for a container to be sorted.
+  /// \return The maximum capacity that a container may have if it is to be sorted
+  /// using this sorter.
+  ::std::size_t capacity() const
+  {
+    return m_buffer.capacity();
+  }
+
+private:
+  static constexpr ::std::size_t MAX_DIGITS = 64U / RADIX_BITS;
+  using Offsets = ::std::array<::std::size_t, RADIX_BUCKETS>;
+
+  /// \brief Get the bucket of a radix key for a digit
+  template<typename RadixKeyT>
+  static ::std::size_t bucket(const RadixKeyT key, const ::std::size_t digit)
+  {
+    return static_cast<::std::size_t>(key >> (digit * RADIX_BITS)) & (RADIX_BUCKETS - 1U);
+  }
+
+  /// \brief Stable move of the elements of [first, last) to their bucket for a digit
+  template<typename InputIt, typename OutputIt, typename KeyFunction>
+  static void scatter(
+    InputIt first, InputIt last, OutputIt out, KeyFunction key_function,
+    const ::std::size_t digit, Offsets & offsets)
+  {
+    for (auto it = first; it != last; ++it) {
+      auto & offset = offsets[bucket(to_radix_key(key_function(*it)), digit)];
+      *(out + static_cast<::std::ptrdiff_t>(offset)) = ::std::move(*it);
+      ++offset;
+    }
+  }
+
+  /// Helper buffer the elements are moved to on every other pass
+  ::std::vector<T> m_buffer;
+  /// Bucket counts, then output positions, of each digit
+  ::std::array<Offsets, MAX_DIGITS> m_offsets;
+};
+
+}  // namespace algorithm
+
+}  // namespace common
+
+}  // namespace autoware
+
+#endif  // AUTOWARE_AUTO_ALGORITHM__RADIX_SORT_HPP_
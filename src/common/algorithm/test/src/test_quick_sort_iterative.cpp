@@ -15,6 +15,8 @@
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
 #include <vector>
 #include "autoware_auto_algorithm/algorithm.hpp"
 
@@ -100,3 +102,57 @@ TEST(QuickSortIterative, SubRange) {
   ASSERT_EQ(vector, ::std::vector<int32_t>({3, 1, 5, 6, 4, 2}));
   ASSERT_EQ(sorter.capacity(), 6UL);
 }
+
+namespace
+{
+// Deterministic pseudo random values, so that failures can be reproduced
+::std::vector<int32_t> random_values(const ::std::size_t size, const int32_t modulus)
+{
+  ::std::vector<int32_t> vector(size);
+  uint32_t state = 42U;
+  for (auto & value : vector) {
+    state = (state * 1664525U) + 1013904223U;
+    value = static_cast<int32_t>(state >> 8U) % modulus;
+  }
+  return vector;
+}
+}  // namespace
+
+TEST(QuickSortIterative, LargeRandom) {
+  auto vector = random_values(10000U, 1000000);
+  auto expected = vector;
+  ::std::sort(expected.begin(), expected.end());
+  QuickSorter<::std::vector<int32_t>> sorter(vector.capacity());
+  sorter.sort(vector.begin(), vector.end());
+  ASSERT_EQ(vector, expected);
+  ASSERT_EQ(sorter.capacity(), 10000UL);
+}
+
+TEST(QuickSortIterative, Degenerate) {
+  // Many duplicates make every partition unbalanced, which has to fall back to heap sort
+  ::std::vector<::std::vector<int32_t>> inputs{
+    ::std::vector<int32_t>(5000U, 7),
+    random_values(5000U, 3)};
+  // Organ pipe
+  ::std::vector<int32_t> pipe(5000U);
+  for (::std::size_t i = 0U; i < pipe.size(); ++i) {
+    pipe[i] = static_cast<int32_t>(::std::min(i, pipe.size() - i));
+  }
+  inputs.push_back(pipe);
+  for (auto & vector : inputs) {
+    auto expected = vector;
+    ::std::sort(expected.begin(), expected.end());
+    QuickSorter<::std::vector<int32_t>> sorter(vector.capacity());
+    sorter.sort(vector.begin(), vector.end());
+    ASSERT_EQ(vector, expected);
+  }
+}
+
+TEST(QuickSortIterative, Comparison) {
+  auto vector = random_values(1000U, 100);
+  auto expected = vector;
+  ::std::sort(expected.begin(), expected.end(), ::std::greater<int32_t>());
+  QuickSorter<::std::vector<int32_t>> sorter(vector.capacity());
+  sorter.sort(vector.begin(), vector.end(), ::std::greater<int32_t>());
+  ASSERT_EQ(vector, expected);
+}
@@ -0,0 +1,94 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "autoware_auto_algorithm/algorithm.hpp"
+
+template<typename T>
+using RadixSorter = ::autoware::common::algorithm::RadixSorter<T>;
+
+TEST(RadixSort, Empty) {
+  ::std::vector<uint32_t> vector;
+  RadixSorter<uint32_t> sorter;
+  sorter.sort(vector.begin(), vector.end());
+  ASSERT_EQ(vector, ::std::vector<uint32_t>({}));
+  ASSERT_EQ(sorter.capacity(), 0UL);
+}
+
+TEST(RadixSort, Unsigned) {
+  ::std::vector<uint64_t> vector = {3U, 1UL << 40U, 0U, 256U, 255U, 1UL << 40U, 7U};
+  RadixSorter<uint64_t> sorter(vector.capacity());
+  ASSERT_EQ(sorter.capacity(), 7UL);
+  sorter.sort(vector.begin(), vector.end());
+  ASSERT_EQ(vector, ::std::vector<uint64_t>({0U, 3U, 7U, 255U, 256U, 1UL << 40U, 1UL << 40U}));
+  ASSERT_EQ(sorter.capacity(), 7UL);
+}
+
+TEST(RadixSort, Signed) {
+  ::std::vector<int32_t> vector = {3, -1, ::std::numeric_limits<int32_t>::max(), 0, -300,
+    ::std::numeric_limits<int32_t>::min(), 2};
+  auto expected = vector;
+  ::std::sort(expected.begin(), expected.end());
+  RadixSorter<int32_t> sorter(vector.capacity());
+  sorter.sort(vector.begin(), vector.end());
+  ASSERT_EQ(vector, expected);
+}
+
+TEST(RadixSort, Float) {
+  ::std::vector<float> vector = {3.5F, -1.0F, 0.0F, -0.25F, 1e-30F, -1e30F, 2.0F,
+    ::std::numeric_limits<float>::infinity(), -::std::numeric_limits<float>::infinity()};
+  auto expected = vector;
+  ::std::sort(expected.begin(), expected.end());
+  RadixSorter<float> sorter(vector.capacity());
+  sorter.sort(vector.begin(), vector.end());
+  ASSERT_EQ(vector, expected);
+
+  ::std::vector<double> doubles = {3.5, -1.0, 0.0, -0.25, 1e-300, -1e300, 2.0};
+  auto expected_doubles = doubles;
+  ::std::sort(expected_doubles.begin(), expected_doubles.end());
+  RadixSorter<double> double_sorter(doubles.capacity());
+  double_sorter.sort(doubles.begin(), doubles.end());
+  ASSERT_EQ(doubles, expected_doubles);
+}
+
+TEST(RadixSort, StableByKey) {
+  // Sort (radius, index) pairs by radius only, equal radii keep their order
+  using Element = ::std::pair<float, uint32_t>;
+  ::std::vector<Element> vector;
+  uint32_t state = 42U;
+  for (uint32_t i = 0U; i < 5000U; ++i) {
+    state = (state * 1664525U) + 1013904223U;
+    vector.emplace_back(static_cast<float>(state >> 24U) * 0.5F, i);
+  }
+  auto expected = vector;
+  ::std::stable_sort(
+    expected.begin(), expected.end(), [](const Element & lhs, const Element & rhs) {
+      return lhs.first < rhs.first;
+    });
+  RadixSorter<Element> sorter(vector.capacity());
+  sorter.sort(vector.begin(), vector.end(), [](const Element & e) {return e.first;});
+  ASSERT_EQ(vector, expected);
+  // A sub range is sorted in place
+  ::std::reverse(vector.begin(), vector.end());
+  sorter.sort(vector.begin() + 10, vector.end(), [](const Element & e) {return e.first;});
+  ASSERT_TRUE(
+    ::std::is_sorted(
+      vector.begin() + 10, vector.end(), [](const Element & lhs, const Element & rhs) {
+        return lhs.first < rhs.first;
+      }));
+}
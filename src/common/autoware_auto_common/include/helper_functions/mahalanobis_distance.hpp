@@ -19,6 +19,9 @@
 
 #include <Eigen/Cholesky>
 
+#include <cstddef>
+#include <stdexcept>
+
 namespace autoware
 {
 namespace common
@@ -68,6 +71,89 @@ types::float32_t calculate_mahalanobis_distance(
 {
   return sqrtf(calculate_squared_mahalanobis_distance(sample, mean, covariance_factor));
 }
+
+/// \brief Calculate square of mahalanobis distance of several samples to the same mean
+/// \details The covariance matrix is factorized once for all samples. The result for each sample
+/// is the same as that of calculate_squared_mahalanobis_distance.
+/// \tparam T Type of elements in the matrix
+/// \tparam kNumOfStates Number of states
+/// \param samples Matrix containing one sample in each column
+/// \param mean Single column matrix containing mean of samples received so far
+/// \param covariance_factor Covariance matrix
+/// \return Square of mahalanobis distance of each sample, in the order of the columns of samples
+template<typename T, std::int32_t kNumOfStates>
+Eigen::Matrix<T, 1, Eigen::Dynamic> calculate_squared_mahalanobis_distances(
+  const Eigen::Matrix<T, kNumOfStates, Eigen::Dynamic> & samples,
+  const Eigen::Matrix<T, kNumOfStates, 1> & mean,
+  const Eigen::Matrix<T, kNumOfStates, kNumOfStates> & covariance_factor)
+{
+  using Samples = Eigen::Matrix<T, kNumOfStates, Eigen::Dynamic>;
+  const Samples x = covariance_factor.ldlt().solve(samples.colwise() - mean);
+  return x.colwise().squaredNorm();
+}
+
+/// \brief Calculate mahalanobis distance of several samples to the same mean
+/// \tparam T Type of elements in the matrix
+/// \tparam kNumOfStates Number of states
+/// \param samples Matrix containing one sample in each column
+/// \param mean Single column matrix containing mean of samples received so far
+/// \param covariance_factor Covariance matrix
+/// \return Mahalanobis distance of each sample, in the order of the columns of samples
+template<typename T, std::int32_t kNumOfStates>
+Eigen::Matrix<T, 1, Eigen::Dynamic> calculate_mahalanobis_distances(
+  const Eigen::Matrix<T, kNumOfStates, Eigen::Dynamic> & samples,
+  const Eigen::Matrix<T, kNumOfStates, 1> & mean,
+  const Eigen::Matrix<T, kNumOfStates, kNumOfStates> & covariance_factor)
+{
+  return calculate_squared_mahalanobis_distances(samples, mean, covariance_factor).cwiseSqrt();
+}
+
+/// \brief Calculate square of mahalanobis distance of every sample to every mean
+/// \details Each covariance matrix is factorized once for all samples.
+/// \tparam T Type of elements in the matrix
+/// \tparam kNumOfStates Number of states
+/// \tparam CovarianceContainerT Random access container of covariance matrices
+/// \param samples Matrix containing one sample in each column
+/// \param means Matrix containing one mean in each column
+/// \param covariance_factors Covariance matrix of each mean, in the order of the columns of means
+/// \return Matrix with the square of mahalanobis distance of sample i to mean j at (i, j)
+/// \throw std::domain_error If the number of covariance matrices and means differ
+template<typename T, std::int32_t kNumOfStates, typename CovarianceContainerT>
+Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> calculate_pairwise_squared_mahalanobis_distances(
+  const Eigen::Matrix<T, kNumOfStates, Eigen::Dynamic> & samples,
+  const Eigen::Matrix<T, kNumOfStates, Eigen::Dynamic> & means,
+  const CovarianceContainerT & covariance_factors)
+{
+  if (static_cast<Eigen::Index>(covariance_factors.size()) != means.cols()) {
+    throw std::domain_error{"Need one covariance matrix per mean"};
+  }
+  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> distances{samples.cols(), means.cols()};
+  for (Eigen::Index j = 0; j < means.cols(); ++j) {
+    const Eigen::Matrix<T, kNumOfStates, 1> mean = means.col(j);
+    distances.col(j) = calculate_squared_mahalanobis_distances(
+      samples, mean, covariance_factors[static_cast<std::size_t>(j)]).transpose();
+  }
+  return distances;
+}
+
+/// \brief Calculate mahalanobis distance of every sample to every mean
+/// \tparam T Type of elements in the matrix
+/// \tparam kNumOfStates Number of states
+/// \tparam CovarianceContainerT Random access container of covariance matrices
+/// \param samples Matrix containing one sample in each column
+/// \param means Matrix containing one mean in each column
+/// \param covariance_factors Covariance matrix of each mean, in the order of the columns of means
+/// \return Matrix with the mahalanobis distance of sample i to mean j at (i, j)
+/// \throw std::domain_error If the number of covariance matrices and means differ
+template<typename T, std::int32_t kNumOfStates, typename CovarianceContainerT>
+Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> calculate_pairwise_mahalanobis_distances(
+  const Eigen::Matrix<T, kNumOfStates, Eigen::Dynamic> & samples,
+  const Eigen::Matrix<T, kNumOfStates, Eigen::Dynamic> & means,
+  const CovarianceContainerT & covariance_factors)
+{
+  return calculate_pairwise_squared_mahalanobis_distances(
+    samples, means, covariance_factors).cwiseSqrt();
+}
 }  // namespace helper_functions
 }  // namespace common
 }  // namespace autoware
@@ -0,0 +1,134 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// \file
+/// \brief This file defines the scheduling policy, priority and CPU set of a thread
+
+#ifndef HELPER_FUNCTIONS__THREAD_SCHEDULING_HPP_
+#define HELPER_FUNCTIONS__THREAD_SCHEDULING_HPP_
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace common
+{
+namespace helper_functions
+{
+/// \brief The scheduling of a thread, whose empty fields leave the thread unchanged
+struct ThreadScheduling
+{
+  /// \brief One of "other", "batch", "idle", "fifo" and "rr", or empty to keep the policy
+  std::string policy{};
+  /// \brief The real-time priority, for the "fifo" and "rr" policies
+  int64_t priority{0};
+  /// \brief The CPUs the thread may run on, or empty to keep its affinity
+  std::vector<int64_t> cpus{};
+};
+
+/// \brief Get the POSIX scheduling policy of a ThreadScheduling policy name
+/// \param[in] policy The name of the policy
+/// \return The policy, e.g. SCHED_FIFO
+/// \throws std::domain_error if the policy is unknown
+inline int32_t to_sched_policy(const std::string & policy)
+{
+  if (policy == "other") {
+    return SCHED_OTHER;
+  } else if (policy == "batch") {
+    return SCHED_BATCH;
+  } else if (policy == "idle") {
+    return SCHED_IDLE;
+  } else if (policy == "fifo") {
+    return SCHED_FIFO;
+  } else if (policy == "rr") {
+    return SCHED_RR;
+  }
+  throw std::domain_error("Unknown scheduling policy: " + policy);
+}
+
+/// \brief Declare the scheduling of a thread as the parameters `<prefix>.policy`,
+/// `<prefix>.priority` and `<prefix>.cpus` of a node
+/// \tparam NodeT The type of the node, e.g. rclcpp::Node
+/// \param[in] node The node to declare the parameters on
+/// \param[in] prefix The prefix of the parameters, which names the thread
+/// \return The scheduling, which leaves the thread unchanged if no parameter is set
+/// \throws std::domain_error if the policy is unknown or the priority or a CPU is negative
+template<typename NodeT>
+ThreadScheduling declare_thread_scheduling(NodeT & node, const std::string & prefix)
+{
+  ThreadScheduling scheduling{};
+  scheduling.policy = node.declare_parameter(prefix + ".policy", std::string{});
+  scheduling.priority = node.declare_parameter(prefix + ".priority", int64_t{0});
+  scheduling.cpus = node.declare_parameter(prefix + ".cpus", std::vector<int64_t>{});
+  if (!scheduling.policy.empty()) {
+    (void)to_sched_policy(scheduling.policy);
+  }
+  if (scheduling.priority < 0) {
+    throw std::domain_error(prefix + ".priority must not be negative");
+  }
+  for (const auto cpu : scheduling.cpus) {
+    if ((cpu < 0) || (cpu >= CPU_SETSIZE)) {
+      throw std::domain_error(prefix + ".cpus must be in [0, " + std::to_string(CPU_SETSIZE) + ")");
+    }
+  }
+  return scheduling;
+}
+
+/// \brief Apply a scheduling to a thread
+/// \details Setting a real-time policy or a higher priority usually needs CAP_SYS_NICE, so a
+/// failure is returned for the caller to report rather than thrown.
+/// \param[in] scheduling The scheduling to apply
+/// \param[in] thread The thread, e.g. pthread_self() or std::thread::native_handle()
+/// \return An empty string on success, the reason of the failure otherwise
+/// \throws std::domain_error if the policy is unknown
+inline std::string apply_thread_scheduling(
+  const ThreadScheduling & scheduling, const pthread_t thread)
+{
+  std::string error{};
+  if (!scheduling.cpus.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const auto cpu : scheduling.cpus) {
+      CPU_SET(static_cast<std::size_t>(cpu), &cpu_set);
+    }
+    const int32_t result = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+    if (result != 0) {
+      error += std::string{"cannot set the CPU affinity: "} + std::strerror(result);
+    }
+  }
+  if (!scheduling.policy.empty()) {
+    const int32_t policy = to_sched_policy(scheduling.policy);
+    sched_param param{};
+    if ((policy == SCHED_FIFO) || (policy == SCHED_RR)) {
+      param.sched_priority = static_cast<int32_t>(scheduling.priority);
+    }
+    const int32_t result = pthread_setschedparam(thread, policy, &param);
+    if (result != 0) {
+      error += std::string{error.empty() ? "" : ", "} + "cannot set the scheduling policy " +
+        scheduling.policy + ": " + std::strerror(result);
+    }
+  }
+  return error;
+}
+}  // namespace helper_functions
+}  // namespace common
+}  // namespace autoware
+
+#endif  // HELPER_FUNCTIONS__THREAD_SCHEDULING_HPP_
@@ -0,0 +1,195 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// \file
+/// \brief This file defines a fixed pool of worker threads for data parallel batches
+
+#ifndef HELPER_FUNCTIONS__WORKER_POOL_HPP_
+#define HELPER_FUNCTIONS__WORKER_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace autoware
+{
+namespace common
+{
+namespace helper_functions
+{
+/// \brief A fixed pool of worker threads that calls a function once for each index of a batch
+/// \details The threads are started once and then wait for batches, so running a batch neither
+/// starts threads nor allocates. Indices are claimed one at a time, so the schedule depends on
+/// timing, but work that only touches the state of its index, or of the worker running it, gives
+/// the same results as a serial loop.
+class WorkerPool
+{
+public:
+  /// \brief Work for one index, called with the index and the worker in [0, get_num_workers()).
+  /// Worker 0 is the calling thread.
+  using Work = std::function<void (std::size_t, std::size_t)>;
+
+  /// \brief Constructor, starts the worker threads
+  /// \param[in] num_workers Number of workers, including the calling thread. A value of 1 means
+  ///                        no additional threads are started
+  /// \throws std::domain_error if num_workers is 0
+  explicit WorkerPool(const std::size_t num_workers)
+  : m_num_workers{num_workers},
+    m_batch_id{0U},
+    m_num_busy{0U},
+    m_shutdown{false},
+    m_work{nullptr},
+    m_count{0U},
+    m_next_index{0U}
+  {
+    if (0U == num_workers) {
+      throw std::domain_error("WorkerPool: need at least one worker");
+    }
+    m_threads.reserve(num_workers - 1U);
+    for (std::size_t worker = 1U; worker < num_workers; ++worker) {
+      m_threads.emplace_back([this, worker] {loop(worker);});
+    }
+  }
+
+  /// \brief Destructor, stops and joins the worker threads
+  ~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_shutdown = true;
+    }
+    m_start_cv.notify_all();
+    for (auto & thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  /// \brief Call the work for each index in [0, count). Blocks until all calls have returned; the
+  /// calling thread also works on the batch. Not thread safe.
+  /// \param[in] count Number of indices
+  /// \param[in] work Work to do for each index
+  /// \throws ... The first exception thrown by the work. No further indices are handed out after
+  ///         it, and it is rethrown once the calls in progress have returned.
+  void run(const std::size_t count, const Work & work)
+  {
+    if ((0U == count) || m_threads.empty()) {
+      for (std::size_t idx = 0U; idx < count; ++idx) {
+        work(idx, 0U);
+      }
+      return;
+    }
+    // Start batch
+    m_error = nullptr;
+    m_work = &work;
+    m_count = count;
+    m_next_index.store(0U);
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      ++m_batch_id;
+      m_num_busy = m_threads.size();
+    }
+    m_start_cv.notify_all();
+    process(0U);
+    // Wait for batch to finish; the workers' writes are visible after this
+    {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      m_done_cv.wait(lock, [this] {return 0U == m_num_busy;});
+    }
+    m_work = nullptr;
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+  }
+
+  /// \brief Get the number of workers, including the calling thread
+  /// \return Value
+  std::size_t get_num_workers() const
+  {
+    return m_num_workers;
+  }
+
+private:
+  /// \brief Run loop of the worker threads
+  /// \param[in] worker Index of the worker
+  void loop(const std::size_t worker)
+  {
+    uint64_t last_batch_id = 0U;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_start_cv.wait(
+          lock, [this, last_batch_id] {return m_shutdown || (last_batch_id != m_batch_id);});
+        if (m_shutdown) {
+          break;
+        }
+        last_batch_id = m_batch_id;
+      }
+      process(worker);
+      {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        --m_num_busy;
+      }
+      m_done_cv.notify_one();
+    }
+  }
+
+  /// \brief Claim indices of the current batch and do their work until there are none left
+  /// \param[in] worker Index of the worker
+  void process(const std::size_t worker)
+  {
+    try {
+      for (std::size_t idx = m_next_index++; idx < m_count; idx = m_next_index++) {
+        (*m_work)(idx, worker);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      if (!m_error) {
+        m_error = std::current_exception();
+      }
+      // Stop the other workers early
+      m_next_index.store(m_count);
+    }
+  }
+
+  std::size_t m_num_workers;
+  std::vector<std::thread> m_threads;
+
+  // Synchronization between the calling thread and the workers
+  std::mutex m_mutex;
+  std::condition_variable m_start_cv;
+  std::condition_variable m_done_cv;
+  uint64_t m_batch_id;
+  std::size_t m_num_busy;
+  bool m_shutdown;
+
+  // State of the current batch
+  const Work * m_work;
+  std::size_t m_count;
+  std::atomic<std::size_t> m_next_index;
+  std::exception_ptr m_error;
+};
+}  // namespace helper_functions
+}  // namespace common
+}  // namespace autoware
+
+#endif  // HELPER_FUNCTIONS__WORKER_POOL_HPP_
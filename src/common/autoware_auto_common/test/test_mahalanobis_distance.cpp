@@ -18,6 +18,8 @@
 #include <common/types.hpp>
 #include <helper_functions/mahalanobis_distance.hpp>
 
+#include <vector>
+
 TEST(MahalanobisDistanceTest, BasicTest)
 {
   Eigen::Matrix<autoware::common::types::float32_t, 2, 1> mean;
@@ -39,3 +41,45 @@ TEST(MahalanobisDistanceTest, BasicTest)
     autoware::common::helper_functions::calculate_mahalanobis_distance(
       sample, mean, cov), 10.0F);
 }
+
+TEST(MahalanobisDistanceTest, Batch)
+{
+  using autoware::common::types::float32_t;
+  namespace helper_functions = autoware::common::helper_functions;
+  using Vector = Eigen::Matrix<float32_t, 2, 1>;
+  using Matrix = Eigen::Matrix<float32_t, 2, 2>;
+  Eigen::Matrix<float32_t, 2, Eigen::Dynamic> samples{2, 3};
+  samples << 2.F, 3.F, 1.F,
+    3.F, 2.F, 0.5F;
+  Eigen::Matrix<float32_t, 2, Eigen::Dynamic> means{2, 2};
+  means << 2.F, 0.F,
+    2.F, 1.F;
+  std::vector<Matrix, Eigen::aligned_allocator<Matrix>> covs(2U);
+  covs[0U] << 0.1F, 0.0F, 0.0F, 0.6F;
+  covs[1U] << 1.0F, 0.2F, 0.2F, 0.5F;
+
+  const Vector mean = means.col(0);
+  const auto batch = helper_functions::calculate_mahalanobis_distances(samples, mean, covs[0U]);
+  ASSERT_EQ(batch.cols(), samples.cols());
+  EXPECT_FLOAT_EQ(batch(0), 1.666666666F);
+  EXPECT_FLOAT_EQ(batch(1), 10.0F);
+
+  const auto pairwise =
+    helper_functions::calculate_pairwise_mahalanobis_distances(samples, means, covs);
+  ASSERT_EQ(pairwise.rows(), samples.cols());
+  ASSERT_EQ(pairwise.cols(), means.cols());
+  for (Eigen::Index i = 0; i < samples.cols(); ++i) {
+    for (Eigen::Index j = 0; j < means.cols(); ++j) {
+      const Vector sample = samples.col(i);
+      const Vector mean_j = means.col(j);
+      EXPECT_FLOAT_EQ(
+        pairwise(i, j), helper_functions::calculate_mahalanobis_distance(
+          sample, mean_j, covs[static_cast<std::size_t>(j)])) << i << ", " << j;
+    }
+  }
+
+  covs.pop_back();
+  EXPECT_THROW(
+    helper_functions::calculate_pairwise_mahalanobis_distances(samples, means, covs),
+    std::domain_error);
+}
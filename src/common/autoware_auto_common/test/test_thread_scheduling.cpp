@@ -0,0 +1,104 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helper_functions/thread_scheduling.hpp"
+
+using autoware::common::helper_functions::ThreadScheduling;
+using autoware::common::helper_functions::apply_thread_scheduling;
+using autoware::common::helper_functions::declare_thread_scheduling;
+using autoware::common::helper_functions::to_sched_policy;
+
+namespace
+{
+// Stands in for rclcpp::Node, returning the overridden or the default value
+struct FakeNode
+{
+  std::map<std::string, std::string> strings;
+  std::map<std::string, int64_t> integers;
+  std::map<std::string, std::vector<int64_t>> arrays;
+
+  std::string declare_parameter(const std::string & name, const std::string & default_value)
+  {
+    return strings.count(name) ? strings.at(name) : default_value;
+  }
+  int64_t declare_parameter(const std::string & name, const int64_t default_value)
+  {
+    return integers.count(name) ? integers.at(name) : default_value;
+  }
+  std::vector<int64_t> declare_parameter(
+    const std::string & name, const std::vector<int64_t> & default_value)
+  {
+    return arrays.count(name) ? arrays.at(name) : default_value;
+  }
+};
+}  // namespace
+
+TEST(TestThreadScheduling, Policies)
+{
+  EXPECT_EQ(to_sched_policy("other"), SCHED_OTHER);
+  EXPECT_EQ(to_sched_policy("fifo"), SCHED_FIFO);
+  EXPECT_EQ(to_sched_policy("rr"), SCHED_RR);
+  EXPECT_THROW(to_sched_policy("FIFO"), std::domain_error);
+}
+
+TEST(TestThreadScheduling, Declare)
+{
+  FakeNode node{};
+  const auto unchanged = declare_thread_scheduling(node, "thread");
+  EXPECT_TRUE(unchanged.policy.empty());
+  EXPECT_TRUE(unchanged.cpus.empty());
+
+  node.strings["thread.policy"] = "fifo";
+  node.integers["thread.priority"] = 50;
+  node.arrays["thread.cpus"] = {0, 2};
+  const auto scheduling = declare_thread_scheduling(node, "thread");
+  EXPECT_EQ(scheduling.policy, "fifo");
+  EXPECT_EQ(scheduling.priority, 50);
+  EXPECT_EQ(scheduling.cpus, (std::vector<int64_t>{0, 2}));
+
+  node.arrays["thread.cpus"] = {-1};
+  EXPECT_THROW(declare_thread_scheduling(node, "thread"), std::domain_error);
+  node.arrays["thread.cpus"] = {};
+  node.strings["thread.policy"] = "realtime";
+  EXPECT_THROW(declare_thread_scheduling(node, "thread"), std::domain_error);
+}
+
+TEST(TestThreadScheduling, Apply)
+{
+  EXPECT_TRUE(apply_thread_scheduling(ThreadScheduling{}, pthread_self()).empty());
+
+  // Restricting the thread to a CPU it may already run on needs no privileges
+  cpu_set_t initial_cpus;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(initial_cpus), &initial_cpus), 0);
+  int64_t cpu = 0;
+  while (!CPU_ISSET(static_cast<std::size_t>(cpu), &initial_cpus)) {
+    ++cpu;
+  }
+  ThreadScheduling scheduling{};
+  scheduling.policy = "other";
+  scheduling.cpus = {cpu};
+  EXPECT_TRUE(apply_thread_scheduling(scheduling, pthread_self()).empty());
+  cpu_set_t cpus;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus), 0);
+  EXPECT_EQ(CPU_COUNT(&cpus), 1);
+  EXPECT_TRUE(CPU_ISSET(static_cast<std::size_t>(cpu), &cpus));
+
+  ASSERT_EQ(pthread_setaffinity_np(pthread_self(), sizeof(initial_cpus), &initial_cpus), 0);
+}
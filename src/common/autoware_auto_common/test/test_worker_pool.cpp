@@ -0,0 +1,72 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helper_functions/worker_pool.hpp"
+
+using autoware::common::helper_functions::WorkerPool;
+
+TEST(TestWorkerPool, Run)
+{
+  EXPECT_THROW(WorkerPool{0U}, std::domain_error);
+  WorkerPool pool{3U};
+  EXPECT_EQ(pool.get_num_workers(), 3U);
+  std::vector<std::size_t> calls(1000U, 0U);
+  std::vector<std::size_t> calls_per_worker(pool.get_num_workers(), 0U);
+  for (std::size_t batch = 0U; batch < 10U; ++batch) {
+    pool.run(
+      calls.size(), [&calls, &calls_per_worker](const std::size_t idx, const std::size_t worker) {
+        ++calls[idx];
+        // Each worker only touches its own counter
+        ++calls_per_worker[worker];
+      });
+  }
+  for (const auto count : calls) {
+    EXPECT_EQ(count, 10U);
+  }
+  std::size_t total = 0U;
+  for (const auto count : calls_per_worker) {
+    total += count;
+  }
+  EXPECT_EQ(total, 10000U);
+  pool.run(0U, [](const std::size_t, const std::size_t) {throw std::runtime_error("no work");});
+  EXPECT_THROW(
+    pool.run(
+      calls.size(), [](const std::size_t idx, const std::size_t) {
+        if (idx == 500U) {
+          throw std::runtime_error("work failed");
+        }
+      }),
+    std::runtime_error);
+  // Still usable after an error
+  pool.run(calls.size(), [&calls](const std::size_t idx, const std::size_t) {calls[idx] = 0U;});
+  EXPECT_EQ(std::count(calls.begin(), calls.end(), 0U), 1000);
+}
+
+TEST(TestWorkerPool, SingleWorker)
+{
+  WorkerPool pool{1U};
+  std::vector<std::size_t> order;
+  pool.run(
+    5U, [&order](const std::size_t idx, const std::size_t worker) {
+      EXPECT_EQ(worker, 0U);
+      order.push_back(idx);
+    });
+  EXPECT_EQ(order, (std::vector<std::size_t>{0U, 1U, 2U, 3U, 4U}));
+}
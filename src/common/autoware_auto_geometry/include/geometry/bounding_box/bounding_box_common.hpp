@@ -95,6 +95,26 @@ void compute_height(const IT begin, const IT end, autoware_auto_msgs::msg::Shape
   shape.height = max_z - min_z;
 }
 
+/// \brief Computes height of bounding box given a range of points, e.g. a cluster view
+/// \param[in] points The range of points
+/// \param[out] box A box for which the z component of centroid, corners, and size gets filled
+/// \tparam RangeT A type with begin() and end() iterators, see compute_height(begin, end, box)
+template<typename RangeT>
+void compute_height(const RangeT & points, BoundingBox & box)
+{
+  compute_height(points.begin(), points.end(), box);
+}
+
+/// \brief Computes height of a shape given a range of points, e.g. a cluster view
+/// \param[in] points The range of points
+/// \param[out] shape A shape in which vertices z values and height field will be set
+/// \tparam RangeT A type with begin() and end() iterators, see compute_height(begin, end, shape)
+template<typename RangeT>
+void compute_height(const RangeT & points, autoware_auto_msgs::msg::Shape & shape)
+{
+  compute_height(points.begin(), points.end(), shape);
+}
+
 namespace details
 {
 
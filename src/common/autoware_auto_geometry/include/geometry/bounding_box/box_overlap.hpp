@@ -0,0 +1,112 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+/// \file
+/// \brief This file defines batched overlap tests between sets of oriented bounding boxes
+
+#ifndef GEOMETRY__BOUNDING_BOX__BOX_OVERLAP_HPP_
+#define GEOMETRY__BOUNDING_BOX__BOX_OVERLAP_HPP_
+
+#include <geometry/bounding_box/bounding_box_common.hpp>
+#include <geometry/static_vector.hpp>
+#include <geometry/visibility_control.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace autoware
+{
+namespace common
+{
+namespace geometry
+{
+namespace bounding_box
+{
+
+/// \brief The 2D footprints of a set of bounding boxes, stored as a structure of arrays so that
+///        one box can be tested against many others at once. Only the corners of the boxes are
+///        used, which must be ordered around the box (either cw or ccw).
+class GEOMETRY_PUBLIC BoxArray
+{
+public:
+  /// \brief Replace the contents with the given boxes. Memory is only allocated if there are more
+  ///        boxes than before
+  /// \param[in] boxes The boxes
+  void assign(const std::vector<BoundingBox> & boxes);
+
+  /// \brief Get the number of boxes
+  /// \return The number of boxes
+  std::size_t size() const noexcept;
+
+private:
+  friend void overlap_row(const BoxArray &, std::size_t, const BoxArray &, uint8_t *);
+  friend void iou_matrix(const BoxArray &, const BoxArray &, std::vector<float32_t> &);
+
+  // Center, the two half edge vectors and the radius of the enclosing circle
+  std::vector<float32_t> m_cx;
+  std::vector<float32_t> m_cy;
+  std::vector<float32_t> m_ax;
+  std::vector<float32_t> m_ay;
+  std::vector<float32_t> m_bx;
+  std::vector<float32_t> m_by;
+  std::vector<float32_t> m_radius;
+  // Corners in ccw order, for the intersection over union
+  std::vector<StaticVector<geometry_msgs::msg::Point32, 4U>> m_corners;
+};  // class BoxArray
+
+/// \brief Test one box against all boxes of a set for overlap. Boxes that touch overlap. A check
+///        on the enclosing circles is done first, then the separating axis test. All pairs are
+///        evaluated without branching, so that the compiler can vectorize across pairs
+/// \param[in] boxes1 The set containing the box to test
+/// \param[in] idx The index of the box in boxes1; must be smaller than boxes1.size()
+/// \param[in] boxes2 The boxes to test against
+/// \param[out] result One entry per box in boxes2, 1 if the boxes overlap and 0 otherwise. Must
+///                    point to at least boxes2.size() elements
+void GEOMETRY_PUBLIC overlap_row(
+  const BoxArray & boxes1,
+  const std::size_t idx,
+  const BoxArray & boxes2,
+  uint8_t * const result);
+
+/// \brief Test all pairs of boxes of two sets for overlap, see overlap_row
+/// \param[in] boxes1 The boxes corresponding to the rows of the matrix
+/// \param[in] boxes2 The boxes corresponding to the columns of the matrix
+/// \param[out] result A row major boxes1.size() x boxes2.size() matrix, with 1 where the boxes
+///                    overlap and 0 otherwise. Resized as needed
+void GEOMETRY_PUBLIC overlap_matrix(
+  const BoxArray & boxes1,
+  const BoxArray & boxes2,
+  std::vector<uint8_t> & result);
+
+/// \brief Compute the intersection over union of all pairs of boxes of two sets. Pairs which do
+///        not overlap according to overlap_row are 0 without further computation; the others
+///        are computed with convex_intersection_over_union_2d, without allocating memory
+/// \param[in] boxes1 The boxes corresponding to the rows of the matrix
+/// \param[in] boxes2 The boxes corresponding to the columns of the matrix
+/// \param[out] result A row major boxes1.size() x boxes2.size() matrix of intersection over union
+///                    values. Resized as needed
+/// \throw std::domain_error If the intersection over union of a pair is undefined
+void GEOMETRY_PUBLIC iou_matrix(
+  const BoxArray & boxes1,
+  const BoxArray & boxes2,
+  std::vector<float32_t> & result);
+
+}  // namespace bounding_box
+}  // namespace geometry
+}  // namespace common
+}  // namespace autoware
+
+#endif  // GEOMETRY__BOUNDING_BOX__BOX_OVERLAP_HPP_
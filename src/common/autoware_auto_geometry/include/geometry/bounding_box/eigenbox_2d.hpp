@@ -246,6 +246,18 @@ BoundingBox eigenbox_2d(const IT begin, const IT end)
 
   return bbox;
 }
+
+/// \brief Compute oriented bounding box using eigenvectors of a range of points, e.g. a cluster
+///        view, without copying them. See eigenbox_2d(begin, end)
+/// \param[in] points The range of points
+/// \tparam RangeT A type with begin() and end() iterators dereferencable into a point with float
+///                members x and y
+/// \return An oriented bounding box in x-y. This bounding box has no height information
+template<typename RangeT>
+BoundingBox eigenbox_2d(const RangeT & points)
+{
+  return eigenbox_2d(points.begin(), points.end());
+}
 }  // namespace bounding_box
 }  // namespace geometry
 }  // namespace common
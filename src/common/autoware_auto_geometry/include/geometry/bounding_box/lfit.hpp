@@ -22,7 +22,9 @@
 #define GEOMETRY__BOUNDING_BOX__LFIT_HPP_
 
 #include <geometry/bounding_box/eigenbox_2d.hpp>
+#include <algorithm>
 #include <limits>
+#include <type_traits>
 #include <utility>
 
 namespace autoware
@@ -122,6 +124,64 @@ float32_t solve_lfit(const LFitWs & ws, PointT & dir)
   return eigv.second;
 }
 
+/// \brief Number of partitions whose residuals are evaluated together by the L fit algorithm
+constexpr std::size_t LFIT_BLOCK_SIZE = 16U;
+
+/// \brief M matrices and residuals of a block of partitions, stored as a structure of arrays
+struct LFitBlock
+{
+  /// \brief Number of points in the first partition
+  float32_t p[LFIT_BLOCK_SIZE];
+  /// \brief Number of points in the second partition
+  float32_t q[LFIT_BLOCK_SIZE];
+  /// \brief See LFitWs
+  float32_t m12a[LFIT_BLOCK_SIZE];
+  /// \brief See LFitWs
+  float32_t m12b[LFIT_BLOCK_SIZE];
+  /// \brief See LFitWs
+  float32_t m12c[LFIT_BLOCK_SIZE];
+  /// \brief See LFitWs
+  float32_t m12d[LFIT_BLOCK_SIZE];
+  /// \brief See LFitWs
+  float32_t m22a[LFIT_BLOCK_SIZE];
+  /// \brief See LFitWs
+  float32_t m22b[LFIT_BLOCK_SIZE];
+  /// \brief See LFitWs
+  float32_t m22d[LFIT_BLOCK_SIZE];
+  /// \brief x entry of the reduced matrix, see solve_lfit
+  float32_t xx[LFIT_BLOCK_SIZE];
+  /// \brief y entry of the reduced matrix, see solve_lfit
+  float32_t yy[LFIT_BLOCK_SIZE];
+  /// \brief Off-diagonal entry of the reduced matrix, see solve_lfit
+  float32_t xy[LFIT_BLOCK_SIZE];
+  /// \brief L2 residual of each partition
+  float32_t score[LFIT_BLOCK_SIZE];
+};  // struct LFitBlock
+
+/// \brief Copies the M matrix of a partition into a block
+/// \param[in] ws A representation of the M matrix
+/// \param[in] idx The slot in the block
+/// \param[inout] block The block to be filled
+inline void store_lfit_ws(const LFitWs & ws, const std::size_t idx, LFitBlock & block)
+{
+  block.p[idx] = static_cast<float32_t>(ws.p);
+  block.q[idx] = static_cast<float32_t>(ws.q);
+  block.m12a[idx] = ws.m12a;
+  block.m12b[idx] = ws.m12b;
+  block.m12c[idx] = ws.m12c;
+  block.m12d[idx] = ws.m12d;
+  block.m22a[idx] = ws.m22a;
+  block.m22b[idx] = ws.m22b;
+  block.m22d[idx] = ws.m22d;
+}
+
+/// \brief Computes the residuals of a block of partitions. This is the same computation as in
+///        solve_lfit, without the fit direction. The partitions are independent, so this is
+///        compiled such that it can be vectorized
+/// \param[inout] block The M matrices of the partitions, gets the reduced matrices and residuals
+/// \throw std::runtime_error If the discriminant of any reduced matrix is negative
+void GEOMETRY_PUBLIC solve_lfit_block(LFitBlock & block);
+
 /// \brief Increments L fit M matrix with information in the point
 /// \tparam PointT The point type
 /// \param[in] pt The point to increment the M matrix with
@@ -185,29 +245,45 @@ BoundingBox lfit_bounding_box_2d_impl(const IT begin, const IT end, const std::s
   // initialize M
   LFitWs ws{};
   init_lfit_ws(begin, end, size, ws);
-  // solve initial problem
-  details::base_type<decltype(*begin)> best_normal;
-  float32_t min_eig = solve_lfit(ws, best_normal);
-  // solve subsequent problems
+  // The partitions are solved in blocks: updating M is inherently sequential, but computing the
+  // residuals is not. Only the direction of the best partition is computed
+  LFitBlock block;
+  Covariance2d best_m{0.0F, 0.0F, 0.0F, 0UL};
+  float32_t min_eig = std::numeric_limits<float32_t>::max();
+  const std::size_t num_partitions = size - 1U;
   auto it = begin;
-  ++it;
-  for (; it != end; ++it) {
-    // update M
-    ws.p += 1U;
-    ws.q -= 1U;
-    if (ws.q == 0U) {  // checks for q = 0 case
-      break;
+  for (std::size_t offset = 0U; offset < num_partitions; offset += LFIT_BLOCK_SIZE) {
+    const std::size_t count = std::min(LFIT_BLOCK_SIZE, num_partitions - offset);
+    for (std::size_t idx = 0U; idx < count; ++idx) {
+      if ((offset + idx) > 0U) {
+        // update M
+        ++it;
+        ws.p += 1U;
+        ws.q -= 1U;
+        increment_lfit_ws(*it, ws);
+      }
+      store_lfit_ws(ws, idx, block);
+    }
+    // pad the last block with copies of a valid partition, their residuals are ignored
+    for (std::size_t idx = count; idx < LFIT_BLOCK_SIZE; ++idx) {
+      store_lfit_ws(ws, idx, block);
     }
-    increment_lfit_ws(*it, ws);
-    // solve incremented problem
-    decltype(best_normal) dir;
-    const float32_t score = solve_lfit(ws, dir);
-    // update optima
-    if (score < min_eig) {
-      min_eig = score;
-      best_normal = dir;
+    solve_lfit_block(block);
+    // update optima, the first partition is always taken
+    for (std::size_t idx = 0U; idx < count; ++idx) {
+      if (((offset + idx) == 0U) || (block.score[idx] < min_eig)) {
+        min_eig = block.score[idx];
+        best_m.xx = block.xx[idx];
+        best_m.yy = block.yy[idx];
+        best_m.xy = block.xy[idx];
+      }
     }
   }
+  details::base_type<decltype(*begin)> best_normal;
+  {
+    decltype(best_normal) eig1;
+    (void)eig_2d(best_m, eig1, best_normal);
+  }
   // can recover best corner point, but don't care, need to cover all points
   const auto inorm = 1.0F / norm_2d(best_normal);
   if (!std::isnormal(inorm)) {
@@ -252,7 +328,7 @@ BoundingBox lfit_bounding_box_2d(
   // NOTE: assumes points are in base_link/sensor frame!
   // sort along tangent wrt sensor origin
   //lint -e522 NOLINT Not a pure function: data structure iterators are pointing to is modified
-  std::partial_sort(begin, end, end, details::LFitCompare<PointT>{hint});
+  std::sort(begin, end, details::LFitCompare<PointT>{hint});
 
   return details::lfit_bounding_box_2d_impl(begin, end, size);
 }
@@ -276,6 +352,22 @@ BoundingBox lfit_bounding_box_2d(const IT begin, const IT end)
   (void)eig2;
   return lfit_bounding_box_2d(begin, end, eig1, cov.num_points);
 }
+
+/// \brief Compute bounding box which best fits an L-shaped range of points, e.g. a mutable
+///        cluster view, without copying them. See lfit_bounding_box_2d(begin, end)
+/// \param[inout] points The range of points, which gets reordered
+/// \tparam RangeT A type with begin() and end() iterators dereferencable into a modifiable point
+///                with float members x and y
+/// \return An oriented bounding box in x-y. This bounding box has no height information
+/// \throw std::domain_error If the number of points is too few
+template<typename RangeT>
+BoundingBox lfit_bounding_box_2d(RangeT && points)
+{
+  static_assert(
+    !std::is_const<std::remove_reference_t<decltype(*points.begin())>>::value,
+    "LFit reorders the points: the range must be mutable");
+  return lfit_bounding_box_2d(points.begin(), points.end());
+}
 }  // namespace bounding_box
 }  // namespace geometry
 }  // namespace common
@@ -25,8 +25,11 @@
 
 #include <algorithm>
 #include <cstring>
+#include <iterator>
 #include <limits>
 #include <list>
+#include <type_traits>
+#include <utility>
 
 namespace autoware
 {
@@ -258,6 +261,39 @@ BoundingBox minimum_perimeter_bounding_box(const IT begin, const IT end)
   return details::rotating_calipers_impl(begin, end, metric_fn);
 }
 
+namespace details
+{
+/// Enabled for ranges with random access iterators, which are not confused with std::list
+template<typename RangeT>
+using enable_if_random_access_range_t = std::enable_if_t<
+  std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<
+    decltype(std::declval<const RangeT &>().begin())>::iterator_category>::value>;
+}  // namespace details
+
+/// \brief Compute the minimum area bounding box given a range holding a convex hull of points,
+/// e.g. a view of a hull of a cluster, without copying it
+/// \param[in] hull A random access range of the points on a convex hull
+/// \return A minimum area bounding box, value field is the area
+/// \tparam RangeT A type with begin() and end() iterators dereferencable into a point type with
+///                float members x and y
+template<typename RangeT, typename = details::enable_if_random_access_range_t<RangeT>>
+BoundingBox minimum_area_bounding_box(const RangeT & hull)
+{
+  return minimum_area_bounding_box(hull.begin(), hull.end());
+}
+
+/// \brief Compute the minimum perimeter bounding box given a range holding a convex hull of
+/// points, e.g. a view of a hull of a cluster, without copying it
+/// \param[in] hull A random access range of the points on a convex hull
+/// \return A minimum perimeter bounding box, value field is half the perimeter
+/// \tparam RangeT A type with begin() and end() iterators dereferencable into a point type with
+///                float members x and y
+template<typename RangeT, typename = details::enable_if_random_access_range_t<RangeT>>
+BoundingBox minimum_perimeter_bounding_box(const RangeT & hull)
+{
+  return minimum_perimeter_bounding_box(hull.begin(), hull.end());
+}
+
 /// \brief Compute the minimum area bounding box given an unstructured list of points.
 /// Only a list is supported as it enables the convex hull to be formed in O(n log n) time and
 /// without memory allocation.
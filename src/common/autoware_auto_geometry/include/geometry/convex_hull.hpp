@@ -23,12 +23,17 @@
 
 #include <common/types.hpp>
 #include <geometry/common_2d.hpp>
+#include <geometry/static_vector.hpp>
 
 //lint -e537 NOLINT pclint vs cpplint
 #include <algorithm>
 //lint -e537 NOLINT pclint vs cpplint
+#include <array>
+#include <cmath>
+#include <iterator>
 #include <list>
 #include <limits>
+#include <set>
 #include <utility>
 
 using autoware::common::types::float32_t;
@@ -43,6 +48,21 @@ namespace geometry
 namespace details
 {
 
+/// \brief Whether a < b in the lexical sense (a.x < b.x), sort by y if tied
+/// \param[in] a The first point
+/// \param[in] b The second point
+/// \return True if a is lexically smaller than b
+/// \tparam PointT Type of a point, must have x and y float members
+template<typename PointT>
+bool8_t lexical_less(const PointT & a, const PointT & b)
+{
+  using point_adapter::x_;
+  using point_adapter::y_;
+  constexpr auto FEPS = std::numeric_limits<float32_t>::epsilon();
+  return (fabsf(x_(a) - x_(b)) > FEPS) ?
+         (x_(a) < x_(b)) : (y_(a) < y_(b));
+}
+
 /// \brief Moves points comprising the lower convex hull from points to hull.
 /// \param[inout] points A list of points, assumed to be sorted in lexical order
 /// \param[inout] hull An empty list of points, assumed to have same allocator as points
@@ -132,15 +152,7 @@ void form_upper_hull(std::list<PointT> & points, std::list<HullT> & hull)
 template<typename PointT>
 typename std::list<PointT>::const_iterator convex_hull_impl(std::list<PointT> & list)
 {
-  // Functor that return whether a <= b in the lexical sense (a.x < b.x), sort by y if tied
-  const auto lexical_comparator = [](const PointT & a, const PointT & b) -> bool8_t
-    {
-      using point_adapter::x_;
-      using point_adapter::y_;
-      constexpr auto FEPS = std::numeric_limits<float32_t>::epsilon();
-      return (fabsf(x_(a) - x_(b)) > FEPS) ?
-             (x_(a) < x_(b)) : (y_(a) < y_(b));
-    };
+  const auto lexical_comparator = lexical_less<PointT>;
   list.sort(lexical_comparator);
 
   // Temporary list to store points
@@ -168,6 +180,156 @@ typename std::list<PointT>::const_iterator convex_hull_impl(std::list<PointT> &
   list.splice(ret, tmp_hull_list);
   return ret;
 }
+
+/// \brief Convex hull computation on a static vector, see convex_hull_impl. The same monotone
+///        chain algorithm is run on indices into the sorted points, so that no memory is allocated
+/// \param[inout] points Points that will be reordered into a ccw convex hull, followed by the
+///                      internal points
+/// \return An iterator pointing to one after the last point contained in the hull
+/// \tparam PointT Type of a point, must have x and y float members
+/// \tparam CapacityT The capacity of the vector
+template<typename PointT, std::size_t CapacityT>
+typename StaticVector<PointT, CapacityT>::iterator convex_hull_impl(
+  StaticVector<PointT, CapacityT> & points)
+{
+  std::sort(points.begin(), points.end(), lexical_less<PointT>);
+  const std::size_t size = points.size();
+  // The hull is closed by the left-most point, it is stored once
+  StaticVector<std::size_t, CapacityT> hull;
+  std::array<bool8_t, CapacityT> on_hull{};
+  const auto pop_while_ccw = [&points, &hull, &on_hull](
+    const std::size_t lower_hull_size, const std::size_t idx) {
+      while ((hull.size() > lower_hull_size) &&
+        ccw(points[hull[hull.size() - 2U]], points[hull.back()], points[idx]))
+      {
+        // return this point for consideration in upper hull
+        on_hull[hull.back()] = false;
+        hull.pop_back();
+      }
+    };
+  // lower hull, from left to right
+  for (std::size_t idx = 0U; idx < size; ++idx) {
+    pop_while_ccw(1U, idx);
+    hull.push_back(idx);
+    on_hull[idx] = true;
+  }
+  // upper hull, from right to left, over the points which are not on the lower hull
+  const std::size_t lower_hull_size = hull.size();
+  for (std::size_t idx = size - 1U; idx > 0U; --idx) {
+    if (!on_hull[idx - 1U] || (1U == idx)) {
+      pop_while_ccw(lower_hull_size, idx - 1U);
+      if (1U != idx) {
+        hull.push_back(idx - 1U);
+        on_hull[idx - 1U] = true;
+      }
+    }
+  }
+  // Move hull to beginning, followed by the internal points in lexical order
+  const StaticVector<PointT, CapacityT> sorted{points};
+  points.clear();
+  for (const auto idx : hull) {
+    points.push_back(sorted[idx]);
+  }
+  for (std::size_t idx = 0U; idx < size; ++idx) {
+    if (!on_hull[idx]) {
+      points.push_back(sorted[idx]);
+    }
+  }
+  return points.begin() + static_cast<std::ptrdiff_t>(hull.size());
+}
+
+/// \brief Exact lexical order of points, by x and then by y. Unlike lexical_less, this is a
+///        strict weak ordering, so that it can be used to key an ordered container
+/// \tparam PointT Type of a point, must have x and y float members
+/// \tparam LessT Whether the order is ascending, otherwise it is descending
+template<typename PointT, bool8_t LessT>
+struct ExactLexicalOrder
+{
+  bool8_t operator()(const PointT & a, const PointT & b) const
+  {
+    using point_adapter::x_;
+    using point_adapter::y_;
+    const auto & first = LessT ? a : b;
+    const auto & second = LessT ? b : a;
+    return (x_(first) < x_(second)) || (!(x_(second) < x_(first)) && (y_(first) < y_(second)));
+  }
+};
+
+/// \brief One of the two monotone chains of an incremental convex hull. The points are kept in
+///        the order of the chain, and every three consecutive points form a strict left turn.
+///        The lower chain is ordered by ascending, the upper chain by descending lexical order,
+///        so that both are traversed ccw
+/// \tparam PointT Type of a point, must have x and y float members
+/// \tparam LessT Whether this is the lower chain
+template<typename PointT, bool8_t LessT>
+class HullChain
+{
+public:
+  using Points = std::set<PointT, ExactLexicalOrder<PointT, LessT>>;
+
+  /// \brief Add a point to the chain, and remove the points which are not convex anymore
+  /// \param[in] pt The point to add, must be finite
+  /// \return True if the point was added, false if it is on or inside of the chain
+  bool8_t insert(const PointT & pt)
+  {
+    auto next = m_points.lower_bound(pt);
+    if ((next != m_points.end()) && !m_points.key_comp()(pt, *next)) {
+      return false;  // same point
+    }
+    if ((next != m_points.begin()) && (next != m_points.end()) &&
+      ccw(*std::prev(next), pt, *next))
+    {
+      return false;
+    }
+    const auto it = m_points.insert(next, pt);
+    // Each point is removed at most once, which amortizes the removals over the insertions
+    while ((it != m_points.begin()) && (std::prev(it) != m_points.begin())) {
+      const auto prev = std::prev(it);
+      if (!ccw(*std::prev(prev), *prev, pt)) {
+        break;
+      }
+      m_points.erase(prev);
+    }
+    while ((next != m_points.end()) && (std::next(next) != m_points.end())) {
+      if (!ccw(pt, *next, *std::next(next))) {
+        break;
+      }
+      next = m_points.erase(next);
+    }
+    return true;
+  }
+
+  /// \brief Whether a point is on or to the left of the chain, within its lexical range
+  /// \param[in] pt The point to check
+  /// \return True if the point is on the inner side of the chain
+  bool8_t is_inside(const PointT & pt) const
+  {
+    const auto next = m_points.lower_bound(pt);
+    if (next == m_points.end()) {
+      return false;
+    }
+    if (!m_points.key_comp()(pt, *next)) {
+      return true;  // a vertex of the chain
+    }
+    return (next != m_points.begin()) && ccw(*std::prev(next), pt, *next);
+  }
+
+  /// \brief Get the points of the chain
+  /// \return The points, in the order of the chain
+  const Points & points() const noexcept
+  {
+    return m_points;
+  }
+
+  /// \brief Remove all points
+  void clear() noexcept
+  {
+    m_points.clear();
+  }
+
+private:
+  Points m_points;
+};  // class HullChain
 }  // namespace details
 
 /// \brief A static memory implementation of convex hull computation. Shuffles points around the
@@ -187,6 +349,169 @@ typename std::list<PointT>::const_iterator convex_hull(std::list<PointT> & list)
   return (list.size() <= 3U) ? list.end() : details::convex_hull_impl(list);
 }
 
+/// \brief Convex hull computation on a static vector, which does not allocate memory. Same as the
+///        list version otherwise: the points of the convex hull are moved to the front of the
+///        vector in ccw order, starting with the point with the smallest x value, followed by the
+///        internal points in an unspecified order. If there are 3 or fewer points, nothing is done.
+/// \param[inout] points A vector of points that will be reordered into a ccw convex hull
+/// \return An iterator pointing to one after the last point contained in the hull
+/// \tparam PointT Type of a point, must have x and y float members
+/// \tparam CapacityT The capacity of the vector
+template<typename PointT, std::size_t CapacityT>
+typename StaticVector<PointT, CapacityT>::iterator convex_hull(
+  StaticVector<PointT, CapacityT> & points)
+{
+  return (points.size() <= 3U) ? points.end() : details::convex_hull_impl(points);
+}
+
+/// \brief Convex hull computation on a range of points, which writes the hull to a separate
+///        buffer instead of moving it to the front of the range. No memory is allocated, so that
+///        hulls of ranges of a larger container can be computed without copying them out first.
+///
+///        The points of the range are sorted in lexical order. The hull is written in the same
+///        order as by the other versions: ccw, starting with the point with the smallest x value.
+///        If there are 3 or fewer points, they are copied to the output as is.
+/// \param[inout] begin Random access iterator to the first point, the range gets sorted
+/// \param[inout] end Random access iterator to one after the last point
+/// \param[out] hull Random access iterator to a buffer with room for std::distance(begin, end) + 1
+///                  points; the last one is scratch space
+/// \return An iterator pointing to one after the last point of the hull in the output buffer
+/// \tparam IT Iterator type of the points, must have x and y float members
+/// \tparam OutIT Iterator type of the output, its points must be assignable from the input points
+template<typename IT, typename OutIT>
+OutIT convex_hull(const IT begin, const IT end, const OutIT hull)
+{
+  using PointT = typename std::iterator_traits<IT>::value_type;
+  if (std::distance(begin, end) <= 3) {
+    return std::copy(begin, end, hull);
+  }
+  std::sort(begin, end, details::lexical_less<PointT>);
+  std::ptrdiff_t hull_size = 0;
+  const auto pop_while_ccw = [&hull, &hull_size](
+    const std::ptrdiff_t lower_hull_size, const PointT & pt) {
+      while ((hull_size > lower_hull_size) &&
+        ccw(hull[hull_size - 2], hull[hull_size - 1], pt))
+      {
+        --hull_size;
+      }
+    };
+  // lower hull, from left to right
+  for (auto it = begin; it != end; ++it) {
+    pop_while_ccw(1, *it);
+    hull[hull_size] = *it;
+    ++hull_size;
+  }
+  // upper hull, from right to left, closed by the left-most point which is then dropped again
+  const std::ptrdiff_t lower_hull_size = hull_size;
+  for (auto it = std::prev(end); it != begin; ) {
+    --it;
+    pop_while_ccw(lower_hull_size, *it);
+    hull[hull_size] = *it;
+    ++hull_size;
+  }
+  return hull + (hull_size - 1);
+}
+
+/// \brief A convex hull of a set of points that grows as points are added, for example as
+///        detections of an object are accumulated. The hull is kept as the lower and the upper
+///        monotone chain in ordered containers, so that a point is added in amortized O(log n)
+///        instead of recomputing the hull of all points. Points on the boundary which are not
+///        vertices of the hull are not kept.
+/// \tparam PointT Type of a point, must have x and y float members
+template<typename PointT>
+class IncrementalConvexHull
+{
+public:
+  /// \brief Add a point to the hull
+  /// \param[in] pt The point to add, non-finite points are ignored
+  /// \return True if the point is a vertex of the hull now, false if it is inside of the hull
+  bool8_t insert(const PointT & pt)
+  {
+    using point_adapter::x_;
+    using point_adapter::y_;
+    if (!std::isfinite(x_(pt)) || !std::isfinite(y_(pt))) {
+      return false;
+    }
+    // Evaluate both, a point may extend only one of the chains
+    const auto on_lower = m_lower.insert(pt);
+    const auto on_upper = m_upper.insert(pt);
+    return on_lower || on_upper;
+  }
+
+  /// \brief Add a range of points to the hull
+  /// \param[in] begin Iterator to the first point
+  /// \param[in] end Iterator to one after the last point
+  /// \tparam IT Iterator type of the points
+  template<typename IT>
+  void insert(const IT begin, const IT end)
+  {
+    for (auto it = begin; it != end; ++it) {
+      (void)insert(*it);
+    }
+  }
+
+  /// \brief Grow this hull to the convex hull of both hulls, only the vertices of the other hull
+  ///        are added
+  /// \param[in] other The hull to merge into this one
+  void merge(const IncrementalConvexHull & other)
+  {
+    insert(other.m_lower.points().begin(), other.m_lower.points().end());
+    insert(other.m_upper.points().begin(), other.m_upper.points().end());
+  }
+
+  /// \brief Whether a point is inside of or on the boundary of the hull, in O(log n)
+  /// \param[in] pt The point to check
+  /// \return True if the point is contained in the hull
+  bool8_t contains(const PointT & pt) const
+  {
+    return m_lower.is_inside(pt) && m_upper.is_inside(pt);
+  }
+
+  /// \brief Write the vertices of the hull in the same order as convex_hull(): ccw, starting
+  ///        with the point with the smallest x value
+  /// \param[out] out Output iterator, with room for size() points
+  /// \return An iterator pointing to one after the last written point
+  /// \tparam OutIT Iterator type of the output, its points must be assignable from PointT
+  template<typename OutIT>
+  OutIT get_hull(OutIT out) const
+  {
+    const auto & lower = m_lower.points();
+    const auto & upper = m_upper.points();
+    out = std::copy(lower.begin(), lower.end(), out);
+    // The upper chain shares its first and last point with the lower chain
+    if (upper.size() > 2U) {
+      out = std::copy(std::next(upper.begin()), std::prev(upper.end()), out);
+    }
+    return out;
+  }
+
+  /// \brief Get the number of vertices of the hull
+  /// \return The number of vertices
+  std::size_t size() const noexcept
+  {
+    const auto lower_size = m_lower.points().size();
+    return (lower_size < 2U) ? lower_size : ((lower_size + m_upper.points().size()) - 2U);
+  }
+
+  /// \brief Whether no point was added to the hull
+  /// \return True if the hull is empty
+  bool8_t empty() const noexcept
+  {
+    return m_lower.points().empty();
+  }
+
+  /// \brief Remove all points from the hull
+  void clear() noexcept
+  {
+    m_lower.clear();
+    m_upper.clear();
+  }
+
+private:
+  details::HullChain<PointT, true> m_lower;
+  details::HullChain<PointT, false> m_upper;
+};  // class IncrementalConvexHull
+
 }  // namespace geometry
 }  // namespace common
 }  // namespace autoware
@@ -23,6 +23,7 @@
 #include <autoware_auto_msgs/msg/trajectory_point.hpp>
 #include <geometry/convex_hull.hpp>
 #include <geometry/common_2d.hpp>
+#include <geometry/static_vector.hpp>
 
 #include <limits>
 #include <vector>
@@ -84,12 +85,13 @@ std::vector<Line> get_sorted_face_list(const Iter start, const Iter end)
 }
 
 /// \brief Append points of the polygon `internal` that are contained in the polygon `exernal`.
-template<template<typename ...> class Iterable1T, template<typename ...> class Iterable2T,
-  typename PointT>
+/// \tparam Polygon1T, Polygon2T Containers of points with stl style iterators
+/// \tparam ResultT A container of points with push_back, e.g. std::list or StaticVector
+template<typename Polygon1T, typename Polygon2T, typename ResultT>
 void append_contained_points(
-  const Iterable1T<PointT> & external,
-  const Iterable2T<PointT> & internal,
-  std::list<PointT> & result)
+  const Polygon1T & external,
+  const Polygon2T & internal,
+  ResultT & result)
 {
   std::copy_if(
     internal.begin(), internal.end(), std::back_inserter(result),
@@ -99,13 +101,15 @@ void append_contained_points(
 }
 
 /// \brief Append the intersecting points between two polygons into the output list.
-template<template<typename ...> class Iterable1T, template<typename ...> class Iterable2T,
-  typename PointT>
+/// \tparam Polygon1T, Polygon2T Containers of points with stl style iterators
+/// \tparam ResultT A container of points with push_back, e.g. std::list or StaticVector
+template<typename Polygon1T, typename Polygon2T, typename ResultT>
 void append_intersection_points(
-  const Iterable1T<PointT> & polygon1,
-  const Iterable2T<PointT> & polygon2,
-  std::list<PointT> & result)
+  const Polygon1T & polygon1,
+  const Polygon2T & polygon2,
+  ResultT & result)
 {
+  using PointT = typename ResultT::value_type;
   using FloatT = decltype(point_adapter::x_(std::declval<PointT>()));
   using Interval = common::geometry::Interval<float32_t>;
 
@@ -123,6 +127,15 @@ void append_intersection_points(
       return std::max(std::fabs(val), std::max(get_abs_max(i1), get_abs_max(i2)));
     };
 
+  // Same check as for the parallel case in intersection_2d
+  auto is_parallel = [](const auto & e1, const auto & e2) {
+      constexpr auto FEPS = std::numeric_limits<float32_t>::epsilon();
+      const auto u = minus_2d(e1.second, e1.first);
+      const auto v = minus_2d(e2.second, e2.first);
+      return (fabsf(cross_2d(v, u)) < FEPS) &&
+             (fabsf(cross_2d(minus_2d(e1.first, e2.first), u)) >= FEPS);
+    };
+
   // Compare each edge from polygon1 to each edge from polygon2
   for (auto corner1_it = polygon1.begin(); corner1_it != polygon1.end(); ++corner1_it) {
     const auto & edge1 = get_edge(polygon1, corner1_it);
@@ -138,10 +151,6 @@ void append_intersection_points(
     for (auto corner2_it = polygon2.begin(); corner2_it != polygon2.end(); ++corner2_it) {
       try {
         const auto & edge2 = get_edge(polygon2, corner2_it);
-        const auto & intersection =
-          common::geometry::intersection_2d(
-          edge1.first, minus_2d(edge1.second, edge1.first),
-          edge2.first, minus_2d(edge2.second, edge2.first));
 
         Interval edge2_x_interval{
           std::min(point_adapter::x_(edge2.first), point_adapter::x_(edge2.second)),
@@ -151,6 +160,28 @@ void append_intersection_points(
           std::min(point_adapter::y_(edge2.first), point_adapter::y_(edge2.second)),
           std::max(point_adapter::y_(edge2.first), point_adapter::y_(edge2.second))};
 
+        // Pre-reject edges whose bounding intervals are apart by more than the epsilon of the
+        // acceptance test below can tolerate, before intersecting their lines. That epsilon is at
+        // most about twice the one of the bounds, as an accepted point lies within them.
+        const auto bounds_feps = std::max(
+          compute_eps_scale(edge1_x_interval, edge2_x_interval, FloatT{}),
+          compute_eps_scale(edge1_y_interval, edge2_y_interval, FloatT{})) *
+          std::numeric_limits<FloatT>::epsilon();
+        if (!Interval::overlaps(edge1_x_interval, edge2_x_interval, 4.0F * bounds_feps) ||
+          !Interval::overlaps(edge1_y_interval, edge2_y_interval, 4.0F * bounds_feps))
+        {
+          continue;
+        }
+
+        if (is_parallel(edge1, edge2)) {
+          // Skip before intersection_2d throws, exceptions are expensive and allocate memory
+          continue;
+        }
+        const auto & intersection =
+          common::geometry::intersection_2d(
+          edge1.first, minus_2d(edge1.second, edge1.first),
+          edge2.first, minus_2d(edge2.second, edge2.first));
+
         // The accumulated floating point error depends on the magnitudes of each end of the
         // intervals. Hence the upper bound of the absolute magnitude should be taken into account
         // while computing the epsilon.
@@ -176,6 +207,88 @@ void append_intersection_points(
 }
 
 
+/// \brief Check whether the normal of a face separates two sets of points
+/// \param[in] face_first The first point of the face
+/// \param[in] face_second The second point of the face
+/// \param[in] begin1 Start iterator to first list of point types
+/// \param[in] end1   End iterator to first list of point types
+/// \param[in] begin2 Start iterator to second list of point types
+/// \param[in] end2   End iterator to second list of point types
+/// \return true if the projections of the point sets onto the normal do not overlap
+/// \tparam PointT Point type of the face and of the point sets
+/// \tparam Iter1, Iter2 Iterators over PointT
+template<typename PointT, typename Iter1, typename Iter2>
+bool is_separating_face(
+  const PointT & face_first, const PointT & face_second,
+  const Iter1 begin1, const Iter1 end1, const Iter2 begin2, const Iter2 end2)
+{
+  // Compute normal vector to the face and define a closure to get progress along it
+  const auto normal = get_normal(minus_2d(face_second, face_first));
+  auto get_position_along_line = [&normal](auto point)
+    {
+      return dot_2d(normal, minus_2d(point, PointT{}) );
+    };
+
+  // Define a function to get the minimum and maximum projected position of the corners
+  // of a given bounding box along the normal line of the face
+  auto get_projected_min_max = [&get_position_along_line, &normal](auto begin, auto end)
+    {
+      const auto zero_point = PointT{};
+      auto min_corners =
+        get_position_along_line(closest_line_point_2d(normal, zero_point, *begin));
+      auto max_corners = min_corners;
+
+      for (auto & point = begin; point != end; ++point) {
+        const auto point_projected = closest_line_point_2d(normal, zero_point, *point);
+        const auto position_along_line = get_position_along_line(point_projected);
+        min_corners = std::min(min_corners, position_along_line);
+        max_corners = std::max(max_corners, position_along_line);
+      }
+      return std::pair<float, float>{min_corners, max_corners};
+    };
+
+  // Perform the actual computations for the extent computation
+  auto minmax_1 = get_projected_min_max(begin1, end1);
+  auto minmax_2 = get_projected_min_max(begin2, end2);
+
+  // Check for any intersections
+  const auto eps = std::numeric_limits<decltype(minmax_1.first)>::epsilon();
+  return minmax_1.first > minmax_2.second + eps || minmax_2.first > minmax_1.second + eps;
+}
+
+/// \brief Compute the intersection over union of two 2d convex polygons given their intersection
+/// \param polygon1 A convex polygon
+/// \param polygon2 A convex polygon
+/// \param intersection The intersection of both polygons
+/// \return (Intersection / Union) between two given polygons.
+/// \throws std::domain_error If the union has zero area
+template<typename Polygon1T, typename Polygon2T, typename IntersectionT>
+common::types::float32_t intersection_over_union_2d(
+  const Polygon1T & polygon1,
+  const Polygon2T & polygon2,
+  const IntersectionT & intersection)
+{
+  constexpr auto eps = std::numeric_limits<float32_t>::epsilon();
+  const auto intersection_area =
+    common::geometry::area_2d(intersection.begin(), intersection.end());
+
+  if (intersection_area < eps) {
+    return 0.0F;  // There's either no intersection or the points are collinear
+  }
+
+  const auto polygon1_area =
+    common::geometry::area_2d(polygon1.begin(), polygon1.end());
+  const auto polygon2_area =
+    common::geometry::area_2d(polygon2.begin(), polygon2.end());
+
+  const auto union_area = polygon1_area + polygon2_area - intersection_area;
+  if (union_area < eps) {
+    throw std::domain_error("IoU is undefined for polygons with a zero union area");
+  }
+
+  return intersection_area / union_area;
+}
+
 }  // namespace details
 
 // TODO(s.me) implement GJK(+EPA) algorithm as well as per Chris Ho's suggestion
@@ -200,38 +313,7 @@ bool intersect(const Iter begin1, const Iter end1, const Iter begin2, const Iter
 
   // Also look at last line
   for (const auto & face : faces) {
-    // Compute normal vector to the face and define a closure to get progress along it
-    const auto normal = get_normal(minus_2d(face.second, face.first));
-    auto get_position_along_line = [&normal](auto point)
-      {
-        return dot_2d(normal, minus_2d(point, Point{}) );
-      };
-
-    // Define a function to get the minimum and maximum projected position of the corners
-    // of a given bounding box along the normal line of the face
-    auto get_projected_min_max = [&get_position_along_line, &normal](Iter begin, Iter end)
-      {
-        const auto zero_point = Point{};
-        auto min_corners =
-          get_position_along_line(closest_line_point_2d(normal, zero_point, *begin));
-        auto max_corners = min_corners;
-
-        for (auto & point = begin; point != end; ++point) {
-          const auto point_projected = closest_line_point_2d(normal, zero_point, *point);
-          const auto position_along_line = get_position_along_line(point_projected);
-          min_corners = std::min(min_corners, position_along_line);
-          max_corners = std::max(max_corners, position_along_line);
-        }
-        return std::pair<float, float>{min_corners, max_corners};
-      };
-
-    // Perform the actual computations for the extent computation
-    auto minmax_1 = get_projected_min_max(begin1, end1);
-    auto minmax_2 = get_projected_min_max(begin2, end2);
-
-    // Check for any intersections
-    const auto eps = std::numeric_limits<decltype(minmax_1.first)>::epsilon();
-    if (minmax_1.first > minmax_2.second + eps || minmax_2.first > minmax_1.second + eps) {
+    if (details::is_separating_face(face.first, face.second, begin1, end1, begin2, end2)) {
       // Found separating hyperplane, stop
       return false;
     }
@@ -241,6 +323,38 @@ bool intersect(const Iter begin1, const Iter end1, const Iter begin2, const Iter
   return true;
 }
 
+/// \brief Check if two polygons intersect, without allocating memory. Same as the iterator
+///        version otherwise: the polygons are given by arbitrary sets of points
+/// \param[in] polygon1 The points of the first polygon
+/// \param[in] polygon2 The points of the second polygon
+/// \return true if the polygons collide, false otherwise.
+/// \tparam PointT Point type that have the adapters for the x and y fields.
+/// \tparam Capacity1T, Capacity2T Capacities of the vectors
+template<typename PointT, std::size_t Capacity1T, std::size_t Capacity2T>
+bool intersect(
+  const StaticVector<PointT, Capacity1T> & polygon1,
+  const StaticVector<PointT, Capacity2T> & polygon2)
+{
+  auto hull1 = polygon1;
+  const auto hull1_end = convex_hull(hull1);
+  auto hull2 = polygon2;
+  const auto hull2_end = convex_hull(hull2);
+  const auto has_separating_face = [&polygon1, &polygon2](const auto begin, const auto end) {
+      for (auto it = begin; it != end; ++it) {
+        const auto next_it = std::next(it);
+        const auto & next_pt = (next_it != end) ? *next_it : *begin;
+        if (details::is_separating_face(
+            *it, next_pt, polygon1.begin(), polygon1.end(), polygon2.begin(), polygon2.end()))
+        {
+          return true;
+        }
+      }
+      return false;
+    };
+  return !has_separating_face(hull1.begin(), hull1_end) &&
+         !has_separating_face(hull2.begin(), hull2_end);
+}
+
 /// \brief Get the intersection between two polygons. The polygons should be provided in an
 /// identical format to the output of `convex_hull` function as in the corners should be ordered
 /// in a CCW fashion.
@@ -294,27 +408,49 @@ common::types::float32_t convex_intersection_over_union_2d(
   const Iterable2T<PointT> & polygon2
 )
 {
-  constexpr auto eps = std::numeric_limits<float32_t>::epsilon();
   const auto intersection = convex_polygon_intersection2d(polygon1, polygon2);
+  return details::intersection_over_union_2d(polygon1, polygon2, intersection);
+}
 
-  const auto intersection_area =
-    common::geometry::area_2d(intersection.begin(), intersection.end());
-
-  if (intersection_area < eps) {
-    return 0.0F;  // There's either no intersection or the points are collinear
-  }
-
-  const auto polygon1_area =
-    common::geometry::area_2d(polygon1.begin(), polygon1.end());
-  const auto polygon2_area =
-    common::geometry::area_2d(polygon2.begin(), polygon2.end());
-
-  const auto union_area = polygon1_area + polygon2_area - intersection_area;
-  if (union_area < eps) {
-    throw std::domain_error("IoU is undefined for polygons with a zero union area");
-  }
+/// \brief Get the intersection between two convex polygons, without allocating memory. See the
+/// version for stl containers for details.
+/// \tparam PointT Point type that have the adapters for the x and y fields.
+/// \tparam Capacity1T, Capacity2T Capacities of the vectors
+/// \param polygon1 A convex polygon
+/// \param polygon2 A convex polygon
+/// \return The resulting convex polygon. Its capacity is large enough for all corners contained
+///         in the other polygon and all edge intersections.
+template<typename PointT, std::size_t Capacity1T, std::size_t Capacity2T>
+StaticVector<PointT, (Capacity1T + Capacity2T) + (Capacity1T * Capacity2T)>
+convex_polygon_intersection2d(
+  const StaticVector<PointT, Capacity1T> & polygon1,
+  const StaticVector<PointT, Capacity2T> & polygon2)
+{
+  StaticVector<PointT, (Capacity1T + Capacity2T) + (Capacity1T * Capacity2T)> result;
+  details::append_contained_points(polygon1, polygon2, result);
+  details::append_contained_points(polygon2, polygon1, result);
+  details::append_intersection_points(polygon1, polygon2, result);
+  const auto end_it = common::geometry::convex_hull(result);
+  result.resize(static_cast<std::size_t>(std::distance(result.begin(), end_it)));
+  return result;
+}
 
-  return intersection_area / union_area;
+/// \brief Compute the intersection over union of two 2d convex polygons, without allocating
+/// memory. See the version for stl containers for details.
+/// \tparam PointT Point type that have the adapters for the x and y fields.
+/// \tparam Capacity1T, Capacity2T Capacities of the vectors
+/// \param polygon1 A convex polygon
+/// \param polygon2 A convex polygon
+/// \return (Intersection / Union) between two given polygons.
+/// \throws std::domain_error If there is any inconsistency on the undderlying geometrical
+/// computation.
+template<typename PointT, std::size_t Capacity1T, std::size_t Capacity2T>
+common::types::float32_t convex_intersection_over_union_2d(
+  const StaticVector<PointT, Capacity1T> & polygon1,
+  const StaticVector<PointT, Capacity2T> & polygon2)
+{
+  const auto intersection = convex_polygon_intersection2d(polygon1, polygon2);
+  return details::intersection_over_union_2d(polygon1, polygon2, intersection);
 }
 
 }  // namespace geometry
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <sstream>
@@ -30,6 +31,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "common/types.hpp"
 #include "helper_functions/float_comparisons.hpp"
@@ -180,6 +182,12 @@ public:
    */
   static bool is_subset_eq(const Interval & i1, const Interval & i2);
 
+  /**
+   * @brief Test for whether 'i1' and 'i2' overlap, i.e. are apart by at most 'eps'
+   * @return True iff neither interval is empty and the gap between them is at most 'eps'.
+   */
+  static bool overlaps(const Interval & i1, const Interval & i2, const T & eps = T{});
+
   /**
    * @brief Compute the intersection of two intervals as a new interval.
    */
@@ -229,6 +237,139 @@ typedef Interval<autoware::common::types::float32_t> Interval_f;
 
 //------------------------------------------------------------------------------
 
+/**
+ * @brief A set of intervals stored as a structure of arrays, so that one interval or value can
+ * be tested against all of them at once, e.g. in a broad phase before exact geometric tests.
+ *
+ * @note The batch operations evaluate every interval without branching, so that the compiler
+ * can vectorize across intervals. Their results agree with the scalar operations of Interval,
+ * in particular empty intervals never overlap, contain or intersect anything.
+ */
+template<typename T>
+class IntervalArray
+{
+public:
+  /** @brief Remove all intervals, keeping the memory. */
+  void clear() noexcept
+  {
+    mins_.clear();
+    maxs_.clear();
+  }
+
+  /** @brief Reserve memory for a number of intervals. */
+  void reserve(const std::size_t capacity)
+  {
+    mins_.reserve(capacity);
+    maxs_.reserve(capacity);
+  }
+
+  /** @brief Append an interval. */
+  void push_back(const Interval<T> & i)
+  {
+    mins_.push_back(Interval<T>::min(i));
+    maxs_.push_back(Interval<T>::max(i));
+  }
+
+  /** @brief The number of intervals. */
+  std::size_t size() const noexcept {return mins_.size();}
+
+  /** @brief Get an interval by its index, which must be smaller than size(). */
+  Interval<T> operator[](const std::size_t idx) const {return Interval<T>{mins_[idx], maxs_[idx]};}
+
+  /**
+   * @brief Test which intervals overlap 'i' within epsilon, see Interval::overlaps.
+   *
+   * @param[out] result One entry per interval, 1 if it overlaps 'i' and 0 otherwise. Must point
+   * to at least size() elements.
+   */
+  void overlaps(
+    const Interval<T> & i, uint8_t * const result, const T & eps = T{}) const noexcept
+  {
+    const T min = Interval<T>::min(i);
+    const T max = Interval<T>::max(i);
+    const T * const mins = mins_.data();
+    const T * const maxs = maxs_.data();
+    for (std::size_t idx = 0U; idx < mins_.size(); ++idx) {
+      // Comparisons with NaN are false, which rejects empty intervals
+      const bool lower_below = (mins[idx] - max) <= eps;
+      const bool upper_above = (min - maxs[idx]) <= eps;
+      result[idx] = static_cast<uint8_t>(lower_below & upper_above);
+    }
+  }
+
+  /**
+   * @brief Test which intervals contain a value within epsilon, see Interval::contains.
+   *
+   * @param[out] result One entry per interval, 1 if it contains 'value' and 0 otherwise. Must
+   * point to at least size() elements.
+   */
+  void contains(
+    const T & value, uint8_t * const result,
+    const T & eps = std::numeric_limits<T>::epsilon()) const noexcept
+  {
+    const T * const mins = mins_.data();
+    const T * const maxs = maxs_.data();
+    for (std::size_t idx = 0U; idx < mins_.size(); ++idx) {
+      const bool above_min = (mins[idx] - value) <= eps;
+      const bool below_max = (value - maxs[idx]) <= eps;
+      result[idx] = static_cast<uint8_t>(above_min & below_max);
+    }
+  }
+
+  /**
+   * @brief Test which intervals contain 'i', see Interval::is_subset_eq.
+   *
+   * @param[out] result One entry per interval, 1 if 'i' is a subset of it and 0 otherwise. Must
+   * point to at least size() elements.
+   */
+  void contains(const Interval<T> & i, uint8_t * const result) const noexcept
+  {
+    const T min = Interval<T>::min(i);
+    const T max = Interval<T>::max(i);
+    const T * const mins = mins_.data();
+    const T * const maxs = maxs_.data();
+    for (std::size_t idx = 0U; idx < mins_.size(); ++idx) {
+      result[idx] = static_cast<uint8_t>((min >= mins[idx]) & (max <= maxs[idx]));
+    }
+  }
+
+  /**
+   * @brief Compute the intersection of 'i' with each interval, see Interval::intersect.
+   *
+   * @param[out] result The intersections, in the same order. Resized as needed.
+   */
+  void intersect(const Interval<T> & i, IntervalArray & result) const
+  {
+    constexpr T NaN = std::numeric_limits<T>::quiet_NaN();
+    const T min = Interval<T>::min(i);
+    const T max = Interval<T>::max(i);
+    result.mins_.resize(mins_.size());
+    result.maxs_.resize(maxs_.size());
+    const T * const mins = mins_.data();
+    const T * const maxs = maxs_.data();
+    T * const result_mins = result.mins_.data();
+    T * const result_maxs = result.maxs_.data();
+    for (std::size_t idx = 0U; idx < mins_.size(); ++idx) {
+      // std::max/std::min would propagate NaN depending on the argument order
+      const T lower = (mins[idx] > min) ? mins[idx] : min;
+      const T upper = (maxs[idx] < max) ? maxs[idx] : max;
+      // Also false if 'i' is empty, as lower is NaN then, or if the interval is empty
+      const bool non_empty = (lower <= upper) & (mins[idx] <= maxs[idx]);
+      result_mins[idx] = non_empty ? lower : NaN;
+      result_maxs[idx] = non_empty ? upper : NaN;
+    }
+  }
+
+private:
+  std::vector<T> mins_;
+  std::vector<T> maxs_;
+};  // class IntervalArray
+
+typedef IntervalArray<autoware::common::types::float64_t> IntervalArray_d;
+typedef IntervalArray<autoware::common::types::float32_t> IntervalArray_f;
+
+//------------------------------------------------------------------------------
+
 template<typename T>
 constexpr T Interval<T>::NaN;
 
@@ -309,6 +450,17 @@ bool Interval<T>::is_subset_eq(const Interval & i1, const Interval & i2)
 
 //------------------------------------------------------------------------------
 
+template<typename T>
+bool Interval<T>::overlaps(const Interval & i1, const Interval & i2, const T & eps)
+{
+  // Comparisons with NaN are false, which rejects empty intervals
+  const auto lower_below = ((Interval::min(i1) - Interval::max(i2)) <= eps);
+  const auto upper_above = ((Interval::min(i2) - Interval::max(i1)) <= eps);
+  return lower_below && upper_above;
+}
+
+//------------------------------------------------------------------------------
+
 template<typename T>
 bool Interval<T>::contains(const Interval & i, const T & value, const T & eps)
 {
@@ -15,13 +15,16 @@
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
 /// \file
-/// \brief This file contains a 1D linear lookup table implementation
+/// \brief This file contains 1D linear and 2D bilinear lookup table implementations
 
 #ifndef GEOMETRY__LOOKUP_TABLE_HPP_
 #define GEOMETRY__LOOKUP_TABLE_HPP_
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "common/types.hpp"
@@ -33,6 +36,8 @@ namespace common
 {
 namespace helper_functions
 {
+using autoware::common::types::bool8_t;
+using autoware::common::types::float64_t;
 
 namespace
 {
@@ -52,6 +57,15 @@ T interpolate(const T & a, const T & b, U scaling)
   return a + static_cast<T>(offset);
 }
 
+// Index of the first domain value above `value` by binary search
+// Assumes domain.front() < value < domain.back()
+template<typename T>
+std::size_t upper_index(const std::vector<T> & domain, const T value)
+{
+  const auto it = std::upper_bound(domain.begin() + 1, domain.end() - 1, value);
+  return static_cast<std::size_t>(it - domain.begin());
+}
+
 // TODO(c.ho) support more forms of interpolation as template functor
 // Actual lookup logic, assuming all invariants hold:
 // Throw if value is not finite
@@ -69,13 +83,7 @@ T lookup_impl_1d(const std::vector<T> & domain, const std::vector<T> & range, co
     // Fall through to normal case
   }
 
-  auto second_idx{0U};
-  for (auto idx = 1U; idx < domain.size(); ++idx) {
-    if (value < domain[idx]) {
-      second_idx = idx;
-      break;
-    }
-  }
+  const auto second_idx = upper_index(domain, value);
   // T must be a floating point between 0 and 1
   const auto num = static_cast<double>(value - domain[second_idx - 1U]);
   const auto den = static_cast<double>(domain[second_idx] - domain[second_idx - 1U]);
@@ -123,6 +131,101 @@ T lookup_1d(const std::vector<T> & domain, const std::vector<T> & range, const T
   return lookup_impl_1d(domain, range, value);
 }
 
+/// A sorted domain of a lookup table, which brackets query values. A uniformly spaced domain,
+/// such as a calibration map axis, is detected at construction and indexed directly in O(1), other
+/// domains are binary searched
+/// \tparam T The type of the domain
+template<typename T>
+class LookupDomain
+{
+public:
+  /// Constructor
+  /// \param[in] values The sorted domain values
+  /// \throw std::domain_error If the domain is empty
+  /// \throw std::domain_error If the domain is not sorted
+  explicit LookupDomain(std::vector<T> values)
+  : m_values{std::move(values)}
+  {
+    check_table_lookup_invariants(m_values, m_values);
+    if (m_values.size() < 2U) {
+      return;
+    }
+    const auto front = static_cast<float64_t>(m_values.front());
+    const auto num_steps = static_cast<float64_t>(m_values.size() - 1U);
+    const auto step = (static_cast<float64_t>(m_values.back()) - front) / num_steps;
+    m_uniform = true;
+    for (auto idx = 1U; idx < m_values.size(); ++idx) {
+      const auto expected = front + (static_cast<float64_t>(idx) * step);
+      const auto deviation = std::fabs(static_cast<float64_t>(m_values[idx]) - expected);
+      if (deviation > (UNIFORM_TOLERANCE * step)) {
+        m_uniform = false;
+        break;
+      }
+    }
+    m_inv_step = 1.0 / step;
+  }
+
+  /// Bracket a query value by two adjacent domain values. If the query value falls out of the
+  /// domain, both are the corresponding edge of the domain
+  /// \param[in] value The point in the domain to query
+  /// \param[out] lower_idx Index of the domain value at or below the query
+  /// \param[out] upper_idx Index of the domain value above the query
+  /// \return The position of the query between the two domain values, in [0, 1]
+  /// \throw std::domain_error If value is not finite
+  float64_t bracket(const T value, std::size_t & lower_idx, std::size_t & upper_idx) const
+  {
+    if (!std::isfinite(value)) {
+      throw std::domain_error{"Query value is not finite (NAN or INF)"};
+    }
+    if (value <= m_values.front()) {
+      lower_idx = 0U;
+      upper_idx = 0U;
+      return 0.0;
+    } else if (value >= m_values.back()) {
+      lower_idx = m_values.size() - 1U;
+      upper_idx = lower_idx;
+      return 0.0;
+    } else {
+      // Fall through to normal case
+    }
+    upper_idx = m_uniform ? uniform_upper_index(value) : upper_index(m_values, value);
+    lower_idx = upper_idx - 1U;
+    const auto num = static_cast<float64_t>(value - m_values[lower_idx]);
+    const auto den = static_cast<float64_t>(m_values[upper_idx] - m_values[lower_idx]);
+    return num / den;
+  }
+
+  /// Whether the domain is uniformly spaced, and hence indexed directly
+  bool8_t is_uniform() const noexcept {return m_uniform;}
+  /// Get the domain values
+  const std::vector<T> & values() const noexcept {return m_values;}
+
+private:
+  /// Relative deviation from the uniform spacing up to which a domain is indexed directly. The
+  /// index is corrected against the domain values, so this only bounds the correction steps
+  static constexpr float64_t UNIFORM_TOLERANCE = 1.0e-3;
+
+  // Index of the first domain value above `value`, assuming front() < value < back()
+  std::size_t uniform_upper_index(const T value) const
+  {
+    const auto offset =
+      (static_cast<float64_t>(value) - static_cast<float64_t>(m_values.front())) * m_inv_step;
+    auto idx = std::min(static_cast<std::size_t>(offset) + 1U, m_values.size() - 1U);
+    // The spacing is only approximately uniform: step to the exact segment
+    while ((idx > 1U) && (value < m_values[idx - 1U])) {
+      --idx;
+    }
+    while ((idx < (m_values.size() - 1U)) && (value >= m_values[idx])) {
+      ++idx;
+    }
+    return idx;
+  }
+
+  std::vector<T> m_values;
+  bool8_t m_uniform{false};
+  float64_t m_inv_step{0.0};
+};  // class LookupDomain
+
 /// A class wrapping a 1D lookup table. Intended for more frequent lookups. Error checking is pushed
 /// into the constructor and not done in the lookup function call
 /// \tparam T The type of the function, must be interpolatable
@@ -140,7 +243,7 @@ public:
   : m_domain{domain},
     m_range{range}
   {
-    check_table_lookup_invariants(m_domain, m_range);
+    check_table_lookup_invariants(m_domain.values(), m_range);
   }
 
   /// Move constructor
@@ -150,10 +253,10 @@ public:
   /// \throw std::domain_error If range is not the same size as domain
   /// \throw std::domain_error If domain is not sorted
   LookupTable1D(std::vector<T> && domain, std::vector<T> && range)
-  : m_domain{domain},
-    m_range{range}
+  : m_domain{std::move(domain)},
+    m_range{std::move(range)}
   {
-    check_table_lookup_invariants(m_domain, m_range);
+    check_table_lookup_invariants(m_domain.values(), m_range);
   }
 
   /// Do a 1D table lookup
@@ -164,18 +267,118 @@ public:
   /// \throw std::domain_error If value is not finite
   T lookup(const T value) const
   {
-    return lookup_impl_1d(m_domain, m_range, value);
+    std::size_t lower_idx;
+    std::size_t upper_idx;
+    const auto t = m_domain.bracket(value, lower_idx, upper_idx);
+    return static_cast<T>(interpolate(m_range[lower_idx], m_range[upper_idx], t));
+  }
+
+  /// Do a 1D table lookup for each value of a batch
+  /// \param[in] first Start of the points in the domain to query
+  /// \param[in] last End of the points in the domain to query (not included)
+  /// \param[out] out Start of the interpolated values
+  /// \return The end of the interpolated values
+  /// \throw std::domain_error If a value is not finite
+  template<typename InputIt, typename OutputIt>
+  OutputIt lookup(InputIt first, InputIt last, OutputIt out) const
+  {
+    for (; first != last; ++first, ++out) {
+      *out = lookup(*first);
+    }
+    return out;
   }
+
+  /// Whether the domain is uniformly spaced, and hence indexed directly
+  bool8_t is_uniform() const noexcept {return m_domain.is_uniform();}
   /// Get the domain table
-  const std::vector<T> & domain() const noexcept {return m_domain;}
+  const std::vector<T> & domain() const noexcept {return m_domain.values();}
   /// Get the range table
   const std::vector<T> & range() const noexcept {return m_range;}
 
 private:
-  std::vector<T> m_domain;
+  LookupDomain<T> m_domain;
   std::vector<T> m_range;
 };  // class LookupTable1D
 
+/// A class wrapping a 2D bilinear lookup table, e.g. a calibration map from velocity and command
+/// to acceleration. Error checking is pushed into the constructor and not done in the lookup
+/// function call
+/// \tparam T The type of the function, must be interpolatable
+template<typename T>
+class LookupTable2D
+{
+public:
+  /// Constructor
+  /// \param[in] x_domain The first domain, or set of x values, e.g. velocities
+  /// \param[in] y_domain The second domain, or set of y values, e.g. commands
+  /// \param[in] values The set of z values in row-major order: the value at (x_domain[i],
+  ///                   y_domain[j]) is values[i * y_domain.size() + j]
+  /// \throw std::domain_error If a domain is empty or not sorted
+  /// \throw std::domain_error If the size of values is not the product of the domains' sizes
+  LookupTable2D(std::vector<T> x_domain, std::vector<T> y_domain, std::vector<T> values)
+  : m_x_domain{std::move(x_domain)},
+    m_y_domain{std::move(y_domain)},
+    m_values{std::move(values)}
+  {
+    if (m_values.size() != (m_x_domain.values().size() * m_y_domain.values().size())) {
+      throw std::domain_error{"Values' size does not match the product of the domains' sizes"};
+    }
+  }
+
+  /// Do a 2D table lookup
+  /// If a query value falls out of its domain, then the values at the corresponding edge of the
+  /// domain are interpolated.
+  /// \param[in] x The point in the first domain to query
+  /// \param[in] y The point in the second domain to query
+  /// \return A bilinearly interpolated value z, corresponding to the query (x, y)
+  /// \throw std::domain_error If x or y is not finite
+  T lookup(const T x, const T y) const
+  {
+    std::size_t x_lower;
+    std::size_t x_upper;
+    std::size_t y_lower;
+    std::size_t y_upper;
+    const auto tx = m_x_domain.bracket(x, x_lower, x_upper);
+    const auto ty = m_y_domain.bracket(y, y_lower, y_upper);
+    const auto lower = interpolate(value(x_lower, y_lower), value(x_lower, y_upper), ty);
+    const auto upper = interpolate(value(x_upper, y_lower), value(x_upper, y_upper), ty);
+    return static_cast<T>(interpolate(lower, upper, tx));
+  }
+
+  /// Do a 2D table lookup for each point of a batch
+  /// \param[in] x_first Start of the points in the first domain to query
+  /// \param[in] x_last End of the points in the first domain to query (not included)
+  /// \param[in] y_first Start of the points in the second domain to query, as many as x values
+  /// \param[out] out Start of the interpolated values
+  /// \return The end of the interpolated values
+  /// \throw std::domain_error If a value is not finite
+  template<typename InputIt, typename OutputIt>
+  OutputIt lookup(InputIt x_first, InputIt x_last, InputIt y_first, OutputIt out) const
+  {
+    for (; x_first != x_last; ++x_first, ++y_first, ++out) {
+      *out = lookup(*x_first, *y_first);
+    }
+    return out;
+  }
+
+  /// Get the first domain table
+  const std::vector<T> & x_domain() const noexcept {return m_x_domain.values();}
+  /// Get the second domain table
+  const std::vector<T> & y_domain() const noexcept {return m_y_domain.values();}
+  /// Get the values table, in row-major order
+  const std::vector<T> & values() const noexcept {return m_values;}
+
+private:
+  const T & value(const std::size_t x_idx, const std::size_t y_idx) const
+  {
+    return m_values[(x_idx * m_y_domain.values().size()) + y_idx];
+  }
+
+  LookupDomain<T> m_x_domain;
+  LookupDomain<T> m_y_domain;
+  std::vector<T> m_values;
+};  // class LookupTable2D
+
 }  // namespace helper_functions
 }  // namespace common
 }  // namespace autoware
@@ -23,6 +23,8 @@
 #include <common/types.hpp>
 #include <geometry/spatial_hash_config.hpp>
 #include <geometry/visibility_control.hpp>
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 #include <unordered_map>
 #include <utility>
@@ -108,6 +110,52 @@ private:
   };  // class Output
   using OutputVector = typename std::vector<Output>;
 
+  /// \brief Contiguous view of the points stored in one bin, see for_each_bin_pair
+  class BinView
+  {
+public:
+    /// \brief Constructor
+    /// \param[in] begin Pointer to the first point of the bin
+    /// \param[in] end Pointer past the last point of the bin
+    /// \param[in] bin The index of the bin
+    BinView(const PointT * const begin, const PointT * const end, const Index bin)
+    : m_begin(begin),
+      m_end(end),
+      m_bin(bin)
+    {
+    }
+    /// \brief Get pointer to the first point of the bin
+    const PointT * begin() const
+    {
+      return m_begin;
+    }
+    /// \brief Get pointer past the last point of the bin
+    const PointT * end() const
+    {
+      return m_end;
+    }
+    /// \brief Get the number of points in the bin
+    Index size() const
+    {
+      return static_cast<Index>(m_end - m_begin);
+    }
+    /// \brief Get a point of the bin, no bounds checking is done
+    const PointT & operator[](const Index idx) const
+    {
+      return m_begin[idx];
+    }
+    /// \brief Get the index of the bin
+    Index bin() const
+    {
+      return m_bin;
+    }
+
+private:
+    const PointT * m_begin;
+    const PointT * m_end;
+    Index m_bin;
+  };  // class BinView
+
   /// \brief Constructor
   /// \param[in] cfg The configuration object for this class
   explicit SpatialHashBase(const ConfigT & cfg)
@@ -229,6 +277,51 @@ private:
     return m_neighbors_found;
   }
 
+  /// \brief Visits all pairs of occupied bins which could hold two points within a radius of
+  ///        each other. This replaces one near() query per point for bulk neighborhood processing
+  /// \param[in] radius The radius within which points are considered near
+  /// \param[in] f Called as f(const BinView & a, const BinView & b). Each unordered pair of bins is
+  ///              visited exactly once. Each occupied bin is also paired with itself, in which case
+  ///              a and b refer to the same bin
+  /// \tparam FunctorT The type of the callable
+  /// \throw std::domain_error If the radius is negative or NaN
+  ///
+  /// The stored points are first copied to an array sorted by bin, so that the points of each bin
+  /// are contiguous. Distances between points are not checked, which is left to f. The views are
+  /// invalidated by the next call to this method.
+  template<typename FunctorT>
+  void for_each_bin_pair(const float32_t radius, FunctorT && f)
+  {
+    if (!(radius >= 0.0F)) {
+      throw std::domain_error{"SpatialHash: radius for bin pairs must be non-negative"};
+    }
+    compact_bins();
+    const float32_t radius2 = radius * radius;
+    const auto key_less = [](const CompactBin & bin, const Index key) {return bin.key < key;};
+    for (auto ref_it = m_bins.cbegin(); ref_it != m_bins.cend(); ++ref_it) {
+      const BinView ref_view = make_view(*ref_it);
+      const details::BinRange idx_range = m_config.bin_range(ref_it->index3, radius);
+      // Bins within a row along the x axis have consecutive keys, so each row is one search
+      Index3 row = idx_range.first;
+      do {
+        Index3 row_end = row;
+        row_end.x = idx_range.second.x;
+        // Bins with a smaller key were paired with the reference bin already
+        const Index first_key = std::max(m_config.index(row), ref_it->key);
+        const Index last_key = m_config.index(row_end);
+        for (auto it = std::lower_bound(ref_it, m_bins.cend(), first_key, key_less);
+          (it != m_bins.cend()) && (it->key <= last_key); ++it)
+        {
+          ++m_bins_hit;
+          if (m_config.is_candidate_bin(ref_it->index3, it->index3, radius2)) {
+            f(ref_view, make_view(*it));
+          }
+        }
+        row = row_end;
+      } while (m_config.next_bin(idx_range, row));
+    }
+  }
+
 protected:
   /// \brief Finds all points within a fixed radius of a reference point
   /// \param[in] x The x component of the reference point
@@ -276,6 +369,57 @@ protected:
   }
 
 private:
+  /// \brief Occupied bin in the array of points sorted by bin
+  struct CompactBin
+  {
+    Index key;
+    Index3 index3;
+    IT first;
+    Index begin;
+    Index end;
+  };  // struct CompactBin
+
+  /// \brief Copies the stored points into an array sorted by bin
+  GEOMETRY_LOCAL void compact_bins()
+  {
+    // Only allocates on first use, so that users of near() alone do not pay for the extra memory
+    m_bins.reserve(capacity());
+    m_bin_points.reserve(capacity());
+    m_bins.clear();
+    m_bin_points.clear();
+    // Equal keys are adjacent in the multimap, so points only need to be copied once
+    for (auto it = m_hash.cbegin(); it != m_hash.cend(); ++it) {
+      if (m_bins.empty() || (m_bins.back().key != it->first)) {
+        const PointT & pt = it->second;
+        m_bins.push_back(
+          {it->first,
+            m_config.index3(point_adapter::x_(pt), point_adapter::y_(pt), point_adapter::z_(pt)),
+            it, 0U, 0U});
+      }
+      ++m_bins.back().end;
+    }
+    std::sort(
+      m_bins.begin(), m_bins.end(),
+      [](const CompactBin & a, const CompactBin & b) {return a.key < b.key;});
+    for (auto & bin : m_bins) {
+      const Index count = bin.end;
+      bin.begin = m_bin_points.size();
+      bin.end = bin.begin + count;
+      auto it = bin.first;
+      for (Index idx = 0U; idx < count; ++idx) {
+        m_bin_points.push_back(it->second);
+        ++it;
+      }
+    }
+  }
+
+  /// \brief Creates the view of a compacted bin
+  GEOMETRY_LOCAL BinView make_view(const CompactBin & bin) const
+  {
+    const PointT * const data = m_bin_points.data();
+    return BinView{data + bin.begin, data + bin.end, bin.key};
+  }
+
   /// \brief Internal insert method with no error checking
   /// \param[in] pt The Point to insert
   GEOMETRY_LOCAL IT insert_impl(const PointT & pt)
@@ -292,6 +436,8 @@ private:
   OutputVector m_neighbors;
   Index m_bins_hit;
   Index m_neighbors_found;
+  std::vector<CompactBin> m_bins;
+  std::vector<PointT> m_bin_points;
 };  // class SpatialHashBase
 
 /// \brief The class to be used for specializing on
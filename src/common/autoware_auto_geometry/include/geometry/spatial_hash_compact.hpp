@@ -0,0 +1,416 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// \file
+/// \brief This file implements a compact spatial hash for fixed-radius near neighbor queries on
+///        point sets which are built once and queried many times
+
+#ifndef GEOMETRY__SPATIAL_HASH_COMPACT_HPP_
+#define GEOMETRY__SPATIAL_HASH_COMPACT_HPP_
+
+#include <common/types.hpp>
+#include <geometry/spatial_hash_config.hpp>
+#include <geometry/visibility_control.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace autoware
+{
+namespace common
+{
+namespace geometry
+{
+namespace spatial_hash
+{
+
+/// \brief A variant of the spatial hash which stores the points in a single array sorted by bin,
+///        with an array of offsets to the start of each bin (compressed sparse row layout).
+/// \tparam PointT The point type stored in this data structure. Must have float members x, y, and z
+///                and be default constructible
+///
+/// Points do not go into bins when they are inserted, but when the next query is made. Binning is a
+/// counting sort, which is O(n + b) for b bins. All memory is allocated on construction. This fits
+/// the use case of inserting a whole scan, querying it and clearing the data structure again.
+/// Individual points cannot be erased. The offset array has one entry per bin of the configured
+/// area, so the area should not be much larger than needed.
+template<typename PointT, typename ConfigT>
+class GEOMETRY_PUBLIC SpatialHashCompactBase
+{
+  using Index3 = details::Index3;
+  //lint -e{9131} NOLINT There's no other way to make this work in a static assert
+  static_assert(
+    std::is_same<ConfigT, Config2d>::value || std::is_same<ConfigT, Config3d>::value,
+    "SpatialHashCompact only works with Config2d or Config3d");
+
+public:
+  using IT = typename std::vector<PointT>::const_iterator;
+  /// \brief Wrapper around a stored point and a distance (from some query point)
+  class Output
+  {
+public:
+    /// \brief Constructor
+    /// \param[in] point A pointer to some stored point
+    /// \param[in] index The index of the point in the sorted point array
+    /// \param[in] distance The euclidean distance (2d or 3d) to a reference point
+    Output(const PointT * const point, const Index index, const float32_t distance)
+    : m_point(point),
+      m_index(index),
+      m_distance(distance)
+    {
+    }
+    /// \brief Get stored point
+    /// \return A const reference to the stored point
+    const PointT & get_point() const
+    {
+      return *m_point;
+    }
+    /// \brief Get the position of the point in the data structure, i.e. its distance from begin()
+    /// \return The index of the point, valid until the next insertion or clear
+    Index get_index() const
+    {
+      return m_index;
+    }
+    /// \brief Convert to underlying point
+    /// \return A reference to the underlying point
+    operator const PointT &() const
+    {
+      return get_point();
+    }
+    /// \brief Get distance to reference point
+    /// \return The distance
+    float32_t get_distance() const
+    {
+      return m_distance;
+    }
+
+private:
+    const PointT * m_point;
+    Index m_index;
+    float32_t m_distance;
+  };  // class Output
+  using OutputVector = typename std::vector<Output>;
+
+  /// \brief Constructor, allocates all memory needed for the configured capacity
+  /// \param[in] cfg The configuration object for this class
+  explicit SpatialHashCompactBase(const ConfigT & cfg)
+  : m_config{cfg},
+    m_offsets(cfg.get_num_bins() + 1U, 0U),
+    m_binned{true},
+    m_bins_hit{},  // zero initialization (and below)
+    m_neighbors_found{}
+  {
+    m_points.reserve(capacity());
+    m_keys.reserve(capacity());
+    m_sorted_points.resize(capacity());
+    m_sorted_keys.resize(capacity());
+    m_neighbors.reserve(capacity());
+  }
+
+  /// \brief Inserts point
+  /// \param[in] pt The Point to insert
+  /// \throw std::length_error If the data structure is at capacity
+  void insert(const PointT & pt)
+  {
+    if (size() >= capacity()) {
+      throw std::length_error{"SpatialHashCompact: Cannot insert past capacity"};
+    }
+    insert_impl(pt);
+  }
+
+  /// \brief Inserts a range of points
+  /// \param[in] begin The start of the range of points to insert
+  /// \param[in] end The end of the range of points to insert
+  /// \tparam IteratorT The iterator type
+  /// \throw std::length_error If the range of points to insert exceeds the data structure's
+  ///                          capacity
+  template<typename IteratorT>
+  void insert(IteratorT begin, IteratorT end)
+  {
+    // This check is here for strong exception safety
+    if ((size() + static_cast<Index>(std::distance(begin, end))) > capacity()) {
+      throw std::length_error{"SpatialHashCompact: Cannot multi-insert past capacity"};
+    }
+    for (IteratorT it = begin; it != end; ++it) {
+      insert_impl(*it);
+    }
+  }
+
+  /// \brief Reset the state of the data structure
+  void clear()
+  {
+    m_points.clear();
+    m_keys.clear();
+    m_binned = false;
+  }
+  /// \brief Get current number of element stored in this data structure
+  /// \return Number of stored elements
+  Index size() const
+  {
+    return m_points.size();
+  }
+  /// \brief Get the maximum capacity of the data structure
+  /// \return The capacity of the data structure
+  Index capacity() const
+  {
+    return m_config.get_capacity();
+  }
+  /// \brief Whether the hash is empty
+  /// \return True if data structure is empty
+  bool8_t empty() const
+  {
+    return m_points.empty();
+  }
+  /// \brief Get iterator to beginning of data structure. Points are in bin order after a query
+  /// \return Iterator
+  IT begin() const
+  {
+    return m_points.begin();
+  }
+  /// \brief Get iterator to end of data structure
+  /// \return Iterator
+  IT end() const
+  {
+    return m_points.end();
+  }
+  /// \brief Get iterator to beginning of data structure
+  /// \return Iterator
+  IT cbegin() const
+  {
+    return begin();
+  }
+  /// \brief Get iterator to end of data structure
+  /// \return Iterator
+  IT cend() const
+  {
+    return end();
+  }
+
+  /// \brief Get the number of bins touched during the lifetime of this object, for debugging and
+  ///        size tuning
+  /// \return The total number of bins touched during near() queries
+  Index bins_hit() const
+  {
+    return m_bins_hit;
+  }
+
+  /// \brief Get number of near neighbors found during the lifetime of this object, for debugging
+  ///        and size tuning
+  /// \return The total number of neighbors found during near() queries
+  Index neighbors_found() const
+  {
+    return m_neighbors_found;
+  }
+
+protected:
+  /// \brief Finds all points within a fixed radius of a reference point
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] z The z component of the reference point, respected only if the spatial hash is not
+  ///              2D.
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to a vector containing all points within the radius, and the
+  ///         actual distance to the reference point
+  const OutputVector & near_impl(
+    const float32_t x,
+    const float32_t y,
+    const float32_t z,
+    const float32_t radius)
+  {
+    if (!m_binned) {
+      sort_into_bins();
+    }
+    // reset output
+    m_neighbors.clear();
+    // Compute bin, bin range
+    const Index3 ref_idx = m_config.index3(x, y, z);
+    const float32_t radius2 = radius * radius;
+    const details::BinRange idx_range = m_config.bin_range(ref_idx, radius);
+    Index3 idx = idx_range.first;
+    // For bins in radius
+    do {  // guaranteed to have at least the bin ref_idx is in
+      // update book-keeping
+      ++m_bins_hit;
+      // Iterating in a square/cube pattern is easier than constructing sphere pattern
+      if (m_config.is_candidate_bin(ref_idx, idx, radius2)) {
+        // For point in bin
+        const Index jdx = m_config.index(idx);
+        for (Index pdx = m_offsets[jdx]; pdx < m_offsets[jdx + 1U]; ++pdx) {
+          const auto & pt = m_points[pdx];
+          const float32_t dist2 = m_config.distance_squared(x, y, z, pt);
+          if (dist2 <= radius2) {
+            // Only compute true distance if necessary
+            m_neighbors.emplace_back(&pt, pdx, sqrtf(dist2));
+          }
+        }
+      }
+    } while (m_config.next_bin(idx_range, idx));
+    // update book-keeping
+    m_neighbors_found += m_neighbors.size();
+    return m_neighbors;
+  }
+
+private:
+  /// \brief Internal insert method with no error checking
+  /// \param[in] pt The Point to insert
+  GEOMETRY_LOCAL void insert_impl(const PointT & pt)
+  {
+    m_keys.push_back(
+      m_config.bin(point_adapter::x_(pt), point_adapter::y_(pt), point_adapter::z_(pt)));
+    m_points.push_back(pt);
+    m_binned = false;
+  }
+
+  /// \brief Counting sort of all points by bin, computes the offset of each bin. The sort is
+  ///        stable, so inserting the same points always results in the same order
+  GEOMETRY_LOCAL void sort_into_bins()
+  {
+    // Count points per bin, offsets[key + 1] holds the count of bin key
+    std::fill(m_offsets.begin(), m_offsets.end(), 0U);
+    for (const Index key : m_keys) {
+      ++m_offsets[key + 1U];
+    }
+    for (Index key = 1U; key < m_offsets.size(); ++key) {
+      m_offsets[key] += m_offsets[key - 1U];
+    }
+    // Scatter, using offsets[key] as the write position of bin key; afterwards offsets[key] is the
+    // end of bin key, so it is shifted back by one bin
+    for (Index pdx = 0U; pdx < m_points.size(); ++pdx) {
+      const Index key = m_keys[pdx];
+      const Index dst = m_offsets[key];
+      m_sorted_points[dst] = m_points[pdx];
+      m_sorted_keys[dst] = key;
+      ++m_offsets[key];
+    }
+    for (Index key = m_offsets.size() - 1U; key > 0U; --key) {
+      m_offsets[key] = m_offsets[key - 1U];
+    }
+    m_offsets[0U] = 0U;
+    std::copy(
+      m_sorted_points.begin(),
+      m_sorted_points.begin() + static_cast<std::ptrdiff_t>(m_points.size()),
+      m_points.begin());
+    std::copy(
+      m_sorted_keys.begin(),
+      m_sorted_keys.begin() + static_cast<std::ptrdiff_t>(m_keys.size()),
+      m_keys.begin());
+    m_binned = true;
+  }
+
+  const ConfigT m_config;
+  std::vector<PointT> m_points;
+  std::vector<Index> m_keys;
+  std::vector<PointT> m_sorted_points;
+  std::vector<Index> m_sorted_keys;
+  std::vector<Index> m_offsets;
+  bool8_t m_binned;
+  OutputVector m_neighbors;
+  Index m_bins_hit;
+  Index m_neighbors_found;
+};  // class SpatialHashCompactBase
+
+/// \brief The class to be used for specializing on SpatialHashCompactBase to provide different
+/// function signatures on 2D and 3D configurations
+/// \tparam PointT The point type stored in this data structure. Must have float members x, y and z
+template<typename PointT, typename ConfigT>
+class GEOMETRY_PUBLIC SpatialHashCompact;
+
+/// \brief Explicit specialization of SpatialHashCompact for 2D configuration
+/// \tparam PointT The point type stored in this data structure.
+template<typename PointT>
+class GEOMETRY_PUBLIC SpatialHashCompact<PointT, Config2d>
+  : public SpatialHashCompactBase<PointT, Config2d>
+{
+public:
+  using OutputVector = typename SpatialHashCompactBase<PointT, Config2d>::OutputVector;
+
+  explicit SpatialHashCompact(const Config2d & cfg)
+  : SpatialHashCompactBase<PointT, Config2d>(cfg) {}
+
+  /// \brief Finds all points within a fixed radius of a reference point
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to a vector containing all points within the radius, and the
+  ///         actual distance to the reference point
+  const OutputVector & near(
+    const float32_t x,
+    const float32_t y,
+    const float32_t radius)
+  {
+    return this->near_impl(x, y, 0.0F, radius);
+  }
+
+  /// \brief Finds all points within a fixed radius of a reference point
+  /// \param[in] pt The reference point. Only the x and y members are respected.
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to a vector containing all points within the radius, and the
+  ///         actual distance to the reference point
+  const OutputVector & near(const PointT & pt, const float32_t radius)
+  {
+    return near(point_adapter::x_(pt), point_adapter::y_(pt), radius);
+  }
+};
+
+/// \brief Explicit specialization of SpatialHashCompact for 3D configuration
+/// \tparam PointT The point type stored in this data structure. Must have float members x, y and z
+template<typename PointT>
+class GEOMETRY_PUBLIC SpatialHashCompact<PointT, Config3d>
+  : public SpatialHashCompactBase<PointT, Config3d>
+{
+public:
+  using OutputVector = typename SpatialHashCompactBase<PointT, Config3d>::OutputVector;
+
+  explicit SpatialHashCompact(const Config3d & cfg)
+  : SpatialHashCompactBase<PointT, Config3d>(cfg) {}
+
+  /// \brief Finds all points within a fixed radius of a reference point
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] z The z component of the reference point
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to a vector containing all points within the radius, and the
+  ///         actual distance to the reference point
+  const OutputVector & near(
+    const float32_t x,
+    const float32_t y,
+    const float32_t z,
+    const float32_t radius)
+  {
+    return this->near_impl(x, y, z, radius);
+  }
+
+  /// \brief Finds all points within a fixed radius of a reference point
+  /// \param[in] pt The reference point.
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to a vector containing all points within the radius, and the
+  ///         actual distance to the reference point
+  const OutputVector & near(const PointT & pt, const float32_t radius)
+  {
+    return near(
+      point_adapter::x_(pt), point_adapter::y_(pt), point_adapter::z_(pt),
+      radius);
+  }
+};
+
+template<typename T>
+using SpatialHashCompact2d = SpatialHashCompact<T, Config2d>;
+template<typename T>
+using SpatialHashCompact3d = SpatialHashCompact<T, Config3d>;
+}  // namespace spatial_hash
+}  // namespace geometry
+}  // namespace common
+}  // namespace autoware
+
+#endif  // GEOMETRY__SPATIAL_HASH_COMPACT_HPP_
@@ -188,6 +188,13 @@ public:
     return m_side_length2;
   }
 
+  /// \brief Get the total number of bins, i.e. one more than the largest composed bin index
+  /// \return The number of bins
+  Index get_num_bins() const
+  {
+    return m_z_stride * (m_max_z_idx + 1U);
+  }
+
   ////////////////////////////////////////////////////////////////////////////////////////////
   // "Polymorphic" API
   /// \brief Compute the single index given a point
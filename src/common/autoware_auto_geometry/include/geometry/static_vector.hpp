@@ -0,0 +1,238 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+/// \file
+/// \brief This file defines a vector with fixed capacity and inline storage
+
+#ifndef GEOMETRY__STATIC_VECTOR_HPP_
+#define GEOMETRY__STATIC_VECTOR_HPP_
+
+#include <common/types.hpp>
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace autoware
+{
+namespace common
+{
+namespace geometry
+{
+using autoware::common::types::bool8_t;
+
+/// \brief A vector with a fixed capacity which stores its elements inline, e.g. on the stack.
+///        Intended for small polygons such as boxes and the convex hulls of small point sets,
+///        so that geometric computations on them do not allocate memory. Elements beyond the
+///        size are default constructed and hold unspecified values.
+/// \tparam T The element type, must be default constructible and copy assignable
+/// \tparam CapacityT The maximum number of elements
+template<typename T, std::size_t CapacityT>
+class StaticVector
+{
+  static_assert(CapacityT > 0U, "StaticVector must have a positive capacity");
+  using Storage = std::array<T, CapacityT>;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = typename Storage::iterator;
+  using const_iterator = typename Storage::const_iterator;
+
+  /// \brief Constructs an empty vector
+  StaticVector()
+  : m_data{},
+    m_size(0U)
+  {
+  }
+
+  /// \brief Constructs a vector from a list of elements
+  /// \param[in] elements The elements of the vector
+  /// \throw std::length_error If there are more elements than the capacity
+  StaticVector(std::initializer_list<T> elements)
+  : StaticVector(elements.begin(), elements.end())
+  {
+  }
+
+  /// \brief Constructs a vector from a range of elements
+  /// \param[in] begin An iterator pointing to the first element
+  /// \param[in] end An iterator pointing to one past the last element
+  /// \tparam IT An iterator type dereferencable into T
+  /// \throw std::length_error If there are more elements than the capacity
+  template<typename IT>
+  StaticVector(const IT begin, const IT end)
+  : StaticVector()
+  {
+    for (auto it = begin; it != end; ++it) {
+      push_back(*it);
+    }
+  }
+
+  /// \brief Appends an element
+  /// \param[in] value The element to append
+  /// \throw std::length_error If the vector is full
+  void push_back(const T & value)
+  {
+    if (m_size >= CapacityT) {
+      throw std::length_error{"StaticVector: capacity exceeded"};
+    }
+    m_data[m_size] = value;
+    ++m_size;
+  }
+
+  /// \brief Removes the last element; the vector must not be empty
+  void pop_back()
+  {
+    --m_size;
+  }
+
+  /// \brief Shrinks or grows the vector; new elements hold unspecified values
+  /// \param[in] size The new size
+  /// \throw std::length_error If the size is larger than the capacity
+  void resize(const size_type size)
+  {
+    if (size > CapacityT) {
+      throw std::length_error{"StaticVector: capacity exceeded"};
+    }
+    m_size = size;
+  }
+
+  /// \brief Removes all elements
+  void clear() noexcept
+  {
+    m_size = 0U;
+  }
+
+  /// \brief Get the number of elements
+  /// \return The number of elements
+  size_type size() const noexcept
+  {
+    return m_size;
+  }
+
+  /// \brief Get the maximum number of elements
+  /// \return The capacity
+  static constexpr size_type capacity() noexcept
+  {
+    return CapacityT;
+  }
+
+  /// \brief Whether there are no elements
+  /// \return True if the vector is empty
+  bool8_t empty() const noexcept
+  {
+    return 0U == m_size;
+  }
+
+  /// \brief Get an element; the index must be smaller than the size
+  /// \param[in] idx The index of the element
+  /// \return A reference to the element
+  reference operator[](const size_type idx)
+  {
+    return m_data[idx];
+  }
+
+  /// \brief Get an element; the index must be smaller than the size
+  /// \param[in] idx The index of the element
+  /// \return A const reference to the element
+  const_reference operator[](const size_type idx) const
+  {
+    return m_data[idx];
+  }
+
+  /// \brief Get the first element; the vector must not be empty
+  /// \return A reference to the element
+  reference front()
+  {
+    return m_data[0U];
+  }
+
+  /// \brief Get the first element; the vector must not be empty
+  /// \return A const reference to the element
+  const_reference front() const
+  {
+    return m_data[0U];
+  }
+
+  /// \brief Get the last element; the vector must not be empty
+  /// \return A reference to the element
+  reference back()
+  {
+    return m_data[m_size - 1U];
+  }
+
+  /// \brief Get the last element; the vector must not be empty
+  /// \return A const reference to the element
+  const_reference back() const
+  {
+    return m_data[m_size - 1U];
+  }
+
+  /// \brief Get an iterator to the first element
+  /// \return The iterator
+  iterator begin() noexcept
+  {
+    return m_data.begin();
+  }
+
+  /// \brief Get an iterator to one past the last element
+  /// \return The iterator
+  iterator end() noexcept
+  {
+    return m_data.begin() + static_cast<std::ptrdiff_t>(m_size);
+  }
+
+  /// \brief Get an iterator to the first element
+  /// \return The iterator
+  const_iterator begin() const noexcept
+  {
+    return m_data.cbegin();
+  }
+
+  /// \brief Get an iterator to one past the last element
+  /// \return The iterator
+  const_iterator end() const noexcept
+  {
+    return m_data.cbegin() + static_cast<std::ptrdiff_t>(m_size);
+  }
+
+  /// \brief Get an iterator to the first element
+  /// \return The iterator
+  const_iterator cbegin() const noexcept
+  {
+    return begin();
+  }
+
+  /// \brief Get an iterator to one past the last element
+  /// \return The iterator
+  const_iterator cend() const noexcept
+  {
+    return end();
+  }
+
+private:
+  Storage m_data;
+  size_type m_size;
+};  // class StaticVector
+
+}  // namespace geometry
+}  // namespace common
+}  // namespace autoware
+
+#endif  // GEOMETRY__STATIC_VECTOR_HPP_
@@ -0,0 +1,146 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <geometry/bounding_box/box_overlap.hpp>
+#include <geometry/convex_hull.hpp>
+#include <geometry/intersection.hpp>
+
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+namespace autoware
+{
+namespace common
+{
+namespace geometry
+{
+namespace bounding_box
+{
+////////////////////////////////////////////////////////////////////////////////
+void BoxArray::assign(const std::vector<BoundingBox> & boxes)
+{
+  const auto size = boxes.size();
+  m_cx.resize(size);
+  m_cy.resize(size);
+  m_ax.resize(size);
+  m_ay.resize(size);
+  m_bx.resize(size);
+  m_by.resize(size);
+  m_radius.resize(size);
+  m_corners.resize(size);
+  for (std::size_t idx = 0U; idx < size; ++idx) {
+    const auto & corners = boxes[idx].corners;
+    m_cx[idx] = (corners[0U].x + corners[2U].x) * 0.5F;
+    m_cy[idx] = (corners[0U].y + corners[2U].y) * 0.5F;
+    m_ax[idx] = (corners[1U].x - corners[0U].x) * 0.5F;
+    m_ay[idx] = (corners[1U].y - corners[0U].y) * 0.5F;
+    m_bx[idx] = (corners[2U].x - corners[1U].x) * 0.5F;
+    m_by[idx] = (corners[2U].y - corners[1U].y) * 0.5F;
+    m_radius[idx] = sqrtf(
+      (m_ax[idx] * m_ax[idx]) + (m_ay[idx] * m_ay[idx]) +
+      (m_bx[idx] * m_bx[idx]) + (m_by[idx] * m_by[idx]));
+    auto & hull = m_corners[idx];
+    hull.clear();
+    for (const auto & corner : corners) {
+      hull.push_back(corner);
+    }
+    const auto hull_end = convex_hull(hull);
+    hull.resize(static_cast<std::size_t>(std::distance(hull.begin(), hull_end)));
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t BoxArray::size() const noexcept
+{
+  return m_cx.size();
+}
+////////////////////////////////////////////////////////////////////////////////
+void overlap_row(
+  const BoxArray & boxes1,
+  const std::size_t idx,
+  const BoxArray & boxes2,
+  uint8_t * const result)
+{
+  const float32_t cx = boxes1.m_cx[idx];
+  const float32_t cy = boxes1.m_cy[idx];
+  const float32_t ax = boxes1.m_ax[idx];
+  const float32_t ay = boxes1.m_ay[idx];
+  const float32_t bx = boxes1.m_bx[idx];
+  const float32_t by = boxes1.m_by[idx];
+  const float32_t radius = boxes1.m_radius[idx];
+  const float32_t * const cx2 = boxes2.m_cx.data();
+  const float32_t * const cy2 = boxes2.m_cy.data();
+  const float32_t * const ax2 = boxes2.m_ax.data();
+  const float32_t * const ay2 = boxes2.m_ay.data();
+  const float32_t * const bx2 = boxes2.m_bx.data();
+  const float32_t * const by2 = boxes2.m_by.data();
+  const float32_t * const radius2 = boxes2.m_radius.data();
+  const std::size_t size = boxes2.size();
+  for (std::size_t jdx = 0U; jdx < size; ++jdx) {
+    const float32_t tx = cx2[jdx] - cx;
+    const float32_t ty = cy2[jdx] - cy;
+    // Enclosing circles
+    const float32_t max_dist = radius + radius2[jdx];
+    const bool8_t far = ((tx * tx) + (ty * ty)) > (max_dist * max_dist);
+    // Separating axes: for rectangles, the edge directions are the face normals. The box extents
+    // projected onto an axis are the sum of the projected half edges
+    const auto is_separating = [&](const float32_t nx, const float32_t ny) {
+        const float32_t extent =
+          fabsf((ax * nx) + (ay * ny)) + fabsf((bx * nx) + (by * ny)) +
+          fabsf((ax2[jdx] * nx) + (ay2[jdx] * ny)) + fabsf((bx2[jdx] * nx) + (by2[jdx] * ny));
+        return fabsf((tx * nx) + (ty * ny)) > extent;
+      };
+    const bool8_t separated =
+      is_separating(ax, ay) | is_separating(bx, by) |
+      is_separating(ax2[jdx], ay2[jdx]) | is_separating(bx2[jdx], by2[jdx]);
+    result[jdx] = (far | separated) ? 0U : 1U;
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void overlap_matrix(
+  const BoxArray & boxes1,
+  const BoxArray & boxes2,
+  std::vector<uint8_t> & result)
+{
+  const std::size_t cols = boxes2.size();
+  result.resize(boxes1.size() * cols);
+  for (std::size_t idx = 0U; idx < boxes1.size(); ++idx) {
+    overlap_row(boxes1, idx, boxes2, &result[idx * cols]);
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void iou_matrix(
+  const BoxArray & boxes1,
+  const BoxArray & boxes2,
+  std::vector<float32_t> & result)
+{
+  const std::size_t cols = boxes2.size();
+  result.resize(boxes1.size() * cols);
+  // Overlap flags of the current row
+  std::vector<uint8_t> overlaps(cols);
+  for (std::size_t idx = 0U; idx < boxes1.size(); ++idx) {
+    overlap_row(boxes1, idx, boxes2, overlaps.data());
+    for (std::size_t jdx = 0U; jdx < cols; ++jdx) {
+      result[(idx * cols) + jdx] = (0U == overlaps[jdx]) ? 0.0F :
+        convex_intersection_over_union_2d(boxes1.m_corners[idx], boxes2.m_corners[jdx]);
+    }
+  }
+}
+
+}  // namespace bounding_box
+}  // namespace geometry
+}  // namespace common
+}  // namespace autoware
@@ -0,0 +1,68 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <geometry/bounding_box/lfit.hpp>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace autoware
+{
+namespace common
+{
+namespace geometry
+{
+namespace bounding_box
+{
+namespace details
+{
+////////////////////////////////////////////////////////////////////////////////
+void solve_lfit_block(LFitBlock & block)
+{
+  // Counted rather than or-ed so that the loop has no control flow
+  std::size_t num_negative = 0U;
+  for (std::size_t idx = 0U; idx < LFIT_BLOCK_SIZE; ++idx) {
+    const float32_t pi = 1.0F / block.p[idx];
+    const float32_t qi = 1.0F / block.q[idx];
+    const float32_t m12a = block.m12a[idx];
+    const float32_t m12b = block.m12b[idx];
+    const float32_t m12c = block.m12c[idx];
+    const float32_t m12d = block.m12d[idx];
+    const float32_t xx = block.m22a[idx] - (((m12a * m12a) * pi) + ((m12c * m12c) * qi));
+    const float32_t yy = block.m22d[idx] - (((m12b * m12b) * pi) + ((m12d * m12d) * qi));
+    const float32_t xy = block.m22b[idx] - (((m12a * m12b) * pi) + ((m12c * m12d) * qi));
+    block.xx[idx] = xx;
+    block.yy[idx] = yy;
+    block.xy[idx] = xy;
+    // smaller eigenvalue, as in eig_2d
+    const float32_t tr_2 = (xx + yy) * 0.5F;
+    const float32_t det = (xx * yy) - (xy * xy);
+    const float32_t disc = ((tr_2 * tr_2) - det) + std::numeric_limits<float32_t>::epsilon();
+    num_negative += (disc < 0.0F) ? 1U : 0U;
+    block.score[idx] = tr_2 - sqrtf(disc);
+  }
+  if (num_negative > 0U) {
+    throw std::runtime_error(
+            "pca_2d: negative discriminant! Should never happen for well formed "
+            "covariance matrix");
+  }
+}
+}  // namespace details
+}  // namespace bounding_box
+}  // namespace geometry
+}  // namespace common
+}  // namespace autoware
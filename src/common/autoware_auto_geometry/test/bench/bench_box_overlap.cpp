@@ -0,0 +1,109 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <benchmark/benchmark.h>
+#include <geometry/bounding_box/box_overlap.hpp>
+#include <geometry/intersection.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using autoware::common::geometry::bounding_box::BoxArray;
+using autoware_auto_msgs::msg::BoundingBox;
+
+// Vehicle sized boxes scattered around the ego vehicle
+std::vector<BoundingBox> create_boxes(const std::size_t size, const uint32_t seed)
+{
+  std::mt19937 generator{seed};
+  std::uniform_real_distribution<float> center_distribution{-30.0F, 30.0F};
+  std::uniform_real_distribution<float> angle_distribution{-3.14159F, 3.14159F};
+  std::vector<BoundingBox> boxes(size);
+  for (auto & box : boxes) {
+    const float cx = center_distribution(generator);
+    const float cy = center_distribution(generator);
+    const float th = angle_distribution(generator);
+    const float c = cosf(th);
+    const float s = sinf(th);
+    const float signs[4U][2U] = {{1.0F, 1.0F}, {-1.0F, 1.0F}, {-1.0F, -1.0F}, {1.0F, -1.0F}};
+    for (std::size_t idx = 0U; idx < 4U; ++idx) {
+      const float dx = signs[idx][0U] * 2.25F;
+      const float dy = signs[idx][1U] * 0.9F;
+      box.corners[idx].x = cx + ((dx * c) - (dy * s));
+      box.corners[idx].y = cy + ((dx * s) + (dy * c));
+    }
+  }
+  return boxes;
+}
+
+}  // namespace
+
+// Baseline: pairwise separating axis test on the corners
+static void BenchIntersectPairwise(benchmark::State & state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto boxes1 = create_boxes(size, 42U);
+  const auto boxes2 = create_boxes(size, 43U);
+  std::vector<uint8_t> result(size * size);
+  for (auto _ : state) {
+    for (std::size_t idx = 0U; idx < size; ++idx) {
+      for (std::size_t jdx = 0U; jdx < size; ++jdx) {
+        const auto & c1 = boxes1[idx].corners;
+        const auto & c2 = boxes2[jdx].corners;
+        result[(idx * size) + jdx] = autoware::common::geometry::intersect(
+          c1.begin(), c1.end(), c2.begin(), c2.end()) ? 1U : 0U;
+      }
+    }
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size * size));
+}
+
+static void BenchOverlapMatrix(benchmark::State & state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  BoxArray boxes1;
+  BoxArray boxes2;
+  boxes1.assign(create_boxes(size, 42U));
+  boxes2.assign(create_boxes(size, 43U));
+  std::vector<uint8_t> result;
+  for (auto _ : state) {
+    overlap_matrix(boxes1, boxes2, result);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size * size));
+}
+
+static void BenchIoUMatrix(benchmark::State & state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  BoxArray boxes1;
+  BoxArray boxes2;
+  boxes1.assign(create_boxes(size, 42U));
+  boxes2.assign(create_boxes(size, 43U));
+  std::vector<float> result;
+  for (auto _ : state) {
+    iou_matrix(boxes1, boxes2, result);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size * size));
+}
+
+BENCHMARK(BenchIntersectPairwise)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BenchOverlapMatrix)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BenchIoUMatrix)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
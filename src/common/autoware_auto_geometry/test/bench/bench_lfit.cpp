@@ -0,0 +1,69 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <benchmark/benchmark.h>
+#include <geometry/bounding_box/lfit.hpp>
+#include <geometry_msgs/msg/point32.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using autoware::common::geometry::bounding_box::lfit_bounding_box_2d;
+using geometry_msgs::msg::Point32;
+
+// Noisy L shape of a vehicle seen from a corner
+std::vector<Point32> create_cluster(const std::size_t size)
+{
+  std::mt19937 generator{42U};
+  std::uniform_real_distribution<float> side_distribution{0.0F, 1.0F};
+  std::normal_distribution<float> noise_distribution{0.0F, 0.03F};
+  std::vector<Point32> points;
+  points.reserve(size);
+  for (std::size_t idx = 0U; idx < size; ++idx) {
+    Point32 pt;
+    const float t = side_distribution(generator);
+    if ((idx % 3U) == 0U) {
+      pt.x = 10.0F + noise_distribution(generator);
+      pt.y = 5.0F + (1.8F * t);
+    } else {
+      pt.x = 10.0F + (4.5F * t);
+      pt.y = 5.0F + noise_distribution(generator);
+    }
+    points.push_back(pt);
+  }
+  return points;
+}
+
+}  // namespace
+
+static void BenchLFit(benchmark::State & state)
+{
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto points = create_cluster(size);
+  auto cluster = points;
+  for (auto _ : state) {
+    state.PauseTiming();
+    cluster = points;
+    state.ResumeTiming();
+    const auto box = lfit_bounding_box_2d(cluster.begin(), cluster.end());
+    benchmark::DoNotOptimize(box.value);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+BENCHMARK(BenchLFit)->Arg(30)->Arg(300)->Arg(3000)->Unit(benchmark::kMicrosecond);
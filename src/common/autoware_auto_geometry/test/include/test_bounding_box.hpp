@@ -19,8 +19,10 @@
 
 #include <geometry_msgs/msg/point32.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <list>
+#include <random>
 #include <vector>
 
 #include "geometry/bounding_box/rotating_calipers.hpp"
@@ -664,6 +666,61 @@ TYPED_TEST(BoxTest, EigUnderflow)
 }
 
 
+/// The blocked evaluation of partitions should give the same result as solving each partition
+TYPED_TEST(BoxTest, LFitBlocks)
+{
+  using autoware::common::geometry::bounding_box::details::LFitCompare;
+  using autoware::common::geometry::bounding_box::details::LFitWs;
+  using autoware::common::geometry::bounding_box::details::increment_lfit_ws;
+  using autoware::common::geometry::bounding_box::details::init_lfit_ws;
+  using autoware::common::geometry::bounding_box::details::lfit_bounding_box_2d_impl;
+  using autoware::common::geometry::bounding_box::details::solve_lfit;
+  std::mt19937 gen{1234U};
+  std::uniform_real_distribution<float32_t> side{0.0F, 1.0F};
+  std::normal_distribution<float32_t> noise{0.0F, 0.05F};
+  // sizes around block boundaries
+  for (const std::size_t size : {2U, 3U, 15U, 16U, 17U, 18U, 33U, 100U, 301U}) {
+    // noisy L shape
+    std::vector<TypeParam> vals;
+    for (std::size_t idx = 0U; idx < size; ++idx) {
+      const float32_t t = side(gen);
+      if ((idx % 3U) == 0U) {
+        vals.push_back(this->make(10.0F + noise(gen), 5.0F + (1.8F * t)));
+      } else {
+        vals.push_back(this->make(10.0F + (4.5F * t), 5.0F + noise(gen)));
+      }
+    }
+    const auto hint = this->make(1.0F, 0.3F);
+    std::sort(vals.begin(), vals.end(), LFitCompare<TypeParam>{hint});
+    // reference: solve each partition
+    LFitWs ws{};
+    init_lfit_ws(vals.begin(), vals.end(), size, ws);
+    TypeParam dir;
+    float32_t min_eig = solve_lfit(ws, dir);
+    for (std::size_t idx = 1U; idx < (size - 1U); ++idx) {
+      ws.p += 1U;
+      ws.q -= 1U;
+      increment_lfit_ws(vals[idx], ws);
+      TypeParam dir_idx;
+      const float32_t score = solve_lfit(ws, dir_idx);
+      if (score < min_eig) {
+        min_eig = score;
+        dir = dir_idx;
+      }
+    }
+    this->box = lfit_bounding_box_2d_impl(vals.begin(), vals.end(), size);
+    EXPECT_FLOAT_EQ(this->box.value, min_eig) << size;
+    // box should be aligned with the best direction
+    const float32_t dx = this->box.corners[1U].x - this->box.corners[0U].x;
+    const float32_t dy = this->box.corners[1U].y - this->box.corners[0U].y;
+    const float32_t len =
+      sqrtf((dx * dx) + (dy * dy)) * sqrtf((x_(dir) * x_(dir)) + (y_(dir) * y_(dir)));
+    const float32_t cos_th = ((dx * x_(dir)) + (dy * y_(dir))) / len;
+    const float32_t sin_th = ((dx * y_(dir)) - (dy * x_(dir))) / len;
+    EXPECT_LT(fabsf(cos_th * sin_th), 1.0E-4F) << size;
+  }
+}
+
 ////////////////////////////////////////////////
 
 #endif  // TEST_BOUNDING_BOX_HPP_
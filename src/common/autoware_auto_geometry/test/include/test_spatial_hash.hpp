@@ -18,9 +18,13 @@
 #define TEST_SPATIAL_HASH_HPP_
 
 #include <geometry_msgs/msg/point32.hpp>
+#include <algorithm>
+#include <random>
+#include <tuple>
 #include <vector>
 #include <limits>
 #include "geometry/spatial_hash.hpp"
+#include "geometry/spatial_hash_compact.hpp"
 
 using autoware::common::types::float32_t;
 using autoware::common::types::float64_t;
@@ -30,6 +34,8 @@ using autoware::common::geometry::spatial_hash::Config3d;
 using autoware::common::geometry::spatial_hash::SpatialHash;
 using autoware::common::geometry::spatial_hash::SpatialHash2d;
 using autoware::common::geometry::spatial_hash::SpatialHash3d;
+using autoware::common::geometry::spatial_hash::SpatialHashCompact2d;
+using autoware::common::geometry::spatial_hash::SpatialHashCompact3d;
 
 template<typename PointT>
 class TypedSpatialHashTest : public ::testing::Test
@@ -230,6 +236,171 @@ TYPED_TEST(TypedSpatialHashTest, 3d)
   EXPECT_EQ(count, 0U);
 }
 
+/// bin pairs find the same point pairs as a brute force search
+TYPED_TEST(TypedSpatialHashTest, BinPairs)
+{
+  using PointT = TypeParam;
+  const float32_t radius = 1.5F;
+  const float32_t radius2 = radius * radius;
+  Config2d cfg2{-10.0F, 10.0F, -10.0F, 10.0F, 1.0F, 1024U};
+  SpatialHash2d<PointT> hash2{cfg2};
+  Config3d cfg3{-10.0F, 10.0F, -10.0F, 10.0F, -10.0F, 10.0F, 1.0F, 1024U};
+  SpatialHash3d<PointT> hash3{cfg3};
+
+  std::mt19937 gen{42U};
+  // Includes some points outside of the configured bounds
+  std::uniform_real_distribution<float32_t> coord{-11.0F, 11.0F};
+  std::vector<PointT> pts{};
+  for (uint32_t idx = 0U; idx < 500U; ++idx) {
+    PointT pt;
+    pt.x = coord(gen);
+    pt.y = coord(gen);
+    pt.z = coord(gen);
+    pts.push_back(pt);
+  }
+  hash2.insert(pts.begin(), pts.end());
+  hash3.insert(pts.begin(), pts.end());
+
+  const auto dist2_2d = [](const PointT & a, const PointT & b) {
+      const float32_t dx = a.x - b.x;
+      const float32_t dy = a.y - b.y;
+      return (dx * dx) + (dy * dy);
+    };
+  const auto dist2_3d = [&dist2_2d](const PointT & a, const PointT & b) {
+      const float32_t dz = a.z - b.z;
+      return dist2_2d(a, b) + (dz * dz);
+    };
+  const auto count_brute_force = [&pts, radius2](const auto & dist2) {
+      uint32_t count = 0U;
+      for (std::size_t idx = 0U; idx < pts.size(); ++idx) {
+        for (std::size_t jdx = idx + 1U; jdx < pts.size(); ++jdx) {
+          if (dist2(pts[idx], pts[jdx]) <= radius2) {
+            ++count;
+          }
+        }
+      }
+      return count;
+    };
+  const auto count_bin_pairs = [radius, radius2](auto & hash, const auto & dist2) {
+      uint32_t count = 0U;
+      uint32_t num_points = 0U;
+      hash.for_each_bin_pair(
+        radius, [&count, &num_points, &dist2, radius2](const auto & a, const auto & b) {
+          const bool8_t same = a.bin() == b.bin();
+          EXPECT_TRUE(same || (a.bin() < b.bin()));
+          if (same) {
+            num_points += static_cast<uint32_t>(a.size());
+          }
+          for (std::size_t idx = 0U; idx < a.size(); ++idx) {
+            for (std::size_t jdx = same ? (idx + 1U) : 0U; jdx < b.size(); ++jdx) {
+              if (dist2(a[idx], b[jdx]) <= radius2) {
+                ++count;
+              }
+            }
+          }
+        });
+      EXPECT_EQ(num_points, hash.size());
+      return count;
+    };
+  const uint32_t expected_2d = count_brute_force(dist2_2d);
+  const uint32_t expected_3d = count_brute_force(dist2_3d);
+  EXPECT_GT(expected_3d, 0U);
+  EXPECT_EQ(count_bin_pairs(hash2, dist2_2d), expected_2d);
+  EXPECT_EQ(count_bin_pairs(hash3, dist2_3d), expected_3d);
+  // Repeated calls give the same result
+  EXPECT_EQ(count_bin_pairs(hash2, dist2_2d), expected_2d);
+
+  EXPECT_THROW(hash2.for_each_bin_pair(-1.0F, [](const auto &, const auto &) {}),
+    std::domain_error);
+  hash2.clear();
+  uint32_t num_calls = 0U;
+  hash2.for_each_bin_pair(radius, [&num_calls](const auto &, const auto &) {++num_calls;});
+  EXPECT_EQ(num_calls, 0U);
+}
+
+/// the compact variant finds the same neighbors as the multimap based spatial hash
+TYPED_TEST(TypedSpatialHashTest, Compact)
+{
+  using PointT = TypeParam;
+  const Config2d cfg2{-10.0F, 10.0F, -10.0F, 10.0F, 1.0F, 1024U};
+  const Config3d cfg3{-10.0F, 10.0F, -10.0F, 10.0F, -10.0F, 10.0F, 1.0F, 1024U};
+  SpatialHash2d<PointT> hash2{cfg2};
+  SpatialHash3d<PointT> hash3{cfg3};
+  SpatialHashCompact2d<PointT> compact2{cfg2};
+  SpatialHashCompact3d<PointT> compact3{cfg3};
+  // The upper bounds get their own row of bins
+  EXPECT_EQ(cfg2.get_num_bins(), 21U * 21U);
+  EXPECT_EQ(cfg3.get_num_bins(), 21U * 21U * 21U);
+  EXPECT_TRUE(compact2.empty());
+  EXPECT_TRUE(compact2.near(0.0F, 0.0F, 5.0F).empty());
+
+  std::mt19937 gen{1234U};
+  // Includes some points outside of the configured bounds
+  std::uniform_real_distribution<float32_t> coord{-11.0F, 11.0F};
+  const auto random_points = [&gen, &coord](const std::size_t num_points) {
+      std::vector<PointT> pts{};
+      for (std::size_t idx = 0U; idx < num_points; ++idx) {
+        PointT pt;
+        pt.x = coord(gen);
+        pt.y = coord(gen);
+        pt.z = coord(gen);
+        pts.push_back(pt);
+      }
+      return pts;
+    };
+  // Neighbors as sorted (x, y, z, distance) tuples, to compare regardless of point order
+  const auto as_sorted = [](const auto & neighbors) {
+      std::vector<std::tuple<float32_t, float32_t, float32_t, float32_t>> ret{};
+      for (const auto & nbr : neighbors) {
+        const PointT & pt = nbr;
+        ret.emplace_back(pt.x, pt.y, pt.z, nbr.get_distance());
+      }
+      std::sort(ret.begin(), ret.end());
+      return ret;
+    };
+
+  for (uint32_t scan = 0U; scan < 3U; ++scan) {
+    const auto pts = random_points(600U);
+    hash2.insert(pts.begin(), pts.end());
+    hash3.insert(pts.begin(), pts.end());
+    // Mix range and single insertion
+    compact2.insert(pts.begin(), pts.begin() + 300);
+    compact3.insert(pts.begin(), pts.end());
+    for (auto it = pts.begin() + 300; it != pts.end(); ++it) {
+      compact2.insert(*it);
+    }
+    EXPECT_EQ(compact2.size(), pts.size());
+    std::size_t num_found = 0U;
+    for (const auto & query : random_points(50U)) {
+      for (const float32_t radius : {0.5F, 1.0F, 2.5F}) {
+        const auto expected2 = as_sorted(hash2.near(query, radius));
+        const auto & found2 = compact2.near(query, radius);
+        ASSERT_EQ(as_sorted(found2), expected2);
+        for (const auto & nbr : found2) {
+          const auto stored = compact2.cbegin() + static_cast<std::ptrdiff_t>(nbr.get_index());
+          EXPECT_EQ(&(*stored), &nbr.get_point());
+        }
+        ASSERT_EQ(as_sorted(compact3.near(query, radius)), as_sorted(hash3.near(query, radius)));
+        num_found += expected2.size();
+      }
+    }
+    EXPECT_GT(num_found, 0U);
+    EXPECT_EQ(compact2.neighbors_found(), hash2.neighbors_found());
+    hash2.clear();
+    hash3.clear();
+    compact2.clear();
+    compact3.clear();
+    EXPECT_TRUE(compact2.empty());
+    EXPECT_TRUE(compact2.near(0.0F, 0.0F, 5.0F).empty());
+  }
+
+  const auto pts = random_points(1025U);
+  EXPECT_THROW(compact2.insert(pts.begin(), pts.end()), std::length_error);
+  EXPECT_TRUE(compact2.empty());
+  compact2.insert(pts.begin(), pts.begin() + 1024);
+  EXPECT_THROW(compact2.insert(pts.back()), std::length_error);
+}
+
 /// edge cases
 TEST(SpatialHashConfig, BadCases)
 {
@@ -19,12 +19,16 @@
 #include <geometry/lookup_table.hpp>
 #include <common/types.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <vector>
 
 using autoware::common::helper_functions::lookup_1d;
 using autoware::common::helper_functions::interpolate;
 using autoware::common::helper_functions::LookupTable1D;
+using autoware::common::helper_functions::LookupTable2D;
 using autoware::common::types::float32_t;
 using autoware::common::types::float64_t;
 
@@ -161,4 +165,75 @@ TEST(LookupTableHelpers, Interpolate) {
   }
 }
 
+TEST(LookupTable1D, UniformDomain) {
+  // The same function on a uniform and on a non-uniform domain
+  const LookupTable1D<float64_t> uniform{{-1.0, 0.0, 1.0, 2.0, 3.0}, {4.0, 0.0, 1.0, 3.0, 2.0}};
+  const LookupTable1D<float64_t> non_uniform{
+    {-1.0, 0.0, 0.5, 1.0, 2.0, 3.0}, {4.0, 0.0, 0.5, 1.0, 3.0, 2.0}};
+  EXPECT_TRUE(uniform.is_uniform());
+  EXPECT_FALSE(non_uniform.is_uniform());
+  for (auto x = -2.0; x < 4.0; x += 0.01) {
+    EXPECT_DOUBLE_EQ(uniform.lookup(x), non_uniform.lookup(x)) << x;
+    EXPECT_DOUBLE_EQ(uniform.lookup(x), lookup_1d(uniform.domain(), uniform.range(), x)) << x;
+  }
+  // Domain values which are not exactly representable still bracket exactly
+  std::vector<float32_t> domain{};
+  std::vector<float32_t> range{};
+  for (auto idx = 0; idx <= 100; ++idx) {
+    domain.push_back(static_cast<float32_t>(idx) * 0.1F);
+    range.push_back(static_cast<float32_t>(idx % 2));
+  }
+  const LookupTable1D<float32_t> table{domain, range};
+  EXPECT_TRUE(table.is_uniform());
+  for (auto idx = 0U; idx < domain.size(); ++idx) {
+    EXPECT_EQ(table.lookup(domain[idx]), range[idx]);
+  }
+  EXPECT_THROW(table.lookup(std::numeric_limits<float32_t>::quiet_NaN()), std::domain_error);
+}
+
+TEST(LookupTable1D, Batch) {
+  const LookupTable1D<int32_t> table{{0, 10, 20}, {0, 100, 0}};
+  EXPECT_TRUE(table.is_uniform());
+  const std::vector<int32_t> values{-5, 0, 5, 10, 15, 25};
+  std::vector<int32_t> results(values.size());
+  const auto end = table.lookup(values.begin(), values.end(), results.begin());
+  EXPECT_EQ(end, results.end());
+  EXPECT_EQ(results, (std::vector<int32_t>{0, 0, 50, 100, 50, 0}));
+}
+
+TEST(LookupTable2D, Bilinear) {
+  // z = x * y on a non-uniform x and a uniform y domain
+  const std::vector<float64_t> x_domain{0.0, 1.0, 4.0};
+  const std::vector<float64_t> y_domain{-1.0, 0.0, 1.0};
+  std::vector<float64_t> values{};
+  for (const auto x : x_domain) {
+    for (const auto y : y_domain) {
+      values.push_back(x * y);
+    }
+  }
+  const LookupTable2D<float64_t> table{x_domain, y_domain, values};
+  EXPECT_DOUBLE_EQ(table.lookup(1.0, 1.0), 1.0);
+  EXPECT_DOUBLE_EQ(table.lookup(0.5, 0.5), 0.25);
+  EXPECT_DOUBLE_EQ(table.lookup(2.5, -0.5), -1.25);
+  // Clamped to the edges of the domains
+  EXPECT_DOUBLE_EQ(table.lookup(10.0, 0.5), 2.0);
+  EXPECT_DOUBLE_EQ(table.lookup(-1.0, 5.0), 0.0);
+  EXPECT_DOUBLE_EQ(table.lookup(8.0, -3.0), -4.0);
+  EXPECT_THROW(table.lookup(std::numeric_limits<float64_t>::infinity(), 0.0), std::domain_error);
+
+  const std::vector<float64_t> xs{0.5, 2.5, 10.0};
+  const std::vector<float64_t> ys{0.5, -0.5, 0.5};
+  std::vector<float64_t> results{};
+  table.lookup(xs.begin(), xs.end(), ys.begin(), std::back_inserter(results));
+  EXPECT_EQ(results, (std::vector<float64_t>{0.25, -1.25, 2.0}));
+}
+
+TEST(LookupTable2D, Bad) {
+  using Table = LookupTable2D<float32_t>;
+  EXPECT_THROW(Table({}, {1.0F}, {}), std::domain_error);
+  EXPECT_THROW(Table({1.0F, 0.0F}, {1.0F}, {1.0F, 2.0F}), std::domain_error);
+  EXPECT_THROW(Table({0.0F, 1.0F}, {1.0F}, {1.0F}), std::domain_error);
+  EXPECT_NO_THROW(Table({0.0F, 1.0F}, {1.0F}, {1.0F, 2.0F}));
+}
+
 // TODO(c.ho) check with more interesting functions
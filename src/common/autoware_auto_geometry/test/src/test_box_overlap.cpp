@@ -0,0 +1,168 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <gtest/gtest.h>
+#include <geometry/bounding_box/box_overlap.hpp>
+#include <geometry/convex_hull.hpp>
+#include <geometry/intersection.hpp>
+
+#include <cmath>
+#include <list>
+#include <random>
+#include <vector>
+
+using autoware::common::geometry::bounding_box::BoxArray;
+using autoware::common::geometry::bounding_box::iou_matrix;
+using autoware::common::geometry::bounding_box::overlap_matrix;
+using autoware_auto_msgs::msg::BoundingBox;
+using geometry_msgs::msg::Point32;
+
+class BoxOverlapTest : public ::testing::Test
+{
+protected:
+  BoxOverlapTest()
+  : m_gen{42U}
+  {
+  }
+
+  BoundingBox make_box(
+    const float32_t cx, const float32_t cy, const float32_t lx, const float32_t ly,
+    const float32_t th) const
+  {
+    const float32_t c = cosf(th);
+    const float32_t s = sinf(th);
+    BoundingBox box;
+    const float32_t signs[4U][2U] = {{1.0F, 1.0F}, {-1.0F, 1.0F}, {-1.0F, -1.0F}, {1.0F, -1.0F}};
+    for (std::size_t idx = 0U; idx < 4U; ++idx) {
+      const float32_t dx = signs[idx][0U] * lx * 0.5F;
+      const float32_t dy = signs[idx][1U] * ly * 0.5F;
+      box.corners[idx].x = cx + ((dx * c) - (dy * s));
+      box.corners[idx].y = cy + ((dx * s) + (dy * c));
+    }
+    return box;
+  }
+
+  std::vector<BoundingBox> make_boxes(const std::size_t num)
+  {
+    std::uniform_real_distribution<float32_t> center{-8.0F, 8.0F};
+    std::uniform_real_distribution<float32_t> size{0.5F, 5.0F};
+    std::uniform_real_distribution<float32_t> angle{-3.14159F, 3.14159F};
+    std::vector<BoundingBox> boxes;
+    for (std::size_t idx = 0U; idx < num; ++idx) {
+      const float32_t cx = center(m_gen);
+      const float32_t cy = center(m_gen);
+      const float32_t lx = size(m_gen);
+      const float32_t ly = size(m_gen);
+      boxes.push_back(make_box(cx, cy, lx, ly, angle(m_gen)));
+    }
+    return boxes;
+  }
+
+  std::mt19937 m_gen;
+};  // class BoxOverlapTest
+
+// The batched test should agree with the separating axis test on the convex hulls
+TEST_F(BoxOverlapTest, MatchesIntersect)
+{
+  const auto boxes1 = make_boxes(37U);
+  const auto boxes2 = make_boxes(23U);
+  BoxArray array1;
+  BoxArray array2;
+  array1.assign(boxes1);
+  array2.assign(boxes2);
+  ASSERT_EQ(array1.size(), boxes1.size());
+  std::vector<uint8_t> result;
+  overlap_matrix(array1, array2, result);
+  ASSERT_EQ(result.size(), boxes1.size() * boxes2.size());
+  std::size_t num_overlaps = 0U;
+  for (std::size_t idx = 0U; idx < boxes1.size(); ++idx) {
+    for (std::size_t jdx = 0U; jdx < boxes2.size(); ++jdx) {
+      const auto & c1 = boxes1[idx].corners;
+      const auto & c2 = boxes2[jdx].corners;
+      const bool expected =
+        autoware::common::geometry::intersect(c1.begin(), c1.end(), c2.begin(), c2.end());
+      EXPECT_EQ(result[(idx * boxes2.size()) + jdx] != 0U, expected) << idx << ", " << jdx;
+      num_overlaps += expected ? 1U : 0U;
+    }
+  }
+  EXPECT_GT(num_overlaps, 0U);
+  EXPECT_LT(num_overlaps, result.size());
+}
+
+// The batched intersection over union should agree with that of the individual polygons
+TEST_F(BoxOverlapTest, MatchesIoU)
+{
+  auto boxes1 = make_boxes(17U);
+  const auto boxes2 = make_boxes(19U);
+  // cw corners are fine as well
+  std::swap(boxes1[0U].corners[1U], boxes1[0U].corners[3U]);
+  BoxArray array1;
+  BoxArray array2;
+  array1.assign(boxes1);
+  array2.assign(boxes2);
+  std::vector<float32_t> result;
+  iou_matrix(array1, array2, result);
+  ASSERT_EQ(result.size(), boxes1.size() * boxes2.size());
+  const auto to_polygon = [](const BoundingBox & box) {
+      std::list<Point32> polygon{box.corners.begin(), box.corners.end()};
+      (void)autoware::common::geometry::convex_hull(polygon);
+      return polygon;
+    };
+  for (std::size_t idx = 0U; idx < boxes1.size(); ++idx) {
+    for (std::size_t jdx = 0U; jdx < boxes2.size(); ++jdx) {
+      const float32_t expected = autoware::common::geometry::convex_intersection_over_union_2d(
+        to_polygon(boxes1[idx]), to_polygon(boxes2[jdx]));
+      EXPECT_NEAR(result[(idx * boxes2.size()) + jdx], expected, 1.0E-5F) << idx << ", " << jdx;
+    }
+  }
+}
+
+TEST_F(BoxOverlapTest, Basic)
+{
+  BoxArray array1;
+  BoxArray array2;
+  // identical, touching, separated along an edge normal, separated only diagonally
+  array1.assign({make_box(0.0F, 0.0F, 2.0F, 2.0F, 0.0F)});
+  array2.assign(
+    {make_box(0.0F, 0.0F, 2.0F, 2.0F, 0.0F), make_box(2.0F, 0.0F, 2.0F, 2.0F, 0.0F),
+      make_box(2.5F, 0.0F, 2.0F, 2.0F, 0.0F), make_box(2.3F, 2.3F, 2.0F, 2.0F, 0.7853982F)});
+  std::vector<uint8_t> overlaps;
+  overlap_matrix(array1, array2, overlaps);
+  ASSERT_EQ(overlaps.size(), 4U);
+  EXPECT_EQ(overlaps[0U], 1U);
+  EXPECT_EQ(overlaps[1U], 1U);
+  EXPECT_EQ(overlaps[2U], 0U);
+  EXPECT_EQ(overlaps[3U], 0U);
+  // identical, half overlapping, separated; rotated as is_point_inside_polygon_2d does not
+  // handle points on the extension of horizontal edges
+  const float32_t th = 0.3F;
+  array1.assign({make_box(0.0F, 0.0F, 2.0F, 2.0F, th)});
+  array2.assign(
+    {make_box(0.0F, 0.0F, 2.0F, 2.0F, th), make_box(cosf(th), sinf(th), 2.0F, 2.0F, th),
+      make_box(2.5F * cosf(th), 2.5F * sinf(th), 2.0F, 2.0F, th)});
+  std::vector<float32_t> ious;
+  iou_matrix(array1, array2, ious);
+  ASSERT_EQ(ious.size(), 3U);
+  EXPECT_NEAR(ious[0U], 1.0F, 1.0E-5F);
+  EXPECT_NEAR(ious[1U], 1.0F / 3.0F, 1.0E-5F);
+  EXPECT_EQ(ious[2U], 0.0F);
+  // Empty sets
+  array2.assign({});
+  overlap_matrix(array1, array2, overlaps);
+  EXPECT_TRUE(overlaps.empty());
+  iou_matrix(array2, array1, ious);
+  EXPECT_TRUE(ious.empty());
+}
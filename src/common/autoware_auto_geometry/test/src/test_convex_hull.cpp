@@ -16,7 +16,10 @@
 
 #include <gtest/gtest.h>
 #include <geometry_msgs/msg/point32.hpp>
+#include <algorithm>
+#include <limits>
 #include <list>
+#include <random>
 #include <vector>
 #include "geometry/convex_hull.hpp"
 
@@ -369,4 +372,159 @@ TYPED_TEST(TypedConvexHullTest, Root)
   EXPECT_EQ(last->z, 6);
 }
 
+// The static vector version should give the same hull, in the same order, as the list version
+TYPED_TEST(TypedConvexHullTest, StaticVector)
+{
+  using autoware::common::geometry::StaticVector;
+  std::mt19937 gen{42U};
+  std::uniform_real_distribution<float32_t> dist{-10.0F, 10.0F};
+  for (uint32_t size = 0U; size <= 32U; ++size) {
+    StaticVector<TypeParam, 32U> points;
+    this->list.clear();
+    for (uint32_t idx = 0U; idx < size; ++idx) {
+      // coarse grid to get collinear and duplicate points
+      const auto pt = this->make(roundf(dist(gen)), roundf(dist(gen)), static_cast<float32_t>(idx));
+      points.push_back(pt);
+      this->list.push_back(pt);
+    }
+    const auto list_last = this->convex_hull();
+    const auto last = autoware::common::geometry::convex_hull(points);
+    ASSERT_EQ(std::distance(points.begin(), last), std::distance(this->list.cbegin(), list_last));
+    ASSERT_EQ(points.size(), size);
+    auto list_it = this->list.cbegin();
+    for (auto it = points.begin(); it != last; ++it) {
+      EXPECT_FLOAT_EQ(it->x, list_it->x) << size;
+      EXPECT_FLOAT_EQ(it->y, list_it->y) << size;
+      ++list_it;
+    }
+  }
+}
+
+// The range version should give the same hull, in the same order, as the list version, without
+// touching the output beyond the size of the range plus one
+TYPED_TEST(TypedConvexHullTest, Range)
+{
+  std::mt19937 gen{43U};
+  std::uniform_real_distribution<float32_t> dist{-10.0F, 10.0F};
+  for (uint32_t size = 0U; size <= 64U; ++size) {
+    std::vector<TypeParam> points;
+    this->list.clear();
+    for (uint32_t idx = 0U; idx < size; ++idx) {
+      // coarse grid to get collinear and duplicate points
+      const auto pt = this->make(roundf(dist(gen)), roundf(dist(gen)), static_cast<float32_t>(idx));
+      points.push_back(pt);
+      this->list.push_back(pt);
+    }
+    const auto sentinel = this->make(100.0F, 100.0F, 100.0F);
+    std::vector<TypeParam> hull(size + 2U, sentinel);
+    const auto list_last = this->convex_hull();
+    const auto last = autoware::common::geometry::convex_hull(
+      points.begin(), points.end(), hull.begin());
+    ASSERT_EQ(std::distance(hull.begin(), last), std::distance(this->list.cbegin(), list_last));
+    EXPECT_FLOAT_EQ(hull.back().z, sentinel.z) << size;
+    auto list_it = this->list.cbegin();
+    for (auto it = hull.begin(); it != last; ++it) {
+      EXPECT_FLOAT_EQ(it->x, list_it->x) << size;
+      EXPECT_FLOAT_EQ(it->y, list_it->y) << size;
+      ++list_it;
+    }
+  }
+}
+
+// Growing the hull one point at a time should give the same hull, in the same order, as the
+// range version on all points so far
+TYPED_TEST(TypedConvexHullTest, Incremental)
+{
+  std::mt19937 gen{44U};
+  std::uniform_real_distribution<float32_t> dist{-10.0F, 10.0F};
+  autoware::common::geometry::IncrementalConvexHull<TypeParam> incremental;
+  EXPECT_TRUE(incremental.empty());
+  std::vector<TypeParam> points;
+  for (uint32_t size = 1U; size <= 128U; ++size) {
+    // coarse grid to get collinear and duplicate points
+    const auto pt = this->make(roundf(dist(gen)), roundf(dist(gen)), 0.0F);
+    points.push_back(pt);
+    const bool8_t was_inside = incremental.contains(pt);
+    EXPECT_NE(incremental.insert(pt), was_inside) << size;
+    EXPECT_TRUE(incremental.contains(pt)) << size;
+    if (size <= 3U) {
+      continue;
+    }
+    std::vector<TypeParam> copy{points};
+    std::vector<TypeParam> expect(size + 1U);
+    expect.erase(
+      autoware::common::geometry::convex_hull(copy.begin(), copy.end(), expect.begin()),
+      expect.end());
+    std::vector<TypeParam> hull(incremental.size());
+    ASSERT_EQ(incremental.get_hull(hull.begin()), hull.end());
+    ASSERT_EQ(hull.size(), expect.size()) << size;
+    for (std::size_t idx = 0U; idx < hull.size(); ++idx) {
+      EXPECT_FLOAT_EQ(hull[idx].x, expect[idx].x) << size;
+      EXPECT_FLOAT_EQ(hull[idx].y, expect[idx].y) << size;
+    }
+  }
+  // A point is contained if adding it does not make it a new vertex of the hull
+  for (float32_t x = -11.0F; x <= 11.0F; x += 0.5F) {
+    for (float32_t y = -11.0F; y <= 11.0F; y += 0.5F) {
+      std::vector<TypeParam> copy{points};
+      copy.push_back(this->make(x, y, 0.0F));
+      std::vector<TypeParam> hull(copy.size() + 1U);
+      const auto last = autoware::common::geometry::convex_hull(
+        copy.begin(), copy.end(), hull.begin());
+      const bool8_t on_hull = std::any_of(
+        hull.begin(), last, [x, y](const TypeParam & q) {return (q.x == x) && (q.y == y);});
+      const bool8_t is_input = std::any_of(
+        points.begin(), points.end(), [x, y](const TypeParam & q) {
+          return (q.x == x) && (q.y == y);});
+      EXPECT_EQ(incremental.contains(this->make(x, y, 0.0F)), !on_hull || is_input) << x << y;
+    }
+  }
+  incremental.clear();
+  EXPECT_TRUE(incremental.empty());
+  EXPECT_EQ(incremental.size(), 0U);
+  EXPECT_FALSE(incremental.contains(points.front()));
+}
+
+TYPED_TEST(TypedConvexHullTest, IncrementalMerge)
+{
+  using autoware::common::geometry::IncrementalConvexHull;
+  IncrementalConvexHull<TypeParam> left;
+  IncrementalConvexHull<TypeParam> right;
+  left.insert(this->make(0.0F, 0.0F, 0.0F));
+  EXPECT_EQ(left.size(), 1U);
+  left.insert(this->make(0.0F, 0.0F, 0.0F));
+  EXPECT_EQ(left.size(), 1U);
+  left.insert(this->make(1.0F, 1.0F, 0.0F));
+  EXPECT_EQ(left.size(), 2U);
+  // collinear points are not vertices
+  EXPECT_FALSE(left.insert(this->make(0.5F, 0.5F, 0.0F)));
+  EXPECT_TRUE(left.contains(this->make(0.5F, 0.5F, 0.0F)));
+  EXPECT_FALSE(left.contains(this->make(0.5F, 0.6F, 0.0F)));
+  EXPECT_TRUE(left.insert(this->make(0.0F, 1.0F, 0.0F)));
+  EXPECT_EQ(left.size(), 3U);
+  EXPECT_FALSE(
+    left.insert(this->make(std::numeric_limits<float32_t>::quiet_NaN(), 0.0F, 0.0F)));
+  EXPECT_EQ(left.size(), 3U);
+  const std::vector<TypeParam> points{
+    this->make(2.0F, 0.0F, 0.0F), this->make(3.0F, 0.5F, 0.0F),
+    this->make(2.0F, 1.0F, 0.0F), this->make(2.5F, 0.5F, 0.0F)};
+  right.insert(points.begin(), points.end());
+  EXPECT_EQ(right.size(), 3U);
+  left.merge(right);
+  EXPECT_EQ(right.size(), 3U);
+  const std::vector<TypeParam> expect{
+    this->make(0.0F, 0.0F, 0.0F), this->make(2.0F, 0.0F, 0.0F), this->make(3.0F, 0.5F, 0.0F),
+    this->make(2.0F, 1.0F, 0.0F), this->make(0.0F, 1.0F, 0.0F)};
+  std::vector<TypeParam> hull(left.size());
+  ASSERT_EQ(hull.size(), expect.size());
+  left.get_hull(hull.begin());
+  for (std::size_t idx = 0U; idx < hull.size(); ++idx) {
+    EXPECT_FLOAT_EQ(hull[idx].x, expect[idx].x) << idx;
+    EXPECT_FLOAT_EQ(hull[idx].y, expect[idx].y) << idx;
+  }
+  EXPECT_TRUE(left.contains(this->make(1.5F, 0.5F, 0.0F)));
+  EXPECT_TRUE(left.contains(this->make(1.0F, 1.0F, 0.0F)));
+  EXPECT_FALSE(left.contains(this->make(3.0F, 0.0F, 0.0F)));
+}
+
 // TODO(c.ho) random input, fuzzing, stress tests
@@ -18,6 +18,8 @@
 #include <geometry/intersection.hpp>
 #include <geometry/convex_hull.hpp>
 #include <list>
+#include <random>
+#include <vector>
 
 struct TestPoint
 {
@@ -63,6 +65,20 @@ TEST_P(IntersectionTest, Basic) {
     EXPECT_FLOAT_EQ(result_it->y, expected_shape_it->y);
     ++expected_shape_it;
   }
+
+  // Same result without memory allocation
+  using autoware::common::geometry::StaticVector;
+  const StaticVector<TestPoint, 4U> static_polygon1{polygon1.begin(), polygon1.end()};
+  const StaticVector<TestPoint, 4U> static_polygon2{polygon2.begin(), polygon2.end()};
+  const auto static_result =
+    autoware::common::geometry::convex_polygon_intersection2d(static_polygon1, static_polygon2);
+  ASSERT_EQ(static_result.size(), expected_intersection.size());
+  expected_shape_it = expected_intersection.begin();
+  for (const auto & pt : static_result) {
+    EXPECT_FLOAT_EQ(pt.x, expected_shape_it->x);
+    EXPECT_FLOAT_EQ(pt.y, expected_shape_it->y);
+    ++expected_shape_it;
+  }
 }
 
 INSTANTIATE_TEST_CASE_P(
@@ -153,6 +169,56 @@ TEST(IoUTest, PentagonRectangleIntersection) {
     autoware::common::geometry::convex_intersection_over_union_2d(polygon1, polygon2);
 
   EXPECT_FLOAT_EQ(computed_iou, expected_intersection_area / expected_union_area);
+
+  using autoware::common::geometry::StaticVector;
+  const StaticVector<TestPoint, 5U> static_polygon1{polygon1.begin(), polygon1.end()};
+  const StaticVector<TestPoint, 4U> static_polygon2{polygon2.begin(), polygon2.end()};
+  EXPECT_FLOAT_EQ(
+    autoware::common::geometry::convex_intersection_over_union_2d(static_polygon1, static_polygon2),
+    computed_iou);
+}
+
+// Collision checks on static vectors should agree with the iterator version
+TEST(IntersectTest, StaticVector) {
+  using autoware::common::geometry::StaticVector;
+  using Point = autoware::common::geometry::Point;
+  std::mt19937 gen{42U};
+  std::uniform_real_distribution<float32_t> center_dist{-5.0F, 5.0F};
+  std::uniform_real_distribution<float32_t> size_dist{0.5F, 3.0F};
+  std::uniform_real_distribution<float32_t> angle_dist{0.0F, 3.14159F};
+  const auto make_box = [&]() {
+      const float32_t cx = center_dist(gen);
+      const float32_t cy = center_dist(gen);
+      const float32_t lx = size_dist(gen);
+      const float32_t ly = size_dist(gen);
+      const float32_t th = angle_dist(gen);
+      const float32_t c = cosf(th);
+      const float32_t s = sinf(th);
+      StaticVector<Point, 4U> box;
+      for (const auto & corner : {std::make_pair(1.0F, 1.0F), std::make_pair(-1.0F, 1.0F),
+          std::make_pair(-1.0F, -1.0F), std::make_pair(1.0F, -1.0F)})
+      {
+        Point pt;
+        pt.x = cx + (((corner.first * lx) * c) - ((corner.second * ly) * s));
+        pt.y = cy + (((corner.first * lx) * s) + ((corner.second * ly) * c));
+        box.push_back(pt);
+      }
+      return box;
+    };
+  std::size_t num_collisions = 0U;
+  for (std::size_t idx = 0U; idx < 200U; ++idx) {
+    const auto box1 = make_box();
+    const auto box2 = make_box();
+    const std::vector<Point> vec1{box1.begin(), box1.end()};
+    const std::vector<Point> vec2{box2.begin(), box2.end()};
+    const bool expected =
+      autoware::common::geometry::intersect(vec1.begin(), vec1.end(), vec2.begin(), vec2.end());
+    EXPECT_EQ(autoware::common::geometry::intersect(box1, box2), expected) << idx;
+    num_collisions += expected ? 1U : 0U;
+  }
+  // Both cases should be covered
+  EXPECT_GT(num_collisions, 0U);
+  EXPECT_LT(num_collisions, 200U);
 }
 
 // IoU of two non-intersecting rectangles.
@@ -22,13 +22,16 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
+#include <vector>
 
 #include "geometry/interval.hpp"
 
 using autoware::common::geometry::Interval_d;
 using autoware::common::geometry::Interval_f;
 using autoware::common::geometry::Interval;
+using autoware::common::geometry::IntervalArray_d;
 
 namespace
 {
@@ -261,3 +264,59 @@ TEST(GeometryInterval, ConstructionMeasure) {
 }
 
 //------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+
+TEST(GeometryInterval, Batch) {
+  const std::vector<Interval_d> intervals{
+    Interval_d(-1.0, 1.0), Interval_d(0.5, 0.5), Interval_d(1.0, 3.0), Interval_d(-4.0, -2.0),
+    Interval_d(), Interval_d(Min, Max), Interval_d(-Inf, 0.0), Interval_d(1.0 + epsilon, 2.0)};
+  IntervalArray_d array{};
+  for (const auto & i : intervals) {
+    array.push_back(i);
+  }
+  ASSERT_EQ(array.size(), intervals.size());
+  EXPECT_EQ(array[2U], intervals[2U]);
+
+  // Each batch result agrees with the scalar operations
+  std::vector<uint8_t> result(array.size());
+  IntervalArray_d intersections{};
+  for (const auto & i : intervals) {
+    array.overlaps(i, result.data());
+    for (std::size_t idx = 0U; idx < intervals.size(); ++idx) {
+      const auto overlap = !Interval_d::empty(Interval_d::intersect(i, intervals[idx]));
+      EXPECT_EQ(Interval_d::overlaps(i, intervals[idx]), overlap) << i << " " << intervals[idx];
+      EXPECT_EQ(result[idx] != 0U, overlap) << i << " " << intervals[idx];
+    }
+    array.overlaps(i, result.data(), 2.0 * epsilon);
+    for (std::size_t idx = 0U; idx < intervals.size(); ++idx) {
+      EXPECT_EQ(result[idx] != 0U, Interval_d::overlaps(i, intervals[idx], 2.0 * epsilon));
+    }
+    array.contains(i, result.data());
+    for (std::size_t idx = 0U; idx < intervals.size(); ++idx) {
+      EXPECT_EQ(result[idx] != 0U, Interval_d::is_subset_eq(i, intervals[idx]));
+    }
+    array.intersect(i, intersections);
+    ASSERT_EQ(intersections.size(), intervals.size());
+    for (std::size_t idx = 0U; idx < intervals.size(); ++idx) {
+      // Compared with == for the infinite bounds, which abs_eq does not support
+      EXPECT_EQ(intersections[idx], Interval_d::intersect(i, intervals[idx]));
+    }
+  }
+  for (const auto value : {-3.0, 0.5, 1.0, 1.0 + 0.5 * epsilon, 5.0, NaN}) {
+    array.contains(value, result.data(), epsilon);
+    for (std::size_t idx = 0U; idx < intervals.size(); ++idx) {
+      EXPECT_EQ(
+        result[idx] != 0U,
+        Interval_d::contains(intervals[idx], value, epsilon)) << value << " " << intervals[idx];
+    }
+  }
+
+  // Touching within epsilon
+  EXPECT_FALSE(Interval_d::overlaps(Interval_d(-1.0, 1.0), Interval_d(1.0 + epsilon, 2.0)));
+  EXPECT_TRUE(
+    Interval_d::overlaps(Interval_d(-1.0, 1.0), Interval_d(1.0 + epsilon, 2.0), 2.0 * epsilon));
+
+  array.clear();
+  EXPECT_EQ(array.size(), 0U);
+}
@@ -0,0 +1,101 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// \file
+/// \brief This file defines a tf2 buffer shared by all nodes of a process
+
+#ifndef AUTOWARE_AUTO_TF2__SHARED_TRANSFORM_BUFFER_HPP_
+#define AUTOWARE_AUTO_TF2__SHARED_TRANSFORM_BUFFER_HPP_
+
+#include <autoware_auto_tf2/visibility_control.hpp>
+#include <geometry_msgs/msg/transform.hpp>
+#include <rclcpp/clock.hpp>
+#include <tf2_ros/buffer.h>
+#include <tf2_ros/transform_listener.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace autoware_auto_tf2
+{
+
+/// A tf2 buffer and listener shared by all nodes of a process, e.g. of a component container, so
+/// that `/tf` and `/tf_static` are received and stored once instead of once per node.
+///
+/// Static transforms, such as the extrinsics of a sensor, are usually looked up for every message
+/// although they never change. `lookup_latest_transform()` resolves them once and then serves them
+/// from a process-wide cache, which is read without taking a lock.
+class AUTOWARE_AUTO_TF2_PUBLIC SharedTransformBuffer
+{
+public:
+  /// Maximum number of static transforms cached, further ones are looked up in the buffer.
+  static constexpr std::size_t MAX_STATIC_TRANSFORMS = 256U;
+
+  /// Get the buffer of the process, which is created on the first call and kept until no caller
+  /// holds it any more. The listener spins a node of its own on a dedicated thread, so the buffer
+  /// does not depend on the executor or the lifetime of any node.
+  /// \param clock Clock of the buffer if it is created, e.g. the clock of the calling node. It
+  ///        is only used for lookups with a timeout, so all users should agree on `use_sim_time`.
+  /// \return The shared buffer.
+  static std::shared_ptr<SharedTransformBuffer> get(const rclcpp::Clock::SharedPtr & clock);
+
+  SharedTransformBuffer(const SharedTransformBuffer &) = delete;
+  SharedTransformBuffer & operator=(const SharedTransformBuffer &) = delete;
+
+  /// Get the underlying buffer, e.g. for lookups at a given time.
+  tf2_ros::Buffer & buffer() noexcept;
+
+  /// Look up the latest transform from `source_frame` to `target_frame`. A transform composed of
+  /// static transforms only is cached on the first lookup and then returned without accessing the
+  /// buffer. A republished static transform is therefore not picked up.
+  /// \param target_frame Frame to transform into.
+  /// \param source_frame Frame to transform from.
+  /// \return The transform.
+  /// \throw tf2::TransformException If the transform is not available.
+  geometry_msgs::msg::Transform lookup_latest_transform(
+    const std::string & target_frame, const std::string & source_frame);
+
+private:
+  struct StaticTransform
+  {
+    std::string target_frame;
+    std::string source_frame;
+    geometry_msgs::msg::Transform transform;
+  };
+
+  explicit SharedTransformBuffer(const rclcpp::Clock::SharedPtr & clock);
+
+  /// Find a cached static transform, which may run concurrently with `cache_static()`.
+  const StaticTransform * find_static(
+    const std::string & target_frame, const std::string & source_frame) const noexcept;
+
+  /// Add a static transform to the cache unless it is full or the transform is cached already.
+  void cache_static(
+    const std::string & target_frame, const std::string & source_frame,
+    const geometry_msgs::msg::Transform & transform);
+
+  tf2_ros::Buffer m_buffer;
+  tf2_ros::TransformListener m_listener;
+  // Append only: an entry is written before the count including it is published, so readers only
+  // see complete entries, and entries are not modified afterwards
+  std::unique_ptr<StaticTransform[]> m_static_transforms;
+  std::atomic<std::size_t> m_num_static_transforms{0U};
+  std::mutex m_static_mutex;
+};
+
+}  // namespace autoware_auto_tf2
+
+#endif  // AUTOWARE_AUTO_TF2__SHARED_TRANSFORM_BUFFER_HPP_
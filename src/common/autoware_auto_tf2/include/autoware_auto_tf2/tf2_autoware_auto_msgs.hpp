@@ -22,12 +22,15 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <autoware_auto_msgs/msg/bounding_box_array.hpp>
 #include <autoware_auto_msgs/msg/bounding_box.hpp>
+#include <autoware_auto_msgs/msg/detected_objects.hpp>
+#include <autoware_auto_msgs/msg/tracked_objects.hpp>
 #include <geometry_msgs/msg/transform_stamped.hpp>
 #include <autoware_auto_msgs/msg/quaternion32.hpp>
 #include <geometry_msgs/msg/polygon.hpp>
 #include <geometry_msgs/msg/point32.hpp>
 #include <kdl/frames.hpp>
 #include <common/types.hpp>
+#include <array>
 #include <string>
 
 
@@ -35,6 +38,98 @@ using autoware::common::types::float32_t;
 using autoware::common::types::float64_t;
 using BoundingBoxArray = autoware_auto_msgs::msg::BoundingBoxArray;
 using BoundingBox = autoware_auto_msgs::msg::BoundingBox;
+using DetectedObjects = autoware_auto_msgs::msg::DetectedObjects;
+using TrackedObjects = autoware_auto_msgs::msg::TrackedObjects;
+
+namespace autoware_auto_tf2
+{
+namespace detail
+{
+// The message level transforms below convert the transform to a KDL::Frame once per message and
+// apply it with these to every object
+
+template<typename PointT>
+inline void transform_point(const KDL::Frame & frame, const PointT & p_in, PointT & p_out)
+{
+  using ScalarT = decltype(p_out.x);
+  const KDL::Vector v_out = frame * KDL::Vector(p_in.x, p_in.y, p_in.z);
+  p_out.x = static_cast<ScalarT>(v_out[0]);
+  p_out.y = static_cast<ScalarT>(v_out[1]);
+  p_out.z = static_cast<ScalarT>(v_out[2]);
+}
+
+template<typename VectorT>
+inline void rotate_vector(const KDL::Rotation & rotation, VectorT & vector)
+{
+  const KDL::Vector v_out = rotation * KDL::Vector(vector.x, vector.y, vector.z);
+  vector.x = v_out[0];
+  vector.y = v_out[1];
+  vector.z = v_out[2];
+}
+
+template<typename QuaternionT>
+inline void rotate_quaternion(
+  const KDL::Rotation & rotation, const QuaternionT & q_in, QuaternionT & q_out)
+{
+  using ScalarT = decltype(q_out.x);
+  const KDL::Rotation r_out = rotation * KDL::Rotation::Quaternion(q_in.x, q_in.y, q_in.z, q_in.w);
+  double qx, qy, qz, qw;
+  r_out.GetQuaternion(qx, qy, qz, qw);
+  q_out.x = static_cast<ScalarT>(qx);
+  q_out.y = static_cast<ScalarT>(qy);
+  q_out.z = static_cast<ScalarT>(qz);
+  q_out.w = static_cast<ScalarT>(qw);
+}
+
+/// \brief Rotate the 3x3 blocks on the diagonal of a row-major covariance of size 3 * N,
+///        i.e. C' = R C R^T with R = diag(rotation, ..., rotation).
+template<std::size_t kSize>
+inline void rotate_covariance(const KDL::Rotation & rotation, std::array<float64_t, kSize> & cov)
+{
+  constexpr std::size_t kDim = (kSize == 9U) ? 3U : 6U;
+  static_assert(kDim * kDim == kSize, "The covariance must be 3x3 or 6x6");
+  std::array<float64_t, kSize> rotated{};
+  // rotated = R * cov, then cov = rotated * R^T
+  for (std::size_t row = 0U; row < kDim; ++row) {
+    for (std::size_t col = 0U; col < kDim; ++col) {
+      const std::size_t block = row - (row % 3U);
+      float64_t sum = 0.0;
+      for (std::size_t k = 0U; k < 3U; ++k) {
+        sum += rotation(static_cast<int>(row % 3U), static_cast<int>(k)) *
+          cov[(block + k) * kDim + col];
+      }
+      rotated[row * kDim + col] = sum;
+    }
+  }
+  for (std::size_t row = 0U; row < kDim; ++row) {
+    for (std::size_t col = 0U; col < kDim; ++col) {
+      const std::size_t block = col - (col % 3U);
+      float64_t sum = 0.0;
+      for (std::size_t k = 0U; k < 3U; ++k) {
+        sum += rotated[row * kDim + block + k] *
+          rotation(static_cast<int>(col % 3U), static_cast<int>(k));
+      }
+      cov[row * kDim + col] = sum;
+    }
+  }
+}
+
+inline void transform_bounding_box(
+  const KDL::Frame & frame, const BoundingBox & t_in, BoundingBox & t_out)
+{
+  if (&t_in != &t_out) {
+    t_out = t_in;
+  }
+  rotate_quaternion(frame.M, t_in.orientation, t_out.orientation);
+  transform_point(frame, t_in.centroid, t_out.centroid);
+  for (std::size_t i = 0U; i < t_in.corners.size(); ++i) {
+    transform_point(frame, t_in.corners[i], t_out.corners[i]);
+  }
+  // TODO(jitrc): add conversion for other fields of BoundingBox, such as heading, variance, size
+}
+
+}  // namespace detail
+}  // namespace autoware_auto_tf2
 
 namespace tf2
 {
@@ -84,11 +179,7 @@ void doTransform(
   // We don't use std::back_inserter to allow aliasing between t_in and t_out
   t_out.points.resize(t_in.points.size());
   for (size_t i = 0; i < t_in.points.size(); ++i) {
-    const KDL::Vector v_out = kdl_frame * KDL::Vector(
-      t_in.points[i].x, t_in.points[i].y, t_in.points[i].z);
-    t_out.points[i].x = static_cast<float>(v_out[0]);
-    t_out.points[i].y = static_cast<float>(v_out[1]);
-    t_out.points[i].z = static_cast<float>(v_out[2]);
+    autoware_auto_tf2::detail::transform_point(kdl_frame, t_in.points[i], t_out.points[i]);
   }
 }
 
@@ -109,15 +200,7 @@ void doTransform(
   autoware_auto_msgs::msg::Quaternion32 & t_out,
   const geometry_msgs::msg::TransformStamped & transform)
 {
-  KDL::Rotation r_in = KDL::Rotation::Quaternion(t_in.x, t_in.y, t_in.z, t_in.w);
-  KDL::Rotation out = gmTransformToKDL(transform).M * r_in;
-
-  double qx, qy, qz, qw;
-  out.GetQuaternion(qx, qy, qz, qw);
-  t_out.x = static_cast<float32_t>(qx);
-  t_out.y = static_cast<float32_t>(qy);
-  t_out.z = static_cast<float32_t>(qz);
-  t_out.w = static_cast<float32_t>(qw);
+  autoware_auto_tf2::detail::rotate_quaternion(gmTransformToKDL(transform).M, t_in, t_out);
 }
 
 
@@ -137,14 +220,7 @@ void doTransform(
   const BoundingBox & t_in, BoundingBox & t_out,
   const geometry_msgs::msg::TransformStamped & transform)
 {
-  t_out = t_in;
-  doTransform(t_in.orientation, t_out.orientation, transform);
-  doTransform(t_in.centroid, t_out.centroid, transform);
-  doTransform(t_in.corners[0], t_out.corners[0], transform);
-  doTransform(t_in.corners[1], t_out.corners[1], transform);
-  doTransform(t_in.corners[2], t_out.corners[2], transform);
-  doTransform(t_in.corners[3], t_out.corners[3], transform);
-  // TODO(jitrc): add conversion for other fields of BoundingBox, such as heading, variance, size
+  autoware_auto_tf2::detail::transform_bounding_box(gmTransformToKDL(transform), t_in, t_out);
 }
 
 
@@ -186,9 +262,145 @@ void doTransform(
   BoundingBoxArray & t_out,
   const geometry_msgs::msg::TransformStamped & transform)
 {
+  // The transform is converted once for all boxes
+  const auto kdl_frame = gmTransformToKDL(transform);
+  t_out = t_in;
+  for (auto & box : t_out.boxes) {
+    autoware_auto_tf2::detail::transform_bounding_box(kdl_frame, box, box);
+  }
+  t_out.header.stamp = transform.header.stamp;
+  t_out.header.frame_id = transform.header.frame_id;
+}
+
+
+/*********************/
+/** DetectedObjects **/
+/*********************/
+
+/** \brief Extract a timestamp from the header of a DetectedObjects message.
+ * This function is a specialization of the getTimestamp template defined in tf2/convert.h.
+ * \param t A timestamped DetectedObjects message to extract the timestamp from.
+ * \return The timestamp of the message.
+ */
+template<>
+inline
+tf2::TimePoint getTimestamp(const DetectedObjects & t)
+{
+  return tf2_ros::fromMsg(t.header.stamp);
+}
+
+/** \brief Extract a frame ID from the header of a DetectedObjects message.
+ * This function is a specialization of the getFrameId template defined in tf2/convert.h.
+ * \param t A timestamped DetectedObjects message to extract the frame ID from.
+ * \return A string containing the frame ID of the message.
+ */
+template<>
+inline
+std::string getFrameId(const DetectedObjects & t) {return t.header.frame_id;}
+
+/** \brief Apply a geometry_msgs TransformStamped to an autoware_auto_msgs DetectedObjects type.
+ * This function is a specialization of the doTransform template defined in tf2/convert.h.
+ * The transform is converted once for all objects. The centroids are transformed, and the
+ * orientations, position covariances, twists and twist covariances are rotated where they are
+ * available. The shapes are relative to the centroid and orientation of their object, so they are
+ * kept. The transform is assumed to be static, i.e. the velocity of the target frame is not added
+ * to the twists.
+ * \param t_in The DetectedObjects to transform, as a timestamped DetectedObjects message.
+ * \param t_out The transformed DetectedObjects, as a timestamped DetectedObjects message.
+ * \param transform The timestamped transform to apply, as a TransformStamped message.
+ */
+template<>
+inline
+void doTransform(
+  const DetectedObjects & t_in,
+  DetectedObjects & t_out,
+  const geometry_msgs::msg::TransformStamped & transform)
+{
+  using autoware_auto_msgs::msg::DetectedObjectKinematics;
+  namespace detail = autoware_auto_tf2::detail;
+  const auto kdl_frame = gmTransformToKDL(transform);
+  t_out = t_in;
+  for (auto & object : t_out.objects) {
+    auto & kinematics = object.kinematics;
+    detail::transform_point(kdl_frame, kinematics.centroid_position, kinematics.centroid_position);
+    if (kinematics.orientation_availability != DetectedObjectKinematics::UNAVAILABLE) {
+      detail::rotate_quaternion(kdl_frame.M, kinematics.orientation, kinematics.orientation);
+    }
+    if (kinematics.has_position_covariance) {
+      detail::rotate_covariance(kdl_frame.M, kinematics.position_covariance);
+    }
+    if (kinematics.has_twist) {
+      detail::rotate_vector(kdl_frame.M, kinematics.twist.twist.linear);
+      detail::rotate_vector(kdl_frame.M, kinematics.twist.twist.angular);
+    }
+    if (kinematics.has_twist_covariance) {
+      detail::rotate_covariance(kdl_frame.M, kinematics.twist.covariance);
+    }
+  }
+  t_out.header.stamp = transform.header.stamp;
+  t_out.header.frame_id = transform.header.frame_id;
+}
+
+
+/********************/
+/** TrackedObjects **/
+/********************/
+
+/** \brief Extract a timestamp from the header of a TrackedObjects message.
+ * This function is a specialization of the getTimestamp template defined in tf2/convert.h.
+ * \param t A timestamped TrackedObjects message to extract the timestamp from.
+ * \return The timestamp of the message.
+ */
+template<>
+inline
+tf2::TimePoint getTimestamp(const TrackedObjects & t)
+{
+  return tf2_ros::fromMsg(t.header.stamp);
+}
+
+/** \brief Extract a frame ID from the header of a TrackedObjects message.
+ * This function is a specialization of the getFrameId template defined in tf2/convert.h.
+ * \param t A timestamped TrackedObjects message to extract the frame ID from.
+ * \return A string containing the frame ID of the message.
+ */
+template<>
+inline
+std::string getFrameId(const TrackedObjects & t) {return t.header.frame_id;}
+
+/** \brief Apply a geometry_msgs TransformStamped to an autoware_auto_msgs TrackedObjects type.
+ * This function is a specialization of the doTransform template defined in tf2/convert.h.
+ * The transform is converted once for all objects. The centroids are transformed, and the
+ * orientations, where they are available, the position covariances, the twists and the
+ * accelerations with their covariances are rotated. The shapes are kept, and the transform is
+ * assumed to be static, as for DetectedObjects.
+ * \param t_in The TrackedObjects to transform, as a timestamped TrackedObjects message.
+ * \param t_out The transformed TrackedObjects, as a timestamped TrackedObjects message.
+ * \param transform The timestamped transform to apply, as a TransformStamped message.
+ */
+template<>
+inline
+void doTransform(
+  const TrackedObjects & t_in,
+  TrackedObjects & t_out,
+  const geometry_msgs::msg::TransformStamped & transform)
+{
+  using autoware_auto_msgs::msg::TrackedObjectKinematics;
+  namespace detail = autoware_auto_tf2::detail;
+  const auto kdl_frame = gmTransformToKDL(transform);
   t_out = t_in;
-  for (auto idx = 0U; idx < t_in.boxes.size(); idx++) {
-    doTransform(t_out.boxes[idx], t_out.boxes[idx], transform);
+  for (auto & object : t_out.objects) {
+    auto & kinematics = object.kinematics;
+    detail::transform_point(kdl_frame, kinematics.centroid_position, kinematics.centroid_position);
+    if (kinematics.orientation_availability != TrackedObjectKinematics::UNAVAILABLE) {
+      detail::rotate_quaternion(kdl_frame.M, kinematics.orientation, kinematics.orientation);
+    }
+    detail::rotate_covariance(kdl_frame.M, kinematics.position_covariance);
+    detail::rotate_vector(kdl_frame.M, kinematics.twist.twist.linear);
+    detail::rotate_vector(kdl_frame.M, kinematics.twist.twist.angular);
+    detail::rotate_covariance(kdl_frame.M, kinematics.twist.covariance);
+    detail::rotate_vector(kdl_frame.M, kinematics.acceleration.accel.linear);
+    detail::rotate_vector(kdl_frame.M, kinematics.acceleration.accel.angular);
+    detail::rotate_covariance(kdl_frame.M, kinematics.acceleration.covariance);
   }
   t_out.header.stamp = transform.header.stamp;
   t_out.header.frame_id = transform.header.frame_id;
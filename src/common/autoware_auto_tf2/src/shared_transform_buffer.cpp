@@ -0,0 +1,101 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware_auto_tf2/shared_transform_buffer.hpp>
+#include <tf2/time.h>
+
+#include <memory>
+#include <string>
+
+namespace autoware_auto_tf2
+{
+
+constexpr std::size_t SharedTransformBuffer::MAX_STATIC_TRANSFORMS;
+
+std::shared_ptr<SharedTransformBuffer> SharedTransformBuffer::get(
+  const rclcpp::Clock::SharedPtr & clock)
+{
+  static std::mutex instance_mutex;
+  static std::weak_ptr<SharedTransformBuffer> instance;
+  std::lock_guard<std::mutex> lock{instance_mutex};
+  auto buffer = instance.lock();
+  if (!buffer) {
+    // The constructor is private, hence no make_shared
+    buffer = std::shared_ptr<SharedTransformBuffer>{new SharedTransformBuffer{clock}};
+    instance = buffer;
+  }
+  return buffer;
+}
+
+SharedTransformBuffer::SharedTransformBuffer(const rclcpp::Clock::SharedPtr & clock)
+: m_buffer{clock},
+  m_listener{m_buffer},
+  m_static_transforms{new StaticTransform[MAX_STATIC_TRANSFORMS]}
+{
+}
+
+tf2_ros::Buffer & SharedTransformBuffer::buffer() noexcept
+{
+  return m_buffer;
+}
+
+geometry_msgs::msg::Transform SharedTransformBuffer::lookup_latest_transform(
+  const std::string & target_frame, const std::string & source_frame)
+{
+  const auto * const cached = find_static(target_frame, source_frame);
+  if (cached != nullptr) {
+    return cached->transform;
+  }
+  const auto tf = m_buffer.lookupTransform(target_frame, source_frame, tf2::TimePointZero);
+  // The latest common time of a chain of static transforms only is zero, a dynamic transform in
+  // the chain makes it the time of its latest update
+  if ((tf.header.stamp.sec == 0) && (tf.header.stamp.nanosec == 0U)) {
+    cache_static(target_frame, source_frame, tf.transform);
+  }
+  return tf.transform;
+}
+
+const SharedTransformBuffer::StaticTransform * SharedTransformBuffer::find_static(
+  const std::string & target_frame, const std::string & source_frame) const noexcept
+{
+  const auto num_static_transforms = m_num_static_transforms.load(std::memory_order_acquire);
+  for (std::size_t i = 0U; i < num_static_transforms; ++i) {
+    const auto & entry = m_static_transforms[i];
+    if ((entry.source_frame == source_frame) && (entry.target_frame == target_frame)) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+void SharedTransformBuffer::cache_static(
+  const std::string & target_frame, const std::string & source_frame,
+  const geometry_msgs::msg::Transform & transform)
+{
+  std::lock_guard<std::mutex> lock{m_static_mutex};
+  // Another thread may have cached it since the lookup
+  const auto num_static_transforms = m_num_static_transforms.load(std::memory_order_relaxed);
+  if ((num_static_transforms >= MAX_STATIC_TRANSFORMS) ||
+    (find_static(target_frame, source_frame) != nullptr))
+  {
+    return;
+  }
+  auto & entry = m_static_transforms[num_static_transforms];
+  entry.target_frame = target_frame;
+  entry.source_frame = source_frame;
+  entry.transform = transform;
+  m_num_static_transforms.store(num_static_transforms + 1U, std::memory_order_release);
+}
+
+}  // namespace autoware_auto_tf2
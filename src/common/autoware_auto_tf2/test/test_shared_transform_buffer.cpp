@@ -0,0 +1,89 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware_auto_tf2/shared_transform_buffer.hpp>
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include <tf2/exceptions.h>
+
+#include <memory>
+#include <string>
+
+using autoware_auto_tf2::SharedTransformBuffer;
+
+class SharedTransformBufferTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  void TearDown() override
+  {
+    rclcpp::shutdown();
+  }
+
+  static geometry_msgs::msg::TransformStamped make_transform(
+    const std::string & parent, const std::string & child, const int32_t sec, const double x)
+  {
+    geometry_msgs::msg::TransformStamped tf;
+    tf.header.frame_id = parent;
+    tf.header.stamp.sec = sec;
+    tf.child_frame_id = child;
+    tf.transform.translation.x = x;
+    tf.transform.rotation.w = 1.0;
+    return tf;
+  }
+
+  rclcpp::Clock::SharedPtr m_clock{std::make_shared<rclcpp::Clock>(RCL_ROS_TIME)};
+};
+
+TEST_F(SharedTransformBufferTest, SharedWhileHeld)
+{
+  const auto first = SharedTransformBuffer::get(m_clock);
+  const auto second = SharedTransformBuffer::get(m_clock);
+  EXPECT_EQ(first.get(), second.get());
+  first->buffer().setTransform(make_transform("base_link", "lidar", 0, 1.0), "test", true);
+  EXPECT_TRUE(second->buffer().canTransform("base_link", "lidar", tf2::TimePointZero));
+}
+
+TEST_F(SharedTransformBufferTest, StaticTransformsAreCached)
+{
+  const auto buffer = SharedTransformBuffer::get(m_clock);
+  EXPECT_THROW(buffer->lookup_latest_transform("base_link", "lidar"), tf2::TransformException);
+
+  buffer->buffer().setTransform(make_transform("base_link", "lidar", 0, 1.0), "test", true);
+  EXPECT_DOUBLE_EQ(buffer->lookup_latest_transform("base_link", "lidar").translation.x, 1.0);
+  EXPECT_DOUBLE_EQ(buffer->lookup_latest_transform("lidar", "base_link").translation.x, -1.0);
+
+  // The cached transform is kept, although the buffer has the new one
+  buffer->buffer().setTransform(make_transform("base_link", "lidar", 0, 2.0), "test", true);
+  EXPECT_DOUBLE_EQ(buffer->lookup_latest_transform("base_link", "lidar").translation.x, 1.0);
+  EXPECT_DOUBLE_EQ(
+    buffer->buffer().lookupTransform(
+      "base_link", "lidar", tf2::TimePointZero).transform.translation.x, 2.0);
+}
+
+TEST_F(SharedTransformBufferTest, DynamicTransformsAreNotCached)
+{
+  const auto buffer = SharedTransformBuffer::get(m_clock);
+  buffer->buffer().setTransform(make_transform("odom", "base_link", 1, 1.0), "test", false);
+  buffer->buffer().setTransform(make_transform("base_link", "lidar", 0, 0.5), "test", true);
+  EXPECT_DOUBLE_EQ(buffer->lookup_latest_transform("odom", "lidar").translation.x, 1.5);
+
+  buffer->buffer().setTransform(make_transform("odom", "base_link", 2, 3.0), "test", false);
+  EXPECT_DOUBLE_EQ(buffer->lookup_latest_transform("odom", "lidar").translation.x, 3.5);
+  EXPECT_DOUBLE_EQ(buffer->lookup_latest_transform("base_link", "lidar").translation.x, 0.5);
+}
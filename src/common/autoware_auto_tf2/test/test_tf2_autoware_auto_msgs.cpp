@@ -21,6 +21,8 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <autoware_auto_tf2/tf2_autoware_auto_msgs.hpp>
 #include <rclcpp/clock.hpp>
+#include <array>
+#include <cmath>
 #include <memory>
 
 std::unique_ptr<tf2_ros::Buffer> tf_buffer = nullptr;
@@ -308,6 +310,115 @@ TEST(Tf2AutowareAuto, TransformBoundingBoxArray)
   EXPECT_NEAR(bba_advanced.boxes[1].corners[3].z, -24, EPS);
 }
 
+TEST(Tf2AutowareAuto, TransformDetectedObjects)
+{
+  using autoware_auto_msgs::msg::DetectedObjectKinematics;
+  autoware_auto_msgs::msg::DetectedObject object;
+  object.kinematics.centroid_position.x = 1;
+  object.kinematics.centroid_position.y = 2;
+  object.kinematics.centroid_position.z = 3;
+  object.kinematics.orientation_availability = DetectedObjectKinematics::AVAILABLE;
+  object.kinematics.orientation.w = 0;
+  object.kinematics.orientation.z = 1;
+  object.kinematics.has_position_covariance = true;
+  object.kinematics.position_covariance = {1.0, 0.5, 0.25, 0.5, 2.0, 0.1, 0.25, 0.1, 3.0};
+  object.kinematics.has_twist = true;
+  object.kinematics.twist.twist.linear.x = 1;
+  object.kinematics.twist.twist.linear.y = 2;
+  object.kinematics.twist.twist.linear.z = 3;
+  object.kinematics.twist.twist.angular.z = 0.5;
+  object.kinematics.has_twist_covariance = true;
+  object.kinematics.twist.covariance[0] = 4.0;
+  object.kinematics.twist.covariance[1] = 0.5;
+  object.kinematics.twist.covariance[4] = 0.3;
+  object.kinematics.twist.covariance[(3 * 6) + 5] = 0.2;
+  object.shape.polygon.points.resize(1U);
+  object.shape.polygon.points[0].x = 1;
+  object.shape.polygon.points[0].y = 1;
+
+  // Only the centroid of this object is transformed
+  autoware_auto_msgs::msg::DetectedObject bare_object;
+  bare_object.kinematics.centroid_position.x = 1;
+  bare_object.kinematics.orientation_availability = DetectedObjectKinematics::UNAVAILABLE;
+  bare_object.kinematics.orientation.w = 1;
+  bare_object.kinematics.has_twist = false;
+  bare_object.kinematics.twist.twist.linear.y = 2;
+
+  DetectedObjects objects;
+  objects.header.stamp = tf2_ros::toMsg(tf2::timeFromSec(2));
+  objects.header.frame_id = "A";
+  objects.objects.push_back(object);
+  objects.objects.push_back(bare_object);
+
+  const auto out = tf_buffer->transform(objects, "B", tf2::durationFromSec(2.0));
+  EXPECT_EQ(out.header.frame_id, "B");
+  ASSERT_EQ(out.objects.size(), 2U);
+
+  const auto & kinematics = out.objects[0].kinematics;
+  EXPECT_NEAR(kinematics.centroid_position.x, -9, EPS);
+  EXPECT_NEAR(kinematics.centroid_position.y, 18, EPS);
+  EXPECT_NEAR(kinematics.centroid_position.z, 27, EPS);
+  EXPECT_NEAR(std::abs(kinematics.orientation.y), 1.0, EPS);
+  EXPECT_NEAR(kinematics.orientation.w, 0.0, EPS);
+  // The rotation about x flips the sign of the correlations of x with y and z
+  const std::array<double, 9> expected_covariance{1.0, -0.5, -0.25, -0.5, 2.0, 0.1, -0.25, 0.1,
+    3.0};
+  for (std::size_t i = 0U; i < expected_covariance.size(); ++i) {
+    EXPECT_NEAR(kinematics.position_covariance[i], expected_covariance[i], EPS) << i;
+  }
+  EXPECT_NEAR(kinematics.twist.twist.linear.x, 1, EPS);
+  EXPECT_NEAR(kinematics.twist.twist.linear.y, -2, EPS);
+  EXPECT_NEAR(kinematics.twist.twist.linear.z, -3, EPS);
+  EXPECT_NEAR(kinematics.twist.twist.angular.z, -0.5, EPS);
+  EXPECT_NEAR(kinematics.twist.covariance[0], 4.0, EPS);
+  EXPECT_NEAR(kinematics.twist.covariance[1], -0.5, EPS);
+  EXPECT_NEAR(kinematics.twist.covariance[4], -0.3, EPS);
+  EXPECT_NEAR(kinematics.twist.covariance[(3 * 6) + 5], -0.2, EPS);
+  EXPECT_EQ(out.objects[0].shape, object.shape);
+
+  const auto & bare_kinematics = out.objects[1].kinematics;
+  EXPECT_NEAR(bare_kinematics.centroid_position.x, -9, EPS);
+  EXPECT_EQ(bare_kinematics.orientation, bare_object.kinematics.orientation);
+  EXPECT_EQ(bare_kinematics.twist, bare_object.kinematics.twist);
+}
+
+TEST(Tf2AutowareAuto, TransformTrackedObjects)
+{
+  using autoware_auto_msgs::msg::TrackedObjectKinematics;
+  autoware_auto_msgs::msg::TrackedObject object;
+  object.kinematics.centroid_position.x = 1;
+  object.kinematics.centroid_position.y = 2;
+  object.kinematics.centroid_position.z = 3;
+  object.kinematics.orientation_availability = TrackedObjectKinematics::SIGN_UNKNOWN;
+  object.kinematics.orientation.w = 0;
+  object.kinematics.orientation.z = 1;
+  object.kinematics.position_covariance = {1.0, 0.5, 0.0, 0.5, 2.0, 0.0, 0.0, 0.0, 3.0};
+  object.kinematics.twist.twist.linear.y = 2;
+  object.kinematics.acceleration.accel.linear.y = 1;
+  object.kinematics.acceleration.covariance[1] = 0.5;
+
+  TrackedObjects objects;
+  objects.header.stamp = tf2_ros::toMsg(tf2::timeFromSec(2));
+  objects.header.frame_id = "B";
+  objects.objects.push_back(object);
+
+  TrackedObjects out;
+  tf2::doTransform(objects, out, filled_transfom());
+  EXPECT_EQ(out.header.frame_id, "A");
+  ASSERT_EQ(out.objects.size(), 1U);
+
+  const auto & kinematics = out.objects[0].kinematics;
+  EXPECT_NEAR(kinematics.centroid_position.x, 11, EPS);
+  EXPECT_NEAR(kinematics.centroid_position.y, 18, EPS);
+  EXPECT_NEAR(kinematics.centroid_position.z, 27, EPS);
+  EXPECT_NEAR(std::abs(kinematics.orientation.y), 1.0, EPS);
+  EXPECT_NEAR(kinematics.position_covariance[1], -0.5, EPS);
+  EXPECT_NEAR(kinematics.position_covariance[4], 2.0, EPS);
+  EXPECT_NEAR(kinematics.twist.twist.linear.y, -2, EPS);
+  EXPECT_NEAR(kinematics.acceleration.accel.linear.y, -1, EPS);
+  EXPECT_NEAR(kinematics.acceleration.covariance[1], -0.5, EPS);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -22,6 +22,7 @@
 
 #include <common/types.hpp>
 #include <covariance_insertion/add_covariance.hpp>
+#include <covariance_insertion/resolved_covariances.hpp>
 #include <covariance_insertion/visibility_control.hpp>
 
 #include <map>
@@ -40,6 +41,8 @@ public:
   CovarianceInsertion();
 
   /// @brief      populate msg from the covarianes
+  ///
+  /// The fields are resolved for every call, resolve() can be used instead for many messages.
   /// @param      msg  message to be populated
   template<typename MsgT>
   void set_all_covariances(MsgT * msg)
@@ -52,6 +55,19 @@ public:
     }
   }
 
+  /// @brief      resolve the fields of the covariances for a message type
+  /// @throws     std::runtime_error  if a covariance cannot be set in this message type
+  /// @return     the covariances, which populate messages without looking up the fields
+  template<typename MsgT>
+  ResolvedCovariances<MsgT> resolve() const
+  {
+    ResolvedCovariances<MsgT> resolved{};
+    for (const auto & kv : m_covariances) {
+      resolved.add(kv.first, kv.second);
+    }
+    return resolved;
+  }
+
   /// @brief      check if the covariance map is empty
   bool covariances_empty();
 
@@ -0,0 +1,184 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COVARIANCE_INSERTION__RESOLVED_COVARIANCES_HPP_
+#define COVARIANCE_INSERTION__RESOLVED_COVARIANCES_HPP_
+
+#include <common/types.hpp>
+#include <covariance_insertion/add_covariance.hpp>
+#include <covariance_insertion/traits.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace autoware
+{
+namespace covariance_insertion
+{
+
+namespace detail
+{
+struct DirectlyTag {};
+struct PoseTag {};
+struct TwistTag {};
+
+/// Path from a message to the covariance which is selected by a tag, only defined for the tags
+/// which are valid for the message. The paths follow the fields of add_covariance().
+template<typename TagT, typename MsgT, typename = void>
+struct covariance_path;
+
+/// A field holds the covariance itself, or is searched for the same tag again.
+template<typename TagT, typename FieldT>
+auto field_covariance(FieldT & field)
+-> std::enable_if_t<has_covariance_member<FieldT>::value, decltype((field.covariance))>
+{
+  return field.covariance;
+}
+
+template<typename TagT, typename FieldT>
+auto field_covariance(FieldT & field)
+-> std::enable_if_t<!has_covariance_member<FieldT>::value,
+  decltype(covariance_path<TagT, FieldT>::get(field))>
+{
+  return covariance_path<TagT, FieldT>::get(field);
+}
+
+template<typename MsgT>
+struct covariance_path<DirectlyTag, MsgT, std::enable_if_t<has_covariance_member<MsgT>::value>>
+{
+  static auto get(MsgT & msg) -> decltype((msg.covariance)) {return msg.covariance;}
+};
+
+template<typename MsgT>
+struct covariance_path<PoseTag, MsgT, std::enable_if_t<
+    has_pose_member<MsgT>::value && !has_covariance_member<MsgT>::value>>
+{
+  static auto get(MsgT & msg) -> decltype(field_covariance<PoseTag>(msg.pose))
+  {
+    return field_covariance<PoseTag>(msg.pose);
+  }
+};
+
+template<typename MsgT>
+struct covariance_path<TwistTag, MsgT, std::enable_if_t<
+    has_twist_member<MsgT>::value && !has_covariance_member<MsgT>::value>>
+{
+  static auto get(MsgT & msg) -> decltype(field_covariance<TwistTag>(msg.twist))
+  {
+    return field_covariance<TwistTag>(msg.twist);
+  }
+};
+
+template<typename TagT, typename MsgT, typename = void>
+struct has_covariance_path : std::false_type {};
+
+template<typename TagT, typename MsgT>
+struct has_covariance_path<TagT, MsgT,
+  decltype((void)covariance_path<TagT, MsgT>::get(std::declval<MsgT &>()), void())>
+  : std::true_type {};
+
+template<typename TagT, typename MsgT>
+common::types::float64_t * covariance_data(MsgT & msg)
+{
+  return covariance_path<TagT, MsgT>::get(msg).data();
+}
+}  // namespace detail
+
+/// @brief Covariances of which the fields are resolved for a message type
+///
+/// The field names are resolved to the covariance arrays of the message when the covariances are
+/// added, so that setting the covariances of a message only copies the values.
+template<typename MsgT>
+class ResolvedCovariances
+{
+public:
+  /// @brief      resolve the field and add its covariance
+  /// @param      field  name of the field, one of "directly", "pose" and "twist"
+  /// @param      covariance  values of the covariance
+  /// @throws     std::runtime_error  if the message has no such covariance, or if the number of
+  ///             values does not match
+  void add(const std::string & field, const std::vector<common::types::float64_t> & covariance)
+  {
+    if (field == detail::kDirectlyTag) {
+      add<detail::DirectlyTag>(field, covariance);
+    } else if (field == detail::kPoseTag) {
+      add<detail::PoseTag>(field, covariance);
+    } else if (field == detail::kTwistTag) {
+      add<detail::TwistTag>(field, covariance);
+    } else {
+      throw std::runtime_error("Cannot set: " + field);
+    }
+  }
+
+  /// @brief      populate msg from the covariances
+  /// @param      msg  message to be populated
+  void set_all_covariances(MsgT * msg) const
+  {
+    if (!msg) {return;}
+    for (const auto & write : m_writes) {
+      std::copy(write.covariance.begin(), write.covariance.end(), write.data(*msg));
+    }
+  }
+
+  /// @brief      check if no covariance has been added
+  bool empty() const noexcept
+  {
+    return m_writes.empty();
+  }
+
+private:
+  struct Write
+  {
+    common::types::float64_t * (*data)(MsgT &);
+    std::vector<common::types::float64_t> covariance;
+  };
+
+  template<typename TagT>
+  std::enable_if_t<detail::has_covariance_path<TagT, MsgT>::value> add(
+    const std::string &, const std::vector<common::types::float64_t> & covariance)
+  {
+    using CovarianceT = std::decay_t<
+      decltype(detail::covariance_path<TagT, MsgT>::get(std::declval<MsgT &>()))>;
+    constexpr std::size_t kSize = std::tuple_size<CovarianceT>::value;
+    if (covariance.size() != kSize) {
+      throw std::runtime_error(
+              "Number of covariance entries does not match. The message has " +
+              std::to_string(kSize) + " entries, while there are " +
+              std::to_string(covariance.size()) + " entries in parameters of this node.");
+    }
+    m_writes.push_back(Write{&detail::covariance_data<TagT, MsgT>, covariance});
+  }
+
+  template<typename TagT>
+  std::enable_if_t<!detail::has_covariance_path<TagT, MsgT>::value> add(
+    const std::string & field, const std::vector<common::types::float64_t> &)
+  {
+    if (has_covariance_member<MsgT>::value) {
+      throw std::runtime_error("Message has covariance directly, but asked for field: " + field);
+    }
+    throw std::runtime_error("Cannot set: " + field);
+  }
+
+  std::vector<Write> m_writes;
+};
+
+}  // namespace covariance_insertion
+}  // namespace autoware
+
+#endif  // COVARIANCE_INSERTION__RESOLVED_COVARIANCES_HPP_
@@ -117,8 +117,7 @@ void CovarianceInsertionNode::validate(const MsgVariant & msg_variant)
     [&](const auto & msg) {
       using InputMsgT = std::decay_t<decltype(msg)>;
       using OutputType = typename output<InputMsgT>::type;
-      OutputType new_msg{};
-      m_core->set_all_covariances(&new_msg);
+      (void)m_core->resolve<OutputType>();
     }, msg_variant);
 }
 
@@ -129,13 +128,15 @@ void CovarianceInsertionNode::create_pub_sub(const MsgVariant & msg_variant)
     [&](const auto & msg) {
       using InputMsgT = std::decay_t<decltype(msg)>;
       using OutputType = typename output<InputMsgT>::type;
+      // The fields are resolved once, so that each message only gets the covariances copied
+      const auto covariances = m_core->resolve<OutputType>();
       m_publisher = create_publisher<OutputType>(m_output_topic, m_history_size);
       m_subscription = create_subscription<InputMsgT>(
         m_input_topic, m_history_size,
-        [&](const typename InputMsgT::SharedPtr msg) {
+        [this, covariances](const typename InputMsgT::SharedPtr msg) {
           if (!msg) {return;}
           auto new_msg = convert(*msg);
-          m_core->set_all_covariances(&new_msg);
+          covariances.set_all_covariances(&new_msg);
           auto publisher = std::static_pointer_cast<rclcpp::Publisher<OutputType>>(m_publisher);
           publisher->publish(new_msg);
         });
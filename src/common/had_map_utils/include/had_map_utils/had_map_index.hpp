@@ -0,0 +1,106 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HAD_MAP_UTILS__HAD_MAP_INDEX_HPP_
+#define HAD_MAP_UTILS__HAD_MAP_INDEX_HPP_
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <common/types.hpp>
+#include <lanelet2_core/LaneletMap.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "had_map_utils/visibility_control.hpp"
+
+namespace autoware
+{
+namespace common
+{
+namespace had_map_utils
+{
+using autoware::common::types::bool8_t;
+using autoware::common::types::float64_t;
+
+/// \brief Spatial index of the lanelets and areas of a map by their subtype, built once when the
+/// map is loaded. Each subtype has an R-tree over the centers of its primitives, so that finding
+/// the primitives of a subtype nearest to a location, e.g. the parking spot a goal is in, takes
+/// logarithmic time in the number of primitives instead of a pass over the whole layer. The center
+/// of a primitive is the mean of its boundary vertices.
+///
+/// The index holds ids only and does not keep the map alive. Primitives without a subtype are not
+/// indexed.
+class HAD_MAP_UTILS_PUBLIC PrimitiveIndex
+{
+public:
+  /// Predicate on the id of a primitive.
+  using Filter = std::function<bool8_t(lanelet::Id)>;
+
+  /// Construct an empty index.
+  PrimitiveIndex() = default;
+
+  /// Index the lanelets and areas of a map.
+  /// \param map Map to index.
+  explicit PrimitiveIndex(const lanelet::LaneletMap & map);
+
+  /// Find the lanelets of some subtypes whose centers are nearest to a location.
+  /// \param subtypes Subtypes of the lanelets, e.g. "road".
+  /// \param point Location in the map frame.
+  /// \param count Maximum number of lanelets.
+  /// \param filter If set, only lanelets whose id satisfies it are returned.
+  /// \return Ids of the lanelets by increasing distance.
+  lanelet::Ids nearest_lanelets(
+    const std::vector<std::string> & subtypes, const lanelet::BasicPoint3d & point,
+    const std::size_t count, const Filter & filter = Filter{}) const;
+
+  /// Find the areas of some subtypes whose centers are nearest to a location.
+  /// \param subtypes Subtypes of the areas, e.g. "parking_spot" or "parking_access".
+  /// \param point Location in the map frame.
+  /// \param count Maximum number of areas.
+  /// \param filter If set, only areas whose id satisfies it are returned.
+  /// \return Ids of the areas by increasing distance.
+  lanelet::Ids nearest_areas(
+    const std::vector<std::string> & subtypes, const lanelet::BasicPoint3d & point,
+    const std::size_t count, const Filter & filter = Filter{}) const;
+
+  /// Get the number of indexed lanelets of a subtype.
+  std::size_t num_lanelets(const std::string & subtype) const;
+
+  /// Get the number of indexed areas of a subtype.
+  std::size_t num_areas(const std::string & subtype) const;
+
+private:
+  using Point = boost::geometry::model::point<float64_t, 3U, boost::geometry::cs::cartesian>;
+  using Value = std::pair<Point, lanelet::Id>;
+  using RTree = boost::geometry::index::rtree<Value, boost::geometry::index::quadratic<16U>>;
+  using SubtypeTrees = std::map<std::string, RTree>;
+
+  static lanelet::Ids nearest(
+    const SubtypeTrees & trees, const std::vector<std::string> & subtypes,
+    const lanelet::BasicPoint3d & point, const std::size_t count, const Filter & filter);
+
+  static std::size_t size(const SubtypeTrees & trees, const std::string & subtype);
+
+  SubtypeTrees m_lanelets{};
+  SubtypeTrees m_areas{};
+};
+
+}  // namespace had_map_utils
+}  // namespace common
+}  // namespace autoware
+
+#endif  // HAD_MAP_UTILS__HAD_MAP_INDEX_HPP_
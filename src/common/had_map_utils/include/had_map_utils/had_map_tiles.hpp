@@ -0,0 +1,170 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HAD_MAP_UTILS__HAD_MAP_TILES_HPP_
+#define HAD_MAP_UTILS__HAD_MAP_TILES_HPP_
+
+#include <autoware_auto_msgs/msg/had_map_bin.hpp>
+#include <common/types.hpp>
+#include <lanelet2_core/LaneletMap.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "had_map_utils/visibility_control.hpp"
+
+namespace autoware
+{
+namespace common
+{
+namespace had_map_utils
+{
+using autoware::common::types::bool8_t;
+using autoware::common::types::float64_t;
+
+/// Index of a square tile of the map in the xy plane.
+struct HAD_MAP_UTILS_PUBLIC MapTileId
+{
+  int32_t x;
+  int32_t y;
+};
+
+HAD_MAP_UTILS_PUBLIC bool8_t operator<(const MapTileId & lhs, const MapTileId & rhs) noexcept;
+HAD_MAP_UTILS_PUBLIC bool8_t operator==(const MapTileId & lhs, const MapTileId & rhs) noexcept;
+
+/// Division of the xy plane of the map frame into square tiles, tile (0, 0) having its lower
+/// corner at the origin.
+class HAD_MAP_UTILS_PUBLIC MapTiling
+{
+public:
+  /// Constructor
+  /// \param tile_size Side length of the tiles in meters.
+  /// \throw std::domain_error if the tile size is not positive.
+  explicit MapTiling(const float64_t tile_size);
+
+  /// Get the tile which contains a location.
+  /// \param x x coordinate of the location
+  /// \param y y coordinate of the location
+  /// \return Id of the tile.
+  MapTileId tile_of(const float64_t x, const float64_t y) const;
+
+  /// Get the tiles which intersect the axis aligned square of a radius around a location.
+  /// \param x x coordinate of the location
+  /// \param y y coordinate of the location
+  /// \param radius Half side length of the square.
+  /// \return Ids of the tiles, ordered by increasing y and then x.
+  std::vector<MapTileId> tiles_within(
+    const float64_t x, const float64_t y, const float64_t radius) const;
+
+  /// Get the bounds of a tile, e.g. for the geometric bounds of a HADMapService request.
+  /// \param id Id of the tile.
+  /// \return Bounding box of the tile.
+  lanelet::BoundingBox2d bounds(const MapTileId & id) const;
+
+  /// Get the side length of the tiles.
+  float64_t tile_size() const noexcept {return m_tile_size;}
+
+private:
+  float64_t m_tile_size;
+};
+
+/// \brief Local lanelet map assembled from tiles of a larger map, e.g. the sub-maps returned by
+/// the lanelet2 map provider for the bounds of each tile. A client only requests and deserializes
+/// the tiles which it enters, and evicts the tiles which it leaves, so that the cost of an update
+/// is bounded by the newly entered area.
+///
+/// Primitives which cross tile borders are contained in several tiles. The first copy of a
+/// primitive which is merged into the local map is kept, and lanelets and areas of later tiles
+/// are linked to the kept line strings and points of the same id, so that adjacency across tiles
+/// is preserved, e.g. for routing. Regulatory elements are not merged.
+class HAD_MAP_UTILS_PUBLIC TiledLaneletMap
+{
+public:
+  /// Constructor
+  /// \param tiling Tiling the tiles are defined by.
+  explicit TiledLaneletMap(const MapTiling & tiling);
+
+  /// Get the tiles around a location which have not been inserted yet.
+  /// \param x x coordinate of the location
+  /// \param y y coordinate of the location
+  /// \param radius Half side length of the square of tiles around the location, see
+  /// `MapTiling::tiles_within()`.
+  /// \return Ids of the missing tiles.
+  std::vector<MapTileId> missing_tiles(
+    const float64_t x, const float64_t y, const float64_t radius) const;
+
+  /// Insert a serialized tile, see `insert(id, map_version, tile)`.
+  /// \param id Id of the tile.
+  /// \param msg Serialized tile. Its `map_version` identifies the map the tile was cut from.
+  /// \return True if the local map changed.
+  bool8_t insert(const MapTileId & id, const autoware_auto_msgs::msg::HADMapBin & msg);
+
+  /// Insert a tile and merge it into the local map. A tile which is already present is ignored.
+  /// A tile of another map version replaces all tiles, since they are stale.
+  /// \param id Id of the tile.
+  /// \param map_version Version of the map the tile was cut from.
+  /// \param tile Primitives of the tile. They are linked to the primitives of the local map and
+  /// must not be modified afterwards.
+  /// \return True if the local map changed.
+  bool8_t insert(
+    const MapTileId & id, const std::string & map_version,
+    const std::shared_ptr<lanelet::LaneletMap> & tile);
+
+  /// Remove the tiles which are not within a radius of a location, and rebuild the local map
+  /// from the remaining tiles if any were removed. Rebuilding only links the already
+  /// deserialized primitives.
+  /// \param x x coordinate of the location
+  /// \param y y coordinate of the location
+  /// \param radius Half side length of the square of tiles to keep, see
+  /// `MapTiling::tiles_within()`.
+  /// \return Number of removed tiles.
+  std::size_t evict(const float64_t x, const float64_t y, const float64_t radius);
+
+  /// Get the local map. It is replaced by a new map when tiles are evicted or replaced.
+  /// \return Map of all inserted tiles.
+  const std::shared_ptr<lanelet::LaneletMap> & map() const noexcept {return m_map;}
+
+  /// Get the map version of the tiles.
+  /// \return Map version, empty if no tile was inserted.
+  const std::string & map_version() const noexcept {return m_map_version;}
+
+  /// Get the number of tiles.
+  std::size_t size() const noexcept {return m_tiles.size();}
+
+  /// Get the tiling.
+  const MapTiling & tiling() const noexcept {return m_tiling;}
+
+private:
+  /// Link the primitives of a tile to the ones of the local map and add the new ones to it.
+  void merge(lanelet::LaneletMap & tile);
+
+  /// Get the line string of the local map with the id of a line string, in the same direction.
+  lanelet::LineString3d shared(const lanelet::LineString3d & line_string) const;
+
+  /// Build a new local map from all tiles.
+  void rebuild();
+
+  MapTiling m_tiling;
+  std::map<MapTileId, std::shared_ptr<lanelet::LaneletMap>> m_tiles{};
+  std::string m_map_version{};
+  std::shared_ptr<lanelet::LaneletMap> m_map;
+};
+
+}  // namespace had_map_utils
+}  // namespace common
+}  // namespace autoware
+
+#endif  // HAD_MAP_UTILS__HAD_MAP_TILES_HPP_
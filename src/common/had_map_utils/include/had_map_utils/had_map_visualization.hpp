@@ -84,13 +84,15 @@ void HAD_MAP_UTILS_PUBLIC setMarkerHeader(
  * \param ns namespace set to the marker
  * \param c color of the marker
  * \param lss linestrip scale (i.e. width)
+ * \param simplify_tolerance if positive, points within this distance of the simplified
+ * linestrip are dropped (Douglas-Peucker), the end points are always kept
  * \return created visualization_msgs::msg::Marker
  */
 visualization_msgs::msg::Marker HAD_MAP_UTILS_PUBLIC lineString2Marker(
   const rclcpp::Time & t,
   const lanelet::LineString3d & ls,
   const std::string & frame_id, const std::string & ns, const std_msgs::msg::ColorRGBA & c,
-  const float32_t & lss);
+  const float32_t & lss, const float64_t & simplify_tolerance = 0.0);
 
 /**
  * \brief creates marker with type LINE_STRIP from a lanelet::ConstLineString3d object
@@ -100,13 +102,15 @@ visualization_msgs::msg::Marker HAD_MAP_UTILS_PUBLIC lineString2Marker(
  * \param ns namespace set to the marker
  * \param c color of the marker
  * \param lss linestrip scale (i.e. width)
+ * \param simplify_tolerance if positive, points within this distance of the simplified
+ * linestrip are dropped (Douglas-Peucker), the end points are always kept
  * \return created visualization_msgs::msg::Marker
  */
 visualization_msgs::msg::Marker HAD_MAP_UTILS_PUBLIC lineString2Marker(
   const rclcpp::Time & t,
   const lanelet::ConstLineString3d & ls,
   const std::string & frame_id, const std::string & ns, const std_msgs::msg::ColorRGBA & c,
-  const float32_t & lss);
+  const float32_t & lss, const float64_t & simplify_tolerance = 0.0);
 
 /**
  * \brief converts lanelet::LineString into markers with type LINE_STRIP
@@ -129,13 +133,15 @@ lineStringsAsMarkerArray(
  * \param lanelets input lanelet objects
  * \param c color of the marker
  * \param viz_centerline option to add centerline to the marker array
+ * \param simplify_tolerance level of detail of the linestrips, see lineString2Marker()
  * \return created visualization_msgs::msg::MarkerArray
  */
 visualization_msgs::msg::MarkerArray HAD_MAP_UTILS_PUBLIC laneletsBoundaryAsMarkerArray(
   const rclcpp::Time & t,
   const lanelet::ConstLanelets & lanelets,
   const std_msgs::msg::ColorRGBA & c,
-  const bool8_t & viz_centerline);
+  const bool8_t & viz_centerline,
+  const float64_t & simplify_tolerance = 0.0);
 
 /**
  * \brief creates marker with type LINE_STRIP from a lanelet::BasicPolygon object
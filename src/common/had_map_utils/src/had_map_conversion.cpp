@@ -22,8 +22,10 @@
 #include <boost/archive/binary_oarchive.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <streambuf>
 #include <string>
 #include <vector>
 
@@ -37,31 +39,68 @@ namespace common
 namespace had_map_utils
 {
 
+namespace
+{
+// Stream buffer which appends to the bytes of a message, so that the map is archived into the
+// message without intermediate copies
+class ByteVectorOutBuf : public std::streambuf
+{
+public:
+  explicit ByteVectorOutBuf(std::vector<uint8_t> & data)
+  : m_data(data) {}
+
+protected:
+  int_type overflow(int_type ch) override
+  {
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      m_data.push_back(static_cast<uint8_t>(traits_type::to_char_type(ch)));
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize xsputn(const char_type * s, std::streamsize count) override
+  {
+    const auto * const bytes = reinterpret_cast<const uint8_t *>(s);
+    m_data.insert(m_data.end(), bytes, bytes + count);
+    return count;
+  }
+
+private:
+  std::vector<uint8_t> & m_data;
+};
+
+// Stream buffer which reads the bytes of a message in place
+class ByteVectorInBuf : public std::streambuf
+{
+public:
+  explicit ByteVectorInBuf(const std::vector<uint8_t> & data)
+  {
+    // The get area is only read from, the default pbackfail() does not write to it
+    auto * const begin = const_cast<char_type *>(reinterpret_cast<const char_type *>(data.data()));
+    setg(begin, begin, begin + data.size());
+  }
+};
+}  // namespace
+
 void toBinaryMsg(
   const std::shared_ptr<lanelet::LaneletMap> & map,
   autoware_auto_msgs::msg::HADMapBin & msg)
 {
-  std::stringstream ss;
-  boost::archive::binary_oarchive oa(ss);
+  // Keeps the capacity of a message which is filled again
+  msg.data.clear();
+  ByteVectorOutBuf buf{msg.data};
+  boost::archive::binary_oarchive oa(buf);
   oa << *map;
   auto id_counter = lanelet::utils::getId();
   oa << id_counter;
-
-  std::string tmp_str = ss.str();
-  msg.data.clear();
-  msg.data.resize(tmp_str.size());
-  msg.data.assign(tmp_str.begin(), tmp_str.end());
 }
 
 void fromBinaryMsg(
   const autoware_auto_msgs::msg::HADMapBin & msg,
   std::shared_ptr<lanelet::LaneletMap> & map)
 {
-  std::string data_str;
-  data_str.assign(msg.data.begin(), msg.data.end());
-  std::stringstream ss;
-  ss << data_str;
-  boost::archive::binary_iarchive oa(ss);
+  ByteVectorInBuf buf{msg.data};
+  boost::archive::binary_iarchive oa(buf);
   oa >> *map;
   lanelet::Id id_counter;
   oa >> id_counter;
@@ -0,0 +1,160 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//lint -e537 pclint vs cpplint NOLINT
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "had_map_utils/had_map_index.hpp"
+
+namespace autoware
+{
+namespace common
+{
+namespace had_map_utils
+{
+
+namespace bgi = boost::geometry::index;
+
+namespace
+{
+template<typename PointsT>
+void add_vertices(const PointsT & points, lanelet::BasicPoint3d & sum, std::size_t & num_points)
+{
+  for (const auto & point : points) {
+    sum += point.basicPoint();
+  }
+  num_points += points.size();
+}
+
+template<typename PrimitiveT, typename ValueT>
+void add_primitive(
+  const PrimitiveT & primitive, const lanelet::BasicPoint3d & sum, const std::size_t num_points,
+  std::map<std::string, std::vector<ValueT>> & values)
+{
+  if ((num_points == 0U) || !primitive.hasAttribute("subtype")) {
+    return;
+  }
+  const lanelet::BasicPoint3d center = sum / static_cast<float64_t>(num_points);
+  values[primitive.attribute("subtype").value()].emplace_back(
+    typename ValueT::first_type{center.x(), center.y(), center.z()}, primitive.id());
+}
+
+template<typename RTreeT, typename ValueT>
+std::map<std::string, RTreeT> pack(const std::map<std::string, std::vector<ValueT>> & values)
+{
+  // The range constructor bulk loads the tree, which gives a better tree than inserting
+  std::map<std::string, RTreeT> trees;
+  for (const auto & subtype_values : values) {
+    trees.emplace(
+      std::piecewise_construct, std::forward_as_tuple(subtype_values.first),
+      std::forward_as_tuple(subtype_values.second.begin(), subtype_values.second.end()));
+  }
+  return trees;
+}
+}  // namespace
+
+PrimitiveIndex::PrimitiveIndex(const lanelet::LaneletMap & map)
+{
+  std::map<std::string, std::vector<Value>> lanelet_values;
+  for (const auto & lanelet : map.laneletLayer) {
+    lanelet::BasicPoint3d sum = lanelet::BasicPoint3d::Zero();
+    std::size_t num_points = 0U;
+    add_vertices(lanelet.leftBound(), sum, num_points);
+    add_vertices(lanelet.rightBound(), sum, num_points);
+    add_primitive(lanelet, sum, num_points, lanelet_values);
+  }
+  m_lanelets = pack<RTree>(lanelet_values);
+
+  std::map<std::string, std::vector<Value>> area_values;
+  for (const auto & area : map.areaLayer) {
+    lanelet::BasicPoint3d sum = lanelet::BasicPoint3d::Zero();
+    std::size_t num_points = 0U;
+    add_vertices(area.outerBoundPolygon(), sum, num_points);
+    add_primitive(area, sum, num_points, area_values);
+  }
+  m_areas = pack<RTree>(area_values);
+}
+
+lanelet::Ids PrimitiveIndex::nearest_lanelets(
+  const std::vector<std::string> & subtypes, const lanelet::BasicPoint3d & point,
+  const std::size_t count, const Filter & filter) const
+{
+  return nearest(m_lanelets, subtypes, point, count, filter);
+}
+
+lanelet::Ids PrimitiveIndex::nearest_areas(
+  const std::vector<std::string> & subtypes, const lanelet::BasicPoint3d & point,
+  const std::size_t count, const Filter & filter) const
+{
+  return nearest(m_areas, subtypes, point, count, filter);
+}
+
+std::size_t PrimitiveIndex::num_lanelets(const std::string & subtype) const
+{
+  return size(m_lanelets, subtype);
+}
+
+std::size_t PrimitiveIndex::num_areas(const std::string & subtype) const
+{
+  return size(m_areas, subtype);
+}
+
+lanelet::Ids PrimitiveIndex::nearest(
+  const SubtypeTrees & trees, const std::vector<std::string> & subtypes,
+  const lanelet::BasicPoint3d & point, const std::size_t count, const Filter & filter)
+{
+  const Point query{point.x(), point.y(), point.z()};
+  const auto accept = [&filter](const Value & value) {
+      return !filter || filter(value.second);
+    };
+  // The nearest primitives of each subtype, merged by distance
+  std::vector<std::pair<float64_t, lanelet::Id>> candidates;
+  for (const auto & subtype : subtypes) {
+    const auto tree = trees.find(subtype);
+    if (tree == trees.end()) {
+      continue;
+    }
+    std::vector<Value> values;
+    tree->second.query(
+      bgi::nearest(query, static_cast<uint32_t>(count)) && bgi::satisfies(accept),
+      std::back_inserter(values));
+    for (const auto & value : values) {
+      candidates.emplace_back(
+        boost::geometry::comparable_distance(query, value.first), value.second);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  lanelet::Ids ids;
+  for (std::size_t i = 0U; (i < candidates.size()) && (i < count); ++i) {
+    ids.push_back(candidates[i].second);
+  }
+  return ids;
+}
+
+std::size_t PrimitiveIndex::size(const SubtypeTrees & trees, const std::string & subtype)
+{
+  const auto tree = trees.find(subtype);
+  return (tree == trees.end()) ? 0U : tree->second.size();
+}
+
+}  // namespace had_map_utils
+}  // namespace common
+}  // namespace autoware
@@ -0,0 +1,218 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//lint -e537 pclint vs cpplint NOLINT
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "had_map_utils/had_map_conversion.hpp"
+#include "had_map_utils/had_map_tiles.hpp"
+
+namespace autoware
+{
+namespace common
+{
+namespace had_map_utils
+{
+
+bool8_t operator<(const MapTileId & lhs, const MapTileId & rhs) noexcept
+{
+  return std::tie(lhs.y, lhs.x) < std::tie(rhs.y, rhs.x);
+}
+
+bool8_t operator==(const MapTileId & lhs, const MapTileId & rhs) noexcept
+{
+  return (lhs.x == rhs.x) && (lhs.y == rhs.y);
+}
+
+MapTiling::MapTiling(const float64_t tile_size)
+: m_tile_size{tile_size}
+{
+  if (!(tile_size > 0.0) || !std::isfinite(tile_size)) {
+    throw std::domain_error("MapTiling: The tile size should be positive.");
+  }
+}
+
+MapTileId MapTiling::tile_of(const float64_t x, const float64_t y) const
+{
+  return MapTileId{
+    static_cast<int32_t>(std::floor(x / m_tile_size)),
+    static_cast<int32_t>(std::floor(y / m_tile_size))};
+}
+
+std::vector<MapTileId> MapTiling::tiles_within(
+  const float64_t x, const float64_t y, const float64_t radius) const
+{
+  const auto lower = tile_of(x - radius, y - radius);
+  const auto upper = tile_of(x + radius, y + radius);
+  std::vector<MapTileId> tiles;
+  for (auto tile_y = lower.y; tile_y <= upper.y; ++tile_y) {
+    for (auto tile_x = lower.x; tile_x <= upper.x; ++tile_x) {
+      tiles.push_back(MapTileId{tile_x, tile_y});
+    }
+  }
+  return tiles;
+}
+
+lanelet::BoundingBox2d MapTiling::bounds(const MapTileId & id) const
+{
+  return lanelet::BoundingBox2d(
+    lanelet::BasicPoint2d(
+      static_cast<float64_t>(id.x) * m_tile_size, static_cast<float64_t>(id.y) * m_tile_size),
+    lanelet::BasicPoint2d(
+      static_cast<float64_t>(id.x + 1) * m_tile_size,
+      static_cast<float64_t>(id.y + 1) * m_tile_size));
+}
+
+TiledLaneletMap::TiledLaneletMap(const MapTiling & tiling)
+: m_tiling{tiling}, m_map{std::make_shared<lanelet::LaneletMap>()}
+{
+}
+
+std::vector<MapTileId> TiledLaneletMap::missing_tiles(
+  const float64_t x, const float64_t y, const float64_t radius) const
+{
+  auto tiles = m_tiling.tiles_within(x, y, radius);
+  tiles.erase(
+    std::remove_if(
+      tiles.begin(), tiles.end(), [this](const MapTileId & id) {
+        return m_tiles.find(id) != m_tiles.end();
+      }), tiles.end());
+  return tiles;
+}
+
+bool8_t TiledLaneletMap::insert(
+  const MapTileId & id, const autoware_auto_msgs::msg::HADMapBin & msg)
+{
+  if ((msg.map_version == m_map_version) && (m_tiles.find(id) != m_tiles.end())) {
+    return false;
+  }
+  auto tile = std::make_shared<lanelet::LaneletMap>();
+  fromBinaryMsg(msg, tile);
+  return insert(id, msg.map_version, tile);
+}
+
+bool8_t TiledLaneletMap::insert(
+  const MapTileId & id, const std::string & map_version,
+  const std::shared_ptr<lanelet::LaneletMap> & tile)
+{
+  if (map_version != m_map_version) {
+    m_tiles.clear();
+    m_map = std::make_shared<lanelet::LaneletMap>();
+    m_map_version = map_version;
+  }
+  if (!m_tiles.emplace(id, tile).second) {
+    return false;
+  }
+  merge(*tile);
+  return true;
+}
+
+std::size_t TiledLaneletMap::evict(const float64_t x, const float64_t y, const float64_t radius)
+{
+  const auto kept_tiles = m_tiling.tiles_within(x, y, radius);
+  std::size_t num_evicted = 0U;
+  for (auto it = m_tiles.begin(); it != m_tiles.end(); ) {
+    if (std::find(kept_tiles.begin(), kept_tiles.end(), it->first) == kept_tiles.end()) {
+      it = m_tiles.erase(it);
+      ++num_evicted;
+    } else {
+      ++it;
+    }
+  }
+  // A lanelet map has no removal, so the remaining tiles are linked into a new one
+  if (num_evicted > 0U) {
+    rebuild();
+  }
+  return num_evicted;
+}
+
+void TiledLaneletMap::merge(lanelet::LaneletMap & tile)
+{
+  for (auto line_string : tile.lineStringLayer) {
+    if (m_map->lineStringLayer.exists(line_string.id())) {
+      continue;
+    }
+    // Link the points to the ones already in the map, in the stored direction of the line string
+    auto forward = line_string.inverted() ? line_string.invert() : line_string;
+    for (std::size_t i = 0U; i < forward.size(); ++i) {
+      const auto point_id = forward[i].id();
+      if (m_map->pointLayer.exists(point_id)) {
+        forward[i] = m_map->pointLayer.get(point_id);
+      }
+    }
+    m_map->add(forward);
+  }
+  for (auto point : tile.pointLayer) {
+    if (!m_map->pointLayer.exists(point.id())) {
+      m_map->add(point);
+    }
+  }
+  for (auto lanelet : tile.laneletLayer) {
+    if (m_map->laneletLayer.exists(lanelet.id())) {
+      continue;
+    }
+    lanelet.setLeftBound(shared(lanelet.leftBound()));
+    lanelet.setRightBound(shared(lanelet.rightBound()));
+    m_map->add(lanelet);
+  }
+  for (auto area : tile.areaLayer) {
+    if (m_map->areaLayer.exists(area.id())) {
+      continue;
+    }
+    lanelet::LineStrings3d outer_bound;
+    for (const auto & line_string : area.outerBound()) {
+      outer_bound.push_back(shared(line_string));
+    }
+    area.setOuterBound(outer_bound);
+    lanelet::InnerBounds inner_bounds;
+    for (const auto & inner_bound : area.innerBounds()) {
+      lanelet::LineStrings3d bound;
+      for (const auto & line_string : inner_bound) {
+        bound.push_back(shared(line_string));
+      }
+      inner_bounds.push_back(bound);
+    }
+    area.setInnerBounds(inner_bounds);
+    m_map->add(area);
+  }
+}
+
+lanelet::LineString3d TiledLaneletMap::shared(const lanelet::LineString3d & line_string) const
+{
+  // The line strings of a tile are all in its line string layer, which is merged first
+  if (!m_map->lineStringLayer.exists(line_string.id())) {
+    return line_string;
+  }
+  const lanelet::LineString3d kept = m_map->lineStringLayer.get(line_string.id());
+  return (kept.inverted() == line_string.inverted()) ? kept : kept.invert();
+}
+
+void TiledLaneletMap::rebuild()
+{
+  m_map = std::make_shared<lanelet::LaneletMap>();
+  for (auto & tile : m_tiles) {
+    merge(*tile.second);
+  }
+}
+
+}  // namespace had_map_utils
+}  // namespace common
+}  // namespace autoware
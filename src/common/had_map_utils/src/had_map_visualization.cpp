@@ -26,6 +26,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <unordered_set>
 
@@ -43,7 +44,69 @@ namespace had_map_utils
 template<typename T>
 bool8_t exists(const std::unordered_set<T> & set, const T & element)
 {
-  return std::find(set.begin(), set.end(), element) != set.end();
+  return set.find(element) != set.end();
+}
+
+// Squared distance of a point to the segment between two points
+float64_t squaredSegmentDistance(
+  const geometry_msgs::msg::Point & p,
+  const geometry_msgs::msg::Point & a,
+  const geometry_msgs::msg::Point & b)
+{
+  const float64_t abx = b.x - a.x;
+  const float64_t aby = b.y - a.y;
+  const float64_t abz = b.z - a.z;
+  const float64_t length2 = abx * abx + aby * aby + abz * abz;
+  float64_t s = 0.0;
+  if (length2 > 0.0) {
+    s = ((p.x - a.x) * abx + (p.y - a.y) * aby + (p.z - a.z) * abz) / length2;
+    s = std::max(0.0, std::min(1.0, s));
+  }
+  const float64_t dx = a.x + s * abx - p.x;
+  const float64_t dy = a.y + s * aby - p.y;
+  const float64_t dz = a.z + s * abz - p.z;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+// Douglas-Peucker simplification of a line strip, which keeps its end points and drops the
+// points within the tolerance of the simplified line strip
+void simplifyLineStrip(
+  std::vector<geometry_msgs::msg::Point> & points, const float64_t tolerance)
+{
+  if ((tolerance <= 0.0) || (points.size() < 3U)) {
+    return;
+  }
+  const float64_t tolerance2 = tolerance * tolerance;
+  std::vector<bool8_t> keep(points.size(), false);
+  keep.front() = true;
+  keep.back() = true;
+  std::vector<std::pair<size_t, size_t>> ranges{{0U, points.size() - 1U}};
+  while (!ranges.empty()) {
+    const auto range = ranges.back();
+    ranges.pop_back();
+    float64_t max_distance2 = tolerance2;
+    size_t farthest = range.first;
+    for (size_t i = range.first + 1U; i < range.second; ++i) {
+      const float64_t distance2 =
+        squaredSegmentDistance(points[i], points[range.first], points[range.second]);
+      if (distance2 > max_distance2) {
+        max_distance2 = distance2;
+        farthest = i;
+      }
+    }
+    if (farthest != range.first) {
+      keep[farthest] = true;
+      ranges.emplace_back(range.first, farthest);
+      ranges.emplace_back(farthest, range.second);
+    }
+  }
+  size_t num_kept = 0U;
+  for (size_t i = 0U; i < points.size(); ++i) {
+    if (keep[i]) {
+      points[num_kept++] = points[i];
+    }
+  }
+  points.resize(num_kept);
 }
 
 void setColor(
@@ -91,7 +154,8 @@ visualization_msgs::msg::Marker lineString2Marker(
   const rclcpp::Time & t,
   const lanelet::LineString3d & ls,
   const std::string & frame_id,
-  const std::string & ns, const std_msgs::msg::ColorRGBA & c, const float32_t & lss)
+  const std::string & ns, const std_msgs::msg::ColorRGBA & c, const float32_t & lss,
+  const float64_t & simplify_tolerance)
 {
   visualization_msgs::msg::Marker line_strip;
   setMarkerHeader(
@@ -100,6 +164,7 @@ visualization_msgs::msg::Marker lineString2Marker(
     visualization_msgs::msg::Marker::LINE_STRIP,
     lss);
 
+  line_strip.points.reserve(ls.size());
   for (auto i = ls.begin(); i != ls.end(); i++) {
     geometry_msgs::msg::Point p;
     p.x = (*i).x();
@@ -107,6 +172,7 @@ visualization_msgs::msg::Marker lineString2Marker(
     p.z = (*i).z();
     line_strip.points.push_back(p);
   }
+  simplifyLineStrip(line_strip.points, simplify_tolerance);
   return line_strip;
 }
 
@@ -114,7 +180,7 @@ visualization_msgs::msg::Marker lineString2Marker(
   const rclcpp::Time & t,
   const lanelet::ConstLineString3d & ls,
   const std::string & frame_id, const std::string & ns, const std_msgs::msg::ColorRGBA & c,
-  const float32_t & lss)
+  const float32_t & lss, const float64_t & simplify_tolerance)
 {
   visualization_msgs::msg::Marker line_strip;
   setMarkerHeader(
@@ -123,6 +189,7 @@ visualization_msgs::msg::Marker lineString2Marker(
     visualization_msgs::msg::Marker::LINE_STRIP,
     lss);
 
+  line_strip.points.reserve(ls.size());
   for (auto i = ls.begin(); i != ls.end(); i++) {
     geometry_msgs::msg::Point p;
     p.x = (*i).x();
@@ -130,6 +197,7 @@ visualization_msgs::msg::Marker lineString2Marker(
     p.z = (*i).z();
     line_strip.points.push_back(p);
   }
+  simplifyLineStrip(line_strip.points, simplify_tolerance);
   return line_strip;
 }
 
@@ -154,7 +222,8 @@ visualization_msgs::msg::MarkerArray laneletsBoundaryAsMarkerArray(
   const rclcpp::Time & t,
   const lanelet::ConstLanelets & lanelets,
   const std_msgs::msg::ColorRGBA & c,
-  const bool8_t & viz_centerline)
+  const bool8_t & viz_centerline,
+  const float64_t & simplify_tolerance)
 {
   float32_t lss = 0.1f;
   std::unordered_set<lanelet::Id> added;
@@ -168,20 +237,21 @@ visualization_msgs::msg::MarkerArray laneletsBoundaryAsMarkerArray(
 
     visualization_msgs::msg::Marker left_line_strip, right_line_strip, center_line_strip;
     if (!exists(added, left_ls.id())) {
-      left_line_strip = lineString2Marker(t, left_ls, "map", "left_lane_bound", c, lss);
+      left_line_strip = lineString2Marker(
+        t, left_ls, "map", "left_lane_bound", c, lss, simplify_tolerance);
       marker_array.markers.push_back(left_line_strip);
       added.insert(left_ls.id());
     }
     if (!exists(added, right_ls.id())) {
       right_line_strip = lineString2Marker(
-        t, right_ls, "map", "right_lane_bound", c, lss);
+        t, right_ls, "map", "right_lane_bound", c, lss, simplify_tolerance);
       marker_array.markers.push_back(right_line_strip);
       added.insert(right_ls.id());
     }
     if (viz_centerline && !exists(added, center_ls.id())) {
       center_line_strip = lineString2Marker(
         t, center_ls, "map", "center_lane_line",
-        c, std::max(lss * 0.1f, 0.01f));
+        c, std::max(lss * 0.1f, 0.01f), simplify_tolerance);
       marker_array.markers.push_back(center_line_strip);
       added.insert(center_ls.id());
     }
@@ -318,7 +388,7 @@ geometry_msgs::msg::Point32 toGeomMsgPt32(const lanelet::BasicPoint3d & src)
 }
 void adjacentPoints(
   const size_t i, const size_t N,
-  const geometry_msgs::msg::Polygon poly,
+  const geometry_msgs::msg::Polygon & poly,
   geometry_msgs::msg::Point32 * p0,
   geometry_msgs::msg::Point32 * p1,
   geometry_msgs::msg::Point32 * p2)
@@ -499,17 +569,13 @@ visualization_msgs::msg::MarkerArray laneletsAsTriangleMarkerArray(
     visualization_msgs::msg::Marker::TRIANGLE_LIST,
     1.0);
 
-  for (auto ll : lanelets) {
-    std::vector<geometry_msgs::msg::Polygon> triangles = lanelet2Triangle(ll);
-
-    for (auto tri : triangles) {
-      geometry_msgs::msg::Point tri0[3];
+  // All vertices have the marker color, so no per-vertex colors are sent
+  for (const auto & ll : lanelets) {
+    const std::vector<geometry_msgs::msg::Polygon> triangles = lanelet2Triangle(ll);
 
+    for (const auto & tri : triangles) {
       for (size_t i = 0; i < 3; i++) {
-        tri0[i] = toGeomMsgPt(tri.points[i]);
-
-        marker.points.push_back(tri0[i]);
-        marker.colors.push_back(c);
+        marker.points.push_back(toGeomMsgPt(tri.points[i]));
       }
     }
   }
@@ -537,12 +603,12 @@ visualization_msgs::msg::MarkerArray areasAsTriangleMarkerArray(
     visualization_msgs::msg::Marker::TRIANGLE_LIST,
     1.0);
 
-  for (auto area : areas) {
-    std::vector<geometry_msgs::msg::Polygon> triangles = area2Triangle(area);
-    for (auto tri : triangles) {
+  // All vertices have the marker color, so no per-vertex colors are sent
+  for (const auto & area : areas) {
+    const std::vector<geometry_msgs::msg::Polygon> triangles = area2Triangle(area);
+    for (const auto & tri : triangles) {
       for (size_t i = 0; i < 3; i++) {
         marker.points.push_back(toGeomMsgPt(tri.points[i]));
-        marker.colors.push_back(c);
       }
     }
   }
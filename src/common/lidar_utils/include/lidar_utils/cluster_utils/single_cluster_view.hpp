@@ -22,6 +22,7 @@
 #include <lidar_utils/visibility_control.hpp>
 
 #include <memory>
+#include <utility>
 
 namespace autoware
 {
@@ -31,19 +32,25 @@ namespace lidar_utils
 {
 
 ///
-/// @brief      Single cluster view that wraps a const reference to the clusters message and
+/// @brief      Single cluster view that wraps a reference to the clusters message and
 ///             provides convenient access functions and allows iterating over the points in a
 ///             single cluster
 ///
+/// @details    The view is constant if the message is, see SingleClusterView. Otherwise the points
+///             of the cluster can be modified in place through the view, see
+///             MutableSingleClusterView, e.g. to be reordered by a box fitting algorithm.
+///
 /// @warning    As always when using the view paradigm, the underlying container (a message in this
 ///             case) must outlive this view.
 ///
-class LIDAR_UTILS_PUBLIC SingleClusterView
+/// @tparam     ClustersMsgT  The clusters message type, optionally const qualified
+///
+template<typename ClustersMsgT>
+class LIDAR_UTILS_PUBLIC BasicSingleClusterView
 {
-  using ClustersMsg = autoware_auto_msgs::msg::PointClusters;
-  using Point = ClustersMsg::_points_type::value_type;
-  using PointConstIterator = ClustersMsg::_points_type::const_iterator;
-  using PointConstReverseIterator = ClustersMsg::_points_type::const_reverse_iterator;
+  using PointConstIterator = typename ClustersMsgT::_points_type::const_iterator;
+  using PointIterator = decltype(std::declval<ClustersMsgT &>().points.begin());
+  using PointReference = decltype(*std::declval<PointIterator>());
 
 public:
   ///
@@ -52,8 +59,8 @@ public:
   /// @param[in]  msg           The message reference that this class wraps
   /// @param[in]  border_index  The border index, aka index of the cluster in the clusters message
   ///
-  explicit SingleClusterView(
-    const ClustersMsg & msg,
+  explicit BasicSingleClusterView(
+    ClustersMsgT & msg,
     const std::uint32_t border_index) noexcept
   : m_msg{msg}, m_border_index{border_index} {}
 
@@ -67,11 +74,14 @@ public:
     return m_msg.points.cbegin() + m_msg.cluster_boundary[m_border_index];
   }
 
-  inline PointConstIterator begin() const noexcept {return cbegin();}
-  inline PointConstIterator end() const noexcept {return cend();}
+  inline PointIterator begin() const noexcept {return m_msg.points.begin() + start_point_index();}
+  inline PointIterator end() const noexcept
+  {
+    return m_msg.points.begin() + m_msg.cluster_boundary[m_border_index];
+  }
 
   /// Allow direct access to the points in the current cluster
-  inline const Point & operator[](const std::size_t point_index_in_cluster) const noexcept
+  inline PointReference operator[](const std::size_t point_index_in_cluster) const noexcept
   {
     return m_msg.points[start_point_index() + point_index_in_cluster];
   }
@@ -94,10 +104,15 @@ private:
     return m_border_index > 0U ? m_msg.cluster_boundary[m_border_index - 1U] : 0U;
   }
 
-  const ClustersMsg & m_msg;
+  ClustersMsgT & m_msg;
   std::uint32_t m_border_index;
 };
 
+/// A view of a single cluster of a constant message
+using SingleClusterView = BasicSingleClusterView<const autoware_auto_msgs::msg::PointClusters>;
+/// A view of a single cluster whose points can be modified, but not added or removed
+using MutableSingleClusterView = BasicSingleClusterView<autoware_auto_msgs::msg::PointClusters>;
+
 }  // namespace lidar_utils
 }  // namespace common
 }  // namespace autoware
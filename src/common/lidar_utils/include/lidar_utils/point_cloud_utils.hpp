@@ -32,6 +32,7 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
+#include <array>
 #include <atomic>
 #include <limits>
 #include <memory>
@@ -192,6 +193,78 @@ sensor_msgs::msg::PointCloud2::SharedPtr create_custom_pcl(
   return msg;
 }
 
+/// Maximum number of points in a PointBatch
+static constexpr std::size_t POINT_BATCH_CAPACITY = 64U;
+/// Result of a filter applied to a PointBatch: bit i is set iff point i passes the filter
+using PointBatchMask = uint64_t;
+
+/// \brief A batch of point coordinates in structure of arrays layout, for the batch methods of
+///        DistanceFilter, AngleFilter and StaticTransformer. These process the whole batch in
+///        branch-free loops of fixed length, which the compiler vectorizes for the target
+///        instruction set (e.g. SSE/AVX or NEON) and which are plain scalar code otherwise.
+struct LIDAR_UTILS_PUBLIC PointBatch
+{
+  /// Coordinates, only the first `size` entries are valid
+  alignas(32) std::array<float32_t, POINT_BATCH_CAPACITY> x{};
+  alignas(32) std::array<float32_t, POINT_BATCH_CAPACITY> y{};
+  alignas(32) std::array<float32_t, POINT_BATCH_CAPACITY> z{};
+  /// Number of valid points
+  std::size_t size{0U};
+};
+
+/// \brief Load the coordinates of consecutive points of a point cloud into a batch
+/// \param[in] msg The point cloud, with float32_t x, y, z as the first three fields, see
+///                has_intensity_and_throw_if_no_xyz
+/// \param[in] first_point Index of the first point to load
+/// \param[out] batch Gets the coordinates of up to POINT_BATCH_CAPACITY points
+/// \return Number of points loaded, 0 if first_point is past the last safe point of the cloud
+/// \throw std::runtime_error If the point step is too small for x, y, z
+LIDAR_UTILS_PUBLIC std::size_t load_point_batch(
+  const PointCloud2 & msg,
+  const std::size_t first_point,
+  PointBatch & batch);
+
+/// Size of a point of a compact point cloud: int16_t x, y, z and uint8_t intensity
+static constexpr uint32_t COMPACT_POINT_STEP = 7U;
+
+/// \brief Check whether a point cloud is in the compact layout of encode_compact_point_cloud
+/// \param[in] msg The point cloud
+/// \return True if the first fields are int16_t x, y, z and uint8_t intensity, packed
+LIDAR_UTILS_PUBLIC bool8_t is_compact_point_cloud(const PointCloud2 & msg) noexcept;
+
+/// \brief Encode a point cloud into a compact layout, for transport between processes or
+///        machines. The coordinates are quantized to multiples of the resolution relative to the
+///        origin of the frame of the header and stored as int16_t, and the intensity is rounded
+///        and saturated to uint8_t. This takes COMPACT_POINT_STEP bytes per point instead of 16 or
+///        more. The resolution is not part of the message, both ends must agree on it.
+/// \param[in] input The point cloud, with float32_t x, y, z as the first three fields and an
+///                  optional float32_t or uint8_t intensity field, see
+///                  has_intensity_and_throw_if_no_xyz
+/// \param[in] resolution Quantization step in meters. Points more than 32767 steps away from the
+///                       origin along any axis can't be represented
+/// \param[out] output Compact point cloud with the header of the input, reused if it already has
+///                    the compact layout
+/// \return Number of points which are dropped because they are out of range or not finite
+/// \throw std::domain_error If the resolution is not positive
+/// \throw std::runtime_error If the input has no x, y, z or its point step is too small
+LIDAR_UTILS_PUBLIC std::size_t encode_compact_point_cloud(
+  const PointCloud2 & input,
+  const float32_t resolution,
+  PointCloud2 & output);
+
+/// \brief Decode a compact point cloud into float32_t x, y, z and intensity, the layout of
+///        common::types::PointXYZI
+/// \param[in] input Compact point cloud, see encode_compact_point_cloud
+/// \param[in] resolution Quantization step in meters which the input was encoded with
+/// \param[out] output Point cloud with the header of the input, reused if it already has the
+///                    layout of output
+/// \throw std::domain_error If the resolution is not positive
+/// \throw std::runtime_error If the input is not a compact point cloud
+LIDAR_UTILS_PUBLIC void decode_compact_point_cloud(
+  const PointCloud2 & input,
+  const float32_t resolution,
+  PointCloud2 & output);
+
 /// \brief Filter class to check if a point lies within a range defined by a min and max radius.
 class LIDAR_UTILS_PUBLIC DistanceFilter
 {
@@ -216,6 +289,12 @@ public:
            comp::abs_lte(pt_radius, m_max_r2, FEPS);
   }
 
+  /// \brief Check which points of a batch are within the allowed range of the filter, with the
+  ///        same result as calling operator() on each point
+  /// \param batch Points to be filtered
+  /// \return Mask of the points within the filter's range
+  PointBatchMask filter(const PointBatch & batch) const;
+
 private:
   float32_t m_min_r2;
   float32_t m_max_r2;
@@ -249,6 +328,10 @@ public:
     zr_(out) = out_mat[2];
   }
 
+  /// \brief Apply the transform to all points of a batch in place.
+  /// \param batch Points to transform
+  void transform(PointBatch & batch) const;  //NOLINT (false positive: this is not std::transform)
+
 private:
   Eigen::Affine3f m_tf;
 };
@@ -303,6 +386,12 @@ public:
     return ret;
   }
 
+  /// \brief Check which points of a batch lie in the range, with the same result as calling
+  ///        operator() on each point
+  /// \param batch Points to check
+  /// \return Mask of the points contained within the range
+  PointBatchMask filter(const PointBatch & batch) const;
+
 private:
   VectorT m_range_normal;
   bool8_t m_threshold_negative;
@@ -19,6 +19,9 @@
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <string>
@@ -158,6 +161,84 @@ SafeCloudIndices sanitize_point_cloud(const sensor_msgs::msg::PointCloud2 & msg)
   return SafeCloudIndices{num_floats * sizeof(float32_t), index_after_last_safe_byte_index(msg)};
 }
 
+std::size_t load_point_batch(
+  const PointCloud2 & msg,
+  const std::size_t first_point,
+  PointBatch & batch)
+{
+  if (msg.point_step < (3U * sizeof(float32_t))) {
+    throw std::runtime_error("Invalid PointCloud msg");
+  }
+  const std::size_t num_points = index_after_last_safe_byte_index(msg) / msg.point_step;
+  batch.size = (first_point < num_points) ?
+    std::min(num_points - first_point, POINT_BATCH_CAPACITY) : 0U;
+  const uint8_t * data = msg.data.data() + (first_point * msg.point_step);
+  for (std::size_t idx = 0U; idx < batch.size; ++idx) {
+    float32_t xyz[3U];
+    //lint -e{586} NOLINT memcpy is needed for the unaligned serialized data
+    (void)std::memcpy(&xyz[0U], data, sizeof(xyz));
+    batch.x[idx] = xyz[0U];
+    batch.y[idx] = xyz[1U];
+    batch.z[idx] = xyz[2U];
+    data += msg.point_step;
+  }
+  return batch.size;
+}
+
+namespace
+{
+using sensor_msgs::msg::PointField;
+
+/// \brief Whether a field has the given name, type and offset, and holds one value
+bool8_t is_field(
+  const PointField & field, const char8_t * const name, const uint8_t datatype,
+  const uint32_t offset) noexcept
+{
+  return (field.name == name) && (field.datatype == datatype) && (field.offset == offset) &&
+         (field.count == 1U);
+}
+
+/// \brief Set the fields unless they are set already, so that their names are not reallocated
+///        for each cloud
+bool8_t set_xyzi_fields(
+  PointCloud2 & msg, const uint8_t coordinate_type, const uint32_t coordinate_size,
+  const uint8_t intensity_type, const uint32_t point_step)
+{
+  const bool8_t has_layout = (msg.fields.size() == 4U) && (msg.point_step == point_step) &&
+    is_field(msg.fields[0U], "x", coordinate_type, 0U) &&
+    is_field(msg.fields[1U], "y", coordinate_type, coordinate_size) &&
+    is_field(msg.fields[2U], "z", coordinate_type, 2U * coordinate_size) &&
+    is_field(msg.fields[3U], "intensity", intensity_type, 3U * coordinate_size);
+  if (!has_layout) {
+    msg.fields.resize(4U);
+    const std::array<const char8_t *, 4U> names{"x", "y", "z", "intensity"};
+    for (uint32_t idx = 0U; idx < 4U; ++idx) {
+      msg.fields[idx].name = names[idx];
+      msg.fields[idx].offset = idx * coordinate_size;
+      msg.fields[idx].datatype = (idx < 3U) ? coordinate_type : intensity_type;
+      msg.fields[idx].count = 1U;
+    }
+    msg.point_step = point_step;
+  }
+  msg.height = 1U;
+  msg.is_bigendian = false;
+  return has_layout;
+}
+
+/// \brief Pack one flag per point of a batch into a mask; flags of points past the batch size are
+///        ignored
+PointBatchMask to_mask(
+  const std::array<uint8_t, POINT_BATCH_CAPACITY> & passed,
+  const std::size_t size)
+{
+  PointBatchMask mask = 0U;
+  for (std::size_t idx = 0U; idx < size; ++idx) {
+    mask |= static_cast<PointBatchMask>(passed[idx]) << idx;
+  }
+  return mask;
+}
+}  // namespace
+
 /////////////////////////////////////////////////////////////////////////////////////////
 
 DistanceFilter::DistanceFilter(float32_t min_radius, float32_t max_radius)
@@ -171,6 +252,25 @@ DistanceFilter::DistanceFilter(float32_t min_radius, float32_t max_radius)
 // odr-used by comp::abs_gte
 constexpr float32_t DistanceFilter::FEPS;
 
+PointBatchMask DistanceFilter::filter(const PointBatch & batch) const
+{
+  // Same comparisons as comp::abs_gte and comp::abs_lte, combined without branches. The loop
+  // always runs over the whole capacity so that it has a fixed trip count
+  std::array<uint8_t, POINT_BATCH_CAPACITY> passed;
+  for (std::size_t idx = 0U; idx < POINT_BATCH_CAPACITY; ++idx) {
+    const float32_t x = batch.x[idx];
+    const float32_t y = batch.y[idx];
+    const float32_t z = batch.z[idx];
+    const float32_t pt_radius = (x * x) + ((y * y) + (z * z));
+    const bool8_t above_min =
+      (std::fabs(pt_radius - m_min_r2) <= FEPS) | (pt_radius >= m_min_r2);
+    const bool8_t below_max =
+      (std::fabs(pt_radius - m_max_r2) <= FEPS) | (pt_radius < m_max_r2);
+    passed[idx] = static_cast<uint8_t>(above_min & below_max);
+  }
+  return to_mask(passed, batch.size);
+}
+
 
 StaticTransformer::StaticTransformer(const geometry_msgs::msg::Transform & tf)
 {
@@ -190,6 +290,23 @@ StaticTransformer::StaticTransformer(const geometry_msgs::msg::Transform & tf)
     static_cast<float>(tf.translation.z)};
 }
 
+void StaticTransformer::transform(PointBatch & batch) const  //NOLINT
+{
+  const Eigen::Matrix3f rotation = m_tf.linear();
+  const Eigen::Vector3f translation = m_tf.translation();
+  for (std::size_t idx = 0U; idx < POINT_BATCH_CAPACITY; ++idx) {
+    const float32_t x = batch.x[idx];
+    const float32_t y = batch.y[idx];
+    const float32_t z = batch.z[idx];
+    batch.x[idx] =
+      (rotation(0, 0) * x) + (rotation(0, 1) * y) + (rotation(0, 2) * z) + translation(0);
+    batch.y[idx] =
+      (rotation(1, 0) * x) + (rotation(1, 1) * y) + (rotation(1, 2) * z) + translation(1);
+    batch.z[idx] =
+      (rotation(2, 0) * x) + (rotation(2, 1) * y) + (rotation(2, 2) * z) + translation(2);
+  }
+}
+
 AngleFilter::AngleFilter(float32_t start_angle, float32_t end_angle)
 {
   using autoware::common::geometry::make_unit_vector2d;
@@ -233,6 +350,39 @@ AngleFilter::AngleFilter(float32_t start_angle, float32_t end_angle)
   m_threshold2 = thresh * thresh;
 }
 
+PointBatchMask AngleFilter::filter(const PointBatch & batch) const
+{
+  // Same cases as operator(). The threshold sign is the same for all points, so only the sign of
+  // the projection is selected per point
+  const float32_t normal_x = m_range_normal.x;
+  const float32_t normal_y = m_range_normal.y;
+  std::array<uint8_t, POINT_BATCH_CAPACITY> passed;
+  if (!m_threshold_negative) {
+    const float32_t threshold2 = m_threshold2 - FEPS;
+    for (std::size_t idx = 0U; idx < POINT_BATCH_CAPACITY; ++idx) {
+      const float32_t x = batch.x[idx];
+      const float32_t y = batch.y[idx];
+      const float32_t pt_len2 = (x * x) + (y * y);
+      const float32_t proj_on_normal = (x * normal_x) + (y * normal_y);
+      const bool8_t is_proj_negative = (proj_on_normal + FEPS) < 0.0F;
+      passed[idx] = static_cast<uint8_t>(
+        (!is_proj_negative) & ((proj_on_normal * proj_on_normal) >= (pt_len2 * threshold2)));
+    }
+  } else {
+    const float32_t threshold2 = m_threshold2 + FEPS;
+    for (std::size_t idx = 0U; idx < POINT_BATCH_CAPACITY; ++idx) {
+      const float32_t x = batch.x[idx];
+      const float32_t y = batch.y[idx];
+      const float32_t pt_len2 = (x * x) + (y * y);
+      const float32_t proj_on_normal = (x * normal_x) + (y * normal_y);
+      const bool8_t is_proj_negative = (proj_on_normal + FEPS) < 0.0F;
+      passed[idx] = static_cast<uint8_t>(
+        (!is_proj_negative) | ((proj_on_normal * proj_on_normal) <= (pt_len2 * threshold2)));
+    }
+  }
+  return to_mask(passed, batch.size);
+}
+
 bool8_t IntensityIteratorWrapper::eof()
 {
   switch (m_intensity_datatype) {
@@ -285,6 +435,127 @@ IntensityIteratorWrapper::IntensityIteratorWrapper(
   }
 }
 
+bool8_t is_compact_point_cloud(const PointCloud2 & msg) noexcept
+{
+  return (msg.fields.size() >= 4U) && (msg.point_step >= COMPACT_POINT_STEP) &&
+         is_field(msg.fields[0U], "x", PointField::INT16, 0U) &&
+         is_field(msg.fields[1U], "y", PointField::INT16, 2U) &&
+         is_field(msg.fields[2U], "z", PointField::INT16, 4U) &&
+         is_field(msg.fields[3U], "intensity", PointField::UINT8, 6U);
+}
+
+std::size_t encode_compact_point_cloud(
+  const PointCloud2 & input,
+  const float32_t resolution,
+  PointCloud2 & output)
+{
+  if (!(resolution > 0.0F)) {
+    throw std::domain_error("encode_compact_point_cloud: resolution must be positive");
+  }
+  // The intensity is either a float32_t or a uint8_t if there is one
+  const bool8_t has_intensity = has_intensity_and_throw_if_no_xyz(input);
+  const auto intensity_type =
+    has_intensity ? input.fields[3U].datatype : static_cast<uint8_t>(PointField::UINT8);
+  const uint32_t intensity_offset = has_intensity ? input.fields[3U].offset : 0U;
+  const uint32_t point_size = has_intensity ?
+    (intensity_offset + ((intensity_type == PointField::UINT8) ? 1U : 4U)) :
+    3U * static_cast<uint32_t>(sizeof(float32_t));
+  if (input.point_step < point_size) {
+    throw std::runtime_error("Invalid PointCloud msg");
+  }
+
+  (void)set_xyzi_fields(
+    output, PointField::INT16, sizeof(int16_t), PointField::UINT8, COMPACT_POINT_STEP);
+  output.header = input.header;
+  output.is_dense = input.is_dense;
+  const std::size_t num_points = index_after_last_safe_byte_index(input) / input.point_step;
+  output.data.resize(num_points * COMPACT_POINT_STEP);
+
+  const float32_t inv_resolution = 1.0F / resolution;
+  constexpr auto MAX_STEPS = static_cast<float32_t>(std::numeric_limits<int16_t>::max());
+  const uint8_t * in = input.data.data();
+  uint8_t * out = output.data.data();
+  std::size_t num_encoded = 0U;
+  for (std::size_t idx = 0U; idx < num_points; ++idx) {
+    float32_t xyz[3U];
+    //lint -e{586} NOLINT memcpy is needed for the unaligned serialized data
+    (void)std::memcpy(&xyz[0U], in, sizeof(xyz));
+    std::array<float32_t, 3U> steps{};
+    bool8_t in_range = true;
+    for (std::size_t axis = 0U; axis < 3U; ++axis) {
+      steps[axis] = std::round(xyz[axis] * inv_resolution);
+      // NaN fails the comparison as well
+      in_range = in_range && (std::fabs(steps[axis]) <= MAX_STEPS);
+    }
+    if (in_range) {
+      const std::array<int16_t, 3U> quantized{
+        static_cast<int16_t>(steps[0U]), static_cast<int16_t>(steps[1U]),
+        static_cast<int16_t>(steps[2U])};
+      uint8_t intensity = 0U;
+      if (intensity_type == PointField::FLOAT32) {
+        float32_t value;
+        //lint -e{586} NOLINT memcpy is needed for the unaligned serialized data
+        (void)std::memcpy(&value, in + intensity_offset, sizeof(value));
+        const auto saturated = (value > 0.0F) ? std::min(value, 255.0F) : 0.0F;
+        intensity = static_cast<uint8_t>(saturated + 0.5F);
+      } else if (has_intensity) {
+        intensity = in[intensity_offset];
+      }
+      //lint -e{586} NOLINT memcpy is needed for the unaligned serialized data
+      (void)std::memcpy(out, quantized.data(), sizeof(quantized));
+      out[3U * sizeof(int16_t)] = intensity;
+      out += COMPACT_POINT_STEP;
+      ++num_encoded;
+    }
+    in += input.point_step;
+  }
+
+  output.data.resize(num_encoded * COMPACT_POINT_STEP);
+  output.width = static_cast<uint32_t>(num_encoded);
+  output.row_step = output.width * COMPACT_POINT_STEP;
+  return num_points - num_encoded;
+}
+
+void decode_compact_point_cloud(
+  const PointCloud2 & input,
+  const float32_t resolution,
+  PointCloud2 & output)
+{
+  if (!(resolution > 0.0F)) {
+    throw std::domain_error("decode_compact_point_cloud: resolution must be positive");
+  }
+  if (!is_compact_point_cloud(input)) {
+    throw std::runtime_error("decode_compact_point_cloud: input is not a compact point cloud");
+  }
+
+  constexpr uint32_t POINT_STEP = 4U * sizeof(float32_t);
+  (void)set_xyzi_fields(
+    output, PointField::FLOAT32, sizeof(float32_t), PointField::FLOAT32, POINT_STEP);
+  output.header = input.header;
+  output.is_dense = input.is_dense;
+  const std::size_t num_points = index_after_last_safe_byte_index(input) / input.point_step;
+  output.data.resize(num_points * POINT_STEP);
+  output.width = static_cast<uint32_t>(num_points);
+  output.row_step = output.width * POINT_STEP;
+
+  const uint8_t * in = input.data.data();
+  uint8_t * out = output.data.data();
+  for (std::size_t idx = 0U; idx < num_points; ++idx) {
+    int16_t quantized[3U];
+    //lint -e{586} NOLINT memcpy is needed for the unaligned serialized data
+    (void)std::memcpy(&quantized[0U], in, sizeof(quantized));
+    const std::array<float32_t, 4U> point{
+      static_cast<float32_t>(quantized[0U]) * resolution,
+      static_cast<float32_t>(quantized[1U]) * resolution,
+      static_cast<float32_t>(quantized[2U]) * resolution,
+      static_cast<float32_t>(in[3U * sizeof(int16_t)])};
+    //lint -e{586} NOLINT memcpy is needed for the unaligned serialized data
+    (void)std::memcpy(out, point.data(), sizeof(point));
+    in += input.point_step;
+    out += POINT_STEP;
+  }
+}
+
 }  // namespace lidar_utils
 }  // namespace common
 }  // namespace autoware
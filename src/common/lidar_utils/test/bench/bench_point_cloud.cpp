@@ -23,6 +23,8 @@
 
 #include <algorithm>
 #include <limits>
+#include <random>
+#include <vector>
 
 namespace
 {
@@ -48,8 +50,95 @@ sensor_msgs::msg::PointCloud2 create_point_cloud_through_utils(const std::size_t
   return msg;
 }
 
+constexpr auto kFilterCloudSize = 50000UL;
+
+// Points of a lidar scan around the sensor, about half of which are filtered out
+sensor_msgs::msg::PointCloud2 create_random_point_cloud(const std::size_t size)
+{
+  sensor_msgs::msg::PointCloud2 msg;
+  using autoware::common::types::PointXYZI;
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{msg, "frame_id"};
+  modifier.resize(size);
+  std::mt19937 generator{42U};
+  std::uniform_real_distribution<float> distribution{-30.0F, 30.0F};
+  for (auto & p : modifier) {
+    p.x = distribution(generator);
+    p.y = distribution(generator);
+    p.z = distribution(generator) * 0.1F;
+  }
+  return msg;
+}
+
+geometry_msgs::msg::Transform create_transform()
+{
+  geometry_msgs::msg::Transform tf;
+  tf.rotation.z = 0.38268343236;
+  tf.rotation.w = 0.92387953251;
+  tf.translation.x = 1.5;
+  tf.translation.z = 2.0;
+  return tf;
+}
+
 }  // namespace
 
+static void BenchFilterTransformPerPoint(benchmark::State & state)
+{
+  using autoware::common::types::PointXYZI;
+  const auto msg = create_random_point_cloud(kFilterCloudSize);
+  const autoware::common::lidar_utils::AngleFilter angle_filter{-2.0F, 2.0F};
+  const autoware::common::lidar_utils::DistanceFilter distance_filter{2.0F, 25.0F};
+  const autoware::common::lidar_utils::StaticTransformer transformer{create_transform()};
+  std::vector<PointXYZI> output;
+  output.reserve(kFilterCloudSize);
+  for (auto _ : state) {
+    output.clear();
+    const point_cloud_msg_wrapper::PointCloud2View<PointXYZI> view{msg};
+    for (const auto & p : view) {
+      if (angle_filter(p) && distance_filter(p)) {
+        PointXYZI out{};
+        transformer.transform(p, out);
+        output.push_back(out);
+      }
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kFilterCloudSize));
+}
+
+static void BenchFilterTransformBatch(benchmark::State & state)
+{
+  using autoware::common::types::PointXYZI;
+  using autoware::common::lidar_utils::PointBatch;
+  using autoware::common::lidar_utils::PointBatchMask;
+  const auto msg = create_random_point_cloud(kFilterCloudSize);
+  const autoware::common::lidar_utils::AngleFilter angle_filter{-2.0F, 2.0F};
+  const autoware::common::lidar_utils::DistanceFilter distance_filter{2.0F, 25.0F};
+  const autoware::common::lidar_utils::StaticTransformer transformer{create_transform()};
+  std::vector<PointXYZI> output;
+  output.reserve(kFilterCloudSize);
+  PointBatch batch;
+  for (auto _ : state) {
+    output.clear();
+    for (std::size_t first = 0U; autoware::common::lidar_utils::load_point_batch(
+        msg, first, batch) > 0U; first += batch.size)
+    {
+      const PointBatchMask mask = angle_filter.filter(batch) & distance_filter.filter(batch);
+      transformer.transform(batch);
+      for (std::size_t idx = 0U; idx < batch.size; ++idx) {
+        if (0U != (mask & (PointBatchMask{1U} << idx))) {
+          PointXYZI out{};
+          out.x = batch.x[idx];
+          out.y = batch.y[idx];
+          out.z = batch.z[idx];
+          output.push_back(out);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kFilterCloudSize));
+}
+
 static void BenchMsgWrapperAddPointToCloud(benchmark::State & state)
 {
   using autoware::common::types::PointXYZIF;
@@ -134,3 +223,6 @@ BENCHMARK(BenchMsgWrapperPushBackPointToCloud);
 
 
 BENCHMARK(BenchMsgWrapperAccessPoint);
+
+BENCHMARK(BenchFilterTransformPerPoint)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BenchFilterTransformBatch)->Unit(benchmark::kMicrosecond);
@@ -16,14 +16,19 @@
 
 #include <gtest/gtest.h>
 
+#include <geometry/bounding_box_2d.hpp>
+#include <geometry/convex_hull.hpp>
 #include <lidar_utils/cluster_utils/point_clusters_view.hpp>
 
+#include <vector>
+
 namespace
 {
 
 using autoware::common::types::float32_t;
 using autoware::common::types::float64_t;
 using autoware_auto_msgs::msg::PointXYZIF;
+using autoware::common::lidar_utils::MutableSingleClusterView;
 using autoware::common::lidar_utils::PointClustersView;
 
 using autoware_auto_msgs::msg::PointClusters;
@@ -99,3 +104,64 @@ TEST(TestClusterView, IterateOverMessage)
     ++i;
   }
 }
+
+TEST(TestClusterView, MutableView)
+{
+  PointClusters msg;
+  msg.points.push_back(make_point(1.0F, 2.0F, 3.0F));
+  msg.cluster_boundary.push_back(1U);
+  msg.points.push_back(make_point(4.0F, 5.0F, 6.0F));
+  msg.points.push_back(make_point(7.0F, 8.0F, 9.0F));
+  msg.cluster_boundary.push_back(3U);
+
+  const MutableSingleClusterView cluster_view{msg, 1U};
+  ASSERT_EQ(cluster_view.size(), 2UL);
+  std::swap(cluster_view[0UL], cluster_view[1UL]);
+  EXPECT_FLOAT_EQ(msg.points[1UL].x, 7.0F);
+  EXPECT_FLOAT_EQ(msg.points[2UL].x, 4.0F);
+  // The other cluster is untouched
+  EXPECT_FLOAT_EQ(msg.points[0UL].x, 1.0F);
+}
+
+TEST(TestClusterView, BoxFitting)
+{
+  namespace bounding_box = autoware::common::geometry::bounding_box;
+  // An L-shaped cluster after a single point cluster
+  PointClusters msg;
+  msg.points.push_back(make_point(-10.0F, -10.0F, 0.0F));
+  msg.cluster_boundary.push_back(1U);
+  for (auto idx = 0; idx < 10; ++idx) {
+    const auto offset = static_cast<float32_t>(idx) * 0.5F;
+    msg.points.push_back(make_point(2.0F + offset, 1.0F, 0.1F * offset));
+    msg.points.push_back(make_point(2.0F, 1.5F + offset, 0.0F));
+  }
+  msg.cluster_boundary.push_back(static_cast<uint32_t>(msg.points.size()));
+  const PointClustersView view{msg};
+  std::vector<PointXYZIF> copy{view[1UL].begin(), view[1UL].end()};
+
+  const auto eigenbox = bounding_box::eigenbox_2d(view[1UL]);
+  const auto expected_eigenbox = bounding_box::eigenbox_2d(copy.begin(), copy.end());
+  EXPECT_FLOAT_EQ(eigenbox.size.x, expected_eigenbox.size.x);
+  EXPECT_FLOAT_EQ(eigenbox.size.y, expected_eigenbox.size.y);
+
+  auto lfit_copy = copy;
+  auto expected_lfit = bounding_box::lfit_bounding_box_2d(lfit_copy.begin(), lfit_copy.end());
+  bounding_box::compute_height(lfit_copy.begin(), lfit_copy.end(), expected_lfit);
+  const MutableSingleClusterView cluster_view{msg, 1U};
+  auto lfit = bounding_box::lfit_bounding_box_2d(cluster_view);
+  bounding_box::compute_height(cluster_view, lfit);
+  EXPECT_FLOAT_EQ(lfit.size.x, expected_lfit.size.x);
+  EXPECT_FLOAT_EQ(lfit.size.y, expected_lfit.size.y);
+  EXPECT_FLOAT_EQ(lfit.size.z, expected_lfit.size.z);
+  EXPECT_FLOAT_EQ(msg.points[0UL].x, -10.0F);
+
+  // A hull of the cluster, stored as a cluster itself
+  PointClusters hulls;
+  hulls.points.resize(copy.size() + 1U);
+  const auto hull_end =
+    autoware::common::geometry::convex_hull(copy.begin(), copy.end(), hulls.points.begin());
+  hulls.points.resize(static_cast<std::size_t>(hull_end - hulls.points.begin()));
+  hulls.cluster_boundary.push_back(static_cast<uint32_t>(hulls.points.size()));
+  const auto box = bounding_box::minimum_area_bounding_box(PointClustersView{hulls}[0UL]);
+  EXPECT_FLOAT_EQ(box.size.x * box.size.y, 4.5F * 5.0F);
+}
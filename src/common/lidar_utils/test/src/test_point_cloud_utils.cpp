@@ -20,6 +20,10 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cstring>
+#include <limits>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -84,3 +88,180 @@ TEST(TestStaticTransformer, TransformPoint)
   EXPECT_FLOAT_EQ(7.0F, result_point.y);
   EXPECT_FLOAT_EQ(8.0F, result_point.z);
 }
+
+TEST(TestPointBatch, LoadPointBatch)
+{
+  using autoware::common::lidar_utils::create_custom_pcl;
+  using autoware::common::lidar_utils::load_point_batch;
+  using autoware::common::lidar_utils::PointBatch;
+  using autoware::common::lidar_utils::POINT_BATCH_CAPACITY;
+
+  const uint32_t cloud_size = static_cast<uint32_t>(POINT_BATCH_CAPACITY) + 10U;
+  auto cloud = create_custom_pcl<float32_t>({"x", "y", "z", "intensity"}, cloud_size);
+  for (uint32_t idx = 0U; idx < cloud_size; ++idx) {
+    const auto value = static_cast<float32_t>(idx);
+    const float32_t xyz[3U] = {value, -value, 2.0F * value};
+    std::memcpy(&cloud->data[idx * cloud->point_step], &xyz[0U], sizeof(xyz));
+  }
+
+  PointBatch batch;
+  EXPECT_EQ(load_point_batch(*cloud, 0U, batch), POINT_BATCH_CAPACITY);
+  EXPECT_EQ(batch.size, POINT_BATCH_CAPACITY);
+  EXPECT_EQ(batch.x[5U], 5.0F);
+  EXPECT_EQ(batch.y[5U], -5.0F);
+  EXPECT_EQ(batch.z[5U], 10.0F);
+  EXPECT_EQ(load_point_batch(*cloud, POINT_BATCH_CAPACITY, batch), 10U);
+  EXPECT_EQ(batch.x[9U], static_cast<float32_t>(POINT_BATCH_CAPACITY + 9U));
+  EXPECT_EQ(load_point_batch(*cloud, cloud_size, batch), 0U);
+  EXPECT_EQ(batch.size, 0U);
+
+  cloud->point_step = 8U;
+  EXPECT_THROW(load_point_batch(*cloud, 0U, batch), std::runtime_error);
+}
+
+TEST(TestPointBatch, FiltersMatchPerPoint)
+{
+  using autoware::common::lidar_utils::AngleFilter;
+  using autoware::common::lidar_utils::DistanceFilter;
+  using autoware::common::lidar_utils::PointBatch;
+  using autoware::common::lidar_utils::POINT_BATCH_CAPACITY;
+  using autoware::common::types::PointXYZF;
+
+  std::mt19937 generator{42U};
+  std::uniform_real_distribution<float32_t> distribution{-20.0F, 20.0F};
+  const DistanceFilter distance_filter{2.0F, 15.0F};
+  // Both a range smaller and a range larger than pi, and thus both signs of the threshold
+  const std::vector<AngleFilter> angle_filters{
+    AngleFilter{-0.5F, 1.0F}, AngleFilter{1.0F, -0.5F}, AngleFilter{0.0F, AngleFilter::PI}};
+
+  for (const std::size_t batch_size : {POINT_BATCH_CAPACITY, std::size_t{13U}}) {
+    PointBatch batch;
+    batch.size = batch_size;
+    for (std::size_t idx = 0U; idx < POINT_BATCH_CAPACITY; ++idx) {
+      batch.x[idx] = distribution(generator);
+      batch.y[idx] = distribution(generator);
+      batch.z[idx] = distribution(generator);
+    }
+    // Points on the range limits, which the filters accept
+    batch.x[0U] = 2.0F;
+    batch.y[0U] = 0.0F;
+    batch.z[0U] = 0.0F;
+    batch.x[1U] = 0.0F;
+    batch.y[1U] = 0.0F;
+    batch.z[1U] = 15.0F;
+
+    const auto expected_mask = [&batch](const auto & filter) {
+        autoware::common::lidar_utils::PointBatchMask mask = 0U;
+        for (std::size_t idx = 0U; idx < batch.size; ++idx) {
+          const PointXYZF pt{batch.x[idx], batch.y[idx], batch.z[idx]};
+          if (filter(pt)) {
+            mask |= 1ULL << idx;
+          }
+        }
+        return mask;
+      };
+    EXPECT_EQ(distance_filter.filter(batch), expected_mask(distance_filter));
+    EXPECT_EQ(distance_filter.filter(batch) & 3ULL, 3ULL);
+    for (const auto & angle_filter : angle_filters) {
+      EXPECT_EQ(angle_filter.filter(batch), expected_mask(angle_filter));
+    }
+  }
+}
+
+TEST(TestPointBatch, TransformMatchesPerPoint)
+{
+  using autoware::common::lidar_utils::PointBatch;
+  using autoware::common::lidar_utils::POINT_BATCH_CAPACITY;
+  using autoware::common::lidar_utils::StaticTransformer;
+  using autoware::common::types::PointXYZF;
+
+  Eigen::Quaternionf rotation;
+  rotation = Eigen::AngleAxisf(0.3F, Eigen::Vector3f{1.0F, 2.0F, 3.0F}.normalized());
+  geometry_msgs::msg::Transform tf;
+  tf.translation.x = 1.0;
+  tf.translation.y = -2.0;
+  tf.translation.z = 0.5;
+  tf.rotation.x = static_cast<float64_t>(rotation.x());
+  tf.rotation.y = static_cast<float64_t>(rotation.y());
+  tf.rotation.z = static_cast<float64_t>(rotation.z());
+  tf.rotation.w = static_cast<float64_t>(rotation.w());
+  const StaticTransformer transformer{tf};
+
+  PointBatch batch;
+  batch.size = POINT_BATCH_CAPACITY;
+  for (std::size_t idx = 0U; idx < POINT_BATCH_CAPACITY; ++idx) {
+    batch.x[idx] = static_cast<float32_t>(idx);
+    batch.y[idx] = 5.0F - static_cast<float32_t>(idx);
+    batch.z[idx] = 0.25F * static_cast<float32_t>(idx);
+  }
+  const PointBatch input = batch;
+  transformer.transform(batch);
+  for (std::size_t idx = 0U; idx < POINT_BATCH_CAPACITY; ++idx) {
+    const PointXYZF pt{input.x[idx], input.y[idx], input.z[idx]};
+    PointXYZF expected{};
+    transformer.transform(pt, expected);
+    // Results may differ in the last bits if the compiler contracts to fused multiply-adds
+    EXPECT_NEAR(batch.x[idx], expected.x, 1.0e-4F);
+    EXPECT_NEAR(batch.y[idx], expected.y, 1.0e-4F);
+    EXPECT_NEAR(batch.z[idx], expected.z, 1.0e-4F);
+  }
+}
+
+TEST(TestCompactPointCloud, RoundTrip)
+{
+  using autoware::common::lidar_utils::COMPACT_POINT_STEP;
+  using autoware::common::lidar_utils::create_custom_pcl;
+  using autoware::common::lidar_utils::decode_compact_point_cloud;
+  using autoware::common::lidar_utils::encode_compact_point_cloud;
+  using autoware::common::lidar_utils::is_compact_point_cloud;
+
+  const std::vector<std::array<float32_t, 4U>> points{
+    {1.2344F, -2.0F, 0.0006F, 12.4F},
+    {-32.767F, 32.767F, -0.0004F, 300.0F},
+    // out of range at a resolution of 1 mm
+    {40.0F, 0.0F, 0.0F, 1.0F},
+    {std::numeric_limits<float32_t>::quiet_NaN(), 0.0F, 0.0F, 1.0F},
+    {0.5F, 0.25F, -1.0F, -3.0F}};
+  auto cloud = create_custom_pcl<float32_t>({"x", "y", "z", "intensity"}, 5U);
+  cloud->header.frame_id = "lidar";
+  for (std::size_t idx = 0U; idx < points.size(); ++idx) {
+    std::memcpy(&cloud->data[idx * cloud->point_step], points[idx].data(), sizeof(points[idx]));
+  }
+  EXPECT_FALSE(is_compact_point_cloud(*cloud));
+
+  sensor_msgs::msg::PointCloud2 compact;
+  EXPECT_THROW(encode_compact_point_cloud(*cloud, 0.0F, compact), std::domain_error);
+  EXPECT_EQ(encode_compact_point_cloud(*cloud, 0.001F, compact), 2U);
+  EXPECT_TRUE(is_compact_point_cloud(compact));
+  EXPECT_EQ(compact.header.frame_id, "lidar");
+  EXPECT_EQ(compact.width, 3U);
+  EXPECT_EQ(compact.point_step, COMPACT_POINT_STEP);
+  EXPECT_EQ(compact.data.size(), 3U * COMPACT_POINT_STEP);
+
+  sensor_msgs::msg::PointCloud2 decoded;
+  EXPECT_THROW(decode_compact_point_cloud(*cloud, 0.001F, decoded), std::runtime_error);
+  decode_compact_point_cloud(compact, 0.001F, decoded);
+  EXPECT_TRUE(autoware::common::lidar_utils::has_intensity_and_throw_if_no_xyz(decoded));
+  EXPECT_EQ(decoded.header.frame_id, "lidar");
+  ASSERT_EQ(decoded.width, 3U);
+  ASSERT_EQ(decoded.data.size(), 3U * decoded.point_step);
+  const std::vector<std::array<float32_t, 4U>> expected{
+    {1.234F, -2.0F, 0.001F, 12.0F},
+    {-32.767F, 32.767F, 0.0F, 255.0F},
+    {0.5F, 0.25F, -1.0F, 0.0F}};
+  for (std::size_t idx = 0U; idx < expected.size(); ++idx) {
+    std::array<float32_t, 4U> point{};
+    std::memcpy(point.data(), &decoded.data[idx * decoded.point_step], sizeof(point));
+    for (std::size_t field = 0U; field < 3U; ++field) {
+      EXPECT_NEAR(point[field], expected[idx][field], 1.0e-5F) << idx;
+    }
+    EXPECT_EQ(point[3U], expected[idx][3U]) << idx;
+  }
+
+  // Encoding into the same message again reuses its layout
+  cloud->width = 1U;
+  cloud->row_step = cloud->point_step;
+  EXPECT_EQ(encode_compact_point_cloud(*cloud, 0.001F, compact), 0U);
+  EXPECT_EQ(compact.width, 1U);
+  EXPECT_EQ(compact.data.size(), COMPACT_POINT_STEP);
+}
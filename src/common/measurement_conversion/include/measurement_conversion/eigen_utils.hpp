@@ -19,6 +19,9 @@
 
 #include <Eigen/Geometry>
 
+#include <array>
+#include <stdexcept>
+#include <string>
 
 namespace autoware
 {
@@ -161,6 +164,66 @@ Eigen::Matrix<ScalarT, kRows, kCols> array_to_matrix(
   return res;
 }
 
+///
+/// @brief      A read-only view of a part of an array as an Eigen matrix, without copying it.
+///
+/// @tparam     kRows          Number of rows in the matrix
+/// @tparam     kCols          Number of columns in the matrix
+/// @tparam     ScalarT        Scalar type
+/// @tparam     kStorageOrder  The storage order of the data in the array
+///
+template<
+  std::int32_t kRows, std::int32_t kCols, typename ScalarT, DataStorageOrder kStorageOrder>
+using ArrayMatrixMap = Eigen::Map<
+  const Eigen::Matrix<ScalarT, kRows, kCols,
+  (kStorageOrder == DataStorageOrder::kRowMajor) ? Eigen::RowMajor : Eigen::ColMajor>,
+  Eigen::Unaligned, Eigen::OuterStride<>>;
+
+///
+/// @brief      View a given array as an Eigen matrix using the specified stride and a starting
+///             index within this array, without copying the data.
+///
+/// @details    This is the same as array_to_matrix, but the result refers to the array, so it is
+///             only valid for the lifetime of the array. It can be assigned to a block of a matrix
+///             directly, e.g. a block of the covariance of a measurement.
+///
+/// @throws     std::runtime_error  if there is not enough elements in the array to view all the
+///                                 asked elements.
+///
+/// @param[in]  array          The given array (e.g. a covariance array from a message)
+/// @param[in]  start_index    The start index of the first element in the array
+/// @param[in]  stride         How big the step to the next row is in terms of indices in the array
+///
+/// @tparam     kRows          Number of rows in the resulting matrix
+/// @tparam     kCols          Number of columns in the resulting matrix
+/// @tparam     kStorageOrder  The storage order of the data in the array (row-major for ROS)
+/// @tparam     ScalarT        Scalar type (inferred)
+/// @tparam     kSize          Size of the input array (inferred)
+///
+/// @return     A map of the requested data.
+///
+template<
+  std::int32_t kRows, std::int32_t kCols,
+  DataStorageOrder kStorageOrder = DataStorageOrder::kRowMajor,
+  typename ScalarT, std::size_t kSize>
+ArrayMatrixMap<kRows, kCols, ScalarT, kStorageOrder> array_as_matrix(
+  const std::array<ScalarT, kSize> & array,
+  const std::int32_t start_index,
+  const std::int32_t stride)
+{
+  static_assert(
+    (kRows > 1) && (kCols > 1), "Use array_to_matrix to get a vector from an array.");
+  const detail::Index index{start_index, stride, kStorageOrder};
+  const auto max_index = index(kRows - 1, kCols - 1);
+  if (max_index >= array.size()) {
+    throw std::runtime_error(
+            "Trying to access out of bound memory at index " +
+            std::to_string(max_index) + " of an array with size: " + std::to_string(array.size()));
+  }
+  return ArrayMatrixMap<kRows, kCols, ScalarT, kStorageOrder>{
+    &array[static_cast<std::size_t>(start_index)], Eigen::OuterStride<>{stride}};
+}
+
 ///
 /// @brief      Sets data in an array from a given Eigen matrix.
 ///
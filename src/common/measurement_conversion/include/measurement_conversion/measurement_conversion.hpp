@@ -95,6 +95,24 @@ struct MEASUREMENT_CONVERSION_PUBLIC convert_to<Stamped<MeasurementT>>
       convert_to<MeasurementT>::from(detail::unstamp(msg))
     };
   }
+
+  ///
+  /// @brief      Convert a message into an existing `Stamped` measurement.
+  ///
+  /// @details    The mean and covariance are written into the given measurement directly, so that
+  ///             a measurement can be reused for every message.
+  ///
+  /// @param[in]  msg          The message to be converted to a stamped measurement.
+  /// @param[out] measurement  The stamped measurement to be overwritten.
+  ///
+  /// @tparam     MsgT         A message type that must have a header.
+  ///
+  template<typename MsgT>
+  static void from(const MsgT & msg, Stamped<MeasurementT> & measurement)
+  {
+    measurement.timestamp = time_utils::from_message(msg.header.stamp);
+    convert_to<MeasurementT>::from(detail::unstamp(msg), measurement.measurement);
+  }
 };
 
 /// A specialization for PoseMeasurementXYZRPY64.
@@ -102,6 +120,8 @@ template<>
 struct MEASUREMENT_CONVERSION_PUBLIC convert_to<PoseMeasurementXYZRPY64>
 {
   static PoseMeasurementXYZRPY64 from(const geometry_msgs::msg::PoseWithCovariance & msg);
+  static void from(
+    const geometry_msgs::msg::PoseWithCovariance & msg, PoseMeasurementXYZRPY64 & measurement);
 };
 
 /// A specialization for PoseMeasurementXYZ64.
@@ -110,6 +130,9 @@ struct MEASUREMENT_CONVERSION_PUBLIC convert_to<PoseMeasurementXYZ64>
 {
   static PoseMeasurementXYZ64 from(
     const autoware_auto_msgs::msg::RelativePositionWithCovarianceStamped & msg);
+  static void from(
+    const autoware_auto_msgs::msg::RelativePositionWithCovarianceStamped & msg,
+    PoseMeasurementXYZ64 & measurement);
 };
 
 }  // namespace state_estimation
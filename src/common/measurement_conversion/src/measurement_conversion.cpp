@@ -61,36 +61,48 @@ namespace state_estimation
 PoseMeasurementXYZRPY64 convert_to<PoseMeasurementXYZRPY64>::from(
   const geometry_msgs::msg::PoseWithCovariance & msg)
 {
-  using Vector6d = Eigen::Matrix<float64_t, 6, 1>;
-  using Matrix6d = Eigen::Matrix<float64_t, 6, 6>;
+  PoseMeasurementXYZRPY64 measurement{};
+  from(msg, measurement);
+  return measurement;
+}
+
+void convert_to<PoseMeasurementXYZRPY64>::from(
+  const geometry_msgs::msg::PoseWithCovariance & msg, PoseMeasurementXYZRPY64 & measurement)
+{
   float64_t roll{}, pitch{}, yaw{};
   tf2::Quaternion quaternion;
   tf2::fromMsg(msg.pose.orientation, quaternion);
   tf2::Matrix3x3{quaternion}.getRPY(roll, pitch, yaw);
-  const Vector6d mean = (Vector6d{} <<
-    msg.pose.position.x, msg.pose.position.y, msg.pose.position.z, roll, pitch, yaw).finished();
-  Matrix6d covariance = Matrix6d::Zero();
+  measurement.state().vector() <<
+    msg.pose.position.x, msg.pose.position.y, msg.pose.position.z, roll, pitch, yaw;
+  auto & covariance = measurement.covariance();
   const auto & cov = msg.covariance;
   const auto stride = kCovarianceMatrixRows;
   const auto position_start_idx = 0;
-  covariance.topLeftCorner<3, 3>() =
-    array_to_matrix<3, 3>(cov, position_start_idx, stride, DataStorageOrder::kRowMajor);
+  covariance.topLeftCorner<3, 3>() = array_as_matrix<3, 3>(cov, position_start_idx, stride);
+  covariance.topRightCorner<3, 3>().setZero();
+  covariance.bottomLeftCorner<3, 3>().setZero();
   const auto rotation_start_idx{kAngleOffset};
-  covariance.bottomRightCorner<3, 3>() =
-    array_to_matrix<3, 3>(cov, rotation_start_idx, stride, DataStorageOrder::kRowMajor);
-  return PoseMeasurementXYZRPY64{mean, covariance};
+  covariance.bottomRightCorner<3, 3>() = array_as_matrix<3, 3>(cov, rotation_start_idx, stride);
 }
 
 PoseMeasurementXYZ64 convert_to<PoseMeasurementXYZ64>::from(
   const autoware_auto_msgs::msg::RelativePositionWithCovarianceStamped & msg)
 {
-  const Eigen::Vector3d mean{msg.position.x, msg.position.y, msg.position.z};
+  PoseMeasurementXYZ64 measurement{};
+  from(msg, measurement);
+  return measurement;
+}
+
+void convert_to<PoseMeasurementXYZ64>::from(
+  const autoware_auto_msgs::msg::RelativePositionWithCovarianceStamped & msg,
+  PoseMeasurementXYZ64 & measurement)
+{
+  measurement.state().vector() << msg.position.x, msg.position.y, msg.position.z;
   const auto & cov = msg.covariance;
   const auto start_idx = 0;
   const auto stride = kCovarianceMatrixRowsRelativePos;
-  const Eigen::Matrix3d covariance =
-    array_to_matrix<3, 3>(cov, start_idx, stride, DataStorageOrder::kRowMajor);
-  return PoseMeasurementXYZ64{mean, covariance};
+  measurement.covariance() = array_as_matrix<3, 3>(cov, start_idx, stride);
 }
 
 }  // namespace state_estimation
@@ -0,0 +1,105 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <benchmark/benchmark.h>
+#include <common/types.hpp>
+#include <measurement_conversion/eigen_utils.hpp>
+#include <measurement_conversion/measurement_conversion.hpp>
+
+#include <cstdint>
+
+namespace
+{
+
+using autoware::common::state_estimation::DataStorageOrder;
+using autoware::common::state_estimation::PoseMeasurementXYZRPY64;
+using autoware::common::state_estimation::Stamped;
+using autoware::common::state_estimation::array_as_matrix;
+using autoware::common::state_estimation::array_to_matrix;
+using autoware::common::state_estimation::convert_to;
+using autoware::common::types::float64_t;
+using Matrix6d = Eigen::Matrix<float64_t, 6, 6>;
+
+geometry_msgs::msg::PoseWithCovarianceStamped create_pose_msg() noexcept
+{
+  geometry_msgs::msg::PoseWithCovarianceStamped msg{};
+  msg.header.frame_id = "map";
+  msg.header.stamp.sec = 42;
+  msg.pose.pose.position.x = 42.0;
+  msg.pose.pose.position.y = 23.0;
+  msg.pose.pose.position.z = 1.0;
+  msg.pose.pose.orientation.z = 0.7071068;
+  msg.pose.pose.orientation.w = 0.7071068;
+  for (std::size_t i = 0U; i < msg.pose.covariance.size(); ++i) {
+    msg.pose.covariance[i] = (i % 7U == 0U) ? 1.0 : 0.1;
+  }
+  return msg;
+}
+
+}  // namespace
+
+// Baseline: copy the covariance blocks element-wise into temporary matrices
+static void BenchCovarianceBlocksCopy(benchmark::State & state)
+{
+  const auto msg = create_pose_msg();
+  Matrix6d covariance = Matrix6d::Zero();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(msg.pose.covariance.data());
+    covariance.topLeftCorner<3, 3>() =
+      array_to_matrix<3, 3>(msg.pose.covariance, 0, 6, DataStorageOrder::kRowMajor);
+    covariance.bottomRightCorner<3, 3>() =
+      array_to_matrix<3, 3>(msg.pose.covariance, 21, 6, DataStorageOrder::kRowMajor);
+    benchmark::DoNotOptimize(covariance.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BenchCovarianceBlocksView(benchmark::State & state)
+{
+  const auto msg = create_pose_msg();
+  Matrix6d covariance = Matrix6d::Zero();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(msg.pose.covariance.data());
+    covariance.topLeftCorner<3, 3>() = array_as_matrix<3, 3>(msg.pose.covariance, 0, 6);
+    covariance.bottomRightCorner<3, 3>() = array_as_matrix<3, 3>(msg.pose.covariance, 21, 6);
+    benchmark::DoNotOptimize(covariance.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BenchConvertPoseToNewMeasurement(benchmark::State & state)
+{
+  const auto msg = create_pose_msg();
+  for (auto _ : state) {
+    auto measurement = convert_to<Stamped<PoseMeasurementXYZRPY64>>::from(msg);
+    benchmark::DoNotOptimize(measurement.measurement.covariance().data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BenchConvertPoseIntoExistingMeasurement(benchmark::State & state)
+{
+  const auto msg = create_pose_msg();
+  Stamped<PoseMeasurementXYZRPY64> measurement{};
+  for (auto _ : state) {
+    convert_to<Stamped<PoseMeasurementXYZRPY64>>::from(msg, measurement);
+    benchmark::DoNotOptimize(measurement.measurement.covariance().data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BenchCovarianceBlocksCopy)->Unit(benchmark::kNanosecond);
+BENCHMARK(BenchCovarianceBlocksView)->Unit(benchmark::kNanosecond);
+BENCHMARK(BenchConvertPoseToNewMeasurement)->Unit(benchmark::kNanosecond);
+BENCHMARK(BenchConvertPoseIntoExistingMeasurement)->Unit(benchmark::kNanosecond);
@@ -26,6 +26,7 @@
 
 using autoware::common::state_estimation::downscale_isometry;
 using autoware::common::state_estimation::array_to_matrix;
+using autoware::common::state_estimation::array_as_matrix;
 using autoware::common::state_estimation::slice;
 using autoware::common::state_estimation::DataStorageOrder;
 using autoware::common::types::float64_t;
@@ -95,6 +96,32 @@ TEST(MeasurementConversion, PartialArrayToMatrix) {
     std::runtime_error);
 }
 
+/// \test Check that a view of an array matches the copy of the same part of the array.
+TEST(MeasurementConversion, ArrayAsMatrix) {
+  std::array<float64_t, 9UL> data{0, 1, 2, 3, 4, 5, 6, 7, 8};
+  const auto stride = 3;
+  const auto start_index = 1;
+  const auto view_as_row_major = array_as_matrix<2, 2>(data, start_index, stride);
+  EXPECT_EQ(
+    view_as_row_major,
+    (array_to_matrix<2, 2>(data, start_index, stride, DataStorageOrder::kRowMajor)));
+  const auto view_as_col_major =
+    array_as_matrix<2, 2, DataStorageOrder::kColumnMajor>(data, start_index, stride);
+  EXPECT_EQ(
+    view_as_col_major,
+    (array_to_matrix<2, 2>(data, start_index, stride, DataStorageOrder::kColumnMajor)));
+  // The view refers to the array.
+  data[1] = 42.0;
+  EXPECT_DOUBLE_EQ(view_as_row_major(0, 0), 42.0);
+  EXPECT_DOUBLE_EQ(view_as_col_major(0, 0), 42.0);
+  const auto too_big_start = 6;
+  EXPECT_THROW((array_as_matrix<2, 2>(data, too_big_start, stride)), std::runtime_error);
+  const auto too_big_stride = 10;
+  EXPECT_THROW(
+    (array_as_matrix<2, 2, DataStorageOrder::kColumnMajor>(data, start_index, too_big_stride)),
+    std::runtime_error);
+}
+
 /// \test Check that a matrix can be represented as an array.
 TEST(MeasurementConversion, WholeMatrixToArray) {
   std::array<float64_t, 4UL> data_row_major{};
@@ -131,3 +131,30 @@ TEST(MeasurementConversionTest, Pose) {
     measurement.timestamp.time_since_epoch(),
     std::chrono::seconds{42LL});
 }
+
+/// \test Convert messages into existing measurements.
+TEST(MeasurementConversionTest, ConvertIntoExistingMeasurement) {
+  const auto pose_msg = create_pose_msg();
+  Stamped<PoseMeasurementXYZRPY64> pose_measurement{};
+  pose_measurement.measurement.covariance().setOnes();
+  convert_to<Stamped<PoseMeasurementXYZRPY64>>::from(pose_msg, pose_measurement);
+  const auto expected_pose = convert_to<Stamped<PoseMeasurementXYZRPY64>>::from(pose_msg);
+  EXPECT_EQ(pose_measurement.timestamp, expected_pose.timestamp);
+  EXPECT_EQ(
+    pose_measurement.measurement.state().vector(), expected_pose.measurement.state().vector());
+  // The blocks between position and rotation are cleared.
+  EXPECT_EQ(pose_measurement.measurement.covariance(), expected_pose.measurement.covariance());
+
+  const auto relative_pos_msg = create_relative_pos_msg();
+  Stamped<PoseMeasurementXYZ64> relative_pos_measurement{};
+  convert_to<Stamped<PoseMeasurementXYZ64>>::from(relative_pos_msg, relative_pos_measurement);
+  const auto expected_relative_pos =
+    convert_to<Stamped<PoseMeasurementXYZ64>>::from(relative_pos_msg);
+  EXPECT_EQ(relative_pos_measurement.timestamp, expected_relative_pos.timestamp);
+  EXPECT_EQ(
+    relative_pos_measurement.measurement.state().vector(),
+    expected_relative_pos.measurement.state().vector());
+  EXPECT_EQ(
+    relative_pos_measurement.measurement.covariance(),
+    expected_relative_pos.measurement.covariance());
+}
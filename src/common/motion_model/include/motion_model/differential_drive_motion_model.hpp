@@ -57,6 +57,26 @@ protected:
       sizeof(StateT) == 0,
       "Function crtp_jacobian is expected to be specialized for every state it is used with.");
   }
+
+  /// @brief      A crtp-called function that propagates a covariance through the motion model.
+  typename State::Matrix crtp_propagate_covariance(
+    const State &,
+    const typename State::Matrix &,
+    const std::chrono::nanoseconds &) const
+  {
+    static_assert(
+      sizeof(StateT) == 0,
+      "Function crtp_propagate_covariance is expected to be specialized for every state it is "
+      "used with.");
+  }
+
+  /// @brief      A crtp-called function that predicts a batch of states forward.
+  void crtp_predict_batch(StateBatchRef<State>, const std::chrono::nanoseconds &) const
+  {
+    static_assert(
+      sizeof(StateT) == 0,
+      "Function crtp_predict_batch is expected to be specialized for every state it is used with.");
+  }
 };
 
 /// @brief      An alias of the differential drive motion model for the
@@ -124,6 +144,58 @@ MOTION_MODEL_PUBLIC CatrMotionModel64::State::Matrix CatrMotionModel64::crtp_jac
   const CatrMotionModel64::State & state,
   const std::chrono::nanoseconds & dt) const;
 
+/// @brief      A crtp-called function that predicts a batch of states forward.
+template<>
+MOTION_MODEL_PUBLIC void CvtrMotionModel32::crtp_predict_batch(
+  StateBatchRef<CvtrMotionModel32::State> states,
+  const std::chrono::nanoseconds & dt) const;
+
+/// @brief      A crtp-called function that predicts a batch of states forward.
+template<>
+MOTION_MODEL_PUBLIC void CvtrMotionModel64::crtp_predict_batch(
+  StateBatchRef<CvtrMotionModel64::State> states,
+  const std::chrono::nanoseconds & dt) const;
+
+/// @brief      A crtp-called function that predicts a batch of states forward.
+template<>
+MOTION_MODEL_PUBLIC void CatrMotionModel32::crtp_predict_batch(
+  StateBatchRef<CatrMotionModel32::State> states,
+  const std::chrono::nanoseconds & dt) const;
+
+/// @brief      A crtp-called function that predicts a batch of states forward.
+template<>
+MOTION_MODEL_PUBLIC void CatrMotionModel64::crtp_predict_batch(
+  StateBatchRef<CatrMotionModel64::State> states,
+  const std::chrono::nanoseconds & dt) const;
+
+/// @brief      A crtp-called function that propagates a covariance through the motion model.
+template<>
+MOTION_MODEL_PUBLIC CvtrMotionModel32::State::Matrix CvtrMotionModel32::crtp_propagate_covariance(
+  const CvtrMotionModel32::State & state,
+  const CvtrMotionModel32::State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt) const;
+
+/// @brief      A crtp-called function that propagates a covariance through the motion model.
+template<>
+MOTION_MODEL_PUBLIC CvtrMotionModel64::State::Matrix CvtrMotionModel64::crtp_propagate_covariance(
+  const CvtrMotionModel64::State & state,
+  const CvtrMotionModel64::State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt) const;
+
+/// @brief      A crtp-called function that propagates a covariance through the motion model.
+template<>
+MOTION_MODEL_PUBLIC CatrMotionModel32::State::Matrix CatrMotionModel32::crtp_propagate_covariance(
+  const CatrMotionModel32::State & state,
+  const CatrMotionModel32::State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt) const;
+
+/// @brief      A crtp-called function that propagates a covariance through the motion model.
+template<>
+MOTION_MODEL_PUBLIC CatrMotionModel64::State::Matrix CatrMotionModel64::crtp_propagate_covariance(
+  const CatrMotionModel64::State & state,
+  const CatrMotionModel64::State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt) const;
+
 }  // namespace motion_model
 }  // namespace common
 }  // namespace autoware
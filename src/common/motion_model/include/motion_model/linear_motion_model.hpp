@@ -74,6 +74,39 @@ protected:
   /// @return     A matrix that represents the Jacobian.
   ///
   typename State::Matrix crtp_jacobian(const State &, const std::chrono::nanoseconds & dt) const;
+
+  ///
+  /// @brief      A crtp-called function that propagates a covariance through the motion model.
+  ///
+  /// @details    The Jacobian is block diagonal with an upper triangular block per variable, so
+  ///             J * P * J^T is computed by adding multiples of rows and columns of P to each other
+  ///             within every block instead of with two dense matrix products.
+  ///
+  /// @note       This makes the same assumption about the variables as crtp_jacobian, and must be
+  ///             specialized together with it.
+  ///
+  /// @return     The propagated covariance.
+  ///
+  typename State::Matrix crtp_propagate_covariance(
+    const State &,
+    const typename State::Matrix & covariance,
+    const std::chrono::nanoseconds & dt) const;
+
+  ///
+  /// @brief      A crtp-called function that predicts a batch of states forward.
+  ///
+  /// @details    The transition matrix only depends on the time span, so it is computed once and
+  ///             applied to all the states with a single matrix product.
+  ///
+  /// @param[in,out]  states  The states to predict, one per column.
+  /// @param[in]      dt      Time difference
+  ///
+  inline void crtp_predict_batch(
+    StateBatchRef<State> states,
+    const std::chrono::nanoseconds & dt) const
+  {
+    states = crtp_jacobian(State{}, dt) * states;
+  }
 };
 
 }  // namespace motion_model
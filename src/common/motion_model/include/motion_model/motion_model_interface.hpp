@@ -21,6 +21,8 @@
 #include <motion_model/visibility_control.hpp>
 #include <state_vector/generic_state.hpp>
 
+#include <Eigen/Core>
+
 #include <chrono>
 
 namespace autoware
@@ -30,6 +32,22 @@ namespace common
 namespace motion_model
 {
 
+///
+/// @brief      A batch of states of the same type, stored as a structure of arrays.
+///
+/// @details    Row i holds variable i of all the states and column j is state j, so that the same
+///             variable of all the states is contiguous in memory and can be processed at once.
+///
+/// @tparam     StateT  Type of the states.
+///
+template<typename StateT>
+using StateBatch =
+  Eigen::Matrix<typename StateT::Scalar, StateT::size(), Eigen::Dynamic, Eigen::RowMajor>;
+
+/// @brief      A reference to a StateBatch or to a fixed-size map with the same layout.
+template<typename StateT>
+using StateBatchRef = Eigen::Ref<StateBatch<StateT>>;
+
 ///
 /// @brief      A CRTP interface for any motion model.
 ///
@@ -75,6 +93,90 @@ public:
       "\n\nStateT must be a GenericState\n\n");
     return this->impl().crtp_jacobian(state, dt);
   }
+  ///
+  /// @brief      Propagate a covariance through this motion model, i.e. compute J * P * J^T
+  ///             for the Jacobian J at the given state.
+  ///
+  /// @details    Implementations can exploit the structure of their Jacobian, which is known at
+  ///             compile time, and only touch the entries of the covariance that change.
+  ///
+  /// @param[in]  state       The state at which the Jacobian is computed.
+  /// @param[in]  covariance  The covariance to propagate.
+  /// @param[in]  dt          Time span.
+  ///
+  /// @tparam     StateT  Type of the state.
+  ///
+  /// @return     The propagated covariance.
+  ///
+  template<typename StateT>
+  inline auto propagate_covariance(
+    const StateT & state,
+    const typename StateT::Matrix & covariance,
+    const std::chrono::nanoseconds & dt) const
+  {
+    static_assert(
+      common::state_vector::is_state<StateT>::value,
+      "\n\nStateT must be a GenericState\n\n");
+    return this->impl().crtp_propagate_covariance(state, covariance, dt);
+  }
+  ///
+  /// @brief      Predict a batch of states forward in place, all by the same time span.
+  ///
+  /// @details    This is equivalent to calling predict for every column of the batch, but lets the
+  ///             implementation share the work that only depends on the time span and process all
+  ///             the states at once.
+  ///
+  /// @param[in,out]  states  The states to predict, one per column. This is a StateBatch, or a
+  ///                         fixed-size matrix or map with the same layout.
+  /// @param[in]      dt      Length of prediction into the future
+  ///
+  /// @tparam     BatchT  Type of the batch.
+  ///
+  template<typename BatchT>
+  inline void predict_batch(
+    Eigen::DenseBase<BatchT> & states,
+    const std::chrono::nanoseconds & dt) const
+  {
+    using State = typename Derived::State;
+    static_assert(
+      static_cast<Eigen::Index>(BatchT::RowsAtCompileTime) == State::size(),
+      "\n\nEvery column of the batch must be a state of the motion model\n\n");
+    this->impl().crtp_predict_batch(StateBatchRef<State>{states.derived()}, dt);
+  }
+
+protected:
+  ///
+  /// @brief      A crtp-called function that propagates a covariance through the motion model.
+  ///
+  /// @details    This default implementation multiplies with the dense Jacobian. Motion models can
+  ///             hide it with a function that exploits the structure of their Jacobian.
+  ///
+  template<typename StateT>
+  typename StateT::Matrix crtp_propagate_covariance(
+    const StateT & state,
+    const typename StateT::Matrix & covariance,
+    const std::chrono::nanoseconds & dt) const
+  {
+    const typename StateT::Matrix jacobian = this->impl().jacobian(state, dt);
+    return jacobian * covariance * jacobian.transpose();
+  }
+
+  ///
+  /// @brief      A crtp-called function that predicts a batch of states forward.
+  ///
+  /// @details    This default implementation predicts the states one by one. Motion models can
+  ///             hide it with a function that processes the whole batch at once.
+  ///
+  template<typename ScalarT, int kStateSize>
+  void crtp_predict_batch(
+    Eigen::Ref<Eigen::Matrix<ScalarT, kStateSize, Eigen::Dynamic, Eigen::RowMajor>> states,
+    const std::chrono::nanoseconds & dt) const
+  {
+    using State = typename Derived::State;
+    for (Eigen::Index i = 0; i < states.cols(); ++i) {
+      states.col(i) = this->impl().predict(State{states.col(i)}, dt).vector();
+    }
+  }
 };
 
 }  // namespace motion_model
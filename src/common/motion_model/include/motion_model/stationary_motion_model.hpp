@@ -69,6 +69,22 @@ protected:
   {
     return Eigen::Matrix<typename State::Scalar, State::size(), State::size()>::Identity();
   }
+
+  ///
+  /// @brief      A crtp-called function that propagates a covariance through the motion model.
+  ///
+  /// @return     The unchanged covariance, as the Jacobian is an identity matrix.
+  ///
+  typename State::Matrix crtp_propagate_covariance(
+    const State &,
+    const typename State::Matrix & covariance,
+    const std::chrono::nanoseconds &) const
+  {
+    return covariance;
+  }
+
+  /// @brief      A crtp-called function that leaves a batch of states unchanged.
+  inline void crtp_predict_batch(StateBatchRef<State>, const std::chrono::nanoseconds &) const {}
 };
 
 }  // namespace motion_model
@@ -19,6 +19,7 @@
 #include <common/types.hpp>
 #include <helper_functions/float_comparisons.hpp>
 
+#include <array>
 #include <cmath>
 
 namespace
@@ -47,6 +48,30 @@ namespace common
 namespace motion_model
 {
 
+///
+/// @brief      Compute J * P * J^T for a Jacobian J that only differs from the identity matrix in
+///             the given rows.
+///
+/// @details    Only these rows of J * P and then only these columns of (J * P) * J^T differ from
+///             the input, so only those are computed.
+///
+template<typename MatrixT, std::size_t kNumRows>
+MatrixT propagate_through_rows(
+  const MatrixT & jacobian,
+  const MatrixT & covariance,
+  const std::array<Eigen::Index, kNumRows> & non_identity_rows)
+{
+  MatrixT jacobian_times_covariance{covariance};
+  for (const auto row : non_identity_rows) {
+    jacobian_times_covariance.row(row) = jacobian.row(row) * covariance;
+  }
+  MatrixT result{jacobian_times_covariance};
+  for (const auto row : non_identity_rows) {
+    result.col(row) = jacobian_times_covariance * jacobian.row(row).transpose();
+  }
+  return result;
+}
+
 template<typename ScalarT>
 typename CvtrMotionModel<ScalarT>::State cvtr_predict(
   const typename CvtrMotionModel<ScalarT>::State & state,
@@ -128,6 +153,46 @@ typename CvtrMotionModel<ScalarT>::State::Matrix cvtr_jacobian(
   return jacobian;
 }
 
+template<typename ScalarT>
+typename CvtrMotionModel<ScalarT>::State::Matrix cvtr_propagate_covariance(
+  const typename CvtrMotionModel<ScalarT>::State & state,
+  const typename CvtrMotionModel<ScalarT>::State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt)
+{
+  using State = typename CvtrMotionModel<ScalarT>::State;
+  // All the other rows of the Jacobian are identity rows.
+  constexpr std::array<Eigen::Index, 4U> non_identity_rows{{
+    State::template index_of<X>(), State::template index_of<Y>(),
+    State::template index_of<YAW>(), State::template index_of<XY_VELOCITY>()}};
+  return propagate_through_rows(cvtr_jacobian<ScalarT>(state, dt), covariance, non_identity_rows);
+}
+
+
+template<typename ScalarT>
+void cvtr_predict_batch(
+  StateBatchRef<typename CvtrMotionModel<ScalarT>::State> states,
+  const std::chrono::nanoseconds & dt)
+{
+  using State = typename CvtrMotionModel<ScalarT>::State;
+  using RowArray = Eigen::Array<ScalarT, 1, Eigen::Dynamic>;
+  const auto t = std::chrono::duration<ScalarT>{dt}.count();
+  auto x = states.row(State::template index_of<X>()).array();
+  auto y = states.row(State::template index_of<Y>()).array();
+  auto theta = states.row(State::template index_of<YAW>()).array();
+  const RowArray v = states.row(State::template index_of<XY_VELOCITY>()).array();
+  const RowArray w = states.row(State::template index_of<YAW_CHANGE_RATE>()).array();
+  // Both the straight and the curved motion are computed for all the states, which keeps the loops
+  // free of branches, and the turn rate selects between them.
+  const Eigen::Array<bool, 1, Eigen::Dynamic> straight = w.abs() <= static_cast<ScalarT>(kEpsilon);
+  const RowArray safe_w = straight.select(static_cast<ScalarT>(1.0), w);
+  const RowArray sin_theta = theta.sin();
+  const RowArray cos_theta = theta.cos();
+  const RowArray next_theta = theta + t * w;
+  x += straight.select(t * v * cos_theta, v * (next_theta.sin() - sin_theta) / safe_w);
+  y += straight.select(t * v * sin_theta, v * (cos_theta - next_theta.cos()) / safe_w);
+  theta = next_theta;
+}
+
 
 template<typename ScalarT>
 typename CatrMotionModel<ScalarT>::State catr_predict(
@@ -168,6 +233,43 @@ typename CatrMotionModel<ScalarT>::State catr_predict(
   return new_state;
 }
 
+template<typename ScalarT>
+void catr_predict_batch(
+  StateBatchRef<typename CatrMotionModel<ScalarT>::State> states,
+  const std::chrono::nanoseconds & dt)
+{
+  using State = typename CatrMotionModel<ScalarT>::State;
+  using RowArray = Eigen::Array<ScalarT, 1, Eigen::Dynamic>;
+  const auto t = std::chrono::duration<ScalarT>{dt}.count();
+  auto x = states.row(State::template index_of<X>()).array();
+  auto y = states.row(State::template index_of<Y>()).array();
+  auto theta = states.row(State::template index_of<YAW>()).array();
+  auto v = states.row(State::template index_of<XY_VELOCITY>()).array();
+  const RowArray a = states.row(State::template index_of<XY_ACCELERATION>()).array();
+  const RowArray w = states.row(State::template index_of<YAW_CHANGE_RATE>()).array();
+  // Both the straight and the curved motion are computed for all the states, which keeps the loops
+  // free of branches, and the turn rate selects between them.
+  const Eigen::Array<bool, 1, Eigen::Dynamic> straight = w.abs() <= static_cast<ScalarT>(kEpsilon);
+  const RowArray inv_w = straight.select(static_cast<ScalarT>(1.0), w).inverse();
+  const RowArray sin_theta = theta.sin();
+  const RowArray cos_theta = theta.cos();
+  const RowArray next_theta = theta + t * w;
+  const RowArray sin_next_theta = next_theta.sin();
+  const RowArray cos_next_theta = next_theta.cos();
+  const RowArray straight_distance = static_cast<ScalarT>(0.5) * t * t * a + t * v;
+  x += straight.select(
+    straight_distance * cos_theta,
+    inv_w * t * a * sin_next_theta + inv_w * v * (sin_next_theta - sin_theta) +
+    inv_w * inv_w * a * (cos_next_theta - cos_theta));
+  y += straight.select(
+    straight_distance * sin_theta,
+    -inv_w * t * a * cos_next_theta + inv_w * v * (cos_theta - cos_next_theta) +
+    inv_w * inv_w * a * (sin_next_theta - sin_theta));
+  theta = next_theta;
+  v += t * a;
+}
+
+
 template<typename ScalarT>
 typename CatrMotionModel<ScalarT>::State::Matrix catr_jacobian(
   const typename CatrMotionModel<ScalarT>::State & state,
@@ -242,6 +344,20 @@ typename CatrMotionModel<ScalarT>::State::Matrix catr_jacobian(
   return jacobian;
 }
 
+template<typename ScalarT>
+typename CatrMotionModel<ScalarT>::State::Matrix catr_propagate_covariance(
+  const typename CatrMotionModel<ScalarT>::State & state,
+  const typename CatrMotionModel<ScalarT>::State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt)
+{
+  using State = typename CatrMotionModel<ScalarT>::State;
+  // All the other rows of the Jacobian are identity rows.
+  constexpr std::array<Eigen::Index, 4U> non_identity_rows{{
+    State::template index_of<X>(), State::template index_of<Y>(),
+    State::template index_of<YAW>(), State::template index_of<XY_VELOCITY>()}};
+  return propagate_through_rows(catr_jacobian<ScalarT>(state, dt), covariance, non_identity_rows);
+}
+
 template<>
 MOTION_MODEL_PUBLIC CvtrMotionModel32::State CvtrMotionModel32::crtp_predict(
   const CvtrMotionModel32::State & state,
@@ -306,6 +422,74 @@ MOTION_MODEL_PUBLIC CatrMotionModel64::State::Matrix CatrMotionModel64::crtp_jac
   return catr_jacobian<float64_t>(state, dt);
 }
 
+template<>
+MOTION_MODEL_PUBLIC void CvtrMotionModel32::crtp_predict_batch(
+  StateBatchRef<CvtrMotionModel32::State> states,
+  const std::chrono::nanoseconds & dt) const
+{
+  cvtr_predict_batch<float32_t>(states, dt);
+}
+
+template<>
+MOTION_MODEL_PUBLIC void CvtrMotionModel64::crtp_predict_batch(
+  StateBatchRef<CvtrMotionModel64::State> states,
+  const std::chrono::nanoseconds & dt) const
+{
+  cvtr_predict_batch<float64_t>(states, dt);
+}
+
+template<>
+MOTION_MODEL_PUBLIC void CatrMotionModel32::crtp_predict_batch(
+  StateBatchRef<CatrMotionModel32::State> states,
+  const std::chrono::nanoseconds & dt) const
+{
+  catr_predict_batch<float32_t>(states, dt);
+}
+
+template<>
+MOTION_MODEL_PUBLIC void CatrMotionModel64::crtp_predict_batch(
+  StateBatchRef<CatrMotionModel64::State> states,
+  const std::chrono::nanoseconds & dt) const
+{
+  catr_predict_batch<float64_t>(states, dt);
+}
+
+template<>
+MOTION_MODEL_PUBLIC CvtrMotionModel32::State::Matrix CvtrMotionModel32::crtp_propagate_covariance(
+  const CvtrMotionModel32::State & state,
+  const CvtrMotionModel32::State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt) const
+{
+  return cvtr_propagate_covariance<float32_t>(state, covariance, dt);
+}
+
+template<>
+MOTION_MODEL_PUBLIC CvtrMotionModel64::State::Matrix CvtrMotionModel64::crtp_propagate_covariance(
+  const CvtrMotionModel64::State & state,
+  const CvtrMotionModel64::State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt) const
+{
+  return cvtr_propagate_covariance<float64_t>(state, covariance, dt);
+}
+
+template<>
+MOTION_MODEL_PUBLIC CatrMotionModel32::State::Matrix CatrMotionModel32::crtp_propagate_covariance(
+  const CatrMotionModel32::State & state,
+  const CatrMotionModel32::State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt) const
+{
+  return catr_propagate_covariance<float32_t>(state, covariance, dt);
+}
+
+template<>
+MOTION_MODEL_PUBLIC CatrMotionModel64::State::Matrix CatrMotionModel64::crtp_propagate_covariance(
+  const CatrMotionModel64::State & state,
+  const CatrMotionModel64::State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt) const
+{
+  return catr_propagate_covariance<float64_t>(state, covariance, dt);
+}
+
 }  // namespace motion_model
 }  // namespace common
 }  // namespace autoware
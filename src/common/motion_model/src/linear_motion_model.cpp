@@ -48,6 +48,28 @@ Eigen::Matrix<ScalarT, size, size> create_jacobian(const std::chrono::nanosecond
   return m;
 }
 
+template<typename ScalarT, int size>
+Eigen::Matrix<ScalarT, size, size> propagate_covariance(
+  Eigen::Matrix<ScalarT, size, size> covariance,
+  const std::chrono::nanoseconds & dt)
+{
+  // Every block of the Jacobian adds t times the velocity and t^2 / 2 times the acceleration to
+  // the position, and t times the acceleration to the velocity. J * P applies this to the rows of
+  // P and (J * P) * J^T applies it to the columns.
+  const auto t = std::chrono::duration<float64_t>{dt}.count();
+  const auto t_scalar = static_cast<ScalarT>(t);
+  const auto half_t2_scalar = static_cast<ScalarT>(0.5 * t * t);
+  for (int i = 0; i < size; i += 3) {
+    covariance.row(i) += t_scalar * covariance.row(i + 1) + half_t2_scalar * covariance.row(i + 2);
+    covariance.row(i + 1) += t_scalar * covariance.row(i + 2);
+  }
+  for (int i = 0; i < size; i += 3) {
+    covariance.col(i) += t_scalar * covariance.col(i + 1) + half_t2_scalar * covariance.col(i + 2);
+    covariance.col(i + 1) += t_scalar * covariance.col(i + 2);
+  }
+  return covariance;
+}
+
 }  // namespace
 
 namespace autoware
@@ -65,6 +87,15 @@ LinearMotionModel<StateT>::crtp_jacobian(
   return create_jacobian<typename State::Scalar, State::size()>(dt);
 }
 
+template<typename StateT>
+typename StateT::Matrix
+LinearMotionModel<StateT>::crtp_propagate_covariance(
+  const State &, const typename State::Matrix & covariance,
+  const std::chrono::nanoseconds & dt) const
+{
+  return propagate_covariance<typename State::Scalar, State::size()>(covariance, dt);
+}
+
 /// \cond DO_NOT_DOCUMENT
 
 template class MOTION_MODEL_PUBLIC LinearMotionModel<state_vector::ConstAccelerationXY32>;
@@ -25,6 +25,7 @@
 
 using autoware::common::motion_model::CatrMotionModel32;
 using autoware::common::motion_model::CvtrMotionModel32;
+using autoware::common::motion_model::StateBatch;
 using autoware::common::state_vector::variable::X;
 using autoware::common::state_vector::variable::Y;
 using autoware::common::state_vector::variable::YAW;
@@ -319,3 +320,65 @@ TEST(CatrMotionModelTest, PredictLinearMovementWithNonzeroTurnRate) {
   expected_state.at<XY_VELOCITY>() = 2.2F;
   EXPECT_EQ(expected_state, model.predict(initial_state, std::chrono::milliseconds{100LL}));
 }
+
+namespace
+{
+/// Check that the batch prediction matches the prediction of every single state.
+template<typename MotionModelT>
+void check_batch_prediction(const MotionModelT & model)
+{
+  using State = typename MotionModelT::State;
+  const auto dt = std::chrono::milliseconds{100LL};
+  StateBatch<State> states{StateBatch<State>::Random(State::size(), 6)};
+  // Some of the objects move on a straight line.
+  states(State::template index_of<YAW_CHANGE_RATE>(), 0) = 0.0F;
+  states(State::template index_of<YAW_CHANGE_RATE>(), 3) = 0.0F;
+  const StateBatch<State> initial_states{states};
+  model.predict_batch(states, dt);
+  for (Eigen::Index i = 0; i < states.cols(); ++i) {
+    const State expected_state{model.predict(State{initial_states.col(i)}, dt)};
+    EXPECT_TRUE(expected_state.vector().isApprox(states.col(i), kEpsilon)) <<
+      "State " << states.col(i).transpose() << " is not " << expected_state.vector().transpose();
+  }
+}
+
+/// Check that the covariance propagation matches the one with the dense Jacobian.
+template<typename MotionModelT>
+void check_covariance_propagation(const MotionModelT & model, const float32_t turn_rate)
+{
+  using State = typename MotionModelT::State;
+  const auto dt = std::chrono::milliseconds{100LL};
+  State state{State::Vector::Random()};
+  state.template at<YAW_CHANGE_RATE>() = turn_rate;
+  const typename State::Matrix random_matrix{State::Matrix::Random()};
+  const typename State::Matrix covariance{random_matrix * random_matrix.transpose()};
+  const typename State::Matrix jacobian{model.jacobian(state, dt)};
+  const typename State::Matrix expected_covariance{jacobian * covariance * jacobian.transpose()};
+  const typename State::Matrix propagated_covariance{
+    model.propagate_covariance(state, covariance, dt)};
+  EXPECT_TRUE(expected_covariance.isApprox(propagated_covariance, kEpsilon)) <<
+    "Covariance:\n" << propagated_covariance << "\nis not:\n" << expected_covariance;
+}
+}  // namespace
+
+/// @test Predict a batch of states at once.
+TEST(CvtrMotionModelTest, PredictBatch) {
+  check_batch_prediction(CvtrMotionModel32{});
+}
+
+/// @test Predict a batch of states at once.
+TEST(CatrMotionModelTest, PredictBatch) {
+  check_batch_prediction(CatrMotionModel32{});
+}
+
+/// @test Propagate the covariance with and without turning.
+TEST(CvtrMotionModelTest, PropagateCovariance) {
+  check_covariance_propagation(CvtrMotionModel32{}, 0.0F);
+  check_covariance_propagation(CvtrMotionModel32{}, 0.5F);
+}
+
+/// @test Propagate the covariance with and without turning.
+TEST(CatrMotionModelTest, PropagateCovariance) {
+  check_covariance_propagation(CatrMotionModel32{}, 0.0F);
+  check_covariance_propagation(CatrMotionModel32{}, 0.5F);
+}
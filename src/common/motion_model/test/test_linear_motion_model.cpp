@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 
 using autoware::common::motion_model::LinearMotionModel;
+using autoware::common::motion_model::StateBatch;
 using autoware::common::state_vector::ConstAccelerationXY32;
 using autoware::common::state_vector::ConstAccelerationXYYaw32;
 using autoware::common::state_vector::variable::X;
@@ -62,3 +63,34 @@ TEST(LinearMotionModel, PredictConstAccelerationXY) {
   EXPECT_FLOAT_EQ(1.1F, state.at<Y_VELOCITY>());
   EXPECT_FLOAT_EQ(1.0F, state.at<Y_ACCELERATION>());
 }
+
+/// @test Test that the batch prediction matches the prediction of every single state.
+TEST(LinearMotionModel, PredictBatchConstAccelerationXYYaw32) {
+  using State = ConstAccelerationXYYaw32;
+  LinearMotionModel<State> motion_model{};
+  const auto dt = std::chrono::milliseconds{100};
+  StateBatch<State> states{StateBatch<State>::Random(State::size(), 5)};
+  const StateBatch<State> initial_states{states};
+  motion_model.predict_batch(states, dt);
+  for (Eigen::Index i = 0; i < states.cols(); ++i) {
+    const State expected_state{motion_model.predict(State{initial_states.col(i)}, dt)};
+    EXPECT_TRUE(expected_state.vector().isApprox(states.col(i))) <<
+      "State " << states.col(i).transpose() << " is not " << expected_state.vector().transpose();
+  }
+}
+
+/// @test Test that the covariance propagation matches the one with the dense Jacobian.
+TEST(LinearMotionModel, PropagateCovarianceConstAccelerationXYYaw32) {
+  using State = ConstAccelerationXYYaw32;
+  LinearMotionModel<State> motion_model{};
+  const auto dt = std::chrono::milliseconds{100};
+  const State state{};
+  const State::Matrix random_matrix{State::Matrix::Random()};
+  const State::Matrix covariance{random_matrix * random_matrix.transpose()};
+  const State::Matrix jacobian{motion_model.jacobian(state, dt)};
+  const State::Matrix expected_covariance{jacobian * covariance * jacobian.transpose()};
+  const State::Matrix propagated_covariance{
+    motion_model.propagate_covariance(state, covariance, dt)};
+  EXPECT_TRUE(expected_covariance.isApprox(propagated_covariance)) <<
+    "Covariance:\n" << propagated_covariance << "\nis not:\n" << expected_covariance;
+}
@@ -0,0 +1,279 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPTIMIZATION__LEVENBERG_MARQUARDT_OPTIMIZER_HPP_
+#define OPTIMIZATION__LEVENBERG_MARQUARDT_OPTIMIZER_HPP_
+
+#include <optimization/optimizer.hpp>
+#include <optimization/optimization_problem.hpp>
+#include <optimization/optimizer_options.hpp>
+#include <Eigen/Cholesky>
+#include <algorithm>
+#include <cmath>
+
+namespace autoware
+{
+namespace common
+{
+namespace optimization
+{
+/// Options of the damping, i.e. of the trust region, of the Levenberg-Marquardt optimizer.
+class OPTIMIZATION_PUBLIC LevenbergMarquardtOptions
+{
+public:
+  /// Constructor to initialize const members
+  /// \param initial_damping_factor initial damping relative to the largest diagonal element of
+  /// the hessian at the initial value. Small values start close to a newton step.
+  /// \param max_damping damping beyond which no step can improve the score anymore, which
+  /// terminates the optimization as converged.
+  /// \throws std::domain_error on non-positive or non-finite values, or if the initial damping
+  /// factor exceeds the maximum damping.
+  explicit LevenbergMarquardtOptions(
+    float64_t initial_damping_factor = 1e-4, float64_t max_damping = 1e32);
+
+  /// Get the initial damping relative to the largest diagonal element of the hessian
+  float64_t initial_damping_factor() const noexcept;
+  /// Get the damping beyond which the optimization terminates
+  float64_t max_damping() const noexcept;
+
+private:
+  float64_t m_initial_damping_factor;
+  float64_t m_max_damping;
+};
+
+/// Storage of the Levenberg-Marquardt iterations. Keep an instance alive across solves of
+/// dynamically sized problems, so that the matrices and the decomposition are only allocated once.
+/// \tparam OptimizationProblemT Optimization problem type.
+/// \tparam DomainValueT Type of the parameter.
+/// \tparam EigenSolverT Type of the eigen solver of the damped system.
+template<typename OptimizationProblemT, typename DomainValueT,
+  typename EigenSolverT = Eigen::LDLT<typename OptimizationProblemT::Hessian>>
+struct LevenbergMarquardtWorkspace
+{
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  using Jacobian = typename OptimizationProblemT::Jacobian;
+  using Hessian = typename OptimizationProblemT::Hessian;
+
+  /// Resize the storage for a number of variables, which reallocates only if it changes.
+  void resize(const Eigen::Index num_vars)
+  {
+    jacobian.resize(num_vars, jacobian.cols());
+    hessian.resize(num_vars, num_vars);
+    damped_hessian.resize(num_vars, num_vars);
+    hessian_step.resize(num_vars, jacobian.cols());
+    step.resize(num_vars, 1);
+    x_candidate.resize(num_vars, 1);
+  }
+
+  Jacobian jacobian{Jacobian{}.setZero()};
+  Hessian hessian{Hessian{}.setZero()};
+  Hessian damped_hessian{Hessian{}.setZero()};
+  Jacobian hessian_step{Jacobian{}.setZero()};
+  DomainValueT step{DomainValueT{}.setZero()};
+  DomainValueT x_candidate{DomainValueT{}.setZero()};
+  EigenSolverT solver{};
+};
+
+/// Optimizer using the Levenberg-Marquardt method on the hessian of the problem, i.e. a trust
+/// region newton method: the step solves `(H + lambda * I) * step = -g`, is only accepted if it
+/// improves the score, and the damping `lambda` shrinks or grows depending on how well the
+/// quadratic model predicted the improvement [Nielsen 1999]. No line search is needed and
+/// indefinite hessians, e.g. far from the optimum of NDT, are handled by the damping.
+class OPTIMIZATION_PUBLIC LevenbergMarquardtOptimizer
+  : public Optimizer<LevenbergMarquardtOptimizer>
+{
+public:
+  using Optimizer<LevenbergMarquardtOptimizer>::solve;
+
+  /// Constructor to initialize the options
+  ///
+  /// @param[in]  options          Options to be used for this optimization.
+  /// @param[in]  damping_options  Options of the damping.
+  ///
+  explicit LevenbergMarquardtOptimizer(
+    const OptimizationOptions & options,
+    const LevenbergMarquardtOptions & damping_options = LevenbergMarquardtOptions{});
+
+  /// Solves `x_out` for an objective `optimization_problem` and an initial value `x0`, with a
+  /// workspace local to this call.
+  template<typename OptimizationProblemT, typename DomainValueT, typename EigenSolverT>
+  OptimizationSummary solve_(
+    OptimizationProblemT & optimization_problem,
+    const DomainValueT & x0, DomainValueT & x_out)
+  {
+    LevenbergMarquardtWorkspace<OptimizationProblemT, DomainValueT, EigenSolverT> workspace{};
+    return solve(optimization_problem, x0, x_out, workspace);
+  }
+
+  /// Solves `x_out` for an objective `optimization_problem` and an initial value `x0`
+  ///
+  /// @param      optimization_problem  optimization_problem optimization objective
+  /// @param      x0                    initial value
+  /// @param      x_out                 optimized value
+  /// @param      workspace             storage of the iterations, reused across solves
+  ///
+  /// @tparam     OptimizationProblemT  Optimization problem type. Must be an implementation of
+  ///                                   `common::optimization::OptimizationProblem`.
+  /// @tparam     DomainValueT          Type of the parameter
+  /// @tparam     EigenSolverT          Type of eigen solver to be used internally for solving the
+  ///                                   damped linear equations.
+  ///
+  /// @return     Summary of this optimization.
+  ///
+  template<typename OptimizationProblemT, typename DomainValueT, typename EigenSolverT>
+  OptimizationSummary solve(
+    OptimizationProblemT & optimization_problem,
+    const DomainValueT & x0, DomainValueT & x_out,
+    LevenbergMarquardtWorkspace<OptimizationProblemT, DomainValueT, EigenSolverT> & workspace)
+  {
+    TerminationType termination_type{TerminationType::NO_CONVERGENCE};
+    OptimizationStatistics statistics{};
+    statistics.start();
+    const auto make_summary = [&statistics](
+      float64_t dist, TerminationType type, uint64_t iter) {
+        statistics.stop();
+        return OptimizationSummary{dist, type, iter, statistics};
+      };
+
+    if (!x0.allFinite()) {   // Early exit for invalid input.
+      return make_summary(0.0, TerminationType::FAILURE, 0UL);
+    }
+
+    // Initialize
+    workspace.resize(x0.rows());
+    workspace.step.setZero();
+    x_out = x0;
+    optimization_problem.evaluate(x_out, ComputeMode{}.set_score().set_jacobian().set_hessian());
+    statistics.add_evaluation();
+    auto score = optimization_problem(x_out);
+    optimization_problem.jacobian(x_out, workspace.jacobian);
+    optimization_problem.hessian(x_out, workspace.hessian);
+    if (!std::isfinite(score) || !workspace.jacobian.allFinite() ||
+      !workspace.hessian.allFinite())
+    {
+      return make_summary(0.0, TerminationType::FAILURE, 0UL);
+    }
+
+    // Early exit if the initial solution is good enough.
+    if (workspace.jacobian.template lpNorm<Eigen::Infinity>() <= m_options.gradient_tolerance()) {
+      // As there's no step yet, jacobian can be a good substitute.
+      return make_summary(workspace.jacobian.norm(), TerminationType::CONVERGENCE, 0UL);
+    }
+
+    const auto max_diagonal = workspace.hessian.diagonal().cwiseAbs().maxCoeff();
+    auto damping = m_damping_options.initial_damping_factor() *
+      ((max_diagonal > 0.0) ? max_diagonal : 1.0);
+    auto damping_increase = 2.0;
+
+    // Iterate until convergence, error, or maximum number of iterations. A rejected step also
+    // counts as an iteration.
+    auto nr_iterations = 0UL;
+    for (; nr_iterations < m_options.max_num_iterations(); ++nr_iterations) {
+      statistics.start_iteration();
+      workspace.damped_hessian = workspace.hessian;
+      workspace.damped_hessian.diagonal().array() += damping;
+      workspace.solver.compute(workspace.damped_hessian);
+      workspace.step = workspace.solver.solve(-workspace.jacobian);
+
+      auto accepted = false;
+      if (workspace.step.allFinite()) {
+        // Check the step size relative to the parameter value, as in NewtonsMethodOptimizer
+        const auto parameter_tolerance =
+          m_options.parameter_tolerance() * (x_out.norm() + m_options.parameter_tolerance());
+        if (workspace.step.norm() <= parameter_tolerance) {
+          termination_type = TerminationType::CONVERGENCE;
+          break;
+        }
+
+        // Improvement predicted by the quadratic model, which must be positive for a descent
+        workspace.hessian_step.noalias() = workspace.hessian * workspace.step;
+        const auto predicted_improvement = -(workspace.jacobian.dot(workspace.step) +
+          0.5 * workspace.step.dot(workspace.hessian_step));
+
+        workspace.x_candidate = x_out + workspace.step;
+        optimization_problem.evaluate(workspace.x_candidate, ComputeMode{}.set_score());
+        statistics.add_evaluation();
+        const auto candidate_score = optimization_problem(workspace.x_candidate);
+        const auto improvement = score - candidate_score;
+        if ((predicted_improvement > 0.0) && (improvement > 0.0) && std::isfinite(improvement)) {
+          accepted = true;
+          x_out = workspace.x_candidate;
+          // Only the derivatives are missing, the score is already cached
+          optimization_problem.evaluate(x_out, ComputeMode{}.set_jacobian().set_hessian());
+          optimization_problem.jacobian(x_out, workspace.jacobian);
+          optimization_problem.hessian(x_out, workspace.hessian);
+          if (!workspace.jacobian.allFinite() || !workspace.hessian.allFinite()) {
+            termination_type = TerminationType::FAILURE;
+            break;
+          }
+
+          // Shrink the damping the better the model predicted the improvement
+          const auto gain_ratio = improvement / predicted_improvement;
+          damping *= std::max(1.0 / 3.0, 1.0 - std::pow(2.0 * gain_ratio - 1.0, 3.0));
+          damping_increase = 2.0;
+
+          // Check if the max-norm of the gradient is small enough.
+          if (workspace.jacobian.template lpNorm<Eigen::Infinity>() <=
+            m_options.gradient_tolerance())
+          {
+            termination_type = TerminationType::CONVERGENCE;
+            break;
+          }
+
+          // Check change in cost function, relative to its value and in absolute terms.
+          if ((improvement <= (m_options.function_tolerance() * std::fabs(score))) ||
+            (improvement <= m_options.absolute_function_tolerance()))
+          {
+            score = candidate_score;
+            termination_type = TerminationType::CONVERGENCE;
+            break;
+          }
+          score = candidate_score;
+        }
+      }
+
+      if (!accepted) {
+        // Grow the damping, i.e. shrink the trust region, faster with each rejection in a row
+        damping *= damping_increase;
+        damping_increase *= 2.0;
+        if (!(damping <= m_damping_options.max_damping())) {
+          // No step within any trust region improves the score anymore.
+          termination_type = TerminationType::CONVERGENCE;
+          break;
+        }
+      }
+    }
+
+    return make_summary(workspace.step.norm(), termination_type, nr_iterations);
+  }
+
+  /// Get the options used for the optimization.
+  const OptimizationOptions & options() const noexcept;
+
+  /// Set the options used for the following optimizations, e.g. to adapt the tolerances to the
+  /// size of the next problem.
+  void set_options(const OptimizationOptions & options) noexcept;
+
+  /// Get the options of the damping.
+  const LevenbergMarquardtOptions & damping_options() const noexcept;
+
+private:
+  OptimizationOptions m_options;
+  LevenbergMarquardtOptions m_damping_options;
+};
+}  // namespace optimization
+}  // namespace common
+}  // namespace autoware
+
+#endif  // OPTIMIZATION__LEVENBERG_MARQUARDT_OPTIMIZER_HPP_
@@ -78,9 +78,16 @@ public:
     Jacobian jacobian{Jacobian{}.setZero()};
     Hessian hessian{Hessian{}.setZero()};
     DomainValueT opt_direction{DomainValueT{}.setZero()};
+    OptimizationStatistics statistics{};
+    statistics.start();
+    const auto make_summary = [&statistics](
+      float64_t dist, TerminationType type, uint64_t iter) {
+        statistics.stop();
+        return OptimizationSummary{dist, type, iter, statistics};
+      };
 
     if (!x0.allFinite()) {   // Early exit for invalid input.
-      return OptimizationSummary{0.0, TerminationType::FAILURE, 0UL};
+      return make_summary(0.0, TerminationType::FAILURE, 0UL);
     }
 
     // Initialize
@@ -88,6 +95,7 @@ public:
 
     // Get score, Jacobian and Hessian (pre-computed using evaluate)
     optimization_problem.evaluate(x_out, ComputeMode{}.set_score().set_jacobian().set_hessian());
+    statistics.add_evaluation();
     score_previous = optimization_problem(x_out);
     optimization_problem.jacobian(x_out, jacobian);
     optimization_problem.hessian(x_out, hessian);
@@ -95,12 +103,13 @@ public:
     // Early exit if the initial solution is good enough.
     if (jacobian.template lpNorm<Eigen::Infinity>() <= m_options.gradient_tolerance()) {
       // As there's no newton solution yet, jacobian can be a good substitute.
-      return OptimizationSummary{jacobian.norm(), TerminationType::CONVERGENCE, 0UL};
+      return make_summary(jacobian.norm(), TerminationType::CONVERGENCE, 0UL);
     }
 
     // Iterate until convergence, error, or maximum number of iterations
     auto nr_iterations = 0UL;
     for (; nr_iterations < m_options.max_num_iterations(); ++nr_iterations) {
+      statistics.start_iteration();
       if (!x_out.allFinite() || !jacobian.allFinite() || !hessian.allFinite()) {
         termination_type = TerminationType::FAILURE;
         break;
@@ -139,6 +148,7 @@ public:
 
       // Update value, Jacobian and Hessian (pre-computed using evaluate)
       optimization_problem.evaluate(x_out, ComputeMode{}.set_score().set_jacobian().set_hessian());
+      statistics.add_evaluation();
       const auto score = optimization_problem(x_out);
       optimization_problem.jacobian(x_out, jacobian);
       optimization_problem.hessian(x_out, hessian);
@@ -149,9 +159,10 @@ public:
         break;
       }
 
-      // Check change in cost function.
-      if (std::fabs(score - score_previous) <=
-        (m_options.function_tolerance() * std::fabs(score_previous)))
+      // Check change in cost function, relative to its value and in absolute terms.
+      const auto score_change = std::fabs(score - score_previous);
+      if ((score_change <= (m_options.function_tolerance() * std::fabs(score_previous))) ||
+        (score_change <= m_options.absolute_function_tolerance()))
       {
         termination_type = TerminationType::CONVERGENCE;
         break;
@@ -161,7 +172,20 @@ public:
 
     // Returning summary consisting of the following three values:
     // estimated_distance_to_optimum, convergence_tolerance_criteria_met, number_of_iterations_made
-    return OptimizationSummary{opt_direction.norm(), termination_type, nr_iterations};
+    return make_summary(opt_direction.norm(), termination_type, nr_iterations);
+  }
+
+  /// Get the options used for the optimization.
+  const OptimizationOptions & options() const noexcept
+  {
+    return m_options;
+  }
+
+  /// Set the options used for the following optimizations, e.g. to adapt the tolerances to the
+  /// size of the next problem.
+  void set_options(const OptimizationOptions & options) noexcept
+  {
+    m_options = options;
   }
 
 private:
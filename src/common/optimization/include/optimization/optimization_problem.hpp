@@ -98,7 +98,10 @@ public:
 /// may be more efficient. This class implements the necessary boilerplate to manage the cache
 /// state book-keeping.
 /// This class implements `score_(..)`, `jacobian_(..)` and `hessian_(..)`; hence the
-/// implementation must only implement `evaluate_(..)`
+/// implementation must only implement `evaluate_(..)`. `evaluate_(..)` is only called with the
+/// terms which are not cached for the parameter yet, e.g. only the hessian after a line search
+/// evaluated the score and the jacobian at the accepted step. So it must only set the terms of
+/// the requested mode.
 /// \tparam Derived CRTP implementation class. This class should implement `evaluate_()`.
 /// \tparam DomainValueT Parameter type.
 /// \tparam NumJacobianColsT Number of columns in the jacobian matrix.
@@ -144,7 +147,7 @@ public:
 
   void hessian_(const DomainValue & x, HessianRef out)
   {
-    if (!m_cache_state.is_cached(x, common::optimization::ExpressionTerm::SCORE)) {
+    if (!m_cache_state.is_cached(x, common::optimization::ExpressionTerm::HESSIAN)) {
       evaluate(x, ComputeMode{}.set_hessian());
     }
     out = m_hessian;
@@ -152,12 +155,15 @@ public:
 
   void evaluate(const DomainValue & x, const ComputeMode & mode)
   {
-    if (!mode.score() && !mode.jacobian() && !mode.hessian()) {
+    // Only compute the terms which are not cached for this parameter yet.
+    const auto uncached_mode = m_cache_state.uncached(x, mode);
+    if (!uncached_mode.score() && !uncached_mode.jacobian() && !uncached_mode.hessian()) {
       return;
     }
-    m_cache_state.update(x, mode);
     // Call the implementation method.
-    static_cast<Derived *>(this)->evaluate_(x, mode);
+    static_cast<Derived *>(this)->evaluate_(x, uncached_mode);
+    // Only marked as cached once computed, so that a throwing evaluation is not cached.
+    m_cache_state.update(x, uncached_mode);
   }
 
 protected:
@@ -19,9 +19,11 @@
 
 #include <common/types.hpp>
 #include <optimization/visibility_control.hpp>
+#include <chrono>
 #include <limits>
 #include <cstdint>
 
+using autoware::common::types::bool8_t;
 using autoware::common::types::float64_t;
 
 namespace autoware
@@ -51,11 +53,13 @@ public:
   /// \param function_tolerance minimum relative change in the cost function.
   /// \param parameter_tolerance minimum step size relative to the parameter's norm.
   /// \param gradient_tolerance minimum absolute change in the gradient.
+  /// \param absolute_function_tolerance minimum absolute change in the cost function, e.g. scaled
+  /// by the number of terms of the cost function to stop once the improvement per term is small.
   /// \throws std::domain_error on negative or NaN tolerance values.
   OptimizationOptions(
     uint64_t max_num_iterations = std::numeric_limits<int64_t>::max(),
     float64_t function_tolerance = 0.0, float64_t parameter_tolerance = 0.0,
-    float64_t gradient_tolerance = 0.0);
+    float64_t gradient_tolerance = 0.0, float64_t absolute_function_tolerance = 0.0);
 
   /// Get maximum number of iterations
   uint64_t max_num_iterations() const noexcept;
@@ -65,12 +69,57 @@ public:
   float64_t parameter_tolerance() const noexcept;
   /// Get minimum relative change in the gradient
   float64_t gradient_tolerance() const noexcept;
+  /// Get minimum absolute change in the cost function
+  float64_t absolute_function_tolerance() const noexcept;
 
 private:
   uint64_t m_max_num_iterations;
   float64_t m_function_tolerance;
   float64_t m_parameter_tolerance;
   float64_t m_gradient_tolerance;
+  float64_t m_absolute_function_tolerance;
+};
+
+// Evaluation counters and iteration timing of a single solve, collected by the optimizers.
+class OPTIMIZATION_PUBLIC OptimizationStatistics
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Reset the counters and start timing the solve.
+  void start() noexcept;
+  /// Finish timing the current iteration, if any, and start timing the next one.
+  void start_iteration() noexcept;
+  /// Count an evaluation of the optimization problem at a new parameter value.
+  void add_evaluation() noexcept;
+  /// Finish timing the current iteration, if any, and the solve.
+  void stop() noexcept;
+
+  /// Get the number of parameter values the optimizer evaluated the problem at. Evaluations made
+  /// internally by a line search are not counted.
+  uint64_t number_of_evaluations() const noexcept;
+  /// Get the number of timed iterations.
+  uint64_t number_of_timed_iterations() const noexcept;
+  /// Get the duration of the whole solve, including the evaluation at the initial value.
+  std::chrono::nanoseconds total_duration() const noexcept;
+  /// Get the summed duration of all iterations.
+  std::chrono::nanoseconds total_iteration_duration() const noexcept;
+  /// Get the duration of the slowest iteration.
+  std::chrono::nanoseconds max_iteration_duration() const noexcept;
+  /// Get the mean duration of an iteration, zero if no iteration was made.
+  std::chrono::nanoseconds mean_iteration_duration() const noexcept;
+
+private:
+  void finish_iteration(const Clock::time_point now) noexcept;
+
+  Clock::time_point m_start{};
+  Clock::time_point m_iteration_start{};
+  bool8_t m_iteration_running{false};
+  uint64_t m_number_of_evaluations{0U};
+  uint64_t m_number_of_timed_iterations{0U};
+  std::chrono::nanoseconds m_total_duration{0};
+  std::chrono::nanoseconds m_total_iteration_duration{0};
+  std::chrono::nanoseconds m_max_iteration_duration{0};
 };
 
 // Optimization summary class.
@@ -81,7 +130,10 @@ public:
   /// \param dist estimated distance to the optimum
   /// \param termination_type Type of termination. Check the enum definition for possible outcomes.
   /// \param iter number of iterations that were made
-  OptimizationSummary(float64_t dist, TerminationType termination_type, uint64_t iter);
+  /// \param statistics evaluation counters and iteration timing of the solve
+  OptimizationSummary(
+    float64_t dist, TerminationType termination_type, uint64_t iter,
+    const OptimizationStatistics & statistics = OptimizationStatistics{});
 
   /// Get the estimated distance to the optimum
   float64_t estimated_distance_to_optimum() const noexcept;
@@ -89,11 +141,14 @@ public:
   TerminationType termination_type() const noexcept;
   /// Get the number of iterations that were made
   uint64_t number_of_iterations_made() const noexcept;
+  /// Get the evaluation counters and iteration timing of the solve
+  const OptimizationStatistics & statistics() const noexcept;
 
 private:
   float64_t m_estimated_distance_to_optimum;
   uint64_t m_number_of_iterations_made;
   TerminationType m_termination_type;
+  OptimizationStatistics m_statistics;
 };
 
 }  // namespace optimization
@@ -125,15 +125,35 @@ public:
   {
   }
 
-  /// Update the state with the given parameter and the computation mode/
+  /// Update the state with the given parameter and the computation mode. If the parameter is
+  /// the same as the last one, the terms of the mode are added to the cached ones.
   /// \param value Parameter value used in computation
   /// \param mode Computation mode
   void update(const DomainValue & value, const ComputeMode & mode) noexcept
   {
-    m_last_mode = mode;
+    if (m_comparator(value, m_last_value)) {
+      m_last_mode = ComputeMode{
+        m_last_mode.score() || mode.score(),
+        m_last_mode.jacobian() || mode.jacobian(),
+        m_last_mode.hessian() || mode.hessian()};
+    } else {
+      m_last_mode = mode;
+    }
     m_last_value = value;
   }
 
+  /// Get the terms of a computation mode which are not cached for a given parameter.
+  /// \param x Parameter value
+  /// \param mode Computation mode
+  /// \return Computation mode of the terms that still need to be computed.
+  ComputeMode uncached(const DomainValue & x, const ComputeMode & mode) const noexcept
+  {
+    return ComputeMode{
+      mode.score() && !is_cached(x, ExpressionTerm::SCORE),
+      mode.jacobian() && !is_cached(x, ExpressionTerm::JACOBIAN),
+      mode.hessian() && !is_cached(x, ExpressionTerm::HESSIAN)};
+  }
+
   /// Check if the term is already evaluated and cached for a given parameter
   /// \param x Parameter value
   /// \param term Expression term to query the cache status. Can be one of the following:
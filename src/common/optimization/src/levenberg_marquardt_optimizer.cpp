@@ -0,0 +1,72 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "optimization/levenberg_marquardt_optimizer.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace autoware
+{
+namespace common
+{
+namespace optimization
+{
+LevenbergMarquardtOptions::LevenbergMarquardtOptions(
+  float64_t initial_damping_factor,
+  float64_t max_damping)
+: m_initial_damping_factor(initial_damping_factor), m_max_damping(max_damping)
+{
+  if (!std::isfinite(m_initial_damping_factor) || !std::isfinite(m_max_damping) ||
+    (m_initial_damping_factor <= 0.0) || (m_max_damping <= 0.0))
+  {
+    throw std::domain_error(
+            "LevenbergMarquardtOptions: Damping values must be positive and finite.");
+  }
+  if (m_initial_damping_factor > m_max_damping) {
+    throw std::domain_error(
+            "LevenbergMarquardtOptions: "
+            "The initial damping factor must not exceed the maximum damping.");
+  }
+}
+
+float64_t LevenbergMarquardtOptions::initial_damping_factor() const noexcept
+{
+  return m_initial_damping_factor;
+}
+float64_t LevenbergMarquardtOptions::max_damping() const noexcept
+{
+  return m_max_damping;
+}
+
+LevenbergMarquardtOptimizer::LevenbergMarquardtOptimizer(
+  const OptimizationOptions & options,
+  const LevenbergMarquardtOptions & damping_options)
+: m_options{options}, m_damping_options{damping_options} {}
+
+const OptimizationOptions & LevenbergMarquardtOptimizer::options() const noexcept
+{
+  return m_options;
+}
+void LevenbergMarquardtOptimizer::set_options(const OptimizationOptions & options) noexcept
+{
+  m_options = options;
+}
+const LevenbergMarquardtOptions & LevenbergMarquardtOptimizer::damping_options() const noexcept
+{
+  return m_damping_options;
+}
+}  // namespace optimization
+}  // namespace common
+}  // namespace autoware
@@ -16,6 +16,7 @@
 
 #include <common/types.hpp>
 #include <optimization/optimizer_options.hpp>
+#include <algorithm>
 #include <stdexcept>
 #include <cmath>
 
@@ -31,21 +32,25 @@ OptimizationOptions::OptimizationOptions(
   uint64_t max_num_iterations,
   float64_t function_tolerance,
   float64_t parameter_tolerance,
-  float64_t gradient_tolerance)
+  float64_t gradient_tolerance,
+  float64_t absolute_function_tolerance)
 : m_max_num_iterations(max_num_iterations),
   m_function_tolerance(function_tolerance), m_parameter_tolerance(parameter_tolerance),
-  m_gradient_tolerance(gradient_tolerance)
+  m_gradient_tolerance(gradient_tolerance),
+  m_absolute_function_tolerance(absolute_function_tolerance)
 {
   if (!std::isfinite(m_function_tolerance) ||
     !std::isfinite(m_parameter_tolerance) ||
-    !std::isfinite(m_gradient_tolerance))
+    !std::isfinite(m_gradient_tolerance) ||
+    !std::isfinite(m_absolute_function_tolerance))
   {
     throw std::domain_error("OptimizationOptions: Tolerance values must be finite.");
   }
 
   if ((m_function_tolerance <= 0.0) &&
     (m_parameter_tolerance <= 0.0) &&
-    (m_gradient_tolerance <= 0.0))
+    (m_gradient_tolerance <= 0.0) &&
+    (m_absolute_function_tolerance <= 0.0))
   {
     throw std::domain_error(
             "OptimizationOptions: "
@@ -70,13 +75,82 @@ float64_t OptimizationOptions::gradient_tolerance() const noexcept
 {
   return m_gradient_tolerance;
 }
+float64_t OptimizationOptions::absolute_function_tolerance() const noexcept
+{
+  return m_absolute_function_tolerance;
+}
+
+void OptimizationStatistics::start() noexcept
+{
+  *this = OptimizationStatistics{};
+  m_start = Clock::now();
+}
+void OptimizationStatistics::start_iteration() noexcept
+{
+  const auto now = Clock::now();
+  finish_iteration(now);
+  m_iteration_start = now;
+  m_iteration_running = true;
+}
+void OptimizationStatistics::add_evaluation() noexcept
+{
+  ++m_number_of_evaluations;
+}
+void OptimizationStatistics::stop() noexcept
+{
+  const auto now = Clock::now();
+  finish_iteration(now);
+  m_total_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_start);
+}
+void OptimizationStatistics::finish_iteration(const Clock::time_point now) noexcept
+{
+  if (!m_iteration_running) {
+    return;
+  }
+  const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    now - m_iteration_start);
+  m_total_iteration_duration += duration;
+  m_max_iteration_duration = std::max(m_max_iteration_duration, duration);
+  ++m_number_of_timed_iterations;
+  m_iteration_running = false;
+}
+
+uint64_t OptimizationStatistics::number_of_evaluations() const noexcept
+{
+  return m_number_of_evaluations;
+}
+uint64_t OptimizationStatistics::number_of_timed_iterations() const noexcept
+{
+  return m_number_of_timed_iterations;
+}
+std::chrono::nanoseconds OptimizationStatistics::total_duration() const noexcept
+{
+  return m_total_duration;
+}
+std::chrono::nanoseconds OptimizationStatistics::total_iteration_duration() const noexcept
+{
+  return m_total_iteration_duration;
+}
+std::chrono::nanoseconds OptimizationStatistics::max_iteration_duration() const noexcept
+{
+  return m_max_iteration_duration;
+}
+std::chrono::nanoseconds OptimizationStatistics::mean_iteration_duration() const noexcept
+{
+  if (m_number_of_timed_iterations == 0U) {
+    return std::chrono::nanoseconds{0};
+  }
+  return m_total_iteration_duration /
+         static_cast<std::chrono::nanoseconds::rep>(m_number_of_timed_iterations);
+}
 
 OptimizationSummary::OptimizationSummary(
   float64_t dist, TerminationType termination_type,
-  uint64_t iter)
+  uint64_t iter, const OptimizationStatistics & statistics)
 : m_estimated_distance_to_optimum(dist),
   m_number_of_iterations_made(iter),
-  m_termination_type(termination_type)
+  m_termination_type(termination_type),
+  m_statistics(statistics)
 {}
 
 float64_t OptimizationSummary::estimated_distance_to_optimum() const noexcept
@@ -91,6 +165,10 @@ uint64_t OptimizationSummary::number_of_iterations_made() const noexcept
 {
   return m_number_of_iterations_made;
 }
+const OptimizationStatistics & OptimizationSummary::statistics() const noexcept
+{
+  return m_statistics;
+}
 }  // namespace optimization
 }  // namespace common
 }  // namespace autoware
@@ -16,6 +16,7 @@
 
 #include <common/types.hpp>
 #include <gtest/gtest.h>
+#include <optimization/optimization_problem.hpp>
 #include <optimization/utils.hpp>
 #include <Eigen/Core>
 #include <vector>
@@ -52,6 +53,77 @@ TEST_F(CacheStateMachineTest, NumericTest) {
   }
 }
 
+TEST_F(CacheStateMachineTest, MergeModes) {
+  CacheStateMachine<int32_t> csm{};
+  csm.update(1, ComputeMode{}.set_score().set_jacobian());
+  // Terms computed for the same parameter add up
+  csm.update(1, ComputeMode{}.set_hessian());
+  EXPECT_TRUE(csm.is_cached(1, ExpressionTerm::SCORE));
+  EXPECT_TRUE(csm.is_cached(1, ExpressionTerm::JACOBIAN));
+  EXPECT_TRUE(csm.is_cached(1, ExpressionTerm::HESSIAN));
+  EXPECT_EQ(
+    csm.uncached(1, ComputeMode{}.set_score().set_jacobian().set_hessian()), ComputeMode{});
+  // A new parameter replaces them
+  csm.update(2, ComputeMode{}.set_jacobian());
+  EXPECT_FALSE(csm.is_cached(1, ExpressionTerm::JACOBIAN));
+  EXPECT_EQ(
+    csm.uncached(2, ComputeMode{}.set_score().set_jacobian().set_hessian()),
+    ComputeMode{}.set_score().set_hessian());
+}
+
+/// Expression counting the evaluations of each term.
+class CountingExpression
+  : public CachedExpression<CountingExpression, Eigen::Matrix<float64_t, 1, 1>, 1, 1,
+    EigenComparator>
+{
+public:
+  void evaluate_(const DomainValue & x, const ComputeMode & mode)
+  {
+    if (mode.score()) {
+      ++m_num_scores;
+      set_score(x(0U) * x(0U));
+    }
+    if (mode.jacobian()) {
+      ++m_num_jacobians;
+      Jacobian jacobian{2.0 * x(0U)};
+      set_jacobian(jacobian);
+    }
+    if (mode.hessian()) {
+      ++m_num_hessians;
+      Hessian hessian{2.0};
+      set_hessian(hessian);
+    }
+  }
+
+  int32_t m_num_scores{0};
+  int32_t m_num_jacobians{0};
+  int32_t m_num_hessians{0};
+};
+
+TEST(CachedExpressionTest, OnlyUncachedTermsAreEvaluated) {
+  CountingExpression expression;
+  const CountingExpression::DomainValue x{3.0};
+  CountingExpression::Jacobian jacobian;
+  CountingExpression::Hessian hessian;
+  // e.g. a line search trial followed by the newton step at the accepted trial
+  expression.evaluate(x, ComputeMode{}.set_score().set_jacobian());
+  expression.evaluate(x, ComputeMode{}.set_score().set_jacobian().set_hessian());
+  EXPECT_DOUBLE_EQ(expression(x), 9.0);
+  expression.jacobian(x, jacobian);
+  expression.hessian(x, hessian);
+  EXPECT_DOUBLE_EQ(jacobian(0U), 6.0);
+  EXPECT_DOUBLE_EQ(hessian(0U), 2.0);
+  EXPECT_EQ(expression.m_num_scores, 1);
+  EXPECT_EQ(expression.m_num_jacobians, 1);
+  EXPECT_EQ(expression.m_num_hessians, 1);
+
+  // A score does not make the hessian of a new parameter cached
+  const CountingExpression::DomainValue y{4.0};
+  EXPECT_DOUBLE_EQ(expression(y), 16.0);
+  expression.hessian(y, hessian);
+  EXPECT_EQ(expression.m_num_scores, 2);
+  EXPECT_EQ(expression.m_num_hessians, 2);
+}
 
 }  // namespace optimization
 }  // namespace common
@@ -0,0 +1,179 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test_newton_optimization.hpp"
+
+#include <optimization/levenberg_marquardt_optimizer.hpp>
+
+#include <common/types.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+
+using autoware::common::types::float64_t;
+using autoware::common::optimization::Expression;
+using autoware::common::optimization::LevenbergMarquardtOptimizer;
+using autoware::common::optimization::LevenbergMarquardtOptions;
+using autoware::common::optimization::LevenbergMarquardtWorkspace;
+using autoware::common::optimization::OptimizationOptions;
+using autoware::common::optimization::Polynomial1DOptimizationProblem;
+using autoware::common::optimization::TerminationType;
+using autoware::common::optimization::UnconstrainedOptimizationProblem;
+using autoware::common::optimization::Vector1D;
+
+namespace
+{
+using Vector2D = Eigen::Matrix<float64_t, 2U, 1U>;
+
+/// `f(x, y) = (1 - x)^2 + 100 * (y - x^2)^2`, with an indefinite hessian away from the valley
+/// and a global minimum at (1, 1).
+class RosenbrockObjective : public Expression<RosenbrockObjective, Vector2D, 1U, 2U>
+{
+public:
+  Value score_(const DomainValue & x)
+  {
+    return std::pow(1.0 - x(0), 2) + 100.0 * std::pow(x(1) - x(0) * x(0), 2);
+  }
+
+  void jacobian_(const DomainValue & x, JacobianRef out)
+  {
+    out(0) = -2.0 * (1.0 - x(0)) - 400.0 * x(0) * (x(1) - x(0) * x(0));
+    out(1) = 200.0 * (x(1) - x(0) * x(0));
+  }
+
+  void hessian_(const DomainValue & x, HessianRef out)
+  {
+    out(0, 0) = 2.0 - 400.0 * x(1) + 1200.0 * x(0) * x(0);
+    out(0, 1) = -400.0 * x(0);
+    out(1, 0) = -400.0 * x(0);
+    out(1, 1) = 200.0;
+  }
+};
+using RosenbrockProblem = UnconstrainedOptimizationProblem<RosenbrockObjective, Vector2D, 2U>;
+
+/// `f(x) = cos(x)`, whose hessian is negative around the maximum at 0.
+class CosineObjective : public Expression<CosineObjective, Vector1D, 1U, 1U>
+{
+public:
+  Value score_(const DomainValue & x)
+  {
+    return std::cos(x(0));
+  }
+
+  void jacobian_(const DomainValue & x, JacobianRef out)
+  {
+    out(0) = -std::sin(x(0));
+  }
+
+  void hessian_(const DomainValue & x, HessianRef out)
+  {
+    out(0, 0) = -std::cos(x(0));
+  }
+};
+using CosineProblem = UnconstrainedOptimizationProblem<CosineObjective, Vector1D, 1U>;
+}  // namespace
+
+TEST(LevenbergMarquardtOptimizationTest, ConvexPolynomial) {
+  Polynomial1DOptimizationProblem problem{1.0, 2, 1.0};  // (x+1)^2+1
+  const Vector1D x0{3.0};
+  Vector1D x_out;
+  LevenbergMarquardtOptimizer optimizer{OptimizationOptions(30, 0.0, 0.0, 1e-6)};
+  const auto summary = optimizer.solve(problem, x0, x_out);
+  EXPECT_EQ(summary.termination_type(), TerminationType::CONVERGENCE);
+  EXPECT_NEAR(x_out(0, 0), -1.0, 1e-6);
+  // An almost undamped step lands close to the minimum of a quadratic at once
+  EXPECT_LE(summary.number_of_iterations_made(), 2U);
+}
+
+TEST(LevenbergMarquardtOptimizationTest, Rosenbrock) {
+  RosenbrockProblem problem{RosenbrockObjective{}, std::tuple<>{}, std::tuple<>{}};
+  const Vector2D x0{-1.2, 1.0};
+  Vector2D x_out;
+  LevenbergMarquardtOptimizer optimizer{OptimizationOptions(100, 0.0, 1e-12, 1e-8)};
+  const auto summary = optimizer.solve(problem, x0, x_out);
+  EXPECT_EQ(summary.termination_type(), TerminationType::CONVERGENCE);
+  EXPECT_NEAR(x_out(0), 1.0, 1e-6);
+  EXPECT_NEAR(x_out(1), 1.0, 1e-6);
+
+  // Every iteration evaluates at most one candidate, besides the initial evaluation
+  const auto & statistics = summary.statistics();
+  EXPECT_LE(statistics.number_of_evaluations(), summary.number_of_iterations_made() + 2U);
+  EXPECT_GT(statistics.number_of_evaluations(), 1U);
+  EXPECT_EQ(statistics.number_of_timed_iterations(), summary.number_of_iterations_made() + 1U);
+  EXPECT_LE(statistics.max_iteration_duration(), statistics.total_iteration_duration());
+  EXPECT_LE(statistics.total_iteration_duration(), statistics.total_duration());
+  EXPECT_LE(statistics.mean_iteration_duration(), statistics.max_iteration_duration());
+}
+
+TEST(LevenbergMarquardtOptimizationTest, NegativeCurvature) {
+  // A newton step heads for the maximum at 0, the damping turns it into a descent.
+  const Vector1D x0{0.1};
+  Vector1D x_out;
+  CosineProblem problem{CosineObjective{}, std::tuple<>{}, std::tuple<>{}};
+  LevenbergMarquardtOptimizer optimizer{OptimizationOptions(50, 0.0, 0.0, 1e-8)};
+  const auto summary = optimizer.solve(problem, x0, x_out);
+  EXPECT_EQ(summary.termination_type(), TerminationType::CONVERGENCE);
+  EXPECT_NEAR(x_out(0), M_PI, 1e-6);
+}
+
+TEST(LevenbergMarquardtOptimizationTest, ReusedWorkspace) {
+  RosenbrockProblem problem{RosenbrockObjective{}, std::tuple<>{}, std::tuple<>{}};
+  LevenbergMarquardtOptimizer optimizer{OptimizationOptions(100, 0.0, 0.0, 1e-8)};
+  LevenbergMarquardtWorkspace<RosenbrockProblem, Vector2D> workspace{};
+  Vector2D x_local;
+  Vector2D x_reused;
+  for (const auto & x0 : {Vector2D{-1.2, 1.0}, Vector2D{2.0, -1.0}, Vector2D{-1.2, 1.0}}) {
+    const auto local_summary = optimizer.solve(problem, x0, x_local);
+    const auto reused_summary = optimizer.solve(problem, x0, x_reused, workspace);
+    EXPECT_EQ(local_summary.termination_type(), reused_summary.termination_type());
+    EXPECT_EQ(
+      local_summary.number_of_iterations_made(), reused_summary.number_of_iterations_made());
+    EXPECT_EQ(x_local, x_reused);
+  }
+}
+
+TEST(LevenbergMarquardtOptimizationTest, Termination) {
+  Polynomial1DOptimizationProblem problem{1.0, 2, 1.0};  // (x+1)^2+1
+  Vector1D x_out;
+  // Converged at the initial value
+  LevenbergMarquardtOptimizer optimizer{OptimizationOptions(30, 0.0, 0.0, 1e-4)};
+  auto summary = optimizer.solve(problem, Vector1D{-1.0}, x_out);
+  EXPECT_EQ(summary.termination_type(), TerminationType::CONVERGENCE);
+  EXPECT_EQ(summary.number_of_iterations_made(), 0U);
+  EXPECT_EQ(summary.statistics().number_of_evaluations(), 1U);
+
+  // Not enough iterations
+  optimizer.set_options(OptimizationOptions(1, 0.0, 0.0, 1e-12));
+  EXPECT_EQ(optimizer.options().max_num_iterations(), 1U);
+  summary = optimizer.solve(problem, Vector1D{100.0}, x_out);
+  EXPECT_EQ(summary.termination_type(), TerminationType::NO_CONVERGENCE);
+  EXPECT_EQ(summary.number_of_iterations_made(), 1U);
+
+  // Invalid input
+  summary = optimizer.solve(problem, Vector1D{std::numeric_limits<float64_t>::quiet_NaN()}, x_out);
+  EXPECT_EQ(summary.termination_type(), TerminationType::FAILURE);
+  summary = optimizer.solve(problem, Vector1D{std::numeric_limits<float64_t>::max()}, x_out);
+  EXPECT_EQ(summary.termination_type(), TerminationType::FAILURE);
+}
+
+TEST(LevenbergMarquardtOptimizationTest, DampingOptions) {
+  const LevenbergMarquardtOptions options{1e-3, 1e10};
+  EXPECT_DOUBLE_EQ(options.initial_damping_factor(), 1e-3);
+  EXPECT_DOUBLE_EQ(options.max_damping(), 1e10);
+  EXPECT_THROW(LevenbergMarquardtOptions(0.0), std::domain_error);
+  EXPECT_THROW(LevenbergMarquardtOptions(1e-3, -1.0), std::domain_error);
+  EXPECT_THROW(LevenbergMarquardtOptions(1e-3, 1e-4), std::domain_error);
+  EXPECT_THROW(
+    LevenbergMarquardtOptions(std::numeric_limits<float64_t>::infinity()), std::domain_error);
+}
@@ -200,6 +200,57 @@ INSTANTIATE_TEST_CASE_P(
   ),
 );
 
+TEST(NewtonOptimizationTest, AbsoluteFunctionTolerance) {
+  Polynomial1DOptimizationProblem problem{1.0, 2, 1.0};  // (x+1)^2+1
+  const Vector1D x0{3.0};
+  Vector1D x_out;
+  NewtonsMethodOptimizer<FixedLineSearch> gradient_optimizer{
+    FixedLineSearch(0.2), OptimizationOptions(30, 0.0, 0.0, 1e-4)};
+  const auto gradient_summary = gradient_optimizer.solve(problem, x0, x_out);
+  ASSERT_EQ(gradient_summary.termination_type(), TerminationType::CONVERGENCE);
+
+  // Stopping once the score improves by less than 0.5 per iteration saves iterations
+  NewtonsMethodOptimizer<FixedLineSearch> absolute_optimizer{
+    FixedLineSearch(0.2), OptimizationOptions(30, 0.0, 0.0, 1e-4, 0.5)};
+  EXPECT_DOUBLE_EQ(absolute_optimizer.options().absolute_function_tolerance(), 0.5);
+  const auto absolute_summary = absolute_optimizer.solve(problem, x0, x_out);
+  EXPECT_EQ(absolute_summary.termination_type(), TerminationType::CONVERGENCE);
+  EXPECT_LT(
+    absolute_summary.number_of_iterations_made(),
+    gradient_summary.number_of_iterations_made());
+  EXPECT_GT(x_out(0, 0), -1.0);
+
+  absolute_optimizer.set_options(OptimizationOptions(30, 0.0, 0.0, 1e-4));
+  const auto reset_summary = absolute_optimizer.solve(problem, x0, x_out);
+  EXPECT_EQ(
+    reset_summary.number_of_iterations_made(), gradient_summary.number_of_iterations_made());
+
+  EXPECT_NO_THROW(OptimizationOptions(30, 0.0, 0.0, 0.0, 0.5));
+  EXPECT_THROW(
+    OptimizationOptions(30, 0.0, 0.0, 0.0, std::numeric_limits<float64_t>::quiet_NaN()),
+    std::domain_error);
+}
+
+TEST(NewtonOptimizationTest, Statistics) {
+  Polynomial1DOptimizationProblem problem{1.0, 2, 1.0};  // (x+1)^2+1
+  Vector1D x_out;
+  NewtonsMethodOptimizer<FixedLineSearch> optimizer{
+    FixedLineSearch(0.2), OptimizationOptions(30, 0.0, 0.0, 1e-4)};
+  const auto summary = optimizer.solve(problem, Vector1D{3.0}, x_out);
+  ASSERT_EQ(summary.termination_type(), TerminationType::CONVERGENCE);
+  const auto & statistics = summary.statistics();
+  // The initial value and the value after every iteration are evaluated
+  EXPECT_EQ(statistics.number_of_evaluations(), summary.number_of_iterations_made() + 2U);
+  EXPECT_EQ(statistics.number_of_timed_iterations(), summary.number_of_iterations_made() + 1U);
+  EXPECT_LE(statistics.max_iteration_duration(), statistics.total_iteration_duration());
+  EXPECT_LE(statistics.total_iteration_duration(), statistics.total_duration());
+
+  const auto failure = optimizer.solve(
+    problem, Vector1D{std::numeric_limits<float64_t>::quiet_NaN()}, x_out);
+  EXPECT_EQ(failure.statistics().number_of_evaluations(), 0U);
+  EXPECT_EQ(failure.statistics().number_of_timed_iterations(), 0U);
+}
+
 TEST(TestFixedLineSearch, FixedLineSearchValidation) {
   // set up varaibles
   constexpr auto step = 0.01F;
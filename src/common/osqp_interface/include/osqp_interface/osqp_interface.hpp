@@ -48,8 +48,11 @@ private:
   OSQPWorkspace * m_work = nullptr;
   std::unique_ptr<OSQPSettings> m_settings;
   std::unique_ptr<OSQPData> m_data;
-  // store last work info since work is cleaned up at every execution to prevent memory leak.
+  // store last work info since the work is replaced when the problem structure changes.
   OSQPInfo m_latest_work_info;
+  // Sparsity patterns of the P and A matrices of the current work
+  CSC_Matrix m_P_csc;
+  CSC_Matrix m_A_csc;
   // Number of parameters to optimize
   int64_t m_param_n;
   // Flag to check if the current work exists
@@ -129,6 +132,22 @@ public:
     const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<float64_t> & q,
     const std::vector<float64_t> & l, const std::vector<float64_t> & u);
 
+  /// \brief Updates the values of the stored problem, keeping the workspace when possible.
+  /// \details If the dimensions and the sparsity patterns of P and A are the same as the ones of
+  /// \details the current workspace, only the values are copied into it. This skips the setup of
+  /// \details the workspace and the symbolic factorization of the KKT matrix, and the next
+  /// \details optimization is warm started from the previous primal and dual solution. Otherwise,
+  /// \details the problem is set up again as with initializeProblem().
+  /// \param P (n,n) matrix defining relations between parameters.
+  /// \param A (m,n) matrix defining parameter constraints relative to the lower and upper bound.
+  /// \param q (n) vector defining the linear cost of the problem.
+  /// \param l (m) vector defining the lower bound problem constraint.
+  /// \param u (m) vector defining the upper bound problem constraint.
+  /// \return The exit flag of the update (0 on success).
+  int64_t updateProblem(
+    const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<float64_t> & q,
+    const std::vector<float64_t> & l, const std::vector<float64_t> & u);
+
   /// \brief Get the number of iteration taken to solve the problem
   inline int64_t getTakenIter() const {return static_cast<int64_t>(m_latest_work_info.iter);}
   /// \brief Get the status message for the latest problem solved
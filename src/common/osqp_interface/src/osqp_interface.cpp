@@ -18,6 +18,7 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "osqp/osqp.h"
@@ -100,10 +101,43 @@ int64_t OSQPInterface::initializeProblem(
   m_data->l = l_dyn;
   m_data->u = u_dyn;
 
-  // Setup workspace
+  // Setup workspace, replacing the previous one
+  if (m_work) {
+    osqp_cleanup(m_work);
+    m_work = nullptr;
+  }
   m_exitflag = osqp_setup(&m_work, m_data.get(), m_settings.get());
   m_work_initialized = true;
+  m_P_csc = std::move(P_csc);
+  m_A_csc = std::move(A_csc);
+
+  return m_exitflag;
+}
 
+int64_t OSQPInterface::updateProblem(
+  const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<float64_t> & q,
+  const std::vector<float64_t> & l, const std::vector<float64_t> & u)
+{
+  CSC_Matrix P_csc = calCSCMatrixTrapezoidal(P);
+  CSC_Matrix A_csc = calCSCMatrix(A);
+  const bool8_t same_structure = m_work_initialized && (m_exitflag == 0) &&
+    (m_data->n == P.rows()) && (m_data->m == A.rows()) &&
+    (P_csc.m_row_idxs == m_P_csc.m_row_idxs) && (P_csc.m_col_idxs == m_P_csc.m_col_idxs) &&
+    (A_csc.m_row_idxs == m_A_csc.m_row_idxs) && (A_csc.m_col_idxs == m_A_csc.m_col_idxs);
+  if (!same_structure) {
+    return initializeProblem(P, A, q, l, u);
+  }
+
+  // Update all the values of the workspace, its iterates are kept for the warm start
+  m_exitflag = osqp_update_P_A(
+    m_work, P_csc.m_vals.data(), OSQP_NULL, static_cast<c_int>(P_csc.m_vals.size()),
+    A_csc.m_vals.data(), OSQP_NULL, static_cast<c_int>(A_csc.m_vals.size()));
+  if (m_exitflag == 0) {
+    m_exitflag = osqp_update_lin_cost(m_work, q.data());
+  }
+  if (m_exitflag == 0) {
+    m_exitflag = osqp_update_bounds(m_work, l.data(), u.data());
+  }
   return m_exitflag;
 }
 
@@ -88,4 +88,46 @@ TEST(TestOsqpInterface, BasicQp) {
     check_result(result);
   }
 }
+
+TEST(TestOsqpInterface, UpdateProblem) {
+  Eigen::MatrixXd P(2, 2);
+  P << 4, 1, 1, 2;
+  Eigen::MatrixXd A(2, 4);
+  A << 1, 1, 1, 0, 0, 1, 0, 1;
+  std::vector<float64_t> q = {1.0, 1.0};
+  std::vector<float64_t> l = {1.0, 0.0, 0.0, -autoware::common::osqp::INF};
+  std::vector<float64_t> u = {1.0, 0.7, 0.7, autoware::common::osqp::INF};
+  autoware::common::osqp::OSQPInterface osqp(1e-6);
+  // The first update sets up the workspace
+  EXPECT_EQ(osqp.updateProblem(P, A, q, l, u), 0);
+  auto result = osqp.optimize();
+  EXPECT_EQ(std::get<3>(result), 1);
+  EXPECT_NEAR(std::get<0>(result)[0], 0.3, 1e-6);
+  EXPECT_NEAR(std::get<0>(result)[1], 0.7, 1e-6);
+
+  // Same structure, new values: the warm started solution matches a fresh solver
+  P << 6, 1, 1, 2;
+  q = {-1.0, 2.0};
+  u = {1.0, 0.9, 0.9, autoware::common::osqp::INF};
+  EXPECT_EQ(osqp.updateProblem(P, A, q, l, u), 0);
+  result = osqp.optimize();
+  autoware::common::osqp::OSQPInterface fresh(1e-6);
+  const auto expected = fresh.optimize(P, A, q, l, u);
+  EXPECT_EQ(std::get<3>(result), 1);
+  EXPECT_NEAR(std::get<0>(result)[0], std::get<0>(expected)[0], 1e-6);
+  EXPECT_NEAR(std::get<0>(result)[1], std::get<0>(expected)[1], 1e-6);
+
+  // Another structure: the workspace is set up again
+  Eigen::MatrixXd A_new(3, 2);
+  A_new << 1, 1, 1, 0, 0, 1;
+  std::vector<float64_t> l_new = {1.0, 0.0, 0.0};
+  std::vector<float64_t> u_new = {1.0, 0.7, 0.7};
+  P << 4, 1, 1, 2;
+  q = {1.0, 1.0};
+  EXPECT_EQ(osqp.updateProblem(P, A_new, q, l_new, u_new), 0);
+  result = osqp.optimize();
+  EXPECT_EQ(std::get<3>(result), 1);
+  EXPECT_NEAR(std::get<0>(result)[0], 0.3, 1e-6);
+  EXPECT_NEAR(std::get<0>(result)[1], 0.7, 1e-6);
+}
 }  // namespace
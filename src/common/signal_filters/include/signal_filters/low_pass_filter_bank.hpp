@@ -0,0 +1,121 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+/// \file
+/// \brief Low pass filter for several signals sampled at the same time
+#ifndef SIGNAL_FILTERS__LOW_PASS_FILTER_BANK_HPP_
+#define SIGNAL_FILTERS__LOW_PASS_FILTER_BANK_HPP_
+
+#include <signal_filters/visibility_control.hpp>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace autoware
+{
+namespace common
+{
+namespace signal_filters
+{
+
+/// A bank of N low pass filters which are updated together with one call. Each channel behaves
+/// like a LowPassFilter with its own cutoff frequency; the state of all channels is kept in
+/// contiguous arrays and no virtual dispatch happens per channel.
+/// \tparam T A floating point type for the signals
+/// \tparam N The number of channels
+template<typename T, std::size_t N>
+class SIGNAL_FILTERS_PUBLIC LowPassFilterBank
+{
+  static_assert(std::is_floating_point<T>::value, "Filters only work on floating point types");
+  static_assert(N > 0U, "A filter bank needs at least one channel");
+
+public:
+  using Signals = std::array<T, N>;
+
+  /// Constructor
+  /// \param[in] cutoff_frequencies_hz The cutoff frequency of every channel
+  /// \throw std::domain_error If a cutoff frequency is non-positive
+  explicit LowPassFilterBank(const Signals & cutoff_frequencies_hz)
+  {
+    constexpr T TAU{static_cast<T>(2.0 * 3.14159)};
+    for (std::size_t i = 0U; i < N; ++i) {
+      if (T{} >= cutoff_frequencies_hz[i]) {
+        throw std::domain_error{"Cutoff frequency is non-positve"};
+      }
+      m_rc_inv[i] = TAU * cutoff_frequencies_hz[i];
+    }
+  }
+
+  /// Constructor for channels which all have the same cutoff frequency
+  /// \param[in] cutoff_frequency_hz The cutoff frequency of every channel
+  /// \throw std::domain_error If the cutoff frequency is non-positive
+  explicit LowPassFilterBank(T cutoff_frequency_hz)
+  : LowPassFilterBank{filled(cutoff_frequency_hz)}
+  {
+  }
+
+  /// Filter one sample of every channel
+  /// \param[in] values The new sample of every channel
+  /// \param[in] duration The time since the last sample
+  /// \return The filtered signal of every channel
+  /// \throw std::domain_error If the duration is non-positive or a value is NAN or INF
+  const Signals & filter(const Signals & values, std::chrono::nanoseconds duration)
+  {
+    if (decltype(duration)::zero() >= duration) {
+      throw std::domain_error{"Duration is non-positive"};
+    }
+    for (const auto value : values) {
+      if (!std::isfinite(value)) {
+        throw std::domain_error{"Value is not finite"};
+      }
+    }
+    const auto dt = std::chrono::duration_cast<std::chrono::duration<T>>(duration).count();
+    // Separate loops without branches so that the compiler can vectorize them
+    for (std::size_t i = 0U; i < N; ++i) {
+      m_alpha[i] = T{1.0} - std::exp(-dt * m_rc_inv[i]);
+    }
+    for (std::size_t i = 0U; i < N; ++i) {
+      m_signals[i] += m_alpha[i] * (values[i] - m_signals[i]);
+    }
+    return m_signals;
+  }
+
+  /// Get the filtered signal of every channel
+  const Signals & signals() const noexcept
+  {
+    return m_signals;
+  }
+
+private:
+  static Signals filled(T value) noexcept
+  {
+    Signals ret{};
+    ret.fill(value);
+    return ret;
+  }
+
+  Signals m_rc_inv{};
+  Signals m_alpha{};
+  Signals m_signals{};
+};
+}  // namespace signal_filters
+}  // namespace common
+}  // namespace autoware
+
+#endif  // SIGNAL_FILTERS__LOW_PASS_FILTER_BANK_HPP_
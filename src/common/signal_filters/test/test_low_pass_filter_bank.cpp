@@ -0,0 +1,78 @@
+// Copyright 2020 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <common/types.hpp>
+#include <gtest/gtest.h>
+
+#include <signal_filters/low_pass_filter.hpp>
+#include <signal_filters/low_pass_filter_bank.hpp>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
+using autoware::common::signal_filters::DummyClock;
+using autoware::common::signal_filters::LowPassFilter;
+using autoware::common::signal_filters::LowPassFilterBank;
+
+template<typename T>
+class LowPassFilterBankTest : public ::testing::Test
+{
+};
+
+using BankTypes = ::testing::Types<float32_t, float64_t>;
+// cppcheck-suppress syntaxError
+TYPED_TEST_CASE(LowPassFilterBankTest, BankTypes, );
+
+/// Every channel behaves like a single low pass filter with the same cutoff frequency
+TYPED_TEST(LowPassFilterBankTest, MatchesSingleChannelFilters)
+{
+  using Float = TypeParam;
+  using Single = LowPassFilter<Float, DummyClock>;
+  const std::array<Float, 3U> cutoffs{Float{1.0}, Float{5.0}, Float{20.0}};
+  LowPassFilterBank<Float, 3U> bank{cutoffs};
+  std::array<Single, 3U> singles{Single{cutoffs[0U]}, Single{cutoffs[1U]}, Single{cutoffs[2U]}};
+  const auto dt = std::chrono::milliseconds{10LL};
+  for (std::size_t step = 0U; step < 200U; ++step) {
+    const auto t = static_cast<Float>(step) * Float{0.01};
+    const std::array<Float, 3U> values{std::sin(t), Float{1.0}, std::cos(Float{3.0} * t)};
+    const auto & filtered = bank.filter(values, dt);
+    for (std::size_t i = 0U; i < 3U; ++i) {
+      EXPECT_EQ(filtered[i], singles[i].filter(values[i], dt)) << step << ", " << i;
+    }
+  }
+  EXPECT_EQ(&bank.signals(), &bank.filter({}, dt));
+}
+
+TYPED_TEST(LowPassFilterBankTest, BadInput)
+{
+  using Float = TypeParam;
+  EXPECT_THROW((LowPassFilterBank<Float, 2U>{{Float{1.0}, Float{}}}), std::domain_error);
+  EXPECT_THROW((LowPassFilterBank<Float, 2U>{Float{-1.0}}), std::domain_error);
+
+  LowPassFilterBank<Float, 2U> bank{Float{1.0}};
+  const auto dt = std::chrono::milliseconds{10LL};
+  bank.filter({Float{1.0}, Float{2.0}}, dt);
+  const auto signals = bank.signals();
+  EXPECT_THROW(bank.filter({Float{1.0}, Float{2.0}}, decltype(dt)::zero()), std::domain_error);
+  EXPECT_THROW(
+    bank.filter({Float{1.0}, std::numeric_limits<Float>::quiet_NaN()}, dt), std::domain_error);
+  EXPECT_THROW(
+    bank.filter({std::numeric_limits<Float>::infinity(), Float{2.0}}, dt), std::domain_error);
+  // Strong exception guarantee
+  EXPECT_EQ(signals, bank.signals());
+}
@@ -20,13 +20,15 @@
 #include <helper_functions/float_comparisons.hpp>
 #include <motion_model/motion_model_interface.hpp>
 #include <motion_model/stationary_motion_model.hpp>
+#include <state_estimation/measurement/linear_measurement.hpp>
 #include <state_estimation/noise_model/noise_interface.hpp>
 #include <state_estimation/state_estimation_interface.hpp>
 #include <state_estimation/visibility_control.hpp>
 
-#include <Eigen/LU>
+#include <Eigen/Cholesky>
 
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace autoware
@@ -90,9 +92,9 @@ public:
   State crtp_predict(const std::chrono::nanoseconds & dt)
   {
     m_state = m_motion_model.predict(m_state, dt);
-    const auto & motion_jacobian = m_motion_model.jacobian(m_state, dt);
     m_covariance =
-      motion_jacobian * m_covariance * motion_jacobian.transpose() + m_noise_model.covariance(dt);
+      m_motion_model.propagate_covariance(m_state, m_covariance, dt) +
+      m_noise_model.covariance(dt);
     return m_state;
   }
 
@@ -110,19 +112,8 @@ public:
   template<typename MeasurementT>
   State crtp_correct(const MeasurementT & measurement)
   {
-    const auto expected_measurement = measurement.create_new_instance_from(m_state);
-    const auto innovation = wrap_all_angles(measurement.state() - expected_measurement);
-    const auto mapping_matrix = measurement.mapping_matrix_from(m_state);
-    const auto innovation_covariance =
-      mapping_matrix * m_covariance * mapping_matrix.transpose() + measurement.covariance();
-    const auto kalman_gain =
-      m_covariance * mapping_matrix.transpose() * innovation_covariance.inverse();
-    m_state += kalman_gain * innovation.vector();
-    m_state.wrap_all_angles();
-    m_covariance = (State::Matrix::Identity() - kalman_gain * mapping_matrix) * m_covariance;
-    return m_state;
+    return correct_impl(measurement, is_selection_measurement<MeasurementT, State>{});
   }
-
   ///
   /// @brief      Reset the state of the filter to a given state and covariance.
   ///
@@ -146,6 +137,67 @@ public:
   const auto & crtp_covariance() const {return m_covariance;}
 
 private:
+  ///
+  /// @brief      Correct the state with a generic measurement.
+  ///
+  /// @details    The Kalman gain K = P * H^T * S^-1 is computed as the transposed solution of
+  ///             S * K^T = H * P, which is cheaper and more stable than inverting S.
+  ///
+  template<typename MeasurementT>
+  State correct_impl(const MeasurementT & measurement, std::false_type)
+  {
+    const auto expected_measurement = measurement.create_new_instance_from(m_state);
+    const auto innovation = wrap_all_angles(measurement.state() - expected_measurement);
+    const auto mapping_matrix = measurement.mapping_matrix_from(m_state);
+    const auto innovation_covariance =
+      mapping_matrix * m_covariance * mapping_matrix.transpose() + measurement.covariance();
+    const auto kalman_gain =
+      innovation_covariance.ldlt().solve(mapping_matrix * m_covariance).transpose().eval();
+    m_state += kalman_gain * innovation.vector();
+    m_state.wrap_all_angles();
+    m_covariance = (State::Matrix::Identity() - kalman_gain * mapping_matrix) * m_covariance;
+    return m_state;
+  }
+
+  ///
+  /// @brief      Correct the state with a measurement that directly observes state variables.
+  ///
+  /// @details    The mapping matrix H of such a measurement has a single 1 in every row, so all
+  ///             the products with it only select rows and columns of the covariance. These are
+  ///             copied instead of multiplying with H, which is where the generic correction
+  ///             spends most of its time.
+  ///
+  template<typename MeasurementT>
+  State correct_impl(const MeasurementT & measurement, std::true_type)
+  {
+    using MeasurementState = typename MeasurementT::State;
+    using Scalar = typename State::Scalar;
+    constexpr auto kMeasurementSize = MeasurementState::size();
+    constexpr auto indices = MeasurementT::template indices_in<State>();
+
+    const auto expected_measurement = measurement.create_new_instance_from(m_state);
+    const auto innovation = wrap_all_angles(measurement.state() - expected_measurement);
+    // H * P
+    Eigen::Matrix<Scalar, kMeasurementSize, State::size()> mapped_covariance;
+    for (Eigen::Index row = 0; row < kMeasurementSize; ++row) {
+      mapped_covariance.row(row) = m_covariance.row(indices[static_cast<std::size_t>(row)]);
+    }
+    // H * P * H^T + R
+    typename MeasurementState::Matrix innovation_covariance{measurement.covariance()};
+    for (Eigen::Index col = 0; col < kMeasurementSize; ++col) {
+      innovation_covariance.col(col) +=
+        mapped_covariance.col(indices[static_cast<std::size_t>(col)]);
+    }
+    // P is symmetric, so K^T = S^-1 * H * P
+    const Eigen::Matrix<Scalar, State::size(), kMeasurementSize> kalman_gain =
+      innovation_covariance.ldlt().solve(mapped_covariance).transpose();
+    m_state += kalman_gain * innovation.vector();
+    m_state.wrap_all_angles();
+    // (I - K * H) * P
+    m_covariance -= kalman_gain * mapped_covariance;
+    return m_state;
+  }
+
   /// Motion model used to predict the state forward.
   MotionModelT m_motion_model{};
   /// Noise model of the movement.
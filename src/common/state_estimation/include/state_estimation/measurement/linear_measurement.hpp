@@ -23,8 +23,10 @@
 
 #include <Eigen/Core>
 
+#include <array>
 #include <chrono>
 #include <tuple>
+#include <type_traits>
 
 namespace autoware
 {
@@ -100,6 +102,22 @@ public:
     };
   }
 
+  ///
+  /// @brief      Get the indices of the measured variables in another state.
+  ///
+  /// @details    This is a sparse form of the mapping matrix: the only 1 in its row i is in the
+  ///             column given by the entry i of the returned array.
+  ///
+  /// @tparam     OtherStateT  State that must contain all the variables of this measurement.
+  ///
+  /// @return     The index in OtherStateT of every variable of this measurement.
+  ///
+  template<typename OtherStateT>
+  static constexpr std::array<Eigen::Index, StateT::size()> indices_in() noexcept
+  {
+    return indices_in<OtherStateT>(typename StateT::Variables{});
+  }
+
 protected:
   // Allow the CRTP interface to call private functions from this class.
   friend MeasurementInterface<LinearMeasurement<StateT>>;
@@ -187,12 +205,37 @@ protected:
   }
 
 private:
+  /// @brief      Unpack the variables to get their indices in another state.
+  template<typename OtherStateT, typename ... VariableTs>
+  static constexpr std::array<Eigen::Index, sizeof...(VariableTs)> indices_in(
+    std::tuple<VariableTs...>) noexcept
+  {
+    return {{OtherStateT::template index_of<VariableTs>()...}};
+  }
+
   /// Current measurement vector.
   StateT m_measurement{};
   /// Current measurement covariance matrix.
   typename StateT::Matrix m_covariance{StateT::Matrix::Zero()};
 };
 
+///
+/// @brief      A trait to check if the mapping matrix of a measurement into a state only selects
+///             variables of that state, i.e., it is a linear measurement of a sub-state.
+///
+/// @tparam     MeasurementT  Type of the measurement.
+/// @tparam     OtherStateT   State to which the measurement is mapped.
+///
+template<typename MeasurementT, typename OtherStateT>
+struct is_selection_measurement : std::false_type {};
+
+/// @brief      A linear measurement selects the state variables if the state has all of them.
+template<typename StateT, typename OtherStateT>
+struct is_selection_measurement<LinearMeasurement<StateT>, OtherStateT>
+  : std::integral_constant<bool, std::tuple_size<typename common::type_traits::intersect<
+        typename StateT::Variables, typename OtherStateT::Variables>::type>::value ==
+    static_cast<std::size_t>(StateT::size())> {};
+
 }  // namespace state_estimation
 }  // namespace common
 }  // namespace autoware
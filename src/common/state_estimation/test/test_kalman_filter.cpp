@@ -141,6 +141,39 @@ TEST(TestKalmanFilter, TrackStaticObjectHiddenState) {
 }
 
 
+/// @test Test that the correction with a measurement of some of the state variables, which does
+///       not multiply with the mapping matrix, matches the textbook Kalman filter equations.
+TEST(TestKalmanFilter, CorrectWithSubStateMeasurement) {
+  using State = LinearMotionModel<ConstAccelerationXYYaw32>::State;
+  using Matrix = State::Matrix;
+  // The variables are in a different order than in the state.
+  using MeasurementState = FloatState<YAW, X>;
+  using Measurement = LinearMeasurement<MeasurementState>;
+  static_assert(
+    autoware::common::state_estimation::is_selection_measurement<Measurement, State>::value,
+    "The measurement should only select state variables.");
+  const Matrix random_matrix = Matrix::Random();
+  const Matrix covariance = random_matrix * random_matrix.transpose() + Matrix::Identity();
+  State state{};
+  state.vector() = State::Vector::Random();
+  auto kf = make_correction_only_kalman_filter(state, covariance);
+  const auto measurement = Measurement::create_with_stddev({0.5F, 1.0F}, {0.1F, 0.2F});
+  kf.correct(measurement);
+
+  const auto H = measurement.mapping_matrix_from(state);
+  const MeasurementState::Matrix S = H * covariance * H.transpose() + measurement.covariance();
+  const Eigen::Matrix<float32_t, State::size(), MeasurementState::size()> K =
+    covariance * H.transpose() * S.inverse();
+  const State::Vector expected_state =
+    state.vector() + K * (measurement.state().vector() - H * state.vector());
+  const Matrix expected_covariance = (Matrix::Identity() - K * H) * covariance;
+  EXPECT_TRUE(kf.state().vector().isApprox(expected_state, 1.0e-4F)) <<
+    kf.state().vector().transpose() << "\nis not\n" << expected_state.transpose();
+  EXPECT_TRUE(kf.covariance().isApprox(expected_covariance, 1.0e-4F)) <<
+    kf.covariance() << "\nis not\n" << expected_covariance;
+}
+
+
 /// @test Test that we can track a moving object measuring part of its state.
 ///
 /// @details The object is assumed to move at a straight line, changing its orientation with
@@ -29,9 +29,9 @@
 #include <Eigen/Core>
 
 #include <chrono>
-#include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace autoware
 {
@@ -91,11 +91,16 @@ struct ResetEvent
 ///
 /// @brief      This class encapsulates a history of events used with EKF.
 ///
-///             The class handles adding events to a history of a specified size. It models the
-///             behavior of a circular buffer, meaning that as new events come in, the oldest ones
-///             are removed. The events can be either measurement types or specific events like
-///             reset or prediction. Whenever an event is added to the middle of the history all the
-///             following events get rolled on top of this event to produce a new state.
+///             The class handles adding events to a history of a specified size. The events are
+///             stored sorted by time in a circular buffer which is allocated once, meaning that as
+///             new events come in, the oldest ones are overwritten. New events are placed by a
+///             binary search on their timestamp. The events can be either measurement types or
+///             specific events like reset or prediction. Whenever an event is added to the middle
+///             of the history all the following events get rolled on top of this event to produce
+///             a new state. If more events than the replay budget would be replayed, consecutive
+///             prediction events among them are first merged into the last one of them, which
+///             predicts over the whole time span in a single step. Events with the same
+///             timestamp as the event before them are not preceded by a prediction.
 ///
 /// @tparam     FilterT       Type of EKF filter used.
 /// @tparam     kNumOfStates  Dimensionality of the state in the filter.
@@ -116,24 +121,35 @@ class History
 
   /// Typedef for timestamps.
   using Timestamp = std::chrono::system_clock::time_point;
-  /// Typedef for history map type.
-  using HistoryMap = std::multimap<Timestamp, HistoryEntry>;
+  /// Typedef for a history entry together with its timestamp.
+  using TimedEntry = std::pair<Timestamp, HistoryEntry>;
+  /// Typedef for the storage of the circular buffer.
+  using HistoryBuffer = std::vector<TimedEntry, Eigen::aligned_allocator<TimedEntry>>;
 
 public:
   ///
   /// @brief      Construct history from a filter pointer with a specific size.
   ///
   /// @param      filter                 The filter pointer to be used internally.
-  /// @param[in]  max_history_size       The maximum history size.
+  /// @param[in]  max_history_size       The maximum history size. The history is not bounded if
+  ///                                    this is 0.
   /// @param[in]  mahalanobis_threshold  The mahalanobis threshold
+  /// @param[in]  replay_budget          The number of events that can be replayed after an
+  ///                                    insertion before prediction events get merged. There is
+  ///                                    no budget if this is 0.
   ///
   explicit History(
     FilterT & filter,
     const std::size_t max_history_size,
-    const common::types::float32_t mahalanobis_threshold)
+    const common::types::float32_t mahalanobis_threshold,
+    const std::size_t replay_budget = 0U)
   : m_filter{filter},
     m_max_history_size{max_history_size},
-    m_mahalanobis_threshold{mahalanobis_threshold} {}
+    m_mahalanobis_threshold{mahalanobis_threshold},
+    m_replay_budget{replay_budget}
+  {
+    m_history.reserve(m_max_history_size);
+  }
 
   ///
   /// @brief      Add an event to history. If it is added to the middle the following ones are
@@ -144,13 +160,16 @@ public:
   ///
   void emplace_event(const Timestamp & timestamp, const HistoryEntry & entry);
   /// @brief      Check if the history is empty.
-  inline bool empty() const noexcept {return m_history.empty();}
+  inline bool empty() const noexcept {return m_size == 0U;}
   /// @brief      Get size of history.
-  inline std::size_t size() const noexcept {return m_history.size();}
+  inline std::size_t size() const noexcept {return m_size;}
   /// @brief      Get last timestamp in history.
-  inline const Timestamp & get_last_timestamp() const noexcept {return m_history.rbegin()->first;}
+  inline const Timestamp & get_last_timestamp() const noexcept {return entry_at(m_size - 1U).first;}
   /// @brief      Get last event in history.
-  inline const HistoryEntry & get_last_event() const noexcept {return m_history.rbegin()->second;}
+  inline const HistoryEntry & get_last_event() const noexcept
+  {
+    return entry_at(m_size - 1U).second;
+  }
   /// @brief      Get the filter as a const ref.
   const FilterT & get_filter() const noexcept {return m_filter;}
   /// @brief      Get the filter.
@@ -162,22 +181,63 @@ private:
   ///
   inline void drop_oldest_event_if_needed()
   {
-    if ((m_history.size() >= m_max_history_size) && (m_max_history_size > 0U)) {
-      (void) m_history.erase(m_history.begin());
+    if ((m_size >= m_max_history_size) && (m_max_history_size > 0U)) {
+      m_head = (m_head + 1U) % m_max_history_size;
+      --m_size;
     }
   }
 
+  ///
+  /// @brief      Get the position in the buffer of the event with the given index, the oldest
+  ///             event having the index 0.
+  ///
+  inline std::size_t buffer_index(const std::size_t index) const noexcept
+  {
+    return (m_max_history_size > 0U) ? ((m_head + index) % m_max_history_size) : index;
+  }
+  /// @brief      Get the event with the given index, the oldest event having the index 0.
+  inline TimedEntry & entry_at(const std::size_t index) noexcept
+  {
+    return m_history[buffer_index(index)];
+  }
+  /// @brief      Get the event with the given index, the oldest event having the index 0.
+  inline const TimedEntry & entry_at(const std::size_t index) const noexcept
+  {
+    return m_history[buffer_index(index)];
+  }
+
+  ///
+  /// @brief      Get the index of the first event which is later than the timestamp.
+  ///
+  std::size_t upper_bound_index(const Timestamp & timestamp) const noexcept;
+
+  ///
+  /// @brief      Insert an event at the given index, moving the following events back.
+  ///
+  void insert_event(
+    const std::size_t index, const Timestamp & timestamp, const HistoryEntry & entry);
+
+  ///
+  /// @brief      Merge each run of consecutive prediction events into its last event.
+  ///
+  /// @param[in]  first_index  The index of the first event which can be merged.
+  ///
+  void coalesce_prediction_events(const std::size_t first_index);
+
   ///
   /// @brief      Update all the following events as their state is based on the current one.
   ///
-  /// @param[in]  start_iter  The current iterator with the new state.
+  /// @param[in]  start_index  The index of the event with the new state.
   ///
-  void update_impacted_events(const typename HistoryMap::iterator & start_iter);
+  void update_impacted_events(const std::size_t start_index);
 
-  HistoryMap m_history{};  ///< history of events.
+  HistoryBuffer m_history{};  ///< circular buffer of the history of events.
+  std::size_t m_head{};  ///< Position of the oldest event in the buffer.
+  std::size_t m_size{};  ///< Number of events in history.
   FilterT & m_filter{};  ///< pointer to the filter implementation.
   std::size_t m_max_history_size{};  ///< Maximum number of events in history.
   common::types::float32_t m_mahalanobis_threshold{};  ///< Mahalanobis distance threshold.
+  std::size_t m_replay_budget{};  ///< Number of events replayed before predictions get merged.
 };
 
 template<typename FilterT, typename ... EventT>
@@ -241,7 +301,7 @@ public:
   template<typename MeasurementT>
   void operator()(const MeasurementT & event)
   {
-    m_filter.predict(m_dt);
+    predict_if_time_passed();
     // TODO(#887): I see a couple of ways to check mahalanobis distance in case the measurement does
     // not cover the full state. Here I upscale it to the full state, copying the values of the
     // current state for ones missing in the observation. We can alternatively apply the H matrix
@@ -265,10 +325,22 @@ public:
   /// @brief      An operator that applies the prediction event to the filter implementation.
   void operator()(const PredictionEvent &)
   {
-    m_filter.predict(m_dt);
+    predict_if_time_passed();
   }
 
 private:
+  ///
+  /// @brief      Predict the filter state over the time step. An event with the same timestamp as
+  ///             the previous one, e.g. a measurement on a point of the prediction grid, starts
+  ///             from the state stored for the previous event instead of predicting over zero time.
+  ///
+  void predict_if_time_passed()
+  {
+    if (m_dt != std::chrono::system_clock::duration::zero()) {
+      m_filter.predict(m_dt);
+    }
+  }
+
   FilterT & m_filter{};  ///< A pointer to the filter implementation.
   common::types::float32_t m_mahalanobis_threshold{};  ///< Mahalanobis distance threshold.
   std::chrono::system_clock::duration m_dt{};  ///< Current time step.
@@ -279,44 +351,104 @@ void History<FilterT, EventT...>::emplace_event(
   const Timestamp & timestamp, const HistoryEntry & entry)
 {
   drop_oldest_event_if_needed();
-  const auto iterator_to_inserted_position = m_history.emplace(timestamp, entry);
-  update_impacted_events(iterator_to_inserted_position);
+  const auto index = upper_bound_index(timestamp);
+  if ((index == 0U) && !mpark::holds_alternative<ResetEvent<FilterT>>(entry.event())) {
+    throw std::runtime_error(
+            "Non-reset event inserted to the beginning of history. This might "
+            "happen if a very old event is inserted into the queue. Consider "
+            "increasing the queue size or debug program latencies.");
+  }
+  insert_event(index, timestamp, entry);
+  update_impacted_events(index);
 }
 
 template<typename FilterT, typename ... EventT>
-void History<FilterT, EventT...>::update_impacted_events(
-  const typename HistoryMap::iterator & start_iter)
+std::size_t History<FilterT, EventT...>::upper_bound_index(
+  const Timestamp & timestamp) const noexcept
 {
-  Timestamp previous_timestamp{};
-  if (start_iter == m_history.begin()) {
-    if (!mpark::holds_alternative<ResetEvent<FilterT>>(start_iter->second.event())) {
-      (void) m_history.erase(start_iter);
-      throw std::runtime_error(
-              "Non-reset event inserted to the beginning of history. This might "
-              "happen if a very old event is inserted into the queue. Consider "
-              "increasing the queue size or debug program latencies.");
+  // Events mostly arrive in order, so check the end of the history first.
+  if ((m_size == 0U) || (entry_at(m_size - 1U).first <= timestamp)) {
+    return m_size;
+  }
+  std::size_t first = 0U;
+  std::size_t last = m_size - 1U;
+  while (first < last) {
+    const auto middle = first + (last - first) / 2U;
+    if (timestamp < entry_at(middle).first) {
+      last = middle;
+    } else {
+      first = middle + 1U;
     }
+  }
+  return first;
+}
+
+template<typename FilterT, typename ... EventT>
+void History<FilterT, EventT...>::insert_event(
+  const std::size_t index, const Timestamp & timestamp, const HistoryEntry & entry)
+{
+  // The buffer only grows until it reaches the maximum history size.
+  if (buffer_index(m_size) < m_history.size()) {
+    entry_at(m_size) = TimedEntry{timestamp, entry};
   } else {
-    const auto prev_iter = std::prev(start_iter);
-    previous_timestamp = prev_iter->first;
-    const auto & prev_entry = prev_iter->second;
+    m_history.emplace_back(timestamp, entry);
+  }
+  ++m_size;
+  if (index + 1U < m_size) {
+    TimedEntry inserted{std::move(entry_at(m_size - 1U))};
+    for (auto i = m_size - 1U; i > index; --i) {
+      entry_at(i) = std::move(entry_at(i - 1U));
+    }
+    entry_at(index) = std::move(inserted);
+  }
+}
+
+template<typename FilterT, typename ... EventT>
+void History<FilterT, EventT...>::coalesce_prediction_events(const std::size_t first_index)
+{
+  std::size_t kept_count = first_index;
+  for (auto i = first_index; i < m_size; ++i) {
+    const auto is_merged = (i + 1U < m_size) &&
+      mpark::holds_alternative<PredictionEvent>(entry_at(i).second.event()) &&
+      mpark::holds_alternative<PredictionEvent>(entry_at(i + 1U).second.event());
+    if (is_merged) {continue;}
+    if (kept_count != i) {
+      entry_at(kept_count) = std::move(entry_at(i));
+    }
+    ++kept_count;
+  }
+  m_size = kept_count;
+}
+
+template<typename FilterT, typename ... EventT>
+void History<FilterT, EventT...>::update_impacted_events(const std::size_t start_index)
+{
+  Timestamp previous_timestamp{};
+  if (start_index > 0U) {
+    const auto & prev_timed_entry = entry_at(start_index - 1U);
+    previous_timestamp = prev_timed_entry.first;
+    const auto & prev_entry = prev_timed_entry.second;
     m_filter.reset(
       typename FilterT::State{prev_entry.stored_state()},
       prev_entry.stored_covariance());
   }
-  for (auto iter = start_iter; iter != m_history.end(); ++iter) {
-    const auto current_timestamp = iter->first;
-    auto & entry = iter->second;
+  if ((m_replay_budget > 0U) && (m_size - start_index > m_replay_budget)) {
+    // The inserted event itself is kept.
+    coalesce_prediction_events(start_index + 1U);
+  }
+  for (auto i = start_index; i < m_size; ++i) {
+    auto & timed_entry = entry_at(i);
+    const auto current_timestamp = timed_entry.first;
+    auto & entry = timed_entry.second;
     mpark::visit(
       EkfStateUpdater{m_filter, m_mahalanobis_threshold, current_timestamp - previous_timestamp},
       entry.event());
     entry.update_stored_state(m_filter.state());
     entry.update_stored_covariance(m_filter.covariance());
-    previous_timestamp = iter->first;
+    previous_timestamp = current_timestamp;
   }
 }
 
-
 }  // namespace state_estimation
 }  // namespace common
 }  // namespace autoware
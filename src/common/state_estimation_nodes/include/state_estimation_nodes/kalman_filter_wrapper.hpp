@@ -33,6 +33,7 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <limits>
@@ -80,6 +81,9 @@ public:
   /// @param[in]  history_duration          Length of the history of events.
   /// @param[in]  mahalanobis_threshold     The threshold on the Mahalanobis distance for outlier
   ///                                       rejection.
+  /// @param[in]  history_replay_budget     The number of events replayed after an out-of-order
+  ///                                       event before prediction events get merged, 0 for no
+  ///                                       limit.
   ///
   KalmanFilterWrapper(
     const typename FilterT::MotionModel motion_model,
@@ -89,11 +93,13 @@ public:
     const std::string & frame_id,
     const std::chrono::nanoseconds & history_duration = std::chrono::milliseconds{5000},
     common::types::float32_t mahalanobis_threshold =
-    std::numeric_limits<common::types::float32_t>::max())
+    std::numeric_limits<common::types::float32_t>::max(),
+    const std::size_t history_replay_budget = 0U)
   : m_initial_covariance{initial_state_covariance},
     m_frame_id{frame_id},
     m_mahalanobis_threshold{mahalanobis_threshold},
     m_expected_prediction_period{expected_dt},
+    m_motion_model{motion_model},
     m_filter{
       motion_model,
       noise_model,
@@ -103,7 +109,8 @@ public:
     m_history{
       m_filter,
       static_cast<std::size_t>(history_duration / expected_dt),
-      m_mahalanobis_threshold} {}
+      m_mahalanobis_threshold,
+      history_replay_budget} {}
 
   ///
   /// Reset the filter state using the default covariance and state derived from the measurement.
@@ -136,19 +143,23 @@ public:
   {
     m_history.emplace_event(event_timestamp, ResetEvent<FilterT>{state, initial_covariance});
     m_time_grid = SteadyTimeGrid{event_timestamp, m_expected_prediction_period};
+    m_last_predicted_mean_timestamp = event_timestamp;
   }
 
   ///
   /// Predict state of filter at the next timestep defined by the period of this node.
   ///
+  /// @note       This is the next timestep after both the last event in the history and the last
+  ///             time to which get_next_predicted_mean predicted.
+  ///
   /// @return     true if the update was successful and false otherwise. In case false is returned,
   ///             this update had no effect on the state of the filter.
   ///
   inline common::types::bool8_t add_next_temporal_update_to_history()
   {
     if (!is_initialized()) {return false;}
-    const auto next_prediction_timestamp =
-      m_time_grid.get_next_timestamp_after(m_history.get_last_timestamp());
+    const auto next_prediction_timestamp = m_time_grid.get_next_timestamp_after(
+      std::max(m_history.get_last_timestamp(), m_last_predicted_mean_timestamp));
     m_history.emplace_event(next_prediction_timestamp, PredictionEvent{});
     return true;
   }
@@ -182,7 +193,25 @@ public:
   /// Get the current state of the system as an odometry message.
   nav_msgs::msg::Odometry get_state() const;
 
+  ///
+  /// Get the state predicted to the next timestep defined by the period of this node, without
+  /// adding a prediction to the history.
+  ///
+  /// @details    Only the mean is predicted, from the last event in the history. The covariance is
+  ///             the one of that event, so it is not grown by the process noise until the next
+  ///             event is added. Consecutive calls step through the timesteps.
+  ///
+  /// @return     The predicted state as an odometry message.
+  ///
+  nav_msgs::msg::Odometry get_next_predicted_mean();
+
 private:
+  /// Fill an odometry message with the state and covariance at the given time.
+  nav_msgs::msg::Odometry to_odometry(
+    const State & state,
+    const typename State::Matrix & covariance,
+    const std::chrono::system_clock::time_point & timestamp) const;
+
   /// Initial covariance of the filter.
   typename State::Matrix m_initial_covariance{};
   /// Time represented in a frame based on the last measurement timestamp.
@@ -193,6 +222,10 @@ private:
   common::types::float32_t m_mahalanobis_threshold{};
   /// What duration passes between prediction events.
   std::chrono::nanoseconds m_expected_prediction_period{};
+  /// Motion model used to predict the mean without the filter.
+  typename FilterT::MotionModel m_motion_model{};
+  /// Time to which the mean was last predicted.
+  std::chrono::system_clock::time_point m_last_predicted_mean_timestamp{};
   /// Wrapper owns the filter implementation.
   FilterT m_filter{};
   /// History of all events is stored here.
@@ -43,6 +43,7 @@
 
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -96,9 +97,12 @@ private:
   /// Predict the state and publish the current estimate.
   void STATE_ESTIMATION_NODES_LOCAL predict_and_publish_current_state();
 
-  /// Publish the currently estimated state.
+  /// Publish the last state handed off by the filter.
   void STATE_ESTIMATION_NODES_LOCAL publish_current_state();
 
+  /// Hand off a state of the filter for publishing.
+  void STATE_ESTIMATION_NODES_LOCAL hand_off_state(OdomMsgT state);
+
   template<typename MessageT>
   using CallbackFnT = void (StateEstimationNode::*)(const typename MessageT::SharedPtr);
 
@@ -120,10 +124,18 @@ private:
   std::chrono::system_clock::time_point m_time_of_last_publish{};
 
   rclcpp::TimerBase::SharedPtr m_wall_timer{};
+  /// Callback group of the publishing timer, so that it does not wait for the measurements.
+  rclcpp::CallbackGroup::SharedPtr m_publish_callback_group{};
+  /// Callback group of the measurement subscriptions.
+  rclcpp::CallbackGroup::SharedPtr m_measurement_callback_group{};
 
   common::types::bool8_t m_filter_initialized{};
   common::types::bool8_t m_publish_data_driven{};
   common::types::float64_t m_publish_frequency{};
+  /// Every how many timer ticks the covariance is predicted along with the mean, 0 for never.
+  std::size_t m_covariance_prediction_interval{1U};
+  /// Timer ticks since the covariance was last predicted, guarded by m_ekf_mutex.
+  std::size_t m_ticks_since_covariance_prediction{};
 
   std::string m_frame_id{};
   std::string m_child_frame_id{};
@@ -131,6 +143,13 @@ private:
   // TODO(igor): we can replace the unique_ptr here with std::variant or alike at a later time to
   // allow configuring which filter to use at runtime.
   std::unique_ptr<FilterWrapperT> m_ekf{};
+  /// Guards m_ekf, which the measurements and the publishing timer update.
+  std::mutex m_ekf_mutex;
+
+  /// Last state of the filter, guarded by m_latest_state_mutex.
+  OdomMsgT m_latest_state{};
+  common::types::bool8_t m_latest_state_valid{};
+  std::mutex m_latest_state_mutex;
 
   tf2::BufferCore m_tf_buffer;
   tf2_ros::TransformListener m_tf_listener;
@@ -212,11 +212,34 @@ nav_msgs::msg::Odometry KalmanFilterWrapper<FilterT>::get_state() const
   if (!is_initialized()) {
     throw std::runtime_error("Filter not is_initialized, cannot get state.");
   }
-  const auto last_event = m_history.get_last_event();
-  const auto state = last_event.stored_state();
-  const auto & covariance = last_event.stored_covariance();
+  const auto & last_event = m_history.get_last_event();
+  return to_odometry(
+    last_event.stored_state(), last_event.stored_covariance(), m_history.get_last_timestamp());
+}
+
+template<typename FilterT>
+nav_msgs::msg::Odometry KalmanFilterWrapper<FilterT>::get_next_predicted_mean()
+{
+  if (!is_initialized()) {
+    throw std::runtime_error("Filter not is_initialized, cannot predict state.");
+  }
+  const auto & last_timestamp = m_history.get_last_timestamp();
+  m_last_predicted_mean_timestamp = m_time_grid.get_next_timestamp_after(
+    std::max(last_timestamp, m_last_predicted_mean_timestamp));
+  const auto & last_event = m_history.get_last_event();
+  const auto state = m_motion_model.predict(
+    last_event.stored_state(), m_last_predicted_mean_timestamp - last_timestamp);
+  return to_odometry(state, last_event.stored_covariance(), m_last_predicted_mean_timestamp);
+}
+
+template<typename FilterT>
+nav_msgs::msg::Odometry KalmanFilterWrapper<FilterT>::to_odometry(
+  const State & state,
+  const typename State::Matrix & covariance,
+  const std::chrono::system_clock::time_point & timestamp) const
+{
   auto msg = OdometryFiller<typename FilterT::State>::fill_odom_msg(state, covariance);
-  msg.header.stamp = rclcpp::Time{to_ros_time(m_history.get_last_timestamp())};
+  msg.header.stamp = rclcpp::Time{to_ros_time(timestamp)};
   msg.header.frame_id = m_frame_id;
   msg.child_frame_id = kDefaultChildFrameId;
   return msg;
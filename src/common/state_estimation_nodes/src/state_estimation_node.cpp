@@ -31,7 +31,9 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 using autoware::common::types::float32_t;
@@ -115,10 +117,16 @@ StateEstimationNode::StateEstimationNode(
   m_publish_data_driven = declare_parameter("data_driven", false);
   const auto time_between_publish_requests{
     validate_publish_frequency(m_publish_frequency, m_publish_data_driven)};
+  // With a multi-threaded executor, the publishing timer runs next to the measurement callbacks,
+  // so that a long history replay does not delay the output.
+  m_publish_callback_group = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  m_measurement_callback_group =
+    create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
   if (!m_publish_data_driven) {
     m_wall_timer = create_wall_timer(
       time_between_publish_requests,
-      std::bind(&StateEstimationNode::predict_and_publish_current_state, this));
+      std::bind(&StateEstimationNode::predict_and_publish_current_state, this),
+      m_publish_callback_group);
   }
 
   const auto acceleration_variances{
@@ -127,6 +135,16 @@ StateEstimationNode::StateEstimationNode(
     declare_parameter("state_variances", std::vector<float64_t>{})};
   const auto mahalanobis_threshold{
     declare_parameter("mahalanobis_threshold", std::numeric_limits<float32_t>::max())};
+  const auto history_replay_budget{declare_parameter("history_replay_budget", 0)};
+  if (history_replay_budget < 0) {
+    throw std::runtime_error("history_replay_budget must not be negative.");
+  }
+  const auto covariance_prediction_interval{
+    declare_parameter("covariance_prediction_interval", 1)};
+  if (covariance_prediction_interval < 0) {
+    throw std::runtime_error("covariance_prediction_interval must not be negative.");
+  }
+  m_covariance_prediction_interval = static_cast<std::size_t>(covariance_prediction_interval);
 
   using State = typename FilterWrapperT::State;
   m_ekf = std::make_unique<FilterWrapperT>(
@@ -136,7 +154,8 @@ StateEstimationNode::StateEstimationNode(
     time_between_publish_requests,
     m_frame_id,
     kDefaultHistoryLength,
-    mahalanobis_threshold);
+    mahalanobis_threshold,
+    static_cast<std::size_t>(history_replay_budget));
 
 
   const std::vector<std::string> empty_vector{};
@@ -168,14 +187,20 @@ void StateEstimationNode::pose_callback(const PoseMsgT::SharedPtr msg)
   }
   const auto measurement =
     convert_to<Stamped<PoseMeasurementXYZRPY64>>::from(*msg).cast<float32_t>();
-  if (m_ekf->is_initialized()) {
-    if (!m_ekf->add_observation_to_history(measurement)) {
-      throw std::runtime_error("Cannot add a pose observation to history.");
+  {
+    std::lock_guard<std::mutex> lock{m_ekf_mutex};
+    if (m_ekf->is_initialized()) {
+      if (!m_ekf->add_observation_to_history(measurement)) {
+        throw std::runtime_error("Cannot add a pose observation to history.");
+      }
+    } else {
+      m_ekf->add_reset_event_to_history(measurement);
+    }
+    if (m_ekf->is_initialized()) {
+      hand_off_state(m_ekf->get_state());
     }
-  } else {
-    m_ekf->add_reset_event_to_history(measurement);
   }
-  if (m_publish_data_driven && m_ekf->is_initialized()) {
+  if (m_publish_data_driven) {
     publish_current_state();
   }
 }
@@ -186,31 +211,66 @@ void StateEstimationNode::relative_pos_callback(const RelativePosMsgT::SharedPtr
     throw std::runtime_error("RelativePosition message frames don't match the expected ones.");
   }
   const auto measurement = convert_to<Stamped<PoseMeasurementXYZ64>>::from(*msg).cast<float32_t>();
-  if (m_ekf->is_initialized()) {
-    if (!m_ekf->add_observation_to_history(measurement)) {
-      throw std::runtime_error("Cannot add a relative pose observation to history.");
+  {
+    std::lock_guard<std::mutex> lock{m_ekf_mutex};
+    if (m_ekf->is_initialized()) {
+      if (!m_ekf->add_observation_to_history(measurement)) {
+        throw std::runtime_error("Cannot add a relative pose observation to history.");
+      }
+    } else {
+      m_ekf->add_reset_event_to_history(measurement);
+    }
+    if (m_ekf->is_initialized()) {
+      hand_off_state(m_ekf->get_state());
     }
-  } else {
-    m_ekf->add_reset_event_to_history(measurement);
   }
-  if (m_publish_data_driven && m_ekf->is_initialized()) {
+  if (m_publish_data_driven) {
     publish_current_state();
   }
 }
 
 void StateEstimationNode::predict_and_publish_current_state()
 {
-  if (!m_ekf->is_initialized()) {return;}
-  if (!m_ekf->add_next_temporal_update_to_history()) {
-    throw std::runtime_error("Could not perform a temporal update.");
+  // If a measurement is being processed, publish the state that it started from instead of waiting
+  // for it, so that the output stays at a steady rate.
+  std::unique_lock<std::mutex> lock{m_ekf_mutex, std::try_to_lock};
+  if (lock.owns_lock()) {
+    if (!m_ekf->is_initialized()) {return;}
+    ++m_ticks_since_covariance_prediction;
+    if ((m_covariance_prediction_interval > 0U) &&
+      (m_ticks_since_covariance_prediction >= m_covariance_prediction_interval))
+    {
+      m_ticks_since_covariance_prediction = 0U;
+      if (!m_ekf->add_next_temporal_update_to_history()) {
+        throw std::runtime_error("Could not perform a temporal update.");
+      }
+      hand_off_state(m_ekf->get_state());
+    } else {
+      // Between the full predictions only the mean is predicted, which leaves the history and the
+      // covariance as they are.
+      hand_off_state(m_ekf->get_next_predicted_mean());
+    }
+    lock.unlock();
   }
   publish_current_state();
 }
 
+void StateEstimationNode::hand_off_state(OdomMsgT state)
+{
+  std::lock_guard<std::mutex> lock{m_latest_state_mutex};
+  m_latest_state = std::move(state);
+  m_latest_state_valid = true;
+}
+
 void StateEstimationNode::publish_current_state()
 {
-  if (m_ekf->is_initialized() && m_publisher) {
-    auto state = m_ekf->get_state();
+  OdomMsgT state{};
+  {
+    std::lock_guard<std::mutex> lock{m_latest_state_mutex};
+    if (!m_latest_state_valid) {return;}
+    state = m_latest_state;
+  }
+  if (m_publisher) {
     m_publisher->publish(state);
     if (m_tf_publisher) {
       TfMsgT tf_msg{};
@@ -234,10 +294,12 @@ void StateEstimationNode::create_subscriptions(
   CallbackFnT<MessageT> callback)
 {
   for (const auto & input_topic : input_topics) {
+    rclcpp::SubscriptionOptions options{};
+    options.callback_group = m_measurement_callback_group;
     subscribers->emplace_back(
       create_subscription<MessageT>(
         input_topic, kDefaultHistory,
-        std::bind(callback, this, std::placeholders::_1)));
+        std::bind(callback, this, std::placeholders::_1), options));
   }
 }
 
@@ -216,3 +216,98 @@ TEST(HistoryTest, ExhaustHistory) {
   }
   ASSERT_EQ(history_size, history.size());
 }
+
+/// @test Test that out-of-order events are sorted in once the history has wrapped around.
+TEST(HistoryTest, OutOfOrderEventAfterWrapAround) {
+  using HistoryT = History<MockFilter, PredictionEvent, ResetEvent<MockFilter>, Measurement>;
+
+  const auto history_size = 3U;
+  const std::chrono::system_clock::time_point timestamp{std::chrono::system_clock::now()};
+  const std::chrono::system_clock::duration dt{std::chrono::milliseconds{10}};
+  const FilterState state{FilterState::Vector{23.0F}};
+  const FilterState::Matrix covariance{23.0F * FilterState::Matrix::Identity()};
+  auto filter = std::make_unique<MockFilter>();
+  HistoryT history{*filter, history_size, 100};
+  EXPECT_CALL(history.get_filter(), reset(state, covariance)).Times(::testing::AnyNumber());
+  EXPECT_CALL(history.get_filter(), state()).WillRepeatedly(Return(state));
+  EXPECT_CALL(history.get_filter(), covariance()).WillRepeatedly(Return(covariance));
+  EXPECT_CALL(history.get_filter(), correct(_)).Times(::testing::AnyNumber());
+  EXPECT_CALL(history.get_filter(), predict(2 * dt)).Times(4);
+
+  history.emplace_event(timestamp - 2 * dt, ResetEvent<MockFilter>{state, covariance});
+  for (std::int32_t i = 0; i < 4; ++i) {
+    history.emplace_event(timestamp + 2 * i * dt, Measurement{state.vector(), covariance});
+  }
+  ASSERT_EQ(history_size, history.size());
+
+  // The new event goes between the last two events and both of them are replayed.
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(history.get_filter(), predict(dt)).Times(2);
+  }
+  history.emplace_event(timestamp + 5 * dt, Measurement{state.vector(), covariance});
+  ASSERT_EQ(history_size, history.size());
+  EXPECT_EQ(history.get_last_timestamp(), timestamp + 6 * dt);
+}
+
+/// @test Test that prediction events are merged when the replay exceeds the budget.
+TEST(HistoryTest, CoalescePredictionEvents) {
+  using HistoryT = History<MockFilter, PredictionEvent, ResetEvent<MockFilter>, Measurement>;
+
+  const std::chrono::system_clock::time_point timestamp{std::chrono::system_clock::now()};
+  const std::chrono::system_clock::duration dt{std::chrono::milliseconds{10}};
+  const FilterState state{FilterState::Vector{23.0F}};
+  const FilterState::Matrix covariance{23.0F * FilterState::Matrix::Identity()};
+  auto filter = std::make_unique<MockFilter>();
+  const auto replay_budget = 2U;
+  HistoryT history{*filter, 10, 100, replay_budget};
+  EXPECT_CALL(history.get_filter(), reset(state, covariance)).Times(::testing::AnyNumber());
+  EXPECT_CALL(history.get_filter(), state()).WillRepeatedly(Return(state));
+  EXPECT_CALL(history.get_filter(), covariance()).WillRepeatedly(Return(covariance));
+  EXPECT_CALL(history.get_filter(), correct(_)).Times(1);
+  EXPECT_CALL(history.get_filter(), predict(dt)).Times(4);
+
+  history.emplace_event(timestamp, ResetEvent<MockFilter>{state, covariance});
+  for (std::int32_t i = 1; i <= 4; ++i) {
+    history.emplace_event(timestamp + i * dt, PredictionEvent{});
+  }
+  ASSERT_EQ(5U, history.size());
+
+  // Five events would be replayed, so the four predictions after the measurement are merged into
+  // a single one.
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(history.get_filter(), predict(dt / 2));
+    EXPECT_CALL(history.get_filter(), predict(4 * dt - dt / 2));
+  }
+  history.emplace_event(timestamp + dt / 2, Measurement{state.vector(), covariance});
+  ASSERT_EQ(3U, history.size());
+  EXPECT_EQ(history.get_last_timestamp(), timestamp + 4 * dt);
+}
+
+/// @test Test that no prediction happens between events with the same timestamp.
+TEST(HistoryTest, NoPredictionOverZeroTime) {
+  using HistoryT = History<MockFilter, PredictionEvent, ResetEvent<MockFilter>, Measurement>;
+
+  const std::chrono::system_clock::time_point timestamp{std::chrono::system_clock::now()};
+  const std::chrono::system_clock::duration dt{std::chrono::milliseconds{10}};
+  const FilterState state{FilterState::Vector{23.0F}};
+  const FilterState::Matrix covariance{23.0F * FilterState::Matrix::Identity()};
+  auto filter = std::make_unique<MockFilter>();
+  HistoryT history{*filter, 10, 100};
+  EXPECT_CALL(history.get_filter(), reset(state, covariance)).Times(::testing::AnyNumber());
+  EXPECT_CALL(history.get_filter(), state()).WillRepeatedly(Return(state));
+  EXPECT_CALL(history.get_filter(), covariance()).WillRepeatedly(Return(covariance));
+  EXPECT_CALL(history.get_filter(), correct(_)).Times(3);
+  EXPECT_CALL(history.get_filter(), predict(dt)).Times(2);
+  EXPECT_CALL(history.get_filter(), predict(std::chrono::system_clock::duration::zero())).Times(0);
+
+  history.emplace_event(timestamp, ResetEvent<MockFilter>{state, covariance});
+  history.emplace_event(timestamp + dt, PredictionEvent{});
+  // A measurement on the prediction grid is corrected on top of the predicted state.
+  history.emplace_event(timestamp + dt, Measurement{state.vector(), covariance});
+  // A measurement at the time of the reset is applied to the reset state, and the measurement
+  // after it is replayed.
+  history.emplace_event(timestamp, Measurement{state.vector(), covariance});
+  ASSERT_EQ(4U, history.size());
+}
@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 
 #include <measurement_conversion/measurement_typedefs.hpp>
+#include <rclcpp/time.hpp>
 #include <state_estimation_nodes/kalman_filter_wrapper.hpp>
 #include <state_vector/common_variables.hpp>
 
@@ -255,6 +256,41 @@ TEST(KalmanFilterWrapperTest, CovarianceGrowsWithTime) {
   EXPECT_GT(odom_msg_later.twist.covariance[7], 1.0 + kEpsilon);
 }
 
+/// \test Predicting only the mean moves the state on but leaves the covariance and history alone.
+TEST(KalmanFilterWrapperTest, PredictMeanOnly) {
+  using State = ConstantAccelerationFilterWrapperXY::State;
+  using namespace std::chrono_literals;
+  ConstantAccelerationFilterWrapperXY filter{
+    LinearMotionModel<State>{},
+    WienerNoise<State>{{1.0F, 1.0F}},
+    kCovarianceIdentity,
+    std::chrono::milliseconds{100LL},
+    "map"};
+  const auto timestamp = std::chrono::system_clock::time_point{std::chrono::system_clock::now()};
+  State initial_state{};
+  initial_state.at<X_VELOCITY>() = 1.0F;
+  filter.add_reset_event_to_history(initial_state, kCovarianceIdentity, timestamp);
+  ASSERT_TRUE(filter.is_initialized());
+  for (auto i = 1; i <= 3; ++i) {
+    const auto odom_msg = filter.get_next_predicted_mean();
+    EXPECT_NEAR(odom_msg.pose.pose.position.x, 0.1 * i, kEpsilon);
+    EXPECT_NEAR(odom_msg.twist.twist.linear.x, 1.0, kEpsilon);
+    EXPECT_NEAR(odom_msg.pose.covariance[0], 1.0, kEpsilon);
+    EXPECT_EQ(
+      rclcpp::Time{odom_msg.header.stamp}.nanoseconds(),
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        (timestamp + i * 100ms).time_since_epoch()).count());
+  }
+  const auto odom_msg = filter.get_state();
+  EXPECT_NEAR(odom_msg.pose.pose.position.x, 0.0, kEpsilon);
+  EXPECT_NEAR(odom_msg.pose.covariance[0], 1.0, kEpsilon);
+  // The next full prediction continues after the predicted mean.
+  EXPECT_TRUE(filter.add_next_temporal_update_to_history());
+  const auto odom_msg_later = filter.get_state();
+  EXPECT_NEAR(odom_msg_later.pose.pose.position.x, 0.4, kEpsilon);
+  EXPECT_GT(odom_msg_later.pose.covariance[0], 1.0 + kEpsilon);
+}
+
 
 /// \test Track a static object.
 TEST(KalmanFilterWrapperTest, TrackStaticObject) {
@@ -0,0 +1,232 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#ifndef TIME_UTILS__LATENCY_HISTOGRAM_HPP_
+#define TIME_UTILS__LATENCY_HISTOGRAM_HPP_
+
+#include <time_utils/visibility_control.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace autoware
+{
+namespace common
+{
+namespace time_utils
+{
+
+///
+/// @brief      This class describes a histogram of latencies with logarithmic bins, for
+///             instrumenting hot paths. Adding a sample does not allocate memory and takes
+///             constant time.
+///
+///             Bin 0 counts latencies below 1 us, bin i > 0 counts latencies in [2^(i-1), 2^i) us,
+///             the last bin also counts all longer latencies.
+///
+class TIME_UTILS_PUBLIC LatencyHistogram
+{
+public:
+  static constexpr std::size_t NUM_BINS = 32U;
+  using Bins = std::array<uint64_t, NUM_BINS>;
+
+  /// Get the bin a latency is counted in.
+  static inline std::size_t bin_of(const std::chrono::nanoseconds latency) noexcept
+  {
+    const auto us = static_cast<uint64_t>(
+      std::max(std::chrono::duration_cast<std::chrono::microseconds>(latency).count(), int64_t{}));
+    std::size_t bin = 0U;
+    for (uint64_t bound = 1U; (bin < (NUM_BINS - 1U)) && (us >= bound); bound <<= 1U) {
+      ++bin;
+    }
+    return bin;
+  }
+
+  /// Add a sample.
+  inline void add(const std::chrono::nanoseconds latency) noexcept
+  {
+    ++m_bins[bin_of(latency)];
+    ++m_count;
+    m_total += latency;
+    m_max = std::max(m_max, latency);
+  }
+
+  /// Remove all samples.
+  inline void reset() noexcept {*this = LatencyHistogram{};}
+
+  /// Get the number of samples.
+  inline uint64_t count() const noexcept {return m_count;}
+
+  /// Get the sum of all samples.
+  inline std::chrono::nanoseconds total() const noexcept {return m_total;}
+
+  /// Get the mean of all samples, or zero if there are none.
+  inline std::chrono::nanoseconds mean() const noexcept
+  {
+    return (0U == m_count) ? std::chrono::nanoseconds{} :
+           (m_total / static_cast<std::chrono::nanoseconds::rep>(m_count));
+  }
+
+  /// Get the largest sample, or zero if there are none.
+  inline std::chrono::nanoseconds max() const noexcept {return m_max;}
+
+  ///
+  /// @brief      Get an upper bound of a quantile, i.e. the upper edge of the bin that contains it,
+  ///             but no more than the largest sample.
+  ///
+  /// @param[in]  quantile  The quantile in [0, 1], e.g. 0.99 for the 99th percentile.
+  ///
+  /// @return     The upper bound, or zero if there are no samples.
+  ///
+  inline std::chrono::nanoseconds quantile_upper_bound(const double quantile) const noexcept
+  {
+    // Nearest rank: the smallest sample such that at least this fraction of samples is not larger
+    const auto rank = std::max(
+      static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(m_count))), uint64_t{1U});
+    uint64_t seen = 0U;
+    for (std::size_t bin = 0U; bin < NUM_BINS; ++bin) {
+      seen += m_bins[bin];
+      if ((seen >= rank) || (seen == m_count)) {
+        const std::chrono::nanoseconds edge = std::chrono::microseconds{int64_t{1} << bin};
+        return std::min(edge, m_max);
+      }
+    }
+    return m_max;
+  }
+
+  /// Get the number of samples per bin.
+  inline const Bins & bins() const noexcept {return m_bins;}
+
+private:
+  friend class ConcurrentLatencyHistogram;
+
+  Bins m_bins{};
+  uint64_t m_count{0U};
+  std::chrono::nanoseconds m_total{0};
+  std::chrono::nanoseconds m_max{0};
+};
+
+///
+/// @brief      This class describes a histogram of latencies with the bins of LatencyHistogram,
+///             to which any number of threads can add samples at the same time. Adding a sample
+///             is lock-free and does not allocate memory. Each thread adds to one of NUM_SHARDS
+///             copies of the histogram, so that threads do not contend for the same cache line
+///             unless there are more of them than shards.
+///
+class TIME_UTILS_PUBLIC ConcurrentLatencyHistogram
+{
+public:
+  static constexpr std::size_t NUM_SHARDS = 8U;
+
+  /// Add a sample.
+  inline void add(const std::chrono::nanoseconds latency) noexcept
+  {
+    Shard & shard = m_shards[shard_index()];
+    shard.bins[LatencyHistogram::bin_of(latency)].fetch_add(1U, std::memory_order_relaxed);
+    shard.count.fetch_add(1U, std::memory_order_relaxed);
+    shard.total.fetch_add(latency.count(), std::memory_order_relaxed);
+    auto max = shard.max.load(std::memory_order_relaxed);
+    while ((latency.count() > max) &&
+      !shard.max.compare_exchange_weak(max, latency.count(), std::memory_order_relaxed))
+    {
+    }
+  }
+
+  ///
+  /// @brief      Get the sum of the samples of all threads so far. Samples which are added at
+  ///             the same time may be counted in some of the statistics but not yet in others.
+  ///
+  inline LatencyHistogram snapshot() const noexcept
+  {
+    LatencyHistogram histogram{};
+    for (const auto & shard : m_shards) {
+      for (std::size_t bin = 0U; bin < LatencyHistogram::NUM_BINS; ++bin) {
+        histogram.m_bins[bin] += shard.bins[bin].load(std::memory_order_relaxed);
+      }
+      histogram.m_count += shard.count.load(std::memory_order_relaxed);
+      histogram.m_total += std::chrono::nanoseconds{shard.total.load(std::memory_order_relaxed)};
+      histogram.m_max = std::max(
+        histogram.m_max, std::chrono::nanoseconds{shard.max.load(std::memory_order_relaxed)});
+    }
+    return histogram;
+  }
+
+private:
+  // The padding keeps the counters of neighboring shards at least a cache line apart, without
+  // over-aligned allocations
+  struct Shard
+  {
+    std::array<std::atomic<uint64_t>, LatencyHistogram::NUM_BINS> bins{};
+    std::atomic<uint64_t> count{0U};
+    std::atomic<int64_t> total{0};
+    std::atomic<int64_t> max{0};
+    std::array<uint8_t, 64U> padding{};
+  };
+
+  // Threads get consecutive shards in the order they first add a sample to any histogram
+  static inline std::size_t shard_index() noexcept
+  {
+    static std::atomic<std::size_t> next_shard{0U};
+    thread_local const std::size_t shard =
+      next_shard.fetch_add(1U, std::memory_order_relaxed) % NUM_SHARDS;
+    return shard;
+  }
+
+  std::array<Shard, NUM_SHARDS> m_shards{};
+};
+
+///
+/// @brief      This class adds the time from its construction to its destruction to a histogram.
+///             If the histogram is null, the clock is not read at all, so that instrumentation
+///             which is switched off costs a single branch.
+///
+class TIME_UTILS_PUBLIC ScopedLatency
+{
+  using Clock = std::chrono::steady_clock;
+
+public:
+  /// Start measuring if the histogram is not null.
+  explicit ScopedLatency(LatencyHistogram * const histogram) noexcept
+  : m_histogram{histogram},
+    m_start{(nullptr != histogram) ? Clock::now() : Clock::time_point{}}
+  {
+  }
+
+  /// Add the elapsed time to the histogram, if there is one.
+  ~ScopedLatency()
+  {
+    if (nullptr != m_histogram) {
+      m_histogram->add(Clock::now() - m_start);
+    }
+  }
+
+  ScopedLatency(const ScopedLatency &) = delete;
+  ScopedLatency & operator=(const ScopedLatency &) = delete;
+
+private:
+  LatencyHistogram * const m_histogram;
+  const Clock::time_point m_start;
+};
+
+}  // namespace time_utils
+}  // namespace common
+}  // namespace autoware
+
+#endif  // TIME_UTILS__LATENCY_HISTOGRAM_HPP_
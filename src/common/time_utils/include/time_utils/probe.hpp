@@ -0,0 +1,189 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#ifndef TIME_UTILS__PROBE_HPP_
+#define TIME_UTILS__PROBE_HPP_
+
+#include <time_utils/latency_histogram.hpp>
+#include <time_utils/visibility_control.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware
+{
+namespace common
+{
+namespace time_utils
+{
+
+///
+/// @brief      This class collects the latency histograms of the probes of a process.
+///
+///             The probes of the process are enabled if the environment variable AUTOWARE_PROBES
+///             is set to neither an empty string nor "0", or by set_enabled. If the environment
+///             variable AUTOWARE_TRACE_DIR is set to a directory, the summary of the probes is
+///             written to probes_<pid>.csv in that directory when the process exits, next to the
+///             trace of the Tracer.
+///
+class TIME_UTILS_PUBLIC ProbeRegistry
+{
+public:
+  using Snapshot = std::vector<std::pair<std::string, LatencyHistogram>>;
+
+  ///
+  /// @brief      Create a registry.
+  ///
+  /// @param[in]  enabled  Whether the probes record samples.
+  /// @param[in]  path     The file the summary is written to on destruction, none if empty.
+  ///
+  explicit ProbeRegistry(const bool enabled, const std::string & path = "");
+
+  /// Write the summary to the file given at construction, if any.
+  ~ProbeRegistry();
+
+  ProbeRegistry(const ProbeRegistry &) = delete;
+  ProbeRegistry & operator=(const ProbeRegistry &) = delete;
+
+  /// Get the registry of the process.
+  static ProbeRegistry & instance();
+
+  /// Whether the probes record samples.
+  inline bool enabled() const noexcept {return m_enabled.load(std::memory_order_relaxed);}
+
+  /// Switch recording on or off for all probes, e.g. from a parameter of a node.
+  inline void set_enabled(const bool enabled) noexcept
+  {
+    m_enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  ///
+  /// @brief      Get the histogram of a probe. Probes with the same name share a histogram. This
+  ///             takes a lock and allocates.
+  ///
+  ConcurrentLatencyHistogram & add_probe(const std::string & name);
+
+  /// Get the name and a copy of the histogram of every probe, in the order they were added.
+  Snapshot snapshot() const;
+
+  ///
+  /// @brief      Write the summary as CSV with the columns probe, count, mean_ns, p50_ns, p99_ns
+  ///             and max_ns, where p50 and p99 are upper bounds.
+  ///
+  void write(std::ostream & stream) const;
+
+private:
+  std::atomic<bool> m_enabled;
+  mutable std::mutex m_mutex;
+  // A deque does not move its elements when it grows
+  std::deque<std::pair<std::string, ConcurrentLatencyHistogram>> m_probes;
+  const std::string m_path;
+};
+
+///
+/// @brief      This class describes a named point in the code whose latency is measured, e.g. a
+///             step of the callback of a node. A probe is meant to be a static object, see
+///             AUTOWARE_PROBE_SCOPE. While the registry is disabled, a probe costs a single load
+///             and branch.
+///
+class TIME_UTILS_PUBLIC Probe
+{
+public:
+  /// Register the probe with the registry.
+  explicit Probe(const std::string & name, ProbeRegistry & registry = ProbeRegistry::instance())
+  : m_registry{registry}, m_histogram{registry.add_probe(name)}
+  {
+  }
+
+  /// Whether samples of this probe are recorded.
+  inline bool enabled() const noexcept {return m_registry.enabled();}
+
+  /// Add a sample, if the probe is enabled.
+  inline void add(const std::chrono::nanoseconds latency) noexcept
+  {
+    if (enabled()) {
+      m_histogram.add(latency);
+    }
+  }
+
+  /// Get a copy of the histogram of the probe.
+  inline LatencyHistogram snapshot() const noexcept {return m_histogram.snapshot();}
+
+private:
+  ProbeRegistry & m_registry;
+  ConcurrentLatencyHistogram & m_histogram;
+};
+
+///
+/// @brief      This class adds the time from its construction to its destruction to a probe. If
+///             the probe is disabled, the clock is not read at all.
+///
+class TIME_UTILS_PUBLIC ScopedProbe
+{
+  using Clock = std::chrono::steady_clock;
+
+public:
+  /// Start measuring if the probe is enabled.
+  explicit ScopedProbe(Probe & probe) noexcept
+  : m_probe{probe}, m_start{probe.enabled() ? Clock::now() : Clock::time_point{}}
+  {
+  }
+
+  /// Add the elapsed time to the probe, unless it was disabled at construction.
+  ~ScopedProbe()
+  {
+    if (Clock::time_point{} != m_start) {
+      m_probe.add(Clock::now() - m_start);
+    }
+  }
+
+  ScopedProbe(const ScopedProbe &) = delete;
+  ScopedProbe & operator=(const ScopedProbe &) = delete;
+
+private:
+  Probe & m_probe;
+  const Clock::time_point m_start;
+};
+
+}  // namespace time_utils
+}  // namespace common
+}  // namespace autoware
+
+#define TIME_UTILS_PROBE_CONCAT_IMPL(a, b) a ## b
+#define TIME_UTILS_PROBE_CONCAT(a, b) TIME_UTILS_PROBE_CONCAT_IMPL(a, b)
+
+///
+/// @brief      Measure the latency of the rest of the enclosing scope with a static probe of the
+///             given name. Defining AUTOWARE_TIME_UTILS_DISABLE_PROBES when compiling a target
+///             removes the probes of that target entirely.
+///
+#if defined(AUTOWARE_TIME_UTILS_DISABLE_PROBES)
+#define AUTOWARE_PROBE_SCOPE(name)
+#else
+#define AUTOWARE_PROBE_SCOPE(name) \
+  static ::autoware::common::time_utils::Probe TIME_UTILS_PROBE_CONCAT(time_utils_probe_, \
+    __LINE__){name}; \
+  const ::autoware::common::time_utils::ScopedProbe TIME_UTILS_PROBE_CONCAT( \
+    time_utils_scoped_probe_, __LINE__){TIME_UTILS_PROBE_CONCAT(time_utils_probe_, __LINE__)}
+#endif
+
+#endif  // TIME_UTILS__PROBE_HPP_
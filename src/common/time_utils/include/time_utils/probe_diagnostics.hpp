@@ -0,0 +1,111 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#ifndef TIME_UTILS__PROBE_DIAGNOSTICS_HPP_
+#define TIME_UTILS__PROBE_DIAGNOSTICS_HPP_
+
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+#include <diagnostic_msgs/msg/key_value.hpp>
+#include <time_utils/latency_histogram.hpp>
+#include <time_utils/probe.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace autoware
+{
+namespace common
+{
+namespace time_utils
+{
+
+///
+/// @brief      Make an empty diagnostic status for latencies, which are then added with
+///             add_latency_values.
+///
+/// @param[in]  name         The name of the status, e.g. the name of the node.
+/// @param[in]  hardware_id  The hardware id of the status, e.g. the name of the package.
+///
+/// @return     The status, whose level is OK.
+///
+inline diagnostic_msgs::msg::DiagnosticStatus make_latency_status(
+  const std::string & name, const std::string & hardware_id)
+{
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.name = name;
+  status.message = "Latencies in us since start; p50 and p99 are upper bounds";
+  status.hardware_id = hardware_id;
+  return status;
+}
+
+///
+/// @brief      Add the summary of a histogram to a diagnostic status: the count, mean, upper
+///             bounds of the 50th and 99th percentiles, and maximum in microseconds, with the
+///             keys <name>.count, <name>.mean, <name>.p50, <name>.p99 and <name>.max.
+///
+/// @param[in]  name       The name of the latency, used as the prefix of the keys.
+/// @param[in]  histogram  The latencies.
+/// @param[out] status     The status, whose values are appended to.
+///
+inline void add_latency_values(
+  const std::string & name, const LatencyHistogram & histogram,
+  diagnostic_msgs::msg::DiagnosticStatus & status)
+{
+  const auto add_value = [&status](const std::string & key, const int64_t value) {
+      diagnostic_msgs::msg::KeyValue key_value;
+      key_value.key = key;
+      key_value.value = std::to_string(value);
+      status.values.push_back(key_value);
+    };
+  const auto to_us = [](const std::chrono::nanoseconds duration) {
+      return static_cast<int64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    };
+  add_value(name + ".count", static_cast<int64_t>(histogram.count()));
+  add_value(name + ".mean", to_us(histogram.mean()));
+  add_value(name + ".p50", to_us(histogram.quantile_upper_bound(0.5)));
+  add_value(name + ".p99", to_us(histogram.quantile_upper_bound(0.99)));
+  add_value(name + ".max", to_us(histogram.max()));
+}
+
+///
+/// @brief      Summarize the probes of a registry in a diagnostic status, e.g. to be published
+///             periodically by a node. Each probe is added with add_latency_values.
+///
+/// @param[in]  name         The name of the status, e.g. the name of the node.
+/// @param[in]  hardware_id  The hardware id of the status, e.g. the name of the package.
+/// @param[in]  registry     The registry of the probes.
+///
+/// @return     The status, whose level is OK.
+///
+inline diagnostic_msgs::msg::DiagnosticStatus make_probe_diagnostics(
+  const std::string & name, const std::string & hardware_id,
+  const ProbeRegistry & registry = ProbeRegistry::instance())
+{
+  auto status = make_latency_status(name, hardware_id);
+  for (const auto & probe : registry.snapshot()) {
+    add_latency_values(probe.first, probe.second, status);
+  }
+  return status;
+}
+
+}  // namespace time_utils
+}  // namespace common
+}  // namespace autoware
+
+#endif  // TIME_UTILS__PROBE_DIAGNOSTICS_HPP_
@@ -0,0 +1,230 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#ifndef TIME_UTILS__TRACE_HPP_
+#define TIME_UTILS__TRACE_HPP_
+
+#include <time_utils/time_utils.hpp>
+#include <time_utils/visibility_control.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace common
+{
+namespace time_utils
+{
+
+///
+/// @brief      One pass of a message through a tracepoint. All times are since the epoch of the
+///             system clock, so that events of different processes can be compared with each
+///             other and with the stamps of the messages.
+///
+struct TraceEvent
+{
+  /// Stamp of the sensor data the message was made from, i.e. the stamp of its header.
+  std::chrono::nanoseconds source_stamp{0};
+  /// Time the node started to work on the message.
+  std::chrono::nanoseconds enter{0};
+  /// Time the node was done with the message, after publishing the result.
+  std::chrono::nanoseconds exit{0};
+  /// Index of the tracepoint in its Tracer.
+  uint32_t tracepoint{0U};
+};
+
+///
+/// @brief      This class describes a ring buffer of trace events with a fixed capacity.
+///             Recording an event is lock-free, wait-free and does not allocate memory, so it can
+///             be called from any number of threads. Old events are overwritten once the buffer is
+///             full. An event is dropped instead if the slot it goes to is still being written by
+///             another thread, or already holds a later event, which only happens if a thread
+///             stalled for a full turn of the buffer. The slot is used again in the next turn.
+///
+class TIME_UTILS_PUBLIC TraceBuffer
+{
+public:
+  /// Create a buffer for at least the given number of events, rounded up to a power of two.
+  explicit TraceBuffer(const std::size_t capacity);
+
+  /// Record an event.
+  void record(const TraceEvent & event) noexcept;
+
+  /// Get a copy of the events that are currently in the buffer, the oldest first.
+  std::vector<TraceEvent> snapshot() const;
+
+  /// Get the number of events recorded so far, including overwritten and dropped ones.
+  uint64_t num_recorded() const noexcept;
+
+  /// Get the number of events that were dropped.
+  uint64_t num_dropped() const noexcept;
+
+  /// Get the number of events the buffer holds.
+  std::size_t capacity() const noexcept;
+
+private:
+  // The sequence of a slot is odd while the event with index (sequence - 1) / 2 is written to it,
+  // and even once the event with index sequence / 2 - 1 is complete
+  struct Slot
+  {
+    std::atomic<uint64_t> sequence{0U};
+    std::atomic<int64_t> source_stamp{0};
+    std::atomic<int64_t> enter{0};
+    std::atomic<int64_t> exit{0};
+    std::atomic<uint32_t> tracepoint{0U};
+  };
+
+  std::unique_ptr<Slot[]> m_slots;
+  const std::size_t m_mask;
+  std::atomic<uint64_t> m_head{0U};
+  std::atomic<uint64_t> m_num_dropped{0U};
+};
+
+///
+/// @brief      This class collects the trace events of the tracepoints of a process.
+///
+///             The tracer of the process is created on first use if the environment variable
+///             AUTOWARE_TRACE_DIR is set to a directory. It then writes its events to
+///             trace_<pid>.csv in that directory when the process exits. The buffer holds the last
+///             AUTOWARE_TRACE_CAPACITY events, 65536 by default.
+///
+class TIME_UTILS_PUBLIC Tracer
+{
+public:
+  ///
+  /// @brief      Create a tracer.
+  ///
+  /// @param[in]  capacity  The tracer holds at least this number of events.
+  /// @param[in]  path      The file the events are written to on destruction, none if empty.
+  ///
+  explicit Tracer(const std::size_t capacity, const std::string & path = "");
+
+  /// Write the events to the file given at construction, if any.
+  ~Tracer();
+
+  Tracer(const Tracer &) = delete;
+  Tracer & operator=(const Tracer &) = delete;
+
+  /// Get the tracer of the process, or null if tracing is switched off.
+  static Tracer * instance();
+
+  /// Register a tracepoint and get its index. This takes a lock and allocates.
+  uint32_t add_tracepoint(const std::string & name);
+
+  /// Record an event of a tracepoint.
+  inline void record(const TraceEvent & event) noexcept {m_buffer.record(event);}
+
+  ///
+  /// @brief      Write the events as CSV with the columns tracepoint, source_stamp_ns, enter_ns
+  ///             and exit_ns, preceded by comment lines starting with '#'.
+  ///
+  void write(std::ostream & stream) const;
+
+  /// Get the buffer of the events.
+  inline const TraceBuffer & buffer() const noexcept {return m_buffer;}
+
+private:
+  TraceBuffer m_buffer;
+  mutable std::mutex m_mutex;
+  std::vector<std::string> m_tracepoints;
+  const std::string m_path;
+};
+
+///
+/// @brief      This class describes a named point in the code that messages pass through, e.g. the
+///             callback of a node. If the tracer is null, tracing costs a single branch.
+///
+class TIME_UTILS_PUBLIC TracePoint
+{
+public:
+  using Clock = std::chrono::system_clock;
+
+  /// Register the tracepoint with the tracer, unless it is null.
+  explicit TracePoint(const std::string & name, Tracer * const tracer = Tracer::instance());
+
+  /// Whether events of this tracepoint are recorded.
+  inline bool enabled() const noexcept {return nullptr != m_tracer;}
+
+  /// Record an event, if tracing is enabled.
+  inline void record(
+    const builtin_interfaces::msg::Time & source_stamp, const Clock::time_point enter,
+    const Clock::time_point exit) const noexcept
+  {
+    if (enabled()) {
+      m_tracer->record(
+        TraceEvent{::time_utils::from_message(source_stamp).time_since_epoch(),
+          enter.time_since_epoch(), exit.time_since_epoch(), m_index});
+    }
+  }
+
+  /// Record an event which enters and exits now, e.g. when a driver publishes new data.
+  inline void mark(const builtin_interfaces::msg::Time & source_stamp) const noexcept
+  {
+    if (enabled()) {
+      const auto now = Clock::now();
+      record(source_stamp, now, now);
+    }
+  }
+
+private:
+  Tracer * const m_tracer;
+  const uint32_t m_index;
+};
+
+///
+/// @brief      This class records the time from its construction to its destruction as an event
+///             of a tracepoint. If tracing is switched off, the clock is not read at all.
+///
+class TIME_UTILS_PUBLIC ScopedTrace
+{
+public:
+  /// Start the event of a message with the given source stamp.
+  ScopedTrace(
+    const TracePoint & tracepoint, const builtin_interfaces::msg::Time & source_stamp) noexcept
+  : m_tracepoint{tracepoint}, m_source_stamp{source_stamp},
+    m_enter{tracepoint.enabled() ? TracePoint::Clock::now() : TracePoint::Clock::time_point{}}
+  {
+  }
+
+  /// Record the event.
+  ~ScopedTrace()
+  {
+    if (m_tracepoint.enabled()) {
+      m_tracepoint.record(m_source_stamp, m_enter, TracePoint::Clock::now());
+    }
+  }
+
+  ScopedTrace(const ScopedTrace &) = delete;
+  ScopedTrace & operator=(const ScopedTrace &) = delete;
+
+private:
+  const TracePoint & m_tracepoint;
+  const builtin_interfaces::msg::Time m_source_stamp;
+  const TracePoint::Clock::time_point m_enter;
+};
+
+}  // namespace time_utils
+}  // namespace common
+}  // namespace autoware
+
+#endif  // TIME_UTILS__TRACE_HPP_
@@ -0,0 +1,111 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include "time_utils/probe.hpp"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace autoware
+{
+namespace common
+{
+namespace time_utils
+{
+namespace
+{
+std::unique_ptr<ProbeRegistry> make_process_registry()
+{
+  const char * const enabled = std::getenv("AUTOWARE_PROBES");
+  const char * const dir = std::getenv("AUTOWARE_TRACE_DIR");
+  std::string path{};
+  if ((nullptr != dir) && ('\0' != dir[0])) {
+    path = std::string{dir} + "/probes_" + std::to_string(static_cast<int64_t>(::getpid())) +
+      ".csv";
+  }
+  return std::make_unique<ProbeRegistry>(
+    (nullptr != enabled) && ('\0' != enabled[0]) && (std::string{enabled} != "0"), path);
+}
+}  // namespace
+
+ProbeRegistry::ProbeRegistry(const bool enabled, const std::string & path)
+: m_enabled{enabled}, m_path{path}
+{
+}
+
+ProbeRegistry::~ProbeRegistry()
+{
+  if (m_path.empty()) {
+    return;
+  }
+  try {
+    std::ofstream file{m_path};
+    write(file);
+  } catch (...) {
+    // A summary that can not be written must not take the process down while it exits
+  }
+}
+
+ProbeRegistry & ProbeRegistry::instance()
+{
+  static const std::unique_ptr<ProbeRegistry> registry = make_process_registry();
+  return *registry;
+}
+
+ConcurrentLatencyHistogram & ProbeRegistry::add_probe(const std::string & name)
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  for (auto & probe : m_probes) {
+    if (probe.first == name) {
+      return probe.second;
+    }
+  }
+  m_probes.emplace_back(
+    std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple());
+  return m_probes.back().second;
+}
+
+ProbeRegistry::Snapshot ProbeRegistry::snapshot() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  Snapshot snapshot{};
+  snapshot.reserve(m_probes.size());
+  for (const auto & probe : m_probes) {
+    snapshot.emplace_back(probe.first, probe.second.snapshot());
+  }
+  return snapshot;
+}
+
+void ProbeRegistry::write(std::ostream & stream) const
+{
+  stream << "probe,count,mean_ns,p50_ns,p99_ns,max_ns\n";
+  for (const auto & probe : snapshot()) {
+    const auto & histogram = probe.second;
+    stream << probe.first << "," << histogram.count() << "," << histogram.mean().count() << "," <<
+      histogram.quantile_upper_bound(0.5).count() << "," <<
+      histogram.quantile_upper_bound(0.99).count() << "," << histogram.max().count() << "\n";
+  }
+}
+
+}  // namespace time_utils
+}  // namespace common
+}  // namespace autoware
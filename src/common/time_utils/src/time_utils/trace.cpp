@@ -0,0 +1,190 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include "time_utils/trace.hpp"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace common
+{
+namespace time_utils
+{
+namespace
+{
+constexpr std::size_t DEFAULT_TRACE_CAPACITY = 65536U;
+
+std::size_t round_up_to_power_of_two(const std::size_t value)
+{
+  std::size_t result = 1U;
+  while (result < value) {
+    result <<= 1U;
+  }
+  return result;
+}
+
+std::unique_ptr<Tracer> make_process_tracer()
+{
+  const char * const dir = std::getenv("AUTOWARE_TRACE_DIR");
+  if ((nullptr == dir) || ('\0' == dir[0])) {
+    return nullptr;
+  }
+  std::size_t capacity = DEFAULT_TRACE_CAPACITY;
+  const char * const capacity_str = std::getenv("AUTOWARE_TRACE_CAPACITY");
+  if (nullptr != capacity_str) {
+    const auto parsed = std::strtoull(capacity_str, nullptr, 10);
+    if (parsed > 0U) {
+      capacity = static_cast<std::size_t>(parsed);
+    }
+  }
+  const std::string path =
+    std::string{dir} + "/trace_" + std::to_string(static_cast<int64_t>(::getpid())) + ".csv";
+  return std::make_unique<Tracer>(capacity, path);
+}
+}  // namespace
+
+TraceBuffer::TraceBuffer(const std::size_t capacity)
+: m_slots{new Slot[round_up_to_power_of_two(capacity)]},
+  m_mask{round_up_to_power_of_two(capacity) - 1U}
+{
+}
+
+void TraceBuffer::record(const TraceEvent & event) noexcept
+{
+  const uint64_t index = m_head.fetch_add(1U, std::memory_order_relaxed);
+  Slot & slot = m_slots[index & m_mask];
+  // The slot must hold a complete event of an earlier turn. That need not be the previous turn,
+  // whose event may have been dropped, so that one drop does not make all later turns drop too
+  uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  if ((0U != (sequence & 1U)) || (sequence > (2U * index)) ||
+    !slot.sequence.compare_exchange_strong(
+      sequence, (2U * index) + 1U, std::memory_order_relaxed))
+  {
+    m_num_dropped.fetch_add(1U, std::memory_order_relaxed);
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.source_stamp.store(event.source_stamp.count(), std::memory_order_relaxed);
+  slot.enter.store(event.enter.count(), std::memory_order_relaxed);
+  slot.exit.store(event.exit.count(), std::memory_order_relaxed);
+  slot.tracepoint.store(event.tracepoint, std::memory_order_relaxed);
+  slot.sequence.store(2U * (index + 1U), std::memory_order_release);
+}
+
+std::vector<TraceEvent> TraceBuffer::snapshot() const
+{
+  const uint64_t head = m_head.load(std::memory_order_acquire);
+  const uint64_t begin = (head > capacity()) ? (head - capacity()) : 0U;
+  std::vector<TraceEvent> events;
+  events.reserve(static_cast<std::size_t>(head - begin));
+  for (uint64_t index = begin; index < head; ++index) {
+    const Slot & slot = m_slots[index & m_mask];
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    // Skip events which are still being written or were dropped
+    if (sequence != (2U * (index + 1U))) {
+      continue;
+    }
+    TraceEvent event{};
+    event.source_stamp =
+      std::chrono::nanoseconds{slot.source_stamp.load(std::memory_order_relaxed)};
+    event.enter = std::chrono::nanoseconds{slot.enter.load(std::memory_order_relaxed)};
+    event.exit = std::chrono::nanoseconds{slot.exit.load(std::memory_order_relaxed)};
+    event.tracepoint = slot.tracepoint.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Skip events which were overwritten while they were copied
+    if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+      events.push_back(event);
+    }
+  }
+  return events;
+}
+
+uint64_t TraceBuffer::num_recorded() const noexcept
+{
+  return m_head.load(std::memory_order_relaxed);
+}
+
+uint64_t TraceBuffer::num_dropped() const noexcept
+{
+  return m_num_dropped.load(std::memory_order_relaxed);
+}
+
+std::size_t TraceBuffer::capacity() const noexcept
+{
+  return m_mask + 1U;
+}
+
+Tracer::Tracer(const std::size_t capacity, const std::string & path)
+: m_buffer{capacity}, m_path{path}
+{
+}
+
+Tracer::~Tracer()
+{
+  if (m_path.empty()) {
+    return;
+  }
+  try {
+    std::ofstream file{m_path};
+    write(file);
+  } catch (...) {
+    // A trace that can not be written must not take the process down while it exits
+  }
+}
+
+Tracer * Tracer::instance()
+{
+  static const std::unique_ptr<Tracer> tracer = make_process_tracer();
+  return tracer.get();
+}
+
+uint32_t Tracer::add_tracepoint(const std::string & name)
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  m_tracepoints.push_back(name);
+  return static_cast<uint32_t>(m_tracepoints.size() - 1U);
+}
+
+void Tracer::write(std::ostream & stream) const
+{
+  const auto events = m_buffer.snapshot();
+  std::lock_guard<std::mutex> lock{m_mutex};
+  stream << "# recorded " << m_buffer.num_recorded() << ", dropped " << m_buffer.num_dropped() <<
+    ", capacity " << m_buffer.capacity() << "\n";
+  stream << "tracepoint,source_stamp_ns,enter_ns,exit_ns\n";
+  for (const auto & event : events) {
+    if (event.tracepoint < m_tracepoints.size()) {
+      stream << m_tracepoints[event.tracepoint] << "," << event.source_stamp.count() << "," <<
+        event.enter.count() << "," << event.exit.count() << "\n";
+    }
+  }
+}
+
+TracePoint::TracePoint(const std::string & name, Tracer * const tracer)
+: m_tracer{tracer}, m_index{(nullptr != tracer) ? tracer->add_tracepoint(name) : 0U}
+{
+}
+
+}  // namespace time_utils
+}  // namespace common
+}  // namespace autoware
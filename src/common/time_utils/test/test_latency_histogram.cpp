@@ -0,0 +1,96 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <gtest/gtest.h>
+#include <time_utils/latency_histogram.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+using autoware::common::time_utils::LatencyHistogram;
+using autoware::common::time_utils::ScopedLatency;
+using std::chrono::hours;
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+TEST(TestLatencyHistogram, Bins)
+{
+  EXPECT_EQ(LatencyHistogram::bin_of(nanoseconds{-5}), 0U);
+  EXPECT_EQ(LatencyHistogram::bin_of(nanoseconds{0}), 0U);
+  EXPECT_EQ(LatencyHistogram::bin_of(nanoseconds{999}), 0U);
+  EXPECT_EQ(LatencyHistogram::bin_of(microseconds{1}), 1U);
+  EXPECT_EQ(LatencyHistogram::bin_of(nanoseconds{1999}), 1U);
+  EXPECT_EQ(LatencyHistogram::bin_of(microseconds{2}), 2U);
+  EXPECT_EQ(LatencyHistogram::bin_of(microseconds{3}), 2U);
+  EXPECT_EQ(LatencyHistogram::bin_of(microseconds{4}), 3U);
+  EXPECT_EQ(LatencyHistogram::bin_of(microseconds{1023}), 10U);
+  EXPECT_EQ(LatencyHistogram::bin_of(microseconds{1024}), 11U);
+  // The last bin also counts all longer latencies
+  EXPECT_EQ(
+    LatencyHistogram::bin_of(microseconds{int64_t{1} << 30U}), LatencyHistogram::NUM_BINS - 1U);
+  EXPECT_EQ(LatencyHistogram::bin_of(hours{24}), LatencyHistogram::NUM_BINS - 1U);
+}
+
+TEST(TestLatencyHistogram, Statistics)
+{
+  LatencyHistogram histogram{};
+  EXPECT_EQ(histogram.count(), 0U);
+  EXPECT_EQ(histogram.mean(), nanoseconds{0});
+  EXPECT_EQ(histogram.max(), nanoseconds{0});
+  EXPECT_EQ(histogram.quantile_upper_bound(0.5), nanoseconds{0});
+
+  // 1 to 100 us
+  for (int64_t us = 1; us <= 100; ++us) {
+    histogram.add(microseconds{us});
+  }
+  EXPECT_EQ(histogram.count(), 100U);
+  EXPECT_EQ(histogram.total(), microseconds{5050});
+  EXPECT_EQ(histogram.mean(), nanoseconds{50500});
+  EXPECT_EQ(histogram.max(), microseconds{100});
+  EXPECT_EQ(histogram.bins()[1U], 1U);
+  EXPECT_EQ(histogram.bins()[7U], 37U);
+
+  // The bounds are the upper edges of the bins of the quantiles, capped by the largest sample
+  EXPECT_EQ(histogram.quantile_upper_bound(0.0), microseconds{2});
+  EXPECT_EQ(histogram.quantile_upper_bound(0.01), microseconds{2});
+  EXPECT_EQ(histogram.quantile_upper_bound(0.5), microseconds{64});
+  EXPECT_EQ(histogram.quantile_upper_bound(0.63), microseconds{64});
+  EXPECT_EQ(histogram.quantile_upper_bound(0.64), microseconds{100});
+  EXPECT_EQ(histogram.quantile_upper_bound(0.99), microseconds{100});
+  EXPECT_EQ(histogram.quantile_upper_bound(1.0), microseconds{100});
+  for (const double quantile : {0.1, 0.5, 0.9, 0.99}) {
+    EXPECT_GE(
+      histogram.quantile_upper_bound(quantile),
+      microseconds{static_cast<int64_t>(quantile * 100.0)});
+  }
+
+  histogram.reset();
+  EXPECT_EQ(histogram.count(), 0U);
+  EXPECT_EQ(histogram.bins(), LatencyHistogram::Bins{});
+}
+
+TEST(TestLatencyHistogram, ScopedLatency)
+{
+  LatencyHistogram histogram{};
+  {
+    const ScopedLatency latency{&histogram};
+  }
+  EXPECT_EQ(histogram.count(), 1U);
+  {
+    const ScopedLatency latency{nullptr};
+  }
+  EXPECT_EQ(histogram.count(), 1U);
+}
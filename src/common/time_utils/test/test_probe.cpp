@@ -0,0 +1,115 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <gtest/gtest.h>
+#include <time_utils/probe.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using autoware::common::time_utils::ConcurrentLatencyHistogram;
+using autoware::common::time_utils::LatencyHistogram;
+using autoware::common::time_utils::Probe;
+using autoware::common::time_utils::ProbeRegistry;
+using autoware::common::time_utils::ScopedProbe;
+
+namespace
+{
+// A spread of latencies from below 1 us to several seconds
+std::chrono::nanoseconds sample(const uint32_t thread_idx, const uint32_t idx)
+{
+  return std::chrono::nanoseconds{(int64_t{idx} * 7919) % (int64_t{1} << (idx % 33U))} +
+         std::chrono::nanoseconds{thread_idx};
+}
+}  // namespace
+
+TEST(TestConcurrentLatencyHistogram, ShardsSumToOneHistogram)
+{
+  constexpr uint32_t NUM_THREADS = 2U * ConcurrentLatencyHistogram::NUM_SHARDS;
+  constexpr uint32_t NUM_SAMPLES = 5000U;
+  ConcurrentLatencyHistogram concurrent{};
+  std::vector<std::thread> threads;
+  for (uint32_t thread_idx = 0U; thread_idx < NUM_THREADS; ++thread_idx) {
+    threads.emplace_back(
+      [&concurrent, thread_idx] {
+        for (uint32_t idx = 0U; idx < NUM_SAMPLES; ++idx) {
+          concurrent.add(sample(thread_idx, idx));
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  LatencyHistogram expected{};
+  for (uint32_t thread_idx = 0U; thread_idx < NUM_THREADS; ++thread_idx) {
+    for (uint32_t idx = 0U; idx < NUM_SAMPLES; ++idx) {
+      expected.add(sample(thread_idx, idx));
+    }
+  }
+  const auto histogram = concurrent.snapshot();
+  EXPECT_EQ(histogram.count(), expected.count());
+  EXPECT_EQ(histogram.total(), expected.total());
+  EXPECT_EQ(histogram.max(), expected.max());
+  EXPECT_EQ(histogram.bins(), expected.bins());
+  EXPECT_EQ(histogram.quantile_upper_bound(0.99), expected.quantile_upper_bound(0.99));
+}
+
+TEST(TestProbeRegistry, AddProbe)
+{
+  ProbeRegistry registry{false};
+  auto & first = registry.add_probe("first");
+  auto & second = registry.add_probe("second");
+  // Probes with the same name share a histogram
+  EXPECT_EQ(&registry.add_probe("first"), &first);
+  EXPECT_NE(&first, &second);
+
+  Probe probe{"first", registry};
+  Probe other{"second", registry};
+  // Nothing is recorded while the registry is disabled
+  EXPECT_FALSE(probe.enabled());
+  probe.add(std::chrono::microseconds{3});
+  {
+    ScopedProbe scoped{probe};
+  }
+  EXPECT_EQ(probe.snapshot().count(), 0U);
+
+  registry.set_enabled(true);
+  EXPECT_TRUE(probe.enabled());
+  probe.add(std::chrono::microseconds{3});
+  {
+    ScopedProbe scoped{other};
+  }
+  EXPECT_EQ(first.snapshot().count(), 1U);
+  EXPECT_EQ(first.snapshot().max(), std::chrono::microseconds{3});
+  EXPECT_EQ(other.snapshot().count(), 1U);
+
+  // In the order the probes were added
+  const auto snapshot = registry.snapshot();
+  ASSERT_EQ(snapshot.size(), 2U);
+  EXPECT_EQ(snapshot[0U].first, "first");
+  EXPECT_EQ(snapshot[0U].second.count(), 1U);
+  EXPECT_EQ(snapshot[1U].first, "second");
+
+  std::stringstream stream;
+  registry.write(stream);
+  EXPECT_EQ(
+    stream.str().substr(0U, stream.str().find("second")),
+    "probe,count,mean_ns,p50_ns,p99_ns,max_ns\nfirst,1,3000,3000,3000,3000\n");
+}
@@ -0,0 +1,181 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <gtest/gtest.h>
+#include <time_utils/trace.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using autoware::common::time_utils::ScopedTrace;
+using autoware::common::time_utils::TraceBuffer;
+using autoware::common::time_utils::TraceEvent;
+using autoware::common::time_utils::TracePoint;
+using autoware::common::time_utils::Tracer;
+
+namespace
+{
+// An event whose fields can be checked against each other
+TraceEvent make_event(const uint32_t tracepoint)
+{
+  TraceEvent event{};
+  event.source_stamp = std::chrono::nanoseconds{tracepoint};
+  event.enter = std::chrono::nanoseconds{2 * static_cast<int64_t>(tracepoint)};
+  event.exit = std::chrono::nanoseconds{3 * static_cast<int64_t>(tracepoint)};
+  event.tracepoint = tracepoint;
+  return event;
+}
+
+bool is_consistent(const TraceEvent & event)
+{
+  return make_event(event.tracepoint).source_stamp == event.source_stamp &&
+         make_event(event.tracepoint).enter == event.enter &&
+         make_event(event.tracepoint).exit == event.exit;
+}
+}  // namespace
+
+TEST(TestTraceBuffer, WrapAround)
+{
+  TraceBuffer buffer{3U};
+  EXPECT_EQ(buffer.capacity(), 4U);
+  EXPECT_TRUE(buffer.snapshot().empty());
+  for (uint32_t idx = 0U; idx < 10U; ++idx) {
+    buffer.record(make_event(idx));
+  }
+  EXPECT_EQ(buffer.num_recorded(), 10U);
+  EXPECT_EQ(buffer.num_dropped(), 0U);
+  // Only the last turn is kept, the oldest first
+  const auto events = buffer.snapshot();
+  ASSERT_EQ(events.size(), 4U);
+  for (uint32_t idx = 0U; idx < 4U; ++idx) {
+    EXPECT_EQ(events[idx].tracepoint, 6U + idx);
+    EXPECT_TRUE(is_consistent(events[idx]));
+  }
+}
+
+TEST(TestTraceBuffer, DropRecovers)
+{
+  // With a single slot, every event which overlaps with another one is dropped
+  TraceBuffer buffer{1U};
+  std::atomic<bool> done{false};
+  std::vector<std::thread> threads;
+  for (uint32_t thread_idx = 0U; thread_idx < 4U; ++thread_idx) {
+    threads.emplace_back(
+      [&buffer, &done] {
+        for (uint32_t idx = 0U; !done.load(); ++idx) {
+          buffer.record(make_event(idx));
+        }
+      });
+  }
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+  while ((0U == buffer.num_dropped()) && (std::chrono::steady_clock::now() < deadline)) {
+    std::this_thread::yield();
+  }
+  done.store(true);
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_GT(buffer.num_dropped(), 0U);
+
+  // The slot is written again by the following events
+  const auto num_dropped = buffer.num_dropped();
+  for (uint32_t idx = 1000U; idx < 1010U; ++idx) {
+    buffer.record(make_event(idx));
+    const auto events = buffer.snapshot();
+    ASSERT_EQ(events.size(), 1U);
+    EXPECT_EQ(events[0U].tracepoint, idx);
+  }
+  EXPECT_EQ(buffer.num_dropped(), num_dropped);
+}
+
+TEST(TestTraceBuffer, ConcurrentRecordAndSnapshot)
+{
+  constexpr uint32_t NUM_THREADS = 4U;
+  constexpr uint32_t NUM_EVENTS = 20000U;
+  TraceBuffer buffer{64U};
+  std::vector<std::thread> threads;
+  for (uint32_t thread_idx = 0U; thread_idx < NUM_THREADS; ++thread_idx) {
+    threads.emplace_back(
+      [&buffer, thread_idx] {
+        for (uint32_t idx = 0U; idx < NUM_EVENTS; ++idx) {
+          buffer.record(make_event((thread_idx * NUM_EVENTS) + idx));
+        }
+      });
+  }
+  // Snapshots never contain partially written events
+  while (buffer.num_recorded() < (NUM_THREADS * NUM_EVENTS)) {
+    const auto events = buffer.snapshot();
+    EXPECT_LE(events.size(), buffer.capacity());
+    for (const auto & event : events) {
+      EXPECT_TRUE(is_consistent(event));
+    }
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(buffer.num_recorded(), NUM_THREADS * NUM_EVENTS);
+  const auto events = buffer.snapshot();
+  EXPECT_FALSE(events.empty());
+  EXPECT_LE(events.size(), buffer.capacity());
+  for (const auto & event : events) {
+    EXPECT_TRUE(is_consistent(event));
+  }
+}
+
+TEST(TestTracer, ScopedTrace)
+{
+  Tracer tracer{16U};
+  const TracePoint callback{"callback", &tracer};
+  const TracePoint driver{"driver", &tracer};
+  EXPECT_TRUE(callback.enabled());
+  builtin_interfaces::msg::Time stamp;
+  stamp.sec = 12;
+  stamp.nanosec = 345U;
+  {
+    const ScopedTrace trace{callback, stamp};
+  }
+  driver.mark(stamp);
+
+  const auto events = tracer.buffer().snapshot();
+  ASSERT_EQ(events.size(), 2U);
+  EXPECT_EQ(events[0U].tracepoint, 0U);
+  EXPECT_EQ(events[1U].tracepoint, 1U);
+  for (const auto & event : events) {
+    EXPECT_EQ(event.source_stamp, std::chrono::nanoseconds{12000000345LL});
+    EXPECT_LE(event.enter, event.exit);
+  }
+  EXPECT_EQ(events[1U].enter, events[1U].exit);
+
+  std::stringstream stream;
+  tracer.write(stream);
+  const auto csv = stream.str();
+  EXPECT_NE(csv.find("# recorded 2, dropped 0, capacity 16"), std::string::npos);
+  EXPECT_NE(csv.find("callback,12000000345,"), std::string::npos);
+  EXPECT_NE(csv.find("driver,12000000345,"), std::string::npos);
+
+  // Without a tracer, nothing is recorded
+  const TracePoint disabled{"disabled", nullptr};
+  EXPECT_FALSE(disabled.enabled());
+  {
+    const ScopedTrace trace{disabled, stamp};
+  }
+  disabled.mark(stamp);
+  EXPECT_EQ(tracer.buffer().num_recorded(), 2U);
+}
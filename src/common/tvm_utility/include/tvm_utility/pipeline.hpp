@@ -13,15 +13,26 @@
 // limitations under the License.
 
 #include <ament_index_cpp/get_package_share_directory.hpp>
+#include <time_utils/latency_histogram.hpp>
 #include <tvm_vendor/dlpack/dlpack.h>
 #include <tvm_vendor/tvm/runtime/c_runtime_api.h>
 #include <tvm_vendor/tvm/runtime/module.h>
 #include <tvm_vendor/tvm/runtime/packed_func.h>
 #include <tvm_vendor/tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -118,6 +129,16 @@ class InferenceEngine : public PipelineStage<TVMArrayContainerVector, TVMArrayCo
 template<class OutputType>
 class PostProcessor : public PipelineStage<TVMArrayContainerVector, OutputType> {};
 
+/**
+ * @brief Latencies of the stages of a Pipeline, see Pipeline::enableProfiling
+ */
+typedef struct
+{
+  autoware::common::time_utils::LatencyHistogram pre_processor;
+  autoware::common::time_utils::LatencyHistogram inference_engine;
+  autoware::common::time_utils::LatencyHistogram post_processor;
+} PipelineProfile;
+
 /**
  * @class Pipeline
  * @brief Inference Pipeline. Consists of 3 stages: preprocessor, inference
@@ -127,6 +148,10 @@ template<class PreProcessorType, class InferenceEngineType, class PostProcessorT
 class Pipeline
 {
   using InputType = decltype(std::declval<PreProcessorType>().input_type_indicator_);
+  using PreProcessorOutputType =
+    decltype(std::declval<PreProcessorType>().output_type_indicator_);
+  using InferenceEngineOutputType =
+    decltype(std::declval<InferenceEngineType>().output_type_indicator_);
   using OutputType = decltype(std::declval<PostProcessorType>().output_type_indicator_);
 
 public:
@@ -152,15 +177,315 @@ public:
    */
   OutputType schedule(const InputType & input)
   {
-    auto input_tensor = pre_processor_.schedule(input);
-    auto output_tensor = inference_engine_.schedule(input_tensor);
+    using autoware::common::time_utils::ScopedLatency;
+    PipelineProfile * const profile = profile_.get();
+    PreProcessorOutputType input_tensor{};
+    {
+      ScopedLatency latency{profile ? &profile->pre_processor : nullptr};
+      input_tensor = pre_processor_.schedule(input);
+    }
+    InferenceEngineOutputType output_tensor{};
+    {
+      ScopedLatency latency{profile ? &profile->inference_engine : nullptr};
+      output_tensor = inference_engine_.schedule(input_tensor);
+    }
+    ScopedLatency latency{profile ? &profile->post_processor : nullptr};
     return post_processor_.schedule(output_tensor);
   }
 
+  /**
+   * @brief Start measuring the latency of each stage in every call to
+   * schedule. Until then, the clock is not read at all.
+   */
+  void enableProfiling()
+  {
+    if (!profile_) {
+      profile_ = std::make_unique<PipelineProfile>();
+    }
+  }
+
+  /**
+   * @brief Get the latencies of the stages since profiling was enabled, or
+   * null if it is not enabled
+   */
+  const PipelineProfile * getProfile() const {return profile_.get();}
+
 private:
   PreProcessorType pre_processor_{};
   InferenceEngineType inference_engine_{};
   PostProcessorType post_processor_{};
+  std::unique_ptr<PipelineProfile> profile_{};
+};
+
+/**
+ * @class StageHandoff
+ * @brief Hands one item at a time from a pipeline stage to the next one. The
+ * slot stays occupied until the consumer has finished processing the item, so
+ * that a producer which alternates between two output buffers never overwrites
+ * a buffer that is still being read.
+ *
+ * @tparam T The data type of the handed over item.
+ */
+template<class T>
+class StageHandoff
+{
+public:
+  /**
+   * @brief Wait for the slot to be free and put an item into it.
+   *
+   * @param item The item to hand over.
+   * @return false if the handoff was closed, in which case the item is dropped.
+   */
+  bool put(T item)
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    condition_.wait(lock, [this] {return !occupied_ || closed_;});
+    if (closed_) {
+      return false;
+    }
+    item_ = std::move(item);
+    occupied_ = true;
+    taken_ = false;
+    condition_.notify_all();
+    return true;
+  }
+
+  /**
+   * @brief Wait for an item. The slot stays occupied until release is called.
+   *
+   * @param item Set to the handed over item.
+   * @return false if the handoff was closed.
+   */
+  bool take(T & item)
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    condition_.wait(lock, [this] {return (occupied_ && !taken_) || closed_;});
+    if (closed_) {
+      return false;
+    }
+    item = std::move(item_);
+    taken_ = true;
+    return true;
+  }
+
+  /**
+   * @brief Free the slot after the taken item was processed.
+   */
+  void release()
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    occupied_ = false;
+    condition_.notify_all();
+  }
+
+  /**
+   * @brief Wake up and fail all current and future calls to put and take.
+   */
+  void close()
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    closed_ = true;
+    condition_.notify_all();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  T item_{};
+  bool occupied_{false};
+  bool taken_{false};
+  bool closed_{false};
+};
+
+/**
+ * @class AsyncPipeline
+ * @brief Inference Pipeline which runs each of its 3 stages in its own thread,
+ * so that the pre-processing of an input overlaps with the inference of the
+ * previous input and the post-processing of the one before. The throughput
+ * approaches that of the slowest stage.
+ *
+ * Consecutive stages are connected by a StageHandoff, which holds a single
+ * item. An input therefore waits for at most one other input before each
+ * stage. Since a stage can produce its next output while the next stage still
+ * reads the previous one, the pre-processor and the inference engine have to
+ * alternate between (at least) two output buffers instead of reusing the same
+ * TVMArrayContainer for every call, e.g. InferenceEngineTVM with 2 output
+ * buffers. Stages must not share data with each other, such as an input that
+ * is read again by the post-processor.
+ *
+ * Outputs are passed to a callback, in the order of the inputs, from the
+ * thread of the post-processor.
+ */
+template<class PreProcessorType, class InferenceEngineType, class PostProcessorType>
+class AsyncPipeline
+{
+  using InputType = decltype(std::declval<PreProcessorType>().input_type_indicator_);
+  using PreProcessorOutputType =
+    decltype(std::declval<PreProcessorType>().output_type_indicator_);
+  using InferenceEngineOutputType =
+    decltype(std::declval<InferenceEngineType>().output_type_indicator_);
+  using OutputType = decltype(std::declval<PostProcessorType>().output_type_indicator_);
+
+public:
+  using OutputCallback = std::function<void (OutputType)>;
+
+  /**
+   * @brief Construct a new AsyncPipeline object and start the threads of the
+   * stages
+   *
+   * @param pre_processor a PreProcessor object
+   * @param inference_engine a InferenceEngine object
+   * @param post_processor a PostProcessor object
+   * @param callback Called with the output of each input
+   */
+  AsyncPipeline(
+    PreProcessorType pre_processor, InferenceEngineType inference_engine,
+    PostProcessorType post_processor, OutputCallback callback)
+  : pre_processor_(pre_processor),
+    inference_engine_(inference_engine),
+    post_processor_(post_processor),
+    callback_(callback)
+  {
+    pre_processor_thread_ = std::thread{[this] {
+          run_stage(input_, pre_processor_, pre_processor_output_);
+        }};
+    inference_engine_thread_ = std::thread{[this] {
+          run_stage(pre_processor_output_, inference_engine_, inference_engine_output_);
+        }};
+    post_processor_thread_ = std::thread{[this] {run_post_processor();}};
+  }
+
+  AsyncPipeline(const AsyncPipeline &) = delete;
+  AsyncPipeline & operator=(const AsyncPipeline &) = delete;
+
+  /**
+   * @brief Stop the stages. Inputs which are not processed yet are dropped.
+   */
+  ~AsyncPipeline()
+  {
+    close();
+    pre_processor_thread_.join();
+    inference_engine_thread_.join();
+    post_processor_thread_.join();
+  }
+
+  /**
+   * @brief push an input into the pipeline. Blocks while the pre-processor is
+   * busy with the previous input.
+   *
+   * @param input The data to push into the pipeline
+   * @throw The exception thrown by a stage for an earlier input, after which
+   * the pipeline does not process any input anymore
+   */
+  void schedule(const InputType & input)
+  {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      rethrow_error();
+      ++num_scheduled_;
+    }
+    if (!input_.put(input)) {
+      std::lock_guard<std::mutex> lock{mutex_};
+      rethrow_error();
+    }
+  }
+
+  /**
+   * @brief Wait until the outputs of all scheduled inputs were passed to the
+   * callback.
+   *
+   * @throw The exception thrown by a stage, if any
+   */
+  void flush()
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    done_condition_.wait(lock, [this] {return (num_done_ == num_scheduled_) || error_;});
+    rethrow_error();
+  }
+
+private:
+  template<class StageInputType, class StageType, class StageOutputType>
+  void run_stage(
+    StageHandoff<StageInputType> & input, StageType & stage,
+    StageHandoff<StageOutputType> & output)
+  {
+    StageInputType item{};
+    while (input.take(item)) {
+      try {
+        auto result = stage.schedule(item);
+        input.release();
+        if (!output.put(std::move(result))) {
+          return;
+        }
+      } catch (...) {
+        set_error(std::current_exception());
+        return;
+      }
+    }
+  }
+
+  void run_post_processor()
+  {
+    InferenceEngineOutputType item{};
+    while (inference_engine_output_.take(item)) {
+      try {
+        auto result = post_processor_.schedule(item);
+        inference_engine_output_.release();
+        callback_(std::move(result));
+      } catch (...) {
+        set_error(std::current_exception());
+        return;
+      }
+      std::lock_guard<std::mutex> lock{mutex_};
+      ++num_done_;
+      done_condition_.notify_all();
+    }
+  }
+
+  void set_error(const std::exception_ptr & error)
+  {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      if (!error_) {
+        error_ = error;
+      }
+      done_condition_.notify_all();
+    }
+    close();
+  }
+
+  void rethrow_error() const
+  {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+  void close()
+  {
+    input_.close();
+    pre_processor_output_.close();
+    inference_engine_output_.close();
+  }
+
+  PreProcessorType pre_processor_;
+  InferenceEngineType inference_engine_;
+  PostProcessorType post_processor_;
+  OutputCallback callback_;
+
+  StageHandoff<InputType> input_;
+  StageHandoff<PreProcessorOutputType> pre_processor_output_;
+  StageHandoff<InferenceEngineOutputType> inference_engine_output_;
+
+  std::mutex mutex_;
+  std::condition_variable done_condition_;
+  std::size_t num_scheduled_{0U};
+  std::size_t num_done_{0U};
+  std::exception_ptr error_{};
+
+  std::thread pre_processor_thread_;
+  std::thread inference_engine_thread_;
+  std::thread post_processor_thread_;
 };
 
 // Each node should be specificed with a string name and a shape
@@ -192,15 +517,160 @@ typedef struct
   std::vector<NetworkNode> network_outputs;
 } InferenceEngineTVMConfig;
 
+// The same network may be compiled with a lower precision, e.g. fp16 or int8, and installed next
+// to it as another network named <network_name>_<precision>, with the same inputs and outputs
+typedef struct
+{
+  InferenceEngineTVMConfig config;
+
+  // Latency of an inference on the target the network was compiled for, in ms, negative if unknown
+  double latency_ms;
+} InferenceEngineTVMVariant;
+
+// Name of a node of the graph of a network and the latency of its operator in ms
+using OperatorLatency = std::pair<std::string, double>;
+
+/**
+ * @brief Get the names of the nodes of a graph, in the order of the graph
+ * runtime
+ *
+ * @param graph_json The graph in the JSON format of the graph runtime, in which
+ * only the nodes have a "name" key
+ */
+inline std::vector<std::string> get_graph_node_names(const std::string & graph_json)
+{
+  const std::string key{"\"name\""};
+  std::vector<std::string> names{};
+  for (std::size_t pos = graph_json.find(key); pos != std::string::npos;
+    pos = graph_json.find(key, pos))
+  {
+    const std::size_t colon = graph_json.find(':', pos + key.size());
+    const std::size_t begin = graph_json.find('"', colon);
+    const std::size_t end = graph_json.find('"', begin + 1U);
+    if ((colon == std::string::npos) || (begin == std::string::npos) ||
+      (end == std::string::npos))
+    {
+      break;
+    }
+    names.push_back(graph_json.substr(begin + 1U, end - begin - 1U));
+    pos = end + 1U;
+  }
+  return names;
+}
+
+/**
+ * @brief Get the directory of the compiled files of a network
+ */
+inline std::string get_network_directory(const InferenceEngineTVMConfig & config)
+{
+  return ament_index_cpp::get_package_share_directory("neural_networks") + "/networks/" +
+         config.network_name + "/" + config.network_backend + "/";
+}
+
+/**
+ * @brief Read the latency of a network from the deploy_latency.txt file next
+ * to its compiled files, which holds the latency of an inference in ms
+ *
+ * @return The latency in ms, or -1 if the network has no such file
+ */
+inline double read_network_latency(const InferenceEngineTVMConfig & config)
+{
+  std::ifstream latency_in(get_network_directory(config) + "deploy_latency.txt");
+  double latency_ms = -1.0;
+  if (!(latency_in >> latency_ms) || (latency_ms < 0.0)) {
+    latency_ms = -1.0;
+  }
+  return latency_ms;
+}
+
+/**
+ * @brief Find the installed variants of a network
+ *
+ * @param config The configuration of the network
+ * @param precisions The precisions of the variants to look for, most accurate
+ * first, e.g. {"fp16", "int8"}
+ * @return The network itself followed by the variants which are installed for
+ * the same backend, in the order of precisions
+ */
+inline std::vector<InferenceEngineTVMVariant> find_network_variants(
+  const InferenceEngineTVMConfig & config, const std::vector<std::string> & precisions)
+{
+  std::vector<InferenceEngineTVMVariant> variants{{config, read_network_latency(config)}};
+  for (const auto & precision : precisions) {
+    InferenceEngineTVMConfig variant_config = config;
+    variant_config.network_name = config.network_name + "_" + precision;
+    std::ifstream module(
+      get_network_directory(variant_config) + variant_config.network_module_path);
+    if (module.good()) {
+      variants.push_back({variant_config, read_network_latency(variant_config)});
+    }
+  }
+  return variants;
+}
+
+/**
+ * @brief Select the variant of a network to run within a latency budget
+ *
+ * @param variants The variants of the network, most accurate first
+ * @param latency_budget_ms The latency budget of an inference in ms, or 0 for
+ * no budget
+ * @return The index of the first variant whose latency is known and within the
+ * budget. If there is none, the index of the fastest variant whose latency is
+ * known, or 0 if no latency is known.
+ * @throw std::runtime_error If there is no variant
+ */
+inline std::size_t select_network_variant(
+  const std::vector<InferenceEngineTVMVariant> & variants, const double latency_budget_ms)
+{
+  if (variants.empty()) {
+    throw std::runtime_error("No variant of the network to select from");
+  }
+  if (latency_budget_ms <= 0.0) {
+    return 0U;
+  }
+  std::size_t fastest = 0U;
+  for (std::size_t index = 0U; index < variants.size(); ++index) {
+    const double latency_ms = variants[index].latency_ms;
+    if (latency_ms < 0.0) {
+      continue;
+    }
+    if (latency_ms <= latency_budget_ms) {
+      return index;
+    }
+    if ((variants[fastest].latency_ms < 0.0) || (latency_ms < variants[fastest].latency_ms)) {
+      fastest = index;
+    }
+  }
+  return fastest;
+}
+
 class InferenceEngineTVM : public InferenceEngine
 {
 public:
-  explicit InferenceEngineTVM(const InferenceEngineTVMConfig & config)
+  /**
+   * @brief Load the network and allocate its outputs
+   *
+   * @param config The configuration of the network
+   * @param num_output_buffers The number of output buffers, which are used in
+   * turn. With 2 buffers, the output of a call stays valid during the next
+   * call, as needed by AsyncPipeline.
+   * @param profile_operators Load the network into the debug graph runtime,
+   * which can measure the latency of every operator, see profileOperators.
+   * Its inferences are as fast as those of the graph runtime.
+   * @throw std::runtime_error If profile_operators is set and the TVM runtime
+   * was built without the debug graph runtime
+   */
+  explicit InferenceEngineTVM(
+    const InferenceEngineTVMConfig & config, const std::size_t num_output_buffers = 1U,
+    const bool profile_operators = false)
   : config_(config)
   {
+    if (num_output_buffers == 0U) {
+      throw std::runtime_error("InferenceEngineTVM needs at least one output buffer");
+    }
+
     // Get full network path
-    std::string network_prefix = ament_index_cpp::get_package_share_directory("neural_networks") +
-      "/networks/" + config.network_name + "/" + config.network_backend + "/";
+    std::string network_prefix = get_network_directory(config);
     std::string network_module_path = network_prefix + config.network_module_path;
     std::string network_graph_path = network_prefix + config.network_graph_path;
     std::string network_params_path = network_prefix + config.network_params_path;
@@ -243,9 +713,21 @@ public:
     params_arr.size = params_data.length();
 
     // Create tvm runtime module
-    tvm::runtime::Module runtime_mod =
-      (*tvm::runtime::Registry::Get("tvm.graph_runtime.create"))(
+    const char * const runtime_name =
+      profile_operators ? "tvm.graph_runtime_debug.create" : "tvm.graph_runtime.create";
+    const tvm::runtime::PackedFunc * const create_runtime =
+      tvm::runtime::Registry::Get(runtime_name);
+    if (create_runtime == nullptr) {
+      throw std::runtime_error(
+              std::string{"The TVM runtime has no "} + runtime_name +
+              ", it must be built with USE_GRAPH_RUNTIME_DEBUG to profile operators");
+    }
+    tvm::runtime::Module runtime_mod = (*create_runtime)(
       json_data, mod, static_cast<uint32_t>(config.tvm_device_type), config.tvm_device_id);
+    if (profile_operators) {
+      run_individual = runtime_mod.GetFunction("run_individual");
+      operator_names_ = get_graph_node_names(json_data);
+    }
 
     // Load parameters
     auto load_params = runtime_mod.GetFunction("load_params");
@@ -254,21 +736,75 @@ public:
     // Get set_input function
     set_input = runtime_mod.GetFunction("set_input");
 
+    // Get the function which binds an input without copying it, if the runtime has one
+    set_input_zero_copy = runtime_mod.GetFunction("set_input_zero_copy");
+
     // Get the function which executes the network
     execute = runtime_mod.GetFunction("run");
 
     // Get the function to get output data
     get_output = runtime_mod.GetFunction("get_output");
 
-    for (auto & output_config : config.network_outputs) {
-      output_.push_back(
+    // Inputs are allocated in host memory, so that a pre-processor can write into them directly.
+    // On a CPU target they are used by the network without a copy. For CUDA, page-locked memory
+    // speeds up the copy to the device.
+    zero_copy_input_ = (config.tvm_device_type == kDLCPU) && (set_input_zero_copy != nullptr);
+    const DLDeviceType input_device_type =
+      (config.tvm_device_type == kDLGPU) ? kDLCPUPinned : kDLCPU;
+    for (auto & input_config : config.network_inputs) {
+      inputs_.push_back(
         TVMArrayContainer(
-          output_config.second, config.tvm_dtype_code,
+          input_config.second, config.tvm_dtype_code,
           config.tvm_dtype_bits, config.tvm_dtype_lanes,
-          kDLCPU, 0));
+          input_device_type, 0));
+    }
+
+    outputs_.resize(num_output_buffers);
+    for (auto & output : outputs_) {
+      for (auto & output_config : config.network_outputs) {
+        output.push_back(
+          TVMArrayContainer(
+            output_config.second, config.tvm_dtype_code,
+            config.tvm_dtype_bits, config.tvm_dtype_lanes,
+            kDLCPU, 0));
+      }
     }
   }
 
+  /**
+   * @brief Load the variant of a network which fits a latency budget, see
+   * select_network_variant
+   *
+   * @param variants The variants of the network, most accurate first, which
+   * all have the same inputs and outputs
+   * @param latency_budget_ms The latency budget of an inference in ms, or 0 to
+   * load the first variant
+   * @param num_output_buffers The number of output buffers
+   * @param profile_operators Load the network into the debug graph runtime
+   */
+  InferenceEngineTVM(
+    const std::vector<InferenceEngineTVMVariant> & variants, const double latency_budget_ms,
+    const std::size_t num_output_buffers = 1U, const bool profile_operators = false)
+  : InferenceEngineTVM(
+      variants[select_network_variant(variants, latency_budget_ms)].config, num_output_buffers,
+      profile_operators)
+  {
+  }
+
+  /**
+   * @brief Get the configuration of the loaded network
+   */
+  const InferenceEngineTVMConfig & getConfig() const {return config_;}
+
+  /**
+   * @brief Get the preallocated input tensors, one per network input, in host
+   * memory. A pre-processor which fills these and returns them avoids a copy of
+   * its output. They are reused for every call, so they are not suited for
+   * AsyncPipeline, where the pre-processor fills the next input during the
+   * inference.
+   */
+  const TVMArrayContainerVector & getInputs() const {return inputs_;}
+
   TVMArrayContainerVector schedule(const TVMArrayContainerVector & input)
   {
     // Set input(s)
@@ -276,28 +812,236 @@ public:
       if (input[index].getArray() == nullptr) {
         throw std::runtime_error("input variable is null");
       }
-      set_input(config_.network_inputs[index].first.c_str(), input[index].getArray());
+      const char * const name = config_.network_inputs[index].first.c_str();
+      if (zero_copy_input_ && (index < inputs_.size()) &&
+        (input[index].getArray() == inputs_[index].getArray()))
+      {
+        set_input_zero_copy(name, input[index].getArray());
+      } else {
+        set_input(name, input[index].getArray());
+      }
     }
 
     // Execute the inference
     execute();
 
     // Get output(s)
-    for (uint32_t index = 0; index < output_.size(); ++index) {
-      if (output_[index].getArray() == nullptr) {
+    const TVMArrayContainerVector & output = outputs_[next_output_];
+    next_output_ = (next_output_ + 1U) % outputs_.size();
+    for (uint32_t index = 0; index < output.size(); ++index) {
+      if (output[index].getArray() == nullptr) {
         throw std::runtime_error("output variable is null");
       }
-      get_output(index, output_[index].getArray());
+      get_output(index, output[index].getArray());
+    }
+    return output;
+  }
+
+  /**
+   * @brief Measure the latency of every operator of the network, running it
+   * once more for each repetition with the inputs of the last call to schedule.
+   * The outputs are not changed.
+   *
+   * @param number The number of repetitions to average over
+   * @return The latency of every node of the graph, in the order of the graph.
+   * Nodes which are not operators, e.g. the inputs, have a latency of 0.
+   * @throw std::runtime_error If the engine was not created with
+   * profile_operators
+   */
+  std::vector<OperatorLatency> profileOperators(const int32_t number = 1)
+  {
+    if (run_individual == nullptr) {
+      throw std::runtime_error("InferenceEngineTVM was not created with profile_operators");
+    }
+    // The debug graph runtime returns the latencies in seconds, separated by commas
+    const std::string latencies = run_individual(number, 1, 0);
+    std::istringstream latencies_in{latencies};
+    std::vector<OperatorLatency> operators{};
+    std::string latency_s{};
+    while (std::getline(latencies_in, latency_s, ',')) {
+      const std::size_t index = operators.size();
+      operators.emplace_back(
+        (index < operator_names_.size()) ? operator_names_[index] : std::to_string(index),
+        std::stod(latency_s) * 1000.0);
     }
-    return output_;
+    return operators;
   }
 
 private:
   InferenceEngineTVMConfig config_;
-  TVMArrayContainerVector output_;
+  TVMArrayContainerVector inputs_;
+  bool zero_copy_input_{false};
+  std::vector<TVMArrayContainerVector> outputs_;
+  std::size_t next_output_{0U};
   tvm::runtime::PackedFunc set_input;
+  tvm::runtime::PackedFunc set_input_zero_copy;
   tvm::runtime::PackedFunc execute;
   tvm::runtime::PackedFunc get_output;
+  tvm::runtime::PackedFunc run_individual;
+  std::vector<std::string> operator_names_;
+};
+
+/**
+ * @class InferenceService
+ * @brief Runs the inference of several pipelines, possibly of different
+ * networks, on a single thread of its own, highest priority request first.
+ *
+ * The TVM runtime creates a thread pool for every thread which runs an
+ * inference, so engines which are scheduled from the threads of different
+ * pipelines each get as many workers as there are cores. When they share a
+ * service, only the thread pool of the service exists, and its size can be set.
+ * Requests of the same priority are run in the order they are submitted.
+ */
+class InferenceService
+{
+public:
+  /**
+   * @brief Construct a new InferenceService object and start its thread
+   *
+   * @param num_tvm_threads Number of threads of the TVM runtime thread pool,
+   * the TVM default if 0
+   */
+  explicit InferenceService(const int32_t num_tvm_threads = 0)
+  {
+    thread_ = std::thread{[this, num_tvm_threads] {run(num_tvm_threads);}};
+  }
+
+  InferenceService(const InferenceService &) = delete;
+  InferenceService & operator=(const InferenceService &) = delete;
+
+  /**
+   * @brief Stop the thread. Requests which have not been run yet are dropped,
+   * their futures get a broken_promise error.
+   */
+  ~InferenceService()
+  {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      stopped_ = true;
+    }
+    condition_.notify_all();
+    thread_.join();
+  }
+
+  /**
+   * @brief Queue the inference of an input
+   *
+   * @param engine The inference engine to schedule the input to. It must stay
+   * valid until the request is done, and must not be used by another thread in
+   * the meantime.
+   * @param input The input of the engine
+   * @param priority Requests with a higher priority are run first
+   * @return The future output of the engine, or its exception
+   */
+  template<class InferenceEngineType>
+  std::future<decltype(std::declval<InferenceEngineType>().output_type_indicator_)> submit(
+    InferenceEngineType & engine,
+    const decltype(std::declval<InferenceEngineType>().input_type_indicator_) & input,
+    const int32_t priority = 0)
+  {
+    using OutputType = decltype(std::declval<InferenceEngineType>().output_type_indicator_);
+    const auto task = std::make_shared<std::packaged_task<OutputType()>>(
+      [&engine, input] {return engine.schedule(input);});
+    auto output = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      requests_.push_back(Request{priority, next_sequence_++, [task] {(*task)();}});
+      std::push_heap(requests_.begin(), requests_.end(), runs_later);
+    }
+    condition_.notify_one();
+    return output;
+  }
+
+private:
+  struct Request
+  {
+    int32_t priority;
+    uint64_t sequence;
+    std::function<void()> run;
+  };
+
+  // Order of the heap, whose front is run next
+  static bool runs_later(const Request & a, const Request & b)
+  {
+    return (a.priority != b.priority) ? (a.priority < b.priority) : (a.sequence > b.sequence);
+  }
+
+  void run(const int32_t num_tvm_threads)
+  {
+    if (num_tvm_threads > 0) {
+      // The thread pool of this thread, which runs all inferences
+      const auto config_threadpool = tvm::runtime::Registry::Get("runtime.config_threadpool");
+      if (config_threadpool != nullptr) {
+        (*config_threadpool)(1, num_tvm_threads);
+      }
+    }
+    std::unique_lock<std::mutex> lock{mutex_};
+    while (true) {
+      condition_.wait(lock, [this] {return stopped_ || !requests_.empty();});
+      if (stopped_) {
+        return;
+      }
+      std::pop_heap(requests_.begin(), requests_.end(), runs_later);
+      Request request{std::move(requests_.back())};
+      requests_.pop_back();
+      lock.unlock();
+      // An exception of the engine is stored in the future
+      request.run();
+      lock.lock();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<Request> requests_;
+  uint64_t next_sequence_{0U};
+  bool stopped_{false};
+  std::thread thread_;
+};
+
+/**
+ * @class SharedInferenceEngine
+ * @brief Pipeline stage which runs an inference engine on an InferenceService,
+ * so that it can be used in a Pipeline or AsyncPipeline.
+ *
+ * @tparam InferenceEngineType The type of the engine, e.g. InferenceEngineTVM
+ */
+template<class InferenceEngineType>
+class SharedInferenceEngine : public PipelineStage<
+    decltype(std::declval<InferenceEngineType>().input_type_indicator_),
+    decltype(std::declval<InferenceEngineType>().output_type_indicator_)>
+{
+  using InputType = decltype(std::declval<InferenceEngineType>().input_type_indicator_);
+  using OutputType = decltype(std::declval<InferenceEngineType>().output_type_indicator_);
+
+public:
+  /**
+   * @brief Construct a new SharedInferenceEngine object
+   *
+   * @param service The service to run the engine on
+   * @param engine The engine, which is only used by the service
+   * @param priority The priority of the requests of this engine
+   */
+  SharedInferenceEngine(
+    const std::shared_ptr<InferenceService> & service, InferenceEngineType engine,
+    const int32_t priority = 0)
+  : service_(service), engine_(engine), priority_(priority) {}
+
+  /**
+   * @brief Run the inference on the service and wait for its output
+   *
+   * @param input The input of the engine
+   * @return The output of the engine
+   */
+  OutputType schedule(const InputType & input) override
+  {
+    return service_->submit(engine_, input, priority_).get();
+  }
+
+private:
+  std::shared_ptr<InferenceService> service_;
+  InferenceEngineType engine_;
+  int32_t priority_;
 };
 
 }  // namespace pipeline
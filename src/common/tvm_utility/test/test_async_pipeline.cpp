@@ -0,0 +1,187 @@
+// Copyright 2021 Arm Limited and Contributors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <tvm_utility/pipeline.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// The stages pass a pointer to the one of their two output buffers that they wrote last, like a
+// stage which alternates between two TVMArrayContainers
+using Buffer = std::shared_ptr<std::array<int, 2U>>;
+using Buffers = std::shared_ptr<std::array<std::array<int, 2U>, 2U>>;
+
+// Counts the stages which are running at the same time
+struct Activity
+{
+  std::atomic<int> active{0};
+  std::atomic<int> max_active{0};
+
+  void enter()
+  {
+    const int now_active = ++active;
+    int previous = max_active.load();
+    while ((now_active > previous) && !max_active.compare_exchange_weak(previous, now_active)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+  }
+  void exit() {--active;}
+};
+
+Buffer next_buffer(const Buffers & buffers, int & next)
+{
+  Buffer buffer{buffers, &(*buffers)[static_cast<std::size_t>(next)]};
+  next = 1 - next;
+  return buffer;
+}
+
+class TestPreProcessor : public tvm_utility::pipeline::PipelineStage<int, Buffer>
+{
+public:
+  explicit TestPreProcessor(const std::shared_ptr<Activity> & activity)
+  : activity_{activity} {}
+
+  Buffer schedule(const int & input) override
+  {
+    activity_->enter();
+    const auto output = next_buffer(buffers_, next_);
+    (*output)[0U] = input;
+    (*output)[1U] = input;
+    activity_->exit();
+    return output;
+  }
+
+private:
+  std::shared_ptr<Activity> activity_;
+  Buffers buffers_{std::make_shared<std::array<std::array<int, 2U>, 2U>>()};
+  int next_{0};
+};
+
+class TestInferenceEngine : public tvm_utility::pipeline::PipelineStage<Buffer, Buffer>
+{
+public:
+  explicit TestInferenceEngine(const std::shared_ptr<Activity> & activity, const int fail_at = -1)
+  : activity_{activity}, fail_at_{fail_at} {}
+
+  Buffer schedule(const Buffer & input) override
+  {
+    activity_->enter();
+    if ((*input)[0U] == fail_at_) {
+      activity_->exit();
+      throw std::runtime_error("inference failed");
+    }
+    const auto output = next_buffer(buffers_, next_);
+    (*output)[0U] = (*input)[0U] * 2;
+    // The input must not have been overwritten by the pre-processor in the meantime
+    (*output)[1U] = (*input)[1U] * 2;
+    activity_->exit();
+    return output;
+  }
+
+private:
+  std::shared_ptr<Activity> activity_;
+  int fail_at_;
+  Buffers buffers_{std::make_shared<std::array<std::array<int, 2U>, 2U>>()};
+  int next_{0};
+};
+
+class TestPostProcessor : public tvm_utility::pipeline::PipelineStage<Buffer, int>
+{
+public:
+  explicit TestPostProcessor(const std::shared_ptr<Activity> & activity)
+  : activity_{activity} {}
+
+  int schedule(const Buffer & input) override
+  {
+    activity_->enter();
+    const int first = (*input)[0U];
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    const int second = (*input)[1U];
+    activity_->exit();
+    return (first == second) ? first : -1;
+  }
+
+private:
+  std::shared_ptr<Activity> activity_;
+};
+
+using TestPipeline =
+  tvm_utility::pipeline::AsyncPipeline<TestPreProcessor, TestInferenceEngine, TestPostProcessor>;
+}  // namespace
+
+TEST(TestAsyncPipeline, OutputsInOrderWithOverlappedStages)
+{
+  const auto activity = std::make_shared<Activity>();
+  std::vector<int> outputs{};
+  TestPipeline pipeline{TestPreProcessor{activity}, TestInferenceEngine{activity},
+    TestPostProcessor{activity}, [&outputs](int output) {outputs.push_back(output);}};
+
+  constexpr int kNumInputs = 50;
+  for (int i = 0; i < kNumInputs; ++i) {
+    pipeline.schedule(i);
+  }
+  pipeline.flush();
+
+  ASSERT_EQ(outputs.size(), static_cast<std::size_t>(kNumInputs));
+  for (int i = 0; i < kNumInputs; ++i) {
+    EXPECT_EQ(outputs[static_cast<std::size_t>(i)], 2 * i);
+  }
+  EXPECT_GT(activity->max_active.load(), 1);
+  EXPECT_LE(activity->max_active.load(), 3);
+}
+
+TEST(TestAsyncPipeline, StageErrorIsRethrown)
+{
+  const auto activity = std::make_shared<Activity>();
+  std::vector<int> outputs{};
+  TestPipeline pipeline{TestPreProcessor{activity}, TestInferenceEngine{activity, 3},
+    TestPostProcessor{activity}, [&outputs](int output) {outputs.push_back(output);}};
+
+  EXPECT_THROW(
+  {
+    for (int i = 0; i < 10; ++i) {
+      pipeline.schedule(i);
+    }
+    pipeline.flush();
+  }, std::runtime_error);
+  EXPECT_THROW(pipeline.schedule(0), std::runtime_error);
+  EXPECT_THROW(pipeline.flush(), std::runtime_error);
+  ASSERT_LE(outputs.size(), 3U);
+  for (std::size_t i = 0U; i < outputs.size(); ++i) {
+    EXPECT_EQ(outputs[i], 2 * static_cast<int>(i));
+  }
+}
+
+TEST(TestAsyncPipeline, DestroyWithPendingInputs)
+{
+  const auto activity = std::make_shared<Activity>();
+  std::atomic<int> num_outputs{0};
+  {
+    TestPipeline pipeline{TestPreProcessor{activity}, TestInferenceEngine{activity},
+      TestPostProcessor{activity}, [&num_outputs](int) {++num_outputs;}};
+    for (int i = 0; i < 5; ++i) {
+      pipeline.schedule(i);
+    }
+  }
+  EXPECT_LE(num_outputs.load(), 5);
+}
@@ -0,0 +1,141 @@
+// Copyright 2021 Arm Limited and Contributors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <tvm_utility/pipeline.hpp>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Input which holds the engine until it is released
+constexpr int kBlockingInput = 1000;
+
+// Records the order in which the inputs are run, and can hold the service until it is released
+class TestEngine : public tvm_utility::pipeline::PipelineStage<int, int>
+{
+public:
+  explicit TestEngine(const std::shared_ptr<std::vector<int>> & order)
+  : order_{order} {}
+
+  int schedule(const int & input) override
+  {
+    if (input == kBlockingInput) {
+      started_->set_value();
+      released_.wait();
+    } else if (input < 0) {
+      throw std::runtime_error("inference failed");
+    }
+    order_->push_back(input);
+    return input * 2;
+  }
+
+  void wait_until_blocking() {blocking_.wait();}
+  void release() {release_->set_value();}
+
+private:
+  std::shared_ptr<std::vector<int>> order_;
+  std::shared_ptr<std::promise<void>> started_{std::make_shared<std::promise<void>>()};
+  std::shared_future<void> blocking_{started_->get_future().share()};
+  std::shared_ptr<std::promise<void>> release_{std::make_shared<std::promise<void>>()};
+  std::shared_future<void> released_{release_->get_future().share()};
+};
+
+class TestPreProcessor : public tvm_utility::pipeline::PipelineStage<int, int>
+{
+public:
+  int schedule(const int & input) override {return input + 1;}
+};
+
+class TestPostProcessor : public tvm_utility::pipeline::PipelineStage<int, int>
+{
+public:
+  int schedule(const int & input) override {return input;}
+};
+}  // namespace
+
+TEST(TestInferenceService, HigherPriorityFirst)
+{
+  const auto order = std::make_shared<std::vector<int>>();
+  TestEngine engine{order};
+  std::vector<std::future<int>> outputs{};
+  {
+    tvm_utility::pipeline::InferenceService service{};
+    // Hold the service, so that the other requests are queued
+    auto blocking_output = service.submit(engine, kBlockingInput);
+    engine.wait_until_blocking();
+    outputs.push_back(service.submit(engine, 1, 0));
+    outputs.push_back(service.submit(engine, 2, 5));
+    outputs.push_back(service.submit(engine, 3, 0));
+    outputs.push_back(service.submit(engine, 4, 5));
+    engine.release();
+    EXPECT_EQ(blocking_output.get(), 2 * kBlockingInput);
+    for (std::size_t i = 0U; i < outputs.size(); ++i) {
+      EXPECT_EQ(outputs[i].get(), 2 * static_cast<int>(i + 1U));
+    }
+  }
+  EXPECT_EQ(*order, (std::vector<int>{kBlockingInput, 2, 4, 1, 3}));
+}
+
+TEST(TestInferenceService, EngineErrorIsInFuture)
+{
+  const auto order = std::make_shared<std::vector<int>>();
+  TestEngine engine{order};
+  tvm_utility::pipeline::InferenceService service{};
+  auto failed_output = service.submit(engine, -1);
+  EXPECT_THROW(failed_output.get(), std::runtime_error);
+  EXPECT_EQ(service.submit(engine, 1).get(), 2);
+}
+
+TEST(TestInferenceService, PendingRequestsAreDropped)
+{
+  const auto order = std::make_shared<std::vector<int>>();
+  TestEngine engine{order};
+  std::future<int> blocking_output{};
+  std::future<int> pending_output{};
+  // Release the service only once it is being destroyed
+  std::thread releaser{[&engine] {
+      engine.wait_until_blocking();
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+      engine.release();
+    }};
+  {
+    tvm_utility::pipeline::InferenceService service{};
+    blocking_output = service.submit(engine, kBlockingInput);
+    engine.wait_until_blocking();
+    pending_output = service.submit(engine, 1);
+  }
+  releaser.join();
+  EXPECT_EQ(blocking_output.get(), 2 * kBlockingInput);
+  EXPECT_THROW(pending_output.get(), std::future_error);
+}
+
+TEST(TestInferenceService, SharedInferenceEngineInPipelines)
+{
+  const auto service = std::make_shared<tvm_utility::pipeline::InferenceService>(1);
+  const auto order = std::make_shared<std::vector<int>>();
+  using TestSharedEngine = tvm_utility::pipeline::SharedInferenceEngine<TestEngine>;
+  tvm_utility::pipeline::Pipeline<TestPreProcessor, TestSharedEngine, TestPostProcessor> first{
+    TestPreProcessor{}, TestSharedEngine{service, TestEngine{order}, 1}, TestPostProcessor{}};
+  tvm_utility::pipeline::Pipeline<TestPreProcessor, TestSharedEngine, TestPostProcessor> second{
+    TestPreProcessor{}, TestSharedEngine{service, TestEngine{order}}, TestPostProcessor{}};
+  EXPECT_EQ(first.schedule(1), 4);
+  EXPECT_EQ(second.schedule(2), 6);
+  EXPECT_EQ(*order, (std::vector<int>{2, 3}));
+}
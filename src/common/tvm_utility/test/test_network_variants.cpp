@@ -0,0 +1,66 @@
+// Copyright 2021 Arm Limited and Contributors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <tvm_utility/pipeline.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+using tvm_utility::pipeline::InferenceEngineTVMVariant;
+using tvm_utility::pipeline::select_network_variant;
+
+// Variants in the order fp32, fp16, int8 with the given latencies
+std::vector<InferenceEngineTVMVariant> make_variants(const std::vector<double> & latencies_ms)
+{
+  std::vector<InferenceEngineTVMVariant> variants{};
+  for (const double latency_ms : latencies_ms) {
+    InferenceEngineTVMVariant variant{};
+    variant.latency_ms = latency_ms;
+    variants.push_back(variant);
+  }
+  return variants;
+}
+}  // namespace
+
+TEST(TestNetworkVariants, MostPreciseWithinBudget)
+{
+  const auto variants = make_variants({120.0, 70.0, 40.0});
+  EXPECT_EQ(select_network_variant(variants, 150.0), 0U);
+  EXPECT_EQ(select_network_variant(variants, 100.0), 1U);
+  EXPECT_EQ(select_network_variant(variants, 70.0), 1U);
+  EXPECT_EQ(select_network_variant(variants, 50.0), 2U);
+}
+
+TEST(TestNetworkVariants, FastestWhenNoneWithinBudget)
+{
+  EXPECT_EQ(select_network_variant(make_variants({120.0, 40.0, 70.0}), 10.0), 1U);
+  EXPECT_EQ(select_network_variant(make_variants({-1.0, 40.0, -1.0}), 10.0), 1U);
+}
+
+TEST(TestNetworkVariants, UnknownLatency)
+{
+  // A variant without a latency is only selected when no latency is known
+  EXPECT_EQ(select_network_variant(make_variants({-1.0, 70.0, 40.0}), 100.0), 1U);
+  EXPECT_EQ(select_network_variant(make_variants({-1.0, -1.0}), 100.0), 0U);
+}
+
+TEST(TestNetworkVariants, NoBudget)
+{
+  EXPECT_EQ(select_network_variant(make_variants({120.0, 70.0}), 0.0), 0U);
+  EXPECT_THROW(select_network_variant(make_variants({}), 100.0), std::runtime_error);
+  EXPECT_THROW(select_network_variant(make_variants({}), 0.0), std::runtime_error);
+}
@@ -0,0 +1,92 @@
+// Copyright 2021 Arm Limited and Contributors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <tvm_utility/pipeline.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Each stage takes at least the given time
+template<class InputType, class OutputType>
+class TestStage : public tvm_utility::pipeline::PipelineStage<InputType, OutputType>
+{
+public:
+  explicit TestStage(const std::chrono::milliseconds duration)
+  : duration_{duration} {}
+
+  OutputType schedule(const InputType & input) override
+  {
+    std::this_thread::sleep_for(duration_);
+    return static_cast<OutputType>(input + 1);
+  }
+
+private:
+  std::chrono::milliseconds duration_;
+};
+
+using TestPipeline = tvm_utility::pipeline::Pipeline<TestStage<int, int>, TestStage<int, int>,
+    TestStage<int, int>>;
+}  // namespace
+
+TEST(TestPipelineProfiling, DisabledByDefault)
+{
+  const std::chrono::milliseconds no_time{0};
+  TestPipeline pipeline{TestStage<int, int>{no_time}, TestStage<int, int>{no_time},
+    TestStage<int, int>{no_time}};
+  EXPECT_EQ(pipeline.schedule(0), 3);
+  EXPECT_EQ(pipeline.getProfile(), nullptr);
+}
+
+TEST(TestPipelineProfiling, StageLatencies)
+{
+  TestPipeline pipeline{TestStage<int, int>{std::chrono::milliseconds{1}},
+    TestStage<int, int>{std::chrono::milliseconds{5}},
+    TestStage<int, int>{std::chrono::milliseconds{2}}};
+  EXPECT_EQ(pipeline.schedule(0), 3);
+  pipeline.enableProfiling();
+  constexpr int kNumInputs = 4;
+  for (int i = 0; i < kNumInputs; ++i) {
+    EXPECT_EQ(pipeline.schedule(i), i + 3);
+  }
+  // Enabling it again keeps the samples
+  pipeline.enableProfiling();
+
+  const auto * const profile = pipeline.getProfile();
+  ASSERT_NE(profile, nullptr);
+  EXPECT_EQ(profile->pre_processor.count(), static_cast<uint64_t>(kNumInputs));
+  EXPECT_EQ(profile->inference_engine.count(), static_cast<uint64_t>(kNumInputs));
+  EXPECT_EQ(profile->post_processor.count(), static_cast<uint64_t>(kNumInputs));
+  EXPECT_GE(profile->pre_processor.mean(), std::chrono::milliseconds{1});
+  EXPECT_GE(profile->inference_engine.mean(), std::chrono::milliseconds{5});
+  EXPECT_GE(profile->post_processor.mean(), std::chrono::milliseconds{2});
+}
+
+TEST(TestPipelineProfiling, GraphNodeNames)
+{
+  const std::string graph_json{
+    "{\"nodes\": [{\"op\": \"null\", \"name\": \"data\", \"inputs\": []}, "
+    "{\"op\": \"tvm_op\", \"name\":\"fused_nn_conv2d\", "
+    "\"attrs\": {\"func_name\": \"fused_nn_conv2d\", \"num_inputs\": \"1\"}, "
+    "\"inputs\": [[0, 0, 0]]}], \"arg_nodes\": [0], \"heads\": [[1, 0, 0]]}"};
+  const std::vector<std::string> names = tvm_utility::pipeline::get_graph_node_names(graph_json);
+  ASSERT_EQ(names.size(), 2U);
+  EXPECT_EQ(names[0U], "data");
+  EXPECT_EQ(names[1U], "fused_nn_conv2d");
+  EXPECT_TRUE(tvm_utility::pipeline::get_graph_node_names("{}").empty());
+}
@@ -40,6 +40,8 @@ struct VEHICLE_CONSTANTS_MANAGER_PUBLIC VehicleConstants
 {
   using SharedPtr = std::shared_ptr<VehicleConstants>;
   using ConstSharedPtr = const SharedPtr;
+  /// @brief A read-only snapshot which can be shared between nodes, see attach_vehicle_constants
+  using SharedConstPtr = std::shared_ptr<const VehicleConstants>;
 
   using float64_t = autoware::common::types::float64_t;
 
@@ -169,6 +171,20 @@ struct VEHICLE_CONSTANTS_MANAGER_PUBLIC VehicleConstants
 /// @return A VehicleConstants object containing vehicle constant parameters.
 VEHICLE_CONSTANTS_MANAGER_PUBLIC VehicleConstants
 declare_and_get_vehicle_constants(rclcpp::Node & node);
+
+/// @brief Attaches the node to a read-only VehicleConstants snapshot which is shared by all the
+/// nodes of the process that were given the same vehicle parameters.
+/// @details The vehicle parameters are looked up in the parameter overrides of the node, which is
+/// how a component container passes them, without declaring them. The snapshot is created by the
+/// first node that attaches with a given set of values and is reused by the following ones as long
+/// as any node holds it. If any of the parameters is not among the overrides, the parameters are
+/// declared like in `declare_and_get_vehicle_constants`. Nodes which need to get or set the
+/// vehicle parameters through the parameter services should use
+/// `declare_and_get_vehicle_constants` instead.
+/// @throws The exceptions of `declare_and_get_vehicle_constants`.
+/// @return A snapshot containing the vehicle constant parameters of the node.
+VEHICLE_CONSTANTS_MANAGER_PUBLIC VehicleConstants::SharedConstPtr
+attach_vehicle_constants(rclcpp::Node & node);
 }  // namespace vehicle_constants_manager
 }  // namespace common
 }  // namespace autoware
@@ -15,10 +15,13 @@
 #include "vehicle_constants_manager/vehicle_constants_manager.hpp"
 #include <rclcpp/rclcpp.hpp>
 
+#include <algorithm>
+#include <array>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
-#include <utility>
 
 namespace autoware
 {
@@ -29,6 +32,65 @@ namespace vehicle_constants_manager
 
 using float64_t = VehicleConstants::float64_t;
 
+namespace
+{
+const std::string kParameterNamespace = "vehicle.";
+
+// The primary constants in the order of the VehicleConstants constructor
+const std::array<const char *, 14U> kParameterNames{
+  "wheel_radius",
+  "wheel_width",
+  "wheel_base",
+  "wheel_tread",
+  "overhang_front",
+  "overhang_rear",
+  "overhang_left",
+  "overhang_right",
+  "vehicle_height",
+  "cg_to_rear",
+  "tire_cornering_stiffness_front",
+  "tire_cornering_stiffness_rear",
+  "mass_vehicle",
+  "inertia_yaw_kg_m2"
+};
+
+using ParameterValues = std::array<float64_t, 14U>;
+
+VehicleConstants make_vehicle_constants(const ParameterValues & values)
+{
+  return VehicleConstants(
+    values[0U], values[1U], values[2U], values[3U], values[4U], values[5U], values[6U],
+    values[7U], values[8U], values[9U], values[10U], values[11U], values[12U], values[13U]);
+}
+
+ParameterValues to_values(const VehicleConstants & vc)
+{
+  return ParameterValues{
+    vc.wheel_radius, vc.wheel_width, vc.wheel_base, vc.wheel_tread, vc.overhang_front,
+    vc.overhang_rear, vc.overhang_left, vc.overhang_right, vc.vehicle_height, vc.cg_to_rear,
+    vc.tire_cornering_stiffness_front, vc.tire_cornering_stiffness_rear, vc.mass_vehicle,
+    vc.inertia_yaw_kg_m2};
+}
+
+// Gets the values from the parameter overrides of the node, returns false if any is missing or
+// is not a double
+bool get_overridden_values(const rclcpp::Node & node, ParameterValues & values)
+{
+  const auto & overrides = node.get_node_options().parameter_overrides();
+  for (std::size_t i = 0U; i < kParameterNames.size(); ++i) {
+    const std::string name = kParameterNamespace + kParameterNames[i];
+    const auto it = std::find_if(
+      overrides.rbegin(), overrides.rend(),
+      [&name](const rclcpp::Parameter & parameter) {return parameter.get_name() == name;});
+    if ((it == overrides.rend()) || (it->get_type() != rclcpp::ParameterType::PARAMETER_DOUBLE)) {
+      return false;
+    }
+    values[i] = it->as_double();
+  }
+  return true;
+}
+}  // namespace
+
 
 VehicleConstants::VehicleConstants(
   float64_t wheel_radius,
@@ -130,53 +192,42 @@ std::string VehicleConstants::str_pretty() const
 
 VehicleConstants declare_and_get_vehicle_constants(rclcpp::Node & node)
 {
-  // Initialize the parameters
-  const std::string ns = "vehicle.";
-  std::map<std::string, float64_t> params{
-    std::make_pair(ns + "wheel_radius", -1.0),
-    std::make_pair(ns + "wheel_width", -1.0),
-    std::make_pair(ns + "wheel_base", -1.0),
-    std::make_pair(ns + "wheel_tread", -1.0),
-    std::make_pair(ns + "overhang_front", -1.0),
-    std::make_pair(ns + "overhang_rear", -1.0),
-    std::make_pair(ns + "overhang_left", -1.0),
-    std::make_pair(ns + "overhang_right", -1.0),
-    std::make_pair(ns + "vehicle_height", -1.0),
-    std::make_pair(ns + "cg_to_rear", -1.0),
-    std::make_pair(ns + "tire_cornering_stiffness_front", -1.0),
-    std::make_pair(ns + "tire_cornering_stiffness_rear", -1.0),
-    std::make_pair(ns + "mass_vehicle", -1.0),
-    std::make_pair(ns + "inertia_yaw_kg_m2", -1.0)
-  };
-
   // Try to get parameter values from parameter_overrides set either from .yaml
   // or with args.
-  for (auto & pair : params) {
+  ParameterValues values{};
+  for (std::size_t i = 0U; i < kParameterNames.size(); ++i) {
+    const std::string name = kParameterNamespace + kParameterNames[i];
     // If it is already declared
-    if (node.has_parameter(pair.first)) {
-      pair.second = node.get_parameter(pair.first).get_value<float64_t>();
+    if (node.has_parameter(name)) {
+      values[i] = node.get_parameter(name).get_value<float64_t>();
       continue;
     }
 
-    pair.second = node.declare_parameter(pair.first).get<float64_t>();
+    values[i] = node.declare_parameter(name).get<float64_t>();
   }
 
-  return VehicleConstants(
-    params.at(ns + "wheel_radius"),
-    params.at(ns + "wheel_width"),
-    params.at(ns + "wheel_base"),
-    params.at(ns + "wheel_tread"),
-    params.at(ns + "overhang_front"),
-    params.at(ns + "overhang_rear"),
-    params.at(ns + "overhang_left"),
-    params.at(ns + "overhang_right"),
-    params.at(ns + "vehicle_height"),
-    params.at(ns + "cg_to_rear"),
-    params.at(ns + "tire_cornering_stiffness_front"),
-    params.at(ns + "tire_cornering_stiffness_rear"),
-    params.at(ns + "mass_vehicle"),
-    params.at(ns + "inertia_yaw_kg_m2")
-  );
+  return make_vehicle_constants(values);
+}
+
+VehicleConstants::SharedConstPtr attach_vehicle_constants(rclcpp::Node & node)
+{
+  ParameterValues values{};
+  if (!get_overridden_values(node, values)) {
+    values = to_values(declare_and_get_vehicle_constants(node));
+  }
+
+  // The snapshots are only kept alive by the nodes attached to them
+  static std::mutex snapshots_mutex;
+  static std::map<ParameterValues, std::weak_ptr<const VehicleConstants>> snapshots;
+
+  std::lock_guard<std::mutex> lock{snapshots_mutex};
+  auto & entry = snapshots[values];
+  auto snapshot = entry.lock();
+  if (!snapshot) {
+    snapshot = std::make_shared<const VehicleConstants>(make_vehicle_constants(values));
+    entry = snapshot;
+  }
+  return snapshot;
 }
 }  // namespace vehicle_constants_manager
 }  // namespace common
@@ -118,3 +118,49 @@ TEST(TestVehicleConstantsManager, TestGetVehicleConstants) {
 
   rclcpp::shutdown();
 }
+
+TEST(TestVehicleConstantsManager, TestAttachVehicleConstants) {
+  rclcpp::init(0, nullptr);
+  const std::string ns_node = "TestAttachVehicleConstants";
+  std::vector<rclcpp::Parameter> params;
+  const std::string ns_vehicle = "vehicle.";
+  params.emplace_back(ns_vehicle + "wheel_radius", 0.37);
+  params.emplace_back(ns_vehicle + "wheel_width", 0.27);
+  params.emplace_back(ns_vehicle + "wheel_base", 2.734);
+  params.emplace_back(ns_vehicle + "wheel_tread", 1.571);
+  params.emplace_back(ns_vehicle + "overhang_front", 1.033);
+  params.emplace_back(ns_vehicle + "overhang_rear", 1.021);
+  params.emplace_back(ns_vehicle + "overhang_left", 0.3135);
+  params.emplace_back(ns_vehicle + "overhang_right", 0.3135);
+  params.emplace_back(ns_vehicle + "vehicle_height", 1.662);
+  params.emplace_back(ns_vehicle + "cg_to_rear", 1.367);
+  params.emplace_back(ns_vehicle + "tire_cornering_stiffness_front", 0.1);
+  params.emplace_back(ns_vehicle + "tire_cornering_stiffness_rear", 0.1);
+  params.emplace_back(ns_vehicle + "mass_vehicle", 2120.0);
+  params.emplace_back(ns_vehicle + "inertia_yaw_kg_m2", 12.0);
+
+  rclcpp::NodeOptions node_options;
+  node_options.parameter_overrides(params);
+  rclcpp::Node node_a("node_a", ns_node, node_options);
+  rclcpp::Node node_b("node_b", ns_node, node_options);
+
+  using autoware::common::vehicle_constants_manager::attach_vehicle_constants;
+  const auto snapshot_a = attach_vehicle_constants(node_a);
+  const auto snapshot_b = attach_vehicle_constants(node_b);
+  // The nodes with the same parameters share the snapshot, without declaring the parameters
+  EXPECT_EQ(snapshot_a, snapshot_b);
+  EXPECT_DOUBLE_EQ(snapshot_a->wheel_base, 2.734);
+  EXPECT_FALSE(node_a.has_parameter(ns_vehicle + "wheel_base"));
+
+  params.back() = rclcpp::Parameter(ns_vehicle + "inertia_yaw_kg_m2", 13.0);
+  node_options.parameter_overrides(params);
+  rclcpp::Node node_c("node_c", ns_node, node_options);
+  const auto snapshot_c = attach_vehicle_constants(node_c);
+  EXPECT_NE(snapshot_a, snapshot_c);
+  EXPECT_DOUBLE_EQ(snapshot_c->inertia_yaw_kg_m2, 13.0);
+
+  rclcpp::Node node_missing("node_missing", ns_node);
+  EXPECT_THROW(attach_vehicle_constants(node_missing), std::runtime_error);
+
+  rclcpp::shutdown();
+}
@@ -150,7 +150,8 @@ private:
   autoware::common::motion_model::CatrMotionModel32 m_model{};
 };  // class ControllerBase
 
-/// Fill out a controller diagnostic message
+/// Fill out a controller diagnostic message. The name is only filled if it is empty, so that a
+/// message that is reused for every control cycle of a controller does not allocate
 CONTROLLER_COMMON_PUBLIC void compute_diagnostic(
   const ControllerBase & ctrl,
   const State & state,
@@ -301,7 +301,10 @@ void compute_diagnostic(
     // nothing to do: no reference trajectory
     return;
   }
-  out.diag_header.name = ctrl.name();
+  // name() returns a new string, which may allocate
+  if (out.diag_header.name.empty()) {
+    out.diag_header.name = ctrl.name();
+  }
   out.diag_header.data_stamp = state.header.stamp;
   out.diag_header.iterations =
     static_cast<decltype(out.diag_header.iterations)>(ctrl.get_compute_iterations());
@@ -18,12 +18,15 @@
 #include <time_utils/time_utils.hpp>
 
 #include <chrono>
+#include <string>
 
 using motion::control::controller_common::State;
 using motion::control::controller_common::Command;
 using motion::control::controller_common::BehaviorConfig;
 using motion::control::controller_common::ControlReference;
 using motion::control::controller_common::ControllerBase;
+using motion::control::controller_common::Diagnostic;
+using motion::control::controller_common::compute_diagnostic;
 using motion::motion_testing::make_state;
 using motion::motion_testing::constant_velocity_trajectory;
 using time_utils::from_message;
@@ -42,6 +45,17 @@ protected:
   }
 };  // class TestController
 
+// With a name that is longer than the small string optimization
+class LongNameController : public TestController
+{
+public:
+  using TestController::TestController;
+  std::string name() const override
+  {
+    return std::string{"a name that does not fit in place", std::allocator<char>{}};
+  }
+};  // class LongNameController
+
 class Behavior : public ::testing::Test
 {
 public:
@@ -154,4 +168,28 @@ TEST_F(Behavior, WrongFrame)
   // TODO(c.ho) no memory test here: no access to static exceptions
 }
 
+// A diagnostic message that is reused for every control cycle should not allocate
+TEST_F(Behavior, ReusedDiagnostic)
+{
+  LongNameController controller{
+    BehaviorConfig{3.0F, std::chrono::milliseconds(100LL), ControlReference::SPATIAL}};
+  const auto dt = std::chrono::milliseconds(100LL);
+  auto traj = constant_velocity_trajectory(0.0F, 0.0F, 0.0F, 1.0F, dt);
+  traj.header.frame_id = "foo";
+  controller.set_trajectory(traj);
+  auto state = make_state(0.5F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, from_message(traj.header.stamp));
+  state.header.frame_id = "foo";
+  Diagnostic diag{};
+  controller.compute_command(state);
+  compute_diagnostic(controller, state, false, diag);
+  EXPECT_EQ(diag.diag_header.name, controller.name());
+  state.state.x = 1.5F;
+  apex_test_tools::memory_test::start();
+  controller.compute_command(state);
+  compute_diagnostic(controller, state, false, diag);
+  apex_test_tools::memory_test::stop();
+  EXPECT_EQ(diag.diag_header.name, controller.name());
+  EXPECT_EQ(diag.diag_header.data_stamp, state.header.stamp);
+}
+
 // TODO(c.ho) past_trajectory_curved (i.e. u-turn maneuver, but past the end somehow)
@@ -106,6 +106,9 @@ private:
   // TODO(c.ho) diagnostics
   ControllerPtr m_controller{nullptr};
   std::list<State> m_uncomputed_states{};
+  // Reused by every control cycle so that the steady state does not allocate
+  State m_state_tf{};
+  Diagnostic m_diagnostic{};
 };  // class ControllerBaseNode
 }  // namespace controller_common_nodes
 }  // namespace control
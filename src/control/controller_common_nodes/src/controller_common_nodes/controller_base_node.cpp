@@ -180,8 +180,8 @@ bool ControllerBaseNode::try_compute(const State & state)
   }
   // TODO(c.ho) these should honestly be two functions
   // Transform state into same frame as trajectory
-  const auto traj_frame = m_controller->get_reference_trajectory().header.frame_id;
-  const auto state_frame = state.header.frame_id;
+  const auto & traj_frame = m_controller->get_reference_trajectory().header.frame_id;
+  const auto & state_frame = state.header.frame_id;
   const auto stamp = time_utils::from_message(state.header.stamp);
 
   geometry_msgs::msg::TransformStamped tf;
@@ -193,11 +193,13 @@ bool ControllerBaseNode::try_compute(const State & state)
     return false;
   }
 
-  auto state_tf = state;
+  // The transformed state and the diagnostic are members to reuse their storage
+  auto & state_tf = m_state_tf;
+  state_tf = state;
   motion_common::doTransform(state, state_tf, tf);
   // Diagnostic stuff: should maybe be different functions
   const auto start = std::chrono::system_clock::now();
-  Diagnostic diag;
+  auto & diag = m_diagnostic;
   if (m_diagnostic_pub) {
     diag.diag_header.computation_start = time_utils::to_message(start);
     if (m_controller->get_reference_trajectory().points.empty()) {
@@ -242,6 +244,8 @@ void ControllerBaseNode::publish(const Command & msg)
 void ControllerBaseNode::set_controller(ControllerPtr && controller) noexcept
 {
   m_controller = std::forward<ControllerPtr &&>(controller);
+  // The name is filled from the new controller
+  m_diagnostic.diag_header.name.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -163,6 +163,121 @@ MOTION_COMMON_PUBLIC float64_t calcSignedArcLength(
 MOTION_COMMON_PUBLIC float64_t calcLongitudinalDeviation(
   const geometry_msgs::msg::Pose & base_pose, const geometry_msgs::msg::Point & target_point);
 
+/**
+  * @brief queries that are repeated on the same points, e.g. once per control period.
+  *        The arc length and the time from start of the points are accumulated once, so that
+  *        the arc length between two points and the point at an arc length or at a time are found
+  *        in O(log n). The next zero velocity point of each point is also found once, so that the
+  *        stop point is found in O(1). The nearest point is first searched in a window around the
+  *        previous nearest point, and in all the points when the target is farther from the
+  *        nearest point of the window than the borders of the window are along the points. Where
+  *        the trajectory passes near itself, this follows the part of the trajectory that was
+  *        nearest before.
+  */
+class MOTION_COMMON_PUBLIC TrajectoryQuery
+{
+public:
+  /**
+    * @brief constructor
+    * @param [in] points points to query, which must outlive the query and must not change
+    * @param [in] search_window number of points before and after the previous nearest point that
+    *             are searched first
+    * @throw std::invalid_argument if the points are empty
+    */
+  explicit TrajectoryQuery(const Points & points, const size_t search_window = 100U);
+
+  /**
+    * @brief search the index of the point nearest to the given target
+    * @param [in] point target point
+    * @return index of the point nearest to the target
+    */
+  size_t findNearestIndex(const geometry_msgs::msg::Point & point);
+
+  /**
+    * @brief search the index of the point nearest to the given target with limits on the distance and yaw deviation
+    * @param [in] pose target point
+    * @param [in] max_dist optional maximum distance from the pose when searching for the nearest index
+    * @param [in] max_yaw optional maximum deviation from the pose when searching for the nearest index
+    * @return index of the point nearest to the target
+    */
+  std::experimental::optional<size_t> findNearestIndex(
+    const geometry_msgs::msg::Pose & pose,
+    const float64_t max_dist = std::numeric_limits<float64_t>::max(),
+    const float64_t max_yaw = std::numeric_limits<float64_t>::max());
+
+  /**
+    * @brief search the nearest segment index to the given target as findNearestSegmentIndex(),
+    *        with the nearest point found as findNearestIndex()
+    * @param [in] point target point
+    * @return index of the first point of the nearest segment
+    */
+  size_t findNearestSegmentIndex(const geometry_msgs::msg::Point & point);
+
+  /**
+    * @brief calculate arc length along the points, as calcSignedArcLength() up to rounding
+    * @param [in] src_idx source index
+    * @param [in] dst_idx destination index
+    * @return arc length distance from source to destination along the points
+    */
+  float64_t calcSignedArcLength(const size_t src_idx, const size_t dst_idx) const;
+
+  /**
+    * @brief calculate arc length along the points from the given point to a point, as
+    *        calcSignedArcLength() with the segment found as findNearestSegmentIndex()
+    * @param [in] src_point source point
+    * @param [in] dst_idx destination index
+    * @return arc length distance from source to destination along the points
+    */
+  float64_t calcSignedArcLength(const geometry_msgs::msg::Point & src_point, const size_t dst_idx);
+
+  /**
+    * @brief search the first zero velocity point from the given index, as
+    *        searchZeroVelocityIndex() with the default epsilon
+    * @param [in] src_idx index to start the search at
+    * @return index of the zero velocity point, nullopt if there is none
+    */
+  std::experimental::optional<size_t> searchZeroVelocityIndex(const size_t src_idx = 0U) const;
+
+  /**
+    * @brief search the last point whose arc length from the first point is at most the given one
+    * @param [in] arc_length arc length from the first point [m]
+    * @return index of the point, 0 if the arc length is negative
+    */
+  size_t findIndexAtArcLength(const float64_t arc_length) const;
+
+  /**
+    * @brief search the last point whose time from start is at most the given one, assuming that
+    *        the time from start increases along the points
+    * @param [in] time_from_start time from start [s]
+    * @return index of the point, 0 if the time is before the first point
+    */
+  size_t findIndexAtTime(const float64_t time_from_start) const;
+
+  /**
+    * @brief get the points that are queried
+    */
+  const Points & getPoints() const noexcept {return *m_points;}
+
+private:
+  /**
+    * @brief search the nearest point in [begin, end) as findNearestIndex()
+    */
+  std::experimental::optional<size_t> findNearestIndexInRange(
+    const geometry_msgs::msg::Pose & pose, const float64_t max_dist, const float64_t max_yaw,
+    const size_t begin, const size_t end) const;
+
+  const Points * m_points;
+  size_t m_search_window;
+  //!< @brief arc length of each point from the first point [m]
+  std::vector<float64_t> m_arc_lengths;
+  //!< @brief time from start of each point [s]
+  std::vector<float64_t> m_times;
+  //!< @brief first zero velocity point at or after each point, the number of points if none
+  std::vector<size_t> m_next_stop_indices;
+  //!< @brief nearest point of the previous search
+  std::experimental::optional<size_t> m_nearest_idx;
+};
+
 }  // namespace motion_common
 }  // namespace motion
 }  // namespace autoware
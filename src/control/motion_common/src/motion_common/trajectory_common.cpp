@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 #include <limits>
 
 #include "motion_common/trajectory_common.hpp"
@@ -211,6 +214,166 @@ float64_t calcLongitudinalDeviation(
 
   return base_unit_vec.dot(diff_vec);
 }
+
+TrajectoryQuery::TrajectoryQuery(const Points & points, const size_t search_window)
+: m_points{&points}, m_search_window{search_window}
+{
+  validateNonEmpty(points);
+
+  m_arc_lengths.reserve(points.size());
+  m_times.reserve(points.size());
+  float64_t dist_sum = 0.0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (i > 0) {
+      dist_sum +=
+        autoware::common::geometry::distance_2d<float64_t>(points.at(i - 1), points.at(i));
+    }
+    m_arc_lengths.push_back(dist_sum);
+    m_times.push_back(
+      std::chrono::duration<float64_t>(
+        time_utils::from_message(points.at(i).time_from_start)).count());
+  }
+
+  // filled backwards, each point takes the stop point of the next one unless it stops itself
+  constexpr float64_t epsilon = 1e-3;
+  m_next_stop_indices.resize(points.size());
+  size_t next_stop_idx = points.size();
+  for (size_t i = points.size(); i > 0U; --i) {
+    if (static_cast<float64_t>(std::fabs(points.at(i - 1U).longitudinal_velocity_mps)) < epsilon) {
+      next_stop_idx = i - 1U;
+    }
+    m_next_stop_indices[i - 1U] = next_stop_idx;
+  }
+}
+
+size_t TrajectoryQuery::findNearestIndex(const geometry_msgs::msg::Point & point)
+{
+  geometry_msgs::msg::Pose pose;
+  pose.position = point;
+  return findNearestIndex(pose).value();
+}
+
+std::experimental::optional<size_t> TrajectoryQuery::findNearestIndex(
+  const geometry_msgs::msg::Pose & pose, const float64_t max_dist, const float64_t max_yaw)
+{
+  const size_t size = m_points->size();
+  if (m_nearest_idx) {
+    const size_t begin = *m_nearest_idx - std::min(*m_nearest_idx, m_search_window);
+    const size_t end = std::min(*m_nearest_idx + m_search_window + 1U, size);
+    const auto idx = findNearestIndexInRange(pose, max_dist, max_yaw, begin, end);
+    // the nearest point of the window is kept when it is nearer to the target than the borders
+    // of the window are to it along the points, where the points outside of the window continue
+    if (idx) {
+      const auto dist =
+        autoware::common::geometry::distance_2d<float64_t>((*m_points)[*idx], pose.position);
+      const bool begin_ok = (begin == 0U) || (dist < calcSignedArcLength(begin, *idx));
+      const bool end_ok = (end == size) || (dist < calcSignedArcLength(*idx, end - 1U));
+      if (begin_ok && end_ok) {
+        m_nearest_idx = idx;
+        return idx;
+      }
+    }
+  }
+  m_nearest_idx = findNearestIndexInRange(pose, max_dist, max_yaw, 0U, size);
+  return m_nearest_idx;
+}
+
+std::experimental::optional<size_t> TrajectoryQuery::findNearestIndexInRange(
+  const geometry_msgs::msg::Pose & pose, const float64_t max_dist, const float64_t max_yaw,
+  const size_t begin, const size_t end) const
+{
+  const bool check_yaw = max_yaw < std::numeric_limits<float64_t>::max();
+  const auto target_yaw = check_yaw ? tf2::getYaw(pose.orientation) : 0.0;
+
+  float64_t min_dist = std::numeric_limits<float64_t>::max();
+  bool is_nearest_found = false;
+  size_t min_idx = 0;
+  for (size_t i = begin; i < end; ++i) {
+    const auto & point = (*m_points)[i];
+    const auto dist = autoware::common::geometry::distance_2d<float64_t>(point, pose.position);
+    if (dist > max_dist) {
+      continue;
+    }
+
+    if (check_yaw) {
+      const auto base_yaw = ::motion::motion_common::to_angle(point.heading);
+      const auto yaw = calcYawDeviation(base_yaw, target_yaw);
+      if (std::fabs(yaw) > max_yaw) {
+        continue;
+      }
+    }
+
+    if (dist >= min_dist) {
+      continue;
+    }
+
+    min_dist = dist;
+    min_idx = i;
+    is_nearest_found = true;
+  }
+  return is_nearest_found ? std::experimental::optional<size_t>(min_idx) : std::experimental::
+         nullopt;
+}
+
+size_t TrajectoryQuery::findNearestSegmentIndex(const geometry_msgs::msg::Point & point)
+{
+  const size_t nearest_idx = findNearestIndex(point);
+
+  if (nearest_idx == 0) {
+    return 0;
+  } else if (nearest_idx == m_points->size() - 1) {
+    return m_points->size() - 2;
+  }
+
+  const float64_t signed_length = calcLongitudinalOffsetToSegment(*m_points, nearest_idx, point);
+
+  if (signed_length <= 0) {
+    return nearest_idx - 1;
+  }
+
+  return nearest_idx;
+}
+
+float64_t TrajectoryQuery::calcSignedArcLength(const size_t src_idx, const size_t dst_idx) const
+{
+  return m_arc_lengths.at(dst_idx) - m_arc_lengths.at(src_idx);
+}
+
+float64_t TrajectoryQuery::calcSignedArcLength(
+  const geometry_msgs::msg::Point & src_point, const size_t dst_idx)
+{
+  const size_t src_seg_idx = findNearestSegmentIndex(src_point);
+
+  return calcSignedArcLength(src_seg_idx, dst_idx) -
+         calcLongitudinalOffsetToSegment(*m_points, src_seg_idx, src_point);
+}
+
+std::experimental::optional<size_t> TrajectoryQuery::searchZeroVelocityIndex(
+  const size_t src_idx) const
+{
+  if (src_idx >= m_next_stop_indices.size()) {
+    return {};
+  }
+  const size_t stop_idx = m_next_stop_indices[src_idx];
+  if (stop_idx == m_next_stop_indices.size()) {
+    return {};
+  }
+  return stop_idx;
+}
+
+size_t TrajectoryQuery::findIndexAtArcLength(const float64_t arc_length) const
+{
+  const auto it = std::upper_bound(m_arc_lengths.begin(), m_arc_lengths.end(), arc_length);
+  return (it == m_arc_lengths.begin()) ? 0U :
+         static_cast<size_t>(std::distance(m_arc_lengths.begin(), it)) - 1U;
+}
+
+size_t TrajectoryQuery::findIndexAtTime(const float64_t time_from_start) const
+{
+  const auto it = std::upper_bound(m_times.begin(), m_times.end(), time_from_start);
+  return (it == m_times.begin()) ? 0U :
+         static_cast<size_t>(std::distance(m_times.begin(), it)) - 1U;
+}
 }  // namespace motion_common
 }  // namespace motion
 }  // namespace autoware
@@ -16,6 +16,7 @@
 /// \brief This file includes tests for functions in trajectory_common
 
 #include <experimental/optional>
+#include <chrono>
 #include <cmath>
 
 #include "common/types.hpp"
@@ -23,6 +24,7 @@
 #include "helper_functions/angle_utils.hpp"
 #include "motion_common/trajectory_common.hpp"
 #include "tf2/LinearMath/Quaternion.h"
+#include "time_utils/time_utils.hpp"
 
 
 using autoware::common::types::float64_t;
@@ -403,3 +405,107 @@ TEST(Trajectory, CalcSignedArcLengthPointToPoint)
   src.y = 0.0;
   EXPECT_EQ(calcSignedArcLength(points, src, dest), 5.0);
 }
+
+TEST(TrajectoryCommonTests, TrajectoryQuery) {
+  using autoware::motion::motion_common::TrajectoryQuery;
+  using autoware::motion::motion_common::Point;
+  using autoware::motion::motion_common::Points;
+  using motion::motion_common::from_angle;
+
+  Points points;
+  EXPECT_THROW(TrajectoryQuery{points}, std::invalid_argument);
+
+  // Making a trajectory going to (49,0) and back on y = 1, with one point per meter and 0.1s
+  Point p;
+  for (size_t i = 0; i < 100; ++i) {
+    const bool is_back = i >= 50;
+    p.x = is_back ? static_cast<float>(99 - i) : static_cast<float>(i);
+    p.y = is_back ? 1.0 : 0.0;
+    p.heading = from_angle(is_back ? M_PI : 0.0);
+    p.time_from_start = time_utils::to_message(std::chrono::milliseconds(100 * i));
+    points.push_back(p);
+  }
+  TrajectoryQuery query(points, 10U);
+
+  geometry_msgs::msg::Point target;
+  target.x = 10.2;
+  target.y = 0.1;
+  EXPECT_EQ(query.findNearestIndex(target), size_t(10));
+  target.x = 15.3;
+  target.y = 0.4;
+  EXPECT_EQ(query.findNearestIndex(target), size_t(15));
+  // outside of the window
+  target.x = 29.0;
+  target.y = 0.4;
+  EXPECT_EQ(query.findNearestIndex(target), size_t(29));
+  // the way back is nearer, but the window follows the way out
+  target.x = 30.0;
+  target.y = 0.55;
+  EXPECT_EQ(autoware::motion::motion_common::findNearestIndex(points, target), size_t(69));
+  EXPECT_EQ(query.findNearestIndex(target), size_t(30));
+  // the way back is much nearer than the way out
+  target.x = 20.0;
+  target.y = 0.9;
+  EXPECT_EQ(query.findNearestIndex(target), size_t(79));
+
+  // limit on the orientation
+  geometry_msgs::msg::Pose pose;
+  pose.position.x = 40.0;
+  pose.position.y = 0.45;
+  EXPECT_EQ(query.findNearestIndex(pose, 100.0, 0.1).value(), size_t(40));
+  EXPECT_EQ(query.findNearestIndex(pose, 0.1, 0.1), std::experimental::nullopt);
+
+  // arc length
+  EXPECT_NEAR(
+    query.calcSignedArcLength(3, 60),
+    autoware::motion::motion_common::calcSignedArcLength(points, 3, 60), 1e-9);
+  EXPECT_NEAR(query.calcSignedArcLength(60, 3), -57.0, 1e-9);
+  EXPECT_EQ(query.findIndexAtArcLength(-1.0), size_t(0));
+  EXPECT_EQ(query.findIndexAtArcLength(10.5), size_t(10));
+  EXPECT_EQ(query.findIndexAtArcLength(60.0), size_t(60));
+  EXPECT_EQ(query.findIndexAtArcLength(1000.0), size_t(99));
+
+  // time
+  EXPECT_EQ(query.findIndexAtTime(-1.0), size_t(0));
+  EXPECT_EQ(query.findIndexAtTime(0.55), size_t(5));
+  EXPECT_EQ(query.findIndexAtTime(100.0), size_t(99));
+}
+
+TEST(TrajectoryCommonTests, TrajectoryQueryStopPoint) {
+  using autoware::motion::motion_common::TrajectoryQuery;
+  using autoware::motion::motion_common::Point;
+  using autoware::motion::motion_common::Points;
+  namespace trajectory_common = autoware::motion::motion_common;
+
+  // Making a straight trajectory with one point per meter, stopping at 30 and at the end
+  Points points;
+  Point p;
+  for (size_t i = 0; i < 80; ++i) {
+    p.x = static_cast<float>(i);
+    p.longitudinal_velocity_mps = ((i == 30) || (i >= 70)) ? 0.0f : 5.0f;
+    points.push_back(p);
+  }
+  TrajectoryQuery query(points, 10U);
+
+  // stop point, from every index and beyond the points
+  for (size_t i = 0; i <= points.size(); ++i) {
+    EXPECT_EQ(
+      query.searchZeroVelocityIndex(i),
+      trajectory_common::searchZeroVelocityIndex(points, i, points.size()));
+  }
+  EXPECT_EQ(query.searchZeroVelocityIndex().value(), size_t(30));
+  EXPECT_EQ(query.searchZeroVelocityIndex(31).value(), size_t(70));
+
+  // nearest segment and arc length from a point, on and between the points
+  geometry_msgs::msg::Point target;
+  for (const float64_t x : {-1.0, 0.0, 5.0, 12.4, 13.6, 79.0, 85.0}) {
+    target.x = x;
+    target.y = 0.3;
+    EXPECT_EQ(
+      query.findNearestSegmentIndex(target),
+      trajectory_common::findNearestSegmentIndex(points, target));
+    EXPECT_NEAR(
+      query.calcSignedArcLength(target, 30),
+      trajectory_common::calcSignedArcLength(points, target, 30), 1e-9);
+  }
+}
@@ -0,0 +1,209 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef MOTION_TESTING__SCENARIO_RUNNER_HPP_
+#define MOTION_TESTING__SCENARIO_RUNNER_HPP_
+
+#include <motion_testing/motion_testing.hpp>
+#include <motion_testing/visibility_control.hpp>
+#include <autoware_auto_msgs/msg/vehicle_control_command.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace motion
+{
+namespace motion_testing
+{
+using Command = autoware_auto_msgs::msg::VehicleControlCommand;
+
+/// \brief Shape of the reference trajectory of a scenario
+enum class TrajectoryKind : uint8_t
+{
+  CONSTANT_VELOCITY,
+  CONSTANT_ACCELERATION,
+  CONSTANT_TURN_RATE
+};
+
+/// \brief One closed loop run of a controller against a reference trajectory
+struct Scenario
+{
+  std::string name;
+  TrajectoryKind trajectory;
+  Real speed;  // initial speed of the trajectory, m/s
+  Real position_noise;  // standard deviation of the measured position, m
+  Real heading_noise;  // standard deviation of the measured heading, rad
+  std::chrono::nanoseconds dt;  // spacing of the trajectory points and control period
+  uint32_t seed;  // seed of the measurement noise
+};
+
+/// \brief Tracking error and compute time of one scenario
+struct ScenarioResult
+{
+  std::string name;
+  Index steps;  // number of control commands computed
+  Real max_lateral_error;  // m
+  Real rms_lateral_error;  // m
+  Real rms_velocity_error;  // m/s
+  std::chrono::nanoseconds mean_compute_time;
+  std::chrono::nanoseconds max_compute_time;
+};
+
+/// \brief Aggregated statistics over many scenarios
+struct ScenarioSummary
+{
+  Index num_scenarios;
+  Real max_lateral_error;  // worst lateral error of all scenarios, m
+  Real mean_rms_lateral_error;  // m
+  Real mean_rms_velocity_error;  // m/s
+  std::chrono::nanoseconds mean_compute_time;
+  std::chrono::nanoseconds max_compute_time;
+};
+
+/// \brief Build the cross product of trajectory shapes, speeds and position noise levels; the
+///        heading noise is scaled with the position noise, and every scenario gets its own seed
+MOTION_TESTING_PUBLIC std::vector<Scenario> make_scenario_matrix(
+  const std::vector<TrajectoryKind> & trajectories,
+  const std::vector<Real> & speeds,
+  const std::vector<Real> & position_noises,
+  std::chrono::nanoseconds dt,
+  uint32_t seed = 0U);
+
+/// \brief Generate the reference trajectory of a scenario, starting at the origin
+MOTION_TESTING_PUBLIC Trajectory make_trajectory(const Scenario & scenario);
+
+/// \brief Advance the state by one period with a kinematic bicycle model that follows the
+///        commanded acceleration and front wheel angle ideally
+MOTION_TESTING_PUBLIC State step_vehicle(
+  const State & state,
+  const Command & command,
+  Real wheelbase,
+  std::chrono::nanoseconds dt);
+
+/// \brief Add normally distributed noise to the position and heading of the state
+MOTION_TESTING_PUBLIC State add_noise(
+  const State & state,
+  const Scenario & scenario,
+  Generator & gen);
+
+/// \brief Signed lateral distance of the point to the closest trajectory point, and its velocity
+///        difference to that point
+/// \throw std::domain_error If the trajectory is empty
+MOTION_TESTING_PUBLIC std::pair<Real, Real> tracking_error(
+  const Trajectory & trajectory,
+  const Point & point);
+
+/// \brief Aggregate the results of many scenarios
+/// \throw std::domain_error If there are no results
+MOTION_TESTING_PUBLIC ScenarioSummary summarize(const std::vector<ScenarioResult> & results);
+
+/// \brief Run the controller in closed loop with step_vehicle until the end of the trajectory
+/// \tparam ControllerT Type with set_trajectory(Trajectory) and compute_command(State) -> Command
+template<typename ControllerT>
+ScenarioResult run_scenario(ControllerT & controller, const Scenario & scenario, Real wheelbase)
+{
+  const auto trajectory = make_trajectory(scenario);
+  controller.set_trajectory(trajectory);
+  Generator gen{scenario.seed};
+
+  ScenarioResult result{scenario.name, {}, {}, {}, {}, {}, {}};
+  State state{rosidl_runtime_cpp::MessageInitialization::ALL};
+  state.header = trajectory.header;
+  state.state = trajectory.points.front();
+  auto sum_lateral_error = 0.0;
+  auto sum_velocity_error = 0.0;
+  auto sum_compute_time = std::chrono::nanoseconds::zero();
+  for (Index i = 1U; i < trajectory.points.size(); ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto command = controller.compute_command(add_noise(state, scenario, gen));
+    const auto compute_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+    state = step_vehicle(state, command, wheelbase, scenario.dt);
+
+    const auto error = tracking_error(trajectory, state.state);
+    result.max_lateral_error = std::max(result.max_lateral_error, std::fabs(error.first));
+    sum_lateral_error += static_cast<double>(error.first * error.first);
+    sum_velocity_error += static_cast<double>(error.second * error.second);
+    sum_compute_time += compute_time;
+    result.max_compute_time = std::max(result.max_compute_time, compute_time);
+    ++result.steps;
+  }
+  if (result.steps > 0U) {
+    const auto steps = static_cast<double>(result.steps);
+    result.rms_lateral_error = static_cast<Real>(std::sqrt(sum_lateral_error / steps));
+    result.rms_velocity_error = static_cast<Real>(std::sqrt(sum_velocity_error / steps));
+    result.mean_compute_time = sum_compute_time / result.steps;
+  }
+  return result;
+}
+
+/// \brief Run all scenarios in parallel, each with its own controller
+/// \param[in] scenarios Scenarios to run, e.g. from make_scenario_matrix
+/// \param[in] make_controller Callable returning a (smart) pointer to a new controller; it is
+///                            called from the worker threads
+/// \param[in] wheelbase Wheelbase of the simulated vehicle, m
+/// \param[in] num_threads Number of worker threads, one per core if 0
+/// \return The results in the order of the scenarios
+/// \throw Rethrows the first exception thrown by a controller, after all workers finished
+template<typename ControllerFactoryT>
+std::vector<ScenarioResult> run_scenarios(
+  const std::vector<Scenario> & scenarios,
+  const ControllerFactoryT & make_controller,
+  const Real wheelbase,
+  std::size_t num_threads = 0U)
+{
+  if (num_threads == 0U) {
+    num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  num_threads = std::min(num_threads, scenarios.size());
+  std::vector<ScenarioResult> results(scenarios.size());
+  std::vector<std::exception_ptr> errors(scenarios.size());
+  // scenarios are handed out one by one, since their run times differ a lot
+  std::atomic<std::size_t> next{0U};
+  const auto work = [&]() {
+      for (auto i = next++; i < scenarios.size(); i = next++) {
+        try {
+          auto controller = make_controller();
+          results[i] = run_scenario(*controller, scenarios[i], wheelbase);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    };
+  std::vector<std::thread> workers;
+  for (std::size_t i = 1U; i < num_threads; ++i) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto & worker : workers) {
+    worker.join();
+  }
+  for (const auto & error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  return results;
+}
+}  // namespace motion_testing
+}  // namespace motion
+
+#endif  // MOTION_TESTING__SCENARIO_RUNNER_HPP_
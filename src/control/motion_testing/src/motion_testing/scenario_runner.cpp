@@ -0,0 +1,197 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "motion_testing/scenario_runner.hpp"
+
+#include <time_utils/time_utils.hpp>
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace motion
+{
+namespace motion_testing
+{
+namespace
+{
+Real to_angle(const decltype(Point::heading) & heading)
+{
+  return 2.0F * std::atan2(heading.imag, heading.real);
+}
+
+decltype(Point::heading) from_angle(const Real angle)
+{
+  decltype(Point::heading) heading;
+  heading.real = std::cos(angle / 2.0F);
+  heading.imag = std::sin(angle / 2.0F);
+  return heading;
+}
+
+const char * to_string(const TrajectoryKind kind)
+{
+  switch (kind) {
+    case TrajectoryKind::CONSTANT_VELOCITY:
+      return "constant_velocity";
+    case TrajectoryKind::CONSTANT_ACCELERATION:
+      return "constant_acceleration";
+    case TrajectoryKind::CONSTANT_TURN_RATE:
+    default:
+      return "constant_turn_rate";
+  }
+}
+
+// Heading noise per meter of position noise
+constexpr Real kHeadingNoisePerPositionNoise = 0.1F;
+// Acceleration and turn rate of the non-constant trajectories
+constexpr Real kTrajectoryAcceleration = 0.5F;
+constexpr Real kTrajectoryTurnRate = 0.05F;
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<Scenario> make_scenario_matrix(
+  const std::vector<TrajectoryKind> & trajectories,
+  const std::vector<Real> & speeds,
+  const std::vector<Real> & position_noises,
+  const std::chrono::nanoseconds dt,
+  const uint32_t seed)
+{
+  std::vector<Scenario> ret;
+  ret.reserve(trajectories.size() * speeds.size() * position_noises.size());
+  for (const auto trajectory : trajectories) {
+    for (const auto speed : speeds) {
+      for (const auto noise : position_noises) {
+        const auto name = std::string{to_string(trajectory)} + "_v" + std::to_string(speed) +
+          "_noise" + std::to_string(noise);
+        const auto scenario_seed = seed + static_cast<uint32_t>(ret.size());
+        ret.push_back(
+          Scenario{name, trajectory, speed, noise, noise * kHeadingNoisePerPositionNoise, dt,
+            scenario_seed});
+      }
+    }
+  }
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Trajectory make_trajectory(const Scenario & scenario)
+{
+  switch (scenario.trajectory) {
+    case TrajectoryKind::CONSTANT_VELOCITY:
+      return constant_velocity_trajectory(0.0F, 0.0F, 0.0F, scenario.speed, scenario.dt);
+    case TrajectoryKind::CONSTANT_ACCELERATION:
+      return constant_acceleration_trajectory(
+        0.0F, 0.0F, 0.0F, scenario.speed, kTrajectoryAcceleration, scenario.dt);
+    case TrajectoryKind::CONSTANT_TURN_RATE:
+    default:
+      return constant_velocity_turn_rate_trajectory(
+        0.0F, 0.0F, 0.0F, scenario.speed, kTrajectoryTurnRate, scenario.dt);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+State step_vehicle(
+  const State & state,
+  const Command & command,
+  const Real wheelbase,
+  const std::chrono::nanoseconds dt)
+{
+  const auto dt_s = std::chrono::duration_cast<std::chrono::duration<Real>>(dt).count();
+  State ret{state};
+  auto & s = ret.state;
+  const auto yaw = to_angle(s.heading);
+  const auto v0 = s.longitudinal_velocity_mps;
+  s.acceleration_mps2 = command.long_accel_mps2;
+  s.front_wheel_angle_rad = command.front_wheel_angle_rad;
+  s.longitudinal_velocity_mps = v0 + (dt_s * command.long_accel_mps2);
+  s.heading_rate_rps = (v0 * std::tan(command.front_wheel_angle_rad)) / wheelbase;
+  const auto ds = dt_s * (v0 + (0.5F * dt_s * command.long_accel_mps2));
+  s.x += std::cos(yaw) * ds;
+  s.y += std::sin(yaw) * ds;
+  s.heading = from_angle(yaw + (dt_s * s.heading_rate_rps));
+  ret.header.stamp = time_utils::to_message(time_utils::from_message(state.header.stamp) + dt);
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+State add_noise(const State & state, const Scenario & scenario, Generator & gen)
+{
+  State ret{state};
+  if (scenario.position_noise > 0.0F) {
+    std::normal_distribution<Real> position{0.0F, scenario.position_noise};
+    ret.state.x += position(gen);
+    ret.state.y += position(gen);
+  }
+  if (scenario.heading_noise > 0.0F) {
+    std::normal_distribution<Real> heading{0.0F, scenario.heading_noise};
+    ret.state.heading = from_angle(to_angle(ret.state.heading) + heading(gen));
+  }
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::pair<Real, Real> tracking_error(const Trajectory & trajectory, const Point & point)
+{
+  if (trajectory.points.empty()) {
+    throw std::domain_error{"tracking_error: empty trajectory"};
+  }
+  const Point * closest = nullptr;
+  auto min_distance = std::numeric_limits<Real>::max();
+  for (const auto & pt : trajectory.points) {
+    const auto dx = point.x - pt.x;
+    const auto dy = point.y - pt.y;
+    const auto distance = (dx * dx) + (dy * dy);
+    if (distance < min_distance) {
+      min_distance = distance;
+      closest = &pt;
+    }
+  }
+  // left of the reference heading is positive
+  const auto yaw = to_angle(closest->heading);
+  const auto lateral =
+    (std::cos(yaw) * (point.y - closest->y)) - (std::sin(yaw) * (point.x - closest->x));
+  return {lateral, point.longitudinal_velocity_mps - closest->longitudinal_velocity_mps};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScenarioSummary summarize(const std::vector<ScenarioResult> & results)
+{
+  if (results.empty()) {
+    throw std::domain_error{"summarize: no results"};
+  }
+  ScenarioSummary ret{results.size(), {}, {}, {}, {}, {}};
+  auto sum_lateral_error = 0.0;
+  auto sum_velocity_error = 0.0;
+  auto sum_compute_time = std::chrono::nanoseconds::zero();
+  Index steps = 0U;
+  for (const auto & result : results) {
+    ret.max_lateral_error = std::max(ret.max_lateral_error, result.max_lateral_error);
+    sum_lateral_error += static_cast<double>(result.rms_lateral_error);
+    sum_velocity_error += static_cast<double>(result.rms_velocity_error);
+    // weighted with the number of steps, so that this is the mean over all commands
+    sum_compute_time += result.mean_compute_time * result.steps;
+    steps += result.steps;
+    ret.max_compute_time = std::max(ret.max_compute_time, result.max_compute_time);
+  }
+  const auto num_results = static_cast<double>(results.size());
+  ret.mean_rms_lateral_error = static_cast<Real>(sum_lateral_error / num_results);
+  ret.mean_rms_velocity_error = static_cast<Real>(sum_velocity_error / num_results);
+  if (steps > 0U) {
+    ret.mean_compute_time = sum_compute_time / steps;
+  }
+  return ret;
+}
+}  // namespace motion_testing
+}  // namespace motion
@@ -0,0 +1,146 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+#include <motion_testing/scenario_runner.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using motion::motion_testing::Command;
+using motion::motion_testing::Real;
+using motion::motion_testing::Scenario;
+using motion::motion_testing::ScenarioResult;
+using motion::motion_testing::State;
+using motion::motion_testing::Trajectory;
+using motion::motion_testing::TrajectoryKind;
+using motion::motion_testing::make_scenario_matrix;
+using motion::motion_testing::run_scenarios;
+using motion::motion_testing::summarize;
+
+namespace
+{
+constexpr Real kWheelbase = 2.7F;
+const auto kDt = std::chrono::milliseconds{100LL};
+
+// Feeds the acceleration and turn rate of the closest reference point forward
+class FeedforwardController
+{
+public:
+  void set_trajectory(const Trajectory & trajectory)
+  {
+    m_trajectory = trajectory;
+  }
+
+  Command compute_command(const State & state)
+  {
+    const auto & points = m_trajectory.points;
+    auto closest = points.begin();
+    for (auto it = points.begin(); it != points.end(); ++it) {
+      if (std::hypot(it->x - state.state.x, it->y - state.state.y) <
+        std::hypot(closest->x - state.state.x, closest->y - state.state.y))
+      {
+        closest = it;
+      }
+    }
+    Command ret{};
+    ret.long_accel_mps2 = closest->acceleration_mps2;
+    ret.front_wheel_angle_rad =
+      std::atan(kWheelbase * closest->heading_rate_rps / closest->longitudinal_velocity_mps);
+    return ret;
+  }
+
+private:
+  Trajectory m_trajectory{};
+};
+
+class ThrowingController : public FeedforwardController
+{
+public:
+  Command compute_command(const State &)
+  {
+    throw std::runtime_error{"ThrowingController"};
+  }
+};
+
+std::vector<Scenario> matrix()
+{
+  return make_scenario_matrix(
+    {TrajectoryKind::CONSTANT_VELOCITY, TrajectoryKind::CONSTANT_ACCELERATION,
+      TrajectoryKind::CONSTANT_TURN_RATE},
+    {2.0F, 5.0F, 10.0F}, {0.0F, 0.1F}, kDt);
+}
+}  // namespace
+
+TEST(ScenarioRunner, Matrix)
+{
+  const auto scenarios = matrix();
+  ASSERT_EQ(scenarios.size(), 18U);
+  EXPECT_EQ(scenarios[0U].trajectory, TrajectoryKind::CONSTANT_VELOCITY);
+  EXPECT_FLOAT_EQ(scenarios[1U].position_noise, 0.1F);
+  EXPECT_FLOAT_EQ(scenarios[2U].speed, 5.0F);
+  EXPECT_EQ(scenarios.back().trajectory, TrajectoryKind::CONSTANT_TURN_RATE);
+  EXPECT_NE(scenarios[0U].seed, scenarios[1U].seed);
+  EXPECT_NE(scenarios[0U].name, scenarios[1U].name);
+}
+
+TEST(ScenarioRunner, NoiseFreeTracking)
+{
+  const auto scenarios = make_scenario_matrix(
+    {TrajectoryKind::CONSTANT_VELOCITY, TrajectoryKind::CONSTANT_ACCELERATION},
+    {5.0F}, {0.0F}, kDt);
+  const auto results = run_scenarios(
+    scenarios, [] {return std::make_unique<FeedforwardController>();}, kWheelbase);
+  ASSERT_EQ(results.size(), scenarios.size());
+  for (const auto & result : results) {
+    EXPECT_GT(result.steps, 0U);
+    EXPECT_LT(result.max_lateral_error, 1.0E-3F) << result.name;
+    EXPECT_LT(result.rms_velocity_error, 1.0E-3F) << result.name;
+    EXPECT_LE(result.mean_compute_time, result.max_compute_time);
+  }
+}
+
+TEST(ScenarioRunner, ParallelMatchesSerial)
+{
+  const auto scenarios = matrix();
+  const auto make_controller = [] {return std::make_unique<FeedforwardController>();};
+  const auto serial = run_scenarios(scenarios, make_controller, kWheelbase, 1U);
+  const auto parallel = run_scenarios(scenarios, make_controller, kWheelbase, 4U);
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (auto i = 0U; i < serial.size(); ++i) {
+    EXPECT_EQ(serial[i].name, parallel[i].name);
+    EXPECT_EQ(serial[i].steps, parallel[i].steps);
+    EXPECT_EQ(serial[i].max_lateral_error, parallel[i].max_lateral_error);
+    EXPECT_EQ(serial[i].rms_lateral_error, parallel[i].rms_lateral_error);
+    EXPECT_EQ(serial[i].rms_velocity_error, parallel[i].rms_velocity_error);
+  }
+
+  const auto summary = summarize(parallel);
+  EXPECT_EQ(summary.num_scenarios, scenarios.size());
+  EXPECT_GT(summary.max_lateral_error, 0.0F);
+  EXPECT_LE(summary.mean_rms_lateral_error, summary.max_lateral_error);
+  EXPECT_LE(summary.mean_compute_time, summary.max_compute_time);
+}
+
+TEST(ScenarioRunner, Errors)
+{
+  const auto scenarios = matrix();
+  EXPECT_THROW(
+    run_scenarios(
+      scenarios, [] {return std::make_unique<ThrowingController>();}, kWheelbase),
+    std::runtime_error);
+  EXPECT_THROW(summarize(std::vector<ScenarioResult>{}), std::domain_error);
+}
@@ -14,7 +14,10 @@
 
 #include "mpc_controller_nodes/mpc_controller_node.hpp"
 
+#include <helper_functions/thread_scheduling.hpp>
+
 #include <memory>
+#include <string>
 
 int32_t main(int32_t argc, char ** argv)
 {
@@ -23,6 +26,15 @@ int32_t main(int32_t argc, char ** argv)
   using motion::control::mpc_controller_nodes::MpcControllerNode;
   const auto nd = std::make_shared<MpcControllerNode>("mpc_controller", "");
 
+  // The executor runs in this thread
+  using autoware::common::helper_functions::apply_thread_scheduling;
+  using autoware::common::helper_functions::declare_thread_scheduling;
+  const std::string error =
+    apply_thread_scheduling(declare_thread_scheduling(*nd, "executor_thread"), pthread_self());
+  if (!error.empty()) {
+    RCLCPP_WARN(nd->get_logger(), "Executor thread: %s", error.c_str());
+  }
+
   rclcpp::spin(nd);
 
   rclcpp::shutdown();
@@ -23,6 +23,7 @@
 #include <autoware_auto_msgs/msg/vehicle_control_command.hpp>
 #include <controller_common/controller_base.hpp>
 #include <utility>
+#include <vector>
 #include "pure_pursuit/config.hpp"
 
 namespace autoware
@@ -39,6 +40,7 @@ using TrajectoryPoint = autoware_auto_msgs::msg::TrajectoryPoint;
 using TrajectoryPointStamped = autoware_auto_msgs::msg::VehicleKinematicState;
 using ControllerDiagnostic = autoware_auto_msgs::msg::ControlDiagnostic;
 using VehicleControlCommand = autoware_auto_msgs::msg::VehicleControlCommand;
+using autoware::common::types::float64_t;
 
 /// \brief Given a trajectory and the current state, compute the control command
 class PURE_PURSUIT_PUBLIC PurePursuit
@@ -56,6 +58,11 @@ protected:
   /// \param[in] state The current position and velocity information
   /// \return the command for the vehicle control
   VehicleControlCommand compute_command_impl(const TrajectoryPointStamped & state) override;
+  /// \brief Compute the cumulative arc length of the new trajectory, which bounds the distance
+  ///        of its points for the lookahead point search
+  /// \param[in] trajectory The new trajectory
+  /// \return The trajectory unchanged
+  const Trajectory & handle_new_trajectory(const Trajectory & trajectory) override;
 
 private:
   /// \brief Compute error of the current vehicle state by comparing the nearest neighbor
@@ -89,6 +96,15 @@ private:
   /// \param[in] current_point The current position and velocity information
   /// \return True if the controller get the current target point
   PURE_PURSUIT_LOCAL bool8_t compute_target_point(const TrajectoryPoint & current_point);
+  /// \brief Find the first index from which a point can be over the lookahead distance.
+  ///        A point is at most as far as the start point plus the arc length in between, so
+  ///        the points before it are all closer than the lookahead distance
+  /// \param[in] current_point The current position and velocity information
+  /// \param[in] start_idx The index to start the search from
+  /// \return The first index which may be the target index
+  PURE_PURSUIT_LOCAL std::size_t skip_near_points(
+    const TrajectoryPoint & current_point,
+    const std::size_t start_idx);
   /// \brief Compute the 2D distance between given two points
   /// \param[in] point1 The point with x and y position information
   /// \param[in] point2 The point with x and y position information
@@ -119,6 +135,10 @@ private:
   TrajectoryPoint m_target_point;
   VehicleControlCommand m_command;
   Config m_config;
+  /// Arc length from the first point of the reference trajectory to each of its points
+  std::vector<float64_t> m_arc_lengths;
+  /// Result of the previous search of skip_near_points(), where the next search starts
+  std::size_t m_search_hint;
 
   uint32_t m_iterations;
 };  // class PurePursuit
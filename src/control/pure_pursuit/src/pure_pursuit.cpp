@@ -17,6 +17,7 @@
 #include <motion_common/motion_common.hpp>
 #include <time_utils/time_utils.hpp>
 #include <algorithm>
+#include <cstddef>
 #include <limits>
 #include <utility>
 #include "pure_pursuit/pure_pursuit.hpp"
@@ -41,8 +42,26 @@ PurePursuit::PurePursuit(const Config & cfg)
   m_target_point{},
   m_command{},
   m_config(cfg),
+  m_search_hint(0U),
   m_iterations(0U)
 {
+  m_arc_lengths.reserve(CAPACITY);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const Trajectory & PurePursuit::handle_new_trajectory(const Trajectory & trajectory)
+{
+  m_arc_lengths.resize(trajectory.points.size());
+  float64_t arc_length = 0.0;
+  for (std::size_t idx = 0U; idx < trajectory.points.size(); ++idx) {
+    if (idx != 0U) {
+      arc_length += static_cast<float64_t>(sqrtf(
+          compute_points_distance_squared(trajectory.points[idx - 1U], trajectory.points[idx])));
+    }
+    m_arc_lengths[idx] = arc_length;
+  }
+  m_search_hint = 0U;
+  return trajectory;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -236,9 +255,60 @@ void PurePursuit::compute_interpolate_target_point(
   }
 }
 ////////////////////////////////////////////////////////////////////////////////
+std::size_t PurePursuit::skip_near_points(
+  const TrajectoryPoint & current_point,
+  const std::size_t start_idx)
+{
+  // The margin keeps the points whose bound is only off by rounding
+  constexpr float64_t margin = 1.0E-3;
+  const auto & traj = get_reference_trajectory();
+  const auto start_distance =
+    sqrtf(compute_points_distance_squared(current_point, traj.points[start_idx]));
+  const auto min_arc_length = m_arc_lengths[start_idx] +
+    static_cast<float64_t>(m_lookahead_distance - start_distance) - margin;
+  if (min_arc_length <= m_arc_lengths[start_idx]) {
+    return start_idx;
+  }
+  // Gallop from the previous result, which moves little between two control cycles
+  const auto begin = m_arc_lengths.begin() + static_cast<std::ptrdiff_t>(start_idx);
+  const auto end = m_arc_lengths.end();
+  const auto hint_idx = std::min(std::max(m_search_hint, start_idx), m_arc_lengths.size() - 1U);
+  const auto hint = m_arc_lengths.begin() + static_cast<std::ptrdiff_t>(hint_idx);
+  auto first = begin;
+  auto last = end;
+  std::ptrdiff_t step = 1;
+  if (*hint < min_arc_length) {
+    first = hint + 1;
+    while ((end - first) > step) {
+      if (*(first + step) >= min_arc_length) {
+        last = first + step;
+        break;
+      }
+      first += step + 1;
+      step *= 2;
+    }
+  } else {
+    last = hint;
+    while ((last - begin) > step) {
+      if (*(last - step - 1) < min_arc_length) {
+        first = last - step;
+        break;
+      }
+      last -= step + 1;
+      step *= 2;
+    }
+  }
+  const auto idx = std::lower_bound(first, last, min_arc_length);
+  m_search_hint = static_cast<std::size_t>(idx - m_arc_lengths.begin());
+  return m_search_hint;
+}
+////////////////////////////////////////////////////////////////////////////////
 bool8_t PurePursuit::compute_target_point(const TrajectoryPoint & current_point)
 {
-  auto idx = static_cast<uint32_t>(get_current_state_spatial_index());
+  const auto start_idx = static_cast<uint32_t>(get_current_state_spatial_index());
+  const auto first_candidate_idx =
+    static_cast<uint32_t>(skip_near_points(current_point, start_idx));
+  auto idx = first_candidate_idx;
   bool8_t is_travel_direct = false;
   uint32_t last_idx_for_noupdate = 0U;
   const auto & traj = get_reference_trajectory();
@@ -267,6 +337,15 @@ bool8_t PurePursuit::compute_target_point(const TrajectoryPoint & current_point)
   bool8_t is_success = true;
   // If all points are within the distance threshold,
   if (idx == traj.points.size()) {
+    // the farthest point in the traveling direction may be among the skipped ones
+    for (auto skipped_idx = first_candidate_idx; (!is_travel_direct) && (skipped_idx > start_idx);
+      --skipped_idx)
+    {
+      if (in_traveling_direction(current_point, traj.points[skipped_idx - 1U])) {
+        is_travel_direct = true;
+        last_idx_for_noupdate = skipped_idx - 1U;
+      }
+    }
     if (is_travel_direct) {
       // use the farthest target index in the traveling direction
       m_target_point = traj.points[last_idx_for_noupdate];
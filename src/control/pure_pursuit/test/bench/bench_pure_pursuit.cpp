@@ -0,0 +1,90 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <motion_common/motion_common.hpp>
+#include <time_utils/time_utils.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "pure_pursuit/pure_pursuit.hpp"
+
+namespace
+{
+using autoware::common::types::float32_t;
+using autoware::motion::control::pure_pursuit::Config;
+using autoware::motion::control::pure_pursuit::PurePursuit;
+using autoware::motion::control::pure_pursuit::Trajectory;
+using autoware::motion::control::pure_pursuit::TrajectoryPointStamped;
+
+constexpr float32_t kVelocity = 8.0F;
+constexpr float32_t kCurvature = 0.02F;
+
+// A recorded trajectory is as dense as the recording rate: a point every few centimeters on a
+// slow drive. It bends gently along an arc at constant velocity.
+Trajectory create_recorded_trajectory(const float32_t spacing)
+{
+  Trajectory traj;
+  traj.header.frame_id = "map";
+  traj.header.stamp = time_utils::to_message(std::chrono::system_clock::now());
+  traj.points.resize(Trajectory::CAPACITY);
+  for (uint32_t idx = 0U; idx < traj.points.size(); ++idx) {
+    const auto heading = kCurvature * spacing * static_cast<float32_t>(idx);
+    auto & point = traj.points[idx];
+    point.x = std::sin(heading) / kCurvature;
+    point.y = (1.0F - std::cos(heading)) / kCurvature;
+    point.heading = ::motion::motion_common::from_angle(heading);
+    point.longitudinal_velocity_mps = kVelocity;
+    point.time_from_start.sec = 3600 + static_cast<int32_t>(idx);
+  }
+  return traj;
+}
+
+// The vehicle drives along the trajectory, slightly off to the side
+std::vector<TrajectoryPointStamped> create_states(const Trajectory & traj)
+{
+  std::vector<TrajectoryPointStamped> states;
+  for (const auto & point : traj.points) {
+    TrajectoryPointStamped state;
+    state.header.frame_id = traj.header.frame_id;
+    state.state = point;
+    state.state.y += 0.1F;
+    states.push_back(state);
+  }
+  return states;
+}
+}  // namespace
+
+// Argument: the spacing of the trajectory points in centimeters
+static void BenchComputeCommand(benchmark::State & state)
+{
+  const auto spacing = static_cast<float32_t>(state.range(0)) * 0.01F;
+  // A lookahead of a second
+  const Config cfg(1.0F, 20.0F, 1.0F, true, false, 2.0F, 0.1F, 2.0F);
+  PurePursuit controller{cfg};
+  const auto traj = create_recorded_trajectory(spacing);
+  auto states = create_states(traj);
+  for (auto _ : state) {
+    controller.set_trajectory(traj);
+    for (auto & vehicle_state : states) {
+      vehicle_state.header.stamp = traj.header.stamp;
+      benchmark::DoNotOptimize(controller.compute_command(vehicle_state));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(states.size()));
+}
+
+BENCHMARK(BenchComputeCommand)->Arg(5)->Arg(10)->Arg(50)->Unit(benchmark::kMicrosecond);
@@ -264,3 +264,51 @@ TEST_F(PurePursuitTest, ReplaceShortTrajectory)
 
   EXPECT_NO_MEMORY_OPERATIONS_END();
 }
+
+TEST_F(PurePursuitTest, DenseTrajectory)
+{
+  const Config cfg(1.0F, 100.0F, 0.2F, false, false, 2.0F, 0.1F, 2.0F);
+  PurePursuit controller(cfg);
+
+  // A straight trajectory along x with a point every 0.1 m, as recorded trajectories are
+  traj.points.resize(100U);
+  traj.header.frame_id = "traj";
+  traj.header.stamp = time_utils::to_message(std::chrono::system_clock::now());
+  for (uint32_t idx = 0U; idx < traj.points.size(); ++idx) {
+    traj.points[idx].time_from_start.sec = static_cast<int32_t>(idx);
+    traj.points[idx].x = static_cast<float32_t>(idx) * 0.1F;
+    traj.points[idx].y = 0.0F;
+    traj.points[idx].heading = from_angle(0.0F);
+    traj.points[idx].longitudinal_velocity_mps = static_cast<float32_t>(idx);
+  }
+  // The command accelerates to the velocity of the first point over the lookahead distance
+  const auto expected_accel = [this](float32_t x, float32_t velocity, uint32_t target_idx) {
+      const auto & target = traj.points[target_idx];
+      return ((target.longitudinal_velocity_mps * target.longitudinal_velocity_mps) -
+             (velocity * velocity)) / (2.0F * (target.x - x));
+    };
+
+  EXPECT_NO_MEMORY_OPERATIONS_BEGIN();
+  controller.set_trajectory(traj);
+  // lookahead of 2.05 m
+  create_current_pose(current_pose, 0.0F, 0.0F, 0.0F, 10.25F, 0.0F, 0.0F);
+  command = controller.compute_command(current_pose);
+  EXPECT_FLOAT_EQ(command.long_accel_mps2, expected_accel(0.0F, 10.25F, 21U));
+  EXPECT_FLOAT_EQ(command.front_wheel_angle_rad, 0.0F);
+
+  // Further along, the search moves forward from its previous result
+  create_current_pose(current_pose, 3.02F, 0.0F, 0.0F, 10.25F, 0.0F, 0.0F);
+  command = controller.compute_command(current_pose);
+  EXPECT_FLOAT_EQ(command.long_accel_mps2, expected_accel(3.02F, 10.25F, 51U));
+
+  // A shorter lookahead of 1 m moves the search back
+  create_current_pose(current_pose, 3.02F, 0.0F, 0.0F, 5.0F, 0.0F, 0.0F);
+  command = controller.compute_command(current_pose);
+  EXPECT_FLOAT_EQ(command.long_accel_mps2, expected_accel(3.02F, 5.0F, 41U));
+
+  // Beyond the end, the last point is the target
+  create_current_pose(current_pose, 9.0F, 0.0F, 0.0F, 10.25F, 0.0F, 0.0F);
+  command = controller.compute_command(current_pose);
+  EXPECT_FLOAT_EQ(command.long_accel_mps2, expected_accel(9.0F, 10.25F, 99U));
+  EXPECT_NO_MEMORY_OPERATIONS_END();
+}
@@ -17,6 +17,7 @@
 #include <memory>
 #include <string>
 
+#include "helper_functions/thread_scheduling.hpp"
 #include "pure_pursuit_nodes/pure_pursuit_node.hpp"
 
 int32_t main(const int32_t argc, char * argv[])
@@ -27,6 +28,15 @@ int32_t main(const int32_t argc, char * argv[])
     using autoware::motion::control::pure_pursuit_nodes::PurePursuitNode;
     const auto nd_ptr = std::make_shared<PurePursuitNode>("pure_pursuit_node");
 
+    // The executor runs in this thread
+    using autoware::common::helper_functions::apply_thread_scheduling;
+    using autoware::common::helper_functions::declare_thread_scheduling;
+    const std::string error = apply_thread_scheduling(
+      declare_thread_scheduling(*nd_ptr, "executor_thread"), pthread_self());
+    if (!error.empty()) {
+      RCLCPP_WARN(nd_ptr->get_logger(), "Executor thread: %s", error.c_str());
+    }
+
     rclcpp::spin(nd_ptr);
 
     if (!rclcpp::shutdown()) {
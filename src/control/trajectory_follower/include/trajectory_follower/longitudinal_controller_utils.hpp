@@ -18,6 +18,7 @@
 #include <cmath>
 #include <experimental/optional>  // NOLINT
 #include <limits>
+#include <vector>
 
 #include "eigen3/Eigen/Core"
 #include "eigen3/Eigen/Geometry"
@@ -63,6 +64,16 @@ TRAJECTORY_FOLLOWER_PUBLIC float64_t calcStopDistance(
   const Point & current_pos,
   const Trajectory & traj);
 
+/**
+ * @brief calculate distance to stopline from current vehicle position where velocity is 0, with
+ *        the stop point and the arc lengths precomputed once per trajectory in the query
+ * @param [in] current_pos current vehicle position
+ * @param [in] query query of the trajectory points, shared with other per-cycle searches
+ */
+TRAJECTORY_FOLLOWER_PUBLIC float64_t calcStopDistance(
+  const Point & current_pos,
+  trajectory_common::TrajectoryQuery & query);
+
 /**
  * @brief calculate pitch angle from estimated current pose
  */
@@ -79,6 +90,17 @@ TRAJECTORY_FOLLOWER_PUBLIC float64_t getPitchByTraj(
   const Trajectory & trajectory, const size_t closest_idx,
   const float64_t wheel_base);
 
+/**
+ * @brief calculate the pitch angle of getPitchByTraj() for every closest index, once per
+ *        trajectory, so that the pitch of a control cycle is looked up by its closest index
+ * @param [in] trajectory input trajectory
+ * @param [in] wheel_base length of wheel base
+ * @return pitch angle for each point of the trajectory
+ */
+TRAJECTORY_FOLLOWER_PUBLIC std::vector<float64_t> calcPitchTable(
+  const Trajectory & trajectory,
+  const float64_t wheel_base);
+
 /**
  * @brief calculate elevation angle
  */
@@ -104,18 +126,18 @@ TRAJECTORY_FOLLOWER_PUBLIC Quaternion lerpOrientation(
   const float64_t ratio);
 
 /**
- * @brief apply linear interpolation to trajectory point that is nearest to a certain point
+ * @brief apply linear interpolation to trajectory point on a segment that is nearest to a point
  * @param [in] points trajectory points
+ * @param [in] nearest_seg_idx index of the first point of the segment
  * @param [in] point Interpolated point is nearest to this point.
  */
 template<class T>
 TRAJECTORY_FOLLOWER_PUBLIC
-TrajectoryPoint lerpTrajectoryPoint(const T & points, const Point & point)
+TrajectoryPoint lerpTrajectoryPointOnSegment(
+  const T & points, const size_t nearest_seg_idx, const Point & point)
 {
   TrajectoryPoint interpolated_point;
 
-  const size_t nearest_seg_idx = trajectory_common::findNearestSegmentIndex(points, point);
-
   const float64_t len_to_interpolated =
     trajectory_common::calcLongitudinalOffsetToSegment(points, nearest_seg_idx, point);
   const float64_t len_segment =
@@ -156,6 +178,28 @@ TrajectoryPoint lerpTrajectoryPoint(const T & points, const Point & point)
   return interpolated_point;
 }
 
+/**
+ * @brief apply linear interpolation to trajectory point that is nearest to a certain point
+ * @param [in] points trajectory points
+ * @param [in] point Interpolated point is nearest to this point.
+ */
+template<class T>
+TRAJECTORY_FOLLOWER_PUBLIC
+TrajectoryPoint lerpTrajectoryPoint(const T & points, const Point & point)
+{
+  return lerpTrajectoryPointOnSegment(
+    points, trajectory_common::findNearestSegmentIndex(points, point), point);
+}
+
+/**
+ * @brief apply linear interpolation to trajectory point that is nearest to a certain point, with
+ *        the nearest segment searched around the previous one as TrajectoryQuery does
+ * @param [in] query query of the trajectory points, shared with other per-cycle searches
+ * @param [in] point Interpolated point is nearest to this point.
+ */
+TRAJECTORY_FOLLOWER_PUBLIC TrajectoryPoint lerpTrajectoryPoint(
+  trajectory_common::TrajectoryQuery & query, const Point & point);
+
 /**
  * @brief limit variable whose differential is within a certain value
  * @param [in] input_val current value
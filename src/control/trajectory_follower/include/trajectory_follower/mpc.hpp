@@ -179,8 +179,43 @@ private:
   rclcpp::Time m_time_prev = rclcpp::Time(0, 0, RCL_ROS_TIME);
   //!< @brief sign of previous target speed to calculate curvature when the target speed is 0.
   float64_t m_sign_vx = 0.0;
-  //!< @brief buffer of sent command
-  std::vector<autoware_auto_msgs::msg::AckermannLateralCommand> m_ctrl_cmd_vec;
+  //!< @brief sent steering command, stamped with the time it is applied after the input delay
+  struct SteerCmd
+  {
+    rclcpp::Time stamp;
+    float64_t steer;
+  };
+  //!< @brief ring buffer of sent commands, the oldest at m_steer_cmd_begin. It only grows when
+  //!< full, so that storing a command does not move or erase the others
+  std::vector<SteerCmd> m_steer_cmd_buffer;
+  //!< @brief buffer index of the oldest sent command
+  size_t m_steer_cmd_begin = 0U;
+  //!< @brief number of sent commands in the buffer
+  size_t m_steer_cmd_size = 0U;
+  //!< @brief MPC matrices, kept to reuse their storage in the next period
+  MPCMatrix m_mpc_matrix;
+  //!< @brief hessian and gradient of the QP cost, kept to reuse their storage
+  Eigen::MatrixXd m_hessian;
+  Eigen::MatrixXd m_gradient;
+  //!< @brief C * B and Q * C * B for one prediction step, used with the structured MPC matrix
+  Eigen::MatrixXd m_cb;
+  Eigen::MatrixXd m_qcb;
+  //!< @brief velocity and curvatures of each prediction step, used with the structured MPC matrix
+  std::vector<float64_t> m_step_velocities;
+  std::vector<float64_t> m_step_curvatures;
+  std::vector<float64_t> m_step_smooth_curvatures;
+  //!< @brief discrete model matrices and reference inputs of all the prediction steps, stacked
+  Eigen::MatrixXd m_step_a_d;
+  Eigen::MatrixXd m_step_b_d;
+  Eigen::MatrixXd m_step_c_d;
+  Eigen::MatrixXd m_step_w_d;
+  Eigen::MatrixXd m_step_u_ref;
+  //!< @brief increasing velocities [m/s] and curvatures [1/m] of the grid of the gain table
+  std::vector<float64_t> m_gain_table_velocities;
+  std::vector<float64_t> m_gain_table_curvatures;
+  //!< @brief gains G of the unconstrained solution Uex = G * [x0; 1; u(-1); u(-2)] at each grid
+  //!< point, by velocity and then by curvature, where u(-1) and u(-2) are the previous raw commands
+  std::vector<Eigen::MatrixXd> m_gain_table;
 
   /**
    * @brief get variables for mpc calculation
@@ -195,15 +230,9 @@ private:
    */
   float64_t calcSteerPrediction();
   /**
-   * @brief get the sum of all steering commands over the given time range
-   */
-  float64_t getSteerCmdSum(
-    const rclcpp::Time & t_start, const rclcpp::Time & t_end,
-    const float64_t time_constant) const;
-  /**
-   * @brief set the reference trajectory to follow
+   * @brief get the sent command at the given position, 0 being the oldest
    */
-  void storeSteerCmd(const float64_t steer);
+  const SteerCmd & getSteerCmd(const size_t i) const;
   /**
    * @brief set initial condition for mpc
    * @param [in] data mpc data
@@ -221,8 +250,10 @@ private:
   /**
    * @brief generate MPC matrix with trajectory and vehicle model
    * @param [in] reference_trajectory used for linearization around reference trajectory
+   * @param [out] m generated matrices, whose storage is reused if the dimensions are the same
    */
-  MPCMatrix generateMPCMatrix(const trajectory_follower::MPCTrajectory & reference_trajectory);
+  void generateMPCMatrix(
+    const trajectory_follower::MPCTrajectory & reference_trajectory, MPCMatrix * m);
   /**
    * @brief generate MPC matrix with trajectory and vehicle model
    * @param [in] mpc_matrix parameters matrix to use for optimization
@@ -231,6 +262,16 @@ private:
    */
   bool8_t executeOptimization(
     const MPCMatrix & mpc_matrix, const Eigen::VectorXd & x0, Eigen::VectorXd * Uex);
+  /**
+   * @brief compute the unconstrained optimization result from the gain table
+   * @param [in] reference_trajectory resampled reference, the gains of its first point are used
+   * @param [in] x0 initial state vector
+   * @param [out] Uex optimized input vector
+   * @return false if the first point is outside of the table or if a constraint is violated
+   */
+  bool8_t interpolateGainTable(
+    const trajectory_follower::MPCTrajectory & reference_trajectory, const Eigen::VectorXd & x0,
+    Eigen::VectorXd * Uex) const;
   /**
    * @brief resample trajectory with mpc resampling time
    */
@@ -354,6 +395,10 @@ public:
   /* parameters for path smoothing */
   //!< @brief flag to use predicted steer, not measured steer.
   bool8_t m_use_steer_prediction;
+  //!< @brief flag to build the MPC matrices and the QP cost from the nonzero blocks only.
+  bool8_t m_use_structured_mpc_matrix = false;
+  //!< @brief flag to take the command from the gain table when no constraint is violated.
+  bool8_t m_use_gain_table = false;
 
   /**
    * @brief constructor
@@ -386,6 +431,33 @@ public:
     const int64_t path_filter_moving_ave_num,
     const bool8_t enable_yaw_recalculation,
     const int64_t curvature_smoothing_num);
+  /**
+   * @brief get the sum of all steering commands over the given time range
+   * @param [in] t_start start of the time range
+   * @param [in] t_end end of the time range
+   * @param [in] time_constant time constant of the steering response [s]
+   */
+  float64_t getSteerCmdSum(
+    const rclcpp::Time & t_start, const rclcpp::Time & t_end,
+    const float64_t time_constant) const;
+  /**
+   * @brief store the sent steering command and drop the oldest one once it is no longer used
+   * @details The command is stamped with the current time of the clock plus the input delay.
+   * @param [in] steer sent steering command [rad]
+   */
+  void storeSteerCmd(const float64_t steer);
+  /**
+   * @brief precompute the gains of the unconstrained MPC on a grid of constant references
+   * @details For every velocity and curvature of the grid, the MPC matrices of a reference
+   * with this constant velocity and curvature over the horizon are generated, and the
+   * unconstrained optimum is factored into gains on the initial state and the previous commands.
+   * This must be called again when the parameters or the vehicle model change.
+   * @param [in] velocities increasing positive velocities of the grid [m/s], at least two
+   * @param [in] curvatures increasing curvatures of the grid [1/m], at least two
+   * @return false if the vehicle model is not set, a grid is invalid or a cost is singular
+   */
+  bool8_t buildGainTable(
+    const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures);
   /**
    * @brief set the vehicle model of this MPC
    */
@@ -127,6 +127,24 @@ TRAJECTORY_FOLLOWER_PUBLIC bool8_t calcMPCTrajectoryTime(MPCTrajectory & traj);
 TRAJECTORY_FOLLOWER_PUBLIC void dynamicSmoothingVelocity(
   const size_t start_idx, const float64_t start_vel, const float64_t acc_lim, const float64_t tau,
   MPCTrajectory & traj);
+/**
+ * @brief copy the MPCTrajectory with dynamic smoothing of its velocity, up to a time window ahead
+ * @details The velocity and the relative_time are the same as with dynamicSmoothingVelocity and
+ * calcMPCTrajectoryTime, but the points after the window are not copied, as their calculation
+ * would be wasted on a controller that only looks window_time ahead.
+ * @param [in] input MPCTrajectory to smooth
+ * @param [in] start_idx index of the trajectory point from which to start smoothing
+ * @param [in] start_vel initial velocity to set at the start_idx
+ * @param [in] acc_lim limit on the acceleration
+ * @param [in] tau constant to control the smoothing (high-value = very smooth)
+ * @param [in] window_time time after the point following start_idx which the output must cover
+ * @param [out] output smoothed MPCTrajectory, ending at the first point after the window
+ * @return true if points after the window were left out
+ */
+TRAJECTORY_FOLLOWER_PUBLIC bool8_t dynamicSmoothingVelocityInWindow(
+  const MPCTrajectory & input, const size_t start_idx, const float64_t start_vel,
+  const float64_t acc_lim, const float64_t tau, const float64_t window_time,
+  MPCTrajectory & output);
 /**
  * @brief calculate yaw angle in MPCTrajectory from xy vector
  * @param [inout] traj object trajectory
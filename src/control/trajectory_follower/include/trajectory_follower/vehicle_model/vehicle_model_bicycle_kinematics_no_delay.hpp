@@ -38,6 +38,8 @@
 #ifndef TRAJECTORY_FOLLOWER__VEHICLE_MODEL__VEHICLE_MODEL_BICYCLE_KINEMATICS_NO_DELAY_HPP_
 #define TRAJECTORY_FOLLOWER__VEHICLE_MODEL__VEHICLE_MODEL_BICYCLE_KINEMATICS_NO_DELAY_HPP_
 
+#include <vector>
+
 #include "trajectory_follower/vehicle_model/vehicle_model_interface.hpp"
 
 #include "common/types.hpp"
@@ -91,6 +93,32 @@ public:
    */
   void calculateReferenceInput(Eigen::MatrixXd & u_ref) override;
 
+  /**
+   * @brief calculate the discrete model matrices of all the steps of a horizon in one call,
+   *        with fixed-size matrices for each step
+   * @param [in] velocities velocity of each step [m/s]
+   * @param [in] curvatures curvature of each step, of the same size as the velocities
+   * @param [out] a_d coefficient matrices, resized to (dim_x * N, dim_x)
+   * @param [out] b_d coefficient matrices, resized to (dim_x * N, dim_u)
+   * @param [out] c_d coefficient matrices, resized to (dim_y * N, dim_x)
+   * @param [out] w_d coefficient matrices, resized to (dim_x * N, 1)
+   * @param [in] dt Discretization time [s]
+   */
+  void calculateDiscreteMatrices(
+    const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures,
+    Eigen::MatrixXd & a_d, Eigen::MatrixXd & b_d, Eigen::MatrixXd & c_d, Eigen::MatrixXd & w_d,
+    const float64_t dt) override;
+
+  /**
+   * @brief calculate the reference inputs of all the steps of a horizon in one call
+   * @param [in] velocities velocity of each step [m/s]
+   * @param [in] curvatures curvature of each step, of the same size as the velocities
+   * @param [out] u_ref inputs, resized to (dim_u * N, 1)
+   */
+  void calculateReferenceInputs(
+    const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures,
+    Eigen::MatrixXd & u_ref) override;
+
 private:
   float64_t m_steer_lim;  //!< @brief steering angle limit [rad]
 };
@@ -15,6 +15,8 @@
 #ifndef TRAJECTORY_FOLLOWER__VEHICLE_MODEL__VEHICLE_MODEL_INTERFACE_HPP_
 #define TRAJECTORY_FOLLOWER__VEHICLE_MODEL__VEHICLE_MODEL_INTERFACE_HPP_
 
+#include <vector>
+
 #include "common/types.hpp"
 #include "eigen3/Eigen/Core"
 #include "trajectory_follower/visibility_control.hpp"
@@ -110,6 +112,36 @@ public:
    * @param [out] u_ref input
    */
   virtual void calculateReferenceInput(Eigen::MatrixXd & u_ref) = 0;
+
+  /**
+   * @brief calculate the discrete model matrices of all the steps of a horizon in one call.
+   *        The block row i of each output is the matrix of calculateDiscreteMatrix() for the
+   *        velocity and curvature i, up to rounding. The velocity and curvature of the model
+   *        are not changed
+   * @param [in] velocities velocity of each step [m/s]
+   * @param [in] curvatures curvature of each step, of the same size as the velocities
+   * @param [out] a_d coefficient matrices, resized to (dim_x * N, dim_x)
+   * @param [out] b_d coefficient matrices, resized to (dim_x * N, dim_u)
+   * @param [out] c_d coefficient matrices, resized to (dim_y * N, dim_x)
+   * @param [out] w_d coefficient matrices, resized to (dim_x * N, 1)
+   * @param [in] dt Discretization time [s]
+   */
+  virtual void calculateDiscreteMatrices(
+    const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures,
+    Eigen::MatrixXd & a_d, Eigen::MatrixXd & b_d, Eigen::MatrixXd & c_d, Eigen::MatrixXd & w_d,
+    const float64_t dt);
+
+  /**
+   * @brief calculate the reference inputs of all the steps of a horizon in one call.
+   *        The block row i is the input of calculateReferenceInput() for the velocity and
+   *        curvature i. The velocity and curvature of the model are not changed
+   * @param [in] velocities velocity of each step [m/s]
+   * @param [in] curvatures curvature of each step, of the same size as the velocities
+   * @param [out] u_ref inputs, resized to (dim_u * N, 1)
+   */
+  virtual void calculateReferenceInputs(
+    const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures,
+    Eigen::MatrixXd & u_ref);
 };
 }  // namespace trajectory_follower
 }  // namespace control
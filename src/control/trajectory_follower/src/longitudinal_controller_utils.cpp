@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <experimental/optional>  // NOLINT
 #include <limits>
+#include <vector>
 
 #include "trajectory_follower/longitudinal_controller_utils.hpp"
 
@@ -69,6 +70,19 @@ float64_t calcStopDistance(
   return trajectory_common::calcSignedArcLength(traj.points, current_pos, *stop_idx_opt);
 }
 
+float64_t calcStopDistance(
+  const Point & current_pos, trajectory_common::TrajectoryQuery & query)
+{
+  const std::experimental::optional<size_t> stop_idx_opt = query.searchZeroVelocityIndex();
+
+  // If no zero velocity point, return the length between current_pose to the end of trajectory.
+  if (!stop_idx_opt) {
+    return query.calcSignedArcLength(current_pos, query.getPoints().size() - 1);
+  }
+
+  return query.calcSignedArcLength(current_pos, *stop_idx_opt);
+}
+
 float64_t getPitchByPose(const Quaternion & quaternion_msg)
 {
   float64_t roll, pitch, yaw;
@@ -117,6 +131,16 @@ float64_t getPitchByTraj(
     trajectory.points.back());
 }
 
+std::vector<float64_t> calcPitchTable(const Trajectory & trajectory, const float64_t wheel_base)
+{
+  std::vector<float64_t> pitches;
+  pitches.reserve(trajectory.points.size());
+  for (size_t i = 0; i < trajectory.points.size(); ++i) {
+    pitches.push_back(getPitchByTraj(trajectory, i, wheel_base));
+  }
+  return pitches;
+}
+
 float64_t calcElevationAngle(const TrajectoryPoint & p_from, const TrajectoryPoint & p_to)
 {
   const float64_t dx = p_from.x - p_to.x;
@@ -144,6 +168,13 @@ Pose calcPoseAfterTimeDelay(
   return pred_pose;
 }
 
+TrajectoryPoint lerpTrajectoryPoint(
+  trajectory_common::TrajectoryQuery & query, const Point & point)
+{
+  return lerpTrajectoryPointOnSegment(
+    query.getPoints(), query.findNearestSegmentIndex(point), point);
+}
+
 float64_t lerp(const float64_t v_from, const float64_t v_to, const float64_t ratio)
 {
   return v_from + (v_to - v_from) * ratio;
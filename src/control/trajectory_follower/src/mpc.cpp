@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <deque>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <string>
@@ -35,6 +36,79 @@ namespace trajectory_follower
 {
 using namespace std::chrono_literals;
 
+namespace
+{
+/*
+ * Steps of the construction of the MPC matrices that exploit their structure: Bex is block lower
+ * triangular, Cex and Qex are block diagonal. The blocks have fixed sizes for the dimensions of
+ * the bicycle models, and dynamic sizes otherwise.
+ */
+template<int DIM_X, int DIM_U, int DIM_Y>
+struct StructuredMPCStep
+{
+  /*
+   * block row i of Aex, Bex and Wex from block row i - 1, where Bex only has i nonzero blocks
+   */
+  static void predict(
+    MPCMatrix & m, const Eigen::MatrixXd & Ad, const Eigen::MatrixXd & Wd, const int64_t i,
+    const int64_t dim_x, const int64_t dim_u)
+  {
+    const Eigen::Matrix<float64_t, DIM_X, DIM_X> A = Ad;
+    const int64_t row = i * dim_x;
+    const int64_t prev_row = row - dim_x;
+    m.Aex.block<DIM_X, DIM_X>(row, 0, dim_x, dim_x).noalias() =
+      A * m.Aex.block<DIM_X, DIM_X>(prev_row, 0, dim_x, dim_x);
+    m.Bex.block<DIM_X, Eigen::Dynamic>(row, 0, dim_x, i * dim_u).noalias() =
+      A * m.Bex.block<DIM_X, Eigen::Dynamic>(prev_row, 0, dim_x, i * dim_u);
+    m.Wex.block<DIM_X, 1>(row, 0, dim_x, 1).noalias() =
+      A * m.Wex.block<DIM_X, 1>(prev_row, 0, dim_x, 1);
+    m.Wex.block<DIM_X, 1>(row, 0, dim_x, 1) += Wd;
+  }
+
+  /*
+   * add the cost of the output at step i: with CB = C_i * Bex_i, where only the first i + 1
+   * blocks of the block row Bex_i are nonzero,
+   * H += CB' * Q_i * CB, f += (C_i * (Aex_i * x0 + Wex_i))' * Q_i * CB
+   */
+  static void addCost(
+    const MPCMatrix & m, const Eigen::VectorXd & x0, const int64_t i, const int64_t dim_x,
+    const int64_t dim_u, const int64_t dim_y, Eigen::MatrixXd & CB, Eigen::MatrixXd & QCB,
+    Eigen::MatrixXd & H, Eigen::MatrixXd & f)
+  {
+    const int64_t cols = (i + 1) * dim_u;
+    const auto C = m.Cex.block<DIM_Y, DIM_X>(i * dim_y, i * dim_x, dim_y, dim_x);
+    const auto Q = m.Qex.block<DIM_Y, DIM_Y>(i * dim_y, i * dim_y, dim_y, dim_y);
+    auto CB_i = CB.block<DIM_Y, Eigen::Dynamic>(0, 0, dim_y, cols);
+    auto QCB_i = QCB.block<DIM_Y, Eigen::Dynamic>(0, 0, dim_y, cols);
+    CB_i.noalias() = C * m.Bex.block<DIM_X, Eigen::Dynamic>(i * dim_x, 0, dim_x, cols);
+    QCB_i.noalias() = Q * CB_i;
+    H.topLeftCorner(cols, cols).triangularView<Eigen::Upper>() += CB_i.transpose() * QCB_i;
+    const Eigen::Matrix<float64_t, DIM_Y, 1> y =
+      C * (m.Aex.block<DIM_X, DIM_X>(i * dim_x, 0, dim_x, dim_x) * x0 +
+      m.Wex.block<DIM_X, 1>(i * dim_x, 0, dim_x, 1));
+    f.leftCols(cols).noalias() += y.transpose() * QCB_i;
+  }
+};
+
+/*
+ * call the function with the StructuredMPCStep for the given dimensions
+ */
+template<typename FunctionT>
+void visitStructuredMPCStep(
+  const int64_t dim_x, const int64_t dim_u, const int64_t dim_y, FunctionT && function)
+{
+  if (dim_u == 1 && dim_y == 2) {
+    switch (dim_x) {
+      case 2: function(StructuredMPCStep<2, 1, 2>{}); return;
+      case 3: function(StructuredMPCStep<3, 1, 2>{}); return;
+      case 4: function(StructuredMPCStep<4, 1, 2>{}); return;
+      default: break;
+    }
+  }
+  function(StructuredMPCStep<Eigen::Dynamic, Eigen::Dynamic, Eigen::Dynamic>{});
+}
+}  // namespace
+
 bool8_t MPC::calculateMPC(
   const autoware_auto_msgs::msg::VehicleKinematicState & current_steer,
   const float64_t current_velocity,
@@ -76,11 +150,14 @@ bool8_t MPC::calculateMPC(
   }
 
   /* generate mpc matrix : predict equation Xec = Aex * x0 + Bex * Uex + Wex */
-  MPCMatrix mpc_matrix = generateMPCMatrix(mpc_resampled_ref_traj);
+  generateMPCMatrix(mpc_resampled_ref_traj, &m_mpc_matrix);
+  const MPCMatrix & mpc_matrix = m_mpc_matrix;
 
-  /* solve quadratic optimization */
+  /* solve quadratic optimization, or look up its solution if no constraint is active */
   Eigen::VectorXd Uex;
-  if (!executeOptimization(mpc_matrix, x0, &Uex)) {
+  const bool8_t is_gain_table_used =
+    m_use_gain_table && interpolateGainTable(mpc_resampled_ref_traj, x0, &Uex);
+  if (!is_gain_table_used && !executeOptimization(mpc_matrix, x0, &Uex)) {
     RCLCPP_WARN_THROTTLE(m_logger, *m_clock, 1000 /*ms*/, "optimization failed.");
     return false;
   }
@@ -171,6 +248,8 @@ bool8_t MPC::calculateMPC(
   append_diag_data(mpc_data.predicted_steer);
   // [17] angvel from predicted steer
   append_diag_data(current_velocity * tan(mpc_data.predicted_steer) / wb);
+  // [18] 1 if the command was taken from the gain table, 0 if the QP was solved
+  append_diag_data(is_gain_table_used ? 1.0 : 0.0);
 
   return true;
 }
@@ -328,7 +407,7 @@ float64_t MPC::calcSteerPrediction()
   const float64_t initial_response = std::exp(-duration / time_constant) *
     (*m_steer_prediction_prev);
 
-  if (m_ctrl_cmd_vec.size() <= 2) {return initial_response;}
+  if (m_steer_cmd_size <= 2) {return initial_response;}
 
   return initial_response + getSteerCmdSum(t_start, t_end, time_constant);
 }
@@ -336,57 +415,68 @@ float64_t MPC::calcSteerPrediction()
 float64_t MPC::getSteerCmdSum(
   const rclcpp::Time & t_start, const rclcpp::Time & t_end, const float64_t time_constant) const
 {
-  if (m_ctrl_cmd_vec.size() <= 2) {return 0.0;}
+  if (m_steer_cmd_size <= 2) {return 0.0;}
 
   // Find first index of control command container
   size_t idx = 1;
-  while (t_start > rclcpp::Time(m_ctrl_cmd_vec.at(idx).stamp)) {
-    if ((idx + 1) >= m_ctrl_cmd_vec.size()) {return 0.0;}
+  while (t_start > getSteerCmd(idx).stamp) {
+    if ((idx + 1) >= m_steer_cmd_size) {return 0.0;}
     ++idx;
   }
 
   // Compute steer command input response
   float64_t steer_sum = 0.0;
   auto t = t_start;
-  while (t_end > rclcpp::Time(m_ctrl_cmd_vec.at(idx).stamp)) {
-    const float64_t duration = (rclcpp::Time(m_ctrl_cmd_vec.at(idx).stamp) - t).seconds();
-    t = rclcpp::Time(m_ctrl_cmd_vec.at(idx).stamp);
-    steer_sum +=
-      (1 - std::exp(-duration / time_constant)) *
-      static_cast<float64_t>(m_ctrl_cmd_vec.at(idx - 1).steering_tire_angle);
+  while (t_end > getSteerCmd(idx).stamp) {
+    const float64_t duration = (getSteerCmd(idx).stamp - t).seconds();
+    t = getSteerCmd(idx).stamp;
+    steer_sum += (1 - std::exp(-duration / time_constant)) * getSteerCmd(idx - 1).steer;
     ++idx;
-    if (idx >= m_ctrl_cmd_vec.size()) {break;}
+    if (idx >= m_steer_cmd_size) {break;}
   }
 
   const float64_t duration = (t_end - t).seconds();
-  steer_sum +=
-    (1 - std::exp(-duration / time_constant)) *
-    static_cast<float64_t>(m_ctrl_cmd_vec.at(idx - 1).steering_tire_angle);
+  steer_sum += (1 - std::exp(-duration / time_constant)) * getSteerCmd(idx - 1).steer;
 
   return steer_sum;
 }
 
+const MPC::SteerCmd & MPC::getSteerCmd(const size_t i) const
+{
+  return m_steer_cmd_buffer[(m_steer_cmd_begin + i) % m_steer_cmd_buffer.size()];
+}
+
 void MPC::storeSteerCmd(const float64_t steer)
 {
   const auto time_delayed = m_clock->now() + rclcpp::Duration::from_seconds(m_param.input_delay);
-  autoware_auto_msgs::msg::AckermannLateralCommand cmd;
-  cmd.stamp = time_delayed;
-  cmd.steering_tire_angle = static_cast<float>(steer);
+
+  // grow the buffer when it is full, which only happens until it covers the stored time range
+  if (m_steer_cmd_size == m_steer_cmd_buffer.size()) {
+    constexpr size_t min_capacity = 16U;
+    std::vector<SteerCmd> buffer(std::max(min_capacity, 2U * m_steer_cmd_size));
+    for (size_t i = 0; i < m_steer_cmd_size; ++i) {
+      buffer[i] = getSteerCmd(i);
+    }
+    m_steer_cmd_buffer.swap(buffer);
+    m_steer_cmd_begin = 0U;
+  }
 
   // store published ctrl cmd
-  m_ctrl_cmd_vec.emplace_back(cmd);
+  SteerCmd & cmd =
+    m_steer_cmd_buffer[(m_steer_cmd_begin + m_steer_cmd_size) % m_steer_cmd_buffer.size()];
+  cmd.stamp = time_delayed;
+  cmd.steer = static_cast<float64_t>(static_cast<float>(steer));
+  ++m_steer_cmd_size;
 
-  if (m_ctrl_cmd_vec.size() <= 2) {
+  if (m_steer_cmd_size <= 2) {
     return;
   }
 
   // remove unused ctrl cmd
   constexpr float64_t store_time = 0.3;
-  if (
-    (time_delayed - m_ctrl_cmd_vec.at(1).stamp).seconds() >
-    m_param.input_delay + store_time)
-  {
-    m_ctrl_cmd_vec.erase(m_ctrl_cmd_vec.begin());
+  if ((time_delayed - getSteerCmd(1).stamp).seconds() > m_param.input_delay + store_time) {
+    m_steer_cmd_begin = (m_steer_cmd_begin + 1) % m_steer_cmd_buffer.size();
+    --m_steer_cmd_size;
   }
 }
 
@@ -453,6 +543,8 @@ bool8_t MPC::updateStateForDelayCompensation(
   Eigen::MatrixXd Wd(DIM_X, 1);
   Eigen::MatrixXd Cd(DIM_Y, DIM_X);
 
+  Eigen::MatrixXd ud = Eigen::MatrixXd::Zero(DIM_U, 1);
+
   Eigen::MatrixXd x_curr = *x;
   float64_t mpc_curr_time = start_time;
   for (uint64_t i = 0; i < m_input_buffer.size(); ++i) {
@@ -476,7 +568,6 @@ bool8_t MPC::updateStateForDelayCompensation(
     m_vehicle_model_ptr->setVelocity(v);
     m_vehicle_model_ptr->setCurvature(k);
     m_vehicle_model_ptr->calculateDiscreteMatrix(Ad, Bd, Cd, Wd, m_ctrl_period);
-    Eigen::MatrixXd ud = Eigen::MatrixXd::Zero(DIM_U, 1);
     ud(0, 0) = m_input_buffer.at(i);  // for steering input delay
     x_curr = Ad * x_curr + Bd * ud + Wd;
     mpc_curr_time += m_ctrl_period;
@@ -497,14 +588,17 @@ trajectory_follower::MPCTrajectory MPC::applyVelocityDynamicsFilter(
   const float64_t alim = m_param.acceleration_limit;
   const float64_t tau = m_param.velocity_time_constant;
 
-  trajectory_follower::MPCTrajectory output = input;
-  trajectory_follower::MPCUtils::dynamicSmoothingVelocity(
-    static_cast<size_t>(nearest_idx), v0,
-    alim, tau, output);
+  // Only the part of the trajectory that the prediction reaches is smoothed and copied, the
+  // reference is sampled from the point after the nearest one to the prediction time ahead of it
+  trajectory_follower::MPCTrajectory output;
+  const bool8_t is_cut = trajectory_follower::MPCUtils::dynamicSmoothingVelocityInWindow(
+    input, static_cast<size_t>(nearest_idx), v0, alim, tau, getPredictionTime(), output);
   const float64_t t_ext = 100.0;  // extra time to prevent mpc calculation failure due to short time
   const float64_t t_end = output.relative_time.back() + getPredictionTime() + t_ext;
   const float64_t v_end = 0.0;
-  output.vx.back() = v_end;  // set for end point
+  if (!is_cut) {
+    output.vx.back() = v_end;  // set for end point
+  }
   output.push_back(
     output.x.back(), output.y.back(), output.z.back(), output.yaw.back(), v_end, output.k.back(),
     output.smooth_k.back(), t_end);
@@ -516,8 +610,8 @@ trajectory_follower::MPCTrajectory MPC::applyVelocityDynamicsFilter(
  * cost function: J = Xex' * Qex * Xex + (Uex - Uref)' * R1ex * (Uex - Urefex) + Uex' * R2ex * Uex
  * Qex = diag([Q,Q,...]), R1ex = diag([R,R,...])
  */
-MPCMatrix MPC::generateMPCMatrix(
-  const trajectory_follower::MPCTrajectory & reference_trajectory)
+void MPC::generateMPCMatrix(
+  const trajectory_follower::MPCTrajectory & reference_trajectory, MPCMatrix * m_ptr)
 {
   using Eigen::MatrixXd;
 
@@ -527,7 +621,8 @@ MPCMatrix MPC::generateMPCMatrix(
   const int64_t DIM_U = m_vehicle_model_ptr->getDimU();
   const int64_t DIM_Y = m_vehicle_model_ptr->getDimY();
 
-  MPCMatrix m;
+  // the storage of the matrices is reused when the dimensions stay the same
+  MPCMatrix & m = *m_ptr;
   m.Aex = MatrixXd::Zero(DIM_X * N, DIM_X);
   m.Bex = MatrixXd::Zero(DIM_X * N, DIM_U * N);
   m.Wex = MatrixXd::Zero(DIM_X * N, 1);
@@ -551,6 +646,22 @@ MPCMatrix MPC::generateMPCMatrix(
 
   constexpr float64_t ep = 1.0e-3;  // large enough to ignore velocity noise
 
+  /* get discrete state matrix A, B, C, W and the reference input of all the steps at once */
+  if (m_use_structured_mpc_matrix) {
+    m_step_velocities.resize(static_cast<size_t>(N));
+    m_step_curvatures.resize(static_cast<size_t>(N));
+    m_step_smooth_curvatures.resize(static_cast<size_t>(N));
+    for (size_t i = 0; i < static_cast<size_t>(N); ++i) {
+      m_step_velocities[i] = reference_trajectory.vx[i];
+      m_step_curvatures[i] = reference_trajectory.k[i] * m_sign_vx;
+      m_step_smooth_curvatures[i] = reference_trajectory.smooth_k[i] * m_sign_vx;
+    }
+    m_vehicle_model_ptr->calculateDiscreteMatrices(
+      m_step_velocities, m_step_curvatures, m_step_a_d, m_step_b_d, m_step_c_d, m_step_w_d, DT);
+    m_vehicle_model_ptr->calculateReferenceInputs(
+      m_step_velocities, m_step_smooth_curvatures, m_step_u_ref);
+  }
+
   /* predict dynamics for N times */
   for (int64_t i = 0; i < N; ++i) {
     const float64_t ref_vx = reference_trajectory.vx[static_cast<size_t>(i)];
@@ -562,9 +673,16 @@ MPCMatrix MPC::generateMPCMatrix(
       m_sign_vx;
 
     /* get discrete state matrix A, B, C, W */
-    m_vehicle_model_ptr->setVelocity(ref_vx);
-    m_vehicle_model_ptr->setCurvature(ref_k);
-    m_vehicle_model_ptr->calculateDiscreteMatrix(Ad, Bd, Cd, Wd, DT);
+    if (m_use_structured_mpc_matrix) {
+      Ad = m_step_a_d.middleRows(i * DIM_X, DIM_X);
+      Bd = m_step_b_d.middleRows(i * DIM_X, DIM_X);
+      Cd = m_step_c_d.middleRows(i * DIM_Y, DIM_Y);
+      Wd = m_step_w_d.middleRows(i * DIM_X, DIM_X);
+    } else {
+      m_vehicle_model_ptr->setVelocity(ref_vx);
+      m_vehicle_model_ptr->setCurvature(ref_k);
+      m_vehicle_model_ptr->calculateDiscreteMatrix(Ad, Bd, Cd, Wd, DT);
+    }
 
     Q = Eigen::MatrixXd::Zero(DIM_Y, DIM_Y);
     R = Eigen::MatrixXd::Zero(DIM_U, DIM_U);
@@ -590,6 +708,11 @@ MPCMatrix MPC::generateMPCMatrix(
       m.Aex.block(0, 0, DIM_X, DIM_X) = Ad;
       m.Bex.block(0, 0, DIM_X, DIM_U) = Bd;
       m.Wex.block(0, 0, DIM_X, 1) = Wd;
+    } else if (m_use_structured_mpc_matrix) {
+      visitStructuredMPCStep(
+        DIM_X, DIM_U, DIM_Y, [&](auto step) {
+          decltype(step)::predict(m, Ad, Wd, i, DIM_X, DIM_U);
+        });
     } else {
       m.Aex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad * m.Aex.block(idx_x_i_prev, 0, DIM_X, DIM_X);
       for (int64_t j = 0; j < i; ++j) {
@@ -605,8 +728,12 @@ MPCMatrix MPC::generateMPCMatrix(
     m.R1ex.block(idx_u_i, idx_u_i, DIM_U, DIM_U) = R_adaptive;
 
     /* get reference input (feed-forward) */
-    m_vehicle_model_ptr->setCurvature(ref_smooth_k);
-    m_vehicle_model_ptr->calculateReferenceInput(Uref);
+    if (m_use_structured_mpc_matrix) {
+      Uref = m_step_u_ref.middleRows(i * DIM_U, DIM_U);
+    } else {
+      m_vehicle_model_ptr->setCurvature(ref_smooth_k);
+      m_vehicle_model_ptr->calculateReferenceInput(Uref);
+    }
     if (std::fabs(Uref(0, 0)) < DEG2RAD * m_param.zero_ff_steer_deg) {
       Uref(0, 0) = 0.0;  // ignore curvature noise
     }
@@ -624,8 +751,6 @@ MPCMatrix MPC::generateMPCMatrix(
   }
 
   addSteerWeightR(&m.R1ex);
-
-  return m;
 }
 
 /*
@@ -665,14 +790,33 @@ bool8_t MPC::executeOptimization(
   const int64_t DIM_U_N = m_param.prediction_horizon * m_vehicle_model_ptr->getDimU();
 
   // cost function: 1/2 * Uex' * H * Uex + f' * Uex,  H = B' * C' * Q * C * B + R
-  const MatrixXd CB = m.Cex * m.Bex;
-  const MatrixXd QCB = m.Qex * CB;
-  // MatrixXd H = CB.transpose() * QCB + m.R1ex + m.R2ex; // This calculation is heavy. looking for a good way.  //NOLINT
-  MatrixXd H = MatrixXd::Zero(DIM_U_N, DIM_U_N);
-  H.triangularView<Eigen::Upper>() = CB.transpose() * QCB;
+  MatrixXd & H = m_hessian;
+  MatrixXd & f = m_gradient;
+  if (m_use_structured_mpc_matrix) {
+    // the products of the zero blocks of B, C and Q are skipped
+    const int64_t DIM_X = m_vehicle_model_ptr->getDimX();
+    const int64_t DIM_U = m_vehicle_model_ptr->getDimU();
+    const int64_t DIM_Y = m_vehicle_model_ptr->getDimY();
+    H.setZero(DIM_U_N, DIM_U_N);
+    f.noalias() = -m.Urefex.transpose() * m.R1ex;
+    m_cb.resize(DIM_Y, DIM_U_N);
+    m_qcb.resize(DIM_Y, DIM_U_N);
+    for (int64_t i = 0; i < m_param.prediction_horizon; ++i) {
+      visitStructuredMPCStep(
+        DIM_X, DIM_U, DIM_Y, [&](auto step) {
+          decltype(step)::addCost(m, x0, i, DIM_X, DIM_U, DIM_Y, m_cb, m_qcb, H, f);
+        });
+    }
+  } else {
+    const MatrixXd CB = m.Cex * m.Bex;
+    const MatrixXd QCB = m.Qex * CB;
+    // MatrixXd H = CB.transpose() * QCB + m.R1ex + m.R2ex; // This calculation is heavy. looking for a good way.  //NOLINT
+    H = MatrixXd::Zero(DIM_U_N, DIM_U_N);
+    H.triangularView<Eigen::Upper>() = CB.transpose() * QCB;
+    f = (m.Cex * (m.Aex * x0 + m.Wex)).transpose() * QCB - m.Urefex.transpose() * m.R1ex;
+  }
   H.triangularView<Eigen::Upper>() += m.R1ex + m.R2ex;
   H.triangularView<Eigen::Lower>() = H.transpose();
-  MatrixXd f = (m.Cex * (m.Aex * x0 + m.Wex)).transpose() * QCB - m.Urefex.transpose() * m.R1ex;
   addSteerWeightF(&f);
 
   MatrixXd A = MatrixXd::Identity(DIM_U_N, DIM_U_N);
@@ -709,6 +853,141 @@ bool8_t MPC::executeOptimization(
   return true;
 }
 
+bool8_t MPC::buildGainTable(
+  const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures)
+{
+  using Eigen::MatrixXd;
+
+  m_gain_table.clear();
+  const auto is_grid = [](const std::vector<float64_t> & grid) {
+      return (grid.size() >= 2U) && std::is_sorted(grid.begin(), grid.end()) &&
+             (std::adjacent_find(grid.begin(), grid.end()) == grid.end());
+    };
+  if (!m_vehicle_model_ptr || !is_grid(velocities) || !is_grid(curvatures) ||
+    (velocities.front() <= 0.0))
+  {
+    RCLCPP_WARN(m_logger, "[buildGainTable] no vehicle model or invalid grid.");
+    return false;
+  }
+
+  const int64_t N = m_param.prediction_horizon;
+  const int64_t DIM_X = m_vehicle_model_ptr->getDimX();
+  const int64_t DIM_U_N = N * m_vehicle_model_ptr->getDimU();
+  // the state that generateMPCMatrix and addSteerWeightF depend on is restored afterwards
+  const float64_t sign_vx = m_sign_vx;
+  const float64_t raw_steer_cmd_prev = m_raw_steer_cmd_prev;
+  const float64_t raw_steer_cmd_pprev = m_raw_steer_cmd_pprev;
+  m_sign_vx = 1.0;
+
+  MPCMatrix m;
+  trajectory_follower::MPCTrajectory reference;
+  std::vector<Eigen::MatrixXd> table;
+  table.reserve(velocities.size() * curvatures.size());
+  for (const float64_t v : velocities) {
+    for (const float64_t k : curvatures) {
+      reference.clear();
+      for (int64_t i = 0; i < N; ++i) {
+        reference.push_back(
+          0.0, 0.0, 0.0, 0.0, v, k, k, static_cast<float64_t>(i) * m_param.prediction_dt);
+      }
+      generateMPCMatrix(reference, &m);
+
+      // cost function: 1/2 * Uex' * H * Uex + f' * Uex, as in executeOptimization
+      const MatrixXd CB = m.Cex * m.Bex;
+      const MatrixXd QCB = m.Qex * CB;
+      MatrixXd H = MatrixXd::Zero(DIM_U_N, DIM_U_N);
+      H.triangularView<Eigen::Upper>() = CB.transpose() * QCB + m.R1ex + m.R2ex;
+      H.triangularView<Eigen::Lower>() = H.transpose();
+      // f' = F * [x0; 1; u(-1); u(-2)], the steering terms of f are affine in u(-1) and u(-2)
+      MatrixXd F(DIM_U_N, DIM_X + 3);
+      F.leftCols(DIM_X) = QCB.transpose() * m.Cex * m.Aex;
+      MatrixXd f_steer[3];
+      for (int64_t j = 0; j < 3; ++j) {
+        m_raw_steer_cmd_prev = (j == 1) ? 1.0 : 0.0;
+        m_raw_steer_cmd_pprev = (j == 2) ? 1.0 : 0.0;
+        f_steer[j] = MatrixXd::Zero(1, DIM_U_N);
+        addSteerWeightF(&f_steer[j]);
+      }
+      F.col(DIM_X) = QCB.transpose() * m.Cex * m.Wex - m.R1ex.transpose() * m.Urefex +
+        f_steer[0].transpose();
+      F.col(DIM_X + 1) = (f_steer[1] - f_steer[0]).transpose();
+      F.col(DIM_X + 2) = (f_steer[2] - f_steer[0]).transpose();
+
+      const Eigen::LLT<MatrixXd> llt(H);
+      if (llt.info() != Eigen::Success) {
+        break;
+      }
+      table.push_back(-llt.solve(F));
+    }
+  }
+
+  m_sign_vx = sign_vx;
+  m_raw_steer_cmd_prev = raw_steer_cmd_prev;
+  m_raw_steer_cmd_pprev = raw_steer_cmd_pprev;
+  if (table.size() != velocities.size() * curvatures.size()) {
+    RCLCPP_WARN(m_logger, "[buildGainTable] the cost is singular for a grid point.");
+    return false;
+  }
+  m_gain_table_velocities = velocities;
+  m_gain_table_curvatures = curvatures;
+  m_gain_table = std::move(table);
+  return true;
+}
+
+bool8_t MPC::interpolateGainTable(
+  const trajectory_follower::MPCTrajectory & reference_trajectory, const Eigen::VectorXd & x0,
+  Eigen::VectorXd * Uex) const
+{
+  if (m_gain_table.empty() || reference_trajectory.empty()) {
+    return false;
+  }
+  // bilinear interpolation of the gains of the cell that contains the first reference point
+  const auto get_cell = [](const std::vector<float64_t> & grid, const float64_t value,
+      size_t * idx, float64_t * ratio) {
+      if ((value < grid.front()) || (value > grid.back())) {
+        return false;
+      }
+      const auto upper = std::upper_bound(grid.begin(), grid.end() - 1, value);
+      *idx = static_cast<size_t>(std::distance(grid.begin(), upper)) - 1U;
+      *ratio = (value - grid[*idx]) / (grid[*idx + 1U] - grid[*idx]);
+      return true;
+    };
+  size_t iv;
+  size_t ik;
+  float64_t rv;
+  float64_t rk;
+  if (
+    !get_cell(m_gain_table_velocities, reference_trajectory.vx[0], &iv, &rv) ||
+    !get_cell(m_gain_table_curvatures, reference_trajectory.smooth_k[0] * m_sign_vx, &ik, &rk))
+  {
+    return false;
+  }
+  const size_t num_k = m_gain_table_curvatures.size();
+  const auto gain_times = [this, num_k](
+    const size_t v_idx, const size_t k_idx, const Eigen::VectorXd & z) -> Eigen::VectorXd {
+      return m_gain_table[v_idx * num_k + k_idx] * z;
+    };
+
+  const int64_t DIM_X = m_vehicle_model_ptr->getDimX();
+  Eigen::VectorXd z(DIM_X + 3);
+  z << x0, 1.0, m_raw_steer_cmd_prev, m_raw_steer_cmd_pprev;
+  *Uex = (1.0 - rv) * ((1.0 - rk) * gain_times(iv, ik, z) + rk * gain_times(iv, ik + 1U, z)) +
+    rv * ((1.0 - rk) * gain_times(iv + 1U, ik, z) + rk * gain_times(iv + 1U, ik + 1U, z));
+
+  // the same constraints as in executeOptimization
+  const Eigen::VectorXd & u = *Uex;
+  const float64_t rate_lim = m_steer_rate_lim * m_param.prediction_dt;
+  if (std::fabs(u(0) - m_raw_steer_cmd_prev) > m_steer_rate_lim * m_ctrl_period) {
+    return false;
+  }
+  for (Eigen::Index i = 0; i < u.size(); ++i) {
+    if ((std::fabs(u(i)) > m_steer_lim) || ((i > 0) && (std::fabs(u(i) - u(i - 1)) > rate_lim))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void MPC::addSteerWeightR(Eigen::MatrixXd * R_ptr) const
 {
   const int64_t N = m_param.prediction_horizon;
@@ -296,6 +296,52 @@ void dynamicSmoothingVelocity(
   calcMPCTrajectoryTime(traj);
 }
 
+bool8_t dynamicSmoothingVelocityInWindow(
+  const MPCTrajectory & input, const size_t start_idx, const float64_t start_vel,
+  const float64_t acc_lim, const float64_t tau, const float64_t window_time,
+  MPCTrajectory & output)
+{
+  output.clear();
+  float64_t t = 0.0;
+  float64_t curr_v = start_vel;
+  float64_t window_end_time = std::numeric_limits<float64_t>::max();
+  for (size_t i = 0; i < input.size(); ++i) {
+    float64_t v = input.vx.at(i);
+    if (i == start_idx) {
+      v = start_vel;
+    } else if (i > start_idx) {
+      // Same steps as dynamicSmoothingVelocity
+      const float64_t ds =
+        std::hypot(input.x.at(i) - input.x.at(i - 1), input.y.at(i) - input.y.at(i - 1));
+      const float64_t dt = ds /
+        std::max(std::fabs(curr_v), std::numeric_limits<float64_t>::epsilon());
+      const float64_t a = tau / std::max(tau + dt, std::numeric_limits<float64_t>::epsilon());
+      const float64_t updated_v = a * curr_v + (1.0 - a) * v;
+      const float64_t dv = std::max(-acc_lim * dt, std::min(acc_lim * dt, updated_v - curr_v));
+      curr_v = curr_v + dv;
+      v = curr_v;
+    }
+    if (i > 0) {
+      // Same steps as calcMPCTrajectoryTime
+      const float64_t dx = input.x.at(i) - input.x.at(i - 1);
+      const float64_t dy = input.y.at(i) - input.y.at(i - 1);
+      const float64_t dz = input.z.at(i) - input.z.at(i - 1);
+      const float64_t dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+      t += (dist / std::max(std::fabs(output.vx.back()), 0.1));
+    }
+    output.push_back(
+      input.x.at(i), input.y.at(i), input.z.at(i), input.yaw.at(i), v, input.k.at(i),
+      input.smooth_k.at(i), t);
+    if (i == start_idx + 1) {
+      window_end_time = t + window_time;
+    }
+    if (t >= window_end_time) {
+      return i + 1 < input.size();
+    }
+  }
+  return false;
+}
+
 int64_t calcNearestIndex(
   const MPCTrajectory & traj, const geometry_msgs::msg::Pose & self_pose)
 {
@@ -56,8 +56,9 @@ bool8_t QPSolverOSQP::solve(
   Eigen::MatrixXd osqpA = Eigen::MatrixXd(dim_u + col_a, raw_a);
   osqpA << Identity, a;
 
-  /* execute optimization */
-  auto result = osqpsolver_.optimize(h_mat, osqpA, f, lower_bound, upper_bound);
+  /* execute optimization, reusing the workspace of the previous cycle when possible */
+  osqpsolver_.updateProblem(h_mat, osqpA, f, lower_bound, upper_bound);
+  auto result = osqpsolver_.optimize();
 
   std::vector<float64_t> U_osqp = std::get<0>(result);
   u =
@@ -93,6 +93,62 @@ void DynamicsBicycleModel::calculateReferenceInput(Eigen::MatrixXd & u_ref)
     (2 * m_cr * m_wheelbase);
   u_ref(0, 0) = m_wheelbase * m_curvature + Kv * vel * vel * m_curvature;
 }
+
+void DynamicsBicycleModel::calculateDiscreteMatrices(
+  const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures,
+  Eigen::MatrixXd & a_d, Eigen::MatrixXd & b_d, Eigen::MatrixXd & c_d, Eigen::MatrixXd & w_d,
+  const float64_t dt)
+{
+  const int64_t N = static_cast<int64_t>(curvatures.size());
+  a_d.resize(4 * N, 4);
+  b_d.resize(4 * N, 1);
+  c_d.resize(2 * N, 4);
+  w_d.resize(4 * N, 1);
+  const Eigen::Matrix4d I = Eigen::Matrix4d::Identity();
+  const Eigen::Vector4d b{0.0, m_cf / m_mass, 0.0, m_lf * m_cf / m_iz};
+  for (int64_t i = 0; i < N; ++i) {
+    const float64_t vel = std::max(velocities[static_cast<size_t>(i)], 0.01);
+
+    Eigen::Matrix4d a = Eigen::Matrix4d::Zero();
+    a(0, 1) = 1.0;
+    a(1, 1) = -(m_cf + m_cr) / (m_mass * vel);
+    a(1, 2) = (m_cf + m_cr) / m_mass;
+    a(1, 3) = (m_lr * m_cr - m_lf * m_cf) / (m_mass * vel);
+    a(2, 3) = 1.0;
+    a(3, 1) = (m_lr * m_cr - m_lf * m_cf) / (m_iz * vel);
+    a(3, 2) = (m_lf * m_cf - m_lr * m_cr) / m_iz;
+    a(3, 3) = -(m_lf * m_lf * m_cf + m_lr * m_lr * m_cr) / (m_iz * vel);
+
+    const Eigen::Matrix4d a_inverse = (I - dt * 0.5 * a).inverse();
+    // bilinear discretization
+    a_d.block<4, 4>(4 * i, 0).noalias() = a_inverse * (I + dt * 0.5 * a);
+
+    const Eigen::Vector4d w{
+      0.0, (m_lr * m_cr - m_lf * m_cf) / (m_mass * vel) - vel, 0.0,
+      -(m_lf * m_lf * m_cf + m_lr * m_lr * m_cr) / (m_iz * vel)};
+
+    b_d.block<4, 1>(4 * i, 0).noalias() = (a_inverse * dt) * b;
+    w_d.block<4, 1>(4 * i, 0).noalias() =
+      (a_inverse * dt * curvatures[static_cast<size_t>(i)] * vel) * w;
+
+    c_d.block<2, 4>(2 * i, 0) << 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0;
+  }
+}
+
+void DynamicsBicycleModel::calculateReferenceInputs(
+  const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures,
+  Eigen::MatrixXd & u_ref)
+{
+  const float64_t Kv = m_lr * m_mass / (2 * m_cf * m_wheelbase) - m_lf * m_mass /
+    (2 * m_cr * m_wheelbase);
+  const int64_t N = static_cast<int64_t>(curvatures.size());
+  u_ref.resize(N, 1);
+  for (int64_t i = 0; i < N; ++i) {
+    const float64_t vel = std::max(velocities[static_cast<size_t>(i)], 0.01);
+    const float64_t curvature = curvatures[static_cast<size_t>(i)];
+    u_ref(i, 0) = m_wheelbase * curvature + Kv * vel * vel * curvature;
+  }
+}
 }  // namespace trajectory_follower
 }  // namespace control
 }  // namespace motion
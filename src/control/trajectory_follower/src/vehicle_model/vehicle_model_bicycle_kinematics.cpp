@@ -68,6 +68,60 @@ void KinematicsBicycleModel::calculateReferenceInput(Eigen::MatrixXd & u_ref)
 {
   u_ref(0, 0) = std::atan(m_wheelbase * m_curvature);
 }
+
+void KinematicsBicycleModel::calculateDiscreteMatrices(
+  const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures,
+  Eigen::MatrixXd & a_d, Eigen::MatrixXd & b_d, Eigen::MatrixXd & c_d, Eigen::MatrixXd & w_d,
+  const float64_t dt)
+{
+  auto sign = [](float64_t x) {return (x > 0.0) - (x < 0.0);};
+
+  const int64_t N = static_cast<int64_t>(curvatures.size());
+  a_d.resize(3 * N, 3);
+  b_d.resize(3 * N, 1);
+  c_d.resize(2 * N, 3);
+  w_d.resize(3 * N, 1);
+  const Eigen::Matrix3d I = Eigen::Matrix3d::Identity();
+  for (int64_t i = 0; i < N; ++i) {
+    const float64_t curvature = curvatures[static_cast<size_t>(i)];
+
+    /* Linearize delta around delta_r (reference delta) */
+    float64_t delta_r = atan(m_wheelbase * curvature);
+    if (std::abs(delta_r) >= m_steer_lim) {
+      delta_r = m_steer_lim * static_cast<float64_t>(sign(delta_r));
+    }
+    const float64_t cos_delta_r_squared_inv = 1 / (cos(delta_r) * cos(delta_r));
+    float64_t velocity = velocities[static_cast<size_t>(i)];
+    if (std::abs(velocity) < 1e-04) {velocity = 1e-04 * (velocity >= 0 ? 1 : -1);}
+
+    Eigen::Matrix3d a;
+    a << 0.0, velocity, 0.0, 0.0, 0.0, velocity / m_wheelbase * cos_delta_r_squared_inv, 0.0, 0.0,
+      -1.0 / m_steer_tau;
+    // bilinear discretization
+    a_d.block<3, 3>(3 * i, 0).noalias() = (I - dt * 0.5 * a).inverse() * (I + dt * 0.5 * a);
+
+    b_d.block<3, 1>(3 * i, 0) << 0.0, 0.0, 1.0 / m_steer_tau * dt;
+
+    c_d.block<2, 3>(2 * i, 0) << 1.0, 0.0, 0.0, 0.0, 1.0, 0.0;
+
+    w_d.block<3, 1>(3 * i, 0) << 0.0,
+      (-velocity * curvature +
+      velocity / m_wheelbase * (tan(delta_r) - delta_r * cos_delta_r_squared_inv)) * dt,
+      0.0;
+  }
+}
+
+void KinematicsBicycleModel::calculateReferenceInputs(
+  const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures,
+  Eigen::MatrixXd & u_ref)
+{
+  (void)velocities;
+  const int64_t N = static_cast<int64_t>(curvatures.size());
+  u_ref.resize(N, 1);
+  for (int64_t i = 0; i < N; ++i) {
+    u_ref(i, 0) = std::atan(m_wheelbase * curvatures[static_cast<size_t>(i)]);
+  }
+}
 }  // namespace trajectory_follower
 }  // namespace control
 }  // namespace motion
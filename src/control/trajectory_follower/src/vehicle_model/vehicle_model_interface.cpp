@@ -34,6 +34,54 @@ int64_t VehicleModelInterface::getDimY() {return m_dim_y;}
 float64_t VehicleModelInterface::getWheelbase() {return m_wheelbase;}
 void VehicleModelInterface::setVelocity(const float64_t velocity) {m_velocity = velocity;}
 void VehicleModelInterface::setCurvature(const float64_t curvature) {m_curvature = curvature;}
+
+void VehicleModelInterface::calculateDiscreteMatrices(
+  const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures,
+  Eigen::MatrixXd & a_d, Eigen::MatrixXd & b_d, Eigen::MatrixXd & c_d, Eigen::MatrixXd & w_d,
+  const float64_t dt)
+{
+  const int64_t N = static_cast<int64_t>(curvatures.size());
+  a_d.resize(m_dim_x * N, m_dim_x);
+  b_d.resize(m_dim_x * N, m_dim_u);
+  c_d.resize(m_dim_y * N, m_dim_x);
+  w_d.resize(m_dim_x * N, 1);
+  Eigen::MatrixXd a_d_i(m_dim_x, m_dim_x);
+  Eigen::MatrixXd b_d_i(m_dim_x, m_dim_u);
+  Eigen::MatrixXd c_d_i(m_dim_y, m_dim_x);
+  Eigen::MatrixXd w_d_i(m_dim_x, 1);
+  const float64_t velocity = m_velocity;
+  const float64_t curvature = m_curvature;
+  for (int64_t i = 0; i < N; ++i) {
+    m_velocity = velocities[static_cast<size_t>(i)];
+    m_curvature = curvatures[static_cast<size_t>(i)];
+    calculateDiscreteMatrix(a_d_i, b_d_i, c_d_i, w_d_i, dt);
+    a_d.middleRows(i * m_dim_x, m_dim_x) = a_d_i;
+    b_d.middleRows(i * m_dim_x, m_dim_x) = b_d_i;
+    c_d.middleRows(i * m_dim_y, m_dim_y) = c_d_i;
+    w_d.middleRows(i * m_dim_x, m_dim_x) = w_d_i;
+  }
+  m_velocity = velocity;
+  m_curvature = curvature;
+}
+
+void VehicleModelInterface::calculateReferenceInputs(
+  const std::vector<float64_t> & velocities, const std::vector<float64_t> & curvatures,
+  Eigen::MatrixXd & u_ref)
+{
+  const int64_t N = static_cast<int64_t>(curvatures.size());
+  u_ref.resize(m_dim_u * N, 1);
+  Eigen::MatrixXd u_ref_i(m_dim_u, 1);
+  const float64_t velocity = m_velocity;
+  const float64_t curvature = m_curvature;
+  for (int64_t i = 0; i < N; ++i) {
+    m_velocity = velocities[static_cast<size_t>(i)];
+    m_curvature = curvatures[static_cast<size_t>(i)];
+    calculateReferenceInput(u_ref_i);
+    u_ref.middleRows(i * m_dim_u, m_dim_u) = u_ref_i;
+  }
+  m_velocity = velocity;
+  m_curvature = curvature;
+}
 }  // namespace trajectory_follower
 }  // namespace control
 }  // namespace motion
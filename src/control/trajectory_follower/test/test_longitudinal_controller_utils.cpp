@@ -460,3 +460,56 @@ TEST(TestLongitudinalControllerUtils, applyDiffLimitFilter) {
     prev = new_val;
   }
 }
+
+TEST(TestLongitudinalControllerUtils, precomputedTrajectoryQueries) {
+  using autoware::motion::motion_common::TrajectoryQuery;
+  using autoware_auto_msgs::msg::Trajectory;
+  using autoware_auto_msgs::msg::TrajectoryPoint;
+  using geometry_msgs::msg::Point;
+  const double wheel_base = 2.5;
+  const double abs_err = 1e-9;
+  // A curved trajectory climbing a slope, stopping at the 40th point
+  Trajectory traj;
+  TrajectoryPoint p;
+  for (size_t i = 0; i < 60; ++i) {
+    const double s = static_cast<double>(i);
+    p.x = static_cast<float>(10.0 * std::sin(s * 0.05));
+    p.y = static_cast<float>(10.0 * (1.0 - std::cos(s * 0.05)));
+    p.z = static_cast<float>(0.02 * s * s);
+    p.longitudinal_velocity_mps = (i >= 40) ? 0.0f : 3.0f;
+    p.acceleration_mps2 = static_cast<float>(s);
+    traj.points.push_back(p);
+  }
+  TrajectoryQuery query(traj.points, 5U);
+
+  const auto pitches = longitudinal_utils::calcPitchTable(traj, wheel_base);
+  ASSERT_EQ(pitches.size(), traj.points.size());
+  for (size_t i = 0; i < traj.points.size(); ++i) {
+    EXPECT_EQ(pitches[i], longitudinal_utils::getPitchByTraj(traj, i, wheel_base));
+  }
+
+  // The vehicle driving along the trajectory, slightly off to the side
+  for (size_t i = 0; i + 1 < traj.points.size(); ++i) {
+    Point current_pos;
+    current_pos.x = 0.7 * traj.points[i].x + 0.3 * traj.points[i + 1].x;
+    current_pos.y = 0.7 * traj.points[i].y + 0.3 * traj.points[i + 1].y + 0.1;
+    EXPECT_NEAR(
+      longitudinal_utils::calcStopDistance(current_pos, query),
+      longitudinal_utils::calcStopDistance(current_pos, traj), abs_err);
+    const auto lerp_query = longitudinal_utils::lerpTrajectoryPoint(query, current_pos);
+    const auto lerp_points = longitudinal_utils::lerpTrajectoryPoint(traj.points, current_pos);
+    EXPECT_EQ(lerp_query.x, lerp_points.x);
+    EXPECT_EQ(lerp_query.y, lerp_points.y);
+    EXPECT_EQ(lerp_query.acceleration_mps2, lerp_points.acceleration_mps2);
+  }
+
+  // Without a stop point, the distance to the end of the trajectory
+  for (auto & point : traj.points) {
+    point.longitudinal_velocity_mps = 3.0f;
+  }
+  TrajectoryQuery moving_query(traj.points, 5U);
+  Point current_pos;
+  EXPECT_NEAR(
+    longitudinal_utils::calcStopDistance(current_pos, moving_query),
+    longitudinal_utils::calcStopDistance(current_pos, traj), abs_err);
+}
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -30,6 +33,10 @@
 #include "common/types.hpp"
 #include "geometry_msgs/msg/pose.hpp"
 #include "gtest/gtest.h"
+#include "rcl/time.h"
+#include "rclcpp/clock.hpp"
+#include "rclcpp/duration.hpp"
+#include "rclcpp/time.hpp"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.h"
 
 namespace
@@ -173,6 +180,62 @@ protected:
   }
 };  // class MPCTest
 
+// The sent commands as they were stored in a deque, to check the ring buffer of the MPC against
+class ReferenceSteerCmds
+{
+public:
+  explicit ReferenceSteerCmds(const float64_t input_delay)
+  : m_input_delay(input_delay) {}
+
+  void store(const rclcpp::Time & now, const float64_t steer)
+  {
+    const auto time_delayed = now + rclcpp::Duration::from_seconds(m_input_delay);
+    AckermannLateralCommand cmd;
+    cmd.stamp = time_delayed;
+    cmd.steering_tire_angle = static_cast<float>(steer);
+    m_cmds.emplace_back(cmd);
+    if (m_cmds.size() <= 2) {
+      return;
+    }
+    constexpr float64_t store_time = 0.3;
+    if ((time_delayed - m_cmds.at(1).stamp).seconds() > m_input_delay + store_time) {
+      m_cmds.pop_front();
+    }
+  }
+
+  float64_t sum(
+    const rclcpp::Time & t_start, const rclcpp::Time & t_end,
+    const float64_t time_constant) const
+  {
+    if (m_cmds.size() <= 2) {return 0.0;}
+    size_t idx = 1;
+    while (t_start > rclcpp::Time(m_cmds.at(idx).stamp)) {
+      if ((idx + 1) >= m_cmds.size()) {return 0.0;}
+      ++idx;
+    }
+    float64_t steer_sum = 0.0;
+    auto t = t_start;
+    while (t_end > rclcpp::Time(m_cmds.at(idx).stamp)) {
+      const float64_t duration = (rclcpp::Time(m_cmds.at(idx).stamp) - t).seconds();
+      t = rclcpp::Time(m_cmds.at(idx).stamp);
+      steer_sum += (1 - std::exp(-duration / time_constant)) *
+        static_cast<float64_t>(m_cmds.at(idx - 1).steering_tire_angle);
+      ++idx;
+      if (idx >= m_cmds.size()) {break;}
+    }
+    const float64_t duration = (t_end - t).seconds();
+    steer_sum += (1 - std::exp(-duration / time_constant)) *
+      static_cast<float64_t>(m_cmds.at(idx - 1).steering_tire_angle);
+    return steer_sum;
+  }
+
+  size_t size() const {return m_cmds.size();}
+
+private:
+  float64_t m_input_delay;
+  std::deque<AckermannLateralCommand> m_cmds;
+};  // class ReferenceSteerCmds
+
 /* cppcheck-suppress syntaxError */
 TEST_F(MPCTest, InitializeAndCalculate) {
   trajectory_follower::MPC mpc;
@@ -493,4 +556,198 @@ TEST_F(MPCTest, FailureCases) {
       neutral_steer, default_velocity, pose_zero, ctrl_cmd, pred_traj,
       diag));
 }
+
+// Test that the structured MPC matrices give the same commands as the dense ones, up to rounding.
+TEST_F(MPCTest, StructuredMatrixCalculate) {
+  const auto make_vehicle_model = [this](const std::string & vehicle_model_type)
+    -> std::shared_ptr<trajectory_follower::VehicleModelInterface> {
+      if (vehicle_model_type == "kinematics_no_delay") {
+        return std::make_shared<trajectory_follower::KinematicsBicycleModelNoDelay>(
+          wheelbase, steer_limit);
+      } else if (vehicle_model_type == "dynamics") {
+        return std::make_shared<trajectory_follower::DynamicsBicycleModel>(
+          wheelbase, mass_fl, mass_fr, mass_rl, mass_rr, cf, cr);
+      }
+      return std::make_shared<trajectory_follower::KinematicsBicycleModel>(
+        wheelbase, steer_limit, steer_tau);
+    };
+  for (const std::string vehicle_model_type : {"kinematics", "kinematics_no_delay", "dynamics"}) {
+    trajectory_follower::MPC dense_mpc;
+    trajectory_follower::MPC structured_mpc;
+    structured_mpc.m_use_structured_mpc_matrix = true;
+    for (auto * mpc : {&dense_mpc, &structured_mpc}) {
+      mpc->setVehicleModel(make_vehicle_model(vehicle_model_type), vehicle_model_type);
+      mpc->setQPSolver(std::make_shared<trajectory_follower::QPSolverEigenLeastSquareLLT>());
+      initializeMPC(*mpc);
+      mpc->setReferenceTrajectory(
+        dummy_right_turn_trajectory, traj_resample_dist, enable_path_smoothing,
+        path_filter_moving_ave_num, enable_yaw_recalculation,
+        curvature_smoothing_num);
+    }
+    // Several periods, for the storage that is reused and the previous commands
+    for (int64_t period = 0; period < 3; ++period) {
+      AckermannLateralCommand dense_cmd;
+      AckermannLateralCommand structured_cmd;
+      Trajectory dense_traj;
+      Trajectory structured_traj;
+      Float32MultiArrayDiagnostic dense_diag;
+      Float32MultiArrayDiagnostic structured_diag;
+      ASSERT_TRUE(
+        dense_mpc.calculateMPC(
+          neutral_steer, default_velocity, pose_zero, dense_cmd, dense_traj, dense_diag));
+      ASSERT_TRUE(
+        structured_mpc.calculateMPC(
+          neutral_steer, default_velocity, pose_zero, structured_cmd, structured_traj,
+          structured_diag));
+      EXPECT_NEAR(dense_cmd.steering_tire_angle, structured_cmd.steering_tire_angle, 1.0e-6);
+      EXPECT_NEAR(
+        dense_cmd.steering_tire_rotation_rate, structured_cmd.steering_tire_rotation_rate, 1.0e-5);
+      ASSERT_EQ(dense_traj.points.size(), structured_traj.points.size());
+      for (size_t i = 0; i < dense_traj.points.size(); ++i) {
+        EXPECT_NEAR(dense_traj.points[i].x, structured_traj.points[i].x, 1.0e-5);
+        EXPECT_NEAR(dense_traj.points[i].y, structured_traj.points[i].y, 1.0e-5);
+      }
+    }
+  }
+}
+
+// Test that the matrices of all the steps computed at once are those of each step.
+TEST_F(MPCTest, VehicleModelDiscreteMatrices) {
+  const std::vector<std::shared_ptr<trajectory_follower::VehicleModelInterface>> models = {
+    std::make_shared<trajectory_follower::KinematicsBicycleModel>(
+      wheelbase, steer_limit, steer_tau),
+    std::make_shared<trajectory_follower::KinematicsBicycleModelNoDelay>(wheelbase, steer_limit),
+    std::make_shared<trajectory_follower::DynamicsBicycleModel>(
+      wheelbase, mass_fl, mass_fr, mass_rl, mass_rr, cf, cr)};
+  // including a stop and curvatures beyond the steering limit
+  const std::vector<float64_t> velocities = {0.0, 1.0e-5, 1.0, 5.0, -2.0, 10.0, 20.0};
+  const std::vector<float64_t> curvatures = {0.0, 0.1, -0.05, 0.3, -0.5, 0.01, 0.0};
+  const float64_t dt = 0.1;
+  for (const auto & model : models) {
+    const int64_t dim_x = model->getDimX();
+    const int64_t dim_u = model->getDimU();
+    const int64_t dim_y = model->getDimY();
+    Eigen::MatrixXd a_d_all, b_d_all, c_d_all, w_d_all, u_ref_all;
+    model->calculateDiscreteMatrices(
+      velocities, curvatures, a_d_all, b_d_all, c_d_all, w_d_all, dt);
+    model->calculateReferenceInputs(velocities, curvatures, u_ref_all);
+    const int64_t N = static_cast<int64_t>(velocities.size());
+    ASSERT_EQ(a_d_all.rows(), dim_x * N);
+    ASSERT_EQ(u_ref_all.rows(), dim_u * N);
+    Eigen::MatrixXd a_d(dim_x, dim_x), b_d(dim_x, dim_u), c_d(dim_y, dim_x), w_d(dim_x, 1);
+    Eigen::MatrixXd u_ref(dim_u, 1);
+    for (int64_t i = 0; i < N; ++i) {
+      model->setVelocity(velocities[static_cast<size_t>(i)]);
+      model->setCurvature(curvatures[static_cast<size_t>(i)]);
+      model->calculateDiscreteMatrix(a_d, b_d, c_d, w_d, dt);
+      model->calculateReferenceInput(u_ref);
+      EXPECT_TRUE(a_d_all.middleRows(i * dim_x, dim_x).isApprox(a_d, 1.0e-12));
+      EXPECT_TRUE(b_d_all.middleRows(i * dim_x, dim_x).isApprox(b_d, 1.0e-12));
+      EXPECT_TRUE(c_d_all.middleRows(i * dim_y, dim_y).isApprox(c_d, 1.0e-12));
+      EXPECT_TRUE(w_d_all.middleRows(i * dim_x, dim_x).isApprox(w_d, 1.0e-12));
+      EXPECT_TRUE(u_ref_all.middleRows(i * dim_u, dim_u).isApprox(u_ref, 1.0e-12));
+    }
+  }
+}
+
+TEST_F(MPCTest, GainTableCalculate) {
+  Trajectory long_straight_trajectory;
+  TrajectoryPoint p;
+  p.longitudinal_velocity_mps = 1.0f;
+  for (int64_t i = 0; i < 30; ++i) {
+    p.x = static_cast<float>(i);
+    long_straight_trajectory.points.push_back(p);
+  }
+  Pose pose_offset = pose_zero;
+  pose_offset.position.y = 0.05;
+  // Perturbs the results of the QP, if the table computes differently than the solver
+  param.weight_steer_rate = 0.1;
+  // The unconstrained solver ignores the constraints, the table checks them
+  steer_rate_lim = 100.0;
+  const auto make_mpc = [&](trajectory_follower::MPC & mpc) {
+      mpc.setVehicleModel(
+        std::make_shared<trajectory_follower::KinematicsBicycleModel>(
+          wheelbase, steer_limit, steer_tau), "kinematics");
+      mpc.setQPSolver(std::make_shared<trajectory_follower::QPSolverEigenLeastSquareLLT>());
+      initializeMPC(mpc);
+      mpc.setReferenceTrajectory(
+        long_straight_trajectory, traj_resample_dist, enable_path_smoothing,
+        path_filter_moving_ave_num, enable_yaw_recalculation, curvature_smoothing_num);
+    };
+  const auto calculate = [&](trajectory_follower::MPC & mpc, AckermannLateralCommand & cmd) {
+      Trajectory pred_traj;
+      Float32MultiArrayDiagnostic diag;
+      EXPECT_TRUE(
+        mpc.calculateMPC(neutral_steer, default_velocity, pose_offset, cmd, pred_traj, diag));
+      return diag.diag_array.data.at(18) == 1.0F;
+    };
+
+  trajectory_follower::MPC qp_mpc;
+  make_mpc(qp_mpc);
+  trajectory_follower::MPC table_mpc;
+  make_mpc(table_mpc);
+  table_mpc.m_use_gain_table = true;
+  EXPECT_FALSE(table_mpc.buildGainTable({1.0}, {-0.1, 0.1}));
+  EXPECT_FALSE(table_mpc.buildGainTable({0.0, 1.0}, {-0.1, 0.1}));
+  ASSERT_TRUE(table_mpc.buildGainTable({0.5, 1.0, 2.0}, {-0.1, 0.0, 0.1}));
+
+  // On the grid, with a constant reference, the table gives the unconstrained optimum
+  for (int64_t period = 0; period < 3; ++period) {
+    AckermannLateralCommand qp_cmd;
+    AckermannLateralCommand table_cmd;
+    EXPECT_FALSE(calculate(qp_mpc, qp_cmd));
+    EXPECT_TRUE(calculate(table_mpc, table_cmd));
+    EXPECT_NE(qp_cmd.steering_tire_angle, 0.0f);
+    EXPECT_NEAR(qp_cmd.steering_tire_angle, table_cmd.steering_tire_angle, 1.0e-5);
+    EXPECT_NEAR(qp_cmd.steering_tire_rotation_rate, table_cmd.steering_tire_rotation_rate, 1.0e-4);
+  }
+
+  // The QP is solved when a constraint is violated, or outside of the table
+  AckermannLateralCommand cmd;
+  table_mpc.m_steer_rate_lim = 1.0e-6;
+  EXPECT_FALSE(calculate(table_mpc, cmd));
+  table_mpc.m_steer_rate_lim = steer_rate_lim;
+  ASSERT_TRUE(table_mpc.buildGainTable({2.0, 3.0}, {-0.1, 0.1}));
+  EXPECT_FALSE(calculate(table_mpc, cmd));
+}
+TEST_F(MPCTest, SteerCmdBufferMatchesDeque) {
+  // A short delay wraps around the initial capacity, a long one grows the buffer several times
+  for (const float64_t input_delay : {0.0, 0.1, 5.0}) {
+    trajectory_follower::MPC mpc;
+    initializeMPC(mpc);
+    mpc.m_param.input_delay = input_delay;
+    const auto clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+    ASSERT_EQ(rcl_enable_ros_time_override(clock->get_clock_handle()), RCL_RET_OK);
+    mpc.setClock(clock);
+    ReferenceSteerCmds reference{input_delay};
+
+    int64_t now_ns = 1000000000;
+    size_t max_size = 0U;
+    for (int64_t i = 0; i < 400; ++i) {
+      // Irregular control periods of 30 to 70 ms
+      now_ns += (30 + 10 * (i % 5)) * 1000000;
+      ASSERT_EQ(rcl_set_ros_time_override(clock->get_clock_handle(), now_ns), RCL_RET_OK);
+      const float64_t steer = 0.5 * std::sin(0.1 * static_cast<float64_t>(i));
+      mpc.storeSteerCmd(steer);
+      reference.store(clock->now(), steer);
+      max_size = std::max(max_size, reference.size());
+
+      // Time ranges starting before, between and after the stored stamps
+      const auto last_stamp = clock->now() + rclcpp::Duration::from_seconds(input_delay);
+      for (int64_t k = 0; k <= 10; ++k) {
+        const auto t_start = last_stamp + rclcpp::Duration::from_seconds(0.05 * (k - 8));
+        const auto t_end = t_start + rclcpp::Duration::from_seconds(0.12);
+        EXPECT_DOUBLE_EQ(
+          mpc.getSteerCmdSum(t_start, t_end, steer_tau),
+          reference.sum(t_start, t_end, steer_tau)) << "input delay " << input_delay <<
+          ", command " << i << ", range " << k;
+      }
+    }
+    if (input_delay > 1.0) {
+      EXPECT_GT(max_size, size_t(64));
+    } else {
+      EXPECT_LT(max_size, size_t(16));
+    }
+  }
+}
 }  // namespace
@@ -109,4 +109,33 @@ TEST(TestMPC, CalcStopDistance) {
   EXPECT_EQ(MPCUtils::calcStopDistance(trajectory_msg, 6), 0.0);
   EXPECT_EQ(MPCUtils::calcStopDistance(trajectory_msg, 7), -1.0);
 }
+
+TEST(TestMPCUtils, DynamicSmoothingVelocityInWindow) {
+  using autoware::motion::control::trajectory_follower::MPCTrajectory;
+  MPCTrajectory input;
+  for (size_t i = 0; i < 100; ++i) {
+    const double x = static_cast<double>(i);
+    input.push_back(x, 0.1 * x, 0.0, 0.1, 5.0 + 0.05 * x, 0.01, 0.01, 0.0);
+  }
+  MPCUtils::calcMPCTrajectoryTime(input);
+  MPCTrajectory full = input;
+  MPCUtils::dynamicSmoothingVelocity(10, 2.0, 1.5, 0.3, full);
+
+  MPCTrajectory window;
+  EXPECT_TRUE(MPCUtils::dynamicSmoothingVelocityInWindow(input, 10, 2.0, 1.5, 0.3, 3.0, window));
+  ASSERT_LT(window.size(), full.size());
+  EXPECT_GE(window.relative_time.back(), full.relative_time[11] + 3.0);
+  EXPECT_LT(window.relative_time[window.size() - 2], full.relative_time[11] + 3.0);
+  for (size_t i = 0; i < window.size(); ++i) {
+    EXPECT_EQ(window.x[i], full.x[i]);
+    EXPECT_EQ(window.vx[i], full.vx[i]);
+    EXPECT_EQ(window.relative_time[i], full.relative_time[i]);
+  }
+
+  // A window beyond the end keeps the whole trajectory
+  EXPECT_FALSE(MPCUtils::dynamicSmoothingVelocityInWindow(input, 10, 2.0, 1.5, 0.3, 1e3, window));
+  ASSERT_EQ(window.size(), full.size());
+  EXPECT_EQ(window.vx.back(), full.vx.back());
+  EXPECT_EQ(window.relative_time.back(), full.relative_time.back());
+}
 }  // namespace
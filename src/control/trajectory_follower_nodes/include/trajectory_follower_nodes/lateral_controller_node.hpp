@@ -15,11 +15,14 @@
 #ifndef TRAJECTORY_FOLLOWER_NODES__LATERAL_CONTROLLER_NODE_HPP_
 #define TRAJECTORY_FOLLOWER_NODES__LATERAL_CONTROLLER_NODE_HPP_
 
+#include <chrono>
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "motion_common/trajectory_common.hpp"
 #include "trajectory_follower_nodes/visibility_control.hpp"
 #include "trajectory_follower/interpolate.hpp"
 #include "trajectory_follower/lowpass_filter.hpp"
@@ -86,6 +89,14 @@ private:
   rclcpp::Subscription<autoware_auto_msgs::msg::VehicleKinematicState>::SharedPtr m_sub_steering;
   //!< @brief timer to update after a given interval
   rclcpp::TimerBase::SharedPtr m_timer;
+  //!< @brief callback group of the timer, so that the MPC runs in parallel to other callbacks
+  rclcpp::CallbackGroup::SharedPtr m_timer_callback_group;
+  //!< @brief callback group of the input subscriptions
+  rclcpp::CallbackGroup::SharedPtr m_input_callback_group;
+  //!< @brief guards the inputs that are shared between the subscriptions and the timer
+  std::mutex m_input_mutex;
+  //!< @brief guards the MPC, which is shared between the timer and the parameter callback
+  std::mutex m_mpc_mutex;
 
   /* parameters for path smoothing */
   //!< @brief flag for path smoothing
@@ -99,6 +110,12 @@ private:
   //!< @brief path resampling interval [m]
   float64_t m_traj_resample_dist;
 
+  /* grid of the gain table of the MPC */
+  //!< @brief velocities of the grid [m/s]
+  std::vector<float64_t> m_gain_table_velocities;
+  //!< @brief curvatures of the grid [1/m]
+  std::vector<float64_t> m_gain_table_curvatures;
+
   /* parameters for stop state */
   float64_t m_stop_state_entry_ego_speed;
   float64_t m_stop_state_entry_target_speed;
@@ -114,6 +131,19 @@ private:
   //!< @brief reference trajectory
   autoware_auto_msgs::msg::Trajectory::SharedPtr
     m_current_trajectory_ptr;
+  //!< @brief nearest point searches on the points of m_current_trajectory_ptr
+  std::shared_ptr<motion::motion_common::TrajectoryQuery> m_trajectory_query;
+  //!< @brief measured state received since the last control cycle, guarded by m_input_mutex
+  autoware_auto_msgs::msg::VehicleKinematicState::SharedPtr m_received_state_ptr;
+  //!< @brief trajectory received since the last control cycle, guarded by m_input_mutex
+  autoware_auto_msgs::msg::Trajectory::SharedPtr m_received_trajectory_ptr;
+
+  //!< @brief number of control cycles in the current statistics window
+  int64_t m_cycle_count = 0;
+  //!< @brief sum of the computation times of the control cycles in the current window
+  std::chrono::nanoseconds m_cycle_time_sum{0};
+  //!< @brief longest computation time of a control cycle in the current window
+  std::chrono::nanoseconds m_cycle_time_max{0};
 
   //!< @brief mpc filtered output in previous period
   float64_t m_steer_cmd_prev = 0.0;
@@ -135,10 +165,26 @@ private:
   void onTimer();
 
   /**
-   * @brief set m_current_trajectory with received message
+   * @brief store the received trajectory for the next control cycle
    */
   void onTrajectory(const autoware_auto_msgs::msg::Trajectory::SharedPtr);
 
+  /**
+   * @brief take a snapshot of the inputs received since the last control cycle
+   */
+  void updateInputs();
+
+  /**
+   * @brief set m_current_trajectory and the MPC reference with received message
+   */
+  void setTrajectory(const autoware_auto_msgs::msg::Trajectory::SharedPtr msg);
+
+  /**
+   * @brief add the computation time of a control cycle to the statistics
+   * @param [in] cycle_time computation time of the cycle
+   */
+  void updateCycleTimeStatistics(const std::chrono::nanoseconds cycle_time);
+
   /**
    * @brief update current_pose from tf
    */
@@ -150,7 +196,7 @@ private:
   bool8_t checkData() const;
 
   /**
-   * @brief set current_state with received message
+   * @brief store the received state for the next control cycle
    */
   void onState(const autoware_auto_msgs::msg::VehicleKinematicState::SharedPtr msg);
 
@@ -185,7 +231,7 @@ private:
   /**
    * @brief check ego car is in stopped state
    */
-  bool8_t isStoppedState() const;
+  bool8_t isStoppedState();
 
   /**
    * @brief check if the trajectory has valid value
@@ -194,6 +240,11 @@ private:
 
   OnSetParametersCallbackHandle::SharedPtr m_set_param_res;
 
+  /**
+   * @brief build the gain table of the MPC for the current parameters
+   */
+  void buildGainTable();
+
   /**
    * @brief Declare MPC parameters as ROS parameters to allow tuning on the fly
    */
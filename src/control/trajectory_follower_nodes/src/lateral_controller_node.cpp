@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <chrono>
 #include <deque>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -40,6 +42,9 @@ namespace
 {
 using namespace std::chrono_literals;
 
+// Window after which the cycle time statistics are logged and reset
+constexpr float64_t kCycleTimeStatisticsWindowSec = 10.0;
+
 template<typename T>
 void update_param(
   const std::vector<rclcpp::Parameter> & parameters, const std::string & name, T & value)
@@ -69,6 +74,13 @@ LateralController::LateralController(const rclcpp::NodeOptions & node_options)
     declare_parameter("admissible_position_error").get<float64_t>();
   m_mpc.m_admissible_yaw_error_rad = declare_parameter("admissible_yaw_error_rad").get<float64_t>();
   m_mpc.m_use_steer_prediction = declare_parameter("use_steer_prediction").get<bool8_t>();
+  m_mpc.m_use_structured_mpc_matrix =
+    declare_parameter("use_structured_mpc_matrix").get<bool8_t>();
+  m_mpc.m_use_gain_table = declare_parameter("use_gain_table").get<bool8_t>();
+  m_gain_table_velocities =
+    declare_parameter("gain_table_velocities_mps").get<std::vector<float64_t>>();
+  m_gain_table_curvatures =
+    declare_parameter("gain_table_curvatures").get<std::vector<float64_t>>();
   m_mpc.m_param.steer_tau = declare_parameter("vehicle_model_steer_tau").get<float64_t>();
 
   /* stop state parameters */
@@ -143,6 +155,10 @@ LateralController::LateralController(const rclcpp::NodeOptions & node_options)
   }
 
   /* set up ros system */
+  // Separate callback groups let a multi-threaded executor run the MPC next to the inputs and
+  // to the other nodes of a composed deployment, e.g. the longitudinal controller
+  m_timer_callback_group = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  m_input_callback_group = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
   initTimer(m_mpc.m_ctrl_period);
 
   m_pub_ctrl_cmd =
@@ -153,12 +169,14 @@ LateralController::LateralController(const rclcpp::NodeOptions & node_options)
   m_pub_diagnostic =
     create_publisher<autoware_auto_msgs::msg::Float32MultiArrayDiagnostic>(
     "output/lateral/diagnostic", 1);
+  rclcpp::SubscriptionOptions input_options;
+  input_options.callback_group = m_input_callback_group;
   m_sub_ref_path = create_subscription<autoware_auto_msgs::msg::Trajectory>(
     "input/reference_trajectory", rclcpp::QoS{1},
-    std::bind(&LateralController::onTrajectory, this, _1));
+    std::bind(&LateralController::onTrajectory, this, _1), input_options);
   m_sub_steering = create_subscription<autoware_auto_msgs::msg::VehicleKinematicState>(
     "input/current_kinematic_state", rclcpp::QoS{1}, std::bind(
-      &LateralController::onState, this, _1));
+      &LateralController::onState, this, _1), input_options);
 
   // TODO(Frederik.Beaujean) ctor is too long, should factor out parameter declarations
   declareMPCparameters();
@@ -172,6 +190,10 @@ LateralController::LateralController(const rclcpp::NodeOptions & node_options)
 
   m_mpc.setLogger(get_logger());
   m_mpc.setClock(get_clock());
+
+  if (m_mpc.m_use_gain_table) {
+    buildGainTable();
+  }
 }
 
 LateralController::~LateralController()
@@ -182,6 +204,10 @@ LateralController::~LateralController()
 
 void LateralController::onTimer()
 {
+  const auto cycle_start = std::chrono::steady_clock::now();
+  const rclcpp::Time computation_start = this->now();
+  std::lock_guard<std::mutex> lock(m_mpc_mutex);
+  updateInputs();
   updateCurrentPose();
 
   if (!checkData()) {
@@ -202,6 +228,12 @@ void LateralController::onTimer()
     *m_current_state_ptr, m_current_state_ptr->state.longitudinal_velocity_mps,
     m_current_pose_ptr->pose, ctrl_cmd, predicted_traj, diagnostic);
 
+  const auto cycle_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - cycle_start);
+  diagnostic.diag_header.computation_start = computation_start;
+  diagnostic.diag_header.runtime = rclcpp::Duration(cycle_time);
+  updateCycleTimeStatistics(cycle_time);
+
   if (isStoppedState()) {
     // Reset input buffer
     for (auto & value : m_mpc.m_input_buffer) {
@@ -257,8 +289,33 @@ bool8_t LateralController::checkData() const
 }
 
 void LateralController::onTrajectory(const autoware_auto_msgs::msg::Trajectory::SharedPtr msg)
+{
+  std::lock_guard<std::mutex> lock(m_input_mutex);
+  m_received_trajectory_ptr = msg;
+}
+
+void LateralController::updateInputs()
+{
+  autoware_auto_msgs::msg::VehicleKinematicState::SharedPtr state;
+  autoware_auto_msgs::msg::Trajectory::SharedPtr trajectory;
+  {
+    std::lock_guard<std::mutex> lock(m_input_mutex);
+    state = std::move(m_received_state_ptr);
+    trajectory = std::move(m_received_trajectory_ptr);
+  }
+  if (state) {
+    m_current_state_ptr = state;
+  }
+  if (trajectory) {
+    setTrajectory(trajectory);
+  }
+}
+
+void LateralController::setTrajectory(const autoware_auto_msgs::msg::Trajectory::SharedPtr msg)
 {
   m_current_trajectory_ptr = msg;
+  m_trajectory_query = msg->points.empty() ? nullptr :
+    std::make_shared<motion::motion_common::TrajectoryQuery>(msg->points);
 
   if (msg->points.size() < 3) {
     RCLCPP_DEBUG(get_logger(), "received path size is < 3, not enough.");
@@ -298,7 +355,35 @@ void LateralController::updateCurrentPose()
 
 void LateralController::onState(const autoware_auto_msgs::msg::VehicleKinematicState::SharedPtr msg)
 {
-  m_current_state_ptr = msg;
+  std::lock_guard<std::mutex> lock(m_input_mutex);
+  m_received_state_ptr = msg;
+}
+
+void LateralController::updateCycleTimeStatistics(const std::chrono::nanoseconds cycle_time)
+{
+  const float64_t cycle_time_ms = static_cast<float64_t>(cycle_time.count()) * 1e-6;
+  if (cycle_time_ms > m_mpc.m_ctrl_period * 1e3) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 1000 /*ms*/,
+      "control cycle took %f ms, longer than the control period of %f ms", cycle_time_ms,
+      m_mpc.m_ctrl_period * 1e3);
+  }
+
+  ++m_cycle_count;
+  m_cycle_time_sum += cycle_time;
+  m_cycle_time_max = std::max(m_cycle_time_max, cycle_time);
+  const float64_t window_sec = static_cast<float64_t>(m_cycle_count) * m_mpc.m_ctrl_period;
+  if (window_sec >= kCycleTimeStatisticsWindowSec) {
+    RCLCPP_DEBUG(
+      get_logger(), "control cycle time over %ld cycles: mean = %f ms, max = %f ms",
+      m_cycle_count,
+      static_cast<float64_t>(m_cycle_time_sum.count()) * 1e-6 /
+      static_cast<float64_t>(m_cycle_count),
+      static_cast<float64_t>(m_cycle_time_max.count()) * 1e-6);
+    m_cycle_count = 0;
+    m_cycle_time_sum = std::chrono::nanoseconds::zero();
+    m_cycle_time_max = std::chrono::nanoseconds::zero();
+  }
 }
 
 autoware_auto_msgs::msg::AckermannLateralCommand LateralController::getStopControlCommand() const
@@ -317,13 +402,15 @@ autoware_auto_msgs::msg::AckermannLateralCommand LateralController::getInitialCo
   return cmd;
 }
 
-bool8_t LateralController::isStoppedState() const
+bool8_t LateralController::isStoppedState()
 {
-  const int64_t nearest = trajectory_follower::MPCUtils::calcNearestIndex(
-    *m_current_trajectory_ptr,
-    m_current_pose_ptr->pose);
   // If the nearest index is not found, return false
-  if (nearest < 0) {return false;}
+  if (!m_trajectory_query) {return false;}
+  // ignore the points whose yaw error is large, for crossing path
+  const auto nearest_opt = m_trajectory_query->findNearestIndex(
+    m_current_pose_ptr->pose, std::numeric_limits<float64_t>::max(), M_PI / 3.0);
+  if (!nearest_opt) {return false;}
+  const int64_t nearest = static_cast<int64_t>(*nearest_opt);
   const float64_t dist = trajectory_follower::MPCUtils::calcStopDistance(
     *m_current_trajectory_ptr,
     nearest);
@@ -382,7 +469,14 @@ void LateralController::initTimer(float64_t period_s)
   m_timer = std::make_shared<rclcpp::GenericTimer<decltype(timer_callback)>>(
     this->get_clock(), period_ns, std::move(timer_callback),
     this->get_node_base_interface()->get_context());
-  this->get_node_timers_interface()->add_timer(m_timer, nullptr);
+  this->get_node_timers_interface()->add_timer(m_timer, m_timer_callback_group);
+}
+
+void LateralController::buildGainTable()
+{
+  if (!m_mpc.buildGainTable(m_gain_table_velocities, m_gain_table_curvatures)) {
+    RCLCPP_ERROR(get_logger(), "the gain table could not be built, the QP is always solved");
+  }
 }
 
 void LateralController::declareMPCparameters()
@@ -436,6 +530,8 @@ rcl_interfaces::msg::SetParametersResult LateralController::paramCallback(
   result.successful = true;
   result.reason = "success";
 
+  std::lock_guard<std::mutex> lock(m_mpc_mutex);
+
   // strong exception safety wrt MPCParam
   trajectory_follower::MPCParam param = m_mpc.m_param;
   try {
@@ -475,6 +571,9 @@ rcl_interfaces::msg::SetParametersResult LateralController::paramCallback(
 
     // transaction succeeds, now assign values
     m_mpc.m_param = param;
+    if (m_mpc.m_use_gain_table) {
+      buildGainTable();
+    }
   } catch (const rclcpp::exceptions::InvalidParameterTypeException & e) {
     result.successful = false;
     result.reason = e.what();
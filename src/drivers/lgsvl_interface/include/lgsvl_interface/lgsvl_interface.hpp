@@ -49,7 +49,6 @@
 #include <chrono>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <utility>
 
 namespace lgsvl_interface
@@ -105,7 +104,8 @@ public:
     Table1D && brake_table,
     Table1D && steer_table,
     bool publish_tf = NO_PUBLISH,
-    bool publish_pose = PUBLISH);
+    bool publish_pose = PUBLISH,
+    bool skip_unchanged_state = false);
 
   ~LgsvlInterface() noexcept override = default;
   /// Receives data from ROS 2 subscriber, and updates output messages.
@@ -113,6 +113,8 @@ public:
   bool update(std::chrono::nanoseconds timeout) override;
   /// Queues up data to be sent along with the next control command.
   /// Only gear shifting between drive and reverse is supported at this time.
+  /// If unchanged states are skipped, the state is only published when it differs from the last
+  /// published one in more than its stamp.
   bool send_state_command(const autoware_auto_msgs::msg::VehicleStateCommand & msg) override;
   /// Send control command data with whatever state data came along last
   bool send_control_command(const autoware_auto_msgs::msg::VehicleControlCommand & msg) override;
@@ -130,15 +132,10 @@ public:
   void send_wipers_command(const autoware_auto_msgs::msg::WipersCommand & msg) override;
 
 private:
-  // Mappings from Autoware to LGSVL values
-  static const std::unordered_map<WIPER_TYPE, WIPER_TYPE> autoware_to_lgsvl_wiper;
-  static const std::unordered_map<GEAR_TYPE, GEAR_TYPE> autoware_to_lgsvl_gear;
-  static const std::unordered_map<MODE_TYPE, MODE_TYPE> autoware_to_lgsvl_mode;
-
   // Convert odometry into vehicle kinematic state and pose
   void on_odometry(const nav_msgs::msg::Odometry & msg);
 
-  // store state_report with gear value correction
+  // store state_report with gear value correction, notify only changes if unchanged are skipped
   void on_state_report(const autoware_auto_msgs::msg::VehicleStateReport & msg);
 
   rclcpp::Publisher<lgsvl_msgs::msg::VehicleControlData>::SharedPtr m_cmd_pub{};
@@ -169,6 +166,18 @@ private:
 
   lgsvl_msgs::msg::VehicleStateData m_lgsvl_state{};
 
+  // Skip publishing states and notifying state reports that did not change
+  bool m_skip_unchanged_state;
+  bool m_lgsvl_state_published{false};
+  lgsvl_msgs::msg::VehicleStateData m_published_lgsvl_state{};
+  bool m_state_report_received{false};
+
+  // Outgoing messages, prepared once and overwritten for each publication
+  lgsvl_msgs::msg::VehicleControlData m_control_data{};
+  autoware_auto_msgs::msg::VehicleKinematicState m_kinematic_state{};
+  tf2_msgs::msg::TFMessage m_tf_msg{};
+  geometry_msgs::msg::PoseWithCovarianceStamped m_pose{};
+
   rclcpp::Logger m_logger;
 };  // class LgsvlInterface
 
@@ -18,13 +18,11 @@
 #include <helper_functions/float_comparisons.hpp>
 #include <motion_common/motion_common.hpp>
 
-#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <limits>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <utility>
 
 #include "lgsvl_interface/lgsvl_interface.hpp"
@@ -54,28 +52,105 @@ using autoware_auto_msgs::msg::HornReport;
 using autoware_auto_msgs::msg::WipersCommand;
 using autoware_auto_msgs::msg::WipersReport;
 
-const std::unordered_map<WIPER_TYPE, WIPER_TYPE> LgsvlInterface::autoware_to_lgsvl_wiper {
-  {WipersCommand::NO_COMMAND, static_cast<WIPER_TYPE>(VSD::WIPERS_OFF)},
-  {WipersCommand::DISABLE, static_cast<WIPER_TYPE>(VSD::WIPERS_OFF)},
-  {WipersCommand::ENABLE_LOW, static_cast<WIPER_TYPE>(VSD::WIPERS_LOW)},
-  {WipersCommand::ENABLE_HIGH, static_cast<WIPER_TYPE>(VSD::WIPERS_HIGH)},
-  {WipersCommand::ENABLE_CLEAN, static_cast<WIPER_TYPE>(VSD::WIPERS_OFF)},
-};
-
-const std::unordered_map<GEAR_TYPE, GEAR_TYPE> LgsvlInterface::autoware_to_lgsvl_gear {
-  {VSC::GEAR_NO_COMMAND, static_cast<GEAR_TYPE>(VSD::GEAR_NEUTRAL)},
-  {VSC::GEAR_DRIVE, static_cast<GEAR_TYPE>(VSD::GEAR_DRIVE)},
-  {VSC::GEAR_REVERSE, static_cast<GEAR_TYPE>(VSD::GEAR_REVERSE)},
-  {VSC::GEAR_PARK, static_cast<GEAR_TYPE>(VSD::GEAR_PARKING)},
-  {VSC::GEAR_LOW, static_cast<GEAR_TYPE>(VSD::GEAR_LOW)},
-  {VSC::GEAR_NEUTRAL, static_cast<GEAR_TYPE>(VSD::GEAR_NEUTRAL)},
-};
-
-const std::unordered_map<MODE_TYPE, MODE_TYPE> LgsvlInterface::autoware_to_lgsvl_mode {
-  {VSC::MODE_NO_COMMAND, static_cast<MODE_TYPE>(VSD::VEHICLE_MODE_COMPLETE_MANUAL)},
-  {VSC::MODE_AUTONOMOUS, static_cast<MODE_TYPE>(VSD::VEHICLE_MODE_COMPLETE_AUTO_DRIVE)},
-  {VSC::MODE_MANUAL, static_cast<MODE_TYPE>(VSD::VEHICLE_MODE_COMPLETE_MANUAL)},
-};
+namespace
+{
+// Mappings from Autoware to LGSVL values, as switches that compile to jump tables instead of
+// hashing each value of each state command. They return false for unsupported values.
+bool8_t to_lgsvl_wiper(const WIPER_TYPE wiper, WIPER_TYPE & lgsvl_wiper) noexcept
+{
+  switch (wiper) {
+    case WipersCommand::NO_COMMAND:
+    case WipersCommand::DISABLE:
+    case WipersCommand::ENABLE_CLEAN:
+      lgsvl_wiper = static_cast<WIPER_TYPE>(VSD::WIPERS_OFF);
+      return true;
+    case WipersCommand::ENABLE_LOW:
+      lgsvl_wiper = static_cast<WIPER_TYPE>(VSD::WIPERS_LOW);
+      return true;
+    case WipersCommand::ENABLE_HIGH:
+      lgsvl_wiper = static_cast<WIPER_TYPE>(VSD::WIPERS_HIGH);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool8_t to_lgsvl_gear(const GEAR_TYPE gear, GEAR_TYPE & lgsvl_gear) noexcept
+{
+  switch (gear) {
+    case VSC::GEAR_NO_COMMAND:
+    case VSC::GEAR_NEUTRAL:
+      lgsvl_gear = static_cast<GEAR_TYPE>(VSD::GEAR_NEUTRAL);
+      return true;
+    case VSC::GEAR_DRIVE:
+      lgsvl_gear = static_cast<GEAR_TYPE>(VSD::GEAR_DRIVE);
+      return true;
+    case VSC::GEAR_REVERSE:
+      lgsvl_gear = static_cast<GEAR_TYPE>(VSD::GEAR_REVERSE);
+      return true;
+    case VSC::GEAR_PARK:
+      lgsvl_gear = static_cast<GEAR_TYPE>(VSD::GEAR_PARKING);
+      return true;
+    case VSC::GEAR_LOW:
+      lgsvl_gear = static_cast<GEAR_TYPE>(VSD::GEAR_LOW);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Inverse of to_lgsvl_gear, where neutral maps back to neutral rather than to no command
+bool8_t from_lgsvl_gear(const GEAR_TYPE lgsvl_gear, GEAR_TYPE & gear) noexcept
+{
+  switch (lgsvl_gear) {
+    case VSD::GEAR_NEUTRAL:
+      gear = VSC::GEAR_NEUTRAL;
+      return true;
+    case VSD::GEAR_DRIVE:
+      gear = VSC::GEAR_DRIVE;
+      return true;
+    case VSD::GEAR_REVERSE:
+      gear = VSC::GEAR_REVERSE;
+      return true;
+    case VSD::GEAR_PARKING:
+      gear = VSC::GEAR_PARK;
+      return true;
+    case VSD::GEAR_LOW:
+      gear = VSC::GEAR_LOW;
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool8_t to_lgsvl_mode(const MODE_TYPE mode, MODE_TYPE & lgsvl_mode) noexcept
+{
+  switch (mode) {
+    case VSC::MODE_NO_COMMAND:
+    case VSC::MODE_MANUAL:
+      lgsvl_mode = static_cast<MODE_TYPE>(VSD::VEHICLE_MODE_COMPLETE_MANUAL);
+      return true;
+    case VSC::MODE_AUTONOMOUS:
+      lgsvl_mode = static_cast<MODE_TYPE>(VSD::VEHICLE_MODE_COMPLETE_AUTO_DRIVE);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Compare everything but the header, which only differs by its stamp
+bool8_t same_state(const VSD & lhs, const VSD & rhs) noexcept
+{
+  return (lhs.blinker_state == rhs.blinker_state) &&
+         (lhs.headlight_state == rhs.headlight_state) &&
+         (lhs.wiper_state == rhs.wiper_state) &&
+         (lhs.current_gear == rhs.current_gear) &&
+         (lhs.vehicle_mode == rhs.vehicle_mode) &&
+         (lhs.hand_brake_active == rhs.hand_brake_active) &&
+         (lhs.horn_active == rhs.horn_active) &&
+         (lhs.autonomous_mode_active == rhs.autonomous_mode_active);
+}
+}  // namespace
 
 LgsvlInterface::LgsvlInterface(
   rclcpp::Node & node,
@@ -90,10 +165,12 @@ LgsvlInterface::LgsvlInterface(
   Table1D && brake_table,
   Table1D && steer_table,
   bool publish_tf,
-  bool publish_pose)
-: m_throttle_table{throttle_table},
-  m_brake_table{brake_table},
-  m_steer_table{steer_table},
+  bool publish_pose,
+  bool skip_unchanged_state)
+: m_throttle_table{std::move(throttle_table)},
+  m_brake_table{std::move(brake_table)},
+  m_steer_table{std::move(steer_table)},
+  m_skip_unchanged_state{skip_unchanged_state},
   m_logger{node.get_logger()}
 {
   const auto check = [](const auto value, const auto ref) -> bool8_t {
@@ -137,6 +214,16 @@ LgsvlInterface::LgsvlInterface(
     // Warn if steer domain is not equally straddling zero: could be right, but maybe not
     RCLCPP_WARN(node.get_logger(), "Steer table domain is not symmetric across zero. Is this ok?");
   }
+  // Uniformly spaced domains are indexed directly, others need a binary search per lookup
+  if (!m_throttle_table.is_uniform() || !m_brake_table.is_uniform() ||
+    !m_steer_table.is_uniform())
+  {
+    RCLCPP_INFO(
+      node.get_logger(), "A control table domain is not uniformly spaced, lookups are slower");
+  }
+
+  // A single transform is reused for each odometry message
+  m_tf_msg.transforms.resize(1U);
 
   // Make publishers
   m_cmd_pub = node.create_publisher<lgsvl_msgs::msg::VehicleControlData>(
@@ -212,6 +299,7 @@ LgsvlInterface::LgsvlInterface(
       odometry().set__velocity_mps(msg->velocity);
       odometry().set__rear_wheel_angle_rad(msg->rear_wheel_angle);
       odometry().set__front_wheel_angle_rad(msg->front_wheel_angle);
+      notify_state_update();
     });
 
   // Setup Tf Buffer with listener
@@ -263,55 +351,53 @@ bool8_t LgsvlInterface::update(std::chrono::nanoseconds timeout)
 ////////////////////////////////////////////////////////////////////////////////
 bool8_t LgsvlInterface::send_state_command(const autoware_auto_msgs::msg::VehicleStateCommand & msg)
 {
-  auto msg_corrected = msg;
-
   // Correcting blinker: it is shifted down by one,
   // as the first value BLINKER_NO_COMMAND does not exisit in LGSVL
-  if (msg.blinker == VSC::BLINKER_NO_COMMAND) {
-    msg_corrected.blinker = get_state_report().blinker;
+  auto blinker = msg.blinker;
+  if (blinker == VSC::BLINKER_NO_COMMAND) {
+    blinker = get_state_report().blinker;
   }
-  msg_corrected.blinker--;
+  blinker--;
 
   // Correcting gears
-  auto const gear_iter = autoware_to_lgsvl_gear.find(msg.gear);
-
-  if (gear_iter != autoware_to_lgsvl_gear.end()) {
-    msg_corrected.gear = gear_iter->second;
-  } else {
-    msg_corrected.gear = static_cast<uint8_t>(VSD::GEAR_DRIVE);
+  GEAR_TYPE gear{};
+  if (!to_lgsvl_gear(msg.gear, gear)) {
+    gear = static_cast<GEAR_TYPE>(VSD::GEAR_DRIVE);
     RCLCPP_WARN(m_logger, "Unsupported gear value in state command, defaulting to Drive");
   }
 
-  // Correcting wipers
-  auto const wiper_iter = autoware_to_lgsvl_wiper.find(msg.wiper);
-
-  if (wiper_iter != autoware_to_lgsvl_wiper.end()) {
-    msg_corrected.wiper = wiper_iter->second;
-  } else {
-    msg_corrected.wiper = static_cast<uint8_t>(VSD::WIPERS_OFF);
+  // Correcting wipers, which are not part of the LGSVL state: checked for the warning only
+  WIPER_TYPE wiper{};
+  if (!to_lgsvl_wiper(msg.wiper, wiper)) {
     RCLCPP_WARN(m_logger, "Unsupported wiper value in state command, defaulting to OFF");
   }
 
   // Correcting mode
-  auto const mode_iter = autoware_to_lgsvl_mode.find(msg.mode);
-
-  if (mode_iter != autoware_to_lgsvl_mode.end()) {
-    msg_corrected.mode = mode_iter->second;
-  } else {
-    msg_corrected.mode = static_cast<uint8_t>(VSD::VEHICLE_MODE_COMPLETE_MANUAL);
+  MODE_TYPE mode{};
+  if (!to_lgsvl_mode(msg.mode, mode)) {
+    mode = static_cast<MODE_TYPE>(VSD::VEHICLE_MODE_COMPLETE_MANUAL);
     RCLCPP_WARN(m_logger, "Unsupported mode value in state command, defaulting to COMPLETE MANUAL");
   }
 
-  m_lgsvl_state.header.set__stamp(msg_corrected.stamp);
-  m_lgsvl_state.set__blinker_state(msg_corrected.blinker);
-  m_lgsvl_state.set__current_gear(msg_corrected.gear);
-  m_lgsvl_state.set__vehicle_mode(msg_corrected.mode);
-  m_lgsvl_state.set__hand_brake_active(msg_corrected.hand_brake);
+  m_lgsvl_state.header.set__stamp(msg.stamp);
+  m_lgsvl_state.set__blinker_state(blinker);
+  m_lgsvl_state.set__current_gear(gear);
+  m_lgsvl_state.set__vehicle_mode(mode);
+  m_lgsvl_state.set__hand_brake_active(msg.hand_brake);
   m_lgsvl_state.set__autonomous_mode_active(
-    msg_corrected.mode ==
+    mode ==
     VSD::VEHICLE_MODE_COMPLETE_AUTO_DRIVE ? true : false);
 
+  if (m_skip_unchanged_state && m_lgsvl_state_published &&
+    same_state(m_lgsvl_state, m_published_lgsvl_state))
+  {
+    return true;
+  }
   m_state_pub->publish(m_lgsvl_state);
+  if (m_skip_unchanged_state) {
+    m_published_lgsvl_state = m_lgsvl_state;
+    m_lgsvl_state_published = true;
+  }
 
   return true;
 }
@@ -348,13 +434,12 @@ bool8_t LgsvlInterface::send_control_command(
 bool8_t LgsvlInterface::send_control_command(const autoware_auto_msgs::msg::RawControlCommand & msg)
 {
   // Front steer semantically is z up, ccw positive, but LGSVL thinks its the opposite
-  lgsvl_msgs::msg::VehicleControlData control_data;
-  control_data.set__acceleration_pct(static_cast<float>(msg.throttle) / 100.f);
-  control_data.set__braking_pct(static_cast<float>(msg.brake) / 100.f);
-  control_data.set__target_wheel_angle(-static_cast<float>(msg.front_steer) / 100.f);
-  // control_data.set__target_wheel_angular_rate();  // Missing angular rate in raw command
-  // control_data.set__target_gear(); // Missing target gear in raw command
-  m_cmd_pub->publish(control_data);
+  m_control_data.set__acceleration_pct(static_cast<float>(msg.throttle) / 100.f);
+  m_control_data.set__braking_pct(static_cast<float>(msg.brake) / 100.f);
+  m_control_data.set__target_wheel_angle(-static_cast<float>(msg.front_steer) / 100.f);
+  // m_control_data.set__target_wheel_angular_rate();  // Missing angular rate in raw command
+  // m_control_data.set__target_gear(); // Missing target gear in raw command
+  m_cmd_pub->publish(m_control_data);
   return true;
 }
 
@@ -415,7 +500,7 @@ void LgsvlInterface::on_odometry(const nav_msgs::msg::Odometry & msg)
   const auto pz = msg.pose.pose.position.z - m_odom_zero.z;
   {
     // Create a TF which represents the odometry observation
-    geometry_msgs::msg::TransformStamped tf{};
+    auto & tf = m_tf_msg.transforms.front();
     tf.header = msg.header;
     tf.child_frame_id = msg.child_frame_id;
     tf.transform.translation.x = px;
@@ -425,7 +510,7 @@ void LgsvlInterface::on_odometry(const nav_msgs::msg::Odometry & msg)
 
     // Only create vehicle kinematic state when required tf is available
     if (m_nav_base_tf_set) {
-      autoware_auto_msgs::msg::VehicleKinematicState vse_t{};
+      auto & vse_t = m_kinematic_state;
 
       // Apply a transform representing the odometry observation of the original
       // child frame in the odometry parent frame to the VehicleKinematicState
@@ -457,14 +542,12 @@ void LgsvlInterface::on_odometry(const nav_msgs::msg::Odometry & msg)
     }
 
     if (m_tf_pub) {
-      tf2_msgs::msg::TFMessage tf_msg{};
-      tf_msg.transforms.emplace_back(std::move(tf));
-      m_tf_pub->publish(tf_msg);
+      m_tf_pub->publish(m_tf_msg);
     }
   }
 
   if (m_pose_pub) {
-    geometry_msgs::msg::PoseWithCovarianceStamped pose{};
+    auto & pose = m_pose;
     pose.header = msg.header;
     pose.pose.pose.orientation = q;
     pose.pose.pose.position.x = px;
@@ -504,16 +587,7 @@ void LgsvlInterface::on_state_report(const autoware_auto_msgs::msg::VehicleState
 
 
   // Find autoware gear via inverse mapping
-  const auto value_same = [&msg](const auto & kv) -> bool {  // also do some capture
-      return msg.gear == kv.second;
-    };
-  const auto it = std::find_if(
-    autoware_to_lgsvl_gear.begin(),
-    autoware_to_lgsvl_gear.end(), value_same);
-
-  if (it != autoware_to_lgsvl_gear.end()) {
-    corrected_report.gear = it->first;
-  } else {
+  if (!from_lgsvl_gear(msg.gear, corrected_report.gear)) {
     corrected_report.gear = msg.GEAR_NEUTRAL;
     RCLCPP_WARN(m_logger, "Invalid gear value in state report from LGSVL simulator");
   }
@@ -524,7 +598,14 @@ void LgsvlInterface::on_state_report(const autoware_auto_msgs::msg::VehicleState
   // instead reporting true blinker status
   corrected_report.blinker++;
 
+  if (m_skip_unchanged_state && m_state_report_received &&
+    (corrected_report == state_report()))
+  {
+    return;
+  }
   state_report() = corrected_report;
+  m_state_report_received = true;
+  notify_state_update();
 }
 
 }  // namespace lgsvl_interface
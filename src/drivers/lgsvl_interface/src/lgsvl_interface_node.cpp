@@ -67,6 +67,8 @@ LgsvlInterfaceNode::LgsvlInterfaceNode(
   const auto pub_tf_param = declare_parameter("lgsvl.publish_tf");
   const bool pub_tf = rclcpp::ParameterType::PARAMETER_NOT_SET == pub_tf_param.get_type() ?
     NO_PUBLISH : pub_tf_param.get<bool>();
+  // Only publish state commands and notify state reports which changed, for high rate simulation
+  const bool skip_unchanged_state = declare_parameter("lgsvl.skip_unchanged_state", false);
 
   // Set up interface
   set_interface(
@@ -83,7 +85,8 @@ LgsvlInterfaceNode::LgsvlInterfaceNode(
       table("brake"),
       table("steer"),
       pub_tf,
-      pub_pose
+      pub_pose,
+      skip_unchanged_state
   ));
   // TODO(c.ho) low pass filter and velocity controller
 }
@@ -16,6 +16,7 @@
 
 #include "test_lgsvl_interface.hpp"
 #include <memory>
+#include <vector>
 
 TEST_F(LgsvlInterfaceTest, GearMappingStateCommand)
 {
@@ -116,3 +117,63 @@ TEST_F(LgsvlInterfaceTest, GearMappingStateReport)
   publish_gear_and_wait(static_cast<lgsvl_interface::GEAR_TYPE>(99u));
   EXPECT_EQ(lgsvl_interface_->get_state_report().gear, VSC::GEAR_NEUTRAL);
 }
+
+TEST_F(LgsvlInterfaceTest, SkipUnchangedStateCommand)
+{
+  const auto skip_state_cmd_topic = "test_lgsvl_skip/vehicle_state_cmd";
+  const auto skip_node = std::make_shared<rclcpp::Node>(
+    "lgsvl_interface_skip_test_node", "/gtest");
+  const auto skip_interface = std::make_unique<lgsvl_interface::LgsvlInterface>(
+    *skip_node,
+    "test_lgsvl_skip/vehicle_control_cmd",
+    skip_state_cmd_topic,
+    "test_lgsvl_skip/state_report",
+    "",
+    "test_lgsvl_skip/vehicle_odom",
+    "test_lgsvl_skip/vehicle_kinematic_state",
+    sim_odom_child_frame,
+    Table1D({0.0, 3.0}, {0.0, 100.0}),
+    Table1D({-3.0, 0.0}, {100.0, 0.0}),
+    Table1D({-0.331, 0.331}, {-100.0, 100.0}),
+    lgsvl_interface::NO_PUBLISH,
+    lgsvl_interface::NO_PUBLISH,
+    true);
+
+  // Setup subscription
+  std::vector<lgsvl_interface::GEAR_TYPE> received_gears{};
+  const auto sub_node = std::make_shared<rclcpp::Node>(
+    "test_lgsvl_interface_sub_skip_state_command",
+    "/gtest");
+  auto sub_ptr = sub_node->create_subscription<lgsvl_interface::VSD>(
+    skip_state_cmd_topic, rclcpp::QoS(10),
+    [&received_gears](const lgsvl_interface::VSD::SharedPtr msg) -> void {
+      received_gears.push_back(msg->current_gear);
+    });
+
+  // Setup Node execution
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(skip_node);
+  executor.add_node(sub_node);
+  wait_for_publisher(sub_ptr);
+
+  auto send_gear_and_wait =
+    [&skip_interface, &executor](lgsvl_interface::GEAR_TYPE gear, int32_t stamp_sec) -> void {
+      VSC vsc_msg;
+      vsc_msg.stamp.sec = stamp_sec;
+      vsc_msg.gear = gear;
+      EXPECT_TRUE(skip_interface->send_state_command(vsc_msg));
+      rclcpp::sleep_for(std::chrono::milliseconds(100));
+      executor.spin_some();
+    };
+
+  // Tests: only the first command of each state is published, whatever its stamp
+  send_gear_and_wait(VSC::GEAR_DRIVE, 1);
+  send_gear_and_wait(VSC::GEAR_DRIVE, 2);
+  send_gear_and_wait(VSC::GEAR_DRIVE, 3);
+  send_gear_and_wait(VSC::GEAR_REVERSE, 4);
+  send_gear_and_wait(VSC::GEAR_REVERSE, 5);
+
+  ASSERT_EQ(received_gears.size(), 2U);
+  EXPECT_EQ(received_gears[0U], lgsvl_interface::VSD::GEAR_DRIVE);
+  EXPECT_EQ(received_gears[1U], lgsvl_interface::VSD::GEAR_REVERSE);
+}
@@ -24,6 +24,7 @@
 #include <common/types.hpp>
 #include <vehicle_interface/dbw_state_machine.hpp>
 #include <vehicle_interface/platform_interface.hpp>
+#include <vehicle_interface/signal_table.hpp>
 
 #include <raptor_dbw_msgs/msg/accelerator_pedal_cmd.hpp>
 #include <raptor_dbw_msgs/msg/brake_cmd.hpp>
@@ -127,6 +128,7 @@ using ModeChangeResponse = autoware_auto_msgs::srv::AutonomyModeChange_Response;
 
 using autoware::drivers::vehicle_interface::DbwStateMachine;
 using autoware::drivers::vehicle_interface::DbwState;
+using autoware::drivers::vehicle_interface::LinearSignal;
 using namespace std::chrono_literals;  // NOLINT
 
 namespace autoware
@@ -253,6 +255,8 @@ private:
   float32_t m_front_axle_to_cog;
   float32_t m_rear_axle_to_cog;
   float32_t m_steer_to_tire_ratio;
+  // Steering wheel angle in degrees of the DBW to tire angle in radians
+  LinearSignal m_steering_wheel_angle;
   float32_t m_max_steer_angle;
   float32_t m_acceleration_limit;
   float32_t m_deceleration_limit;
@@ -26,6 +26,73 @@ namespace autoware
 namespace ne_raptor_interface
 {
 
+using autoware::drivers::vehicle_interface::EnumTable;
+
+namespace
+{
+struct HeadlightsCmd
+{
+  uint8_t low_beam;
+  uint8_t high_beam;
+};
+
+struct WipersCmd
+{
+  uint8_t front;
+  uint8_t rear;
+};
+
+// Commands from Autoware to the DBW
+constexpr EnumTable<uint8_t> kGearCmdTable{
+  {VehicleStateCommand::GEAR_NO_COMMAND, Gear::NONE},
+  {VehicleStateCommand::GEAR_DRIVE, Gear::DRIVE},
+  {VehicleStateCommand::GEAR_REVERSE, Gear::REVERSE},
+  {VehicleStateCommand::GEAR_PARK, Gear::PARK},
+  {VehicleStateCommand::GEAR_LOW, Gear::LOW},
+  {VehicleStateCommand::GEAR_NEUTRAL, Gear::NEUTRAL}};
+constexpr EnumTable<uint8_t> kTurnSignalCmdTable{
+  {VehicleStateCommand::BLINKER_OFF, TurnSignal::NONE},
+  {VehicleStateCommand::BLINKER_LEFT, TurnSignal::LEFT},
+  {VehicleStateCommand::BLINKER_RIGHT, TurnSignal::RIGHT},
+  {VehicleStateCommand::BLINKER_HAZARD, TurnSignal::HAZARDS}};
+constexpr EnumTable<HeadlightsCmd> kHeadlightsCmdTable{
+  {HeadlightsCommand::DISABLE, {LowBeam::OFF, HighBeam::OFF}},
+  {HeadlightsCommand::ENABLE_LOW, {LowBeam::ON, HighBeam::OFF}},
+  {HeadlightsCommand::ENABLE_HIGH, {LowBeam::OFF, HighBeam::ON}}};
+constexpr EnumTable<WipersCmd> kWipersCmdTable{
+  {WipersCommand::DISABLE, {WiperFront::OFF, WiperRear::OFF}},
+  {WipersCommand::ENABLE_LOW, {WiperFront::CONSTANT_LOW, WiperRear::CONSTANT_LOW}},
+  {WipersCommand::ENABLE_HIGH, {WiperFront::CONSTANT_HIGH, WiperRear::CONSTANT_HIGH}},
+  {WipersCommand::ENABLE_CLEAN, {WiperFront::WASH_BRIEF, WiperRear::WASH_BRIEF}}};
+
+// Reports from the DBW to Autoware
+constexpr EnumTable<bool8_t> kParkingBrakeRptTable{
+  {ParkingBrake::OFF, false},
+  {ParkingBrake::ON, true}};
+constexpr EnumTable<uint8_t> kGearRptTable{
+  {Gear::PARK, VehicleStateReport::GEAR_PARK},
+  {Gear::REVERSE, VehicleStateReport::GEAR_REVERSE},
+  {Gear::NEUTRAL, VehicleStateReport::GEAR_NEUTRAL},
+  {Gear::DRIVE, VehicleStateReport::GEAR_DRIVE},
+  {Gear::LOW, VehicleStateReport::GEAR_LOW}};
+constexpr EnumTable<bool8_t> kHornRptTable{
+  {HornState::OFF, false},
+  {HornState::ON, true}};
+constexpr EnumTable<uint8_t> kTurnSignalRptTable{
+  {TurnSignal::NONE, VehicleStateReport::BLINKER_OFF},
+  {TurnSignal::LEFT, VehicleStateReport::BLINKER_LEFT},
+  {TurnSignal::RIGHT, VehicleStateReport::BLINKER_RIGHT},
+  {TurnSignal::HAZARDS, VehicleStateReport::BLINKER_HAZARD}};
+constexpr EnumTable<uint8_t> kHighBeamRptTable{
+  {HighBeamState::OFF, VehicleStateReport::HEADLIGHT_OFF},
+  {HighBeamState::ON, VehicleStateReport::HEADLIGHT_HIGH}};
+constexpr EnumTable<uint8_t> kWiperRptTable{
+  {WiperFront::OFF, VehicleStateReport::WIPER_OFF},
+  {WiperFront::CONSTANT_LOW, VehicleStateReport::WIPER_LOW},
+  {WiperFront::CONSTANT_HIGH, VehicleStateReport::WIPER_HIGH},
+  {WiperFront::WASH_BRIEF, VehicleStateReport::WIPER_CLEAN}};
+}  // namespace
+
 NERaptorInterface::NERaptorInterface(
   rclcpp::Node & node,
   uint16_t ecu_build_num,
@@ -44,6 +111,7 @@ NERaptorInterface::NERaptorInterface(
   m_front_axle_to_cog{front_axle_to_cog},
   m_rear_axle_to_cog{rear_axle_to_cog},
   m_steer_to_tire_ratio{steer_to_tire_ratio},
+  m_steering_wheel_angle{DEGREES_TO_RADIANS / steer_to_tire_ratio, 0.0F},
   m_max_steer_angle{max_steer_angle},
   m_acceleration_limit{acceleration_limit},
   m_deceleration_limit{std::fabs(deceleration_limit)},
@@ -199,57 +267,23 @@ bool8_t NERaptorInterface::send_state_command(const VehicleStateCommand & msg)
   std::lock_guard<std::mutex> guard_mc(m_misc_cmd_mutex);
 
   // Set gear values
-  switch (msg.gear) {
-    case VehicleStateCommand::GEAR_NO_COMMAND:
-      m_gear_cmd.cmd.gear = Gear::NONE;
-      break;
-    case VehicleStateCommand::GEAR_DRIVE:
-      m_gear_cmd.cmd.gear = Gear::DRIVE;
-      break;
-    case VehicleStateCommand::GEAR_REVERSE:
-      m_gear_cmd.cmd.gear = Gear::REVERSE;
-      break;
-    case VehicleStateCommand::GEAR_PARK:
-      m_gear_cmd.cmd.gear = Gear::PARK;
-      break;
-    case VehicleStateCommand::GEAR_LOW:
-      m_gear_cmd.cmd.gear = Gear::LOW;
-      break;
-    case VehicleStateCommand::GEAR_NEUTRAL:
-      m_gear_cmd.cmd.gear = Gear::NEUTRAL;
-      break;
-    default:  // error
-      m_gear_cmd.cmd.gear = Gear::NONE;
-      RCLCPP_ERROR_THROTTLE(
-        m_logger, m_clock, CLOCK_1_SEC,
-        "Received command for invalid gear state.");
-      ret = false;
-      break;
+  if (!kGearCmdTable.find(msg.gear, m_gear_cmd.cmd.gear)) {
+    m_gear_cmd.cmd.gear = Gear::NONE;
+    RCLCPP_ERROR_THROTTLE(
+      m_logger, m_clock, CLOCK_1_SEC,
+      "Received command for invalid gear state.");
+    ret = false;
   }
 
-  switch (msg.blinker) {
-    case VehicleStateCommand::BLINKER_NO_COMMAND:
-      // Keep previous
-      break;
-    case VehicleStateCommand::BLINKER_OFF:
-      m_misc_cmd.cmd.value = TurnSignal::NONE;
-      break;
-    case VehicleStateCommand::BLINKER_LEFT:
-      m_misc_cmd.cmd.value = TurnSignal::LEFT;
-      break;
-    case VehicleStateCommand::BLINKER_RIGHT:
-      m_misc_cmd.cmd.value = TurnSignal::RIGHT;
-      break;
-    case VehicleStateCommand::BLINKER_HAZARD:
-      m_misc_cmd.cmd.value = TurnSignal::HAZARDS;
-      break;
-    default:
-      m_misc_cmd.cmd.value = TurnSignal::SNA;
-      RCLCPP_ERROR_THROTTLE(
-        m_logger, m_clock, CLOCK_1_SEC,
-        "Received command for invalid turn signal state.");
-      ret = false;
-      break;
+  // Keep the previous turn signal if there is no command
+  if ((msg.blinker != VehicleStateCommand::BLINKER_NO_COMMAND) &&
+    !kTurnSignalCmdTable.find(msg.blinker, m_misc_cmd.cmd.value))
+  {
+    m_misc_cmd.cmd.value = TurnSignal::SNA;
+    RCLCPP_ERROR_THROTTLE(
+      m_logger, m_clock, CLOCK_1_SEC,
+      "Received command for invalid turn signal state.");
+    ret = false;
   }
 
   std::lock_guard<std::mutex> guard_bc(m_brake_cmd_mutex);
@@ -361,7 +395,7 @@ bool8_t NERaptorInterface::send_control_command(const VehicleControlCommand & ms
 
   // Limit steering angle to valid range
   /* Steering -> tire angle conversion is linear except for extreme angles */
-  angle_checked = (msg.front_wheel_angle_rad * m_steer_to_tire_ratio) / DEGREES_TO_RADIANS;
+  angle_checked = m_steering_wheel_angle.encode(msg.front_wheel_angle_rad);
   if (angle_checked > m_max_steer_angle) {
     angle_checked = m_max_steer_angle;
     RCLCPP_ERROR_THROTTLE(
@@ -405,28 +439,18 @@ bool8_t NERaptorInterface::handle_mode_change_request(ModeChangeRequest::SharedP
 
 void NERaptorInterface::send_headlights_command(const HeadlightsCommand & msg)
 {
-  switch (msg.command) {
-    case HeadlightsCommand::NO_COMMAND:
-      // Keep previous
-      break;
-    case HeadlightsCommand::DISABLE:
-      m_misc_cmd.low_beam_cmd.status = LowBeam::OFF;
-      m_misc_cmd.high_beam_cmd.status = HighBeam::OFF;
-      break;
-    case HeadlightsCommand::ENABLE_LOW:
-      m_misc_cmd.low_beam_cmd.status = LowBeam::ON;
-      m_misc_cmd.high_beam_cmd.status = HighBeam::OFF;
-      break;
-    case HeadlightsCommand::ENABLE_HIGH:
-      m_misc_cmd.low_beam_cmd.status = LowBeam::OFF;
-      m_misc_cmd.high_beam_cmd.status = HighBeam::ON;
-      break;
-    default:
-      // Keep previous
-      RCLCPP_ERROR_THROTTLE(
-        m_logger, m_clock, CLOCK_1_SEC,
-        "Received command for invalid headlight state.");
-      break;
+  // Keep previous if there is no command or the command is invalid
+  if (msg.command == HeadlightsCommand::NO_COMMAND) {
+    return;
+  }
+  HeadlightsCmd cmd{};
+  if (kHeadlightsCmdTable.find(msg.command, cmd)) {
+    m_misc_cmd.low_beam_cmd.status = cmd.low_beam;
+    m_misc_cmd.high_beam_cmd.status = cmd.high_beam;
+  } else {
+    RCLCPP_ERROR_THROTTLE(
+      m_logger, m_clock, CLOCK_1_SEC,
+      "Received command for invalid headlight state.");
   }
 }
 
@@ -438,83 +462,43 @@ void NERaptorInterface::send_horn_command(const HornCommand & msg)
 
 void NERaptorInterface::send_wipers_command(const WipersCommand & msg)
 {
-  switch (msg.command) {
-    case WipersCommand::NO_COMMAND:
-      // Keep previous
-      break;
-    case WipersCommand::DISABLE:
-      m_misc_cmd.front_wiper_cmd.status = WiperFront::OFF;
-      m_misc_cmd.rear_wiper_cmd.status = WiperRear::OFF;
-      break;
-    case WipersCommand::ENABLE_LOW:
-      m_misc_cmd.front_wiper_cmd.status = WiperFront::CONSTANT_LOW;
-      m_misc_cmd.rear_wiper_cmd.status = WiperRear::CONSTANT_LOW;
-      break;
-    case WipersCommand::ENABLE_HIGH:
-      m_misc_cmd.front_wiper_cmd.status = WiperFront::CONSTANT_HIGH;
-      m_misc_cmd.rear_wiper_cmd.status = WiperRear::CONSTANT_HIGH;
-      break;
-    case WipersCommand::ENABLE_CLEAN:
-      m_misc_cmd.front_wiper_cmd.status = WiperFront::WASH_BRIEF;
-      m_misc_cmd.rear_wiper_cmd.status = WiperRear::WASH_BRIEF;
-      break;
-    default:
-      // Keep previous
-      RCLCPP_ERROR_THROTTLE(
-        m_logger, m_clock, CLOCK_1_SEC,
-        "Received command for invalid wiper state.");
-      break;
+  // Keep previous if there is no command or the command is invalid
+  if (msg.command == WipersCommand::NO_COMMAND) {
+    return;
+  }
+  WipersCmd cmd{};
+  if (kWipersCmdTable.find(msg.command, cmd)) {
+    m_misc_cmd.front_wiper_cmd.status = cmd.front;
+    m_misc_cmd.rear_wiper_cmd.status = cmd.rear;
+  } else {
+    RCLCPP_ERROR_THROTTLE(
+      m_logger, m_clock, CLOCK_1_SEC,
+      "Received command for invalid wiper state.");
   }
 }
 
 void NERaptorInterface::on_brake_report(const BrakeReport::SharedPtr & msg)
 {
-  switch (msg->parking_brake.status) {
-    case ParkingBrake::OFF:
-      state_report().hand_brake = false;
-      break;
-    case ParkingBrake::ON:
-      state_report().hand_brake = true;
-      break;
-    case ParkingBrake::NO_REQUEST:
-    case ParkingBrake::FAULT:
-    default:
-      state_report().hand_brake = false;
-      RCLCPP_WARN_THROTTLE(
-        m_logger, m_clock, CLOCK_1_SEC,
-        "Received invalid parking brake value from NE Raptor DBW.");
-      break;
+  if (!kParkingBrakeRptTable.find(msg->parking_brake.status, state_report().hand_brake)) {
+    state_report().hand_brake = false;
+    RCLCPP_WARN_THROTTLE(
+      m_logger, m_clock, CLOCK_1_SEC,
+      "Received invalid parking brake value from NE Raptor DBW.");
   }
   m_seen_brake_rpt = true;
+  notify_state_update();
 }
 
 void NERaptorInterface::on_gear_report(const GearReport::SharedPtr & msg)
 {
-  switch (msg->state.gear) {
-    case Gear::PARK:
-      state_report().gear = VehicleStateReport::GEAR_PARK;
-      break;
-    case Gear::REVERSE:
-      state_report().gear = VehicleStateReport::GEAR_REVERSE;
-      break;
-    case Gear::NEUTRAL:
-      state_report().gear = VehicleStateReport::GEAR_NEUTRAL;
-      break;
-    case Gear::DRIVE:
-      state_report().gear = VehicleStateReport::GEAR_DRIVE;
-      break;
-    case Gear::LOW:
-      state_report().gear = VehicleStateReport::GEAR_LOW;
-      break;
-    case Gear::NONE:
-    default:
-      state_report().gear = 0;
-      RCLCPP_WARN_THROTTLE(
-        m_logger, m_clock, CLOCK_1_SEC,
-        "Received invalid gear value from NE Raptor DBW.");
-      break;
+  if (!kGearRptTable.find(msg->state.gear, state_report().gear)) {
+    state_report().gear = 0;
+    RCLCPP_WARN_THROTTLE(
+      m_logger, m_clock, CLOCK_1_SEC,
+      "Received invalid gear value from NE Raptor DBW.");
   }
   m_seen_gear_rpt = true;
+  notify_state_update();
 }
 
 void NERaptorInterface::on_misc_report(const MiscReport::SharedPtr & msg)
@@ -536,6 +520,7 @@ void NERaptorInterface::on_misc_report(const MiscReport::SharedPtr & msg)
     state_report().mode = VehicleStateReport::MODE_MANUAL;
   }
   m_dbw_state_machine->dbw_feedback(msg->by_wire_ready && !msg->general_driver_activity);
+  notify_state_update();
 
   std::lock_guard<std::mutex> guard_vks(m_vehicle_kin_state_mutex);
 
@@ -601,91 +586,42 @@ void NERaptorInterface::on_misc_report(const MiscReport::SharedPtr & msg)
 
 void NERaptorInterface::on_other_actuators_report(const OtherActuatorsReport::SharedPtr & msg)
 {
-  switch (msg->horn_state.status) {
-    case HornState::OFF:
-      state_report().horn = false;
-      break;
-    case HornState::ON:
-      state_report().horn = true;
-      break;
-    case HornState::SNA:
-    default:
-      state_report().horn = false;
-      RCLCPP_WARN_THROTTLE(
-        m_logger, m_clock, CLOCK_1_SEC,
-        "Received invalid horn value from NE Raptor DBW.");
-      break;
+  if (!kHornRptTable.find(msg->horn_state.status, state_report().horn)) {
+    state_report().horn = false;
+    RCLCPP_WARN_THROTTLE(
+      m_logger, m_clock, CLOCK_1_SEC,
+      "Received invalid horn value from NE Raptor DBW.");
   }
 
-  switch (msg->turn_signal_state.value) {
-    case TurnSignal::NONE:
-      state_report().blinker = VehicleStateReport::BLINKER_OFF;
-      break;
-    case TurnSignal::LEFT:
-      state_report().blinker = VehicleStateReport::BLINKER_LEFT;
-      break;
-    case TurnSignal::RIGHT:
-      state_report().blinker = VehicleStateReport::BLINKER_RIGHT;
-      break;
-    case TurnSignal::HAZARDS:
-      state_report().blinker = VehicleStateReport::BLINKER_HAZARD;
-      break;
-    case TurnSignal::SNA:
-    default:
-      state_report().blinker = 0;
-      RCLCPP_WARN_THROTTLE(
-        m_logger, m_clock, CLOCK_1_SEC,
-        "Received invalid turn signal value from NE Raptor DBW.");
-      break;
+  if (!kTurnSignalRptTable.find(msg->turn_signal_state.value, state_report().blinker)) {
+    state_report().blinker = 0;
+    RCLCPP_WARN_THROTTLE(
+      m_logger, m_clock, CLOCK_1_SEC,
+      "Received invalid turn signal value from NE Raptor DBW.");
   }
 
-  switch (msg->high_beam_state.value) {
-    case HighBeamState::OFF:
-      state_report().headlight = VehicleStateReport::HEADLIGHT_OFF;
-      break;
-    case HighBeamState::ON:
-      state_report().headlight = VehicleStateReport::HEADLIGHT_HIGH;
-      break;
-    case HighBeamState::RESERVED:
-    case HighBeamState::SNA:
-    default:
-      state_report().headlight = 0;
-      RCLCPP_WARN_THROTTLE(
-        m_logger, m_clock, CLOCK_1_SEC,
-        "Received invalid headlight value from NE Raptor DBW.");
-      break;
+  if (!kHighBeamRptTable.find(msg->high_beam_state.value, state_report().headlight)) {
+    state_report().headlight = 0;
+    RCLCPP_WARN_THROTTLE(
+      m_logger, m_clock, CLOCK_1_SEC,
+      "Received invalid headlight value from NE Raptor DBW.");
   }
 
-  switch (msg->front_wiper_state.status) {
-    case WiperFront::OFF:
-      state_report().wiper = VehicleStateReport::WIPER_OFF;
-      break;
-    case WiperFront::CONSTANT_LOW:
-      state_report().wiper = VehicleStateReport::WIPER_LOW;
-      break;
-    case WiperFront::CONSTANT_HIGH:
-      state_report().wiper = VehicleStateReport::WIPER_HIGH;
-      break;
-    case WiperFront::WASH_BRIEF:
-      state_report().wiper = VehicleStateReport::WIPER_CLEAN;
-      break;
-    case WiperFront::SNA:
-    default:
-      state_report().wiper = 0;
-      RCLCPP_WARN_THROTTLE(
-        m_logger, m_clock, CLOCK_1_SEC,
-        "Received invalid wiper value from NE Raptor DBW.");
-      break;
+  if (!kWiperRptTable.find(msg->front_wiper_state.status, state_report().wiper)) {
+    state_report().wiper = 0;
+    RCLCPP_WARN_THROTTLE(
+      m_logger, m_clock, CLOCK_1_SEC,
+      "Received invalid wiper value from NE Raptor DBW.");
   }
 
   state_report().stamp = msg->header.stamp;
+  notify_state_update();
 }
 
 void NERaptorInterface::on_steering_report(const SteeringReport::SharedPtr & msg)
 {
   /* Steering -> tire angle conversion is linear except for extreme angles */
-  const float32_t f_wheel_angle_rad = (msg->steering_wheel_angle * DEGREES_TO_RADIANS) /
-    m_steer_to_tire_ratio;
+  const float32_t f_wheel_angle_rad = m_steering_wheel_angle.decode(msg->steering_wheel_angle);
 
   odometry().front_wheel_angle_rad = f_wheel_angle_rad;
   odometry().rear_wheel_angle_rad = 0.0F;
@@ -696,6 +632,7 @@ void NERaptorInterface::on_steering_report(const SteeringReport::SharedPtr & msg
 
   m_seen_steering_rpt = true;
   odometry().stamp = msg->header.stamp;
+  notify_state_update();
 }
 
 void NERaptorInterface::on_wheel_spd_report(const WheelSpeedReport::SharedPtr & msg)
@@ -14,8 +14,12 @@
 
 #include "ne_raptor_interface/test_ne_raptor_interface.hpp"
 #include <algorithm>
+#include <array>
+#include <iostream>
 #include <memory>
 
+using autoware::common::types::float64_t;
+
 /* Test the DBW Commands:
  * Autoware -> NE Raptor
  *
@@ -3454,3 +3458,51 @@ TEST_F(NERaptorInterfaceTest, TestKinematicBikeModel)
       "Test radius #" << std::to_string(i);
   }
 }
+
+/* Measure the throughput of translating commands,
+ * which does not publish anything */
+TEST_F(NERaptorInterfaceTest, TestCmdThroughput)
+{
+  constexpr uint32_t kNumIterations{100000U};
+  const std::array<uint8_t, 4U> gears{
+    VehicleStateCommand::GEAR_DRIVE, VehicleStateCommand::GEAR_REVERSE,
+    VehicleStateCommand::GEAR_PARK, VehicleStateCommand::GEAR_NEUTRAL};
+  const std::array<uint8_t, 4U> blinkers{
+    VehicleStateCommand::BLINKER_OFF, VehicleStateCommand::BLINKER_LEFT,
+    VehicleStateCommand::BLINKER_RIGHT, VehicleStateCommand::BLINKER_HAZARD};
+  const std::array<uint8_t, 3U> headlights{
+    HeadlightsCommand::DISABLE, HeadlightsCommand::ENABLE_LOW, HeadlightsCommand::ENABLE_HIGH};
+  const std::array<uint8_t, 4U> wipers{
+    WipersCommand::DISABLE, WipersCommand::ENABLE_LOW, WipersCommand::ENABLE_HIGH,
+    WipersCommand::ENABLE_CLEAN};
+
+  VehicleStateCommand vsc{};
+  VehicleControlCommand vcc{};
+  HeadlightsCommand hc{};
+  WipersCommand wc{};
+  uint32_t num_failures{0U};
+
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0U; i < kNumIterations; ++i) {
+    vsc.gear = gears[i % gears.size()];
+    vsc.blinker = blinkers[i % blinkers.size()];
+    hc.command = headlights[i % headlights.size()];
+    wc.command = wipers[i % wipers.size()];
+    vcc.front_wheel_angle_rad = 0.001F * static_cast<float32_t>(i % 100U);
+    if (!ne_raptor_interface_->send_state_command(vsc)) {
+      ++num_failures;
+    }
+    ne_raptor_interface_->send_headlights_command(hc);
+    ne_raptor_interface_->send_wipers_command(wc);
+    if (!ne_raptor_interface_->send_control_command(vcc)) {
+      ++num_failures;
+    }
+  }
+  const auto diff = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(num_failures, 0U);
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count();
+  std::cout << "Translated " << kNumIterations << " sets of commands in " <<
+    (static_cast<float64_t>(ns) / 1.0e6) << " ms, " <<
+    (static_cast<float64_t>(ns) / kNumIterations) << " ns per set\n";
+}
@@ -49,6 +49,12 @@ public:
   using ImageCallbackFunction = std::function<void (
         std::uint32_t,
         std::unique_ptr<sensor_msgs::msg::Image>)>;
+  /// A typedef for the callback function used to lend a reused image message to the user.
+  /// The message is owned by the camera and is overwritten by the next image, so it must not be
+  /// used after the callback returns.
+  using ReusedImageCallbackFunction = std::function<void (
+        std::uint32_t,
+        const sensor_msgs::msg::Image &)>;
 
   /// Construct a camera that wraps the spinnaker camera pointer.
   explicit CameraWrapper(
@@ -91,11 +97,25 @@ public:
   /// Set the callback function called upon image arrival from the SDK.
   void set_on_image_callback(ImageCallbackFunction callback);
 
+  /// Set the callback function called upon image arrival from the SDK with a message that is
+  /// reused for every image of this camera. This avoids allocating a new message and its buffer
+  /// for every image. Replaces a callback set with set_on_image_callback.
+  void set_on_reused_image_callback(ReusedImageCallbackFunction callback);
+
 private:
   /// Convert Spinnaker image to image message.
   static std::unique_ptr<sensor_msgs::msg::Image> convert_to_image_msg(
     const Spinnaker::ImagePtr & image, const std::string & frame_id);
 
+  /// Fill an image message with a Spinnaker image, reusing the buffer of the message.
+  /// \return false if the image is incomplete, in which case the message is not changed.
+  static bool fill_image_msg(
+    const Spinnaker::ImagePtr & image, const std::string & frame_id,
+    sensor_msgs::msg::Image & msg);
+
+  /// Register the event handling for this camera if no callback was set yet.
+  void register_event_handler();
+
   /// Convert a configuration string to Spinnaker PixelFormat enum.
   static Spinnaker::PixelFormatEnums convert_to_pixel_format_enum(const std::string & pixel_format);
   /// Convert Spinnaker PixelFormat enum to string.
@@ -114,6 +134,10 @@ private:
 
   /// A callback that the user can set to receive an image message when a new image is available.
   ImageCallbackFunction m_on_image_callback{};
+  /// A callback that the user can set to be lent the reused image message instead.
+  ReusedImageCallbackFunction m_on_reused_image_callback{};
+  /// The message that is reused for every image when m_on_reused_image_callback is set.
+  sensor_msgs::msg::Image m_image_msg{};
 };
 
 }  //  namespace spinnaker
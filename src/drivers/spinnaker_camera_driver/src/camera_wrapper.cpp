@@ -58,7 +58,7 @@ CameraWrapper::CameraWrapper(
 
 CameraWrapper::~CameraWrapper()
 {
-  if (m_on_image_callback) {
+  if (m_on_image_callback || m_on_reused_image_callback) {
     m_camera->UnregisterEventHandler(*this);
   }
   if (m_camera->IsStreaming()) {
@@ -72,12 +72,19 @@ void CameraWrapper::OnImageEvent(Spinnaker::ImagePtr image)
   if (m_on_image_callback) {
     m_on_image_callback(m_camera_index, convert_to_image_msg(image, m_frame_id));
     image->Release();
+  } else if (m_on_reused_image_callback) {
+    const bool is_complete = fill_image_msg(image, m_frame_id, m_image_msg);
+    // The Spinnaker buffer can be given back as soon as its data is copied.
+    image->Release();
+    if (is_complete) {
+      m_on_reused_image_callback(m_camera_index, m_image_msg);
+    }
   }
 }
 
 std::unique_ptr<sensor_msgs::msg::Image> CameraWrapper::retreive_image() const
 {
-  if (m_on_image_callback) {
+  if (m_on_image_callback || m_on_reused_image_callback) {
     throw std::logic_error("A callback is set, please use it to retreive images.");
   }
   auto image = m_camera->GetNextImage();
@@ -103,42 +110,63 @@ void CameraWrapper::stop_capturing()
 
 void CameraWrapper::set_on_image_callback(ImageCallbackFunction callback)
 {
-  if (!m_on_image_callback) {
+  register_event_handler();
+  m_on_reused_image_callback = nullptr;
+  m_on_image_callback = callback;
+}
+
+void CameraWrapper::set_on_reused_image_callback(ReusedImageCallbackFunction callback)
+{
+  register_event_handler();
+  m_on_image_callback = nullptr;
+  m_on_reused_image_callback = callback;
+}
+
+void CameraWrapper::register_event_handler()
+{
+  if (!m_on_image_callback && !m_on_reused_image_callback) {
     // This is the first time we are setting a callback so we want to register
     // event handling for this camera.
     m_camera->RegisterEventHandler(*this);
   }
-  m_on_image_callback = callback;
 }
 
 std::unique_ptr<sensor_msgs::msg::Image> CameraWrapper::convert_to_image_msg(
   const Spinnaker::ImagePtr & image, const std::string & frame_id)
+{
+  auto msg{std::make_unique<sensor_msgs::msg::Image>()};
+  if (!fill_image_msg(image, frame_id, *msg)) {
+    return nullptr;
+  }
+  return msg;
+}
+
+bool CameraWrapper::fill_image_msg(
+  const Spinnaker::ImagePtr & image, const std::string & frame_id,
+  sensor_msgs::msg::Image & msg)
 {
   if (image->IsIncomplete()) {
     std::cerr << "Received an incomplete image. Skipping." << std::endl;
-    return nullptr;
+    return false;
   }
   auto acquisition_time = image->GetTimeStamp();
 
-  const std::string encoding_pattern = convert_to_pixel_format_string(image->GetPixelFormat());
   const auto seconds = acquisition_time / kNanoSecondsInSecond;
-  std_msgs::msg::Header header;
-  header.stamp.sec = static_cast<std::int32_t>(seconds);
-  header.stamp.nanosec = static_cast<std::uint32_t>(acquisition_time - seconds);
-  header.frame_id = frame_id;
-
-  auto msg{std::make_unique<sensor_msgs::msg::Image>()};
-  msg->header = header;
-  msg->height = static_cast<std::uint32_t>(image->GetHeight());
-  msg->width = static_cast<std::uint32_t>(image->GetWidth());
-  msg->encoding = encoding_pattern;
-  msg->step = static_cast<std::uint32_t>(image->GetStride());
-
+  msg.header.stamp.sec = static_cast<std::int32_t>(seconds);
+  msg.header.stamp.nanosec =
+    static_cast<std::uint32_t>(acquisition_time - (seconds * kNanoSecondsInSecond));
+  msg.header.frame_id = frame_id;
+  msg.height = static_cast<std::uint32_t>(image->GetHeight());
+  msg.width = static_cast<std::uint32_t>(image->GetWidth());
+  msg.encoding = convert_to_pixel_format_string(image->GetPixelFormat());
+  msg.step = static_cast<std::uint32_t>(image->GetStride());
+
+  // Unlike resizing and copying, assigning does not zero the buffer first, and it does not
+  // reallocate a buffer that is reused for an image of the same size.
   const size_t image_size = image->GetImageSize();
-  msg->data.resize(static_cast<std::uint32_t>(image_size));
-  std::copy_n(static_cast<std::uint8_t *>(
-      image->GetData()), image_size, msg->data.data());
-  return msg;
+  const auto data = static_cast<const std::uint8_t *>(image->GetData());
+  msg.data.assign(data, data + image_size);
+  return true;
 }
 
 Spinnaker::PixelFormatEnums CameraWrapper::convert_to_pixel_format_enum(
@@ -52,6 +52,12 @@ private:
     std::uint32_t camera_index,
     std::unique_ptr<sensor_msgs::msg::Image> image);
 
+  /// This funciton is called to publish an image message that the camera reuses for the next
+  /// image. The message is published by reference, so it stays with the camera.
+  SPINNAKER_CAMERA_NODES_LOCAL void publish_reused_image(
+    std::uint32_t camera_index,
+    const sensor_msgs::msg::Image & image);
+
   /// Helper function to parse camera-related params and create cameras from them.
   SPINNAKER_CAMERA_NODES_LOCAL spinnaker::CameraListWrapper & create_cameras_from_params(
     spinnaker::SystemWrapper * spinnaker_wrapper);
@@ -76,6 +82,8 @@ public:
   void set_publisher(PublisherT::SharedPtr publisher);
   /// Publish an image.
   void publish(std::unique_ptr<sensor_msgs::msg::Image> image);
+  /// Publish an image by reference, without taking ownership of it.
+  void publish(const sensor_msgs::msg::Image & image);
 
 private:
   std::mutex m_publish_mutex{};
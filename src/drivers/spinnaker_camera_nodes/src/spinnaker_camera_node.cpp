@@ -71,8 +71,14 @@ SpinnakerCameraNode::SpinnakerCameraNode(
     // TODO(igor): this should really be a terminate. It is a post-condition violation.
     throw std::runtime_error("No publishers created. Cannot start node.");
   }
-  cameras.set_image_callback(std::bind(
-      &SpinnakerCameraNode::publish_image, this, std::placeholders::_1, std::placeholders::_2));
+  if (declare_parameter("reuse_image_messages", false)) {
+    cameras.set_reused_image_callback(std::bind(
+        &SpinnakerCameraNode::publish_reused_image, this, std::placeholders::_1,
+        std::placeholders::_2));
+  } else {
+    cameras.set_image_callback(std::bind(
+        &SpinnakerCameraNode::publish_image, this, std::placeholders::_1, std::placeholders::_2));
+  }
   cameras.start_capturing();
 }
 
@@ -158,6 +164,14 @@ void SpinnakerCameraNode::publish_image(
   }
 }
 
+void SpinnakerCameraNode::publish_reused_image(
+  std::uint32_t camera_index,
+  const sensor_msgs::msg::Image & image)
+{
+  const auto publisher_index = m_use_publisher_per_camera ? camera_index : 0UL;
+  m_publishers.at(publisher_index).publish(image);
+}
+
 void SpinnakerCameraNode::ProtectedPublisher::set_publisher(PublisherT::SharedPtr publisher)
 {
   m_publisher = publisher;
@@ -176,6 +190,16 @@ void SpinnakerCameraNode::ProtectedPublisher::publish(
   }
 }
 
+void SpinnakerCameraNode::ProtectedPublisher::publish(const sensor_msgs::msg::Image & image)
+{
+  if (m_publisher) {
+    const std::lock_guard<std::mutex> lock{m_publish_mutex};
+    m_publisher->publish(image);
+  } else {
+    throw std::runtime_error("Publisher is nullptr, cannot publish.");
+  }
+}
+
 }  // namespace camera
 }  // namespace drivers
 }  // namespace autoware
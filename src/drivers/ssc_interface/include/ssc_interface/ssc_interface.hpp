@@ -79,6 +79,28 @@ namespace ssc_interface
 
 static constexpr float32_t STEERING_TO_TIRE_RATIO = 0.533F / 8.6F;
 
+/// \brief Decides when a command needs to be published to the SSC: whenever it changes, and
+///   once per keep-alive period while it does not, so that the SSC does not time out on it
+class SSC_INTERFACE_PUBLIC CommandCoalescer
+{
+public:
+  /// \brief Constructor
+  /// \param[in] keep_alive_period Maximum time between two publications of an unchanged
+  ///   command, zero to publish each command
+  explicit CommandCoalescer(std::chrono::nanoseconds keep_alive_period) noexcept;
+
+  /// \brief Decide whether to publish a command, and remember it as published if so
+  /// \param[in] changed Whether the command differs from the last published one
+  /// \param[in] now Time of the command
+  /// \return True if the command needs to be published
+  bool8_t should_publish(bool8_t changed, std::chrono::nanoseconds now) noexcept;
+
+private:
+  std::chrono::nanoseconds m_keep_alive_period;
+  std::chrono::nanoseconds m_last_publish_time{};
+  bool8_t m_published{false};
+};
+
 /// \brief Class for interfacing with AS SSC
 class SSC_INTERFACE_PUBLIC SscInterface
   : public ::autoware::drivers::vehicle_interface::PlatformInterface
@@ -91,13 +113,16 @@ public:
   /// \param[in] max_accel_mps2 Maximum acceleration in m/s^2
   /// \param[in] max_decel_mps2 Maximum deceleration in m/s^2
   /// \param[in] max_yaw_rate_rad Maximum rate of change of heading in radians/sec
+  /// \param[in] keep_alive_period If nonzero, unchanged commands are only published to the SSC
+  ///   once per this period instead of each time
   explicit SscInterface(
     rclcpp::Node & node,
     float32_t front_axle_to_cog,
     float32_t rear_axle_to_cog,
     float32_t max_accel_mps2,
     float32_t max_decel_mps2,
-    float32_t max_yaw_rate_rad
+    float32_t max_yaw_rate_rad,
+    std::chrono::nanoseconds keep_alive_period = std::chrono::nanoseconds::zero()
   );
   /// \brief Default destructor
   ~SscInterface() noexcept override = default;
@@ -151,13 +176,27 @@ private:
     m_steer_sub;
 
   rclcpp::Logger m_logger;
+  rclcpp::Clock::SharedPtr m_clock;
   float32_t m_front_axle_to_cog;
   float32_t m_rear_axle_to_cog;
+  // Precomputed for the conversions between wheel angle and curvature
+  float32_t m_wheelbase;
+  float32_t m_inv_wheelbase;
   float32_t m_accel_limit;
   float32_t m_decel_limit;
   float32_t m_max_yaw_rate;
   std::unique_ptr<DbwStateMachine> m_dbw_state_machine;
 
+  // Last published commands, to only publish changes and keep-alives
+  CommandCoalescer m_gear_coalescer;
+  CommandCoalescer m_speed_coalescer;
+  CommandCoalescer m_steer_coalescer;
+  CommandCoalescer m_turn_signal_coalescer;
+  GearCommand m_gear_cmd{};
+  SpeedMode m_speed_cmd{};
+  SteerMode m_steer_cmd{};
+  TurnSignalCommand m_turn_signal_cmd{};
+
   // The vehicle kinematic state is stored because it needs information from
   // both on_steer_report() and on_vel_accel_report().
   VehicleKinematicState m_vehicle_kinematic_state;
@@ -17,31 +17,104 @@
 #include <automotive_platform_msgs/msg/gear.hpp>
 #include <rclcpp/logging.hpp>
 #include <time_utils/time_utils.hpp>
+#include <vehicle_interface/signal_table.hpp>
 
 #include <cmath>
 #include <stdexcept>
 
 using SscGear = automotive_platform_msgs::msg::Gear;
+using autoware::drivers::vehicle_interface::EnumTable;
 
 namespace ssc_interface
 {
 
+namespace
+{
+constexpr EnumTable<uint8_t> kGearCmdTable{
+  {VehicleStateCommand::GEAR_DRIVE, SscGear::DRIVE},
+  {VehicleStateCommand::GEAR_REVERSE, SscGear::REVERSE},
+  {VehicleStateCommand::GEAR_PARK, SscGear::PARK},
+  {VehicleStateCommand::GEAR_LOW, SscGear::LOW},
+  {VehicleStateCommand::GEAR_NEUTRAL, SscGear::NEUTRAL}};
+constexpr EnumTable<uint8_t> kGearRptTable{
+  {SscGear::PARK, VehicleStateReport::GEAR_PARK},
+  {SscGear::REVERSE, VehicleStateReport::GEAR_REVERSE},
+  {SscGear::NEUTRAL, VehicleStateReport::GEAR_NEUTRAL},
+  {SscGear::DRIVE, VehicleStateReport::GEAR_DRIVE},
+  {SscGear::LOW, VehicleStateReport::GEAR_LOW}};
+
+// Commands are compared without their header, which only differs by its stamp
+bool8_t same_command(const TurnSignalCommand & lhs, const TurnSignalCommand & rhs) noexcept
+{
+  return (lhs.mode == rhs.mode) && (lhs.turn_signal == rhs.turn_signal);
+}
+
+bool8_t same_command(const GearCommand & lhs, const GearCommand & rhs) noexcept
+{
+  return lhs.command.gear == rhs.command.gear;
+}
+
+bool8_t same_command(const SpeedMode & lhs, const SpeedMode & rhs) noexcept
+{
+  return (lhs.mode == rhs.mode) && (lhs.speed == rhs.speed) &&
+         (lhs.acceleration_limit == rhs.acceleration_limit) &&
+         (lhs.deceleration_limit == rhs.deceleration_limit);
+}
+
+bool8_t same_command(const SteerMode & lhs, const SteerMode & rhs) noexcept
+{
+  return (lhs.mode == rhs.mode) && (lhs.curvature == rhs.curvature) &&
+         (lhs.max_curvature_rate == rhs.max_curvature_rate);
+}
+}  // namespace
+
+CommandCoalescer::CommandCoalescer(const std::chrono::nanoseconds keep_alive_period) noexcept
+: m_keep_alive_period{keep_alive_period}
+{
+}
+
+bool8_t CommandCoalescer::should_publish(
+  const bool8_t changed, const std::chrono::nanoseconds now) noexcept
+{
+  // A clock going backwards, e.g. on a restart of a simulation, also publishes
+  if ((m_keep_alive_period == std::chrono::nanoseconds::zero()) || !m_published || changed ||
+    (now < m_last_publish_time) || ((now - m_last_publish_time) >= m_keep_alive_period))
+  {
+    m_last_publish_time = now;
+    m_published = true;
+    return true;
+  }
+  return false;
+}
+
 SscInterface::SscInterface(
   rclcpp::Node & node,
   float32_t front_axle_to_cog,
   float32_t rear_axle_to_cog,
   float32_t max_accel_mps2,
   float32_t max_decel_mps2,
-  float32_t max_yaw_rate_rad
+  float32_t max_yaw_rate_rad,
+  std::chrono::nanoseconds keep_alive_period
 )
 : m_logger{node.get_logger()},
+  m_clock{node.get_clock()},
   m_front_axle_to_cog{front_axle_to_cog},
   m_rear_axle_to_cog{rear_axle_to_cog},
+  m_wheelbase{front_axle_to_cog + rear_axle_to_cog},
+  m_inv_wheelbase{1.0F / (front_axle_to_cog + rear_axle_to_cog)},
   m_accel_limit{max_accel_mps2},
   m_decel_limit{max_decel_mps2},
   m_max_yaw_rate{max_yaw_rate_rad},
-  m_dbw_state_machine(new DbwStateMachine{3})
+  m_dbw_state_machine(new DbwStateMachine{3}),
+  m_gear_coalescer{keep_alive_period},
+  m_speed_coalescer{keep_alive_period},
+  m_steer_coalescer{keep_alive_period},
+  m_turn_signal_coalescer{keep_alive_period}
 {
+  if (keep_alive_period < std::chrono::nanoseconds::zero()) {
+    throw std::domain_error{"Keep-alive period of the SSC commands must not be negative"};
+  }
+
   // Publishers (to SSC)
   m_gear_cmd_pub = node.create_publisher<GearCommand>("gear_select", 10);
   m_speed_cmd_pub = node.create_publisher<SpeedMode>("arbitrated_speed_commands", 10);
@@ -80,6 +153,8 @@ bool8_t SscInterface::update(std::chrono::nanoseconds timeout)
 
 bool8_t SscInterface::send_state_command(const VehicleStateCommand & msg)
 {
+  const std::chrono::nanoseconds now{m_clock->now().nanoseconds()};
+
   // Turn signal command
   TurnSignalCommand tsc;
   tsc.mode = m_dbw_state_machine->enabled() ? 1 : 0;
@@ -110,7 +185,10 @@ bool8_t SscInterface::send_state_command(const VehicleStateCommand & msg)
   }
 
   tsc.header.stamp = msg.stamp;
-  m_turn_signal_cmd_pub->publish(tsc);
+  if (m_turn_signal_coalescer.should_publish(!same_command(tsc, m_turn_signal_cmd), now)) {
+    m_turn_signal_cmd = tsc;
+    m_turn_signal_cmd_pub->publish(m_turn_signal_cmd);
+  }
 
   // Gear command
   GearCommand gc;
@@ -118,30 +196,17 @@ bool8_t SscInterface::send_state_command(const VehicleStateCommand & msg)
   // other DBW system is enabled
   gc.command.gear = SscGear::NONE;
 
-  switch (msg.gear) {
-    case VehicleStateCommand::GEAR_NO_COMMAND:
-      break;
-    case VehicleStateCommand::GEAR_DRIVE:
-      gc.command.gear = SscGear::DRIVE;
-      break;
-    case VehicleStateCommand::GEAR_REVERSE:
-      gc.command.gear = SscGear::REVERSE;
-      break;
-    case VehicleStateCommand::GEAR_PARK:
-      gc.command.gear = SscGear::PARK;
-      break;
-    case VehicleStateCommand::GEAR_LOW:
-      gc.command.gear = SscGear::LOW;
-      break;
-    case VehicleStateCommand::GEAR_NEUTRAL:
-      gc.command.gear = SscGear::NEUTRAL;
-      break;
-    default:
-      RCLCPP_ERROR(m_logger, "Received command for invalid gear state.");
+  if ((msg.gear != VehicleStateCommand::GEAR_NO_COMMAND) &&
+    !kGearCmdTable.find(msg.gear, gc.command.gear))
+  {
+    RCLCPP_ERROR(m_logger, "Received command for invalid gear state.");
   }
 
   gc.header.stamp = msg.stamp;
-  m_gear_cmd_pub->publish(gc);
+  if (m_gear_coalescer.should_publish(!same_command(gc, m_gear_cmd), now)) {
+    m_gear_cmd = gc;
+    m_gear_cmd_pub->publish(m_gear_cmd);
+  }
 
   m_dbw_state_machine->state_cmd_sent();
 
@@ -161,6 +226,7 @@ bool8_t SscInterface::send_control_command(const HighLevelControlCommand & msg)
   } else {
     desired_velocity = std::fabs(msg.velocity_mps);
   }
+  const std::chrono::nanoseconds now{m_clock->now().nanoseconds()};
 
   // Publish speed command
   SpeedMode speed_mode;
@@ -169,7 +235,10 @@ bool8_t SscInterface::send_control_command(const HighLevelControlCommand & msg)
   speed_mode.acceleration_limit = m_accel_limit;
   speed_mode.deceleration_limit = m_decel_limit;
   speed_mode.header.stamp = msg.stamp;
-  m_speed_cmd_pub->publish(speed_mode);
+  if (m_speed_coalescer.should_publish(!same_command(speed_mode, m_speed_cmd), now)) {
+    m_speed_cmd = speed_mode;
+    m_speed_cmd_pub->publish(m_speed_cmd);
+  }
 
   // Publish steering command
   SteerMode steer_mode;
@@ -178,7 +247,10 @@ bool8_t SscInterface::send_control_command(const HighLevelControlCommand & msg)
   steer_mode.curvature = msg.curvature;
   steer_mode.max_curvature_rate = curvature_rate;  // should be positive
   steer_mode.header.stamp = msg.stamp;
-  m_steer_cmd_pub->publish(steer_mode);
+  if (m_steer_coalescer.should_publish(!same_command(steer_mode, m_steer_cmd), now)) {
+    m_steer_cmd = steer_mode;
+    m_steer_cmd_pub->publish(m_steer_cmd);
+  }
 
   m_dbw_state_machine->control_cmd_sent();
 
@@ -200,18 +272,16 @@ bool8_t SscInterface::send_control_command(const VehicleControlCommand & msg)
     signed_velocity = -msg.velocity_mps;
   }
 
-  const auto wheelbase = m_front_axle_to_cog + m_rear_axle_to_cog;
-
   HighLevelControlCommand hlc_cmd;
   hlc_cmd.stamp = msg.stamp;
 
-  // Convert from center-of-mass velocity to rear-axle-center velocity
-  const auto beta =
-    std::atan(m_front_axle_to_cog * std::tan(msg.front_wheel_angle_rad) / (wheelbase));
-  hlc_cmd.velocity_mps = std::cos(beta) * signed_velocity;
-
   // Calculate curvature from desired steering angle
-  hlc_cmd.curvature = std::tan(msg.front_wheel_angle_rad) / (wheelbase);
+  hlc_cmd.curvature = std::tan(msg.front_wheel_angle_rad) * m_inv_wheelbase;
+
+  // Convert from center-of-mass velocity to rear-axle-center velocity, with
+  // cos(beta) = 1 / sqrt(1 + tan(beta)^2) and tan(beta) = front_axle_to_cog * curvature
+  const auto tan_beta = m_front_axle_to_cog * hlc_cmd.curvature;
+  hlc_cmd.velocity_mps = signed_velocity / std::sqrt(1.0F + (tan_beta * tan_beta));
 
   return send_control_command(hlc_cmd);
 }
@@ -239,31 +309,16 @@ void SscInterface::on_dbw_state_report(const std_msgs::msg::Bool::SharedPtr & ms
   }
 
   m_dbw_state_machine->dbw_feedback(msg->data);
+  notify_state_update();
 }
 
 void SscInterface::on_gear_report(const GearFeedback::SharedPtr & msg)
 {
-  switch (msg->current_gear.gear) {
-    case SscGear::PARK:
-      state_report().gear = VehicleStateReport::GEAR_PARK;
-      break;
-    case SscGear::REVERSE:
-      state_report().gear = VehicleStateReport::GEAR_REVERSE;
-      break;
-    case SscGear::NEUTRAL:
-      state_report().gear = VehicleStateReport::GEAR_NEUTRAL;
-      break;
-    case SscGear::DRIVE:
-      state_report().gear = VehicleStateReport::GEAR_DRIVE;
-      break;
-    case SscGear::LOW:
-      state_report().gear = VehicleStateReport::GEAR_LOW;
-      break;
-    case SscGear::NONE:
-    default:
-      state_report().gear = 0;
-      RCLCPP_WARN(m_logger, "Received invalid gear value from SSC.");
+  if (!kGearRptTable.find(msg->current_gear.gear, state_report().gear)) {
+    state_report().gear = 0;
+    RCLCPP_WARN(m_logger, "Received invalid gear value from SSC.");
   }
+  notify_state_update();
 }
 
 void SscInterface::on_steer_report(const SteeringFeedback::SharedPtr & msg)
@@ -272,6 +327,7 @@ void SscInterface::on_steer_report(const SteeringFeedback::SharedPtr & msg)
   odometry().stamp = msg->header.stamp;
   odometry().front_wheel_angle_rad = front_wheel_angle_rad;
   odometry().rear_wheel_angle_rad = 0.0F;
+  notify_state_update();
 
   std::lock_guard<std::mutex> guard(m_vehicle_kinematic_state_mutex);
   m_vehicle_kinematic_state.state.front_wheel_angle_rad = front_wheel_angle_rad;
@@ -282,18 +338,18 @@ void SscInterface::on_vel_accel_report(const VelocityAccelCov::SharedPtr & msg)
 {
   odometry().stamp = msg->header.stamp;
   odometry().velocity_mps = msg->velocity;
+  notify_state_update();
 
   std::lock_guard<std::mutex> guard(m_vehicle_kinematic_state_mutex);
   // Input velocity is (assumed to be) measured at the rear axle, but we're
   // producing a velocity at the center of gravity.
   // Lateral velocity increases linearly from 0 at the rear axle to the maximum
   // at the front axle, where it is tan(δ)*v_lon.
-  const float32_t wheelbase = m_rear_axle_to_cog + m_front_axle_to_cog;
-  const float32_t delta = m_vehicle_kinematic_state.state.front_wheel_angle_rad;
+  const float32_t tan_delta = std::tan(m_vehicle_kinematic_state.state.front_wheel_angle_rad);
   m_vehicle_kinematic_state.header.frame_id = "odom";
   m_vehicle_kinematic_state.state.longitudinal_velocity_mps = msg->velocity;
-  m_vehicle_kinematic_state.state.lateral_velocity_mps = (m_rear_axle_to_cog / wheelbase) *
-    msg->velocity * std::tan(delta);
+  m_vehicle_kinematic_state.state.lateral_velocity_mps = (m_rear_axle_to_cog * m_inv_wheelbase) *
+    msg->velocity * tan_delta;
   m_vehicle_kinematic_state.state.acceleration_mps2 = msg->accleration;
   // Dt can not be calculated from the first message alone
   if (!m_seen_vel_accel) {
@@ -321,8 +377,9 @@ void SscInterface::on_vel_accel_report(const VelocityAccelCov::SharedPtr & msg)
     m_vehicle_kinematic_state.state.y = 0.0F;
     m_vehicle_kinematic_state.state.heading.real = std::cos(/*yaw*/ 0.0F / 2.0F);
     m_vehicle_kinematic_state.state.heading.imag = std::sin(/*yaw*/ 0.0F / 2.0F);
-    const float32_t beta = std::atan2(m_rear_axle_to_cog * std::tan(delta), wheelbase);
-    m_vehicle_kinematic_state.state.heading_rate_rps = std::cos(beta) * std::tan(delta) / wheelbase;
+    // cos(beta) * tan(delta) / wheelbase, where beta = atan2(l_r * tan(delta), wheelbase)
+    m_vehicle_kinematic_state.state.heading_rate_rps =
+      tan_delta / std::hypot(m_wheelbase, m_rear_axle_to_cog * tan_delta);
     m_kinematic_state_pub->publish(m_vehicle_kinematic_state);
   }
 }
@@ -17,6 +17,7 @@
 
 #include <common/types.hpp>
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -41,7 +42,8 @@ SscInterfaceNode::SscInterfaceNode(const rclcpp::NodeOptions & options)
       declare_parameter("ssc.rear_axle_to_cog").get<float32_t>(),
       get_state_machine().get_config().accel_limits().max(),
       get_state_machine().get_config().accel_limits().min(),
-      declare_parameter("ssc.max_yaw_rate").get<float32_t>()
+      declare_parameter("ssc.max_yaw_rate").get<float32_t>(),
+      std::chrono::milliseconds{declare_parameter("ssc.keep_alive_period_ms", 0)}
   ));
 }
 
@@ -16,6 +16,7 @@
 
 #include <autoware_auto_msgs/msg/vehicle_kinematic_state.hpp>
 
+#include <chrono>
 #include <cmath>
 #include <memory>
 #include <iostream>
@@ -102,3 +103,25 @@ TEST(TestSscInterface, TestConstantSteering) {
       "should be " << dist_squared << ", is " << radius_m_squared;
   }
 }
+
+TEST(TestSscInterface, TestCommandCoalescer) {
+  using std::chrono::milliseconds;
+  ssc_interface::CommandCoalescer each_command{milliseconds::zero()};
+  EXPECT_TRUE(each_command.should_publish(false, milliseconds{0}));
+  EXPECT_TRUE(each_command.should_publish(false, milliseconds{10}));
+
+  ssc_interface::CommandCoalescer coalescer{milliseconds{100}};
+  // The first command is always published, unchanged ones only once per keep-alive period
+  EXPECT_TRUE(coalescer.should_publish(false, milliseconds{0}));
+  EXPECT_FALSE(coalescer.should_publish(false, milliseconds{10}));
+  EXPECT_FALSE(coalescer.should_publish(false, milliseconds{99}));
+  EXPECT_TRUE(coalescer.should_publish(false, milliseconds{100}));
+  EXPECT_FALSE(coalescer.should_publish(false, milliseconds{150}));
+  // Changes are published right away, and restart the period
+  EXPECT_TRUE(coalescer.should_publish(true, milliseconds{160}));
+  EXPECT_FALSE(coalescer.should_publish(false, milliseconds{200}));
+  EXPECT_TRUE(coalescer.should_publish(false, milliseconds{260}));
+  // A clock going backwards publishes
+  EXPECT_TRUE(coalescer.should_publish(false, milliseconds{50}));
+  EXPECT_FALSE(coalescer.should_publish(false, milliseconds{60}));
+}
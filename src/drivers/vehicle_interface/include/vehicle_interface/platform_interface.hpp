@@ -36,6 +36,7 @@
 #include <vehicle_interface/visibility_control.hpp>
 
 #include <chrono>
+#include <functional>
 
 using autoware::common::types::bool8_t;
 
@@ -68,6 +69,9 @@ namespace vehicle_interface
 class VEHICLE_INTERFACE_PUBLIC PlatformInterface
 {
 public:
+  /// Callback which is called by the implementation when new data was received
+  using StateUpdateCallback = std::function<void ()>;
+
   /// Constructor
   PlatformInterface() = default;
   /// Destructor
@@ -148,7 +152,19 @@ public:
   /// \param[in] msg The control command to send to the vehicle.
   virtual void send_hazard_lights_command(const HazardLightsCommand & msg);
 
+  /// \brief Set the callback to call when the implementation received new data from the
+  /// vehicle platform. This is used by the VehicleInterfaceNode in event driven mode, where the
+  /// reports are published as soon as they are updated instead of after each call to update.
+  /// \param[in] callback The callback, or an empty function to remove it
+  void set_state_update_callback(StateUpdateCallback callback);
+
 protected:
+  /// \brief Notify the VehicleInterfaceNode that the state report, odometry or feature reports
+  /// were updated with data from the vehicle platform. Implementations which receive data
+  /// asynchronously, e.g. in subscription callbacks, should call this after each update. It must
+  /// be called from a callback of the executor that also spins the VehicleInterfaceNode, and
+  /// without holding locks that sending a command takes.
+  void notify_state_update();
   /// Get the underlying state report for modification
   VehicleStateReport & state_report() noexcept;
   /// Get the underlying odometry for modification
@@ -166,6 +182,7 @@ private:
   WipersReport m_wipers_report{};
   VehicleStateReport m_state_report{};
   VehicleOdometry m_odometry{};
+  StateUpdateCallback m_state_update_callback{};
 };  // class PlatformInterface
 }  // namespace vehicle_interface
 }  // namespace drivers
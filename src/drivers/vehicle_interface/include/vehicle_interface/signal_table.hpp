@@ -0,0 +1,127 @@
+// Copyright 2020 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+/// \file
+/// \brief Lookup tables for translating enumerated and scaled signals of vehicle platforms
+#ifndef VEHICLE_INTERFACE__SIGNAL_TABLE_HPP_
+#define VEHICLE_INTERFACE__SIGNAL_TABLE_HPP_
+
+#include <common/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace autoware
+{
+namespace drivers
+{
+namespace vehicle_interface
+{
+
+using autoware::common::types::bool8_t;
+using autoware::common::types::float32_t;
+
+/// Table which maps the values of an enumerated signal, e.g. the gear or the turn signal state of a
+/// drive-by-wire message, to the values of another representation. The table covers all values of
+/// a byte, so that a lookup is a single array access instead of a chain of branches.
+/// \tparam ValueT The type of the mapped values, which must be a literal type
+template<typename ValueT>
+class EnumTable
+{
+public:
+  static constexpr std::size_t SIZE = 256U;
+
+  struct Entry
+  {
+    uint8_t key;
+    ValueT value;
+  };
+
+  /// Constructor
+  /// \param[in] entries The mapped values, each key may only appear once
+  /// \throw std::domain_error If a key appears more than once
+  constexpr EnumTable(std::initializer_list<Entry> entries)
+  : m_values{}, m_valid{}
+  {
+    for (const auto & entry : entries) {
+      if (m_valid[entry.key]) {
+        throw std::domain_error{"EnumTable: duplicate key"};
+      }
+      m_values[entry.key] = entry.value;
+      m_valid[entry.key] = true;
+    }
+  }
+
+  /// Look up the value of a key
+  /// \param[in] key The key, e.g. a constant of a platform message
+  /// \param[out] value The mapped value, unchanged if the key is not in the table
+  /// \return True if the key is in the table, false otherwise
+  constexpr bool8_t find(const uint8_t key, ValueT & value) const noexcept
+  {
+    if (!m_valid[key]) {
+      return false;
+    }
+    value = m_values[key];
+    return true;
+  }
+
+private:
+  ValueT m_values[SIZE];
+  bool8_t m_valid[SIZE];
+};  // class EnumTable
+
+/// Linear conversion physical = raw * scale + offset between the raw value of a signal of a
+/// vehicle platform and its physical value. The inverse of the scale is computed once, so that
+/// neither direction divides.
+class LinearSignal
+{
+public:
+  /// Constructor
+  /// \param[in] scale The physical value of one raw unit, must not be zero
+  /// \param[in] offset The physical value of a raw value of zero
+  /// \throw std::domain_error If the scale is zero
+  constexpr LinearSignal(const float32_t scale, const float32_t offset)
+  : m_scale{scale},
+    m_inverse_scale{(scale != 0.0F) ? (1.0F / scale) :
+      throw std::domain_error{"LinearSignal: scale must not be zero"}},
+    m_offset{offset}
+  {
+  }
+
+  /// Convert a raw value to a physical value
+  constexpr float32_t decode(const float32_t raw) const noexcept
+  {
+    return (raw * m_scale) + m_offset;
+  }
+
+  /// Convert a physical value to a raw value
+  constexpr float32_t encode(const float32_t physical) const noexcept
+  {
+    return (physical - m_offset) * m_inverse_scale;
+  }
+
+private:
+  float32_t m_scale;
+  float32_t m_inverse_scale;
+  float32_t m_offset;
+};  // class LinearSignal
+
+}  // namespace vehicle_interface
+}  // namespace drivers
+}  // namespace autoware
+
+#endif  // VEHICLE_INTERFACE__SIGNAL_TABLE_HPP_
@@ -26,6 +26,7 @@
 #include <rclcpp/rclcpp.hpp>
 #include <reference_tracking_controller/reference_tracking_controller.hpp>
 #include <signal_filters/signal_filter.hpp>
+#include <time_utils/latency_histogram.hpp>
 
 #include <autoware_auto_msgs/msg/high_level_control_command.hpp>
 #include <autoware_auto_msgs/msg/raw_control_command.hpp>
@@ -34,6 +35,7 @@
 #include <autoware_auto_msgs/msg/vehicle_state_command.hpp>
 #include <autoware_auto_msgs/msg/vehicle_state_report.hpp>
 #include <autoware_auto_msgs/srv/autonomy_mode_change.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 
 #include <experimental/optional>
 #include <chrono>
@@ -98,6 +100,7 @@ protected:
   using FilterBasePtr = std::unique_ptr<common::signal_filters::FilterBase<Real>>;
   using ModeChangeRequest = autoware_auto_msgs::srv::AutonomyModeChange_Request;
   using ModeChangeResponse = autoware_auto_msgs::srv::AutonomyModeChange_Response;
+  using DiagnosticArray = diagnostic_msgs::msg::DiagnosticArray;
 
   struct VehicleFilter
   {
@@ -156,6 +159,14 @@ private:
   VEHICLE_INTERFACE_LOCAL void send_state_command(const MaybeStateCommand & maybe_command);
   // Read data from vehicle platform for time budget, publish data
   VEHICLE_INTERFACE_LOCAL void read_and_publish();
+  // Publish the reports of the vehicle platform and update the state machine with them
+  VEHICLE_INTERFACE_LOCAL void publish_and_update();
+  // Add the latencies of a command which was handled, and publish them periodically
+  VEHICLE_INTERFACE_LOCAL void add_command_latencies(
+    const builtin_interfaces::msg::Time & stamp,
+    const std::chrono::nanoseconds processing_time);
+  // Summarize the command latencies in a diagnostic message
+  VEHICLE_INTERFACE_LOCAL DiagnosticArray make_latency_diagnostics() const;
   // Core loop for different input commands. Specialized differently for each topic type
   template<typename T>
   VEHICLE_INTERFACE_LOCAL void on_command_message(const T & msg);
@@ -192,6 +203,22 @@ private:
   std::chrono::system_clock::time_point m_last_command_stamp{};
   std::chrono::nanoseconds m_cycle_time{};
   MaybeStateCommand m_last_state_command{};
+  // Publish reports when the platform interface notifies about new data instead of on the timer
+  bool8_t m_event_driven{false};
+
+  struct CommandLatencies
+  {
+    // From the stamp of a command to when it was sent to the vehicle platform
+    common::time_utils::LatencyHistogram age;
+    // From receiving a command to when it was sent to the vehicle platform
+    common::time_utils::LatencyHistogram processing;
+  };
+  // Latencies of the commands, null if diagnostics are disabled
+  std::unique_ptr<CommandLatencies> m_latencies{};
+  // Number of commands between two diagnostic messages
+  std::size_t m_diagnostics_period{1U};
+  std::size_t m_num_commands{0U};
+  rclcpp::Publisher<DiagnosticArray>::SharedPtr m_diagnostics_pub{nullptr};
 
   std::map<std::string, ViFeature> m_avail_features =
   {
@@ -18,6 +18,8 @@
 #include "autoware_auto_msgs/msg/headlights_command.hpp"
 #include "autoware_auto_msgs/msg/horn_command.hpp"
 
+#include <utility>
+
 namespace autoware
 {
 namespace drivers
@@ -106,6 +108,18 @@ void PlatformInterface::send_hazard_lights_command(
   throw std::runtime_error("HazardLightsCommand not supported by this vehicle interface");
 }
 
+void PlatformInterface::set_state_update_callback(StateUpdateCallback callback)
+{
+  m_state_update_callback = std::move(callback);
+}
+
+void PlatformInterface::notify_state_update()
+{
+  if (m_state_update_callback) {
+    m_state_update_callback();
+  }
+}
+
 }  // namespace vehicle_interface
 }  // namespace drivers
 }  // namespace autoware
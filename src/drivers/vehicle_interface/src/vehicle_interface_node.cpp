@@ -16,8 +16,10 @@
 #include <common/types.hpp>
 
 #include <signal_filters/filter_factory.hpp>
+#include <time_utils/probe_diagnostics.hpp>
 #include <time_utils/time_utils.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -116,6 +118,14 @@ VehicleInterfaceNode::VehicleInterfaceNode(
     }
   }
 
+  m_event_driven = declare_parameter("event_driven", false);
+  if (declare_parameter("diagnostics.enable", false)) {
+    m_latencies = std::make_unique<CommandLatencies>();
+    m_diagnostics_period =
+      static_cast<std::size_t>(std::max(declare_parameter("diagnostics.period_commands", 100), 1));
+    m_diagnostics_pub = create_publisher<DiagnosticArray>("diagnostics", rclcpp::QoS{10U});
+  }
+
   // Actually init
   init(
     topic_num_matches_from_param("control_command"),
@@ -145,6 +155,16 @@ void VehicleInterfaceNode::set_reference_tracker(ControllerBasePtr && controller
 void VehicleInterfaceNode::set_interface(std::unique_ptr<PlatformInterface> && interface) noexcept
 {
   m_interface = std::forward<std::unique_ptr<PlatformInterface>&&>(interface);
+  if (m_event_driven && m_interface) {
+    m_interface->set_state_update_callback(
+      [this]() {
+        try {
+          publish_and_update();
+        } catch (...) {
+          on_error(std::current_exception());
+        }
+      });
+  }
 }
 
 rclcpp::Logger VehicleInterfaceNode::logger() const noexcept {return get_logger();}
@@ -318,7 +338,11 @@ void VehicleInterfaceNode::init(
       using Ptr = typename decltype(t)::SharedPtr;
       return [this](Ptr msg) -> void {
                try {
+                 const auto start = std::chrono::steady_clock::now();
                  on_command_message(*msg);
+                 if (m_latencies) {
+                   add_command_latencies(msg->stamp, std::chrono::steady_clock::now() - start);
+                 }
                } catch (...) {
                  on_error(std::current_exception());
                }
@@ -420,6 +444,15 @@ void VehicleInterfaceNode::read_and_publish()
   if (!m_interface->update(m_cycle_time - std::chrono::milliseconds{2LL})) {
     on_read_timeout();
   }
+  // In event driven mode this happens whenever the platform interface notifies about new data
+  if (!m_event_driven) {
+    publish_and_update();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void VehicleInterfaceNode::publish_and_update()
+{
   // Publish data from interface
   m_odom_pub->publish(m_interface->get_odometry());
   m_state_pub->publish(m_interface->get_state_report());
@@ -440,6 +473,31 @@ void VehicleInterfaceNode::read_and_publish()
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void VehicleInterfaceNode::add_command_latencies(
+  const builtin_interfaces::msg::Time & stamp,
+  const std::chrono::nanoseconds processing_time)
+{
+  m_latencies->age.add(std::chrono::system_clock::now() - time_utils::from_message(stamp));
+  m_latencies->processing.add(processing_time);
+  if ((++m_num_commands % m_diagnostics_period) == 0U) {
+    m_diagnostics_pub->publish(make_latency_diagnostics());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+VehicleInterfaceNode::DiagnosticArray VehicleInterfaceNode::make_latency_diagnostics() const
+{
+  auto status = common::time_utils::make_latency_status(
+    std::string{get_name()} + ": command latencies", "vehicle_interface");
+  common::time_utils::add_latency_values("age", m_latencies->age, status);
+  common::time_utils::add_latency_values("processing", m_latencies->processing, status);
+  DiagnosticArray diagnostics;
+  diagnostics.header.stamp = now();
+  diagnostics.status.push_back(status);
+  return diagnostics;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void VehicleInterfaceNode::on_control_send_failure()
 {
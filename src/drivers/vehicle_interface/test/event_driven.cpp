@@ -0,0 +1,131 @@
+// Copyright 2020 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <gtest/gtest.h>
+
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "test_vi_node.hpp"
+
+using autoware_auto_msgs::msg::VehicleStateReport;
+using diagnostic_msgs::msg::DiagnosticArray;
+
+// In event driven mode, the reports are published when the platform interface has new data
+TEST_F(SanityChecks, EventDriven)
+{
+  rclcpp::NodeOptions options{};
+  options
+  .append_parameter_override("control_command", "raw")
+  .append_parameter_override("event_driven", true);
+
+  const auto vi_node = std::make_shared<TestVINode>(
+    "event_driven_vi_node", options, false);  // no failure
+
+  const auto sub_node = std::make_shared<rclcpp::Node>("event_driven_vi_sub_node");
+  auto num_reports{0};
+  const auto test_sub = sub_node->create_subscription<VehicleStateReport>(
+    "state_report_out", rclcpp::QoS{10},
+    [&num_reports](VehicleStateReport::SharedPtr) {++num_reports;});
+
+  // The timer still reads from the platform interface, but does not publish
+  constexpr auto max_iters{100};
+  auto count{0};
+  while (!vi_node->interface().update_called()) {
+    rclcpp::spin_some(vi_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds{10LL});
+    ++count;
+    if (count > max_iters) {
+      EXPECT_TRUE(false);  // soft fail
+      break;
+    }
+  }
+  for (auto i = 0; i < 10; ++i) {
+    rclcpp::spin_some(sub_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds{10LL});
+  }
+  EXPECT_EQ(num_reports, 0);
+
+  // New data is published right away
+  vi_node->interface().push_state_update();
+  count = 0;
+  while (num_reports == 0) {
+    rclcpp::spin_some(sub_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds{10LL});
+    ++count;
+    if (count > max_iters) {
+      EXPECT_TRUE(false);  // soft fail
+      break;
+    }
+  }
+  EXPECT_EQ(num_reports, 1);
+}
+
+// The latencies of the commands are published as diagnostics
+TEST_F(SanityChecks, CommandLatencyDiagnostics)
+{
+  rclcpp::NodeOptions options{};
+  options
+  .append_parameter_override("control_command", "raw")
+  .append_parameter_override("diagnostics.enable", true)
+  .append_parameter_override("diagnostics.period_commands", 1);
+
+  const auto vi_node = std::make_shared<TestVINode>(
+    "latency_vi_node", options, false);  // no failure
+
+  const auto test_node = std::make_shared<rclcpp::Node>("latency_vi_test_node");
+  const auto test_pub =
+    test_node->create_publisher<RawControlCommand>("raw_command", rclcpp::QoS{10});
+  DiagnosticArray diagnostics{};
+  auto received{false};
+  const auto test_sub = test_node->create_subscription<DiagnosticArray>(
+    "diagnostics", rclcpp::QoS{10},
+    [&diagnostics, &received](DiagnosticArray::SharedPtr msg) {
+      diagnostics = *msg;
+      received = true;
+    });
+
+  RawControlCommand msg{};
+  constexpr auto max_iters{100};
+  auto count{0};
+  while (!received) {
+    msg.stamp = vi_node->now();
+    test_pub->publish(msg);
+    rclcpp::spin_some(vi_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds{10LL});
+    rclcpp::spin_some(test_node);
+    ++count;
+    if (count > max_iters) {
+      EXPECT_TRUE(false);  // soft fail
+      break;
+    }
+  }
+  ASSERT_TRUE(received);
+  ASSERT_EQ(diagnostics.status.size(), 1U);
+  const auto & values = diagnostics.status[0U].values;
+  const auto has_key = [&values](const std::string & key) {
+      return std::any_of(
+        values.begin(), values.end(), [&key](const auto & value) {return value.key == key;});
+    };
+  EXPECT_TRUE(has_key("age.p99"));
+  EXPECT_TRUE(has_key("processing.p99"));
+}
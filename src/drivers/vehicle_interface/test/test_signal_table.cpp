@@ -0,0 +1,72 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "vehicle_interface/signal_table.hpp"
+
+using autoware::drivers::vehicle_interface::EnumTable;
+using autoware::drivers::vehicle_interface::LinearSignal;
+
+namespace
+{
+struct Pair
+{
+  uint8_t first;
+  uint8_t second;
+};
+
+constexpr EnumTable<uint8_t> kTable{{0U, 10U}, {3U, 30U}, {255U, 42U}};
+constexpr EnumTable<Pair> kPairTable{{{1U, {2U, 3U}}}};
+}  // namespace
+
+TEST(TestSignalTable, EnumTableFindsKeys) {
+  uint8_t value{0U};
+  ASSERT_TRUE(kTable.find(0U, value));
+  EXPECT_EQ(value, 10U);
+  ASSERT_TRUE(kTable.find(3U, value));
+  EXPECT_EQ(value, 30U);
+  ASSERT_TRUE(kTable.find(255U, value));
+  EXPECT_EQ(value, 42U);
+
+  Pair pair{};
+  ASSERT_TRUE(kPairTable.find(1U, pair));
+  EXPECT_EQ(pair.first, 2U);
+  EXPECT_EQ(pair.second, 3U);
+}
+
+TEST(TestSignalTable, EnumTableLeavesValueOfMissingKey) {
+  uint8_t value{7U};
+  EXPECT_FALSE(kTable.find(1U, value));
+  EXPECT_EQ(value, 7U);
+  EXPECT_FALSE(kTable.find(254U, value));
+  EXPECT_EQ(value, 7U);
+}
+
+TEST(TestSignalTable, EnumTableRejectsDuplicateKeys) {
+  EXPECT_THROW((EnumTable<uint8_t>{{1U, 1U}, {1U, 2U}}), std::domain_error);
+}
+
+TEST(TestSignalTable, LinearSignal) {
+  constexpr LinearSignal signal{0.5F, -1.0F};
+  EXPECT_FLOAT_EQ(signal.decode(0.0F), -1.0F);
+  EXPECT_FLOAT_EQ(signal.decode(4.0F), 1.0F);
+  EXPECT_FLOAT_EQ(signal.encode(1.0F), 4.0F);
+  EXPECT_FLOAT_EQ(signal.encode(signal.decode(-12.5F)), -12.5F);
+
+  EXPECT_THROW(LinearSignal(0.0F, 1.0F), std::domain_error);
+}
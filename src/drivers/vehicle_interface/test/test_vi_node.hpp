@@ -114,6 +114,8 @@ public:
   bool8_t raw_called() const noexcept {return m_raw_called;}
   bool8_t mode_change_called() const noexcept {return m_mode_change_called;}
   int32_t count() const noexcept {return m_count;}
+  /// Pretend that data was received from the vehicle platform
+  void push_state_update() {notify_state_update();}
 
 private:
   std::atomic<bool8_t> m_update_called{false};
@@ -168,6 +170,7 @@ public:
   }
 
   const FakeInterface & interface() const noexcept {return *m_interface;}
+  FakeInterface & interface() noexcept {return *m_interface;}
   bool8_t error_handler_called() const noexcept {return m_error_handler_called;}
   bool8_t control_handler_called() const noexcept {return m_control_send_error_handler_called;}
   bool8_t state_handler_called() const noexcept {return m_state_send_error_handler_called;}
@@ -239,7 +242,7 @@ public:
   }
 
 private:
-  const FakeInterface * m_interface;
+  FakeInterface * m_interface;
   bool8_t m_error_handler_called{false};
   bool8_t m_control_send_error_handler_called{false};
   bool8_t m_state_send_error_handler_called{false};
@@ -0,0 +1,87 @@
+// Copyright 2018-2020 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+/// \copyright Copyright 2021 the Autoware Foundation
+/// \file
+/// \brief This file defines the conversion of the points of a data block into cartesian points
+
+#ifndef VELODYNE_DRIVER__BLOCK_DECODER_HPP_
+#define VELODYNE_DRIVER__BLOCK_DECODER_HPP_
+
+#include <velodyne_driver/common.hpp>
+#include <array>
+#include <cstddef>
+
+namespace autoware
+{
+namespace drivers
+{
+namespace velodyne_driver
+{
+/// lookup table of a trigonometric function over all azimuth indices
+using TrigTable = std::array<float32_t, AZIMUTH_ROTATION_RESOLUTION>;
+
+/// \brief The polar coordinates of the points of one data block, one array per coordinate
+/// \tparam N Number of points in a block
+template<std::size_t N>
+struct PolarBlock
+{
+  /// index of the azimuth angle in lookup tables, less than AZIMUTH_ROTATION_RESOLUTION
+  std::array<uint32_t, N> azimuth_ind;
+  /// index of the altitude angle in lookup tables, less than AZIMUTH_ROTATION_RESOLUTION
+  std::array<uint32_t, N> altitude_ind;
+  /// distance in multiples of the distance resolution of the sensor, as stored in the packet
+  std::array<uint32_t, N> distance;
+};
+
+/// \brief The cartesian coordinates of the points of one data block, one array per coordinate
+/// \tparam N Number of points in a block
+template<std::size_t N>
+struct CartesianBlock
+{
+  std::array<float32_t, N> x;
+  std::array<float32_t, N> y;
+  std::array<float32_t, N> z;
+};
+
+/// \brief Converts the points of a block from polar into cartesian coordinates. The loop has no
+///        dependencies between points, which lets the compiler vectorize it for the target.
+/// \param[in] cos_table lookup table for cos
+/// \param[in] sin_table lookup table for sin
+/// \param[in] distance_resolution distance in meters of one step of the raw distance
+/// \param[in] polar the polar coordinates of the points
+/// \param[out] cartesian gets filled with the cartesian coordinates of the points
+template<std::size_t N>
+inline void decode_block(
+  const TrigTable & cos_table, const TrigTable & sin_table, const float32_t distance_resolution,
+  const PolarBlock<N> & polar, CartesianBlock<N> & cartesian)
+{
+  for (std::size_t idx = 0U; idx < N; ++idx) {
+    const float32_t r_m = static_cast<float32_t>(polar.distance[idx]) * distance_resolution;
+    const uint32_t th_ind = polar.azimuth_ind[idx];
+    const uint32_t phi_ind = polar.altitude_ind[idx];
+    const float32_t r_xy = r_m * cos_table[phi_ind];
+    cartesian.x[idx] = r_xy * cos_table[th_ind];  // y (vlp-frame)
+    cartesian.y[idx] = -r_xy * sin_table[th_ind];  // -x (vlp-frame)
+    cartesian.z[idx] = r_m * sin_table[phi_ind];
+  }
+}
+
+}  // namespace velodyne_driver
+}  // namespace drivers
+}  // namespace autoware
+
+#endif  // VELODYNE_DRIVER__BLOCK_DECODER_HPP_
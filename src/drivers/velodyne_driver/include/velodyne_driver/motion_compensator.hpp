@@ -0,0 +1,94 @@
+// Copyright 2018-2020 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+/// \copyright Copyright 2021 the Autoware Foundation
+/// \file
+/// \brief This file defines the motion compensation of the points of a scan
+
+#ifndef VELODYNE_DRIVER__MOTION_COMPENSATOR_HPP_
+#define VELODYNE_DRIVER__MOTION_COMPENSATOR_HPP_
+
+#include <velodyne_driver/common.hpp>
+#include <array>
+
+namespace autoware
+{
+namespace drivers
+{
+namespace velodyne_driver
+{
+/// \brief Moves the points of a scan, which are measured while the sensor moves, into the sensor
+///        frame at a single reference time. The sensor is assumed to move with a constant twist
+///        over the scan.
+class MotionCompensator
+{
+public:
+  using Vector3 = std::array<float32_t, 3U>;
+
+  /// \brief Set the twist the sensor moves with
+  /// \param[in] linear_mps linear velocity of the sensor, expressed in the sensor frame
+  /// \param[in] angular_rps angular velocity of the sensor, expressed in the sensor frame
+  void set_twist(const Vector3 & linear_mps, const Vector3 & angular_rps) noexcept
+  {
+    m_linear_mps = linear_mps;
+    m_angular_rps = angular_rps;
+  }
+
+  /// \brief Move a point into the sensor frame at the reference time. The rotation is expanded up
+  ///        to the third order in the rotation angle, which is accurate to a fraction of a
+  ///        millimeter for the rotation of a car during one scan, and avoids trigonometric
+  ///        functions per point.
+  /// \param[inout] pt The point, as measured at time_s
+  /// \param[in] time_s The time the point was measured at
+  /// \param[in] reference_time_s The time of the sensor frame the point is moved into
+  void compensate(PointXYZIF & pt, const float32_t time_s, const float32_t reference_time_s)
+  const noexcept
+  {
+    // Motion of the sensor from the time of the point to the reference time
+    const float32_t dt = reference_time_s - time_s;
+    const Vector3 th{m_angular_rps[0U] * dt, m_angular_rps[1U] * dt, m_angular_rps[2U] * dt};
+    // The point relative to the sensor position at the reference time
+    const Vector3 p{
+      pt.x - (m_linear_mps[0U] * dt),
+      pt.y - (m_linear_mps[1U] * dt),
+      pt.z - (m_linear_mps[2U] * dt)};
+    // Rotate by -th: R^T p ~ p - th x p + 1/2 th x (th x p) - 1/6 th x (th x (th x p))
+    const Vector3 a = cross(th, p);
+    const Vector3 b = cross(th, a);
+    const Vector3 c = cross(th, b);
+    pt.x = p[0U] - a[0U] + (0.5F * b[0U]) - (c[0U] / 6.0F);
+    pt.y = p[1U] - a[1U] + (0.5F * b[1U]) - (c[1U] / 6.0F);
+    pt.z = p[2U] - a[2U] + (0.5F * b[2U]) - (c[2U] / 6.0F);
+  }
+
+private:
+  static Vector3 cross(const Vector3 & a, const Vector3 & b) noexcept
+  {
+    return Vector3{
+      (a[1U] * b[2U]) - (a[2U] * b[1U]),
+      (a[2U] * b[0U]) - (a[0U] * b[2U]),
+      (a[0U] * b[1U]) - (a[1U] * b[0U])};
+  }
+
+  Vector3 m_linear_mps{0.0F, 0.0F, 0.0F};
+  Vector3 m_angular_rps{0.0F, 0.0F, 0.0F};
+};
+
+}  // namespace velodyne_driver
+}  // namespace drivers
+}  // namespace autoware
+
+#endif  // VELODYNE_DRIVER__MOTION_COMPENSATOR_HPP_
@@ -23,6 +23,7 @@
 
 #include <velodyne_driver/visibility_control.hpp>
 #include <geometry_msgs/msg/point32.hpp>
+#include <velodyne_driver/block_decoder.hpp>
 #include <velodyne_driver/common.hpp>
 #include <velodyne_driver/vlp16_data.hpp>
 #include <velodyne_driver/vlp32c_data.hpp>
@@ -98,7 +99,9 @@ private:
   /// \param[in] config config struct with rpm, transform, radial and angle pruning params
   /// \throw std::runtime_error if pruning parameters are inconsistent
   explicit VelodyneTranslator(const Config & config)
-  : m_sensor_data(config.get_rpm())
+  : m_azimuth_ind_per_us(
+      DEG2IDX * (config.get_rpm() * 360.0F) / (60.0F * 1.0E6F)),
+    m_sensor_data(config.get_rpm())
   {
     init_trig_tables();
     init_intensity_table();
@@ -110,7 +113,20 @@ private:
   void convert(const Packet & pkt, std::vector<autoware::common::types::PointXYZIF> & output)
   {
     output.clear();
+    convert(pkt, [&output](const PointXYZIF & pt, float32_t) {output.push_back(pt);});
+  }
 
+  /// \brief Convert a packet into cartesian points, handing every point to a callback in the
+  ///        order of the packet instead of storing them. This lets the caller write the points
+  ///        directly into its own output without an intermediate block.
+  /// \tparam PointHandlerT Callable with the signature void(const PointXYZIF &, float32_t)
+  /// \param[in] pkt A packet from a VLP16 HiRes sensor for conversion
+  /// \param[in] handle_point Gets called with every point and the time of its firing in seconds
+  ///                         since the first firing of the scan. It is also called with a point
+  ///                         with the id END_OF_SCAN_ID when a full revolution is reached.
+  template<typename PointHandlerT>
+  void convert(const Packet & pkt, PointHandlerT && handle_point)
+  {
     for (uint32_t block_id = 0U; block_id < NUM_BLOCKS_PER_PACKET; ++block_id, ++m_block_counter) {
       const DataBlock & block = pkt.blocks[block_id];
       const auto flag_check_result = m_sensor_data.check_flag(block.flag);
@@ -121,21 +137,41 @@ private:
       // Number of points from the sequence that has already been delivered in previous blocks.
       const auto num_banked_pts = flag_check_result.second;
       const uint32_t azimuth_base = to_uint32(block.azimuth_bytes[1U], block.azimuth_bytes[0U]);
+      if (!m_scan_started) {
+        m_scan_start_azimuth = azimuth_base;
+        m_scan_started = true;
+      }
+      // The sensor turns at a constant rate, so the azimuth of the block tells when its first
+      // firing happened
+      const uint32_t azimuth_since_scan_start =
+        ((azimuth_base + AZIMUTH_ROTATION_RESOLUTION) - m_scan_start_azimuth) %
+        AZIMUTH_ROTATION_RESOLUTION;
+      const float32_t block_time_us =
+        static_cast<float32_t>(azimuth_since_scan_start) / m_azimuth_ind_per_us;
 
+      // Gather the polar coordinates of the whole block, so that they are converted together
       for (uint16_t pt_id = 0U; pt_id < NUM_POINTS_PER_BLOCK; ++pt_id) {
         const DataChannel & channel = block.channels[pt_id];
-        const uint32_t th = (azimuth_base + m_sensor_data.azimuth_offset(
+        m_polar_block.azimuth_ind[pt_id] = (azimuth_base + m_sensor_data.azimuth_offset(
             num_banked_pts, block_id, pt_id)) % AZIMUTH_ROTATION_RESOLUTION;
-        const float32_t r = compute_distance_m(channel.data[1U], channel.data[0U]);
-        const uint32_t phi = m_sensor_data.altitude(num_banked_pts, block_id, pt_id);
+        m_polar_block.altitude_ind[pt_id] = m_sensor_data.altitude(num_banked_pts, block_id, pt_id);
+        m_polar_block.distance[pt_id] = to_uint32(channel.data[1U], channel.data[0U]);
+      }
+      decode_block(
+        m_cos_table, m_sin_table, m_sensor_data.distance_resolution(), m_polar_block,
+        m_cartesian_block);
 
-        // Compute the point
+      for (uint16_t pt_id = 0U; pt_id < NUM_POINTS_PER_BLOCK; ++pt_id) {
         PointXYZIF pt;
-        polar_to_xyz(pt, r, th, phi);
-        pt.intensity = m_intensity_table[channel.data[2U]];
+        pt.x = m_cartesian_block.x[pt_id];
+        pt.y = m_cartesian_block.y[pt_id];
+        pt.z = m_cartesian_block.z[pt_id];
+        pt.intensity = m_intensity_table[block.channels[pt_id].data[2U]];
         pt.id = m_sensor_data.seq_id(m_block_counter, pt_id);
+        const float32_t time_us =
+          block_time_us + m_sensor_data.firing_time_us(num_banked_pts, block_id, pt_id);
 
-        output.push_back(pt);
+        handle_point(pt, time_us * 1.0E-6F);
       }
 
       if (static_cast<float32_t>(m_block_counter) > m_sensor_data.num_blocks_per_revolution()) {
@@ -143,8 +179,9 @@ private:
         PointXYZIF pt;
         pt.id =
           static_cast<uint16_t>(PointXYZIF::END_OF_SCAN_ID);
-        output.push_back(pt);
+        handle_point(pt, block_time_us * 1.0E-6F);
         m_block_counter = uint16_t{0U};
+        m_scan_started = false;
       }
     }
   }
@@ -160,34 +197,6 @@ private:
     ((NUM_POINTS_PER_BLOCK * NUM_BLOCKS_PER_PACKET) + 1U),
     "Number of points from one VLP16 packet cannot fit into a point block");
 
-  /// \brief converts polar coordinates into cartesian (xyz), not threadsafe: modifies a
-  ///        preallocated workspace member variable (m_point)
-  /// \param[out] pt Gets filled with the requisite cartesian information
-  /// \param[in] r_m the radius in meters
-  /// \param[in] th_ind the index of the azimuth in lookup tables (angle about the z-axis)
-  /// \param[in] phi_ind the altitude angle index from lookup tables(angle orthogonal to z-axis)
-  inline void polar_to_xyz(
-    autoware::common::types::PointXYZIF & pt,
-    const float32_t r_m,
-    const uint32_t th_ind,
-    const uint32_t phi_ind) const
-  {
-    const float32_t r_xy = r_m * m_cos_table[phi_ind];
-    pt.x = r_xy * m_cos_table[th_ind];  // y (vlp-frame)
-    pt.y = -r_xy * m_sin_table[th_ind];  // -x (vlp-frame)
-    pt.z = r_m * m_sin_table[phi_ind];
-  }
-
-  /// \brief converts the two byte representation of distance into meters
-  /// \param[in] first the byte representing the most significant bits
-  /// \param[in] second the byte representing the least significant bits
-  /// \return the radial distance in meters
-  inline float32_t compute_distance_m(const uint8_t first, const uint8_t second) const
-  {
-    const uint32_t dist_scaled = to_uint32(first, second);
-    return static_cast<float32_t>(dist_scaled) * m_sensor_data.distance_resolution();
-  }
-
   template<typename T>
   inline T clamp(const T val, const T min, const T max) const
   {
@@ -218,12 +227,23 @@ private:
 
   /// parameters
   /// lookup table for sin
-  std::array<float32_t, AZIMUTH_ROTATION_RESOLUTION> m_sin_table;
+  TrigTable m_sin_table;
   /// lookup table for cos
-  std::array<float32_t, AZIMUTH_ROTATION_RESOLUTION> m_cos_table;
+  TrigTable m_cos_table;
   /// lookup table for intensity
   std::array<float32_t, AZIMUTH_ROTATION_RESOLUTION> m_intensity_table;
+  /// workspace for the polar coordinates of the block being converted, makes convert() not
+  /// threadsafe
+  PolarBlock<NUM_POINTS_PER_BLOCK> m_polar_block;
+  /// workspace for the cartesian coordinates of the block being converted
+  CartesianBlock<NUM_POINTS_PER_BLOCK> m_cartesian_block;
 
+  /// azimuth lookup table indices the sensor turns per microsecond
+  float32_t m_azimuth_ind_per_us;
+  /// azimuth of the first block of the current scan
+  uint32_t m_scan_start_azimuth{0U};
+  /// whether a block of the current scan was converted already
+  bool8_t m_scan_started{false};
   /// mask to avoid modulo: packet id can go up to 3617: 0000 1111 1111 1111 = 4096
   uint16_t m_block_counter{0U};
   SensorData m_sensor_data;
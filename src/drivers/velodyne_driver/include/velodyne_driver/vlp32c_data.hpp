@@ -74,6 +74,15 @@ public:
   /// \return Altitude angle for the given laser.
   uint32_t altitude(uint16_t num_banked_pts, uint32_t block_id, uint32_t pt_id) const;
 
+  /// Get the time of the firing of a given point in the given block, relative to the first
+  /// firing of the sequence the block starts with.
+  /// \param num_banked_pts Number of points from the sequence that were
+  /// transferred on previous blocks.
+  /// \param block_id Block ID within the packet.
+  /// \param pt_id Point ID within the block.
+  /// \return Firing time offset in microseconds.
+  float32_t firing_time_us(uint16_t num_banked_pts, uint32_t block_id, uint32_t pt_id) const;
+
   /// Get total number of firing sequences in the number of blocks + number of points.
   /// \param num_blocks Total number of blocks.
   /// \param pt_id Residue number of points
@@ -102,11 +111,18 @@ private:
   /// \return none
   VELODYNE_DRIVER_LOCAL void init_azimuth_table(const float32_t rpm);
 
+  /// \brief initializes the firing time of each point in a block. This only needs to run once
+  ///        and happens in the constructor
+  /// \return none
+  VELODYNE_DRIVER_LOCAL void init_firing_time_table();
+
   /// \brief initializes the fixed altitude angles for each firing in a block. This only needs to
   ///        run once and happens in the constructor
   /// \return none
   VELODYNE_DRIVER_LOCAL void init_altitude_table();
 
+  /// lookup table for the firing time offset for each point index in a block
+  std::array<float32_t, NUM_LASERS> m_firing_time_us;
   /// lookup table for azimuth offset for each point index in a block
   std::array<uint32_t, NUM_LASERS> m_azimuth_ind;
   /// lookup table for altitude angle for each firing in a fire sequence (2 per block)
@@ -29,6 +29,7 @@ VLS128Data::VLS128Data(const float32_t rpm)
 {
   init_azimuth_table(rpm);
   init_altitude_table();
+  init_firing_time_table();
   // (60E6 us/min * x min/rev = us/rev) * (seq/us * block/seq) = block / rev
   m_num_blocks_per_revolution =
     static_cast<uint16_t>(std::roundf(
@@ -46,6 +47,11 @@ uint32_t VLS128Data::altitude(uint16_t num_banked_pts, uint32_t, uint32_t pt_id)
   return m_altitude_ind[num_banked_pts + pt_id];
 }
 
+float32_t VLS128Data::firing_time_us(uint16_t num_banked_pts, uint32_t, uint32_t pt_id) const
+{
+  return m_firing_time_us[num_banked_pts + pt_id];
+}
+
 uint16_t VLS128Data::seq_id(uint16_t num_blocks, uint32_t) const noexcept
 {
   return static_cast<uint16_t>(std::floor(NUM_SEQUENCES_PER_BLOCK * num_blocks));
@@ -111,6 +117,18 @@ std::pair<bool8_t, uint16_t> VLS128Data::check_flag(const BlockFlag & flag)
   return std::make_pair(valid, banked_points);
 }
 
+void VLS128Data::init_firing_time_table()
+{
+  // Same firing offsets as in the azimuth table: one group of 8 lasers after another, with a
+  // maintenance period after the first 8 groups
+  for (uint32_t pt_id = 0U; pt_id < NUM_LASERS; ++pt_id) {
+    const uint32_t num_groups_fired = pt_id / GROUP_SIZE;
+    const float32_t maintenance_offset_us = num_groups_fired < 8U ? 0.0F : MAINTENANCE_DURATION1_US;
+    m_firing_time_us[pt_id] =
+      (static_cast<float32_t>(num_groups_fired) * FIRE_DURATION_US) + maintenance_offset_us;
+  }
+}
+
 void VLS128Data::init_altitude_table()
 {
   // altitude angles in degrees: from spec sheet(Figure 9-8)
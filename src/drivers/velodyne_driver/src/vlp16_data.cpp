@@ -27,6 +27,7 @@ VLP16Data::VLP16Data(const float32_t rpm)
 {
   init_azimuth_table(rpm);
   init_altitude_table();
+  init_firing_time_table();
   // (60E6 us/min * x min/rev = us/rev) * (seq/us * block/seq) = block / rev
   m_num_blocks_per_revolution =
     static_cast<uint16_t>(std::ceil(60.0E6F / (rpm * FIRE_SEQ_OFFSET_US * 2.0F)));
@@ -42,6 +43,11 @@ uint32_t VLP16Data::altitude(uint16_t, uint32_t, uint32_t pt_id) const
   return m_altitude_ind[pt_id % NUM_LASERS];
 }
 
+float32_t VLP16Data::firing_time_us(uint16_t, uint32_t, uint32_t pt_id) const
+{
+  return m_firing_time_us[pt_id];
+}
+
 uint16_t VLP16Data::seq_id(uint16_t num_blocks, uint32_t pt_id) const noexcept
 {
   const auto num_seqs = static_cast<uint16_t>(NUM_SEQUENCES_PER_BLOCK * num_blocks);
@@ -79,6 +85,16 @@ uint16_t VLP16Data::num_blocks_per_revolution() const noexcept
   return m_num_blocks_per_revolution;
 }
 
+void VLP16Data::init_firing_time_table()
+{
+  // us = 55.296*fire_seq + 2.304*(point idx % 16)
+  for (uint32_t pt_id = 0U; pt_id < NUM_POINTS_PER_BLOCK; ++pt_id) {
+    const auto fire_seq = static_cast<float32_t>(pt_id / NUM_LASERS);
+    const auto laser_id = static_cast<float32_t>(pt_id % NUM_LASERS);
+    m_firing_time_us[pt_id] = (FIRE_SEQ_OFFSET_US * fire_seq) + (FIRE_DURATION_US * laser_id);
+  }
+}
+
 void VLP16Data::init_altitude_table()
 {
   // TODO(christopher.ho) from calibration file if available
@@ -29,6 +29,7 @@ VLP32CData::VLP32CData(const float32_t rpm)
 {
   init_azimuth_table(rpm);
   init_altitude_table();
+  init_firing_time_table();
   // (60E6 us/min * x min/rev = us/rev) * (seq/us * block/seq) = block / rev
   m_num_blocks_per_revolution =
     static_cast<uint16_t>(std::floor(
@@ -46,6 +47,11 @@ uint32_t VLP32CData::altitude(uint16_t, uint32_t, uint32_t pt_id) const
   return m_altitude_ind[pt_id];
 }
 
+float32_t VLP32CData::firing_time_us(uint16_t, uint32_t, uint32_t pt_id) const
+{
+  return m_firing_time_us[pt_id];
+}
+
 uint16_t VLP32CData::seq_id(uint16_t num_blocks, uint32_t) const noexcept
 {
   return num_blocks;
@@ -87,6 +93,15 @@ std::pair<bool8_t, uint16_t> VLP32CData::check_flag(const BlockFlag & flag)
   return std::make_pair(valid, 0U);
 }
 
+void VLP32CData::init_firing_time_table()
+{
+  // The lasers of a group are fired at the same time, one group after another
+  for (uint32_t pt_id = 0U; pt_id < NUM_LASERS; ++pt_id) {
+    const uint32_t group_id = pt_id / GROUP_SIZE;
+    m_firing_time_us[pt_id] = static_cast<float32_t>(group_id) * FIRE_DURATION_US;
+  }
+}
+
 void VLP32CData::init_altitude_table()
 {
   // altitude angles in degrees: from spec sheet(Table 9-2)
@@ -257,6 +257,24 @@ TEST_F(VelodyneDriver, Basic)
   EXPECT_LE(phi_diff, (20.0F * 3.14159F / 180.0F) + 0.001F);
 }
 
+// The points of one packet are fired within about 1.3 ms, in the order of the packet
+TEST_F(VelodyneDriver, PointTimes)
+{
+  // The azimuth of the blocks of the packet advances by 0.4 deg, the sensor turned at 600 rpm
+  const Vlp16Translator::Config cfg{600.0F};
+  Vlp16Translator driver(cfg);
+  std::vector<float32_t> times;
+  driver.convert(
+    pkt, [&times](const autoware::common::types::PointXYZIF &, float32_t time_s) {
+      times.push_back(time_s);
+    });
+  ASSERT_EQ(times.size(), static_cast<size_t>(NUM_POINTS_PER_BLOCK * NUM_BLOCKS_PER_PACKET));
+  EXPECT_FLOAT_EQ(times.front(), 0.0F);
+  EXPECT_TRUE(std::is_sorted(times.begin(), times.end()));
+  EXPECT_LT(times.back(), 1.4E-3F);
+  EXPECT_GT(times.back(), 1.2E-3F);
+}
+
 // figure out what the runtime of convert() is, locally
 TEST_F(VelodyneDriver, Benchmark)
 {
@@ -0,0 +1,94 @@
+// Copyright 2018-2020 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <velodyne_driver/block_decoder.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+
+using autoware::drivers::velodyne_driver::AZIMUTH_ROTATION_RESOLUTION;
+using autoware::drivers::velodyne_driver::CartesianBlock;
+using autoware::drivers::velodyne_driver::NUM_POINTS_PER_BLOCK;
+using autoware::drivers::velodyne_driver::PolarBlock;
+using autoware::drivers::velodyne_driver::TrigTable;
+using autoware::drivers::velodyne_driver::decode_block;
+using autoware::common::types::float32_t;
+
+// The block conversion must give the same bits as the per point conversion, including the sign
+// of zero
+TEST(BlockDecoderTest, MatchesPerPointConversionBitExact) {
+  // The tables are large, so keep them off the stack
+  auto cos_table = std::make_unique<TrigTable>();
+  auto sin_table = std::make_unique<TrigTable>();
+  for (uint32_t idx = 0U; idx < AZIMUTH_ROTATION_RESOLUTION; ++idx) {
+    const float32_t angle = static_cast<float32_t>(idx) * 6.2831853F /
+      static_cast<float32_t>(AZIMUTH_ROTATION_RESOLUTION);
+    (*cos_table)[idx] = cosf(angle);
+    (*sin_table)[idx] = sinf(angle);
+  }
+
+  std::mt19937 gen{42U};
+  std::uniform_int_distribution<uint32_t> angle_dist{0U, AZIMUTH_ROTATION_RESOLUTION - 1U};
+  std::uniform_int_distribution<uint32_t> distance_dist{0U, 0xFFFFU};
+  PolarBlock<NUM_POINTS_PER_BLOCK> polar;
+  CartesianBlock<NUM_POINTS_PER_BLOCK> cartesian;
+  for (uint32_t run = 0U; run < 100U; ++run) {
+    for (uint32_t idx = 0U; idx < NUM_POINTS_PER_BLOCK; ++idx) {
+      polar.azimuth_ind[idx] = angle_dist(gen);
+      polar.altitude_ind[idx] = angle_dist(gen);
+      // missing returns have a zero distance
+      polar.distance[idx] = ((idx % 4U) == 0U) ? 0U : distance_dist(gen);
+    }
+    decode_block(*cos_table, *sin_table, 0.002F, polar, cartesian);
+    for (uint32_t idx = 0U; idx < NUM_POINTS_PER_BLOCK; ++idx) {
+      const float32_t r = static_cast<float32_t>(polar.distance[idx]) * 0.002F;
+      const float32_t r_xy = r * (*cos_table)[polar.altitude_ind[idx]];
+      const float32_t x = r_xy * (*cos_table)[polar.azimuth_ind[idx]];
+      const float32_t y = -r_xy * (*sin_table)[polar.azimuth_ind[idx]];
+      const float32_t z = r * (*sin_table)[polar.altitude_ind[idx]];
+      EXPECT_EQ(std::memcmp(&x, &cartesian.x[idx], sizeof(x)), 0);
+      EXPECT_EQ(std::memcmp(&y, &cartesian.y[idx], sizeof(y)), 0);
+      EXPECT_EQ(std::memcmp(&z, &cartesian.z[idx], sizeof(z)), 0);
+    }
+  }
+}
+
+// The block conversion is the per point conversion the translator always used
+TEST(BlockDecoderTest, MatchesPerPointConversion) {
+  auto cos_table = std::make_unique<TrigTable>();
+  auto sin_table = std::make_unique<TrigTable>();
+  for (uint32_t idx = 0U; idx < AZIMUTH_ROTATION_RESOLUTION; ++idx) {
+    (*cos_table)[idx] = static_cast<float32_t>(idx) * 1.0E-4F;
+    (*sin_table)[idx] = 1.0F - static_cast<float32_t>(idx) * 1.0E-5F;
+  }
+  PolarBlock<NUM_POINTS_PER_BLOCK> polar;
+  for (uint32_t idx = 0U; idx < NUM_POINTS_PER_BLOCK; ++idx) {
+    polar.azimuth_ind[idx] = idx * 1000U;
+    polar.altitude_ind[idx] = AZIMUTH_ROTATION_RESOLUTION - 1U - idx * 100U;
+    polar.distance[idx] = idx * 2000U;
+  }
+  CartesianBlock<NUM_POINTS_PER_BLOCK> cartesian;
+  decode_block(*cos_table, *sin_table, 0.004F, polar, cartesian);
+  for (uint32_t idx = 0U; idx < NUM_POINTS_PER_BLOCK; ++idx) {
+    const float32_t r = static_cast<float32_t>(polar.distance[idx]) * 0.004F;
+    const float32_t r_xy = r * (*cos_table)[polar.altitude_ind[idx]];
+    EXPECT_EQ(cartesian.x[idx], r_xy * (*cos_table)[polar.azimuth_ind[idx]]);
+    EXPECT_EQ(cartesian.y[idx], -r_xy * (*sin_table)[polar.azimuth_ind[idx]]);
+    EXPECT_EQ(cartesian.z[idx], r * (*sin_table)[polar.altitude_ind[idx]]);
+  }
+}
@@ -0,0 +1,73 @@
+// Copyright 2018-2020 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <velodyne_driver/motion_compensator.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using autoware::drivers::velodyne_driver::MotionCompensator;
+using autoware::drivers::velodyne_driver::PointXYZIF;
+using autoware::common::types::float32_t;
+
+TEST(MotionCompensatorTest, NoMotion) {
+  MotionCompensator compensator;
+  PointXYZIF pt;
+  pt.x = 1.0F;
+  pt.y = 2.0F;
+  pt.z = 3.0F;
+  compensator.compensate(pt, 0.02F, 0.1F);
+  EXPECT_FLOAT_EQ(pt.x, 1.0F);
+  EXPECT_FLOAT_EQ(pt.y, 2.0F);
+  EXPECT_FLOAT_EQ(pt.z, 3.0F);
+  // A point measured at the reference time stays where it is
+  compensator.set_twist({10.0F, 1.0F, 0.0F}, {0.0F, 0.0F, 0.5F});
+  compensator.compensate(pt, 0.1F, 0.1F);
+  EXPECT_FLOAT_EQ(pt.x, 1.0F);
+  EXPECT_FLOAT_EQ(pt.y, 2.0F);
+  EXPECT_FLOAT_EQ(pt.z, 3.0F);
+}
+
+TEST(MotionCompensatorTest, Translation) {
+  MotionCompensator compensator;
+  compensator.set_twist({10.0F, -2.0F, 0.0F}, {0.0F, 0.0F, 0.0F});
+  PointXYZIF pt;
+  pt.x = 20.0F;
+  pt.y = 5.0F;
+  pt.z = -1.0F;
+  pt.intensity = 7.0F;
+  // The sensor moved 1 m forward and 0.2 m to the right since the point was measured
+  compensator.compensate(pt, 0.0F, 0.1F);
+  EXPECT_FLOAT_EQ(pt.x, 19.0F);
+  EXPECT_FLOAT_EQ(pt.y, 5.2F);
+  EXPECT_FLOAT_EQ(pt.z, -1.0F);
+  EXPECT_FLOAT_EQ(pt.intensity, 7.0F);
+}
+
+TEST(MotionCompensatorTest, Rotation) {
+  MotionCompensator compensator;
+  // A fast turn of a car
+  compensator.set_twist({0.0F, 0.0F, 0.0F}, {0.0F, 0.0F, 0.5F});
+  PointXYZIF pt;
+  pt.x = 50.0F;
+  pt.y = 0.0F;
+  pt.z = 2.0F;
+  compensator.compensate(pt, 0.0F, 0.1F);
+  // The sensor turned left, so the point appears to the right of it
+  const float32_t angle = 0.05F;
+  EXPECT_NEAR(pt.x, 50.0F * std::cos(angle), 1.0E-4F);
+  EXPECT_NEAR(pt.y, -50.0F * std::sin(angle), 1.0E-4F);
+  EXPECT_FLOAT_EQ(pt.z, 2.0F);
+}
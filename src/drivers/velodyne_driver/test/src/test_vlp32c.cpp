@@ -70,6 +70,17 @@ TEST(VLP32CDataTest, SeqIdTest) {
   EXPECT_EQ(vlp32c_data.seq_id(8U, 0U), 8U);
 }
 
+TEST(VLP32CDataTest, FiringTimeTest) {
+  constexpr auto rpm{300U};
+  VLP32CData vlp32c_data{rpm};
+  // The two lasers of a group fire together
+  EXPECT_FLOAT_EQ(vlp32c_data.firing_time_us(0U, 0U, 0U), 0.0F);
+  EXPECT_FLOAT_EQ(vlp32c_data.firing_time_us(0U, 0U, 1U), 0.0F);
+  EXPECT_FLOAT_EQ(vlp32c_data.firing_time_us(0U, 3U, 2U), VLP32CData::FIRE_DURATION_US);
+  EXPECT_FLOAT_EQ(
+    vlp32c_data.firing_time_us(0U, 0U, 31U), 15.0F * VLP32CData::FIRE_DURATION_US);
+}
+
 TEST(VLP32CDataTest, FlagTest) {
   constexpr auto rpm{300U};
   VLP32CData vlp32c_data{rpm};
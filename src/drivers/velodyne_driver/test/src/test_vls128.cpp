@@ -105,6 +105,18 @@ TEST(VLS128DataTest, SeqIdTest) {
   EXPECT_EQ(vls128_data.seq_id(8U, 0U), 2U);
 }
 
+TEST(VLS128DataTest, FiringTimeTest) {
+  constexpr auto rpm{300U};
+  VLS128Data vls128_data{rpm};
+  EXPECT_FLOAT_EQ(vls128_data.firing_time_us(0U, 0U, 7U), 0.0F);
+  EXPECT_FLOAT_EQ(vls128_data.firing_time_us(0U, 0U, 8U), VLS128Data::FIRE_DURATION_US);
+  // Banked points continue the sequence of the previous blocks, with the maintenance period
+  // after the 8th group
+  EXPECT_FLOAT_EQ(
+    vls128_data.firing_time_us(64U, 2U, 0U),
+    8.0F * VLS128Data::FIRE_DURATION_US + VLS128Data::MAINTENANCE_DURATION1_US);
+}
+
 TEST(VLS128DataTest, FlagTest) {
   constexpr auto rpm{300U};
   VLS128Data vls128_data{rpm};
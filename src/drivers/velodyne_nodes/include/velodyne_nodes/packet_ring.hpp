@@ -0,0 +1,140 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+/// \file
+/// \brief This file defines a ring of packets shared between a receiving and a converting thread
+
+#ifndef VELODYNE_NODES__PACKET_RING_HPP_
+#define VELODYNE_NODES__PACKET_RING_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace autoware
+{
+namespace drivers
+{
+namespace velodyne_nodes
+{
+
+/// A fixed capacity ring of packets for a single producer and a single consumer. The producer
+/// receives packets into the free slots in place, and the consumer converts the received packets
+/// in place, both in batches of contiguous slots. The lock is only held to exchange the slot
+/// indices, not while packets are received or converted.
+/// \tparam PacketT The packet type
+template<typename PacketT>
+class PacketRing
+{
+public:
+  /// A batch of contiguous slots
+  using Slots = std::pair<PacketT *, std::size_t>;
+
+  /// \brief Allocate the slots of the ring
+  /// \param[in] capacity Number of packets the ring can hold
+  /// \throw std::domain_error If the capacity is zero
+  explicit PacketRing(const std::size_t capacity)
+  : m_packets(capacity)
+  {
+    if (capacity == 0U) {
+      throw std::domain_error{"PacketRing: capacity must be positive"};
+    }
+  }
+
+  /// \brief Get the free slots after the last written one, up to the end of the storage
+  /// \param[in] max_count Maximum number of slots to return
+  /// \return The free slots, with a count of zero if the ring is full
+  Slots free_slots(const std::size_t max_count)
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    const auto write_index = (m_read_index + m_size) % m_packets.size();
+    const auto contiguous = std::min(m_packets.size() - m_size, m_packets.size() - write_index);
+    return {&m_packets[write_index], std::min(contiguous, max_count)};
+  }
+
+  /// \brief Make the first slots returned by free_slots available to the consumer
+  /// \param[in] count Number of slots that were written
+  void commit(const std::size_t count)
+  {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_size += count;
+    }
+    m_condition.notify_one();
+  }
+
+  /// \brief Wait for written slots after the last released one, up to the end of the storage
+  /// \return The written slots, or no slots with a null pointer if the ring was stopped
+  Slots wait_for_packets()
+  {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_condition.wait(lock, [this] {return (m_size > 0U) || m_stopped;});
+    if (m_stopped) {
+      return {nullptr, 0U};
+    }
+    return {&m_packets[m_read_index], std::min(m_size, m_packets.size() - m_read_index)};
+  }
+
+  /// \brief Free the first slots returned by wait_for_packets
+  /// \param[in] count Number of slots that were read
+  void release(const std::size_t count)
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_read_index = (m_read_index + count) % m_packets.size();
+    m_size -= count;
+  }
+
+  /// \brief Wake up the consumer and make all further waits return immediately
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_stopped = true;
+    }
+    m_condition.notify_all();
+  }
+
+  /// \brief Number of packets which were written but not released
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_size;
+  }
+
+  /// \brief Number of packets the ring can hold
+  std::size_t capacity() const noexcept
+  {
+    return m_packets.size();
+  }
+
+private:
+  std::vector<PacketT> m_packets;
+  std::size_t m_read_index{0U};
+  std::size_t m_size{0U};
+  bool m_stopped{false};
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+};  // class PacketRing
+
+}  // namespace velodyne_nodes
+}  // namespace drivers
+}  // namespace autoware
+
+#endif  // VELODYNE_NODES__PACKET_RING_HPP_
@@ -23,17 +23,27 @@
 #ifndef VELODYNE_NODES__VELODYNE_CLOUD_NODE_HPP_
 #define VELODYNE_NODES__VELODYNE_CLOUD_NODE_HPP_
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include "common/types.hpp"
+#include "geometry_msgs/msg/twist_stamped.hpp"
+#include "helper_functions/thread_scheduling.hpp"
 #include "lidar_utils/point_cloud_utils.hpp"
 #include "rclcpp/rclcpp.hpp"
+#include "time_utils/trace.hpp"
 #include "udp_driver/udp_driver.hpp"
+#include "velodyne_driver/motion_compensator.hpp"
 #include "velodyne_driver/velodyne_translator.hpp"
+#include "velodyne_nodes/packet_ring.hpp"
 #include "velodyne_nodes/visibility_control.hpp"
 #include "sensor_msgs/msg/point_cloud2.hpp"
 
 using autoware::common::types::bool8_t;
+using autoware::common::types::float32_t;
 
 namespace autoware
 {
@@ -45,6 +55,17 @@ namespace velodyne_nodes
 
 /// Template class for the velodyne driver node that receives veldyne `packet`s via
 /// UDP, converts the packet into a PointCloud2 message and publishes this cloud.
+/// If the `packet_ring_size` parameter is positive, the packets are not received through the
+/// udp driver one at a time. Instead, a receiving thread drains the socket in batches of datagrams
+/// into a ring of that many packets, and a converting thread converts them from there.
+/// If the `deskew` parameter is true, the points are motion compensated with the latest twist of
+/// the sensor, received on the topic given by `twist_topic`, into the sensor frame at the end of
+/// the revolution.
+/// If the `sectors_per_revolution` parameter is positive, a cloud is also published whenever the
+/// points of an azimuth sector of the revolution are complete, so that processing can start before
+/// the revolution is.
+/// The node is also registered as a component for each sensor model, so that the drivers of several
+/// lidars can be composed into one process with the nodes consuming their clouds.
 /// \tparam SensorData SensorData implementation for the specific velodyne sensor model.
 template<typename SensorData>
 class VELODYNE_NODES_PUBLIC VelodyneCloudNode : public rclcpp::Node
@@ -55,6 +76,10 @@ public:
   using Packet = typename VelodyneTranslatorT::Packet;
 
   VelodyneCloudNode(const std::string & node_name, const rclcpp::NodeOptions & options);
+  /// Constructor used when the node is loaded as a component, which is named by the container
+  explicit VelodyneCloudNode(const rclcpp::NodeOptions & options);
+  /// Stop and join the receiving and converting threads, if any
+  ~VelodyneCloudNode() override;
 
   /// Handle data packet from the udp driver
   /// \param buffer Data from the udp driver
@@ -69,10 +94,25 @@ protected:
 
 private:
   void init_udp_driver();
+  void init_batched_receiver(const std::size_t packet_ring_size);
+  /// Apply the scheduling declared with the given name to a thread, warning if that fails
+  void apply_scheduling(
+    const common::helper_functions::ThreadScheduling & scheduling, std::thread & thread,
+    const std::string & name);
+  /// Loop of the receiving thread, which receives datagrams into the packet ring
+  void receive_packets();
+  /// Loop of the converting thread, which converts the packets in the packet ring
+  void convert_packets();
+  void convert_and_publish(const Packet & pkt);
+  void on_twist(const geometry_msgs::msg::TwistStamped::SharedPtr msg);
+  /// Sector of the revolution that a point fired at the given time since the scan start is in
+  uint32_t get_sector(const float32_t time_s) const;
 
   IoContext m_io_cxt;
   ::drivers::udp_driver::UdpDriver m_udp_driver;
   VelodyneTranslatorT m_translator;
+  // Points of the last packet that were converted after the cloud was complete, which start the
+  // next cloud
   std::vector<autoware::common::types::PointXYZIF> m_point_block;
 
   std::string m_ip;
@@ -80,13 +120,29 @@ private:
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr m_pc2_pub_ptr;
   sensor_msgs::msg::PointCloud2 m_pc2_msg{};
   bool m_published_cloud = false;
-  // Keeps track of where you left off on the converted point block in case you needed to publish
-  // a point cloud in the middle of processing it
-  uint32_t m_remainder_start_idx;
   // keeps track of the constructed point cloud to continue growing it with new data
   uint32_t m_point_cloud_idx;
   const std::string m_frame_id;
   const std::uint32_t m_cloud_size;
+  // records when each cloud is published, if tracing is switched on
+  const common::time_utils::TracePoint m_trace;
+  // Only used for the batched receive
+  std::unique_ptr<PacketRing<Packet>> m_packet_ring{};
+  int32_t m_socket{-1};
+  std::atomic<bool8_t> m_receiving{false};
+  std::thread m_receive_thread{};
+  std::thread m_convert_thread{};
+  float32_t m_scan_period_s{0.0F};
+  // Only used for the sector publishing
+  uint32_t m_num_sectors{0U};
+  float32_t m_sector_period_s{0.0F};
+  // sector of the cloud being constructed
+  uint32_t m_cloud_sector{0U};
+  // Only used for the motion compensation
+  bool8_t m_deskew{false};
+  rclcpp::Subscription<geometry_msgs::msg::TwistStamped>::SharedPtr m_twist_sub_ptr{};
+  std::mutex m_twist_mutex{};
+  velodyne_driver::MotionCompensator m_motion_compensator{};
 };  // class VelodyneCloudNode
 
 using VLP16DriverNode = VelodyneCloudNode<velodyne_driver::VLP16Data>;
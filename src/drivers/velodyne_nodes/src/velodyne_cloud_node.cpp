@@ -14,8 +14,18 @@
 //
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
-#include <string>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
 #include <chrono>
+#include <cstring>
+#include <string>
 #include <vector>
 
 #include "common/types.hpp"
@@ -34,6 +44,14 @@ namespace drivers
 namespace velodyne_nodes
 {
 
+namespace
+{
+// Maximum number of datagrams received with a single system call
+constexpr std::size_t kReceiveBatchSize = 64U;
+// Time after which a blocking receive returns, so that the receiving thread can stop
+constexpr std::chrono::microseconds kReceiveTimeout{100000};
+}  // namespace
+
 template<typename T>
 VelodyneCloudNode<T>::VelodyneCloudNode(
   const std::string & node_name,
@@ -47,21 +65,66 @@ VelodyneCloudNode<T>::VelodyneCloudNode(
   m_pc2_pub_ptr(create_publisher<sensor_msgs::msg::PointCloud2>(
       declare_parameter("topic").template
       get<std::string>(), rclcpp::QoS{10})),
-  m_remainder_start_idx(0U),
   m_point_cloud_idx(0),
   m_frame_id(this->declare_parameter("frame_id").template get<std::string>().c_str()),
   m_cloud_size(static_cast<std::uint32_t>(
-      this->declare_parameter("cloud_size").template get<std::uint32_t>()))
+      this->declare_parameter("cloud_size").template get<std::uint32_t>())),
+  m_trace(this->get_fully_qualified_name())
 {
   m_point_block.reserve(VelodyneTranslatorT::POINT_BLOCK_CAPACITY);
   // If your preallocated cloud size is too small, the node really won't operate well at all
   if (static_cast<uint32_t>(m_point_block.capacity()) >= m_cloud_size) {
     throw std::runtime_error("VelodyneCloudNode: cloud_size must be > PointBlock::CAPACITY");
   }
+  const auto packet_ring_size = this->declare_parameter("packet_ring_size", 0);
+  if (packet_ring_size < 0) {
+    throw std::runtime_error("VelodyneCloudNode: packet_ring_size must not be negative");
+  }
 
+  m_scan_period_s = 60.0F / static_cast<float32_t>(this->get_parameter("rpm").as_int());
+  const auto sectors_per_revolution = this->declare_parameter("sectors_per_revolution", 0);
+  if (sectors_per_revolution < 0) {
+    throw std::runtime_error("VelodyneCloudNode: sectors_per_revolution must not be negative");
+  }
+  m_num_sectors = static_cast<uint32_t>(sectors_per_revolution);
+  if (m_num_sectors > 0U) {
+    m_sector_period_s = m_scan_period_s / static_cast<float32_t>(m_num_sectors);
+  }
+  m_deskew = this->declare_parameter("deskew", false);
+  if (m_deskew) {
+    m_twist_sub_ptr = create_subscription<geometry_msgs::msg::TwistStamped>(
+      this->declare_parameter("twist_topic", "twist"), rclcpp::QoS{10},
+      [this](const geometry_msgs::msg::TwistStamped::SharedPtr msg) {on_twist(msg);});
+  }
 
-  init_udp_driver();
   init_output(m_pc2_msg);
+  if (packet_ring_size > 0) {
+    init_batched_receiver(static_cast<std::size_t>(packet_ring_size));
+  } else {
+    init_udp_driver();
+  }
+}
+
+template<typename T>
+VelodyneCloudNode<T>::VelodyneCloudNode(const rclcpp::NodeOptions & options)
+: VelodyneCloudNode("velodyne_cloud_node", options)
+{
+}
+
+template<typename T>
+VelodyneCloudNode<T>::~VelodyneCloudNode()
+{
+  if (m_packet_ring) {
+    m_receiving = false;
+    m_packet_ring->stop();
+    if (m_receive_thread.joinable()) {
+      m_receive_thread.join();
+    }
+    if (m_convert_thread.joinable()) {
+      m_convert_thread.join();
+    }
+    (void)close(m_socket);
+  }
 }
 
 template<typename T>
@@ -74,17 +137,136 @@ void VelodyneCloudNode<T>::init_udp_driver()
     std::bind(&VelodyneCloudNode<T>::receiver_callback, this, std::placeholders::_1));
 }
 
+template<typename T>
+void VelodyneCloudNode<T>::init_batched_receiver(const std::size_t packet_ring_size)
+{
+  m_packet_ring = std::make_unique<PacketRing<Packet>>(packet_ring_size);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(m_port);
+  if (inet_pton(AF_INET, m_ip.c_str(), &address.sin_addr) != 1) {
+    throw std::runtime_error("VelodyneCloudNode: invalid ip " + m_ip);
+  }
+  m_socket = socket(AF_INET, SOCK_DGRAM, 0);
+  if (m_socket < 0) {
+    throw std::runtime_error(
+            std::string{"VelodyneCloudNode: failed to open socket: "} + std::strerror(errno));
+  }
+  timeval timeout{};
+  timeout.tv_usec = static_cast<decltype(timeout.tv_usec)>(kReceiveTimeout.count());
+  if ((setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) != 0) ||
+    (bind(m_socket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0))
+  {
+    const std::string error{std::strerror(errno)};
+    (void)close(m_socket);
+    throw std::runtime_error("VelodyneCloudNode: failed to bind socket: " + error);
+  }
+  using common::helper_functions::declare_thread_scheduling;
+  const auto receive_scheduling = declare_thread_scheduling(*this, "receive_thread");
+  const auto convert_scheduling = declare_thread_scheduling(*this, "convert_thread");
+
+  m_receiving = true;
+  m_convert_thread = std::thread{[this] {convert_packets();}};
+  m_receive_thread = std::thread{[this] {receive_packets();}};
+  apply_scheduling(convert_scheduling, m_convert_thread, "convert_thread");
+  apply_scheduling(receive_scheduling, m_receive_thread, "receive_thread");
+}
+
+template<typename T>
+void VelodyneCloudNode<T>::apply_scheduling(
+  const common::helper_functions::ThreadScheduling & scheduling, std::thread & thread,
+  const std::string & name)
+{
+  const std::string error =
+    common::helper_functions::apply_thread_scheduling(scheduling, thread.native_handle());
+  if (!error.empty()) {
+    RCLCPP_WARN(this->get_logger(), "VelodyneCloudNode: %s: %s", name.c_str(), error.c_str());
+  }
+}
+
+template<typename T>
+void VelodyneCloudNode<T>::receive_packets()
+{
+  std::array<mmsghdr, kReceiveBatchSize> messages{};
+  std::array<iovec, kReceiveBatchSize> buffers{};
+  Packet dropped_pkt{};
+  while (m_receiving) {
+    auto slots = m_packet_ring->free_slots(kReceiveBatchSize);
+    const bool8_t ring_full = (slots.second == 0U);
+    if (ring_full) {
+      // The converting thread is behind, keep draining the socket but drop the packets
+      slots = {&dropped_pkt, 1U};
+    }
+    for (std::size_t idx = 0U; idx < slots.second; ++idx) {
+      buffers[idx].iov_base = &slots.first[idx];
+      buffers[idx].iov_len = sizeof(Packet);
+      messages[idx].msg_hdr = msghdr{};
+      messages[idx].msg_hdr.msg_iov = &buffers[idx];
+      messages[idx].msg_hdr.msg_iovlen = 1U;
+    }
+    // Wait for the first datagram, then take all the ones that are already queued
+    const auto received = recvmmsg(
+      m_socket, messages.data(), static_cast<uint32_t>(slots.second), MSG_WAITFORONE, nullptr);
+    if (received <= 0) {
+      if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+        RCLCPP_WARN_THROTTLE(
+          this->get_logger(), *this->get_clock(), 1000, "VelodyneCloudNode: receive failed: %s",
+          std::strerror(errno));
+      }
+      continue;
+    }
+    if (ring_full) {
+      RCLCPP_WARN_THROTTLE(
+        this->get_logger(), *this->get_clock(), 1000,
+        "VelodyneCloudNode: packet ring is full, dropping packets");
+      continue;
+    }
+    for (std::size_t idx = 0U; idx < static_cast<std::size_t>(received); ++idx) {
+      // Same as for the udp driver, the rest of a short packet is zero
+      const std::size_t length = messages[idx].msg_len;
+      if (length < sizeof(Packet)) {
+        std::memset(reinterpret_cast<uint8_t *>(&slots.first[idx]) + length, 0,
+          sizeof(Packet) - length);
+      }
+    }
+    m_packet_ring->commit(static_cast<std::size_t>(received));
+  }
+}
+
+template<typename T>
+void VelodyneCloudNode<T>::convert_packets()
+{
+  while (true) {
+    const auto packets = m_packet_ring->wait_for_packets();
+    if (packets.first == nullptr) {
+      break;
+    }
+    for (std::size_t idx = 0U; idx < packets.second; ++idx) {
+      convert_and_publish(packets.first[idx]);
+    }
+    m_packet_ring->release(packets.second);
+  }
+}
+
 template<typename T>
 void VelodyneCloudNode<T>::receiver_callback(const std::vector<uint8_t> & buffer)
 {
   Packet pkt{};
   std::memcpy(&pkt, &buffer[0], buffer.size());
+  convert_and_publish(pkt);
+}
+
+template<typename T>
+void VelodyneCloudNode<T>::convert_and_publish(const Packet & pkt)
+{
   try {
     // message received, convert and publish
     if (this->convert(pkt, m_pc2_msg)) {
       m_pc2_pub_ptr->publish(m_pc2_msg);
+      m_trace.mark(m_pc2_msg.header.stamp);
       while (this->get_output_remainder(m_pc2_msg)) {
         m_pc2_pub_ptr->publish(m_pc2_msg);
+        m_trace.mark(m_pc2_msg.header.stamp);
       }
     }
   } catch (const std::exception & e) {
@@ -96,6 +278,26 @@ void VelodyneCloudNode<T>::receiver_callback(const std::vector<uint8_t> & buffer
     throw;
   }
 }
+template<typename T>
+void VelodyneCloudNode<T>::on_twist(const geometry_msgs::msg::TwistStamped::SharedPtr msg)
+{
+  if (msg->header.frame_id != m_frame_id) {
+    RCLCPP_WARN_THROTTLE(
+      this->get_logger(), *this->get_clock(), 1000,
+      "Ignoring twist in frame %s, it must be expressed in the sensor frame %s",
+      msg->header.frame_id.c_str(), m_frame_id.c_str());
+    return;
+  }
+  const auto & linear = msg->twist.linear;
+  const auto & angular = msg->twist.angular;
+  std::lock_guard<std::mutex> lock{m_twist_mutex};
+  m_motion_compensator.set_twist(
+    {static_cast<float32_t>(linear.x), static_cast<float32_t>(linear.y),
+      static_cast<float32_t>(linear.z)},
+    {static_cast<float32_t>(angular.x), static_cast<float32_t>(angular.y),
+      static_cast<float32_t>(angular.z)});
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 template<typename T>
 void VelodyneCloudNode<T>::init_output(sensor_msgs::msg::PointCloud2 & output)
@@ -111,8 +313,8 @@ bool8_t VelodyneCloudNode<T>::convert(
   const Packet & pkt,
   sensor_msgs::msg::PointCloud2 & output)
 {
-  // This handles the case when the below loop exited due to containing extra points
   using autoware::common::types::PointXYZI;
+  using autoware::common::types::PointXYZIF;
   point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{output};
   if (m_published_cloud) {
     // reset the pointcloud
@@ -120,30 +322,53 @@ bool8_t VelodyneCloudNode<T>::convert(
     modifier.reserve(m_cloud_size);
     m_point_cloud_idx = 0;
 
-    // deserialize remainder into pointcloud
+    // Start the new cloud with the points that were converted after the previous one was complete
     m_published_cloud = false;
-    for (uint32_t idx = m_remainder_start_idx; idx < m_point_block.size(); ++idx) {
-      const autoware::common::types::PointXYZIF & pt = m_point_block[idx];
+    for (const PointXYZIF & pt : m_point_block) {
       modifier.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
       m_point_cloud_idx++;
     }
+    m_point_block.clear();
   }
-  m_translator.convert(pkt, m_point_block);
-  for (uint32_t idx = 0U; idx < m_point_block.size(); ++idx) {
-    const autoware::common::types::PointXYZIF & pt = m_point_block[idx];
-    if (static_cast<uint16_t>(autoware::common::types::PointXYZIF::END_OF_SCAN_ID) != pt.id) {
-      modifier.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
-      m_point_cloud_idx++;
-      if (modifier.size() >= m_cloud_size) {
+  // The twist is copied once per packet instead of taking the lock for every point
+  velodyne_driver::MotionCompensator motion_compensator;
+  if (m_deskew) {
+    std::lock_guard<std::mutex> lock{m_twist_mutex};
+    motion_compensator = m_motion_compensator;
+  }
+  // The points are written directly into the cloud, only the ones past its end are kept aside
+  m_translator.convert(
+    pkt, [this, &modifier, &motion_compensator](PointXYZIF pt, const float32_t time_s) {
+      const bool8_t end_of_scan = (static_cast<uint16_t>(PointXYZIF::END_OF_SCAN_ID) == pt.id);
+      const uint32_t sector = get_sector(time_s);
+      if (m_deskew) {
+        // A sector is published when it is complete, so its points are moved to its end
+        const float32_t reference_time_s = (m_num_sectors > 0U) ?
+          (static_cast<float32_t>(sector + 1U) * m_sector_period_s) : m_scan_period_s;
+        motion_compensator.compensate(pt, time_s, reference_time_s);
+      }
+      if (!m_published_cloud && !end_of_scan && (sector != m_cloud_sector) &&
+        (modifier.size() > 0U))
+      {
+        // The point starts the next sector
         m_published_cloud = true;
-        m_remainder_start_idx = idx;
+        m_cloud_sector = sector;
       }
-    } else {
-      m_published_cloud = true;
-      m_remainder_start_idx = idx;
-      break;
-    }
-  }
+      if (m_published_cloud) {
+        if (!end_of_scan) {
+          m_point_block.push_back(pt);
+        }
+      } else if (!end_of_scan) {
+        modifier.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
+        m_point_cloud_idx++;
+        m_cloud_sector = sector;
+        m_published_cloud = (modifier.size() >= m_cloud_size);
+      } else {
+        m_published_cloud = true;
+        // The times of the next scan start from zero again
+        m_cloud_sector = 0U;
+      }
+    });
   if (m_published_cloud) {
     // resize pointcloud down to its actual size
     modifier.resize(m_point_cloud_idx);
@@ -153,6 +378,18 @@ bool8_t VelodyneCloudNode<T>::convert(
   return m_published_cloud;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+uint32_t VelodyneCloudNode<T>::get_sector(const float32_t time_s) const
+{
+  if (m_num_sectors == 0U) {
+    return 0U;
+  }
+  // A scan can take slightly longer than the nominal period
+  const auto sector = static_cast<uint32_t>(std::max(time_s, 0.0F) / m_sector_period_s);
+  return std::min(sector, m_num_sectors - 1U);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 template<typename T>
 bool8_t VelodyneCloudNode<T>::get_output_remainder(sensor_msgs::msg::PointCloud2 & output)
@@ -170,3 +407,11 @@ template class VelodyneCloudNode<velodyne_driver::VLS128Data>;
 }  // namespace velodyne_nodes
 }  // namespace drivers
 }  // namespace autoware
+
+#include "rclcpp_components/register_node_macro.hpp"
+
+// This acts as an entry point, allowing the components to be
+// discoverable when the library is being loaded into a running process
+RCLCPP_COMPONENTS_REGISTER_NODE(autoware::drivers::velodyne_nodes::VLP16DriverNode)
+RCLCPP_COMPONENTS_REGISTER_NODE(autoware::drivers::velodyne_nodes::VLP32CDriverNode)
+RCLCPP_COMPONENTS_REGISTER_NODE(autoware::drivers::velodyne_nodes::VLS128DriverNode)
@@ -14,6 +14,7 @@
 //
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
+#include <helper_functions/thread_scheduling.hpp>
 #include <velodyne_nodes/velodyne_cloud_node.hpp>
 #include <rcutils/cmdline_parser.h>
 
@@ -35,6 +36,14 @@ int32_t main(const int32_t argc, char ** const argv)
     rclcpp::init(argc, argv);
 
     const auto run = [](const auto & nd_ptr) {
+        // The executor runs in this thread
+        using autoware::common::helper_functions::apply_thread_scheduling;
+        using autoware::common::helper_functions::declare_thread_scheduling;
+        const std::string error = apply_thread_scheduling(
+          declare_thread_scheduling(*nd_ptr, "executor_thread"), pthread_self());
+        if (!error.empty()) {
+          RCLCPP_WARN(nd_ptr->get_logger(), "Executor thread: %s", error.c_str());
+        }
         while (rclcpp::ok()) {
           rclcpp::spin(nd_ptr);
         }
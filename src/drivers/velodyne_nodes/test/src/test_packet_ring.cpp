@@ -0,0 +1,111 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <gtest/gtest.h>
+#include <velodyne_nodes/packet_ring.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using autoware::drivers::velodyne_nodes::PacketRing;
+
+TEST(PacketRing, Capacity)
+{
+  EXPECT_THROW(PacketRing<uint32_t>{0U}, std::domain_error);
+  PacketRing<uint32_t> ring{4U};
+  EXPECT_EQ(ring.capacity(), 4U);
+  EXPECT_EQ(ring.size(), 0U);
+}
+
+// The slots returned to the producer and the consumer are contiguous, so they end at the end of
+// the storage and continue from its start
+TEST(PacketRing, WrapAround)
+{
+  PacketRing<uint32_t> ring{4U};
+  auto slots = ring.free_slots(3U);
+  ASSERT_EQ(slots.second, 3U);
+  for (uint32_t idx = 0U; idx < 3U; ++idx) {
+    slots.first[idx] = idx;
+  }
+  ring.commit(3U);
+  auto packets = ring.wait_for_packets();
+  ASSERT_EQ(packets.second, 3U);
+  EXPECT_EQ(packets.first[2U], 2U);
+  ring.release(2U);
+  EXPECT_EQ(ring.size(), 1U);
+
+  // Only the last slot before the end of the storage is contiguous
+  slots = ring.free_slots(8U);
+  ASSERT_EQ(slots.second, 1U);
+  slots.first[0U] = 3U;
+  ring.commit(1U);
+  slots = ring.free_slots(8U);
+  ASSERT_EQ(slots.second, 2U);
+  slots.first[0U] = 4U;
+  slots.first[1U] = 5U;
+  ring.commit(2U);
+  EXPECT_EQ(ring.size(), 4U);
+  EXPECT_EQ(ring.free_slots(8U).second, 0U);
+
+  packets = ring.wait_for_packets();
+  ASSERT_EQ(packets.second, 2U);
+  EXPECT_EQ(packets.first[0U], 2U);
+  EXPECT_EQ(packets.first[1U], 3U);
+  ring.release(2U);
+  packets = ring.wait_for_packets();
+  ASSERT_EQ(packets.second, 2U);
+  EXPECT_EQ(packets.first[0U], 4U);
+  EXPECT_EQ(packets.first[1U], 5U);
+  ring.release(2U);
+  EXPECT_EQ(ring.size(), 0U);
+}
+
+TEST(PacketRing, ProducerConsumer)
+{
+  constexpr uint32_t kNumPackets = 10000U;
+  PacketRing<uint32_t> ring{16U};
+  std::vector<uint32_t> received;
+  std::thread consumer{[&ring, &received] {
+      while (true) {
+        const auto packets = ring.wait_for_packets();
+        if (packets.first == nullptr) {
+          break;
+        }
+        received.insert(received.end(), packets.first, packets.first + packets.second);
+        ring.release(packets.second);
+      }
+    }};
+  uint32_t next = 0U;
+  while (next < kNumPackets) {
+    const auto slots = ring.free_slots(5U);
+    std::size_t count = 0U;
+    for (; (count < slots.second) && (next < kNumPackets); ++count) {
+      slots.first[count] = next++;
+    }
+    ring.commit(count);
+  }
+  while (ring.size() > 0U) {
+    std::this_thread::yield();
+  }
+  ring.stop();
+  consumer.join();
+  ASSERT_EQ(received.size(), kNumPackets);
+  for (uint32_t idx = 0U; idx < kNumPackets; ++idx) {
+    EXPECT_EQ(received[idx], idx);
+  }
+}
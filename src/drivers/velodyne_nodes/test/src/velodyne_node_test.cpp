@@ -52,6 +52,27 @@ TEST(VelodyneNode, Constructor)
   }
   EXPECT_NO_THROW(VelodyneCloudNode(name, velodyne_options));
 
+  velodyne_params.emplace_back("packet_ring_size", 128);
+  velodyne_options.parameter_overrides(velodyne_params);
+  EXPECT_NO_THROW(VelodyneCloudNode(name, velodyne_options));
+  velodyne_params.back() = rclcpp::Parameter{"packet_ring_size", -1};
+  velodyne_options.parameter_overrides(velodyne_params);
+  EXPECT_THROW(VelodyneCloudNode(name, velodyne_options), std::runtime_error);
+  velodyne_params.pop_back();
+
+  velodyne_params.emplace_back("deskew", true);
+  velodyne_options.parameter_overrides(velodyne_params);
+  EXPECT_NO_THROW(VelodyneCloudNode(name, velodyne_options));
+  velodyne_params.pop_back();
+
+  velodyne_params.emplace_back("sectors_per_revolution", 8);
+  velodyne_options.parameter_overrides(velodyne_params);
+  EXPECT_NO_THROW(VelodyneCloudNode(name, velodyne_options));
+  velodyne_params.back() = rclcpp::Parameter{"sectors_per_revolution", -1};
+  velodyne_options.parameter_overrides(velodyne_params);
+  EXPECT_THROW(VelodyneCloudNode(name, velodyne_options), std::runtime_error);
+  velodyne_params.pop_back();
+
   velodyne_params.pop_back();
   velodyne_options.parameter_overrides(velodyne_params);
   EXPECT_THROW(
@@ -68,6 +89,7 @@ struct VelodyneNodeTestParam
   uint32_t expected_size;
   float32_t expected_period_ms;
   bool8_t is_cloud;
+  uint32_t packet_ring_size;
 };  // VelodyneNodeTestParam
 
 class VelodyneNodeIntegration : public ::testing::TestWithParam<VelodyneNodeTestParam>
@@ -95,6 +117,7 @@ TEST_P(VelodyneNodeIntegration, Test)
   velodyne_params.emplace_back("cloud_size", static_cast<int64_t>(param.reserved_size));
   velodyne_params.emplace_back("rpm", static_cast<int>(config.get_rpm()));
   velodyne_params.emplace_back("topic", topic);
+  velodyne_params.emplace_back("packet_ring_size", static_cast<int64_t>(param.packet_ring_size));
   rclcpp::NodeOptions velodyne_options = rclcpp::NodeOptions();
   velodyne_options.parameter_overrides(velodyne_params);
 
@@ -154,10 +177,16 @@ INSTANTIATE_TEST_CASE_P(
   Cloud,
   VelodyneNodeIntegration,
   // cppcheck-suppress syntaxError
-  ::testing::Values(VelodyneNodeTestParam{55000U, 30000U, 100.0F, true}), );
+  ::testing::Values(VelodyneNodeTestParam{55000U, 30000U, 100.0F, true, 0U}), );
 
 INSTANTIATE_TEST_CASE_P(
   HalfCloud,
   VelodyneNodeIntegration,
   // cppcheck-suppress syntaxError
-  ::testing::Values(VelodyneNodeTestParam{10700U, 10700U, 50.0F, true}), );
+  ::testing::Values(VelodyneNodeTestParam{10700U, 10700U, 50.0F, true, 0U}), );
+
+INSTANTIATE_TEST_CASE_P(
+  BatchedCloud,
+  VelodyneNodeIntegration,
+  // cppcheck-suppress syntaxError
+  ::testing::Values(VelodyneNodeTestParam{55000U, 30000U, 100.0F, true, 1024U}), );
@@ -22,11 +22,14 @@
 #include <common/types.hpp>
 #include <xsens_driver/xsens_common.hpp>
 #include <xsens_driver/visibility_control.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <mutex>
 #include <numeric>
+#include <stdexcept>
 #include <vector>
 
+#include "helper_functions/byte_reader.hpp"
 #include "helper_functions/crtp.hpp"
 
 using autoware::common::types::bool8_t;
@@ -68,6 +71,9 @@ protected:
 
   std::size_t current_length_;
 
+  // Reused for the content of each data item of an MTData2 message
+  std::vector<uint8_t> content_;
+
 public:
   XsensBaseTranslator()
   : current_state_(State::START) {}
@@ -154,30 +160,90 @@ public:
     return false;
   }
 
-  void parse_mtdata2(MessageT & output)
+  /// \brief Convert a whole read of the serial stream into ROS messages.
+  ///        This behaves like feeding the bytes one by one to the packet overload, except that
+  ///        the data bytes of a frame are copied in one go. A frame may be split across several
+  ///        reads, and a read may contain several frames.
+  /// \param[in] bytes The bytes of the read
+  /// \param[inout] outputs One message is appended per MTData2 frame that is completed
+  /// \return The number of messages appended to outputs
+  std::size_t convert(const std::vector<uint8_t> & bytes, std::vector<MessageT> & outputs)
   {
-    auto data = raw_message_;
-
-    // Read bytes from the byte vector until there are no more messages left
-    while (!data.empty()) {
-      const int32_t data_id = data[1] | data[0] << 8;
-      const int32_t message_size = data[2];
-
-      // Create a slice from the byte vector, skipping the first three bytes (data_id and
-      // message_size)
-      auto content = decltype(data)(
-        std::begin(data) + 3,
-        std::begin(data) + 3 + message_size);
+    const std::size_t num_outputs = outputs.size();
+    // The last element of outputs is used as scratch space for the frame being parsed
+    outputs.emplace_back();
+    try {
+      std::size_t i = 0U;
+      while (i < bytes.size()) {
+        if ((current_state_ == State::LENGTH_READ) && (raw_message_.size() < current_length_)) {
+          const std::size_t count =
+            std::min(current_length_ - raw_message_.size(), bytes.size() - i);
+          const auto begin = std::begin(bytes) + static_cast<std::ptrdiff_t>(i);
+          raw_message_.insert(
+            std::end(raw_message_), begin, begin + static_cast<std::ptrdiff_t>(count));
+          i += count;
+          continue;
+        }
+        const Packet pkt{bytes[i]};
+        ++i;
+        if (convert(pkt, outputs.back()) && (current_mid_ == MID::MT_DATA2)) {
+          outputs.emplace_back();
+        }
+      }
+    } catch (...) {
+      outputs.pop_back();
+      throw;
+    }
+    outputs.pop_back();
+    return outputs.size() - num_outputs;
+  }
 
-      // Overwrite data with the bytes after the slice
-      data = decltype(data)(
-        std::begin(data) + 3 + message_size,
-        std::end(data));
+  void parse_mtdata2(MessageT & output)
+  {
+    // Walk the data items of the message, each of which is a two byte data_id followed by a one
+    // byte size and the content
+    std::size_t offset = 0U;
+    while (offset < raw_message_.size()) {
+      if (offset + 3U > raw_message_.size()) {
+        throw std::runtime_error("Truncated MTData2 message");
+      }
+      const int32_t data_id = raw_message_[offset + 1U] | raw_message_[offset] << 8;
+      const std::size_t message_size = raw_message_[offset + 2U];
+      const std::size_t content_end = offset + 3U + message_size;
+      if (content_end > raw_message_.size()) {
+        throw std::runtime_error("Truncated MTData2 message");
+      }
+      content_.assign(
+        std::begin(raw_message_) + static_cast<std::ptrdiff_t>(offset + 3U),
+        std::begin(raw_message_) + static_cast<std::ptrdiff_t>(content_end));
+      offset = content_end;
 
       int32_t group = data_id & 0xF800;
       XDIGroup xdigroup = XDIGroup_from_int(static_cast<uint16_t>(group));
       // Dispatch the rest of the parsing to the translator specialization via CRTP
-      this->impl().parse_xdigroup_mtdata2(xdigroup, output, data_id, content);
+      this->impl().parse_xdigroup_mtdata2(xdigroup, output, data_id, content_);
+    }
+  }
+
+  /// \brief Set the stamp of a header from the timestamp group of an MTData2 message.
+  ///        Only SampleTimeFine, which counts ticks of 100 us since the device started, is used
+  ///        so that the stamp is the time the device took the sample. It wraps around after
+  ///        2^32 ticks, i.e. about five days.
+  template<typename HeaderT>
+  void parse_timestamp_header(
+    HeaderT & header,
+    int32_t data_id,
+    const std::vector<uint8_t> & content)
+  {
+    const Timestamp value = Timestamp_from_int(static_cast<uint8_t>(data_id & 0x00F0));
+    if (value == Timestamp::SAMPLE_TIME_FINE) {
+      constexpr uint32_t kTicksPerSecond = 10000U;
+      constexpr uint32_t kNanosecondsPerTick = 100000U;
+      autoware::common::helper_functions::ByteReader byte_reader(content);
+      uint32_t ticks = 0U;
+      byte_reader.read(ticks);
+      header.stamp.sec = static_cast<int32_t>(ticks / kTicksPerSecond);
+      header.stamp.nanosec = (ticks % kTicksPerSecond) * kNanosecondsPerTick;
     }
   }
 };
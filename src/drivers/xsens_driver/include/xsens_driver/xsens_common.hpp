@@ -178,6 +178,20 @@ enum class GNSS : uint8_t
 
 XSENS_DRIVER_PUBLIC GNSS GNSS_from_int(uint8_t value);
 
+enum class Timestamp : uint8_t
+{
+  UTC_TIME = 0x10,
+  PACKET_COUNTER = 0x20,
+  ITOW = 0x30,
+  GPS_AGE = 0x40,
+  PRESSURE_AGE = 0x50,
+  SAMPLE_TIME_FINE = 0x60,
+  SAMPLE_TIME_COARSE = 0x70,
+  FRAME_RANGE = 0x80,
+};
+
+XSENS_DRIVER_PUBLIC Timestamp Timestamp_from_int(uint8_t value);
+
 }  // namespace xsens_driver
 }  // namespace drivers
 }  // namespace autoware
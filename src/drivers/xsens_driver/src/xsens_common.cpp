@@ -175,6 +175,30 @@ GNSS GNSS_from_int(uint8_t value)
   }
 }
 
+Timestamp Timestamp_from_int(uint8_t value)
+{
+  switch (value) {
+    case 0x10:
+      return Timestamp::UTC_TIME;
+    case 0x20:
+      return Timestamp::PACKET_COUNTER;
+    case 0x30:
+      return Timestamp::ITOW;
+    case 0x40:
+      return Timestamp::GPS_AGE;
+    case 0x50:
+      return Timestamp::PRESSURE_AGE;
+    case 0x60:
+      return Timestamp::SAMPLE_TIME_FINE;
+    case 0x70:
+      return Timestamp::SAMPLE_TIME_COARSE;
+    case 0x80:
+      return Timestamp::FRAME_RANGE;
+    default:
+      throw std::runtime_error("Unknown value: " + std::to_string(value));
+  }
+}
+
 }  // namespace xsens_driver
 }  // namespace drivers
 }  // namespace autoware
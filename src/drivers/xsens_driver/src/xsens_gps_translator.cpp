@@ -57,6 +57,7 @@ void XsensGpsTranslator::parse_xdigroup_mtdata2(
     case XDIGroup::TEMPERATURE:
       break;
     case XDIGroup::TIMESTAMP:
+      parse_timestamp_header(message.header, data_id, content);
       break;
     case XDIGroup::ORIENTATION_DATA:
       break;
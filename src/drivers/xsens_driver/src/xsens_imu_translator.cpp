@@ -95,9 +95,7 @@ void XsensImuTranslator::parse_timestamp(
   int32_t data_id,
   const std::vector<uint8_t> & content)
 {
-  (void)message;
-  (void)data_id;
-  (void)content;
+  parse_timestamp_header(message.header, data_id, content);
 }
 
 void XsensImuTranslator::parse_acceleration(
@@ -57,6 +57,43 @@ protected:
     pkt.data = data[length];
     ASSERT_TRUE(driver.convert(pkt, out));
   }
+
+  /// Feed the frame to the buffered overload as one read, split into two reads at every
+  /// position, and twice in one read with noise in front of it
+  void xsens_driver_buffered_test(const std::vector<uint8_t> & data)
+  {
+    const typename TranslatorT::Config cfg{};
+    std::vector<uint8_t> frame = {
+      0xFA, 0xFF, static_cast<MID_underlying_type>(MID::MT_DATA2),
+      static_cast<uint8_t>(data.size() - 1)};
+    frame.insert(frame.end(), data.begin(), data.end());
+    {
+      TranslatorT driver(cfg);
+      outs.clear();
+      ASSERT_EQ(driver.convert(frame, outs), 1U);
+      ASSERT_EQ(outs.size(), 1U);
+    }
+    for (std::size_t split = 1U; split < frame.size(); ++split) {
+      TranslatorT driver(cfg);
+      const std::vector<uint8_t> first(frame.begin(), frame.begin() + split);
+      const std::vector<uint8_t> second(frame.begin() + split, frame.end());
+      outs.clear();
+      ASSERT_EQ(driver.convert(first, outs), 0U);
+      ASSERT_EQ(driver.convert(second, outs), 1U);
+      ASSERT_EQ(outs.size(), 1U);
+    }
+    {
+      TranslatorT driver(cfg);
+      std::vector<uint8_t> bytes = {0x00, 0xFA, 0x01};
+      bytes.insert(bytes.end(), frame.begin(), frame.end());
+      bytes.insert(bytes.end(), frame.begin(), frame.end());
+      outs.clear();
+      ASSERT_EQ(driver.convert(bytes, outs), 2U);
+      ASSERT_EQ(outs.size(), 2U);
+    }
+  }
+
+  std::vector<MessageT> outs;
 };  // class xsens_driver_common
 
 #endif  // XSENS_DRIVER__TEST_XSENS_COMMON_HPP_
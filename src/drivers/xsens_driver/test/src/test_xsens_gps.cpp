@@ -44,6 +44,13 @@ TEST_F(XsensDriver, Basic)
   };
 
   xsens_driver_common_test(data);
+  // SampleTimeFine of 0x22D55897 ticks of 100 us
+  EXPECT_EQ(out.header.stamp.sec, 58440);
+  EXPECT_EQ(out.header.stamp.nanosec, 719100000U);
+
+  xsens_driver_buffered_test(data);
+  EXPECT_EQ(outs[1].header.stamp.sec, 58440);
+  EXPECT_EQ(outs[1].header.stamp.nanosec, 719100000U);
 }
 
 int32_t main(int32_t argc, char ** argv)
@@ -31,6 +31,7 @@
 #include <utility>
 #include <limits>
 #include <array>
+#include <cstddef>
 #include "common/types.hpp"
 
 using autoware::common::types::bool8_t;
@@ -49,7 +50,9 @@ namespace hungarian_assigner
 using index_t = Eigen::Index;
 
 /// \brief implementation of the hungarian/kuhn-munkres/jacobi algorithm for
-/// minimum weight assignment problem in O(N^3 ) time
+/// minimum weight assignment problem in O(N^3 ) time. The matrices are stored for the full
+/// capacity, but a problem of num_cols columns only uses their first num_cols x num_cols
+/// entries, as one contiguous block, so the work and memory traffic scale with the problem size
 /// \tparam Capacity maximum number of things that can be matched, sets matrix size
 template<uint16_t Capacity>
 class HUNGARIAN_ASSIGNER_PUBLIC hungarian_assigner_c
@@ -68,6 +71,14 @@ class HUNGARIAN_ASSIGNER_PUBLIC hungarian_assigner_c
   /// \brief this definition is for internal book-keeping
   using index2_t = std::pair<index_t, index_t>;
 
+  /// \brief view of the active num_cols x num_cols block of a matrix storage
+  template<typename T>
+  using block_t = Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>;
+  template<typename T>
+  using const_block_t = Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>;
+  template<typename T>
+  using storage_t = std::array<T, static_cast<std::size_t>(Capacity) * Capacity>;
+
   /// \brief This exception is for a bad edge case when the assigner tries to add a new zero
   ///        but the only uncovered entries in the matrix are not valid links/weights
   class HUNGARIAN_ASSIGNER_LOCAL no_uncovered_values_c : public std::runtime_error
@@ -91,7 +102,7 @@ public:
   hungarian_assigner_c(const index_t num_rows, const index_t num_cols);
 
   /// \brief set the size of the matrix. Must be less than capacity. This should be done before
-  ///        set_weight() calls
+  ///        set_weight() calls, and clears the weights of the active block
   /// \param[in] num_rows number of rows/jobs
   /// \param[in] num_cols number of columns/workers
   /// \throw std::length_error if num_rows or num_cols is bigger than capacity
@@ -173,11 +184,23 @@ private:
   /// \brief update internal bookkeeping for which rows and columns are uncovered
   HUNGARIAN_ASSIGNER_LOCAL void update_uncovered_rows_and_cols();
 
+  /// \brief view a matrix storage as the active block, with a column stride of num_cols
+  template<typename T>
+  block_t<T> active_block(storage_t<T> & storage) const
+  {
+    return block_t<T>(storage.data(), m_num_cols, m_num_cols);
+  }
+  template<typename T>
+  const_block_t<T> active_block(const storage_t<T> & storage) const
+  {
+    return const_block_t<T>(storage.data(), m_num_cols, m_num_cols);
+  }
+
   // TODO(gowtham.ranganathan): Workaround. There should be no need for m_is_max_matrix after #979
   // Matrix to track if a weight is unset (set to max means unset)
-  Eigen::Matrix<bool8_t, Capacity, Capacity> m_is_max_matrix;
-  Eigen::Matrix<float32_t, Capacity, Capacity> m_weight_matrix;
-  Eigen::Matrix<int8_t, Capacity, Capacity> m_mark_matrix;
+  storage_t<bool8_t> m_is_max_matrix;
+  storage_t<float32_t> m_weight_matrix;
+  storage_t<int8_t> m_mark_matrix;
   Eigen::Matrix<index_t, Capacity, 1> m_row_min_idx;
   index_t m_num_rows;
   index_t m_num_cols;
@@ -0,0 +1,160 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 the Autoware Foundation
+/// \file
+/// \brief Header for a sparse minimum weight assignment solver
+#ifndef HUNGARIAN_ASSIGNER__SPARSE_ASSIGNER_HPP_
+#define HUNGARIAN_ASSIGNER__SPARSE_ASSIGNER_HPP_
+
+#include <hungarian_assigner/visibility_control.hpp>
+#include <Eigen/Core>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "common/types.hpp"
+
+namespace autoware
+{
+namespace fusion
+{
+namespace hungarian_assigner
+{
+
+using autoware::common::types::bool8_t;
+using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
+
+/// \brief indexing matches what matrices use
+using index_t = Eigen::Index;
+
+/// \brief Minimum weight assignment for problems where most assignments are impossible, e.g.
+///        tracks and detections that are gated by distance. Only the possible assignments are
+///        stored, as edges of a bipartite graph. The graph is split into connected components,
+///        i.e. clusters of rows and columns that share no possible assignment with the rest,
+///        and each component is solved separately by successive shortest augmenting paths with
+///        Dijkstra's algorithm on reduced weights (the Jonker-Volgenant family of solvers).
+///
+///        The result assigns as many rows as possible and has the minimum total weight among
+///        such assignments, which is the result of hungarian_assigner_c whenever every row can be
+///        assigned. Solving a component with k rows and e possible assignments takes
+///        O(k e log(e)) time, compared to O(N^3) for the dense matrix of all rows and columns.
+///
+///        Unlike hungarian_assigner_c, there is no maximum capacity and no restriction on the
+///        shape of the problem. Memory is only allocated when a problem is larger than any
+///        problem before.
+class HUNGARIAN_ASSIGNER_PUBLIC sparse_assigner_c
+{
+public:
+  /// \brief This index denotes a worker for which no job assignment was possible
+  static constexpr index_t UNASSIGNED = std::numeric_limits<index_t>::max();
+
+  /// \brief constructor
+  sparse_assigner_c() = default;
+
+  /// \brief constructor, equivalent of construct(); set_size(num_rows, num_cols)
+  /// \param[in] num_rows number of rows/jobs
+  /// \param[in] num_cols number of columns/workers
+  sparse_assigner_c(const index_t num_rows, const index_t num_cols);
+
+  /// \brief set the size of the problem. This should be done before set_weight() calls
+  /// \param[in] num_rows number of rows/jobs
+  /// \param[in] num_cols number of columns/workers
+  /// \throw std::domain_error if num_rows or num_cols is negative
+  void set_size(const index_t num_rows, const index_t num_cols);
+
+  /// \brief set the weight of a possible assignment. Assignments without a weight are
+  ///        impossible. If the weight of an assignment is set several times, the smallest one
+  ///        is used.
+  /// \param[in] weight the weight for assignment of job idx to worker jdx
+  /// \param[in] idx the index of the job
+  /// \param[in] jdx the index of the worker
+  /// \throw std::out_of_range if idx or jdx are outside of range specified by set_size()
+  /// \throw std::domain_error if the weight is negative or not finite
+  void set_weight(const float32_t weight, const index_t idx, const index_t jdx);
+
+  /// \brief reset the weights and the result, must be called after assign(), and before
+  ///        set_weight()
+  void reset();
+
+  /// \brief reset and set_size, equivalent to reset(); set_size(num_rows, num_cols);
+  /// \param[in] num_rows number of rows/jobs
+  /// \param[in] num_cols number of columns/workers
+  void reset(const index_t num_rows, const index_t num_cols);
+
+  /// \brief compute minimum cost assignment
+  /// \return true if every row/job was assigned a column/worker. Otherwise, get_assignment()
+  ///         returns UNASSIGNED for some rows.
+  bool8_t assign();
+
+  /// \brief dictate what the assignment for a given row/task is, should be called after assign()
+  /// \param[in] idx the index for the task, starting at 0
+  /// \return the index for the assigned job, starting at 0, or UNASSIGNED
+  /// \throw std::range_error if idx is out of bounds or assign() was not called
+  index_t get_assignment(const index_t idx) const;
+
+  /// \brief get the number of connected components that the last assign() solved separately
+  index_t get_num_components() const noexcept {return m_num_components;}
+
+private:
+  /// \brief a possible assignment
+  struct edge_t
+  {
+    index_t row;
+    index_t col;
+    float32_t weight;
+  };
+
+  /// \brief find the representative of a node in the union-find forest, with path halving
+  HUNGARIAN_ASSIGNER_LOCAL index_t find_root(index_t node);
+
+  /// \brief group the rows, columns and edges by connected component
+  HUNGARIAN_ASSIGNER_LOCAL void find_components();
+
+  /// \brief assign the rows of a component by successive shortest augmenting paths
+  HUNGARIAN_ASSIGNER_LOCAL void solve_component(const index_t component);
+
+  /// \brief find a shortest augmenting path from the free rows of a component to a free column
+  ///        and augment the assignment along it, return false if there is none
+  HUNGARIAN_ASSIGNER_LOCAL bool8_t augment(const index_t component);
+
+  index_t m_num_rows{};
+  index_t m_num_cols{};
+  bool8_t m_is_assigned{false};
+  index_t m_num_components{};
+  std::vector<edge_t> m_edges;
+  // rows and columns are nodes of the graph, columns are offset by m_num_rows
+  std::vector<index_t> m_parent;
+  // edges of each row, sorted by row
+  std::vector<index_t> m_row_edges;
+  std::vector<index_t> m_row_edges_begin;
+  // nodes of each component, and the begin of each component in it
+  std::vector<index_t> m_component_nodes;
+  std::vector<index_t> m_component_begin;
+  std::vector<index_t> m_component_of;
+  // assignment state: the assigned edge of each row, the assigned row of each column
+  std::vector<index_t> m_row_edge;
+  std::vector<index_t> m_col_row;
+  // shortest path state: potentials and distances for the nodes, and the sink
+  std::vector<float64_t> m_potential;
+  std::vector<float64_t> m_distance;
+  std::vector<index_t> m_predecessor;
+  std::vector<bool8_t> m_is_done;
+  std::vector<std::pair<float64_t, index_t>> m_heap;
+};  // class sparse_assigner_c
+
+}  // namespace hungarian_assigner
+}  // namespace fusion
+}  // namespace autoware
+#endif  // HUNGARIAN_ASSIGNER__SPARSE_ASSIGNER_HPP_
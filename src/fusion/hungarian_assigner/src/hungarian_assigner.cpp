@@ -53,16 +53,9 @@ template<uint16_t Capacity>
 hungarian_assigner_c<Capacity>::hungarian_assigner_c(
   const index_t num_rows,
   const index_t num_cols)
-: m_weight_matrix(
-    Eigen::MatrixXf::Constant(
-      Capacity,
-      Capacity,
-      std::numeric_limits<float32_t>::max())),
-  m_mark_matrix(
-    Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic>::Constant(
-      Capacity,
-      Capacity,
-      static_cast<int8_t>(NO_LINK))),
+: m_is_max_matrix(),  // zero/false initialized
+  m_weight_matrix(),  // zero initialization
+  m_mark_matrix(),  // zero/NO_LINK initialized
   m_row_min_idx(Eigen::Matrix<index_t, Capacity, 1>::Constant(UNASSIGNED)),
   m_num_rows(num_rows),
   m_num_cols(num_cols),
@@ -98,6 +91,11 @@ void hungarian_assigner_c<Capacity>::set_size(const index_t num_rows, const inde
   }
   m_num_rows = num_rows;
   m_num_cols = num_cols;
+  // set the weights of the active block to infinity, rows are padded up to the number of columns
+  active_block(m_weight_matrix).setConstant(MAX_WEIGHT);
+  // TODO(gowtham.ranganathan): workaround. Should be NO_LINK after #979 is fixed
+  active_block(m_mark_matrix).setConstant(static_cast<int8_t>(UNMARKED));
+  active_block(m_is_max_matrix).setConstant(true);
   // initialize assignments to "unassigned"
   const index_t max_assignments = std::max(num_rows, num_cols);
   for (index_t idx = index_t(); idx < max_assignments; ++idx) {
@@ -118,22 +116,17 @@ void hungarian_assigner_c<Capacity>::set_weight(
   if (weight >= MAX_WEIGHT) {
     throw std::out_of_range("Cannot set weight greater than or equal to MAX_WEIGHT");
   }
-  // rely on eigen's matrix to throw an error
-  m_weight_matrix(idx, jdx) = weight;
-  m_mark_matrix(idx, jdx) = static_cast<int8_t>(UNMARKED);
-  m_is_max_matrix(idx, jdx) = false;
+  active_block(m_weight_matrix)(idx, jdx) = weight;
+  active_block(m_mark_matrix)(idx, jdx) = static_cast<int8_t>(UNMARKED);
+  active_block(m_is_max_matrix)(idx, jdx) = false;
 }
 
 ///
 template<uint16_t Capacity>
 void hungarian_assigner_c<Capacity>::reset()
 {
-  // set all weights to infinity
-  m_weight_matrix.fill(MAX_WEIGHT);
+  // the weight matrix of the next size is reset by set_size()
   m_row_min_weights.fill(MAX_WEIGHT);
-  // reset assignment
-  // TODO(gowtham.ranganathan): workaround. Should be NO_LINK after #979 is fixed
-  m_mark_matrix.fill(static_cast<int8_t>(UNMARKED));
   // reset size
   m_num_cols = index_t();
   m_num_rows = index_t();
@@ -141,7 +134,6 @@ void hungarian_assigner_c<Capacity>::reset()
   m_is_col_covered.fill(false);
   m_is_row_covered.fill(false);
   m_row_min_idx.fill(UNASSIGNED);
-  m_is_max_matrix.fill(true);
 }
 
 ///
@@ -155,8 +147,10 @@ void hungarian_assigner_c<Capacity>::reset(const index_t num_rows, const index_t
 template<uint16_t Capacity>
 void hungarian_assigner_c<Capacity>::find_minimums()
 {
-  for (auto i = index_t(); i < m_weight_matrix.rows(); ++i) {
-    m_row_min_weights[i] = m_weight_matrix.row(i).minCoeff(&m_row_min_idx[i]);
+  // only the rows with weights, the padded rows are zero
+  const auto weights = active_block(m_weight_matrix);
+  for (auto i = index_t(); i < m_num_rows; ++i) {
+    m_row_min_weights[i] = weights.row(i).minCoeff(&m_row_min_idx[i]);
   }
 }
 
@@ -170,11 +164,11 @@ bool8_t hungarian_assigner_c<Capacity>::assign()
     // pad 0's in unbalanced case
     if (m_num_rows < m_num_cols) {
       const index_t num_pad = m_num_cols - m_num_rows;
-      m_weight_matrix.block(m_num_rows, index_t(), num_pad, m_num_cols) =
+      active_block(m_weight_matrix).block(m_num_rows, index_t(), num_pad, m_num_cols) =
         Eigen::MatrixXf::Zero(num_pad, m_num_cols);
       m_row_min_weights.segment(m_num_rows, num_pad) =
         Eigen::ArrayXf::Zero(num_pad);
-      m_mark_matrix.block(m_num_rows, index_t(), num_pad, m_num_cols) =
+      active_block(m_mark_matrix).block(m_num_rows, index_t(), num_pad, m_num_cols) =
         Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic>::Constant(
         num_pad,
         m_num_cols,
@@ -211,7 +205,7 @@ index_t hungarian_assigner_c<Capacity>::get_assignment(const index_t idx) const
   }
   const auto ret = m_assignments[idx];
   // TODO(gowtham.ranganathan): Workaround. There should be no need to check this after #979.
-  if (ret != UNASSIGNED && m_is_max_matrix(idx, ret)) {
+  if (ret != UNASSIGNED && active_block(m_is_max_matrix)(idx, ret)) {
     return UNASSIGNED;
   }
   return ret;
@@ -234,21 +228,22 @@ index_t hungarian_assigner_c<Capacity>::get_unassigned(const index_t idx) const
 template<uint16_t Capacity>
 bool8_t hungarian_assigner_c<Capacity>::reduce_rows_and_init_zeros_and_check_result()
 {
+  auto marks = active_block(m_mark_matrix);
   // we should already know what the minimum weight is for each row
   // decrement each row by given weight
-  auto blk = m_weight_matrix.block(0, 0, m_num_rows, m_num_cols);
+  auto blk = active_block(m_weight_matrix).block(0, 0, m_num_rows, m_num_cols);
   blk.colwise() -=
     m_row_min_weights.segment(0, m_num_rows);
   // don't do subtraction for the zero padded rows
   for (index_t row_idx = index_t(); row_idx < m_num_rows; ++row_idx) {
     const index_t col_idx = m_row_min_idx[row_idx];
     if (col_idx != UNASSIGNED) {
-      m_mark_matrix(row_idx, col_idx) = static_cast<int8_t>(ZERO);
+      marks(row_idx, col_idx) = static_cast<int8_t>(ZERO);
       if (!m_is_col_covered[col_idx]) {
         // row and column is covered by me
         m_is_col_covered[col_idx] = true;
         // update STAR
-        m_mark_matrix(row_idx, col_idx) = static_cast<int8_t>(STARRED);
+        marks(row_idx, col_idx) = static_cast<int8_t>(STARRED);
         // update assignment
         m_assignments[row_idx] = col_idx;
       }
@@ -260,7 +255,7 @@ bool8_t hungarian_assigner_c<Capacity>::reduce_rows_and_init_zeros_and_check_res
       if (!(m_is_col_covered[jdx])) {
         m_is_col_covered[jdx] = true;
         m_assignments[idx] = jdx;
-        m_mark_matrix(idx, jdx) = static_cast<int8_t>(STARRED);
+        marks(idx, jdx) = static_cast<int8_t>(STARRED);
         break;
       }
     }
@@ -275,6 +270,7 @@ bool8_t hungarian_assigner_c<Capacity>::reduce_rows_and_init_zeros_and_check_res
 template<uint16_t Capacity>
 bool8_t hungarian_assigner_c<Capacity>::increment_starred_zeroes_and_check_result(index2_t loc)
 {
+  auto marks = active_block(m_mark_matrix);
   // TODO(c.ho) maybe keep augment_path local
   // update path:
   index_t path_size = 1U;
@@ -285,7 +281,7 @@ bool8_t hungarian_assigner_c<Capacity>::increment_starred_zeroes_and_check_resul
     // find star in col
     bool8_t found = false;
     for (index_t jdx = index_t(); jdx < m_num_cols; ++jdx) {
-      if (m_mark_matrix(jdx, loc.second) == static_cast<int8_t>(STARRED)) {
+      if (marks(jdx, loc.second) == static_cast<int8_t>(STARRED)) {
         found = true;
         loc.first = jdx;
         m_augment_path[path_size] = loc;
@@ -300,7 +296,7 @@ bool8_t hungarian_assigner_c<Capacity>::increment_starred_zeroes_and_check_resul
     // update row, col in path: find prime in row
     found = false;
     for (index_t jdx = index_t(); jdx < m_num_cols; ++jdx) {
-      if (m_mark_matrix(loc.first, jdx) == static_cast<int8_t>(PRIMED)) {
+      if (marks(loc.first, jdx) == static_cast<int8_t>(PRIMED)) {
         loc.second = jdx;
         m_augment_path[path_size] = loc;
         ++path_size;
@@ -317,10 +313,10 @@ bool8_t hungarian_assigner_c<Capacity>::increment_starred_zeroes_and_check_resul
   for (index_t idx = index_t(); idx < path_size; ++idx) {
     const index_t row_idx = m_augment_path[idx].first;
     const index_t col_idx = m_augment_path[idx].second;
-    if (m_mark_matrix(row_idx, col_idx) == static_cast<int8_t>(STARRED)) {
-      m_mark_matrix(row_idx, col_idx) = static_cast<int8_t>(ZERO);
+    if (marks(row_idx, col_idx) == static_cast<int8_t>(STARRED)) {
+      marks(row_idx, col_idx) = static_cast<int8_t>(ZERO);
     } else {
-      m_mark_matrix(row_idx, col_idx) = static_cast<int8_t>(STARRED);
+      marks(row_idx, col_idx) = static_cast<int8_t>(STARRED);
       m_assignments[row_idx] = col_idx;
     }
   }
@@ -338,8 +334,8 @@ bool8_t hungarian_assigner_c<Capacity>::increment_starred_zeroes_and_check_resul
   // erase all primes
   for (index_t idx = index_t(); idx < m_num_primed_zeros; ++idx) {
     loc = m_primed_zero_locs[idx];
-    if (m_mark_matrix(loc.first, loc.second) == static_cast<int8_t>(PRIMED)) {
-      m_mark_matrix(loc.first, loc.second) = static_cast<int8_t>(ZERO);
+    if (marks(loc.first, loc.second) == static_cast<int8_t>(PRIMED)) {
+      marks(loc.first, loc.second) = static_cast<int8_t>(ZERO);
     }
   }
   m_num_primed_zeros = index_t();
@@ -354,6 +350,7 @@ template<uint16_t Capacity>
 typename hungarian_assigner_c<Capacity>::index2_t
 hungarian_assigner_c<Capacity>::prime_uncovered_zero()
 {
+  auto marks = active_block(m_mark_matrix);
   index2_t loc;
   // upper bound number of iterations to N, since entering outer loop is only columns
   // each iteration can swap one col to row, which can happen at most row times, so N
@@ -366,7 +363,7 @@ hungarian_assigner_c<Capacity>::prime_uncovered_zero()
       }
     }
     // prime zero and look for star in row
-    m_mark_matrix(loc.first, loc.second) = static_cast<int8_t>(PRIMED);
+    marks(loc.first, loc.second) = static_cast<int8_t>(PRIMED);
     if (m_num_primed_zeros < Capacity) {
       m_primed_zero_locs[m_num_primed_zeros] = loc;
       ++m_num_primed_zeros;
@@ -377,7 +374,7 @@ hungarian_assigner_c<Capacity>::prime_uncovered_zero()
     bool8_t found = false;
     index_t star_col;
     for (index_t jdx = index_t(); jdx < m_num_cols; ++jdx) {
-      if (m_mark_matrix(loc.first, jdx) == static_cast<int8_t>(STARRED)) {
+      if (marks(loc.first, jdx) == static_cast<int8_t>(STARRED)) {
         star_col = jdx;
         found = true;
         break;
@@ -398,26 +395,28 @@ hungarian_assigner_c<Capacity>::prime_uncovered_zero()
 template<uint16_t Capacity>
 bool8_t hungarian_assigner_c<Capacity>::add_new_zero(index2_t & loc)
 {
+  auto marks = active_block(m_mark_matrix);
   // find minimum nonzero'd value
   float32_t min_val;
   const bool8_t ret = find_minimum_uncovered_value(loc, min_val);
   if (ret) {
+    auto weights = active_block(m_weight_matrix);
     // add to covered rows
     for (index_t idx = index_t(); idx < m_num_cols; ++idx) {
       if (m_is_row_covered[idx]) {
-        m_weight_matrix.block(idx, index_t(), 1U, m_num_cols) +=
+        weights.block(idx, index_t(), 1U, m_num_cols) +=
           Eigen::MatrixXf::Constant(1, m_num_cols, min_val);
       }
     }
     // subtract from uncovered columns
     for (index_t idx = index_t(); idx < m_num_cols; ++idx) {
       if (!m_is_col_covered[idx]) {
-        m_weight_matrix.block(index_t(), idx, m_num_cols, 1U) -=
+        weights.block(index_t(), idx, m_num_cols, 1U) -=
           Eigen::MatrixXf::Constant(m_num_cols, 1, min_val);
       }
     }
     // add as a zero
-    m_mark_matrix(loc.first, loc.second) = static_cast<int8_t>(ZERO);
+    marks(loc.first, loc.second) = static_cast<int8_t>(ZERO);
   }
   return ret;
 }
@@ -437,12 +436,13 @@ bool8_t hungarian_assigner_c<Capacity>::are_all_columns_covered() const
 template<uint16_t Capacity>
 bool8_t hungarian_assigner_c<Capacity>::find_uncovered_zero(index2_t & loc) const
 {
+  auto marks = active_block(m_mark_matrix);
   bool8_t found = false;
   for (index_t idx = index_t(); idx < m_num_uncovered_rows; ++idx) {
     for (index_t jdx = index_t(); jdx < m_num_uncovered_cols; ++jdx) {
       const index_t row_idx = m_uncovered_rows[idx];
       const index_t col_idx = m_uncovered_cols[jdx];
-      const int8_t mark = static_cast<int8_t>(m_mark_matrix(row_idx, col_idx));
+      const int8_t mark = static_cast<int8_t>(marks(row_idx, col_idx));
       if ((mark != static_cast<int8_t>(NO_LINK)) &&
         ((mark == static_cast<int8_t>(ZERO)) ||
         (mark == static_cast<int8_t>(PRIMED))))
@@ -467,6 +467,8 @@ bool8_t hungarian_assigner_c<Capacity>::find_minimum_uncovered_value(
   index2_t & loc,
   float32_t & min_val) const
 {
+  const auto weights = active_block(m_weight_matrix);
+  const auto marks = active_block(m_mark_matrix);
   // I don't need to update uncovered because this will always be called
   // after find_uncovered_zero()
   // update_uncovered_rows_and_cols();
@@ -476,8 +478,8 @@ bool8_t hungarian_assigner_c<Capacity>::find_minimum_uncovered_value(
     for (index_t jdx = index_t(); jdx < m_num_uncovered_cols; ++jdx) {
       const index_t row_idx = m_uncovered_rows[idx];
       const index_t col_idx = m_uncovered_cols[jdx];
-      if (m_mark_matrix(row_idx, col_idx) != static_cast<int8_t>(NO_LINK)) {
-        const float32_t val = m_weight_matrix(row_idx, col_idx);
+      if (marks(row_idx, col_idx) != static_cast<int8_t>(NO_LINK)) {
+        const float32_t val = weights(row_idx, col_idx);
         if (val < min_val) {
           ret = true;
           min_val = val;
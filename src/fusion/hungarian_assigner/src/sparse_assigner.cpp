@@ -0,0 +1,309 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 the Autoware Foundation
+/// \file
+/// \brief source file for a sparse minimum weight assignment solver
+
+//lint -e537 cpplint complains otherwise NOLINT
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "hungarian_assigner/sparse_assigner.hpp"
+
+namespace autoware
+{
+namespace fusion
+{
+namespace hungarian_assigner
+{
+
+namespace
+{
+constexpr index_t NONE = std::numeric_limits<index_t>::max();
+constexpr float64_t INF = std::numeric_limits<float64_t>::infinity();
+using heap_compare_t = std::greater<std::pair<float64_t, index_t>>;
+}  // namespace
+
+constexpr index_t sparse_assigner_c::UNASSIGNED;
+
+///
+sparse_assigner_c::sparse_assigner_c(const index_t num_rows, const index_t num_cols)
+{
+  set_size(num_rows, num_cols);
+}
+
+///
+void sparse_assigner_c::set_size(const index_t num_rows, const index_t num_cols)
+{
+  if ((num_rows < index_t()) || (num_cols < index_t())) {
+    throw std::domain_error("Sparse Assigner: The size must not be negative");
+  }
+  m_num_rows = num_rows;
+  m_num_cols = num_cols;
+}
+
+///
+void sparse_assigner_c::set_weight(const float32_t weight, const index_t idx, const index_t jdx)
+{
+  if ((idx < index_t()) || (idx >= m_num_rows) || (jdx < index_t()) || (jdx >= m_num_cols)) {
+    throw std::out_of_range("Sparse Assigner: Index out of bounds of the size");
+  }
+  if (!std::isfinite(weight) || (weight < 0.0F)) {
+    throw std::domain_error("Sparse Assigner: The weight must be finite and not negative");
+  }
+  m_edges.push_back(edge_t{idx, jdx, weight});
+}
+
+///
+void sparse_assigner_c::reset()
+{
+  m_edges.clear();
+  m_is_assigned = false;
+  m_num_components = index_t();
+}
+
+///
+void sparse_assigner_c::reset(const index_t num_rows, const index_t num_cols)
+{
+  reset();
+  set_size(num_rows, num_cols);
+}
+
+///
+bool8_t sparse_assigner_c::assign()
+{
+  m_row_edge.assign(static_cast<std::size_t>(m_num_rows), NONE);
+  m_col_row.assign(static_cast<std::size_t>(m_num_cols), NONE);
+  find_components();
+  for (index_t component = index_t(); component < m_num_components; ++component) {
+    solve_component(component);
+  }
+  m_is_assigned = true;
+  return std::find(m_row_edge.begin(), m_row_edge.end(), NONE) == m_row_edge.end();
+}
+
+///
+index_t sparse_assigner_c::get_assignment(const index_t idx) const
+{
+  if (!m_is_assigned || (idx < index_t()) || (idx >= m_num_rows)) {
+    throw std::range_error("Sparse Assigner: Index out of bounds of the assignment");
+  }
+  const index_t edge = m_row_edge[static_cast<std::size_t>(idx)];
+  return (edge == NONE) ? UNASSIGNED : m_edges[static_cast<std::size_t>(edge)].col;
+}
+
+///
+index_t sparse_assigner_c::find_root(index_t node)
+{
+  while (m_parent[static_cast<std::size_t>(node)] != node) {
+    auto & parent = m_parent[static_cast<std::size_t>(node)];
+    parent = m_parent[static_cast<std::size_t>(parent)];
+    node = parent;
+  }
+  return node;
+}
+
+///
+void sparse_assigner_c::find_components()
+{
+  const auto num_nodes = static_cast<std::size_t>(m_num_rows + m_num_cols);
+  // Sort the edges by row
+  m_row_edges_begin.assign(static_cast<std::size_t>(m_num_rows) + 1U, index_t());
+  for (const auto & edge : m_edges) {
+    ++m_row_edges_begin[static_cast<std::size_t>(edge.row) + 1U];
+  }
+  std::partial_sum(m_row_edges_begin.begin(), m_row_edges_begin.end(), m_row_edges_begin.begin());
+  m_row_edges.resize(m_edges.size());
+  m_predecessor.assign(m_row_edges_begin.begin(), m_row_edges_begin.end() - 1);
+  for (std::size_t edge = 0U; edge < m_edges.size(); ++edge) {
+    const auto row = static_cast<std::size_t>(m_edges[edge].row);
+    m_row_edges[static_cast<std::size_t>(m_predecessor[row]++)] = static_cast<index_t>(edge);
+  }
+
+  // Join the rows and columns of the edges
+  m_parent.resize(num_nodes);
+  std::iota(m_parent.begin(), m_parent.end(), index_t());
+  for (const auto & edge : m_edges) {
+    const index_t row_root = find_root(edge.row);
+    const index_t col_root = find_root(m_num_rows + edge.col);
+    if (row_root != col_root) {
+      m_parent[static_cast<std::size_t>(col_root)] = row_root;
+    }
+  }
+
+  // Number the components, nodes without edges are in none
+  m_num_components = index_t();
+  m_component_of.assign(num_nodes, NONE);
+  m_predecessor.assign(num_nodes, NONE);
+  for (const auto & edge : m_edges) {
+    for (const index_t node : {edge.row, m_num_rows + edge.col}) {
+      auto & component = m_component_of[static_cast<std::size_t>(node)];
+      if (component == NONE) {
+        auto & root_component = m_predecessor[static_cast<std::size_t>(find_root(node))];
+        if (root_component == NONE) {
+          root_component = m_num_components++;
+        }
+        component = root_component;
+      }
+    }
+  }
+
+  // Group the nodes by component
+  m_component_begin.assign(static_cast<std::size_t>(m_num_components) + 1U, index_t());
+  for (const index_t component : m_component_of) {
+    if (component != NONE) {
+      ++m_component_begin[static_cast<std::size_t>(component) + 1U];
+    }
+  }
+  std::partial_sum(m_component_begin.begin(), m_component_begin.end(), m_component_begin.begin());
+  m_component_nodes.resize(static_cast<std::size_t>(m_component_begin.back()));
+  m_predecessor.assign(m_component_begin.begin(), m_component_begin.end() - 1);
+  for (std::size_t node = 0U; node < num_nodes; ++node) {
+    const index_t component = m_component_of[node];
+    if (component != NONE) {
+      auto & next = m_predecessor[static_cast<std::size_t>(component)];
+      m_component_nodes[static_cast<std::size_t>(next++)] = static_cast<index_t>(node);
+    }
+  }
+
+  // One more node for the sink of the shortest paths
+  m_potential.resize(num_nodes + 1U);
+  m_distance.resize(num_nodes + 1U);
+  m_predecessor.resize(num_nodes + 1U);
+  m_is_done.resize(num_nodes + 1U);
+}
+
+///
+void sparse_assigner_c::solve_component(const index_t component)
+{
+  // The weights are not negative, so zero potentials are feasible
+  const auto component_idx = static_cast<std::size_t>(component);
+  const auto begin = static_cast<std::size_t>(m_component_begin[component_idx]);
+  const auto end = static_cast<std::size_t>(m_component_begin[component_idx + 1U]);
+  for (std::size_t i = begin; i < end; ++i) {
+    m_potential[static_cast<std::size_t>(m_component_nodes[i])] = 0.0;
+  }
+  m_potential.back() = 0.0;
+  // Every augmentation assigns one more row
+  while (augment(component)) {
+  }
+}
+
+///
+bool8_t sparse_assigner_c::augment(const index_t component)
+{
+  const auto component_idx = static_cast<std::size_t>(component);
+  const auto begin = static_cast<std::size_t>(m_component_begin[component_idx]);
+  const auto end = static_cast<std::size_t>(m_component_begin[component_idx + 1U]);
+  const auto sink = m_potential.size() - 1U;
+  const auto push = [this](const float64_t distance, const index_t node) {
+      m_heap.emplace_back(distance, node);
+      std::push_heap(m_heap.begin(), m_heap.end(), heap_compare_t{});
+    };
+  // Try to reach a node with a shorter path, the reduced weights are clamped against rounding
+  const auto relax = [this, &push](
+    const std::size_t from, const std::size_t to, const float64_t weight, const index_t via) {
+      const float64_t reduced = weight + m_potential[from] - m_potential[to];
+      const float64_t distance = m_distance[from] + std::max(reduced, 0.0);
+      if (distance < m_distance[to]) {
+        m_distance[to] = distance;
+        m_predecessor[to] = via;
+        push(distance, static_cast<index_t>(to));
+      }
+    };
+
+  // Dijkstra from all free rows, i.e. from a source with an edge to each of them
+  m_heap.clear();
+  for (std::size_t i = begin; i < end; ++i) {
+    const auto node = static_cast<std::size_t>(m_component_nodes[i]);
+    m_distance[node] = INF;
+    m_predecessor[node] = NONE;
+    m_is_done[node] = false;
+    if ((m_component_nodes[i] < m_num_rows) && (m_row_edge[node] == NONE)) {
+      m_distance[node] = std::max(-m_potential[node], 0.0);
+      push(m_distance[node], static_cast<index_t>(node));
+    }
+  }
+  m_distance[sink] = INF;
+  m_is_done[sink] = false;
+  while (!m_heap.empty()) {
+    std::pop_heap(m_heap.begin(), m_heap.end(), heap_compare_t{});
+    const auto node = static_cast<std::size_t>(m_heap.back().second);
+    m_heap.pop_back();
+    if (m_is_done[node]) {
+      continue;
+    }
+    m_is_done[node] = true;
+    if (node == sink) {
+      break;
+    }
+    if (node < static_cast<std::size_t>(m_num_rows)) {
+      // Unassigned edges lead from a row to a column
+      const auto edges_begin = static_cast<std::size_t>(m_row_edges_begin[node]);
+      const auto edges_end = static_cast<std::size_t>(m_row_edges_begin[node + 1U]);
+      for (std::size_t i = edges_begin; i < edges_end; ++i) {
+        const index_t edge = m_row_edges[i];
+        if (edge != m_row_edge[node]) {
+          const auto & e = m_edges[static_cast<std::size_t>(edge)];
+          relax(node, static_cast<std::size_t>(m_num_rows + e.col), e.weight, edge);
+        }
+      }
+    } else {
+      // An assigned edge leads back from a column to its row, a free column to the sink
+      const index_t row = m_col_row[node - static_cast<std::size_t>(m_num_rows)];
+      if (row == NONE) {
+        relax(node, sink, 0.0, static_cast<index_t>(node));
+      } else {
+        const index_t edge = m_row_edge[static_cast<std::size_t>(row)];
+        const auto & e = m_edges[static_cast<std::size_t>(edge)];
+        relax(node, static_cast<std::size_t>(row), -e.weight, static_cast<index_t>(node));
+      }
+    }
+  }
+  if (!m_is_done[sink]) {
+    return false;
+  }
+
+  // Keep the reduced weights of the remaining edges non-negative
+  const float64_t sink_distance = m_distance[sink];
+  for (std::size_t i = begin; i < end; ++i) {
+    const auto node = static_cast<std::size_t>(m_component_nodes[i]);
+    m_potential[node] += std::min(m_distance[node], sink_distance);
+  }
+  m_potential[sink] += sink_distance;
+
+  // Flip the edges of the path, from the free column back to the free row
+  auto col = static_cast<std::size_t>(m_predecessor[sink]);
+  while (true) {
+    const index_t edge = m_predecessor[col];
+    const auto row = static_cast<std::size_t>(m_edges[static_cast<std::size_t>(edge)].row);
+    m_row_edge[row] = edge;
+    m_col_row[col - static_cast<std::size_t>(m_num_rows)] = static_cast<index_t>(row);
+    if (m_predecessor[row] == NONE) {
+      break;
+    }
+    col = static_cast<std::size_t>(m_predecessor[row]);
+  }
+  return true;
+}
+
+}  // namespace hungarian_assigner
+}  // namespace fusion
+}  // namespace autoware
@@ -0,0 +1,118 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <benchmark/benchmark.h>
+#include <hungarian_assigner/hungarian_assigner.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using autoware::fusion::hungarian_assigner::hungarian_assigner_c;
+using autoware::fusion::hungarian_assigner::index_t;
+
+struct Problem
+{
+  index_t num_rows;
+  index_t num_cols;
+  // gated weights, negative for impossible assignments
+  std::vector<float> weights;
+};
+
+// A detection is gated to a few of the tracks
+Problem create_problem(const index_t num_rows, const index_t num_cols, std::mt19937 & generator)
+{
+  std::uniform_real_distribution<float> weight_distribution{0.0F, 10.0F};
+  std::bernoulli_distribution link_distribution{0.2};
+  Problem problem{num_rows, num_cols, {}};
+  problem.weights.reserve(static_cast<std::size_t>(num_rows * num_cols));
+  for (index_t i = 0; i < (num_rows * num_cols); ++i) {
+    problem.weights.push_back(
+      link_distribution(generator) ? weight_distribution(generator) : -1.0F);
+  }
+  return problem;
+}
+
+// Tracks and detections of traffic scenes: mostly a dozen of each, sometimes a crowded scene
+std::vector<Problem> create_problems(const std::size_t num_problems, const index_t max_size)
+{
+  std::mt19937 generator{42U};
+  std::poisson_distribution<index_t> size_distribution{10.0};
+  std::bernoulli_distribution crowded_distribution{0.05};
+  std::uniform_int_distribution<index_t> crowded_size_distribution{20, max_size};
+  std::vector<Problem> problems;
+  for (std::size_t i = 0U; i < num_problems; ++i) {
+    const index_t size = crowded_distribution(generator) ?
+      crowded_size_distribution(generator) : size_distribution(generator);
+    const index_t num_rows = std::min(std::max(size, index_t{1}), max_size);
+    const index_t num_cols = std::min(num_rows + (size_distribution(generator) / 4), max_size);
+    problems.push_back(create_problem(num_rows, num_cols, generator));
+  }
+  return problems;
+}
+
+template<uint16_t Capacity>
+void solve(hungarian_assigner_c<Capacity> & assigner, const Problem & problem)
+{
+  assigner.reset(problem.num_rows, problem.num_cols);
+  for (index_t idx = 0; idx < problem.num_rows; ++idx) {
+    for (index_t jdx = 0; jdx < problem.num_cols; ++jdx) {
+      const float weight = problem.weights[static_cast<std::size_t>(idx * problem.num_cols + jdx)];
+      if (weight >= 0.0F) {
+        assigner.set_weight(weight, idx, jdx);
+      }
+    }
+  }
+  benchmark::DoNotOptimize(assigner.assign());
+}
+
+}  // namespace
+
+// The same problems for each capacity, the work should not depend on the capacity
+template<uint16_t Capacity>
+static void BenchHungarianAssigner(benchmark::State & state)
+{
+  const auto problems = create_problems(1000U, 64);
+  // The operator new of the assigner is Eigen's, which is forbidden by EIGEN_NO_MALLOC
+  hungarian_assigner_c<Capacity> assigner;
+  for (auto _ : state) {
+    for (const auto & problem : problems) {
+      solve(assigner, problem);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(problems.size()));
+}
+
+BENCHMARK_TEMPLATE(BenchHungarianAssigner, 64U)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BenchHungarianAssigner, 128U)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BenchHungarianAssigner, 256U)->Unit(benchmark::kMillisecond);
+
+// A single square problem of the given size
+static void BenchHungarianAssignerSize(benchmark::State & state)
+{
+  const auto size = static_cast<index_t>(state.range(0));
+  std::mt19937 generator{42U};
+  const auto problem = create_problem(size, size, generator);
+  hungarian_assigner_c<256U> assigner;
+  for (auto _ : state) {
+    solve(assigner, problem);
+  }
+}
+
+BENCHMARK(BenchHungarianAssignerSize)->Arg(4)->Arg(10)->Arg(30)->Arg(100)->Arg(256)
+->Unit(benchmark::kMicrosecond);
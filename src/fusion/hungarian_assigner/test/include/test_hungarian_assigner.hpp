@@ -19,6 +19,7 @@
 
 #include <hungarian_assigner/hungarian_assigner.hpp>
 #include <iostream>
+#include <random>
 #include <vector>
 #include <thread>
 #include "common/types.hpp"
@@ -26,6 +27,7 @@
 using autoware::common::types::bool8_t;
 using autoware::common::types::float32_t;
 using autoware::fusion::hungarian_assigner::hungarian_assigner_c;
+using autoware::fusion::hungarian_assigner::index_t;
 
 template<uint16_t N>
 void set_weights(
@@ -377,4 +379,38 @@ TEST(HungarianAssigner, Degenerate3)
   EXPECT_EQ(assign.get_assignment(4), assign.UNASSIGNED);
 }
 
+// only the active block of the matrices is reset, so nothing of a larger problem may leak into a
+// smaller one: a reused assigner gives the same assignments as a fresh one
+TEST(HungarianAssigner, ReuseAcrossSizes)
+{
+  std::mt19937 gen{12U};
+  std::uniform_int_distribution<index_t> size_dist{1, 40};
+  std::uniform_real_distribution<float32_t> weight_dist{0.0F, 100.0F};
+  std::bernoulli_distribution link_dist{0.3};
+  hungarian_assigner_c<64U> reused;
+  for (uint32_t trial = 0U; trial < 50U; ++trial) {
+    const index_t num_rows = size_dist(gen);
+    const index_t num_cols = num_rows + (size_dist(gen) % 5);
+    hungarian_assigner_c<64U> fresh;
+    fresh.set_size(num_rows, num_cols);
+    reused.reset(num_rows, num_cols);
+    for (index_t idx = 0; idx < num_rows; ++idx) {
+      for (index_t jdx = 0; jdx < num_cols; ++jdx) {
+        if (link_dist(gen)) {
+          const float32_t weight = weight_dist(gen);
+          fresh.set_weight(weight, idx, jdx);
+          reused.set_weight(weight, idx, jdx);
+        }
+      }
+    }
+    ASSERT_EQ(fresh.assign(), reused.assign());
+    for (index_t idx = 0; idx < num_rows; ++idx) {
+      ASSERT_EQ(fresh.get_assignment(idx), reused.get_assignment(idx)) << trial;
+    }
+    for (index_t idx = 0; idx < (num_cols - num_rows); ++idx) {
+      ASSERT_EQ(fresh.get_unassigned(idx), reused.get_unassigned(idx)) << trial;
+    }
+  }
+}
+
 #endif  // TEST_HUNGARIAN_ASSIGNER_HPP_
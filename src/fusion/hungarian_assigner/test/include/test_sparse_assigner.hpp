@@ -0,0 +1,241 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_SPARSE_ASSIGNER_HPP_
+#define TEST_SPARSE_ASSIGNER_HPP_
+
+#include <hungarian_assigner/hungarian_assigner.hpp>
+#include <hungarian_assigner/sparse_assigner.hpp>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+#include "common/types.hpp"
+
+using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
+using autoware::fusion::hungarian_assigner::hungarian_assigner_c;
+using autoware::fusion::hungarian_assigner::index_t;
+using autoware::fusion::hungarian_assigner::sparse_assigner_c;
+
+// same as the dense Basic example
+TEST(SparseAssigner, Basic)
+{
+  sparse_assigner_c assign(3, 3);
+  assign.set_weight(0.0F, 0U, 0U);
+  assign.set_weight(10.0F, 0U, 1U);
+  assign.set_weight(1.0F, 0U, 2U);
+  assign.set_weight(0.0F, 1U, 0U);
+  assign.set_weight(10.0F, 1U, 1U);
+  assign.set_weight(10.0F, 1U, 2U);
+  assign.set_weight(1.0F, 2U, 0U);
+  assign.set_weight(0.0F, 2U, 1U);
+  assign.set_weight(1.0F, 2U, 2U);
+  ASSERT_THROW(assign.set_weight(1.0F, 2U, 3U), std::out_of_range);
+  ASSERT_THROW(assign.set_weight(1.0F, 3U, 0U), std::out_of_range);
+  ASSERT_THROW(assign.set_weight(-1.0F, 0U, 0U), std::domain_error);
+  ASSERT_THROW(
+    assign.set_weight(std::numeric_limits<float32_t>::infinity(), 0U, 0U), std::domain_error);
+  ASSERT_THROW(assign.get_assignment(0U), std::range_error);
+  ASSERT_TRUE(assign.assign());
+  ASSERT_EQ(assign.get_assignment(0U), 2U);
+  ASSERT_EQ(assign.get_assignment(1U), 0U);
+  ASSERT_EQ(assign.get_assignment(2U), 1U);
+  ASSERT_EQ(assign.get_num_components(), 1);
+  ASSERT_THROW(assign.get_assignment(3U), std::range_error);
+  ASSERT_THROW(assign.set_size(-1, 3), std::domain_error);
+  // reset
+  assign.reset();
+  ASSERT_THROW(assign.get_assignment(0U), std::range_error);
+}
+
+// more rows than columns, which the dense solver does not support
+TEST(SparseAssigner, MoreRows)
+{
+  sparse_assigner_c assign(3, 2);
+  assign.set_weight(1.0F, 0U, 0U);
+  assign.set_weight(2.0F, 1U, 0U);
+  assign.set_weight(5.0F, 1U, 1U);
+  assign.set_weight(1.0F, 2U, 1U);
+  ASSERT_FALSE(assign.assign());
+  ASSERT_EQ(assign.get_assignment(0U), 0U);
+  ASSERT_EQ(assign.get_assignment(1U), sparse_assigner_c::UNASSIGNED);
+  ASSERT_EQ(assign.get_assignment(2U), 1U);
+}
+
+// clusters without shared assignments are solved separately
+TEST(SparseAssigner, Components)
+{
+  sparse_assigner_c assign;
+  assign.reset(6, 7);
+  // cluster of rows 0 and 2 competing for columns 1 and 4
+  assign.set_weight(1.0F, 0U, 1U);
+  assign.set_weight(3.0F, 0U, 4U);
+  assign.set_weight(1.0F, 2U, 1U);
+  assign.set_weight(5.0F, 2U, 4U);
+  // cluster of row 1 and column 0, with a duplicate weight
+  assign.set_weight(4.0F, 1U, 0U);
+  assign.set_weight(2.0F, 1U, 0U);
+  // cluster of rows 3 and 5 competing for column 6
+  assign.set_weight(1.0F, 3U, 6U);
+  assign.set_weight(2.0F, 5U, 6U);
+  // row 4 has no possible assignment
+  ASSERT_FALSE(assign.assign());
+  ASSERT_EQ(assign.get_num_components(), 3);
+  ASSERT_EQ(assign.get_assignment(0U), 4U);
+  ASSERT_EQ(assign.get_assignment(1U), 0U);
+  ASSERT_EQ(assign.get_assignment(2U), 1U);
+  ASSERT_EQ(assign.get_assignment(3U), 6U);
+  ASSERT_EQ(assign.get_assignment(4U), sparse_assigner_c::UNASSIGNED);
+  ASSERT_EQ(assign.get_assignment(5U), sparse_assigner_c::UNASSIGNED);
+  // empty problem
+  assign.reset(0, 0);
+  ASSERT_TRUE(assign.assign());
+  ASSERT_EQ(assign.get_num_components(), 0);
+}
+
+// gated random problems have at most the total weight of the dense solver
+TEST(SparseAssigner, MatchesHungarian)
+{
+  std::mt19937 gen(42U);
+  std::uniform_real_distribution<float32_t> weight_dist(0.0F, 10.0F);
+  std::uniform_int_distribution<index_t> size_dist(1, 40);
+  hungarian_assigner_c<64U> dense;
+  sparse_assigner_c sparse;
+  std::size_t num_compared = 0U;
+  for (std::size_t trial = 0U; trial < 200U; ++trial) {
+    const index_t num_rows = size_dist(gen);
+    const index_t num_cols = num_rows + size_dist(gen) / 4;
+    dense.reset();
+    dense.set_size(num_rows, num_cols);
+    sparse.reset(num_rows, num_cols);
+    std::vector<std::vector<float32_t>> weights(
+      static_cast<std::size_t>(num_rows),
+      std::vector<float32_t>(static_cast<std::size_t>(num_cols), -1.0F));
+    for (index_t idx = 0; idx < num_rows; ++idx) {
+      for (index_t jdx = 0; jdx < num_cols; ++jdx) {
+        const float32_t weight = weight_dist(gen);
+        // gate most of the assignments
+        if (weight < 2.0F) {
+          weights[static_cast<std::size_t>(idx)][static_cast<std::size_t>(jdx)] = weight;
+          dense.set_weight(weight, idx, jdx);
+          sparse.set_weight(weight, idx, jdx);
+        }
+      }
+    }
+    const auto total = [&weights, num_rows](const auto & assign) {
+        float64_t sum = 0.0;
+        for (index_t idx = 0; idx < num_rows; ++idx) {
+          const auto jdx = static_cast<std::size_t>(assign.get_assignment(idx));
+          sum += static_cast<float64_t>(weights[static_cast<std::size_t>(idx)][jdx]);
+        }
+        return sum;
+      };
+    const bool8_t is_sparse_complete = sparse.assign();
+    bool8_t is_dense_complete = dense.assign();
+    for (index_t idx = 0; idx < num_rows; ++idx) {
+      is_dense_complete = is_dense_complete &&
+        (dense.get_assignment(idx) != hungarian_assigner_c<64U>::UNASSIGNED);
+    }
+    if (is_dense_complete) {
+      ASSERT_TRUE(is_sparse_complete);
+      ASSERT_LE(total(sparse), total(dense) + 1.0E-3);
+      ++num_compared;
+    }
+  }
+  ASSERT_GT(num_compared, 10U);
+}
+
+// small random problems against exhaustive search: as many rows as possible are assigned, with
+// the minimum total weight among such assignments
+TEST(SparseAssigner, MatchesExhaustive)
+{
+  std::mt19937 gen(7U);
+  std::uniform_int_distribution<index_t> size_dist(0, 5);
+  std::uniform_int_distribution<int32_t> weight_dist(0, 30);
+  sparse_assigner_c sparse;
+  for (std::size_t trial = 0U; trial < 500U; ++trial) {
+    const index_t num_rows = size_dist(gen);
+    const index_t num_cols = size_dist(gen);
+    sparse.reset(num_rows, num_cols);
+    std::vector<std::vector<float32_t>> weights(
+      static_cast<std::size_t>(num_rows),
+      std::vector<float32_t>(static_cast<std::size_t>(num_cols), -1.0F));
+    for (auto & row : weights) {
+      for (auto & weight : row) {
+        const int32_t value = weight_dist(gen);
+        // a third of the assignments are possible
+        if (value <= 10) {
+          weight = static_cast<float32_t>(value);
+        }
+      }
+    }
+    for (index_t idx = 0; idx < num_rows; ++idx) {
+      for (index_t jdx = 0; jdx < num_cols; ++jdx) {
+        const float32_t weight =
+          weights[static_cast<std::size_t>(idx)][static_cast<std::size_t>(jdx)];
+        if (weight >= 0.0F) {
+          sparse.set_weight(weight, idx, jdx);
+        }
+      }
+    }
+    // exhaustive search over the rows, each either unassigned or assigned to a free column
+    index_t best_count = -1;
+    float64_t best_total = 0.0;
+    std::vector<bool8_t> is_used(static_cast<std::size_t>(num_cols), false);
+    std::function<void(index_t, index_t, float64_t)> search =
+      [&](const index_t idx, const index_t count, const float64_t sum) {
+        if (idx == num_rows) {
+          if ((count > best_count) || ((count == best_count) && (sum < best_total))) {
+            best_count = count;
+            best_total = sum;
+          }
+          return;
+        }
+        search(idx + 1, count, sum);
+        for (std::size_t jdx = 0U; jdx < is_used.size(); ++jdx) {
+          const float32_t weight = weights[static_cast<std::size_t>(idx)][jdx];
+          if (!is_used[jdx] && (weight >= 0.0F)) {
+            is_used[jdx] = true;
+            search(idx + 1, count + 1, sum + static_cast<float64_t>(weight));
+            is_used[jdx] = false;
+          }
+        }
+      };
+    search(0, 0, 0.0);
+
+    const bool8_t is_complete = sparse.assign();
+    index_t count = 0;
+    float64_t sum = 0.0;
+    std::fill(is_used.begin(), is_used.end(), false);
+    for (index_t idx = 0; idx < num_rows; ++idx) {
+      const index_t jdx = sparse.get_assignment(idx);
+      if (jdx != sparse_assigner_c::UNASSIGNED) {
+        const float32_t weight =
+          weights[static_cast<std::size_t>(idx)][static_cast<std::size_t>(jdx)];
+        ASSERT_GE(weight, 0.0F);
+        ASSERT_FALSE(is_used[static_cast<std::size_t>(jdx)]);
+        is_used[static_cast<std::size_t>(jdx)] = true;
+        ++count;
+        sum += static_cast<float64_t>(weight);
+      }
+    }
+    ASSERT_EQ(is_complete, count == num_rows);
+    ASSERT_EQ(count, best_count);
+    ASSERT_NEAR(sum, best_total, 1.0E-6);
+  }
+}
+
+#endif  // TEST_SPARSE_ASSIGNER_HPP_
@@ -36,6 +36,8 @@ def generate_launch_description():
     web_files_root = os.path.join(avp_web_interface_pkg_prefix, 'web')
     rviz_cfg_path = os.path.join(get_package_share_directory('autoware_auto_launch'),
                                  'config', 'avp.rviz')
+    rosbridge_param_file = os.path.join(get_package_share_directory('autoware_auto_launch'),
+                                        'param', 'rosbridge.param.yaml')
 
     # Arguments
     with_rviz_param = DeclareLaunchArgument(
@@ -48,6 +50,11 @@ def generate_launch_description():
         default_value=rviz_cfg_path,
         description='Launch RVIZ2 with the specified config file'
     )
+    rosbridge_param = DeclareLaunchArgument(
+        'rosbridge_param_file',
+        default_value=rosbridge_param_file,
+        description='Path to config file for the rosbridge server of the web interface'
+    )
 
     # Nodes
     rviz2 = Node(
@@ -63,7 +70,8 @@ def generate_launch_description():
         package='rosbridge_server',
         name='rosbridge_server_node',
         namespace='gui',
-        executable='rosbridge_websocket'
+        executable='rosbridge_websocket',
+        parameters=[LaunchConfiguration('rosbridge_param_file')]
     )
     web_server = ExecuteProcess(
       cmd=["python3", "-m", "http.server", "8000"],
@@ -73,6 +81,7 @@ def generate_launch_description():
     return LaunchDescription([
         with_rviz_param,
         rviz_cfg_path_param,
+        rosbridge_param,
         rviz2,
         web_server,
         web_bridge,
@@ -19,7 +19,10 @@ from launch.launch_description_sources import PythonLaunchDescriptionSource
 from launch.actions import IncludeLaunchDescription
 from launch import LaunchDescription
 from launch.actions import DeclareLaunchArgument
+from launch.actions import GroupAction
+from launch.actions import SetEnvironmentVariable
 from launch.conditions import IfCondition
+from launch.conditions import UnlessCondition
 from launch.substitutions import LaunchConfiguration
 from launch_ros.actions import Node
 
@@ -80,6 +83,11 @@ def generate_launch_description():
         default_value='True',
         description='Enable obstacle detection'
     )
+    composed_param = DeclareLaunchArgument(
+        'composed',
+        default_value='False',
+        description='The lidar front-end is composed by avp_lidar_localization_composed.launch.py'
+    )
     scan_downsampler_param = DeclareLaunchArgument(
         'scan_downsampler_param_file',
         default_value=scan_downsampler_param_file,
@@ -120,6 +128,14 @@ def generate_launch_description():
         default_value=vehicle_characteristics_param_file,
         description='Path to config file for vehicle characteristics'
     )
+    trace_dir_param = DeclareLaunchArgument(
+        'trace_dir',
+        default_value='',
+        description='Directory to write the latency traces of the nodes to, empty to not trace'
+    )
+
+    # Tracing is read from the environment by each node when it starts
+    trace_dir = SetEnvironmentVariable('AUTOWARE_TRACE_DIR', LaunchConfiguration('trace_dir'))
 
     # Nodes
 
@@ -235,6 +251,16 @@ def generate_launch_description():
             ('vehicle_state_command', '/vehicle/state_command')
         ]
     )
+    # The nodes from the fused cloud to the clusters, unless they run in a component container
+    lidar_front_end = GroupAction(
+        condition=UnlessCondition(LaunchConfiguration('composed')),
+        actions=[
+            euclidean_clustering,
+            ray_ground_classifier,
+            scan_downsampler,
+            point_cloud_fusion_node,
+        ]
+    )
     off_map_obstacles_filter = Node(
         package='off_map_obstacles_filter_nodes',
         name='off_map_obstacles_filter_node',
@@ -254,6 +280,7 @@ def generate_launch_description():
         ray_ground_classifier_param,
         scan_downsampler_param,
         with_obstacles_param,
+        composed_param,
         lanelet2_map_provider_param,
         lane_planner_param,
         parking_planner_param,
@@ -261,10 +288,9 @@ def generate_launch_description():
         behavior_planner_param,
         off_map_obstacles_filter_param,
         vehicle_characteristics_param,
-        euclidean_clustering,
-        ray_ground_classifier,
-        scan_downsampler,
-        point_cloud_fusion_node,
+        trace_dir_param,
+        trace_dir,
+        lidar_front_end,
         lanelet2_map_provider,
         lanelet2_map_visualizer,
         global_planner,
@@ -0,0 +1,249 @@
+# Copyright 2021 the Autoware Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+"""Launch the lidar front-end and the localization of the AVP demo in a single process."""
+
+from ament_index_python import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument
+from launch.conditions import IfCondition
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.actions import LoadComposableNodes
+from launch_ros.descriptions import ComposableNode
+
+import os
+
+
+def generate_launch_description():
+    """
+    Launch the lidar front-end, the obstacle detection and the localization in one container.
+
+    The lidar drivers, the filter transforms, the fusion, the ground classification, the
+    clustering, the scan downsampler and the ndt localizer hand their clouds to each other
+    through intra-process communication, so that no cloud is serialized between them. This is
+    used instead of the separate processes by avp_sim.launch.py and avp_vehicle.launch.py with
+    `composed:=True`.
+    """
+    avp_demo_pkg_prefix = get_package_share_directory('autoware_demos')
+    autoware_launch_pkg_prefix = get_package_share_directory('autoware_auto_launch')
+
+    vlp16_front_param_file = os.path.join(
+        avp_demo_pkg_prefix, 'param/avp/vlp16_front_vehicle.param.yaml')
+    vlp16_rear_param_file = os.path.join(
+        avp_demo_pkg_prefix, 'param/avp/vlp16_rear_vehicle.param.yaml')
+    pc_filter_transform_param_file = os.path.join(
+        avp_demo_pkg_prefix, 'param/avp/pc_filter_transform.param.yaml')
+    point_cloud_fusion_param_file = os.path.join(
+        get_package_share_directory('point_cloud_fusion_nodes'),
+        'param/vlp16_sim_lexus_pc_fusion.param.yaml')
+    ray_ground_classifier_param_file = os.path.join(
+        autoware_launch_pkg_prefix, 'param/ray_ground_classifier.param.yaml')
+    euclidean_cluster_param_file = os.path.join(
+        autoware_launch_pkg_prefix, 'param/euclidean_cluster.param.yaml')
+    scan_downsampler_param_file = os.path.join(
+        autoware_launch_pkg_prefix, 'param/scan_downsampler.param.yaml')
+    ndt_localizer_param_file = os.path.join(
+        avp_demo_pkg_prefix, 'param/avp/ndt_localizer_sim.param.yaml')
+
+    # Arguments
+
+    with_lidars_param = DeclareLaunchArgument(
+        'with_lidars',
+        default_value='False',
+        description='Load the lidar drivers into the container'
+    )
+    with_obstacles_param = DeclareLaunchArgument(
+        'with_obstacles',
+        default_value='True',
+        description='Load the ground classification and the clustering into the container'
+    )
+    vlp16_front_param = DeclareLaunchArgument(
+        'vlp16_front_param_file',
+        default_value=vlp16_front_param_file,
+        description='Path to config file for front Velodyne'
+    )
+    vlp16_rear_param = DeclareLaunchArgument(
+        'vlp16_rear_param_file',
+        default_value=vlp16_rear_param_file,
+        description='Path to config file for rear Velodyne'
+    )
+    pc_filter_transform_param = DeclareLaunchArgument(
+        'pc_filter_transform_param_file',
+        default_value=pc_filter_transform_param_file,
+        description='Path to config file for Point Cloud Filter/Transform Nodes'
+    )
+    point_cloud_fusion_param = DeclareLaunchArgument(
+        'point_cloud_fusion_param_file',
+        default_value=point_cloud_fusion_param_file,
+        description='Path to config file for Point Cloud Fusion'
+    )
+    ray_ground_classifier_param = DeclareLaunchArgument(
+        'ray_ground_classifier_param_file',
+        default_value=ray_ground_classifier_param_file,
+        description='Path to config file for Ray Ground Classifier'
+    )
+    euclidean_cluster_param = DeclareLaunchArgument(
+        'euclidean_cluster_param_file',
+        default_value=euclidean_cluster_param_file,
+        description='Path to config file for Euclidean Clustering'
+    )
+    scan_downsampler_param = DeclareLaunchArgument(
+        'scan_downsampler_param_file',
+        default_value=scan_downsampler_param_file,
+        description='Path to config file for lidar scan downsampler'
+    )
+    ndt_localizer_param = DeclareLaunchArgument(
+        'ndt_localizer_param_file',
+        default_value=ndt_localizer_param_file,
+        description='Path to config file for ndt localizer'
+    )
+
+    container_prefix_param = DeclareLaunchArgument(
+        'container_prefix',
+        default_value='',
+        description='Command prefix of the container, e.g. to set the real-time scheduling of '
+                    'its threads with chrt and taskset'
+    )
+
+    # Nodes
+
+    intra_process = [{'use_intra_process_comms': True}]
+    filter_transform_plugin = \
+        'autoware::perception::filters::point_cloud_filter_transform_nodes::' \
+        'PointCloud2FilterTransformNode'
+
+    # The multi threaded container runs the callbacks of the two lidars, and the localization
+    # and the obstacle detection, in parallel
+    lidar_localization_container = ComposableNodeContainer(
+        name='lidar_localization_container',
+        namespace='lidars',
+        package='rclcpp_components',
+        executable='component_container_mt',
+        prefix=LaunchConfiguration('container_prefix'),
+        composable_node_descriptions=[
+            ComposableNode(
+                package='point_cloud_filter_transform_nodes',
+                plugin=filter_transform_plugin,
+                name='filter_transform_vlp16_front',
+                namespace='lidar_front',
+                parameters=[LaunchConfiguration('pc_filter_transform_param_file')],
+                remappings=[('points_in', 'points_xyzi')],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='point_cloud_filter_transform_nodes',
+                plugin=filter_transform_plugin,
+                name='filter_transform_vlp16_rear',
+                namespace='lidar_rear',
+                parameters=[LaunchConfiguration('pc_filter_transform_param_file')],
+                remappings=[('points_in', 'points_xyzi')],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='point_cloud_fusion_nodes',
+                plugin='autoware::perception::filters::point_cloud_fusion_nodes::'
+                       'PointCloudFusionNode',
+                name='point_cloud_fusion_nodes',
+                namespace='lidars',
+                parameters=[LaunchConfiguration('point_cloud_fusion_param_file')],
+                remappings=[('output_topic', 'points_fused'),
+                            ('input_topic1', '/lidar_front/points_filtered'),
+                            ('input_topic2', '/lidar_rear/points_filtered')],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='voxel_grid_nodes',
+                plugin='autoware::perception::filters::voxel_grid_nodes::VoxelCloudNode',
+                name='voxel_grid_cloud_node',
+                namespace='lidars',
+                parameters=[LaunchConfiguration('scan_downsampler_param_file')],
+                remappings=[('points_in', 'points_fused'),
+                            ('points_downsampled', 'points_fused_downsampled')],
+                extra_arguments=intra_process),
+            # The map is received through the middleware, see RelativeLocalizerNode
+            ComposableNode(
+                package='ndt_nodes',
+                plugin='autoware::localization::ndt_nodes::P2DNDTLocalizerNodeComponent',
+                name='p2d_ndt_localizer_node',
+                namespace='localization',
+                parameters=[LaunchConfiguration('ndt_localizer_param_file')],
+                remappings=[('points_in', '/lidars/points_fused_downsampled'),
+                            ('observation_republish', '/lidars/points_fused_viz')],
+                extra_arguments=intra_process),
+        ],
+        output='screen',
+    )
+
+    lidar_drivers = LoadComposableNodes(
+        target_container=lidar_localization_container,
+        condition=IfCondition(LaunchConfiguration('with_lidars')),
+        composable_node_descriptions=[
+            ComposableNode(
+                package='velodyne_nodes',
+                plugin='autoware::drivers::velodyne_nodes::VLP16DriverNode',
+                name='vlp16_driver_node',
+                namespace='lidar_front',
+                parameters=[LaunchConfiguration('vlp16_front_param_file')],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='velodyne_nodes',
+                plugin='autoware::drivers::velodyne_nodes::VLP16DriverNode',
+                name='vlp16_driver_node',
+                namespace='lidar_rear',
+                parameters=[LaunchConfiguration('vlp16_rear_param_file')],
+                extra_arguments=intra_process),
+        ],
+    )
+
+    obstacle_detection = LoadComposableNodes(
+        target_container=lidar_localization_container,
+        condition=IfCondition(LaunchConfiguration('with_obstacles')),
+        composable_node_descriptions=[
+            ComposableNode(
+                package='ray_ground_classifier_nodes',
+                plugin='autoware::perception::filters::ray_ground_classifier_nodes::'
+                       'RayGroundClassifierCloudNode',
+                name='ray_ground_classifier',
+                namespace='perception',
+                parameters=[LaunchConfiguration('ray_ground_classifier_param_file')],
+                remappings=[('points_in', '/lidars/points_fused')],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='euclidean_cluster_nodes',
+                plugin='autoware::perception::segmentation::euclidean_cluster_nodes::'
+                       'EuclideanClusterNode',
+                name='euclidean_cluster_cloud_node',
+                namespace='perception',
+                parameters=[LaunchConfiguration('euclidean_cluster_param_file')],
+                remappings=[('points_in', 'points_nonground')],
+                extra_arguments=intra_process),
+        ],
+    )
+
+    return LaunchDescription([
+        with_lidars_param,
+        with_obstacles_param,
+        vlp16_front_param,
+        vlp16_rear_param,
+        pc_filter_transform_param,
+        point_cloud_fusion_param,
+        ray_ground_classifier_param,
+        euclidean_cluster_param,
+        scan_downsampler_param,
+        ndt_localizer_param,
+        container_prefix_param,
+        lidar_localization_container,
+        lidar_drivers,
+        obstacle_detection,
+    ])
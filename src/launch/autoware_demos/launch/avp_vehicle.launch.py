@@ -17,8 +17,10 @@
 from ament_index_python import get_package_share_directory
 from launch import LaunchDescription
 from launch.actions import DeclareLaunchArgument
+from launch.actions import GroupAction
 from launch.actions import IncludeLaunchDescription
 from launch.conditions import IfCondition
+from launch.conditions import UnlessCondition
 from launch.launch_description_sources import PythonLaunchDescriptionSource
 from launch.substitutions import LaunchConfiguration
 from launch_ros.actions import Node
@@ -106,6 +108,11 @@ def generate_launch_description():
         default_value=vehicle_characteristics_param_file,
         description='Path to config file for vehicle characteristics'
     )
+    composed_param = DeclareLaunchArgument(
+        'composed',
+        default_value='False',
+        description='Run the lidar front-end and the localization in one component container'
+    )
 
     # Nodes
 
@@ -200,6 +207,23 @@ def generate_launch_description():
         arguments=["0", "0", "0", "0", "0", "0", "odom", "base_link"]
     )
 
+    # The lidar front-end and the localization run in separate processes, unless they are composed
+    lidar_localization = GroupAction(
+        condition=UnlessCondition(LaunchConfiguration('composed')),
+        actions=[
+            vlp16_front,
+            vlp16_rear,
+            filter_transform_vlp16_front,
+            filter_transform_vlp16_rear,
+            ndt_localizer,
+        ]
+    )
+    lidar_localization_composed = IncludeLaunchDescription(
+        PythonLaunchDescriptionSource(
+            [avp_demo_pkg_prefix, '/launch/avp_lidar_localization_composed.launch.py']),
+        condition=IfCondition(LaunchConfiguration('composed'))
+    )
+
     core_launch = IncludeLaunchDescription(
         PythonLaunchDescriptionSource([avp_demo_pkg_prefix, '/launch/avp_core.launch.py']),
         launch_arguments={}.items()
@@ -215,14 +239,12 @@ def generate_launch_description():
         ssc_interface_param,
         pc_filter_transform_param,
         vehicle_characteristics_param,
-        vlp16_front,
-        vlp16_rear,
-        filter_transform_vlp16_front,
-        filter_transform_vlp16_rear,
+        composed_param,
         urdf_publisher,
         map_publisher,
-        ndt_localizer,
         mpc,
+        lidar_localization,
+        lidar_localization_composed,
         ssc_interface,
         odom_bl_publisher,
         core_launch
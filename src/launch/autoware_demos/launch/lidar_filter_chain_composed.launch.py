@@ -0,0 +1,120 @@
+# Copyright 2021 the Autoware Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+"""Launch a lidar filter chain composed into a single process with intra-process communication."""
+
+from ament_index_python import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+import os
+
+
+def generate_launch_description():
+    """
+    Launch polygon_remover -> radius_search_2d_filter -> voxel_grid in one component container.
+
+    Clouds are handed from one filter to the next as unique_ptrs so that they are neither
+    serialized nor copied between the nodes of the chain.
+    """
+    polygon_remover_param_file = os.path.join(
+        get_package_share_directory('polygon_remover_nodes'), 'param/test_params.yaml')
+    outlier_filter_param_file = os.path.join(
+        get_package_share_directory('outlier_filter_nodes'),
+        'param/radius_search_2d_filter_node_test.param.yaml')
+    voxel_grid_param_file = os.path.join(
+        get_package_share_directory('voxel_grid_nodes'), 'param/vlp16_lexus_centroid.param.yaml')
+
+    # Arguments
+
+    polygon_remover_param = DeclareLaunchArgument(
+        'polygon_remover_param_file',
+        default_value=polygon_remover_param_file,
+        description='Path to config file for Polygon Remover'
+    )
+    outlier_filter_param = DeclareLaunchArgument(
+        'outlier_filter_param_file',
+        default_value=outlier_filter_param_file,
+        description='Path to config file for Radius Search 2D Outlier Filter'
+    )
+    voxel_grid_param = DeclareLaunchArgument(
+        'voxel_grid_param_file',
+        default_value=voxel_grid_param_file,
+        description='Path to config file for Voxel Grid'
+    )
+
+    container_prefix_param = DeclareLaunchArgument(
+        'container_prefix',
+        default_value='',
+        description='Command prefix of the container, e.g. to set the real-time scheduling of '
+                    'its threads with chrt and taskset'
+    )
+
+    # Nodes
+
+    intra_process = [{'use_intra_process_comms': True}]
+
+    filter_chain_container = ComposableNodeContainer(
+        name='lidar_filter_chain_container',
+        namespace='lidars',
+        package='rclcpp_components',
+        executable='component_container',
+        prefix=LaunchConfiguration('container_prefix'),
+        composable_node_descriptions=[
+            ComposableNode(
+                package='polygon_remover_nodes',
+                plugin='autoware::perception::filters::polygon_remover_nodes::PolygonRemoverNode',
+                name='polygon_remover',
+                namespace='lidars',
+                parameters=[LaunchConfiguration('polygon_remover_param_file'),
+                            {'will_visualize': False}],
+                remappings=[('points_xyzi', 'points_fused'),
+                            ('cloud_polygon_removed', 'points_polygon_removed')],
+                extra_arguments=intra_process),
+            # The outlier filter only outputs xyz, so it runs after the polygon remover which
+            # requires intensity
+            ComposableNode(
+                package='outlier_filter_nodes',
+                plugin='autoware::perception::filters::outlier_filter_nodes::'
+                       'RadiusSearch2DFilterNode',
+                name='radius_search_2d_filter',
+                namespace='lidars',
+                parameters=[LaunchConfiguration('outlier_filter_param_file')],
+                remappings=[('input', 'points_polygon_removed'),
+                            ('output', 'points_outlier_filtered')],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='voxel_grid_nodes',
+                plugin='autoware::perception::filters::voxel_grid_nodes::VoxelCloudNode',
+                name='voxel_grid_cloud_node',
+                namespace='lidars',
+                parameters=[LaunchConfiguration('voxel_grid_param_file')],
+                remappings=[('points_in', 'points_outlier_filtered')],
+                extra_arguments=intra_process),
+        ],
+        output='screen',
+    )
+
+    return LaunchDescription([
+        polygon_remover_param,
+        outlier_filter_param,
+        voxel_grid_param,
+        container_prefix_param,
+        filter_chain_container
+    ])
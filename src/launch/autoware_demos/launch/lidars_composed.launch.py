@@ -0,0 +1,145 @@
+# Copyright 2021 the Autoware Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+"""Launch the lidar drivers of the AVP vehicle and the point cloud fusion in a single process."""
+
+from ament_index_python import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+import os
+
+
+def generate_launch_description():
+    """
+    Launch the front and rear vlp16 drivers, their filter transforms and the fusion together.
+
+    The clouds of both lidars are handed to the filter transforms and from there to the fusion
+    through intra-process communication, so that no full cloud is serialized or deserialized on
+    the way to the fused cloud.
+    """
+    avp_demo_pkg_prefix = get_package_share_directory('autoware_demos')
+    vlp16_front_param_file = os.path.join(
+        avp_demo_pkg_prefix, 'param/avp/vlp16_front_vehicle.param.yaml')
+    vlp16_rear_param_file = os.path.join(
+        avp_demo_pkg_prefix, 'param/avp/vlp16_rear_vehicle.param.yaml')
+    pc_filter_transform_param_file = os.path.join(
+        avp_demo_pkg_prefix, 'param/avp/pc_filter_transform.param.yaml')
+    point_cloud_fusion_param_file = os.path.join(
+        get_package_share_directory('point_cloud_fusion_nodes'),
+        'param/vlp16_sim_lexus_pc_fusion.param.yaml')
+
+    # Arguments
+
+    vlp16_front_param = DeclareLaunchArgument(
+        'vlp16_front_param_file',
+        default_value=vlp16_front_param_file,
+        description='Path to config file for front Velodyne'
+    )
+    vlp16_rear_param = DeclareLaunchArgument(
+        'vlp16_rear_param_file',
+        default_value=vlp16_rear_param_file,
+        description='Path to config file for rear Velodyne'
+    )
+    pc_filter_transform_param = DeclareLaunchArgument(
+        'pc_filter_transform_param_file',
+        default_value=pc_filter_transform_param_file,
+        description='Path to config file for Point Cloud Filter/Transform Nodes'
+    )
+    point_cloud_fusion_param = DeclareLaunchArgument(
+        'point_cloud_fusion_param_file',
+        default_value=point_cloud_fusion_param_file,
+        description='Path to config file for Point Cloud Fusion'
+    )
+
+    container_prefix_param = DeclareLaunchArgument(
+        'container_prefix',
+        default_value='',
+        description='Command prefix of the container, e.g. to set the real-time scheduling of '
+                    'its threads with chrt and taskset'
+    )
+
+    # Nodes
+
+    intra_process = [{'use_intra_process_comms': True}]
+    filter_transform_plugin = \
+        'autoware::perception::filters::point_cloud_filter_transform_nodes::' \
+        'PointCloud2FilterTransformNode'
+
+    # The multi threaded container runs the callbacks of the two lidars in parallel
+    lidars_container = ComposableNodeContainer(
+        name='lidars_container',
+        namespace='lidars',
+        package='rclcpp_components',
+        executable='component_container_mt',
+        prefix=LaunchConfiguration('container_prefix'),
+        composable_node_descriptions=[
+            ComposableNode(
+                package='velodyne_nodes',
+                plugin='autoware::drivers::velodyne_nodes::VLP16DriverNode',
+                name='vlp16_driver_node',
+                namespace='lidar_front',
+                parameters=[LaunchConfiguration('vlp16_front_param_file')],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='velodyne_nodes',
+                plugin='autoware::drivers::velodyne_nodes::VLP16DriverNode',
+                name='vlp16_driver_node',
+                namespace='lidar_rear',
+                parameters=[LaunchConfiguration('vlp16_rear_param_file')],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='point_cloud_filter_transform_nodes',
+                plugin=filter_transform_plugin,
+                name='filter_transform_vlp16_front',
+                namespace='lidar_front',
+                parameters=[LaunchConfiguration('pc_filter_transform_param_file')],
+                remappings=[('points_in', 'points_xyzi')],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='point_cloud_filter_transform_nodes',
+                plugin=filter_transform_plugin,
+                name='filter_transform_vlp16_rear',
+                namespace='lidar_rear',
+                parameters=[LaunchConfiguration('pc_filter_transform_param_file')],
+                remappings=[('points_in', 'points_xyzi')],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='point_cloud_fusion_nodes',
+                plugin='autoware::perception::filters::point_cloud_fusion_nodes::'
+                       'PointCloudFusionNode',
+                name='point_cloud_fusion_nodes',
+                namespace='lidars',
+                parameters=[LaunchConfiguration('point_cloud_fusion_param_file')],
+                remappings=[('output_topic', 'points_fused'),
+                            ('input_topic1', '/lidar_front/points_filtered'),
+                            ('input_topic2', '/lidar_rear/points_filtered')],
+                extra_arguments=intra_process),
+        ],
+        output='screen',
+    )
+
+    return LaunchDescription([
+        vlp16_front_param,
+        vlp16_rear_param,
+        pc_filter_transform_param,
+        point_cloud_fusion_param,
+        container_prefix_param,
+        lidars_container
+    ])
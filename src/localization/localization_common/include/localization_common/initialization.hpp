@@ -21,13 +21,13 @@
 #include <localization_common/visibility_control.hpp>
 #include <geometry_msgs/msg/transform.hpp>
 #include <helper_functions/crtp.hpp>
+#include <nav_msgs/msg/odometry.hpp>
 #include <time_utils/time_utils.hpp>
 #include <tf2/buffer_core.h>
 #include <experimental/optional>
+#include <chrono>
 #include <string>
 
-// probably include the motion model
-
 namespace autoware
 {
 namespace localization
@@ -50,7 +50,8 @@ public:
   /// determined by the implementation class. tf2 lookup may generate exceptions if the lookup
   /// fails in other ways. For details, see tf2::BufferCore class.
   /// If a fallback pose was set externally, then the first lookup failure is ignored and the
-  /// fallback pose is served instead.
+  /// fallback pose is served instead. If the implementation class predicts the pose, see
+  /// `predict()`, the prediction is served without looking the transform up.
   /// \param tf_graph Transform graph that contains all the transforms to look up.
   /// \param time_point Time to guess the pose.
   /// \param target_frame Target frame of the transform. (i.e. "map")
@@ -60,6 +61,10 @@ public:
     const tf2::BufferCore & tf_graph, tf2::TimePoint time_point,
     const std::string & target_frame, const std::string & source_frame)
   {
+    const auto prediction = this->impl().predict(tf_graph, time_point, target_frame, source_frame);
+    if (prediction) {
+      return prediction.value();
+    }
     try {
       // attempt to get transform at a given point.
       return tf_graph.lookupTransform(target_frame, source_frame, time_point);
@@ -92,6 +97,17 @@ public:
     m_fallback_pose.emplace(pose);
   }
 
+  /// Predict the pose at a given time point, e.g. from a motion model. Implementation classes can
+  /// hide this method to serve a prediction instead of the transform graph. By default, nothing
+  /// is predicted.
+  /// \return Predicted transform, or nullopt to look the transform up.
+  std::experimental::optional<PoseT> predict(
+    const tf2::BufferCore &, tf2::TimePoint,
+    const std::string &, const std::string &) const
+  {
+    return std::experimental::nullopt;
+  }
+
 private:
   std::experimental::optional<PoseT> m_fallback_pose{std::experimental::nullopt};
 };
@@ -115,6 +131,56 @@ public:
     const std::string & target_frame, const std::string & source_frame);
 };
 
+/// Pose initialization implementation which predicts the pose at the requested time from the
+/// latest state estimate, e.g. the odometry output of a state estimation node, with a constant
+/// velocity motion model. Hence the guess is stamped at the time of the scan rather than at the
+/// last available transform. Without a state estimate in the target frame within the prediction
+/// horizon, it behaves like `BestEffortInitializer`.
+class LOCALIZATION_COMMON_PUBLIC MotionModelInitializer
+  : public PoseInitializerBase<MotionModelInitializer>
+{
+  using PoseT = geometry_msgs::msg::TransformStamped;
+
+public:
+  /// Constructor
+  /// \param max_prediction_horizon Maximum time between the state estimate and a predicted
+  /// time point, in either direction.
+  explicit MotionModelInitializer(
+    std::chrono::nanoseconds max_prediction_horizon = std::chrono::milliseconds{200});
+
+  /// Set the state estimate to predict from. Its pose is in the frame of the header and its
+  /// twist in the child frame, as in the output of a state estimation node.
+  /// \param state_estimate State estimate.
+  void set_state_estimate(const nav_msgs::msg::Odometry & state_estimate);
+
+  /// Predict the pose at a given time point by moving the state estimate with its twist. If the
+  /// child frame of the estimate is not the source frame, e.g. base_link rather than the lidar
+  /// frame, the latest transform between them is looked up and appended.
+  /// \param tf_graph Transform graph to look the transform to the source frame up in.
+  /// \param time_point Time to predict the pose at.
+  /// \param target_frame Target frame of the transform. (i.e. "map")
+  /// \param source_frame Source frame of the transform. (i.e. "base_link")
+  /// \return The predicted transform, or nullopt if there is no usable state estimate.
+  std::experimental::optional<PoseT> predict(
+    const tf2::BufferCore & tf_graph, tf2::TimePoint time_point,
+    const std::string & target_frame, const std::string & source_frame) const;
+
+  /// Get the latest available transform, as `BestEffortInitializer`.
+  /// \param tf_graph Transform graph that contains all the transforms to look up.
+  /// \param time_point Time to guess the pose.
+  /// \param target_frame Target frame of the transform. (i.e. "map")
+  /// \param source_frame Source frame of the transform. (i.e. "base_link")
+  /// \return The latest transform
+  PoseT extrapolate(
+    const tf2::BufferCore & tf_graph, tf2::TimePoint time_point,
+    const std::string & target_frame, const std::string & source_frame);
+
+private:
+  std::chrono::nanoseconds m_max_prediction_horizon;
+  std::experimental::optional<nav_msgs::msg::Odometry> m_state_estimate{
+    std::experimental::nullopt};
+};
+
 }  // namespace localization_common
 }  // namespace localization
 }  // namespace autoware
@@ -14,33 +14,132 @@
 //
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
+#include <common/types.hpp>
 #include <localization_common/initialization.hpp>
 #include <time_utils/time_utils.hpp>
+#include <tf2/LinearMath/Transform.h>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <string>
 
+using autoware::common::types::float64_t;
+
 namespace autoware
 {
 namespace localization
 {
 namespace localization_common
 {
-geometry_msgs::msg::TransformStamped BestEffortInitializer::extrapolate(
+namespace
+{
+geometry_msgs::msg::TransformStamped latest_transform(
   const tf2::BufferCore & tf_graph, tf2::TimePoint time_point,
-  const std::string & target_frame, const std::string & source_frame)
+  const std::string & target_frame, const std::string & source_frame,
+  const std::string & initializer_name)
 {
-  (void) time_point;
   const auto ret = tf_graph.lookupTransform(target_frame, source_frame, tf2::TimePointZero);
   if (time_utils::from_message(ret.header.stamp) > time_point) {
     // It's older than the oldest because if it was within [oldest_available, newest_available]
     // we wouldn't be in this function.
     throw std::domain_error(
-            "BestEffortInitializer: Backwards extrapolation is not supported."
+            initializer_name + ": Backwards extrapolation is not supported."
             "Initialization timepoint is older than the oldest available "
             "transform in the transform graph.");
   }
   return ret;
 }
 
+tf2::Transform to_tf2(const geometry_msgs::msg::Transform & transform)
+{
+  return tf2::Transform{
+    tf2::Quaternion{transform.rotation.x, transform.rotation.y, transform.rotation.z,
+      transform.rotation.w},
+    tf2::Vector3{transform.translation.x, transform.translation.y, transform.translation.z}};
+}
+}  // namespace
+
+geometry_msgs::msg::TransformStamped BestEffortInitializer::extrapolate(
+  const tf2::BufferCore & tf_graph, tf2::TimePoint time_point,
+  const std::string & target_frame, const std::string & source_frame)
+{
+  return latest_transform(
+    tf_graph, time_point, target_frame, source_frame, "BestEffortInitializer");
+}
+
+MotionModelInitializer::MotionModelInitializer(std::chrono::nanoseconds max_prediction_horizon)
+: m_max_prediction_horizon{max_prediction_horizon} {}
+
+void MotionModelInitializer::set_state_estimate(const nav_msgs::msg::Odometry & state_estimate)
+{
+  m_state_estimate.emplace(state_estimate);
+}
+
+std::experimental::optional<geometry_msgs::msg::TransformStamped>
+MotionModelInitializer::predict(
+  const tf2::BufferCore & tf_graph, tf2::TimePoint time_point,
+  const std::string & target_frame, const std::string & source_frame) const
+{
+  if (!m_state_estimate || (m_state_estimate->header.frame_id != target_frame)) {
+    return std::experimental::nullopt;
+  }
+  const auto & estimate = m_state_estimate.value();
+  const std::chrono::nanoseconds dt{
+    time_point - time_utils::from_message(estimate.header.stamp)};
+  if (std::abs(dt.count()) > std::abs(m_max_prediction_horizon.count())) {
+    return std::experimental::nullopt;
+  }
+
+  // Move with the twist in the child frame, to first order in the elapsed time.
+  const auto dt_s = std::chrono::duration<float64_t>{dt}.count();
+  const auto & twist = estimate.twist.twist;
+  const tf2::Vector3 angular{twist.angular.x, twist.angular.y, twist.angular.z};
+  tf2::Quaternion rotation{tf2::Quaternion::getIdentity()};
+  const auto angle = angular.length() * dt_s;
+  if (std::fabs(angle) > std::numeric_limits<float64_t>::epsilon()) {
+    rotation.setRotation(angular.normalized(), angle);
+  }
+  const tf2::Transform motion{
+    rotation, tf2::Vector3{twist.linear.x, twist.linear.y, twist.linear.z} * dt_s};
+  const auto & pose = estimate.pose.pose;
+  const tf2::Transform estimated_pose{
+    tf2::Quaternion{pose.orientation.x, pose.orientation.y, pose.orientation.z,
+      pose.orientation.w},
+    tf2::Vector3{pose.position.x, pose.position.y, pose.position.z}};
+  auto prediction = estimated_pose * motion;
+
+  if (estimate.child_frame_id != source_frame) {
+    try {
+      prediction *= to_tf2(
+        tf_graph.lookupTransform(
+          estimate.child_frame_id, source_frame, tf2::TimePointZero).transform);
+    } catch (const tf2::TransformException &) {
+      return std::experimental::nullopt;
+    }
+  }
+
+  geometry_msgs::msg::TransformStamped ret;
+  ret.header.frame_id = target_frame;
+  ret.header.stamp = time_utils::to_message(time_point);
+  ret.child_frame_id = source_frame;
+  const auto & translation = prediction.getOrigin();
+  ret.transform.translation.set__x(translation.x()).set__y(translation.y()).
+  set__z(translation.z());
+  const auto orientation = prediction.getRotation();
+  ret.transform.rotation.set__x(orientation.x()).set__y(orientation.y()).
+  set__z(orientation.z()).set__w(orientation.w());
+  return ret;
+}
+
+geometry_msgs::msg::TransformStamped MotionModelInitializer::extrapolate(
+  const tf2::BufferCore & tf_graph, tf2::TimePoint time_point,
+  const std::string & target_frame, const std::string & source_frame)
+{
+  return latest_transform(
+    tf_graph, time_point, target_frame, source_frame, "MotionModelInitializer");
+}
+
 }  // namespace localization_common
 }  // namespace localization
 }  // namespace autoware
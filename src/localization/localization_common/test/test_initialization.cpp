@@ -136,6 +136,61 @@ INSTANTIATE_TEST_CASE_P(
     // cppcheck-suppress syntaxError
   ), );
 
+TEST(MotionModelInitializationTest, Prediction) {
+  using autoware::localization::localization_common::MotionModelInitializer;
+  MotionModelInitializer initializer{std::chrono::milliseconds{500}};
+  const auto now = std::chrono::system_clock::now();
+  constexpr std::chrono::milliseconds dt{100};
+  constexpr auto quarter_turn = 1.5707963F;
+  tf2::BufferCore tf_graph;
+  auto latest = make_transform(0.0F, 0.0F, quarter_turn, 10.0F, 0.0F, 0.0F);
+  latest.header.frame_id = "map";
+  latest.child_frame_id = "base_link";
+  latest.header.stamp = time_utils::to_message(now);
+  tf_graph.setTransform(latest, "testauthority");
+  auto extrinsic = make_transform(0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F);
+  extrinsic.header.frame_id = "base_link";
+  extrinsic.child_frame_id = "lidar";
+  tf_graph.setTransform(extrinsic, "testauthority", true);
+
+  // Without a state estimate, the latest transform is served.
+  check_transform_eq(latest, initializer.guess(tf_graph, now + dt, "map", "base_link"));
+
+  // Facing along y at 2 m/s
+  nav_msgs::msg::Odometry estimate;
+  estimate.header = latest.header;
+  estimate.child_frame_id = "base_link";
+  estimate.pose.pose.position.x = 10.0;
+  estimate.pose.pose.orientation = latest.transform.rotation;
+  estimate.twist.twist.linear.x = 2.0;
+  initializer.set_state_estimate(estimate);
+  auto expected = make_transform(0.0F, 0.0F, quarter_turn, 10.0F, 0.2F, 0.0F);
+  expected.header.frame_id = "map";
+  expected.header.stamp = time_utils::to_message(now + dt);
+  expected.child_frame_id = "base_link";
+  check_transform_eq(expected, initializer.guess(tf_graph, now + dt, "map", "base_link"));
+
+  // The lidar is 1 m ahead of base_link.
+  expected.transform.translation.y = 1.2;
+  expected.child_frame_id = "lidar";
+  check_transform_eq(expected, initializer.guess(tf_graph, now + dt, "map", "lidar"));
+
+  // Beyond the prediction horizon, the latest transform is served again.
+  check_transform_eq(
+    latest, initializer.guess(tf_graph, now + std::chrono::seconds{1}, "map", "base_link"));
+
+  // Turning at 1 rad/s
+  estimate.pose.pose.orientation = geometry_msgs::msg::Quaternion{}.set__w(1.0);
+  estimate.twist.twist.linear.x = 0.0;
+  estimate.twist.twist.angular.z = 1.0;
+  initializer.set_state_estimate(estimate);
+  expected = make_transform(0.0F, 0.0F, 0.1F, 10.0F, 0.0F, 0.0F);
+  expected.header.frame_id = "map";
+  expected.header.stamp = time_utils::to_message(now + dt);
+  expected.child_frame_id = "base_link";
+  check_transform_eq(expected, initializer.guess(tf_graph, now + dt, "map", "base_link"));
+}
+
 /////////// Helper function implementations:
 
 geometry_msgs::msg::TransformStamped make_transform(
@@ -116,11 +116,58 @@ struct LocalizerConstraint
     "The localizer should provide a valid  `register_measurement(...)` method.");
   static constexpr Requires value{};
 };
+
+/// \brief This struct detects whether `LocalizerT` can convert a measurement ahead of its
+/// registration, which lets a relative localizer node overlap the conversion of the next
+/// observation with the registration of the current one. Unlike the constraints above, it does
+/// not fail the compilation: `value` is false if the interface is not provided, in which case the
+/// measurement is converted during its registration.
+/// \tparam LocalizerT
+/// \tparam InputT
+/// \tparam MapT
+/// \tparam SummaryT
+template<typename LocalizerT, typename InputT, typename MapT,
+  typename SummaryT = localization_common::OptimizedRegistrationSummary>
+struct ScanPreparation
+{
+  /// \brief This expression requires a const method returning an empty scan of type
+  /// `LocalizerT::ScanT` to prepare measurements in.
+  template<typename Localizer>
+  using call_make_scan = decltype(std::declval<const Localizer &>().make_scan());
+
+  /// \brief This expression requires a const method converting a measurement into a scan, which
+  /// must not access any state modified during a registration.
+  /// \param[in] msg Measurement message to convert.
+  /// \param[out] scan Scan to replace the content of.
+  template<typename Localizer>
+  using call_prepare_scan = decltype(std::declval<const Localizer &>().prepare_scan(
+      std::declval<const InputT &>(), std::declval<typename Localizer::ScanT &>()));
+
+  /// \brief This expression requires a method registering a prepared scan, as the registration
+  /// in `LocalizerConstraint` but with the scan following the message.
+  template<typename Localizer>
+  using call_register_scan = decltype(std::declval<Localizer>().register_measurement(
+      std::declval<const InputT &>(),
+      std::declval<typename Localizer::ScanT &>(),
+      std::declval<geometry_msgs::msg::TransformStamped>(),
+      std::declval<const MapT &>(),
+      std::declval<SummaryT * const>())
+  );
+
+  static constexpr bool value =
+    common::helper_functions::expression_valid<call_make_scan, LocalizerT>::value &&
+    common::helper_functions::expression_valid<call_prepare_scan, LocalizerT>::value &&
+    common::helper_functions::expression_valid_with_return<
+    call_register_scan, LocalizerT, geometry_msgs::msg::PoseWithCovarianceStamped>::value;
+};
+
 // External definition of static members:
 template<typename MapT, typename MapMsgT>
 constexpr Requires MapConstraint<MapT, MapMsgT>::value;
 template<typename LocalizerT, typename InputT, typename MapT, typename SummaryT>
 constexpr Requires LocalizerConstraint<LocalizerT, InputT, MapT, SummaryT>::value;
+template<typename LocalizerT, typename InputT, typename MapT, typename SummaryT>
+constexpr bool ScanPreparation<LocalizerT, InputT, MapT, SummaryT>::value;
 }  // namespace traits
 }  // namespace localization_nodes
 }  // namespace localization
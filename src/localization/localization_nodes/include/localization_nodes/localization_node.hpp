@@ -25,13 +25,22 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <time_utils/time_utils.hpp>
+#include <time_utils/latency_histogram.hpp>
 #include <helper_functions/message_adapters.hpp>
 #include <localization_nodes/visibility_control.hpp>
 #include <localization_nodes/constraints.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace autoware
 {
@@ -56,8 +65,51 @@ enum class LocalizerPublishMode
   NO_PUBLISH_TF
 };
 
+/// Configuration of the pipelined mode of a relative localizer node. In this mode, the
+/// observations are converted in the subscription callback and queued for a dedicated
+/// registration thread, so that the conversion of the next observation overlaps the
+/// registration of the current one.
+struct PipelineConfig
+{
+  /// Whether to register the observations on a dedicated thread.
+  bool enabled{false};
+  /// Maximum number of observations waiting for registration. When the queue is full, the
+  /// oldest observation is dropped in favor of the new one.
+  std::size_t queue_depth{1U};
+};
+
+/// Latencies of the stages of the pipelined mode.
+struct PipelineStatistics
+{
+  /// Conversion of an observation in the subscription callback.
+  common::time_utils::LatencyHistogram preparation{};
+  /// Waiting time of an observation in the queue.
+  common::time_utils::LatencyHistogram queueing{};
+  /// Initial guess, registration and publishing of the estimate.
+  common::time_utils::LatencyHistogram registration{};
+  /// Number of observations dropped from a full queue.
+  uint64_t num_dropped{0U};
+};
+
+/// Configuration of the extrapolation of the registered poses. Between registrations, the last
+/// registered pose is moved along with the odometry, i.e. the `odom` to `base_link` transform,
+/// and published periodically, so that the pose is not as old as the last registration.
+struct ExtrapolationConfig
+{
+  /// Whether to publish extrapolated poses.
+  bool enabled{false};
+  /// Period of checking for new odometry to extrapolate the pose with.
+  std::chrono::milliseconds period{10};
+  /// Maximum odometry time after the last registered pose, beyond which nothing is published
+  /// until the next registration.
+  std::chrono::milliseconds max_horizon{500};
+};
+
 /// Base relative localizer node that publishes map->base_link relative
 /// transform messages for a given observation source and map.
+/// In the pipelined mode, the observations are registered on a dedicated thread, which calls the
+/// virtual hooks like `validate_output()`. Derived classes overriding them must call
+/// `stop_pipeline()` in their destructor.
 /// \tparam ObservationMsgT Message type to register against a map.
 /// \tparam MapMsgT Map type
 /// \tparam LocalizerT Localizer type.
@@ -89,6 +141,10 @@ public:
   /// \param pose_initializer Pose initializer.
   /// \param publish_tf Whether to publish to the `tf` topic. This can be used to publish transform
   /// messages when the relative localizer is the only source of localization.
+  /// \param pipeline_config Configuration of the pipelined mode.
+  /// \param extrapolation_config Configuration of the extrapolated poses, which are published on
+  /// the topic of the output pose with the suffix `_extrapolated`, and to `tf` if it is published.
+  /// \throws std::domain_error if the pipelined mode is enabled with a queue depth of 0.
   RelativeLocalizerNode(
     const std::string & node_name, const std::string & name_space,
     const TopicQoS & observation_sub_config,
@@ -96,7 +152,9 @@ public:
     const TopicQoS & pose_pub_config,
     const TopicQoS & initial_pose_sub_config,
     const PoseInitializerT & pose_initializer,
-    LocalizerPublishMode publish_tf = LocalizerPublishMode::NO_PUBLISH_TF)
+    LocalizerPublishMode publish_tf = LocalizerPublishMode::NO_PUBLISH_TF,
+    const PipelineConfig & pipeline_config = PipelineConfig{},
+    const ExtrapolationConfig & extrapolation_config = ExtrapolationConfig{})
   : Node(node_name, name_space),
     m_pose_initializer(pose_initializer),
     m_tf_listener(m_tf_buffer, USE_DEDICATED_TF_THREAD),
@@ -107,7 +165,8 @@ public:
     m_map_sub(
       create_subscription<MapMsgT>(
         map_sub_config.topic, map_sub_config.qos,
-        [this](typename MapMsgT::ConstSharedPtr msg) {map_callback(msg);})),
+        [this](typename MapMsgT::ConstSharedPtr msg) {map_callback(msg);},
+        map_sub_options())),
     m_pose_publisher(
       create_publisher<PoseWithCovarianceStamped>(
         pose_pub_config.topic,
@@ -121,6 +180,8 @@ public:
     if (publish_tf == LocalizerPublishMode::PUBLISH_TF) {
       m_tf_publisher = create_publisher<tf2_msgs::msg::TFMessage>("/tf", pose_pub_config.qos);
     }
+    start_extrapolation(extrapolation_config);
+    start_pipeline(pipeline_config);
   }
 
   // Constructor for ros2 components
@@ -144,7 +205,8 @@ public:
         rclcpp::QoS{rclcpp::KeepLast{
             static_cast<size_t>(declare_parameter("map_sub.history_depth").
             template get<size_t>())}}.transient_local(),
-        [this](typename MapMsgT::ConstSharedPtr msg) {map_callback(msg);})),
+        [this](typename MapMsgT::ConstSharedPtr msg) {map_callback(msg);},
+        map_sub_options())),
     m_pose_publisher(
       create_publisher<PoseWithCovarianceStamped>(
         "ndt_pose",
@@ -184,7 +246,8 @@ public:
         rclcpp::QoS{rclcpp::KeepLast{
             static_cast<size_t>(declare_parameter("map_sub.history_depth").
             template get<size_t>())}}.transient_local(),
-        [this](typename MapMsgT::ConstSharedPtr msg) {map_callback(msg);})),
+        [this](typename MapMsgT::ConstSharedPtr msg) {map_callback(msg);},
+        map_sub_options())),
     m_pose_publisher(
       create_publisher<PoseWithCovarianceStamped>(
         "ndt_pose",
@@ -202,12 +265,24 @@ public:
     init();
   }
 
+  ~RelativeLocalizerNode() override
+  {
+    stop_pipeline();
+  }
+
   /// Get a const pointer of the output publisher. Can be used for matching against subscriptions.
   const typename rclcpp::Publisher<PoseWithCovarianceStamped>::ConstSharedPtr get_publisher()
   {
     return m_pose_publisher;
   }
 
+  /// Get the latencies of the stages of the pipelined mode, which are only recorded in this mode.
+  PipelineStatistics pipeline_statistics() const
+  {
+    std::lock_guard<std::mutex> lock{m_pipeline_mutex};
+    return m_pipeline_statistics;
+  }
+
 protected:
   /// Set the localizer.
   /// \param localizer_ptr rvalue to the localizer to set.
@@ -221,6 +296,31 @@ protected:
     m_map_ptr = std::forward<std::unique_ptr<MapT>>(map_ptr);
   }
 
+  /// Modify the pose initializer, e.g. to give it a state estimate to predict from. This waits
+  /// for a registration in progress to finish.
+  /// \param modify Function called with a reference to the pose initializer.
+  template<typename ModifierT>
+  void modify_pose_initializer(ModifierT && modify)
+  {
+    std::lock_guard<std::mutex> lock{m_registration_mutex};
+    modify(m_pose_initializer);
+  }
+
+  /// Stop the registration thread of the pipelined mode and drop the queued observations. The
+  /// observations received afterwards are dropped as well.
+  void stop_pipeline()
+  {
+    {
+      std::lock_guard<std::mutex> lock{m_pipeline_mutex};
+      m_pipeline_stopped = true;
+      m_pending_frames.clear();
+    }
+    m_pipeline_condition.notify_all();
+    if (m_pipeline_thread.joinable()) {
+      m_pipeline_thread.join();
+    }
+  }
+
   /// Handle the exceptions during registration.
   virtual void on_bad_registration(std::exception_ptr eptr) // NOLINT
   {
@@ -254,6 +354,23 @@ protected:
       "ignoring the observation.");
   }
 
+  /// Process an observation before the pose initializer is asked for its initial guess, e.g. to
+  /// give the pose initializer a fallback pose found from the observation. This runs under the
+  /// same lock as the registration. By default does nothing.
+  /// \param msg Observation to register next.
+  /// \param localizer Localizer which registers the observation next.
+  /// \param map Valid map to register the observation to.
+  /// \param pose_initializer Pose initializer which is asked for the initial guess next.
+  virtual void on_observation(
+    const ObservationMsgT & msg, LocalizerT & localizer, const MapT & map,
+    PoseInitializerT & pose_initializer)
+  {
+    (void) msg;
+    (void) localizer;
+    (void) map;
+    (void) pose_initializer;
+  }
+
   /// Default behavior when hte pose output is evaluated to be invalid.
   /// \param pose Pose output.
   virtual void on_invalid_output(const PoseWithCovarianceStamped & pose)
@@ -264,6 +381,14 @@ protected:
       "The result is ignored.");
   }
 
+  /// Process a valid pose estimate after it was published. By default does nothing.
+  /// \param pose Pose estimate.
+  /// \param map Map the pose was estimated in, e.g. to drop the parts that are no longer needed.
+  virtual void on_valid_output(const PoseWithCovarianceStamped & pose, MapT & map)
+  {
+    (void) pose;
+    (void) map;
+  }
 
   /// Validate the pose estimate given the registration summary and the initial guess.
   /// This function by default returns true.
@@ -282,6 +407,44 @@ protected:
   }
 
 private:
+  using Clock = std::chrono::steady_clock;
+  using ScanPreparation = traits::ScanPreparation<LocalizerT, ObservationMsgT, MapT>;
+  using ScanPreparationSupported = std::integral_constant<bool, ScanPreparation::value>;
+
+  /// The map is latched, which intra-process communication does not support, so it is always
+  /// received through the middleware. This allows composing the node with intra-process
+  /// communication for the observations.
+  static rclcpp::SubscriptionOptions map_sub_options()
+  {
+    rclcpp::SubscriptionOptions options;
+    options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    return options;
+  }
+
+  template<typename Localizer, bool>
+  struct ScanOf
+  {
+    using type = std::nullptr_t;
+  };
+  template<typename Localizer>
+  struct ScanOf<Localizer, true>
+  {
+    using type = typename Localizer::ScanT;
+  };
+
+  /// An observation on its way through the pipeline. The frames are recycled along with their
+  /// scan buffer.
+  struct Frame
+  {
+    explicit Frame(typename ScanOf<LocalizerT, ScanPreparation::value>::type && empty_scan)
+    : scan{std::move(empty_scan)} {}
+
+    typename ObservationMsgT::ConstSharedPtr msg{};
+    typename ScanOf<LocalizerT, ScanPreparation::value>::type scan;
+    Clock::time_point enqueue_time{};
+  };
+  using FramePtr = std::unique_ptr<Frame>;
+
   /// Check the pointer and throw if null.
   template<typename PtrT>
   void assert_ptr_not_null(const PtrT & ptr, const std::string & name) const
@@ -302,6 +465,18 @@ private:
     if (declare_parameter("load_initial_pose_from_parameters", false)) {
       m_pose_initializer.set_fallback_pose(get_initial_pose());
     }
+    PipelineConfig pipeline_config{};
+    pipeline_config.enabled = declare_parameter("pipeline.enabled", false);
+    pipeline_config.queue_depth =
+      static_cast<std::size_t>(std::max(declare_parameter("pipeline.queue_depth", 1), 0));
+    ExtrapolationConfig extrapolation_config{};
+    extrapolation_config.enabled = declare_parameter("extrapolation.enabled", false);
+    extrapolation_config.period = std::chrono::milliseconds{
+      std::max(declare_parameter("extrapolation.period_ms", 10), 1)};
+    extrapolation_config.max_horizon = std::chrono::milliseconds{
+      std::max(declare_parameter("extrapolation.max_horizon_ms", 500), 0)};
+    start_extrapolation(extrapolation_config);
+    start_pipeline(pipeline_config);
   }
 
   geometry_msgs::msg::TransformStamped get_initial_pose()
@@ -324,10 +499,24 @@ private:
 /// Process the registration summary. By default does nothing.
   virtual void handle_registration_summary(const RegistrationSummary &) {}
 
-  /// Callback that registers each received observation and outputs the result.
+  /// Callback that registers each received observation and outputs the result, or queues it
+  /// for registration in the pipelined mode.
   /// \param msg_ptr Pointer to the observation message.
   void observation_callback(typename ObservationMsgT::ConstSharedPtr msg_ptr)
   {
+    if (m_pipelined) {
+      enqueue_observation(msg_ptr);
+    } else {
+      register_observation(msg_ptr, nullptr);
+    }
+  }
+
+  /// Register an observation and output the result.
+  /// \param msg_ptr Pointer to the observation message.
+  /// \param frame Frame of the observation in the pipelined mode, null otherwise.
+  void register_observation(typename ObservationMsgT::ConstSharedPtr msg_ptr, Frame * const frame)
+  {
+    std::lock_guard<std::mutex> lock{m_registration_mutex};
     // Check to ensure the pointers are initialized.
     assert_ptr_not_null(m_localizer_ptr, "localizer");
     assert_ptr_not_null(m_map_ptr, "map");
@@ -342,13 +531,20 @@ private:
     const auto & map_frame = m_map_ptr->frame_id();
 
     try {
+      on_observation(*msg_ptr, *m_localizer_ptr, *m_map_ptr, m_pose_initializer);
       geometry_msgs::msg::TransformStamped initial_guess = m_pose_initializer.guess(
         m_tf_buffer, observation_time, map_frame, observation_frame);
       RegistrationSummary summary{};
-      const auto pose_out =
-        m_localizer_ptr->register_measurement(*msg_ptr, initial_guess, *m_map_ptr, &summary);
+      const auto pose_out = register_frame(
+        *msg_ptr, frame, initial_guess, summary, ScanPreparationSupported{});
       if (validate_output(summary, pose_out, initial_guess)) {
         m_pose_publisher->publish(pose_out);
+        if (m_extrapolated_pose_publisher) {
+          std::lock_guard<std::mutex> extrapolation_lock{m_extrapolation_mutex};
+          m_registered_pose = pose_out;
+          m_registered_map_frame = map_frame;
+          m_has_registered_pose = true;
+        }
         // This is to be used when no state estimator or alternative source of
         // localization is available.
         if (m_tf_publisher) {
@@ -363,6 +559,7 @@ private:
         }
 
         handle_registration_summary(summary);
+        on_valid_output(pose_out, *m_map_ptr);
       } else {
         on_invalid_output(pose_out);
       }
@@ -371,10 +568,207 @@ private:
     }
   }
 
+  /// Register with the scan prepared in the frame, if there is one.
+  PoseWithCovarianceStamped register_frame(
+    const ObservationMsgT & msg, Frame * const frame,
+    const TransformStamped & initial_guess, RegistrationSummary & summary, std::true_type)
+  {
+    if (frame != nullptr) {
+      return m_localizer_ptr->register_measurement(
+        msg, frame->scan, initial_guess, *m_map_ptr, &summary);
+    }
+    return m_localizer_ptr->register_measurement(msg, initial_guess, *m_map_ptr, &summary);
+  }
+
+  /// Register the message, the localizer cannot prepare scans.
+  PoseWithCovarianceStamped register_frame(
+    const ObservationMsgT & msg, Frame * const,
+    const TransformStamped & initial_guess, RegistrationSummary & summary, std::false_type)
+  {
+    return m_localizer_ptr->register_measurement(msg, initial_guess, *m_map_ptr, &summary);
+  }
+
+  FramePtr make_frame(std::true_type) const
+  {
+    return std::make_unique<Frame>(m_localizer_ptr->make_scan());
+  }
+
+  FramePtr make_frame(std::false_type) const
+  {
+    return std::make_unique<Frame>(nullptr);
+  }
+
+  void prepare(Frame & frame, std::true_type) const
+  {
+    m_localizer_ptr->prepare_scan(*frame.msg, frame.scan);
+  }
+
+  void prepare(Frame &, std::false_type) const {}
+
+  /// Start the registration thread if the pipelined mode is enabled.
+  /// \throws std::domain_error on a queue depth of 0.
+  void start_pipeline(const PipelineConfig & config)
+  {
+    if (!config.enabled) {
+      return;
+    }
+    if (config.queue_depth == 0U) {
+      throw std::domain_error("The pipeline of the localizer node needs a queue depth above 0.");
+    }
+    m_pipeline_queue_depth = config.queue_depth;
+    m_pipelined = true;
+    m_pipeline_thread = std::thread{[this] {run_pipeline();}};
+  }
+
+  /// Start publishing extrapolated poses if it is enabled.
+  void start_extrapolation(const ExtrapolationConfig & config)
+  {
+    if (!config.enabled) {
+      return;
+    }
+    m_extrapolation_max_horizon = config.max_horizon;
+    m_extrapolated_pose_publisher = create_publisher<PoseWithCovarianceStamped>(
+      std::string{m_pose_publisher->get_topic_name()} + "_extrapolated",
+      rclcpp::QoS{rclcpp::KeepLast{m_pose_publisher->get_queue_size()}});
+    m_extrapolation_timer = create_wall_timer(config.period, [this] {publish_extrapolated_pose();});
+  }
+
+  /// Move the last registered pose along with the newest odometry and publish it, and the
+  /// transform to the odometry frame if `tf` is published. Nothing is published without odometry
+  /// newer than the previous output.
+  void publish_extrapolated_pose()
+  {
+    PoseWithCovarianceStamped pose;
+    std_msgs::msg::Header map_odom_header;
+    {
+      std::lock_guard<std::mutex> lock{m_extrapolation_mutex};
+      if (!m_has_registered_pose) {
+        return;
+      }
+      pose = m_registered_pose;
+      map_odom_header.frame_id = m_registered_map_frame;
+    }
+    try {
+      const auto registration_time = time_utils::from_message(pose.header.stamp);
+      const auto odom_now = m_tf_buffer.lookupTransform("odom", "base_link", tf2::TimePointZero);
+      const auto odom_time = time_utils::from_message(odom_now.header.stamp);
+      if ((odom_time <= std::max(registration_time, m_last_extrapolation_time)) ||
+        ((odom_time - registration_time) > m_extrapolation_max_horizon))
+      {
+        return;
+      }
+      const auto odom_registration =
+        m_tf_buffer.lookupTransform("odom", "base_link", registration_time);
+      tf2::Transform map_base_link_transform;
+      tf2::fromMsg(pose.pose.pose, map_base_link_transform);
+      tf2::Transform odom_registration_transform;
+      tf2::fromMsg(odom_registration.transform, odom_registration_transform);
+      tf2::Transform odom_now_transform;
+      tf2::fromMsg(odom_now.transform, odom_now_transform);
+      // The odometry frame is where the registration put it, the covariance is kept
+      const auto map_odom_tf = map_base_link_transform * odom_registration_transform.inverse();
+      tf2::toMsg(map_odom_tf * odom_now_transform, pose.pose.pose);
+      pose.header.stamp = odom_now.header.stamp;
+      m_last_extrapolation_time = odom_time;
+      m_extrapolated_pose_publisher->publish(pose);
+      if (m_tf_publisher) {
+        map_odom_header.stamp = pose.header.stamp;
+        publish_map_odom(map_odom_tf, map_odom_header);
+      }
+    } catch (const tf2::TransformException & e) {
+      RCLCPP_DEBUG(get_logger(), "No extrapolated pose: %s", e.what());
+    }
+  }
+
+  /// Convert an observation and queue it for the registration thread. If the queue is full, the
+  /// oldest observation is dropped, since registering the newest one gives the most timely pose.
+  /// \param msg_ptr Pointer to the observation message.
+  void enqueue_observation(typename ObservationMsgT::ConstSharedPtr msg_ptr)
+  {
+    assert_ptr_not_null(m_localizer_ptr, "localizer");
+    FramePtr frame{};
+    {
+      std::lock_guard<std::mutex> lock{m_pipeline_mutex};
+      if (m_pipeline_stopped) {
+        return;
+      }
+      if (!m_free_frames.empty()) {
+        frame = std::move(m_free_frames.back());
+        m_free_frames.pop_back();
+      }
+    }
+    const auto preparation_start = Clock::now();
+    try {
+      if (!frame) {
+        frame = make_frame(ScanPreparationSupported{});
+      }
+      frame->msg = msg_ptr;
+      prepare(*frame, ScanPreparationSupported{});
+      frame->enqueue_time = Clock::now();
+    } catch (...) {
+      recycle(std::move(frame));
+      on_bad_registration(std::current_exception());
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock{m_pipeline_mutex};
+      m_pipeline_statistics.preparation.add(frame->enqueue_time - preparation_start);
+      if (m_pending_frames.size() >= m_pipeline_queue_depth) {
+        m_pending_frames.front()->msg.reset();
+        m_free_frames.push_back(std::move(m_pending_frames.front()));
+        m_pending_frames.pop_front();
+        ++m_pipeline_statistics.num_dropped;
+      }
+      m_pending_frames.push_back(std::move(frame));
+    }
+    m_pipeline_condition.notify_one();
+  }
+
+  /// Return a frame to the pool of free frames.
+  void recycle(FramePtr && frame)
+  {
+    if (frame) {
+      frame->msg.reset();
+      std::lock_guard<std::mutex> lock{m_pipeline_mutex};
+      m_free_frames.push_back(std::move(frame));
+    }
+  }
+
+  /// Loop of the registration thread, registering the queued observations in order.
+  void run_pipeline()
+  {
+    while (true) {
+      FramePtr frame{};
+      {
+        std::unique_lock<std::mutex> lock{m_pipeline_mutex};
+        m_pipeline_condition.wait(
+          lock, [this] {return m_pipeline_stopped || !m_pending_frames.empty();});
+        if (m_pipeline_stopped) {
+          return;
+        }
+        frame = std::move(m_pending_frames.front());
+        m_pending_frames.pop_front();
+        m_pipeline_statistics.queueing.add(Clock::now() - frame->enqueue_time);
+      }
+      const auto registration_start = Clock::now();
+      try {
+        register_observation(frame->msg, frame.get());
+      } catch (...) {
+        on_bad_registration(std::current_exception());
+      }
+      const auto registration_latency = Clock::now() - registration_start;
+      frame->msg.reset();
+      std::lock_guard<std::mutex> lock{m_pipeline_mutex};
+      m_pipeline_statistics.registration.add(registration_latency);
+      m_free_frames.push_back(std::move(frame));
+    }
+  }
+
   /// Callback that updates the map.
   /// \param msg_ptr Pointer to the map message.
   void map_callback(typename MapMsgT::ConstSharedPtr msg_ptr)
   {
+    std::lock_guard<std::mutex> lock{m_registration_mutex};
     assert_ptr_not_null(m_map_ptr, "map");
     try {
       m_map_ptr->set(*msg_ptr);
@@ -418,10 +812,20 @@ private:
 
     const auto map_odom_tf = map_base_link_transform * odom_base_link_transform.inverse();
 
+    std_msgs::msg::Header header;
+    header.stamp = pose_msg.header.stamp;
+    header.frame_id = map_frame_id;
+    publish_map_odom(map_odom_tf, header);
+  }
+
+  /// Publish the transform from the map to the odometry frame.
+  /// \param map_odom_tf Transform to publish.
+  /// \param header Stamp of the transform and the map frame.
+  void publish_map_odom(const tf2::Transform & map_odom_tf, const std_msgs::msg::Header & header)
+  {
     tf2_msgs::msg::TFMessage tf_message;
     geometry_msgs::msg::TransformStamped tf_stamped;
-    tf_stamped.header.stamp = pose_msg.header.stamp;
-    tf_stamped.header.frame_id = map_frame_id;
+    tf_stamped.header = header;
     tf_stamped.child_frame_id = "odom";
     const auto & tf_trans = map_odom_tf.getOrigin();
     const auto & tf_rot = map_odom_tf.getRotation();
@@ -435,6 +839,7 @@ private:
 
   void initial_pose_callback(const typename PoseWithCovarianceStamped::ConstSharedPtr msg_ptr)
   {
+    std::lock_guard<std::mutex> lock{m_registration_mutex};
     // The child frame is implicitly base_link.
     // Ensure the parent frame is the map frame
     assert_ptr_not_null(m_map_ptr, "map");
@@ -489,6 +894,31 @@ private:
 
   // Receive updates from "/initialpose" (e.g. rviz2)
   typename rclcpp::Subscription<PoseWithCovarianceStamped>::SharedPtr m_initial_pose_sub;
+
+  // Guards the localizer, the map and the pose initializer against the registration thread.
+  std::mutex m_registration_mutex;
+  // Guards the frames and statistics of the pipeline.
+  mutable std::mutex m_pipeline_mutex;
+  std::condition_variable m_pipeline_condition;
+  std::deque<FramePtr> m_pending_frames{};
+  std::vector<FramePtr> m_free_frames{};
+  PipelineStatistics m_pipeline_statistics{};
+  std::size_t m_pipeline_queue_depth{1U};
+  bool m_pipelined{false};
+  bool m_pipeline_stopped{false};
+  std::thread m_pipeline_thread{};
+
+  // Extrapolation of the registered poses, only set up if it is enabled
+  typename rclcpp::Publisher<PoseWithCovarianceStamped>::SharedPtr m_extrapolated_pose_publisher{
+    nullptr};
+  rclcpp::TimerBase::SharedPtr m_extrapolation_timer{nullptr};
+  std::chrono::nanoseconds m_extrapolation_max_horizon{};
+  tf2::TimePoint m_last_extrapolation_time{};
+  // Guards the last registered pose against the registration thread
+  std::mutex m_extrapolation_mutex;
+  PoseWithCovarianceStamped m_registered_pose{};
+  std::string m_registered_map_frame{};
+  bool m_has_registered_pose{false};
 };
 
 template<typename ObservationMsgT, typename MapMsgT, typename MapT, typename LocalizerT,
@@ -22,6 +22,7 @@
 #include <string>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "test_relative_localizer_node.hpp"
 
@@ -262,6 +263,155 @@ TEST_F(RelativeLocalizationNodeTest, ExceptionHandling) {
   EXPECT_TRUE(localizer_node->register_exception());
 }
 
+TEST_F(RelativeLocalizationNodeTest, Pipelined) {
+  const auto max_poll_iters = 50U;
+  constexpr auto num_observations = 5;
+  auto map_tracker_ptr = std::make_shared<MsgWithHeader>();
+  set_msg_id(*map_tracker_ptr, INITIAL_ID);
+
+  autoware::localization::localization_nodes::PipelineConfig pipeline_config{};
+  pipeline_config.enabled = true;
+  pipeline_config.queue_depth = 2U;
+  auto localizer_node = std::make_shared<TestRelativeLocalizerNode>(
+    "TestNode", "",
+    TopicQoS{m_observation_topic, rclcpp::SystemDefaultsQoS{}},
+    TopicQoS{m_map_topic, rclcpp::SystemDefaultsQoS{}},
+    TopicQoS{m_out_topic, rclcpp::SystemDefaultsQoS{}},
+    TopicQoS{m_init_pose_topic, rclcpp::SystemDefaultsQoS{}},
+    MockInitializer{},
+    autoware::localization::localization_nodes::LocalizerPublishMode::NO_PUBLISH_TF,
+    pipeline_config);
+  localizer_node->set_localizer_(std::make_unique<MockRelativeLocalizer>(nullptr));
+  localizer_node->set_map_(std::make_unique<TestMap>(map_tracker_ptr));
+
+  const auto observation_pub = localizer_node->create_publisher<TestObservation>(
+    m_observation_topic, m_history_depth);
+  const auto map_pub =
+    localizer_node->create_publisher<MsgWithHeader>(m_map_topic, m_history_depth);
+  std::vector<int64_t> pose_ids{};
+  const auto pose_out_sub = localizer_node->create_subscription<PoseWithCovarianceStamped>(
+    m_out_topic,
+    rclcpp::QoS{rclcpp::KeepLast{m_history_depth}},
+    [this, &pose_ids](PoseWithCovarianceStamped::ConstSharedPtr pose) {
+      EXPECT_EQ(pose->header.frame_id, m_expected_aggregated_frame);
+      pose_ids.push_back(get_msg_id(*pose));
+    });
+  wait_for_matched(map_pub);
+  wait_for_matched(observation_pub);
+  wait_for_matched(localizer_node->get_publisher());
+
+  set_msg_id(m_map_msg, 0);
+  map_pub->publish(m_map_msg);
+  for (auto iter = 0U; (iter < max_poll_iters) && (get_msg_id(*map_tracker_ptr) != 0); ++iter) {
+    rclcpp::spin_some(localizer_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  ASSERT_EQ(get_msg_id(*map_tracker_ptr), 0);
+
+  for (auto i = 0; i < num_observations; ++i) {
+    set_msg_id(m_observation_msg, i);
+    observation_pub->publish(m_observation_msg);
+  }
+  // The observations are registered in order, the dropped ones being skipped.
+  auto done = [&localizer_node, num_observations]() {
+      const auto statistics = localizer_node->pipeline_statistics();
+      return (statistics.registration.count() + statistics.num_dropped) == num_observations;
+    };
+  for (auto iter = 0U; (iter < max_poll_iters) && (!done() || pose_ids.empty() ||
+    (pose_ids.back() != (num_observations - 1))); ++iter)
+  {
+    rclcpp::spin_some(localizer_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  ASSERT_FALSE(pose_ids.empty());
+  EXPECT_EQ(pose_ids.back(), num_observations - 1);
+  for (auto i = 1U; i < pose_ids.size(); ++i) {
+    EXPECT_LT(pose_ids[i - 1U], pose_ids[i]);
+  }
+  const auto statistics = localizer_node->pipeline_statistics();
+  EXPECT_EQ(statistics.preparation.count(), static_cast<uint64_t>(num_observations));
+  EXPECT_EQ(statistics.queueing.count(), statistics.registration.count());
+  EXPECT_EQ(
+    statistics.registration.count() + statistics.num_dropped,
+    static_cast<uint64_t>(num_observations));
+  EXPECT_FALSE(localizer_node->register_exception());
+}
+
+TEST_F(RelativeLocalizationNodeTest, Extrapolated) {
+  const auto max_poll_iters = 50U;
+  auto map_tracker_ptr = std::make_shared<MsgWithHeader>();
+  set_msg_id(*map_tracker_ptr, INITIAL_ID);
+
+  autoware::localization::localization_nodes::ExtrapolationConfig extrapolation_config{};
+  extrapolation_config.enabled = true;
+  extrapolation_config.max_horizon = std::chrono::seconds{10};
+  auto localizer_node = std::make_shared<TestRelativeLocalizerNode>(
+    "TestNode", "",
+    TopicQoS{m_observation_topic, rclcpp::SystemDefaultsQoS{}},
+    TopicQoS{m_map_topic, rclcpp::SystemDefaultsQoS{}},
+    TopicQoS{m_out_topic, rclcpp::SystemDefaultsQoS{}},
+    TopicQoS{m_init_pose_topic, rclcpp::SystemDefaultsQoS{}},
+    MockInitializer{},
+    autoware::localization::localization_nodes::LocalizerPublishMode::NO_PUBLISH_TF,
+    autoware::localization::localization_nodes::PipelineConfig{},
+    extrapolation_config);
+  localizer_node->set_localizer_(std::make_unique<MockRelativeLocalizer>(nullptr));
+  localizer_node->set_map_(std::make_unique<TestMap>(map_tracker_ptr));
+
+  const auto observation_pub = localizer_node->create_publisher<TestObservation>(
+    m_observation_topic, m_history_depth);
+  const auto map_pub =
+    localizer_node->create_publisher<MsgWithHeader>(m_map_topic, m_history_depth);
+  const auto tf_pub =
+    localizer_node->create_publisher<tf2_msgs::msg::TFMessage>("/tf", m_history_depth);
+  std::vector<PoseWithCovarianceStamped> poses{};
+  const auto pose_out_sub = localizer_node->create_subscription<PoseWithCovarianceStamped>(
+    m_out_topic + "_extrapolated",
+    rclcpp::QoS{rclcpp::KeepLast{m_history_depth}},
+    [&poses](PoseWithCovarianceStamped::ConstSharedPtr pose) {poses.push_back(*pose);});
+  wait_for_matched(map_pub);
+  wait_for_matched(observation_pub);
+  wait_for_matched(tf_pub);
+
+  // Odometry at the time of the observation, and 1.5 m further one second later
+  tf2_msgs::msg::TFMessage odom_tf;
+  for (auto i = 0; i < 2; ++i) {
+    geometry_msgs::msg::TransformStamped odom_base_link;
+    odom_base_link.header.frame_id = "odom";
+    odom_base_link.header.stamp.sec = 1 + i;
+    odom_base_link.child_frame_id = "base_link";
+    odom_base_link.transform.translation.x = 1.5 * i;
+    odom_tf.transforms.push_back(odom_base_link);
+  }
+  tf_pub->publish(odom_tf);
+
+  set_msg_id(m_map_msg, 0);
+  map_pub->publish(m_map_msg);
+  for (auto iter = 0U; (iter < max_poll_iters) && (get_msg_id(*map_tracker_ptr) != 0); ++iter) {
+    rclcpp::spin_some(localizer_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  ASSERT_EQ(get_msg_id(*map_tracker_ptr), 0);
+
+  set_msg_id(m_observation_msg, 3);
+  m_observation_msg.header.stamp.sec = 1;
+  observation_pub->publish(m_observation_msg);
+  for (auto iter = 0U; (iter < max_poll_iters) && poses.empty(); ++iter) {
+    rclcpp::spin_some(localizer_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  ASSERT_FALSE(poses.empty());
+  EXPECT_EQ(poses.front().header.stamp.sec, 2);
+  EXPECT_DOUBLE_EQ(poses.front().pose.pose.position.x, 4.5);
+  // Only once for the same odometry
+  for (auto iter = 0U; iter < 5U; ++iter) {
+    rclcpp::spin_some(localizer_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  EXPECT_EQ(poses.size(), 1U);
+  EXPECT_FALSE(localizer_node->register_exception());
+}
+
 //////////////////////////////////////////////////////////////////////// Implementations
 
 TestMap::TestMap(const std::shared_ptr<MapMsg> & map_ptr)
@@ -292,6 +442,11 @@ const std::shared_ptr<MsgWithHeader> & TestMap::get_msg_tracker()
 }
 
 
+TestRelativeLocalizerNode::~TestRelativeLocalizerNode()
+{
+  stop_pipeline();
+}
+
 void TestRelativeLocalizerNode::set_localizer_(std::unique_ptr<MockRelativeLocalizer> && localizer)
 {
   set_localizer(std::forward<std::unique_ptr<MockRelativeLocalizer>>(localizer));
@@ -318,6 +473,7 @@ PoseWithCovarianceStamped MockRelativeLocalizer::register_measurement(
   // The resulting frame id should contain observation's frame + initial guess' frame ID
   // So the result should be: obs_frame + obs_frame + map_frame
   pose_out.header.frame_id = msg.header.frame_id + transform_initial.header.frame_id;
+  pose_out.header.stamp = msg.header.stamp;
   set_msg_id(pose_out, get_msg_id(msg));
 
   // Update the tracking pointer for notifying the test.
@@ -103,6 +103,8 @@ public:
 
   using Base::Base;
 
+  ~TestRelativeLocalizerNode() override;
+
   // Expose protected methods for convenience
   void set_localizer_(std::unique_ptr<MockRelativeLocalizer> && localizer);
   void set_map_(std::unique_ptr<TestMap> && map);
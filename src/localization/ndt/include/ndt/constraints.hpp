@@ -77,6 +77,13 @@ struct P2DNDTOptimizationMapConstraint
   template<typename Map>
   using call_cell = decltype(std::declval<Map>().cell(std::declval<const Point &>()));
 
+  /// \brief  This expression requires a method that looks up the cells around the given location
+  /// into a caller owned vector, without modifying the map.
+  template<typename Map>
+  using call_cell_into = decltype(std::declval<const Map>().cell(
+      std::declval<const Point &>(), std::declval<VoxelViewVector &>(),
+      std::declval<VoxelLookup>()));
+
   /// \brief  This expression requires a method that returns the (std::chrono) timestamp of the
   /// \return Map frame ID.
   template<typename Map>
@@ -87,6 +94,11 @@ struct P2DNDTOptimizationMapConstraint
     const VoxelViewVector &>::value,
     "The map should provide a `cell(...)` method");
 
+  static_assert(
+    common::helper_functions::expression_valid_with_return<call_cell_into, MapT,
+    const VoxelViewVector &>::value,
+    "The map should provide a const `cell(point, output, lookup)` method");
+
   static_assert(
     common::helper_functions::expression_valid_with_return<call_cell_size, MapT,
     const perception::filters::voxel_grid::PointXYZ &>::value,
@@ -36,6 +36,37 @@ namespace localization
 namespace ndt
 {
 using Real = float64_t;
+
+/// Voxels returned by a map lookup for a point. Returning the neighbours of the voxel which
+/// contains the point widens the convergence basin of the registration, so larger voxels, and
+/// hence smaller maps, can be used at the cost of more lookups per point.
+enum class VoxelLookup
+{
+  /// Only the voxel which contains the point.
+  DIRECT1,
+  /// The voxel which contains the point and its 6 face neighbours.
+  DIRECT7,
+  /// The voxel which contains the point and its 26 neighbours.
+  DIRECT27
+};
+
+/// Get the maximum number of voxels returned by a lookup.
+/// \param lookup Lookup mode.
+/// \return Maximum number of voxels.
+constexpr std::size_t max_num_voxels(const VoxelLookup lookup) noexcept
+{
+  return (lookup == VoxelLookup::DIRECT27) ? 27U : ((lookup == VoxelLookup::DIRECT7) ? 7U : 1U);
+}
+
+/// Floating point precision of the gaussians of the P2D NDT objective.
+enum class EvaluationPrecision
+{
+  /// All terms are evaluated in double precision.
+  FLOAT64,
+  /// The Mahalanobis distances and exponentials are evaluated in vectorized batches in single
+  /// precision, and summed up in double precision.
+  FLOAT32
+};
 }  // namespace ndt
 }  // namespace localization
 }  // namespace autoware
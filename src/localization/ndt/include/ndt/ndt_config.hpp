@@ -17,8 +17,12 @@
 #ifndef NDT__NDT_CONFIG_HPP_
 #define NDT__NDT_CONFIG_HPP_
 
+#include <helper_functions/worker_pool.hpp>
 #include <ndt/ndt_common.hpp>
 #include <voxel_grid/config.hpp>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
 #include <utility>
 
 namespace autoware
@@ -34,9 +38,13 @@ class NDTLocalizerConfigBase
 public:
   /// Constructor
   /// \param guess_time_tolerance
+  /// \param score_tolerance_per_point Minimum improvement of the score per scan point for the
+  /// optimization to continue, 0 to only use the tolerances of the optimizer.
   NDTLocalizerConfigBase(
-    std::chrono::nanoseconds guess_time_tolerance)
-  : m_guess_time_tol{guess_time_tolerance} {}
+    std::chrono::nanoseconds guess_time_tolerance,
+    const Real score_tolerance_per_point = 0.0)
+  : m_guess_time_tol{guess_time_tolerance},
+    m_score_tolerance_per_point{score_tolerance_per_point} {}
 
   /// Get optimizer config.
   /// \return optimizer config
@@ -45,27 +53,73 @@ public:
     return m_guess_time_tol;
   }
 
+  /// Get the minimum score improvement per scan point.
+  /// \return score tolerance per point, 0 if unused.
+  Real score_tolerance_per_point() const noexcept
+  {
+    return m_score_tolerance_per_point;
+  }
+
 private:
   std::chrono::nanoseconds m_guess_time_tol;
+  Real m_score_tolerance_per_point;
 };
 
 
-/// Config class for p2d optimziation problem
+/// Config class for p2d optimziation problem. With more than one thread, the config starts the
+/// worker threads of the objective once, and all of its copies share them. The problems made from
+/// one config must therefore not be evaluated concurrently.
 class NDT_PUBLIC P2DNDTOptimizationConfig
 {
 public:
   /// Constructor
   /// \param outlier_ratio Outlier ratio to be used in the gaussian distribution variation used
   /// in (eq. 6.7) [Magnusson 2009]
-  explicit P2DNDTOptimizationConfig(Real outlier_ratio)
-  : m_outlier_ratio{outlier_ratio} {}
+  /// \param num_threads Number of threads to evaluate the objective with, including the calling
+  /// thread. Values below 1 are treated as 1.
+  /// \param lookup Which voxels around each scan point contribute to the objective.
+  /// \param precision Floating point precision of the gaussians of the objective.
+  explicit P2DNDTOptimizationConfig(
+    Real outlier_ratio, const uint32_t num_threads = 1U,
+    const VoxelLookup lookup = VoxelLookup::DIRECT1,
+    const EvaluationPrecision precision = EvaluationPrecision::FLOAT64)
+  : m_outlier_ratio{outlier_ratio}, m_num_threads{std::max(num_threads, 1U)}, m_lookup{lookup},
+    m_precision{precision}
+  {
+    if (m_num_threads > 1U) {
+      m_workers = std::make_shared<common::helper_functions::WorkerPool>(m_num_threads);
+    }
+  }
 
   /// Get outlier ratio.
   /// \return outlier ratio.
   Real outlier_ratio() const noexcept {return m_outlier_ratio;}
 
+  /// Get number of threads.
+  /// \return number of threads, at least 1.
+  uint32_t num_threads() const noexcept {return m_num_threads;}
+
+  /// Get voxel lookup mode.
+  /// \return voxel lookup mode.
+  VoxelLookup lookup() const noexcept {return m_lookup;}
+
+  /// Get floating point precision of the gaussians.
+  /// \return evaluation precision.
+  EvaluationPrecision precision() const noexcept {return m_precision;}
+
+  /// Get the worker threads of the objective.
+  /// \return workers shared by the copies of this config, nullptr for a single thread.
+  const std::shared_ptr<common::helper_functions::WorkerPool> & workers() const noexcept
+  {
+    return m_workers;
+  }
+
 private:
   Real m_outlier_ratio;
+  uint32_t m_num_threads;
+  VoxelLookup m_lookup;
+  EvaluationPrecision m_precision;
+  std::shared_ptr<common::helper_functions::WorkerPool> m_workers;
 };
 
 
@@ -78,11 +132,24 @@ public:
   /// points expected in a single lidar scan.
   /// \param guess_time_tolerance Time difference tolerance between the initial guess timestamp
   /// and the timestamp of the scan.
+  /// \param num_threads Number of threads to evaluate the optimization objective with. Values
+  /// below 1 are treated as 1.
+  /// \param lookup Which voxels around each scan point contribute to the optimization objective.
+  /// \param score_tolerance_per_point Minimum improvement of the score per scan point for the
+  /// optimization to continue, 0 to only use the tolerances of the optimizer.
+  /// \param precision Floating point precision of the gaussians of the optimization objective.
   P2DNDTLocalizerConfig(
     const uint32_t scan_capacity,
-    std::chrono::nanoseconds guess_time_tolerance)
-  : NDTLocalizerConfigBase{guess_time_tolerance},
-    m_scan_capacity(scan_capacity) {}
+    std::chrono::nanoseconds guess_time_tolerance,
+    const uint32_t num_threads = 1U,
+    const VoxelLookup lookup = VoxelLookup::DIRECT1,
+    const Real score_tolerance_per_point = 0.0,
+    const EvaluationPrecision precision = EvaluationPrecision::FLOAT64)
+  : NDTLocalizerConfigBase{guess_time_tolerance, score_tolerance_per_point},
+    m_scan_capacity(scan_capacity),
+    m_num_threads(std::max(num_threads, 1U)),
+    m_lookup(lookup),
+    m_precision(precision) {}
 
   /// Get scan capacity.
   /// \return scan capacity.
@@ -91,8 +158,101 @@ public:
     return m_scan_capacity;
   }
 
+  /// Get number of threads used to evaluate the optimization objective.
+  /// \return number of threads, at least 1.
+  uint32_t num_threads() const noexcept
+  {
+    return m_num_threads;
+  }
+
+  /// Get voxel lookup mode of the optimization objective.
+  /// \return voxel lookup mode.
+  VoxelLookup lookup() const noexcept
+  {
+    return m_lookup;
+  }
+
+  /// Get floating point precision of the gaussians of the optimization objective.
+  /// \return evaluation precision.
+  EvaluationPrecision precision() const noexcept
+  {
+    return m_precision;
+  }
+
 private:
   uint32_t m_scan_capacity;
+  uint32_t m_num_threads;
+  VoxelLookup m_lookup;
+  EvaluationPrecision m_precision;
+};
+
+/// Config class for the global initialization of a localizer around a coarse position fix. The
+/// candidate poses are the positions of a square grid centered on the fix, each with evenly
+/// spaced yaw angles over a full turn.
+class NDT_PUBLIC GlobalInitializationConfig
+{
+public:
+  /// Constructor
+  /// \param position_range Half side length of the square of candidate positions, 0 for only the
+  /// position of the fix.
+  /// \param position_step Distance between neighboring candidate positions.
+  /// \param num_yaw_bins Number of candidate yaw angles per position.
+  /// \param num_kept_candidates Number of candidates with the best score at their initial pose
+  /// which are optimized. The other ones are rejected without an optimization.
+  /// \param num_threads Number of threads to score and optimize the candidates with. Values below
+  /// 1 are treated as 1.
+  /// \throws std::domain_error on a negative range, a step which is not positive, or 0 yaw bins
+  /// or kept candidates.
+  GlobalInitializationConfig(
+    const Real position_range,
+    const Real position_step,
+    const uint32_t num_yaw_bins,
+    const uint32_t num_kept_candidates,
+    const uint32_t num_threads = 1U)
+  : m_position_range{position_range},
+    m_position_step{position_step},
+    m_num_yaw_bins{num_yaw_bins},
+    m_num_kept_candidates{num_kept_candidates},
+    m_num_threads{std::max(num_threads, 1U)}
+  {
+    if (!(position_range >= 0.0) || !(position_step > 0.0)) {
+      throw std::domain_error(
+              "GlobalInitializationConfig: The position range should not be negative and the "
+              "position step should be positive.");
+    }
+    if ((num_yaw_bins == 0U) || (num_kept_candidates == 0U)) {
+      throw std::domain_error(
+              "GlobalInitializationConfig: There should be at least one yaw bin and one kept "
+              "candidate.");
+    }
+  }
+
+  /// Get the half side length of the square of candidate positions.
+  /// \return position range.
+  Real position_range() const noexcept {return m_position_range;}
+
+  /// Get the distance between neighboring candidate positions.
+  /// \return position step.
+  Real position_step() const noexcept {return m_position_step;}
+
+  /// Get the number of candidate yaw angles per position.
+  /// \return number of yaw bins, at least 1.
+  uint32_t num_yaw_bins() const noexcept {return m_num_yaw_bins;}
+
+  /// Get the number of candidates which are optimized.
+  /// \return number of kept candidates, at least 1.
+  uint32_t num_kept_candidates() const noexcept {return m_num_kept_candidates;}
+
+  /// Get the number of threads to score and optimize the candidates with.
+  /// \return number of threads, at least 1.
+  uint32_t num_threads() const noexcept {return m_num_threads;}
+
+private:
+  Real m_position_range;
+  Real m_position_step;
+  uint32_t m_num_yaw_bins;
+  uint32_t m_num_kept_candidates;
+  uint32_t m_num_threads;
 };
 
 }  // namespace ndt
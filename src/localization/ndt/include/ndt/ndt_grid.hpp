@@ -19,8 +19,14 @@
 
 #include <common/types.hpp>
 #include <ndt/ndt_common.hpp>
+#include <ndt/ndt_grid_storage.hpp>
 #include <ndt/ndt_voxel_view.hpp>
+#include <array>
+#include <cmath>
+#include <cstdlib>
 #include <vector>
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <unordered_map>
 #include <utility>
@@ -36,11 +42,13 @@ namespace ndt
 {
 /// \brief A voxel grid implementation for normal distribution transform
 /// \tparam VoxelT Voxel type
-template<typename VoxelT>
+/// \tparam StorageT Storage policy of the voxels, `HashGridStorage` or `DenseGridStorage`.
+template<typename VoxelT, typename StorageT = HashGridStorage>
 class NDTGrid
 {
 public:
-  using Grid = std::unordered_map<uint64_t, VoxelT>;
+  using Storage = StorageT;
+  using Grid = typename StorageT::template Grid<VoxelT>;
   using Point = Eigen::Vector3d;
   using Config = autoware::perception::filters::voxel_grid::Config;
   using VoxelViewVector = std::vector<VoxelView<VoxelT>>;
@@ -48,10 +56,11 @@ public:
 
   /// Constructor
   /// \param voxel_grid_config Voxel grid config to configure the underlying voxel grid.
+  /// \throws std::domain_error if the storage cannot hold the grid, see `DenseVoxelGrid`.
   explicit NDTGrid(const Config & voxel_grid_config)
-  : m_config(voxel_grid_config), m_map(m_config.get_capacity())
+  : m_config(voxel_grid_config), m_map(StorageT::template make<VoxelT>(m_config))
   {
-    m_output_vector.reserve(1U);
+    m_output_vector.reserve(max_num_voxels(VoxelLookup::DIRECT27));
   }
 
   // Maps should be moved rather than being copied.
@@ -81,14 +90,62 @@ public:
   /// near-neighbour cell queries in the future.
   const VoxelViewVector & cell(const Point & pt) const
   {
-    // TODO(yunus.caliskan): revisit after multi-cell lookup support. #985
-    m_output_vector.clear();
-    const auto vx_it = m_map.find(m_config.index(pt));
-    // Only return a voxel if it's occupied (i.e. has enough points to compute covariance.)
-    if (vx_it != m_map.end() && vx_it->second.usable()) {
-      m_output_vector.emplace_back(vx_it->second);
+    return cell(pt, m_output_vector);
+  }
+
+  /// Lookup the cell at location into a vector owned by the caller. Unlike the other lookups,
+  /// this does not modify the grid, so it can be called concurrently from multiple threads.
+  /// \param pt point to lookup
+  /// \param output Vector to store the cells in. Its previous contents are cleared. Reserving
+  /// `max_num_voxels(lookup)` elements avoids allocating during the lookup.
+  /// \param lookup Which voxels around the point to return. The voxel containing the point
+  /// comes first, and each voxel is returned once even where the neighbours are clamped to the
+  /// grid's bounds.
+  /// \return Reference to `output`.
+  const VoxelViewVector & cell(
+    const Point & pt, VoxelViewVector & output,
+    const VoxelLookup lookup = VoxelLookup::DIRECT1) const
+  {
+    output.clear();
+    const auto center_idx = m_config.index(pt);
+    add_usable_voxel(center_idx, output);
+    if (lookup == VoxelLookup::DIRECT1) {
+      return output;
     }
-    return m_output_vector;
+    // Offset the center of the voxel rather than the point itself, so that a neighbour is not
+    // missed due to rounding when the point is close to a voxel boundary.
+    const auto & min_point = m_config.get_min_point();
+    const auto & size = m_config.get_voxel_size();
+    const auto center = [](const Real coord, const Real min, const Real size) {
+        return min + ((std::floor((coord - min) / size) + 0.5) * size);
+      };
+    const Point center_pt{
+      center(pt(0U), min_point.x, size.x), center(pt(1U), min_point.y, size.y),
+      center(pt(2U), min_point.z, size.z)};
+    std::array<uint64_t, max_num_voxels(VoxelLookup::DIRECT27)> visited{};
+    visited[0U] = center_idx;
+    std::size_t num_visited = 1U;
+    for (int32_t dz = -1; dz <= 1; ++dz) {
+      for (int32_t dy = -1; dy <= 1; ++dy) {
+        for (int32_t dx = -1; dx <= 1; ++dx) {
+          const auto num_offsets = std::abs(dx) + std::abs(dy) + std::abs(dz);
+          if ((num_offsets == 0) || ((lookup == VoxelLookup::DIRECT7) && (num_offsets > 1))) {
+            continue;
+          }
+          const Point neighbour{
+            center_pt(0U) + (dx * size.x), center_pt(1U) + (dy * size.y),
+            center_pt(2U) + (dz * size.z)};
+          const auto idx = m_config.index(neighbour);
+          const auto visited_end = std::next(visited.begin(), num_visited);
+          if (std::find(visited.begin(), visited_end, idx) == visited_end) {
+            visited[num_visited] = idx;
+            ++num_visited;
+            add_usable_voxel(idx, output);
+          }
+        }
+      }
+    }
+    return output;
   }
 
   /// Get size of the map
@@ -171,6 +228,14 @@ public:
     return m_map.emplace(std::forward<Args>(args)...);
   }
 
+  /// \brief Erase a voxel from the grid.
+  /// \param it Iterator to the voxel to erase.
+  /// \return Iterator to the voxel following the erased one.
+  typename Grid::iterator erase(typename Grid::const_iterator it)
+  {
+    return m_map.erase(it);
+  }
+
   /// \brief Add a point to its corresponding voxel in the grid.
   /// \param pt Point to be added
   void add_observation(const Point & pt)
@@ -178,10 +243,12 @@ public:
     m_map[index(pt)].add_observation(pt);
   }
 
-  /// \brief Set the configuration
+  /// \brief Set the configuration. With `DenseGridStorage`, this also removes all voxels.
   /// \param config Config object to be set.
+  /// \throws std::domain_error if the storage cannot hold the grid, see `DenseVoxelGrid`.
   void set_config(const Config & config)
   {
+    StorageT::configure(m_map, config);
     m_config = config;
   }
 
@@ -193,6 +260,15 @@ public:
   }
 
 private:
+  void add_usable_voxel(const uint64_t idx, VoxelViewVector & output) const
+  {
+    const auto vx_it = m_map.find(idx);
+    // Only return a voxel if it's occupied (i.e. has enough points to compute covariance.)
+    if (vx_it != m_map.end() && vx_it->second.usable()) {
+      output.emplace_back(vx_it->second);
+    }
+  }
+
   mutable VoxelViewVector m_output_vector;
   Config m_config;
   Grid m_map;
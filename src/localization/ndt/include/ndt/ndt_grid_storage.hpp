@@ -0,0 +1,220 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#ifndef NDT__NDT_GRID_STORAGE_HPP_
+#define NDT__NDT_GRID_STORAGE_HPP_
+
+#include <ndt/ndt_common.hpp>
+#include <voxel_grid/config.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace autoware
+{
+namespace localization
+{
+namespace ndt
+{
+/// \brief Voxel container which stores the occupied voxels contiguously and finds them through a
+/// dense array with a slot for every cell of the grid. A lookup is a single array access instead
+/// of hashing and probing a bucket, at the cost of 4 bytes per cell of the grid's bounds. Hence
+/// it is meant for maps with tight bounds, e.g. a local map made up of streamed tiles. It
+/// provides the subset of the `std::unordered_map<uint64_t, VoxelT>` interface used by `NDTGrid`.
+/// Erasing a voxel moves the last voxel into its place, so iterators and references to voxels
+/// are invalidated by both inserting and erasing.
+/// \tparam VoxelT Voxel type
+template<typename VoxelT>
+class DenseVoxelGrid
+{
+public:
+  using Config = autoware::perception::filters::voxel_grid::Config;
+  using key_type = uint64_t;
+  using mapped_type = VoxelT;
+  using value_type = std::pair<key_type, VoxelT>;
+  using Voxels = std::vector<value_type>;
+  using iterator = typename Voxels::iterator;
+  using const_iterator = typename Voxels::const_iterator;
+
+  /// Constructor
+  /// \param config Configuration of the grid whose cells get a slot.
+  /// \throws std::domain_error if the grid has too many cells, see `configure()`.
+  explicit DenseVoxelGrid(const Config & config)
+  {
+    configure(config);
+  }
+
+  /// Remove all voxels and allocate a slot for each cell of a grid.
+  /// \param config Configuration of the grid whose cells get a slot.
+  /// \throws std::domain_error if the grid has more cells than a slot can address.
+  void configure(const Config & config)
+  {
+    // The voxel index grows along each axis, so the max point has the largest index.
+    const auto num_cells = config.index(config.get_max_point()) + 1U;
+    if (num_cells >= static_cast<uint64_t>(std::numeric_limits<Slot>::max())) {
+      throw std::domain_error("DenseVoxelGrid: The grid has too many cells for dense storage.");
+    }
+    m_voxels.clear();
+    m_voxels.reserve(std::min(static_cast<uint64_t>(config.get_capacity()), num_cells));
+    m_slots.assign(static_cast<std::size_t>(num_cells), kEmptySlot);
+  }
+
+  /// Find the voxel of a cell.
+  /// \param key Index of the cell.
+  /// \return Iterator to the voxel, or `end()` if the cell has no voxel.
+  iterator find(const key_type key) noexcept
+  {
+    const auto slot = slot_of(key);
+    return (slot == kEmptySlot) ? m_voxels.end() : std::next(m_voxels.begin(), slot);
+  }
+
+  /// Find the voxel of a cell.
+  /// \param key Index of the cell.
+  /// \return Iterator to the voxel, or `end()` if the cell has no voxel.
+  const_iterator find(const key_type key) const noexcept
+  {
+    const auto slot = slot_of(key);
+    return (slot == kEmptySlot) ? m_voxels.cend() : std::next(m_voxels.cbegin(), slot);
+  }
+
+  /// Insert a voxel into a cell which has none.
+  /// \param key Index of the cell.
+  /// \param voxel_args Arguments to construct the voxel from.
+  /// \return Iterator to the voxel of the cell, and whether the voxel was inserted.
+  /// \throws std::out_of_range if the index is not a cell of the grid.
+  template<typename ... Args>
+  std::pair<iterator, bool> emplace(const key_type key, Args && ... voxel_args)
+  {
+    auto & slot = m_slots.at(static_cast<std::size_t>(key));
+    if (slot != kEmptySlot) {
+      return {std::next(m_voxels.begin(), slot), false};
+    }
+    m_voxels.emplace_back(
+      std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(voxel_args)...));
+    slot = static_cast<Slot>(m_voxels.size() - 1U);
+    return {std::prev(m_voxels.end()), true};
+  }
+
+  /// Get the voxel of a cell, default constructed if the cell has none.
+  /// \param key Index of the cell.
+  /// \return Reference to the voxel.
+  /// \throws std::out_of_range if the index is not a cell of the grid.
+  VoxelT & operator[](const key_type key)
+  {
+    return emplace(key).first->second;
+  }
+
+  /// Erase a voxel, the last voxel is moved into its place.
+  /// \param it Iterator to the voxel to erase.
+  /// \return Iterator to the voxel which took the place of the erased one, or `end()`.
+  iterator erase(const_iterator it)
+  {
+    const auto position = static_cast<std::size_t>(std::distance(m_voxels.cbegin(), it));
+    m_slots[static_cast<std::size_t>(it->first)] = kEmptySlot;
+    if (position + 1U != m_voxels.size()) {
+      m_voxels[position] = std::move(m_voxels.back());
+      m_slots[static_cast<std::size_t>(m_voxels[position].first)] = static_cast<Slot>(position);
+    }
+    m_voxels.pop_back();
+    return std::next(m_voxels.begin(), static_cast<std::ptrdiff_t>(position));
+  }
+
+  /// Remove all voxels, in time linear in the number of voxels rather than cells.
+  void clear() noexcept
+  {
+    for (const auto & voxel : m_voxels) {
+      m_slots[static_cast<std::size_t>(voxel.first)] = kEmptySlot;
+    }
+    m_voxels.clear();
+  }
+
+  /// Get the number of voxels.
+  std::size_t size() const noexcept {return m_voxels.size();}
+
+  iterator begin() noexcept {return m_voxels.begin();}
+  iterator end() noexcept {return m_voxels.end();}
+  const_iterator begin() const noexcept {return m_voxels.cbegin();}
+  const_iterator end() const noexcept {return m_voxels.cend();}
+  const_iterator cbegin() const noexcept {return m_voxels.cbegin();}
+  const_iterator cend() const noexcept {return m_voxels.cend();}
+
+private:
+  using Slot = uint32_t;
+  static constexpr Slot kEmptySlot = std::numeric_limits<Slot>::max();
+
+  Slot slot_of(const key_type key) const noexcept
+  {
+    return (key < m_slots.size()) ? m_slots[static_cast<std::size_t>(key)] : kEmptySlot;
+  }
+
+  Voxels m_voxels{};
+  std::vector<Slot> m_slots{};
+};
+
+template<typename VoxelT>
+constexpr typename DenseVoxelGrid<VoxelT>::Slot DenseVoxelGrid<VoxelT>::kEmptySlot;
+
+/// Storage policy of `NDTGrid` keeping the voxels in a hash map, so memory only grows with the
+/// number of occupied voxels. This suits maps of any extent.
+struct HashGridStorage
+{
+  template<typename VoxelT>
+  using Grid = std::unordered_map<uint64_t, VoxelT>;
+  using Config = autoware::perception::filters::voxel_grid::Config;
+
+  template<typename VoxelT>
+  static Grid<VoxelT> make(const Config & config)
+  {
+    return Grid<VoxelT>(config.get_capacity());
+  }
+
+  template<typename VoxelT>
+  static void configure(Grid<VoxelT> &, const Config &) noexcept {}
+};
+
+/// Storage policy of `NDTGrid` keeping the voxels in a `DenseVoxelGrid`, for faster lookups in
+/// maps with tight bounds.
+struct DenseGridStorage
+{
+  template<typename VoxelT>
+  using Grid = DenseVoxelGrid<VoxelT>;
+  using Config = autoware::perception::filters::voxel_grid::Config;
+
+  template<typename VoxelT>
+  static Grid<VoxelT> make(const Config & config)
+  {
+    return Grid<VoxelT>{config};
+  }
+
+  /// Reallocate the slots for a new grid configuration, which removes all voxels.
+  template<typename VoxelT>
+  static void configure(Grid<VoxelT> & grid, const Config & config)
+  {
+    grid.configure(config);
+  }
+};
+}  // namespace ndt
+}  // namespace localization
+}  // namespace autoware
+
+#endif  // NDT__NDT_GRID_STORAGE_HPP_
@@ -0,0 +1,204 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#ifndef NDT__NDT_KERNELS_HPP_
+#define NDT__NDT_KERNELS_HPP_
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "common/types.hpp"
+
+namespace autoware
+{
+namespace localization
+{
+namespace ndt
+{
+using autoware::common::types::float32_t;
+
+/// Smallest argument of `fast_exp()`, e^x is below the smallest normal float for smaller x.
+constexpr float32_t kFastExpMin = -87.3F;
+/// Largest argument of `fast_exp()`, e^x overflows a float for larger x.
+constexpr float32_t kFastExpMax = 88.3F;
+
+/// \brief Exponential function without branches or library calls, so that loops over it are
+/// vectorized by the compiler. The relative error is below 1e-7. The argument is not clamped to
+/// the valid range, since a clamp in the same loop keeps the compiler from vectorizing it.
+/// \param x Argument within [kFastExpMin, kFastExpMax].
+/// \return Approximation of e^x.
+inline float32_t fast_exp(const float32_t x) noexcept
+{
+  // Coefficients of the minimax polynomial of exp on [-ln(2) / 2, ln(2) / 2], taken from Cephes
+  constexpr float32_t kLog2e = 1.44269504088896341F;
+  constexpr float32_t kLn2Hi = 0.693359375F;
+  constexpr float32_t kLn2Lo = -2.12194440e-4F;
+  // e^x = 2^n * e^r with n = round(x / ln(2)). Adding 1.5 * 2^23 rounds to an integer, which is
+  // then held in the low bits of the mantissa, so that no float to int conversion is needed.
+  constexpr float32_t kRoundingShift = 12582912.0F;
+  constexpr int32_t kRoundingShiftBits = 0x4B400000;
+  const float32_t shifted = (x * kLog2e) + kRoundingShift;
+  const float32_t nf = shifted - kRoundingShift;
+  int32_t shifted_bits;
+  std::memcpy(&shifted_bits, &shifted, sizeof(shifted_bits));
+  const int32_t n = shifted_bits - kRoundingShiftBits;
+  // Cody-Waite reduction, ln(2) is split so that n * kLn2Hi is exact
+  const float32_t r = (x - (nf * kLn2Hi)) - (nf * kLn2Lo);
+  float32_t p = 1.9875691500E-4F;
+  p = (p * r) + 1.3981999507E-3F;
+  p = (p * r) + 8.3334519073E-3F;
+  p = (p * r) + 4.1665795894E-2F;
+  p = (p * r) + 1.6666665459E-1F;
+  p = (p * r) + 5.0000001201E-1F;
+  const float32_t exp_r = (((p * r) * r) + r) + 1.0F;
+  // 2^n, built from its exponent bits. n is within [-126, 127] for arguments in the valid range.
+  const int32_t bits = (n + 127) << 23;
+  float32_t scale;
+  std::memcpy(&scale, &bits, sizeof(scale));
+  return exp_r * scale;
+}
+
+/// \brief Batch of point to voxel residuals in single precision, stored as structure of arrays
+/// with the inverse covariance of each voxel packed as its 6 upper triangular entries. Evaluating
+/// the gaussians of the whole batch at once lets the compiler vectorize the Mahalanobis distances
+/// and exponentials, which dominate the cost of a scalar evaluation in double precision. The
+/// buffers keep their memory when cleared, so a batch reused across evaluations does not allocate.
+class MahalanobisBatch
+{
+public:
+  using Residual = Eigen::Vector3d;
+  using InverseCovariance = Eigen::Matrix3d;
+
+  /// Reserve memory for a number of residuals.
+  /// \param capacity Number of residuals.
+  void reserve(const std::size_t capacity)
+  {
+    for (auto * buffer : buffers()) {
+      buffer->reserve(capacity);
+    }
+  }
+
+  /// Remove all residuals.
+  void clear() noexcept
+  {
+    for (auto * buffer : buffers()) {
+      buffer->clear();
+    }
+  }
+
+  /// Get the number of residuals.
+  std::size_t size() const noexcept {return m_x.size();}
+
+  /// Add a residual, rounded to single precision.
+  /// \param residual Difference of the transformed scan point and the voxel centroid.
+  /// \param inv_cov Inverse covariance of the voxel, only its upper triangle is read.
+  void push_back(const Residual & residual, const InverseCovariance & inv_cov)
+  {
+    m_x.push_back(static_cast<float32_t>(residual.x()));
+    m_y.push_back(static_cast<float32_t>(residual.y()));
+    m_z.push_back(static_cast<float32_t>(residual.z()));
+    m_xx.push_back(static_cast<float32_t>(inv_cov(0, 0)));
+    m_xy.push_back(static_cast<float32_t>(inv_cov(0, 1)));
+    m_xz.push_back(static_cast<float32_t>(inv_cov(0, 2)));
+    m_yy.push_back(static_cast<float32_t>(inv_cov(1, 1)));
+    m_yz.push_back(static_cast<float32_t>(inv_cov(1, 2)));
+    m_zz.push_back(static_cast<float32_t>(inv_cov(2, 2)));
+    m_gaussian.push_back(0.0F);
+  }
+
+  /// Evaluate e^(-scale * r^T Sigma^-1 r) for all residuals r.
+  /// \param scale Factor of the Mahalanobis distances in the exponent.
+  void evaluate_gaussians(const float32_t scale) noexcept
+  {
+    const std::size_t num_residuals = size();
+    const float32_t * const x = m_x.data();
+    const float32_t * const y = m_y.data();
+    const float32_t * const z = m_z.data();
+    const float32_t * const xx = m_xx.data();
+    const float32_t * const xy = m_xy.data();
+    const float32_t * const xz = m_xz.data();
+    const float32_t * const yy = m_yy.data();
+    const float32_t * const yz = m_yz.data();
+    const float32_t * const zz = m_zz.data();
+    float32_t * const gaussian = m_gaussian.data();
+    // Two passes, each of which is vectorized, as a clamp and the exponential in one loop are not.
+    // The exponents are not positive beyond rounding errors, so they are only clamped below.
+    for (std::size_t i = 0U; i < num_residuals; ++i) {
+      const float32_t mahalanobis =
+        (xx[i] * x[i] * x[i]) + (yy[i] * y[i] * y[i]) + (zz[i] * z[i] * z[i]) +
+        (2.0F * ((xy[i] * x[i] * y[i]) + (xz[i] * x[i] * z[i]) + (yz[i] * y[i] * z[i])));
+      gaussian[i] = std::max(-scale * mahalanobis, kFastExpMin);
+    }
+    for (std::size_t i = 0U; i < num_residuals; ++i) {
+      gaussian[i] = fast_exp(gaussian[i]);
+    }
+  }
+
+  /// Get a residual.
+  /// \param i Index of the residual.
+  /// \return The residual as it was rounded to single precision.
+  Residual residual(const std::size_t i) const
+  {
+    return Residual{m_x[i], m_y[i], m_z[i]};
+  }
+
+  /// Get the inverse covariance of a residual.
+  /// \param i Index of the residual.
+  /// \return The symmetric inverse covariance as it was rounded to single precision.
+  InverseCovariance inverse_covariance(const std::size_t i) const
+  {
+    InverseCovariance inv_cov;
+    inv_cov << m_xx[i], m_xy[i], m_xz[i],
+      m_xy[i], m_yy[i], m_yz[i],
+      m_xz[i], m_yz[i], m_zz[i];
+    return inv_cov;
+  }
+
+  /// Get the gaussian of a residual computed by the last `evaluate_gaussians()`.
+  /// \param i Index of the residual.
+  /// \return Value of the gaussian.
+  float32_t gaussian(const std::size_t i) const
+  {
+    return m_gaussian[i];
+  }
+
+private:
+  using Buffer = std::vector<float32_t>;
+
+  std::array<Buffer *, 10U> buffers() noexcept
+  {
+    return {&m_x, &m_y, &m_z, &m_xx, &m_xy, &m_xz, &m_yy, &m_yz, &m_zz, &m_gaussian};
+  }
+
+  Buffer m_x{};
+  Buffer m_y{};
+  Buffer m_z{};
+  Buffer m_xx{};
+  Buffer m_xy{};
+  Buffer m_xz{};
+  Buffer m_yy{};
+  Buffer m_yz{};
+  Buffer m_zz{};
+  Buffer m_gaussian{};
+};
+}  // namespace ndt
+}  // namespace localization
+}  // namespace autoware
+
+#endif  // NDT__NDT_KERNELS_HPP_
@@ -24,12 +24,19 @@
 #include <geometry_msgs/msg/transform_stamped.hpp>
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
 #include <ndt/ndt_common.hpp>
+#include <ndt/ndt_map_pyramid.hpp>
 #include <ndt/ndt_optimization_problem.hpp>
 #include <ndt/constraints.hpp>
 #include <optimization/optimizer_options.hpp>
 #include <experimental/optional>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <numeric>
+#include <thread>
 #include <utility>
 #include <string>
+#include <vector>
 
 namespace autoware
 {
@@ -42,7 +49,8 @@ using CloudT = sensor_msgs::msg::PointCloud2;
 /// Base class for NDT based localizers. Implementations must implement the validation logic.
 /// \tparam ScanT Type of ndt scan.
 /// \tparam NDTOptimizationProblemT Type of ndt optimization problem.
-/// \tparam OptimizerT Type of optimizer.
+/// \tparam OptimizerT Type of optimizer. A score tolerance per point needs its `options()` and
+/// `set_options()`.
 /// \tparam ConfigT Type of localization configuration.
 template<
   typename ScanT,
@@ -97,47 +105,153 @@ public:
     const MapT & map,
     Summary * const summary = nullptr)
   {
-    PoseWithCovarianceStamped pose_out{};
-    validate_msg(msg, map);
-    validate_guess(msg, transform_initial);
-    // Initial checks passed, proceed with initialization
-    // Eigen representations to be used for internal computations.
-    EigenPose<Real> eig_pose_initial, eig_pose_result;
-    eig_pose_initial.setZero();
-    eig_pose_result.setZero();
-    // Convert the ros transform/pose to eigen pose vector
-    transform_adapters::transform_to_pose(transform_initial.transform, eig_pose_initial);
+    return register_coarse_to_fine(msg, transform_initial, &map, &map + 1, summary);
+  }
 
-    // Set the scan
-    m_scan.clear();
-    m_scan.insert(msg);
+  /// Register a measurement to a map pyramid from the coarsest to the finest level, each level
+  /// starting from the pose estimate of the previous one. Other than that, this behaves as
+  /// registering to the finest level. A coarse level whose optimization fails numerically is
+  /// skipped.
+  /// \tparam MapT Map type of the levels.
+  /// \param[in] msg Measurement message to register.
+  /// \param[in] transform_initial Initial guess of the pose for the coarsest level.
+  /// \param[in] maps Map pyramid to register.
+  /// \param[out] summary (Optional) Reference to the registration summary of the finest level.
+  /// \return Pose estimate after registration.
+  /// \throws std::runtime_error if the pyramid is empty, and as if registering to a single map.
+  template<typename MapT,
+    Requires = traits::LocalizationMapConstraint<MapT>::value>
+  PoseWithCovarianceStamped register_measurement(
+    const CloudT & msg,
+    const Transform & transform_initial,
+    const NDTMapPyramid<MapT> & maps,
+    Summary * const summary = nullptr)
+  {
+    const auto levels = levels_of(maps);
+    return register_coarse_to_fine(msg, transform_initial, levels.first, levels.second, summary);
+  }
 
-    // Define and solve the problem.
-    NDTOptimizationProblemT problem(m_scan, map, m_optimization_problem_config);
-    const auto opt_summary = m_optimizer.solve(problem, eig_pose_initial, eig_pose_result);
+  /// Convert a measurement into a scan, e.g. one made by `make_scan()` of the implementation
+  /// class. This does not access the state of the localizer, so it can run concurrently with the
+  /// registration of another measurement, e.g. to overlap the conversion of the next lidar frame
+  /// with the optimization of the current one.
+  /// \param[in] msg Measurement message to convert.
+  /// \param[out] scan Scan to replace the content of.
+  void prepare_scan(const CloudT & msg, ScanT & scan) const
+  {
+    scan.clear();
+    scan.insert(msg);
+  }
 
-    if (opt_summary.termination_type() == common::optimization::TerminationType::FAILURE) {
-      throw std::runtime_error(
-              "NDT localizer has likely encountered a numerical "
-              "error during optimization.");
-    }
+  /// Register a measurement which was already converted into a scan by `prepare_scan()`. Other
+  /// than skipping the conversion, this behaves as `register_measurement(msg, ...)`.
+  /// \tparam MapT Map type or map pyramid type to register to.
+  /// \param[in] msg Measurement message the scan was prepared from.
+  /// \param[in,out] scan Prepared scan. Unless the message is rejected, it is exchanged with the
+  /// last used scan, whose buffer can be reused to prepare the next measurement.
+  /// \param[in] transform_initial Initial guess of the pose.
+  /// \param[in] map Map or map pyramid to register to.
+  /// \param[out] summary (Optional) Reference to the registration summary.
+  /// \return Pose estimate after registration.
+  /// \throws As `register_measurement(msg, ...)`.
+  template<typename MapT>
+  PoseWithCovarianceStamped register_measurement(
+    const CloudT & msg,
+    ScanT & scan,
+    const Transform & transform_initial,
+    const MapT & map,
+    Summary * const summary = nullptr)
+  {
+    const auto levels = levels_of(map);
+    return register_coarse_to_fine(
+      msg, transform_initial, levels.first, levels.second, summary, &scan);
+  }
 
-    // Convert eigen pose back to ros pose/transform
-    transform_adapters::pose_to_transform(
-      eig_pose_result,
-      pose_out.pose.pose);
+  /// Register a measurement without a guess of the orientation, e.g. to initialize the
+  /// localizer from a coarse position fix of a GNSS receiver instead of a pose given by hand.
+  /// Candidate poses are sampled around the fix as configured. All candidates are scored at their
+  /// pose on the coarsest level, only the best scoring ones are optimized on that level, and the
+  /// best optimized candidate is registered from coarse to fine as by `register_measurement()`.
+  /// Higher scores are better, as for the maximized P2D objective. The candidates are scored and
+  /// optimized on the configured number of threads, each with its own copy of the optimizer.
+  /// \tparam MapT Map type or map pyramid type to register to.
+  /// \param[in] msg Measurement message to register.
+  /// \param[in] coarse_fix Position fix in the map frame. Its orientation and its time stamp are
+  /// ignored, the candidates start from zero roll and pitch.
+  /// \param[in] map Map or map pyramid to register to.
+  /// \param[in] config Sampling of the candidates.
+  /// \param[out] summary (Optional) Reference to the registration summary of the best candidate.
+  /// \return Pose estimate of the best candidate.
+  /// \throws std::runtime_error if the optimizations of all candidates fail numerically, and as
+  /// `register_measurement(msg, ...)`.
+  template<typename MapT>
+  PoseWithCovarianceStamped register_globally(
+    const CloudT & msg,
+    const Transform & coarse_fix,
+    const MapT & map,
+    const GlobalInitializationConfig & config,
+    Summary * const summary = nullptr)
+  {
+    const auto levels = levels_of(map);
+    const auto & coarse_map = *levels.first;
+    validate_msg(msg, *(levels.second - 1));
+    prepare_scan(msg, m_scan);
+    scale_score_tolerance();
 
-    pose_out.header.stamp = msg.header.stamp;
-    pose_out.header.frame_id = map.frame_id();
+    const auto candidates = make_candidates(coarse_fix, config);
+    const auto problem_config = candidate_problem_config();
+    // Early rejection by the score at the initial pose, which costs a fraction of an optimization
+    std::vector<Real> scores(candidates.size());
+    run_in_chunks(
+      candidates.size(), config.num_threads(),
+      [&](const std::size_t begin, const std::size_t end) {
+        NDTOptimizationProblemT problem(m_scan, coarse_map, problem_config);
+        for (auto idx = begin; idx < end; ++idx) {
+          scores[idx] = problem(candidates[idx]);
+        }
+      });
+    // Ties are broken by the candidate order, for a result independent of the threads
+    std::vector<std::size_t> kept(candidates.size());
+    std::iota(kept.begin(), kept.end(), std::size_t{0U});
+    std::stable_sort(
+      kept.begin(), kept.end(),
+      [&scores](const std::size_t a, const std::size_t b) {return scores[a] > scores[b];});
+    kept.resize(std::min(kept.size(), static_cast<std::size_t>(config.num_kept_candidates())));
 
-    // Populate covariance information. It is implementation defined.
-    set_covariance(problem, eig_pose_initial, eig_pose_result, pose_out);
-    if (summary != nullptr) {
-      *summary = localization_common::OptimizedRegistrationSummary{opt_summary};
+    std::vector<EigenPose<Real>> results(kept.size());
+    // Empty for the candidates whose optimization failed
+    std::vector<std::experimental::optional<Real>> result_scores(kept.size());
+    run_in_chunks(
+      kept.size(), config.num_threads(),
+      [&](const std::size_t begin, const std::size_t end) {
+        OptimizerT optimizer{m_optimizer};
+        NDTOptimizationProblemT problem(m_scan, coarse_map, problem_config);
+        for (auto idx = begin; idx < end; ++idx) {
+          results[idx].setZero();
+          const auto opt_summary = optimizer.solve(problem, candidates[kept[idx]], results[idx]);
+          if (opt_summary.termination_type() != common::optimization::TerminationType::FAILURE) {
+            result_scores[idx] = problem(results[idx]);
+          }
+        }
+      });
+    std::experimental::optional<std::size_t> best;
+    for (std::size_t idx = 0U; idx < kept.size(); ++idx) {
+      if (result_scores[idx] && (!best || (*result_scores[idx] > *result_scores[*best]))) {
+        best = idx;
+      }
+    }
+    if (!best) {
+      throw std::runtime_error(
+              "NDT localizer has likely encountered a numerical error during the optimization of "
+              "all candidates of the global initialization.");
     }
-    return pose_out;
-  }
 
+    // The best candidate is the initial guess at the time of the measurement
+    Transform transform_initial{coarse_fix};
+    transform_initial.header.stamp = msg.header.stamp;
+    transform_adapters::pose_to_transform(results[*best], transform_initial.transform);
+    return register_coarse_to_fine(msg, transform_initial, levels.first, levels.second, summary);
+  }
 
   /// Get the last used scan.
   const ScanT & scan() const noexcept
@@ -180,6 +294,14 @@ protected:
     // For now, do nothing.
   }
 
+  /// Get the optimization problem configuration for the candidates of `register_globally()`,
+  /// which run concurrently. By default, this is the configured one.
+  /// \return Optimization problem configuration of a candidate.
+  virtual OptimizationProblemConfigT candidate_problem_config() const
+  {
+    return m_optimization_problem_config;
+  }
+
   /// Check if the received message is valid to be registered. Following checks are made:
   /// * Message timestamp is not older than the map timestamp.
   /// \param msg Message to register.
@@ -223,6 +345,178 @@ protected:
   }
 
 private:
+  /// Get the levels of a single map.
+  template<typename MapT,
+    Requires = traits::LocalizationMapConstraint<MapT>::value>
+  static std::pair<const MapT *, const MapT *> levels_of(const MapT & map) noexcept
+  {
+    return {&map, &map + 1};
+  }
+
+  /// Get the levels of a map pyramid.
+  /// \throws std::runtime_error if the pyramid is empty.
+  template<typename MapT,
+    Requires = traits::LocalizationMapConstraint<MapT>::value>
+  static std::pair<const MapT *, const MapT *> levels_of(const NDTMapPyramid<MapT> & maps)
+  {
+    const auto & levels = maps.levels();
+    if (levels.empty()) {
+      throw std::runtime_error("NDT localizer was given a map pyramid without levels.");
+    }
+    return {levels.data(), levels.data() + levels.size()};
+  }
+
+  /// Sample the candidate poses of `register_globally()`, ordered by position and then by yaw.
+  static std::vector<EigenPose<Real>> make_candidates(
+    const Transform & coarse_fix,
+    const GlobalInitializationConfig & config)
+  {
+    const auto & fix_position = coarse_fix.transform.translation;
+    // Rounded so that the range is covered despite floating point errors of range / step
+    const auto num_steps = static_cast<int64_t>(
+      std::floor((config.position_range() / config.position_step()) + 1.0E-6));
+    constexpr auto two_pi = 6.283185307179586;
+    const auto yaw_step = two_pi / static_cast<Real>(config.num_yaw_bins());
+    const auto num_positions_per_axis = static_cast<std::size_t>((2 * num_steps) + 1);
+    std::vector<EigenPose<Real>> candidates;
+    candidates.reserve(
+      num_positions_per_axis * num_positions_per_axis * config.num_yaw_bins());
+    for (auto x_idx = -num_steps; x_idx <= num_steps; ++x_idx) {
+      for (auto y_idx = -num_steps; y_idx <= num_steps; ++y_idx) {
+        for (uint32_t yaw_idx = 0U; yaw_idx < config.num_yaw_bins(); ++yaw_idx) {
+          EigenPose<Real> candidate;
+          candidate.setZero();
+          candidate(0) = fix_position.x + (static_cast<Real>(x_idx) * config.position_step());
+          candidate(1) = fix_position.y + (static_cast<Real>(y_idx) * config.position_step());
+          candidate(2) = fix_position.z;
+          candidate(5) = static_cast<Real>(yaw_idx) * yaw_step;
+          candidates.push_back(candidate);
+        }
+      }
+    }
+    return candidates;
+  }
+
+  /// Process contiguous chunks of the indices `[0, count)`, the first one on the calling thread
+  /// and each other one on its own thread. The exception of a failed chunk is rethrown on the
+  /// calling thread once all chunks are done.
+  /// \param[in] count Number of indices.
+  /// \param[in] num_threads Maximum number of chunks.
+  /// \param[in] process Function called with the begin and the end index of each chunk.
+  template<typename ProcessT>
+  static void run_in_chunks(
+    const std::size_t count, const std::size_t num_threads,
+    const ProcessT & process)
+  {
+    const auto num_chunks = std::max(std::min(num_threads, count), std::size_t{1U});
+    std::vector<std::exception_ptr> errors(num_chunks);
+    const auto process_chunk = [&](const std::size_t chunk) {
+        try {
+          process((count * chunk) / num_chunks, (count * (chunk + 1U)) / num_chunks);
+        } catch (...) {
+          errors[chunk] = std::current_exception();
+        }
+      };
+    std::vector<std::thread> threads;
+    threads.reserve(num_chunks - 1U);
+    for (std::size_t chunk = 1U; chunk < num_chunks; ++chunk) {
+      threads.emplace_back(process_chunk, chunk);
+    }
+    process_chunk(0U);
+    for (auto & thread : threads) {
+      thread.join();
+    }
+    for (const auto & error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+
+  /// Register a measurement to the given levels of maps, ordered from coarse to fine. If a
+  /// prepared scan is given, it is swapped in instead of converting the message.
+  template<typename MapT>
+  PoseWithCovarianceStamped register_coarse_to_fine(
+    const CloudT & msg,
+    const Transform & transform_initial,
+    const MapT * const levels_begin,
+    const MapT * const levels_end,
+    Summary * const summary,
+    ScanT * const prepared_scan = nullptr)
+  {
+    const MapT & map = *(levels_end - 1);
+    PoseWithCovarianceStamped pose_out{};
+    validate_msg(msg, map);
+    validate_guess(msg, transform_initial);
+    // Initial checks passed, proceed with initialization
+    // Eigen representations to be used for internal computations.
+    EigenPose<Real> eig_pose_initial, eig_pose_seed, eig_pose_result;
+    eig_pose_initial.setZero();
+    eig_pose_result.setZero();
+    // Convert the ros transform/pose to eigen pose vector
+    transform_adapters::transform_to_pose(transform_initial.transform, eig_pose_initial);
+
+    // Set the scan
+    if (prepared_scan != nullptr) {
+      std::swap(m_scan, *prepared_scan);
+    } else {
+      prepare_scan(msg, m_scan);
+    }
+    scale_score_tolerance();
+
+    // The coarse levels only refine the initial guess of the next level.
+    eig_pose_seed = eig_pose_initial;
+    for (auto level = levels_begin; level != (levels_end - 1); ++level) {
+      NDTOptimizationProblemT coarse_problem(m_scan, *level, m_optimization_problem_config);
+      const auto coarse_summary =
+        m_optimizer.solve(coarse_problem, eig_pose_seed, eig_pose_result);
+      if (coarse_summary.termination_type() != common::optimization::TerminationType::FAILURE) {
+        eig_pose_seed = eig_pose_result;
+      }
+    }
+
+    // Define and solve the problem.
+    NDTOptimizationProblemT problem(m_scan, map, m_optimization_problem_config);
+    const auto opt_summary = m_optimizer.solve(problem, eig_pose_seed, eig_pose_result);
+
+    if (opt_summary.termination_type() == common::optimization::TerminationType::FAILURE) {
+      throw std::runtime_error(
+              "NDT localizer has likely encountered a numerical "
+              "error during optimization.");
+    }
+
+    // Convert eigen pose back to ros pose/transform
+    transform_adapters::pose_to_transform(
+      eig_pose_result,
+      pose_out.pose.pose);
+
+    pose_out.header.stamp = msg.header.stamp;
+    pose_out.header.frame_id = map.frame_id();
+
+    // Populate covariance information. It is implementation defined.
+    set_covariance(problem, eig_pose_initial, eig_pose_result, pose_out);
+    if (summary != nullptr) {
+      *summary = localization_common::OptimizedRegistrationSummary{opt_summary};
+    }
+    return pose_out;
+  }
+
+  /// Set the absolute score tolerance of the optimizer for the current scan, since the score
+  /// sums up the contributions of the scan points.
+  void scale_score_tolerance()
+  {
+    const auto tolerance_per_point = m_config.score_tolerance_per_point();
+    if (tolerance_per_point <= 0.0) {
+      return;
+    }
+    const auto & options = m_optimizer.options();
+    m_optimizer.set_options(
+      common::optimization::OptimizationOptions{
+        options.max_num_iterations(), options.function_tolerance(),
+        options.parameter_tolerance(), options.gradient_tolerance(),
+        tolerance_per_point * static_cast<Real>(m_scan.size())});
+  }
+
   NDTLocalizerConfigBase m_config;
   OptimizationProblemConfigT m_optimization_problem_config;
   OptimizerT m_optimizer;
@@ -252,9 +546,19 @@ public:
     const Real outlier_ratio)
   : ParentT{
       config,
-      P2DNDTOptimizationConfig{outlier_ratio},
+      P2DNDTOptimizationConfig{
+        outlier_ratio, config.num_threads(), config.lookup(), config.precision()},
       optimizer,
-      ScanT{config.scan_capacity()}} {}
+      ScanT{config.scan_capacity()}},
+    m_scan_capacity{config.scan_capacity()} {}
+
+  /// Make an empty scan with the configured capacity, to prepare measurements in ahead of their
+  /// registration.
+  /// \return Empty scan.
+  ScanT make_scan() const
+  {
+    return ScanT{m_scan_capacity};
+  }
 
 protected:
   void set_covariance(
@@ -265,6 +569,17 @@ protected:
   {
     // For now, do nothing.
   }
+
+  P2DNDTOptimizationConfig candidate_problem_config() const override
+  {
+    // The candidates are already spread over the threads
+    const auto & config = this->optimization_problem_config();
+    return P2DNDTOptimizationConfig{
+      config.outlier_ratio(), 1U, config.lookup(), config.precision()};
+  }
+
+private:
+  uint32_t m_scan_capacity;
 };
 
 }  // namespace ndt
@@ -25,6 +25,7 @@
 #include <time_utils/time_utils.hpp>
 #include <vector>
 #include <limits>
+#include <map>
 #include <unordered_map>
 #include <utility>
 #include <string>
@@ -37,6 +38,24 @@ namespace localization
 {
 namespace ndt
 {
+/// Index of a square tile of a map in the xy plane, see `DynamicNDTMap::serialize_tiles_as()`.
+using TileIndex = std::pair<int64_t, int64_t>;
+
+/// Get the index of the tile that contains a point.
+/// \param x x coordinate
+/// \param y y coordinate
+/// \param tile_size Edge length of the tiles.
+/// \return Index of the tile.
+TileIndex NDT_PUBLIC tile_index(Real x, Real y, Real tile_size);
+
+/// Get the distance from a point to the closest point of a tile in the xy plane.
+/// \param tile Index of the tile.
+/// \param tile_size Edge length of the tiles.
+/// \param x x coordinate
+/// \param y y coordinate
+/// \return Distance to the tile, zero if the point is in the tile.
+Real NDT_PUBLIC tile_distance(const TileIndex & tile, Real tile_size, Real x, Real y);
+
 /// Ndt Map for a dynamic voxel type. This map representation is only to be used
 /// when a dense point cloud is intended to be represented as a map. (i.e. by the map publisher)
 class NDT_PUBLIC DynamicNDTMap
@@ -49,6 +68,7 @@ public:
   using VoxelViewVector = std::vector<VoxelView<Voxel>>;
   using VoxelGrid = NDTGrid<Voxel>::Grid;
   using ConfigPoint = NDTGrid<Voxel>::ConfigPoint;
+  using Tiles = std::map<TileIndex, sensor_msgs::msg::PointCloud2>;
 
   /// \brief First 3 points of a serialized message will contain 3 extra points:
   /// Min point, max point and the voxel size.
@@ -73,12 +93,33 @@ public:
   template<typename DeserializingMapT>
   void serialize_as(sensor_msgs::msg::PointCloud2 & msg_out) const;
 
+  /// Serialize the map as `serialize_as()` does, but split into square tiles in the xy plane, so
+  /// that the tiles around a location can be sent without the rest of the map. A voxel belongs
+  /// to the tile of its centroid. Each tile keeps the configuration of the whole map, hence the
+  /// tiles can be inserted into a single map.
+  /// \tparam DeserializingMapT The map type that can deserialize the serialized tiles.
+  /// \param tile_size Edge length of the tiles.
+  /// \param tiles_out Reference to the tiles, replaced by the ones which contain voxels.
+  /// \throws std::domain_error if the tile size is not positive.
+  template<typename DeserializingMapT>
+  void serialize_tiles_as(Real tile_size, Tiles & tiles_out) const;
+
   /// Lookup the cell at location.
   /// \param pt point to lookup
   /// \return A vector containing the cell at given coordinates. A vector is used to support
   /// near-neighbour cell queries in the future.
   const VoxelViewVector & cell(const Point & pt) const;
 
+  /// Lookup the cells around a location into a vector owned by the caller. This does not modify
+  /// the map, so it can be called concurrently from multiple threads.
+  /// \param pt point to lookup
+  /// \param output Vector to store the cells in. Its previous contents are cleared.
+  /// \param lookup Which voxels around the point to return, see `NDTGrid::cell()`.
+  /// \return Reference to `output`.
+  const VoxelViewVector & cell(
+    const Point & pt, VoxelViewVector & output,
+    VoxelLookup lookup = VoxelLookup::DIRECT1) const;
+
   /// Lookup the cell at location.
   /// \param x x coordinate
   /// \param y y coordinate
@@ -125,19 +166,24 @@ private:
   std::string m_frame_id{};
 };
 
-/// NDT map using StaticNDTVoxels. This class is to be used when the pointcloud
+/// NDT map using static voxels. This class is to be used when the pointcloud
 /// messages to be inserted already have the correct format (see validate_pcl_map(...)) and
 /// represent a transformed map. No centroid/covariance computation is done during run-time.
-class NDT_PUBLIC StaticNDTMap
+/// \tparam StorageT Storage policy of the voxel grid, see `StaticNDTMap` and
+/// `DenseStaticNDTMap`.
+/// \tparam VoxelT Voxel type, `StaticNDTVoxel` or `CompactStaticNDTVoxel`, see
+/// `CompactStaticNDTMap`. The map is instantiated for the aliases below only.
+template<typename StorageT, typename VoxelT = StaticNDTVoxel>
+class NDT_PUBLIC BasicStaticNDTMap
 {
 public:
-  using Voxel = StaticNDTVoxel;
+  using Voxel = VoxelT;
   using Config = autoware::perception::filters::voxel_grid::Config;
   using TimePoint = std::chrono::system_clock::time_point;
   using Point = Eigen::Vector3d;
   using VoxelViewVector = std::vector<VoxelView<Voxel>>;
-  using VoxelGrid = NDTGrid<Voxel>::Grid;
-  using ConfigPoint = NDTGrid<Voxel>::ConfigPoint;
+  using VoxelGrid = typename NDTGrid<Voxel, StorageT>::Grid;
+  using ConfigPoint = typename NDTGrid<Voxel, StorageT>::ConfigPoint;
 
   /// Set point cloud message representing the map to the map representation instance.
   /// Map is assumed to have correct format (see `validate_pcl_map(...)`) and was generated
@@ -149,12 +195,38 @@ public:
   /// of 2 unsigned integers. That is because there is no direct long support as a PointField.
   void set(const sensor_msgs::msg::PointCloud2 & msg);
 
+  /// Insert the voxels of a serialized map and keep the voxels which are already in the map.
+  /// This builds the map up from tiles (see `DynamicNDTMap::serialize_tiles_as()`). If no map was
+  /// set, this is the same as `set()`.
+  /// \param msg PointCloud2 message in the format expected by `set()`.
+  /// \throws std::domain_error if the message has another frame or grid configuration than the
+  /// map, in which case the map is not modified.
+  void insert(const sensor_msgs::msg::PointCloud2 & msg);
+
+  /// Remove the voxels whose centroid is farther than a radius from a location in the xy plane,
+  /// to bound the size of a map which is built up from tiles.
+  /// \param x x coordinate of the location
+  /// \param y y coordinate of the location
+  /// \param radius Radius to keep the voxels within.
+  /// \return Number of removed voxels, zero if no map was set.
+  std::size_t evict(Real x, Real y, Real radius);
+
   /// Lookup the cell at location.
   /// \param pt point to lookup
   /// \return A vector containing the cell at given coordinates. A vector is used to support
   /// near-neighbour cell queries in the future.
   const VoxelViewVector & cell(const Point & pt) const;
 
+  /// Lookup the cells around a location into a vector owned by the caller. This does not modify
+  /// the map, so it can be called concurrently from multiple threads.
+  /// \param pt point to lookup
+  /// \param output Vector to store the cells in. Its previous contents are cleared.
+  /// \param lookup Which voxels around the point to return, see `NDTGrid::cell()`.
+  /// \return Reference to `output`.
+  const VoxelViewVector & cell(
+    const Point & pt, VoxelViewVector & output,
+    VoxelLookup lookup = VoxelLookup::DIRECT1) const;
+
   /// Lookup the cell at location.
   /// \param x x coordinate
   /// \param y y coordinate
@@ -198,11 +270,33 @@ public:
 private:
   /// Deserialize the given serialized point cloud map.
   /// \param msg PointCloud2 message containing the deserialized data.
-  void deserialize_from(const sensor_msgs::msg::PointCloud2 & msg);
-  std::experimental::optional<NDTGrid<StaticNDTVoxel>> m_grid{};
+  /// \param merge Whether to keep the current grid and its voxels, which requires the message
+  /// to have the same grid configuration.
+  void deserialize_from(const sensor_msgs::msg::PointCloud2 & msg, bool merge = false);
+  std::experimental::optional<NDTGrid<Voxel, StorageT>> m_grid{};
   TimePoint m_stamp{};
   std::string m_frame_id{};
 };
+
+/// Static NDT map storing its voxels in a hash map, suited to maps of any extent.
+using StaticNDTMap = BasicStaticNDTMap<HashGridStorage>;
+
+/// Static NDT map storing its voxels in a dense grid, see `DenseVoxelGrid`. Lookups are faster
+/// than for `StaticNDTMap`, but the memory grows with the volume of the grid's bounds, so this is
+/// meant for bounded maps, e.g. the tiles streamed around the vehicle. It deserializes the same
+/// messages as `StaticNDTMap`.
+using DenseStaticNDTMap = BasicStaticNDTMap<DenseGridStorage>;
+
+/// Static NDT map storing its voxels as `CompactStaticNDTVoxel` in a hash map, which takes less
+/// than half the memory of `StaticNDTMap`, for maps too large to be held otherwise. Its lookups
+/// cost the expansion of the voxels to double precision, and the centroids and inverse covariances
+/// are exact to single precision only, e.g. to about a millimeter 10 km away from the map origin.
+/// It deserializes the same messages as `StaticNDTMap`.
+using CompactStaticNDTMap = BasicStaticNDTMap<HashGridStorage, CompactStaticNDTVoxel>;
+
+extern template class BasicStaticNDTMap<HashGridStorage, StaticNDTVoxel>;
+extern template class BasicStaticNDTMap<DenseGridStorage, StaticNDTVoxel>;
+extern template class BasicStaticNDTMap<HashGridStorage, CompactStaticNDTVoxel>;
 }  // namespace ndt
 }  // namespace localization
 }  // namespace autoware
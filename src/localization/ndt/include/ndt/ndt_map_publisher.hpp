@@ -75,6 +75,12 @@ void NDT_PUBLIC read_from_pcd(
   const std::string & file_name,
   sensor_msgs::msg::PointCloud2 * msg);
 
+/// Read the map origin from a yaml file and convert it into geocentric coordinates. Throws if
+/// the file cannot be read.
+/// \param yaml_file_name File name of the yaml file.
+/// \return The geocentric position.
+geocentric_pose_t NDT_PUBLIC load_map_origin(const std::string & yaml_file_name);
+
 /// \brief  Read the pcd file with filename into a PointCloud2 message, transform it into an NDT
 /// representation and then serialize the ndt representation back into a PointCloud2 message
 /// that can be published.
@@ -87,6 +93,24 @@ geocentric_pose_t NDT_PUBLIC load_map(
   const std::string & yaml_file_name,
   const std::string & pcl_file_name,
   sensor_msgs::msg::PointCloud2 & pc_out);
+
+/// Write a serialized ndt map (see `DynamicNDTMap::serialize_as()`) into a binary cache file,
+/// which `read_map_cache()` loads without parsing a pcd file or computing the voxels. The points
+/// are stored in their in-memory layout, so a cache file is only meant to be read on the same
+/// architecture. Throws if the message is not a serialized ndt map or the file cannot be written.
+/// \param[in] file_name Name of the cache file.
+/// \param[in] ndt_map Serialized ndt map.
+void NDT_PUBLIC write_map_cache(
+  const std::string & file_name,
+  const sensor_msgs::msg::PointCloud2 & ndt_map);
+
+/// Memory map a cache file written by `write_map_cache()` and copy it into a serialized ndt map.
+/// Throws if the file cannot be read or is not a valid cache file.
+/// \param[in] file_name Name of the cache file.
+/// \param[out] ndt_map_out Serialized ndt map, with the frame and stamp it was written with.
+void NDT_PUBLIC read_map_cache(
+  const std::string & file_name,
+  sensor_msgs::msg::PointCloud2 & ndt_map_out);
 }  // namespace ndt
 }  // namespace localization
 }  // namespace autoware
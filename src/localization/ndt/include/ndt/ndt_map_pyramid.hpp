@@ -0,0 +1,162 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#ifndef NDT__NDT_MAP_PYRAMID_HPP_
+#define NDT__NDT_MAP_PYRAMID_HPP_
+
+#include <ndt/ndt_common.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware
+{
+namespace localization
+{
+namespace ndt
+{
+/// Maps of the same area at different resolutions, to register scans coarse to fine. Each
+/// serialized map is inserted into the level of its cell size, and the levels are kept in the
+/// order of decreasing cell size. A map with a different frame or time stamp than the current
+/// levels, or a new cell size when all levels are taken, replaces all levels. Hence, if a
+/// publisher sends the coarse maps before the fine one, the fine one is always kept, and the tiles
+/// of a map build up their levels.
+/// \tparam MapT Type of the map of a level. It needs to be default constructible and movable, and
+/// provide `set(msg)`, `insert(msg)`, `evict(x, y, radius)`, `cell_size()`, `frame_id()`,
+/// `stamp()` and `valid()`.
+template<typename MapT>
+class NDTMapPyramid
+{
+public:
+  using Map = MapT;
+  using Levels = std::vector<MapT>;
+  using TimePoint = std::chrono::system_clock::time_point;
+
+  /// Constructor
+  /// \param max_num_levels Maximum number of levels.
+  /// \throws std::domain_error if the maximum number of levels is 0.
+  explicit NDTMapPyramid(const std::size_t max_num_levels = 1U)
+  : m_max_num_levels{max_num_levels}
+  {
+    if (max_num_levels == 0U) {
+      throw std::domain_error("NDTMapPyramid: There should be at least one level.");
+    }
+    m_levels.reserve(max_num_levels);
+  }
+
+  /// \brief Insert the pointcloud into the level of its cell size.
+  /// \param msg Serialized map, or a tile of it.
+  /// \throws Any exception thrown when setting the map of a level, in which case the levels are
+  /// not modified.
+  void set(const sensor_msgs::msg::PointCloud2 & msg)
+  {
+    MapT level{};
+    level.set(msg);
+    const auto volume = cell_volume(level);
+    const auto same_size = std::find_if(
+      m_levels.begin(), m_levels.end(), [volume](const MapT & other) {
+        return cell_volume(other) == volume;
+      });
+    const bool new_map = !m_levels.empty() &&
+      ((level.stamp() != stamp()) || (level.frame_id() != frame_id()));
+    if (new_map || ((same_size == m_levels.end()) && (m_levels.size() >= m_max_num_levels))) {
+      m_levels.clear();
+    } else if (same_size != m_levels.end()) {
+      // Another part of the same map, e.g. another tile
+      same_size->insert(msg);
+      return;
+    }
+    const auto position = std::find_if(
+      m_levels.begin(), m_levels.end(), [volume](const MapT & other) {
+        return cell_volume(other) < volume;
+      });
+    (void) m_levels.insert(position, std::move(level));
+  }
+
+  /// Remove the voxels of all levels which are farther than a radius from a location in the xy
+  /// plane, see `StaticNDTMap::evict()`.
+  /// \param x x coordinate of the location
+  /// \param y y coordinate of the location
+  /// \param radius Radius to keep the voxels within.
+  /// \return Number of removed voxels.
+  std::size_t evict(const Real x, const Real y, const Real radius)
+  {
+    std::size_t num_evicted = 0U;
+    for (auto & level : m_levels) {
+      num_evicted += level.evict(x, y, radius);
+    }
+    return num_evicted;
+  }
+
+  /// Get the levels, from the coarsest to the finest one.
+  /// \return The levels.
+  const Levels & levels() const noexcept
+  {
+    return m_levels;
+  }
+
+  /// Get the finest level.
+  /// \return The level with the smallest cell size.
+  /// \throws std::runtime_error if no map was set.
+  const MapT & finest() const
+  {
+    if (m_levels.empty()) {
+      throw std::runtime_error("NDTMapPyramid: No map was set.");
+    }
+    return m_levels.back();
+  }
+
+  /// Get the frame id of the maps.
+  /// \return Frame id of the maps, empty if no map was set.
+  const std::string & frame_id() const noexcept
+  {
+    return m_levels.empty() ? m_empty_frame_id : m_levels.back().frame_id();
+  }
+
+  /// Get the time stamp of the maps.
+  /// \return Time stamp of the maps, default constructed if no map was set.
+  TimePoint stamp() const noexcept
+  {
+    return m_levels.empty() ? TimePoint{} : m_levels.back().stamp();
+  }
+
+  /// \brief Check if the pyramid is valid.
+  /// \return True if the finest level is valid.
+  bool valid() const noexcept
+  {
+    return !m_levels.empty() && m_levels.back().valid();
+  }
+
+private:
+  static Real cell_volume(const MapT & map)
+  {
+    const auto & size = map.cell_size();
+    return static_cast<Real>(size.x) * static_cast<Real>(size.y) * static_cast<Real>(size.z);
+  }
+
+  std::size_t m_max_num_levels;
+  Levels m_levels{};
+  std::string m_empty_frame_id{};
+};
+}  // namespace ndt
+}  // namespace localization
+}  // namespace autoware
+
+#endif  // NDT__NDT_MAP_PYRAMID_HPP_
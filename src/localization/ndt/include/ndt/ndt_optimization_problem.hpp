@@ -60,6 +60,7 @@
 #include <ndt/ndt_map.hpp>
 #include <ndt/ndt_scan.hpp>
 #include <ndt/ndt_config.hpp>
+#include <ndt/ndt_kernels.hpp>
 #include <optimization/optimization_problem.hpp>
 #include <optimization/utils.hpp>
 #include <ndt/utils.hpp>
@@ -67,8 +68,12 @@
 #include <experimental/optional>
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <algorithm>
+#include <cstddef>
 #include <limits>
+#include <memory>
 #include <tuple>
+#include <vector>
 #include "common/types.hpp"
 
 using autoware::common::types::bool8_t;
@@ -114,6 +119,9 @@ public:
   using ComputeMode = common::optimization::ComputeMode;
   using PointGrad = Eigen::Matrix<float64_t, 3, 6>;
   using PointHessian = Eigen::Matrix<float64_t, 18, 6>;
+  using Transform = Eigen::Transform<float64_t, 3, Eigen::Affine, Eigen::ColMajor>;
+  using ScanIterator = typename Scan::iterator;
+  using VoxelViewVector = typename traits::P2DNDTOptimizationMapConstraint<MapT>::VoxelViewVector;
 
   /// Constructor.
   ///
@@ -127,24 +135,24 @@ public:
   ///
   P2DNDTObjective(
     const P2DNDTScan & scan, const Map & map, const P2DNDTOptimizationConfig config)
-  : m_scan_ref(scan), m_map_ref(map)
+  : m_scan_ref(scan), m_map_ref(map), m_workers(config.workers()),
+    m_lookup(config.lookup()), m_precision(config.precision())
   {
     init(config.outlier_ratio());
   }
 
+  /// Evaluate the objective. The scan is split into contiguous chunks, one per worker of the
+  /// config, whose partial sums are added up in the order of the chunks. The result is hence the
+  /// same for a given number of threads, and identical to the single threaded result for one
+  /// thread.
   void evaluate_(const DomainValue & x, const ComputeMode & mode)
   {
     // Convert pose vector to transform matrix for easy point transformation
-    Eigen::Transform<float64_t, 3, Eigen::Affine, Eigen::ColMajor> transform;
+    Transform transform;
     transform.setIdentity();
     transform_adapters::pose_to_transform(x, transform);
 
-    Value score{0.0};
-
-    Jacobian jacobian;
     std::experimental::optional<GradientAngleParameters> grad_params;
-
-    Hessian hessian;
     std::experimental::optional<HessianAngleParameters> hessian_params;
 
     {
@@ -152,77 +160,49 @@ public:
       const AngleParameters angle_params{x};
       // Only construct jacobian/hessian variables if they are needed.
       if (mode.jacobian() || mode.hessian()) {
-        jacobian.setZero();
         grad_params.emplace(angle_params);
       }
       if (mode.hessian()) {
-        hessian.setZero();
         hessian_params.emplace(angle_params);
       }
     }
 
-    for (const auto & pt : m_scan_ref) {
-      PointGrad point_gradient;
-      PointHessian point_hessian;
-
-      if (mode.jacobian() || mode.hessian()) {
-        point_gradient.setZero();
-        point_gradient.block<3, 3>(0, 0).setIdentity();
-        compute_point_gradients(grad_params.value(), pt, point_gradient);
-
-        if (mode.hessian()) {
-          point_hessian.setZero();
-          compute_point_hessians(hessian_params.value(), pt, point_hessian);
-        }
-      }
-
-      const Point pt_trans = transform * pt;
-      const auto & cells = m_map_ref.cell(pt_trans);
-
-      for (const auto & cell : cells) {
-        const Point pt_trans_norm = pt_trans - cell.centroid();
-        // Cell iteration used for compatibility with maps with multi-cell lookup
-        if (!cell.usable()) {
-          continue;
-        }
-        const auto & inv_cov = cell.inverse_covariance();
-        // e^(-d_2/2 * (x_k - mu_k)^T Sigma_k^-1 (x_k - mu_k)) Equation 6.9 [Magnusson 2009]
-        Real e_minus_half_d2_x_cov_x =
-          std::exp(-m_gauss_d2 * pt_trans_norm.dot(inv_cov * pt_trans_norm) / 2.0);
-
-        if (mode.score()) {
-          score += -m_gauss_d1 * e_minus_half_d2_x_cov_x;
-        }
-
-        if (!mode.jacobian() && !mode.hessian()) {
-          continue;
-        }
-        const auto d2_e_minus_half_d2_x_cov_x = m_gauss_d2 * e_minus_half_d2_x_cov_x;
-
-        // Error checking for invalid values.
-        if (!is_valid_probability(d2_e_minus_half_d2_x_cov_x)) {
-          continue;
-        }
+    const std::size_t num_points = m_scan_ref.size();
+    const std::size_t num_workers = (m_workers != nullptr) ? m_workers->get_num_workers() : 1U;
+    const std::size_t num_chunks = std::max(std::min(num_workers, num_points), std::size_t{1U});
+    m_partial_sums.resize(num_chunks);
+    for (auto & sums : m_partial_sums) {
+      sums.cells.reserve(max_num_voxels(m_lookup));
+    }
+    const auto chunk_begin = [this, num_points, num_chunks](const std::size_t chunk) {
+        return m_scan_ref.begin() +
+               static_cast<std::ptrdiff_t>((num_points * chunk) / num_chunks);
+      };
+    const auto accumulate_chunk = [&](const std::size_t chunk) {
+        accumulate(
+          chunk_begin(chunk), chunk_begin(chunk + 1U), transform, mode,
+          grad_params, hessian_params, m_partial_sums[chunk]);
+      };
+    if (num_chunks > 1U) {
+      // Only the chunks are dispatched, the threads are kept by the config. An exception of a
+      // chunk is rethrown here once the other chunks are done.
+      m_workers->run(
+        num_chunks, [&accumulate_chunk](const std::size_t chunk, const std::size_t) {
+          accumulate_chunk(chunk);
+        });
+    } else {
+      accumulate_chunk(0U);
+    }
 
-        // Reusable portion of Equation 6.12 and 6.13 [Magnusson 2009]
-        const auto d1_d2_e_minus_half_d2_x_cov_x = m_gauss_d1 * d2_e_minus_half_d2_x_cov_x;
-
-        for (auto i = 0U; i < jacobian.rows(); ++i) {
-          const Point cov_dxd_pi = inv_cov * point_gradient.col(i);
-          if (mode.jacobian()) {
-            jacobian(i) += pt_trans_norm.dot(cov_dxd_pi) * d1_d2_e_minus_half_d2_x_cov_x;
-          }
-          if (mode.hessian()) {
-            for (auto j = 0U; j < hessian.cols(); ++j) {
-              hessian(i, j) += d1_d2_e_minus_half_d2_x_cov_x *
-                (-m_gauss_d2 * pt_trans_norm.dot(cov_dxd_pi) *
-                pt_trans_norm.dot(inv_cov * point_gradient.col(j)) +
-                pt_trans_norm.dot(inv_cov * point_hessian.block<3, 1>(3 * i, j)) +
-                point_gradient.col(j).dot(cov_dxd_pi));
-            }
-          }
-        }
-      }
+    Value score{0.0};
+    Jacobian jacobian;
+    jacobian.setZero();
+    Hessian hessian;
+    hessian.setZero();
+    for (const auto & sums : m_partial_sums) {
+      score += sums.score;
+      jacobian += sums.jacobian;
+      hessian += sums.hessian;
     }
     if (mode.score()) {
       this->set_score(score);
@@ -396,10 +376,185 @@ public:
       h_ang_f1, h_ang_f2, h_ang_f3;
   };
 
+  /// Partial sums of the objective over a chunk of the scan.
+  struct PartialSums
+  {
+    Value score{0.0};
+    Jacobian jacobian;
+    Hessian hessian;
+    // Lookup buffer, so that concurrent chunks do not share the one of the map
+    VoxelViewVector cells;
+    // Residuals of the chunk and their scan points, for the single precision evaluation
+    MahalanobisBatch batch;
+    std::vector<ScanIterator> batch_points;
+  };
+
+  /// Accumulate the score, jacobian and hessian over a range of scan points into `sums`. This
+  /// only reads shared state, so it can be called concurrently on disjoint ranges.
+  void accumulate(
+    const ScanIterator begin, const ScanIterator end, const Transform & transform,
+    const ComputeMode & mode,
+    const std::experimental::optional<GradientAngleParameters> & grad_params,
+    const std::experimental::optional<HessianAngleParameters> & hessian_params,
+    PartialSums & sums) const
+  {
+    if (m_precision == EvaluationPrecision::FLOAT32) {
+      accumulate_batch(begin, end, transform, mode, grad_params, hessian_params, sums);
+      return;
+    }
+    // Accumulate locally rather than into `sums`, which may share a cache line with another chunk
+    Value score{0.0};
+    Jacobian jacobian;
+    jacobian.setZero();
+    Hessian hessian;
+    hessian.setZero();
+
+    for (auto it = begin; it != end; ++it) {
+      const auto & pt = *it;
+      PointGrad point_gradient;
+      PointHessian point_hessian;
+      compute_point_derivatives(
+        pt, mode, grad_params, hessian_params, point_gradient, point_hessian);
+
+      const Point pt_trans = transform * pt;
+      const auto & cells = m_map_ref.cell(pt_trans, sums.cells, m_lookup);
+
+      for (const auto & cell : cells) {
+        const Point pt_trans_norm = pt_trans - cell.centroid();
+        // Cell iteration used for compatibility with maps with multi-cell lookup
+        if (!cell.usable()) {
+          continue;
+        }
+        const auto & inv_cov = cell.inverse_covariance();
+        // e^(-d_2/2 * (x_k - mu_k)^T Sigma_k^-1 (x_k - mu_k)) Equation 6.9 [Magnusson 2009]
+        const Real e_minus_half_d2_x_cov_x =
+          std::exp(-m_gauss_d2 * pt_trans_norm.dot(inv_cov * pt_trans_norm) / 2.0);
+        add_term(
+          pt_trans_norm, inv_cov, e_minus_half_d2_x_cov_x, point_gradient, point_hessian, mode,
+          score, jacobian, hessian);
+      }
+    }
+    sums.score = score;
+    sums.jacobian = jacobian;
+    sums.hessian = hessian;
+  }
+
+  /// Same as `accumulate()`, but the residuals of all scan points are gathered into a batch
+  /// first, whose gaussians are evaluated at once in single precision. Only the gaussians and the
+  /// rounding of the residuals and inverse covariances differ from the double precision sums.
+  void accumulate_batch(
+    const ScanIterator begin, const ScanIterator end, const Transform & transform,
+    const ComputeMode & mode,
+    const std::experimental::optional<GradientAngleParameters> & grad_params,
+    const std::experimental::optional<HessianAngleParameters> & hessian_params,
+    PartialSums & sums) const
+  {
+    auto & batch = sums.batch;
+    auto & batch_points = sums.batch_points;
+    batch.clear();
+    batch_points.clear();
+    for (auto it = begin; it != end; ++it) {
+      const Point pt_trans = transform * (*it);
+      for (const auto & cell : m_map_ref.cell(pt_trans, sums.cells, m_lookup)) {
+        if (!cell.usable()) {
+          continue;
+        }
+        batch.push_back(pt_trans - cell.centroid(), cell.inverse_covariance());
+        batch_points.push_back(it);
+      }
+    }
+    // e^(-d_2/2 * (x_k - mu_k)^T Sigma_k^-1 (x_k - mu_k)) Equation 6.9 [Magnusson 2009]
+    batch.evaluate_gaussians(static_cast<float32_t>(m_gauss_d2 / 2.0));
+
+    Value score{0.0};
+    Jacobian jacobian;
+    jacobian.setZero();
+    Hessian hessian;
+    hessian.setZero();
+    PointGrad point_gradient;
+    PointHessian point_hessian;
+    for (std::size_t i = 0U; i < batch.size(); ++i) {
+      // The residuals of a scan point are consecutive, so its derivatives are computed once
+      if ((i == 0U) || (batch_points[i] != batch_points[i - 1U])) {
+        compute_point_derivatives(
+          *batch_points[i], mode, grad_params, hessian_params, point_gradient, point_hessian);
+      }
+      add_term(
+        batch.residual(i), batch.inverse_covariance(i), static_cast<Real>(batch.gaussian(i)),
+        point_gradient, point_hessian, mode, score, jacobian, hessian);
+    }
+    sums.score = score;
+    sums.jacobian = jacobian;
+    sums.hessian = hessian;
+  }
+
+  /// Compute the derivatives of a transformed scan point w.r.t. the pose, if the mode needs them.
+  void compute_point_derivatives(
+    const Point & pt, const ComputeMode & mode,
+    const std::experimental::optional<GradientAngleParameters> & grad_params,
+    const std::experimental::optional<HessianAngleParameters> & hessian_params,
+    PointGrad & point_gradient, PointHessian & point_hessian) const
+  {
+    if (mode.jacobian() || mode.hessian()) {
+      point_gradient.setZero();
+      point_gradient.block<3, 3>(0, 0).setIdentity();
+      compute_point_gradients(grad_params.value(), pt, point_gradient);
+
+      if (mode.hessian()) {
+        point_hessian.setZero();
+        compute_point_hessians(hessian_params.value(), pt, point_hessian);
+      }
+    }
+  }
+
+  /// Add the term of a scan point and a voxel to the score, jacobian and hessian.
+  /// \param pt_trans_norm Difference of the transformed scan point and the voxel centroid.
+  /// \param inv_cov Inverse covariance of the voxel.
+  /// \param e_minus_half_d2_x_cov_x Gaussian of the difference, see equation 6.9 [Magnusson 2009].
+  void add_term(
+    const Point & pt_trans_norm, const Eigen::Matrix3d & inv_cov,
+    const Real e_minus_half_d2_x_cov_x, const PointGrad & point_gradient,
+    const PointHessian & point_hessian, const ComputeMode & mode,
+    Value & score, Jacobian & jacobian, Hessian & hessian) const
+  {
+    if (mode.score()) {
+      score += -m_gauss_d1 * e_minus_half_d2_x_cov_x;
+    }
+
+    if (!mode.jacobian() && !mode.hessian()) {
+      return;
+    }
+    const auto d2_e_minus_half_d2_x_cov_x = m_gauss_d2 * e_minus_half_d2_x_cov_x;
+
+    // Error checking for invalid values.
+    if (!is_valid_probability(d2_e_minus_half_d2_x_cov_x)) {
+      return;
+    }
+
+    // Reusable portion of Equation 6.12 and 6.13 [Magnusson 2009]
+    const auto d1_d2_e_minus_half_d2_x_cov_x = m_gauss_d1 * d2_e_minus_half_d2_x_cov_x;
+
+    for (auto i = 0U; i < jacobian.rows(); ++i) {
+      const Point cov_dxd_pi = inv_cov * point_gradient.col(i);
+      if (mode.jacobian()) {
+        jacobian(i) += pt_trans_norm.dot(cov_dxd_pi) * d1_d2_e_minus_half_d2_x_cov_x;
+      }
+      if (mode.hessian()) {
+        for (auto j = 0U; j < hessian.cols(); ++j) {
+          hessian(i, j) += d1_d2_e_minus_half_d2_x_cov_x *
+            (-m_gauss_d2 * pt_trans_norm.dot(cov_dxd_pi) *
+            pt_trans_norm.dot(inv_cov * point_gradient.col(j)) +
+            pt_trans_norm.dot(inv_cov * point_hessian.block<3, 1>(3 * i, j)) +
+            point_gradient.col(j).dot(cov_dxd_pi));
+        }
+      }
+    }
+  }
+
   void compute_point_gradients(
     const GradientAngleParameters & params,
     const Point & x,
-    PointGrad & point_gradient)
+    PointGrad & point_gradient) const
   {
     point_gradient(1, 3) = x.dot(params.j_ang_a);
     point_gradient(2, 3) = x.dot(params.j_ang_b);
@@ -414,7 +569,7 @@ public:
   void compute_point_hessians(
     const HessianAngleParameters & params,
     const Point & x,
-    PointHessian & point_hessian)
+    PointHessian & point_hessian) const
   {
     const Point a{0.0, x.dot(params.h_ang_a2), x.dot(params.h_ang_a3)};
     const Point b{0.0, x.dot(params.h_ang_b2), x.dot(params.h_ang_b3)};
@@ -463,6 +618,12 @@ public:
   // States:
   Real m_gauss_d1{0.0};
   Real m_gauss_d2{0.0};
+  // Shared with the config, so that the threads are only started once
+  std::shared_ptr<common::helper_functions::WorkerPool> m_workers;
+  VoxelLookup m_lookup;
+  EvaluationPrecision m_precision;
+  // Kept across evaluations to avoid reallocating on every optimization iteration
+  std::vector<PartialSums, Eigen::aligned_allocator<PartialSums>> m_partial_sums;
 };
 
 template<typename MapT>
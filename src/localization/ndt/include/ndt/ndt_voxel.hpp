@@ -23,8 +23,10 @@
 #include <voxel_grid/voxels.hpp>
 
 #include <Eigen/Core>
+#include <array>
 
 using autoware::common::types::bool8_t;
+using autoware::common::types::float32_t;
 
 namespace autoware
 {
@@ -131,6 +133,46 @@ private:
   Cov m_inv_covariance;
   bool8_t m_occupied{false};
 };
+
+/// Static Voxel implementation for large NDT maps, where memory is the limit. It stores the
+/// centroid and the upper triangle of the symmetric inverse covariance in single precision, which
+/// takes 40 instead of 104 bytes per voxel. The values are expanded to double precision when the
+/// voxel is looked up, see `VoxelView<CompactStaticNDTVoxel>`.
+class NDT_PUBLIC CompactStaticNDTVoxel
+{
+public:
+  using Point = Eigen::Vector3d;
+  using Cov = Eigen::Matrix3d;
+  /// Initialize an empty voxel
+  CompactStaticNDTVoxel();
+
+  /// Initialize a voxel given the centroid and the covariance.
+  /// \param centroid Centroid of the voxel.
+  /// \param inv_covariance Inverse covariance of the voxel, assumed to be symmetric. Only its
+  /// upper triangle is kept.
+  CompactStaticNDTVoxel(const Point & centroid, const Cov & inv_covariance);
+
+  /// Calculates and returns the covariance of the points in the voxel. Throw if voxel is empty.
+  /// \return covariance of the cell
+  Cov covariance() const;
+  /// Returns the mean of the points in the cell. Throw if voxel is empty.
+  /// \return centroid of the cell
+  Point centroid() const;
+
+  /// Returns the inverse covariance of the points in the voxel. Throw if voxel is empty.
+  /// \return inverse covariance of the cell
+  Cov inverse_covariance() const;
+
+  /// Check if the cell is occupied and can be used in ndt matching
+  /// \return True if cell is occupied
+  bool8_t usable() const noexcept;
+
+private:
+  std::array<float32_t, 3U> m_centroid{};
+  // xx, xy, xz, yy, yz, zz
+  std::array<float32_t, 6U> m_inv_covariance{};
+  bool8_t m_occupied{false};
+};
 }  // namespace ndt
 }  // namespace localization
 }  // namespace autoware
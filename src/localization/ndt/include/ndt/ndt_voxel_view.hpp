@@ -86,6 +86,28 @@ private:
   bool8_t m_usable;
 };
 
+/// VoxelViewBase implementation for `CompactStaticNDTVoxel`. On construction, it expands the
+/// single precision centroid and inverse covariance of the voxel, so the view is as fast to
+/// query as a view of a `StaticNDTVoxel`.
+template<>
+class NDT_PUBLIC VoxelView<CompactStaticNDTVoxel>
+  : public VoxelViewBase<CompactStaticNDTVoxel, VoxelView<CompactStaticNDTVoxel>>
+{
+public:
+  using Point = Eigen::Vector3d;
+  using Cov = Eigen::Matrix3d;
+  using Base = VoxelViewBase<CompactStaticNDTVoxel, VoxelView<CompactStaticNDTVoxel>>;
+  explicit VoxelView(const CompactStaticNDTVoxel & voxel);
+
+  const Cov & inverse_covariance_() const;
+  const Point & centroid_() const;
+  bool8_t usable_() const noexcept;
+
+private:
+  Point m_centroid;
+  Cov m_inverse_covariance;
+  bool8_t m_usable;
+};
 
 /// VoxelViewBase implementation for `DynamicNDTVoxel`. On construction, it will compute the
 /// covariance. If the cell is not usable, the value returned by `inverse_covariance_` will
@@ -19,7 +19,11 @@
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
 #include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 
 namespace autoware
 {
@@ -27,6 +31,83 @@ namespace localization
 {
 namespace ndt
 {
+namespace
+{
+/// Add the configuration of a grid to a serialized map as its first 3 points: min point, max
+/// point and voxel size. The remaining 6 fields are left unused so they are set to 0.0
+void push_back_config(
+  const DynamicNDTMap::Config & config,
+  NdtMapCloudModifier & msg_modifier)
+{
+  const auto min_point = config.get_min_point();
+  const auto max_point = config.get_max_point();
+  const auto size = config.get_voxel_size();
+  msg_modifier.push_back(
+    PointWithCovariances{min_point.x, min_point.y, min_point.z,
+      0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+  msg_modifier.push_back(
+    PointWithCovariances{max_point.x, max_point.y, max_point.z,
+      0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+  msg_modifier.push_back(
+    PointWithCovariances{size.x, size.y, size.z,
+      0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+}
+
+/// Get the serialized point of a voxel.
+/// \param vx Voxel to serialize.
+/// \param point_out Serialized point.
+/// \return False if the voxel can not be used in NDT, in which case it is not serialized.
+bool serialize_voxel(const DynamicNDTVoxel & vx, PointWithCovariances & point_out)
+{
+  if (!vx.usable()) {
+    // Voxel doesn't have enough points to be used in NDT
+    return false;
+  }
+
+  const auto inv_covariance_opt = vx.inverse_covariance();
+  if (!inv_covariance_opt) {
+    // Voxel covariance is not invertible
+    return false;
+  }
+
+  const auto & centroid = vx.centroid();
+  const auto & inv_covariance = inv_covariance_opt.value();
+  point_out = {
+    centroid(0U), centroid(1U), centroid(2U),
+    inv_covariance(0U, 0U), inv_covariance(0U, 1U), inv_covariance(0U, 2U),
+    inv_covariance(1U, 1U), inv_covariance(1U, 2U),
+    inv_covariance(2U, 2U)
+  };
+  return true;
+}
+
+/// Check if two grids index voxels identically.
+bool same_grid(const StaticNDTMap::Config & config1, const StaticNDTMap::Config & config2)
+{
+  const auto same_point = [](const auto & pt1, const auto & pt2) {
+      return (pt1.x == pt2.x) && (pt1.y == pt2.y) && (pt1.z == pt2.z);
+    };
+  return same_point(config1.get_min_point(), config2.get_min_point()) &&
+         same_point(config1.get_max_point(), config2.get_max_point()) &&
+         same_point(config1.get_voxel_size(), config2.get_voxel_size());
+}
+}  // namespace
+
+TileIndex tile_index(const Real x, const Real y, const Real tile_size)
+{
+  return {static_cast<int64_t>(std::floor(x / tile_size)),
+    static_cast<int64_t>(std::floor(y / tile_size))};
+}
+
+Real tile_distance(const TileIndex & tile, const Real tile_size, const Real x, const Real y)
+{
+  const auto axis_distance = [tile_size](const int64_t index, const Real coordinate) {
+      const auto min = static_cast<Real>(index) * tile_size;
+      return std::max({min - coordinate, coordinate - (min + tile_size), 0.0});
+    };
+  return std::hypot(axis_distance(tile.first, x), axis_distance(tile.second, y));
+}
+
 DynamicNDTMap::DynamicNDTMap(const Config & voxel_grid_config)
 : m_grid{voxel_grid_config} {}
 
@@ -85,55 +166,102 @@ void DynamicNDTMap::serialize_as<StaticNDTMap>(sensor_msgs::msg::PointCloud2 & m
 
   msg_out.header.stamp = time_utils::to_message(m_stamp);
 
-  const auto min_point = m_grid.config().get_min_point();
-  const auto max_point = m_grid.config().get_max_point();
-  const auto size = m_grid.config().get_voxel_size();
-
-  // Serialize the configuration to be reconstructed. First 3 fields are used to store the
-  // configuration and the remaining 6 fields are left unused so they are set to 0.0
-  msg_modifier.push_back(
-    PointWithCovariances{min_point.x, min_point.y, min_point.z,
-      0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
-  msg_modifier.push_back(
-    PointWithCovariances{max_point.x, max_point.y, max_point.z,
-      0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
-  msg_modifier.push_back(
-    PointWithCovariances{size.x, size.y, size.z,
-      0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+  // Serialize the configuration to be reconstructed.
+  push_back_config(m_grid.config(), msg_modifier);
 
-  auto num_used_cells = 0U;
+  PointWithCovariances voxel_point;
   for (const auto & vx_it : m_grid) {
-    const auto & vx = vx_it.second;
-    if (!vx.usable()) {
-      // Voxel doesn't have enough points to be used in NDT
-      continue;
+    if (serialize_voxel(vx_it.second, voxel_point)) {
+      msg_modifier.push_back(voxel_point);
     }
+  }
+}
 
-    const auto inv_covariance_opt = vx.inverse_covariance();
-    if (!inv_covariance_opt) {
-      // Voxel covariance is not invertible
+/// Each tile has the fields of the message serialized by `serialize_as<StaticNDTMap>()`.
+/// \param tile_size Edge length of the tiles.
+/// \param tiles_out Reference to the tiles, replaced by the ones which contain voxels.
+template<>
+void DynamicNDTMap::serialize_tiles_as<StaticNDTMap>(const Real tile_size, Tiles & tiles_out) const
+{
+  if (!(tile_size > 0.0)) {
+    throw std::domain_error("DynamicNDTMap: The tile size should be positive.");
+  }
+  tiles_out.clear();
+  std::map<TileIndex, ndt::NdtMapCloudModifier> tile_modifiers;
+
+  PointWithCovariances voxel_point;
+  for (const auto & vx_it : m_grid) {
+    if (!serialize_voxel(vx_it.second, voxel_point)) {
       continue;
     }
-
-    const auto & centroid = vx.centroid();
-    const auto & inv_covariance = inv_covariance_opt.value();
-    msg_modifier.push_back(
-          {
-            centroid(0U), centroid(1U), centroid(2U),
-            inv_covariance(0U, 0U), inv_covariance(0U, 1U), inv_covariance(0U, 2U),
-            inv_covariance(1U, 1U), inv_covariance(1U, 2U),
-            inv_covariance(2U, 2U)
-          });
-
-    ++num_used_cells;
+    const auto tile = tile_index(voxel_point.x, voxel_point.y, tile_size);
+    auto modifier_it = tile_modifiers.find(tile);
+    if (modifier_it == tile_modifiers.end()) {
+      auto & tile_msg = tiles_out[tile];
+      modifier_it = tile_modifiers.emplace(
+        std::piecewise_construct, std::forward_as_tuple(tile),
+        std::forward_as_tuple(tile_msg, frame_id())).first;
+      tile_msg.header.stamp = time_utils::to_message(m_stamp);
+      push_back_config(m_grid.config(), modifier_it->second);
+    }
+    modifier_it->second.push_back(voxel_point);
   }
 }
 
+/// The dense map deserializes the same messages as `StaticNDTMap`.
+/// \param msg_out Reference to the pointcloud message that will store
+/// the serialized map data. The message will be initialized before use.
+template<>
+void DynamicNDTMap::serialize_as<DenseStaticNDTMap>(sensor_msgs::msg::PointCloud2 & msg_out) const
+{
+  serialize_as<StaticNDTMap>(msg_out);
+}
+
+/// The dense map deserializes the same tiles as `StaticNDTMap`.
+/// \param tile_size Edge length of the tiles.
+/// \param tiles_out Reference to the tiles, replaced by the ones which contain voxels.
+template<>
+void DynamicNDTMap::serialize_tiles_as<DenseStaticNDTMap>(
+  const Real tile_size,
+  Tiles & tiles_out) const
+{
+  serialize_tiles_as<StaticNDTMap>(tile_size, tiles_out);
+}
+
+/// The compact map deserializes the same messages as `StaticNDTMap`.
+/// \param msg_out Reference to the pointcloud message that will store
+/// the serialized map data. The message will be initialized before use.
+template<>
+void DynamicNDTMap::serialize_as<CompactStaticNDTMap>(
+  sensor_msgs::msg::PointCloud2 & msg_out) const
+{
+  serialize_as<StaticNDTMap>(msg_out);
+}
+
+/// The compact map deserializes the same tiles as `StaticNDTMap`.
+/// \param tile_size Edge length of the tiles.
+/// \param tiles_out Reference to the tiles, replaced by the ones which contain voxels.
+template<>
+void DynamicNDTMap::serialize_tiles_as<CompactStaticNDTMap>(
+  const Real tile_size,
+  Tiles & tiles_out) const
+{
+  serialize_tiles_as<StaticNDTMap>(tile_size, tiles_out);
+}
+
 const DynamicNDTMap::VoxelViewVector & DynamicNDTMap::cell(const Point & pt) const
 {
   return m_grid.cell(pt);
 }
 
+const DynamicNDTMap::VoxelViewVector & DynamicNDTMap::cell(
+  const Point & pt,
+  VoxelViewVector & output,
+  const VoxelLookup lookup) const
+{
+  return m_grid.cell(pt, output, lookup);
+}
+
 const DynamicNDTMap::VoxelViewVector & DynamicNDTMap::cell(float32_t x, float32_t y, float32_t z)
 const
 {
@@ -160,22 +288,28 @@ void DynamicNDTMap::clear() noexcept
   m_grid.clear();
 }
 
-const std::string & StaticNDTMap::frame_id() const noexcept
+template<typename StorageT, typename VoxelT>
+const std::string & BasicStaticNDTMap<StorageT, VoxelT>::frame_id() const noexcept
 {
   return m_frame_id;
 }
 
-StaticNDTMap::TimePoint StaticNDTMap::stamp() const noexcept
+template<typename StorageT, typename VoxelT>
+typename BasicStaticNDTMap<StorageT, VoxelT>::TimePoint
+BasicStaticNDTMap<StorageT, VoxelT>::stamp() const noexcept
 {
   return m_stamp;
 }
 
-bool StaticNDTMap::valid() const noexcept
+template<typename StorageT, typename VoxelT>
+bool BasicStaticNDTMap<StorageT, VoxelT>::valid() const noexcept
 {
   return m_grid && (m_grid->size() > 0U) && (!m_frame_id.empty());
 }
 
-const StaticNDTMap::ConfigPoint & StaticNDTMap::cell_size() const
+template<typename StorageT, typename VoxelT>
+const typename BasicStaticNDTMap<StorageT, VoxelT>::ConfigPoint &
+BasicStaticNDTMap<StorageT, VoxelT>::cell_size() const
 {
   if (!m_grid) {
     throw std::runtime_error("Static ndt map was attempted to be used before a map was set.");
@@ -183,7 +317,8 @@ const StaticNDTMap::ConfigPoint & StaticNDTMap::cell_size() const
   return m_grid->cell_size();
 }
 
-void StaticNDTMap::set(const sensor_msgs::msg::PointCloud2 & msg)
+template<typename StorageT, typename VoxelT>
+void BasicStaticNDTMap<StorageT, VoxelT>::set(const sensor_msgs::msg::PointCloud2 & msg)
 {
   if (m_grid) {
     m_grid->clear();
@@ -193,7 +328,48 @@ void StaticNDTMap::set(const sensor_msgs::msg::PointCloud2 & msg)
   m_frame_id = msg.header.frame_id;
 }
 
-void StaticNDTMap::deserialize_from(const sensor_msgs::msg::PointCloud2 & msg)
+template<typename StorageT, typename VoxelT>
+void BasicStaticNDTMap<StorageT, VoxelT>::insert(const sensor_msgs::msg::PointCloud2 & msg)
+{
+  if (!m_grid) {
+    set(msg);
+    return;
+  }
+  if (msg.header.frame_id != m_frame_id) {
+    throw std::domain_error("StaticNDTMap: Inserted map has a different frame than the map.");
+  }
+  deserialize_from(msg, true);
+  m_stamp = ::time_utils::from_message(msg.header.stamp);
+}
+
+template<typename StorageT, typename VoxelT>
+std::size_t BasicStaticNDTMap<StorageT, VoxelT>::evict(
+  const Real x, const Real y,
+  const Real radius)
+{
+  std::size_t num_evicted = 0U;
+  if (!m_grid) {
+    return num_evicted;
+  }
+  const auto radius_squared = radius * radius;
+  for (auto vx_it = m_grid->cbegin(); vx_it != m_grid->cend(); ) {
+    const auto & centroid = vx_it->second.centroid();
+    const auto dx = centroid(0U) - x;
+    const auto dy = centroid(1U) - y;
+    if (((dx * dx) + (dy * dy)) > radius_squared) {
+      vx_it = m_grid->erase(vx_it);
+      ++num_evicted;
+    } else {
+      ++vx_it;
+    }
+  }
+  return num_evicted;
+}
+
+template<typename StorageT, typename VoxelT>
+void BasicStaticNDTMap<StorageT, VoxelT>::deserialize_from(
+  const sensor_msgs::msg::PointCloud2 & msg,
+  const bool merge)
 {
   using PointXYZ = geometry_msgs::msg::Point32;
   constexpr auto num_config_fields = 3U;
@@ -216,8 +392,13 @@ void StaticNDTMap::deserialize_from(const sensor_msgs::msg::PointCloud2 & msg)
     set__z(static_cast<float>(voxel_size.z)),
     map_size};
 
-  // Either update the map config or initialize the map.
-  if (m_grid) {
+  // Either keep, update or initialize the map config.
+  if (merge) {
+    if (!same_grid(m_grid->config(), config)) {
+      throw std::domain_error(
+              "StaticNDTMap: Inserted map has a different grid configuration than the map.");
+    }
+  } else if (m_grid) {
     m_grid->set_config(config);
   } else {
     m_grid.emplace(config);
@@ -242,7 +423,9 @@ void StaticNDTMap::deserialize_from(const sensor_msgs::msg::PointCloud2 & msg)
     }
   }
 }
-const StaticNDTMap::VoxelViewVector & StaticNDTMap::cell(const Point & pt) const
+template<typename StorageT, typename VoxelT>
+const typename BasicStaticNDTMap<StorageT, VoxelT>::VoxelViewVector &
+BasicStaticNDTMap<StorageT, VoxelT>::cell(const Point & pt) const
 {
   if (!m_grid) {
     throw std::runtime_error("Static ndt map was attempted to be used before a map was set.");
@@ -250,13 +433,28 @@ const StaticNDTMap::VoxelViewVector & StaticNDTMap::cell(const Point & pt) const
   return m_grid->cell(pt);
 }
 
-const StaticNDTMap::VoxelViewVector & StaticNDTMap::cell(float32_t x, float32_t y, float32_t z)
-const
+template<typename StorageT, typename VoxelT>
+const typename BasicStaticNDTMap<StorageT, VoxelT>::VoxelViewVector &
+BasicStaticNDTMap<StorageT, VoxelT>::cell(
+  const Point & pt,
+  VoxelViewVector & output,
+  const VoxelLookup lookup) const
+{
+  if (!m_grid) {
+    throw std::runtime_error("Static ndt map was attempted to be used before a map was set.");
+  }
+  return m_grid->cell(pt, output, lookup);
+}
+
+template<typename StorageT, typename VoxelT>
+const typename BasicStaticNDTMap<StorageT, VoxelT>::VoxelViewVector &
+BasicStaticNDTMap<StorageT, VoxelT>::cell(float32_t x, float32_t y, float32_t z) const
 {
   return cell(Point({x, y, z}));
 }
 
-std::size_t StaticNDTMap::size() const
+template<typename StorageT, typename VoxelT>
+std::size_t BasicStaticNDTMap<StorageT, VoxelT>::size() const
 {
   if (!m_grid) {
     throw std::runtime_error("Static ndt map was attempted to be used before a map was set.");
@@ -264,7 +462,9 @@ std::size_t StaticNDTMap::size() const
   return m_grid->size();
 }
 
-typename StaticNDTMap::VoxelGrid::const_iterator StaticNDTMap::begin() const
+template<typename StorageT, typename VoxelT>
+typename BasicStaticNDTMap<StorageT, VoxelT>::VoxelGrid::const_iterator
+BasicStaticNDTMap<StorageT, VoxelT>::begin() const
 {
   if (!m_grid) {
     throw std::runtime_error("Static ndt map was attempted to be used before a map was set.");
@@ -272,7 +472,9 @@ typename StaticNDTMap::VoxelGrid::const_iterator StaticNDTMap::begin() const
   return m_grid->cbegin();
 }
 
-typename StaticNDTMap::VoxelGrid::const_iterator StaticNDTMap::end() const
+template<typename StorageT, typename VoxelT>
+typename BasicStaticNDTMap<StorageT, VoxelT>::VoxelGrid::const_iterator
+BasicStaticNDTMap<StorageT, VoxelT>::end() const
 {
   if (!m_grid) {
     throw std::runtime_error("Static ndt map was attempted to be used before a map was set.");
@@ -280,13 +482,18 @@ typename StaticNDTMap::VoxelGrid::const_iterator StaticNDTMap::end() const
   return m_grid->cend();
 }
 
-void StaticNDTMap::clear()
+template<typename StorageT, typename VoxelT>
+void BasicStaticNDTMap<StorageT, VoxelT>::clear()
 {
   if (!m_grid) {
     throw std::runtime_error("Static ndt map was attempted to be used before a map was set.");
   }
   m_grid->clear();
 }
+
+template class BasicStaticNDTMap<HashGridStorage, StaticNDTVoxel>;
+template class BasicStaticNDTMap<DenseGridStorage, StaticNDTVoxel>;
+template class BasicStaticNDTMap<HashGridStorage, CompactStaticNDTVoxel>;
 }  // namespace ndt
 }  // namespace localization
 }  // namespace autoware
@@ -17,11 +17,22 @@
 #include <GeographicLib/Geocentric.hpp>
 #include <lidar_utils/point_cloud_utils.hpp>
 #include <ndt/ndt_map_publisher.hpp>
+#include <ndt/utils.hpp>
 #include <pcl/io/pcd_io.h>
 #include <pcl_conversions/pcl_conversions.h>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
 #include <yaml-cpp/yaml.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -31,6 +42,23 @@ namespace localization
 {
 namespace ndt
 {
+namespace
+{
+constexpr char kMapCacheMagic[8U] = {'N', 'D', 'T', 'C', 'A', 'C', 'H', 'E'};
+constexpr uint32_t kMapCacheVersion = 1U;
+
+/// Beginning of a map cache file. It is followed by the frame id and the points of the map.
+struct MapCacheHeader
+{
+  char magic[8U];
+  uint32_t version;
+  uint32_t point_size;
+  uint64_t num_points;
+  uint64_t frame_id_size;
+  int32_t stamp_sec;
+  uint32_t stamp_nanosec;
+};
+}  // namespace
 
 void read_from_yaml(
   const std::string & yaml_file_name,
@@ -154,13 +182,8 @@ void read_from_pcd(const std::string & file_name, sensor_msgs::msg::PointCloud2
   throw std::runtime_error("intensity datatype is not float or uint8_t");
 }
 
-geocentric_pose_t load_map(
-  const std::string & yaml_file_name,
-  const std::string & pcl_file_name,
-  sensor_msgs::msg::PointCloud2 & pc_out)
+geocentric_pose_t load_map_origin(const std::string & yaml_file_name)
 {
-  using autoware::common::types::PointXYZI;
-  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{pc_out}.clear();
   geodetic_pose_t geodetic_pose{0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
 
   if (!yaml_file_name.empty()) {
@@ -169,12 +192,6 @@ geocentric_pose_t load_map(
     throw std::runtime_error("YAML file name empty\n");
   }
 
-  if (!pcl_file_name.empty()) {
-    read_from_pcd(pcl_file_name, &pc_out);
-  } else {
-    throw std::runtime_error("PCD file name empty\n");
-  }
-
   float64_t x(0.0), y(0.0), z(0.0);
 
   GeographicLib::Geocentric earth(
@@ -189,6 +206,109 @@ geocentric_pose_t load_map(
 
   return {x, y, z, geodetic_pose.roll, geodetic_pose.pitch, geodetic_pose.yaw};
 }
+
+geocentric_pose_t load_map(
+  const std::string & yaml_file_name,
+  const std::string & pcl_file_name,
+  sensor_msgs::msg::PointCloud2 & pc_out)
+{
+  using autoware::common::types::PointXYZI;
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{pc_out}.clear();
+  const auto pose = load_map_origin(yaml_file_name);
+
+  if (!pcl_file_name.empty()) {
+    read_from_pcd(pcl_file_name, &pc_out);
+  } else {
+    throw std::runtime_error("PCD file name empty\n");
+  }
+  return pose;
+}
+
+void write_map_cache(
+  const std::string & file_name,
+  const sensor_msgs::msg::PointCloud2 & ndt_map)
+{
+  const NdtMapCloudView map_view{ndt_map};
+  const auto & frame_id = ndt_map.header.frame_id;
+  MapCacheHeader header{};
+  std::copy(std::begin(kMapCacheMagic), std::end(kMapCacheMagic), std::begin(header.magic));
+  header.version = kMapCacheVersion;
+  header.point_size = static_cast<uint32_t>(sizeof(PointWithCovariances));
+  header.num_points = map_view.size();
+  header.frame_id_size = frame_id.size();
+  header.stamp_sec = ndt_map.header.stamp.sec;
+  header.stamp_nanosec = ndt_map.header.stamp.nanosec;
+
+  std::ofstream file{file_name, std::ios::binary | std::ios::trunc};
+  if (!file) {
+    throw std::runtime_error(std::string("Map cache file ") + file_name + " could not be opened.");
+  }
+  (void) file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  (void) file.write(frame_id.data(), static_cast<std::streamsize>(frame_id.size()));
+  for (const auto & point : map_view) {
+    (void) file.write(reinterpret_cast<const char *>(&point), sizeof(point));
+  }
+  if (!file) {
+    throw std::runtime_error(std::string("Map cache file ") + file_name + " could not be written.");
+  }
+}
+
+void read_map_cache(
+  const std::string & file_name,
+  sensor_msgs::msg::PointCloud2 & ndt_map_out)
+{
+  const auto fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(std::string("Map cache file ") + file_name + " could not be opened.");
+  }
+  struct stat file_stat{};
+  const auto stat_result = ::fstat(fd, &file_stat);
+  const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+  void * const data = ((stat_result == 0) && (file_size > 0U)) ?
+    ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+  // The mapping stays valid after closing the file.
+  (void) ::close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error(std::string("Map cache file ") + file_name + " could not be mapped.");
+  }
+  const std::unique_ptr<void, std::function<void(void *)>> mapping{
+    data, [file_size](void * const ptr) {(void) ::munmap(ptr, file_size);}};
+  const auto bytes = static_cast<const char *>(data);
+
+  MapCacheHeader header{};
+  const auto invalid = [&file_name]() {
+      return std::runtime_error(std::string("Map cache file ") + file_name + " is not valid.");
+    };
+  if (file_size < sizeof(header)) {
+    throw invalid();
+  }
+  (void) std::memcpy(&header, bytes, sizeof(header));
+  if (!std::equal(std::begin(kMapCacheMagic), std::end(kMapCacheMagic), std::begin(header.magic)) ||
+    (header.version != kMapCacheVersion) ||
+    (header.point_size != sizeof(PointWithCovariances)) ||
+    (header.frame_id_size > (file_size - sizeof(header))))
+  {
+    throw invalid();
+  }
+  const auto points_offset = sizeof(header) + header.frame_id_size;
+  const auto points_size = file_size - points_offset;
+  if (((points_size % sizeof(PointWithCovariances)) != 0U) ||
+    ((points_size / sizeof(PointWithCovariances)) != header.num_points))
+  {
+    throw invalid();
+  }
+
+  const std::string frame_id(bytes + sizeof(header), header.frame_id_size);
+  NdtMapCloudModifier map_modifier{ndt_map_out, frame_id};
+  map_modifier.reserve(header.num_points);
+  PointWithCovariances point;
+  for (auto offset = points_offset; offset < file_size; offset += sizeof(point)) {
+    (void) std::memcpy(&point, bytes + offset, sizeof(point));
+    map_modifier.push_back(point);
+  }
+  ndt_map_out.header.stamp.sec = header.stamp_sec;
+  ndt_map_out.header.stamp.nanosec = header.stamp_nanosec;
+}
 }  // namespace ndt
 }  // namespace localization
 }  // namespace autoware
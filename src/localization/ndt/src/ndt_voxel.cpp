@@ -173,6 +173,61 @@ bool8_t StaticNDTVoxel::usable() const noexcept
 {
   return m_occupied;
 }
+
+/////////////////////////////////////////////////
+
+CompactStaticNDTVoxel::CompactStaticNDTVoxel() = default;
+
+CompactStaticNDTVoxel::CompactStaticNDTVoxel(const Point & centroid, const Cov & inv_covariance)
+: m_centroid{{static_cast<float32_t>(centroid(0U)), static_cast<float32_t>(centroid(1U)),
+      static_cast<float32_t>(centroid(2U))}},
+  m_inv_covariance{{static_cast<float32_t>(inv_covariance(0U, 0U)),
+      static_cast<float32_t>(inv_covariance(0U, 1U)),
+      static_cast<float32_t>(inv_covariance(0U, 2U)),
+      static_cast<float32_t>(inv_covariance(1U, 1U)),
+      static_cast<float32_t>(inv_covariance(1U, 2U)),
+      static_cast<float32_t>(inv_covariance(2U, 2U))}},
+  m_occupied{true}
+{}
+
+Eigen::Matrix3d CompactStaticNDTVoxel::covariance() const
+{
+  Eigen::Matrix3d covariance;
+  bool8_t invertible{false};
+  inverse_covariance().computeInverseWithCheck(covariance, invertible);
+  if (!invertible) {
+    throw std::out_of_range("CompactStaticNDTVoxel: Inverse covariance is not invertible");
+  }
+  return covariance;
+}
+
+Eigen::Vector3d CompactStaticNDTVoxel::centroid() const
+{
+  if (!m_occupied) {
+    throw std::out_of_range("CompactStaticNDTVoxel: Cannot get centroid from an unoccupied voxel");
+  }
+  return Eigen::Vector3f{m_centroid[0U], m_centroid[1U], m_centroid[2U]}.cast<Real>();
+}
+
+Eigen::Matrix3d CompactStaticNDTVoxel::inverse_covariance() const
+{
+  if (!m_occupied) {
+    throw std::out_of_range(
+            "CompactStaticNDTVoxel: Cannot get inverse covariance "
+            "from an unoccupied voxel");
+  }
+  Eigen::Matrix3f inv_covariance;
+  inv_covariance <<
+    m_inv_covariance[0U], m_inv_covariance[1U], m_inv_covariance[2U],
+    m_inv_covariance[1U], m_inv_covariance[3U], m_inv_covariance[4U],
+    m_inv_covariance[2U], m_inv_covariance[4U], m_inv_covariance[5U];
+  return inv_covariance.cast<Real>();
+}
+
+bool8_t CompactStaticNDTVoxel::usable() const noexcept
+{
+  return m_occupied;
+}
 }  // namespace ndt
 }  // namespace localization
 }  // namespace autoware
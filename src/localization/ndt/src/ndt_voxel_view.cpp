@@ -15,6 +15,7 @@
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
 #include <ndt/ndt_voxel_view.hpp>
+#include <stdexcept>
 #include <utility>
 
 namespace autoware
@@ -25,6 +26,7 @@ namespace ndt
 {
 
 using StaticView = VoxelView<StaticNDTVoxel>;
+using CompactStaticView = VoxelView<CompactStaticNDTVoxel>;
 using DynamicView = VoxelView<DynamicNDTVoxel>;
 
 StaticView::VoxelView(const StaticNDTVoxel & voxel) : Base(voxel), m_usable{voxel.usable()} {}
@@ -44,6 +46,41 @@ bool8_t StaticView::usable_() const noexcept
   return m_usable;
 }
 
+CompactStaticView::VoxelView(const CompactStaticNDTVoxel & voxel)
+: Base(voxel), m_usable{voxel.usable()}
+{
+  if (m_usable) {
+    m_centroid = voxel.centroid();
+    m_inverse_covariance = voxel.inverse_covariance();
+  } else {
+    m_centroid.setZero();
+    m_inverse_covariance.setZero();
+  }
+}
+
+const CompactStaticView::Cov & CompactStaticView::inverse_covariance_() const
+{
+  if (!m_usable) {
+    throw std::out_of_range(
+            "CompactStaticNDTVoxel: Cannot get inverse covariance "
+            "from an unoccupied voxel");
+  }
+  return m_inverse_covariance;
+}
+
+const CompactStaticView::Point & CompactStaticView::centroid_() const
+{
+  if (!m_usable) {
+    throw std::out_of_range("CompactStaticNDTVoxel: Cannot get centroid from an unoccupied voxel");
+  }
+  return m_centroid;
+}
+
+bool8_t CompactStaticView::usable_() const noexcept
+{
+  return m_usable;
+}
+
 DynamicView::VoxelView(const DynamicNDTVoxel & voxel) : Base{voxel}, m_usable{voxel.usable()} {
   if (m_usable) {
     auto res = voxel.inverse_covariance();
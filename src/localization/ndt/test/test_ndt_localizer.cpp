@@ -19,6 +19,7 @@
 #include <ndt/ndt_localizer.hpp>
 #include <optimization/newtons_method_optimizer.hpp>
 #include <optimization/line_search/fixed_line_search.hpp>
+#include <optimization/line_search/more_thuente_line_search.hpp>
 #include <limits>
 #include "test_ndt_optimization.hpp"
 #include "test_ndt_utils.hpp"
@@ -236,3 +237,346 @@ TEST_F(P2DLocalizerParameterTest, AsyncInitialGuess) {
     localizer.register_measurement(m_downsampled_cloud, set_and_get(guess_time_early), map),
     std::domain_error);
 }
+
+TEST_F(P2DLocalizerParameterTest, MapPyramid) {
+  const auto now = std::chrono::system_clock::now();
+  P2DTestLocalizer::Transform transform_initial{};
+  transform_initial.header.stamp = ::time_utils::to_message(now);
+  transform_initial.transform.rotation.w = 1.0;
+
+  auto translated_cloud = m_downsampled_cloud;
+  geometry_msgs::msg::TransformStamped diff_tf2;
+  diff_tf2.transform.translation.y = 0.3;
+  diff_tf2.transform.rotation.w = 1.0;
+  tf2::doTransform(m_downsampled_cloud, translated_cloud, diff_tf2);
+  translated_cloud.header.stamp = ::time_utils::to_message(now);
+
+  sensor_msgs::msg::PointCloud2 serialized_map;
+  m_dynamic_map.serialize_as<autoware::localization::ndt::StaticNDTMap>(serialized_map);
+  serialized_map.header.stamp = ::time_utils::to_message(now - std::chrono::seconds(1));
+
+  P2DTestLocalizer localizer{
+    m_localizer_config,
+    NewtonOptimizer{FixedLineSearch{m_step_size}, m_optimizer_options},
+    m_outlier_ratio};
+
+  autoware::localization::ndt::NDTMapPyramid<autoware::localization::ndt::StaticNDTMap> maps{};
+  EXPECT_THROW(
+    localizer.register_measurement(translated_cloud, transform_initial, maps),
+    std::runtime_error);
+
+  autoware::localization::ndt::StaticNDTMap map{};
+  map.set(serialized_map);
+  maps.set(serialized_map);
+
+  // A single level pyramid is the same as the map of its level
+  EigenPose<Real> pose_map, pose_pyramid;
+  transform_to_pose(
+    localizer.register_measurement(translated_cloud, transform_initial, map).pose.pose, pose_map);
+  transform_to_pose(
+    localizer.register_measurement(translated_cloud, transform_initial, maps).pose.pose,
+    pose_pyramid);
+  compare(pose_map, pose_pyramid);
+}
+
+TEST_F(P2DLocalizerParameterTest, PreparedScan) {
+  const auto now = std::chrono::system_clock::now();
+  P2DTestLocalizer::Transform transform_initial{};
+  transform_initial.header.stamp = ::time_utils::to_message(now);
+  transform_initial.transform.rotation.w = 1.0;
+
+  auto translated_cloud = m_downsampled_cloud;
+  geometry_msgs::msg::TransformStamped diff_tf2;
+  diff_tf2.transform.translation.y = 0.3;
+  diff_tf2.transform.rotation.w = 1.0;
+  tf2::doTransform(m_downsampled_cloud, translated_cloud, diff_tf2);
+  translated_cloud.header.stamp = ::time_utils::to_message(now);
+
+  sensor_msgs::msg::PointCloud2 serialized_map;
+  m_dynamic_map.serialize_as<autoware::localization::ndt::StaticNDTMap>(serialized_map);
+  serialized_map.header.stamp = ::time_utils::to_message(now - std::chrono::seconds(1));
+  autoware::localization::ndt::StaticNDTMap map{};
+  map.set(serialized_map);
+  autoware::localization::ndt::NDTMapPyramid<autoware::localization::ndt::StaticNDTMap> maps{};
+  maps.set(serialized_map);
+
+  P2DTestLocalizer localizer{
+    m_localizer_config,
+    NewtonOptimizer{FixedLineSearch{m_step_size}, m_optimizer_options},
+    m_outlier_ratio};
+
+  EigenPose<Real> pose_msg, pose_prepared, pose_pyramid;
+  transform_to_pose(
+    localizer.register_measurement(translated_cloud, transform_initial, map).pose.pose, pose_msg);
+
+  // Preparing the scan ahead of the registration does not change the registration
+  auto scan = localizer.make_scan();
+  localizer.prepare_scan(translated_cloud, scan);
+  EXPECT_EQ(scan.size(), translated_cloud.width);
+  transform_to_pose(
+    localizer.register_measurement(translated_cloud, scan, transform_initial, map).pose.pose,
+    pose_prepared);
+  compare(pose_msg, pose_prepared);
+  EXPECT_EQ(localizer.scan().size(), translated_cloud.width);
+
+  // The scan buffer handed back is reused for the next measurement
+  localizer.prepare_scan(translated_cloud, scan);
+  transform_to_pose(
+    localizer.register_measurement(translated_cloud, scan, transform_initial, maps).pose.pose,
+    pose_pyramid);
+  compare(pose_msg, pose_pyramid);
+}
+
+TEST_F(P2DLocalizerParameterTest, DenseStorage) {
+  using autoware::localization::ndt::DenseStaticNDTMap;
+  const auto now = std::chrono::system_clock::now();
+  P2DTestLocalizer::Transform transform_initial{};
+  transform_initial.header.stamp = ::time_utils::to_message(now);
+  transform_initial.transform.rotation.w = 1.0;
+
+  auto translated_cloud = m_downsampled_cloud;
+  geometry_msgs::msg::TransformStamped diff_tf2;
+  diff_tf2.transform.translation.y = 0.3;
+  diff_tf2.transform.rotation.w = 1.0;
+  tf2::doTransform(m_downsampled_cloud, translated_cloud, diff_tf2);
+  translated_cloud.header.stamp = ::time_utils::to_message(now);
+
+  sensor_msgs::msg::PointCloud2 serialized_map;
+  m_dynamic_map.serialize_as<DenseStaticNDTMap>(serialized_map);
+  serialized_map.header.stamp = ::time_utils::to_message(now - std::chrono::seconds(1));
+  autoware::localization::ndt::StaticNDTMap hash_map{};
+  hash_map.set(serialized_map);
+  DenseStaticNDTMap dense_map{};
+  dense_map.set(serialized_map);
+
+  P2DTestLocalizer hash_localizer{
+    m_localizer_config,
+    NewtonOptimizer{FixedLineSearch{m_step_size}, m_optimizer_options},
+    m_outlier_ratio};
+  P2DNDTLocalizer<NewtonOptimizer, DenseStaticNDTMap> dense_localizer{
+    m_localizer_config,
+    NewtonOptimizer{FixedLineSearch{m_step_size}, m_optimizer_options},
+    m_outlier_ratio};
+
+  // The storage of the voxels does not change the registration
+  EigenPose<Real> pose_hash, pose_dense;
+  transform_to_pose(
+    hash_localizer.register_measurement(translated_cloud, transform_initial, hash_map).pose.pose,
+    pose_hash);
+  transform_to_pose(
+    dense_localizer.register_measurement(translated_cloud, transform_initial, dense_map).pose.pose,
+    pose_dense);
+  compare(pose_hash, pose_dense);
+}
+
+TEST_F(P2DLocalizerParameterTest, CompactVoxels) {
+  using autoware::localization::ndt::CompactStaticNDTMap;
+  const auto now = std::chrono::system_clock::now();
+  P2DTestLocalizer::Transform transform_initial{};
+  transform_initial.header.stamp = ::time_utils::to_message(now);
+  transform_initial.transform.rotation.w = 1.0;
+
+  auto translated_cloud = m_downsampled_cloud;
+  geometry_msgs::msg::TransformStamped diff_tf2;
+  diff_tf2.transform.translation.y = 0.3;
+  diff_tf2.transform.rotation.w = 1.0;
+  tf2::doTransform(m_downsampled_cloud, translated_cloud, diff_tf2);
+  translated_cloud.header.stamp = ::time_utils::to_message(now);
+
+  sensor_msgs::msg::PointCloud2 serialized_map;
+  m_dynamic_map.serialize_as<CompactStaticNDTMap>(serialized_map);
+  serialized_map.header.stamp = ::time_utils::to_message(now - std::chrono::seconds(1));
+  autoware::localization::ndt::StaticNDTMap map{};
+  map.set(serialized_map);
+  CompactStaticNDTMap compact_map{};
+  compact_map.set(serialized_map);
+
+  P2DTestLocalizer localizer{
+    m_localizer_config,
+    NewtonOptimizer{FixedLineSearch{m_step_size}, m_optimizer_options},
+    m_outlier_ratio};
+  P2DNDTLocalizer<NewtonOptimizer, CompactStaticNDTMap> compact_localizer{
+    m_localizer_config,
+    NewtonOptimizer{FixedLineSearch{m_step_size}, m_optimizer_options},
+    m_outlier_ratio};
+
+  // The single precision voxels barely change the registration
+  EigenPose<Real> pose, pose_compact;
+  transform_to_pose(
+    localizer.register_measurement(translated_cloud, transform_initial, map).pose.pose, pose);
+  transform_to_pose(
+    compact_localizer.register_measurement(
+      translated_cloud, transform_initial, compact_map).pose.pose,
+    pose_compact);
+  EXPECT_TRUE(pose_compact.isApprox(pose, 1.0E-4));
+}
+
+TEST_F(P2DLocalizerParameterTest, ScoreTolerancePerPoint) {
+  using autoware::common::optimization::TerminationType;
+  const auto now = std::chrono::system_clock::now();
+  P2DTestLocalizer::Transform transform_initial{};
+  transform_initial.header.stamp = ::time_utils::to_message(now);
+  transform_initial.transform.rotation.w = 1.0;
+
+  auto translated_cloud = m_downsampled_cloud;
+  geometry_msgs::msg::TransformStamped diff_tf2;
+  diff_tf2.transform.translation.y = 0.3;
+  diff_tf2.transform.rotation.w = 1.0;
+  tf2::doTransform(m_downsampled_cloud, translated_cloud, diff_tf2);
+  translated_cloud.header.stamp = ::time_utils::to_message(now);
+
+  sensor_msgs::msg::PointCloud2 serialized_map;
+  m_dynamic_map.serialize_as<autoware::localization::ndt::StaticNDTMap>(serialized_map);
+  serialized_map.header.stamp = ::time_utils::to_message(now - std::chrono::seconds(1));
+  autoware::localization::ndt::StaticNDTMap map{};
+  map.set(serialized_map);
+
+  P2DTestLocalizer localizer{
+    m_localizer_config,
+    NewtonOptimizer{FixedLineSearch{m_step_size}, m_optimizer_options},
+    m_outlier_ratio};
+  // Far more than a step improves the score by per point
+  constexpr Real tolerance_per_point{1e3};
+  P2DTestLocalizer tolerant_localizer{
+    P2DNDTLocalizerConfig{
+      m_downsampled_cloud.width, m_guess_time_tol, 1U,
+      autoware::localization::ndt::VoxelLookup::DIRECT1, tolerance_per_point},
+    NewtonOptimizer{FixedLineSearch{m_step_size}, m_optimizer_options},
+    m_outlier_ratio};
+
+  P2DTestLocalizer::Summary summary, tolerant_summary;
+  localizer.register_measurement(translated_cloud, transform_initial, map, &summary);
+  tolerant_localizer.register_measurement(
+    translated_cloud, transform_initial, map, &tolerant_summary);
+
+  // The tolerance is scaled by the number of scan points.
+  EXPECT_DOUBLE_EQ(
+    tolerant_localizer.optimizer().options().absolute_function_tolerance(),
+    tolerance_per_point * static_cast<Real>(m_downsampled_cloud.width));
+  EXPECT_DOUBLE_EQ(localizer.optimizer().options().absolute_function_tolerance(), 0.0);
+  EXPECT_EQ(
+    tolerant_summary.optimization_summary().termination_type(), TerminationType::CONVERGENCE);
+  EXPECT_EQ(tolerant_summary.optimization_summary().number_of_iterations_made(), 0U);
+  EXPECT_LE(
+    tolerant_summary.optimization_summary().number_of_iterations_made(),
+    summary.optimization_summary().number_of_iterations_made());
+}
+
+TEST_F(P2DLocalizerParameterTest, GlobalInitialization) {
+  using autoware::localization::ndt::GlobalInitializationConfig;
+  const auto now = std::chrono::system_clock::now();
+  auto translated_cloud = m_downsampled_cloud;
+  geometry_msgs::msg::TransformStamped diff_tf2;
+  diff_tf2.transform.translation.y = 0.3;
+  diff_tf2.transform.rotation.w = 1.0;
+  tf2::doTransform(m_downsampled_cloud, translated_cloud, diff_tf2);
+  translated_cloud.header.stamp = ::time_utils::to_message(now);
+
+  sensor_msgs::msg::PointCloud2 serialized_map;
+  m_dynamic_map.serialize_as<autoware::localization::ndt::StaticNDTMap>(serialized_map);
+  serialized_map.header.stamp = ::time_utils::to_message(now - std::chrono::seconds(1));
+  autoware::localization::ndt::StaticNDTMap map{};
+  map.set(serialized_map);
+
+  P2DTestLocalizer localizer{
+    m_localizer_config,
+    NewtonOptimizer{FixedLineSearch{m_step_size}, m_optimizer_options},
+    m_outlier_ratio};
+
+  // A coarse fix off by half a voxel, with an unknown heading and time stamp
+  P2DTestLocalizer::Transform coarse_fix{};
+  coarse_fix.header.frame_id = "map";
+  coarse_fix.child_frame_id = "base_link";
+  coarse_fix.transform.translation.x = 0.5;
+  coarse_fix.transform.rotation.z = 1.0;
+  coarse_fix.transform.rotation.w = 0.0;
+
+  EigenPose<Real> pose_single, pose_multi;
+  const auto pose_out = localizer.register_globally(
+    translated_cloud, coarse_fix, map, GlobalInitializationConfig{0.5, 0.5, 8U, 4U, 1U});
+  EXPECT_EQ(pose_out.header.stamp, translated_cloud.header.stamp);
+  EXPECT_EQ(pose_out.header.frame_id, map.frame_id());
+  transform_to_pose(pose_out.pose.pose, pose_single);
+  EigenPose<Real> expected;
+  expected << 0.0, -0.3, 0.0, 0.0, 0.0, 0.0;
+  is_pose_approx(pose_single, expected, 0.05, 1e-2);
+  EXPECT_NEAR(pose_single(1), -0.3, 0.05);
+
+  // The candidates do not depend on the number of threads
+  transform_to_pose(
+    localizer.register_globally(
+      translated_cloud, coarse_fix, map, GlobalInitializationConfig{0.5, 0.5, 8U, 4U, 3U}).
+    pose.pose,
+    pose_multi);
+  compare(pose_single, pose_multi);
+
+  EXPECT_THROW((GlobalInitializationConfig{-1.0, 0.5, 8U, 4U}), std::domain_error);
+  EXPECT_THROW((GlobalInitializationConfig{1.0, 0.0, 8U, 4U}), std::domain_error);
+  EXPECT_THROW((GlobalInitializationConfig{1.0, 0.5, 0U, 4U}), std::domain_error);
+  EXPECT_THROW((GlobalInitializationConfig{1.0, 0.5, 8U, 0U}), std::domain_error);
+}
+
+/// Map counting its lookups, to measure how often the objective is evaluated.
+class LookupCountingMap : public autoware::localization::ndt::StaticNDTMap
+{
+public:
+  using Base = autoware::localization::ndt::StaticNDTMap;
+  using Base::cell;
+
+  const VoxelViewVector & cell(
+    const Point & pt, VoxelViewVector & output,
+    const autoware::localization::ndt::VoxelLookup lookup =
+    autoware::localization::ndt::VoxelLookup::DIRECT1) const
+  {
+    ++m_num_lookups;
+    return Base::cell(pt, output, lookup);
+  }
+
+  mutable std::size_t m_num_lookups{0U};
+};
+
+TEST_F(P2DLocalizerParameterTest, EvaluationsPerLocalization) {
+  using autoware::common::optimization::MoreThuenteLineSearch;
+  using MoreThuenteOptimizer =
+    autoware::common::optimization::NewtonsMethodOptimizer<MoreThuenteLineSearch>;
+  const auto now = std::chrono::system_clock::now();
+  P2DTestLocalizer::Transform transform_initial{};
+  transform_initial.header.stamp = ::time_utils::to_message(now);
+  transform_initial.transform.rotation.w = 1.0;
+
+  auto translated_cloud = m_downsampled_cloud;
+  geometry_msgs::msg::TransformStamped diff_tf2;
+  diff_tf2.transform.translation.y = 0.3;
+  diff_tf2.transform.rotation.w = 1.0;
+  tf2::doTransform(m_downsampled_cloud, translated_cloud, diff_tf2);
+  translated_cloud.header.stamp = ::time_utils::to_message(now);
+
+  sensor_msgs::msg::PointCloud2 serialized_map;
+  m_dynamic_map.serialize_as<autoware::localization::ndt::StaticNDTMap>(serialized_map);
+  serialized_map.header.stamp = ::time_utils::to_message(now - std::chrono::seconds(1));
+  LookupCountingMap map{};
+  map.set(serialized_map);
+
+  P2DNDTLocalizer<MoreThuenteOptimizer, LookupCountingMap> localizer{
+    m_localizer_config,
+    MoreThuenteOptimizer{
+      MoreThuenteLineSearch{
+        m_step_size, 1e-4F, MoreThuenteLineSearch::OptimizationDirection::kMaximization},
+      m_optimizer_options},
+    m_outlier_ratio};
+  P2DTestLocalizer::Summary summary;
+  localizer.register_measurement(translated_cloud, transform_initial, map, &summary);
+
+  // Each evaluation of the objective looks up the voxels of every scan point once. The line
+  // search reuses the terms cached at its starting point, so an iteration only evaluates the
+  // objective at its line search trials, and for the hessian at the accepted step.
+  const auto num_points = static_cast<std::size_t>(m_downsampled_cloud.width);
+  const auto num_evaluations = map.m_num_lookups / num_points;
+  const auto num_iterations = summary.optimization_summary().number_of_iterations_made();
+  RecordProperty("evaluations_per_localization", static_cast<int>(num_evaluations));
+  RecordProperty("iterations_per_localization", static_cast<int>(num_iterations));
+  std::cout << "Objective evaluations per localization: " << num_evaluations << " in " <<
+    num_iterations << " iterations" << std::endl;
+  EXPECT_GT(num_evaluations, 0U);
+  EXPECT_LE(num_evaluations, 1U + (num_iterations * 11U));
+}
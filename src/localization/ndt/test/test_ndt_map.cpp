@@ -15,6 +15,7 @@
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
 #include <gtest/gtest.h>
+#include <ndt/ndt_map_pyramid.hpp>
 #include <ndt/utils.hpp>
 #include <Eigen/LU>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
@@ -335,6 +336,263 @@ TEST_F(NDTMapTest, MapRepresentationBasics) {
   EXPECT_EQ(map_grid.size(), 0U);
 }
 
+TEST_F(DenseNDTMapTest, MapPyramid) {
+  using autoware::localization::ndt::NDTMapPyramid;
+  build_pc(Config(m_min_point, m_max_point, m_voxel_size, m_capacity));
+  const auto serialize = [this](const float32_t voxel_size) {
+      PointXYZ size;
+      size.x = voxel_size;
+      size.y = voxel_size;
+      size.z = voxel_size;
+      DynamicNDTMap map{Config{m_min_point, m_max_point, size, m_capacity}};
+      map.insert(m_pc);
+      sensor_msgs::msg::PointCloud2 msg;
+      map.serialize_as<StaticNDTMap>(msg);
+      return msg;
+    };
+  const auto fine_msg = serialize(1.0F);
+  const auto coarse_msg = serialize(2.0F);
+  const auto coarser_msg = serialize(4.0F);
+
+  EXPECT_THROW(NDTMapPyramid<StaticNDTMap>{0U}, std::domain_error);
+  NDTMapPyramid<StaticNDTMap> pyramid{2U};
+  EXPECT_FALSE(pyramid.valid());
+  EXPECT_THROW(pyramid.finest(), std::runtime_error);
+
+  // Levels are ordered from coarse to fine, regardless of the order they are set in
+  pyramid.set(fine_msg);
+  pyramid.set(coarse_msg);
+  ASSERT_EQ(pyramid.levels().size(), 2U);
+  EXPECT_TRUE(pyramid.valid());
+  EXPECT_FLOAT_EQ(pyramid.levels().front().cell_size().x, 2.0F);
+  EXPECT_FLOAT_EQ(pyramid.finest().cell_size().x, 1.0F);
+  EXPECT_EQ(pyramid.frame_id(), "map");
+  EXPECT_EQ(pyramid.stamp(), pyramid.finest().stamp());
+
+  // Setting a resolution of the same map again is inserted into its level
+  pyramid.set(coarse_msg);
+  EXPECT_EQ(pyramid.levels().size(), 2U);
+
+  // A further resolution replaces all levels
+  pyramid.set(coarser_msg);
+  ASSERT_EQ(pyramid.levels().size(), 1U);
+  EXPECT_FLOAT_EQ(pyramid.finest().cell_size().x, 4.0F);
+
+  // So does a map with another time stamp
+  pyramid.set(coarse_msg);
+  ASSERT_EQ(pyramid.levels().size(), 2U);
+  auto newer_msg = fine_msg;
+  newer_msg.header.stamp.sec += 1;
+  pyramid.set(newer_msg);
+  ASSERT_EQ(pyramid.levels().size(), 1U);
+  EXPECT_FLOAT_EQ(pyramid.finest().cell_size().x, 1.0F);
+
+  // A bad map leaves the levels as they are
+  sensor_msgs::msg::PointCloud2 empty_msg;
+  autoware::localization::ndt::NdtMapCloudModifier empty_view{empty_msg, "map"};
+  EXPECT_THROW(pyramid.set(empty_msg), std::runtime_error);
+  EXPECT_EQ(pyramid.levels().size(), 1U);
+  EXPECT_TRUE(pyramid.valid());
+}
+
+TEST_F(DenseNDTMapTest, MapTiles) {
+  using autoware::localization::ndt::TileIndex;
+  using autoware::localization::ndt::tile_index;
+  using autoware::localization::ndt::tile_distance;
+  EXPECT_EQ(tile_index(2.5, -0.5, 2.0), TileIndex(1, -1));
+  EXPECT_DOUBLE_EQ(tile_distance(TileIndex(1, -1), 2.0, 2.5, -0.5), 0.0);
+  EXPECT_DOUBLE_EQ(tile_distance(TileIndex(1, -1), 2.0, 7.0, 4.0), 5.0);
+
+  const Config grid_config{m_min_point, m_max_point, m_voxel_size, m_capacity};
+  build_pc(grid_config);
+  DynamicNDTMap dynamic_map{grid_config};
+  dynamic_map.insert(m_pc);
+  sensor_msgs::msg::PointCloud2 map_msg;
+  dynamic_map.serialize_as<StaticNDTMap>(map_msg);
+  StaticNDTMap whole_map;
+  whole_map.set(map_msg);
+
+  DynamicNDTMap::Tiles tiles;
+  EXPECT_THROW(dynamic_map.serialize_tiles_as<StaticNDTMap>(0.0, tiles), std::domain_error);
+  dynamic_map.serialize_tiles_as<StaticNDTMap>(2.0, tiles);
+  EXPECT_GT(tiles.size(), 1U);
+
+  // The tiles add up to the whole map
+  StaticNDTMap tiled_map;
+  for (const auto & tile : tiles) {
+    tiled_map.insert(tile.second);
+  }
+  ASSERT_EQ(tiled_map.size(), whole_map.size());
+  for (const auto & vx_it : whole_map) {
+    const auto & cell = tiled_map.cell(vx_it.second.centroid());
+    ASSERT_EQ(cell.size(), 1U);
+    EXPECT_TRUE(cell[0U].centroid().isApprox(vx_it.second.centroid()));
+  }
+
+  // A map with another grid can not be inserted
+  PointXYZ coarse_voxel_size;
+  coarse_voxel_size.x = 2.0F;
+  coarse_voxel_size.y = 2.0F;
+  coarse_voxel_size.z = 2.0F;
+  DynamicNDTMap coarse_map{Config{m_min_point, m_max_point, coarse_voxel_size, m_capacity}};
+  coarse_map.insert(m_pc);
+  sensor_msgs::msg::PointCloud2 coarse_msg;
+  coarse_map.serialize_as<StaticNDTMap>(coarse_msg);
+  EXPECT_THROW(tiled_map.insert(coarse_msg), std::domain_error);
+  EXPECT_EQ(tiled_map.size(), whole_map.size());
+
+  // Only the voxels in range are kept
+  constexpr auto radius = 3.0;
+  const auto num_evicted = tiled_map.evict(0.0, 0.0, radius);
+  EXPECT_GT(num_evicted, 0U);
+  EXPECT_GT(tiled_map.size(), 0U);
+  EXPECT_EQ(tiled_map.size() + num_evicted, whole_map.size());
+  for (const auto & vx_it : tiled_map) {
+    EXPECT_LE(vx_it.second.centroid().head<2>().norm(), radius);
+  }
+}
+
+TEST_F(DenseNDTMapTest, NeighbourLookup) {
+  using autoware::localization::ndt::VoxelLookup;
+  using autoware::localization::ndt::max_num_voxels;
+  const Config grid_config{m_min_point, m_max_point, m_voxel_size, m_capacity};
+  build_pc(grid_config);
+  DynamicNDTMap dynamic_map{grid_config};
+  dynamic_map.insert(m_pc);
+  sensor_msgs::msg::PointCloud2 map_msg;
+  dynamic_map.serialize_as<StaticNDTMap>(map_msg);
+  StaticNDTMap map;
+  map.set(map_msg);
+
+  StaticNDTMap::VoxelViewVector cells;
+  cells.reserve(max_num_voxels(VoxelLookup::DIRECT27));
+  const auto capacity = cells.capacity();
+  const auto expect_cells = [&map, &cells](
+    const Eigen::Vector3d & pt, const VoxelLookup lookup, const std::size_t num_cells) {
+      map.cell(pt, cells, lookup);
+      ASSERT_EQ(cells.size(), num_cells);
+      // The containing voxel comes first, and the others are its distinct neighbours
+      EXPECT_LT((cells[0U].centroid() - pt.array().round().matrix()).norm(), 0.5);
+      for (auto i = 1U; i < cells.size(); ++i) {
+        const Eigen::Vector3d offset = cells[i].centroid() - cells[0U].centroid();
+        EXPECT_LT(offset.lpNorm<Eigen::Infinity>(), 1.5);
+        for (auto j = 0U; j < i; ++j) {
+          EXPECT_FALSE(cells[i].centroid().isApprox(cells[j].centroid(), 1e-3));
+        }
+      }
+    };
+
+  // Interior voxel, also close to a voxel boundary
+  for (const auto & pt : {Eigen::Vector3d{3.0, 3.0, 3.0}, Eigen::Vector3d{3.49, 2.51, 3.0}}) {
+    expect_cells(pt, VoxelLookup::DIRECT1, 1U);
+    expect_cells(pt, VoxelLookup::DIRECT7, 7U);
+    expect_cells(pt, VoxelLookup::DIRECT27, 27U);
+  }
+  // Neighbours outside of the grid are not returned, nor is the clamped voxel twice.
+  expect_cells(Eigen::Vector3d{1.0, 1.0, 1.0}, VoxelLookup::DIRECT7, 4U);
+  expect_cells(Eigen::Vector3d{1.0, 1.0, 1.0}, VoxelLookup::DIRECT27, 8U);
+  expect_cells(Eigen::Vector3d{5.0, 3.0, 1.0}, VoxelLookup::DIRECT27, 12U);
+  // The lookup does not allocate
+  EXPECT_EQ(cells.capacity(), capacity);
+  // The default lookup is the containing voxel
+  EXPECT_EQ(map.cell(Eigen::Vector3d{3.0, 3.0, 3.0}, cells).size(), 1U);
+}
+
+TEST_F(DenseNDTMapTest, DenseStorage) {
+  using autoware::localization::ndt::DenseStaticNDTMap;
+  const Config grid_config{m_min_point, m_max_point, m_voxel_size, m_capacity};
+  build_pc(grid_config);
+  DynamicNDTMap dynamic_map{grid_config};
+  dynamic_map.insert(m_pc);
+  sensor_msgs::msg::PointCloud2 map_msg;
+  dynamic_map.serialize_as<StaticNDTMap>(map_msg);
+  StaticNDTMap hash_map;
+  hash_map.set(map_msg);
+  DenseStaticNDTMap dense_map;
+  EXPECT_THROW(dense_map.size(), std::runtime_error);
+
+  // Both storages hold the same voxels
+  sensor_msgs::msg::PointCloud2 dense_msg;
+  dynamic_map.serialize_as<DenseStaticNDTMap>(dense_msg);
+  dense_map.set(dense_msg);
+  const auto num_voxels = hash_map.size();
+  ASSERT_EQ(dense_map.size(), num_voxels);
+  for (const auto & vx_it : hash_map) {
+    const auto & cell = dense_map.cell(vx_it.second.centroid());
+    ASSERT_EQ(cell.size(), 1U);
+    EXPECT_TRUE(cell[0U].centroid().isApprox(vx_it.second.centroid()));
+    EXPECT_TRUE(cell[0U].inverse_covariance().isApprox(vx_it.second.inverse_covariance()));
+  }
+
+  // Tiles build up the map and eviction keeps the remaining voxels reachable
+  DynamicNDTMap::Tiles tiles;
+  dynamic_map.serialize_tiles_as<DenseStaticNDTMap>(2.0, tiles);
+  DenseStaticNDTMap tiled_map;
+  for (const auto & tile : tiles) {
+    tiled_map.insert(tile.second);
+  }
+  ASSERT_EQ(tiled_map.size(), hash_map.size());
+  constexpr auto radius = 3.0;
+  EXPECT_EQ(tiled_map.evict(0.0, 0.0, radius), hash_map.evict(0.0, 0.0, radius));
+  ASSERT_EQ(tiled_map.size(), hash_map.size());
+  for (const auto & vx_it : hash_map) {
+    const auto & cell = tiled_map.cell(vx_it.second.centroid());
+    ASSERT_EQ(cell.size(), 1U);
+    EXPECT_TRUE(cell[0U].centroid().isApprox(vx_it.second.centroid()));
+  }
+
+  // Setting a map replaces the voxels
+  tiled_map.set(dense_msg);
+  EXPECT_EQ(tiled_map.size(), num_voxels);
+}
+
+TEST_F(DenseNDTMapTest, CompactVoxels) {
+  using autoware::localization::ndt::CompactStaticNDTMap;
+  using autoware::localization::ndt::CompactStaticNDTVoxel;
+  EXPECT_LT(2U * sizeof(CompactStaticNDTVoxel), sizeof(StaticNDTVoxel));
+  const Config grid_config{m_min_point, m_max_point, m_voxel_size, m_capacity};
+  build_pc(grid_config);
+  DynamicNDTMap dynamic_map{grid_config};
+  dynamic_map.insert(m_pc);
+  sensor_msgs::msg::PointCloud2 map_msg;
+  dynamic_map.serialize_as<StaticNDTMap>(map_msg);
+  StaticNDTMap map;
+  map.set(map_msg);
+  sensor_msgs::msg::PointCloud2 compact_msg;
+  dynamic_map.serialize_as<CompactStaticNDTMap>(compact_msg);
+  CompactStaticNDTMap compact_map;
+  compact_map.set(compact_msg);
+
+  // Both maps hold the same voxels, up to single precision
+  constexpr auto tol = 1.0E-6;
+  ASSERT_EQ(compact_map.size(), map.size());
+  for (const auto & vx_it : map) {
+    const auto & cell = compact_map.cell(vx_it.second.centroid());
+    ASSERT_EQ(cell.size(), 1U);
+    EXPECT_TRUE(cell[0U].centroid().isApprox(vx_it.second.centroid(), tol));
+    EXPECT_TRUE(cell[0U].inverse_covariance().isApprox(vx_it.second.inverse_covariance(), tol));
+    // The inversion amplifies the rounding by the condition number of the covariance
+    EXPECT_TRUE(cell[0U].get().covariance().isApprox(vx_it.second.covariance(), 1.0E-4));
+  }
+
+  // Tiles build up the map, and eviction removes the same voxels
+  DynamicNDTMap::Tiles tiles;
+  dynamic_map.serialize_tiles_as<CompactStaticNDTMap>(2.0, tiles);
+  CompactStaticNDTMap tiled_map;
+  for (const auto & tile : tiles) {
+    tiled_map.insert(tile.second);
+  }
+  ASSERT_EQ(tiled_map.size(), map.size());
+  constexpr auto radius = 3.0;
+  EXPECT_EQ(tiled_map.evict(0.0, 0.0, radius), map.evict(0.0, 0.0, radius));
+  EXPECT_EQ(tiled_map.size(), map.size());
+
+  CompactStaticNDTVoxel empty_voxel;
+  EXPECT_FALSE(empty_voxel.usable());
+  EXPECT_THROW(empty_voxel.centroid(), std::out_of_range);
+  EXPECT_THROW(empty_voxel.inverse_covariance(), std::out_of_range);
+}
+
 
 ///////////////////////////// Function definitions:
 
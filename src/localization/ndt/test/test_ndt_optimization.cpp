@@ -29,6 +29,7 @@ using autoware::common::types::float64_t;
 using autoware::localization::ndt::P2DNDTScan;
 using autoware::localization::ndt::P2DNDTOptimizationProblem;
 using autoware::localization::ndt::P2DNDTOptimizationConfig;
+using autoware::localization::ndt::EvaluationPrecision;
 using autoware::localization::ndt::transform_adapters::pose_to_transform;
 
 using P2DProblem = P2DNDTOptimizationProblem<autoware::localization::ndt::StaticNDTMap>;
@@ -122,6 +123,102 @@ TEST_P(P2DOptimizationNumericalTest, NumericalAnalysis) {
     }
   }
 }
+
+/// @test       Evaluating the objective on multiple threads only changes the order of summation.
+TEST_P(P2DOptimizationNumericalTest, ParallelEvaluation) {
+  P2DNDTScan matching_scan(m_downsampled_cloud, m_downsampled_cloud.width);
+  P2DProblem serial_problem{matching_scan, m_static_map, P2DNDTOptimizationConfig{0.55}};
+  const EigenPose<Real> pose = GetParam().diff;
+  const autoware::common::optimization::ComputeMode mode{true, true, true};
+  serial_problem.evaluate(pose, mode);
+  P2DProblem::Jacobian serial_jacobian;
+  P2DProblem::Hessian serial_hessian;
+  serial_problem.jacobian(pose, serial_jacobian);
+  serial_problem.hessian(pose, serial_hessian);
+  const auto serial_score = serial_problem(pose);
+
+  // More threads than points are capped to the number of points
+  const std::size_t num_points = matching_scan.size();
+  for (const std::size_t num_threads : {std::size_t{2U}, std::size_t{3U}, num_points + 1U}) {
+    const P2DNDTOptimizationConfig config{0.55, static_cast<uint32_t>(num_threads)};
+    EXPECT_EQ(config.num_threads(), num_threads);
+    P2DProblem problem{matching_scan, m_static_map, config};
+    problem.evaluate(pose, mode);
+    P2DProblem::Jacobian jacobian;
+    P2DProblem::Hessian hessian;
+    problem.jacobian(pose, jacobian);
+    problem.hessian(pose, hessian);
+
+    constexpr auto eps = 1e-9;
+    EXPECT_NEAR(problem(pose), serial_score, eps * (1.0 + std::fabs(serial_score)));
+    EXPECT_TRUE((jacobian - serial_jacobian).isZero(eps * (1.0 + serial_jacobian.norm())));
+    EXPECT_TRUE((hessian - serial_hessian).isZero(eps * (1.0 + serial_hessian.norm())));
+  }
+  EXPECT_EQ(P2DNDTOptimizationConfig(0.55, 0U).num_threads(), 1U);
+  // The threads are started once by the config and shared by its copies
+  EXPECT_EQ(P2DNDTOptimizationConfig(0.55).workers(), nullptr);
+  const P2DNDTOptimizationConfig config{0.55, 2U};
+  const auto config_copy = config;
+  ASSERT_NE(config.workers(), nullptr);
+  EXPECT_EQ(config.workers()->get_num_workers(), 2U);
+  EXPECT_EQ(config_copy.workers(), config.workers());
+}
+
+/// @test       Each neighbour adds a term of the same sign to the score of a point.
+TEST_P(P2DOptimizationNumericalTest, NeighbourLookup) {
+  using autoware::localization::ndt::VoxelLookup;
+  P2DNDTScan matching_scan(m_downsampled_cloud, m_downsampled_cloud.width);
+  const EigenPose<Real> pose = GetParam().diff;
+  const autoware::common::optimization::ComputeMode mode{true, false, false};
+  const auto score = [&](const VoxelLookup lookup) {
+      P2DProblem problem{matching_scan, m_static_map, P2DNDTOptimizationConfig{0.55, 1U, lookup}};
+      problem.evaluate(pose, mode);
+      return std::fabs(problem(pose));
+    };
+  const auto score1 = score(VoxelLookup::DIRECT1);
+  const auto score7 = score(VoxelLookup::DIRECT7);
+  EXPECT_LE(score1, score7);
+  EXPECT_LE(score7, score(VoxelLookup::DIRECT27));
+  EXPECT_EQ(P2DNDTOptimizationConfig(0.55).lookup(), VoxelLookup::DIRECT1);
+}
+
+/// @test       The single precision evaluation only differs from the double precision one by
+///             rounding, also when the scan is split across threads.
+TEST_P(P2DOptimizationNumericalTest, SinglePrecisionEvaluation) {
+  using autoware::localization::ndt::VoxelLookup;
+  P2DNDTScan matching_scan(m_downsampled_cloud, m_downsampled_cloud.width);
+  const EigenPose<Real> pose = GetParam().diff;
+  const autoware::common::optimization::ComputeMode mode{true, true, true};
+  for (const auto lookup : {VoxelLookup::DIRECT1, VoxelLookup::DIRECT7}) {
+    P2DProblem double_problem{
+      matching_scan, m_static_map, P2DNDTOptimizationConfig{0.55, 1U, lookup}};
+    double_problem.evaluate(pose, mode);
+    P2DProblem::Jacobian double_jacobian;
+    P2DProblem::Hessian double_hessian;
+    double_problem.jacobian(pose, double_jacobian);
+    double_problem.hessian(pose, double_hessian);
+    const auto double_score = double_problem(pose);
+
+    for (const uint32_t num_threads : {1U, 3U}) {
+      const P2DNDTOptimizationConfig config{
+        0.55, num_threads, lookup, EvaluationPrecision::FLOAT32};
+      EXPECT_EQ(config.precision(), EvaluationPrecision::FLOAT32);
+      P2DProblem problem{matching_scan, m_static_map, config};
+      problem.evaluate(pose, mode);
+      P2DProblem::Jacobian jacobian;
+      P2DProblem::Hessian hessian;
+      problem.jacobian(pose, jacobian);
+      problem.hessian(pose, hessian);
+
+      constexpr auto eps = 1e-4;
+      EXPECT_NEAR(problem(pose), double_score, eps * (1.0 + std::fabs(double_score)));
+      EXPECT_TRUE((jacobian - double_jacobian).isZero(eps * (1.0 + double_jacobian.norm())));
+      EXPECT_TRUE((hessian - double_hessian).isZero(eps * (1.0 + double_hessian.norm())));
+    }
+  }
+  EXPECT_EQ(P2DNDTOptimizationConfig(0.55).precision(), EvaluationPrecision::FLOAT64);
+}
+
 /// @test       The shape is fitting exactly into a single voxel. Its copy is moved in different
 ///             directions and aligned with the original.
 TEST_P(AlignmentXyzTest, AlignShapesWithinOneVoxel) {
@@ -178,37 +275,42 @@ TEST_P(AlignmentXyzTest, AlignShapesWithinOneVoxel) {
   auto translated_cloud = initial_point_cloud;
   tf2::doTransform(initial_point_cloud, translated_cloud, diff_tf2);
 
-  P2DProblem::DomainValue guess = P2DProblem::DomainValue::Zero();
   const auto step_length = 0.1F;
   const auto num_iters = 100U;
   P2DNDTScan scan{translated_cloud, translated_cloud.width};
   // TODO(#1062): we have no outliers here, but setting this to 0.0 fails the test. Investigate.
   const auto dummy_outlier_ratio = 0.01F;
-  P2DProblem problem{scan, static_map, P2DNDTOptimizationConfig{dummy_outlier_ratio}};
+  // Both precisions should converge to the same pose
+  for (const auto precision : {EvaluationPrecision::FLOAT64, EvaluationPrecision::FLOAT32}) {
+    P2DProblem::DomainValue guess = P2DProblem::DomainValue::Zero();
+    P2DProblem problem{
+      scan, static_map, P2DNDTOptimizationConfig{dummy_outlier_ratio, 1U,
+        autoware::localization::ndt::VoxelLookup::DIRECT1, precision}};
 
-  for (auto i = 0U; i < num_iters; ++i) {
-    problem.evaluate(
-      guess,
-      autoware::common::optimization::ComputeMode{}.set_score().set_jacobian()
-      .set_hessian());
-    P2DProblem::Jacobian jacobian;
-    P2DProblem::Hessian hessian;
-    problem.jacobian(guess, jacobian);
-    problem.hessian(guess, hessian);
-    P2DProblem::DomainValue delta = hessian.ldlt().solve(-jacobian);
-    guess += step_length * delta;
-    auto guess_cloud = translated_cloud;
-    pose_to_transform(guess, diff_tf2.transform);
-    tf2::doTransform(translated_cloud, guess_cloud, diff_tf2);
-  }
+    for (auto i = 0U; i < num_iters; ++i) {
+      problem.evaluate(
+        guess,
+        autoware::common::optimization::ComputeMode{}.set_score().set_jacobian()
+        .set_hessian());
+      P2DProblem::Jacobian jacobian;
+      P2DProblem::Hessian hessian;
+      problem.jacobian(guess, jacobian);
+      problem.hessian(guess, hessian);
+      P2DProblem::DomainValue delta = hessian.ldlt().solve(-jacobian);
+      guess += step_length * delta;
+      auto guess_cloud = translated_cloud;
+      pose_to_transform(guess, diff_tf2.transform);
+      tf2::doTransform(translated_cloud, guess_cloud, diff_tf2);
+    }
 
-  const auto found_diff = P2DProblem::DomainValue{-guess};
-  for (int i = 0; i < found_diff.size(); ++i) {
-    EXPECT_NEAR(found_diff[i], diff[i], kPoseEpsilon) << "Not matching at index " << i;
+    const auto found_diff = P2DProblem::DomainValue{-guess};
+    for (int i = 0; i < found_diff.size(); ++i) {
+      EXPECT_NEAR(found_diff[i], diff[i], kPoseEpsilon) << "Not matching at index " << i <<
+        " with precision " << static_cast<int>(precision);
+    }
   }
 }
 
-
 // TODO(#1063): when these parameters are picked bigger the tests fail. We need to investigate why.
 INSTANTIATE_TEST_CASE_P(
   AlignmentXyzTest, AlignmentXyzTest,
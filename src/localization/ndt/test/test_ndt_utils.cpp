@@ -16,7 +16,10 @@
 
 #include <gtest/gtest.h>
 #include <ndt/utils.hpp>
+#include <ndt/ndt_kernels.hpp>
 #include <Eigen/Core>
+#include <cmath>
+#include <limits>
 #include <random>
 #include <vector>
 #include <algorithm>
@@ -178,3 +181,41 @@ INSTANTIATE_TEST_CASE_P(
     Cov3x3Param(1e-2, 1e-3, 1e-15, true)
     // cppcheck-suppress syntaxError
   ), );
+
+/// @test       The vectorizable exponential matches std::exp over its range, and the batch of
+///             residuals evaluates the gaussians of the Mahalanobis distances.
+TEST(NDTKernelsTest, FastExp) {
+  using autoware::localization::ndt::fast_exp;
+  using autoware::localization::ndt::kFastExpMax;
+  using autoware::localization::ndt::kFastExpMin;
+  for (float x = kFastExpMin; x < kFastExpMax; x += 0.01F) {
+    const double expected = std::exp(static_cast<double>(x));
+    EXPECT_NEAR(static_cast<double>(fast_exp(x)), expected, 2e-7 * expected) << "x = " << x;
+  }
+
+  autoware::localization::ndt::MahalanobisBatch batch;
+  Eigen::Matrix3d inv_cov;
+  inv_cov << 2.0, 0.1, 0.2,
+    0.1, 3.0, 0.3,
+    0.2, 0.3, 4.0;
+  std::vector<Eigen::Vector3d> residuals;
+  // Include residuals whose exponent is below the range of fast_exp
+  for (auto i = 0; i < 50; ++i) {
+    residuals.emplace_back(0.5 * i, -0.2 * i, 0.1 * i);
+    batch.push_back(residuals.back(), inv_cov);
+  }
+  ASSERT_EQ(batch.size(), residuals.size());
+  batch.evaluate_gaussians(0.5F);
+  for (std::size_t i = 0U; i < residuals.size(); ++i) {
+    const auto expected = std::exp(-0.5 * residuals[i].dot(inv_cov * residuals[i]));
+    // The exponent itself is rounded to single precision, so the relative error grows with it.
+    // Exponents below the range of fast_exp give e^kFastExpMin, close to the smallest normal float.
+    EXPECT_NEAR(
+      static_cast<double>(batch.gaussian(i)), expected,
+      1e-5 * expected + 2.0 * static_cast<double>(std::numeric_limits<float>::min()));
+    EXPECT_TRUE(batch.residual(i).isApprox(residuals[i], 1e-6));
+    EXPECT_TRUE(batch.inverse_covariance(i).isApprox(inv_cov, 1e-6));
+  }
+  batch.clear();
+  EXPECT_EQ(batch.size(), 0U);
+}
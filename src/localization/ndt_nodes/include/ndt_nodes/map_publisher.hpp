@@ -21,15 +21,19 @@
 #include <ndt/ndt_map_publisher.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <ndt/ndt_map.hpp>
+#include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <tf2_msgs/msg/tf_message.hpp>
 #include <tf2_ros/static_transform_broadcaster.h>
 #include <voxel_grid_nodes/algorithm/voxel_cloud_centroid.hpp>
 #include <string>
 #include <memory>
+#include <set>
+#include <vector>
 #include "common/types.hpp"
 
 using autoware::common::types::bool8_t;
+using autoware::common::types::float32_t;
 using autoware::common::types::float64_t;
 
 namespace autoware
@@ -47,6 +51,7 @@ public:
   using SerializedMap = ndt::StaticNDTMap;
   using MapConfig = perception::filters::voxel_grid::Config;
   using VoxelGrid = perception::filters::voxel_grid_nodes::algorithm::VoxelCloudCentroid;
+  using PoseWithCovarianceStamped = geometry_msgs::msg::PoseWithCovarianceStamped;
   /// \brief Parameter constructor
   /// \param node_options Additional options to control creation of the node.
   explicit NDTMapPublisherNode(
@@ -57,8 +62,14 @@ public:
   /// 1. Wait until the map publisher matches the configured number of subscribers. If the
   /// configured timeout occurs, it throws an exception.
   /// 2. Load the PCD file into a PointCloud2 message.
-  /// 3. Apply the normal distribution transform loaded PointCloud2 message.
-  /// 4. Convert the resulting map representation into a `PointCloud2` message and publish.
+  /// 3. Apply the normal distribution transform loaded PointCloud2 message, at each configured
+  /// coarse voxel size and at the map voxel size.
+  /// 4. Convert the resulting map representations into `PointCloud2` messages and publish them,
+  /// from the coarsest to the finest. If the map is streamed, it is split into tiles instead, and
+  /// the tiles around the initial position and later around each received pose are published.
+  ///
+  /// If a map cache file is configured, the serialized map is read from it instead of steps 2 and
+  /// 3, or written to it if it could not be read.
   void run();
 
 private:
@@ -74,10 +85,23 @@ private:
 
   void publish_earth_to_map_transform(ndt::geocentric_pose_t pose);
 
+  /// Compute the ndt maps from the loaded point cloud and serialize them.
+  void build_map();
+
+  /// Read the serialized map from the map cache file.
+  /// \return False if the file could not be read.
+  bool8_t read_map_cache();
+
   /// Publish the loaded map file. If no new map is loaded, it will publish the
   /// previous map, or an empty map.
   void publish();
 
+  /// Publish the tiles within the streaming radius of a location which were not published since
+  /// they came in range, from the coarsest to the finest resolution.
+  /// \param x x coordinate of the location in the map frame
+  /// \param y y coordinate of the location in the map frame
+  void publish_tiles(float64_t x, float64_t y);
+
   /// Reset the internal point clouds and the ndt map.
   void reset();
 
@@ -88,10 +112,23 @@ private:
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr m_pub;
   std::unique_ptr<ndt::DynamicNDTMap> m_ndt_map_ptr;
   sensor_msgs::msg::PointCloud2 m_map_pc;
+  // Coarser resolutions of the map, published before the map itself, coarsest first
+  std::vector<float32_t> m_coarse_voxel_sizes;
+  std::vector<sensor_msgs::msg::PointCloud2> m_coarse_map_pcs;
+  // Tiles of each resolution of the map, coarsest first, if the map is streamed
+  float64_t m_tile_size{0.0};
+  float64_t m_tile_radius{0.0};
+  float64_t m_tile_initial_x{0.0};
+  float64_t m_tile_initial_y{0.0};
+  std::vector<ndt::DynamicNDTMap::Tiles> m_map_tiles;
+  std::vector<std::set<ndt::TileIndex>> m_published_tiles;
+  rclcpp::Subscription<PoseWithCovarianceStamped>::SharedPtr m_pose_sub;
+  rclcpp::Subscription<PoseWithCovarianceStamped>::SharedPtr m_initial_pose_sub;
   sensor_msgs::msg::PointCloud2 m_source_pc;
   sensor_msgs::msg::PointCloud2 m_downsampled_pc;
   const std::string m_pcl_file_name;
   const std::string m_yaml_file_name;
+  const std::string m_map_cache_file;
   const bool8_t m_viz_map;
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr m_viz_pub;
   std::unique_ptr<MapConfig> m_map_config_ptr;
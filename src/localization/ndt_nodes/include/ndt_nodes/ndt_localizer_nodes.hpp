@@ -21,14 +21,20 @@
 #include <ndt_nodes/visibility_control.hpp>
 #include <ndt/ndt_localizer.hpp>
 #include <localization_nodes/localization_node.hpp>
+#include <nav_msgs/msg/odometry.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <optimization/newtons_method_optimizer.hpp>
 #include <optimization/line_search/more_thuente_line_search.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <experimental/optional>
+#include <algorithm>
 #include <utility>
 #include <string>
 #include <memory>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept>
 
 using autoware::common::types::float32_t;
 using autoware::common::types::float64_t;
@@ -44,27 +50,33 @@ namespace ndt_nodes
 // TODO(yunus.caliskan) remove the hard-coded optimizer set up and make it fully configurable
 using Optimizer_ =
   common::optimization::NewtonsMethodOptimizer<common::optimization::MoreThuenteLineSearch>;
-using PoseInitializer_ = localization_common::BestEffortInitializer;
+// Uses the latest transform unless it is given state estimates to predict from
+using PoseInitializer_ = localization_common::MotionModelInitializer;
 
 /// P2D NDT localizer node. Currently uses the hard coded optimizer and pose initializers.
 /// \tparam OptimizerT Hard coded for Newton optimizer. TODO(yunus.caliskan): Make Configurable
 /// \tparam PoseInitializerT Hard coded for Best effort. TODO(yunus.caliskan): Make Configurable
-template<typename OptimizerT = Optimizer_, typename PoseInitializerT = PoseInitializer_>
+/// \tparam MapT Map type of a resolution, `ndt::StaticNDTMap` or `ndt::CompactStaticNDTMap` for
+/// maps too large for the memory otherwise.
+template<typename OptimizerT = Optimizer_, typename PoseInitializerT = PoseInitializer_,
+  typename MapT = ndt::StaticNDTMap>
 class NDT_NODES_PUBLIC P2DNDTLocalizerNode
   : public localization_nodes::RelativeLocalizerNode<
     sensor_msgs::msg::PointCloud2,
     sensor_msgs::msg::PointCloud2,
-    ndt::StaticNDTMap,
-    ndt::P2DNDTLocalizer<OptimizerT>,
+    ndt::NDTMapPyramid<MapT>,
+    ndt::P2DNDTLocalizer<OptimizerT, MapT>,
     PoseInitializerT>
 {
 public:
-  using Localizer = ndt::P2DNDTLocalizer<OptimizerT>;
+  // Maps of one or more resolutions, registered from coarse to fine
+  using Map_ = ndt::NDTMapPyramid<MapT>;
+  using Localizer = ndt::P2DNDTLocalizer<OptimizerT, MapT>;
   using RegistrationSummary = localization_common::OptimizedRegistrationSummary;
   using ParentT = localization_nodes::RelativeLocalizerNode<
     sensor_msgs::msg::PointCloud2,
     sensor_msgs::msg::PointCloud2,
-    ndt::StaticNDTMap,
+    Map_,
     Localizer,
     PoseInitializerT>;
   using PoseWithCovarianceStamped = typename Localizer::PoseWithCovarianceStamped;
@@ -105,6 +117,12 @@ public:
     init();
   }
 
+  ~P2DNDTLocalizerNode() override
+  {
+    // The registration thread of the pipelined mode calls the overrides below.
+    this->stop_pipeline();
+  }
+
 protected:
   bool validate_output(
     const RegistrationSummary & summary,
@@ -133,6 +151,49 @@ protected:
     return ret;
   }
 
+  void on_observation(
+    const sensor_msgs::msg::PointCloud2 & msg, Localizer & localizer, const Map_ & map,
+    PoseInitializerT & pose_initializer) override
+  {
+    std::experimental::optional<Transform> coarse_fix;
+    {
+      std::lock_guard<std::mutex> lock{m_coarse_fix_mutex};
+      std::swap(coarse_fix, m_coarse_fix);
+    }
+    if (!coarse_fix) {
+      return;
+    }
+    if (coarse_fix->header.frame_id != map.frame_id()) {
+      RCLCPP_ERROR(
+        this->get_logger(), "Coarse position fix should be in the %s frame, got %s. Failed to "
+        "initialize globally.", map.frame_id().c_str(), coarse_fix->header.frame_id.c_str());
+      return;
+    }
+    try {
+      const auto pose = localizer.register_globally(msg, *coarse_fix, map, *m_global_config);
+      // Served like an initial pose given by hand, i.e. unless there is a transform to predict
+      // from, and the observation is registered from it as usual.
+      Transform fallback_pose;
+      fallback_pose.header = pose.header;
+      fallback_pose.child_frame_id = "base_link";
+      fallback_pose.transform.rotation = pose.pose.pose.orientation;
+      fallback_pose.transform.translation.x = pose.pose.pose.position.x;
+      fallback_pose.transform.translation.y = pose.pose.pose.position.y;
+      fallback_pose.transform.translation.z = pose.pose.pose.position.z;
+      pose_initializer.set_fallback_pose(fallback_pose);
+    } catch (const std::exception & e) {
+      RCLCPP_ERROR(this->get_logger(), "Failed to initialize globally: %s", e.what());
+    }
+  }
+
+  void on_valid_output(const PoseWithCovarianceStamped & pose, Map_ & map) override
+  {
+    // Drop the tiles of a streamed map which were left behind
+    if (m_map_eviction_radius > 0.0) {
+      (void) map.evict(pose.pose.pose.position.x, pose.pose.pose.position.y, m_map_eviction_radius);
+    }
+  }
+
 private:
   virtual bool on_non_convergence(
     const RegistrationSummary &,
@@ -183,13 +244,37 @@ private:
 
   void init()
   {
+    const std::map<std::string, ndt::VoxelLookup> voxel_lookups{
+      {"DIRECT1", ndt::VoxelLookup::DIRECT1},
+      {"DIRECT7", ndt::VoxelLookup::DIRECT7},
+      {"DIRECT27", ndt::VoxelLookup::DIRECT27}};
+    const auto voxel_lookup = voxel_lookups.find(
+      this->declare_parameter("localizer.optimization.voxel_lookup", std::string{"DIRECT1"}));
+    if (voxel_lookup == voxel_lookups.end()) {
+      throw std::domain_error(
+              "localizer.optimization.voxel_lookup should be one of DIRECT1, DIRECT7 or DIRECT27.");
+    }
+    const std::map<std::string, ndt::EvaluationPrecision> precisions{
+      {"FLOAT64", ndt::EvaluationPrecision::FLOAT64},
+      {"FLOAT32", ndt::EvaluationPrecision::FLOAT32}};
+    const auto precision = precisions.find(
+      this->declare_parameter("localizer.optimization.precision", std::string{"FLOAT64"}));
+    if (precision == precisions.end()) {
+      throw std::domain_error("localizer.optimization.precision should be FLOAT64 or FLOAT32.");
+    }
+
     // Fetch localizer configuration
     ndt::P2DNDTLocalizerConfig localizer_config{
       static_cast<uint32_t>(this->declare_parameter("localizer.scan.capacity").
       template get<uint32_t>()),
       std::chrono::milliseconds(
         static_cast<uint64_t>(
-          this->declare_parameter("localizer.guess_time_tolerance_ms").template get<uint64_t>()))
+          this->declare_parameter("localizer.guess_time_tolerance_ms").template get<uint64_t>())),
+      static_cast<uint32_t>(
+        std::max(this->declare_parameter("localizer.optimization.num_threads", 1), 1)),
+      voxel_lookup->second,
+      this->declare_parameter("localizer.optimizer.score_tolerance_per_point", 0.0),
+      precision->second
     };
 
     const auto outlier_ratio{this->declare_parameter(
@@ -221,7 +306,48 @@ private:
             optimizer_options
           },
       outlier_ratio);
-    auto map_ptr = std::make_unique<ndt::StaticNDTMap>();
+    auto map_ptr = std::make_unique<Map_>(
+      static_cast<std::size_t>(
+        std::max(this->declare_parameter("map_sub.max_num_levels", 1), 1)));
+    m_map_eviction_radius = this->declare_parameter("map_sub.eviction_radius", 0.0);
+
+    if (this->declare_parameter("initial_guess.use_state_estimate", false)) {
+      m_state_estimate_sub = this->template create_subscription<nav_msgs::msg::Odometry>(
+        "state_estimate",
+        rclcpp::QoS{rclcpp::KeepLast{
+            static_cast<size_t>(this->declare_parameter("initial_guess.history_depth", 10))}},
+        [this](const nav_msgs::msg::Odometry::ConstSharedPtr msg) {
+          this->modify_pose_initializer(
+            [&msg](PoseInitializerT & initializer) {initializer.set_state_estimate(*msg);});
+        });
+    }
+
+    // Initialize around the positions on `coarse_fix`, e.g. of a GNSS receiver in the map frame,
+    // instead of waiting for an initial pose given by hand.
+    if (this->declare_parameter("global_initialization.enabled", false)) {
+      m_global_config.emplace(
+        this->declare_parameter("global_initialization.position_range", 2.0),
+        this->declare_parameter("global_initialization.position_step", 1.0),
+        static_cast<uint32_t>(
+          std::max(this->declare_parameter("global_initialization.num_yaw_bins", 12), 1)),
+        static_cast<uint32_t>(
+          std::max(this->declare_parameter("global_initialization.num_kept_candidates", 8), 1)),
+        static_cast<uint32_t>(
+          std::max(this->declare_parameter("global_initialization.num_threads", 1), 1)));
+      m_coarse_fix_sub = this->template create_subscription<PoseWithCovarianceStamped>(
+        "coarse_fix", rclcpp::QoS{rclcpp::KeepLast{1U}},
+        [this](const typename PoseWithCovarianceStamped::ConstSharedPtr msg) {
+          Transform coarse_fix;
+          coarse_fix.header = msg->header;
+          coarse_fix.child_frame_id = "base_link";
+          coarse_fix.transform.rotation = msg->pose.pose.orientation;
+          coarse_fix.transform.translation.x = msg->pose.pose.position.x;
+          coarse_fix.transform.translation.y = msg->pose.pose.position.y;
+          coarse_fix.transform.translation.z = msg->pose.pose.position.z;
+          std::lock_guard<std::mutex> lock{m_coarse_fix_mutex};
+          m_coarse_fix = coarse_fix;
+        });
+    }
 
     this->set_localizer(std::move(localizer_ptr));
     this->set_map(std::move(map_ptr));
@@ -229,6 +355,13 @@ private:
 
   ndt::Real m_predict_translation_threshold;
   ndt::Real m_predict_rotation_threshold;
+  ndt::Real m_map_eviction_radius{0.0};
+  typename rclcpp::Subscription<nav_msgs::msg::Odometry>::SharedPtr m_state_estimate_sub{};
+  std::experimental::optional<ndt::GlobalInitializationConfig> m_global_config{};
+  typename rclcpp::Subscription<PoseWithCovarianceStamped>::SharedPtr m_coarse_fix_sub{};
+  // Guards the latest coarse fix, which is used by the next observation only.
+  std::mutex m_coarse_fix_mutex;
+  std::experimental::optional<Transform> m_coarse_fix{};
 };
 }  // namespace ndt_nodes
 }  // namespace localization
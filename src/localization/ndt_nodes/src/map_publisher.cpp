@@ -21,8 +21,13 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <tf2/LinearMath/Quaternion.h>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 using autoware::common::types::bool8_t;
 using autoware::common::types::float32_t;
@@ -47,6 +52,7 @@ NDTMapPublisherNode::NDTMapPublisherNode(
 : Node("ndt_map_publisher_node", node_options),
   m_pcl_file_name(declare_parameter("map_pcd_file").get<std::string>()),
   m_yaml_file_name(declare_parameter("map_yaml_file").get<std::string>()),
+  m_map_cache_file(declare_parameter("map_cache_file", std::string{})),
   m_viz_map(declare_parameter("viz_map", false))
 {
   using PointXYZ = perception::filters::voxel_grid::PointXYZ;
@@ -73,6 +79,37 @@ NDTMapPublisherNode::NDTMapPublisherNode(
     static_cast<float32_t>(declare_parameter("map_config.voxel_size.z").get<float32_t>());
   const std::size_t capacity =
     static_cast<std::size_t>(declare_parameter("map_config.capacity").get<std::size_t>());
+  // Optional coarser resolutions of the map, to register scans coarse to fine
+  const float32_t min_coarse_voxel_size = std::max({voxel_size.x, voxel_size.y, voxel_size.z});
+  for (const auto size :
+    declare_parameter("map_config.pyramid_voxel_sizes", std::vector<float64_t>{}))
+  {
+    if (!(static_cast<float32_t>(size) > min_coarse_voxel_size)) {
+      throw std::domain_error(
+              "NDTMapPublisherNode: Pyramid voxel sizes should be larger than the map voxel size.");
+    }
+    m_coarse_voxel_sizes.push_back(static_cast<float32_t>(size));
+  }
+  std::sort(m_coarse_voxel_sizes.begin(), m_coarse_voxel_sizes.end(), std::greater<float32_t>{});
+  m_coarse_voxel_sizes.erase(
+    std::unique(m_coarse_voxel_sizes.begin(), m_coarse_voxel_sizes.end()),
+    m_coarse_voxel_sizes.end());
+  // Optional streaming of the map as tiles around the vehicle
+  m_tile_size = declare_parameter("map_config.tile_size", 0.0);
+  if (m_tile_size > 0.0) {
+    m_tile_radius = declare_parameter("tile_streaming.radius").get<float64_t>();
+    if (!(m_tile_radius > 0.0)) {
+      throw std::domain_error("NDTMapPublisherNode: The tile streaming radius should be positive.");
+    }
+    m_tile_initial_x = declare_parameter("tile_streaming.initial_position.x", 0.0);
+    m_tile_initial_y = declare_parameter("tile_streaming.initial_position.y", 0.0);
+  }
+  // The map cache only holds the map at its voxel size
+  if (!m_map_cache_file.empty() && (!m_coarse_voxel_sizes.empty() || (m_tile_size > 0.0))) {
+    throw std::domain_error(
+            "NDTMapPublisherNode: The map cache can not be used with pyramid voxel sizes or "
+            "tiles.");
+  }
   const std::string map_frame = declare_parameter("map_frame").get<std::string>();
   const std::string map_topic = "ndt_map";
   const std::string viz_map_topic = "viz_ndt_map";
@@ -93,9 +130,27 @@ void NDTMapPublisherNode::init(
   point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> initializer{
     m_source_pc, map_frame};
 
+  // All the tiles in range of a pose may be published at once
+  std::size_t history_depth = 5U;
+  if (m_tile_size > 0.0) {
+    const auto tiles_per_axis =
+      static_cast<std::size_t>(std::ceil((2.0 * m_tile_radius) / m_tile_size)) + 1U;
+    history_depth = std::max(
+      history_depth, tiles_per_axis * tiles_per_axis * (m_coarse_voxel_sizes.size() + 1U));
+  }
   m_pub = create_publisher<sensor_msgs::msg::PointCloud2>(
     map_topic,
-    rclcpp::QoS(rclcpp::KeepLast(5U)).transient_local());
+    rclcpp::QoS(rclcpp::KeepLast(history_depth)).transient_local());
+
+  if (m_tile_size > 0.0) {
+    const auto pose_callback = [this](const PoseWithCovarianceStamped::ConstSharedPtr msg) {
+        publish_tiles(msg->pose.pose.position.x, msg->pose.pose.position.y);
+      };
+    m_pose_sub = create_subscription<PoseWithCovarianceStamped>(
+      "ndt_pose", rclcpp::QoS{rclcpp::KeepLast{1U}}, pose_callback);
+    m_initial_pose_sub = create_subscription<PoseWithCovarianceStamped>(
+      "initialpose", rclcpp::QoS{rclcpp::KeepLast{10U}}, pose_callback);
+  }
 
   if (m_viz_map) {   // create a publisher for map_visualization
     using PointXYZ = perception::filters::voxel_grid::PointXYZ;
@@ -139,16 +194,78 @@ void NDTMapPublisherNode::init(
 
 void NDTMapPublisherNode::run()
 {
-  ndt::geocentric_pose_t pose = ndt::load_map(m_yaml_file_name, m_pcl_file_name, m_source_pc);
+  const bool8_t map_from_cache = !m_map_cache_file.empty() && read_map_cache();
+  ndt::geocentric_pose_t pose = map_from_cache ?
+    ndt::load_map_origin(m_yaml_file_name) :
+    ndt::load_map(m_yaml_file_name, m_pcl_file_name, m_source_pc);
   publish_earth_to_map_transform(pose);
-  m_ndt_map_ptr->insert(m_source_pc);
-  m_ndt_map_ptr->serialize_as<SerializedMap>(m_map_pc);
+
+  if (map_from_cache) {
+    if (m_viz_map) {
+      ndt::read_from_pcd(m_pcl_file_name, &m_source_pc);
+    }
+  } else {
+    build_map();
+    if (!m_map_cache_file.empty()) {
+      try {
+        ndt::write_map_cache(m_map_cache_file, m_map_pc);
+      } catch (const std::runtime_error & e) {
+        RCLCPP_WARN(get_logger(), e.what());
+      }
+    }
+  }
 
   if (m_viz_map) {
     reset_pc_msg(m_downsampled_pc);
     downsample_pc();
   }
   publish();
+  if (m_tile_size > 0.0) {
+    publish_tiles(m_tile_initial_x, m_tile_initial_y);
+  }
+}
+
+bool8_t NDTMapPublisherNode::read_map_cache()
+{
+  try {
+    ndt::read_map_cache(m_map_cache_file, m_map_pc);
+  } catch (const std::runtime_error & e) {
+    RCLCPP_WARN(get_logger(), (std::string{e.what()} + " Building the map instead.").c_str());
+    return false;
+  }
+  return true;
+}
+
+void NDTMapPublisherNode::build_map()
+{
+  const bool8_t stream_tiles = m_tile_size > 0.0;
+  m_ndt_map_ptr->insert(m_source_pc);
+  if (stream_tiles) {
+    m_map_tiles.resize(m_coarse_voxel_sizes.size() + 1U);
+    m_published_tiles.assign(m_map_tiles.size(), {});
+    m_ndt_map_ptr->serialize_tiles_as<SerializedMap>(m_tile_size, m_map_tiles.back());
+  } else {
+    m_ndt_map_ptr->serialize_as<SerializedMap>(m_map_pc);
+    m_coarse_map_pcs.resize(m_coarse_voxel_sizes.size());
+  }
+
+  for (std::size_t level = 0U; level < m_coarse_voxel_sizes.size(); ++level) {
+    perception::filters::voxel_grid::PointXYZ voxel_size;
+    voxel_size.x = m_coarse_voxel_sizes[level];
+    voxel_size.y = m_coarse_voxel_sizes[level];
+    voxel_size.z = m_coarse_voxel_sizes[level];
+    ndt::DynamicNDTMap coarse_map{MapConfig{
+        m_map_config_ptr->get_min_point(),
+        m_map_config_ptr->get_max_point(),
+        voxel_size,
+        m_map_config_ptr->get_capacity()}};
+    coarse_map.insert(m_source_pc);
+    if (stream_tiles) {
+      coarse_map.serialize_tiles_as<SerializedMap>(m_tile_size, m_map_tiles[level]);
+    } else {
+      coarse_map.serialize_as<SerializedMap>(m_coarse_map_pcs[level]);
+    }
+  }
 }
 
 void NDTMapPublisherNode::publish_earth_to_map_transform(ndt::geocentric_pose_t pose)
@@ -196,15 +313,46 @@ void NDTMapPublisherNode::downsample_pc()
 
 void NDTMapPublisherNode::publish()
 {
+  // Subscribers which keep fewer messages than there are resolutions still get the finest one
+  for (const auto & coarse_map_pc : m_coarse_map_pcs) {
+    if (coarse_map_pc.width > 0U) {
+      m_pub->publish(coarse_map_pc);
+    }
+  }
   if (m_map_pc.width > 0U) {
     m_pub->publish(m_map_pc);
   }
 }
 
+void NDTMapPublisherNode::publish_tiles(const float64_t x, const float64_t y)
+{
+  for (std::size_t level = 0U; level < m_map_tiles.size(); ++level) {
+    auto & published_tiles = m_published_tiles[level];
+    // Forget the tiles out of range, so that they are published again once they are back in range
+    for (auto tile_it = published_tiles.begin(); tile_it != published_tiles.end(); ) {
+      if (ndt::tile_distance(*tile_it, m_tile_size, x, y) > m_tile_radius) {
+        tile_it = published_tiles.erase(tile_it);
+      } else {
+        ++tile_it;
+      }
+    }
+    for (const auto & tile : m_map_tiles[level]) {
+      if ((ndt::tile_distance(tile.first, m_tile_size, x, y) <= m_tile_radius) &&
+        published_tiles.insert(tile.first).second)
+      {
+        m_pub->publish(tile.second);
+      }
+    }
+  }
+}
+
 void NDTMapPublisherNode::reset()
 {
   reset_pc_msg(m_map_pc);
   reset_pc_msg(m_source_pc);
+  m_coarse_map_pcs.clear();
+  m_map_tiles.clear();
+  m_published_tiles.clear();
 
   if (m_viz_map) {
     reset_pc_msg(m_downsampled_pc);
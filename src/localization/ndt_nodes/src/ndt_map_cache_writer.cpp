@@ -0,0 +1,80 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+// Offline tool to write the map cache file of the ndt map publisher, with the parameters the
+// publisher is launched with (see param/map_publisher.param.yaml).
+
+#include <common/types.hpp>
+#include <ndt/ndt_map.hpp>
+#include <ndt/ndt_map_publisher.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+using autoware::common::types::float32_t;
+using autoware::localization::ndt::DynamicNDTMap;
+using autoware::localization::ndt::StaticNDTMap;
+using PointXYZ = autoware::perception::filters::voxel_grid::PointXYZ;
+
+namespace
+{
+PointXYZ read_point(const YAML::Node & node)
+{
+  PointXYZ point;
+  point.x = node["x"].as<float32_t>();
+  point.y = node["y"].as<float32_t>();
+  point.z = node["z"].as<float32_t>();
+  return point;
+}
+}  // namespace
+
+int32_t main(const int32_t argc, char ** const argv)
+{
+  if ((argc != 2) && (argc != 3)) {
+    std::cerr << "Usage: " << argv[0] << " <map_publisher.param.yaml> [<map cache file>]" <<
+      std::endl << "The cache file defaults to the map_cache_file parameter." << std::endl;
+    return 1;
+  }
+  try {
+    const auto params = YAML::LoadFile(argv[1]).begin()->second["ros__parameters"];
+    const auto map_config = params["map_config"];
+    const std::string cache_file =
+      (argc == 3) ? std::string{argv[2]} : params["map_cache_file"].as<std::string>();
+
+    sensor_msgs::msg::PointCloud2 source_pc;
+    autoware::localization::ndt::read_from_pcd(
+      params["map_pcd_file"].as<std::string>(), &source_pc);
+    source_pc.header.frame_id = params["map_frame"].as<std::string>();
+
+    DynamicNDTMap ndt_map{DynamicNDTMap::Config{
+        read_point(map_config["min_point"]),
+        read_point(map_config["max_point"]),
+        read_point(map_config["voxel_size"]),
+        map_config["capacity"].as<uint64_t>()}};
+    ndt_map.insert(source_pc);
+    sensor_msgs::msg::PointCloud2 map_pc;
+    ndt_map.serialize_as<StaticNDTMap>(map_pc);
+    autoware::localization::ndt::write_map_cache(cache_file, map_pc);
+    std::cout << "Wrote " << (map_pc.width - DynamicNDTMap::kNumConfigPoints) <<
+      " voxels to " << cache_file << std::endl;
+  } catch (const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -33,8 +33,24 @@ struct P2DNDTLocalizerNodeComponent
   {
   }
 };
+
+/// Localizer node with the voxels of the map in single precision, to hold larger maps.
+struct P2DNDTLocalizerCompactMapNodeComponent
+  : public autoware::localization::ndt_nodes::P2DNDTLocalizerNode<
+    Optimizer_, PoseInitializer_, ndt::CompactStaticNDTMap>
+{
+  explicit P2DNDTLocalizerCompactMapNodeComponent(const rclcpp::NodeOptions & node_options)
+  : autoware::localization::ndt_nodes::P2DNDTLocalizerNode<
+      Optimizer_, PoseInitializer_, ndt::CompactStaticNDTMap>(
+      "p2d_ndt_localizer_node", node_options,
+      autoware::localization::ndt_nodes::PoseInitializer_{})
+  {
+  }
+};
 }  // namespace ndt_nodes
 }  // namespace localization
 }  // namespace autoware
 
 RCLCPP_COMPONENTS_REGISTER_NODE(autoware::localization::ndt_nodes::P2DNDTLocalizerNodeComponent)
+RCLCPP_COMPONENTS_REGISTER_NODE(
+  autoware::localization::ndt_nodes::P2DNDTLocalizerCompactMapNodeComponent)
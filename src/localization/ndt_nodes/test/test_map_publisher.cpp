@@ -16,10 +16,13 @@
 
 #include <gtest/gtest.h>
 #include <ndt_nodes/map_publisher.hpp>
+#include <ndt/utils.hpp>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
 #include <pcl/io/pcd_io.h>
 #include <yaml-cpp/yaml.h>
 
+#include <fstream>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <string>
@@ -114,6 +117,53 @@ TEST(YamlLoadTest, Basics) {
   remove(test_fname.c_str());
 }
 
+TEST(MapCacheTest, Basics) {
+  using autoware::localization::ndt::NdtMapCloudModifier;
+  using autoware::localization::ndt::NdtMapCloudView;
+  using autoware::localization::ndt::PointWithCovariances;
+  using autoware::localization::ndt::read_map_cache;
+  using autoware::localization::ndt::write_map_cache;
+  const std::string test_fname = "MapCacheTest_test_cache_file.ndtcache";
+  const std::string non_existing_fname = "NON_EXISTING_FILE_MapCacheTest.ndtcache";
+  const std::string invalid_fname = "MapCacheTest_invalid_cache_file.ndtcache";
+
+  sensor_msgs::msg::PointCloud2 map_msg;
+  NdtMapCloudModifier map_modifier{map_msg, "map"};
+  for (auto i = 0U; i < 10U; i++) {
+    const auto value = static_cast<Real>(i);
+    map_modifier.push_back(
+      PointWithCovariances{value, value, value, 1.0, 0.1, 0.2, 2.0, 0.3, 3.0});
+  }
+  map_msg.header.stamp.sec = 5;
+  map_msg.header.stamp.nanosec = 6U;
+
+  EXPECT_NO_THROW(write_map_cache(test_fname, map_msg));
+  sensor_msgs::msg::PointCloud2 cached_msg;
+  EXPECT_THROW(read_map_cache(non_existing_fname, cached_msg), std::runtime_error);
+  ASSERT_NO_THROW(read_map_cache(test_fname, cached_msg));
+
+  EXPECT_EQ(cached_msg.header.frame_id, "map");
+  EXPECT_EQ(cached_msg.header.stamp.sec, 5);
+  EXPECT_EQ(cached_msg.header.stamp.nanosec, 6U);
+  const NdtMapCloudView map_view{map_msg};
+  const NdtMapCloudView cached_view{cached_msg};
+  ASSERT_EQ(cached_view.size(), map_view.size());
+  for (auto i = 0U; i < map_view.size(); i++) {
+    EXPECT_EQ(cached_view[i], map_view[i]);
+  }
+
+  // A truncated file is rejected
+  std::ifstream cache_fin(test_fname, std::ios::binary);
+  const std::string cache_contents{std::istreambuf_iterator<char>{cache_fin}, {}};
+  std::ofstream invalid_fout(invalid_fname, std::ios::binary);
+  invalid_fout << cache_contents.substr(0U, cache_contents.size() - 1U);
+  invalid_fout.close();
+  EXPECT_THROW(read_map_cache(invalid_fname, cached_msg), std::runtime_error);
+
+  remove(test_fname.c_str());
+  remove(invalid_fname.c_str());
+}
+
 TEST_F(MapPublisherTest, CoreFunctionality)
 {
   using Cloud = sensor_msgs::msg::PointCloud2;
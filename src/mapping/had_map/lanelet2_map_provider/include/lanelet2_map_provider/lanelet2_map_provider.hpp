@@ -46,6 +46,33 @@ struct LatLonAlt
   float64_t alt;  ///< altitude in meters
 };
 
+/// \brief Get the key which identifies the projection of a map file in a map cache. It hashes the
+/// contents of the file together with the origin and the version of the cache format, so that a
+/// cache of an edited map, of another origin or of an older format is detected as stale.
+/// \param map_filename The lanelet map filename
+/// \param map_frame_origin The map frame origin the map is projected with
+/// \return The key.
+/// \throw std::runtime_error if the map file can not be read.
+LANELET2_MAP_PROVIDER_PUBLIC std::string map_cache_key(
+  const std::string & map_filename, const LatLonAlt map_frame_origin);
+
+/// \brief Read a projected map from a map cache file.
+/// \param cache_filename The map cache filename
+/// \param key The key of the expected map, see `map_cache_key()`.
+/// \return The map, or a null pointer if the file does not exist, is unreadable or holds a map of
+/// another key.
+LANELET2_MAP_PROVIDER_PUBLIC std::shared_ptr<lanelet::LaneletMap> read_map_cache(
+  const std::string & cache_filename, const std::string & key);
+
+/// \brief Write a projected map to a map cache file. The file is written next to its destination
+/// and then renamed, so that a concurrent reader never sees a partial file.
+/// \param cache_filename The map cache filename
+/// \param key The key of the map, see `map_cache_key()`.
+/// \param map The map
+/// \throw std::runtime_error if the file can not be written.
+LANELET2_MAP_PROVIDER_PUBLIC void write_map_cache(
+  const std::string & cache_filename, const std::string & key, const lanelet::LaneletMap & map);
+
 /// \class Lanelet2MapProvider
 /// \brief Provides functoins to load and access a lanelet2 OSM map.
 class LANELET2_MAP_PROVIDER_PUBLIC Lanelet2MapProvider
@@ -56,31 +83,41 @@ public:
   /// \param stf The earth to map transform for projection of map data
   /// \param offset_lat Latitude offset in degrees to be added to the map frame origin
   /// \param offset_lon Longitude offset in degrees to be added to the map origin
+  /// \param cache_filename Map cache to load the projected map from, see `load_map()`. Empty
+  /// disables the cache.
   // TODO(nikolai.morin): Remove offsets as part of #849
   Lanelet2MapProvider(
     const std::string & map_filename,
     const geometry_msgs::msg::TransformStamped & stf, const float64_t offset_lat = 0.0,
-    const float64_t offset_lon = 0.0);
+    const float64_t offset_lon = 0.0, const std::string & cache_filename = "");
   /// \brief Constructor from latitude, longitude, altitude
   /// \param map_filename The lanelet map filename
   /// \param map_frame_origin The map frame origin
   /// \param offset_lat Latitude offset in degrees to be added to the map frame origin
   /// \param offset_lon Longitude offset in degrees to be added to the map frame origin
+  /// \param cache_filename Map cache to load the projected map from, see `load_map()`. Empty
+  /// disables the cache.
   // TODO(nikolai.morin): Remove offsets as part of #849
   Lanelet2MapProvider(
     const std::string & map_filename, const LatLonAlt map_frame_origin,
     const float64_t offset_lat = 0.0,
-    const float64_t offset_lon = 0.0);
+    const float64_t offset_lon = 0.0, const std::string & cache_filename = "");
   /// The map itself. After the constructor logic has been done,
   /// this is guaranteed to be initialized.
   std::shared_ptr<lanelet::LaneletMap> m_map;
+  /// Whether the map was read from the map cache instead of parsing the map file.
+  common::types::bool8_t m_loaded_from_cache{false};
 
 private:
-  /// \brief Internal function used by the constructor
+  /// \brief Internal function used by the constructor. If a cache file is given, the projected map
+  /// is read from it unless it is stale, otherwise the map file is parsed and projected and the
+  /// cache is rewritten. A cache which can not be written is skipped.
   /// \param map_filename The lanelet map filename
   /// \param map_frame_origin The map frame origin
+  /// \param cache_filename The map cache filename, empty to always parse the map file
   void load_map(
-    const std::string & map_filename, const LatLonAlt map_frame_origin);
+    const std::string & map_filename, const LatLonAlt map_frame_origin,
+    const std::string & cache_filename);
 };
 
 }  // namespace lanelet2_map_provider
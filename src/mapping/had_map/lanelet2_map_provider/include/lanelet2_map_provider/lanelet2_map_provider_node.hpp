@@ -22,7 +22,12 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <lanelet2_map_provider/lanelet2_map_provider.hpp>
+#include <deque>
+#include <map>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "autoware_auto_msgs/srv/had_map_service.hpp"
 #include "autoware_auto_msgs/msg/had_map_bin.hpp"
@@ -50,7 +55,9 @@ public:
   /// \throw runtime error if failed to start threads or configure driver
   explicit Lanelet2MapProviderNode(const rclcpp::NodeOptions & options);
 
-  /// \brief Handles the node service requests
+  /// \brief Handles the node service requests. Serialized responses are cached per requested
+  /// primitives and geometric bounds, so a repeated request only copies the cached message.
+  /// The cache is cleared when the map is replaced.
   /// \param request Service request message for map data specifying map content and geom. bounds
   /// \param response Service repsone to request, containing a sub-set of map data
   /// but nethertheless containing a complete and valid lanelet2 map
@@ -59,6 +66,20 @@ public:
     std::shared_ptr<autoware_auto_msgs::srv::HADMapService_Response> response);
 
 private:
+  using Request = autoware_auto_msgs::srv::HADMapService_Request;
+  /// Requested primitives and geometric bounds, the latter empty if they are not used.
+  using RequestKey = std::pair<Request::_requested_primitives_type, std::vector<float64_t>>;
+
+  /// Get the key of a request in the response cache.
+  /// \param request Service request.
+  /// \return Key of the request.
+  static RequestKey make_key(const Request & request);
+
+  /// Extract and serialize the requested sub-map.
+  /// \param request Service request.
+  /// \return Serialized map.
+  autoware_auto_msgs::msg::HADMapBin serialize_map(const Request & request) const;
+
   /// If the origin is not defined by parameters, get the transform describing
   /// the map origin (earth->map transform, set by the pcd
   /// map provider). Geocentric lanelet2 coordinates can then be obtained from the map frame.
@@ -66,7 +87,16 @@ private:
   geometry_msgs::msg::TransformStamped get_map_origin();
 
   std::unique_ptr<Lanelet2MapProvider> m_map_provider;
+  /// Version of the loaded map, sent along with every response.
+  std::string m_map_version;
   rclcpp::Service<autoware_auto_msgs::srv::HADMapService>::SharedPtr m_map_service;
+  /// Maximum number of cached responses, 0 disables the cache.
+  std::size_t m_response_cache_size;
+  std::map<RequestKey, autoware_auto_msgs::msg::HADMapBin> m_response_cache;
+  /// Keys of the cached responses in the order of insertion, to evict the oldest one.
+  std::deque<RequestKey> m_response_cache_order;
+  /// Map which the cached responses were serialized from.
+  std::weak_ptr<lanelet::LaneletMap> m_cached_map;
 };
 
 }  // namespace lanelet2_map_provider
@@ -32,6 +32,9 @@ namespace lanelet2_map_provider
 
 /// \class Lanelet2MapVisualizaer
 /// \brief ROS 2 Node for visualization of lanelet2 semantic map.
+/// The markers are generated once from the full map and published latched. The lane bounds can
+/// be simplified with the `simplify_tolerance` parameter, in meters, to reduce the size of the
+/// markers of large maps. A tolerance of 0 keeps all points.
 
 class LANELET2_MAP_PROVIDER_PUBLIC Lanelet2MapVisualizer : public rclcpp::Node
 {
@@ -42,6 +45,8 @@ public:
 private:
   rclcpp::Client<autoware_auto_msgs::srv::HADMapService>::SharedPtr m_client;
   rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr m_viz_pub;
+  /// Level of detail of the lane bounds, see had_map_utils::lineString2Marker().
+  common::types::float64_t m_simplify_tolerance;
 
   void visualize_map_callback(
     rclcpp::Client<autoware_auto_msgs::srv::HADMapService>::SharedFuture response);
@@ -14,7 +14,19 @@
 
 #include "lanelet2_map_provider/lanelet2_map_provider.hpp"
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "common/types.hpp"
 #include "had_map_utils/had_map_utils.hpp"
@@ -22,6 +34,7 @@
 #include "GeographicLib/Geocentric.hpp"
 #include "lanelet2_core/primitives/GPSPoint.h"
 #include "lanelet2_io/Io.h"
+#include "lanelet2_io/io_handlers/Serialize.h"
 #include "lanelet2_projection/UTM.h"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.h"
 
@@ -33,10 +46,87 @@ namespace autoware
 namespace lanelet2_map_provider
 {
 
+/// Version of the map cache format, part of the key so that caches of older formats are stale.
+static constexpr const char * MAP_CACHE_FORMAT = "lanelet2_map_provider map cache 1";
+
+std::string map_cache_key(const std::string & map_filename, const LatLonAlt map_frame_origin)
+{
+  std::ifstream file(map_filename, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Lanelet2MapProvider: Can not read map file " + map_filename);
+  }
+  // 64 bit FNV-1a hash of the file contents
+  uint64_t hash = 14695981039346656037ULL;
+  std::vector<char> buffer(1U << 20U);
+  while (file) {
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    const auto count = static_cast<std::size_t>(file.gcount());
+    for (std::size_t i = 0U; i < count; ++i) {
+      hash = (hash ^ static_cast<uint8_t>(buffer[i])) * 1099511628211ULL;
+    }
+  }
+  std::ostringstream key;
+  key << MAP_CACHE_FORMAT << ' ' << std::hex << hash << std::dec << std::setprecision(17) <<
+    ' ' << map_frame_origin.lat << ' ' << map_frame_origin.lon << ' ' << map_frame_origin.alt;
+  return key.str();
+}
+
+std::shared_ptr<lanelet::LaneletMap> read_map_cache(
+  const std::string & cache_filename, const std::string & key)
+{
+  std::ifstream file(cache_filename, std::ios::binary);
+  if (!file) {
+    return nullptr;
+  }
+  try {
+    boost::archive::binary_iarchive ia(file);
+    std::string cached_key;
+    ia >> cached_key;
+    if (cached_key != key) {
+      return nullptr;
+    }
+    auto map = std::make_shared<lanelet::LaneletMap>();
+    ia >> *map;
+    lanelet::Id id_counter;
+    ia >> id_counter;
+    lanelet::utils::registerId(id_counter);
+    return map;
+  } catch (const std::exception &) {
+    // A truncated or otherwise corrupt cache is stale as well
+    return nullptr;
+  }
+}
+
+void write_map_cache(
+  const std::string & cache_filename, const std::string & key, const lanelet::LaneletMap & map)
+{
+  const std::string tmp_filename = cache_filename + ".tmp";
+  {
+    std::ofstream file(tmp_filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      throw std::runtime_error("Lanelet2MapProvider: Can not write map cache " + tmp_filename);
+    }
+    boost::archive::binary_oarchive oa(file);
+    oa << key;
+    oa << map;
+    auto id_counter = lanelet::utils::getId();
+    oa << id_counter;
+    file.flush();
+    if (!file) {
+      std::remove(tmp_filename.c_str());
+      throw std::runtime_error("Lanelet2MapProvider: Can not write map cache " + tmp_filename);
+    }
+  }
+  if (std::rename(tmp_filename.c_str(), cache_filename.c_str()) != 0) {
+    std::remove(tmp_filename.c_str());
+    throw std::runtime_error("Lanelet2MapProvider: Can not write map cache " + cache_filename);
+  }
+}
+
 Lanelet2MapProvider::Lanelet2MapProvider(
   const std::string & map_filename,
   const geometry_msgs::msg::TransformStamped & stf, const float64_t offset_lat,
-  const float64_t offset_lon)
+  const float64_t offset_lon, const std::string & cache_filename)
 {
   GeographicLib::Geocentric earth(
     GeographicLib::Constants::WGS84_a(),
@@ -50,28 +140,46 @@ Lanelet2MapProvider::Lanelet2MapProvider(
     stf.transform.translation.y,
     stf.transform.translation.z,
     origin_lat, origin_lon, origin_alt);
-  this->load_map(map_filename, {origin_lat + offset_lat, origin_lon + offset_lon, origin_alt});
+  this->load_map(
+    map_filename, {origin_lat + offset_lat, origin_lon + offset_lon, origin_alt}, cache_filename);
 }
 
 Lanelet2MapProvider::Lanelet2MapProvider(
   const std::string & map_filename,
   const LatLonAlt map_frame_origin,
-  const float64_t offset_lat, const float64_t offset_lon)
+  const float64_t offset_lat, const float64_t offset_lon, const std::string & cache_filename)
 {
   LatLonAlt adjusted_origin{map_frame_origin.lat + offset_lat, map_frame_origin.lon + offset_lon,
     map_frame_origin.alt};
-  this->load_map(map_filename, adjusted_origin);
+  this->load_map(map_filename, adjusted_origin, cache_filename);
 }
 
 void Lanelet2MapProvider::load_map(
-  const std::string & map_filename, const LatLonAlt map_frame_origin)
+  const std::string & map_filename, const LatLonAlt map_frame_origin,
+  const std::string & cache_filename)
 {
-  lanelet::ErrorMessages errors;
-  lanelet::GPSPoint originGps{map_frame_origin.lat, map_frame_origin.lon, map_frame_origin.alt};
-  lanelet::Origin origin{originGps};
+  std::string key;
+  if (!cache_filename.empty()) {
+    key = map_cache_key(map_filename, map_frame_origin);
+    m_map = read_map_cache(cache_filename, key);
+  }
+  m_loaded_from_cache = (m_map != nullptr);
+  if (!m_loaded_from_cache) {
+    lanelet::ErrorMessages errors;
+    lanelet::GPSPoint originGps{map_frame_origin.lat, map_frame_origin.lon, map_frame_origin.alt};
+    lanelet::Origin origin{originGps};
 
-  lanelet::projection::UtmProjector projector(origin);
-  m_map = lanelet::load(map_filename, projector, &errors);
+    lanelet::projection::UtmProjector projector(origin);
+    m_map = lanelet::load(map_filename, projector, &errors);
+    if (!cache_filename.empty()) {
+      try {
+        write_map_cache(cache_filename, key, *m_map);
+      } catch (const std::runtime_error &) {
+        // The cache only speeds up the next start, e.g. its directory may be read-only
+      }
+    }
+  }
+  // The cache holds the map as projected, so that it matches a plain load of the map file
   autoware::common::had_map_utils::overwriteLaneletsCenterline(m_map, true);
 }
 
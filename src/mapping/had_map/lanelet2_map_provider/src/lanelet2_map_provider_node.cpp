@@ -28,10 +28,12 @@
 #include <rclcpp/time_source.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
 #include <common/types.hpp>
+#include <algorithm>
 #include <chrono>
 #include <string>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "autoware_auto_msgs/srv/had_map_service.hpp"
 #include "autoware_auto_msgs/msg/had_map_bin.hpp"
@@ -45,9 +47,12 @@ namespace autoware
 namespace lanelet2_map_provider
 {
 Lanelet2MapProviderNode::Lanelet2MapProviderNode(const rclcpp::NodeOptions & options)
-: Node("Lanelet2MapProvider", options)
+: Node("Lanelet2MapProvider", options),
+  m_response_cache_size{static_cast<std::size_t>(
+      std::max(declare_parameter("response_cache_size", 16), 0))}
 {
   const std::string map_filename = declare_parameter("map_osm_file").get<std::string>();
+  const std::string map_cache_filename = declare_parameter("map_cache_file", std::string{});
   const float64_t origin_offset_lat = declare_parameter("origin_offset_lat", 0.0);
   const float64_t origin_offset_lon = declare_parameter("origin_offset_lon", 0.0);
   if (has_parameter("latitude") && has_parameter("longitude") && has_parameter("elevation")) {
@@ -56,14 +61,20 @@ Lanelet2MapProviderNode::Lanelet2MapProviderNode(const rclcpp::NodeOptions & opt
     const float64_t origin_alt = declare_parameter("elevation").get<float64_t>();
     LatLonAlt map_origin{origin_lat, origin_lon, origin_alt};
     m_map_provider = std::make_unique<Lanelet2MapProvider>(
-      map_filename, map_origin, origin_offset_lat, origin_offset_lon);
+      map_filename, map_origin, origin_offset_lat, origin_offset_lon, map_cache_filename);
   } else {
     /// This could potentially also read the same yaml that the ndt map publisher reads
     auto earth_from_map = get_map_origin();
     m_map_provider = std::make_unique<Lanelet2MapProvider>(
       map_filename, std::move(
-        earth_from_map), origin_offset_lat, origin_offset_lon);
+        earth_from_map), origin_offset_lat, origin_offset_lon, map_cache_filename);
   }
+  if (m_map_provider->m_loaded_from_cache) {
+    RCLCPP_INFO(get_logger(), "Loaded the projected map from %s", map_cache_filename.c_str());
+  }
+
+  // Identifies the loaded map, e.g. for clients which assemble it from tiles
+  m_map_version = std::to_string(now().nanoseconds());
 
   m_map_service =
     this->create_service<autoware_auto_msgs::srv::HADMapService>(
@@ -102,33 +113,76 @@ geometry_msgs::msg::TransformStamped Lanelet2MapProviderNode::get_map_origin()
 }
 
 
-// This function should extract requested correct submap from the fullmap
-// convert to binary format and then fill response
 void Lanelet2MapProviderNode::handle_request(
   std::shared_ptr<autoware_auto_msgs::srv::HADMapService_Request> request,
   std::shared_ptr<autoware_auto_msgs::srv::HADMapService_Response> response)
+{
+  // Responses serialized from a previous map are stale
+  if (m_cached_map.lock() != m_map_provider->m_map) {
+    m_response_cache.clear();
+    m_response_cache_order.clear();
+    m_cached_map = m_map_provider->m_map;
+  }
+
+  auto key = make_key(*request);
+  const auto cached = m_response_cache.find(key);
+  if (cached != m_response_cache.end()) {
+    response->map = cached->second;
+    return;
+  }
+
+  response->map = serialize_map(*request);
+  if (m_response_cache_size == 0U) {
+    return;
+  }
+  if (m_response_cache.size() >= m_response_cache_size) {
+    m_response_cache.erase(m_response_cache_order.front());
+    m_response_cache_order.pop_front();
+  }
+  (void) m_response_cache.emplace(key, response->map);
+  m_response_cache_order.push_back(std::move(key));
+}
+
+Lanelet2MapProviderNode::RequestKey Lanelet2MapProviderNode::make_key(const Request & request)
+{
+  const auto & primitives = request.requested_primitives;
+  const bool8_t full_map = (primitives.size() == 1U) && (primitives.front() == Request::FULL_MAP);
+  const bool8_t geom_bound_requested =
+    (request.geom_upper_bound.size() == 3U) && (request.geom_lower_bound.size() == 3U);
+  std::vector<float64_t> bounds;
+  // The full map does not depend on the bounds
+  if (!full_map && geom_bound_requested) {
+    bounds.insert(bounds.end(), request.geom_lower_bound.begin(), request.geom_lower_bound.end());
+    bounds.insert(bounds.end(), request.geom_upper_bound.begin(), request.geom_upper_bound.end());
+  }
+  return {primitives, bounds};
+}
+
+// This function should extract requested correct submap from the fullmap
+// and convert it to binary format
+autoware_auto_msgs::msg::HADMapBin Lanelet2MapProviderNode::serialize_map(
+  const Request & request) const
 {
   autoware_auto_msgs::msg::HADMapBin msg;
   msg.header.frame_id = "map";
 
-  // TODO(simon) add map version and format information to message header
+  // TODO(simon) add format information to message header
   // msg.format_version = format_version;
-  // msg.map_version = map_version;
+  msg.map_version = m_map_version;
 
-  auto primitive_sequence = request->requested_primitives;
+  const auto & primitive_sequence = request.requested_primitives;
 
   // special case where we send existing map as is
   if (primitive_sequence.size() == 1 && *(primitive_sequence.begin()) ==
     autoware_auto_msgs::srv::HADMapService_Request::FULL_MAP)
   {
     autoware::common::had_map_utils::toBinaryMsg(m_map_provider->m_map, msg);
-    response->map = msg;
-    return;
+    return msg;
   }
 
   // check if geom bounds are set in request (ie - they are non zero)
-  auto upper_bound = request->geom_upper_bound;
-  auto lower_bound = request->geom_lower_bound;
+  const auto & upper_bound = request.geom_upper_bound;
+  const auto & lower_bound = request.geom_lower_bound;
   bool8_t geom_bound_requested = (upper_bound.size() == 3) && (lower_bound.size() == 3);
 
   lanelet::LaneletMapPtr requested_map;
@@ -186,7 +240,7 @@ void Lanelet2MapProviderNode::handle_request(
     requested_map->add(*i);
   }
   autoware::common::had_map_utils::toBinaryMsg(requested_map, msg);
-  response->map = msg;
+  return msg;
 }
 
 }  // namespace lanelet2_map_provider
@@ -93,7 +93,7 @@ void Lanelet2MapVisualizer::visualize_map_callback(
     map_marker_array,
     autoware::common::had_map_utils::laneletsBoundaryAsMarkerArray(
       marker_t, lls,
-      color_lane_bounds, true));
+      color_lane_bounds, true, m_simplify_tolerance));
   insertMarkerArray(
     map_marker_array,
     autoware::common::had_map_utils::laneletsAsTriangleMarkerArray(
@@ -132,7 +132,8 @@ void Lanelet2MapVisualizer::visualize_map_callback(
 }
 
 Lanelet2MapVisualizer::Lanelet2MapVisualizer(const rclcpp::NodeOptions & options)
-: Node("lanelet2_map_visualizer", options)
+: Node("lanelet2_map_visualizer", options),
+  m_simplify_tolerance(declare_parameter("simplify_tolerance", 0.0))
 {
   m_client =
     this->create_client<autoware_auto_msgs::srv::HADMapService>("HAD_Map_Service");
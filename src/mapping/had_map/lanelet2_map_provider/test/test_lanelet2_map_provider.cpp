@@ -60,6 +60,47 @@ TEST(TestLanelet2MapProvider, BasicTest) {
   remove(lanelet2_map_file.c_str());
 }
 
+TEST(TestLanelet2MapProvider, MapCache) {
+  using autoware::lanelet2_map_provider::Lanelet2MapProvider;
+  using autoware::lanelet2_map_provider::LatLonAlt;
+  lanelet::LaneletMap lanelet_map = getALaneletMap();
+  const std::string lanelet2_map_file = "lanelet2_cache_test.osm";
+  const std::string cache_file = "lanelet2_cache_test.bin";
+  write(lanelet2_map_file, lanelet_map);
+  remove(cache_file.c_str());
+  const LatLonAlt origin{37.0, -120.0, 16.0};
+
+  // The first load parses the map file and writes the cache
+  const Lanelet2MapProvider parsed(lanelet2_map_file, origin, 0.0, 0.0, cache_file);
+  EXPECT_FALSE(parsed.m_loaded_from_cache);
+  const auto key = autoware::lanelet2_map_provider::map_cache_key(lanelet2_map_file, origin);
+  ASSERT_NE(autoware::lanelet2_map_provider::read_map_cache(cache_file, key), nullptr);
+
+  // The second one reads the cache
+  const Lanelet2MapProvider cached(lanelet2_map_file, origin, 0.0, 0.0, cache_file);
+  EXPECT_TRUE(cached.m_loaded_from_cache);
+  ASSERT_EQ(cached.m_map->laneletLayer.size(), parsed.m_map->laneletLayer.size());
+  ASSERT_EQ(cached.m_map->pointLayer.size(), parsed.m_map->pointLayer.size());
+  for (const auto & point : parsed.m_map->pointLayer) {
+    const auto cached_point = cached.m_map->pointLayer.get(point.id());
+    EXPECT_DOUBLE_EQ(cached_point.x(), point.x());
+    EXPECT_DOUBLE_EQ(cached_point.y(), point.y());
+  }
+
+  // Another origin makes the cache stale
+  const Lanelet2MapProvider offset(lanelet2_map_file, origin, 0.001, 0.0, cache_file);
+  EXPECT_FALSE(offset.m_loaded_from_cache);
+  EXPECT_EQ(autoware::lanelet2_map_provider::read_map_cache(cache_file, key), nullptr);
+
+  // So does an edited map file
+  lanelet_map.add(lanelet::Point3d{lanelet::utils::getId(), 5, 5, 0});
+  write(lanelet2_map_file, lanelet_map);
+  EXPECT_NE(autoware::lanelet2_map_provider::map_cache_key(lanelet2_map_file, origin), key);
+
+  remove(lanelet2_map_file.c_str());
+  remove(cache_file.c_str());
+}
+
 TEST(TestLanelet2MapProviderNode, TestService) {
   std::cerr << "test node\n";
   std::string program_name = "test_node";
@@ -22,6 +22,9 @@
 
 #include <ndt_mapping_nodes/visibility_control.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <point_cloud_mapping/double_buffered_map.hpp>
+#include <point_cloud_mapping/map_chunk.hpp>
+#include <point_cloud_mapping/pcd_writer.hpp>
 #include <point_cloud_mapping/point_cloud_map.hpp>
 #include <point_cloud_mapping/policies.hpp>
 #include <ndt/ndt_localizer.hpp>
@@ -30,10 +33,16 @@
 #include <helper_functions/float_comparisons.hpp>
 #include <tf2_msgs/msg/tf_message.hpp>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <string>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace autoware
 {
@@ -44,7 +53,8 @@ namespace ndt_mapping_nodes
 using Optimizer = common::optimization::NewtonsMethodOptimizer<
   common::optimization::MoreThuenteLineSearch>;
 using NDTMap = localization::ndt::DynamicNDTMap;
-using VoxelMap = point_cloud_mapping::DualVoxelMap<NDTMap>;
+using LocalizerMap = point_cloud_mapping::DoubleBufferedMap<NDTMap>;
+using VoxelMap = point_cloud_mapping::DualVoxelMap<LocalizerMap>;
 using Localizer = localization::ndt::P2DNDTLocalizer<Optimizer, NDTMap>;
 using P2DNDTConfig = localization::ndt::P2DNDTLocalizerConfig;
 using WritePolicy = mapping::point_cloud_mapping::CapacityTrigger;
@@ -52,7 +62,9 @@ using ClearPolicy = mapping::point_cloud_mapping::CapacityTrigger;
 using PrefixPolicy = mapping::point_cloud_mapping::TimeStampPrefixGenerator;
 
 /// \brief Mapper node implementation that localizes using a `P2DNDTLocalizer` and accumulates
-/// the registered scans into a `DualVoxelMap`.
+/// the registered scans into a `DualVoxelMap`. The map can be updated on a background thread, so
+/// that a scan is registered while the previous increment is inserted. The localizer map is
+/// double buffered for that, see `DoubleBufferedMap`.
 /// \tparam WriteTriggerPolicyT Policy specifying when to write the map into a file
 /// \tparam ClearTriggerPolicyT Policy specifying when to clear the map.
 /// \tparam PrefixGeneratorT Functor that generates the full filename prefix given a base prefix.
@@ -104,10 +116,18 @@ public:
 
   ~P2DNDTVoxelMapperNode()
   {
-    if (m_map_ptr->size() > 0U) {
-      const auto & file_name_prefix = m_prefix_generator.get(m_base_fn_prefix);
-      RCLCPP_DEBUG(get_logger(), "The map is written to" + file_name_prefix + ".pcd");
-      m_map_ptr->write(file_name_prefix);
+    // The queued increments are inserted before the map is written
+    if (m_map_update_thread.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock{m_map_update_mutex};
+        m_map_updates_stopped = true;
+      }
+      m_map_update_condition.notify_all();
+      m_map_update_thread.join();
+    }
+    // The writer writes the queued maps before it is destroyed
+    if (m_chunk_writer || (m_map_ptr->size() > 0U)) {
+      write_map();
     }
   }
 
@@ -142,7 +162,9 @@ private:
       template get<uint32_t>()),
       std::chrono::milliseconds(
         static_cast<uint64_t>(
-          this->declare_parameter("localizer.guess_time_tolerance_ms").template get<uint64_t>()))
+          this->declare_parameter("localizer.guess_time_tolerance_ms").template get<uint64_t>())),
+      static_cast<uint32_t>(
+        std::max(this->declare_parameter("localizer.optimization.num_threads", 1), 1))
     };
 
     const auto outlier_ratio{this->declare_parameter(
@@ -172,9 +194,25 @@ private:
             optimization_options},
       outlier_ratio);
     const auto & map_frame_id = this->declare_parameter("map.frame_id").template get<std::string>();
+    const auto localizer_map_config = parse_grid_config("localizer.map");
+    point_cloud_mapping::MapTilingConfig tiling_config;
+    tiling_config.tile_size =
+      static_cast<float32_t>(this->declare_parameter("map.tiling.tile_size", 0.0));
+    tiling_config.max_resident_tiles = static_cast<std::size_t>(
+      std::max(this->declare_parameter("map.tiling.max_resident_tiles", 9), 1));
+    tiling_config.spill_directory = this->declare_parameter(
+      "map.tiling.spill_directory", std::string{"."}).template get<std::string>();
     m_map_ptr = std::make_unique<VoxelMap>(
       parse_grid_config("map"), map_frame_id,
-      NDTMap{parse_grid_config("localizer.map")});
+      LocalizerMap{NDTMap{localizer_map_config}, NDTMap{localizer_map_config}},
+      static_cast<std::size_t>(std::max(this->declare_parameter("map.num_threads", 1), 1)),
+      tiling_config);
+
+    const auto chunk_file_name =
+      this->declare_parameter("map_chunk_file", std::string{}).template get<std::string>();
+    if (!chunk_file_name.empty()) {
+      m_chunk_writer = std::make_unique<point_cloud_mapping::MapChunkWriter>(chunk_file_name);
+    }
 
     if (this->declare_parameter("publish_map_increment").template get<bool8_t>()) {
       m_increment_publisher = this->template create_publisher<sensor_msgs::msg::PointCloud2>(
@@ -194,6 +232,10 @@ private:
     m_previous_transform.header.frame_id = m_map_ptr->frame_id();
     point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> msg_initializer{m_cached_increment,
       map_frame_id};
+
+    if (this->declare_parameter("map.update_in_background", true)) {
+      m_map_update_thread = std::thread{[this] {run_map_updates();}};
+    }
   }
 
   void observation_callback(Cloud::ConstSharedPtr msg_ptr)
@@ -203,15 +245,24 @@ private:
       m_previous_transform.header.stamp = msg_ptr->header.stamp;
 
       geometry_msgs::msg::PoseWithCovarianceStamped pose_out;
-      if (m_map_ptr->empty()) {
-        // If the map is empty, get the initial pose for inserting the increment into the map.
-        // If the map is empty in further iterations, then throw as we don't know where to place
-        // the scan anymore.
-        pose_out = get_initial_pose_once();
-      } else {
-        // Register the measurement only if there is a valid map.
-        pose_out = m_localizer_ptr->register_measurement(
-          *msg_ptr, m_previous_transform, m_map_ptr->localizer_map(), &summary);
+      {
+        // The copy of the localizer map is held until the registration is done, the map update
+        // waits for it.
+        const auto localizer_map = m_map_ptr->localizer_map().read();
+        if (localizer_map.version() > 0U) {
+          // Register the measurement only if there is a valid map.
+          pose_out = m_localizer_ptr->register_measurement(
+            *msg_ptr, m_previous_transform, localizer_map.map(), &summary);
+        } else if (m_map_initialized && m_map_update_thread.joinable()) {
+          RCLCPP_WARN(
+            get_logger(), "The first scan is not inserted into the map yet. The scan is dropped.");
+          return;
+        } else {
+          // If the map is empty, get the initial pose for inserting the increment into the map.
+          // If the map is empty in further iterations, then throw as we don't know where to
+          // place the scan anymore.
+          pose_out = get_initial_pose_once();
+        }
       }
 
       if (!validate_output(summary)) {
@@ -228,25 +279,102 @@ private:
       if (m_tf_publisher) {
         publish_tf(pose_to_transform(pose_out, msg_ptr->header.frame_id));
       }
-      if (m_write_trigger.ready(*m_map_ptr)) {
-        const auto & file_name_prefix = m_prefix_generator.get(m_base_fn_prefix);
-        m_map_ptr->write(file_name_prefix);
-        RCLCPP_DEBUG(get_logger(), "The map is written to" + file_name_prefix + ".pcd");
-      }
-      if (m_clear_trigger.ready(*m_map_ptr)) {
-        RCLCPP_DEBUG(get_logger(), "The map is cleared.");
-        m_map_ptr->clear();
+      if (m_map_update_thread.joinable()) {
+        queue_map_update(increment);
+      } else {
+        update_map(increment);
       }
-
-      // Update the map after a possible clearance and not before so that the map is never fully
-      // empty.
-      m_map_ptr->update(increment);
       m_previous_transform = pose_to_transform(pose_out, msg_ptr->header.frame_id);
     } catch (const std::runtime_error & e) {
       RCLCPP_ERROR(get_logger(), "Failed to register the measurement: ", e.what());
     }
   }
 
+  /// Write and clear the map if the triggers are ready and insert an increment into it. Only
+  /// called from the map update thread if there is one.
+  /// \param increment Registered scan in the map frame.
+  void update_map(const Cloud & increment)
+  {
+    if (m_write_trigger.ready(*m_map_ptr)) {
+      write_map();
+    }
+    const auto num_write_failures = m_map_writer.num_failures();
+    if (num_write_failures > m_num_write_failures) {
+      RCLCPP_ERROR(get_logger(), "Failed to write the map to a pcd file.");
+      m_num_write_failures = num_write_failures;
+    }
+    if (m_clear_trigger.ready(*m_map_ptr)) {
+      RCLCPP_DEBUG(get_logger(), "The map is cleared.");
+      m_map_ptr->clear();
+    }
+
+    // Update the map after a possible clearance and not before so that the map is never fully
+    // empty.
+    m_map_ptr->update(increment);
+  }
+
+  /// Queue an increment for the map update thread. No increment is dropped, as it would be
+  /// missing from the map.
+  /// \param increment Registered scan in the map frame, which is copied.
+  void queue_map_update(const Cloud & increment)
+  {
+    {
+      std::lock_guard<std::mutex> lock{m_map_update_mutex};
+      if (m_free_increments.empty()) {
+        m_pending_increments.push_back(increment);
+      } else {
+        // Copying into a recycled message reuses its buffer
+        m_pending_increments.push_back(std::move(m_free_increments.back()));
+        m_free_increments.pop_back();
+        m_pending_increments.back() = increment;
+      }
+    }
+    m_map_update_condition.notify_one();
+  }
+
+  /// Insert the queued increments into the map until the node is destroyed.
+  void run_map_updates()
+  {
+    std::unique_lock<std::mutex> lock{m_map_update_mutex};
+    while (true) {
+      m_map_update_condition.wait(
+        lock, [this] {return m_map_updates_stopped || !m_pending_increments.empty();});
+      if (m_pending_increments.empty()) {
+        return;
+      }
+      auto increment = std::move(m_pending_increments.front());
+      m_pending_increments.pop_front();
+      lock.unlock();
+      try {
+        update_map(increment);
+      } catch (const std::runtime_error & e) {
+        RCLCPP_ERROR(get_logger(), "Failed to update the map: %s", e.what());
+      }
+      lock.lock();
+      m_free_increments.push_back(std::move(increment));
+    }
+  }
+
+  /// Append the changed voxels to the chunk file if there is one, or queue the whole map to be
+  /// written to a pcd file otherwise.
+  void write_map()
+  {
+    if (m_chunk_writer) {
+      // Only the voxels changed since the last chunk are written
+      try {
+        m_chunk_writer->append(m_map_ptr->take_changes());
+        RCLCPP_DEBUG(get_logger(), "A map chunk is appended.");
+      } catch (const std::runtime_error & e) {
+        RCLCPP_ERROR(get_logger(), "Failed to append the map chunk: %s", e.what());
+      }
+    } else {
+      // Only the snapshot is taken here, the file is written on the writer thread
+      const auto & file_name_prefix = m_prefix_generator.get(m_base_fn_prefix);
+      m_map_writer.write(file_name_prefix, m_map_ptr->snapshot());
+      RCLCPP_DEBUG(get_logger(), "The map is written to" + file_name_prefix + ".pcd");
+    }
+  }
+
   bool8_t validate_output(
     const RegistrationSummary & summary)
   {
@@ -364,6 +492,16 @@ private:
   PrefixGeneratorT m_prefix_generator{};
   bool8_t m_map_initialized{false};
   std::string m_base_fn_prefix;
+  point_cloud_mapping::BackgroundPCDWriter m_map_writer{};
+  std::unique_ptr<point_cloud_mapping::MapChunkWriter> m_chunk_writer{nullptr};
+  std::size_t m_num_write_failures{0U};
+  // Map updates on the background thread, see `run_map_updates()`
+  std::thread m_map_update_thread;
+  std::mutex m_map_update_mutex;
+  std::condition_variable m_map_update_condition;
+  std::deque<Cloud> m_pending_increments;
+  std::vector<Cloud> m_free_increments;
+  bool8_t m_map_updates_stopped{false};
 };
 
 }  // namespace ndt_mapping_nodes
@@ -0,0 +1,108 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+// Offline tool to compact the map chunk file of the ndt mapper (see the `map_chunk_file`
+// parameter) into a pcd file and optionally into the map cache file of the ndt map publisher,
+// with the parameters the publisher is launched with (see
+// ndt_nodes/param/map_publisher.param.yaml).
+
+#include <common/types.hpp>
+#include <ndt/ndt_map.hpp>
+#include <ndt/ndt_map_publisher.hpp>
+#include <point_cloud_mapping/map_chunk.hpp>
+#include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
+#include <yaml-cpp/yaml.h>
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#include <pcl/io/pcd_io.h>
+#pragma GCC diagnostic pop
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+using autoware::common::types::float32_t;
+using autoware::common::types::PointXYZI;
+using autoware::localization::ndt::DynamicNDTMap;
+using autoware::localization::ndt::StaticNDTMap;
+using PointXYZ = autoware::perception::filters::voxel_grid::PointXYZ;
+
+namespace
+{
+PointXYZ read_point(const YAML::Node & node)
+{
+  PointXYZ point;
+  point.x = node["x"].as<float32_t>();
+  point.y = node["y"].as<float32_t>();
+  point.z = node["z"].as<float32_t>();
+  return point;
+}
+
+void write_map_cache(
+  const pcl::PointCloud<pcl::PointXYZI> & map, const std::string & param_file_name,
+  const std::string & cache_file_name)
+{
+  const auto params = YAML::LoadFile(param_file_name).begin()->second["ros__parameters"];
+  const auto map_config = params["map_config"];
+
+  sensor_msgs::msg::PointCloud2 source_pc;
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{
+    source_pc, params["map_frame"].as<std::string>()};
+  modifier.reserve(map.size());
+  for (const auto & pt : map) {
+    modifier.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
+  }
+
+  DynamicNDTMap ndt_map{DynamicNDTMap::Config{
+      read_point(map_config["min_point"]),
+      read_point(map_config["max_point"]),
+      read_point(map_config["voxel_size"]),
+      map_config["capacity"].as<uint64_t>()}};
+  ndt_map.insert(source_pc);
+  sensor_msgs::msg::PointCloud2 map_pc;
+  ndt_map.serialize_as<StaticNDTMap>(map_pc);
+  autoware::localization::ndt::write_map_cache(cache_file_name, map_pc);
+  std::cout << "Wrote " << (map_pc.width - DynamicNDTMap::kNumConfigPoints) <<
+    " ndt voxels to " << cache_file_name << std::endl;
+}
+}  // namespace
+
+int32_t main(const int32_t argc, char ** const argv)
+{
+  if ((argc != 3) && (argc != 5)) {
+    std::cerr << "Usage: " << argv[0] <<
+      " <map chunk file> <output pcd file> [<map_publisher.param.yaml> <map cache file>]" <<
+      std::endl;
+    return 1;
+  }
+  try {
+    const auto map = autoware::mapping::point_cloud_mapping::compact_map_chunks(argv[1]);
+    if (pcl::io::savePCDFileBinary(argv[2], map) != 0) {
+      std::cerr << "The pcd file " << argv[2] << " could not be written." << std::endl;
+      return 1;
+    }
+    std::cout << "Wrote " << map.size() << " voxels to " << argv[2] << std::endl;
+    if (argc == 5) {
+      write_map_cache(map, argv[3], argv[4]);
+    }
+  } catch (const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,170 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 the Autoware Foundation
+/// All rights reserved.
+
+#ifndef POINT_CLOUD_MAPPING__DOUBLE_BUFFERED_MAP_HPP_
+#define POINT_CLOUD_MAPPING__DOUBLE_BUFFERED_MAP_HPP_
+
+#include <point_cloud_mapping/visibility_control.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <common/types.hpp>
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+namespace autoware
+{
+namespace mapping
+{
+namespace point_cloud_mapping
+{
+
+/// A localizer map kept in two copies, so that it can be read, e.g. by a localizer registering
+/// scans, while it is updated on another thread, e.g. as the localizer map of a `DualVoxelMap`.
+/// An insertion is applied to the copy without readers first, which is then handed to new
+/// readers, and then to the other copy once its readers are done. Hence reading never waits for
+/// an insertion, and an insertion waits for at most the readers which started before it.
+///
+/// Maps of the localizer are usually not copyable, which is why both copies are built up by
+/// inserting every cloud twice instead of copying the updated one.
+/// \tparam MapT Map type providing `insert(cloud)` and `clear()`.
+template<typename MapT>
+class POINT_CLOUD_MAPPING_PUBLIC DoubleBufferedMap
+{
+public:
+  using Cloud = sensor_msgs::msg::PointCloud2;
+
+  /// A copy of the map held for reading, which is not updated until the reader is destroyed.
+  class Reader
+  {
+  public:
+    Reader(const Reader &) = delete;
+    Reader & operator=(const Reader &) = delete;
+    Reader(Reader && other) noexcept
+    : m_parent{other.m_parent}, m_copy_idx{other.m_copy_idx}
+    {
+      other.m_parent = nullptr;
+    }
+    Reader & operator=(Reader &&) = delete;
+
+    ~Reader()
+    {
+      if (m_parent != nullptr) {
+        m_parent->release(m_copy_idx);
+      }
+    }
+
+    /// Get the map copy.
+    const MapT & map() const noexcept
+    {
+      return m_parent->m_copies[m_copy_idx];
+    }
+
+    /// Get the number of clouds inserted into the map copy, which is 0 until the first insertion.
+    std::size_t version() const noexcept
+    {
+      return m_parent->m_versions[m_copy_idx];
+    }
+
+  private:
+    friend class DoubleBufferedMap;
+    Reader(const DoubleBufferedMap & parent, const std::size_t copy_idx) noexcept
+    : m_parent{&parent}, m_copy_idx{copy_idx} {}
+
+    const DoubleBufferedMap * m_parent;
+    std::size_t m_copy_idx;
+  };
+
+  /// Constructor
+  /// \param first First copy of the map.
+  /// \param second Second copy of the map, with the same configuration as the first one.
+  DoubleBufferedMap(MapT && first, MapT && second)
+  : m_copies{{std::forward<MapT>(first), std::forward<MapT>(second)}} {}
+
+  /// Move constructor, for handing the map over to its owner before it is read or updated.
+  DoubleBufferedMap(DoubleBufferedMap && other)
+  : m_copies{std::move(other.m_copies)}, m_versions(other.m_versions), m_front{other.m_front},
+    m_clear_pending{other.m_clear_pending} {}
+
+  /// Insert a cloud into both copies, after clearing them if `clear()` was called before. Only
+  /// one thread may insert and clear at a time.
+  /// \param cloud Cloud to insert.
+  /// \throw The error of the underlying map. Then the copies may differ.
+  void insert(const Cloud & cloud)
+  {
+    const auto insert_into = [this, &cloud](const std::size_t copy_idx) {
+        if (m_clear_pending) {
+          m_copies[copy_idx].clear();
+        }
+        m_copies[copy_idx].insert(cloud);
+        ++m_versions[copy_idx];
+      };
+    // New readers only get the front copy and the readers of the back copy are done
+    const auto back = 1U - m_front;
+    insert_into(back);
+    {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      m_front = back;
+      m_readers_done.wait(lock, [this] {return m_num_readers[1U - m_front] == 0U;});
+    }
+    insert_into(1U - back);
+    m_clear_pending = false;
+  }
+
+  /// Clear the map with the next insertion, so that readers never get an empty map once a cloud
+  /// was inserted.
+  void clear() noexcept
+  {
+    m_clear_pending = true;
+  }
+
+  /// Get the up to date copy of the map for reading. It may be called from any thread.
+  /// \return Reader of the copy, which must not outlive this object.
+  Reader read() const
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    ++m_num_readers[m_front];
+    return Reader{*this, m_front};
+  }
+
+private:
+  /// Release a copy, see `Reader`.
+  void release(const std::size_t copy_idx) const
+  {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      --m_num_readers[copy_idx];
+    }
+    m_readers_done.notify_all();
+  }
+
+  std::array<MapT, 2U> m_copies;
+  std::array<std::size_t, 2U> m_versions{{0U, 0U}};
+  // Index of the copy handed to new readers, only changed by `insert()` under the mutex
+  std::size_t m_front{0U};
+  common::types::bool8_t m_clear_pending{false};
+  mutable std::array<std::size_t, 2U> m_num_readers{{0U, 0U}};
+  mutable std::mutex m_mutex;
+  mutable std::condition_variable m_readers_done;
+};
+}  // namespace point_cloud_mapping
+}  // namespace mapping
+}  // namespace autoware
+
+#endif  // POINT_CLOUD_MAPPING__DOUBLE_BUFFERED_MAP_HPP_
@@ -0,0 +1,156 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#ifndef POINT_CLOUD_MAPPING__MAP_CHUNK_HPP_
+#define POINT_CLOUD_MAPPING__MAP_CHUNK_HPP_
+
+#include <point_cloud_mapping/visibility_control.hpp>
+#include <common/types.hpp>
+#pragma GCC diagnostic push
+// silence unsafe signed <-> unsigned conversion
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#pragma GCC diagnostic pop
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace mapping
+{
+namespace point_cloud_mapping
+{
+using common::types::float32_t;
+
+/// Centroid of a voxel of the map, with the index of the voxel in the grid.
+struct POINT_CLOUD_MAPPING_PUBLIC VoxelRecord
+{
+  uint64_t key;
+  float32_t x;
+  float32_t y;
+  float32_t z;
+  float32_t intensity;
+};
+
+/// Voxel of a map tile spilled to disk, with the state needed to keep updating it once the tile
+/// is loaded again.
+struct POINT_CLOUD_MAPPING_PUBLIC TileVoxelRecord
+{
+  VoxelRecord voxel;
+  /// Number of points in the voxel.
+  uint32_t count;
+  /// Nonzero if the voxel changed since the changes were last taken from the map.
+  uint32_t changed;
+};
+
+/// Location and size of a chunk in a map chunk file.
+struct POINT_CLOUD_MAPPING_PUBLIC MapChunkIndexEntry
+{
+  uint64_t offset;
+  uint64_t num_voxels;
+};
+
+/// \brief Writer of an append-only file of map chunks, each of which holds the voxels that
+/// changed since the previous one, so that a flush only writes the new data of a long mapping
+/// session instead of the whole map.
+///
+/// The file starts with a header, followed by the voxel records of the chunks and a footer with
+/// the index of the chunks. Appending a chunk overwrites the footer with the new records and
+/// writes the extended footer after them. The records are stored in their in-memory layout, so a
+/// chunk file is only meant to be read on the same architecture. Use `MapChunkReader` or
+/// `compact_map_chunks()` to read it.
+class POINT_CLOUD_MAPPING_PUBLIC MapChunkWriter
+{
+public:
+  /// Create a chunk file without chunks, replacing an existing file.
+  /// \param file_name Name of the chunk file.
+  /// \throws std::runtime_error if the file cannot be written.
+  explicit MapChunkWriter(const std::string & file_name);
+
+  /// Append a chunk. Nothing is written for an empty chunk.
+  /// \param voxels Voxels of the chunk.
+  /// \throws std::runtime_error if the file cannot be written.
+  void append(const std::vector<VoxelRecord> & voxels);
+
+  /// Get the number of chunks in the file.
+  std::size_t num_chunks() const noexcept {return m_index.size();}
+
+private:
+  void write_footer();
+
+  std::string m_file_name;
+  std::fstream m_file;
+  std::vector<MapChunkIndexEntry> m_index{};
+  uint64_t m_data_end;
+};
+
+/// Reader of a file written by `MapChunkWriter`.
+class POINT_CLOUD_MAPPING_PUBLIC MapChunkReader
+{
+public:
+  /// Open a chunk file and read its index.
+  /// \param file_name Name of the chunk file.
+  /// \throws std::runtime_error if the file cannot be read or is not a valid chunk file.
+  explicit MapChunkReader(const std::string & file_name);
+
+  /// Get the number of chunks in the file.
+  std::size_t num_chunks() const noexcept {return m_index.size();}
+
+  /// Read a chunk.
+  /// \param chunk_idx Index of the chunk, in the order the chunks were appended.
+  /// \return Voxels of the chunk.
+  /// \throws std::out_of_range if there is no such chunk.
+  /// \throws std::runtime_error if the chunk cannot be read.
+  std::vector<VoxelRecord> read_chunk(const std::size_t chunk_idx);
+
+private:
+  std::string m_file_name;
+  std::ifstream m_file;
+  std::vector<MapChunkIndexEntry> m_index{};
+};
+
+/// Write the voxels of a map tile to a file, replacing an existing file. Like a chunk file, the
+/// tile file is only meant to be read on the same architecture.
+/// \param file_name Name of the tile file.
+/// \param voxels Voxels of the tile.
+/// \throws std::runtime_error if the file cannot be written.
+void POINT_CLOUD_MAPPING_PUBLIC write_map_tile(
+  const std::string & file_name, const std::vector<TileVoxelRecord> & voxels);
+
+/// Read a file written by `write_map_tile()`.
+/// \param file_name Name of the tile file.
+/// \return Voxels of the tile.
+/// \throws std::runtime_error if the file cannot be read or is not a valid tile file.
+std::vector<TileVoxelRecord> POINT_CLOUD_MAPPING_PUBLIC read_map_tile(
+  const std::string & file_name);
+
+/// Merge the chunks of a chunk file into one map. A voxel which is in several chunks takes its
+/// centroid from the last one.
+/// \param file_name Name of the chunk file.
+/// \return Point cloud of the voxel centroids, e.g. to write it to a pcd file.
+/// \throws std::runtime_error if the file cannot be read or is not a valid chunk file.
+pcl::PointCloud<pcl::PointXYZI> POINT_CLOUD_MAPPING_PUBLIC compact_map_chunks(
+  const std::string & file_name);
+}  // namespace point_cloud_mapping
+}  // namespace mapping
+}  // namespace autoware
+
+#endif  // POINT_CLOUD_MAPPING__MAP_CHUNK_HPP_
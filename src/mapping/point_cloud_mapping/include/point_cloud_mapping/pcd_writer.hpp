@@ -0,0 +1,86 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#ifndef POINT_CLOUD_MAPPING__PCD_WRITER_HPP_
+#define POINT_CLOUD_MAPPING__PCD_WRITER_HPP_
+
+#include <point_cloud_mapping/visibility_control.hpp>
+#include <common/types.hpp>
+#pragma GCC diagnostic push
+// silence unsafe signed <-> unsigned conversion
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#pragma GCC diagnostic pop
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace autoware
+{
+namespace mapping
+{
+namespace point_cloud_mapping
+{
+/// \brief Writes point clouds to pcd files on a background thread, so that a mapper hands a
+/// snapshot of its map over, e.g. from `DualVoxelMap::snapshot()`, and keeps inserting
+/// observations while the file is written. Clouds are written in the order they were queued.
+class POINT_CLOUD_MAPPING_PUBLIC BackgroundPCDWriter
+{
+public:
+  using PclCloud = pcl::PointCloud<pcl::PointXYZI>;
+
+  /// Constructor, starts the writer thread.
+  BackgroundPCDWriter();
+
+  /// Destructor, writes the queued clouds and stops the writer thread.
+  ~BackgroundPCDWriter();
+
+  BackgroundPCDWriter(const BackgroundPCDWriter &) = delete;
+  BackgroundPCDWriter & operator=(const BackgroundPCDWriter &) = delete;
+
+  /// Queue a cloud to be written.
+  /// \param file_name_prefix File name prefix of the file, ".pcd" is appended.
+  /// \param cloud Cloud to write.
+  void write(const std::string & file_name_prefix, PclCloud && cloud);
+
+  /// Wait until all queued clouds are written.
+  void flush();
+
+  /// Get the number of clouds which could not be written.
+  std::size_t num_failures() const;
+
+private:
+  void run();
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::pair<std::string, PclCloud>> m_pending;
+  std::size_t m_num_failures{0U};
+  common::types::bool8_t m_writing{false};
+  common::types::bool8_t m_stopped{false};
+  std::thread m_thread;
+};
+}  // namespace point_cloud_mapping
+}  // namespace mapping
+}  // namespace autoware
+
+#endif  // POINT_CLOUD_MAPPING__PCD_WRITER_HPP_
@@ -17,6 +17,7 @@
 #ifndef POINT_CLOUD_MAPPING__POINT_CLOUD_MAP_HPP_
 #define POINT_CLOUD_MAPPING__POINT_CLOUD_MAP_HPP_
 
+#include <point_cloud_mapping/map_chunk.hpp>
 #include <point_cloud_mapping/visibility_control.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <voxel_grid/voxel_grid.hpp>
@@ -24,6 +25,7 @@
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
 #include <helper_functions/crtp.hpp>
 #include <helper_functions/template_utils.hpp>
+#include <helper_functions/worker_pool.hpp>
 #include <common/types.hpp>
 #include <time_utils/time_utils.hpp>
 #pragma GCC diagnostic push
@@ -33,6 +35,11 @@
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #include <pcl/io/pcd_io.h>
 #pragma GCC diagnostic pop
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <limits>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -92,32 +99,90 @@ struct LocalizationMapConstraint
   static constexpr Requires value{};
 };
 
+/// Configuration of the tiling of a `DualVoxelMap`. The voxel grid is split into square tiles in
+/// the x-y plane, and the least recently observed tiles are spilled to disk once more than
+/// `max_resident_tiles` of them are in memory. A spilled tile is loaded again when it is observed.
+struct POINT_CLOUD_MAPPING_PUBLIC MapTilingConfig
+{
+  /// Edge length of the tiles, rounded to whole voxels. The map is not tiled if it is 0.
+  float32_t tile_size{0.0F};
+  /// Maximum number of tiles in memory. The tiles of the current observation are always kept.
+  std::size_t max_resident_tiles{9U};
+  /// Existing directory the tiles are spilled to, one file per tile. It must not be shared with
+  /// another map.
+  std::string spill_directory{"."};
+};
+
 /// A map that accumulates lidar scans in a downsampled format using a voxel grid.
 /// A voxel grid is used for accumulating the lidar scans in a downsampled manner. A separate
 /// map is stored for the localizer implementation. The expected interface is defined via the
 /// `Requires` keyword.
+///
+/// The voxel grid is split into partitions keyed by the voxel index, so that an observation can
+/// be inserted into the partitions in parallel. Since every voxel is only updated by the worker of
+/// its partition, in the order of the observation, the parallel update gives the same map as the
+/// serial one.
+///
+/// With a `MapTilingConfig`, only the recently observed tiles of the voxel grid are kept in memory.
+/// The localizer map is rebuilt from their voxel centroids whenever a tile is spilled, so that
+/// neither the memory nor the cost of an update grows with the size of the mapped area.
 template<typename LocalizerMapT, Requires = LocalizationMapConstraint<LocalizerMapT>::value>
 class POINT_CLOUD_MAPPING_PUBLIC DualVoxelMap
 {
 public:
   static constexpr auto NUM_FIELDS{4U};
   using Cloud = sensor_msgs::msg::PointCloud2;
+  using PclCloud = pcl::PointCloud<pcl::PointXYZI>;
 
   /// Constructor
   /// \param grid_config Grid configuration of the underlying voxel grid.
   /// \param frame_id Frame id of the map.
   /// \param localizer_map Localizer map to be stored.
+  /// \param num_threads Number of threads inserting an observation into the voxel grid. With more
+  /// than one thread, the localizer map is updated concurrently on an additional thread. The
+  /// threads are started once, here.
+  /// \param tiling_config Tiling of the voxel grid, which is not tiled by default.
   explicit DualVoxelMap(
     const perception::filters::voxel_grid::Config & grid_config,
     const std::string & frame_id,
-    LocalizerMapT && localizer_map
+    LocalizerMapT && localizer_map,
+    const std::size_t num_threads = 1U,
+    const MapTilingConfig & tiling_config = MapTilingConfig{}
   )
-  : m_grid_config{grid_config}, m_frame_id{frame_id},
-    m_localizer_map{std::forward<LocalizerMapT>(localizer_map)} {}
+  : m_grid_config{grid_config}, m_partitions(std::max(num_threads, std::size_t{1U})),
+    m_workers((num_threads > 1U) ? (num_threads + 1U) : 1U),
+    m_frame_id{frame_id},
+    m_localizer_map{std::forward<LocalizerMapT>(localizer_map)},
+    m_tiling_config{tiling_config}
+  {
+    if (tiled()) {
+      const auto & voxel_size = m_grid_config.get_voxel_size();
+      const auto tile_voxels = [this](const float32_t voxel_length) {
+          return std::max(
+            uint64_t{1U},
+            static_cast<uint64_t>(std::lround(m_tiling_config.tile_size / voxel_length)));
+        };
+      m_tile_voxels_x = tile_voxels(voxel_size.x);
+      m_tile_voxels_y = tile_voxels(voxel_size.y);
+      m_num_tiles_x = (m_grid_config.get_y_stride() + m_tile_voxels_x - 1U) / m_tile_voxels_x;
+    }
+  }
+
+  // The spilled tiles belong to one map
+  DualVoxelMap(const DualVoxelMap &) = delete;
+  DualVoxelMap & operator=(const DualVoxelMap &) = delete;
+
+  /// Destructor, removing the files of the spilled tiles.
+  ~DualVoxelMap()
+  {
+    remove_spilled_tiles();
+  }
 
-  /// Try to extend the map with the given point cloud.
+  /// Try to extend the map with the given point cloud. If the map is tiled, the spilled tiles of
+  /// the observation are loaded first.
   /// \param observation Point cloud in the "map" frame to add to the map.
   /// \return A struct summarizing the outcome of the insertion attempt.
+  /// \throw std::runtime_error if a tile cannot be spilled or loaded.
   MapUpdateSummary update(const Cloud & observation)
   {
     if (observation.header.frame_id != m_frame_id) {
@@ -126,30 +191,106 @@ public:
 
     MapUpdateSummary ret{MapUpdateType::NO_CHANGE, 0U};
 
-    using PointXYZI = autoware::common::types::PointXYZI;
     point_cloud_msg_wrapper::PointCloud2View<PointXYZI> observation_view{observation};
 
-    ret.update_type = m_grid.empty() ? MapUpdateType::NEW : MapUpdateType::UPDATE;
-    auto obs_idx = 0U;
-    for (const auto & pt : observation_view) {
-      const auto pt_key = m_grid_config.index(pt);
-      if (m_grid.size() >= capacity() &&
-        m_grid.find(pt_key) == m_grid.end())
-      {
-        if (obs_idx == 0U) {
-          ret.update_type = MapUpdateType::NO_CHANGE;
-        } else {
-          ret.update_type = MapUpdateType::PARTIAL_UPDATE;
+    ret.update_type = empty() ? MapUpdateType::NEW : MapUpdateType::UPDATE;
+    if (tiled()) {
+      update_tiles(observation_view);
+    }
+    if (m_partitions.size() == 1U) {
+      ret.num_added_pts = update_grid(observation_view, ret.update_type);
+      m_localizer_map.insert(observation);
+      return ret;
+    }
+
+    // The capacity can only be reached within an observation that does not fit in the map.
+    // Then the points have to be inserted in order to know which ones are dropped.
+    if (size() + observation_view.size() <= capacity()) {
+      update_partitions(observation, observation_view);
+      ret.num_added_pts = observation_view.size();
+    } else {
+      // Task 0 updates the localizer map, task 1 the voxel grid
+      m_workers.run(
+        2U, [this, &observation, &observation_view, &ret](
+          const std::size_t task, const std::size_t) {
+          if (0U == task) {
+            m_localizer_map.insert(observation);
+          } else {
+            ret.num_added_pts = update_grid(observation_view, ret.update_type);
+          }
+        });
+    }
+    return ret;
+  }
+
+  /// Copy the voxel grid into a point cloud, e.g. to write it on another thread while the map
+  /// keeps being updated. The spilled tiles are read for it.
+  /// \return Point cloud of the voxel centroids.
+  /// \throw std::runtime_error if a spilled tile cannot be read.
+  PclCloud snapshot() const
+  {
+    // pcl cloud is constructed here and the map is copied to it for sake
+    // of simplicity to be able to use the pcl library's pcd writer.
+    PclCloud cloud;
+    cloud.reserve(size());
+    for (const auto & partition : m_partitions) {
+      for (const auto & vx : partition.grid) {
+        pcl::PointXYZI pt;
+        const auto & vx_pt = vx.second.voxel.get();
+        pt.x = vx_pt.x;
+        pt.y = vx_pt.y;
+        pt.z = vx_pt.z;
+        pt.intensity = vx_pt.intensity;
+        cloud.push_back(pt);
+      }
+    }
+    for (const auto & tile : m_tiles) {
+      if (!tile.second.resident) {
+        for (const auto & record : read_map_tile(tile_file_name(tile.first))) {
+          pcl::PointXYZI pt;
+          pt.x = record.voxel.x;
+          pt.y = record.voxel.y;
+          pt.z = record.voxel.z;
+          pt.intensity = record.voxel.intensity;
+          cloud.push_back(pt);
         }
-        break;
       }
-      m_grid[pt_key].add_observation(pt);
-      ++obs_idx;
     }
+    return cloud;
+  }
 
-    m_localizer_map.insert(observation);
-    ret.num_added_pts = obs_idx;
-    return ret;
+  /// Get the voxels which changed since the last call, e.g. to append them to a map chunk file
+  /// (see `MapChunkWriter`), and reset their change flags. Clearing the map drops the changes.
+  /// \return Records of the changed voxels with their current centroids, including the ones of
+  /// the spilled tiles.
+  /// \throw std::runtime_error if a spilled tile cannot be read or written.
+  std::vector<VoxelRecord> take_changes()
+  {
+    std::vector<VoxelRecord> records;
+    for (auto & partition : m_partitions) {
+      for (const auto key : partition.changed_keys) {
+        auto & tracked_voxel = partition.grid.at(key);
+        const auto & vx_pt = tracked_voxel.voxel.get();
+        records.push_back(VoxelRecord{key, vx_pt.x, vx_pt.y, vx_pt.z, vx_pt.intensity});
+        tracked_voxel.changed = false;
+      }
+      partition.changed_keys.clear();
+    }
+    for (auto & tile : m_tiles) {
+      if (!tile.second.resident && tile.second.has_changes) {
+        const auto file_name = tile_file_name(tile.first);
+        auto voxels = read_map_tile(file_name);
+        for (auto & record : voxels) {
+          if (record.changed != 0U) {
+            records.push_back(record.voxel);
+            record.changed = 0U;
+          }
+        }
+        write_map_tile(file_name, voxels);
+        tile.second.has_changes = false;
+      }
+    }
+    return records;
   }
 
   /// Convert the voxel grid to a point cloud and write it to a pcd file.
@@ -157,36 +298,30 @@ public:
   void write(const std::string & file_name_prefix) const
   {
     // TODO(yunus.caliskan) Remove dynamic allocations.
-    // pcl cloud is constructed here and the map is copied to it for sake
-    // of simplicity to be able to use the pcl library's pcd writer.
-    pcl::PointCloud<pcl::PointXYZI> cloud;
-    cloud.reserve(m_grid.size());
-    for (const auto & vx : m_grid) {
-      pcl::PointXYZI pt;
-      const auto & vx_pt = vx.second.get();
-      pt.x = vx_pt.x;
-      pt.y = vx_pt.y;
-      pt.z = vx_pt.z;
-      pt.intensity = vx_pt.intensity;
-      cloud.push_back(pt);
-    }
-    pcl::io::savePCDFile(file_name_prefix + ".pcd", cloud);
+    pcl::io::savePCDFile(file_name_prefix + ".pcd", snapshot());
   }
 
-  /// Size of the voxel grid.
+  /// Size of the voxel grid, without the spilled tiles.
   std::size_t size() const noexcept
   {
-    return m_grid.size();
+    return m_size;
   }
   /// Capacity of the voxel grid.
   std::size_t capacity() const noexcept
   {
     return m_grid_config.get_capacity();
   }
-  /// Clear the voxel grid.
+  /// Clear the voxel grid, including the spilled tiles.
   void clear()
   {
-    m_grid.clear();
+    for (auto & partition : m_partitions) {
+      partition.grid.clear();
+      partition.changed_keys.clear();
+    }
+    m_size = 0U;
+    remove_spilled_tiles();
+    m_tiles.clear();
+    m_num_resident_tiles = 0U;
     m_localizer_map.clear();
   }
   /// Get the localizer map
@@ -203,15 +338,344 @@ public:
   /// Get if the map is empty
   bool empty()
   {
-    return m_grid.empty();
+    return (m_size == 0U) && (m_num_resident_tiles == m_tiles.size());
   }
 
 private:
+  using PointXYZI = autoware::common::types::PointXYZI;
+  using View = point_cloud_msg_wrapper::PointCloud2View<PointXYZI>;
+  /// Centroid voxel which can be restored from a spilled tile.
+  class SpillableVoxel : public perception::filters::voxel_grid::CentroidVoxel<PointXYZI>
+  {
+  public:
+    void restore(const PointXYZI & centroid, const uint32_t count)
+    {
+      this->set_centroid(centroid);
+      this->set_count(count);
+    }
+  };
+
+  /// Voxel with a flag telling if it changed since the last `take_changes()`.
+  struct TrackedVoxel
+  {
+    SpillableVoxel voxel;
+    common::types::bool8_t changed{false};
+  };
+
+  /// State of a tile, whose voxels are either in the partitions or in its file.
+  struct Tile
+  {
+    /// Number of the last update observing the tile.
+    std::size_t last_used{0U};
+    common::types::bool8_t resident{true};
+    /// If a voxel in the file changed since the last `take_changes()`.
+    common::types::bool8_t has_changes{false};
+  };
+
+  /// Point of an observation with the key of its voxel.
+  struct KeyedPoint
+  {
+    uint64_t key;
+    PointXYZI pt;
+  };
+
+  /// Voxels of a partition and the keys of the changed ones, in the order they changed.
+  struct Partition
+  {
+    std::unordered_map<uint64_t, TrackedVoxel> grid;
+    std::vector<uint64_t> changed_keys;
+    /// Points of the current observation in this partition, in the order of the observation.
+    std::vector<KeyedPoint> observed;
+
+    /// Add a point to a voxel and record the change.
+    void add_observation(const uint64_t voxel_key, const PointXYZI & pt)
+    {
+      auto & tracked_voxel = grid[voxel_key];
+      tracked_voxel.voxel.add_observation(pt);
+      if (!tracked_voxel.changed) {
+        tracked_voxel.changed = true;
+        changed_keys.push_back(voxel_key);
+      }
+    }
+  };
+
+  /// Get the partition of a voxel.
+  Partition & partition(const uint64_t voxel_key)
+  {
+    return m_partitions[voxel_key % m_partitions.size()];
+  }
+
+  /// Insert the points of an observation in order until the capacity is reached.
+  /// \param observation_view Points to insert.
+  /// \param update_type Type of the update, changed if the capacity is reached.
+  /// \return Number of inserted points.
+  std::size_t update_grid(const View & observation_view, MapUpdateType & update_type)
+  {
+    auto obs_idx = 0U;
+    for (const auto & pt : observation_view) {
+      const auto pt_key = m_grid_config.index(pt);
+      auto & voxel_partition = partition(pt_key);
+      if (m_size >= capacity() &&
+        voxel_partition.grid.find(pt_key) == voxel_partition.grid.end())
+      {
+        if (obs_idx == 0U) {
+          update_type = MapUpdateType::NO_CHANGE;
+        } else {
+          update_type = MapUpdateType::PARTIAL_UPDATE;
+        }
+        break;
+      }
+      const auto grid_size = voxel_partition.grid.size();
+      voxel_partition.add_observation(pt_key, pt);
+      m_size += voxel_partition.grid.size() - grid_size;
+      ++obs_idx;
+    }
+    return obs_idx;
+  }
+
+  /// Insert all points of an observation, each partition on its own worker, while the localizer
+  /// map is updated on another one.
+  /// \param observation Observation to insert into the localizer map.
+  /// \param observation_view Points to insert, which must fit into the map.
+  void update_partitions(const Cloud & observation, const View & observation_view)
+  {
+    // The voxel of each point is found once, and the point handed to the partition of the voxel
+    const auto num_partitions = m_partitions.size();
+    for (auto & voxel_partition : m_partitions) {
+      voxel_partition.observed.clear();
+    }
+    for (const auto & pt : observation_view) {
+      const auto pt_key = m_grid_config.index(pt);
+      m_partitions[pt_key % num_partitions].observed.push_back(KeyedPoint{pt_key, pt});
+    }
+    try {
+      // Task 0 updates the localizer map, task i > 0 the partition i - 1
+      m_workers.run(
+        num_partitions + 1U, [this, &observation](const std::size_t task, const std::size_t) {
+          if (0U == task) {
+            m_localizer_map.insert(observation);
+          } else {
+            auto & voxel_partition = m_partitions[task - 1U];
+            for (const auto & keyed_pt : voxel_partition.observed) {
+              voxel_partition.add_observation(keyed_pt.key, keyed_pt.pt);
+            }
+          }
+        });
+    } catch (...) {
+      count_voxels();
+      throw;
+    }
+    count_voxels();
+  }
+
+  /// Recompute the size of the map from the partitions.
+  void count_voxels()
+  {
+    m_size = 0U;
+    for (const auto & voxel_partition : m_partitions) {
+      m_size += voxel_partition.grid.size();
+    }
+  }
+
+  common::types::bool8_t tiled() const noexcept
+  {
+    return m_tiling_config.tile_size > 0.0F;
+  }
+
+  /// Get the tile of a voxel from its x and y index.
+  uint64_t tile_key(const uint64_t voxel_key) const
+  {
+    const auto y_stride = m_grid_config.get_y_stride();
+    const auto xdx = voxel_key % y_stride;
+    const auto ydx = (voxel_key % m_grid_config.get_z_stride()) / y_stride;
+    return (xdx / m_tile_voxels_x) + ((ydx / m_tile_voxels_y) * m_num_tiles_x);
+  }
+
+  std::string tile_file_name(const uint64_t tile_key) const
+  {
+    return m_tiling_config.spill_directory + "/tile_" + std::to_string(tile_key) + ".bin";
+  }
+
+  /// Load the spilled tiles of an observation and spill the least recently observed tiles beyond
+  /// the maximum number of resident ones. The localizer map is rebuilt from the resident voxels if
+  /// a tile was spilled, otherwise the loaded voxels are inserted into it.
+  /// \param observation_view Points of the observation.
+  void update_tiles(const View & observation_view)
+  {
+    ++m_num_tile_updates;
+    std::vector<uint64_t> loaded_tiles;
+    auto previous_key = std::numeric_limits<uint64_t>::max();
+    for (const auto & pt : observation_view) {
+      const auto key = tile_key(m_grid_config.index(pt));
+      // Consecutive points are mostly in the same tile
+      if (key == previous_key) {
+        continue;
+      }
+      previous_key = key;
+      const auto inserted = m_tiles.emplace(key, Tile{});
+      auto & tile = inserted.first->second;
+      if (tile.last_used == m_num_tile_updates) {
+        continue;
+      }
+      tile.last_used = m_num_tile_updates;
+      if (inserted.second) {
+        ++m_num_resident_tiles;
+      } else if (!tile.resident) {
+        loaded_tiles.push_back(key);
+      }
+    }
+
+    Cloud loaded;
+    point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> loaded_modifier{loaded, m_frame_id};
+    for (const auto key : loaded_tiles) {
+      load_tile(key, loaded_modifier);
+    }
+    if (spill_tiles() > 0U) {
+      Cloud resident;
+      point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> resident_modifier{resident,
+        m_frame_id};
+      resident_modifier.reserve(m_size);
+      for (const auto & voxel_partition : m_partitions) {
+        for (const auto & vx : voxel_partition.grid) {
+          resident_modifier.push_back(vx.second.voxel.get());
+        }
+      }
+      m_localizer_map.clear();
+      if (resident_modifier.size() > 0U) {
+        m_localizer_map.insert(resident);
+      }
+    } else if (loaded_modifier.size() > 0U) {
+      m_localizer_map.insert(loaded);
+    }
+  }
+
+  /// Move the voxels of a spilled tile from its file into the partitions.
+  /// \param key Key of the tile.
+  /// \param modifier Modifier to append the loaded voxel centroids to.
+  void load_tile(
+    const uint64_t key, point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> & modifier)
+  {
+    const auto file_name = tile_file_name(key);
+    for (const auto & record : read_map_tile(file_name)) {
+      const PointXYZI pt{record.voxel.x, record.voxel.y, record.voxel.z, record.voxel.intensity};
+      auto & voxel_partition = partition(record.voxel.key);
+      auto & tracked_voxel = voxel_partition.grid[record.voxel.key];
+      tracked_voxel.voxel.restore(pt, record.count);
+      if (record.changed != 0U) {
+        tracked_voxel.changed = true;
+        voxel_partition.changed_keys.push_back(record.voxel.key);
+      }
+      modifier.push_back(pt);
+      ++m_size;
+    }
+    (void) std::remove(file_name.c_str());
+    auto & tile = m_tiles.at(key);
+    tile.resident = true;
+    tile.has_changes = false;
+    ++m_num_resident_tiles;
+  }
+
+  /// Spill the least recently observed tiles until at most the maximum number of tiles is in
+  /// memory. The tiles of the current observation are not spilled.
+  /// \return Number of spilled tiles.
+  std::size_t spill_tiles()
+  {
+    if (m_num_resident_tiles <= m_tiling_config.max_resident_tiles) {
+      return 0U;
+    }
+    // Last use and key of the tiles which may be spilled
+    std::vector<std::pair<std::size_t, uint64_t>> candidates;
+    for (const auto & tile : m_tiles) {
+      if (tile.second.resident && (tile.second.last_used < m_num_tile_updates)) {
+        candidates.emplace_back(tile.second.last_used, tile.first);
+      }
+    }
+    const auto num_spilled = std::min(
+      m_num_resident_tiles - m_tiling_config.max_resident_tiles, candidates.size());
+    if (num_spilled == 0U) {
+      return 0U;
+    }
+    const auto spilled_end = candidates.begin() + static_cast<std::ptrdiff_t>(num_spilled);
+    std::partial_sort(candidates.begin(), spilled_end, candidates.end());
+    std::unordered_map<uint64_t, std::vector<TileVoxelRecord>> spilled;
+    for (auto it = candidates.begin(); it != spilled_end; ++it) {
+      (void) spilled[it->second];
+    }
+
+    for (const auto & voxel_partition : m_partitions) {
+      for (const auto & vx : voxel_partition.grid) {
+        const auto spilled_it = spilled.find(tile_key(vx.first));
+        if (spilled_it != spilled.end()) {
+          const auto & vx_pt = vx.second.voxel.get();
+          spilled_it->second.push_back(
+            TileVoxelRecord{VoxelRecord{vx.first, vx_pt.x, vx_pt.y, vx_pt.z, vx_pt.intensity},
+              vx.second.voxel.count(), vx.second.changed ? 1U : 0U});
+        }
+      }
+    }
+    // The files are written before the voxels are removed, so that a failed write loses nothing
+    for (const auto & tile : spilled) {
+      if (!tile.second.empty()) {
+        write_map_tile(tile_file_name(tile.first), tile.second);
+      }
+    }
+    const auto is_spilled = [this, &spilled](const uint64_t voxel_key) {
+        return spilled.find(tile_key(voxel_key)) != spilled.end();
+      };
+    for (auto & voxel_partition : m_partitions) {
+      for (auto it = voxel_partition.grid.begin(); it != voxel_partition.grid.end(); ) {
+        if (is_spilled(it->first)) {
+          it = voxel_partition.grid.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      auto & changed_keys = voxel_partition.changed_keys;
+      changed_keys.erase(
+        std::remove_if(changed_keys.begin(), changed_keys.end(), is_spilled), changed_keys.end());
+    }
+    for (const auto & tile : spilled) {
+      m_size -= tile.second.size();
+      --m_num_resident_tiles;
+      if (tile.second.empty()) {
+        // Nothing to load again, e.g. if all points of the tile were beyond the capacity
+        (void) m_tiles.erase(tile.first);
+      } else {
+        auto & state = m_tiles.at(tile.first);
+        state.resident = false;
+        state.has_changes = std::any_of(
+          tile.second.begin(), tile.second.end(),
+          [](const TileVoxelRecord & record) {return record.changed != 0U;});
+      }
+    }
+    return num_spilled;
+  }
+
+  void remove_spilled_tiles() noexcept
+  {
+    for (const auto & tile : m_tiles) {
+      if (!tile.second.resident) {
+        (void) std::remove(tile_file_name(tile.first).c_str());
+      }
+    }
+  }
+
   perception::filters::voxel_grid::Config m_grid_config;
-  std::unordered_map<uint64_t,
-    perception::filters::voxel_grid::CentroidVoxel<common::types::PointXYZI>> m_grid;
+  std::vector<Partition> m_partitions;
+  // Workers of the partitions and of the localizer map
+  common::helper_functions::WorkerPool m_workers;
+  std::size_t m_size{0U};
   std::string m_frame_id;
   LocalizerMapT m_localizer_map;
+  MapTilingConfig m_tiling_config;
+  // Tile size in voxels along x and y, and the number of tiles along x
+  uint64_t m_tile_voxels_x{1U};
+  uint64_t m_tile_voxels_y{1U};
+  uint64_t m_num_tiles_x{1U};
+  std::unordered_map<uint64_t, Tile> m_tiles;
+  std::size_t m_num_resident_tiles{0U};
+  // Number of updates of a tiled map, for finding the least recently observed tiles
+  std::size_t m_num_tile_updates{0U};
 };
 }  // namespace point_cloud_mapping
 }  // namespace mapping
@@ -0,0 +1,250 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <point_cloud_mapping/map_chunk.hpp>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace mapping
+{
+namespace point_cloud_mapping
+{
+namespace
+{
+constexpr char kMapChunkMagic[8U] = {'P', 'C', 'M', 'C', 'H', 'N', 'K', '\0'};
+constexpr char kMapChunkIndexMagic[8U] = {'P', 'C', 'M', 'I', 'N', 'D', 'X', '\0'};
+constexpr uint32_t kMapChunkVersion = 1U;
+constexpr char kMapTileMagic[8U] = {'P', 'C', 'M', 'T', 'I', 'L', 'E', '\0'};
+constexpr uint32_t kMapTileVersion = 1U;
+
+struct MapChunkHeader
+{
+  char magic[8U];
+  uint32_t version;
+  uint32_t record_size;
+};
+
+struct MapTileHeader
+{
+  char magic[8U];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t num_voxels;
+};
+
+/// Last bytes of the file, after the index entries.
+struct MapChunkTrailer
+{
+  uint64_t num_chunks;
+  char magic[8U];
+};
+
+template<typename T>
+void write_raw(std::ostream & stream, const T * const data, const std::size_t count)
+{
+  (void) stream.write(
+    reinterpret_cast<const char *>(data), static_cast<std::streamsize>(sizeof(T) * count));
+}
+
+template<typename T>
+void read_raw(std::istream & stream, T * const data, const std::size_t count)
+{
+  (void) stream.read(
+    reinterpret_cast<char *>(data), static_cast<std::streamsize>(sizeof(T) * count));
+}
+}  // namespace
+
+MapChunkWriter::MapChunkWriter(const std::string & file_name)
+: m_file_name{file_name},
+  m_file{file_name, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc},
+  m_data_end{sizeof(MapChunkHeader)}
+{
+  MapChunkHeader header{};
+  std::copy(std::begin(kMapChunkMagic), std::end(kMapChunkMagic), std::begin(header.magic));
+  header.version = kMapChunkVersion;
+  header.record_size = static_cast<uint32_t>(sizeof(VoxelRecord));
+  write_raw(m_file, &header, 1U);
+  write_footer();
+}
+
+void MapChunkWriter::append(const std::vector<VoxelRecord> & voxels)
+{
+  if (voxels.empty()) {
+    return;
+  }
+  // The records replace the old footer. The file only grows, so no stale bytes remain at its end.
+  (void) m_file.seekp(static_cast<std::streamoff>(m_data_end));
+  write_raw(m_file, voxels.data(), voxels.size());
+  m_index.push_back(MapChunkIndexEntry{m_data_end, voxels.size()});
+  m_data_end += sizeof(VoxelRecord) * voxels.size();
+  write_footer();
+}
+
+void MapChunkWriter::write_footer()
+{
+  (void) m_file.seekp(static_cast<std::streamoff>(m_data_end));
+  write_raw(m_file, m_index.data(), m_index.size());
+  MapChunkTrailer trailer{};
+  trailer.num_chunks = m_index.size();
+  std::copy(
+    std::begin(kMapChunkIndexMagic), std::end(kMapChunkIndexMagic), std::begin(trailer.magic));
+  write_raw(m_file, &trailer, 1U);
+  (void) m_file.flush();
+  if (!m_file) {
+    throw std::runtime_error(
+            std::string("Map chunk file ") + m_file_name + " could not be written.");
+  }
+}
+
+MapChunkReader::MapChunkReader(const std::string & file_name)
+: m_file_name{file_name}, m_file{file_name, std::ios::binary}
+{
+  if (!m_file) {
+    throw std::runtime_error(std::string("Map chunk file ") + file_name + " could not be opened.");
+  }
+  const auto invalid = [&file_name]() {
+      return std::runtime_error(std::string("Map chunk file ") + file_name + " is not valid.");
+    };
+  (void) m_file.seekg(0, std::ios::end);
+  const auto file_size = static_cast<uint64_t>(m_file.tellg());
+  if (file_size < (sizeof(MapChunkHeader) + sizeof(MapChunkTrailer))) {
+    throw invalid();
+  }
+
+  MapChunkHeader header{};
+  (void) m_file.seekg(0, std::ios::beg);
+  read_raw(m_file, &header, 1U);
+  MapChunkTrailer trailer{};
+  (void) m_file.seekg(static_cast<std::streamoff>(file_size - sizeof(trailer)));
+  read_raw(m_file, &trailer, 1U);
+  if (!m_file ||
+    !std::equal(std::begin(kMapChunkMagic), std::end(kMapChunkMagic), std::begin(header.magic)) ||
+    (header.version != kMapChunkVersion) || (header.record_size != sizeof(VoxelRecord)) ||
+    !std::equal(
+      std::begin(kMapChunkIndexMagic), std::end(kMapChunkIndexMagic), std::begin(trailer.magic)))
+  {
+    throw invalid();
+  }
+
+  const auto max_num_chunks =
+    (file_size - sizeof(MapChunkHeader) - sizeof(MapChunkTrailer)) / sizeof(MapChunkIndexEntry);
+  if (trailer.num_chunks > max_num_chunks) {
+    throw invalid();
+  }
+  const auto index_offset =
+    file_size - sizeof(MapChunkTrailer) - (trailer.num_chunks * sizeof(MapChunkIndexEntry));
+  m_index.resize(trailer.num_chunks);
+  (void) m_file.seekg(static_cast<std::streamoff>(index_offset));
+  read_raw(m_file, m_index.data(), m_index.size());
+  if (!m_file) {
+    throw invalid();
+  }
+  // All chunks have to lie between the header and the index
+  for (const auto & entry : m_index) {
+    if ((entry.offset < sizeof(MapChunkHeader)) || (entry.offset > index_offset) ||
+      (entry.num_voxels > ((index_offset - entry.offset) / sizeof(VoxelRecord))))
+    {
+      throw invalid();
+    }
+  }
+}
+
+std::vector<VoxelRecord> MapChunkReader::read_chunk(const std::size_t chunk_idx)
+{
+  const auto & entry = m_index.at(chunk_idx);
+  std::vector<VoxelRecord> voxels(entry.num_voxels);
+  (void) m_file.seekg(static_cast<std::streamoff>(entry.offset));
+  read_raw(m_file, voxels.data(), voxels.size());
+  if (!m_file) {
+    throw std::runtime_error(std::string("Map chunk file ") + m_file_name + " could not be read.");
+  }
+  return voxels;
+}
+
+void write_map_tile(const std::string & file_name, const std::vector<TileVoxelRecord> & voxels)
+{
+  std::ofstream file{file_name, std::ios::binary | std::ios::trunc};
+  MapTileHeader header{};
+  std::copy(std::begin(kMapTileMagic), std::end(kMapTileMagic), std::begin(header.magic));
+  header.version = kMapTileVersion;
+  header.record_size = static_cast<uint32_t>(sizeof(TileVoxelRecord));
+  header.num_voxels = voxels.size();
+  write_raw(file, &header, 1U);
+  write_raw(file, voxels.data(), voxels.size());
+  (void) file.flush();
+  if (!file) {
+    throw std::runtime_error(std::string("Map tile file ") + file_name + " could not be written.");
+  }
+}
+
+std::vector<TileVoxelRecord> read_map_tile(const std::string & file_name)
+{
+  std::ifstream file{file_name, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error(std::string("Map tile file ") + file_name + " could not be opened.");
+  }
+  (void) file.seekg(0, std::ios::end);
+  const auto file_size = static_cast<uint64_t>(file.tellg());
+  MapTileHeader header{};
+  (void) file.seekg(0, std::ios::beg);
+  read_raw(file, &header, 1U);
+  if (!file || (file_size < sizeof(MapTileHeader)) ||
+    !std::equal(std::begin(kMapTileMagic), std::end(kMapTileMagic), std::begin(header.magic)) ||
+    (header.version != kMapTileVersion) || (header.record_size != sizeof(TileVoxelRecord)) ||
+    (header.num_voxels != ((file_size - sizeof(MapTileHeader)) / sizeof(TileVoxelRecord))))
+  {
+    throw std::runtime_error(std::string("Map tile file ") + file_name + " is not valid.");
+  }
+  std::vector<TileVoxelRecord> voxels(header.num_voxels);
+  read_raw(file, voxels.data(), voxels.size());
+  if (!file) {
+    throw std::runtime_error(std::string("Map tile file ") + file_name + " could not be read.");
+  }
+  return voxels;
+}
+
+pcl::PointCloud<pcl::PointXYZI> compact_map_chunks(const std::string & file_name)
+{
+  MapChunkReader reader{file_name};
+  // Ordered by the voxel key, so that the compacted map does not depend on the chunking
+  std::map<uint64_t, VoxelRecord> voxels;
+  for (std::size_t chunk_idx = 0U; chunk_idx < reader.num_chunks(); ++chunk_idx) {
+    for (const auto & voxel : reader.read_chunk(chunk_idx)) {
+      voxels[voxel.key] = voxel;
+    }
+  }
+  pcl::PointCloud<pcl::PointXYZI> cloud;
+  cloud.reserve(voxels.size());
+  for (const auto & voxel : voxels) {
+    pcl::PointXYZI pt;
+    pt.x = voxel.second.x;
+    pt.y = voxel.second.y;
+    pt.z = voxel.second.z;
+    pt.intensity = voxel.second.intensity;
+    cloud.push_back(pt);
+  }
+  return cloud;
+}
+
+}  // namespace point_cloud_mapping
+}  // namespace mapping
+}  // namespace autoware
@@ -0,0 +1,102 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <point_cloud_mapping/pcd_writer.hpp>
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#include <pcl/io/pcd_io.h>
+#pragma GCC diagnostic pop
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace autoware
+{
+namespace mapping
+{
+namespace point_cloud_mapping
+{
+BackgroundPCDWriter::BackgroundPCDWriter()
+: m_thread{[this] {run();}}
+{
+}
+
+BackgroundPCDWriter::~BackgroundPCDWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_stopped = true;
+  }
+  m_condition.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+void BackgroundPCDWriter::write(const std::string & file_name_prefix, PclCloud && cloud)
+{
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_pending.emplace_back(file_name_prefix, std::move(cloud));
+  }
+  m_condition.notify_all();
+}
+
+void BackgroundPCDWriter::flush()
+{
+  std::unique_lock<std::mutex> lock{m_mutex};
+  m_condition.wait(lock, [this] {return m_pending.empty() && !m_writing;});
+}
+
+std::size_t BackgroundPCDWriter::num_failures() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_num_failures;
+}
+
+void BackgroundPCDWriter::run()
+{
+  std::unique_lock<std::mutex> lock{m_mutex};
+  while (true) {
+    // Queued clouds are still written when stopped, the map would be lost otherwise
+    m_condition.wait(lock, [this] {return m_stopped || !m_pending.empty();});
+    if (m_pending.empty()) {
+      return;
+    }
+    auto job = std::move(m_pending.front());
+    m_pending.pop_front();
+    m_writing = true;
+    lock.unlock();
+    auto failed = true;
+    try {
+      failed = (pcl::io::savePCDFile(job.first + ".pcd", job.second) != 0);
+    } catch (const std::exception &) {
+      // Counted as a failure, an exception must not end the writer thread
+    }
+    lock.lock();
+    m_writing = false;
+    if (failed) {
+      ++m_num_failures;
+    }
+    m_condition.notify_all();
+  }
+}
+
+}  // namespace point_cloud_mapping
+}  // namespace mapping
+}  // namespace autoware
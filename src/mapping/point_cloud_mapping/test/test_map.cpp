@@ -19,19 +19,32 @@
 
 #include "test_map.hpp"
 
+#include <point_cloud_mapping/double_buffered_map.hpp>
+#include <point_cloud_mapping/map_chunk.hpp>
+#include <point_cloud_mapping/pcd_writer.hpp>
 #include <point_cloud_mapping/point_cloud_map.hpp>
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <limits>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
+using autoware::common::types::float32_t;
+using autoware::mapping::point_cloud_mapping::BackgroundPCDWriter;
+using autoware::mapping::point_cloud_mapping::DoubleBufferedMap;
 using autoware::mapping::point_cloud_mapping::DummyLocalizationMap;
+using autoware::mapping::point_cloud_mapping::MapChunkReader;
+using autoware::mapping::point_cloud_mapping::MapChunkWriter;
+using autoware::mapping::point_cloud_mapping::MapTilingConfig;
 using autoware::mapping::point_cloud_mapping::MapUpdateType;
 using autoware::mapping::point_cloud_mapping::PclCloud;
 using autoware::mapping::point_cloud_mapping::VoxelMapContext;
+using autoware::mapping::point_cloud_mapping::VoxelRecord;
 using autoware::mapping::point_cloud_mapping::DualVoxelMap;
 
 class VoxelMapTest : public ::testing::Test, public VoxelMapContext {};
@@ -93,6 +106,207 @@ TEST_F(VoxelMapTest, BasicIo) {
   EXPECT_THROW(add_update(2U, MapUpdateType::NEW, false_frame), std::runtime_error);
 }
 
+TEST_F(VoxelMapTest, ParallelUpdate) {
+  constexpr auto map_frame = "map";
+  constexpr auto capacity = 12U;
+  const auto grid_config = autoware::perception::filters::voxel_grid::Config(
+    m_min_point, m_max_point, m_voxel_size, capacity);
+
+  DualVoxelMap<DummyLocalizationMap> serial_map{grid_config, map_frame, DummyLocalizationMap{}};
+  DualVoxelMap<DummyLocalizationMap> parallel_map{grid_config, map_frame,
+    DummyLocalizationMap{}, 3U};
+
+  auto map_size = 0U;
+  // The points of the first two updates fit into the map and are inserted in parallel, the last
+  // update reaches the capacity and is inserted serially.
+  for (const auto num_cells : {1U, 1U, 15U}) {
+    const auto pc = autoware::mapping::point_cloud_mapping::make_pc_deviated(
+      num_cells, map_size, map_frame, FIXED_DEVIATION);
+    const auto serial_summary = serial_map.update(pc);
+    const auto parallel_summary = parallel_map.update(pc);
+    EXPECT_EQ(parallel_summary.update_type, serial_summary.update_type);
+    EXPECT_EQ(parallel_summary.num_added_pts, serial_summary.num_added_pts);
+    EXPECT_EQ(parallel_map.size(), serial_map.size());
+    map_size = static_cast<uint32_t>(serial_map.size());
+  }
+  EXPECT_EQ(parallel_map.size(), capacity);
+  auto cloud = parallel_map.snapshot();
+  autoware::mapping::point_cloud_mapping::check_pc(cloud, capacity);
+}
+
+TEST_F(VoxelMapTest, BackgroundWrite) {
+  constexpr auto map_frame = "map";
+  constexpr auto map_size = 5U;
+  const auto grid_config = autoware::perception::filters::voxel_grid::Config(
+    m_min_point, m_max_point, m_voxel_size, m_capacity);
+  DualVoxelMap<DummyLocalizationMap> map{grid_config, map_frame, DummyLocalizationMap{}};
+  map.update(
+    autoware::mapping::point_cloud_mapping::make_pc_deviated(
+      map_size, 0U, map_frame, FIXED_DEVIATION));
+
+  BackgroundPCDWriter writer;
+  const std::string fname_prefix{"map_test_background_fname"};
+  const auto fname = fname_prefix + ".pcd";
+  writer.write(fname_prefix, map.snapshot());
+  // The snapshot is independent of the map
+  map.clear();
+  writer.flush();
+  EXPECT_EQ(writer.num_failures(), 0U);
+  PclCloud pcl_cloud;
+  pcl::io::loadPCDFile(fname, pcl_cloud);
+  autoware::mapping::point_cloud_mapping::check_pc(pcl_cloud, map_size);
+  remove(fname.c_str());
+}
+
+TEST_F(VoxelMapTest, ChunkedWrite) {
+  constexpr auto map_frame = "map";
+  const auto grid_config = autoware::perception::filters::voxel_grid::Config(
+    m_min_point, m_max_point, m_voxel_size, m_capacity);
+  DualVoxelMap<DummyLocalizationMap> map{grid_config, map_frame, DummyLocalizationMap{}};
+  const std::string fname{"map_test_chunks.chunks"};
+  {
+    MapChunkWriter writer{fname};
+    // Cells 0-3, then cells 2-5 of which 2 and 3 change
+    map.update(autoware::mapping::point_cloud_mapping::make_pc_deviated(
+        4U, 0U, map_frame, FIXED_DEVIATION));
+    const auto first_changes = map.take_changes();
+    EXPECT_EQ(first_changes.size(), 4U);
+    writer.append(first_changes);
+    EXPECT_TRUE(map.take_changes().empty());
+    map.update(autoware::mapping::point_cloud_mapping::make_pc_deviated(
+        4U, 2U, map_frame, FIXED_DEVIATION));
+    writer.append(map.take_changes());
+    EXPECT_EQ(writer.num_chunks(), 2U);
+  }
+
+  MapChunkReader reader{fname};
+  ASSERT_EQ(reader.num_chunks(), 2U);
+  EXPECT_EQ(reader.read_chunk(0U).size(), 4U);
+  EXPECT_EQ(reader.read_chunk(1U).size(), 4U);
+  EXPECT_THROW(reader.read_chunk(2U), std::out_of_range);
+  auto compacted = autoware::mapping::point_cloud_mapping::compact_map_chunks(fname);
+  autoware::mapping::point_cloud_mapping::check_pc(compacted, 6U);
+  remove(fname.c_str());
+}
+
+// Localizer map remembering the sizes of the inserted clouds
+struct CloudSizeMap
+{
+  void insert(const sensor_msgs::msg::PointCloud2 & cloud)
+  {
+    sizes.push_back(cloud.width);
+  }
+  void clear()
+  {
+    sizes.clear();
+  }
+  std::vector<uint32_t> sizes;
+};
+
+TEST_F(VoxelMapTest, DoubleBufferedLocalizerMap) {
+  constexpr auto map_frame = "map";
+  const auto grid_config = autoware::perception::filters::voxel_grid::Config(
+    m_min_point, m_max_point, m_voxel_size, m_capacity);
+  DualVoxelMap<DoubleBufferedMap<CloudSizeMap>> map{grid_config, map_frame,
+    DoubleBufferedMap<CloudSizeMap>{CloudSizeMap{}, CloudSizeMap{}}};
+  EXPECT_EQ(map.localizer_map().read().version(), 0U);
+  map.update(autoware::mapping::point_cloud_mapping::make_pc(1U, 0U, map_frame));
+
+  std::thread writer;
+  {
+    const auto reader = map.localizer_map().read();
+    ASSERT_EQ(reader.version(), 1U);
+    // New readers get the updated copy while the held one is waited for
+    writer = std::thread{[&map, map_frame] {
+        map.update(autoware::mapping::point_cloud_mapping::make_pc(2U, 0U, map_frame));
+      }};
+    while (map.localizer_map().read().version() < 2U) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(map.localizer_map().read().map().sizes, (std::vector<uint32_t>{1U, 2U}));
+    // The held copy is not updated until it is released
+    EXPECT_EQ(reader.version(), 1U);
+    EXPECT_EQ(reader.map().sizes, std::vector<uint32_t>{1U});
+  }
+  // Releasing the reader lets the update finish
+  writer.join();
+  // The map is only cleared with the next update, so it is never empty for the readers
+  map.clear();
+  EXPECT_EQ(map.localizer_map().read().map().sizes, (std::vector<uint32_t>{1U, 2U}));
+  map.update(autoware::mapping::point_cloud_mapping::make_pc(3U, 0U, map_frame));
+  EXPECT_EQ(map.localizer_map().read().version(), 3U);
+  EXPECT_EQ(map.localizer_map().read().map().sizes, std::vector<uint32_t>{3U});
+  // The other copy was cleared too
+  map.update(autoware::mapping::point_cloud_mapping::make_pc(4U, 0U, map_frame));
+  EXPECT_EQ(map.localizer_map().read().map().sizes, (std::vector<uint32_t>{3U, 4U}));
+}
+
+TEST_F(VoxelMapTest, TiledMap) {
+  constexpr auto map_frame = "map";
+  const auto grid_config = autoware::perception::filters::voxel_grid::Config(
+    m_min_point, m_max_point, m_voxel_size, 100U);
+  // Tiles of 2x2 voxels, so that the cells (i, i, i) of `make_pc` are in tile i / 2
+  MapTilingConfig tiling_config;
+  tiling_config.tile_size = 2.0F;
+  tiling_config.max_resident_tiles = 2U;
+  tiling_config.spill_directory = ".";
+  DualVoxelMap<DoubleBufferedMap<CloudSizeMap>> map{grid_config, map_frame,
+    DoubleBufferedMap<CloudSizeMap>{CloudSizeMap{}, CloudSizeMap{}}, 1U, tiling_config};
+  DualVoxelMap<DummyLocalizationMap> untiled_map{grid_config, map_frame, DummyLocalizationMap{}};
+  const auto update = [&map, &untiled_map](const sensor_msgs::msg::PointCloud2 & pc) {
+      EXPECT_EQ(map.update(pc).update_type, untiled_map.update(pc).update_type);
+    };
+  const auto localizer_cloud_sizes = [&map]() {
+      return map.localizer_map().read().map().sizes;
+    };
+
+  // Tiles 0 and 1
+  update(autoware::mapping::point_cloud_mapping::make_pc(4U, 0U, map_frame));
+  EXPECT_EQ(map.size(), 4U);
+  // Tile 2 spills tile 0, the localizer map is rebuilt from tile 1 before the scan is inserted
+  update(autoware::mapping::point_cloud_mapping::make_pc(2U, 4U, map_frame));
+  EXPECT_EQ(map.size(), 4U);
+  EXPECT_EQ(localizer_cloud_sizes(), (std::vector<uint32_t>{2U, 2U}));
+  // Tile 0 is loaded and extended, which spills tile 1
+  update(
+    autoware::mapping::point_cloud_mapping::make_pc(
+      {autoware::common::types::PointXYZI{0.2F, 0.2F, 0.2F, 0.2F}}, map_frame));
+  EXPECT_EQ(map.size(), 4U);
+  EXPECT_EQ(localizer_cloud_sizes(), (std::vector<uint32_t>{4U, 1U}));
+  EXPECT_FALSE(map.empty());
+
+  // The spilled tiles are part of the snapshot and the changes, with the same voxels as without
+  // tiling
+  const auto sorted_cloud = [](const PclCloud & cloud) {
+      std::vector<std::array<float32_t, 4U>> points;
+      for (const auto & pt : cloud) {
+        points.push_back({pt.x, pt.y, pt.z, pt.intensity});
+      }
+      std::sort(points.begin(), points.end());
+      return points;
+    };
+  EXPECT_EQ(map.snapshot().size(), 6U);
+  EXPECT_EQ(sorted_cloud(map.snapshot()), sorted_cloud(untiled_map.snapshot()));
+  const auto sorted_changes = [](std::vector<VoxelRecord> records) {
+      std::vector<std::array<float32_t, 4U>> points;
+      for (const auto & record : records) {
+        points.push_back({record.x, record.y, record.z, record.intensity});
+      }
+      std::sort(points.begin(), points.end());
+      return points;
+    };
+  EXPECT_EQ(sorted_changes(map.take_changes()), sorted_changes(untiled_map.take_changes()));
+  EXPECT_TRUE(map.take_changes().empty());
+  // Loading tile 1 and spilling tile 2 again does not bring back the taken changes
+  update(autoware::mapping::point_cloud_mapping::make_pc(1U, 2U, map_frame));
+  EXPECT_EQ(map.take_changes().size(), 1U);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.snapshot().size(), 0U);
+  EXPECT_TRUE(map.take_changes().empty());
+}
+
 //////////////////////// helper function implementations ///////////////////////
 
 void autoware::mapping::point_cloud_mapping::check_pc(PclCloud & pc, std::size_t size)
@@ -0,0 +1,92 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 Tier IV, Inc.
+/// \file
+/// \brief This file defines the CloudBufferPool class.
+
+#ifndef FILTER_NODE_BASE__CLOUD_BUFFER_POOL_HPP_
+#define FILTER_NODE_BASE__CLOUD_BUFFER_POOL_HPP_
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "filter_node_base/visibility_control.hpp"
+#include "sensor_msgs/msg/point_cloud2.hpp"
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace filter_node_base
+{
+
+/// \class CloudBufferPool
+/// \brief A thread-safe pool of PointCloud2 payload buffers, sorted in power of two size classes
+///
+/// The buffers keep their capacity while they are in the pool, so that the payload of a cloud
+/// which is acquired from the pool is neither allocated nor page faulted once the pool holds a
+/// buffer of its size class.
+class FILTER_NODE_BASE_PUBLIC CloudBufferPool
+{
+public:
+  using Buffer = sensor_msgs::msg::PointCloud2::_data_type;
+
+  /// \brief The capacity of the smallest size class, smaller buffers are not pooled
+  static constexpr std::size_t kMinClassBytes = 64U * 1024U;
+  /// \brief The number of size classes, the largest one holds buffers of 128 MiB
+  static constexpr std::size_t kNumClasses = 12U;
+
+  /** \brief Constructor
+   * \param max_buffers_per_class The number of buffers which are kept in each size class, the
+   * buffers released to a full class are freed
+   */
+  explicit CloudBufferPool(std::size_t max_buffers_per_class = 8U);
+
+  /// \brief The pool shared by all the nodes of the process, e.g. of a component container
+  static CloudBufferPool & shared();
+
+  /** \brief Get an empty buffer with at least the given capacity
+   *
+   * The buffer is taken from the pool if its size class holds one, otherwise it is allocated with
+   * the capacity of the size class.
+   * \param min_bytes The capacity the buffer needs
+   * \return An empty buffer
+   */
+  Buffer acquire(std::size_t min_bytes);
+
+  /** \brief Give a buffer back to the pool
+   * \param buffer The buffer, cleared and kept in the largest size class it fits in
+   */
+  void release(Buffer buffer);
+
+  /// \brief The number of buffers in the pool
+  std::size_t size() const;
+
+private:
+  std::size_t max_buffers_per_class_;
+  std::array<std::vector<Buffer>, kNumClasses> classes_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace filter_node_base
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // FILTER_NODE_BASE__CLOUD_BUFFER_POOL_HPP_
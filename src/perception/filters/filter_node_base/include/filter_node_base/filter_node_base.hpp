@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 
+#include "filter_node_base/cloud_buffer_pool.hpp"
 #include "filter_node_base/visibility_control.hpp"
 #include "common/types.hpp"
 #include "rclcpp/rclcpp.hpp"
@@ -32,6 +33,7 @@
 
 
 using autoware::common::types::bool8_t;
+using autoware::common::types::float32_t;
 
 namespace autoware
 {
@@ -93,6 +95,20 @@ protected:
   /** \brief The maximum queue size. */
   size_t max_queue_size_;
 
+  /** \brief Whether to filter into a message loaned from the middleware, if it supports loaning */
+  bool8_t use_loaned_messages_;
+
+  /** \brief Whether to take the output payloads from the CloudBufferPool shared by the process and
+   * give the input payloads back to it */
+  bool8_t use_buffer_pool_;
+
+  /** \brief Resolution in meters of the coordinates of compact point clouds, see
+   * lidar_utils::encode_compact_point_cloud */
+  float32_t compact_resolution_;
+
+  /** \brief Whether to publish the output as a compact point cloud */
+  bool8_t compact_output_;
+
   /** \brief Virtual abstract filter method called by the computePublish method at the arrival of each point cloud message.
    * \param input The input point cloud dataset.
    * \param output The resultant filtered PointCloud2
@@ -125,13 +141,22 @@ protected:
   FILTER_NODE_BASE_LOCAL inline bool8_t is_valid(
     const sensor_msgs::msg::PointCloud2::ConstSharedPtr & cloud)
   {
-    if (cloud->width * cloud->height * cloud->point_step != cloud->data.size()) {
+    return is_valid(*cloud);
+  }
+
+  /** \brief Validate a sensor_msgs::msg::PointCloud2 message
+   * \param cloud Input sensor_msgs::msg::PointCloud2 to be validated
+   * \return bool8_t True if the point cloud is valid, false if not
+   */
+  FILTER_NODE_BASE_LOCAL inline bool8_t is_valid(const sensor_msgs::msg::PointCloud2 & cloud)
+  {
+    if (cloud.width * cloud.height * cloud.point_step != cloud.data.size()) {
       RCLCPP_WARN(
         this->get_logger(),
         "Invalid PointCloud (data = %zu, width = %d, height = %d, step = %d) with stamp %f, "
         "and frame %s received!",
-        cloud->data.size(), cloud->width, cloud->height, cloud->point_step,
-        rclcpp::Time(cloud->header.stamp).seconds(), cloud->header.frame_id.c_str());
+        cloud.data.size(), cloud.width, cloud.height, cloud.point_step,
+        rclcpp::Time(cloud.header.stamp).seconds(), cloud.header.frame_id.c_str());
       return false;
     }
     return true;
@@ -159,12 +184,47 @@ private:
   /** \brief Callback used to receive point cloud data.
    *
    * After checking the validity of the received point cloud message, call the filter method and
-   * publish the filtered point cloud on a new topic.
+   * publish the filtered point cloud on a new topic. The output is either loaned from the
+   * middleware or published as a unique_ptr, so it is not copied when the node is composed with
+   * intra-process communication enabled.
    *
    * \param msg Input point cloud message to be processed by the filter
    */
   FILTER_NODE_BASE_LOCAL void pointcloud_callback(
-    const sensor_msgs::msg::PointCloud2::SharedPtr msg);
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg);
+
+  /** \brief Callback used to receive point cloud data when `use_buffer_pool` is set.
+   *
+   * Like `pointcloud_callback`, and gives the payload of the input back to the CloudBufferPool
+   * once it is filtered. The node owns the input when it is its only intra-process subscriber.
+   *
+   * \param msg Input point cloud message to be processed by the filter
+   */
+  FILTER_NODE_BASE_LOCAL void pooled_pointcloud_callback(
+    std::unique_ptr<sensor_msgs::msg::PointCloud2> msg);
+
+  /** \brief Filter a point cloud and publish the output
+   *
+   * A compact input is decoded before it is filtered, and the output is encoded if
+   * `compact_output` is set, so that filters only ever see float32 clouds.
+   *
+   * \param msg Input point cloud message to be processed by the filter
+   */
+  FILTER_NODE_BASE_LOCAL void filter_and_publish(const sensor_msgs::msg::PointCloud2 & msg);
+
+  /** \brief Filter a point cloud into the output, decoding and encoding compact clouds
+   * \param msg Input point cloud message to be processed by the filter
+   * \param output The resultant filtered PointCloud2
+   */
+  FILTER_NODE_BASE_LOCAL void filter_compact(
+    const sensor_msgs::msg::PointCloud2 & msg,
+    sensor_msgs::msg::PointCloud2 & output);
+
+  /** \brief A decoded compact input, kept to reuse its payload */
+  sensor_msgs::msg::PointCloud2 decoded_input_;
+
+  /** \brief The output of the filter before it is encoded, kept to reuse its payload */
+  sensor_msgs::msg::PointCloud2 filtered_output_;
 };
 }  // namespace filter_node_base
 }  // namespace filters
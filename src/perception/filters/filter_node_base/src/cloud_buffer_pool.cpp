@@ -0,0 +1,111 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "filter_node_base/cloud_buffer_pool.hpp"
+
+#include <utility>
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace filter_node_base
+{
+
+constexpr std::size_t CloudBufferPool::kMinClassBytes;
+constexpr std::size_t CloudBufferPool::kNumClasses;
+
+namespace
+{
+std::size_t class_bytes(const std::size_t size_class)
+{
+  return CloudBufferPool::kMinClassBytes << size_class;
+}
+}  // namespace
+
+CloudBufferPool::CloudBufferPool(const std::size_t max_buffers_per_class)
+: max_buffers_per_class_{max_buffers_per_class}
+{
+  // Releasing a buffer must not allocate
+  for (auto & buffers : classes_) {
+    buffers.reserve(max_buffers_per_class_);
+  }
+}
+
+CloudBufferPool & CloudBufferPool::shared()
+{
+  static CloudBufferPool pool{};
+  return pool;
+}
+
+CloudBufferPool::Buffer CloudBufferPool::acquire(const std::size_t min_bytes)
+{
+  // The smallest size class the buffer fits in
+  std::size_t size_class = 0U;
+  while ((size_class < kNumClasses) && (class_bytes(size_class) < min_bytes)) {
+    ++size_class;
+  }
+  Buffer buffer{};
+  if (size_class == kNumClasses) {
+    buffer.reserve(min_bytes);
+    return buffer;
+  }
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    auto & buffers = classes_[size_class];
+    if (!buffers.empty()) {
+      buffer = std::move(buffers.back());
+      buffers.pop_back();
+      return buffer;
+    }
+  }
+  buffer.reserve(class_bytes(size_class));
+  return buffer;
+}
+
+void CloudBufferPool::release(Buffer buffer)
+{
+  if (buffer.capacity() < kMinClassBytes) {
+    return;
+  }
+  // The largest size class the buffer holds
+  std::size_t size_class = 0U;
+  while ((size_class + 1U < kNumClasses) && (class_bytes(size_class + 1U) <= buffer.capacity())) {
+    ++size_class;
+  }
+  buffer.clear();
+  std::lock_guard<std::mutex> lock{mutex_};
+  auto & buffers = classes_[size_class];
+  if (buffers.size() < max_buffers_per_class_) {
+    buffers.push_back(std::move(buffer));
+  }
+  // Otherwise the buffer is freed when it goes out of scope
+}
+
+std::size_t CloudBufferPool::size() const
+{
+  std::lock_guard<std::mutex> lock{mutex_};
+  std::size_t size = 0U;
+  for (const auto & buffers : classes_) {
+    size += buffers.size();
+  }
+  return size;
+}
+
+}  // namespace filter_node_base
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
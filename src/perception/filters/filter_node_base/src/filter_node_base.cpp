@@ -14,8 +14,12 @@
 
 #include "filter_node_base/filter_node_base.hpp"
 
+#include <lidar_utils/point_cloud_utils.hpp>
+
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 
@@ -30,7 +34,10 @@ namespace filter_node_base
 
 using bool8_t = autoware::common::types::bool8_t;
 using PointCloud2 = sensor_msgs::msg::PointCloud2;
-using PointCloud2SharedPtr = sensor_msgs::msg::PointCloud2::SharedPtr;
+using PointCloud2ConstSharedPtr = sensor_msgs::msg::PointCloud2::ConstSharedPtr;
+using autoware::common::lidar_utils::decode_compact_point_cloud;
+using autoware::common::lidar_utils::encode_compact_point_cloud;
+using autoware::common::lidar_utils::is_compact_point_cloud;
 
 FilterNodeBase::FilterNodeBase(
   const std::string & filter_name, const rclcpp::NodeOptions & options)
@@ -38,13 +45,28 @@ FilterNodeBase::FilterNodeBase(
 {
   max_queue_size_ = static_cast<std::size_t>(declare_parameter(
       "max_queue_size").get<std::size_t>());
+  use_loaned_messages_ = declare_parameter("use_loaned_messages", false);
+  use_buffer_pool_ = declare_parameter("use_buffer_pool", false);
+  compact_resolution_ = static_cast<float32_t>(declare_parameter("compact_resolution", 0.001));
+  compact_output_ = declare_parameter("compact_output", false);
+  if (!(compact_resolution_ > 0.0F)) {
+    throw std::domain_error("compact_resolution must be positive");
+  }
 
   // Set publisher
   pub_output_ = this->create_publisher<PointCloud2>(
     "output", rclcpp::SensorDataQoS().keep_last(max_queue_size_));
 
   // Set subscriber
-  std::function<void(const PointCloud2SharedPtr msg)> cb = std::bind(
+  if (use_buffer_pool_) {
+    // Taking ownership of the input lets its payload be recycled for the output of a node
+    std::function<void(std::unique_ptr<PointCloud2> msg)> cb = std::bind(
+      &FilterNodeBase::pooled_pointcloud_callback, this, std::placeholders::_1);
+    sub_input_ = create_subscription<PointCloud2>(
+      "input", rclcpp::SensorDataQoS().keep_last(max_queue_size_), cb);
+    return;
+  }
+  std::function<void(const PointCloud2ConstSharedPtr msg)> cb = std::bind(
     &FilterNodeBase::pointcloud_callback, this, std::placeholders::_1);
   sub_input_ = create_subscription<PointCloud2>(
     "input", rclcpp::SensorDataQoS().keep_last(max_queue_size_), cb);
@@ -66,7 +88,18 @@ rcl_interfaces::msg::SetParametersResult FilterNodeBase::param_callback(
   return get_node_parameters(p);
 }
 
-void FilterNodeBase::pointcloud_callback(const PointCloud2SharedPtr msg)
+void FilterNodeBase::pointcloud_callback(const PointCloud2ConstSharedPtr msg)
+{
+  filter_and_publish(*msg);
+}
+
+void FilterNodeBase::pooled_pointcloud_callback(std::unique_ptr<PointCloud2> msg)
+{
+  filter_and_publish(*msg);
+  CloudBufferPool::shared().release(std::move(msg->data));
+}
+
+void FilterNodeBase::filter_and_publish(const PointCloud2 & msg)
 {
   if (!is_valid(msg)) {
     RCLCPP_ERROR_STREAM(this->get_logger(), "[" << filter_field_name_ << "]: Invalid input!");
@@ -78,14 +111,51 @@ void FilterNodeBase::pointcloud_callback(const PointCloud2SharedPtr msg)
     this->get_logger(),
     "[%s]: PointCloud with %d data points and frame %s on input topic "
     "received.",
-    filter_field_name_, msg->width * msg->height, msg->header.frame_id.c_str());
+    filter_field_name_, msg.width * msg.height, msg.header.frame_id.c_str());
 
-  PointCloud2 output;
+  if (use_loaned_messages_ && pub_output_->can_loan_messages()) {
+    auto loaned_output = pub_output_->borrow_loaned_message();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      filter_compact(msg, loaned_output.get());
+    }
+    pub_output_->publish(std::move(loaned_output));
+    return;
+  }
+
+  // Publishing a unique_ptr lets intra-process subscriptions take ownership without a copy
+  auto output = std::make_unique<PointCloud2>();
+  if (use_buffer_pool_) {
+    // A filter does not output more points than it gets
+    output->data = CloudBufferPool::shared().acquire(msg.data.size());
+  }
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    filter(*msg, output);
+    filter_compact(msg, *output);
+  }
+  pub_output_->publish(std::move(output));
+}
+
+void FilterNodeBase::filter_compact(const PointCloud2 & msg, PointCloud2 & output)
+{
+  const auto is_compact = is_compact_point_cloud(msg);
+  if (is_compact) {
+    decode_compact_point_cloud(msg, compact_resolution_, decoded_input_);
+  }
+  const auto & input = is_compact ? decoded_input_ : msg;
+  if (!compact_output_) {
+    filter(input, output);
+    return;
+  }
+  filter(input, filtered_output_);
+  const auto dropped =
+    encode_compact_point_cloud(filtered_output_, compact_resolution_, output);
+  if (dropped > 0U) {
+    RCLCPP_WARN_THROTTLE(
+      this->get_logger(), *this->get_clock(), 1000,
+      "[%s]: Dropped %zu points out of the range of the compact point cloud",
+      filter_field_name_.c_str(), dropped);
   }
-  pub_output_->publish(output);
 }
 
 }  // namespace filter_node_base
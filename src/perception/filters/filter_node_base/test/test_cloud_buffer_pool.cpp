@@ -0,0 +1,65 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+
+#include "filter_node_base/cloud_buffer_pool.hpp"
+
+#include "gtest/gtest.h"
+
+using autoware::perception::filters::filter_node_base::CloudBufferPool;
+
+TEST(TestCloudBufferPool, AcquireReusesReleasedBuffer)
+{
+  CloudBufferPool pool{};
+  auto buffer = pool.acquire(100000U);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.capacity(), 2U * CloudBufferPool::kMinClassBytes);
+  buffer.resize(100000U);
+  const auto data = buffer.data();
+
+  pool.release(std::move(buffer));
+  EXPECT_EQ(pool.size(), 1U);
+  // Any size of the same size class gets the buffer back
+  const auto reused = pool.acquire(CloudBufferPool::kMinClassBytes + 1U);
+  EXPECT_EQ(reused.data(), data);
+  EXPECT_TRUE(reused.empty());
+  EXPECT_EQ(pool.size(), 0U);
+}
+
+TEST(TestCloudBufferPool, ReleaseToLargestFittingClass)
+{
+  CloudBufferPool pool{};
+  CloudBufferPool::Buffer buffer{};
+  buffer.reserve(3U * CloudBufferPool::kMinClassBytes);
+  const auto data = buffer.data();
+  pool.release(std::move(buffer));
+
+  // The buffer does not hold the size class of four times the smallest one
+  EXPECT_NE(pool.acquire(3U * CloudBufferPool::kMinClassBytes).data(), data);
+  EXPECT_EQ(pool.acquire(2U * CloudBufferPool::kMinClassBytes).data(), data);
+}
+
+TEST(TestCloudBufferPool, BoundedClasses)
+{
+  CloudBufferPool pool{2U};
+  for (int i = 0; i < 3; ++i) {
+    pool.release(CloudBufferPool::Buffer(CloudBufferPool::kMinClassBytes));
+  }
+  EXPECT_EQ(pool.size(), 2U);
+
+  // Buffers smaller than the smallest size class are not kept
+  pool.release(CloudBufferPool::Buffer(10U));
+  EXPECT_EQ(pool.size(), 2U);
+}
@@ -29,7 +29,7 @@
 namespace
 {
 using float32_t = autoware::common::types::float32_t;
-using FilterNodeTest = autoware::tools::testing::FakeTestNode;
+using FilterNodeTest = autoware::tools::testing::FakeTestNodeParametrized<bool8_t>;
 using FilterNodeBase = autoware::perception::filters::filter_node_base::FilterNodeBase;
 using PointCloud2 = sensor_msgs::msg::PointCloud2;
 
@@ -219,11 +219,13 @@ TEST_F(TestFilterNodeBase, TestParameters) {
   EXPECT_THAT(mock_filter_node_base->test_param_2_, Eq("new_frame_2"));
 }
 
-// Test using the fake_test_node library
-TEST_F(FilterNodeTest, TestFilter) {
+// Test using the fake_test_node library, with and without loaned messages. Middlewares which
+// cannot loan messages fall back to publishing a unique_ptr
+TEST_P(FilterNodeTest, TestFilter) {
   // Generate parameters
   std::vector<rclcpp::Parameter> params;
   params.emplace_back("max_queue_size", 5);
+  params.emplace_back("use_loaned_messages", GetParam());
   params.emplace_back("test_param_1", 0.5);
   params.emplace_back("test_param_2", "frame_2");
 
@@ -270,4 +272,10 @@ TEST_F(FilterNodeTest, TestFilter) {
   check_pc(msg, *last_received_msg);
   SUCCEED();
 }
+
+INSTANTIATE_TEST_CASE_P(
+  FilterNodeTests,
+  FilterNodeTest,
+  // cppcheck-suppress syntaxError  // cppcheck doesn't like the trailing comma.
+  ::testing::Values(false, true), /*This comment needed to avoid a warning*/);
 }  // namespace
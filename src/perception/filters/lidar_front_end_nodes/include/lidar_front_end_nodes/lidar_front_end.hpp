@@ -0,0 +1,139 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 The Autoware Foundation
+/// \file
+/// \brief This file defines the LidarFrontEnd class, which preprocesses the cloud of one lidar in
+///        a single stage.
+
+#ifndef LIDAR_FRONT_END_NODES__LIDAR_FRONT_END_HPP_
+#define LIDAR_FRONT_END_NODES__LIDAR_FRONT_END_HPP_
+
+#include <common/types.hpp>
+#include <geometry_msgs/msg/transform.hpp>
+#include <lidar_front_end_nodes/visibility_control.hpp>
+#include <lidar_utils/point_cloud_utils.hpp>
+#include <ray_ground_classifier/ray_aggregator.hpp>
+#include <ray_ground_classifier/ray_ground_classifier.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <voxel_grid/voxel_grid.hpp>
+#include <voxel_grid/voxels.hpp>
+
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace lidar_front_end_nodes
+{
+using autoware::common::types::bool8_t;
+using sensor_msgs::msg::PointCloud2;
+
+/// \brief Filters, transforms, partitions into ground and nonground and downsamples a point cloud
+///        in one stage, with the results of point_cloud_filter_transform_nodes,
+///        ray_ground_classifier_nodes and voxel_grid_nodes applied one after the other. The
+///        filtered and transformed points are kept in one buffer, allocated at construction, which
+///        the ray aggregator and the voxel grid read through pointers, so no intermediate cloud is
+///        serialized, published or copied.
+class LIDAR_FRONT_END_NODES_PUBLIC LidarFrontEnd
+{
+public:
+  using AngleFilter = autoware::common::lidar_utils::AngleFilter;
+  using DistanceFilter = autoware::common::lidar_utils::DistanceFilter;
+
+  /// \brief Constructor
+  /// \param[in] angle_filter Filter of the raw points, as in PointCloud2FilterTransformNode
+  /// \param[in] distance_filter Filter of the raw points, as in PointCloud2FilterTransformNode
+  /// \param[in] tf Transform of the raw points into the output frame
+  /// \param[in] input_frame_id Expected frame of the raw points
+  /// \param[in] output_frame_id Frame of all outputs
+  /// \param[in] classifier_cfg Configuration of the ground classification
+  /// \param[in] aggregator_cfg Configuration of the rays of the ground classification
+  /// \param[in] voxel_cfg Configuration of the centroid voxel grid of the downsampled output
+  /// \param[in] capacity Maximum number of points which pass the filters
+  /// \param[in] downsample_ground Whether ground points are downsampled as well, e.g. for
+  ///                              localization, or only nonground points, e.g. for clustering
+  LidarFrontEnd(
+    const AngleFilter & angle_filter,
+    const DistanceFilter & distance_filter,
+    const geometry_msgs::msg::Transform & tf,
+    const std::string & input_frame_id,
+    const std::string & output_frame_id,
+    const ray_ground_classifier::Config & classifier_cfg,
+    const ray_ground_classifier::RayAggregator::Config & aggregator_cfg,
+    const voxel_grid::Config & voxel_cfg,
+    const std::size_t capacity,
+    const bool8_t downsample_ground);
+
+  /// \brief Process a raw point cloud into the outputs, which get the stamp of the input
+  /// \param[in] msg Raw point cloud with float32_t x, y, z and a float32_t or uint8_t intensity
+  /// \throw std::runtime_error On an unexpected frame or malformed input, if more points than the
+  ///                           capacity pass the filters, or if a ray can't be partitioned
+  /// \throw std::length_error If the downsampled cloud exceeds the capacity of the voxel grid
+  void process(const PointCloud2 & msg);
+
+  /// \brief Get the ground points of the last processed cloud
+  /// \return Point cloud of PointXYZI
+  const PointCloud2 & ground() const noexcept;
+
+  /// \brief Get the nonground points of the last processed cloud
+  /// \return Point cloud of PointXYZI
+  const PointCloud2 & nonground() const noexcept;
+
+  /// \brief Get the downsampled points of the last processed cloud
+  /// \return Point cloud of PointXYZI
+  const PointCloud2 & downsampled() const noexcept;
+
+private:
+  using PointXYZIF = autoware::common::types::PointXYZIF;
+  using VoxelGrid = voxel_grid::VoxelGrid<voxel_grid::CentroidVoxel<PointXYZIF>,
+      voxel_grid::FlatVoxelStorage>;
+
+  /// \brief Filter and transform the raw points into the point buffer
+  /// \param[in] msg Raw point cloud
+  LIDAR_FRONT_END_NODES_LOCAL void filter_and_transform(const PointCloud2 & msg);
+
+  /// \brief Partition the buffered points into ground and nonground, and downsample them
+  LIDAR_FRONT_END_NODES_LOCAL void classify_and_downsample();
+
+  /// \brief Resets the aggregator, voxel grid and outputs, keeping their capacity
+  LIDAR_FRONT_END_NODES_LOCAL void reset();
+
+  const AngleFilter m_angle_filter;
+  const DistanceFilter m_distance_filter;
+  const autoware::common::lidar_utils::StaticTransformer m_transformer;
+  const std::string m_input_frame_id;
+  ray_ground_classifier::RayGroundClassifier m_classifier;
+  ray_ground_classifier::RayAggregator m_aggregator;
+  VoxelGrid m_voxel_grid;
+  const std::size_t m_capacity;
+  const bool8_t m_downsample_ground;
+  // Filtered and transformed points, which all later steps point into
+  std::vector<PointXYZIF> m_points;
+  autoware::common::types::PointPtrBlock m_ground_blk;
+  autoware::common::types::PointPtrBlock m_nonground_blk;
+  PointCloud2 m_ground_msg;
+  PointCloud2 m_nonground_msg;
+  PointCloud2 m_downsampled_msg;
+};  // class LidarFrontEnd
+}  // namespace lidar_front_end_nodes
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // LIDAR_FRONT_END_NODES__LIDAR_FRONT_END_HPP_
@@ -0,0 +1,76 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 The Autoware Foundation
+/// \file
+/// \brief This file defines the LidarFrontEndNode class.
+
+#ifndef LIDAR_FRONT_END_NODES__LIDAR_FRONT_END_NODE_HPP_
+#define LIDAR_FRONT_END_NODES__LIDAR_FRONT_END_NODE_HPP_
+
+#include <lidar_front_end_nodes/lidar_front_end.hpp>
+#include <lidar_front_end_nodes/visibility_control.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <time_utils/trace.hpp>
+
+#include <memory>
+#include <string>
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace lidar_front_end_nodes
+{
+/// \brief A node which replaces a chain of PointCloud2FilterTransformNode,
+///        RayGroundClassifierCloudNode and VoxelCloudNode for one lidar, with the parameters of
+///        these nodes
+class LIDAR_FRONT_END_NODES_PUBLIC LidarFrontEndNode : public rclcpp::Node
+{
+public:
+  /// \brief Parameter constructor
+  /// \param node_options Additional options to control creation of the node.
+  /// \throw std::runtime_error if configuration fails
+  explicit LidarFrontEndNode(const rclcpp::NodeOptions & node_options);
+
+private:
+  /// \brief Get the transform from the static_transformer parameters, or look it up on /tf
+  /// \param[in] input_frame_id Frame of the raw points
+  /// \param[in] output_frame_id Frame of the outputs
+  /// \return The transform of the raw points into the output frame
+  LIDAR_FRONT_END_NODES_LOCAL geometry_msgs::msg::Transform get_transform(
+    const std::string & input_frame_id,
+    const std::string & output_frame_id);
+
+  /// \brief Process a raw cloud and publish the outputs
+  /// \param[in] msg Raw point cloud
+  LIDAR_FRONT_END_NODES_LOCAL void callback(const PointCloud2::SharedPtr msg);
+
+  std::unique_ptr<LidarFrontEnd> m_front_end;
+  const rclcpp::Subscription<PointCloud2>::SharedPtr m_sub_ptr;
+  const std::shared_ptr<rclcpp::Publisher<PointCloud2>> m_ground_pub_ptr;
+  const std::shared_ptr<rclcpp::Publisher<PointCloud2>> m_nonground_pub_ptr;
+  const std::shared_ptr<rclcpp::Publisher<PointCloud2>> m_downsampled_pub_ptr;
+  // records when each cloud enters and leaves the callback, if tracing is switched on
+  const common::time_utils::TracePoint m_trace;
+};  // class LidarFrontEndNode
+}  // namespace lidar_front_end_nodes
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // LIDAR_FRONT_END_NODES__LIDAR_FRONT_END_NODE_HPP_
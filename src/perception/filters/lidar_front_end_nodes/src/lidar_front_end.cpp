@@ -0,0 +1,206 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <lidar_front_end_nodes/lidar_front_end.hpp>
+#include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace lidar_front_end_nodes
+{
+using autoware::common::lidar_utils::has_intensity_and_throw_if_no_xyz;
+using autoware::common::lidar_utils::IntensityIteratorWrapper;
+using autoware::common::lidar_utils::load_point_batch;
+using autoware::common::lidar_utils::PointBatch;
+using autoware::common::lidar_utils::PointBatchMask;
+using autoware::common::types::float32_t;
+using autoware::common::types::PointXYZI;
+
+LidarFrontEnd::LidarFrontEnd(
+  const AngleFilter & angle_filter,
+  const DistanceFilter & distance_filter,
+  const geometry_msgs::msg::Transform & tf,
+  const std::string & input_frame_id,
+  const std::string & output_frame_id,
+  const ray_ground_classifier::Config & classifier_cfg,
+  const ray_ground_classifier::RayAggregator::Config & aggregator_cfg,
+  const voxel_grid::Config & voxel_cfg,
+  const std::size_t capacity,
+  const bool8_t downsample_ground)
+: m_angle_filter{angle_filter},
+  m_distance_filter{distance_filter},
+  m_transformer{tf},
+  m_input_frame_id{input_frame_id},
+  m_classifier{classifier_cfg},
+  m_aggregator{aggregator_cfg},
+  m_voxel_grid{voxel_cfg},
+  m_capacity{capacity},
+  m_downsample_ground{downsample_ground}
+{
+  m_points.reserve(m_capacity);
+  m_ground_blk.reserve(autoware::common::types::POINT_BLOCK_CAPACITY);
+  m_nonground_blk.reserve(autoware::common::types::POINT_BLOCK_CAPACITY);
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{
+    m_ground_msg, output_frame_id}.reserve(m_capacity);
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{
+    m_nonground_msg, output_frame_id}.reserve(m_capacity);
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{
+    m_downsampled_msg, output_frame_id}.reserve(voxel_cfg.get_capacity());
+}
+
+void LidarFrontEnd::process(const PointCloud2 & msg)
+{
+  reset();
+  if (msg.header.frame_id != m_input_frame_id) {
+    throw std::runtime_error(
+            "LidarFrontEnd: raw topic from unexpected frame. Expected: " +
+            m_input_frame_id + ", got: " + msg.header.frame_id);
+  }
+  const auto data_length = msg.width * msg.height * msg.point_step;
+  if ((msg.data.size() != msg.row_step) || (data_length != msg.row_step)) {
+    throw std::runtime_error("LidarFrontEnd: Malformed PointCloud2");
+  }
+  m_ground_msg.header.stamp = msg.header.stamp;
+  m_nonground_msg.header.stamp = msg.header.stamp;
+  m_downsampled_msg.header.stamp = msg.header.stamp;
+
+  filter_and_transform(msg);
+  classify_and_downsample();
+}
+
+const PointCloud2 & LidarFrontEnd::ground() const noexcept
+{
+  return m_ground_msg;
+}
+
+const PointCloud2 & LidarFrontEnd::nonground() const noexcept
+{
+  return m_nonground_msg;
+}
+
+const PointCloud2 & LidarFrontEnd::downsampled() const noexcept
+{
+  return m_downsampled_msg;
+}
+
+void LidarFrontEnd::filter_and_transform(const PointCloud2 & msg)
+{
+  if (!has_intensity_and_throw_if_no_xyz(msg)) {
+    throw std::runtime_error("LidarFrontEnd: PointCloud doesn't have an intensity field");
+  }
+  IntensityIteratorWrapper intensity_it{msg};
+
+  // Same batched filter and transform as PointCloud2FilterTransformNode
+  PointBatch batch;
+  for (std::size_t first_point = 0U; load_point_batch(msg, first_point, batch) > 0U;
+    first_point += batch.size)
+  {
+    const PointBatchMask mask = m_angle_filter.filter(batch) & m_distance_filter.filter(batch);
+    if (0U != mask) {
+      m_transformer.transform(batch);
+    }
+    for (std::size_t idx = 0U; idx < batch.size; ++idx, intensity_it.next()) {
+      if (0U == (mask & (PointBatchMask{1U} << idx))) {
+        continue;
+      }
+      // The buffer must not reallocate, the later steps point into it
+      if (m_points.size() >= m_capacity) {
+        throw std::runtime_error("LidarFrontEnd: more filtered points than the capacity");
+      }
+      PointXYZIF pt{};
+      pt.x = batch.x[idx];
+      pt.y = batch.y[idx];
+      pt.z = batch.z[idx];
+      intensity_it.get_current_value(pt.intensity);
+      m_points.push_back(pt);
+    }
+  }
+}
+
+void LidarFrontEnd::classify_and_downsample()
+{
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> ground_modifier{m_ground_msg};
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> nonground_modifier{m_nonground_msg};
+
+  // Same aggregation as RayGroundClassifierCloudNode
+  for (const auto & pt : m_points) {
+    // Same as downsampling the output of PointCloud2FilterTransformNode
+    if (m_downsample_ground) {
+      m_voxel_grid.insert(pt);
+    }
+    // don't bother inserting the points almost (0,0).
+    // Too many of those makes the bin 0 overflow
+    if ((std::fabs(pt.x) > std::numeric_limits<float32_t>::epsilon()) ||
+      (std::fabs(pt.y) > std::numeric_limits<float32_t>::epsilon()))
+    {
+      if (!m_aggregator.insert(&pt)) {
+        m_aggregator.end_of_scan();
+      }
+    } else {
+      nonground_modifier.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
+      if (!m_downsample_ground) {
+        m_voxel_grid.insert(pt);
+      }
+    }
+  }
+  m_aggregator.end_of_scan();
+  const auto num_ready = m_aggregator.get_ready_ray_count();
+  for (std::size_t i = 0U; i < num_ready; ++i) {
+    m_ground_blk.clear();
+    m_nonground_blk.clear();
+    m_classifier.partition(m_aggregator.get_next_ray(), m_ground_blk, m_nonground_blk);
+    for (const auto * const pt : m_ground_blk) {
+      ground_modifier.push_back(PointXYZI{pt->x, pt->y, pt->z, pt->intensity});
+    }
+    // Same as downsampling the output of RayGroundClassifierCloudNode
+    for (const auto * const pt : m_nonground_blk) {
+      nonground_modifier.push_back(PointXYZI{pt->x, pt->y, pt->z, pt->intensity});
+      if (!m_downsample_ground) {
+        m_voxel_grid.insert(*pt);
+      }
+    }
+  }
+
+  // Same centroids as VoxelCloudCentroid
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> downsampled_modifier{
+    m_downsampled_msg};
+  for (const auto & it : m_voxel_grid) {
+    const auto & pt = it.second.get();
+    downsampled_modifier.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
+  }
+}
+
+void LidarFrontEnd::reset()
+{
+  // Needed in case an error is thrown during a cloud, which would leave filled rays or voxels
+  m_aggregator.reset();
+  m_voxel_grid.clear();
+  m_points.clear();
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{m_ground_msg}.clear();
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{m_nonground_msg}.clear();
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{m_downsampled_msg}.clear();
+}
+}  // namespace lidar_front_end_nodes
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
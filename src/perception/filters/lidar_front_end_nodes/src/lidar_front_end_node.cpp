@@ -0,0 +1,161 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <lidar_front_end_nodes/lidar_front_end_node.hpp>
+#include <rclcpp_components/register_node_macro.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "tf2_ros/buffer.h"
+#include "tf2_ros/transform_listener.h"
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace lidar_front_end_nodes
+{
+using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
+using std::placeholders::_1;
+
+LidarFrontEndNode::LidarFrontEndNode(const rclcpp::NodeOptions & node_options)
+: Node("lidar_front_end_node", node_options),
+  m_sub_ptr{create_subscription<PointCloud2>(
+      "points_in", rclcpp::QoS{10}, std::bind(&LidarFrontEndNode::callback, this, _1))},
+  m_ground_pub_ptr{create_publisher<PointCloud2>("points_ground", rclcpp::QoS{10})},
+  m_nonground_pub_ptr{create_publisher<PointCloud2>("points_nonground", rclcpp::QoS{10})},
+  m_downsampled_pub_ptr{create_publisher<PointCloud2>("points_downsampled", rclcpp::QoS{10})},
+  m_trace{get_fully_qualified_name()}
+{
+  const auto get_float = [this](const std::string & name) {
+      return static_cast<float32_t>(declare_parameter(name).get<float64_t>());
+    };
+  const auto get_point = [&get_float](const std::string & name) {
+      voxel_grid::PointXYZ pt;
+      pt.x = get_float(name + ".x");
+      pt.y = get_float(name + ".y");
+      pt.z = get_float(name + ".z");
+      return pt;
+    };
+
+  // Parameters of PointCloud2FilterTransformNode
+  const LidarFrontEnd::AngleFilter angle_filter{
+    get_float("start_angle"), get_float("end_angle")};
+  const LidarFrontEnd::DistanceFilter distance_filter{
+    get_float("min_radius"), get_float("max_radius")};
+  const auto input_frame_id = declare_parameter("input_frame_id").get<std::string>();
+  const auto output_frame_id = declare_parameter("output_frame_id").get<std::string>();
+  const auto pcl_size = static_cast<std::size_t>(declare_parameter("pcl_size").get<int64_t>());
+
+  // Parameters of RayGroundClassifierCloudNode
+  const ray_ground_classifier::Config classifier_cfg{
+    get_float("classifier.sensor_height_m"),
+    get_float("classifier.max_local_slope_deg"),
+    get_float("classifier.max_global_slope_deg"),
+    get_float("classifier.nonground_retro_thresh_deg"),
+    get_float("classifier.min_height_thresh_m"),
+    get_float("classifier.max_global_height_thresh_m"),
+    get_float("classifier.max_last_local_ground_thresh_m"),
+    get_float("classifier.max_provisional_ground_distance_m")};
+  const ray_ground_classifier::RayAggregator::Config aggregator_cfg{
+    get_float("aggregator.min_ray_angle_rad"),
+    get_float("aggregator.max_ray_angle_rad"),
+    get_float("aggregator.ray_width_rad"),
+    static_cast<std::size_t>(declare_parameter("aggregator.max_ray_points").get<int64_t>()),
+    static_cast<float32_t>(declare_parameter("aggregator.range_bin_width_m", 0.0)),
+    static_cast<float32_t>(declare_parameter("aggregator.max_range_m", 0.0))};
+
+  // Parameters of VoxelCloudNode, for centroid voxels
+  const voxel_grid::Config voxel_cfg{
+    get_point("voxel.config.min_point"),
+    get_point("voxel.config.max_point"),
+    get_point("voxel.config.voxel_size"),
+    static_cast<uint64_t>(declare_parameter("voxel.config.capacity").get<int64_t>())};
+
+  m_front_end = std::make_unique<LidarFrontEnd>(
+    angle_filter, distance_filter, get_transform(input_frame_id, output_frame_id),
+    input_frame_id, output_frame_id, classifier_cfg, aggregator_cfg, voxel_cfg, pcl_size,
+    declare_parameter("downsample_ground", false));
+}
+
+geometry_msgs::msg::Transform LidarFrontEndNode::get_transform(
+  const std::string & input_frame_id,
+  const std::string & output_frame_id)
+{
+  const auto names = {
+    "static_transformer.quaternion.x", "static_transformer.quaternion.y",
+    "static_transformer.quaternion.z", "static_transformer.quaternion.w",
+    "static_transformer.translation.x", "static_transformer.translation.y",
+    "static_transformer.translation.z"};
+  bool8_t from_file = true;
+  for (const auto & name : names) {
+    from_file = (declare_parameter(name).get_type() == rclcpp::ParameterType::PARAMETER_DOUBLE) &&
+      from_file;
+  }
+
+  geometry_msgs::msg::Transform tf;
+  if (from_file) {
+    RCLCPP_WARN(get_logger(), "Using transform from file.");
+    tf.rotation.x = get_parameter("static_transformer.quaternion.x").as_double();
+    tf.rotation.y = get_parameter("static_transformer.quaternion.y").as_double();
+    tf.rotation.z = get_parameter("static_transformer.quaternion.z").as_double();
+    tf.rotation.w = get_parameter("static_transformer.quaternion.w").as_double();
+    tf.translation.x = get_parameter("static_transformer.translation.x").as_double();
+    tf.translation.y = get_parameter("static_transformer.translation.y").as_double();
+    tf.translation.z = get_parameter("static_transformer.translation.z").as_double();
+    return tf;
+  }
+
+  // Else lookup transform being published on /tf or /static_tf topics
+  tf2_ros::Buffer tf2_buffer(this->get_clock());
+  tf2_ros::TransformListener tf2_listener(tf2_buffer);
+  while (rclcpp::ok()) {
+    try {
+      RCLCPP_INFO(get_logger(), "Looking up the transform.");
+      return tf2_buffer.lookupTransform(
+        output_frame_id, input_frame_id, tf2::TimePointZero).transform;
+    } catch (const std::exception & transform_exception) {
+      RCLCPP_INFO(get_logger(), "No transform was available. Retrying after 100 ms.");
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+  throw std::runtime_error("LidarFrontEndNode: shut down before the transform was available");
+}
+
+void LidarFrontEndNode::callback(const PointCloud2::SharedPtr msg)
+{
+  const common::time_utils::ScopedTrace trace{m_trace, msg->header.stamp};
+  try {
+    m_front_end->process(*msg);
+    // nonground first for the possible microseconds of latency
+    m_nonground_pub_ptr->publish(m_front_end->nonground());
+    m_ground_pub_ptr->publish(m_front_end->ground());
+    m_downsampled_pub_ptr->publish(m_front_end->downsampled());
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR(get_logger(), "LidarFrontEndNode: %s", e.what());
+  }
+}
+}  // namespace lidar_front_end_nodes
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
+
+RCLCPP_COMPONENTS_REGISTER_NODE(
+  autoware::perception::filters::lidar_front_end_nodes::LidarFrontEndNode)
@@ -0,0 +1,225 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <common/types.hpp>
+#include <lidar_front_end_nodes/lidar_front_end.hpp>
+#include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using autoware::common::types::float32_t;
+using autoware::common::types::PointXYZI;
+using autoware::common::types::PointXYZIF;
+using autoware::perception::filters::lidar_front_end_nodes::LidarFrontEnd;
+using autoware::perception::filters::lidar_front_end_nodes::PointCloud2;
+namespace ray_ground_classifier = autoware::perception::filters::ray_ground_classifier;
+namespace voxel_grid = autoware::perception::filters::voxel_grid;
+
+class LidarFrontEndTest : public ::testing::Test
+{
+protected:
+  LidarFrontEndTest()
+  : m_angle_filter{-3.0F, 3.0F},
+    m_distance_filter{1.0F, 60.0F},
+    m_classifier_cfg{1.5F, 20.0F, 7.0F, 70.0F, 0.05F, 0.3F, 0.6F, 5.0F},
+    m_aggregator_cfg{-3.14159F, 3.14159F, 0.01F, 512U},
+    m_voxel_cfg{make_point(-60.0F), make_point(60.0F), make_point(1.0F), 10000U}
+  {
+    m_tf.rotation.x = 0.0;
+    m_tf.rotation.y = 0.0;
+    m_tf.rotation.z = 0.0998334;
+    m_tf.rotation.w = 0.9950042;
+    m_tf.translation.x = 0.5;
+    m_tf.translation.y = -0.25;
+    m_tf.translation.z = 0.0;
+
+    // Ground rings with a wall in front of the lidar and a few points behind it, which are
+    // removed by the angle filter, and a few points which are too close
+    point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{m_raw, "lidar"};
+    for (float32_t r = 0.5F; r < 40.0F; r += 0.75F) {
+      for (float32_t theta = -3.14F; theta < 3.14F; theta += 0.02F) {
+        const auto x = r * std::cos(theta);
+        const auto y = r * std::sin(theta);
+        modifier.push_back(PointXYZI{x, y, -1.5F, r});
+      }
+    }
+    for (float32_t y = -4.0F; y < 4.0F; y += 0.1F) {
+      for (float32_t z = -1.4F; z < 1.0F; z += 0.1F) {
+        modifier.push_back(PointXYZI{12.0F, y, z, 100.0F});
+      }
+    }
+  }
+
+  static voxel_grid::PointXYZ make_point(const float32_t value)
+  {
+    voxel_grid::PointXYZ pt;
+    pt.x = value;
+    pt.y = value;
+    pt.z = value;
+    return pt;
+  }
+
+  LidarFrontEnd make_front_end(const std::size_t capacity, const bool downsample_ground) const
+  {
+    return LidarFrontEnd{m_angle_filter, m_distance_filter, m_tf, "lidar", "base_link",
+      m_classifier_cfg, m_aggregator_cfg, m_voxel_cfg, capacity, downsample_ground};
+  }
+
+  // The same steps as PointCloud2FilterTransformNode, RayGroundClassifierCloudNode and
+  // VoxelCloudNode with centroid voxels, each with its own intermediate cloud
+  void process_separately(const bool downsample_ground)
+  {
+    std::vector<PointXYZI> filtered;
+    const autoware::common::lidar_utils::StaticTransformer transformer{m_tf};
+    for (const auto & raw_pt : point_cloud_msg_wrapper::PointCloud2View<PointXYZI>{m_raw}) {
+      if (m_angle_filter(raw_pt) && m_distance_filter(raw_pt)) {
+        PointXYZI pt{raw_pt};
+        transformer.transform(raw_pt, pt);
+        filtered.push_back(pt);
+      }
+    }
+
+    std::vector<PointXYZIF> points;
+    for (const auto & pt : filtered) {
+      PointXYZIF pt_if{};
+      pt_if.x = pt.x;
+      pt_if.y = pt.y;
+      pt_if.z = pt.z;
+      pt_if.intensity = pt.intensity;
+      points.push_back(pt_if);
+    }
+    ray_ground_classifier::RayGroundClassifier classifier{m_classifier_cfg};
+    ray_ground_classifier::RayAggregator aggregator{m_aggregator_cfg};
+    autoware::common::types::PointPtrBlock ground_blk;
+    autoware::common::types::PointPtrBlock nonground_blk;
+    std::vector<const PointXYZIF *> near_origin;
+    for (const auto & pt : points) {
+      if ((std::fabs(pt.x) > std::numeric_limits<float32_t>::epsilon()) ||
+        (std::fabs(pt.y) > std::numeric_limits<float32_t>::epsilon()))
+      {
+        if (!aggregator.insert(&pt)) {
+          aggregator.end_of_scan();
+        }
+      } else {
+        near_origin.push_back(&pt);
+      }
+    }
+    aggregator.end_of_scan();
+    m_ground.clear();
+    m_nonground.clear();
+    for (const auto * const pt : near_origin) {
+      m_nonground.push_back(PointXYZI{pt->x, pt->y, pt->z, pt->intensity});
+    }
+    const auto num_ready = aggregator.get_ready_ray_count();
+    for (std::size_t i = 0U; i < num_ready; ++i) {
+      ground_blk.clear();
+      nonground_blk.clear();
+      classifier.partition(aggregator.get_next_ray(), ground_blk, nonground_blk);
+      for (const auto * const pt : ground_blk) {
+        m_ground.push_back(PointXYZI{pt->x, pt->y, pt->z, pt->intensity});
+      }
+      for (const auto * const pt : nonground_blk) {
+        m_nonground.push_back(PointXYZI{pt->x, pt->y, pt->z, pt->intensity});
+      }
+    }
+
+    voxel_grid::VoxelGrid<voxel_grid::CentroidVoxel<PointXYZIF>,
+      voxel_grid::FlatVoxelStorage> grid{m_voxel_cfg};
+    const auto insert = [&grid](const std::vector<PointXYZI> & cloud) {
+        for (const auto & pt : cloud) {
+          PointXYZIF pt_if{};
+          pt_if.x = pt.x;
+          pt_if.y = pt.y;
+          pt_if.z = pt.z;
+          pt_if.intensity = pt.intensity;
+          grid.insert(pt_if);
+        }
+      };
+    // The whole filtered cloud, or the nonground output of the ground classification
+    insert(downsample_ground ? filtered : m_nonground);
+    m_downsampled.clear();
+    for (const auto & it : grid) {
+      const auto & pt = it.second.get();
+      m_downsampled.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
+    }
+  }
+
+  static void expect_equal(const std::vector<PointXYZI> & expected, const PointCloud2 & msg)
+  {
+    EXPECT_EQ(msg.header.frame_id, "base_link");
+    const point_cloud_msg_wrapper::PointCloud2View<PointXYZI> view{msg};
+    ASSERT_EQ(view.size(), expected.size());
+    constexpr float32_t TOL = 1.0E-5F;
+    for (std::size_t idx = 0U; idx < expected.size(); ++idx) {
+      EXPECT_NEAR(view[idx].x, expected[idx].x, TOL);
+      EXPECT_NEAR(view[idx].y, expected[idx].y, TOL);
+      EXPECT_NEAR(view[idx].z, expected[idx].z, TOL);
+      EXPECT_NEAR(view[idx].intensity, expected[idx].intensity, TOL);
+    }
+  }
+
+  const LidarFrontEnd::AngleFilter m_angle_filter;
+  const LidarFrontEnd::DistanceFilter m_distance_filter;
+  const ray_ground_classifier::Config m_classifier_cfg;
+  const ray_ground_classifier::RayAggregator::Config m_aggregator_cfg;
+  const voxel_grid::Config m_voxel_cfg;
+  geometry_msgs::msg::Transform m_tf;
+  PointCloud2 m_raw;
+  std::vector<PointXYZI> m_ground;
+  std::vector<PointXYZI> m_nonground;
+  std::vector<PointXYZI> m_downsampled;
+};
+
+TEST_F(LidarFrontEndTest, MatchesSeparateStages)
+{
+  for (const auto downsample_ground : {false, true}) {
+    SCOPED_TRACE(downsample_ground ? "downsample_ground" : "downsample_nonground");
+    auto front_end = make_front_end(m_raw.width, downsample_ground);
+    process_separately(downsample_ground);
+    m_raw.header.stamp.sec = 5;
+    // Twice, to check that nothing is left over from the previous cloud
+    for (int32_t i = 0; i < 2; ++i) {
+      front_end.process(m_raw);
+      ASSERT_FALSE(m_ground.empty());
+      ASSERT_FALSE(m_nonground.empty());
+      expect_equal(m_ground, front_end.ground());
+      expect_equal(m_nonground, front_end.nonground());
+      expect_equal(m_downsampled, front_end.downsampled());
+      EXPECT_EQ(front_end.downsampled().header.stamp.sec, 5);
+    }
+  }
+}
+
+TEST_F(LidarFrontEndTest, Errors)
+{
+  auto front_end = make_front_end(100U, false);
+  // Too many filtered points
+  EXPECT_THROW(front_end.process(m_raw), std::runtime_error);
+  // Unexpected frame
+  m_raw.header.frame_id = "base_link";
+  EXPECT_THROW(front_end.process(m_raw), std::runtime_error);
+  // A failed cloud leaves nothing behind
+  PointCloud2 empty;
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{empty, "lidar"};
+  front_end.process(empty);
+  EXPECT_EQ(front_end.ground().width, 0U);
+  EXPECT_EQ(front_end.nonground().width, 0U);
+  EXPECT_EQ(front_end.downsampled().width, 0U);
+}
@@ -22,10 +22,15 @@
 #define OFF_MAP_OBSTACLES_FILTER__OFF_MAP_OBSTACLES_FILTER_HPP_
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "autoware_auto_msgs/msg/bounding_box_array.hpp"
 #include "common/types.hpp"
 
+#include "boost/geometry.hpp"
+#include "boost/geometry/index/rtree.hpp"
+#include "Eigen/Core"
 #include "geometry_msgs/msg/transform_stamped.hpp"
 #include "lanelet2_core/LaneletMap.h"
 #include "off_map_obstacles_filter/visibility_control.hpp"
@@ -43,7 +48,9 @@ using float64_t = autoware::common::types::float64_t;
 class OFF_MAP_OBSTACLES_FILTER_PUBLIC OffMapObstaclesFilter
 {
 public:
-  /// \brief Constructor.
+  /// \brief Constructor. The drivable area of the map, i.e. its lanelets and its parking spot and
+  /// parking access areas, is cached as polygons in a spatial index, so that filtering does not
+  /// need to convert map primitives.
   /// \param map The lanelet map, correctly transformed into the map frame.
   /// \param overlap_threshold What fraction of a bbox needs to overlap the map to be considered
   /// "on the map".
@@ -66,12 +73,27 @@ public:
     autoware_auto_msgs::msg::BoundingBoxArray & msg) const;
 
 private:
+  using Polygon = boost::geometry::model::polygon<Eigen::Vector2d>;
+  using Box = boost::geometry::model::box<Eigen::Vector2d>;
+  /// Envelope of a drivable polygon and its index in m_drivable_polygons.
+  using IndexValue = std::pair<Box, std::size_t>;
+  using RTree = boost::geometry::index::rtree<IndexValue, boost::geometry::index::quadratic<16U>>;
+
+  /// \brief Checks if a bbox is on the map.
+  /// \param bbox_poly The polygon of the bbox in the map frame.
+  /// \return True if the drivable area covers at least the threshold fraction of the bbox.
+  bool bbox_is_on_map(const Polygon & bbox_poly) const;
+
   /// The full lanelet map.
   const std::shared_ptr<lanelet::LaneletMap> m_map;
   /// What fraction of a bbox needs to overlap the map to be considered "on the map".
   /// Note that the default value will always be overwritten by the constructor, it's just here to
   /// be safe.
   const float64_t m_overlap_threshold {1.0};
+  /// Polygons of the drivable lanelets and areas, in the orientation expected by boost::geometry.
+  std::vector<Polygon> m_drivable_polygons;
+  /// Index of the envelopes of m_drivable_polygons.
+  RTree m_drivable_index;
 };
 
 }  // namespace off_map_obstacles_filter
@@ -16,8 +16,11 @@
 
 #include "off_map_obstacles_filter/off_map_obstacles_filter.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "common/types.hpp"
@@ -40,21 +43,67 @@ namespace off_map_obstacles_filter
 
 using float32_t = autoware::common::types::float32_t;
 using float64_t = autoware::common::types::float64_t;
-namespace utils = lanelet::utils;
+
+namespace
+{
+using polygon_t = boost::geometry::model::polygon<Eigen::Vector2d>;
+
+/// \brief Copy the points of a map polygon into a boost polygon, closed and in the orientation
+/// boost::geometry expects, since the map does not guarantee either.
+/// \param points The points of a lanelet or area polygon.
+/// \return The polygon.
+template<typename PointsT>
+polygon_t to_polygon(const PointsT & points)
+{
+  polygon_t polygon;
+  for (const auto & p : points) {
+    polygon.outer().emplace_back(p.x(), p.y());
+  }
+  boost::geometry::correct(polygon);
+  return polygon;
+}
+
+/// \brief Checks if an area counts as drivable, i.e. is a parking spot or parking access.
+bool is_drivable_area(const lanelet::ConstArea & area)
+{
+  if (!area.hasAttribute("subtype") || !area.hasAttribute("cad_id")) {
+    return false;
+  }
+  const auto subtype = area.attribute("subtype").value();
+  return (subtype == "parking_access") || (subtype == "parking_spot");
+}
+}  // namespace
 
 OffMapObstaclesFilter::OffMapObstaclesFilter(
   std::shared_ptr<lanelet::LaneletMap> map,
   float64_t overlap_threshold)
-: m_map{map}, m_overlap_threshold{overlap_threshold} {}
+: m_map{map}, m_overlap_threshold{overlap_threshold}
+{
+  for (const auto & lanelet : m_map->laneletLayer) {
+    m_drivable_polygons.push_back(to_polygon(lanelet.polygon2d()));
+  }
+  for (const auto & area : m_map->areaLayer) {
+    if (is_drivable_area(area)) {
+      m_drivable_polygons.push_back(to_polygon(area.outerBoundPolygon()));
+    }
+  }
+  // The range constructor bulk loads the tree, which gives a better tree than inserting
+  std::vector<IndexValue> values;
+  values.reserve(m_drivable_polygons.size());
+  for (std::size_t i = 0U; i < m_drivable_polygons.size(); ++i) {
+    values.emplace_back(boost::geometry::return_envelope<Box>(m_drivable_polygons[i]), i);
+  }
+  m_drivable_index = RTree{values.begin(), values.end()};
+}
 
 /// \param bbox The bounding box with coordinates in the base_link frame.
 /// \param map_from_base_link The transform that transforms things from base_link to map.
-/// \return A polygon with the four corners of the bounding box projected into 2D.
-static lanelet::Polygon2d polygon_for_bbox(
+/// \return A closed polygon with the four corners of the bounding box projected into 2D.
+static polygon_t polygon_for_bbox(
   const Eigen::Isometry2f & map_from_base_link,
   const autoware_auto_msgs::msg::BoundingBox & bbox)
 {
-  // Create lanelet polygon from bounding box
+  // Create polygon from bounding box
   // We can neglect z here already, I had a peek into bounding_box.cpp and it's basically 2d only
   const Eigen::Vector2f dx {0.5f * bbox.size.x, 0.0f};
   const Eigen::Vector2f dy {0.0f, 0.5f * bbox.size.y};
@@ -67,7 +116,7 @@ static lanelet::Polygon2d polygon_for_bbox(
 
   const Eigen::Rotation2D<float32_t> orientation {yaw};
 
-  // Construct the points in clockwise order – required by lanelet::Polygon2d
+  // Construct the points in clockwise order – required by boost::geometry's default polygon
   const Eigen::Vector2f p0 = map_from_base_link * (centroid + orientation *
     (Eigen::Vector2f::Zero() - dx - dy));
   const Eigen::Vector2f p1 = map_from_base_link * (centroid + orientation *
@@ -77,11 +126,13 @@ static lanelet::Polygon2d polygon_for_bbox(
   const Eigen::Vector2f p3 = map_from_base_link * (centroid + orientation *
     (Eigen::Vector2f::Zero() + dx - dy));
 
-  lanelet::Polygon2d bbox_poly;
-  bbox_poly.push_back(lanelet::Point2d{utils::getId(), p0.x(), p0.y()});
-  bbox_poly.push_back(lanelet::Point2d{utils::getId(), p1.x(), p1.y()});
-  bbox_poly.push_back(lanelet::Point2d{utils::getId(), p2.x(), p2.y()});
-  bbox_poly.push_back(lanelet::Point2d{utils::getId(), p3.x(), p3.y()});
+  // Plain points, so that no lanelet primitives need to be created per box
+  polygon_t bbox_poly;
+  bbox_poly.outer().push_back(p0.cast<float64_t>());
+  bbox_poly.outer().push_back(p1.cast<float64_t>());
+  bbox_poly.outer().push_back(p2.cast<float64_t>());
+  bbox_poly.outer().push_back(p3.cast<float64_t>());
+  bbox_poly.outer().push_back(p0.cast<float64_t>());
   return bbox_poly;
 }
 
@@ -134,84 +185,39 @@ visualization_msgs::msg::MarkerArray OffMapObstaclesFilter::bboxes_in_map_frame_
     marker.color.b = 0.3f;
     marker.color.a = 1.0f;
     marker.lifetime.sec = 1;
+    // The polygon is closed, so the line strip ends at its first corner
     geometry_msgs::msg::Point p;
     p.z = 0.0;
-    p.x = polygon[0].x();
-    p.y = polygon[0].y();
-    marker.points.push_back(p);
-    p.x = polygon[1].x();
-    p.y = polygon[1].y();
-    marker.points.push_back(p);
-    p.x = polygon[2].x();
-    p.y = polygon[2].y();
-    marker.points.push_back(p);
-    p.x = polygon[3].x();
-    p.y = polygon[3].y();
-    marker.points.push_back(p);
-    p.x = polygon[0].x();
-    p.y = polygon[0].y();
-    marker.points.push_back(p);
+    for (const auto & corner : polygon.outer()) {
+      p.x = corner.x();
+      p.y = corner.y();
+      marker.points.push_back(p);
+    }
     array.markers.push_back(marker);
   }
   return array;
 }
 
-/// \brief Checks if a bbox is on the map.
-/// \param map The lanelet map, correctly transformed into the map frame.
-/// \param map_from_base_link An Isometry2d that can be used to transform Eigen Vectors.
-/// \param overlap_threshold What fraction of a bbox needs to overlap the map to be considered
-/// "on the map".
-/// \param bbox An obstacle bounding box.
-static bool bbox_is_on_map(
-  const lanelet::LaneletMap & map,
-  const Eigen::Isometry2f & map_from_base_link,
-  const float64_t overlap_threshold,
-  const autoware_auto_msgs::msg::BoundingBox & bbox)
+bool OffMapObstaclesFilter::bbox_is_on_map(const Polygon & bbox_poly) const
 {
-  const lanelet::Polygon2d bbox_poly = polygon_for_bbox(map_from_base_link, bbox);
-  // See https://github.com/fzi-forschungszentrum-informatik/Lanelet2/blob/master/lanelet2_core/doc/GeometryPrimer.md
-  const lanelet::ConstHybridPolygon2d bbox_poly_hybrid = utils::toHybrid(bbox_poly);
-  const float64_t total_area = lanelet::geometry::area(bbox_poly_hybrid);
+  const float64_t total_area = boost::geometry::area(bbox_poly);
 
   // Now find possibly-intersecting lanelets and areas
-  const lanelet::BoundingBox2d bbox_bbox = lanelet::geometry::boundingBox2d(bbox_poly);
-  const std::vector<lanelet::ConstLanelet> ll_candidates = map.laneletLayer.search(bbox_bbox);
-  const std::vector<lanelet::ConstArea> area_candidates = map.areaLayer.search(bbox_bbox);
-
-  // The output point type needs to be the same, but it seems easier to use boost's builtin polygon
-  // as the (multi)polygon type for the output.
-  typedef boost::geometry::model::polygon<Eigen::Vector2d> polygon_t;
-  typedef boost::geometry::model::multi_polygon<polygon_t> mpolygon_t;
-  mpolygon_t output;
+  const Box bbox_bbox = boost::geometry::return_envelope<Box>(bbox_poly);
+  std::vector<IndexValue> candidates;
+  m_drivable_index.query(
+    boost::geometry::index::intersects(bbox_bbox), std::back_inserter(candidates));
 
   // For each of them, check if an intersection exists
+  typedef boost::geometry::model::multi_polygon<Polygon> mpolygon_t;
+  mpolygon_t output;
   float64_t overlap_area = 0.0;
-  for (const auto candidate : ll_candidates) {
-    // Annoying – this seems to be the only way to do the intersection
-    lanelet::Polygon2d ll_poly;
-    for (const auto p : candidate.polygon2d()) {
-      ll_poly.push_back(lanelet::Point2d{utils::getId(), p.x(), p.y()});
-    }
-    lanelet::ConstHybridPolygon2d ll_poly_hybrid = utils::toHybrid(ll_poly);
-    boost::geometry::intersection(ll_poly_hybrid, bbox_poly_hybrid, output);
-    overlap_area += boost::geometry::area(output);
-    if (overlap_area / total_area >= overlap_threshold) {
-      return true;
-    }
-  }
-  for (const auto candidate : area_candidates) {
-    if (!candidate.hasAttribute("subtype") || !candidate.hasAttribute("cad_id")) {continue;}
-    if (candidate.attribute("subtype") != "parking_access" &&
-      candidate.attribute("subtype") != "parking_spot") {continue;}
-    // Annoying – this seems to be the only way to do the intersection
-    lanelet::Polygon2d area_poly;
-    for (const auto p : candidate.outerBoundPolygon()) {
-      area_poly.push_back(lanelet::Point2d{utils::getId(), p.x(), p.y()});
-    }
-    lanelet::ConstHybridPolygon2d area_poly_hybrid = utils::toHybrid(area_poly);
-    boost::geometry::intersection(area_poly_hybrid, bbox_poly_hybrid, output);
+  for (const auto & candidate : candidates) {
+    // intersection() appends to the output, which would count earlier overlaps again
+    output.clear();
+    boost::geometry::intersection(m_drivable_polygons[candidate.second], bbox_poly, output);
     overlap_area += boost::geometry::area(output);
-    if (overlap_area / total_area >= overlap_threshold) {
+    if (overlap_area / total_area >= m_overlap_threshold) {
       return true;
     }
   }
@@ -228,9 +234,8 @@ void OffMapObstaclesFilter::remove_off_map_bboxes(
       msg.boxes.begin(),
       msg.boxes.end(),
       [this, &map_from_base_link_isometry](const auto & bbox) {
-        return !bbox_is_on_map(
-          *this->m_map, map_from_base_link_isometry.cast<float32_t>(),
-          this->m_overlap_threshold, bbox);
+        return !this->bbox_is_on_map(
+          polygon_for_bbox(map_from_base_link_isometry.cast<float32_t>(), bbox));
       }),
     msg.boxes.end());
 }
@@ -14,9 +14,80 @@
 //
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
+#include <lanelet2_core/LaneletMap.h>
+
+#include <memory>
+
 #include "gtest/gtest.h"
 #include "off_map_obstacles_filter/off_map_obstacles_filter.hpp"
 
+using autoware::off_map_obstacles_filter::OffMapObstaclesFilter;
+using autoware::common::types::float32_t;
+
+namespace
+{
+// A lanelet covering [0, 10] x [-2, 2] and a parking spot covering [20, 24] x [0, 4]
+std::shared_ptr<lanelet::LaneletMap> make_map()
+{
+  using lanelet::utils::getId;
+  const lanelet::LineString3d left(
+    getId(), {lanelet::Point3d(getId(), 0, 2, 0), lanelet::Point3d(getId(), 10, 2, 0)});
+  const lanelet::LineString3d right(
+    getId(), {lanelet::Point3d(getId(), 0, -2, 0), lanelet::Point3d(getId(), 10, -2, 0)});
+  const lanelet::Lanelet lanelet(getId(), left, right);
+  const lanelet::LineString3d outer(
+    getId(), {lanelet::Point3d(getId(), 20, 0, 0), lanelet::Point3d(getId(), 24, 0, 0),
+      lanelet::Point3d(getId(), 24, 4, 0), lanelet::Point3d(getId(), 20, 4, 0)});
+  const lanelet::Area area(
+    getId(), {outer}, {}, lanelet::AttributeMap{{"subtype", "parking_spot"}, {"cad_id", "1"}});
+  return lanelet::utils::createMap({lanelet}, {area});
+}
+
+autoware_auto_msgs::msg::BoundingBox make_box(const float32_t x, const float32_t y)
+{
+  autoware_auto_msgs::msg::BoundingBox box;
+  box.centroid.x = x;
+  box.centroid.y = y;
+  box.size.x = 2.0f;
+  box.size.y = 2.0f;
+  box.orientation.w = 1.0f;
+  return box;
+}
+}  // namespace
+
 TEST(TestOffMapObstaclesFilter, TestRemoveOffMapBboxes) {
-  // Not implemented yet
+  const OffMapObstaclesFilter filter{make_map(), 0.6};
+  geometry_msgs::msg::TransformStamped map_from_base_link;
+  map_from_base_link.transform.rotation.w = 1.0;
+  autoware_auto_msgs::msg::BoundingBoxArray msg;
+  // On the lanelet
+  msg.boxes.push_back(make_box(5.0f, 0.0f));
+  // Half on the lanelet, below the threshold
+  msg.boxes.push_back(make_box(10.0f, 0.0f));
+  // On the parking spot
+  msg.boxes.push_back(make_box(22.0f, 2.0f));
+  // Off the map
+  msg.boxes.push_back(make_box(50.0f, 50.0f));
+  filter.remove_off_map_bboxes(map_from_base_link, msg);
+  ASSERT_EQ(msg.boxes.size(), 2U);
+  EXPECT_FLOAT_EQ(msg.boxes[0].centroid.x, 5.0f);
+  EXPECT_FLOAT_EQ(msg.boxes[1].centroid.x, 22.0f);
+}
+
+TEST(TestOffMapObstaclesFilter, TestAdjacentLanelets) {
+  // A box across the shared bound of two lanelets is covered by their overlaps together
+  using lanelet::utils::getId;
+  const lanelet::Point3d p0(getId(), 0, -2, 0), p1(getId(), 10, -2, 0);
+  const lanelet::Point3d p2(getId(), 0, 2, 0), p3(getId(), 10, 2, 0);
+  const lanelet::Point3d p4(getId(), 0, 6, 0), p5(getId(), 10, 6, 0);
+  const lanelet::LineString3d bound0(getId(), {p0, p1}), bound1(getId(), {p2, p3});
+  const lanelet::LineString3d bound2(getId(), {p4, p5});
+  const lanelet::Lanelet lower(getId(), bound1, bound0), upper(getId(), bound2, bound1);
+  const OffMapObstaclesFilter filter{lanelet::utils::createMap({lower, upper}), 0.9};
+  geometry_msgs::msg::TransformStamped map_from_base_link;
+  map_from_base_link.transform.rotation.w = 1.0;
+  autoware_auto_msgs::msg::BoundingBoxArray msg;
+  msg.boxes.push_back(make_box(5.0f, 2.0f));
+  filter.remove_off_map_bboxes(map_from_base_link, msg);
+  EXPECT_EQ(msg.boxes.size(), 1U);
 }
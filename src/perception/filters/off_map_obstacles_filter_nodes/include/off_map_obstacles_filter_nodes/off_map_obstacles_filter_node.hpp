@@ -34,6 +34,7 @@
 #include "rclcpp/rclcpp.hpp"
 #include "tf2_ros/buffer.h"
 #include "tf2_ros/transform_listener.h"
+#include "time_utils/trace.hpp"
 #include "visualization_msgs/msg/marker_array.hpp"
 
 namespace autoware
@@ -80,6 +81,8 @@ private:
   tf2_ros::TransformListener m_tf2_listener;
   /// Stores the overlap before the filter has been constructed
   float64_t m_overlap_threshold{1.0};  // Placeholder value
+  /// Records when each box array enters and leaves the callback, if tracing is switched on
+  const common::time_utils::TracePoint m_trace;
 };
 }  // namespace off_map_obstacles_filter_nodes
 }  // namespace autoware
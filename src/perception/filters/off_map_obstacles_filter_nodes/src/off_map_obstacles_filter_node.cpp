@@ -50,7 +50,8 @@ OffMapObstaclesFilterNode::OffMapObstaclesFilterNode(const rclcpp::NodeOptions &
       rmw_qos_profile_services_default)),
   m_tf2_buffer(this->get_clock()),
   m_tf2_listener(m_tf2_buffer),
-  m_overlap_threshold(declare_parameter("overlap_threshold").get<float64_t>())
+  m_overlap_threshold(declare_parameter("overlap_threshold").get<float64_t>()),
+  m_trace(get_fully_qualified_name())
 {
   while (!m_map_client_ptr->wait_for_service(1s)) {
     if (!rclcpp::ok()) {
@@ -84,6 +85,7 @@ void OffMapObstaclesFilterNode::map_response(
 
 void OffMapObstaclesFilterNode::process_bounding_boxes(const ObstacleMsg::SharedPtr msg) const
 {
+  const common::time_utils::ScopedTrace trace{m_trace, msg->header.stamp};
   if (!m_filter) {
     RCLCPP_INFO(get_logger(), "Did not filter boxes because no map was available.");
     m_pub_ptr->publish(*msg);
@@ -21,7 +21,10 @@
 
 #include <vector>
 #include <memory>
+#include <utility>
 
+#include "common/types.hpp"
+#include "geometry/spatial_hash_config.hpp"
 #include "outlier_filter/visibility_control.hpp"
 
 #include "pcl/search/pcl_search.h"
@@ -40,6 +43,17 @@ namespace outlier_filter
 namespace radius_search_2d_filter
 {
 
+/** \brief Neighbor search implementations available to the RadiusSearch2DFilter */
+enum class SearchBackend
+{
+  /** \brief One radius search per point in a PCL kd-tree */
+  KD_TREE,
+  /** \brief Bin the cloud into a 2D lattice once, then count neighbors of all points of a cell in
+   * a single pass over its neighboring cells
+   */
+  SPATIAL_HASH
+};
+
 /** \class RadiusSearch2DFilter
  * \brief Library for using a radius based 2D filtering algorithm on a PCL pointcloud
  */
@@ -49,8 +63,11 @@ public:
   /** \brief Constructor for the RadiusSearch2DFilter class
    * \param search_radius Radius bounding a point's neighbors
    * \param min_neighbors Minimum number of surrounding neighbors for a point
+   * \param search_backend Implementation used to count the neighbors of each point
    */
-  OUTLIER_FILTER_PUBLIC RadiusSearch2DFilter(double search_radius, int min_neighbors);
+  OUTLIER_FILTER_PUBLIC RadiusSearch2DFilter(
+    double search_radius, int min_neighbors,
+    SearchBackend search_backend = SearchBackend::KD_TREE);
 
   /** \brief Filter function that runs the radius search algorithm.
    * \param input The input point cloud for filtering
@@ -60,6 +77,14 @@ public:
     const pcl::PointCloud<pcl::PointXYZ> & input,
     pcl::PointCloud<pcl::PointXYZ> & output);
 
+  /** \brief Get the implementation used to count the neighbors of each point
+   * \return SearchBackend The search backend
+   */
+  SearchBackend OUTLIER_FILTER_PUBLIC get_search_backend() const
+  {
+    return search_backend_;
+  }
+
   /** \brief Update dynamically configurable parameters
    * \param search_radius Parameter that updates the search_radius_ member variable
    * \param min_neighbors Parameter that updates the min_neighbors_ member variable
@@ -71,14 +96,70 @@ public:
   }
 
 private:
+  using Index = autoware::common::geometry::spatial_hash::Index;
+
+  /** \brief A point of the input cloud, flattened and tagged with its lattice bin */
+  struct BinnedPoint
+  {
+    autoware::common::types::float32_t x;
+    autoware::common::types::float32_t y;
+    Index bin;
+    std::size_t input_idx;
+  };
+
+  /** \brief Filter function for the kd-tree backend */
+  void OUTLIER_FILTER_LOCAL filter_kd_tree(
+    const pcl::PointCloud<pcl::PointXYZ> & input,
+    pcl::PointCloud<pcl::PointXYZ> & output);
+
+  /** \brief Filter function for the spatial hash backend */
+  void OUTLIER_FILTER_LOCAL filter_spatial_hash(
+    const pcl::PointCloud<pcl::PointXYZ> & input,
+    pcl::PointCloud<pcl::PointXYZ> & output);
+
+  /** \brief Find the range of binned_points_ belonging to a lattice bin by walking forward
+   * \param bin The lattice bin
+   * \param cursor Position in binned_points_ from which to walk, moved to the start of the range
+   * \return The range [begin, end), which is empty if the bin has no points
+   */
+  std::pair<std::size_t, std::size_t> OUTLIER_FILTER_LOCAL find_cell(
+    Index bin, std::size_t & cursor) const;
+
+  /** \brief Get the cursor of the merged walk over the neighboring cells at a bin offset */
+  OUTLIER_FILTER_LOCAL std::size_t & cell_cursor(Index offset);
+
+  /** \brief Count the neighbor pairs between two ranges of binned_points_, incrementing the
+   * neighbor count of both points of each pair. Passing the same range twice counts the pairs
+   * within the range.
+   */
+  void OUTLIER_FILTER_LOCAL count_neighbor_pairs(
+    const std::pair<std::size_t, std::size_t> & ref_cell,
+    const std::pair<std::size_t, std::size_t> & query_cell,
+    autoware::common::types::float32_t radius2);
+
   /** \brief Radius bounding a point's neighbors */
   double search_radius_;
 
   /** \brief Minimum number of surrounding neighbors for a point to not be considered an outlier */
   int min_neighbors_;
 
+  /** \brief Implementation used to count the neighbors of each point */
+  SearchBackend search_backend_;
+
   /** \brief PCL Search object used to perform the radial search */
   std::shared_ptr<pcl::search::Search<pcl::PointXY>> kd_tree_;
+
+  /** \brief Finite input points sorted by lattice bin, reused between calls */
+  std::vector<BinnedPoint> binned_points_;
+
+  /** \brief Number of neighbors of each point in binned_points_, including the point itself */
+  std::vector<int> neighbor_counts_;
+
+  /** \brief Bin offset and position in binned_points_ of each neighboring cell cursor */
+  std::vector<std::pair<Index, std::size_t>> cell_cursors_;
+
+  /** \brief Whether each point of the input cloud is kept */
+  std::vector<bool> is_inlier_;
 };
 }  // namespace radius_search_2d_filter
 }  // namespace outlier_filter
@@ -19,7 +19,10 @@
 #ifndef OUTLIER_FILTER__VOXEL_GRID_OUTLIER_FILTER_HPP_
 #define OUTLIER_FILTER__VOXEL_GRID_OUTLIER_FILTER_HPP_
 
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <vector>
 
 #include "outlier_filter/visibility_control.hpp"
 
@@ -51,12 +54,27 @@ public:
    * \param voxel_size_y Voxel leaf size of side Y
    * \param voxel_size_z Voxel leaf size of side Z
    * \param voxel_points_threshold Minimum number of points per voxel
+   * \param temporal_window Number of scans, including the current one, whose points are counted
+   * in the voxels. 0 disables the incremental mode, so that only the current scan is counted
+   * \param rolling_grid_range_xy Half width of the rolling grid in x and y, incremental mode only
+   * \param rolling_grid_range_z Half width of the rolling grid in z, incremental mode only
+   * \throw std::domain_error If the incremental mode is enabled and the rolling grid has no voxels
+   * or too many voxels to be indexed
    */
   explicit OUTLIER_FILTER_PUBLIC VoxelGridOutlierFilter(
     float voxel_size_x, float voxel_size_y,
-    float voxel_size_z, uint32_t voxel_points_threshold);
-
-  /** \brief Filter function that runs the radius search algorithm.
+    float voxel_size_z, uint32_t voxel_points_threshold,
+    uint32_t temporal_window = 0U,
+    float rolling_grid_range_xy = 25.0F,
+    float rolling_grid_range_z = 3.0F);
+
+  /** \brief Filter function that runs the voxel grid outlier filter algorithm.
+   *
+   * In incremental mode, the points of the input are added to the rolling grid and the points of
+   * the scan leaving the temporal window are removed from it, so the cost scales with the size of
+   * the scans rather than with the size of the window. Points outside of the rolling grid are
+   * removed.
+   *
    * \param input The input point cloud for filtering
    * \param output The output point cloud
    */
@@ -64,6 +82,23 @@ public:
     const pcl::PointCloud<pcl::PointXYZ> & input,
     pcl::PointCloud<pcl::PointXYZ> & output);
 
+  /** \brief Move the center of the rolling grid, e.g. to the ego position when the input clouds are
+   * in a fixed frame. By default the grid is centered on the origin of the input frame. Voxel
+   * counts are kept, so moving the grid costs nothing; voxels leaving the grid are dropped lazily.
+   * \param x Center of the grid in x
+   * \param y Center of the grid in y
+   * \param z Center of the grid in z
+   */
+  void OUTLIER_FILTER_PUBLIC set_rolling_grid_center(float x, float y, float z);
+
+  /** \brief Get the number of scans counted in the voxels in incremental mode
+   * \return uint32_t The temporal window, 0 if the incremental mode is disabled
+   */
+  uint32_t OUTLIER_FILTER_PUBLIC get_temporal_window() const
+  {
+    return temporal_window_;
+  }
+
   /** \brief Update dynamically configurable parameters
    * \param voxel_size_x Parameter that updates the voxel_size_x_ member variable
    * \param voxel_size_y Parameter that updates the voxel_size_y_ member variable
@@ -75,13 +110,55 @@ public:
     float voxel_size_z,
     uint32_t voxel_points_threshold)
   {
+    // Voxel counts of past scans are meaningless for a different voxel size
+    const bool reset_grid = (voxel_size_x != voxel_size_x_) || (voxel_size_y != voxel_size_y_) ||
+      (voxel_size_z != voxel_size_z_);
     voxel_size_x_ = voxel_size_x;
     voxel_size_y_ = voxel_size_y;
     voxel_size_z_ = voxel_size_z;
     voxel_points_threshold_ = voxel_points_threshold;
+    if (reset_grid && (temporal_window_ > 0U)) {
+      init_rolling_grid();
+    }
   }
 
 private:
+  /** \brief Integer coordinates of a voxel */
+  struct VoxelKey
+  {
+    int64_t x;
+    int64_t y;
+    int64_t z;
+  };
+
+  /** \brief A voxel of the rolling grid. The generation counts the voxels which used the cell */
+  struct RollingGridCell
+  {
+    VoxelKey key;
+    uint32_t count;
+    uint64_t generation;
+  };
+
+  /** \brief The cell a point of a past scan was added to, and the generation of the cell then. A
+   * voxel can leave the grid and come back, so its key alone does not identify its counts
+   */
+  struct CellRecord
+  {
+    std::size_t cell;
+    uint64_t generation;
+  };
+
+  /** \brief Filter function for the incremental mode */
+  void OUTLIER_FILTER_LOCAL filter_incremental(
+    const pcl::PointCloud<pcl::PointXYZ> & input,
+    pcl::PointCloud<pcl::PointXYZ> & output);
+
+  /** \brief Size the rolling grid to the current voxel size and clear all voxel counts */
+  void OUTLIER_FILTER_LOCAL init_rolling_grid();
+
+  /** \brief Number of voxels of the rolling grid along an axis */
+  static int64_t OUTLIER_FILTER_LOCAL rolling_grid_cells(float range, float voxel_size);
+
   /** \brief Voxel leaf size of side X */
   float voxel_size_x_;
 
@@ -96,6 +173,36 @@ private:
 
   /** \brief Assembles a 3D grid over the pointcloud for filtering */
   std::shared_ptr<pcl::VoxelGrid<pcl::PointXYZ>> voxel_filter_;
+
+  /** \brief Number of scans counted in the voxels, 0 if the incremental mode is disabled */
+  uint32_t temporal_window_;
+
+  /** \brief Half width of the rolling grid in x and y */
+  float rolling_grid_range_xy_;
+
+  /** \brief Half width of the rolling grid in z */
+  float rolling_grid_range_z_;
+
+  /** \brief Center of the rolling grid */
+  float center_x_;
+  float center_y_;
+  float center_z_;
+
+  /** \brief Number of voxels of the rolling grid along each axis */
+  int64_t cells_x_;
+  int64_t cells_y_;
+  int64_t cells_z_;
+
+  /** \brief Voxels of the rolling grid, indexed by voxel coordinates modulo the grid size, so the
+   * grid can move without copying any voxel
+   */
+  std::vector<RollingGridCell> rolling_grid_;
+
+  /** \brief Cells the points of each scan in the temporal window were added to, oldest first */
+  std::deque<std::vector<CellRecord>> scan_history_;
+
+  /** \brief Cell of each point of the current scan, or -1 if it is outside of the rolling grid */
+  std::vector<int64_t> point_cells_;
 };
 
 }  // namespace voxel_grid_outlier_filter
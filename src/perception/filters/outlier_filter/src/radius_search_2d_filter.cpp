@@ -12,8 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 #include <memory>
+#include <utility>
 
 #include "outlier_filter/radius_search_2d_filter.hpp"
 
@@ -30,8 +34,13 @@ namespace outlier_filter
 namespace radius_search_2d_filter
 {
 
-RadiusSearch2DFilter::RadiusSearch2DFilter(double search_radius, int min_neighbors)
-: search_radius_(search_radius), min_neighbors_(min_neighbors)
+using autoware::common::types::float32_t;
+using autoware::common::geometry::spatial_hash::Config2d;
+
+RadiusSearch2DFilter::RadiusSearch2DFilter(
+  double search_radius, int min_neighbors,
+  SearchBackend search_backend)
+: search_radius_(search_radius), min_neighbors_(min_neighbors), search_backend_(search_backend)
 {
   kd_tree_ = std::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
 }
@@ -39,6 +48,17 @@ RadiusSearch2DFilter::RadiusSearch2DFilter(double search_radius, int min_neighbo
 void RadiusSearch2DFilter::filter(
   const pcl::PointCloud<pcl::PointXYZ> & input,
   pcl::PointCloud<pcl::PointXYZ> & output)
+{
+  if (SearchBackend::SPATIAL_HASH == search_backend_) {
+    filter_spatial_hash(input, output);
+  } else {
+    filter_kd_tree(input, output);
+  }
+}
+
+void RadiusSearch2DFilter::filter_kd_tree(
+  const pcl::PointCloud<pcl::PointXYZ> & input,
+  pcl::PointCloud<pcl::PointXYZ> & output)
 {
   pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>());
   xy_cloud->points.resize(input.points.size());
@@ -58,6 +78,136 @@ void RadiusSearch2DFilter::filter(
   }
 }
 
+void RadiusSearch2DFilter::filter_spatial_hash(
+  const pcl::PointCloud<pcl::PointXYZ> & input,
+  pcl::PointCloud<pcl::PointXYZ> & output)
+{
+  // Every point trivially has enough neighbors
+  if (min_neighbors_ <= 0) {
+    output.points.insert(output.points.end(), input.points.begin(), input.points.end());
+    return;
+  }
+
+  // Flatten the finite points and compute their bounding box, so that the lattice never clamps a
+  // point into a border bin. Non-finite points have no neighbors, as in the kd-tree
+  binned_points_.clear();
+  float32_t min_x = std::numeric_limits<float32_t>::max();
+  float32_t min_y = std::numeric_limits<float32_t>::max();
+  float32_t max_x = std::numeric_limits<float32_t>::lowest();
+  float32_t max_y = std::numeric_limits<float32_t>::lowest();
+  for (std::size_t i = 0U; i < input.points.size(); ++i) {
+    const auto & pt = input.points[i];
+    if (std::isfinite(pt.x) && std::isfinite(pt.y)) {
+      binned_points_.push_back(BinnedPoint{pt.x, pt.y, Index{}, i});
+      min_x = std::min(min_x, pt.x);
+      min_y = std::min(min_y, pt.y);
+      max_x = std::max(max_x, pt.x);
+      max_y = std::max(max_y, pt.y);
+    }
+  }
+  if (binned_points_.empty()) {
+    return;
+  }
+
+  // Bins have the search radius as side length, so neighbors are at most one bin apart
+  const float32_t radius = static_cast<float32_t>(search_radius_);
+  const Config2d cfg{min_x, max_x + radius, min_y, max_y + radius, radius, binned_points_.size()};
+  for (auto & pt : binned_points_) {
+    pt.bin = cfg.bin(pt.x, pt.y, 0.0F);
+  }
+  std::sort(
+    binned_points_.begin(), binned_points_.end(),
+    [](const BinnedPoint & lhs, const BinnedPoint & rhs) {
+      return (lhs.bin < rhs.bin) || ((lhs.bin == rhs.bin) && (lhs.input_idx < rhs.input_idx));
+    });
+  // Each point is its own neighbor, as in the kd-tree search
+  neighbor_counts_.assign(binned_points_.size(), 1);
+  const float32_t radius2 = radius * radius;
+  // Walk the cells in bin order and count all pairs of a cell with itself and its neighboring
+  // cells of larger bin index. Each cell pair is thus visited once, and both points of a pair are
+  // counted together. The points are sorted by bin, so the cells are contiguous ranges. For a
+  // fixed offset from the current bin, the neighboring bin only grows along the walk, so the
+  // neighboring cells are found by a merged walk with one cursor per offset
+  cell_cursors_.clear();
+  for (std::size_t begin = 0U; begin < binned_points_.size(); ) {
+    const BinnedPoint & ref_pt = binned_points_[begin];
+    std::size_t ref_begin = begin;
+    const auto ref_cell = find_cell(ref_pt.bin, ref_begin);
+    count_neighbor_pairs(ref_cell, ref_cell, radius2);
+    const auto ref_idx = cfg.index3(ref_pt.x, ref_pt.y, 0.0F);
+    const auto range = cfg.bin_range(ref_idx, radius);
+    auto idx = range.first;
+    do {
+      const Index query_bin = cfg.index(idx);
+      if ((query_bin > ref_pt.bin) && cfg.is_candidate_bin(ref_idx, idx, radius2)) {
+        const auto query_cell = find_cell(query_bin, cell_cursor(query_bin - ref_pt.bin));
+        if (query_cell.first != query_cell.second) {
+          count_neighbor_pairs(ref_cell, query_cell, radius2);
+        }
+      }
+    } while (cfg.next_bin(range, idx));
+    begin = ref_cell.second;
+  }
+
+  // Output the inliers in input order
+  is_inlier_.assign(input.points.size(), false);
+  for (std::size_t i = 0U; i < binned_points_.size(); ++i) {
+    if (neighbor_counts_[i] >= min_neighbors_) {
+      is_inlier_[binned_points_[i].input_idx] = true;
+    }
+  }
+  for (std::size_t i = 0U; i < input.points.size(); ++i) {
+    if (is_inlier_[i]) {
+      output.points.push_back(input.points[i]);
+    }
+  }
+}
+
+std::size_t & RadiusSearch2DFilter::cell_cursor(const Index offset)
+{
+  for (auto & cursor : cell_cursors_) {
+    if (cursor.first == offset) {
+      return cursor.second;
+    }
+  }
+  cell_cursors_.emplace_back(offset, 0U);
+  return cell_cursors_.back().second;
+}
+
+std::pair<std::size_t, std::size_t> RadiusSearch2DFilter::find_cell(
+  const Index bin,
+  std::size_t & cursor) const
+{
+  while ((cursor < binned_points_.size()) && (binned_points_[cursor].bin < bin)) {
+    ++cursor;
+  }
+  std::size_t end = cursor;
+  while ((end < binned_points_.size()) && (binned_points_[end].bin == bin)) {
+    ++end;
+  }
+  return std::make_pair(cursor, end);
+}
+
+void RadiusSearch2DFilter::count_neighbor_pairs(
+  const std::pair<std::size_t, std::size_t> & ref_cell,
+  const std::pair<std::size_t, std::size_t> & query_cell,
+  const float32_t radius2)
+{
+  const bool same_cell = (ref_cell.first == query_cell.first);
+  for (std::size_t i = ref_cell.first; i < ref_cell.second; ++i) {
+    const BinnedPoint & ref_pt = binned_points_[i];
+    for (std::size_t j = same_cell ? (i + 1U) : query_cell.first; j < query_cell.second; ++j) {
+      const float32_t dx = ref_pt.x - binned_points_[j].x;
+      const float32_t dy = ref_pt.y - binned_points_[j].y;
+      // Strictly within the radius, as in the kd-tree search
+      if (((dx * dx) + (dy * dy)) < radius2) {
+        ++neighbor_counts_[i];
+        ++neighbor_counts_[j];
+      }
+    }
+  }
+}
+
 }  // namespace radius_search_2d_filter
 }  // namespace outlier_filter
 }  // namespace filters
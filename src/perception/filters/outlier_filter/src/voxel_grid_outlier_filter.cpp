@@ -14,7 +14,12 @@
 
 #include "outlier_filter/voxel_grid_outlier_filter.hpp"
 
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace autoware
 {
@@ -29,17 +34,40 @@ namespace voxel_grid_outlier_filter
 
 VoxelGridOutlierFilter::VoxelGridOutlierFilter(
   float voxel_size_x, float voxel_size_y, float voxel_size_z,
-  uint32_t voxel_points_threshold)
+  uint32_t voxel_points_threshold,
+  uint32_t temporal_window,
+  float rolling_grid_range_xy,
+  float rolling_grid_range_z)
 : voxel_size_x_(voxel_size_x), voxel_size_y_(voxel_size_y), voxel_size_z_(voxel_size_z),
-  voxel_points_threshold_(voxel_points_threshold)
+  voxel_points_threshold_(voxel_points_threshold),
+  temporal_window_(temporal_window),
+  rolling_grid_range_xy_(rolling_grid_range_xy),
+  rolling_grid_range_z_(rolling_grid_range_z),
+  center_x_(0.0F), center_y_(0.0F), center_z_(0.0F),
+  cells_x_(0), cells_y_(0), cells_z_(0)
 {
   voxel_filter_ = std::make_shared<pcl::VoxelGrid<pcl::PointXYZ>>();
+  if (temporal_window_ > 0U) {
+    init_rolling_grid();
+  }
+}
+
+void VoxelGridOutlierFilter::set_rolling_grid_center(float x, float y, float z)
+{
+  center_x_ = x;
+  center_y_ = y;
+  center_z_ = z;
 }
 
 void VoxelGridOutlierFilter::filter(
   const pcl::PointCloud<pcl::PointXYZ> & input,
   pcl::PointCloud<pcl::PointXYZ> & output)
 {
+  if (temporal_window_ > 0U) {
+    filter_incremental(input, output);
+    return;
+  }
+
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_voxelized_input(new pcl::PointCloud<pcl::PointXYZ>);
   pcl_voxelized_input->points.reserve(input.points.size());
 
@@ -64,6 +92,109 @@ void VoxelGridOutlierFilter::filter(
     }
   }
 }
+
+void VoxelGridOutlierFilter::filter_incremental(
+  const pcl::PointCloud<pcl::PointXYZ> & input,
+  pcl::PointCloud<pcl::PointXYZ> & output)
+{
+  // Remove the points of the scan leaving the temporal window. Cells which were reused by another
+  // voxel since have already been reset
+  std::vector<CellRecord> records;
+  if (scan_history_.size() >= temporal_window_) {
+    records = std::move(scan_history_.front());
+    scan_history_.pop_front();
+    for (const auto & record : records) {
+      auto & cell = rolling_grid_[record.cell];
+      if ((cell.generation == record.generation) && (cell.count > 0U)) {
+        --cell.count;
+      }
+    }
+  }
+  records.clear();
+  records.reserve(input.points.size());
+
+  // Add the points of the current scan, in voxel coordinates as in pcl::VoxelGrid
+  const float inv_x = 1.0F / voxel_size_x_;
+  const float inv_y = 1.0F / voxel_size_y_;
+  const float inv_z = 1.0F / voxel_size_z_;
+  const int64_t min_x = static_cast<int64_t>(std::floor(center_x_ * inv_x)) - (cells_x_ / 2);
+  const int64_t min_y = static_cast<int64_t>(std::floor(center_y_ * inv_y)) - (cells_y_ / 2);
+  const int64_t min_z = static_cast<int64_t>(std::floor(center_z_ * inv_z)) - (cells_z_ / 2);
+  const auto in_grid = [](const float coord, const int64_t min, const int64_t cells) {
+      return std::isfinite(coord) && (coord >= static_cast<float>(min)) &&
+             (coord < static_cast<float>(min + cells));
+    };
+  const auto wrap = [](const int64_t idx, const int64_t cells) {
+      return ((idx % cells) + cells) % cells;
+    };
+  point_cells_.resize(input.points.size());
+  for (std::size_t i = 0U; i < input.points.size(); ++i) {
+    const auto & pt = input.points[i];
+    const float fx = std::floor(pt.x * inv_x);
+    const float fy = std::floor(pt.y * inv_y);
+    const float fz = std::floor(pt.z * inv_z);
+    if (!in_grid(fx, min_x, cells_x_) || !in_grid(fy, min_y, cells_y_) ||
+      !in_grid(fz, min_z, cells_z_))
+    {
+      point_cells_[i] = -1;
+      continue;
+    }
+    const VoxelKey key{
+      static_cast<int64_t>(fx), static_cast<int64_t>(fy), static_cast<int64_t>(fz)};
+    const int64_t cell_idx = wrap(key.x, cells_x_) +
+      (cells_x_ * (wrap(key.y, cells_y_) + (cells_y_ * wrap(key.z, cells_z_))));
+    auto & cell = rolling_grid_[static_cast<std::size_t>(cell_idx)];
+    // Two voxels within the grid never share a cell, so a cell holding another voxel belongs to a
+    // voxel which has left the grid
+    if ((cell.key.x != key.x) || (cell.key.y != key.y) || (cell.key.z != key.z)) {
+      cell.key = key;
+      cell.count = 0U;
+      ++cell.generation;
+    }
+    ++cell.count;
+    records.push_back(CellRecord{static_cast<std::size_t>(cell_idx), cell.generation});
+    point_cells_[i] = cell_idx;
+  }
+  scan_history_.push_back(std::move(records));
+
+  output.points.reserve(input.points.size());
+  for (std::size_t i = 0U; i < input.points.size(); ++i) {
+    if ((point_cells_[i] >= 0) &&
+      (rolling_grid_[static_cast<std::size_t>(point_cells_[i])].count >= voxel_points_threshold_))
+    {
+      output.points.push_back(input.points[i]);
+    }
+  }
+}
+
+void VoxelGridOutlierFilter::init_rolling_grid()
+{
+  cells_x_ = rolling_grid_cells(rolling_grid_range_xy_, voxel_size_x_);
+  cells_y_ = rolling_grid_cells(rolling_grid_range_xy_, voxel_size_y_);
+  cells_z_ = rolling_grid_cells(rolling_grid_range_z_, voxel_size_z_);
+  constexpr auto max_cells = static_cast<int64_t>(std::numeric_limits<int32_t>::max());
+  if ((cells_y_ > (max_cells / cells_x_)) || (cells_z_ > (max_cells / (cells_x_ * cells_y_)))) {
+    throw std::domain_error("VoxelGridOutlierFilter: too many voxels in rolling grid");
+  }
+  // Keys of voxels which can never be in the grid mark empty cells
+  constexpr auto empty = std::numeric_limits<int64_t>::min();
+  rolling_grid_.assign(
+    static_cast<std::size_t>(cells_x_ * cells_y_ * cells_z_),
+    RollingGridCell{VoxelKey{empty, empty, empty}, 0U, 0U});
+  scan_history_.clear();
+}
+
+int64_t VoxelGridOutlierFilter::rolling_grid_cells(float range, float voxel_size)
+{
+  if (!(range > 0.0F) || !(voxel_size > 0.0F)) {
+    throw std::domain_error("VoxelGridOutlierFilter: rolling grid needs a positive size");
+  }
+  const float cells = std::ceil((2.0F * range) / voxel_size);
+  if (!(cells < static_cast<float>(std::numeric_limits<int32_t>::max()))) {
+    throw std::domain_error("VoxelGridOutlierFilter: too many voxels in rolling grid");
+  }
+  return static_cast<int64_t>(cells);
+}
 }  // namespace voxel_grid_outlier_filter
 }  // namespace outlier_filter
 }  // namespace filters
@@ -0,0 +1,73 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <benchmark/benchmark.h>
+#include <outlier_filter/radius_search_2d_filter.hpp>
+
+#include <cstdint>
+#include <random>
+
+namespace
+{
+
+constexpr auto kCloudSize = 100000UL;
+
+using autoware::perception::filters::outlier_filter::radius_search_2d_filter::RadiusSearch2DFilter;
+using autoware::perception::filters::outlier_filter::radius_search_2d_filter::SearchBackend;
+
+// Uniformly distributed points in a 100m x 100m square, roughly a dense lidar scan
+pcl::PointCloud<pcl::PointXYZ> create_point_cloud(const std::size_t size)
+{
+  std::mt19937 generator{42U};
+  std::uniform_real_distribution<float> distribution{-50.0F, 50.0F};
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  cloud.points.resize(size);
+  for (auto & pt : cloud.points) {
+    pt.x = distribution(generator);
+    pt.y = distribution(generator);
+    pt.z = 0.0F;
+  }
+  return cloud;
+}
+
+void bench_filter(benchmark::State & state, const SearchBackend backend)
+{
+  const auto input = create_point_cloud(kCloudSize);
+  RadiusSearch2DFilter filter{0.5, 5, backend};
+  pcl::PointCloud<pcl::PointXYZ> output;
+  output.points.reserve(kCloudSize);
+  for (auto _ : state) {
+    output.points.clear();
+    filter.filter(input, output);
+    benchmark::DoNotOptimize(output);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kCloudSize));
+}
+
+}  // namespace
+
+static void BenchRadiusSearch2DFilterKdTree(benchmark::State & state)
+{
+  bench_filter(state, SearchBackend::KD_TREE);
+}
+
+static void BenchRadiusSearch2DFilterSpatialHash(benchmark::State & state)
+{
+  bench_filter(state, SearchBackend::SPATIAL_HASH);
+}
+
+BENCHMARK(BenchRadiusSearch2DFilterKdTree)->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchRadiusSearch2DFilterSpatialHash)->Unit(benchmark::kMillisecond);
@@ -154,3 +154,61 @@ TEST(RadiusSearch2DFilter, TestDecreaseSearchRadius) {
   // Min neighbours increased, not enough neighbours all points should fail checks
   check_pc({}, output);
 }
+
+/* TEST 6: The spatial hash backend gives the same results as the kd-tree backend
+ */
+TEST(RadiusSearch2DFilter, TestSpatialHashBackend) {
+  using autoware::perception::filters::outlier_filter::radius_search_2d_filter::SearchBackend;
+  auto time0 = std::chrono::system_clock::now();
+  auto t0 = to_msg_time(time0);
+
+  // Simple radial pointcloud with one outlier as in TEST 3
+  std::vector<pcl::PointXYZ> points = {
+    make_point(0.0f, 0.0f, 0.0f),
+    make_point(0.2f, 0.0f, 0.0f),
+    make_point(0.0f, 0.2f, 0.0f),
+    make_point(-0.2f, 0.0f, 0.0f),
+    make_point(0.0f, -0.2f, 0.0f),
+    make_point(0.8f, 0.2f, 0.0f)};
+  {
+    RadiusSearch2DFilter filter{0.5, 5, SearchBackend::SPATIAL_HASH};
+    EXPECT_EQ(filter.get_search_backend(), SearchBackend::SPATIAL_HASH);
+    pcl::PointCloud<pcl::PointXYZ> output;
+    filter.filter(make_pc(points, t0), output);
+    auto expected = points;
+    expected.pop_back();
+    check_pc(expected, output);
+  }
+
+  // Pseudo-random clouds of varying density, compared against the kd-tree
+  std::vector<pcl::PointXYZ> random_points;
+  uint32_t seed = 1234U;
+  const auto next_coord = [&seed]() {
+      seed = (seed * 1103515245U) + 12345U;
+      return static_cast<float>((seed >> 8U) % 20000U) * 1.0e-3F - 10.0F;
+    };
+  for (auto i = 0U; i < 2000U; ++i) {
+    const float x = next_coord();
+    random_points.push_back(make_point(x, next_coord(), x));
+  }
+  const auto random_input = make_pc(random_points, t0);
+  for (const double radius : {0.1, 0.3, 1.0}) {
+    for (const int min_neighbors : {1, 2, 5}) {
+      RadiusSearch2DFilter kd_tree_filter{radius, min_neighbors, SearchBackend::KD_TREE};
+      RadiusSearch2DFilter spatial_hash_filter{radius, min_neighbors, SearchBackend::SPATIAL_HASH};
+      pcl::PointCloud<pcl::PointXYZ> kd_tree_output;
+      pcl::PointCloud<pcl::PointXYZ> spatial_hash_output;
+      kd_tree_filter.filter(random_input, kd_tree_output);
+      spatial_hash_filter.filter(random_input, spatial_hash_output);
+      check_pc(
+        std::vector<pcl::PointXYZ>(kd_tree_output.begin(), kd_tree_output.end()),
+        spatial_hash_output);
+    }
+  }
+
+  // Empty cloud
+  RadiusSearch2DFilter filter{0.5, 5, SearchBackend::SPATIAL_HASH};
+  pcl::PointCloud<pcl::PointXYZ> output;
+  filter.filter(make_pc({}, t0), output);
+  check_pc({}, output);
+}
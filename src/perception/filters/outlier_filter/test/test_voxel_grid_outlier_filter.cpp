@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <memory>
+#include <random>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -122,3 +123,172 @@ TEST(VoxelGridOutlierFilterTest, TestLine) {
   points.pop_back();
   check_pc(points, output);
 }
+
+/* TEST 4: Incremental mode with a temporal window of one scan gives the same result as TEST 2
+ */
+TEST(VoxelGridOutlierFilterTest, TestIncrementalSingleScan) {
+  VoxelGridOutlierFilter filter{1.0f, 1.0f, 1.0f, static_cast<uint32_t>(2), 1U};
+  EXPECT_EQ(filter.get_temporal_window(), 1U);
+  std::vector<pcl::PointXYZ> points = {
+    make_point(-1.0f, 1.0f, 0.0f),
+    make_point(-0.8f, 1.0f, 0.0f),
+    make_point(-1.0f, -1.0f, 0.0f),
+    make_point(1.0f, 1.0f, 0.0f),
+    make_point(1.0f, -1.0f, 0.0f)};
+  auto time0 = std::chrono::system_clock::now();
+  auto t0 = to_msg_time(time0);
+  auto input = make_pc(points, t0);
+
+  // Consecutive scans are not counted together
+  for (auto i = 0U; i < 3U; ++i) {
+    pcl::PointCloud<pcl::PointXYZ> output;
+    filter.filter(input, output);
+    check_pc({make_point(-1.0f, 1.0f, 0.0f), make_point(-0.8f, 1.0f, 0.0f)}, output);
+  }
+}
+
+/* TEST 5: Incremental mode counts the points of the last scans in the temporal window
+ *  scan 0: x at A         -> removed, 1 point in A
+ *  scan 1: x at A         -> kept, 2 points in A
+ *  scan 2: x at B         -> removed, scan 0 leaves the window
+ *  scan 3: x at A         -> removed, scan 1 leaves the window
+ */
+TEST(VoxelGridOutlierFilterTest, TestIncrementalTemporalWindow) {
+  VoxelGridOutlierFilter filter{1.0f, 1.0f, 1.0f, static_cast<uint32_t>(2), 2U};
+  auto time0 = std::chrono::system_clock::now();
+  auto t0 = to_msg_time(time0);
+  const std::vector<pcl::PointXYZ> point_a = {make_point(0.5f, 0.5f, 0.5f)};
+  const std::vector<pcl::PointXYZ> point_b = {make_point(5.5f, 0.5f, 0.5f)};
+  const auto scan_a = make_pc(point_a, t0);
+  const auto scan_b = make_pc(point_b, t0);
+
+  pcl::PointCloud<pcl::PointXYZ> output;
+  filter.filter(scan_a, output);
+  check_pc({}, output);
+  output.points.clear();
+  filter.filter(scan_a, output);
+  check_pc(point_a, output);
+  output.points.clear();
+  filter.filter(scan_b, output);
+  check_pc({}, output);
+  output.points.clear();
+  filter.filter(scan_a, output);
+  check_pc({}, output);
+
+  // Changing the voxel size discards all past scans
+  output.points.clear();
+  filter.filter(scan_a, output);
+  check_pc(point_a, output);
+  filter.update_parameters(0.5f, 0.5f, 0.5f, static_cast<uint32_t>(2));
+  output.points.clear();
+  filter.filter(scan_a, output);
+  check_pc({}, output);
+}
+
+/* TEST 6: Incremental mode removes points outside of the rolling grid, which can be moved
+ */
+TEST(VoxelGridOutlierFilterTest, TestIncrementalRollingGrid) {
+  VoxelGridOutlierFilter filter{1.0f, 1.0f, 1.0f, static_cast<uint32_t>(2), 3U, 10.0f, 2.0f};
+  auto time0 = std::chrono::system_clock::now();
+  auto t0 = to_msg_time(time0);
+
+  // The grid spans [-10, 10) in x and y and [-2, 2) in z
+  const std::vector<pcl::PointXYZ> points = {
+    make_point(9.5f, 0.0f, 0.0f),
+    make_point(9.6f, 0.0f, 0.0f),
+    make_point(10.5f, 0.0f, 0.0f),
+    make_point(10.6f, 0.0f, 0.0f),
+    make_point(0.0f, -9.5f, 1.5f),
+    make_point(0.0f, -9.6f, 1.5f),
+    make_point(0.0f, 0.0f, 2.5f),
+    make_point(0.0f, 0.0f, 2.6f)};
+  pcl::PointCloud<pcl::PointXYZ> output;
+  filter.filter(make_pc(points, t0), output);
+  check_pc(
+    {make_point(9.5f, 0.0f, 0.0f), make_point(9.6f, 0.0f, 0.0f),
+      make_point(0.0f, -9.5f, 1.5f), make_point(0.0f, -9.6f, 1.5f)}, output);
+
+  // The grid now spans [10, 30) in x. The voxel at x = 29 uses the cell of the voxel at x = 9,
+  // whose count must not be added to it
+  filter.set_rolling_grid_center(20.0f, 0.0f, 0.0f);
+  output.points.clear();
+  filter.filter(make_pc({make_point(9.5f, 0.0f, 0.0f), make_point(29.5f, 0.0f, 0.0f)}, t0), output);
+  check_pc({}, output);
+}
+
+/* TEST 7: Incremental mode requires a valid rolling grid
+ */
+TEST(VoxelGridOutlierFilterTest, TestIncrementalBadRollingGrid) {
+  EXPECT_THROW(
+    VoxelGridOutlierFilter(1.0f, 1.0f, 1.0f, static_cast<uint32_t>(1), 3U, 0.0f, 2.0f),
+    std::domain_error);
+  EXPECT_THROW(
+    VoxelGridOutlierFilter(1.0e-4f, 1.0e-4f, 1.0e-4f, static_cast<uint32_t>(1), 3U),
+    std::domain_error);
+  // The rolling grid is not used without a temporal window
+  EXPECT_NO_THROW(
+    VoxelGridOutlierFilter(1.0e-4f, 1.0e-4f, 1.0e-4f, static_cast<uint32_t>(1)));
+}
+
+/* TEST 8: Moving the rolling grid away and back gives the same result as filtering the scans of
+ * the temporal window together, once the window holds no scan from before the grid left. The
+ * cells of the first scan are reused twice, so its points must not be removed from the new voxels
+ */
+TEST(VoxelGridOutlierFilterTest, TestIncrementalMovingGrid) {
+  constexpr uint32_t temporal_window = 3U;
+  constexpr uint32_t threshold = 3U;
+  VoxelGridOutlierFilter incremental{
+    1.0f, 1.0f, 1.0f, threshold, temporal_window, 10.0f, 2.0f};
+  VoxelGridOutlierFilter stateless{1.0f, 1.0f, 1.0f, threshold};
+  std::mt19937 gen{42U};
+  std::uniform_real_distribution<float> dist_xy{-9.9f, 9.9f};
+  std::uniform_real_distribution<float> dist_z{-1.9f, 1.9f};
+  // Scans within the grid when it is centered on center_x
+  const auto make_scan = [&gen, &dist_xy, &dist_z](const float center_x) {
+      pcl::PointCloud<pcl::PointXYZ> scan;
+      for (auto i = 0U; i < 2000U; ++i) {
+        scan.points.push_back(make_point(center_x + dist_xy(gen), dist_xy(gen), dist_z(gen)));
+      }
+      return scan;
+    };
+
+  // The grid spans [-10, 10) in x and y, then [10, 30) in x, then [-10, 10) again
+  const std::vector<float> centers = {0.0f, 20.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> scans;
+  for (std::size_t idx = 0U; idx < centers.size(); ++idx) {
+    incremental.set_rolling_grid_center(centers[idx], 0.0f, 0.0f);
+    scans.push_back(make_scan(centers[idx]));
+    pcl::PointCloud<pcl::PointXYZ> output;
+    incremental.filter(scans.back(), output);
+    if (idx < temporal_window) {
+      continue;
+    }
+
+    // The scans taken away from the current voxels do not share any of them
+    pcl::PointCloud<pcl::PointXYZ> window;
+    for (std::size_t scan_idx = idx + 1U - temporal_window; scan_idx <= idx; ++scan_idx) {
+      window.points.insert(
+        window.points.end(), scans[scan_idx].points.begin(), scans[scan_idx].points.end());
+    }
+    pcl::PointCloud<pcl::PointXYZ> window_output;
+    stateless.filter(window, window_output);
+    // The output keeps the input order, so the kept points of the current scan come last
+    std::vector<pcl::PointXYZ> expected;
+    const std::size_t first_current = window.points.size() - scans.back().points.size();
+    std::size_t kept_idx = 0U;
+    for (std::size_t pt_idx = 0U;
+      (pt_idx < window.points.size()) && (kept_idx < window_output.points.size()); ++pt_idx)
+    {
+      const auto & pt = window.points[pt_idx];
+      const auto & kept = window_output.points[kept_idx];
+      if ((pt.x == kept.x) && (pt.y == kept.y) && (pt.z == kept.z)) {
+        ++kept_idx;
+        if (pt_idx >= first_current) {
+          expected.push_back(pt);
+        }
+      }
+    }
+    EXPECT_FALSE(expected.empty());
+    check_pc(expected, output);
+  }
+}
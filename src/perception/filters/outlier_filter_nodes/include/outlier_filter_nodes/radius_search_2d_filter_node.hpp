@@ -28,6 +28,7 @@
 #include "filter_node_base/filter_node_base.hpp"
 #include "outlier_filter/radius_search_2d_filter.hpp"
 
+#include "pcl/PCLPointCloud2.h"
 #include "rclcpp/rclcpp.hpp"
 
 
@@ -90,6 +91,9 @@ private:
   /** \brief Variable containing the value of the minimum neighbors for points (passed into
      radius_search_2d_filter_) */
   std::int64_t min_neighbors_;
+
+  /** \brief The converted output, whose payload is swapped with the one of the output message */
+  pcl::PCLPointCloud2 pcl_output_msg_;
 };
 }  // namespace outlier_filter_nodes
 }  // namespace filters
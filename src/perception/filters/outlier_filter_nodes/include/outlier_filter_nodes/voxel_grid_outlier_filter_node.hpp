@@ -27,6 +27,7 @@
 
 #include "filter_node_base/filter_node_base.hpp"
 #include "outlier_filter/voxel_grid_outlier_filter.hpp"
+#include "pcl/PCLPointCloud2.h"
 #include "rclcpp/rclcpp.hpp"
 
 
@@ -96,6 +97,9 @@ private:
 
   /** \brief Variable containing the points threshold (passed into voxel_grid_outlier_filter_) */
   std::int64_t voxel_points_threshold_;
+
+  /** \brief The converted output, whose payload is swapped with the one of the output message */
+  pcl::PCLPointCloud2 pcl_output_msg_;
 };
 }  // namespace outlier_filter_nodes
 }  // namespace filters
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "outlier_filter_nodes/radius_search_2d_filter_node.hpp"
@@ -34,6 +36,24 @@ using float64_t = autoware::common::types::float64_t;
 using RadiusSearch2DFilter =
   autoware::perception::filters::outlier_filter::radius_search_2d_filter::
   RadiusSearch2DFilter;
+using SearchBackend =
+  autoware::perception::filters::outlier_filter::radius_search_2d_filter::SearchBackend;
+
+namespace
+{
+SearchBackend parse_search_backend(const std::string & search_backend)
+{
+  if (search_backend == "kd_tree") {
+    return SearchBackend::KD_TREE;
+  } else if (search_backend == "spatial_hash") {
+    return SearchBackend::SPATIAL_HASH;
+  }
+
+  throw std::domain_error(
+          "Search backend '" + search_backend + "' is not supported. "
+          "Please try 'kd_tree' or 'spatial_hash'.");
+}
+}  // namespace
 
 RadiusSearch2DFilterNode::RadiusSearch2DFilterNode(const rclcpp::NodeOptions & options)
 :  FilterNodeBase("radius_search_2d_filter_node", options),
@@ -42,7 +62,8 @@ RadiusSearch2DFilterNode::RadiusSearch2DFilterNode(const rclcpp::NodeOptions & o
 {
   radius_search_2d_filter_ = std::make_shared<RadiusSearch2DFilter>(
     search_radius_,
-    min_neighbors_
+    min_neighbors_,
+    parse_search_backend(declare_parameter("search_backend", std::string{"kd_tree"}))
   );
 
   set_param_callback();
@@ -59,7 +80,10 @@ void RadiusSearch2DFilterNode::filter(
   // Perform filtering
   radius_search_2d_filter_->filter(pcl_input, pcl_output);
 
-  pcl::toROSMsg(pcl_output, output);
+  // Converting through a member keeps the payload which comes with the output, e.g. from the
+  // buffer pool of the FilterNodeBase, for the next conversion instead of freeing it
+  pcl::toPCLPointCloud2(pcl_output, pcl_output_msg_);
+  pcl_conversions::moveFromPCL(pcl_output_msg_, output);
 }
 
 rcl_interfaces::msg::SetParametersResult RadiusSearch2DFilterNode::get_node_parameters(
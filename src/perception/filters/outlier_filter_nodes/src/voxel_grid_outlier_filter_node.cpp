@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 #include "outlier_filter_nodes/voxel_grid_outlier_filter_node.hpp"
@@ -43,11 +44,19 @@ VoxelGridOutlierFilterNode::VoxelGridOutlierFilterNode(const rclcpp::NodeOptions
   voxel_size_z_(declare_parameter("voxel_size_z").get<float64_t>()),
   voxel_points_threshold_(declare_parameter("voxel_points_threshold").get<uint32_t>())
 {
+  // The incremental mode can only be configured at startup
+  const auto temporal_window = declare_parameter("temporal_window", 0);
+  if (temporal_window < 0) {
+    throw std::domain_error("temporal_window must not be negative");
+  }
   voxel_grid_outlier_filter_ = std::make_shared<VoxelGridOutlierFilter>(
     voxel_size_x_,
     voxel_size_y_,
     voxel_size_z_,
-    voxel_points_threshold_);
+    voxel_points_threshold_,
+    static_cast<uint32_t>(temporal_window),
+    static_cast<float32_t>(declare_parameter("rolling_grid_range_xy", 25.0)),
+    static_cast<float32_t>(declare_parameter("rolling_grid_range_z", 3.0)));
 
   set_param_callback();
 }
@@ -62,7 +71,10 @@ void VoxelGridOutlierFilterNode::filter(
   // Perform filtering
   voxel_grid_outlier_filter_->filter(pcl_input, pcl_output);
 
-  pcl::toROSMsg(pcl_output, output);
+  // Converting through a member keeps the payload which comes with the output, e.g. from the
+  // buffer pool of the FilterNodeBase, for the next conversion instead of freeing it
+  pcl::toPCLPointCloud2(pcl_output, pcl_output_msg_);
+  pcl_conversions::moveFromPCL(pcl_output_msg_, output);
 }
 
 rcl_interfaces::msg::SetParametersResult VoxelGridOutlierFilterNode::get_node_parameters(
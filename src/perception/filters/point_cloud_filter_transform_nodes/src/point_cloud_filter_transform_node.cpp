@@ -18,6 +18,8 @@
 #include <point_cloud_filter_transform_nodes/point_cloud_filter_transform_node.hpp>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <map>
@@ -33,6 +35,9 @@ namespace filters
 namespace point_cloud_filter_transform_nodes
 {
 using autoware::common::lidar_utils::has_intensity_and_throw_if_no_xyz;
+using autoware::common::lidar_utils::load_point_batch;
+using autoware::common::lidar_utils::PointBatch;
+using autoware::common::lidar_utils::PointBatchMask;
 using autoware::common::lidar_utils::sanitize_point_cloud;
 using autoware::common::types::float64_t;
 using autoware::common::types::PointXYZI;
@@ -155,11 +160,36 @@ const PointCloud2 & PointCloud2FilterTransformNode::filter_and_transform(const P
             m_input_frame_id + ", got: " + msg.header.frame_id);
   }
 
-  sensor_msgs::PointCloud2ConstIterator<float32_t> x_it(msg, "x");
-  sensor_msgs::PointCloud2ConstIterator<float32_t> y_it(msg, "y");
-  sensor_msgs::PointCloud2ConstIterator<float32_t> z_it(msg, "z");
-
-  auto && intensity_it = autoware::common::lidar_utils::IntensityIteratorWrapper(msg);
+  // Validates that x, y, z are the first fields, so that points can be loaded in batches
+  (void)has_intensity_and_throw_if_no_xyz(msg);
+  const auto intensity_field_it = std::find_if(
+    msg.fields.cbegin(), msg.fields.cend(),
+    [](const sensor_msgs::msg::PointField & field) {return field.name == "intensity";});
+  if (intensity_field_it == msg.fields.cend()) {
+    throw std::runtime_error("PointCloud doesn't have an intensity field");
+  }
+  const auto intensity_datatype = intensity_field_it->datatype;
+  const std::size_t intensity_offset = intensity_field_it->offset;
+  const std::size_t intensity_size =
+    (intensity_datatype == sensor_msgs::msg::PointField::UINT8) ? sizeof(uint8_t) :
+    sizeof(float32_t);
+  if (((intensity_datatype != sensor_msgs::msg::PointField::UINT8) &&
+    (intensity_datatype != sensor_msgs::msg::PointField::FLOAT32)) ||
+    ((intensity_offset + intensity_size) > msg.point_step))
+  {
+    throw std::runtime_error(
+            "Intensity type not supported: " + std::to_string(intensity_datatype));
+  }
+  const auto get_intensity = [&msg, intensity_datatype, intensity_offset](std::size_t idx) {
+      const uint8_t * const data = &msg.data[(idx * msg.point_step) + intensity_offset];
+      if (intensity_datatype == sensor_msgs::msg::PointField::UINT8) {
+        return static_cast<float32_t>(*data);
+      }
+      float32_t intensity;
+      //lint -e{586} NOLINT memcpy is needed for the unaligned serialized data
+      (void)std::memcpy(&intensity, data, sizeof(intensity));
+      return intensity;
+    };
 
   using autoware::common::types::PointXYZI;
   point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{m_filtered_transformed_msg};
@@ -168,26 +198,26 @@ const PointCloud2 & PointCloud2FilterTransformNode::filter_and_transform(const P
 
   m_filtered_transformed_msg.header.stamp = msg.header.stamp;
 
-  for (size_t it = 0; it < (msg.data.size() / 16); it++) {
-    PointXYZI pt;
-    pt.x = *x_it;
-    pt.y = *y_it;
-    pt.z = *z_it;
-    intensity_it.get_current_value(pt.intensity);
-
-    if (point_not_filtered(pt)) {
-      auto transformed_point = transform_point(pt);
-      transformed_point.intensity = pt.intensity;
-      modifier.push_back(transformed_point);
+  // Filter and transform in a single pass over the input: each batch is loaded once, then filtered
+  // and transformed while it is in cache, and only the points which pass are written out
+  PointBatch batch;
+  for (std::size_t first_point = 0U; load_point_batch(msg, first_point, batch) > 0U;
+    first_point += batch.size)
+  {
+    const PointBatchMask mask = m_angle_filter.filter(batch) & m_distance_filter.filter(batch);
+    if (0U == mask) {
+      continue;
     }
-
-    ++x_it;
-    ++y_it;
-    ++z_it;
-    intensity_it.next();
-
-    if (intensity_it.eof()) {
-      break;
+    m_static_transformer->transform(batch);
+    for (std::size_t idx = 0U; idx < batch.size; ++idx) {
+      if (0U != (mask & (PointBatchMask{1U} << idx))) {
+        PointXYZI pt;
+        pt.x = batch.x[idx];
+        pt.y = batch.y[idx];
+        pt.z = batch.z[idx];
+        pt.intensity = get_intensity(first_point + idx);
+        modifier.push_back(pt);
+      }
     }
   }
   return m_filtered_transformed_msg;
@@ -197,7 +227,7 @@ void
 PointCloud2FilterTransformNode::process_filtered_transformed_message(
   const PointCloud2::SharedPtr msg)
 {
-  const auto filtered_transformed_msg = filter_and_transform(*msg);
+  const auto & filtered_transformed_msg = filter_and_transform(*msg);
   m_pub_ptr->publish(filtered_transformed_msg);
 }
 
@@ -20,8 +20,16 @@
 #include <point_cloud_fusion/visibility_control.hpp>
 
 #include <common/types.hpp>
+#include <geometry_msgs/msg/transform.hpp>
+#include <helper_functions/worker_pool.hpp>
 #include <lidar_utils/point_cloud_utils.hpp>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include <array>
+#include <chrono>
 #include <vector>
 
 namespace autoware
@@ -33,6 +41,7 @@ namespace filters
 namespace point_cloud_fusion
 {
 using autoware::common::types::PointXYZI;
+using autoware::common::types::bool8_t;
 
 class POINT_CLOUD_FUSION_PUBLIC PointCloudFusion
 {
@@ -48,9 +57,12 @@ public:
   /// \brief     constructor
   /// \param[in] cloud_capacity
   /// \param[in] input_topics_size
+  /// \param[in] num_threads Number of threads used to transform and copy the inputs, including the
+  ///                        calling thread. They are started here, and at most one per input
   explicit PointCloudFusion(
     uint32_t cloud_capacity,
-    size_t input_topics_size);
+    size_t input_topics_size,
+    size_t num_threads = 1U);
 
   /// \brief This function goes through all of the messages and adds them to the concatenated
   /// point cloud. If a pointcloud cannot be transformed to the output frame, it's ignored. If
@@ -63,14 +75,68 @@ public:
     const std::array<PointCloudMsgT::ConstSharedPtr, 8> & msgs,
     PointCloudMsgT & cloud_concatenated);
 
+  /// \brief Fuse an arbitrary number of inputs. The output is resized once to the total size of
+  /// the inputs, and each input is transformed with its input transform straight into its slice
+  /// of the output.
+  /// \param[in]  msgs msgs to be fused, in input order. Null entries are ignored.
+  /// \param[out] cloud_concatenated fused msgs.
+  /// \return     Size of the concatenated pointcloud.
+  /// \throw Error::TOO_LARGE If the inputs do not fit into the cloud capacity. The output is left
+  ///                         unchanged in this case
+  /// \throw std::length_error If there are more msgs than configured inputs
+  uint32_t fuse_pc_msgs(
+    const std::vector<PointCloudMsgT::ConstSharedPtr> & msgs,
+    PointCloudMsgT & cloud_concatenated);
+
+  /// \brief Set the transform applied to the points of an input during fusion. Inputs are not
+  /// transformed by default.
+  /// \param[in] input_idx Index of the input
+  /// \param[in] tf Transform from the input frame to the output frame
+  /// \throw std::out_of_range If the input index is out of range
+  /// \throw std::domain_error If the rotation quaternion is not normalized
+  void set_input_transform(size_t input_idx, const geometry_msgs::msg::Transform & tf);
+
+  /// \brief Get the time it took to transform and copy each input during the last fusion
+  /// \return Durations, in input order
+  const std::vector<std::chrono::nanoseconds> & get_input_transform_times() const;
+
 private:
+  /// \brief State of a single input
+  struct InputTransform
+  {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    /// \brief Maps a point (x, y, z, intensity) to the transformed point, up to the offset
+    Eigen::Matrix4f linear;
+    /// \brief Translation, with a zero intensity component
+    Eigen::Vector4f offset;
+    bool8_t is_identity;
+  };  // struct InputTransform
+  using InputTransforms =
+    std::vector<InputTransform, Eigen::aligned_allocator<InputTransform>>;
+
+  uint32_t fuse_inputs(
+    const PointCloudMsgT::ConstSharedPtr * msgs,
+    size_t num_msgs,
+    PointCloudMsgT & cloud_concatenated);
+
+  /// \brief Transform and copy an input into its output slice
+  void transform_input(
+    const PointCloudMsgT & msg,
+    size_t input_idx,
+    point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> & modifier);
+
   void concatenate_pointcloud(
     const PointCloudMsgT & pc_in,
-    uint32_t & concat_idx,
+    const InputTransform & transform,
+    uint32_t concat_idx,
     point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> & modifier) const;
 
   uint32_t m_cloud_capacity;
   size_t m_input_topics_size;
+  InputTransforms m_input_transforms;
+  std::vector<uint32_t> m_input_offsets;
+  std::vector<std::chrono::nanoseconds> m_input_transform_times;
+  common::helper_functions::WorkerPool m_workers;
 };
 
 }  // namespace point_cloud_fusion
@@ -4,7 +4,7 @@
 // you may not use this file except in compliance with the License.
 // You may obtain a copy of the License at
 //
-//     http://www.apache.org/licenses/LICENSE-2.0
+//     http://www.apache.org/licenses/LICENSE-2.0
 //
 // Unless required by applicable law or agreed to in writing, software
 // distributed under the License is distributed on an "AS IS" BASIS,
@@ -15,9 +15,17 @@
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
 #include <common/types.hpp>
+#include <helper_functions/float_comparisons.hpp>
 #include <point_cloud_fusion/point_cloud_fusion.hpp>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
 
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
 namespace autoware
 {
 namespace perception
@@ -26,55 +34,151 @@ namespace filters
 {
 namespace point_cloud_fusion
 {
+using autoware::common::types::float32_t;
 
 PointCloudFusion::PointCloudFusion(
   uint32_t cloud_capacity,
-  size_t input_topics_size)
+  size_t input_topics_size,
+  size_t num_threads)
 : m_cloud_capacity(cloud_capacity),
-  m_input_topics_size(input_topics_size)
+  m_input_topics_size(input_topics_size),
+  m_input_transforms(input_topics_size),
+  m_input_offsets(input_topics_size, 0U),
+  m_input_transform_times(input_topics_size, std::chrono::nanoseconds::zero()),
+  m_workers(std::max(std::min(num_threads, input_topics_size), size_t{1U}))
 {
+  for (auto & transform : m_input_transforms) {
+    transform.linear.setIdentity();
+    transform.offset.setZero();
+    transform.is_identity = true;
+  }
 }
 
 uint32_t PointCloudFusion::fuse_pc_msgs(
   const std::array<PointCloudMsgT::ConstSharedPtr, 8> & msgs,
   PointCloudMsgT & cloud_concatenated)
 {
-  uint32_t pc_concat_idx = 0;
+  return fuse_inputs(msgs.data(), std::min(m_input_topics_size, msgs.size()), cloud_concatenated);
+}
+
+uint32_t PointCloudFusion::fuse_pc_msgs(
+  const std::vector<PointCloudMsgT::ConstSharedPtr> & msgs,
+  PointCloudMsgT & cloud_concatenated)
+{
+  if (msgs.size() > m_input_topics_size) {
+    throw std::length_error("PointCloudFusion: more msgs than configured inputs");
+  }
+  return fuse_inputs(msgs.data(), msgs.size(), cloud_concatenated);
+}
+
+void PointCloudFusion::set_input_transform(
+  size_t input_idx,
+  const geometry_msgs::msg::Transform & tf)
+{
+  InputTransform & transform = m_input_transforms.at(input_idx);
+  const Eigen::Quaternionf rotation{
+    static_cast<float32_t>(tf.rotation.w),
+    static_cast<float32_t>(tf.rotation.x),
+    static_cast<float32_t>(tf.rotation.y),
+    static_cast<float32_t>(tf.rotation.z)};
+  constexpr auto EPS = std::numeric_limits<float32_t>::epsilon();
+  if (!autoware::common::helper_functions::comparisons::rel_eq(rotation.norm(), 1.0F, EPS)) {
+    throw std::domain_error("PointCloudFusion: quaternion is not normalized");
+  }
+  // Intensity is passed through unchanged
+  transform.linear.setIdentity();
+  transform.linear.topLeftCorner<3, 3>() = rotation.toRotationMatrix();
+  transform.offset = Eigen::Vector4f{
+    static_cast<float32_t>(tf.translation.x),
+    static_cast<float32_t>(tf.translation.y),
+    static_cast<float32_t>(tf.translation.z),
+    0.0F};
+  transform.is_identity = transform.linear.isIdentity() && transform.offset.isZero();
+}
+
+const std::vector<std::chrono::nanoseconds> & PointCloudFusion::get_input_transform_times() const
+{
+  return m_input_transform_times;
+}
 
+uint32_t PointCloudFusion::fuse_inputs(
+  const PointCloudMsgT::ConstSharedPtr * msgs,
+  size_t num_msgs,
+  PointCloudMsgT & cloud_concatenated)
+{
   using autoware::common::types::PointXYZI;
+  // Compute the slice of each input up front. Creating the views also validates the inputs, so
+  // nothing can throw once the inputs are being copied
+  uint32_t total_size = 0U;
+  for (size_t i = 0; i < num_msgs; ++i) {
+    m_input_offsets[i] = total_size;
+    m_input_transform_times[i] = std::chrono::nanoseconds::zero();
+    if (msgs[i]) {
+      const point_cloud_msg_wrapper::PointCloud2View<PointXYZI> view{*msgs[i]};
+      if ((view.size() + total_size) > m_cloud_capacity) {
+        throw Error::TOO_LARGE;
+      }
+      total_size += static_cast<uint32_t>(view.size());
+    }
+  }
+
   point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{cloud_concatenated};
+  modifier.resize(total_size);
 
-  for (size_t i = 0; i < m_input_topics_size; ++i) {
-    concatenate_pointcloud(*msgs[i], pc_concat_idx, modifier);
-  }
+  // Inputs are written to disjoint slices of the output, so they can be processed concurrently
+  // by the workers, which only get the input indices
+  const auto transform_msg = [this, msgs, &modifier](const size_t input_idx) {
+      if (msgs[input_idx]) {
+        transform_input(*msgs[input_idx], input_idx, modifier);
+      }
+    };
+  m_workers.run(
+    num_msgs, [&transform_msg](const size_t input_idx, const size_t) {
+      transform_msg(input_idx);
+    });
 
-  return pc_concat_idx;
+  return total_size;
+}
+
+void PointCloudFusion::transform_input(
+  const PointCloudMsgT & msg,
+  size_t input_idx,
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> & modifier)
+{
+  const auto start = std::chrono::steady_clock::now();
+  concatenate_pointcloud(
+    msg, m_input_transforms[input_idx], m_input_offsets[input_idx], modifier);
+  m_input_transform_times[input_idx] = std::chrono::steady_clock::now() - start;
 }
 
 void PointCloudFusion::concatenate_pointcloud(
   const sensor_msgs::msg::PointCloud2 & pc_in,
-  uint32_t & concat_idx,
+  const InputTransform & transform,
+  uint32_t concat_idx,
   point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> & modifier) const
 {
-  if ((pc_in.width + concat_idx) > m_cloud_capacity) {
-    throw Error::TOO_LARGE;
-  }
-
   using autoware::common::types::PointXYZI;
   point_cloud_msg_wrapper::PointCloud2View<PointXYZI> view{pc_in};
 
-  auto view_it = view.cbegin();
-  while (view_it != view.cend()) {
-    common::types::PointXYZI pt;
-    pt.x = (*view_it).x;
-    pt.y = (*view_it).y;
-    pt.z = (*view_it).z;
-    pt.intensity = (*view_it).intensity;
-
-    modifier.push_back(pt);
+  if (transform.is_identity) {
+    for (auto view_it = view.cbegin(); view_it != view.cend(); ++view_it) {
+      modifier[concat_idx] = *view_it;
+      ++concat_idx;
+    }
+    return;
+  }
+  // (x, y, z, intensity) -> (R * (x, y, z) + t, intensity) as a single 4x4 kernel which Eigen
+  // vectorizes
+  for (auto view_it = view.cbegin(); view_it != view.cend(); ++view_it) {
+    const auto & pt_in = *view_it;
+    const Eigen::Vector4f in{pt_in.x, pt_in.y, pt_in.z, pt_in.intensity};
+    const Eigen::Vector4f out = (transform.linear * in) + transform.offset;
+    PointXYZI & pt_out = modifier[concat_idx];
+    pt_out.x = out[0];
+    pt_out.y = out[1];
+    pt_out.z = out[2];
+    pt_out.intensity = out[3];
     ++concat_idx;
-
-    ++view_it;
   }
 }
 
@@ -21,12 +21,15 @@
 #include <message_filters/sync_policies/approximate_time.h>
 #include <message_filters/synchronizer.h>
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <std_msgs/msg/u_int8_multi_array.hpp>
 #include <lidar_utils/point_cloud_utils.hpp>
-#include <tf2_ros/transform_listener.h>
+#include <autoware_auto_tf2/shared_transform_buffer.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <point_cloud_fusion/point_cloud_fusion.hpp>
 #include <point_cloud_fusion_nodes/visibility_control.hpp>
 #include <common/types.hpp>
+#include <time_utils/trace.hpp>
+#include <chrono>
 #include <string>
 #include <memory>
 #include <vector>
@@ -55,10 +58,14 @@ private:
   using PointT = common::types::PointXYZIF;
   using PointCloudMsgT = sensor_msgs::msg::PointCloud2;
   using PointCloudT = sensor_msgs::msg::PointCloud2;
+  using PresenceMsgT = std_msgs::msg::UInt8MultiArray;
   using SyncPolicyT = message_filters::sync_policies::ApproximateTime<PointCloudMsgT,
       PointCloudMsgT, PointCloudMsgT, PointCloudMsgT, PointCloudMsgT, PointCloudMsgT,
       PointCloudMsgT, PointCloudMsgT>;
 
+  /// \brief Maximum number of inputs which can be synchronized by message_filters
+  static constexpr std::size_t MAX_SYNCHRONIZED_INPUTS = 8U;
+
   void init();
 
   std::chrono::nanoseconds convert_msg_time(builtin_interfaces::msg::Time stamp);
@@ -69,15 +76,67 @@ private:
     const PointCloudMsgT::ConstSharedPtr & msg5, const PointCloudMsgT::ConstSharedPtr & msg6,
     const PointCloudMsgT::ConstSharedPtr & msg7, const PointCloudMsgT::ConstSharedPtr & msg8);
 
+  /// \brief Callback for a single input, used if there are more inputs than can be synchronized
+  /// by message_filters. The latest message of each input is kept, and all inputs are fused once
+  /// every input has received a message.
+  /// \param[in] msg Received message
+  /// \param[in] input_idx Index of the input the message was received on
+  void input_callback(const PointCloudMsgT::ConstSharedPtr & msg, std::size_t input_idx);
+
+  /// \brief Callback for a single input if a fusion deadline is set. The first message of a sweep
+  /// starts the deadline, and the inputs are fused once every input has received a message or
+  /// once the deadline expires, whichever is first.
+  /// \param[in] msg Received message
+  /// \param[in] input_idx Index of the input the message was received on
+  void deadline_input_callback(const PointCloudMsgT::ConstSharedPtr & msg, std::size_t input_idx);
+
+  /// \brief Fuse the inputs which arrived so far, the missing ones are expected to be late
+  void on_fusion_deadline();
+
+  /// \brief Publish a message which missed the deadline of its sweep on its own, transformed to
+  /// the output frame
+  /// \param[in] msg Late message
+  /// \param[in] input_idx Index of the input the message was received on
+  void publish_late_input(const PointCloudMsgT::ConstSharedPtr & msg, std::size_t input_idx);
+
+  /// \brief Look up the transforms from the input frames to the output frame. Inputs whose
+  /// transform is not available are dropped.
+  /// \param[inout] msgs Messages by input, the ones which cannot be transformed are reset
+  void update_input_transforms(std::vector<PointCloudMsgT::ConstSharedPtr> & msgs);
+
+  /// \brief Fuse the messages in m_msgs and publish the result
+  void fuse_and_publish();
+
   std::unique_ptr<point_cloud_fusion::PointCloudFusion> m_core;
   PointCloudT m_cloud_concatenated;
-  std::unique_ptr<message_filters::Subscriber<PointCloudMsgT>> m_cloud_subscribers[8];
+  std::unique_ptr<message_filters::Subscriber<PointCloudMsgT>>
+  m_cloud_subscribers[MAX_SYNCHRONIZED_INPUTS];
   std::unique_ptr<message_filters::Synchronizer<SyncPolicyT>> m_cloud_synchronizer;
+  std::vector<rclcpp::Subscription<PointCloudMsgT>::SharedPtr> m_input_subscriptions;
   rclcpp::Publisher<PointCloudMsgT>::SharedPtr m_cloud_publisher;
+  rclcpp::Publisher<PresenceMsgT>::SharedPtr m_presence_publisher;
+  rclcpp::Publisher<PointCloudMsgT>::SharedPtr m_late_cloud_publisher;
+  rclcpp::TimerBase::SharedPtr m_deadline_timer;
+  std::shared_ptr<autoware_auto_tf2::SharedTransformBuffer> m_tf_buffer;
 
   std::vector<std::string> m_input_topics;
+  std::vector<PointCloudMsgT::ConstSharedPtr> m_msgs;
   std::string m_output_frame_id;
   uint32_t m_cloud_capacity;
+  std::size_t m_num_threads;
+  bool8_t m_transform_inputs;
+  /// Time after the first message of a sweep at which the sweep is fused, disabled if zero
+  std::chrono::milliseconds m_fusion_deadline;
+  bool8_t m_publish_late_inputs;
+  /// Which inputs are part of the last fused cloud
+  PresenceMsgT m_presence;
+  /// Inputs which missed the deadline of the last sweep, and the latest stamp still part of it
+  std::vector<bool8_t> m_late_inputs;
+  std::chrono::nanoseconds m_late_stamp_limit;
+  std::vector<PointCloudMsgT::ConstSharedPtr> m_late_msgs;
+  PointCloudT m_cloud_late;
+  // records when fusing starts and when the fused cloud is published, if tracing is switched on
+  const common::time_utils::TracePoint m_trace;
 };
 }  // namespace point_cloud_fusion_nodes
 }  // namespace filters
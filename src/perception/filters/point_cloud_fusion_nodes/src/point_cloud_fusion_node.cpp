@@ -37,13 +37,21 @@ namespace filters
 namespace point_cloud_fusion_nodes
 {
 
+constexpr std::size_t PointCloudFusionNode::MAX_SYNCHRONIZED_INPUTS;
+
 PointCloudFusionNode::PointCloudFusionNode(
   const rclcpp::NodeOptions & node_options)
 : Node("point_cloud_fusion_nodes", node_options),
   m_cloud_publisher(create_publisher<PointCloudMsgT>("output_topic", rclcpp::QoS(10))),
   m_input_topics(static_cast<std::size_t>(declare_parameter("number_of_sources").get<int>())),
   m_output_frame_id(declare_parameter("output_frame_id").get<std::string>()),
-  m_cloud_capacity(static_cast<uint32_t>(declare_parameter("cloud_size").get<int>()))
+  m_cloud_capacity(static_cast<uint32_t>(declare_parameter("cloud_size").get<int>())),
+  m_num_threads(static_cast<std::size_t>(std::max(declare_parameter("num_threads", 1), 1))),
+  m_transform_inputs(declare_parameter("transform_inputs", false)),
+  m_fusion_deadline(declare_parameter("fusion_deadline_ms", 0)),
+  m_publish_late_inputs(declare_parameter("publish_late_inputs", false)),
+  m_late_stamp_limit(std::chrono::nanoseconds::zero()),
+  m_trace(get_fully_qualified_name())
 {
   for (size_t i = 0; i < m_input_topics.size(); ++i) {
     m_input_topics[i] = "input_topic" + std::to_string(i + 1);
@@ -55,19 +63,61 @@ void PointCloudFusionNode::init()
 {
   m_core = std::make_unique<point_cloud_fusion::PointCloudFusion>(
     m_cloud_capacity,
-    m_input_topics.size());
+    m_input_topics.size(),
+    m_num_threads);
+  m_msgs.resize(m_input_topics.size());
 
   using autoware::common::types::PointXYZI;
   point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{
     m_cloud_concatenated, m_output_frame_id}.reserve(m_cloud_capacity);
 
-  if (m_input_topics.size() > 8 || m_input_topics.size() < 2) {
+  if (m_input_topics.size() < 2) {
     throw std::domain_error(
-            "Number of sources for point cloud fusion must be between 2 and 8."
+            "Number of sources for point cloud fusion must be at least 2."
             " Found: " + std::to_string(m_input_topics.size()));
   }
 
-  for (size_t i = 0; i < 8; ++i) {
+  if (m_transform_inputs) {
+    m_tf_buffer = autoware_auto_tf2::SharedTransformBuffer::get(get_clock());
+  }
+
+  if (m_fusion_deadline < std::chrono::milliseconds::zero()) {
+    throw std::domain_error("fusion_deadline_ms must not be negative");
+  }
+  if (m_fusion_deadline > std::chrono::milliseconds::zero()) {
+    m_presence.data.resize(m_input_topics.size());
+    m_presence_publisher = create_publisher<PresenceMsgT>("output_presence", rclcpp::QoS(10));
+    m_late_inputs.resize(m_input_topics.size(), false);
+    if (m_publish_late_inputs) {
+      m_late_msgs.resize(m_input_topics.size());
+      point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{
+        m_cloud_late, m_output_frame_id}.reserve(m_cloud_capacity);
+      m_late_cloud_publisher =
+        create_publisher<PointCloudMsgT>("late_output_topic", rclcpp::QoS(10));
+    }
+    // Started by the first message of each sweep
+    m_deadline_timer = create_wall_timer(m_fusion_deadline, [this] {on_fusion_deadline();});
+    m_deadline_timer->cancel();
+    for (size_t i = 0; i < m_input_topics.size(); ++i) {
+      m_input_subscriptions.push_back(
+        create_subscription<PointCloudMsgT>(
+          m_input_topics[i], rclcpp::QoS(10),
+          [this, i](const PointCloudMsgT::ConstSharedPtr msg) {deadline_input_callback(msg, i);}));
+    }
+    return;
+  }
+
+  if (m_input_topics.size() > MAX_SYNCHRONIZED_INPUTS) {
+    for (size_t i = 0; i < m_input_topics.size(); ++i) {
+      m_input_subscriptions.push_back(
+        create_subscription<PointCloudMsgT>(
+          m_input_topics[i], rclcpp::QoS(10),
+          [this, i](const PointCloudMsgT::ConstSharedPtr msg) {input_callback(msg, i);}));
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < MAX_SYNCHRONIZED_INPUTS; ++i) {
     if (i < m_input_topics.size()) {
       m_cloud_subscribers[i] = std::make_unique<message_filters::Subscriber<PointCloudMsgT>>(
         this, m_input_topics[i]);
@@ -100,8 +150,123 @@ PointCloudFusionNode::pointcloud_callback(
   const PointCloudMsgT::ConstSharedPtr & msg5, const PointCloudMsgT::ConstSharedPtr & msg6,
   const PointCloudMsgT::ConstSharedPtr & msg7, const PointCloudMsgT::ConstSharedPtr & msg8)
 {
-  std::array<PointCloudMsgT::ConstSharedPtr, 8> msgs{msg1, msg2, msg3, msg4, msg5, msg6, msg7,
-    msg8};
+  const std::array<PointCloudMsgT::ConstSharedPtr, MAX_SYNCHRONIZED_INPUTS> msgs{msg1, msg2, msg3,
+    msg4, msg5, msg6, msg7, msg8};
+  for (size_t i = 0; i < m_msgs.size(); ++i) {
+    m_msgs[i] = msgs[i];
+  }
+  fuse_and_publish();
+}
+
+void PointCloudFusionNode::input_callback(
+  const PointCloudMsgT::ConstSharedPtr & msg,
+  std::size_t input_idx)
+{
+  m_msgs[input_idx] = msg;
+  const auto has_msg = [](const PointCloudMsgT::ConstSharedPtr & input_msg) {
+      return static_cast<bool8_t>(input_msg);
+    };
+  if (std::all_of(m_msgs.begin(), m_msgs.end(), has_msg)) {
+    fuse_and_publish();
+    std::fill(m_msgs.begin(), m_msgs.end(), nullptr);
+  }
+}
+
+void PointCloudFusionNode::deadline_input_callback(
+  const PointCloudMsgT::ConstSharedPtr & msg,
+  std::size_t input_idx)
+{
+  if (m_late_inputs[input_idx]) {
+    m_late_inputs[input_idx] = false;
+    if (convert_msg_time(msg->header.stamp) <= m_late_stamp_limit) {
+      // belongs to the sweep which was already fused without it
+      if (m_publish_late_inputs) {
+        publish_late_input(msg, input_idx);
+      }
+      return;
+    }
+  }
+  const auto has_msg = [](const PointCloudMsgT::ConstSharedPtr & input_msg) {
+      return static_cast<bool8_t>(input_msg);
+    };
+  if (std::none_of(m_msgs.begin(), m_msgs.end(), has_msg)) {
+    m_deadline_timer->reset();
+  }
+  m_msgs[input_idx] = msg;
+  if (std::all_of(m_msgs.begin(), m_msgs.end(), has_msg)) {
+    m_deadline_timer->cancel();
+    fuse_and_publish();
+    std::fill(m_msgs.begin(), m_msgs.end(), nullptr);
+  }
+}
+
+void PointCloudFusionNode::on_fusion_deadline()
+{
+  m_deadline_timer->cancel();
+  auto latest_stamp = std::chrono::nanoseconds::zero();
+  for (size_t i = 0; i < m_msgs.size(); ++i) {
+    m_late_inputs[i] = !m_msgs[i];
+    if (m_msgs[i]) {
+      latest_stamp = std::max(latest_stamp, convert_msg_time(m_msgs[i]->header.stamp));
+    }
+  }
+  // A late message taken within the deadline after the latest message still belongs to the sweep
+  m_late_stamp_limit = latest_stamp + m_fusion_deadline;
+  fuse_and_publish();
+  std::fill(m_msgs.begin(), m_msgs.end(), nullptr);
+}
+
+void PointCloudFusionNode::publish_late_input(
+  const PointCloudMsgT::ConstSharedPtr & msg,
+  std::size_t input_idx)
+{
+  m_late_msgs[input_idx] = msg;
+  if (m_transform_inputs) {
+    update_input_transforms(m_late_msgs);
+  }
+  try {
+    if (m_late_msgs[input_idx] && (m_core->fuse_pc_msgs(m_late_msgs, m_cloud_late) > 0U)) {
+      m_cloud_late.header.stamp = msg->header.stamp;
+      m_late_cloud_publisher->publish(m_cloud_late);
+    }
+  } catch (point_cloud_fusion::PointCloudFusion::Error) {
+    RCLCPP_WARN(get_logger(), "Late pointcloud is too large to be published and will be ignored.");
+  }
+  m_late_msgs[input_idx] = nullptr;
+}
+
+void PointCloudFusionNode::update_input_transforms(
+  std::vector<PointCloudMsgT::ConstSharedPtr> & msgs)
+{
+  for (size_t i = 0; i < msgs.size(); ++i) {
+    if (!msgs[i]) {
+      continue;
+    }
+    const auto & frame_id = msgs[i]->header.frame_id;
+    if (frame_id == m_output_frame_id) {
+      m_core->set_input_transform(i, geometry_msgs::msg::Transform{});
+      continue;
+    }
+    try {
+      // The lidars are usually mounted rigidly, then this is served from the static cache
+      m_core->set_input_transform(
+        i, m_tf_buffer->lookup_latest_transform(m_output_frame_id, frame_id));
+    } catch (const tf2::TransformException & ex) {
+      RCLCPP_WARN(
+        get_logger(), "Could not transform pointcloud from '%s', it will be ignored: %s",
+        frame_id.c_str(), ex.what());
+      msgs[i] = nullptr;
+    }
+  }
+}
+
+void PointCloudFusionNode::fuse_and_publish()
+{
+  using TraceClock = common::time_utils::TracePoint::Clock;
+  const auto enter = m_trace.enabled() ? TraceClock::now() : TraceClock::time_point{};
+  if (m_transform_inputs) {
+    update_input_transforms(m_msgs);
+  }
 
   // reset pointcloud before using
   using autoware::common::types::PointXYZI;
@@ -109,16 +274,19 @@ PointCloudFusionNode::pointcloud_callback(
   modifier.clear();
   modifier.reserve(m_cloud_capacity);
 
-  auto latest_stamp = msgs[0]->header.stamp;
+  builtin_interfaces::msg::Time latest_stamp;
   auto total_size = 0U;
 
   // Get the latest time stamp of the point clouds and find the total size after concatenation
-  for (uint32_t msg_idx = 0; msg_idx < m_input_topics.size(); ++msg_idx) {
-    const auto & stamp = msgs[msg_idx]->header.stamp;
+  for (const auto & msg : m_msgs) {
+    if (!msg) {
+      continue;
+    }
+    const auto & stamp = msg->header.stamp;
     if (convert_msg_time(stamp) > convert_msg_time(latest_stamp)) {
       latest_stamp = stamp;
     }
-    total_size += msgs[msg_idx]->width;
+    total_size += msg->width;
   }
 
   if (total_size > m_cloud_capacity) {
@@ -130,7 +298,7 @@ PointCloudFusionNode::pointcloud_callback(
   // Go through all the messages and fuse them.
   uint32_t fused_cloud_size = 0;
   try {
-    fused_cloud_size = m_core->fuse_pc_msgs(msgs, m_cloud_concatenated);
+    fused_cloud_size = m_core->fuse_pc_msgs(m_msgs, m_cloud_concatenated);
   } catch (point_cloud_fusion::PointCloudFusion::Error fuse_error) {
     if (fuse_error == point_cloud_fusion::PointCloudFusion::Error::TOO_LARGE) {
       RCLCPP_WARN(get_logger(), "Pointcloud is too large to be fused and will be ignored.");
@@ -141,12 +309,28 @@ PointCloudFusionNode::pointcloud_callback(
     }
   }
 
+  const auto & transform_times = m_core->get_input_transform_times();
+  for (size_t i = 0; i < transform_times.size(); ++i) {
+    RCLCPP_DEBUG(
+      get_logger(), "Input %s transformed in %s us", std::to_string(i).c_str(),
+      std::to_string(
+        std::chrono::duration_cast<std::chrono::microseconds>(transform_times[i]).count()).c_str());
+  }
+
   if (fused_cloud_size > 0) {
     // Resize and publish.
     modifier.resize(fused_cloud_size);
 
     m_cloud_concatenated.header.stamp = latest_stamp;
     m_cloud_publisher->publish(m_cloud_concatenated);
+    // The fused cloud carries the stamp of the latest input, which is the sweep it is traced as
+    m_trace.record(latest_stamp, enter, TraceClock::now());
+    if (m_presence_publisher) {
+      for (size_t i = 0; i < m_msgs.size(); ++i) {
+        m_presence.data[i] = m_msgs[i] ? 1U : 0U;
+      }
+      m_presence_publisher->publish(m_presence);
+    }
   }
 }
 }  // namespace point_cloud_fusion_nodes
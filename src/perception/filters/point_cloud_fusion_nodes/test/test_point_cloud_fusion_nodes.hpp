@@ -23,6 +23,9 @@
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 #include <common/types.hpp>
+#include <chrono>
+#include <cmath>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -203,4 +206,213 @@ TEST_F(TestPCF, TestBasicFusion) {
   EXPECT_TRUE(test_completed);
 }
 
+TEST_F(TestPCF, TestTenSourceFusion) {
+  constexpr int32_t num_sources = 10;
+  std::vector<rclcpp::Parameter> params;
+  params.emplace_back("number_of_sources", num_sources);
+  params.emplace_back("output_frame_id", "base_link");
+  params.emplace_back("cloud_size", static_cast<int64_t>(55000U));
+  params.emplace_back("num_threads", 4);
+
+  rclcpp::NodeOptions node_options;
+  node_options.parameter_overrides(params);
+
+  auto pcf_node =
+    std::make_shared<autoware::perception::filters::point_cloud_fusion_nodes::PointCloudFusionNode>(
+    node_options);
+
+  bool8_t test_completed = false;
+  auto time0 = std::chrono::system_clock::now();
+
+  std::vector<sensor_msgs::msg::PointCloud2> pcs;
+  std::vector<int32_t> expected_seeds;
+  for (int32_t i = 0; i < num_sources; ++i) {
+    pcs.push_back(make_pc({i, i + 100}, to_msg_time(time0 + std::chrono::nanoseconds(i))));
+    expected_seeds.push_back(i);
+    expected_seeds.push_back(i + 100);
+  }
+  auto expected_result =
+    make_pc(expected_seeds, to_msg_time(time0 + std::chrono::nanoseconds(num_sources - 1)));
+
+  std::vector<rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr> pubs;
+  for (int32_t i = 0; i < num_sources; ++i) {
+    pubs.push_back(
+      pcf_node->create_publisher<sensor_msgs::msg::PointCloud2>(
+        "input_topic" + std::to_string(i + 1), rclcpp::QoS(10)));
+  }
+
+  auto handle_concat =
+    [&expected_result, &test_completed](const sensor_msgs::msg::PointCloud2::SharedPtr msg)
+    -> void {
+      check_pcl_eq(*msg, expected_result);
+      test_completed = true;
+    };
+
+  auto sub_ptr = pcf_node->create_subscription<sensor_msgs::msg::PointCloud2>(
+    "output_topic",
+    rclcpp::QoS(10), handle_concat);
+
+  // Without the message_filters synchronizer, clouds are fused once every input has one
+  for (int32_t i = 0; i < num_sources; ++i) {
+    pubs[static_cast<std::size_t>(i)]->publish(pcs[static_cast<std::size_t>(i)]);
+  }
+
+  auto start_time = std::chrono::system_clock::now();
+  auto max_test_dur = std::chrono::seconds(1);
+  auto timed_out = false;
+
+  while (rclcpp::ok() && !test_completed) {
+    rclcpp::spin_some(pcf_node);
+    rclcpp::sleep_for(std::chrono::milliseconds(50));
+    if (std::chrono::system_clock::now() - start_time > max_test_dur) {
+      timed_out = true;
+      break;
+    }
+  }
+  EXPECT_FALSE(timed_out);
+  EXPECT_TRUE(test_completed);
+}
+
+TEST_F(TestPCF, TestDeadlineFusion) {
+  std::vector<rclcpp::Parameter> params;
+  params.emplace_back("number_of_sources", 3);
+  params.emplace_back("output_frame_id", "base_link");
+  params.emplace_back("cloud_size", static_cast<int64_t>(55000U));
+  params.emplace_back("fusion_deadline_ms", 100);
+  params.emplace_back("publish_late_inputs", true);
+
+  rclcpp::NodeOptions node_options;
+  node_options.parameter_overrides(params);
+
+  auto pcf_node =
+    std::make_shared<autoware::perception::filters::point_cloud_fusion_nodes::PointCloudFusionNode>(
+    node_options);
+
+  auto time0 = std::chrono::system_clock::now();
+  auto t0 = to_msg_time(time0);
+  auto t1 = to_msg_time(time0 + std::chrono::nanoseconds(1));
+  auto t2 = to_msg_time(time0 + std::chrono::milliseconds(20));
+
+  auto pc1 = make_pc({1, 2, 3}, t0);
+  auto pc2 = make_pc({4, 5, 6}, t1);
+  auto pc3 = make_pc({7, 8}, t2);
+  auto expected_result = make_pc({1, 2, 3, 4, 5, 6}, t1);
+
+  std::vector<rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr> pubs;
+  for (int32_t i = 0; i < 3; ++i) {
+    pubs.push_back(
+      pcf_node->create_publisher<sensor_msgs::msg::PointCloud2>(
+        "input_topic" + std::to_string(i + 1), rclcpp::QoS(10)));
+  }
+
+  bool8_t fused = false;
+  bool8_t late = false;
+  std::vector<uint8_t> presence;
+  auto sub_ptr = pcf_node->create_subscription<sensor_msgs::msg::PointCloud2>(
+    "output_topic", rclcpp::QoS(10),
+    [&expected_result, &fused](const sensor_msgs::msg::PointCloud2::SharedPtr msg) {
+      check_pcl_eq(*msg, expected_result);
+      fused = true;
+    });
+  auto presence_sub_ptr = pcf_node->create_subscription<std_msgs::msg::UInt8MultiArray>(
+    "output_presence", rclcpp::QoS(10),
+    [&presence](const std_msgs::msg::UInt8MultiArray::SharedPtr msg) {presence = msg->data;});
+  auto late_sub_ptr = pcf_node->create_subscription<sensor_msgs::msg::PointCloud2>(
+    "late_output_topic", rclcpp::QoS(10),
+    [&pc3, &late](const sensor_msgs::msg::PointCloud2::SharedPtr msg) {
+      check_pcl_eq(*msg, pc3);
+      late = true;
+    });
+
+  const auto spin_until = [&pcf_node](const std::function<bool8_t()> & done) {
+      const auto start_time = std::chrono::system_clock::now();
+      while (rclcpp::ok() && !done()) {
+        rclcpp::spin_some(pcf_node);
+        rclcpp::sleep_for(std::chrono::milliseconds(10));
+        if (std::chrono::system_clock::now() - start_time > std::chrono::seconds(1)) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+  // The third source misses the deadline, the other two are fused without it
+  pubs[0U]->publish(pc1);
+  pubs[1U]->publish(pc2);
+  EXPECT_TRUE(spin_until([&fused] {return fused;}));
+  EXPECT_TRUE(spin_until([&presence] {return !presence.empty();}));
+  EXPECT_EQ(presence, (std::vector<uint8_t>{1U, 1U, 0U}));
+
+  // Its cloud of the same sweep is published on its own
+  pubs[2U]->publish(pc3);
+  EXPECT_TRUE(spin_until([&late] {return late;}));
+}
+
+TEST_F(TestPCF, TestTransformedFusion) {
+  using autoware::common::types::PointXYZI;
+  using autoware::perception::filters::point_cloud_fusion::PointCloudFusion;
+  constexpr std::size_t num_sources = 10U;
+  constexpr std::size_t num_points = 10000U;
+  PointCloudFusion fusion{static_cast<uint32_t>(num_sources * num_points), num_sources, 4U};
+
+  std::vector<PointCloudFusion::PointCloudMsgT::ConstSharedPtr> msgs;
+  for (std::size_t i = 0U; i < num_sources; ++i) {
+    auto msg = std::make_shared<sensor_msgs::msg::PointCloud2>();
+    point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{*msg, "base_link"};
+    for (std::size_t j = 0U; j < num_points; ++j) {
+      modifier.push_back(
+        PointXYZI{static_cast<float32_t>(j), static_cast<float32_t>(i), 1.0F, 2.0F});
+    }
+    msgs.push_back(msg);
+  }
+  // 90 degrees around z, then shift by 1 in x
+  geometry_msgs::msg::Transform tf;
+  tf.translation.x = 1.0;
+  tf.rotation.z = std::sqrt(0.5);
+  tf.rotation.w = std::sqrt(0.5);
+  fusion.set_input_transform(3U, tf);
+  tf.rotation.w = 1.0;
+  EXPECT_THROW(fusion.set_input_transform(4U, tf), std::domain_error);
+  EXPECT_THROW(fusion.set_input_transform(num_sources, geometry_msgs::msg::Transform{}),
+    std::out_of_range);
+
+  sensor_msgs::msg::PointCloud2 cloud_concatenated;
+  EXPECT_EQ(fusion.fuse_pc_msgs(msgs, cloud_concatenated), num_sources * num_points);
+  point_cloud_msg_wrapper::PointCloud2View<PointXYZI> view{cloud_concatenated};
+  ASSERT_EQ(view.size(), num_sources * num_points);
+  for (std::size_t i = 0U; i < num_sources; ++i) {
+    for (std::size_t j = 0U; j < num_points; j += 1000U) {
+      const auto & pt = view[(i * num_points) + j];
+      if (i == 3U) {
+        EXPECT_NEAR(pt.x, 1.0F - static_cast<float32_t>(i), 1.0e-3F);
+        EXPECT_NEAR(pt.y, static_cast<float32_t>(j), 1.0e-3F);
+      } else {
+        EXPECT_FLOAT_EQ(pt.x, static_cast<float32_t>(j));
+        EXPECT_FLOAT_EQ(pt.y, static_cast<float32_t>(i));
+      }
+      EXPECT_FLOAT_EQ(pt.z, 1.0F);
+      EXPECT_FLOAT_EQ(pt.intensity, 2.0F);
+    }
+  }
+  const auto & transform_times = fusion.get_input_transform_times();
+  ASSERT_EQ(transform_times.size(), num_sources);
+  for (std::size_t i = 0U; i < num_sources; ++i) {
+    std::cout << "Input " << i << " transformed in " <<
+      std::chrono::duration_cast<std::chrono::microseconds>(transform_times[i]).count() << "us\n";
+  }
+
+  // Missing inputs are skipped
+  msgs[2U] = nullptr;
+  EXPECT_EQ(fusion.fuse_pc_msgs(msgs, cloud_concatenated), (num_sources - 1U) * num_points);
+  EXPECT_EQ(fusion.get_input_transform_times()[2U], std::chrono::nanoseconds::zero());
+  // Too many inputs
+  msgs.push_back(msgs[0U]);
+  EXPECT_THROW(fusion.fuse_pc_msgs(msgs, cloud_concatenated), std::length_error);
+  msgs.pop_back();
+  // Output left untouched if the inputs do not fit
+  PointCloudFusion small_fusion{static_cast<uint32_t>(num_points), num_sources};
+  EXPECT_THROW(small_fusion.fuse_pc_msgs(msgs, cloud_concatenated), PointCloudFusion::Error);
+  EXPECT_EQ(cloud_concatenated.width, (num_sources - 1U) * num_points);
+}
+
 #endif  // TEST_POINT_CLOUD_FUSION_NODES_HPP_
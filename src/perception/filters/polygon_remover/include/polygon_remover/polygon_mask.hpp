@@ -0,0 +1,113 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 The Autoware Foundation
+/// \file
+/// \brief This file defines the polygon_mask class.
+
+#ifndef POLYGON_REMOVER__POLYGON_MASK_HPP_
+#define POLYGON_REMOVER__POLYGON_MASK_HPP_
+
+#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+#include <polygon_remover/visibility_control.hpp>
+#include <common/types.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace polygon_remover
+{
+
+/// \brief Rasterized occupancy mask of a polygon, used to classify many points against a polygon
+///        which changes rarely. The bounding box of the polygon is divided into square cells, and
+///        each cell is labeled as outside, inside or crossed by the polygon boundary. Only points
+///        in boundary cells are tested exactly against the polygon, so the result is the same as
+///        with CGAL::bounded_side_2.
+class POLYGON_REMOVER_PUBLIC PolygonMask
+{
+public:
+  typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
+  typedef K::Point_2 PointCgal;
+  using bool8_t = autoware::common::types::bool8_t;
+  using float32_t = autoware::common::types::float32_t;
+  using float64_t = autoware::common::types::float64_t;
+
+  static constexpr std::size_t kDefaultMaxCellsPerAxis = 256U;
+
+  /// \brief Constructs an empty mask, for which all points are outside
+  PolygonMask();
+
+  /// \brief Rasterizes the given polygon
+  /// \param polygon Vertices of a simple polygon, first and last vertices are connected
+  /// \param max_cells_per_axis Number of cells along the longer side of the bounding box
+  /// \throw std::length_error if the polygon has less than 3 vertices
+  /// \throw std::domain_error if max_cells_per_axis is 0
+  explicit PolygonMask(
+    const std::vector<PointCgal> & polygon,
+    std::size_t max_cells_per_axis = kDefaultMaxCellsPerAxis);
+
+  /// \brief Checks whether a point is outside of the polygon, i.e. not inside or on its boundary
+  /// \param x x coordinate of the point
+  /// \param y y coordinate of the point
+  /// \return True if the point is outside of the polygon
+  bool8_t is_outside(float32_t x, float32_t y) const;
+
+  /// \brief Returns the number of cells along the x axis
+  std::size_t get_num_cells_x() const;
+  /// \brief Returns the number of cells along the y axis
+  std::size_t get_num_cells_y() const;
+  /// \brief Returns the number of cells crossed by the polygon boundary
+  std::size_t get_num_boundary_cells() const;
+
+private:
+  enum class Cell : uint8_t
+  {
+    kOutside,
+    kInside,
+    kBoundary
+  };
+
+  /// \brief Labels all cells touched by the edges of the polygon as boundary cells
+  POLYGON_REMOVER_LOCAL void mark_boundary_cells();
+  /// \brief Labels the remaining cells by casting a ray along the center of each row of cells
+  POLYGON_REMOVER_LOCAL void fill_rows();
+  /// \brief Returns the index of the cell column or row containing a coordinate, clamped to the
+  ///        grid
+  POLYGON_REMOVER_LOCAL static std::size_t to_index(
+    float64_t value, float64_t min, float64_t inv_cell_size, std::size_t num_cells);
+
+  std::vector<PointCgal> polygon_;
+  std::vector<Cell> cells_;
+  std::size_t num_cells_x_;
+  std::size_t num_cells_y_;
+  float64_t min_x_;
+  float64_t min_y_;
+  float64_t max_x_;
+  float64_t max_y_;
+  float64_t cell_size_;
+  float64_t inv_cell_size_;
+};
+
+}  // namespace polygon_remover
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // POLYGON_REMOVER__POLYGON_MASK_HPP_
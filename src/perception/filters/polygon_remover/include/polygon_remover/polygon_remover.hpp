@@ -21,6 +21,7 @@
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Polygon_2_algorithms.h>
+#include <polygon_remover/polygon_mask.hpp>
 #include <polygon_remover/visibility_control.hpp>
 #include <common/types.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
@@ -81,11 +82,21 @@ public:
   static std::vector<PointCgal> polygon_geometry_to_cgal(
     const Polygon::ConstSharedPtr & polygon_in);
 
-  /// \brief Updates the stored polygon to be used later on
+  /// \brief Removes the points of the given cloud which are not outside of the given mask
+  /// \param cloud_in_ptr Input Point Cloud Shared Pointer
+  /// \param polygon_mask Mask of the polygon to remove
+  /// \return Filtered Point Cloud Shared Pointer
+  static PointCloud2::SharedPtr remove_polygon_mask_from_cloud(
+    const PointCloud2::ConstSharedPtr & cloud_in_ptr,
+    const PolygonMask & polygon_mask);
+
+  /// \brief Updates the stored polygon to be used later on, and precomputes its mask
   /// \param polygon_in Input Polygon
   void update_polygon(const Polygon::ConstSharedPtr & polygon_in);
 
   /// \brief Removes the stored polygon from the point cloud and returns the filtered point cloud.
+  ///        Uses the mask precomputed by update_polygon, so that most points are classified by a
+  ///        single lookup.
   /// \param cloud_in Input Point Cloud Shared Pointer
   /// \return Filtered Point Cloud Shared Pointer
   PointCloud2::SharedPtr remove_updated_polygon_from_cloud(
@@ -105,6 +116,7 @@ private:
   bool8_t polygon_is_initialized_;
   bool8_t will_visualize_;
   std::vector<PointCgal> polygon_cgal_;
+  PolygonMask polygon_mask_;
   Marker marker_;
 };
 
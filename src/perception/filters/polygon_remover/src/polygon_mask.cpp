@@ -0,0 +1,221 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+#include <CGAL/Polygon_2_algorithms.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "polygon_remover/polygon_mask.hpp"
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace polygon_remover
+{
+using K = CGAL::Exact_predicates_inexact_constructions_kernel;
+using PointCgal = K::Point_2;
+using autoware::common::types::bool8_t;
+using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
+
+constexpr std::size_t PolygonMask::kDefaultMaxCellsPerAxis;
+
+PolygonMask::PolygonMask()
+: num_cells_x_{0U},
+  num_cells_y_{0U},
+  min_x_{0.0},
+  min_y_{0.0},
+  max_x_{-1.0},
+  max_y_{-1.0},
+  cell_size_{1.0},
+  inv_cell_size_{1.0}
+{
+}
+
+PolygonMask::PolygonMask(
+  const std::vector<PointCgal> & polygon,
+  std::size_t max_cells_per_axis)
+: polygon_{polygon}
+{
+  if (polygon_.size() < 3U) {
+    throw std::length_error("Polygon vertex count should be larger than 2.");
+  }
+  if (max_cells_per_axis == 0U) {
+    throw std::domain_error("PolygonMask needs at least one cell per axis.");
+  }
+  const auto x_minmax = std::minmax_element(
+    polygon_.begin(), polygon_.end(),
+    [](const PointCgal & a, const PointCgal & b) {return a.x() < b.x();});
+  const auto y_minmax = std::minmax_element(
+    polygon_.begin(), polygon_.end(),
+    [](const PointCgal & a, const PointCgal & b) {return a.y() < b.y();});
+  min_x_ = x_minmax.first->x();
+  max_x_ = x_minmax.second->x();
+  min_y_ = y_minmax.first->y();
+  max_y_ = y_minmax.second->y();
+
+  cell_size_ = std::max(max_x_ - min_x_, max_y_ - min_y_) /
+    static_cast<float64_t>(max_cells_per_axis);
+  if (!(cell_size_ > 0.0) || !std::isfinite(cell_size_)) {
+    // All vertices coincide: a single boundary cell, so every point is tested exactly
+    cell_size_ = 1.0;
+    inv_cell_size_ = 1.0;
+    num_cells_x_ = 1U;
+    num_cells_y_ = 1U;
+    cells_.assign(1U, Cell::kBoundary);
+    return;
+  }
+  inv_cell_size_ = 1.0 / cell_size_;
+  const auto count_cells = [this](float64_t extent) {
+      const auto num_cells = static_cast<std::size_t>(std::ceil(extent * inv_cell_size_));
+      return std::max(num_cells, std::size_t{1U});
+    };
+  num_cells_x_ = count_cells(max_x_ - min_x_);
+  num_cells_y_ = count_cells(max_y_ - min_y_);
+  cells_.assign(num_cells_x_ * num_cells_y_, Cell::kOutside);
+
+  mark_boundary_cells();
+  fill_rows();
+}
+
+bool8_t PolygonMask::is_outside(float32_t x, float32_t y) const
+{
+  const auto px = static_cast<float64_t>(x);
+  const auto py = static_cast<float64_t>(y);
+  // Written so that NaN coordinates are outside as well
+  if (!((px >= min_x_) && (px <= max_x_) && (py >= min_y_) && (py <= max_y_))) {
+    return true;
+  }
+  const std::size_t col = to_index(px, min_x_, inv_cell_size_, num_cells_x_);
+  const std::size_t row = to_index(py, min_y_, inv_cell_size_, num_cells_y_);
+  switch (cells_[(row * num_cells_x_) + col]) {
+    case Cell::kOutside:
+      return true;
+    case Cell::kInside:
+      return false;
+    case Cell::kBoundary:
+    default:
+      return CGAL::bounded_side_2(
+        polygon_.begin(), polygon_.end(), PointCgal(px, py), K()) == CGAL::ON_UNBOUNDED_SIDE;
+  }
+}
+
+std::size_t PolygonMask::get_num_cells_x() const
+{
+  return num_cells_x_;
+}
+
+std::size_t PolygonMask::get_num_cells_y() const
+{
+  return num_cells_y_;
+}
+
+std::size_t PolygonMask::get_num_boundary_cells() const
+{
+  return static_cast<std::size_t>(std::count(cells_.begin(), cells_.end(), Cell::kBoundary));
+}
+
+void PolygonMask::mark_boundary_cells()
+{
+  // Cells are grown by a small margin, so that rounding errors can only add boundary cells and
+  // never miss one
+  const float64_t margin = 1.0e-3 * cell_size_;
+  for (std::size_t index_cur = 0U; index_cur < polygon_.size(); ++index_cur) {
+    const auto & a = polygon_[index_cur];
+    const auto & b = polygon_[(index_cur + 1U) % polygon_.size()];
+    const float64_t edge_min_y = std::min(a.y(), b.y());
+    const float64_t edge_max_y = std::max(a.y(), b.y());
+    const std::size_t row_begin =
+      to_index(edge_min_y - margin, min_y_, inv_cell_size_, num_cells_y_);
+    const std::size_t row_end =
+      to_index(edge_max_y + margin, min_y_, inv_cell_size_, num_cells_y_);
+    for (std::size_t row = row_begin; row <= row_end; ++row) {
+      // Part of the edge within the (grown) row
+      const float64_t band_min_y = min_y_ + (static_cast<float64_t>(row) * cell_size_) - margin;
+      const float64_t band_max_y = band_min_y + cell_size_ + (2.0 * margin);
+      float64_t x_begin = std::min(a.x(), b.x());
+      float64_t x_end = std::max(a.x(), b.x());
+      if (edge_max_y > edge_min_y) {
+        const auto x_at = [&a, &b](float64_t y) {
+            return a.x() + (((y - a.y()) * (b.x() - a.x())) / (b.y() - a.y()));
+          };
+        const float64_t x_low = x_at(std::max(band_min_y, edge_min_y));
+        const float64_t x_high = x_at(std::min(band_max_y, edge_max_y));
+        x_begin = std::min(x_low, x_high);
+        x_end = std::max(x_low, x_high);
+      }
+      const std::size_t col_begin =
+        to_index(x_begin - margin, min_x_, inv_cell_size_, num_cells_x_);
+      const std::size_t col_end =
+        to_index(x_end + margin, min_x_, inv_cell_size_, num_cells_x_);
+      std::fill(
+        cells_.begin() + static_cast<std::ptrdiff_t>((row * num_cells_x_) + col_begin),
+        cells_.begin() + static_cast<std::ptrdiff_t>((row * num_cells_x_) + col_end + 1U),
+        Cell::kBoundary);
+    }
+  }
+}
+
+void PolygonMask::fill_rows()
+{
+  // No edge crosses a cell which is not a boundary cell, so the whole cell is on the same side as
+  // its center. The center is classified with the even-odd rule along the center line of its row
+  std::vector<float64_t> crossings;
+  crossings.reserve(polygon_.size());
+  for (std::size_t row = 0U; row < num_cells_y_; ++row) {
+    const float64_t center_y = min_y_ + ((static_cast<float64_t>(row) + 0.5) * cell_size_);
+    crossings.clear();
+    for (std::size_t index_cur = 0U; index_cur < polygon_.size(); ++index_cur) {
+      const auto & a = polygon_[index_cur];
+      const auto & b = polygon_[(index_cur + 1U) % polygon_.size()];
+      if ((a.y() <= center_y) != (b.y() <= center_y)) {
+        crossings.push_back(a.x() + (((center_y - a.y()) * (b.x() - a.x())) / (b.y() - a.y())));
+      }
+    }
+    std::sort(crossings.begin(), crossings.end());
+    auto crossing_it = crossings.cbegin();
+    bool8_t inside = false;
+    for (std::size_t col = 0U; col < num_cells_x_; ++col) {
+      const float64_t center_x = min_x_ + ((static_cast<float64_t>(col) + 0.5) * cell_size_);
+      while ((crossing_it != crossings.cend()) && (*crossing_it < center_x)) {
+        inside = !inside;
+        ++crossing_it;
+      }
+      Cell & cell = cells_[(row * num_cells_x_) + col];
+      if (cell != Cell::kBoundary) {
+        cell = inside ? Cell::kInside : Cell::kOutside;
+      }
+    }
+  }
+}
+
+std::size_t PolygonMask::to_index(
+  float64_t value, float64_t min, float64_t inv_cell_size, std::size_t num_cells)
+{
+  const float64_t index = std::floor((value - min) * inv_cell_size);
+  if (index <= 0.0) {
+    return 0U;
+  }
+  return std::min(static_cast<std::size_t>(index), num_cells - 1U);
+}
+
+}  // namespace polygon_remover
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
@@ -38,6 +38,39 @@ using K = CGAL::Exact_predicates_inexact_constructions_kernel;
 using PointCgal = K::Point_2;
 using autoware::common::types::bool8_t;
 
+namespace
+{
+/// \brief Copies the points of the input cloud for which point_is_outside_polygon returns true
+template<typename PredicateT>
+PointCloud2::SharedPtr remove_points_from_cloud(
+  const PointCloud2::ConstSharedPtr & cloud_in_ptr,
+  const PredicateT & point_is_outside_polygon)
+{
+  PointCloud2::SharedPtr cloud_filtered_ptr = std::make_shared<PointCloud2>();
+
+  using CloudModifier = point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>;
+  using CloudView = point_cloud_msg_wrapper::PointCloud2View<PointXYZI>;
+
+  CloudModifier cloud_modifier_filtered(*cloud_filtered_ptr, "");
+  cloud_filtered_ptr->header = cloud_in_ptr->header;
+
+  CloudView cloud_view_in(*cloud_in_ptr);
+  cloud_modifier_filtered.resize(static_cast<uint32_t>(cloud_view_in.size()));
+
+  auto new_end = std::copy_if(
+    cloud_view_in.cbegin(),
+    cloud_view_in.cend(),
+    cloud_modifier_filtered.begin(),
+    point_is_outside_polygon);
+
+  cloud_modifier_filtered.resize(
+    static_cast<uint32_t>(std::distance(
+      cloud_modifier_filtered.begin(),
+      new_end)));
+  return cloud_filtered_ptr;
+}
+}  // namespace
+
 PolygonRemover::PolygonRemover(bool8_t will_visualize)
 : polygon_is_initialized_{false},
   will_visualize_{will_visualize}
@@ -57,37 +90,25 @@ PointCloud2::SharedPtr PolygonRemover::remove_polygon_cgal_from_cloud(
   const PointCloud2::ConstSharedPtr & cloud_in_ptr,
   const std::vector<PointCgal> & polyline_polygon)
 {
-  PointCloud2::SharedPtr cloud_filtered_ptr = std::make_shared<PointCloud2>();
-
-  using CloudModifier = point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>;
-  using CloudView = point_cloud_msg_wrapper::PointCloud2View<PointXYZI>;
-
-  CloudModifier cloud_modifier_filtered(*cloud_filtered_ptr, "");
-  cloud_filtered_ptr->header = cloud_in_ptr->header;
-
-  CloudView cloud_view_in(*cloud_in_ptr);
-  cloud_modifier_filtered.resize(static_cast<uint32_t>(cloud_view_in.size()));
-
-  auto point_is_outside_polygon = [&polyline_polygon](const PointXYZI & point) {
+  return remove_points_from_cloud(
+    cloud_in_ptr,
+    [&polyline_polygon](const PointXYZI & point) {
       auto result = CGAL::bounded_side_2(
         polyline_polygon.begin(), polyline_polygon.end(),
         PointCgal(point.x, point.y), K());
       return result == CGAL::ON_UNBOUNDED_SIDE;  // not INSIDE or ON the polygon
-    };
-
-  auto new_end = std::copy_if(
-    cloud_view_in.cbegin(),
-    cloud_view_in.cend(),
-    cloud_modifier_filtered.begin(),
-    [&point_is_outside_polygon](const PointXYZI & point) {
-      return point_is_outside_polygon(point);
     });
+}
 
-  cloud_modifier_filtered.resize(
-    static_cast<uint32_t>(std::distance(
-      cloud_modifier_filtered.begin(),
-      new_end)));
-  return cloud_filtered_ptr;
+PointCloud2::SharedPtr PolygonRemover::remove_polygon_mask_from_cloud(
+  const PointCloud2::ConstSharedPtr & cloud_in_ptr,
+  const PolygonMask & polygon_mask)
+{
+  return remove_points_from_cloud(
+    cloud_in_ptr,
+    [&polygon_mask](const PointXYZI & point) {
+      return polygon_mask.is_outside(point.x, point.y);
+    });
 }
 
 std::vector<PointCgal> PolygonRemover::polygon_geometry_to_cgal(
@@ -112,6 +133,7 @@ std::vector<PointCgal> PolygonRemover::polygon_geometry_to_cgal(
 void PolygonRemover::update_polygon(const Polygon::ConstSharedPtr & polygon_in)
 {
   polygon_cgal_ = polygon_geometry_to_cgal(polygon_in);
+  polygon_mask_ = PolygonMask{polygon_cgal_};
   if (will_visualize_) {
     marker_.ns = "ns_polygon_remover";
     marker_.id = 0;
@@ -178,7 +200,7 @@ PointCloud2::SharedPtr PolygonRemover::remove_updated_polygon_from_cloud(
     throw std::runtime_error(
             "Polygon is not initialized. Please use `update_polygon` first.");
   }
-  return remove_polygon_cgal_from_cloud(cloud_in, polygon_cgal_);
+  return remove_polygon_mask_from_cloud(cloud_in, polygon_mask_);
 }
 
 bool8_t PolygonRemover::polygon_is_initialized() const
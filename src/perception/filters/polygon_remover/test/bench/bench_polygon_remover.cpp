@@ -0,0 +1,99 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
+#include <polygon_remover/polygon_mask.hpp>
+#include <polygon_remover/polygon_remover.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr auto kCloudSize = 100000UL;
+constexpr auto kVertexCount = 64UL;
+
+using autoware::common::types::PointXYZI;
+using autoware::perception::filters::polygon_remover::PolygonMask;
+using autoware::perception::filters::polygon_remover::PolygonRemover;
+using sensor_msgs::msg::PointCloud2;
+
+// Uniformly distributed points in a 40m x 40m square, half of them around the vehicle
+PointCloud2::SharedPtr create_point_cloud(const std::size_t size)
+{
+  std::mt19937 generator{42U};
+  std::uniform_real_distribution<float> distribution_far{-20.0F, 20.0F};
+  std::uniform_real_distribution<float> distribution_near{-5.0F, 5.0F};
+  auto cloud = std::make_shared<PointCloud2>();
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{*cloud, ""};
+  modifier.resize(static_cast<uint32_t>(size));
+  for (std::size_t i = 0U; i < size; ++i) {
+    auto & distribution = ((i % 2U) == 0U) ? distribution_far : distribution_near;
+    modifier[i].x = distribution(generator);
+    modifier[i].y = distribution(generator);
+  }
+  return cloud;
+}
+
+// Concave star shaped mask, roughly the size of a vehicle body
+std::vector<PolygonRemover::PointCgal> create_polygon()
+{
+  std::vector<PolygonRemover::PointCgal> polygon;
+  for (std::size_t i = 0U; i < kVertexCount; ++i) {
+    const auto angle = 6.283185307179586 * static_cast<double>(i) /
+      static_cast<double>(kVertexCount);
+    const auto radius = ((i % 2U) == 0U) ? 3.0 : 2.0;
+    polygon.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+  }
+  return polygon;
+}
+
+}  // namespace
+
+static void BenchPolygonRemoverExact(benchmark::State & state)
+{
+  const auto input = create_point_cloud(kCloudSize);
+  const auto polygon = create_polygon();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PolygonRemover::remove_polygon_cgal_from_cloud(input, polygon));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kCloudSize));
+}
+
+static void BenchPolygonRemoverMask(benchmark::State & state)
+{
+  const auto input = create_point_cloud(kCloudSize);
+  const PolygonMask polygon_mask{create_polygon()};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PolygonRemover::remove_polygon_mask_from_cloud(input, polygon_mask));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kCloudSize));
+}
+
+static void BenchPolygonMaskConstruction(benchmark::State & state)
+{
+  const auto polygon = create_polygon();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PolygonMask{polygon});
+  }
+}
+
+BENCHMARK(BenchPolygonRemoverExact)->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchPolygonRemoverMask)->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchPolygonMaskConstruction)->Unit(benchmark::kMillisecond);
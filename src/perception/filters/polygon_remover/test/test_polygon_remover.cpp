@@ -15,9 +15,11 @@
 #include <common/types.hpp>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
 #include <geometry_msgs/msg/polygon.hpp>
+#include <cmath>
 #include <random>
 #include <memory>
 #include "gtest/gtest.h"
+#include "polygon_remover/polygon_mask.hpp"
 #include "polygon_remover/polygon_remover.hpp"
 
 using PointXYZI = autoware::common::types::PointXYZI;
@@ -180,3 +182,84 @@ TEST(TestPolygonRemover, ShapeToPolylinePolygon) {
   CloudModifier cloud_modifier_filtered(*cloud_filtered_ptr);
   EXPECT_EQ(cloud_modifier_filtered.size(), count_points_outside_rect);
 }
+
+TEST(TestPolygonRemover, MaskMatchesExactTest) {
+  using PolygonRemover = autoware::perception::filters::polygon_remover::PolygonRemover;
+  using PolygonMask = autoware::perception::filters::polygon_remover::PolygonMask;
+
+  // Concave star, which has many boundary cells
+  Polygon::SharedPtr shape = std::make_shared<Polygon>();
+  const uint32_t count_vertices = 64;
+  for (uint32_t i = 0; i < count_vertices; ++i) {
+    const float32_t angle = 6.2831853F * static_cast<float32_t>(i) /
+      static_cast<float32_t>(count_vertices);
+    const float32_t radius = (i % 2 == 0) ? 5.0F : 2.0F;
+    shape->points.emplace_back(
+      make_point_geo(radius * std::cos(angle) + 1.0F, radius * std::sin(angle) - 0.5F, 0.0F));
+  }
+  const auto polygon_cgal = PolygonRemover::polygon_geometry_to_cgal(shape);
+
+  // Random points, and points on the edges and vertices of the polygon
+  auto cloud_input_ptr = generate_cloud_rect_counted(300, 300, -4.0F, 6.0F, -5.5F, 4.5F);
+  using CloudModifier = point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>;
+  CloudModifier cloud_modifier_input(*cloud_input_ptr);
+  for (uint32_t i = 0; i < count_vertices; ++i) {
+    const auto & a = shape->points[i];
+    const auto & b = shape->points[(i + 1) % count_vertices];
+    PointXYZI point_xyzi;
+    point_xyzi.x = a.x;
+    point_xyzi.y = a.y;
+    cloud_modifier_input.push_back(point_xyzi);
+    point_xyzi.x = 0.5F * (a.x + b.x);
+    point_xyzi.y = 0.5F * (a.y + b.y);
+    cloud_modifier_input.push_back(point_xyzi);
+  }
+
+  const auto cloud_exact_ptr =
+    PolygonRemover::remove_polygon_cgal_from_cloud(cloud_input_ptr, polygon_cgal);
+  CloudModifier cloud_modifier_exact(*cloud_exact_ptr);
+  for (const std::size_t max_cells_per_axis : {1UL, 7UL, PolygonMask::kDefaultMaxCellsPerAxis}) {
+    const PolygonMask polygon_mask{polygon_cgal, max_cells_per_axis};
+    EXPECT_GT(polygon_mask.get_num_boundary_cells(), 0UL);
+    const auto cloud_mask_ptr =
+      PolygonRemover::remove_polygon_mask_from_cloud(cloud_input_ptr, polygon_mask);
+    CloudModifier cloud_modifier_mask(*cloud_mask_ptr);
+    ASSERT_EQ(cloud_modifier_mask.size(), cloud_modifier_exact.size());
+    for (std::size_t i = 0; i < cloud_modifier_exact.size(); ++i) {
+      EXPECT_EQ(cloud_modifier_mask[i].x, cloud_modifier_exact[i].x);
+      EXPECT_EQ(cloud_modifier_mask[i].y, cloud_modifier_exact[i].y);
+    }
+  }
+
+  // The stored polygon uses the mask as well
+  PolygonRemover polygon_remover(false);
+  polygon_remover.update_polygon(shape);
+  const auto cloud_updated_ptr = polygon_remover.remove_updated_polygon_from_cloud(cloud_input_ptr);
+  CloudModifier cloud_modifier_updated(*cloud_updated_ptr);
+  EXPECT_EQ(cloud_modifier_updated.size(), cloud_modifier_exact.size());
+}
+
+TEST(TestPolygonRemover, MaskDegenerate) {
+  using PolygonMask = autoware::perception::filters::polygon_remover::PolygonMask;
+  using PointCgal = PolygonMask::PointCgal;
+
+  // Nothing is masked by default
+  const PolygonMask mask_empty{};
+  EXPECT_TRUE(mask_empty.is_outside(0.0F, 0.0F));
+
+  EXPECT_THROW(PolygonMask({PointCgal(0.0, 0.0), PointCgal(1.0, 0.0)}), std::length_error);
+  EXPECT_THROW(
+    PolygonMask({PointCgal(0.0, 0.0), PointCgal(1.0, 0.0), PointCgal(0.0, 1.0)}, 0U),
+    std::domain_error);
+
+  // All vertices coincide
+  const PolygonMask mask_point{{PointCgal(1.0, 1.0), PointCgal(1.0, 1.0), PointCgal(1.0, 1.0)}};
+  EXPECT_FALSE(mask_point.is_outside(1.0F, 1.0F));
+  EXPECT_TRUE(mask_point.is_outside(1.0F, 2.0F));
+
+  // All vertices on a line
+  const PolygonMask mask_line{{PointCgal(0.0, 0.0), PointCgal(1.0, 0.0), PointCgal(2.0, 0.0)}};
+  EXPECT_EQ(mask_line.get_num_cells_y(), 1UL);
+  EXPECT_FALSE(mask_line.is_outside(0.5F, 0.0F));
+  EXPECT_TRUE(mask_line.is_outside(0.5F, 0.1F));
+}
@@ -16,9 +16,11 @@
 #include <polygon_remover/polygon_remover.hpp>
 #include <geometry_msgs/msg/polygon.hpp>
 #include <visualization_msgs/msg/marker.hpp>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <map>
+#include <utility>
 #include <vector>
 
 namespace autoware
@@ -130,10 +132,18 @@ void PolygonRemoverNode::callback_cloud(const PointCloud2::ConstSharedPtr cloud_
     return;
   }
 
+  const auto start = std::chrono::steady_clock::now();
   PointCloud2::SharedPtr cloud_filtered_ptr =
     polygon_remover_->remove_updated_polygon_from_cloud(cloud_in_ptr);
-
-  pub_cloud_ptr_->publish(*cloud_filtered_ptr);
+  RCLCPP_DEBUG_STREAM(
+    get_logger(),
+    "Removed polygon from cloud with " << cloud_in_ptr->width * cloud_in_ptr->height <<
+      " points in " <<
+      std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count() << " us.");
+
+  // The filtered cloud is owned by this callback, so move it out instead of copying it on publish
+  pub_cloud_ptr_->publish(std::make_unique<PointCloud2>(std::move(*cloud_filtered_ptr)));
 
   if (will_visualize_) {
     pub_marker_ptr_->publish(polygon_remover_->get_marker());
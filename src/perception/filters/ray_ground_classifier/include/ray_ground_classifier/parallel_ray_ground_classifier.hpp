@@ -0,0 +1,106 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+/// \file
+/// \brief This file defines a multi-threaded wrapper around the ray ground filter algorithm
+
+#ifndef RAY_GROUND_CLASSIFIER__PARALLEL_RAY_GROUND_CLASSIFIER_HPP_
+#define RAY_GROUND_CLASSIFIER__PARALLEL_RAY_GROUND_CLASSIFIER_HPP_
+
+#include <common/types.hpp>
+#include <helper_functions/worker_pool.hpp>
+#include <ray_ground_classifier/ray_ground_classifier.hpp>
+
+#include <vector>
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace ray_ground_classifier
+{
+
+/// \brief Partitions a batch of rays into ground and nonground points using a fixed pool of
+///        worker threads. Each worker owns a RayGroundClassifier, and thus its own
+///        RayGroundPointClassifier state. Every ray is written to a precomputed offset of an
+///        internal buffer, so the output is identical to, and in the same order as, partitioning
+///        the rays one after another with a single RayGroundClassifier. The rays are handed out
+///        by a WorkerPool, whose worker index selects the state used.
+class RAY_GROUND_CLASSIFIER_PUBLIC ParallelRayGroundClassifier
+{
+public:
+  /// \brief Constructor, starts the worker threads
+  /// \param[in] cfg Ray ground filter configuration parameters
+  /// \param[in] num_workers Number of workers, including the calling thread. A value of 1 means
+  ///                        no additional threads are started
+  /// \throw std::domain_error If num_workers is 0
+  ParallelRayGroundClassifier(const Config & cfg, const std::size_t num_workers);
+  ParallelRayGroundClassifier(const ParallelRayGroundClassifier &) = delete;
+  ParallelRayGroundClassifier & operator=(const ParallelRayGroundClassifier &) = delete;
+
+  /// \brief Partitions a batch of rays into ground and nonground points. Blocks until all rays
+  ///        are classified; the calling thread also works on the batch. Not thread safe.
+  /// \param[in] rays The rays to partition, each sorted as for RayGroundClassifier::partition,
+  ///                 e.g. as returned by RayAggregator::get_next_ray()
+  /// \param[out] ground_block Gets filled with the ground points of all rays, in ray order. The
+  ///                          size parameter is overwritten
+  /// \param[out] nonground_block Gets filled with the nonground points of all rays, in ray order.
+  ///                             The size parameter is overwritten
+  /// \throw std::runtime_error If a ray cannot be partitioned, or any other exception thrown by a
+  ///                           worker
+  void partition(
+    const std::vector<const Ray *> & rays,
+    PointPtrBlock & ground_block,
+    PointPtrBlock & nonground_block);
+
+  /// \brief Get the number of workers, including the calling thread
+  /// \return Value
+  std::size_t get_num_workers() const;
+
+private:
+  /// \brief State owned by a single worker
+  struct Worker
+  {
+    explicit Worker(const Config & cfg);
+    RayGroundClassifier classifier;
+    PointPtrBlock ground_block;
+    PointPtrBlock nonground_block;
+  };  // struct Worker
+
+  /// \brief Partitions a single ray of the current batch into its slot of the internal buffer
+  /// \param[in] ray The ray
+  /// \param[in] ray_idx The index of the ray in the batch
+  /// \param[inout] worker The state of the calling worker
+  RAY_GROUND_CLASSIFIER_LOCAL void process(
+    const Ray & ray, const std::size_t ray_idx, Worker & worker);
+
+  std::vector<Worker> m_workers;
+  // Declared after the worker states, so that its threads are joined first
+  common::helper_functions::WorkerPool m_pool;
+
+  // State of the current batch
+  std::vector<std::size_t> m_offsets;
+  std::vector<std::size_t> m_ground_counts;
+  PointPtrBlock m_labeled_points;
+};  // class ParallelRayGroundClassifier
+}  // namespace ray_ground_classifier
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // RAY_GROUND_CLASSIFIER__PARALLEL_RAY_GROUND_CLASSIFIER_HPP_
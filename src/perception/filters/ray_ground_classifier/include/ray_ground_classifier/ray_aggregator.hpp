@@ -64,6 +64,24 @@ public:
       const float32_t max_ray_angle_rad,
       const float32_t ray_width_rad,
       const std::size_t min_ray_points);
+    /// \brief Constructor for the binned mode: rays are sorted by a counting sort over quantized
+    ///        ranges rather than by a comparison sort
+    /// \param[in] min_ray_angle_rad Minimum ray angle
+    /// \param[in] max_ray_angle_rad Maximum ray angle
+    /// \param[in] ray_width_rad Width of ray, defines number of rays
+    /// \param[in] min_ray_points Number of points needed in a ray before it's ready for
+    ///                           partitioning
+    /// \param[in] range_bin_width_m Width of a range bin. 0 disables the binned mode
+    /// \param[in] max_range_m Range covered by the range bins, points beyond it share the last bin
+    /// \throw std::runtime_error If the range bin width is negative, or if binned mode is enabled
+    ///                           and max_range_m is not larger than range_bin_width_m
+    Config(
+      const float32_t min_ray_angle_rad,
+      const float32_t max_ray_angle_rad,
+      const float32_t ray_width_rad,
+      const std::size_t min_ray_points,
+      const float32_t range_bin_width_m,
+      const float32_t max_range_m);
 
     /// \brief Get number of rays
     /// \return Value
@@ -81,6 +99,12 @@ public:
     ///        max_ray_angle = -300
     /// \return Value
     bool8_t domain_crosses_180() const;
+    /// \brief Get number of range bins used to sort a ray, 0 if binned mode is disabled
+    /// \return Value
+    std::size_t get_num_range_bins() const;
+    /// \brief Get width of a range bin
+    /// \return Value
+    float32_t get_range_bin_width() const;
 
 private:
     const std::size_t m_min_ray_points;
@@ -88,6 +112,8 @@ private:
     const float32_t m_ray_width_rad;
     const float32_t m_min_angle_rad;
     const bool8_t m_domain_crosses_180;
+    const float32_t m_range_bin_width_m;
+    std::size_t m_num_range_bins;
   };  // class Config
 
   /// \brief Constructor
@@ -177,8 +203,16 @@ private:
 
   /// \brief Compute which bin a point belongs to
   inline std::size_t RAY_GROUND_CLASSIFIER_LOCAL bin(const PointXYZIFR & pt) const;
+  /// \brief Compute which range bin a point belongs to, only used in binned mode
+  inline std::size_t RAY_GROUND_CLASSIFIER_LOCAL range_bin(const PointXYZIFR & pt) const;
+  /// \brief Sort a ray by radius, then height. In binned mode, this is a counting sort over range
+  ///        bins followed by an insertion sort, which is linear for the almost sorted bins
+  RAY_GROUND_CLASSIFIER_LOCAL void sort_ray(Ray & ray);
   const Config m_cfg;
   std::vector<Ray> m_rays;
+  // preallocated buffers for the binned mode
+  Ray m_sort_buffer;
+  std::vector<std::size_t> m_range_bin_offsets;
   // simple index ring buffer
   std::vector<std::size_t> m_ready_indices;
   std::size_t m_ready_start_idx;
@@ -0,0 +1,108 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <algorithm>
+#include <vector>
+
+#include "common/types.hpp"
+#include "ray_ground_classifier/parallel_ray_ground_classifier.hpp"
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace ray_ground_classifier
+{
+
+////////////////////////////////////////////////////////////////////////////////
+ParallelRayGroundClassifier::Worker::Worker(const Config & cfg)
+: classifier(cfg)
+{
+  ground_block.reserve(autoware::common::types::POINT_BLOCK_CAPACITY);
+  nonground_block.reserve(autoware::common::types::POINT_BLOCK_CAPACITY);
+}
+////////////////////////////////////////////////////////////////////////////////
+ParallelRayGroundClassifier::ParallelRayGroundClassifier(
+  const Config & cfg,
+  const std::size_t num_workers)
+: m_pool(num_workers)
+{
+  m_workers.reserve(num_workers);
+  for (std::size_t idx = 0U; idx < num_workers; ++idx) {
+    m_workers.emplace_back(cfg);
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void ParallelRayGroundClassifier::partition(
+  const std::vector<const Ray *> & rays,
+  PointPtrBlock & ground_block,
+  PointPtrBlock & nonground_block)
+{
+  // Precompute where each ray goes; allocation only happens if the batch is larger than any before
+  m_offsets.resize(rays.size());
+  m_ground_counts.resize(rays.size());
+  std::size_t num_points = 0U;
+  for (std::size_t idx = 0U; idx < rays.size(); ++idx) {
+    m_offsets[idx] = num_points;
+    num_points += rays[idx]->size();
+  }
+  m_labeled_points.resize(num_points);
+  // Rays are claimed dynamically since their sizes vary a lot
+  m_pool.run(
+    rays.size(), [this, &rays](const std::size_t ray_idx, const std::size_t worker) {
+      process(*rays[ray_idx], ray_idx, m_workers[worker]);
+    });
+  // Gather: ground points of each ray are stored first, followed by its nonground points
+  std::size_t num_ground = 0U;
+  for (const std::size_t count : m_ground_counts) {
+    num_ground += count;
+  }
+  ground_block.resize(num_ground);
+  nonground_block.resize(num_points - num_ground);
+  auto ground_it = ground_block.begin();
+  auto nonground_it = nonground_block.begin();
+  for (std::size_t idx = 0U; idx < rays.size(); ++idx) {
+    const auto begin = m_labeled_points.begin() + static_cast<std::ptrdiff_t>(m_offsets[idx]);
+    const auto mid = begin + static_cast<std::ptrdiff_t>(m_ground_counts[idx]);
+    const auto end = begin + static_cast<std::ptrdiff_t>(rays[idx]->size());
+    ground_it = std::copy(begin, mid, ground_it);
+    nonground_it = std::copy(mid, end, nonground_it);
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t ParallelRayGroundClassifier::get_num_workers() const
+{
+  return m_pool.get_num_workers();
+}
+////////////////////////////////////////////////////////////////////////////////
+void ParallelRayGroundClassifier::process(
+  const Ray & ray, const std::size_t ray_idx, Worker & worker)
+{
+  worker.ground_block.clear();
+  worker.nonground_block.clear();
+  worker.classifier.partition(ray, worker.ground_block, worker.nonground_block);
+  const auto begin = m_labeled_points.begin() + static_cast<std::ptrdiff_t>(m_offsets[ray_idx]);
+  const auto mid = std::copy(worker.ground_block.begin(), worker.ground_block.end(), begin);
+  (void)std::copy(worker.nonground_block.begin(), worker.nonground_block.end(), mid);
+  m_ground_counts[ray_idx] = worker.ground_block.size();
+}
+
+}  // namespace ray_ground_classifier
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
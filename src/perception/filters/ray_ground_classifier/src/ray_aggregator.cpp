@@ -45,11 +45,24 @@ RayAggregator::Config::Config(
   const float32_t max_ray_angle_rad,
   const float32_t ray_width_rad,
   const std::size_t min_ray_points)
+: Config(min_ray_angle_rad, max_ray_angle_rad, ray_width_rad, min_ray_points, 0.0F, 0.0F)
+{
+}
+////////////////////////////////////////////////////////////////////////////////
+RayAggregator::Config::Config(
+  const float32_t min_ray_angle_rad,
+  const float32_t max_ray_angle_rad,
+  const float32_t ray_width_rad,
+  const std::size_t min_ray_points,
+  const float32_t range_bin_width_m,
+  const float32_t max_range_m)
 : m_min_ray_points(min_ray_points),
   m_num_rays(),
   m_ray_width_rad(ray_width_rad),
   m_min_angle_rad(min_ray_angle_rad),
-  m_domain_crosses_180(max_ray_angle_rad < min_ray_angle_rad)
+  m_domain_crosses_180(max_ray_angle_rad < min_ray_angle_rad),
+  m_range_bin_width_m(range_bin_width_m),
+  m_num_range_bins(0U)
 {
   if (m_domain_crosses_180) {
     const float32_t angle_range = (PI - min_ray_angle_rad) +
@@ -65,6 +78,15 @@ RayAggregator::Config::Config(
   if (min_ray_points > static_cast<std::size_t>(POINT_BLOCK_CAPACITY)) {
     throw std::runtime_error("Min ray points larger than point block capacity, consider reducing");
   }
+  if (range_bin_width_m < 0.0F) {
+    throw std::runtime_error("Range bin width negative");
+  }
+  if (range_bin_width_m > 0.0F) {
+    if (max_range_m <= range_bin_width_m) {
+      throw std::runtime_error("Max range must be larger than range bin width in binned mode");
+    }
+    m_num_range_bins = static_cast<std::size_t>(std::ceil(max_range_m / range_bin_width_m));
+  }
   // TODO(c.ho) upper limit on number of rays?
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -93,6 +115,16 @@ bool8_t RayAggregator::Config::domain_crosses_180() const
   return m_domain_crosses_180;
 }
 ////////////////////////////////////////////////////////////////////////////////
+std::size_t RayAggregator::Config::get_num_range_bins() const
+{
+  return m_num_range_bins;
+}
+////////////////////////////////////////////////////////////////////////////////
+float32_t RayAggregator::Config::get_range_bin_width() const
+{
+  return m_range_bin_width_m;
+}
+////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 RayAggregator::RayAggregator(const Config & cfg)
 : m_cfg(cfg),
@@ -111,6 +143,11 @@ RayAggregator::RayAggregator(const Config & cfg)
     m_ray_state.push_back(RayState::NOT_READY);
   }
   m_ready_indices.resize(m_ready_indices.capacity());
+  if (m_cfg.get_num_range_bins() > 0U) {
+    // the sort buffer is swapped with the sorted ray, so it needs the same capacity
+    m_sort_buffer.reserve(ray_size);
+    m_range_bin_offsets.resize(m_cfg.get_num_range_bins() + 1U);
+  }
 }
 ////////////////////////////////////////////////////////////////////////////////
 void RayAggregator::end_of_scan()
@@ -207,7 +244,7 @@ const Ray & RayAggregator::get_next_ray()
 
   Ray & ret = m_rays[idx];
   // Sort ray
-  std::sort(ret.begin(), ret.end());
+  sort_ray(ret);
   // ready to be reset on next insertion to this item
   m_ray_state[idx] = RayState::RESET;
 
@@ -245,6 +282,54 @@ std::size_t RayAggregator::bin(const PointXYZIFR & pt) const
   // Avoid underflow
   return std::max(0, static_cast<int32_t>(idx));
 }
+////////////////////////////////////////////////////////////////////////////////
+std::size_t RayAggregator::range_bin(const PointXYZIFR & pt) const
+{
+  const std::size_t idx = static_cast<std::size_t>(pt.get_r() / m_cfg.get_range_bin_width());
+  return std::min(idx, m_cfg.get_num_range_bins() - 1U);
+}
+////////////////////////////////////////////////////////////////////////////////
+void RayAggregator::sort_ray(Ray & ray)
+{
+  if ((0U == m_cfg.get_num_range_bins()) || (ray.size() < 2U)) {
+    std::sort(ray.begin(), ray.end());
+    return;
+  }
+  // Only clear and scan the range bins this ray actually spans
+  std::size_t min_bin = std::numeric_limits<std::size_t>::max();
+  std::size_t max_bin = 0U;
+  for (const PointXYZIFR & pt : ray) {
+    const std::size_t bin_idx = range_bin(pt);
+    min_bin = std::min(min_bin, bin_idx);
+    max_bin = std::max(max_bin, bin_idx);
+  }
+  const std::size_t num_bins = (max_bin - min_bin) + 1U;
+  // Counting sort: histogram, shifted by one so that the prefix sum yields the bin offsets
+  std::fill(m_range_bin_offsets.begin(), m_range_bin_offsets.begin() + num_bins + 1U, 0U);
+  for (const PointXYZIFR & pt : ray) {
+    ++m_range_bin_offsets[(range_bin(pt) - min_bin) + 1U];
+  }
+  for (std::size_t idx = 1U; idx < num_bins; ++idx) {
+    m_range_bin_offsets[idx] += m_range_bin_offsets[idx - 1U];
+  }
+  m_sort_buffer.resize(ray.size());  // capacity unchanged
+  for (const PointXYZIFR & pt : ray) {
+    m_sort_buffer[m_range_bin_offsets[range_bin(pt) - min_bin]++] = pt;
+  }
+  // Points are now ordered by bin, but still in insertion order within a bin. An insertion sort
+  // fixes this up and is close to linear for such almost sorted input
+  for (std::size_t idx = 1U; idx < m_sort_buffer.size(); ++idx) {
+    const PointXYZIFR pt = m_sort_buffer[idx];
+    std::size_t jdx = idx;
+    while ((jdx > 0U) && (pt < m_sort_buffer[jdx - 1U])) {
+      m_sort_buffer[jdx] = m_sort_buffer[jdx - 1U];
+      --jdx;
+    }
+    m_sort_buffer[jdx] = pt;
+  }
+  // Both have the same capacity, so no memory is allocated or freed
+  ray.swap(m_sort_buffer);
+}
 }  // namespace ray_ground_classifier
 }  // namespace filters
 }  // namespace perception
@@ -15,9 +15,13 @@
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
 #include <gtest/gtest.h>
+#include <autoware_testing/allocation_counter.hpp>
 #include <ray_ground_classifier/ray_aggregator.hpp>
 #include <ray_ground_classifier/ray_ground_point_classifier.hpp>
 #include <common/types.hpp>
+#include <array>
+#include <chrono>
+#include <random>
 #include <vector>
 
 using autoware::common::types::PointXYZIF;
@@ -26,6 +30,7 @@ using autoware::perception::filters::ray_ground_classifier::PointPtrBlock;
 using autoware::perception::filters::ray_ground_classifier::PointXYZIFR;
 using autoware::perception::filters::ray_ground_classifier::Ray;
 using autoware::perception::filters::ray_ground_classifier::RayAggregator;
+using autoware::tools::autoware_testing::AllocationCounter;
 
 void check_ray(const Ray & ray, const float32_t th)
 {
@@ -235,6 +240,14 @@ TEST(RayAggregator, BadCases)
   EXPECT_THROW(
     RayAggregator::Config cfg({-3.14159F, 3.14159F, 0.1F, capacity + 1U}),
     std::runtime_error);
+  // negative range bin width
+  EXPECT_THROW(
+    RayAggregator::Config cfg({-3.14159F, 3.14159F, 0.1F, 10U, -0.1F, 100.0F}),
+    std::runtime_error);
+  // range bins do not cover anything
+  EXPECT_THROW(
+    RayAggregator::Config cfg({-3.14159F, 3.14159F, 0.1F, 10U, 0.1F, 0.1F}),
+    std::runtime_error);
   // insert past capacity
   RayAggregator::Config cfg{-3.14159F, 3.14159F, 0.2F, 10U};
   RayAggregator agg{cfg};
@@ -332,3 +345,76 @@ TEST(RayAggregator, ResetBug) {
     check_one_ray_fn(pts);
   }
 }
+
+// Binned mode should produce the same rays as the default mode, without allocating memory
+TEST(RayAggregator, Binned)
+{
+  const uint32_t capacity =
+    static_cast<uint32_t>(autoware::common::types::POINT_BLOCK_CAPACITY);
+  const RayAggregator::Config cfg{-3.14159F, 3.14159F, 0.01F, capacity};
+  const RayAggregator::Config binned_cfg{-3.14159F, 3.14159F, 0.01F, capacity, 0.1F, 100.0F};
+  EXPECT_EQ(cfg.get_num_range_bins(), 0U);
+  EXPECT_EQ(binned_cfg.get_num_range_bins(), 1000U);
+  EXPECT_FLOAT_EQ(binned_cfg.get_range_bin_width(), 0.1F);
+  RayAggregator agg{cfg};
+  RayAggregator binned_agg{binned_cfg};
+  // Random scan, some points are beyond the range covered by the bins
+  std::mt19937 gen(1340U);
+  std::uniform_real_distribution<float32_t> th_samp{-3.14F, 3.14F};
+  std::uniform_real_distribution<float32_t> r_samp{0.5F, 120.0F};
+  std::normal_distribution<float32_t> z_samp{0.0F, 0.5F};
+  constexpr uint32_t num_points = 30000U;
+  std::vector<PointXYZIF> all_points(num_points);
+  for (PointXYZIF & pt : all_points) {
+    const float32_t th = th_samp(gen);
+    const float32_t r = r_samp(gen);
+    pt.x = r * cosf(th);
+    pt.y = r * sinf(th);
+    pt.z = z_samp(gen);
+  }
+  std::vector<const Ray *> rays, binned_rays;
+  rays.reserve(cfg.get_num_rays());
+  binned_rays.reserve(cfg.get_num_rays());
+  const auto run_scan = [&all_points](RayAggregator & aggregator, std::vector<const Ray *> & out) {
+      out.clear();
+      for (const PointXYZIF & pt : all_points) {
+        (void)aggregator.insert(&pt);
+      }
+      aggregator.end_of_scan();
+      while (aggregator.is_ray_ready()) {
+        out.push_back(&aggregator.get_next_ray());
+      }
+    };
+  // Same scan a few times to exercise reset logic and reach steady state
+  for (uint32_t iter = 0U; iter < 3U; ++iter) {
+    AllocationCounter allocations;
+    const auto start = std::chrono::steady_clock::now();
+    run_scan(agg, rays);
+    const auto sort_diff = std::chrono::steady_clock::now() - start;
+    const std::size_t sort_allocs = allocations.num_allocations();
+    allocations.reset();
+    const auto binned_start = std::chrono::steady_clock::now();
+    run_scan(binned_agg, binned_rays);
+    const auto binned_diff = std::chrono::steady_clock::now() - binned_start;
+    const std::size_t binned_allocs = allocations.num_allocations();
+    std::cout << "Scan " << iter << ": std::sort " <<
+      std::chrono::duration_cast<std::chrono::microseconds>(sort_diff).count() << "us, " <<
+      sort_allocs << " allocations; binned " <<
+      std::chrono::duration_cast<std::chrono::microseconds>(binned_diff).count() << "us, " <<
+      binned_allocs << " allocations\n";
+    EXPECT_EQ(sort_allocs, 0U);
+    EXPECT_EQ(binned_allocs, 0U);
+    ASSERT_EQ(rays.size(), binned_rays.size());
+    std::size_t total_points = 0U;
+    for (std::size_t idx = 0U; idx < rays.size(); ++idx) {
+      const Ray & ray = *rays[idx];
+      const Ray & binned_ray = *binned_rays[idx];
+      ASSERT_EQ(ray.size(), binned_ray.size());
+      for (std::size_t jdx = 0U; jdx < ray.size(); ++jdx) {
+        EXPECT_EQ(ray[jdx].get_point_pointer(), binned_ray[jdx].get_point_pointer());
+      }
+      total_points += ray.size();
+    }
+    EXPECT_EQ(total_points, num_points);
+  }
+}
@@ -23,7 +23,10 @@
 #include <tuple>
 #include <vector>
 
+#include "autoware_testing/allocation_counter.hpp"
+#include "autoware_testing/latency_recorder.hpp"
 #include "gtest/gtest.h"
+#include "ray_ground_classifier/parallel_ray_ground_classifier.hpp"
 #include "ray_ground_classifier/ray_ground_point_classifier.hpp"
 #include "test_ray_ground_classifier_aux.hpp"
 
@@ -809,3 +812,131 @@ TEST_F(RayGroundClassifier, Benchmark)
   fn(256U);
   fn(512U);
 }
+
+/////
+// The parallel classifier should give exactly the same result as classifying the rays one by one
+TEST_F(RayGroundClassifier, ParallelPartition)
+{
+  using autoware::perception::filters::ray_ground_classifier::ParallelRayGroundClassifier;
+  using autoware::perception::filters::ray_ground_classifier::PointXYZIFR;
+  using autoware::perception::filters::ray_ground_classifier::Ray;
+  EXPECT_THROW(ParallelRayGroundClassifier(cfg, 0U), std::domain_error);
+  // Generate a scan of rays with varying sizes and rough ground with some clutter
+  std::mt19937 gen(1339U);
+  std::uniform_int_distribution<uint32_t> size_samp{1U, 256U};
+  std::uniform_real_distribution<float32_t> dr_samp{0.05F, 1.0F};
+  std::normal_distribution<float32_t> dh_samp{0.0F, 0.15F};
+  std::uniform_real_distribution<float32_t> clutter_samp{0.0F, 1.0F};
+  constexpr uint32_t num_rays = 1024U;
+  std::vector<std::vector<PointXYZIF>> all_points(num_rays);
+  std::vector<Ray> rays(num_rays);
+  std::vector<const Ray *> ray_ptrs;
+  for (uint32_t ray_idx = 0U; ray_idx < num_rays; ++ray_idx) {
+    const uint32_t ray_size = size_samp(gen);
+    auto & points = all_points[ray_idx];
+    points.resize(ray_size);
+    float32_t r = 1.0F;
+    for (PointXYZIF & pt : points) {
+      r += dr_samp(gen);
+      pt.x = r;
+      pt.y = 0.0F;
+      pt.z = cfg.m_ground_z_m + dh_samp(gen) + ((clutter_samp(gen) < 0.1F) ? 1.0F : 0.0F);
+      pt.id = static_cast<uint16_t>(ray_idx);
+      rays[ray_idx].emplace_back(&pt);
+    }
+    std::sort(rays[ray_idx].begin(), rays[ray_idx].end());
+    ray_ptrs.push_back(&rays[ray_idx]);
+  }
+  // Serial reference
+  autoware::perception::filters::ray_ground_classifier::RayGroundClassifier cls{cfg};
+  PointPtrBlock ground_block, nonground_block;
+  PointPtrBlock ground_points, nonground_points;
+  const auto serial_start = std::chrono::steady_clock::now();
+  for (const Ray * const ray : ray_ptrs) {
+    ground_block.clear();
+    nonground_block.clear();
+    cls.partition(*ray, ground_block, nonground_block);
+    ground_points.insert(ground_points.end(), ground_block.begin(), ground_block.end());
+    nonground_points.insert(nonground_points.end(), nonground_block.begin(), nonground_block.end());
+  }
+  const auto serial_diff = std::chrono::steady_clock::now() - serial_start;
+  std::cout << "Serial,\truntime = " <<
+    std::chrono::duration_cast<std::chrono::microseconds>(serial_diff).count() << "us\n";
+  ASSERT_FALSE(ground_points.empty());
+  ASSERT_FALSE(nonground_points.empty());
+  for (const std::size_t num_workers : {1U, 2U, 4U}) {
+    ParallelRayGroundClassifier parallel_cls{cfg, num_workers};
+    EXPECT_EQ(parallel_cls.get_num_workers(), num_workers);
+    // initialize weird numbers
+    PointPtrBlock parallel_ground(3U), parallel_nonground(5U);
+    // Run a few batches to make sure the workers are correctly restarted
+    for (uint32_t iter = 0U; iter < 3U; ++iter) {
+      const auto start = std::chrono::steady_clock::now();
+      parallel_cls.partition(ray_ptrs, parallel_ground, parallel_nonground);
+      const auto diff = std::chrono::steady_clock::now() - start;
+      std::cout << num_workers << " workers,\truntime = " <<
+        std::chrono::duration_cast<std::chrono::microseconds>(diff).count() << "us\n";
+      EXPECT_EQ(parallel_ground, ground_points);
+      EXPECT_EQ(parallel_nonground, nonground_points);
+    }
+    // Errors in any worker are forwarded to the caller
+    Ray too_large(static_cast<std::size_t>(POINT_BLOCK_CAPACITY) + 1U, rays[0U][0U]);
+    std::vector<const Ray *> bad_rays{ray_ptrs};
+    bad_rays[num_rays / 2U] = &too_large;
+    EXPECT_THROW(
+      parallel_cls.partition(bad_rays, parallel_ground, parallel_nonground),
+      std::runtime_error);
+    // Still usable afterwards
+    parallel_cls.partition(ray_ptrs, parallel_ground, parallel_nonground);
+    EXPECT_EQ(parallel_ground, ground_points);
+    EXPECT_EQ(parallel_nonground, nonground_points);
+  }
+}
+
+// The steady state of the classification must not allocate, since it runs on every scan
+TEST_F(RayGroundClassifier, PartitionDoesNotAllocate)
+{
+  using autoware::perception::filters::ray_ground_classifier::Ray;
+  using autoware::tools::autoware_testing::AllocationCounter;
+  using autoware::tools::autoware_testing::LatencyRecorder;
+  // Rough ground with some clutter
+  std::mt19937 gen(1341U);
+  std::uniform_real_distribution<float32_t> dr_samp{0.05F, 1.0F};
+  std::normal_distribution<float32_t> dh_samp{0.0F, 0.15F};
+  std::uniform_real_distribution<float32_t> clutter_samp{0.0F, 1.0F};
+  std::vector<PointXYZIF> points(256U);
+  Ray ray;
+  float32_t r = 1.0F;
+  for (PointXYZIF & pt : points) {
+    r += dr_samp(gen);
+    pt.x = r;
+    pt.y = 0.0F;
+    pt.z = cfg.m_ground_z_m + dh_samp(gen) + ((clutter_samp(gen) < 0.1F) ? 1.0F : 0.0F);
+    ray.emplace_back(&pt);
+  }
+  std::sort(ray.begin(), ray.end());
+  autoware::perception::filters::ray_ground_classifier::RayGroundClassifier cls{cfg};
+  PointPtrBlock ground_block, nonground_block;
+  ground_block.reserve(POINT_BLOCK_CAPACITY);
+  nonground_block.reserve(POINT_BLOCK_CAPACITY);
+  const auto classify = [&cls, &ray, &ground_block, &nonground_block] {
+      ground_block.clear();
+      nonground_block.clear();
+      cls.partition(ray, ground_block, nonground_block);
+    };
+  // Warm up
+  classify();
+  ASSERT_EQ(ground_block.size() + nonground_block.size(), points.size());
+
+  constexpr std::size_t num_runs = 100U;
+  LatencyRecorder latencies;
+  latencies.reserve(num_runs);
+  const AllocationCounter allocations;
+  for (std::size_t run = 0U; run < num_runs; ++run) {
+    latencies.measure(classify);
+  }
+  EXPECT_EQ(allocations.num_allocations(), 0U);
+  std::cout << "partition p99 = " <<
+    std::chrono::duration_cast<std::chrono::microseconds>(latencies.percentile(0.99)).count() <<
+    "us\n";
+}
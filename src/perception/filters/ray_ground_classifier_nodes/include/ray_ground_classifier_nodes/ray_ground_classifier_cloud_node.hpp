@@ -23,10 +23,12 @@
 #include <common/types.hpp>
 #include <lidar_utils/point_cloud_utils.hpp>
 #include <ray_ground_classifier_nodes/visibility_control.hpp>
+#include <ray_ground_classifier/parallel_ray_ground_classifier.hpp>
 #include <ray_ground_classifier/ray_aggregator.hpp>
 #include <ray_ground_classifier/ray_ground_classifier.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <time_utils/trace.hpp>
 
 #include <memory>
 #include <string>
@@ -61,8 +63,15 @@ private:
   /// \brief Resets state of ray aggregator and messages
   RAY_GROUND_CLASSIFIER_NODES_LOCAL void reset();
   // Algorithmic core
+  const ray_ground_classifier::Config m_classifier_cfg;
   ray_ground_classifier::RayGroundClassifier m_classifier;
   ray_ground_classifier::RayAggregator m_aggregator;
+  // Only used if more than one worker thread is configured: all ready rays are partitioned
+  // as one batch
+  std::unique_ptr<ray_ground_classifier::ParallelRayGroundClassifier> m_parallel_classifier;
+  std::vector<const ray_ground_classifier::Ray *> m_ready_rays;
+  ray_ground_classifier::PointPtrBlock m_ground_blk;
+  ray_ground_classifier::PointPtrBlock m_nonground_blk;
   // preallocated message
   PointCloud2 m_ground_msg;
   PointCloud2 m_nonground_msg;
@@ -75,6 +84,9 @@ private:
   const rclcpp::Subscription<PointCloud2>::SharedPtr m_raw_sub_ptr;
   const std::shared_ptr<rclcpp::Publisher<PointCloud2>> m_ground_pub_ptr;
   const std::shared_ptr<rclcpp::Publisher<PointCloud2>> m_nonground_pub_ptr;
+  // records when each cloud enters and leaves the callback, if tracing is switched on
+  const common::time_utils::TracePoint m_trace;
+
   /// \brief Read samples from the subscription
   void callback(const PointCloud2::SharedPtr msg);
 };  // class RayGroundFilterDriverNode
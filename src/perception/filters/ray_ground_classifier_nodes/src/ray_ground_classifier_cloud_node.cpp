@@ -44,7 +44,7 @@ using autoware::common::lidar_utils::has_intensity_and_throw_if_no_xyz;
 RayGroundClassifierCloudNode::RayGroundClassifierCloudNode(
   const rclcpp::NodeOptions & node_options)
 : Node("ray_ground_classifier", node_options),
-  m_classifier(ray_ground_classifier::Config{
+  m_classifier_cfg(ray_ground_classifier::Config{
           static_cast<float32_t>(declare_parameter("classifier.sensor_height_m").get<float32_t>()),
           static_cast<float32_t>(declare_parameter(
             "classifier.max_local_slope_deg").get<float32_t>()),
@@ -61,6 +61,7 @@ RayGroundClassifierCloudNode::RayGroundClassifierCloudNode(
           static_cast<float32_t>(declare_parameter(
             "classifier.max_provisional_ground_distance_m").get<float32_t>())
         }),
+  m_classifier(m_classifier_cfg),
   m_aggregator(ray_ground_classifier::RayAggregator::Config{
           static_cast<float32_t>(declare_parameter(
             "aggregator.min_ray_angle_rad").get<float32_t>()),
@@ -68,7 +69,9 @@ RayGroundClassifierCloudNode::RayGroundClassifierCloudNode(
             "aggregator.max_ray_angle_rad").get<float32_t>()),
           static_cast<float32_t>(declare_parameter("aggregator.ray_width_rad").get<float32_t>()),
           static_cast<std::size_t>(
-            declare_parameter("aggregator.max_ray_points").get<std::size_t>())
+            declare_parameter("aggregator.max_ray_points").get<std::size_t>()),
+          static_cast<float32_t>(declare_parameter("aggregator.range_bin_width_m", 0.0)),
+          static_cast<float32_t>(declare_parameter("aggregator.max_range_m", 0.0))
         }),
   m_pcl_size(static_cast<uint32_t>(declare_parameter("pcl_size").get<uint32_t>())),
   m_frame_id(declare_parameter("frame_id").get<std::string>().c_str()),
@@ -80,13 +83,22 @@ RayGroundClassifierCloudNode::RayGroundClassifierCloudNode(
   m_ground_pub_ptr(create_publisher<PointCloud2>(
       "points_ground", rclcpp::QoS(10))),
   m_nonground_pub_ptr(create_publisher<PointCloud2>(
-      "points_nonground", rclcpp::QoS(10)))
+      "points_nonground", rclcpp::QoS(10))),
+  m_trace(get_fully_qualified_name())
 {
   // initialize messages
   point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{
     m_ground_msg, m_frame_id}.reserve(m_pcl_size);
   point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{
     m_nonground_msg, m_frame_id}.reserve(m_pcl_size);
+  // optionally spread the partitioning of rays over multiple threads
+  const auto num_worker_threads = declare_parameter("num_worker_threads", 1);
+  if (num_worker_threads > 1) {
+    m_parallel_classifier = std::make_unique<ray_ground_classifier::ParallelRayGroundClassifier>(
+      m_classifier_cfg, static_cast<std::size_t>(num_worker_threads));
+    m_ground_blk.reserve(m_pcl_size);
+    m_nonground_blk.reserve(m_pcl_size);
+  }
 }
 ////////////////////////////////////////////////////////////////////////////////
 void
@@ -95,6 +107,7 @@ RayGroundClassifierCloudNode::callback(const PointCloud2::SharedPtr msg)
   PointXYZIF pt_tmp;
   pt_tmp.id = static_cast<uint16_t>(PointXYZIF::END_OF_SCAN_ID);
   const ray_ground_classifier::PointXYZIFR eos_pt{&pt_tmp};
+  const common::time_utils::ScopedTrace trace{m_trace, msg->header.stamp};
 
   try {
     point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> ground_msg_modifier{m_ground_msg};
@@ -174,7 +187,45 @@ RayGroundClassifierCloudNode::callback(const PointCloud2::SharedPtr msg)
     }
 
     // if abort, we skip all remaining the parallel work to be able to return/throw
-    if (!abort) {
+    if ((!abort) && m_parallel_classifier) {
+      m_aggregator.end_of_scan();
+      num_ready = m_aggregator.get_ready_ray_count();
+      try {
+        // Sort all rays first, then partition them in one batch
+        m_ready_rays.clear();
+        for (size_t i = 0; i < num_ready; i++) {
+          m_ready_rays.push_back(&m_aggregator.get_next_ray());
+        }
+        m_parallel_classifier->partition(m_ready_rays, m_ground_blk, m_nonground_blk);
+
+        // Add rays to point clouds
+        for (auto & ground_point : m_ground_blk) {
+          ground_msg_modifier.push_back(
+            PointXYZI{
+                    ground_point->x, ground_point->y, ground_point->z, ground_point->intensity});
+        }
+        for (auto & nonground_point : m_nonground_blk) {
+          nonground_msg_modifier.push_back(
+            PointXYZI{
+                    nonground_point->x, nonground_point->y, nonground_point->z,
+                    nonground_point->intensity});
+        }
+      } catch (const std::runtime_error & e) {
+        m_has_failed = true;
+        RCLCPP_INFO(this->get_logger(), e.what());
+        abort = true;
+      } catch (const std::exception & e) {
+        m_has_failed = true;
+        RCLCPP_INFO(this->get_logger(), e.what());
+        abort = true;
+      } catch (...) {
+        RCLCPP_INFO(
+          this->get_logger(),
+          "RayGroundClassifierCloudNode has encountered an unknown failure");
+        abort = true;
+        has_encountered_unknown_exception = true;
+      }
+    } else if (!abort) {
       m_aggregator.end_of_scan();
       num_ready = m_aggregator.get_ready_ray_count();
 
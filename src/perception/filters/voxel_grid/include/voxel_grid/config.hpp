@@ -75,6 +75,13 @@ public:
   /// \brief Gets the capacity of the voxel grid
   /// \return Fixed value
   uint64_t get_capacity() const;
+  /// \brief Gets the number of voxels along x, which is the stride of the y index in index()
+  /// \return Fixed value
+  uint64_t get_y_stride() const;
+  /// \brief Gets the number of voxels in a layer along x and y, which is the stride of the z index
+  ///        in index()
+  /// \return Fixed value
+  uint64_t get_z_stride() const;
   /// \brief Computes index for a given point given the voxelgrid configuration parameters
   /// \param[in] pt The point for which the voxel index will be computed
   /// \return The index of the voxel for which this point will fall into
@@ -22,9 +22,10 @@
 
 #include <voxel_grid/config.hpp>
 #include <voxel_grid/voxels.hpp>
+#include <voxel_grid/voxel_storage.hpp>
 #include <common/types.hpp>
-#include <forward_list>
-#include <unordered_map>
+#include <cstddef>
+#include <stdexcept>
 
 using autoware::common::types::bool8_t;
 
@@ -40,12 +41,15 @@ namespace voxel_grid
 /// \brief A voxel grid data structure for downsampling point clouds
 /// \tparam VoxelT The underlying voxel type, assumed to be a child class of Voxel with the
 ///                addition of the add_observation(PointT) method
-template<typename VoxelT>
+/// \tparam StorageT The storage backend for the voxels, see voxel_storage.hpp. Defaults to
+///                  UnorderedMapVoxelStorage; FlatVoxelStorage is an allocation-free open
+///                  addressing alternative
+template<typename VoxelT, template<typename> class StorageT = UnorderedMapVoxelStorage>
 class VOXEL_GRID_PUBLIC VoxelGrid
 {
-  using Grid = std::unordered_map<uint64_t, VoxelT>;
-  using IT = typename Grid::const_iterator;
-  using OutputQueue = std::forward_list<IT>;
+  using Storage = StorageT<VoxelT>;
+  using IT = typename Storage::const_iterator;
+  using OutputQueue = typename Storage::OutputQueue;
   // TODO(c.ho) static assert for better error messages
 
 public:
@@ -53,11 +57,7 @@ public:
   /// \param[in] cfg The configuration class
   explicit VoxelGrid(const Config & cfg)
   : m_config(cfg),
-    m_map(m_config.get_capacity()),
-    m_output_pool(m_config.get_capacity()),
-    m_output(m_output_pool.get_allocator()),
-    m_new_voxels_called(false),
-    m_last_output_begin(m_output.end())
+    m_storage(static_cast<std::size_t>(m_config.get_capacity()))
   {
   }
 
@@ -68,35 +68,25 @@ public:
   {
     // Get voxel
     const uint64_t idx = m_config.index(pt);
-    // Check capacity if it would be a new voxel
-    if (m_map.end() == m_map.find(idx)) {
+    VoxelT * vx = m_storage.find(idx);
+    // Add to new queue if newly activated, set up any stateful information
+    if (nullptr == vx) {
+      // Check capacity since it is a new voxel
       if (capacity() <= size()) {
         throw std::length_error{"VoxelGrid: insertion would overrun capacity"};
       }
-    }
-    // TODO(c.ho) #2023 adding a new node allocates memory...
-    VoxelT & vx = m_map[idx];
-    // Add to new queue if newly activated, set up any stateful information
-    if (!vx.occupied()) {
+      // Storage adds the voxel to the output queue
+      vx = &m_storage.emplace(idx);
       // Set hint here, rationale:
       // Using some conditional constructor would require C++17 (my preferred solution)
       // In addition, doing the voxel centroid calculation for every point is wasted work
       // I in general agree that an `init` or `configure` method is poor style, but in this case
       // The details of the voxel should be mostly hidden from the user
       //lint -e{523} NOLINT This is to support multiple voxel implementations, see above
-      vx.configure(m_config, idx);
-      // TODO(c.ho) clean up logic
-      // Add to output queue
-      const auto it = m_output_pool.begin();
-      *it = m_map.find(idx);
-      m_output.splice_after(m_output.cbefore_begin(), m_output_pool, m_output_pool.before_begin());
-      if (m_new_voxels_called) {
-        m_last_output_begin = m_output.begin();
-        m_new_voxels_called = false;
-      }
+      vx->configure(m_config, idx);
     }
     // Add observation to voxel
-    vx.add_observation(pt);
+    vx->add_observation(pt);
   }
   /// \brief Inserts many points into the voxel grid, dispatches to the core insert method.
   /// \tparam IT The iterator type
@@ -123,15 +113,7 @@ public:
   /// new_voxels: 5
   const OutputQueue & new_voxels()
   {
-    // Remove old outputs and put it into the pool
-    m_output_pool.splice_after(
-      m_output_pool.cbefore_begin(),
-      m_output,
-      m_last_output_begin,
-      m_output.end());
-    m_new_voxels_called = true;
-    m_last_output_begin = m_output.before_begin();
-    return m_output;
+    return m_storage.new_voxels();
   }
 
   /// \brief Returns an iterator to the first element of the voxel grid
@@ -144,7 +126,7 @@ public:
   /// \return Iterator
   IT cbegin() const
   {
-    return m_map.cbegin();
+    return m_storage.cbegin();
   }
   /// \brief Returns an iterator to one past the last element of the voxel grid
   /// \return Iterator
@@ -156,21 +138,17 @@ public:
   /// \return Iterator
   IT cend() const
   {
-    return m_map.cend();
+    return m_storage.cend();
   }
   /// \brief Resets the state of the voxel grid
   void clear()
   {
-    // TODO(c.ho) clear deallocates nodes #2023
-    m_output_pool.splice_after(m_output_pool.before_begin(), m_output);
-    m_new_voxels_called = false;
-    m_last_output_begin = m_output.end();
-    m_map.clear();
+    m_storage.clear();
   }
   /// \brief Returns the current size of the voxel grid
   std::size_t size() const
   {
-    return m_map.size();
+    return m_storage.size();
   }
   /// \brief Returns the preallocated capacity of the voxel grid
   /// \return The preallocated capacity
@@ -182,17 +160,12 @@ public:
   /// \return True or false
   bool8_t empty() const
   {
-    return m_map.empty();
+    return 0U == m_storage.size();
   }
 
 private:
   const Config m_config;
-  Grid m_map;
-  // Mechanisms to support output queueing in static memory
-  OutputQueue m_output_pool;
-  OutputQueue m_output;
-  bool8_t m_new_voxels_called;
-  typename OutputQueue::iterator m_last_output_begin;
+  Storage m_storage;
 };  // class VoxelGrid
 
 }  // namespace voxel_grid
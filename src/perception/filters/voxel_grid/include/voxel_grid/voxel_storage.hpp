@@ -0,0 +1,366 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+/// \file
+/// \brief This file defines the storage backends which can be used by the VoxelGrid data structure
+
+#ifndef VOXEL_GRID__VOXEL_STORAGE_HPP_
+#define VOXEL_GRID__VOXEL_STORAGE_HPP_
+
+#include <voxel_grid/visibility_control.hpp>
+#include <common/types.hpp>
+#include <cstddef>
+#include <forward_list>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace voxel_grid
+{
+using autoware::common::types::bool8_t;
+
+/// \brief Voxel storage backed by a std::unordered_map. Newly activated voxels are tracked via a
+///        preallocated std::forward_list. This is the default storage of VoxelGrid.
+/// \tparam VoxelT The underlying voxel type
+template<typename VoxelT>
+class VOXEL_GRID_PUBLIC UnorderedMapVoxelStorage
+{
+  using Grid = std::unordered_map<uint64_t, VoxelT>;
+
+public:
+  using const_iterator = typename Grid::const_iterator;
+  using OutputQueue = std::forward_list<const_iterator>;
+
+  /// \brief Constructor
+  /// \param[in] capacity The maximum number of voxels which will be stored
+  explicit UnorderedMapVoxelStorage(const std::size_t capacity)
+  : m_map(capacity),
+    m_output_pool(capacity),
+    m_output(m_output_pool.get_allocator()),
+    m_new_voxels_called(false),
+    m_last_output_begin(m_output.end())
+  {
+  }
+
+  /// \brief Get the active voxel with the given index
+  /// \param[in] idx The index of the voxel
+  /// \return A pointer to the voxel, nullptr if no voxel with this index is active
+  VoxelT * find(const uint64_t idx)
+  {
+    const auto it = m_map.find(idx);
+    return (m_map.end() == it) ? nullptr : &it->second;
+  }
+
+  /// \brief Activate a new voxel and add it to the output queue. Assumes that no voxel with this
+  ///        index is active and that the storage is not full.
+  /// \param[in] idx The index of the voxel
+  /// \return A reference to the newly activated, default constructed voxel
+  VoxelT & emplace(const uint64_t idx)
+  {
+    // TODO(c.ho) #2023 adding a new node allocates memory...
+    const auto ret = m_map.emplace(idx, VoxelT{});
+    // Add to output queue
+    const auto it = m_output_pool.begin();
+    *it = ret.first;
+    m_output.splice_after(m_output.cbefore_begin(), m_output_pool, m_output_pool.before_begin());
+    if (m_new_voxels_called) {
+      m_last_output_begin = m_output.begin();
+      m_new_voxels_called = false;
+    }
+    return ret.first->second;
+  }
+
+  /// \brief Return a list of iterators pointing to newly activated voxels, see VoxelGrid
+  /// \return A list of newly activated iterators pointing to index-voxel pairs
+  const OutputQueue & new_voxels()
+  {
+    // Remove old outputs and put it into the pool
+    m_output_pool.splice_after(
+      m_output_pool.cbefore_begin(),
+      m_output,
+      m_last_output_begin,
+      m_output.end());
+    m_new_voxels_called = true;
+    m_last_output_begin = m_output.before_begin();
+    return m_output;
+  }
+
+  /// \brief Returns an iterator to the first active voxel
+  /// \return Iterator
+  const_iterator cbegin() const
+  {
+    return m_map.cbegin();
+  }
+  /// \brief Returns an iterator to one past the last active voxel
+  /// \return Iterator
+  const_iterator cend() const
+  {
+    return m_map.cend();
+  }
+  /// \brief Deactivates all voxels
+  void clear()
+  {
+    // TODO(c.ho) clear deallocates nodes #2023
+    m_output_pool.splice_after(m_output_pool.before_begin(), m_output);
+    m_new_voxels_called = false;
+    m_last_output_begin = m_output.end();
+    m_map.clear();
+  }
+  /// \brief Returns the number of active voxels
+  std::size_t size() const
+  {
+    return m_map.size();
+  }
+
+private:
+  Grid m_map;
+  // Mechanisms to support output queueing in static memory
+  OutputQueue m_output_pool;
+  OutputQueue m_output;
+  bool8_t m_new_voxels_called;
+  typename OutputQueue::iterator m_last_output_begin;
+};  // class UnorderedMapVoxelStorage
+
+/// \brief Voxel storage backed by a flat, preallocated open addressing (linear probing) table.
+///        Active voxels are tracked in a dense array in order of activation, so iteration and
+///        clearing are linear in the number of active voxels rather than in the table size.
+///        No memory is allocated after construction.
+/// \tparam VoxelT The underlying voxel type
+template<typename VoxelT>
+class VOXEL_GRID_PUBLIC FlatVoxelStorage
+{
+public:
+  using value_type = std::pair<uint64_t, VoxelT>;
+
+  /// \brief Iterator over the active voxels, in order of activation
+  class VOXEL_GRID_PUBLIC const_iterator
+  {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename FlatVoxelStorage::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    /// \brief Constructor
+    /// \param[in] it Position in the dense array of active voxels
+    explicit const_iterator(const pointer * const it)
+    : m_it(it)
+    {
+    }
+    reference operator*() const
+    {
+      return **m_it;
+    }
+    pointer operator->() const
+    {
+      return *m_it;
+    }
+    const_iterator & operator++()
+    {
+      ++m_it;
+      return *this;
+    }
+    const_iterator operator++(int)
+    {
+      const const_iterator ret{*this};
+      ++m_it;
+      return ret;
+    }
+    bool8_t operator==(const const_iterator & rhs) const
+    {
+      return m_it == rhs.m_it;
+    }
+    bool8_t operator!=(const const_iterator & rhs) const
+    {
+      return m_it != rhs.m_it;
+    }
+
+private:
+    const pointer * m_it;
+  };  // class const_iterator
+
+  /// \brief A view of the voxels activated between two calls to new_voxels(), from most recently
+  ///        to least recently activated. Elements point to index-voxel pairs.
+  class VOXEL_GRID_PUBLIC OutputQueue
+  {
+public:
+    using const_iterator = std::reverse_iterator<const value_type * const *>;
+
+    const_iterator begin() const
+    {
+      return const_iterator{m_end};
+    }
+    const_iterator end() const
+    {
+      return const_iterator{m_begin};
+    }
+    bool8_t empty() const
+    {
+      return m_begin == m_end;
+    }
+    bool8_t operator==(const OutputQueue & rhs) const
+    {
+      return (m_begin == rhs.m_begin) && (m_end == rhs.m_end);
+    }
+
+private:
+    friend class FlatVoxelStorage;
+    const value_type * const * m_begin{nullptr};
+    const value_type * const * m_end{nullptr};
+  };  // class OutputQueue
+
+  /// \brief Constructor, preallocates all memory
+  /// \param[in] capacity The maximum number of voxels which will be stored. The table is sized to
+  ///                     keep the load factor at or below one half.
+  explicit FlatVoxelStorage(const std::size_t capacity)
+  : m_slots(table_size(capacity), value_type{EMPTY_KEY, VoxelT{}}),
+    m_shift(hash_shift(m_slots.size())),
+    m_mask(m_slots.size() - 1U),
+    m_new_begin(0U)
+  {
+    m_active.reserve(capacity);
+  }
+
+  /// \brief Get the active voxel with the given index
+  /// \param[in] idx The index of the voxel
+  /// \return A pointer to the voxel, nullptr if no voxel with this index is active
+  VoxelT * find(const uint64_t idx)
+  {
+    for (std::size_t slot = home(idx); EMPTY_KEY != m_slots[slot].first; slot = next(slot)) {
+      if (idx == m_slots[slot].first) {
+        return &m_slots[slot].second;
+      }
+    }
+    return nullptr;
+  }
+
+  /// \brief Activate a new voxel and append it to the list of active voxels. Assumes that no
+  ///        voxel with this index is active and that the storage is not full.
+  /// \param[in] idx The index of the voxel
+  /// \return A reference to the newly activated, default constructed voxel
+  VoxelT & emplace(const uint64_t idx)
+  {
+    std::size_t slot = home(idx);
+    while (EMPTY_KEY != m_slots[slot].first) {
+      slot = next(slot);
+    }
+    value_type & entry = m_slots[slot];
+    entry.first = idx;
+    m_active.push_back(&entry);
+    return entry.second;
+  }
+
+  /// \brief Return a view of the voxels activated since the last call to this method, see
+  ///        VoxelGrid
+  /// \return A view of newly activated voxels
+  const OutputQueue & new_voxels()
+  {
+    m_output.m_begin = m_active.data() + m_new_begin;
+    m_output.m_end = m_active.data() + m_active.size();
+    m_new_begin = m_active.size();
+    return m_output;
+  }
+
+  /// \brief Returns an iterator to the first active voxel
+  /// \return Iterator
+  const_iterator cbegin() const
+  {
+    return const_iterator{m_active.data()};
+  }
+  /// \brief Returns an iterator to one past the last active voxel
+  /// \return Iterator
+  const_iterator cend() const
+  {
+    return const_iterator{m_active.data() + m_active.size()};
+  }
+  /// \brief Deactivates all voxels, linear in the number of active voxels
+  void clear()
+  {
+    for (const value_type * const entry : m_active) {
+      value_type & slot = m_slots[static_cast<std::size_t>(entry - m_slots.data())];
+      slot.first = EMPTY_KEY;
+      slot.second = VoxelT{};
+    }
+    m_active.clear();
+    m_new_begin = 0U;
+    m_output = OutputQueue{};
+  }
+  /// \brief Returns the number of active voxels
+  std::size_t size() const
+  {
+    return m_active.size();
+  }
+
+private:
+  // Voxel indices computed by Config are strictly smaller than the total number of voxels, which
+  // in turn is guaranteed to fit in an uint64_t
+  static constexpr uint64_t EMPTY_KEY = std::numeric_limits<uint64_t>::max();
+
+  /// \brief Smallest power of two which is at least twice the capacity
+  static std::size_t table_size(const std::size_t capacity)
+  {
+    std::size_t ret = 2U;
+    while (ret < (2U * capacity)) {
+      ret *= 2U;
+    }
+    return ret;
+  }
+  /// \brief Shift to take the log2(size) high bits of a 64 bit product
+  static uint32_t hash_shift(const std::size_t size)
+  {
+    uint32_t bits = 0U;
+    while ((std::size_t{1U} << bits) < size) {
+      ++bits;
+    }
+    return 64U - bits;
+  }
+  /// \brief Fibonacci hashing: voxel indices are dense integers, so they are spread over the
+  ///        table by a multiplication with 2^64 / golden ratio
+  std::size_t home(const uint64_t idx) const
+  {
+    return static_cast<std::size_t>((idx * 11400714819323198485ULL) >> m_shift);
+  }
+  std::size_t next(const std::size_t slot) const
+  {
+    return (slot + 1U) & m_mask;
+  }
+
+  std::vector<value_type> m_slots;
+  uint32_t m_shift;
+  std::size_t m_mask;
+  std::vector<const value_type *> m_active;
+  std::size_t m_new_begin;
+  OutputQueue m_output;
+};  // class FlatVoxelStorage
+
+template<typename VoxelT>
+constexpr uint64_t FlatVoxelStorage<VoxelT>::EMPTY_KEY;
+
+}  // namespace voxel_grid
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // VOXEL_GRID__VOXEL_STORAGE_HPP_
@@ -31,6 +31,10 @@ template class VoxelGrid<ApproximateVoxel<PointXYZ>>;
 template class VoxelGrid<ApproximateVoxel<autoware::common::types::PointXYZIF>>;
 template class VoxelGrid<CentroidVoxel<PointXYZ>>;
 template class VoxelGrid<CentroidVoxel<autoware::common::types::PointXYZIF>>;
+template class VoxelGrid<ApproximateVoxel<PointXYZ>, FlatVoxelStorage>;
+template class VoxelGrid<ApproximateVoxel<autoware::common::types::PointXYZIF>, FlatVoxelStorage>;
+template class VoxelGrid<CentroidVoxel<PointXYZ>, FlatVoxelStorage>;
+template class VoxelGrid<CentroidVoxel<autoware::common::types::PointXYZIF>, FlatVoxelStorage>;
 }  // namespace voxel_grid
 }  // namespace filters
 }  // namespace perception
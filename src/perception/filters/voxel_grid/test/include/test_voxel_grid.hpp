@@ -18,8 +18,14 @@
 #define TEST_VOXEL_GRID_HPP_
 
 #include <common/types.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
 #include <memory>
 #include <limits>
+#include <random>
+#include <utility>
+#include <vector>
 #include "voxel_grid/voxel_grid.hpp"
 
 using autoware::perception::filters::voxel_grid::PointXYZ;
@@ -28,6 +34,7 @@ using autoware::perception::filters::voxel_grid::Voxel;
 using autoware::perception::filters::voxel_grid::ApproximateVoxel;
 using autoware::perception::filters::voxel_grid::CentroidVoxel;
 using autoware::perception::filters::voxel_grid::VoxelGrid;
+using autoware::perception::filters::voxel_grid::FlatVoxelStorage;
 using autoware::perception::filters::voxel_grid::PointXYZIF;
 using autoware::common::types::bool8_t;
 using autoware::common::types::float32_t;
@@ -762,4 +769,170 @@ TYPED_TEST(TypedVoxelGridTest, approximate_voxel_grid)
   EXPECT_THROW(grid.insert(*(this->obs_points1.end() - 1)), std::length_error);
   EXPECT_THROW(grid.insert(*(this->obs_points1.end() - 2)), std::length_error);
 }
+
+/// flat storage has the same queueing behavior as the default storage
+TYPED_TEST(TypedVoxelGridTest, flat_voxel_grid)
+{
+  VoxelGrid<CentroidVoxel<TypeParam>, FlatVoxelStorage> grid{*this->cfg_ptr};
+  this->ref_points1[0U] = this->make(-0.75F, -0.75F, -0.75F);
+  this->ref_points1[1U] = this->make(0.75F, -0.75F, -0.75F);
+  this->ref_points1[2U] = this->make(-0.75F, 0.75F, -0.75F);
+  this->ref_points1[3U] = this->make(0.75F, 0.75F, -0.75F);
+  this->ref_points1[4U] = this->make(-0.75F, -0.75F, 0.75F);
+  this->ref_points1[5U] = this->make(0.75F, -0.75F, 0.75F);
+  this->ref_points1[6U] = this->make(-0.75F, 0.75F, 0.75F);
+  this->ref_points1[7U] = this->make(0.75F, 0.75F, 0.75F);
+  this->ref_points2[0U] = this->make(1.0F, 1.0F, 1.0F);
+  this->ref_points2[1U] = this->make(-1.0F, 1.0F, 1.0F);
+  this->ref_points2[2U] = this->make(1.0F, -1.0F, 1.0F);
+  this->ref_points2[3U] = this->make(-1.0F, -1.0F, 1.0F);
+  EXPECT_TRUE(grid.empty());
+  EXPECT_EQ(grid.size(), 0U);
+  EXPECT_EQ(grid.capacity(), this->capacity);
+  // Add more points: scan 0
+  grid.insert(this->obs_points2.begin(), this->obs_points2.end());
+  EXPECT_EQ(grid.size(), 4U);
+  // Check via new_voxels: all
+  const auto & list = grid.new_voxels();
+  EXPECT_EQ(std::distance(list.begin(), list.end()), 4);
+  for (const auto it : list) {
+    EXPECT_TRUE(this->check(it->second.get(), this->ref_points2));
+  }
+  // Iteration is in order of activation
+  auto ref_it = this->obs_points2.begin();
+  for (const auto & it : grid) {
+    EXPECT_TRUE(this->check(it.second.get(), *ref_it));
+    ++ref_it;
+  }
+  // reset
+  grid.clear();
+  EXPECT_TRUE(grid.empty());
+  EXPECT_EQ(grid.begin(), grid.end());
+  EXPECT_TRUE(grid.new_voxels().empty());
+
+  // add a bunch of points: Scan 1
+  const std::size_t mid = 9U;
+  for (std::size_t idx = 0U; idx < mid; ++idx) {
+    grid.insert(this->obs_points1[idx]);
+  }
+  EXPECT_EQ(grid.size(), 5U);
+  // Voxels are in reverse order
+  const auto & list1 = grid.new_voxels();
+  auto tmp = list1.begin();
+  EXPECT_TRUE(this->check((*tmp)->second.get(), this->obs_points1[8U]));  // Single observation
+  ++tmp;
+  EXPECT_TRUE(this->check((*tmp)->second.get(), this->ref_points1[3U]));
+  ++tmp;
+  EXPECT_TRUE(this->check((*tmp)->second.get(), this->ref_points1[2U]));
+  ++tmp;
+  EXPECT_TRUE(this->check((*tmp)->second.get(), this->ref_points1[1U]));
+  ++tmp;
+  EXPECT_TRUE(this->check((*tmp)->second.get(), this->ref_points1[0U]));
+  ++tmp;
+  EXPECT_TRUE(tmp == list1.end());
+  // Insert remainder, only the newly activated voxels are reported
+  for (std::size_t idx = mid; idx < this->obs_points1.size() - 2U; ++idx) {
+    grid.insert(this->obs_points1[idx]);
+  }
+  EXPECT_EQ(grid.size(), this->ref_points1.size() - 1U);
+  const auto & list2 = grid.new_voxels();
+  tmp = list2.begin();
+  EXPECT_TRUE(this->check((*tmp)->second.get(), this->ref_points1[6U]));  // Single observation
+  ++tmp;
+  EXPECT_TRUE(this->check((*tmp)->second.get(), this->ref_points1[5U]));
+  ++tmp;
+  EXPECT_TRUE(tmp == list2.end());
+  EXPECT_TRUE(grid.new_voxels().empty());
+  // make sure the voxels are right
+  for (const auto & it : grid) {
+    EXPECT_TRUE(this->check(it.second.get(), this->ref_points1, this->ref_points1.size() - 1U));
+  }
+  // Bad case: insert too many
+  EXPECT_THROW(grid.insert(*(this->obs_points1.end() - 1)), std::length_error);
+  EXPECT_THROW(grid.insert(*(this->obs_points1.end() - 2)), std::length_error);
+}
+
+/// Collect (index, centroid) pairs of a voxel grid, sorted by index
+template<typename GridT>
+std::vector<std::pair<uint64_t, PointXYZ>> sorted_voxels(const GridT & grid)
+{
+  std::vector<std::pair<uint64_t, PointXYZ>> ret;
+  ret.reserve(grid.size());
+  for (const auto & it : grid) {
+    ret.emplace_back(it.first, it.second.get());
+  }
+  std::sort(
+    ret.begin(), ret.end(),
+    [](const std::pair<uint64_t, PointXYZ> & a, const std::pair<uint64_t, PointXYZ> & b) {
+      return a.first < b.first;
+    });
+  return ret;
+}
+
+/// Insert a point cloud into a voxel grid a few times, return the mean time per scan
+template<typename GridT>
+std::chrono::nanoseconds time_voxel_grid(GridT & grid, const std::vector<PointXYZ> & cloud)
+{
+  constexpr int64_t NUM_ITERATIONS = 10;
+  const auto start = std::chrono::steady_clock::now();
+  for (int64_t idx = 0; idx < NUM_ITERATIONS; ++idx) {
+    grid.clear();
+    grid.insert(cloud.begin(), cloud.end());
+    (void)grid.new_voxels();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start) / NUM_ITERATIONS;
+}
+
+/// Throughput benchmark of the storage backends; also checks that they produce the same voxels
+TEST(VoxelGridBenchmark, storage_throughput)
+{
+  PointXYZ min_point;
+  min_point.x = -130.0F;
+  min_point.y = -130.0F;
+  min_point.z = -3.0F;
+  PointXYZ max_point;
+  max_point.x = 130.0F;
+  max_point.y = 130.0F;
+  max_point.z = 3.0F;
+  PointXYZ voxel_size;
+  voxel_size.x = 0.25F;
+  voxel_size.y = 0.25F;
+  voxel_size.z = 0.25F;
+  constexpr std::size_t NUM_POINTS = 250000U;
+  const Config cfg{min_point, max_point, voxel_size, NUM_POINTS};
+  // Lidar-like cloud: dense near the sensor, sparse far away
+  std::mt19937 gen{1234U};
+  std::uniform_real_distribution<float32_t> angle{-3.14159F, 3.14159F};
+  std::exponential_distribution<float32_t> range{0.05F};
+  std::uniform_real_distribution<float32_t> height{-2.5F, 2.5F};
+  std::vector<PointXYZ> cloud(NUM_POINTS);
+  for (auto & pt : cloud) {
+    const float32_t th = angle(gen);
+    const float32_t r = range(gen);
+    pt.x = r * cosf(th);
+    pt.y = r * sinf(th);
+    pt.z = height(gen);
+  }
+
+  using MapGrid = VoxelGrid<CentroidVoxel<PointXYZ>>;
+  using FlatGrid = VoxelGrid<CentroidVoxel<PointXYZ>, FlatVoxelStorage>;
+  auto map_grid = std::make_unique<MapGrid>(cfg);
+  auto flat_grid = std::make_unique<FlatGrid>(cfg);
+  const auto map_time = time_voxel_grid(*map_grid, cloud);
+  const auto flat_time = time_voxel_grid(*flat_grid, cloud);
+  std::cout << "VoxelGrid insertion of " << NUM_POINTS << " points into " << map_grid->size() <<
+    " voxels: unordered map " << (map_time.count() / 1000) << "us, flat " <<
+  (flat_time.count() / 1000) << "us" << std::endl;
+
+  ASSERT_EQ(map_grid->size(), flat_grid->size());
+  const auto map_voxels = sorted_voxels(*map_grid);
+  const auto flat_voxels = sorted_voxels(*flat_grid);
+  for (std::size_t idx = 0U; idx < map_voxels.size(); ++idx) {
+    ASSERT_EQ(map_voxels[idx].first, flat_voxels[idx].first);
+    EXPECT_FLOAT_EQ(map_voxels[idx].second.x, flat_voxels[idx].second.x);
+    EXPECT_FLOAT_EQ(map_voxels[idx].second.y, flat_voxels[idx].second.y);
+    EXPECT_FLOAT_EQ(map_voxels[idx].second.z, flat_voxels[idx].second.z);
+  }
+}
 #endif  // TEST_VOXEL_GRID_HPP_
@@ -32,12 +32,14 @@ namespace voxel_grid_nodes
 namespace algorithm
 {
 /// \brief Instantiation of PointCloud2 VoxelCloudBase for ApproximateVoxels.
-class VOXEL_GRID_NODES_PUBLIC VoxelCloudApproximate : public VoxelCloudBase
+/// \tparam StorageT The storage backend of the underlying voxel grid
+template<template<typename> class StorageT>
+class VOXEL_GRID_NODES_PUBLIC BasicVoxelCloudApproximate : public VoxelCloudBase
 {
 public:
   /// \brief Constructor
   /// \param[in] cfg Configuration struct for the voxel grid
-  explicit VoxelCloudApproximate(const voxel_grid::Config & cfg);
+  explicit BasicVoxelCloudApproximate(const voxel_grid::Config & cfg);
 
   /// \brief Inserts points into the voxel grid data structure, overwrites internal header
   /// \param[in] msg A point cloud to insert into the voxel grid. Assumed to have the structure XYZI
@@ -50,8 +52,13 @@ public:
 
 private:
   sensor_msgs::msg::PointCloud2 m_cloud;
-  voxel_grid::VoxelGrid<voxel_grid::ApproximateVoxel<PointXYZIF>> m_grid;
-};  // VoxelCloudApproximate
+  voxel_grid::VoxelGrid<voxel_grid::ApproximateVoxel<PointXYZIF>, StorageT> m_grid;
+};  // BasicVoxelCloudApproximate
+
+/// \brief Approximate voxel grid backed by an unordered map
+using VoxelCloudApproximate = BasicVoxelCloudApproximate<voxel_grid::UnorderedMapVoxelStorage>;
+/// \brief Approximate voxel grid backed by a flat, allocation-free open addressing table
+using FlatVoxelCloudApproximate = BasicVoxelCloudApproximate<voxel_grid::FlatVoxelStorage>;
 }  // namespace algorithm
 }  // namespace voxel_grid_nodes
 }  // namespace filters
@@ -32,12 +32,14 @@ namespace voxel_grid_nodes
 namespace algorithm
 {
 /// \brief An instantiation of VoxelCloudBase for CentroidVoxels.
-class VOXEL_GRID_NODES_PUBLIC VoxelCloudCentroid : public VoxelCloudBase
+/// \tparam StorageT The storage backend of the underlying voxel grid
+template<template<typename> class StorageT>
+class VOXEL_GRID_NODES_PUBLIC BasicVoxelCloudCentroid : public VoxelCloudBase
 {
 public:
   /// \brief Constructor
   /// \param[in] cfg Configuration struct for the voxel grid
-  explicit VoxelCloudCentroid(const voxel_grid::Config & cfg);
+  explicit BasicVoxelCloudCentroid(const voxel_grid::Config & cfg);
 
   /// \brief Inserts points into the voxel grid data structure, overwrites internal header
   /// \param[in] msg A point cloud to insert into the voxel grid. Assumed to have the structure XYZI
@@ -50,8 +52,13 @@ public:
 
 private:
   sensor_msgs::msg::PointCloud2 m_cloud;
-  voxel_grid::VoxelGrid<voxel_grid::CentroidVoxel<PointXYZIF>> m_grid;
-};  // VoxelCloudCentroid
+  voxel_grid::VoxelGrid<voxel_grid::CentroidVoxel<PointXYZIF>, StorageT> m_grid;
+};  // BasicVoxelCloudCentroid
+
+/// \brief Centroid voxel grid backed by an unordered map
+using VoxelCloudCentroid = BasicVoxelCloudCentroid<voxel_grid::UnorderedMapVoxelStorage>;
+/// \brief Centroid voxel grid backed by a flat, allocation-free open addressing table
+using FlatVoxelCloudCentroid = BasicVoxelCloudCentroid<voxel_grid::FlatVoxelStorage>;
 }  // namespace algorithm
 }  // namespace voxel_grid_nodes
 }  // namespace filters
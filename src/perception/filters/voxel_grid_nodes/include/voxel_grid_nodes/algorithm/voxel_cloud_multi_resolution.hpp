@@ -0,0 +1,114 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+/// \file
+/// \brief This file defines a centroid voxel grid downsampling to several resolutions at once
+#ifndef VOXEL_GRID_NODES__ALGORITHM__VOXEL_CLOUD_MULTI_RESOLUTION_HPP_
+#define VOXEL_GRID_NODES__ALGORITHM__VOXEL_CLOUD_MULTI_RESOLUTION_HPP_
+
+#include <voxel_grid_nodes/algorithm/voxel_cloud_sorted.hpp>
+#include <vector>
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace voxel_grid_nodes
+{
+namespace algorithm
+{
+/// \brief Centroid voxel grid downsampling of a cloud to several nested resolutions in one pass.
+///        The voxel index of each point is only computed for the finest level, as in
+///        VoxelCloudSorted. The voxels of each further level are an integer multiple of the
+///        voxels of the previous level, so they are reduced from the centroids of the previous
+///        level, weighted by their number of points, instead of from the points. The finest level
+///        is identical to VoxelCloudSorted, and every level is ordered by voxel index.
+class VOXEL_GRID_NODES_PUBLIC VoxelCloudMultiResolution
+{
+public:
+  /// \brief Constructor
+  /// \param[in] cfg Configuration struct for the finest voxel grid. Its capacity bounds the
+  ///                number of voxels of each level
+  /// \param[in] factors For each further level, the ratio of its voxel size to the voxel size of
+  ///                    the previous level
+  /// \throw std::domain_error If a factor is less than 2
+  VoxelCloudMultiResolution(const voxel_grid::Config & cfg, const std::vector<uint32_t> & factors);
+
+  /// \brief Buffers points for downsampling, overwrites internal headers
+  /// \param[in] msg A point cloud to insert into the voxel grid. Assumed to have the structure XYZI
+  void insert(const sensor_msgs::msg::PointCloud2 & msg);
+
+  /// \brief Get accumulated downsampled points of each level, finest first. Internally resets the
+  ///        internal buffers. Headers are taken from last insert
+  /// \return The downsampled point clouds
+  /// \throw std::length_error If the number of voxels of a level exceeds the configured capacity
+  const std::vector<sensor_msgs::msg::PointCloud2> & get();
+
+  /// \brief Get the number of levels, i.e. of downsampled clouds
+  /// \return The number of factors plus one
+  std::size_t num_levels() const noexcept;
+
+private:
+  using PointXYZIF = autoware::perception::filters::voxel_grid::PointXYZIF;
+
+  /// \brief Strides of the voxel index of a level, and the factor to the previous level
+  struct Level
+  {
+    uint64_t y_stride;
+    uint64_t z_stride;
+    uint64_t factor;
+  };
+
+  /// \brief Reduced voxel of a level
+  struct LevelVoxel
+  {
+    uint64_t key;
+    PointXYZIF centroid;
+    uint32_t count;
+  };
+
+  /// \brief Reduce the buffered points into the voxels of the finest level
+  void VOXEL_GRID_NODES_LOCAL reduce_points();
+
+  /// \brief Reduce the voxels of the previous level into the voxels of a level
+  /// \param[in] level The index of the level, greater than zero
+  void VOXEL_GRID_NODES_LOCAL reduce_voxels(const std::size_t level);
+
+  /// \brief Throws if a level has more voxels than the capacity, after resetting the buffers
+  /// \param[in] num_voxels The number of voxels of the level
+  void VOXEL_GRID_NODES_LOCAL check_capacity(const std::size_t num_voxels);
+
+  /// \brief Resets the internal buffers, keeping their capacity
+  void VOXEL_GRID_NODES_LOCAL clear();
+
+  std::vector<sensor_msgs::msg::PointCloud2> m_clouds;
+  const voxel_grid::Config m_config;
+  std::vector<Level> m_levels;
+  std::vector<PointXYZIF> m_points;
+  std::vector<KeyIndex> m_keys;
+  std::vector<KeyIndex> m_sort_buffer;
+  std::vector<LevelVoxel> m_voxels;
+  std::vector<LevelVoxel> m_next_voxels;
+};  // VoxelCloudMultiResolution
+}  // namespace algorithm
+}  // namespace voxel_grid_nodes
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // VOXEL_GRID_NODES__ALGORITHM__VOXEL_CLOUD_MULTI_RESOLUTION_HPP_
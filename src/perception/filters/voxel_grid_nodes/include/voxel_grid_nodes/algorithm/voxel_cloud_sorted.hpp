@@ -0,0 +1,88 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+/// \file
+/// \brief This file defines an instance of the VoxelCloudBase interface
+#ifndef VOXEL_GRID_NODES__ALGORITHM__VOXEL_CLOUD_SORTED_HPP_
+#define VOXEL_GRID_NODES__ALGORITHM__VOXEL_CLOUD_SORTED_HPP_
+
+#include <voxel_grid_nodes/algorithm/voxel_cloud_base.hpp>
+#include <vector>
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace voxel_grid_nodes
+{
+namespace algorithm
+{
+/// \brief Voxel index of a buffered point or voxel, and its position in the buffer
+struct KeyIndex
+{
+  uint64_t key;
+  uint32_t index;
+};
+
+/// \brief Stable LSD radix sort by voxel index. Only as many digits as needed for the largest
+///        index are sorted
+/// \param[inout] keys The keys to sort
+/// \param[inout] buffer Scratch space, swapped with keys for each digit
+void VOXEL_GRID_NODES_PUBLIC sort_key_indices(
+  std::vector<KeyIndex> & keys,
+  std::vector<KeyIndex> & buffer);
+
+/// \brief Centroid voxel grid downsampling via sorting rather than hashing. Points are buffered
+///        along with their voxel index on insert; get() radix sorts the indices and reduces each
+///        run of equal indices to its centroid. The output is identical to VoxelCloudCentroid,
+///        but ordered by voxel index. Buffers are reused, so no memory is allocated in steady
+///        state.
+class VOXEL_GRID_NODES_PUBLIC VoxelCloudSorted : public VoxelCloudBase
+{
+public:
+  /// \brief Constructor
+  /// \param[in] cfg Configuration struct for the voxel grid
+  explicit VoxelCloudSorted(const voxel_grid::Config & cfg);
+
+  /// \brief Buffers points for downsampling, overwrites internal header
+  /// \param[in] msg A point cloud to insert into the voxel grid. Assumed to have the structure XYZI
+  void insert(const sensor_msgs::msg::PointCloud2 & msg) override;
+
+  /// \brief Get accumulated downsampled points. Internally resets the internal buffers. Header is
+  ///        taken from last insert
+  /// \return The downsampled point cloud
+  /// \throw std::length_error If the number of voxels exceeds the configured capacity
+  const sensor_msgs::msg::PointCloud2 & get() override;
+
+private:
+  /// \brief Resets the internal buffers, keeping their capacity
+  void VOXEL_GRID_NODES_LOCAL clear();
+
+  sensor_msgs::msg::PointCloud2 m_cloud;
+  const voxel_grid::Config m_config;
+  std::vector<PointXYZIF> m_points;
+  std::vector<KeyIndex> m_keys;
+  std::vector<KeyIndex> m_sort_buffer;
+};  // VoxelCloudSorted
+}  // namespace algorithm
+}  // namespace voxel_grid_nodes
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // VOXEL_GRID_NODES__ALGORITHM__VOXEL_CLOUD_SORTED_HPP_
@@ -21,10 +21,13 @@
 #define VOXEL_GRID_NODES__VOXEL_CLOUD_NODE_HPP_
 
 #include <voxel_grid_nodes/algorithm/voxel_cloud_base.hpp>
+#include <voxel_grid_nodes/algorithm/voxel_cloud_multi_resolution.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <common/types.hpp>
+#include <time_utils/trace.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 using autoware::common::types::bool8_t;
 
@@ -56,14 +59,38 @@ private:
   /// \brief Initialize state transition callbacks and voxel grid
   /// \param[in] cfg Configuration object for voxel grid
   /// \param[in] is_approximate whether to instantiate an approximate or centroid voxel grid
-  void VOXEL_GRID_NODES_LOCAL init(const voxel_grid::Config & cfg, const bool8_t is_approximate);
+  /// \param[in] use_flat_index whether the voxel grid uses the flat open addressing storage
+  /// \param[in] use_sorted_reduction whether to downsample by sorting voxel indices instead of
+  ///                                 using a voxel grid, only valid for centroid voxels
+  /// \throw std::domain_error If both is_approximate and use_sorted_reduction are set
+  void VOXEL_GRID_NODES_LOCAL init(
+    const voxel_grid::Config & cfg,
+    const bool8_t is_approximate,
+    const bool8_t use_flat_index,
+    const bool8_t use_sorted_reduction);
+
+  /// \brief Initialize the downsampling to several resolutions and a publisher for each further
+  ///        resolution
+  /// \param[in] cfg Configuration object for the finest voxel grid
+  /// \param[in] is_approximate whether approximate voxels are requested
+  /// \param[in] factors ratio of the voxel size of each further resolution to the previous one
+  /// \throw std::domain_error If is_approximate is set, or if a factor is less than 2
+  void VOXEL_GRID_NODES_LOCAL init_multi_resolution(
+    const voxel_grid::Config & cfg,
+    const bool8_t is_approximate,
+    const std::vector<int64_t> & factors);
 
   using Message = sensor_msgs::msg::PointCloud2;
 
   const rclcpp::Subscription<Message>::SharedPtr m_sub_ptr;
   const std::shared_ptr<rclcpp::Publisher<Message>> m_pub_ptr;
   std::unique_ptr<algorithm::VoxelCloudBase> m_voxelgrid_ptr;
+  // downsampling to several resolutions in one pass, if configured instead of m_voxelgrid_ptr
+  std::unique_ptr<algorithm::VoxelCloudMultiResolution> m_multi_resolution_ptr;
+  std::vector<std::shared_ptr<rclcpp::Publisher<Message>>> m_multi_resolution_pubs;
   bool8_t m_has_failed;
+  // records when each cloud enters and leaves the callback, if tracing is switched on
+  const common::time_utils::TracePoint m_trace;
 };  // VoxelCloudNode
 }  // namespace voxel_grid_nodes
 }  // namespace filters
@@ -34,7 +34,8 @@ namespace voxel_grid_nodes
 namespace algorithm
 {
 ////////////////////////////////////////////////////////////////////////////////
-VoxelCloudApproximate::VoxelCloudApproximate(const voxel_grid::Config & cfg)
+template<template<typename> class StorageT>
+BasicVoxelCloudApproximate<StorageT>::BasicVoxelCloudApproximate(const voxel_grid::Config & cfg)
 : VoxelCloudBase(),
   m_cloud(),
   m_grid(cfg)
@@ -44,7 +45,8 @@ VoxelCloudApproximate::VoxelCloudApproximate(const voxel_grid::Config & cfg)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void VoxelCloudApproximate::insert(
+template<template<typename> class StorageT>
+void BasicVoxelCloudApproximate<StorageT>::insert(
   const sensor_msgs::msg::PointCloud2 & msg)
 {
   m_cloud.header = msg.header;
@@ -80,7 +82,8 @@ void VoxelCloudApproximate::insert(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-const sensor_msgs::msg::PointCloud2 & VoxelCloudApproximate::get()
+template<template<typename> class StorageT>
+const sensor_msgs::msg::PointCloud2 & BasicVoxelCloudApproximate<StorageT>::get()
 {
   using autoware::common::types::PointXYZI;
   point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{m_cloud};
@@ -95,6 +98,9 @@ const sensor_msgs::msg::PointCloud2 & VoxelCloudApproximate::get()
 
   return m_cloud;
 }
+
+template class BasicVoxelCloudApproximate<voxel_grid::UnorderedMapVoxelStorage>;
+template class BasicVoxelCloudApproximate<voxel_grid::FlatVoxelStorage>;
 }  // namespace algorithm
 }  // namespace voxel_grid_nodes
 }  // namespace filters
@@ -33,7 +33,8 @@ namespace voxel_grid_nodes
 namespace algorithm
 {
 ////////////////////////////////////////////////////////////////////////////////
-VoxelCloudCentroid::VoxelCloudCentroid(const voxel_grid::Config & cfg)
+template<template<typename> class StorageT>
+BasicVoxelCloudCentroid<StorageT>::BasicVoxelCloudCentroid(const voxel_grid::Config & cfg)
 : VoxelCloudBase(),
   m_cloud(),
   m_grid(cfg)
@@ -44,7 +45,8 @@ VoxelCloudCentroid::VoxelCloudCentroid(const voxel_grid::Config & cfg)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void VoxelCloudCentroid::insert(
+template<template<typename> class StorageT>
+void BasicVoxelCloudCentroid<StorageT>::insert(
   const sensor_msgs::msg::PointCloud2 & msg)
 {
   m_cloud.header = msg.header;
@@ -80,7 +82,8 @@ void VoxelCloudCentroid::insert(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-const sensor_msgs::msg::PointCloud2 & VoxelCloudCentroid::get()
+template<template<typename> class StorageT>
+const sensor_msgs::msg::PointCloud2 & BasicVoxelCloudCentroid<StorageT>::get()
 {
   using autoware::common::types::PointXYZI;
   point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{m_cloud};
@@ -95,6 +98,9 @@ const sensor_msgs::msg::PointCloud2 & VoxelCloudCentroid::get()
 
   return m_cloud;
 }
+
+template class BasicVoxelCloudCentroid<voxel_grid::UnorderedMapVoxelStorage>;
+template class BasicVoxelCloudCentroid<voxel_grid::FlatVoxelStorage>;
 }  // namespace algorithm
 }  // namespace voxel_grid_nodes
 }  // namespace filters
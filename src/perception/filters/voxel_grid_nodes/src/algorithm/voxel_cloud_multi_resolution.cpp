@@ -0,0 +1,218 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lidar_utils/point_cloud_utils.hpp"
+#include "point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp"
+#include "voxel_grid_nodes/algorithm/voxel_cloud_multi_resolution.hpp"
+
+using autoware::common::lidar_utils::has_intensity_and_throw_if_no_xyz;
+using autoware::common::types::PointXYZI;
+using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace voxel_grid_nodes
+{
+namespace algorithm
+{
+////////////////////////////////////////////////////////////////////////////////
+VoxelCloudMultiResolution::VoxelCloudMultiResolution(
+  const voxel_grid::Config & cfg,
+  const std::vector<uint32_t> & factors)
+: m_clouds(factors.size() + 1U),
+  m_config(cfg)
+{
+  for (auto & cloud : m_clouds) {
+    // frame id is arbitrary, not the responsibility of this component
+    point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{cloud, "base_link"};
+  }
+  m_levels.push_back(Level{cfg.get_y_stride(), cfg.get_z_stride(), 1U});
+  for (const auto factor : factors) {
+    if (factor < 2U) {
+      throw std::domain_error{"VoxelCloudMultiResolution: factors must be at least 2"};
+    }
+    // Round up, so that the partial voxels at the upper bound are kept
+    const auto & previous = m_levels.back();
+    const uint64_t y_width = previous.z_stride / previous.y_stride;
+    const uint64_t y_stride = (previous.y_stride + factor - 1U) / factor;
+    m_levels.push_back(Level{y_stride, y_stride * ((y_width + factor - 1U) / factor), factor});
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void VoxelCloudMultiResolution::insert(const sensor_msgs::msg::PointCloud2 & msg)
+{
+  for (auto & cloud : m_clouds) {
+    cloud.header = msg.header;
+  }
+
+  // Verify the consistency of PointCloud msg
+  const auto data_length = msg.width * msg.height * msg.point_step;
+  if ((msg.data.size() != msg.row_step) || (data_length != msg.row_step)) {
+    throw std::runtime_error("VoxelCloudMultiResolution: Malformed PointCloud2");
+  }
+  // Verify the point cloud format and assign correct point_step
+  constexpr auto field_size = sizeof(decltype(autoware::common::types::PointXYZIF::x));
+  auto point_step = 4U * field_size;
+  if (!has_intensity_and_throw_if_no_xyz(msg)) {
+    point_step = 3U * field_size;
+  }
+
+  // The voxel index is computed once, for the finest level
+  for (std::size_t idx = 0U; idx < msg.data.size(); idx += msg.point_step) {
+    PointXYZIF pt;
+    //lint -e{925, 9110} Need to convert pointers and use bit for external API NOLINT
+    (void)memmove(
+      static_cast<void *>(&pt.x),
+      static_cast<const void *>(&msg.data[idx]),
+      point_step);
+    m_keys.push_back(KeyIndex{m_config.index(pt), static_cast<uint32_t>(m_points.size())});
+    m_points.push_back(pt);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::vector<sensor_msgs::msg::PointCloud2> & VoxelCloudMultiResolution::get()
+{
+  for (auto & cloud : m_clouds) {
+    point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{cloud}.clear();
+  }
+  reduce_points();
+  for (std::size_t level = 1U; level < m_levels.size(); ++level) {
+    reduce_voxels(level);
+  }
+  clear();
+
+  return m_clouds;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t VoxelCloudMultiResolution::num_levels() const noexcept
+{
+  return m_levels.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void VoxelCloudMultiResolution::reduce_points()
+{
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{m_clouds.front()};
+  sort_key_indices(m_keys, m_sort_buffer);
+  // Same segmented reduction as VoxelCloudSorted
+  m_voxels.clear();
+  std::size_t begin = 0U;
+  while (begin < m_keys.size()) {
+    const uint64_t key = m_keys[begin].key;
+    check_capacity(m_voxels.size());
+    voxel_grid::CentroidVoxel<PointXYZIF> voxel{};
+    std::size_t end = begin;
+    while ((end < m_keys.size()) && (key == m_keys[end].key)) {
+      voxel.add_observation(m_points[m_keys[end].index]);
+      ++end;
+    }
+    const auto & pt = voxel.get();
+    modifier.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
+    m_voxels.push_back(LevelVoxel{key, pt, voxel.count()});
+    begin = end;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void VoxelCloudMultiResolution::reduce_voxels(const std::size_t level)
+{
+  const auto & previous = m_levels[level - 1U];
+  const auto & current = m_levels[level];
+  // The index of the enclosing voxel follows from the index of the voxel of the previous level
+  m_keys.clear();
+  for (std::size_t idx = 0U; idx < m_voxels.size(); ++idx) {
+    const uint64_t key = m_voxels[idx].key;
+    const uint64_t xdx = (key % previous.y_stride) / current.factor;
+    const uint64_t ydx = ((key % previous.z_stride) / previous.y_stride) / current.factor;
+    const uint64_t zdx = (key / previous.z_stride) / current.factor;
+    m_keys.push_back(
+      KeyIndex{xdx + (ydx * current.y_stride) + (zdx * current.z_stride),
+        static_cast<uint32_t>(idx)});
+  }
+  sort_key_indices(m_keys, m_sort_buffer);
+
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{m_clouds[level]};
+  m_next_voxels.clear();
+  std::size_t begin = 0U;
+  while (begin < m_keys.size()) {
+    const uint64_t key = m_keys[begin].key;
+    check_capacity(m_next_voxels.size());
+    // The centroid of a voxel is the mean of the centroids it encloses, weighted by their counts
+    float64_t x = 0.0;
+    float64_t y = 0.0;
+    float64_t z = 0.0;
+    float64_t intensity = 0.0;
+    uint32_t count = 0U;
+    std::size_t end = begin;
+    while ((end < m_keys.size()) && (key == m_keys[end].key)) {
+      const auto & voxel = m_voxels[m_keys[end].index];
+      const auto weight = static_cast<float64_t>(voxel.count);
+      x += weight * static_cast<float64_t>(voxel.centroid.x);
+      y += weight * static_cast<float64_t>(voxel.centroid.y);
+      z += weight * static_cast<float64_t>(voxel.centroid.z);
+      intensity += weight * static_cast<float64_t>(voxel.centroid.intensity);
+      count += voxel.count;
+      ++end;
+    }
+    const auto count_inv = 1.0 / static_cast<float64_t>(count);
+    PointXYZIF pt{};
+    pt.x = static_cast<float32_t>(x * count_inv);
+    pt.y = static_cast<float32_t>(y * count_inv);
+    pt.z = static_cast<float32_t>(z * count_inv);
+    pt.intensity = static_cast<float32_t>(intensity * count_inv);
+    modifier.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
+    m_next_voxels.push_back(LevelVoxel{key, pt, count});
+    begin = end;
+  }
+  std::swap(m_voxels, m_next_voxels);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void VoxelCloudMultiResolution::check_capacity(const std::size_t num_voxels)
+{
+  if (m_config.get_capacity() <= num_voxels) {
+    clear();
+    throw std::length_error{"VoxelCloudMultiResolution: number of voxels would overrun capacity"};
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void VoxelCloudMultiResolution::clear()
+{
+  m_points.clear();
+  m_keys.clear();
+  m_sort_buffer.clear();
+  m_voxels.clear();
+  m_next_voxels.clear();
+}
+}  // namespace algorithm
+}  // namespace voxel_grid_nodes
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
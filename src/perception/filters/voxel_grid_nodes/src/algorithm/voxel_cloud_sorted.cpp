@@ -0,0 +1,161 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "lidar_utils/point_cloud_utils.hpp"
+#include "point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp"
+#include "voxel_grid_nodes/algorithm/voxel_cloud_sorted.hpp"
+
+using autoware::common::lidar_utils::has_intensity_and_throw_if_no_xyz;
+using autoware::common::types::PointXYZI;
+
+namespace autoware
+{
+namespace perception
+{
+namespace filters
+{
+namespace voxel_grid_nodes
+{
+namespace algorithm
+{
+namespace
+{
+constexpr uint32_t RADIX_BITS = 8U;
+constexpr std::size_t RADIX_BUCKETS = 1U << RADIX_BITS;
+constexpr uint64_t RADIX_MASK = RADIX_BUCKETS - 1U;
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+void sort_key_indices(std::vector<KeyIndex> & keys, std::vector<KeyIndex> & buffer)
+{
+  uint64_t max_key = 0U;
+  for (const auto & k : keys) {
+    max_key = (k.key > max_key) ? k.key : max_key;
+  }
+  buffer.resize(keys.size());
+  std::array<std::size_t, RADIX_BUCKETS> offsets;
+  for (uint32_t shift = 0U; (shift < 64U) && (0U != (max_key >> shift)); shift += RADIX_BITS) {
+    // Histogram of the current digit
+    offsets.fill(0U);
+    for (const auto & k : keys) {
+      ++offsets[static_cast<std::size_t>((k.key >> shift) & RADIX_MASK)];
+    }
+    // Exclusive prefix sum gives the output position of each bucket
+    std::size_t sum = 0U;
+    for (auto & offset : offsets) {
+      const std::size_t count = offset;
+      offset = sum;
+      sum += count;
+    }
+    // Stable scatter
+    for (const auto & k : keys) {
+      buffer[offsets[static_cast<std::size_t>((k.key >> shift) & RADIX_MASK)]++] = k;
+    }
+    std::swap(keys, buffer);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+VoxelCloudSorted::VoxelCloudSorted(const voxel_grid::Config & cfg)
+: VoxelCloudBase(),
+  m_cloud(),
+  m_config(cfg)
+{
+  // frame id is arbitrary, not the responsibility of this component
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>{m_cloud, "base_link"};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void VoxelCloudSorted::insert(
+  const sensor_msgs::msg::PointCloud2 & msg)
+{
+  m_cloud.header = msg.header;
+
+  // Verify the consistency of PointCloud msg
+  const auto data_length = msg.width * msg.height * msg.point_step;
+  if ((msg.data.size() != msg.row_step) || (data_length != msg.row_step)) {
+    throw std::runtime_error("VoxelCloudSorted: Malformed PointCloud2");
+  }
+  // Verify the point cloud format and assign correct point_step
+  constexpr auto field_size = sizeof(decltype(autoware::common::types::PointXYZIF::x));
+  auto point_step = 4U * field_size;
+  if (!has_intensity_and_throw_if_no_xyz(msg)) {
+    point_step = 3U * field_size;
+  }
+
+  // Only compute and buffer the voxel index here, reduction is deferred to get()
+  for (std::size_t idx = 0U; idx < msg.data.size(); idx += msg.point_step) {
+    PointXYZIF pt;
+    //lint -e{925, 9110} Need to convert pointers and use bit for external API NOLINT
+    (void)memmove(
+      static_cast<void *>(&pt.x),
+      static_cast<const void *>(&msg.data[idx]),
+      point_step);
+    m_keys.push_back(KeyIndex{m_config.index(pt), static_cast<uint32_t>(m_points.size())});
+    m_points.push_back(pt);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const sensor_msgs::msg::PointCloud2 & VoxelCloudSorted::get()
+{
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{m_cloud};
+  modifier.clear();
+
+  sort_key_indices(m_keys, m_sort_buffer);
+  // Segmented reduction: each run of equal keys is one voxel. Points within a run keep their
+  // insertion order, so accumulating them with CentroidVoxel gives the same result as VoxelGrid
+  uint64_t num_voxels = 0U;
+  std::size_t begin = 0U;
+  while (begin < m_keys.size()) {
+    const uint64_t key = m_keys[begin].key;
+    if (m_config.get_capacity() <= num_voxels) {
+      clear();
+      throw std::length_error{"VoxelCloudSorted: number of voxels would overrun capacity"};
+    }
+    voxel_grid::CentroidVoxel<PointXYZIF> voxel{};
+    std::size_t end = begin;
+    while ((end < m_keys.size()) && (key == m_keys[end].key)) {
+      voxel.add_observation(m_points[m_keys[end].index]);
+      ++end;
+    }
+    const auto & pt = voxel.get();
+    modifier.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
+    ++num_voxels;
+    begin = end;
+  }
+  clear();
+
+  return m_cloud;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void VoxelCloudSorted::clear()
+{
+  m_points.clear();
+  m_keys.clear();
+  m_sort_buffer.clear();
+}
+}  // namespace algorithm
+}  // namespace voxel_grid_nodes
+}  // namespace filters
+}  // namespace perception
+}  // namespace autoware
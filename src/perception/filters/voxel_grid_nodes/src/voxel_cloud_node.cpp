@@ -20,12 +20,15 @@
 #include <voxel_grid_nodes/voxel_cloud_node.hpp>
 #include <voxel_grid_nodes/algorithm/voxel_cloud_approximate.hpp>
 #include <voxel_grid_nodes/algorithm/voxel_cloud_centroid.hpp>
+#include <voxel_grid_nodes/algorithm/voxel_cloud_sorted.hpp>
 #include <common/types.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
 
 #include <memory>
 #include <string>
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 using autoware::common::types::bool8_t;
 using autoware::common::types::uchar8_t;
@@ -66,7 +69,8 @@ VoxelCloudNode::VoxelCloudNode(
         )
       )
     )},
-  m_has_failed{false}
+  m_has_failed{false},
+  m_trace{get_fully_qualified_name()}
 {
   // Build config manually (messages only have default constructors)
   voxel_grid::PointXYZ min_point;
@@ -85,15 +89,35 @@ VoxelCloudNode::VoxelCloudNode(
     static_cast<std::size_t>(declare_parameter("config.capacity").get<std::size_t>());
   const voxel_grid::Config cfg{min_point, max_point, voxel_size, capacity};
   // Init
-  init(cfg, declare_parameter("is_approximate").get<bool8_t>());
+  const auto is_approximate = declare_parameter("is_approximate").get<bool8_t>();
+  const auto factors =
+    declare_parameter("multi_resolution.factors", std::vector<int64_t>{});
+  if (factors.empty()) {
+    init(
+      cfg, is_approximate,
+      declare_parameter("use_flat_index", false),
+      declare_parameter("use_sorted_reduction", false));
+  } else {
+    init_multi_resolution(cfg, is_approximate, factors);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void VoxelCloudNode::callback(const sensor_msgs::msg::PointCloud2::SharedPtr msg)
 {
+  const common::time_utils::ScopedTrace trace{m_trace, msg->header.stamp};
   try {
-    m_voxelgrid_ptr->insert(*msg);
-    m_pub_ptr->publish(m_voxelgrid_ptr->get());
+    if (m_multi_resolution_ptr) {
+      m_multi_resolution_ptr->insert(*msg);
+      const auto & clouds = m_multi_resolution_ptr->get();
+      m_pub_ptr->publish(clouds.front());
+      for (std::size_t idx = 1U; idx < clouds.size(); ++idx) {
+        m_multi_resolution_pubs[idx - 1U]->publish(clouds[idx]);
+      }
+    } else {
+      m_voxelgrid_ptr->insert(*msg);
+      m_pub_ptr->publish(m_voxelgrid_ptr->get());
+    }
   } catch (const std::exception & e) {
     std::string err_msg{get_name()};
     err_msg += ": " + std::string(e.what());
@@ -107,13 +131,58 @@ void VoxelCloudNode::callback(const sensor_msgs::msg::PointCloud2::SharedPtr msg
   }
 }
 ////////////////////////////////////////////////////////////////////////////////
-void VoxelCloudNode::init(const voxel_grid::Config & cfg, const bool8_t is_approximate)
+void VoxelCloudNode::init(
+  const voxel_grid::Config & cfg,
+  const bool8_t is_approximate,
+  const bool8_t use_flat_index,
+  const bool8_t use_sorted_reduction)
 {
   // construct voxel grid
-  if (is_approximate) {
-    m_voxelgrid_ptr = std::make_unique<algorithm::VoxelCloudApproximate>(cfg);
+  if (use_sorted_reduction) {
+    if (is_approximate) {
+      throw std::domain_error{"VoxelCloudNode: sorted reduction only supports centroid voxels"};
+    }
+    m_voxelgrid_ptr = std::make_unique<algorithm::VoxelCloudSorted>(cfg);
+  } else if (is_approximate) {
+    if (use_flat_index) {
+      m_voxelgrid_ptr = std::make_unique<algorithm::FlatVoxelCloudApproximate>(cfg);
+    } else {
+      m_voxelgrid_ptr = std::make_unique<algorithm::VoxelCloudApproximate>(cfg);
+    }
   } else {
-    m_voxelgrid_ptr = std::make_unique<algorithm::VoxelCloudCentroid>(cfg);
+    if (use_flat_index) {
+      m_voxelgrid_ptr = std::make_unique<algorithm::FlatVoxelCloudCentroid>(cfg);
+    } else {
+      m_voxelgrid_ptr = std::make_unique<algorithm::VoxelCloudCentroid>(cfg);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void VoxelCloudNode::init_multi_resolution(
+  const voxel_grid::Config & cfg,
+  const bool8_t is_approximate,
+  const std::vector<int64_t> & factors)
+{
+  if (is_approximate) {
+    throw std::domain_error{"VoxelCloudNode: multiple resolutions only support centroid voxels"};
+  }
+  std::vector<uint32_t> level_factors;
+  for (const auto factor : factors) {
+    if ((factor < 2) || (factor > std::numeric_limits<uint32_t>::max())) {
+      throw std::domain_error{"VoxelCloudNode: multi_resolution.factors must be at least 2"};
+    }
+    level_factors.push_back(static_cast<uint32_t>(factor));
+  }
+  m_multi_resolution_ptr =
+    std::make_unique<algorithm::VoxelCloudMultiResolution>(cfg, level_factors);
+  // Each further resolution is published with the same QoS as the finest one
+  const auto qos = rclcpp::QoS(
+    static_cast<size_t>(get_parameter("publisher.qos.history_depth").as_int())
+  ).durability(parse_durability_parameter(get_parameter("publisher.qos.durability").as_string()));
+  for (std::size_t level = 1U; level <= level_factors.size(); ++level) {
+    m_multi_resolution_pubs.push_back(
+      create_publisher<Message>("points_downsampled_" + std::to_string(level), qos));
   }
 }
 
@@ -19,11 +19,18 @@
 #include <rclcpp/rclcpp.hpp>
 #include <voxel_grid_nodes/algorithm/voxel_cloud_approximate.hpp>
 #include <voxel_grid_nodes/algorithm/voxel_cloud_centroid.hpp>
+#include <voxel_grid_nodes/algorithm/voxel_cloud_multi_resolution.hpp>
+#include <voxel_grid_nodes/algorithm/voxel_cloud_sorted.hpp>
 #include <voxel_grid_nodes/voxel_cloud_node.hpp>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
 #include <memory>
+#include <random>
+#include <tuple>
 #include <vector>
 
 using autoware::perception::filters::voxel_grid::PointXYZ;
@@ -32,6 +39,10 @@ using autoware::perception::filters::voxel_grid::Config;
 using autoware::perception::filters::voxel_grid_nodes::algorithm::VoxelCloudBase;
 using autoware::perception::filters::voxel_grid_nodes::algorithm::VoxelCloudApproximate;
 using autoware::perception::filters::voxel_grid_nodes::algorithm::VoxelCloudCentroid;
+using autoware::perception::filters::voxel_grid_nodes::algorithm::FlatVoxelCloudApproximate;
+using autoware::perception::filters::voxel_grid_nodes::algorithm::FlatVoxelCloudCentroid;
+using autoware::perception::filters::voxel_grid_nodes::algorithm::VoxelCloudSorted;
+using autoware::perception::filters::voxel_grid_nodes::algorithm::VoxelCloudMultiResolution;
 
 using autoware::common::types::PointXYZI;
 using autoware::common::types::bool8_t;
@@ -201,6 +212,234 @@ TEST_F(CloudAlgorithm, Centroid)
   EXPECT_EQ(alg_ptr->get().width, 0U);
 }
 
+TEST_F(CloudAlgorithm, FlatApproximate)
+{
+  this->ref_points1[0U] = this->make(-0.5F, -0.5F, -0.5F);
+  this->ref_points1[1U] = this->make(0.5F, -0.5F, -0.5F);
+  this->ref_points1[2U] = this->make(-0.5F, 0.5F, -0.5F);
+  this->ref_points1[3U] = this->make(0.5F, 0.5F, -0.5F);
+  this->ref_points1[4U] = this->make(-0.5F, -0.5F, 0.5F);
+  this->ref_points1[5U] = this->make(0.5F, -0.5F, 0.5F);
+  this->ref_points1[6U] = this->make(-0.5F, 0.5F, 0.5F);
+  this->ref_points1[7U] = this->make(0.5F, 0.5F, 0.5F);
+  alg_ptr = std::make_unique<FlatVoxelCloudApproximate>(*cfg_ptr);
+  EXPECT_EQ(alg_ptr->get().width, 0U);
+  alg_ptr->insert(cloud1);
+  EXPECT_EQ(alg_ptr->get().width, 4U);
+  alg_ptr->insert(cloud1);
+  alg_ptr->insert(cloud2);
+  const auto & out = alg_ptr->get();
+  EXPECT_EQ(out.width, ref_points1.size());
+  EXPECT_TRUE(check(out, ref_points1.size()));
+  EXPECT_EQ(alg_ptr->get().width, 0U);
+}
+
+TEST_F(CloudAlgorithm, FlatCentroid)
+{
+  this->ref_points1[0U] = this->make(-0.75F, -0.75F, -0.75F);
+  this->ref_points1[1U] = this->make(0.75F, -0.75F, -0.75F);
+  this->ref_points1[2U] = this->make(-0.75F, 0.75F, -0.75F);
+  this->ref_points1[3U] = this->make(0.75F, 0.75F, -0.75F);
+  this->ref_points1[4U] = this->make(-0.75F, -0.75F, 0.75F);
+  this->ref_points1[5U] = this->make(0.75F, -0.75F, 0.75F);
+  this->ref_points1[6U] = this->make(-0.75F, 0.75F, 0.75F);
+  this->ref_points1[7U] = this->make(0.75F, 0.75F, 0.75F);
+  alg_ptr = std::make_unique<FlatVoxelCloudCentroid>(*cfg_ptr);
+  EXPECT_EQ(alg_ptr->get().width, 0U);
+  alg_ptr->insert(cloud1);
+  EXPECT_EQ(alg_ptr->get().width, 4U);
+  // Centroids accumulated over two scans match the default storage
+  alg_ptr->insert(cloud1);
+  alg_ptr->insert(cloud2);
+  const auto & out = alg_ptr->get();
+  EXPECT_EQ(out.width, ref_points1.size());
+  EXPECT_TRUE(check(out, ref_points1.size()));
+  EXPECT_EQ(alg_ptr->get().width, 0U);
+}
+
+TEST_F(CloudAlgorithm, Sorted)
+{
+  this->ref_points1[0U] = this->make(-0.75F, -0.75F, -0.75F);
+  this->ref_points1[1U] = this->make(0.75F, -0.75F, -0.75F);
+  this->ref_points1[2U] = this->make(-0.75F, 0.75F, -0.75F);
+  this->ref_points1[3U] = this->make(0.75F, 0.75F, -0.75F);
+  this->ref_points1[4U] = this->make(-0.75F, -0.75F, 0.75F);
+  this->ref_points1[5U] = this->make(0.75F, -0.75F, 0.75F);
+  this->ref_points1[6U] = this->make(-0.75F, 0.75F, 0.75F);
+  this->ref_points1[7U] = this->make(0.75F, 0.75F, 0.75F);
+  alg_ptr = std::make_unique<VoxelCloudSorted>(*cfg_ptr);
+  EXPECT_EQ(alg_ptr->get().width, 0U);
+  alg_ptr->insert(cloud1);
+  EXPECT_EQ(alg_ptr->get().width, 4U);
+  EXPECT_EQ(alg_ptr->get().width, 0U);
+  alg_ptr->insert(cloud1);
+  alg_ptr->insert(cloud2);
+  const auto & out = alg_ptr->get();
+  EXPECT_EQ(out.width, ref_points1.size());
+  EXPECT_TRUE(check(out, ref_points1.size()));
+  EXPECT_EQ(alg_ptr->get().width, 0U);
+}
+
+TEST(VoxelCloudSortedTest, MatchesCentroid)
+{
+  PointXYZ min_point;
+  min_point.x = -130.0F;
+  min_point.y = -130.0F;
+  min_point.z = -3.0F;
+  PointXYZ max_point;
+  max_point.x = 130.0F;
+  max_point.y = 130.0F;
+  max_point.z = 3.0F;
+  PointXYZ voxel_size;
+  voxel_size.x = 0.5F;
+  voxel_size.y = 0.5F;
+  voxel_size.z = 0.5F;
+  constexpr std::size_t NUM_POINTS = 250000U;
+  const Config cfg{min_point, max_point, voxel_size, NUM_POINTS};
+  // Lidar-like cloud: dense near the sensor, sparse far away
+  std::mt19937 gen{42U};
+  std::uniform_real_distribution<float32_t> angle{-3.14159F, 3.14159F};
+  std::exponential_distribution<float32_t> range{0.05F};
+  std::uniform_real_distribution<float32_t> height{-2.5F, 2.5F};
+  std::uniform_real_distribution<float32_t> intensity{0.0F, 255.0F};
+  sensor_msgs::msg::PointCloud2 cloud;
+  {
+    point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> mod{cloud, "frame_id"};
+    mod.reserve(NUM_POINTS);
+    for (std::size_t idx = 0U; idx < NUM_POINTS; ++idx) {
+      const float32_t th = angle(gen);
+      const float32_t r = range(gen);
+      mod.push_back(PointXYZI{r * cosf(th), r * sinf(th), height(gen), intensity(gen)});
+    }
+  }
+  auto to_sorted_points = [](const sensor_msgs::msg::PointCloud2 & msg) {
+      point_cloud_msg_wrapper::PointCloud2View<PointXYZI> view{msg};
+      std::vector<PointXYZI> ret;
+      for (const auto & pt : view) {
+        ret.push_back(pt);
+      }
+      std::sort(
+        ret.begin(), ret.end(), [](const PointXYZI & a, const PointXYZI & b) {
+          return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+        });
+      return ret;
+    };
+  auto time_downsampling = [&cloud](VoxelCloudBase & alg) {
+      const auto start = std::chrono::steady_clock::now();
+      alg.insert(cloud);
+      (void)alg.get();
+      const auto end = std::chrono::steady_clock::now();
+      return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    };
+
+  VoxelCloudCentroid centroid{cfg};
+  VoxelCloudSorted sorted{cfg};
+  const auto centroid_us = time_downsampling(centroid);
+  const auto sorted_us = time_downsampling(sorted);
+  std::cout << "Downsampling " << NUM_POINTS << " points: VoxelCloudCentroid " << centroid_us <<
+    "us, VoxelCloudSorted " << sorted_us << "us" << std::endl;
+
+  centroid.insert(cloud);
+  sorted.insert(cloud);
+  const auto ref = to_sorted_points(centroid.get());
+  const auto out = to_sorted_points(sorted.get());
+  ASSERT_EQ(ref.size(), out.size());
+  for (std::size_t idx = 0U; idx < ref.size(); ++idx) {
+    // Identical accumulation order within each voxel, so results are bitwise equal
+    EXPECT_EQ(ref[idx].x, out[idx].x);
+    EXPECT_EQ(ref[idx].y, out[idx].y);
+    EXPECT_EQ(ref[idx].z, out[idx].z);
+    EXPECT_EQ(ref[idx].intensity, out[idx].intensity);
+  }
+}
+
+TEST_F(CloudAlgorithm, SortedCapacity)
+{
+  alg_ptr = std::make_unique<VoxelCloudSorted>(*cfg_ptr);
+  // 8 voxels, capacity is 10: fine
+  alg_ptr->insert(cloud2);
+  EXPECT_EQ(alg_ptr->get().width, 8U);
+  // Too many voxels
+  PointXYZ min_point;
+  min_point.x = -1.0F;
+  min_point.y = -1.0F;
+  min_point.z = -1.0F;
+  PointXYZ max_point;
+  max_point.x = 1.0F;
+  max_point.y = 1.0F;
+  max_point.z = 1.0F;
+  PointXYZ voxel_size;
+  voxel_size.x = 1.0F;
+  voxel_size.y = 1.0F;
+  voxel_size.z = 1.0F;
+  alg_ptr = std::make_unique<VoxelCloudSorted>(Config{min_point, max_point, voxel_size, 4U});
+  alg_ptr->insert(cloud2);
+  EXPECT_THROW(alg_ptr->get(), std::length_error);
+  // Buffers are reset after the failure
+  alg_ptr->insert(cloud1);
+  EXPECT_EQ(alg_ptr->get().width, 4U);
+}
+
+TEST(VoxelCloudMultiResolutionTest, MatchesSorted)
+{
+  auto make_config = [](const float32_t size) {
+      PointXYZ min_point;
+      min_point.x = -4.0F;
+      min_point.y = -4.0F;
+      min_point.z = -4.0F;
+      PointXYZ max_point;
+      max_point.x = 4.0F;
+      max_point.y = 4.0F;
+      max_point.z = 4.0F;
+      PointXYZ voxel_size;
+      voxel_size.x = size;
+      voxel_size.y = size;
+      voxel_size.z = size;
+      return Config{min_point, max_point, voxel_size, 5000U};
+    };
+  EXPECT_THROW(VoxelCloudMultiResolution(make_config(0.5F), {2U, 1U}), std::domain_error);
+
+  // Every level holds the same voxels as a single grid of its resolution
+  VoxelCloudMultiResolution multi{make_config(0.5F), {2U, 2U}};
+  ASSERT_EQ(multi.num_levels(), 3U);
+  std::vector<VoxelCloudSorted> references{
+    VoxelCloudSorted{make_config(0.5F)},
+    VoxelCloudSorted{make_config(1.0F)},
+    VoxelCloudSorted{make_config(2.0F)}};
+  std::mt19937 gen{42U};
+  // Within the bounds, as points clamped to the upper bound get an index past the last voxel
+  std::uniform_real_distribution<float32_t> position{-3.9F, 3.9F};
+  std::uniform_real_distribution<float32_t> intensity{0.0F, 255.0F};
+  sensor_msgs::msg::PointCloud2 cloud;
+  {
+    point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> mod{cloud, "frame_id"};
+    for (std::size_t idx = 0U; idx < 20000U; ++idx) {
+      mod.push_back(PointXYZI{position(gen), position(gen), position(gen), intensity(gen)});
+    }
+  }
+  multi.insert(cloud);
+  const auto & clouds = multi.get();
+  ASSERT_EQ(clouds.size(), 3U);
+  for (std::size_t level = 0U; level < clouds.size(); ++level) {
+    references[level].insert(cloud);
+    // Both are ordered by voxel index
+    point_cloud_msg_wrapper::PointCloud2View<PointXYZI> ref{references[level].get()};
+    point_cloud_msg_wrapper::PointCloud2View<PointXYZI> out{clouds[level]};
+    EXPECT_EQ(clouds[level].header.frame_id, "frame_id");
+    ASSERT_EQ(ref.size(), out.size()) << level;
+    for (std::size_t idx = 0U; idx < ref.size(); ++idx) {
+      EXPECT_NEAR(ref[idx].x, out[idx].x, 1.0E-4F) << level;
+      EXPECT_NEAR(ref[idx].y, out[idx].y, 1.0E-4F) << level;
+      EXPECT_NEAR(ref[idx].z, out[idx].z, 1.0E-4F) << level;
+      EXPECT_NEAR(ref[idx].intensity, out[idx].intensity, 1.0E-2F) << level;
+    }
+  }
+  // Buffers are reset
+  for (const auto & out : multi.get()) {
+    EXPECT_EQ(out.width, 0U);
+  }
+}
+
 TEST(VoxelGridNodes, Instantiate)
 {
   // Basic test to ensure that VoxelCloudNode can be instantiated
@@ -258,4 +497,12 @@ TEST(VoxelGridNodes, Instantiate)
   params.emplace_back("config.voxel_size.z", 1.0);
   node_options.parameter_overrides(params);
   ASSERT_NO_THROW(VoxelCloudNode{node_options});
+
+  params.emplace_back("use_flat_index", true);
+  node_options.parameter_overrides(params);
+  ASSERT_NO_THROW(VoxelCloudNode{node_options});
+
+  params.emplace_back("use_sorted_reduction", true);
+  node_options.parameter_overrides(params);
+  ASSERT_NO_THROW(VoxelCloudNode{node_options});
 }
@@ -28,10 +28,11 @@
 #include <autoware_auto_msgs/msg/bounding_box_array.hpp>
 #include <common/types.hpp>
 #include <tf2_eigen/tf2_eigen.h>
-#include <tf2_ros/transform_listener.h>
+#include <autoware_auto_tf2/shared_transform_buffer.hpp>
 #include <pcl_conversions/pcl_conversions.h>
 #include <pcl/common/transforms.h>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -46,6 +47,7 @@ namespace apollo_lidar_segmentation
 {
 using autoware::common::types::bool8_t;
 using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
 using autoware_auto_msgs::msg::BoundingBoxArray;
 using tvm_utility::pipeline::TVMArrayContainer;
 using tvm_utility::pipeline::TVMArrayContainerVector;
@@ -57,15 +59,20 @@ class APOLLO_LIDAR_SEGMENTATION_LOCAL ApolloLidarSegmentationPreProcessor
 public:
   /// \brief Constructor.
   /// \param[in] config The TVM configuration.
+  /// \param[in] input_tensor The host memory input tensor of the inference engine. The feature
+  ///                         map is generated in place in it when it has the same number of
+  ///                         channels.
   /// \param[in] range The range of the 2D grid.
   /// \param[in] use_intensity_feature Enable input channel intensity feature.
   /// \param[in] use_constant_feature Enable input channel constant feature.
   /// \param[in] min_height The minimum height.
   /// \param[in] max_height The maximum height.
+  /// \param[in] num_threads The number of threads generating the feature map.
   explicit ApolloLidarSegmentationPreProcessor(
-    const tvm_utility::pipeline::InferenceEngineTVMConfig & config, int32_t range,
-    bool8_t use_intensity_feature, bool8_t use_constant_feature, float32_t min_height,
-    float32_t max_height);
+    const tvm_utility::pipeline::InferenceEngineTVMConfig & config,
+    const TVMArrayContainer & input_tensor, int32_t range, bool8_t use_intensity_feature,
+    bool8_t use_constant_feature, float32_t min_height, float32_t max_height,
+    std::size_t num_threads);
 
   /// \brief Transfer the input data to a TVM array.
   /// \param[in] pc_ptr Input pointcloud.
@@ -78,8 +85,8 @@ private:
   const int64_t input_width;
   const int64_t input_height;
   const int64_t datatype_bytes;
+  const TVMArrayContainer output;
   const std::shared_ptr<FeatureGenerator> feature_generator;
-  TVMArrayContainer output;
 };
 
 /// \brief Post-precessing step of the TVM pipeline.
@@ -98,11 +105,12 @@ public:
   /// \param[in] height_thresh If it is non-negative, the points that are higher than the predicted
   ///                          object height by height_thresh are filtered out.
   /// \param[in] min_pts_num The candidate clusters with less than min_pts_num points are removed.
+  /// \param[in] num_threads The number of threads computing the bounding boxes.
   explicit ApolloLidarSegmentationPostProcessor(
     const tvm_utility::pipeline::InferenceEngineTVMConfig & config,
     const pcl::PointCloud<pcl::PointXYZI>::ConstPtr & pc_ptr, int32_t range,
     float32_t objectness_thresh, float32_t score_threshold, float32_t height_thresh,
-    int32_t min_pts_num);
+    int32_t min_pts_num, std::size_t num_threads);
 
   /// \brief Copy the inference result.
   /// \param[in] input The result of the inference engine.
@@ -121,6 +129,7 @@ private:
   const std::shared_ptr<float32_t> inferred_data;
   const pcl::PointCloud<pcl::PointXYZI>::ConstPtr pc_ptr_;
   const std::shared_ptr<Cluster2D> cluster2d_;
+  pcl::PointIndices valid_idx_;  // all points of the cloud, kept between calls
 };
 
 /// \brief Handle the neural network inference over the input point cloud.
@@ -143,11 +152,26 @@ public:
   /// \param[in] height_thresh If it is non-negative, the points that are higher than the predicted
   ///                          object height by height_thresh are filtered out in the
   ///                          post-processing step.
+  /// \param[in] num_threads The number of threads generating the feature map in the
+  ///                        pre-processing step, and the bounding boxes in the post-processing
+  ///                        step.
+  /// \param[in] latency_budget_ms If it is positive, the fp16 or int8 variant of the network is
+  ///                              run instead when the full precision network is known to exceed
+  ///                              this latency on the target. Unit: millisecond
+  /// \param[in] crop_height Remove the points outside of the height limits from the input
+  ///                        pointcloud, so that they are not part of the detected obstacles either.
+  ///                        Otherwise they are only left out of the feature map.
+  /// \param[in] profile_operators Run the network in the debug graph runtime of TVM, so that the
+  ///                              latencies of its operators can be measured by
+  ///                              profileOperators.
+  /// \throw std::runtime_error If profile_operators is set and the TVM runtime was built without
+  ///                           the debug graph runtime.
   explicit ApolloLidarSegmentation(
     int32_t range, float32_t score_threshold,
     bool8_t use_intensity_feature, bool8_t use_constant_feature, float32_t z_offset,
     float32_t min_height, float32_t max_height, float32_t objectness_thresh, int32_t min_pts_num,
-    float32_t height_thresh);
+    float32_t height_thresh, std::size_t num_threads = 1U, float64_t latency_budget_ms = 0.0,
+    bool8_t crop_height = false, bool8_t profile_operators = false);
 
   /// \brief Detect obstacles.
   /// \param[in] input Input pointcloud.
@@ -157,10 +181,28 @@ public:
   std::shared_ptr<const BoundingBoxArray> detectDynamicObjects(
     const sensor_msgs::msg::PointCloud2 & input);
 
+  /// \brief Start measuring the latencies of the pre-processing, the inference and the
+  ///        post-processing of every pointcloud.
+  void enableProfiling();
+
+  /// \brief Get the latencies of the steps of the inference pipeline since enableProfiling was
+  ///        called, or null if it was not.
+  const tvm_utility::pipeline::PipelineProfile * getProfile() const;
+
+  /// \brief Measure the latencies of the operators of the network with the last pointcloud, see
+  ///        tvm_utility::pipeline::InferenceEngineTVM::profileOperators.
+  /// \param[in] number The number of inferences to average over.
+  /// \return The latency of every node of the graph of the network. Unit: millisecond
+  /// \throw std::runtime_error If profile_operators was not set.
+  std::vector<tvm_utility::pipeline::OperatorLatency> profileOperators(int32_t number = 1);
+
 private:
   const int32_t range_;
   const float32_t score_threshold_;
   const float32_t z_offset_;
+  const float32_t min_height_;
+  const float32_t max_height_;
+  const bool8_t crop_height_;
   const float32_t objectness_thresh_;
   const int32_t min_pts_num_;
   const float32_t height_thresh_;
@@ -171,24 +213,49 @@ private:
   using IET = tvm_utility::pipeline::InferenceEngineTVM;
   using PostPT = ApolloLidarSegmentationPostProcessor;
 
-  const std::shared_ptr<PrePT> PreP;
+  // The engine is created first, the pre-processor writes into its input tensor
   const std::shared_ptr<IET> IE;
+  const std::shared_ptr<PrePT> PreP;
   const std::shared_ptr<PostPT> PostP;
 
   const std::shared_ptr<tvm_utility::pipeline::Pipeline<PrePT, IET, PostPT>> pipeline;
 
-  /// \brief Move up the input pointcloud by z_offset_ and transform the pointcloud to target_frame_
-  ///        if needed.
+  /// \brief Convert the input pointcloud, transformed to target_frame_ and moved up by z_offset_,
+  ///        and cropped to the region of interest. When its x, y, z and intensity fields are
+  ///        float32, as from the lidar drivers, the points are converted, transformed and cropped
+  ///        in one pass, without an intermediate cloud.
   /// \param[in] input
   /// \param[out] transformed_cloud
   /// \throw tf2::TransformException If the pointcloud transformation fails.
   void APOLLO_LIDAR_SEGMENTATION_LOCAL transformCloud(
-    const sensor_msgs::msg::PointCloud2 & input, sensor_msgs::msg::PointCloud2 & transformed_cloud);
+    const sensor_msgs::msg::PointCloud2 & input,
+    pcl::PointCloud<pcl::PointXYZI> & transformed_cloud);
+
+  /// \brief Look up the transform from frame_id to target_frame_, unless it is the frame of the
+  ///        previous pointcloud. The lidar is mounted rigidly, so the transform does not change.
+  /// \param[in] frame_id The frame of the input pointcloud.
+  /// \throw tf2::TransformException If the transform is not available.
+  void APOLLO_LIDAR_SEGMENTATION_LOCAL updateTransform(const std::string & frame_id);
+
+  /// \brief Apply the transform of the last call to updateTransform to a point.
+  void APOLLO_LIDAR_SEGMENTATION_LOCAL transformPoint(pcl::PointXYZI & point) const;
+
+  /// \brief Whether a transformed point is in the region covered by the grid, and within the height
+  ///        limits if crop_height_ is set.
+  bool8_t APOLLO_LIDAR_SEGMENTATION_LOCAL isInRegion(const pcl::PointXYZI & point) const;
 
   rclcpp::Clock::SharedPtr clock_ = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
-  std::unique_ptr<tf2_ros::Buffer> tf_buffer_ = std::make_unique<tf2_ros::Buffer>(clock_);
+  // Buffer shared with the other nodes of the process, only taken for the first pointcloud which
+  // is not in target_frame_
+  std::shared_ptr<autoware_auto_tf2::SharedTransformBuffer> tf_buffer_;
 
   const std::string target_frame_ = "base_link";
+
+  // Transform of the points of the last frame looked up, including z_offset_
+  std::string transform_frame_id_{};
+  bool8_t transform_is_identity_{false};
+  Eigen::Matrix3f transform_rotation_{Eigen::Matrix3f::Identity()};
+  Eigen::Vector3f transform_translation_{Eigen::Vector3f::Zero()};
 };
 }  // namespace apollo_lidar_segmentation
 }  // namespace segmentation
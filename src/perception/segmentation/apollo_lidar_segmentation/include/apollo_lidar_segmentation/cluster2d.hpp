@@ -22,11 +22,13 @@
 #include <autoware_auto_msgs/msg/bounding_box_array.hpp>
 #include <autoware_auto_msgs/msg/point_clusters.hpp>
 #include <common/types.hpp>
+#include <helper_functions/worker_pool.hpp>
 
 #include <apollo_lidar_segmentation/disjoint_set.hpp>
 #include <apollo_lidar_segmentation/util.hpp>
 #include <apollo_lidar_segmentation/visibility_control.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -65,6 +67,10 @@ struct Obstacle
 
 /// \brief Handle the ouput of the CNN-based prediction by obtaining information on individual
 ///        cells.
+/// \details The graph of the cells and the obstacles are kept between frames, so that they are
+///          only allocated for the first one. The bounding boxes of the obstacles are computed on
+///          several threads, started once on construction, each obstacle by a single one, so they
+///          do not depend on the number of threads.
 class APOLLO_LIDAR_SEGMENTATION_LOCAL Cluster2D
 {
 public:
@@ -72,7 +78,8 @@ public:
   /// \param[in] rows The number of rows in the cluster.
   /// \param[in] cols The number of columns in the cluster.
   /// \param[in] range Scaling factor.
-  explicit Cluster2D(int32_t rows, int32_t cols, float32_t range);
+  /// \param[in] num_threads The number of threads computing the bounding boxes.
+  explicit Cluster2D(int32_t rows, int32_t cols, float32_t range, std::size_t num_threads = 1U);
 
   /// \brief Construct a directed graph and search the connected components for candidate object
   ///        clusters.
@@ -105,9 +112,9 @@ public:
     float32_t confidence_thresh, float32_t height_thresh, int32_t min_pts_num);
 
   /// \brief Transform an obstacle from the internal representation to the external one.
-  /// \param[in] in_obstacle
+  /// \param[inout] in_obstacle The points of its cloud are reordered by the L-shape fitting.
   /// \return Output obstacle.
-  autoware_auto_msgs::msg::BoundingBox obstacleToObject(const Obstacle & in_obstacle) const;
+  autoware_auto_msgs::msg::BoundingBox obstacleToObject(Obstacle & in_obstacle) const;
 
 private:
   const int32_t rows_;
@@ -117,38 +124,34 @@ private:
   const float32_t scale_;
   const float32_t inv_res_x_;
   const float32_t inv_res_y_;
+  common::helper_functions::WorkerPool workers_;
   std::vector<int32_t> point2grid_;
+  // only the first num_obstacles_ are the obstacles of the current frame, the others are kept to
+  // be reused
   std::vector<Obstacle> obstacles_;
+  std::size_t num_obstacles_ = 0U;
   std::vector<int32_t> id_img_;
+  std::vector<autoware_auto_msgs::msg::BoundingBox> boxes_;
 
   pcl::PointCloud<pcl::PointXYZI>::ConstPtr pc_ptr_;
   const std::vector<int32_t> * valid_indices_in_pc_ = nullptr;
 
-  /// \brief Node of a directed graph.
+  /// \brief Node of a directed graph, one per grid cell.
   struct Node
   {
-    Node * center_node;
-    Node * parent;
-    char8_t node_rank;
-    char8_t traversed;
-    bool8_t is_center;
-    bool8_t is_object;
-    int32_t point_num;
-    int32_t obstacle_id;
-
-    Node()
-    {
-      center_node = nullptr;
-      parent = nullptr;
-      node_rank = 0;
-      traversed = 0;
-      is_center = false;
-      is_object = false;
-      point_num = 0;
-      obstacle_id = -1;
-    }
+    int32_t center_node = -1;  // grid index of the node the cell points to
+    char8_t traversed = 0;
+    bool8_t is_center = false;
+    bool8_t is_object = false;
+    int32_t point_num = 0;
+    int32_t obstacle_id = -1;
   };
 
+  std::vector<Node> nodes_;
+  // sets of the nodes, by grid index, joined where center nodes are adjacent
+  DisjointSets node_sets_;
+  std::vector<int32_t> traversed_nodes_;
+
   /// \brief Check whether a signed row and column values are valid array indices.
   inline bool IsValidRowCol(int32_t row, int32_t col) const
   {
@@ -165,8 +168,8 @@ private:
   inline int32_t RowCol2Grid(int32_t row, int32_t col) const {return row * cols_ + col;}
 
   /// \brief Traverse the directed graph until visiting a node.
-  /// \param[in] x Node to visit.
-  void traverse(Node * x) const;
+  /// \param[in] x Grid index of the node to visit.
+  void traverse(int32_t x);
 };
 }  // namespace apollo_lidar_segmentation
 }  // namespace segmentation
@@ -15,6 +15,10 @@
 #ifndef APOLLO_LIDAR_SEGMENTATION__DISJOINT_SET_HPP_
 #define APOLLO_LIDAR_SEGMENTATION__DISJOINT_SET_HPP_
 
+#include <common/types.hpp>
+
+#include <vector>
+
 namespace autoware
 {
 namespace perception
@@ -23,62 +27,65 @@ namespace segmentation
 {
 namespace apollo_lidar_segmentation
 {
-/// \brief Add a new element in a new set.
-/// \param[inout] x The element to be added.
-template<class T>
-void DisjointSetMakeSet(T * x)
+using autoware::common::types::char8_t;
+
+/// \brief Disjoint sets of the elements 0, ..., n - 1, stored as flat arrays of the parent and
+///        the rank of each element, so that they can be reused without allocations.
+struct DisjointSets
 {
-  x->parent = x;
-  x->node_rank = 0;
-}
+  std::vector<int32_t> parent;
+  std::vector<char8_t> rank;
+};
 
-/// \brief Recusively follow the chain of parent pointers from the input until reaching a root.
-/// \param[inout] x The element which root is looked for.
-/// \return The root of the set containing x.
-template<class T>
-T * DisjointSetFindRecursive(T * x)
+/// \brief Add a new element in a new set.
+/// \param[inout] sets The sets, which must already have room for x.
+/// \param[in] x The element to be added.
+inline void DisjointSetMakeSet(DisjointSets & sets, const int32_t x)
 {
-  if (x->parent != x) {
-    x->parent = DisjointSetFindRecursive(x->parent);
-  }
-  return x->parent;
+  sets.parent[x] = x;
+  sets.rank[x] = 0;
 }
 
-
-/// \brief Find the root of the set x belongs to.
-/// \param[inout] x The set element.
+/// \brief Find the root of the set x belongs to, and make all elements on the way there point to
+///        the root directly.
+/// \param[inout] sets The sets.
+/// \param[in] x The set element.
 /// \return The root of the set containing x.
-template<class T>
-T * DisjointSetFind(T * x)
+inline int32_t DisjointSetFind(DisjointSets & sets, const int32_t x)
 {
-  T * y = x->parent;
-  if (y == x || y->parent == y) {
-    return y;
+  int32_t root = x;
+  while (sets.parent[root] != root) {
+    root = sets.parent[root];
+  }
+  int32_t y = x;
+  while (y != root) {
+    const int32_t next = sets.parent[y];
+    sets.parent[y] = root;
+    y = next;
   }
-  T * root = DisjointSetFindRecursive(y->parent);
-  x->parent = root;
-  y->parent = root;
   return root;
 }
 
 /// \brief Replace the set containing x and the set containing y with their union.
-/// \param[inout] x An element of a first set.
-/// \param[inout] y An element of a second set.
-template<class T>
-void DisjointSetUnion(T * x, T * y)
+/// \param[inout] sets The sets.
+/// \param[in] x An element of a first set.
+/// \param[in] y An element of a second set.
+inline void DisjointSetUnion(DisjointSets & sets, int32_t x, int32_t y)
 {
-  x = DisjointSetFind(x);
-  y = DisjointSetFind(y);
+  x = DisjointSetFind(sets, x);
+  y = DisjointSetFind(sets, y);
   if (x == y) {
     return;
   }
-  if (x->node_rank < y->node_rank) {
-    x->parent = y;
-  } else if (y->node_rank < x->node_rank) {
-    y->parent = x;
+  char8_t & x_rank = sets.rank[x];
+  char8_t & y_rank = sets.rank[y];
+  if (x_rank < y_rank) {
+    sets.parent[x] = y;
+  } else if (y_rank < x_rank) {
+    sets.parent[y] = x;
   } else {
-    y->parent = x;
-    x->node_rank++;
+    sets.parent[y] = x;
+    x_rank++;
   }
 }
 }  // namespace apollo_lidar_segmentation
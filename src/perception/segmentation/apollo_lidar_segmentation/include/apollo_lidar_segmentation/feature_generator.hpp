@@ -19,11 +19,14 @@
 #include <pcl/point_types.h>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <common/types.hpp>
+#include <helper_functions/worker_pool.hpp>
 #include <apollo_lidar_segmentation/feature_map.hpp>
 #include <apollo_lidar_segmentation/util.hpp>
 #include <apollo_lidar_segmentation/visibility_control.hpp>
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace autoware
 {
@@ -37,6 +40,11 @@ using autoware::common::types::bool8_t;
 using autoware::common::types::float32_t;
 
 /// \brief A FeatureMap generator based on channel feature information.
+/// \details The grid cell of every point is computed first. With more than one thread, the points
+///          are split between the threads for this. The cells are then updated, and normalized,
+///          by the thread of the band of grid rows they are in, in the order of the points, so
+///          the FeatureMap is the same for any number of threads. The threads are started once,
+///          on construction.
 class APOLLO_LIDAR_SEGMENTATION_LOCAL FeatureGenerator
 {
 private:
@@ -45,6 +53,15 @@ private:
   const float32_t min_height_;
   const float32_t max_height_;
   std::shared_ptr<FeatureMapInterface> map_ptr_;
+  common::helper_functions::WorkerPool workers_;
+  std::vector<int32_t> point_cells_;  // cell of every point, -1 if it is not in the grid
+
+  /// \brief Compute the cells of the points in [begin, end) of the point cloud.
+  void computeCells(
+    const pcl::PointCloud<pcl::PointXYZI> & pc, std::size_t begin, std::size_t end);
+
+  /// \brief Update and normalize the feature map in the grid rows [row_begin, row_end).
+  void updateRows(const pcl::PointCloud<pcl::PointXYZI> & pc, int32_t row_begin, int32_t row_end);
 
 public:
   /// \brief Constructor
@@ -55,9 +72,15 @@ public:
   /// \param[in] use_constant_feature Enable input channel constant feature.
   /// \param[in] min_height The minimum height.
   /// \param[in] max_height The maximum height.
+  /// \param[in] external_data Buffer to generate the FeatureMap in, see FeatureMapInterface.
+  /// \param[in] external_size The number of floats in external_data.
+  /// \param[in] num_threads The number of threads generating the FeatureMap, including the
+  ///                        calling thread.
   explicit FeatureGenerator(
     int32_t width, int32_t height, int32_t range, bool8_t use_intensity_feature,
-    bool8_t use_constant_feature, float32_t min_height, float32_t max_height);
+    bool8_t use_constant_feature, float32_t min_height, float32_t max_height,
+    float32_t * external_data = nullptr, std::size_t external_size = 0U,
+    std::size_t num_threads = 1U);
 
   /// \brief Generate a FeatureMap based on the configured features of this object.
   /// \param[in] pc_ptr Pointcloud used to populate the generated FeatureMap.
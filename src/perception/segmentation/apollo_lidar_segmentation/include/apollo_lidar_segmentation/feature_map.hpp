@@ -17,6 +17,7 @@
 
 #include <common/types.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -46,16 +47,25 @@ public:
   float32_t * mean_intensity_data;  // channnel 5
   float32_t * distance_data;        // channnel 6
   float32_t * nonempty_data;        // channnel 7
-  std::vector<float32_t> map_data;
+  std::vector<float32_t> map_data;  // storage of the channels, unless they are external
+  float32_t * data;                 // start of the channels
   virtual void initializeMap(std::vector<float32_t> & map) = 0;
   virtual void resetMap(std::vector<float32_t> & map) = 0;
-  explicit FeatureMapInterface(int32_t _channels, int32_t _width, int32_t _height, int32_t _range);
+  /// \param[in] external_data Buffer to store the channels in, e.g. the input tensor of the
+  ///                          network. It is only used if external_size matches the size of the
+  ///                          channels, otherwise they are stored in map_data.
+  /// \param[in] external_size The number of floats in external_data.
+  explicit FeatureMapInterface(
+    int32_t _channels, int32_t _width, int32_t _height, int32_t _range,
+    float32_t * external_data = nullptr, std::size_t external_size = 0U);
 };
 
 /// \brief FeatureMap with no extra feature channels.
 struct FeatureMap : public FeatureMapInterface
 {
-  explicit FeatureMap(int32_t width, int32_t height, int32_t range);
+  explicit FeatureMap(
+    int32_t width, int32_t height, int32_t range, float32_t * external_data = nullptr,
+    std::size_t external_size = 0U);
   void initializeMap(std::vector<float32_t> & map) override;
   void resetMap(std::vector<float32_t> & map) override;
 };
@@ -63,7 +73,9 @@ struct FeatureMap : public FeatureMapInterface
 /// \brief FeatureMap with an intensity feature channel.
 struct FeatureMapWithIntensity : public FeatureMapInterface
 {
-  explicit FeatureMapWithIntensity(int32_t width, int32_t height, int32_t range);
+  explicit FeatureMapWithIntensity(
+    int32_t width, int32_t height, int32_t range, float32_t * external_data = nullptr,
+    std::size_t external_size = 0U);
   void initializeMap(std::vector<float32_t> & map) override;
   void resetMap(std::vector<float32_t> & map) override;
 };
@@ -71,7 +83,9 @@ struct FeatureMapWithIntensity : public FeatureMapInterface
 /// \brief FeatureMap with a constant feature channel.
 struct FeatureMapWithConstant : public FeatureMapInterface
 {
-  explicit FeatureMapWithConstant(int32_t width, int32_t height, int32_t range);
+  explicit FeatureMapWithConstant(
+    int32_t width, int32_t height, int32_t range, float32_t * external_data = nullptr,
+    std::size_t external_size = 0U);
   void initializeMap(std::vector<float32_t> & map) override;
   void resetMap(std::vector<float32_t> & map) override;
 };
@@ -79,7 +93,9 @@ struct FeatureMapWithConstant : public FeatureMapInterface
 /// \brief FeatureMap with constant and intensity feature channels.
 struct FeatureMapWithConstantAndIntensity : public FeatureMapInterface
 {
-  explicit FeatureMapWithConstantAndIntensity(int32_t width, int32_t height, int32_t range);
+  explicit FeatureMapWithConstantAndIntensity(
+    int32_t width, int32_t height, int32_t range, float32_t * external_data = nullptr,
+    std::size_t external_size = 0U);
   void initializeMap(std::vector<float32_t> & map) override;
   void resetMap(std::vector<float32_t> & map) override;
 };
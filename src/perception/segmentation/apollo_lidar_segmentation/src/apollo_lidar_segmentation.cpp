@@ -17,8 +17,11 @@
 #include <apollo_lidar_segmentation/feature_map.hpp>
 #include <tvm_utility/model_zoo.hpp>
 #include <tvm_utility/pipeline.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 
+#include <cmath>
 #include <memory>
+#include <string>
 #include <vector>
 
 using autoware::common::types::bool8_t;
@@ -34,27 +37,44 @@ namespace segmentation
 {
 namespace apollo_lidar_segmentation
 {
+namespace
+{
+bool8_t hasFloat32Field(const sensor_msgs::msg::PointCloud2 & cloud, const std::string & name)
+{
+  for (const auto & field : cloud.fields) {
+    if (field.name == name) {
+      return (field.datatype == sensor_msgs::msg::PointField::FLOAT32) && (field.count == 1U);
+    }
+  }
+  return false;
+}
+
+// The points can be read with iterators, without a conversion to an intermediate cloud
+bool8_t hasXYZIFloat32Fields(const sensor_msgs::msg::PointCloud2 & cloud)
+{
+  return hasFloat32Field(cloud, "x") && hasFloat32Field(cloud, "y") &&
+         hasFloat32Field(cloud, "z") && hasFloat32Field(cloud, "intensity") &&
+         (cloud.row_step == cloud.width * cloud.point_step) &&
+         (cloud.data.size() >= static_cast<std::size_t>(cloud.row_step) * cloud.height);
+}
+}  // namespace
+
 ApolloLidarSegmentationPreProcessor::ApolloLidarSegmentationPreProcessor(
-  const tvm_utility::pipeline::InferenceEngineTVMConfig & config, int32_t range,
-  bool8_t use_intensity_feature, bool8_t use_constant_feature, float32_t min_height,
-  float32_t max_height)
+  const tvm_utility::pipeline::InferenceEngineTVMConfig & config,
+  const TVMArrayContainer & input_tensor, int32_t range, bool8_t use_intensity_feature,
+  bool8_t use_constant_feature, float32_t min_height, float32_t max_height,
+  std::size_t num_threads)
 : input_channels(config.network_inputs[0].second[1]),
   input_width(config.network_inputs[0].second[2]),
   input_height(config.network_inputs[0].second[3]),
   datatype_bytes(config.tvm_dtype_bits / 8),
+  output(input_tensor),
   feature_generator(std::make_shared<FeatureGenerator>(
       input_width, input_height, range,
-      use_intensity_feature, use_constant_feature, min_height, max_height))
-{
-  // Allocate input variable
-  std::vector<int64_t> shape_x{1, input_channels, input_width, input_height};
-  TVMArrayContainer x{shape_x,
-    config.tvm_dtype_code,
-    config.tvm_dtype_bits,
-    config.tvm_dtype_lanes,
-    config.tvm_device_type,
-    config.tvm_device_id};
-  output = x;
+      use_intensity_feature, use_constant_feature, min_height, max_height,
+      static_cast<float32_t *>(output.getArray()->data),
+      static_cast<std::size_t>(input_channels * input_width * input_height), num_threads))
+{
 }
 
 TVMArrayContainerVector ApolloLidarSegmentationPreProcessor::schedule(
@@ -67,9 +87,12 @@ TVMArrayContainerVector ApolloLidarSegmentationPreProcessor::schedule(
     throw std::runtime_error("schedule: incorrect feature configuration");
   }
 
-  TVMArrayCopyFromBytes(
-    output.getArray(), feature_map_ptr->map_data.data(),
-    input_channels * input_height * input_width * datatype_bytes);
+  // The feature map is only generated apart from the input tensor if it has extra channels
+  if (feature_map_ptr->data != output.getArray()->data) {
+    TVMArrayCopyFromBytes(
+      output.getArray(), feature_map_ptr->data,
+      input_channels * input_height * input_width * datatype_bytes);
+  }
 
   return {output};
 }
@@ -78,7 +101,7 @@ ApolloLidarSegmentationPostProcessor::ApolloLidarSegmentationPostProcessor(
   const tvm_utility::pipeline::InferenceEngineTVMConfig & config,
   const pcl::PointCloud<pcl::PointXYZI>::ConstPtr & pc_ptr, int32_t range,
   float32_t objectness_thresh, float32_t score_threshold, float32_t height_thresh,
-  int32_t min_pts_num)
+  int32_t min_pts_num, std::size_t num_threads)
 : output_channels(config.network_outputs[0].second[1]),
   output_width(config.network_outputs[0].second[2]),
   output_height(config.network_outputs[0].second[3]),
@@ -91,18 +114,19 @@ ApolloLidarSegmentationPostProcessor::ApolloLidarSegmentationPostProcessor(
       new float32_t[output_channels * output_width * output_height],
       std::default_delete<float32_t[]>())),
   pc_ptr_(pc_ptr),
-  cluster2d_(std::make_shared<Cluster2D>(output_width, output_height, range))
+  cluster2d_(std::make_shared<Cluster2D>(output_width, output_height, range, num_threads))
 {
 }
 
 std::shared_ptr<BoundingBoxArray> ApolloLidarSegmentationPostProcessor::schedule(
   const TVMArrayContainerVector & input)
 {
-  pcl::PointIndices valid_idx;
-  valid_idx.indices.resize(pc_ptr_->size());
-  std::iota(valid_idx.indices.begin(), valid_idx.indices.end(), 0);
+  if (valid_idx_.indices.size() != pc_ptr_->size()) {
+    valid_idx_.indices.resize(pc_ptr_->size());
+    std::iota(valid_idx_.indices.begin(), valid_idx_.indices.end(), 0);
+  }
   cluster2d_->cluster(
-    static_cast<float32_t *>(input[0].getArray()->data), pc_ptr_, valid_idx, objectness_thresh_,
+    static_cast<float32_t *>(input[0].getArray()->data), pc_ptr_, valid_idx_, objectness_thresh_,
     true /*use all grids for clustering*/);
   auto object_array = cluster2d_->getObjects(score_threshold_, height_thresh_, min_pts_num_);
 
@@ -113,72 +137,135 @@ ApolloLidarSegmentation::ApolloLidarSegmentation(
   int32_t range, float32_t score_threshold,
   bool8_t use_intensity_feature, bool8_t use_constant_feature, float32_t z_offset,
   float32_t min_height, float32_t max_height, float32_t objectness_thresh, int32_t min_pts_num,
-  float32_t height_thresh)
+  float32_t height_thresh, std::size_t num_threads, float64_t latency_budget_ms,
+  bool8_t crop_height, bool8_t profile_operators)
 : range_(range),
   score_threshold_(score_threshold),
   z_offset_(z_offset),
+  min_height_(min_height),
+  max_height_(max_height),
+  crop_height_(crop_height),
   objectness_thresh_(objectness_thresh),
   min_pts_num_(min_pts_num),
   height_thresh_(height_thresh),
   pcl_pointcloud_ptr_(new pcl::PointCloud<pcl::PointXYZI>),
+  IE(std::make_shared<IET>(
+      tvm_utility::pipeline::find_network_variants(config, {"fp16", "int8"}), latency_budget_ms,
+      1U, profile_operators)),
   PreP(std::make_shared<PrePT>(
-      config, range, use_intensity_feature, use_constant_feature, min_height, max_height)),
-  IE(std::make_shared<IET>(config)),
+      IE->getConfig(), IE->getInputs()[0], range, use_intensity_feature, use_constant_feature,
+      min_height, max_height, num_threads)),
   PostP(std::make_shared<PostPT>(
-      config, pcl_pointcloud_ptr_, range, objectness_thresh, score_threshold, height_thresh,
-      min_pts_num)),
+      IE->getConfig(), pcl_pointcloud_ptr_, range, objectness_thresh, score_threshold,
+      height_thresh, min_pts_num, num_threads)),
   pipeline(std::make_shared<tvm_utility::pipeline::Pipeline<PrePT, IET, PostPT>>(
       *PreP, *IE, *PostP))
 {
 }
 
+void ApolloLidarSegmentation::updateTransform(const std::string & frame_id)
+{
+  if (frame_id == transform_frame_id_) {
+    return;
+  }
+
+  // transform pointcloud to target_frame
+  Eigen::Matrix3f rotation = Eigen::Matrix3f::Identity();
+  Eigen::Vector3f translation = Eigen::Vector3f::Zero();
+  if (target_frame_ != frame_id) {
+    if (!tf_buffer_) {
+      tf_buffer_ = autoware_auto_tf2::SharedTransformBuffer::get(clock_);
+    }
+    const Eigen::Matrix4f affine_matrix = tf2::transformToEigen(
+      tf_buffer_->lookup_latest_transform(target_frame_, frame_id)).matrix().cast<float32_t>();
+    rotation = affine_matrix.topLeftCorner<3, 3>();
+    translation = affine_matrix.topRightCorner<3, 1>();
+  }
+
+  // move pointcloud z_offset in z axis
+  translation.z() += z_offset_;
+
+  transform_is_identity_ = (target_frame_ == frame_id) && (z_offset_ == 0);
+  transform_rotation_ = rotation;
+  transform_translation_ = translation;
+  transform_frame_id_ = frame_id;
+}
+
 void ApolloLidarSegmentation::transformCloud(
   const sensor_msgs::msg::PointCloud2 & input,
-  sensor_msgs::msg::PointCloud2 & transformed_cloud)
+  pcl::PointCloud<pcl::PointXYZI> & transformed_cloud)
 {
-  if (target_frame_ == input.header.frame_id && z_offset_ == 0) {
-    transformed_cloud = input;
+  updateTransform(input.header.frame_id);
+  std::size_t num_kept = 0U;
+  if (hasXYZIFloat32Fields(input)) {
+    // Convert and transform in a single pass over the points, into the storage of the previous
+    // pointcloud
+    pcl_conversions::toPCL(input.header, transformed_cloud.header);
+    const std::size_t num_points = static_cast<std::size_t>(input.width) * input.height;
+    transformed_cloud.points.resize(num_points);
+    sensor_msgs::PointCloud2ConstIterator<float32_t> x_it(input, "x");
+    sensor_msgs::PointCloud2ConstIterator<float32_t> y_it(input, "y");
+    sensor_msgs::PointCloud2ConstIterator<float32_t> z_it(input, "z");
+    sensor_msgs::PointCloud2ConstIterator<float32_t> intensity_it(input, "intensity");
+    for (std::size_t i = 0U; i < num_points; ++i) {
+      // The point is overwritten by the next one if it is outside of the region of interest
+      auto & point = transformed_cloud.points[num_kept];
+      point.x = *x_it;
+      point.y = *y_it;
+      point.z = *z_it;
+      point.intensity = *intensity_it;
+      ++x_it;
+      ++y_it;
+      ++z_it;
+      ++intensity_it;
+      transformPoint(point);
+      if (isInRegion(point)) {
+        ++num_kept;
+      }
+    }
   } else {
-    pcl::PointCloud<pcl::PointXYZI> in_cluster, transformed_cloud_cluster;
-    pcl::fromROSMsg(input, in_cluster);
-
-    // transform pointcloud to target_frame
-    if (target_frame_ != input.header.frame_id) {
-      geometry_msgs::msg::TransformStamped transform_stamped;
-      builtin_interfaces::msg::Time time_stamp = input.header.stamp;
-      const tf2::TimePoint time_point = tf2::TimePoint(
-        std::chrono::seconds(
-          time_stamp.sec) + std::chrono::nanoseconds(time_stamp.nanosec));
-      transform_stamped =
-        tf_buffer_->lookupTransform(target_frame_, input.header.frame_id, time_point);
-      Eigen::Matrix4f affine_matrix =
-        tf2::transformToEigen(transform_stamped.transform).matrix().cast<float32_t>();
-      pcl::transformPointCloud(in_cluster, transformed_cloud_cluster, affine_matrix);
-      transformed_cloud_cluster.header.frame_id = target_frame_;
-    } else {
-      transformed_cloud_cluster = in_cluster;
+    pcl::fromROSMsg(input, transformed_cloud);
+    for (const auto & input_point : transformed_cloud.points) {
+      auto & point = transformed_cloud.points[num_kept];
+      point = input_point;
+      transformPoint(point);
+      if (isInRegion(point)) {
+        ++num_kept;
+      }
     }
+  }
+  transformed_cloud.points.resize(num_kept);
+  transformed_cloud.width = static_cast<uint32_t>(num_kept);
+  transformed_cloud.height = 1U;
+  transformed_cloud.is_dense = true;
+  transformed_cloud.header.frame_id = target_frame_;
+}
 
-    // move pointcloud z_offset in z axis
-    if (z_offset_ != 0) {
-      Eigen::Affine3f z_up_translation(Eigen::Translation3f(0, 0, z_offset_));
-      Eigen::Matrix4f z_up_transform = z_up_translation.matrix();
-      pcl::transformPointCloud(
-        transformed_cloud_cluster, transformed_cloud_cluster, z_up_transform);
-    }
+bool8_t ApolloLidarSegmentation::isInRegion(const pcl::PointXYZI & point) const
+{
+  // The points outside of the grid are not used by the pre- or post-processing. A margin of a
+  // meter makes sure that the rounding of the cell computation cannot put a cropped point in the
+  // grid. Non-finite points are cropped as well.
+  const float32_t limit = static_cast<float32_t>(range_) + 1.0F;
+  return (-limit <= point.x) && (point.x <= limit) && (-limit <= point.y) && (point.y <= limit) &&
+         (!crop_height_ || ((min_height_ < point.z) && (point.z < max_height_)));
+}
 
-    pcl::toROSMsg(transformed_cloud_cluster, transformed_cloud);
+void ApolloLidarSegmentation::transformPoint(pcl::PointXYZI & point) const
+{
+  // Non-finite points are left as they are, like pcl::transformPointCloud does
+  if (!transform_is_identity_ &&
+    std::isfinite(point.x) && std::isfinite(point.y) && std::isfinite(point.z))
+  {
+    point.getVector3fMap() = transform_rotation_ * point.getVector3fMap() + transform_translation_;
   }
 }
 
 std::shared_ptr<const BoundingBoxArray> ApolloLidarSegmentation::detectDynamicObjects(
   const sensor_msgs::msg::PointCloud2 & input)
 {
-  // move up pointcloud z_offset in z axis
-  sensor_msgs::msg::PointCloud2 transformed_cloud;
-  ApolloLidarSegmentation::transformCloud(input, transformed_cloud);
-  // convert from ros to pcl
-  pcl::fromROSMsg(transformed_cloud, *pcl_pointcloud_ptr_);
+  // convert from ros to pcl, in target_frame and moved up by z_offset in z axis
+  transformCloud(input, *pcl_pointcloud_ptr_);
 
   // inference pipeline
   auto output = pipeline->schedule(pcl_pointcloud_ptr_);
@@ -186,6 +273,23 @@ std::shared_ptr<const BoundingBoxArray> ApolloLidarSegmentation::detectDynamicOb
 
   return output;
 }
+
+void ApolloLidarSegmentation::enableProfiling()
+{
+  pipeline->enableProfiling();
+}
+
+const tvm_utility::pipeline::PipelineProfile * ApolloLidarSegmentation::getProfile() const
+{
+  return pipeline->getProfile();
+}
+
+std::vector<tvm_utility::pipeline::OperatorLatency> ApolloLidarSegmentation::profileOperators(
+  const int32_t number)
+{
+  // The engine of the pipeline is a copy of IE, which shares its runtime and so its inputs
+  return IE->profileOperators(number);
+}
 }  // namespace apollo_lidar_segmentation
 }  // namespace segmentation
 }  // namespace perception
@@ -37,38 +37,43 @@ namespace segmentation
 {
 namespace apollo_lidar_segmentation
 {
-Cluster2D::Cluster2D(const int32_t rows, const int32_t cols, const float32_t range)
+Cluster2D::Cluster2D(
+  const int32_t rows, const int32_t cols, const float32_t range, const std::size_t num_threads)
 : rows_(rows), cols_(cols), siz_(rows * cols), range_(range),
   scale_(0.5f * static_cast<float32_t>(rows) / range),
   inv_res_x_(0.5f * static_cast<float32_t>(cols) / range),
-  inv_res_y_(0.5f * static_cast<float32_t>(rows) / range)
+  inv_res_y_(0.5f * static_cast<float32_t>(rows) / range),
+  workers_(std::max(num_threads, std::size_t{1U}))
 {
   point2grid_.clear();
   id_img_.assign(siz_, -1);
+  nodes_.resize(siz_);
+  node_sets_.parent.resize(siz_);
+  node_sets_.rank.resize(siz_);
   pc_ptr_.reset();
   valid_indices_in_pc_ = nullptr;
 }
 
-void Cluster2D::traverse(Node * x) const
+void Cluster2D::traverse(int32_t x)
 {
-  std::vector<Node *> p;
+  std::vector<int32_t> & p = traversed_nodes_;
   p.clear();
 
-  while (x->traversed == 0) {
+  while (nodes_[x].traversed == 0) {
     p.push_back(x);
-    x->traversed = 2;
-    x = x->center_node;
+    nodes_[x].traversed = 2;
+    x = nodes_[x].center_node;
   }
-  if (x->traversed == 2) {
+  if (nodes_[x].traversed == 2) {
     for (int i = static_cast<int>(p.size()) - 1; i >= 0 && p[i] != x; i--) {
-      p[i]->is_center = true;
+      nodes_[p[i]].is_center = true;
     }
-    x->is_center = true;
+    nodes_[x].is_center = true;
   }
   for (size_t i = 0; i < p.size(); i++) {
-    Node * y = p[i];
-    y->traversed = 1;
-    y->parent = x->parent;
+    const int32_t y = p[i];
+    nodes_[y].traversed = 1;
+    node_sets_.parent[y] = node_sets_.parent[x];
   }
 }
 
@@ -84,7 +89,9 @@ void Cluster2D::cluster(
 
   pc_ptr_ = pc_ptr;
 
-  std::vector<std::vector<Node>> nodes(rows_, std::vector<Node>(cols_, Node()));
+  for (Node & node : nodes_) {
+    node.point_num = 0;
+  }
 
   valid_indices_in_pc_ = &(valid_indices.indices);
   point2grid_.assign(valid_indices_in_pc_->size(), -1);
@@ -99,16 +106,19 @@ void Cluster2D::cluster(
     int32_t pos_y = F2I(point.x, range_, inv_res_y_);  // row
     if (IsValidRowCol(pos_y, pos_x)) {
       point2grid_[i] = RowCol2Grid(pos_y, pos_x);
-      nodes[pos_y][pos_x].point_num++;
+      nodes_[RowCol2Grid(pos_y, pos_x)].point_num++;
     }
   }
 
   for (int32_t row = 0; row < rows_; ++row) {
     for (int32_t col = 0; col < cols_; ++col) {
       int32_t grid = RowCol2Grid(row, col);
-      Node * node = &nodes[row][col];
-      DisjointSetMakeSet(node);
-      node->is_object = (use_all_grids_for_clustering || nodes[row][col].point_num > 0) &&
+      Node * node = &nodes_[grid];
+      DisjointSetMakeSet(node_sets_, grid);
+      node->traversed = 0;
+      node->is_center = false;
+      node->obstacle_id = -1;
+      node->is_object = (use_all_grids_for_clustering || node->point_num > 0) &&
         (*(category_pt_data + grid) >= objectness_thresh);
       int32_t center_row = row +
         static_cast<int32_t>(std::round(instance_pt_x_data[grid] * scale_));
@@ -116,31 +126,28 @@ void Cluster2D::cluster(
         static_cast<int32_t>(std::round(instance_pt_y_data[grid] * scale_));
       center_row = std::min(std::max(center_row, 0), rows_ - 1);
       center_col = std::min(std::max(center_col, 0), cols_ - 1);
-      node->center_node = &nodes[center_row][center_col];
+      node->center_node = RowCol2Grid(center_row, center_col);
     }
   }
 
-  for (int32_t row = 0; row < rows_; ++row) {
-    for (int32_t col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (node->is_object && node->traversed == 0) {
-        traverse(node);
-      }
+  for (int32_t grid = 0; grid < siz_; ++grid) {
+    if (nodes_[grid].is_object && nodes_[grid].traversed == 0) {
+      traverse(grid);
     }
   }
 
   for (int32_t row = 0; row < rows_; ++row) {
     for (int32_t col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (!node->is_center) {
+      const int32_t grid = RowCol2Grid(row, col);
+      if (!nodes_[grid].is_center) {
         continue;
       }
       for (int32_t row2 = row - 1; row2 <= row + 1; ++row2) {
         for (int32_t col2 = col - 1; col2 <= col + 1; ++col2) {
           if ((row2 == row || col2 == col) && IsValidRowCol(row2, col2)) {
-            Node * node2 = &nodes[row2][col2];
-            if (node2->is_center) {
-              DisjointSetUnion(node, node2);
+            const int32_t grid2 = RowCol2Grid(row2, col2);
+            if (nodes_[grid2].is_center) {
+              DisjointSetUnion(node_sets_, grid, grid2);
             }
           }
         }
@@ -148,24 +155,29 @@ void Cluster2D::cluster(
     }
   }
 
-  int32_t count_obstacles = 0;
-  obstacles_.clear();
+  num_obstacles_ = 0U;
   id_img_.assign(siz_, -1);
-  for (int32_t row = 0; row < rows_; ++row) {
-    for (int32_t col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (!node->is_object) {
-        continue;
-      }
-      Node * root = DisjointSetFind(node);
-      if (root->obstacle_id < 0) {
-        root->obstacle_id = count_obstacles++;
-        obstacles_.push_back(Obstacle());
+  for (int32_t grid = 0; grid < siz_; ++grid) {
+    if (!nodes_[grid].is_object) {
+      continue;
+    }
+    Node * root = &nodes_[DisjointSetFind(node_sets_, grid)];
+    if (root->obstacle_id < 0) {
+      root->obstacle_id = static_cast<int32_t>(num_obstacles_++);
+      // The obstacles of previous frames are reused, with their allocated memory
+      if (obstacles_.size() < num_obstacles_) {
+        obstacles_.emplace_back();
       }
-      int32_t grid = RowCol2Grid(row, col);
-      id_img_[grid] = root->obstacle_id;
-      obstacles_[root->obstacle_id].grids.push_back(grid);
+      Obstacle & obs = obstacles_[root->obstacle_id];
+      obs.grids.clear();
+      obs.cloud_ptr->clear();
+      obs.score = 0.0f;
+      obs.height = -5.0f;
+      obs.meta_type = MetaType::META_UNKNOWN;
+      std::fill(obs.meta_type_probs.begin(), obs.meta_type_probs.end(), 0.0f);
     }
+    id_img_[grid] = root->obstacle_id;
+    obstacles_[root->obstacle_id].grids.push_back(grid);
   }
   filter(inferred_data);
   classify(inferred_data);
@@ -176,7 +188,7 @@ void Cluster2D::filter(const float32_t * inferred_data)
   const float32_t * confidence_pt_data = inferred_data + siz_ * 3;
   const float32_t * height_pt_data = inferred_data + siz_ * 11;
 
-  for (size_t obstacle_id = 0; obstacle_id < obstacles_.size(); obstacle_id++) {
+  for (size_t obstacle_id = 0; obstacle_id < num_obstacles_; obstacle_id++) {
     Obstacle * obs = &obstacles_[obstacle_id];
     float64_t score = 0.0;
     float64_t height = 0.0;
@@ -186,7 +198,6 @@ void Cluster2D::filter(const float32_t * inferred_data)
     }
     obs->score = static_cast<float32_t>(score / static_cast<float64_t>(obs->grids.size()));
     obs->height = static_cast<float32_t>(height / static_cast<float64_t>(obs->grids.size()));
-    obs->cloud_ptr.reset(new pcl::PointCloud<pcl::PointXYZI>);
   }
 }
 
@@ -194,7 +205,7 @@ void Cluster2D::classify(const float32_t * inferred_data)
 {
   const float32_t * classify_pt_data = inferred_data + siz_ * 4;
   int num_classes = static_cast<int>(MetaType::MAX_META_TYPE);
-  for (size_t obs_id = 0; obs_id < obstacles_.size(); obs_id++) {
+  for (size_t obs_id = 0; obs_id < num_obstacles_; obs_id++) {
     Obstacle * obs = &obstacles_[obs_id];
 
     for (size_t grid_id = 0; grid_id < obs->grids.size(); grid_id++) {
@@ -214,9 +225,9 @@ void Cluster2D::classify(const float32_t * inferred_data)
   }
 }
 
-autoware_auto_msgs::msg::BoundingBox Cluster2D::obstacleToObject(const Obstacle & in_obstacle) const
+autoware_auto_msgs::msg::BoundingBox Cluster2D::obstacleToObject(Obstacle & in_obstacle) const
 {
-  auto in_points = in_obstacle.cloud_ptr->points;
+  auto & in_points = in_obstacle.cloud_ptr->points;
 
   autoware_auto_msgs::msg::BoundingBox resulting_object =
     common::geometry::bounding_box::lfit_bounding_box_2d(in_points.begin(), in_points.end());
@@ -262,13 +273,21 @@ std::shared_ptr<autoware_auto_msgs::msg::BoundingBoxArray> Cluster2D::getObjects
     }
   }
 
-  for (size_t obstacle_id = 0; obstacle_id < obstacles_.size(); obstacle_id++) {
-    Obstacle * obs = &obstacles_[obstacle_id];
-    if (static_cast<int>(obs->cloud_ptr->size()) < min_pts_num) {
-      continue;
+  // The boxes are computed in parallel, and then output in the order of the obstacles
+  boxes_.resize(std::max(boxes_.size(), num_obstacles_));
+  // The obstacles are claimed one at a time, since their sizes vary a lot
+  workers_.run(
+    num_obstacles_, [this, min_pts_num](const std::size_t obstacle_id, const std::size_t) {
+      Obstacle & obs = obstacles_[obstacle_id];
+      if (static_cast<int>(obs.cloud_ptr->size()) >= min_pts_num) {
+        boxes_[obstacle_id] = obstacleToObject(obs);
+      }
+    });
+
+  for (size_t obstacle_id = 0; obstacle_id < num_obstacles_; obstacle_id++) {
+    if (static_cast<int>(obstacles_[obstacle_id].cloud_ptr->size()) >= min_pts_num) {
+      object_array->boxes.push_back(boxes_[obstacle_id]);
     }
-    autoware_auto_msgs::msg::BoundingBox out_obj = obstacleToObject(*obs);
-    object_array->boxes.push_back(out_obj);
   }
 
   return object_array;
@@ -16,6 +16,8 @@
 #include <apollo_lidar_segmentation/log_table.hpp>
 #include <common/types.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -34,26 +36,58 @@ namespace apollo_lidar_segmentation
 namespace
 {
 inline float32_t normalizeIntensity(float32_t intensity) {return intensity / 255;}
+
+/// \brief The grid and the height interval the points are projected on.
+struct Grid
+{
+  float32_t range;
+  float32_t inv_res_x;
+  float32_t inv_res_y;
+  int32_t width;
+  int32_t height;
+  float32_t min_height;
+  float32_t max_height;
+};
+
+inline int32_t computeCell(const Grid & grid, const pcl::PointXYZI & pt)
+{
+  // x on grid
+  const float32_t pos_x = std::floor((grid.range - pt.y) * grid.inv_res_x);
+  // y on grid
+  const float32_t pos_y = std::floor((grid.range - pt.x) * grid.inv_res_y);
+  // Written with comparisons only, so that a NaN point is not in the grid either
+  const bool8_t in_grid = (grid.min_height < pt.z) && (pt.z < grid.max_height) &&
+    (pos_x >= 0.0f) && (pos_x < static_cast<float32_t>(grid.width)) &&
+    (pos_y >= 0.0f) && (pos_y < static_cast<float32_t>(grid.height));
+  return in_grid ?
+         (static_cast<int32_t>(pos_y) * grid.width + static_cast<int32_t>(pos_x)) : -1;
+}
 }  // namespace
 
 FeatureGenerator::FeatureGenerator(
   const int32_t width, const int32_t height, const int32_t range,
   const bool8_t use_intensity_feature, const bool8_t use_constant_feature,
-  const float32_t min_height, const float32_t max_height)
+  const float32_t min_height, const float32_t max_height,
+  float32_t * const external_data, const std::size_t external_size,
+  const std::size_t num_threads)
 : use_intensity_feature_(use_intensity_feature),
   use_constant_feature_(use_constant_feature),
   min_height_(min_height),
-  max_height_(max_height)
+  max_height_(max_height),
+  workers_(std::max(std::min(num_threads, static_cast<std::size_t>(height)), std::size_t{1U}))
 {
   // select feature map type
   if (use_constant_feature && use_intensity_feature) {
-    map_ptr_ = std::make_shared<FeatureMapWithConstantAndIntensity>(width, height, range);
+    map_ptr_ = std::make_shared<FeatureMapWithConstantAndIntensity>(
+      width, height, range, external_data, external_size);
   } else if (use_constant_feature) {
-    map_ptr_ = std::make_shared<FeatureMapWithConstant>(width, height, range);
+    map_ptr_ = std::make_shared<FeatureMapWithConstant>(
+      width, height, range, external_data, external_size);
   } else if (use_intensity_feature) {
-    map_ptr_ = std::make_shared<FeatureMapWithIntensity>(width, height, range);
+    map_ptr_ = std::make_shared<FeatureMapWithIntensity>(
+      width, height, range, external_data, external_size);
   } else {
-    map_ptr_ = std::make_shared<FeatureMap>(width, height, range);
+    map_ptr_ = std::make_shared<FeatureMap>(width, height, range, external_data, external_size);
   }
   map_ptr_->initializeMap(map_ptr_->map_data);
 }
@@ -61,45 +95,75 @@ FeatureGenerator::FeatureGenerator(
 std::shared_ptr<FeatureMapInterface> FeatureGenerator::generate(
   const pcl::PointCloud<pcl::PointXYZI>::ConstPtr & pc_ptr)
 {
-  const float64_t epsilon = 1e-6;
   map_ptr_->resetMap(map_ptr_->map_data);
 
-  const int32_t size = map_ptr_->height * map_ptr_->width;
+  const std::size_t num_points = pc_ptr->points.size();
+  // Only allocates when there are more points than in any cloud before
+  point_cells_.resize(std::max(point_cells_.size(), num_points));
+
+  const std::size_t num_threads = workers_.get_num_workers();
+  if (num_threads == 1U) {
+    computeCells(*pc_ptr, 0U, num_points);
+    updateRows(*pc_ptr, 0, map_ptr_->height);
+    return map_ptr_;
+  }
 
-  const float32_t inv_res_x = 0.5f * map_ptr_->width / map_ptr_->range;
-  const float32_t inv_res_y = 0.5f * map_ptr_->height / map_ptr_->range;
+  const pcl::PointCloud<pcl::PointXYZI> & pc = *pc_ptr;
+  workers_.run(
+    num_threads, [this, &pc](const std::size_t part, const std::size_t) {
+      const std::size_t num_parts = workers_.get_num_workers();
+      computeCells(
+        pc, pc.points.size() * part / num_parts, pc.points.size() * (part + 1U) / num_parts);
+    });
+  workers_.run(
+    num_threads, [this, &pc](const std::size_t part, const std::size_t) {
+      const std::size_t num_parts = workers_.get_num_workers();
+      const auto height = static_cast<std::size_t>(map_ptr_->height);
+      updateRows(
+        pc, static_cast<int32_t>(height * part / num_parts),
+        static_cast<int32_t>(height * (part + 1U) / num_parts));
+    });
+  return map_ptr_;
+}
 
-  for (size_t i = 0; i < pc_ptr->points.size(); ++i) {
-    if (pc_ptr->points[i].z <= min_height_ || max_height_ <= pc_ptr->points[i].z) {continue;}
+void FeatureGenerator::computeCells(
+  const pcl::PointCloud<pcl::PointXYZI> & pc, const std::size_t begin, const std::size_t end)
+{
+  const Grid grid{
+    static_cast<float32_t>(map_ptr_->range),
+    0.5f * map_ptr_->width / map_ptr_->range,
+    0.5f * map_ptr_->height / map_ptr_->range,
+    map_ptr_->width, map_ptr_->height, min_height_, max_height_};
+  for (std::size_t i = begin; i < end; ++i) {
+    point_cells_[i] = computeCell(grid, pc.points[i]);
+  }
+}
 
-    // x on grid
-    const int32_t pos_x =
-      static_cast<int32_t>(std::floor(
-        (static_cast<float32_t>(map_ptr_->range) -
-        pc_ptr->points[i].y) * inv_res_x));
-    // y on grid
-    const int32_t pos_y =
-      static_cast<int32_t>(std::floor(
-        (static_cast<float32_t>(map_ptr_->range) -
-        pc_ptr->points[i].x) * inv_res_y));
-    if (pos_x < 0 || map_ptr_->width <= pos_x || pos_y < 0 || map_ptr_->height <= pos_y) {continue;}
+void FeatureGenerator::updateRows(
+  const pcl::PointCloud<pcl::PointXYZI> & pc, const int32_t row_begin, const int32_t row_end)
+{
+  const float64_t epsilon = 1e-6;
+  const int32_t cell_begin = row_begin * map_ptr_->width;
+  const int32_t cell_end = row_end * map_ptr_->width;
 
-    const int32_t idx = pos_y * map_ptr_->width + pos_x;
+  for (size_t i = 0; i < pc.points.size(); ++i) {
+    const int32_t idx = point_cells_[i];
+    if (idx < cell_begin || cell_end <= idx) {continue;}
 
-    if (map_ptr_->max_height_data[idx] < pc_ptr->points[i].z) {
-      map_ptr_->max_height_data[idx] = pc_ptr->points[i].z;
+    if (map_ptr_->max_height_data[idx] < pc.points[i].z) {
+      map_ptr_->max_height_data[idx] = pc.points[i].z;
       if (map_ptr_->top_intensity_data != nullptr) {
-        map_ptr_->top_intensity_data[idx] = normalizeIntensity(pc_ptr->points[i].intensity);
+        map_ptr_->top_intensity_data[idx] = normalizeIntensity(pc.points[i].intensity);
       }
     }
-    map_ptr_->mean_height_data[idx] += pc_ptr->points[i].z;
+    map_ptr_->mean_height_data[idx] += pc.points[i].z;
     if (map_ptr_->mean_intensity_data != nullptr) {
-      map_ptr_->mean_intensity_data[idx] += normalizeIntensity(pc_ptr->points[i].intensity);
+      map_ptr_->mean_intensity_data[idx] += normalizeIntensity(pc.points[i].intensity);
     }
     map_ptr_->count_data[idx] += 1.0f;
   }
 
-  for (int32_t i = 0; i < size; ++i) {
+  for (int32_t i = cell_begin; i < cell_end; ++i) {
     if (static_cast<float64_t>(map_ptr_->count_data[i]) < epsilon) {
       map_ptr_->max_height_data[i] = 0.0f;
     } else {
@@ -111,7 +175,6 @@ std::shared_ptr<FeatureMapInterface> FeatureGenerator::generate(
     }
     map_ptr_->count_data[i] = calcApproximateLog(map_ptr_->count_data[i]);
   }
-  return map_ptr_;
 }
 }  // namespace apollo_lidar_segmentation
 }  // namespace segmentation
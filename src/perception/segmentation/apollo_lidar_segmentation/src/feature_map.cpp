@@ -30,7 +30,8 @@ namespace segmentation
 namespace apollo_lidar_segmentation
 {
 FeatureMapInterface::FeatureMapInterface(
-  const int32_t _channels, const int32_t _width, const int32_t _height, const int32_t _range)
+  const int32_t _channels, const int32_t _width, const int32_t _height, const int32_t _range,
+  float32_t * const external_data, const std::size_t external_size)
 : channels(_channels),
   width(_width),
   height(_height),
@@ -42,18 +43,25 @@ FeatureMapInterface::FeatureMapInterface(
   top_intensity_data(nullptr),
   mean_intensity_data(nullptr),
   distance_data(nullptr),
-  nonempty_data(nullptr)
+  nonempty_data(nullptr),
+  data(external_data)
 {
-  map_data.resize(width * height * channels);
+  const auto size = static_cast<std::size_t>(width * height * channels);
+  if ((data == nullptr) || (external_size != size)) {
+    map_data.resize(size);
+    data = map_data.data();
+  }
 }
 
-FeatureMap::FeatureMap(const int32_t width, const int32_t height, const int32_t range)
-: FeatureMapInterface(4, width, height, range)
-{
-  max_height_data = &(map_data[0]) + width * height * 0;
-  mean_height_data = &(map_data[0]) + width * height * 1;
-  count_data = &(map_data[0]) + width * height * 2;
-  nonempty_data = &(map_data[0]) + width * height * 3;
+FeatureMap::FeatureMap(
+  const int32_t width, const int32_t height, const int32_t range,
+  float32_t * const external_data, const std::size_t external_size)
+: FeatureMapInterface(4, width, height, range, external_data, external_size)
+{
+  max_height_data = data + width * height * 0;
+  mean_height_data = data + width * height * 1;
+  count_data = data + width * height * 2;
+  nonempty_data = data + width * height * 3;
 }
 void FeatureMap::initializeMap(std::vector<float32_t> & map)
 {
@@ -72,16 +80,16 @@ void FeatureMap::resetMap(std::vector<float32_t> & map)
 }
 
 FeatureMapWithIntensity::FeatureMapWithIntensity(
-  const int32_t width, const int32_t height,
-  const int32_t range)
-: FeatureMapInterface(6, width, height, range)
-{
-  max_height_data = &(map_data[0]) + width * height * 0;
-  mean_height_data = &(map_data[0]) + width * height * 1;
-  count_data = &(map_data[0]) + width * height * 2;
-  top_intensity_data = &(map_data[0]) + width * height * 3;
-  mean_intensity_data = &(map_data[0]) + width * height * 4;
-  nonempty_data = &(map_data[0]) + width * height * 5;
+  const int32_t width, const int32_t height, const int32_t range,
+  float32_t * const external_data, const std::size_t external_size)
+: FeatureMapInterface(6, width, height, range, external_data, external_size)
+{
+  max_height_data = data + width * height * 0;
+  mean_height_data = data + width * height * 1;
+  count_data = data + width * height * 2;
+  top_intensity_data = data + width * height * 3;
+  mean_intensity_data = data + width * height * 4;
+  nonempty_data = data + width * height * 5;
 }
 void FeatureMapWithIntensity::initializeMap(std::vector<float32_t> & map)
 {
@@ -102,16 +110,16 @@ void FeatureMapWithIntensity::resetMap(std::vector<float32_t> & map)
 }
 
 FeatureMapWithConstant::FeatureMapWithConstant(
-  const int32_t width, const int32_t height,
-  const int32_t range)
-: FeatureMapInterface(6, width, height, range)
-{
-  max_height_data = &(map_data[0]) + width * height * 0;
-  mean_height_data = &(map_data[0]) + width * height * 1;
-  count_data = &(map_data[0]) + width * height * 2;
-  direction_data = &(map_data[0]) + width * height * 3;
-  distance_data = &(map_data[0]) + width * height * 4;
-  nonempty_data = &(map_data[0]) + width * height * 5;
+  const int32_t width, const int32_t height, const int32_t range,
+  float32_t * const external_data, const std::size_t external_size)
+: FeatureMapInterface(6, width, height, range, external_data, external_size)
+{
+  max_height_data = data + width * height * 0;
+  mean_height_data = data + width * height * 1;
+  count_data = data + width * height * 2;
+  direction_data = data + width * height * 3;
+  distance_data = data + width * height * 4;
+  nonempty_data = data + width * height * 5;
 }
 void FeatureMapWithConstant::initializeMap(std::vector<float32_t> & map)
 {
@@ -145,17 +153,18 @@ void FeatureMapWithConstant::resetMap(std::vector<float32_t> & map)
 }
 
 FeatureMapWithConstantAndIntensity::FeatureMapWithConstantAndIntensity(
-  const int32_t width, const int32_t height, const int32_t range)
-: FeatureMapInterface(8, width, height, range)
-{
-  max_height_data = &(map_data[0]) + width * height * 0;
-  mean_height_data = &(map_data[0]) + width * height * 1;
-  count_data = &(map_data[0]) + width * height * 2;
-  direction_data = &(map_data[0]) + width * height * 3;
-  top_intensity_data = &(map_data[0]) + width * height * 4;
-  mean_intensity_data = &(map_data[0]) + width * height * 5;
-  distance_data = &(map_data[0]) + width * height * 6;
-  nonempty_data = &(map_data[0]) + width * height * 7;
+  const int32_t width, const int32_t height, const int32_t range,
+  float32_t * const external_data, const std::size_t external_size)
+: FeatureMapInterface(8, width, height, range, external_data, external_size)
+{
+  max_height_data = data + width * height * 0;
+  mean_height_data = data + width * height * 1;
+  count_data = data + width * height * 2;
+  direction_data = data + width * height * 3;
+  top_intensity_data = data + width * height * 4;
+  mean_intensity_data = data + width * height * 5;
+  distance_data = data + width * height * 6;
+  nonempty_data = data + width * height * 7;
 }
 void FeatureMapWithConstantAndIntensity::initializeMap(std::vector<float32_t> & map)
 {
@@ -18,6 +18,7 @@
 #include <apollo_lidar_segmentation/apollo_lidar_segmentation.hpp>
 #include <tvm_utility/pipeline.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <random>
 #include <string>
@@ -27,24 +28,8 @@ using autoware::common::types::float32_t;
 using autoware::common::types::uchar8_t;
 using autoware::perception::segmentation::apollo_lidar_segmentation::ApolloLidarSegmentation;
 
-void test_segmentation(bool use_intensity_feature, bool use_constant_feature, bool expect_throw)
+sensor_msgs::msg::PointCloud2 make_random_cloud(const int width, const int height)
 {
-  // Instantiate the pipeline
-  const int width = 1;
-  const int height = 10000;
-  const int range = 70;
-  const float score_threshold = 0.8f;
-  const float z_offset = 1.0f;
-  const float32_t min_height = -5.0f;
-  const float32_t max_height = 5.0f;
-  const float32_t objectness_thresh = 0.5f;
-  const int32_t min_pts_num = 3;
-  const float32_t height_thresh = 0.5f;
-  ApolloLidarSegmentation segmentation(range, score_threshold, use_intensity_feature,
-    use_constant_feature, z_offset, min_height, max_height, objectness_thresh, min_pts_num,
-    height_thresh);
-
-  std::random_device rd;
   std::mt19937 gen(42);
   std::uniform_real_distribution<float32_t> dis(-50.0, 50.0);
   std::vector<uchar8_t> v(width * height * sizeof(float32_t) * 4);
@@ -71,11 +56,35 @@ void test_segmentation(bool use_intensity_feature, bool use_constant_feature, bo
   input.row_step = input.point_step * input.width;
   input.is_dense = false;
   input.data = v;
+  return input;
+}
+
+std::shared_ptr<ApolloLidarSegmentation> make_segmentation(
+  bool use_intensity_feature, bool use_constant_feature, std::size_t num_threads = 1U)
+{
+  const int range = 70;
+  const float score_threshold = 0.8f;
+  const float z_offset = 1.0f;
+  const float32_t min_height = -5.0f;
+  const float32_t max_height = 5.0f;
+  const float32_t objectness_thresh = 0.5f;
+  const int32_t min_pts_num = 3;
+  const float32_t height_thresh = 0.5f;
+  return std::make_shared<ApolloLidarSegmentation>(
+    range, score_threshold, use_intensity_feature, use_constant_feature, z_offset, min_height,
+    max_height, objectness_thresh, min_pts_num, height_thresh, num_threads);
+}
+
+void test_segmentation(bool use_intensity_feature, bool use_constant_feature, bool expect_throw)
+{
+  // Instantiate the pipeline
+  const auto segmentation = make_segmentation(use_intensity_feature, use_constant_feature);
+  const sensor_msgs::msg::PointCloud2 input = make_random_cloud(1, 10000);
 
   std::shared_ptr<const autoware_auto_msgs::msg::BoundingBoxArray> output;
   bool has_thrown = false;
   try {
-    output = segmentation.detectDynamicObjects(input);
+    output = segmentation->detectDynamicObjects(input);
   } catch (const std::exception & e) {
     has_thrown = true;
   }
@@ -97,3 +106,40 @@ TEST(apollo_lidar_segmentation, others) {
   test_segmentation(false, true, false);
   test_segmentation(true, true, false);
 }
+
+// Test that the feature map, and so the detections, do not depend on the number of threads.
+TEST(apollo_lidar_segmentation, multi_threaded) {
+  const sensor_msgs::msg::PointCloud2 input = make_random_cloud(1, 10000);
+  const auto single_threaded = make_segmentation(true, false, 1U)->detectDynamicObjects(input);
+  const auto multi_threaded = make_segmentation(true, false, 4U)->detectDynamicObjects(input);
+  ASSERT_EQ(single_threaded->boxes.size(), multi_threaded->boxes.size());
+  for (std::size_t i = 0U; i < single_threaded->boxes.size(); ++i) {
+    EXPECT_EQ(single_threaded->boxes[i].centroid.x, multi_threaded->boxes[i].centroid.x);
+    EXPECT_EQ(single_threaded->boxes[i].centroid.y, multi_threaded->boxes[i].centroid.y);
+    EXPECT_EQ(single_threaded->boxes[i].size.x, multi_threaded->boxes[i].size.x);
+    EXPECT_EQ(single_threaded->boxes[i].size.y, multi_threaded->boxes[i].size.y);
+  }
+}
+
+// Test that the points cropped from the input, outside of the grid, do not change the detections.
+TEST(apollo_lidar_segmentation, out_of_range_points) {
+  const sensor_msgs::msg::PointCloud2 input = make_random_cloud(1, 10000);
+  sensor_msgs::msg::PointCloud2 input_with_far_points = make_random_cloud(1, 10100);
+  auto * const points = reinterpret_cast<float32_t *>(input_with_far_points.data.data());
+  std::copy(
+    reinterpret_cast<const float32_t *>(input.data.data()),
+    reinterpret_cast<const float32_t *>(input.data.data()) + 10000 * 4, points);
+  for (std::size_t i = 10000U; i < 10100U; ++i) {
+    points[i * 4U] = (i % 2U == 0U) ? 500.0f : -500.0f;
+  }
+  const auto output = make_segmentation(true, false)->detectDynamicObjects(input);
+  const auto output_with_far_points =
+    make_segmentation(true, false)->detectDynamicObjects(input_with_far_points);
+  ASSERT_EQ(output->boxes.size(), output_with_far_points->boxes.size());
+  for (std::size_t i = 0U; i < output->boxes.size(); ++i) {
+    EXPECT_EQ(output->boxes[i].centroid.x, output_with_far_points->boxes[i].centroid.x);
+    EXPECT_EQ(output->boxes[i].centroid.y, output_with_far_points->boxes[i].centroid.y);
+    EXPECT_EQ(output->boxes[i].size.x, output_with_far_points->boxes[i].size.x);
+    EXPECT_EQ(output->boxes[i].size.y, output_with_far_points->boxes[i].size.y);
+  }
+}
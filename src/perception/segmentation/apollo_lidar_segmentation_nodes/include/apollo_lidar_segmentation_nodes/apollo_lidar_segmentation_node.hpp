@@ -15,6 +15,7 @@
 #ifndef APOLLO_LIDAR_SEGMENTATION_NODES__APOLLO_LIDAR_SEGMENTATION_NODE_HPP_
 #define APOLLO_LIDAR_SEGMENTATION_NODES__APOLLO_LIDAR_SEGMENTATION_NODE_HPP_
 
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <rclcpp/node.hpp>
 #include <rclcpp/publisher.hpp>
 #include <rclcpp/subscription.hpp>
@@ -23,7 +24,9 @@
 
 #include <apollo_lidar_segmentation/apollo_lidar_segmentation.hpp>
 #include <apollo_lidar_segmentation_nodes/visibility_control.hpp>
+#include <time_utils/latency_histogram.hpp>
 
+#include <cstddef>
 #include <memory>
 
 namespace autoware
@@ -42,14 +45,26 @@ private:
   const rclcpp::Publisher<autoware_auto_msgs::msg::BoundingBoxArray>::SharedPtr m_box_pub_ptr;
   const rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr m_marker_pub_ptr;
   const std::shared_ptr<apollo_lidar_segmentation::ApolloLidarSegmentation> m_detector_ptr;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr m_diagnostics_pub_ptr{};
+  // Latency of the whole callback, null if latencies are not measured
+  std::unique_ptr<common::time_utils::LatencyHistogram> m_latency_ptr{};
+  std::size_t m_diagnostics_period{1U};
+  std::size_t m_num_frames{0U};
+  bool m_profile_operators{false};
   /// \brief Main callback function.
   void APOLLO_LIDAR_SEGMENTATION_NODES_LOCAL pointCloudCallback(
     const sensor_msgs::msg::PointCloud2::SharedPtr & msg);
+  /// \brief Summarize the latencies of the callback and of the steps of the inference pipeline,
+  ///        and of the slowest operators of the network if they are profiled
+  diagnostic_msgs::msg::DiagnosticArray APOLLO_LIDAR_SEGMENTATION_NODES_LOCAL
+  makeLatencyDiagnostics();
 
 public:
   /// \brief Constructor
   /// \param options Additional options to control creation of the node.
   explicit ApolloLidarSegmentationNode(const rclcpp::NodeOptions & options);
+  /// \brief Log a summary of the latencies, if they are measured
+  ~ApolloLidarSegmentationNode() override;
 };
 }  // namespace apollo_lidar_segmentation_nodes
 }  // namespace segmentation
@@ -16,13 +16,20 @@
 #include <apollo_lidar_segmentation_nodes/apollo_lidar_segmentation_node.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
 #include <common/types.hpp>
+#include <time_utils/probe_diagnostics.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 using autoware::common::types::bool8_t;
 using autoware::common::types::float32_t;
 using autoware::common::types::float64_t;
 using autoware::perception::segmentation::apollo_lidar_segmentation::ApolloLidarSegmentation;
+using diagnostic_msgs::msg::DiagnosticArray;
 
 namespace autoware
 {
@@ -32,6 +39,28 @@ namespace segmentation
 {
 namespace apollo_lidar_segmentation_nodes
 {
+namespace
+{
+// Number of operators of the network which are reported, slowest first
+constexpr std::size_t kNumReportedOperators = 10U;
+
+int64_t to_us(const std::chrono::nanoseconds duration)
+{
+  return static_cast<int64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+// The latencies of the callback and of the steps of the pipeline, by name
+std::vector<std::pair<std::string, const common::time_utils::LatencyHistogram *>>
+get_latencies(
+  const common::time_utils::LatencyHistogram & total,
+  const tvm_utility::pipeline::PipelineProfile & profile)
+{
+  return {{"pre_processor", &profile.pre_processor},
+    {"inference_engine", &profile.inference_engine},
+    {"post_processor", &profile.post_processor}, {"total", &total}};
+}
+}  // namespace
 
 ApolloLidarSegmentationNode::ApolloLidarSegmentationNode(const rclcpp::NodeOptions & options)
 : Node("apollo_lidar_segmentation", options),
@@ -55,8 +84,86 @@ m_detector_ptr{std::make_shared<apollo_lidar_segmentation::ApolloLidarSegmentati
     declare_parameter("max_height", rclcpp::ParameterValue{5.0}).get<float32_t>(),
     declare_parameter("objectness_thresh", rclcpp::ParameterValue{0.5}).get<float32_t>(),
     declare_parameter("min_pts_num", rclcpp::ParameterValue{3}).get<int32_t>(),
-    declare_parameter("height_thresh", rclcpp::ParameterValue{0.5}).get<float32_t>())}
+    declare_parameter("height_thresh", rclcpp::ParameterValue{0.5}).get<float32_t>(),
+    static_cast<std::size_t>(
+      std::max(declare_parameter("num_threads", rclcpp::ParameterValue{1}).get<int32_t>(), 1)),
+    declare_parameter("latency_budget_ms", rclcpp::ParameterValue{0.0}).get<float64_t>(),
+    declare_parameter("crop_height", rclcpp::ParameterValue{false}).get<bool8_t>(),
+    declare_parameter("diagnostics.enable", false) &&
+    declare_parameter("diagnostics.profile_operators", false))}
 {
+  // The hot path only reads the clock if latencies are measured
+  if (get_parameter("diagnostics.enable").as_bool()) {
+    m_detector_ptr->enableProfiling();
+    m_latency_ptr = std::make_unique<common::time_utils::LatencyHistogram>();
+    m_diagnostics_period =
+      static_cast<std::size_t>(std::max(declare_parameter("diagnostics.period_frames", 100), 1));
+    m_profile_operators = get_parameter("diagnostics.profile_operators").as_bool();
+    m_diagnostics_pub_ptr = create_publisher<DiagnosticArray>("diagnostics", rclcpp::QoS{10});
+  }
+}
+
+ApolloLidarSegmentationNode::~ApolloLidarSegmentationNode()
+{
+  if (!m_latency_ptr) {
+    return;
+  }
+  for (const auto & latency : get_latencies(*m_latency_ptr, *m_detector_ptr->getProfile())) {
+    const auto & histogram = *latency.second;
+    if (0U != histogram.count()) {
+      RCLCPP_INFO_STREAM(
+        get_logger(), "Latency of " << latency.first << " over " << histogram.count() <<
+          " frames: mean " << to_us(histogram.mean()) << " us, p50 <= " <<
+          to_us(histogram.quantile_upper_bound(0.5)) << " us, p99 <= " <<
+          to_us(histogram.quantile_upper_bound(0.99)) << " us, max " <<
+          to_us(histogram.max()) << " us");
+    }
+  }
+}
+
+DiagnosticArray ApolloLidarSegmentationNode::makeLatencyDiagnostics()
+{
+  using diagnostic_msgs::msg::DiagnosticStatus;
+  using diagnostic_msgs::msg::KeyValue;
+  const auto add_value = [](DiagnosticStatus & status, const std::string & key,
+      const int64_t value) {
+      KeyValue key_value;
+      key_value.key = key;
+      key_value.value = std::to_string(value);
+      status.values.push_back(key_value);
+    };
+  DiagnosticArray diagnostics;
+  diagnostics.header.stamp = now();
+
+  auto status = common::time_utils::make_latency_status(
+    std::string{get_name()} + ": stage latencies", "apollo_lidar_segmentation_nodes");
+  for (const auto & latency : get_latencies(*m_latency_ptr, *m_detector_ptr->getProfile())) {
+    common::time_utils::add_latency_values(latency.first, *latency.second, status);
+  }
+  diagnostics.status.push_back(status);
+
+  if (m_profile_operators) {
+    // This runs the network once more, operator by operator, with the last pointcloud
+    auto operators = m_detector_ptr->profileOperators();
+    const std::size_t num_reported = std::min(operators.size(), kNumReportedOperators);
+    std::partial_sort(
+      operators.begin(), operators.begin() + static_cast<std::ptrdiff_t>(num_reported),
+      operators.end(),
+      [](const tvm_utility::pipeline::OperatorLatency & lhs,
+      const tvm_utility::pipeline::OperatorLatency & rhs) {return lhs.second > rhs.second;});
+    DiagnosticStatus operator_status;
+    operator_status.level = DiagnosticStatus::OK;
+    operator_status.name = std::string{get_name()} + ": operator latencies";
+    operator_status.message = "Latencies in us of the slowest operators in the last frame";
+    operator_status.hardware_id = status.hardware_id;
+    for (std::size_t idx = 0U; idx < num_reported; ++idx) {
+      add_value(
+        operator_status, operators[idx].first,
+        static_cast<int64_t>(operators[idx].second * 1000.0));
+    }
+    diagnostics.status.push_back(operator_status);
+  }
+  return diagnostics;
 }
 
 void ApolloLidarSegmentationNode::pointCloudCallback(
@@ -64,6 +171,7 @@ void ApolloLidarSegmentationNode::pointCloudCallback(
 {
   std::shared_ptr<const autoware_auto_msgs::msg::BoundingBoxArray> output_msg;
   try {
+    const common::time_utils::ScopedLatency latency{m_latency_ptr.get()};
     output_msg = m_detector_ptr->detectDynamicObjects(*msg);
   } catch (const std::exception & e) {
     RCLCPP_WARN(get_logger(), e.what());
@@ -103,6 +211,17 @@ void ApolloLidarSegmentationNode::pointCloudCallback(
     id_counter++;
   }
   m_marker_pub_ptr->publish(marker_array);
+
+  if (m_diagnostics_pub_ptr) {
+    ++m_num_frames;
+    if (0U == (m_num_frames % m_diagnostics_period)) {
+      try {
+        m_diagnostics_pub_ptr->publish(makeLatencyDiagnostics());
+      } catch (const std::exception & e) {
+        RCLCPP_WARN(get_logger(), e.what());
+      }
+    }
+  }
 }
 }  // namespace apollo_lidar_segmentation_nodes
 }  // namespace segmentation
@@ -25,6 +25,9 @@
 #include <geometry/spatial_hash.hpp>
 #include <euclidean_cluster/visibility_control.hpp>
 #include <common/types.hpp>
+#include <helper_functions/worker_pool.hpp>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 #include <utility>
@@ -147,6 +150,8 @@ private:
 /// according to euclidean distance. This can be thought of as a graph-based
 /// approach where points are vertices and edges are defined by euclidean distance
 /// The input to this should be nonground points pased through a voxel grid.
+/// With more than one thread, the connected components are found in parallel with a lock-free
+/// union-find, and the result is the same as with a single thread.
 class EUCLIDEAN_CLUSTER_PUBLIC EuclideanCluster
 {
 public:
@@ -159,7 +164,12 @@ public:
   /// \param[in] cfg The configuration of the clustering algorithm, contains threshold function
   /// \param[in] hash_cfg The configuration of the underlying spatial hash, controls the maximum
   ///                     number of points in a scene
-  EuclideanCluster(const Config & cfg, const HashConfig & hash_cfg);
+  /// \param[in] num_threads The number of threads used during clustering, including the calling
+  ///                        thread. Values smaller than 1 are treated as 1
+  EuclideanCluster(
+    const Config & cfg,
+    const HashConfig & hash_cfg,
+    const std::size_t num_threads = 1U);
   /// \brief Insert an individual point
   /// \param[in] pt The point to insert
   /// \throw std::length_error If the underlying spatial hash is full
@@ -199,6 +209,10 @@ public:
   /// \throw std::runtime_error If the maximum number of clusters may have been exceeded
   void throw_stored_error() const;
 
+  /// \brief Gets the number of threads used during clustering
+  /// \return Number of threads, including the calling thread
+  std::size_t get_num_threads() const;
+
 private:
   /// \brief Internal struct instead of pair since I can guarantee some memory stuff
   struct PointXY
@@ -206,8 +220,65 @@ private:
     float32_t x = 0.0f;
     float32_t y = 0.0f;
   };  // struct PointXYZ
+  /// \brief Points of one bin of the spatial hash, as a range of the point snapshot
+  struct Bin
+  {
+    autoware::common::geometry::spatial_hash::Index key;
+    std::size_t begin;
+    std::size_t end;
+  };  // struct Bin
   /// \brief Do the clustering process, with no error checking
   EUCLIDEAN_CLUSTER_LOCAL void cluster_impl(Clusters & clusters);
+  /// \brief Parallel version of cluster_impl: points are joined with their neighbors into
+  ///        connected components for tiles of bins concurrently, and the components are then
+  ///        split into clusters concurrently. The clusters are finally emitted in the order in
+  ///        which cluster_impl would find them
+  EUCLIDEAN_CLUSTER_LOCAL void cluster_parallel(Clusters & clusters);
+  /// \brief Copy the points out of the hash, such that the points of each bin are contiguous
+  EUCLIDEAN_CLUSTER_LOCAL void take_snapshot();
+  /// \brief Group the points of each bin in a tile of bins by sub-cell, and join the points of
+  ///        each group
+  EUCLIDEAN_CLUSTER_LOCAL void join_cells(const std::size_t tile);
+  /// \brief Join all points in a tile of bins with their neighbors
+  /// \param[in] tile Index of the tile
+  /// \param[in] worker_idx Index of the worker, which selects the bin cache
+  EUCLIDEAN_CLUSTER_LOCAL void join_neighbors(const std::size_t tile, const std::size_t worker_idx);
+  /// \brief Join two groups if any point of the first one has a neighbor in the second one, which
+  ///        is in the given bin
+  /// \return The root of the first group
+  EUCLIDEAN_CLUSTER_LOCAL std::size_t join_groups(
+    const autoware::common::geometry::spatial_hash::details::Index3 & ref_idx,
+    const autoware::common::geometry::spatial_hash::details::Index3 & query_idx,
+    const std::pair<std::size_t, std::size_t> & group,
+    const std::pair<std::size_t, std::size_t> & nbr_group,
+    std::size_t root);
+  /// \brief Group the points by component, in the order in which the points are in the hash
+  EUCLIDEAN_CLUSTER_LOCAL void group_components();
+  /// \brief Traverse a chunk of components
+  EUCLIDEAN_CLUSTER_LOCAL void traverse_components(const std::size_t chunk);
+  /// \brief Split a component into clusters, exactly as cluster_impl would grow them
+  EUCLIDEAN_CLUSTER_LOCAL void traverse_component(
+    const std::pair<std::size_t, std::size_t> & component);
+  /// \brief Run a number of tasks on the workers, the calling thread being worker 0
+  /// \throw The first exception thrown by any of the tasks
+  EUCLIDEAN_CLUSTER_LOCAL void run_workers(
+    const std::size_t num_tasks,
+    const common::helper_functions::WorkerPool::Work & task);
+  /// \brief Find a bin by key in a range of bins sorted by key
+  /// \return Pointer to the bin, or nullptr if no point is in the bin
+  template<typename BinsT>
+  EUCLIDEAN_CLUSTER_LOCAL static auto find_bin(
+    BinsT & bins,
+    const std::size_t begin,
+    const std::size_t end,
+    const autoware::common::geometry::spatial_hash::Index key) -> decltype(&bins[0U]);
+  /// \brief Lock-free find of the component root, with path halving
+  EUCLIDEAN_CLUSTER_LOCAL std::size_t find_root(std::size_t idx);
+  /// \brief Lock-free union of two components; the smaller index always becomes the root
+  /// \return The root of the joined component
+  EUCLIDEAN_CLUSTER_LOCAL std::size_t join(std::size_t idx1, std::size_t idx2);
+  /// \brief Appends a new empty cluster
+  EUCLIDEAN_CLUSTER_LOCAL static void start_cluster(Clusters & clusters);
   /// \brief Compute the next cluster, seeded by the given point, and grown using the remaining
   ///         points still contained in the hash
   EUCLIDEAN_CLUSTER_LOCAL void cluster(Clusters & clusters, const Hash::IT it);
@@ -223,9 +294,35 @@ private:
   EUCLIDEAN_CLUSTER_LOCAL static std::size_t last_cluster_size(const Clusters & clusters);
 
   const Config m_config;
+  const HashConfig m_hash_config;
   Hash m_hash;
   Error m_last_error;
   std::vector<bool8_t> m_seen;
+  // State for parallel clustering, all indices are into m_points
+  common::helper_functions::WorkerPool m_workers;
+  std::vector<PointXYZIR> m_points;
+  std::vector<autoware::common::geometry::spatial_hash::Index> m_keys;
+  std::vector<float32_t> m_thresholds;
+  std::vector<float32_t> m_query_thresholds;
+  std::vector<Bin> m_bins;
+  std::unique_ptr<std::atomic<std::size_t>[]> m_parents;
+  std::vector<std::vector<const Bin *>> m_bin_caches;
+  std::vector<std::pair<int64_t, int64_t>> m_cells;
+  std::vector<std::size_t> m_cell_members;
+  std::vector<std::pair<std::size_t, std::size_t>> m_groups;
+  std::vector<std::size_t> m_bin_groups_ends;
+  autoware::common::types::float64_t m_inv_cell_size;
+  // Marks bins which have not been looked up yet in m_bin_caches
+  const Bin m_unknown_bin;
+  std::vector<std::size_t> m_roots;
+  std::vector<std::size_t> m_component_cursors;
+  std::vector<std::pair<std::size_t, std::size_t>> m_components;
+  std::vector<std::size_t> m_members;
+  std::vector<std::size_t> m_bin_members;
+  std::vector<Bin> m_component_bins;
+  std::vector<uint8_t> m_assigned;
+  std::vector<std::size_t> m_order;
+  std::vector<std::pair<std::size_t, std::size_t>> m_cluster_ranges;
 };  // class EuclideanCluster
 
 /// \brief Common euclidean cluster functions not intended for external use
@@ -240,6 +337,18 @@ enum class BboxMethod
   Eigenbox,
   LFit,
 };
+/// \brief Compute the bounding box of a single cluster
+/// \param[inout] clusters A set of clusters. The points of the given cluster may get shuffled.
+/// \param[in] cls_id The index of the cluster
+/// \param[in] method Whether to use the eigenboxes or L-Fit algorithm.
+/// \param[in] compute_height Compute the height of the bounding box as well.
+/// \param[out] box The bounding box, only modified if the cluster is not empty
+/// \returns False if the cluster is empty
+/// \throw std::exception If the bounding box cannot be computed, e.g. for too few points
+EUCLIDEAN_CLUSTER_PUBLIC
+bool8_t compute_bounding_box(
+  Clusters & clusters, const std::size_t cls_id, const BboxMethod method,
+  const bool8_t compute_height, BoundingBox & box);
 /// \brief Compute bounding boxes from clusters
 /// \param[in] method Whether to use the eigenboxes or L-Fit algorithm.
 /// \param[in] compute_height Compute the height of the bounding box as well.
@@ -249,6 +358,23 @@ enum class BboxMethod
 EUCLIDEAN_CLUSTER_PUBLIC
 BoundingBoxArray compute_bounding_boxes(
   Clusters & clusters, const BboxMethod method, const bool compute_height);
+/// \brief Compute the convex hull of a single cluster, see common::geometry::convex_hull
+/// \param[inout] clusters A set of clusters. The points of the given cluster get sorted.
+/// \param[in] cls_id The index of the cluster
+/// \param[out] hull Iterator to room for the number of points of the cluster plus one
+/// \returns The number of points of the hull, which are written ccw starting at hull
+EUCLIDEAN_CLUSTER_PUBLIC
+std::size_t compute_convex_hull(
+  Clusters & clusters, const std::size_t cls_id, const Clusters::_points_type::iterator hull);
+/// \brief Compute the convex hulls of all clusters of a frame. The hulls are computed on the
+///        points of the clusters in place, without copying them to intermediate containers.
+/// \param[inout] clusters A set of clusters. The points of individual clusters get sorted.
+/// \param[out] hulls Gets filled with the hulls packed in the same layout as clusters, i.e. the
+///                   hull of a cluster is get_cluster(hulls, cls_id). Memory is only allocated if
+///                   the clusters have more points than in any call before; the header is not
+///                   modified. Clusters with 3 or fewer points are their own hull
+EUCLIDEAN_CLUSTER_PUBLIC
+void compute_convex_hulls(Clusters & clusters, Clusters & hulls);
 /// \brief Convert this bounding box to a DetectedObjects message
 /// \param[in] boxes A bounding box array
 /// \returns A DetectedObjects message with the bounding boxes inside
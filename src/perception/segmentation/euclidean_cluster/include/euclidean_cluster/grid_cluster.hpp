@@ -0,0 +1,216 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+/// \file
+/// \brief This file defines a clustering algorithm on a 2D occupancy grid
+
+#ifndef EUCLIDEAN_CLUSTER__GRID_CLUSTER_HPP_
+#define EUCLIDEAN_CLUSTER__GRID_CLUSTER_HPP_
+
+#include <common/types.hpp>
+#include <euclidean_cluster/euclidean_cluster.hpp>
+#include <euclidean_cluster/visibility_control.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace autoware
+{
+namespace perception
+{
+namespace segmentation
+{
+namespace euclidean_cluster
+{
+
+/// \brief Configuration of the bird's eye view grid of GridCluster
+class EUCLIDEAN_CLUSTER_PUBLIC GridConfig
+{
+public:
+  /// \brief Constructor
+  /// \param[in] min_x The minimum x coordinate of the grid
+  /// \param[in] max_x The maximum x coordinate of the grid
+  /// \param[in] min_y The minimum y coordinate of the grid
+  /// \param[in] max_y The maximum y coordinate of the grid
+  /// \param[in] cell_size_m The side length of the square cells, which is also the connectivity
+  ///                        threshold
+  /// \param[in] capacity The maximum number of points
+  /// \throw std::domain_error If the bounds or the cell size do not define a non-empty grid
+  GridConfig(
+    const float32_t min_x,
+    const float32_t max_x,
+    const float32_t min_y,
+    const float32_t max_y,
+    const float32_t cell_size_m,
+    const std::size_t capacity);
+  /// \brief Get the minimum x coordinate of the grid
+  /// \return Value
+  float32_t min_x() const;
+  /// \brief Get the minimum y coordinate of the grid
+  /// \return Value
+  float32_t min_y() const;
+  /// \brief Get the side length of the cells
+  /// \return Value
+  float32_t cell_size() const;
+  /// \brief Get the number of cells along the x axis
+  /// \return Value
+  std::size_t width() const;
+  /// \brief Get the number of cells along the y axis
+  /// \return Value
+  std::size_t height() const;
+  /// \brief Get the maximum number of points
+  /// \return Value
+  std::size_t capacity() const;
+
+private:
+  const float32_t m_min_x;
+  const float32_t m_min_y;
+  const float32_t m_cell_size;
+  const std::size_t m_width;
+  const std::size_t m_height;
+  const std::size_t m_capacity;
+};  // class GridConfig
+
+/// \brief Clustering on a 2D occupancy grid, as a cheaper alternative to EuclideanCluster.
+/// Points are binned into the cells of a bird's eye view grid, and occupied cells which are
+/// neighbors of each other, including diagonally, are joined into clusters with a union-find. This
+/// is linear in the number of points and occupied cells, instead of querying the near neighbors of
+/// every point. The result is coarser: points in neighboring cells may be up to
+/// 2 * sqrt(2) * cell size apart, and the threshold does not vary with the distance. Points outside
+/// of the grid are ignored. The output format, the cluster size limits and the error handling are
+/// the same as those of EuclideanCluster; the input should also be nonground points.
+class EUCLIDEAN_CLUSTER_PUBLIC GridCluster
+{
+public:
+  using Error = EuclideanCluster::Error;
+
+  /// \brief Constructor
+  /// \param[in] cfg The configuration of the clustering algorithm. The thresholds are not used,
+  ///                the connectivity is defined by the grid
+  /// \param[in] grid_cfg The configuration of the grid
+  GridCluster(const Config & cfg, const GridConfig & grid_cfg);
+  /// \brief Insert an individual point
+  /// \param[in] pt The point to insert
+  /// \throw std::length_error If the capacity is exceeded
+  void insert(const PointXYZIR & pt);
+  /// \brief Multi-insert
+  /// \param[in] begin Iterator pointing to to the first point to insert
+  /// \param[in] end Iterator pointing to one past the last point to insert
+  /// \throw std::length_error If the points would exceed the capacity
+  /// \tparam IT The type of the iterator
+  template<typename IT>
+  void insert(const IT begin, const IT end)
+  {
+    if ((static_cast<std::size_t>(std::distance(begin, end)) + m_points.size()) >
+      m_grid_config.capacity())
+    {
+      throw std::length_error{"GridCluster: Multi insert would overrun capacity"};
+    }
+    for (auto it = begin; it != end; ++it) {
+      insert(PointXYZIR{*it});
+    }
+  }
+
+  /// \brief Compute the clusters from the inserted points, and remove all points
+  /// \param[inout] clusters The clusters object
+  void cluster(Clusters & clusters);
+  /// \brief Compute the clusters like cluster(clusters), reusing the components of the previous
+  ///        call of this function where the occupied cells did not change, e.g. at low speed.
+  /// The occupied cells of the previous call are shifted by the displacement, rounded to whole
+  /// cells. A previous component of which every cell is still occupied, and which has no newly
+  /// occupied cell next to it, is still a component, so its cells are not joined again. The
+  /// result is the same as that of cluster(clusters), the displacement only decides how many
+  /// cells are reused. A call of cluster(clusters) in between means that nothing is reused.
+  /// \param[inout] clusters The clusters object
+  /// \param[in] displacement_x How far static points moved along x since the previous call, e.g.
+  ///                           by ego motion
+  /// \param[in] displacement_y How far static points moved along y since the previous call
+  void cluster(Clusters & clusters, const float32_t displacement_x, const float32_t displacement_y);
+
+  /// \brief Get the number of occupied cells whose component was reused, see the last call of
+  ///        cluster(clusters, displacement_x, displacement_y)
+  /// \return The number of cells
+  std::size_t get_num_reused_cells() const;
+
+  /// \brief Gets last error, see EuclideanCluster::get_error
+  /// \return The error of the last call to cluster
+  Error get_error() const;
+
+  /// \brief Gets the internal configuration class
+  /// \return Internal configuration class
+  const Config & get_config() const;
+
+  /// \brief Throw the stored error during clustering process
+  /// \throw std::runtime_error If the maximum number of clusters may have been exceeded
+  void throw_stored_error() const;
+
+private:
+  /// \brief Find the root of an occupied cell, with path halving
+  EUCLIDEAN_CLUSTER_LOCAL std::size_t find_root(std::size_t slot);
+  /// \brief Join an occupied cell with a cell, if that one is occupied
+  EUCLIDEAN_CLUSTER_LOCAL void join(const std::size_t slot, const std::size_t cell);
+  /// \brief Join an occupied cell with its neighbors in the next column and the next row
+  EUCLIDEAN_CLUSTER_LOCAL void join_neighbors(const std::size_t slot);
+  /// \brief Label the components and write the large enough ones into the clusters
+  EUCLIDEAN_CLUSTER_LOCAL void emit(Clusters & clusters);
+  /// \brief Take over the unchanged components of the previous call as joined cells
+  EUCLIDEAN_CLUSTER_LOCAL void reuse_previous(
+    const float32_t displacement_x,
+    const float32_t displacement_y);
+  /// \brief Keep the components of the occupied cells for the next call
+  EUCLIDEAN_CLUSTER_LOCAL void store_previous();
+  /// \brief Remove all points and reset the grid
+  EUCLIDEAN_CLUSTER_LOCAL void clear();
+
+  const Config m_config;
+  const GridConfig m_grid_config;
+  Error m_last_error;
+  // Slot of each cell in the arrays of occupied cells, or NO_SLOT
+  std::vector<std::size_t> m_cell_slots;
+  // Occupied cells, in the order in which they were first hit
+  std::vector<std::size_t> m_slot_cells;
+  std::vector<std::size_t> m_slot_sizes;
+  std::vector<std::size_t> m_parents;
+  std::vector<uint8_t> m_ranks;
+  // Component label of each root, and of each occupied cell
+  std::vector<std::size_t> m_root_labels;
+  std::vector<std::size_t> m_labels;
+  // Points and the slot of their cell, in insertion order
+  std::vector<PointXYZIR> m_points;
+  std::vector<std::size_t> m_point_slots;
+  // Size and then write position of each component
+  std::vector<std::size_t> m_component_offsets;
+  // Component of each cell occupied in the previous temporal call, or NO_SLOT. It is only
+  // allocated by the first temporal call
+  std::vector<std::size_t> m_prev_cell_labels;
+  std::vector<std::size_t> m_prev_cells;
+  std::vector<std::size_t> m_prev_label_sizes;
+  bool8_t m_has_previous;
+  // Previous component of each occupied cell, or NO_SLOT
+  std::vector<std::size_t> m_slot_prev_labels;
+  // Per previous component: number of cells still occupied, whether it is reused, and its root
+  std::vector<std::size_t> m_prev_label_matches;
+  std::vector<uint8_t> m_prev_label_reusable;
+  std::vector<std::size_t> m_prev_label_roots;
+  std::size_t m_num_reused_cells;
+};  // class GridCluster
+}  // namespace euclidean_cluster
+}  // namespace segmentation
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // EUCLIDEAN_CLUSTER__GRID_CLUSTER_HPP_
@@ -0,0 +1,119 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+/// \file
+/// \brief This file defines a multi-threaded bounding box computation for clusters
+
+#ifndef EUCLIDEAN_CLUSTER__PARALLEL_BOUNDING_BOXES_HPP_
+#define EUCLIDEAN_CLUSTER__PARALLEL_BOUNDING_BOXES_HPP_
+
+#include <common/types.hpp>
+#include <euclidean_cluster/euclidean_cluster.hpp>
+#include <euclidean_cluster/visibility_control.hpp>
+#include <helper_functions/worker_pool.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace autoware
+{
+namespace perception
+{
+namespace segmentation
+{
+namespace euclidean_cluster
+{
+namespace details
+{
+
+/// \brief Computes the bounding boxes or convex hulls of clusters using a WorkerPool. Clusters
+///        are independent, so each one is handled by a single worker. The largest clusters are
+///        handed out first, so that a few large clusters do not end up on the same worker late in
+///        the batch. The output is identical to, and in the same order as, that of
+///        compute_bounding_boxes and compute_convex_hulls.
+class EUCLIDEAN_CLUSTER_PUBLIC ParallelBoundingBoxes
+{
+public:
+  /// \brief Constructor, starts the worker threads
+  /// \param[in] num_workers Number of workers, including the calling thread. A value of 1 means
+  ///                        no additional threads are started
+  /// \throw std::domain_error If num_workers is 0
+  explicit ParallelBoundingBoxes(const std::size_t num_workers);
+  ParallelBoundingBoxes(const ParallelBoundingBoxes &) = delete;
+  ParallelBoundingBoxes & operator=(const ParallelBoundingBoxes &) = delete;
+
+  /// \brief Compute bounding boxes from clusters. Blocks until all boxes are computed; the calling
+  ///        thread also works on the batch. Memory is only allocated if there are more clusters
+  ///        than in any batch before. Not thread safe.
+  /// \param[inout] clusters A set of clusters for which to compute the bounding boxes. Individual
+  ///                        clusters may get their points shuffled.
+  /// \param[in] method Whether to use the eigenboxes or L-Fit algorithm.
+  /// \param[in] compute_height Compute the height of the bounding box as well.
+  /// \param[out] boxes Gets filled with the bounding boxes; the header is not modified. Clusters
+  ///                   for which no box can be computed are skipped, as in compute_bounding_boxes
+  /// \throw ... Any exception thrown by a worker which is not derived from std::exception.
+  ///           Exceptions derived from std::exception are printed and skip the cluster
+  void compute(
+    Clusters & clusters,
+    const BboxMethod method,
+    const bool8_t compute_height,
+    BoundingBoxArray & boxes);
+
+  /// \brief Compute the convex hulls of the clusters, see compute_convex_hulls. Blocks until all
+  ///        hulls are computed, as compute. Not thread safe.
+  /// \param[inout] clusters A set of clusters. The points of individual clusters get sorted.
+  /// \param[out] hulls Gets filled with the packed hulls; the header is not modified
+  /// \throw ... Any exception thrown by a worker
+  void compute_hulls(Clusters & clusters, Clusters & hulls);
+
+  /// \brief Get the number of workers, including the calling thread
+  /// \return Value
+  std::size_t get_num_workers() const;
+
+private:
+  /// \brief Bounding box of a single cluster
+  struct Result
+  {
+    BoundingBox box;
+    bool8_t valid;
+  };  // struct Result
+
+  /// \brief Order the clusters of a batch, run it on all workers and wait for it to finish
+  EUCLIDEAN_CLUSTER_LOCAL void run_batch(Clusters & clusters);
+  /// \brief Computes the box or hull of a single cluster of the current batch
+  /// \param[inout] clusters The clusters of the batch
+  /// \param[in] cls_id The index of the cluster
+  EUCLIDEAN_CLUSTER_LOCAL void process(Clusters & clusters, const std::size_t cls_id);
+
+  common::helper_functions::WorkerPool m_pool;
+  // Serializes the messages of skipped clusters
+  std::mutex m_print_mutex;
+
+  // State of the current batch
+  // Hulls are computed instead of boxes if set
+  Clusters * m_hulls;
+  BboxMethod m_method;
+  bool8_t m_compute_height;
+  std::vector<std::size_t> m_order;
+  std::vector<Result> m_results;
+  std::vector<std::size_t> m_hull_sizes;
+};  // class ParallelBoundingBoxes
+}  // namespace details
+}  // namespace euclidean_cluster
+}  // namespace segmentation
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // EUCLIDEAN_CLUSTER__PARALLEL_BOUNDING_BOXES_HPP_
@@ -17,11 +17,17 @@
 #include <cstring>
 //lint -e537 NOLINT Repeated include file: pclint vs cpplint
 #include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
 #include <string>
 //lint -e537 NOLINT Repeated include file: pclint vs cpplint
 #include <utility>
+#include <vector>
 #include "euclidean_cluster/euclidean_cluster.hpp"
 #include "geometry/bounding_box_2d.hpp"
+#include "geometry/convex_hull.hpp"
+#include "lidar_utils/cluster_utils/single_cluster_view.hpp"
 
 namespace autoware
 {
@@ -31,6 +37,7 @@ namespace segmentation
 {
 namespace euclidean_cluster
 {
+using autoware::common::types::float64_t;
 ////////////////////////////////////////////////////////////////////////////////
 PointXYZIR::PointXYZIR(const common::types::PointXYZIF & pt)
 : m_point{pt.x, pt.y, pt.z, pt.intensity},
@@ -120,11 +127,74 @@ const std::string & Config::frame_id() const
 }
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-EuclideanCluster::EuclideanCluster(const Config & cfg, const HashConfig & hash_cfg)
+namespace
+{
+// Number of bins or components claimed by a worker at once
+constexpr std::size_t TASK_CHUNK_SIZE = 32U;
+
+// Sub-cell of a point, or a value which is unique to the point if it has none
+std::pair<int64_t, int64_t> get_cell(
+  const PointXYZI & pt,
+  const float64_t inv_cell_size,
+  const std::size_t idx)
+{
+  const float64_t cell_x = std::floor(static_cast<float64_t>(pt.x) * inv_cell_size);
+  const float64_t cell_y = std::floor(static_cast<float64_t>(pt.y) * inv_cell_size);
+  // Also catches NaN coordinates
+  constexpr float64_t MAX_CELL = 1.0e15;
+  if ((inv_cell_size > 0.0) && (std::fabs(cell_x) < MAX_CELL) && (std::fabs(cell_y) < MAX_CELL)) {
+    return {static_cast<int64_t>(cell_x), static_cast<int64_t>(cell_y)};
+  }
+  return {std::numeric_limits<int64_t>::min(), static_cast<int64_t>(idx)};
+}
+}  // namespace
+////////////////////////////////////////////////////////////////////////////////
+EuclideanCluster::EuclideanCluster(
+  const Config & cfg,
+  const HashConfig & hash_cfg,
+  const std::size_t num_threads)
 : m_config(cfg),
+  m_hash_config(hash_cfg),
   m_hash(hash_cfg),
-  m_last_error(Error::NONE)
-{}
+  m_last_error(Error::NONE),
+  m_workers(std::max(num_threads, std::size_t{1U})),
+  m_inv_cell_size(0.0),
+  m_unknown_bin{}
+{
+  if (get_num_threads() > 1U) {
+    // Any two points in a square cell of this size are within the smallest threshold of each
+    // other, with a small margin for rounding errors. The threshold is linear in r, so smallest
+    // at one of the ends
+    const float64_t min_thresh = static_cast<float64_t>(std::min(
+        m_config.threshold(0.0F), m_config.threshold(std::numeric_limits<float32_t>::max())));
+    const float64_t cell_size = (0.99 * min_thresh) / std::sqrt(2.0);
+    if (std::isfinite(cell_size) && (cell_size > 1.0e-6)) {
+      m_inv_cell_size = 1.0 / cell_size;
+    }
+    // Preallocate everything which scales with the number of points
+    const std::size_t capacity = m_hash.capacity();
+    m_points.reserve(capacity);
+    m_thresholds.reserve(capacity);
+    m_query_thresholds.reserve(capacity);
+    m_bins.reserve(capacity);
+    m_parents.reset(new std::atomic<std::size_t>[capacity]);
+    m_keys.reserve(capacity);
+    m_bin_caches.resize(get_num_threads());
+    m_roots.resize(capacity);
+    m_component_cursors.resize(capacity);
+    m_components.reserve(capacity);
+    m_cells.resize(capacity);
+    m_cell_members.resize(capacity);
+    m_groups.resize(capacity);
+    m_bin_groups_ends.resize(capacity);
+    m_members.resize(capacity);
+    m_bin_members.resize(capacity);
+    m_component_bins.resize(capacity);
+    m_assigned.resize(capacity);
+    m_order.resize(capacity);
+    m_cluster_ranges.resize(capacity);
+  }
+}
 ////////////////////////////////////////////////////////////////////////////////
 bool Config::match_clusters_size(const Clusters & clusters) const
 {
@@ -174,9 +244,18 @@ const Config & EuclideanCluster::get_config() const
   return m_config;
 }
 ////////////////////////////////////////////////////////////////////////////////
+std::size_t EuclideanCluster::get_num_threads() const
+{
+  return m_workers.get_num_workers();
+}
+////////////////////////////////////////////////////////////////////////////////
 void EuclideanCluster::cluster_impl(Clusters & clusters)
 {
   m_last_error = Error::NONE;
+  if (get_num_threads() > 1U) {
+    cluster_parallel(clusters);
+    return;
+  }
   auto it = m_hash.begin();
   while (it != m_hash.end()) {
     cluster(clusters, it);
@@ -193,12 +272,7 @@ void EuclideanCluster::cluster(Clusters & clusters, const Hash::IT it)
     // Flush the remaining points in the hash for the new scan
     m_hash.clear();
   } else {
-    // initialize new cluster in clusters
-    if (clusters.cluster_boundary.empty()) {
-      clusters.cluster_boundary.emplace_back(0U);
-    } else {
-      clusters.cluster_boundary.emplace_back(clusters.cluster_boundary.back());
-    }
+    start_cluster(clusters);
     // Seed cluster with new point
     add_point_to_last_cluster(clusters, it->second);
     // Erase returns the element after the removed element but it is not useful here
@@ -243,6 +317,392 @@ void EuclideanCluster::add_neighbors_to_last_cluster(
   }
 }
 ////////////////////////////////////////////////////////////////////////////////
+void EuclideanCluster::cluster_parallel(Clusters & clusters)
+{
+  take_snapshot();
+  const std::size_t num_points = m_points.size();
+  for (std::size_t idx = 0U; idx < num_points; ++idx) {
+    m_parents[idx].store(idx);
+  }
+  const std::size_t num_tiles = (m_bins.size() + TASK_CHUNK_SIZE - 1U) / TASK_CHUNK_SIZE;
+  run_workers(num_tiles, [this](const std::size_t tile, const std::size_t) {join_cells(tile);});
+  run_workers(
+    num_tiles, [this](const std::size_t tile, const std::size_t worker_idx) {
+      join_neighbors(tile, worker_idx);
+    });
+  group_components();
+  run_workers(
+    (m_components.size() + TASK_CHUNK_SIZE - 1U) / TASK_CHUNK_SIZE,
+    [this](const std::size_t chunk, const std::size_t) {traverse_components(chunk);});
+  // Compaction: cluster_impl seeds each cluster with the first point left in the hash. Erasing does
+  // not reorder a hash, so the clusters come out in the order of their seeds in the snapshot
+  for (std::size_t idx = 0U; idx < num_points; ++idx) {
+    const auto & range = m_cluster_ranges[idx];
+    if (range.first == range.second) {
+      // Not a seed
+      continue;
+    }
+    if (clusters.cluster_boundary.size() >= m_config.max_num_clusters()) {
+      m_last_error = Error::TOO_MANY_CLUSTERS;
+      break;
+    }
+    start_cluster(clusters);
+    for (std::size_t jdx = range.first; jdx < range.second; ++jdx) {
+      add_point_to_last_cluster(clusters, m_points[m_order[jdx]]);
+    }
+    if ((range.second - range.first) < m_config.min_cluster_size()) {
+      clusters.cluster_boundary.pop_back();
+    }
+  }
+  // All points are consumed, as in cluster_impl
+  m_hash.clear();
+}
+////////////////////////////////////////////////////////////////////////////////
+void EuclideanCluster::take_snapshot()
+{
+  m_points.clear();
+  m_keys.clear();
+  m_thresholds.clear();
+  m_query_thresholds.clear();
+  m_bins.clear();
+  // Points with the same key are adjacent in an unordered_multimap, so each bin is one range
+  for (auto it = m_hash.cbegin(); it != m_hash.cend(); ++it) {
+    const std::size_t idx = m_points.size();
+    if (m_bins.empty() || (m_bins.back().key != it->first)) {
+      m_bins.push_back(Bin{it->first, idx, idx});
+    }
+    m_points.push_back(it->second);
+    m_keys.push_back(it->first);
+    // Same thresholds as add_neighbors_to_last_cluster computes for a point and its neighbors
+    const auto & pt = it->second.get_point();
+    m_query_thresholds.push_back(m_config.threshold(sqrtf((pt.x * pt.x) + (pt.y * pt.y))));
+    m_thresholds.push_back(m_config.threshold(it->second));
+    m_bins.back().end = idx + 1U;
+  }
+  // Sorted by key, tiles of consecutive bins are rows of the hash
+  std::sort(
+    m_bins.begin(), m_bins.end(),
+    [](const Bin & lhs, const Bin & rhs) {return lhs.key < rhs.key;});
+}
+////////////////////////////////////////////////////////////////////////////////
+void EuclideanCluster::join_cells(const std::size_t tile)
+{
+  const std::size_t bins_end = std::min((tile + 1U) * TASK_CHUNK_SIZE, m_bins.size());
+  for (std::size_t bin_idx = tile * TASK_CHUNK_SIZE; bin_idx < bins_end; ++bin_idx) {
+    const Bin & bin = m_bins[bin_idx];
+    for (std::size_t idx = bin.begin; idx < bin.end; ++idx) {
+      m_cells[idx] = get_cell(m_points[idx].get_point(), m_inv_cell_size, idx);
+      m_cell_members[idx] = idx;
+    }
+    std::sort(
+      m_cell_members.begin() + static_cast<std::ptrdiff_t>(bin.begin),
+      m_cell_members.begin() + static_cast<std::ptrdiff_t>(bin.end),
+      [this](const std::size_t lhs, const std::size_t rhs) {
+        return (m_cells[lhs] < m_cells[rhs]) || ((m_cells[lhs] == m_cells[rhs]) && (lhs < rhs));
+      });
+    // Points of a group are connected to each other in both directions
+    std::size_t groups_end = bin.begin;
+    for (std::size_t cell_idx = bin.begin; cell_idx < bin.end; ++cell_idx) {
+      const std::size_t idx = m_cell_members[cell_idx];
+      if ((cell_idx == bin.begin) || (m_cells[m_cell_members[cell_idx - 1U]] != m_cells[idx])) {
+        m_groups[groups_end] = {cell_idx, cell_idx + 1U};
+        ++groups_end;
+      } else {
+        m_groups[groups_end - 1U].second = cell_idx + 1U;
+        (void)join(m_cell_members[m_groups[groups_end - 1U].first], idx);
+      }
+    }
+    m_bin_groups_ends[bin_idx] = groups_end;
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void EuclideanCluster::join_neighbors(const std::size_t tile, const std::size_t worker_idx)
+{
+  auto & bin_cache = m_bin_caches[worker_idx];
+  // The threshold is linear in r, so largest at one of the ends
+  const float32_t max_thresh = std::max(
+    m_config.threshold(0.0F), m_config.threshold(std::numeric_limits<float32_t>::max()));
+  const std::size_t bins_end = std::min((tile + 1U) * TASK_CHUNK_SIZE, m_bins.size());
+  for (std::size_t bin_idx = tile * TASK_CHUNK_SIZE; bin_idx < bins_end; ++bin_idx) {
+    const Bin & ref_bin = m_bins[bin_idx];
+    const auto & ref_pt = m_points[ref_bin.begin].get_point();
+    const auto ref_idx = m_hash_config.index3(ref_pt.x, ref_pt.y, 0.0F);
+    // The bins around this one are looked up at most once for all of its points
+    const auto cache_range = m_hash_config.bin_range(ref_idx, max_thresh);
+    const std::size_t cache_width = (cache_range.second.x - cache_range.first.x) + 1U;
+    bin_cache.assign(
+      cache_width * ((cache_range.second.y - cache_range.first.y) + 1U), &m_unknown_bin);
+
+    for (std::size_t group_idx = ref_bin.begin; group_idx < m_bin_groups_ends[bin_idx];
+      ++group_idx)
+    {
+      const auto & group = m_groups[group_idx];
+      float32_t group_thresh = 0.0F;
+      for (std::size_t cell_idx = group.first; cell_idx < group.second; ++cell_idx) {
+        group_thresh = std::max(group_thresh, m_query_thresholds[m_cell_members[cell_idx]]);
+      }
+      const float32_t group_thresh_2 = group_thresh * group_thresh;
+      const auto group_range = m_hash_config.bin_range(ref_idx, group_thresh);
+      std::size_t root = m_cell_members[group.first];
+      auto query_idx = group_range.first;
+      do {
+        const std::size_t cache_offset =
+          ((query_idx.y - cache_range.first.y) * cache_width) +
+          (query_idx.x - cache_range.first.x);
+        const Bin * bin = nullptr;
+        if (m_hash_config.is_candidate_bin(ref_idx, query_idx, group_thresh_2)) {
+          if (&m_unknown_bin == bin_cache[cache_offset]) {
+            bin_cache[cache_offset] =
+              find_bin(m_bins, 0U, m_bins.size(), m_hash_config.index(query_idx));
+          }
+          bin = bin_cache[cache_offset];
+        }
+        if (nullptr == bin) {
+          continue;
+        }
+        const auto nbr_groups_end =
+          m_bin_groups_ends[static_cast<std::size_t>(bin - m_bins.data())];
+        for (std::size_t nbr_group_idx = bin->begin; nbr_group_idx < nbr_groups_end;
+          ++nbr_group_idx)
+        {
+          // A single edge is enough to join two groups, so most pairs of points are skipped
+          const auto & nbr_group = m_groups[nbr_group_idx];
+          root = find_root(root);
+          if (find_root(m_cell_members[nbr_group.first]) == root) {
+            continue;
+          }
+          root = join_groups(ref_idx, query_idx, group, nbr_group, root);
+        }
+      } while (m_hash_config.next_bin(group_range, query_idx));
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t EuclideanCluster::join_groups(
+  const autoware::common::geometry::spatial_hash::details::Index3 & ref_idx,
+  const autoware::common::geometry::spatial_hash::details::Index3 & query_idx,
+  const std::pair<std::size_t, std::size_t> & group,
+  const std::pair<std::size_t, std::size_t> & nbr_group,
+  std::size_t root)
+{
+  for (std::size_t cell_idx = group.first; cell_idx < group.second; ++cell_idx) {
+    // Same neighbors as SpatialHash::near finds in add_neighbors_to_last_cluster
+    const std::size_t idx = m_cell_members[cell_idx];
+    const auto & pt = m_points[idx].get_point();
+    const float32_t thresh1 = m_query_thresholds[idx];
+    const float32_t thresh1_2 = thresh1 * thresh1;
+    const auto bin_range = m_hash_config.bin_range(ref_idx, thresh1);
+    const bool8_t is_in_range =
+      (query_idx.x >= bin_range.first.x) && (query_idx.x <= bin_range.second.x) &&
+      (query_idx.y >= bin_range.first.y) && (query_idx.y <= bin_range.second.y);
+    if (!is_in_range || !m_hash_config.is_candidate_bin(ref_idx, query_idx, thresh1_2)) {
+      continue;
+    }
+    for (std::size_t nbr_idx = nbr_group.first; nbr_idx < nbr_group.second; ++nbr_idx) {
+      const std::size_t jdx = m_cell_members[nbr_idx];
+      const float32_t dist2 = m_hash_config.distance_squared(pt.x, pt.y, 0.0F, m_points[jdx]);
+      // Ensure that threshold is satisfied bidirectionally
+      if ((dist2 <= thresh1_2) && (sqrtf(dist2) <= m_thresholds[jdx])) {
+        return join(root, jdx);
+      }
+    }
+  }
+  return root;
+}
+////////////////////////////////////////////////////////////////////////////////
+void EuclideanCluster::group_components()
+{
+  // The root of a component is its first point, so components are ordered by their first point
+  const std::size_t num_points = m_points.size();
+  for (std::size_t idx = 0U; idx < num_points; ++idx) {
+    m_roots[idx] = find_root(idx);
+    m_component_cursors[idx] = 0U;
+  }
+  for (std::size_t idx = 0U; idx < num_points; ++idx) {
+    ++m_component_cursors[m_roots[idx]];
+  }
+  m_components.clear();
+  std::size_t offset = 0U;
+  for (std::size_t idx = 0U; idx < num_points; ++idx) {
+    if (m_roots[idx] == idx) {
+      const std::size_t size = m_component_cursors[idx];
+      m_components.emplace_back(offset, offset + size);
+      m_component_cursors[idx] = offset;
+      offset += size;
+    }
+  }
+  // Counting sort, which keeps the snapshot order within each component
+  for (std::size_t idx = 0U; idx < num_points; ++idx) {
+    m_members[m_component_cursors[m_roots[idx]]++] = idx;
+    m_assigned[idx] = 0U;
+    m_cluster_ranges[idx] = {0U, 0U};
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void EuclideanCluster::traverse_components(const std::size_t chunk)
+{
+  const std::size_t components_end =
+    std::min((chunk + 1U) * TASK_CHUNK_SIZE, m_components.size());
+  for (std::size_t cmp_idx = chunk * TASK_CHUNK_SIZE; cmp_idx < components_end; ++cmp_idx) {
+    traverse_component(m_components[cmp_idx]);
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void EuclideanCluster::traverse_component(const std::pair<std::size_t, std::size_t> & component)
+{
+  // The clusters of cluster_impl never leave a component, and within a component they are seeded
+  // in snapshot order. Components are disjoint, so each one is traversed on its own, with only its
+  // own points in its bins. Everything is written to the component's own range of the buffers
+  const std::size_t begin = component.first;
+  const std::size_t end = component.second;
+  if ((end - begin) == 1U) {
+    // Single point, which is common for noise
+    const std::size_t seed = m_members[begin];
+    m_order[begin] = seed;
+    m_cluster_ranges[seed] = {begin, end};
+    return;
+  }
+  // Bins of the component, each with its points in snapshot order
+  (void)std::copy(
+    m_members.begin() + static_cast<std::ptrdiff_t>(begin),
+    m_members.begin() + static_cast<std::ptrdiff_t>(end),
+    m_bin_members.begin() + static_cast<std::ptrdiff_t>(begin));
+  std::sort(
+    m_bin_members.begin() + static_cast<std::ptrdiff_t>(begin),
+    m_bin_members.begin() + static_cast<std::ptrdiff_t>(end),
+    [this](const std::size_t lhs, const std::size_t rhs) {
+      return (m_keys[lhs] < m_keys[rhs]) || ((m_keys[lhs] == m_keys[rhs]) && (lhs < rhs));
+    });
+  std::size_t bins_end = begin;
+  for (std::size_t idx = begin; idx < end; ++idx) {
+    const auto key = m_keys[m_bin_members[idx]];
+    if ((bins_end == begin) || (m_component_bins[bins_end - 1U].key != key)) {
+      m_component_bins[bins_end] = Bin{key, idx, idx};
+      ++bins_end;
+    }
+    m_component_bins[bins_end - 1U].end = idx + 1U;
+  }
+  // Same procedure as cluster_impl
+  std::size_t last = begin;
+  for (std::size_t mem_idx = begin; mem_idx < end; ++mem_idx) {
+    const std::size_t seed = m_members[mem_idx];
+    if (0U != m_assigned[seed]) {
+      continue;
+    }
+    const std::size_t first = last;
+    m_assigned[seed] = 1U;
+    m_order[last++] = seed;
+    for (std::size_t next = first; next < last; ++next) {
+      const auto & pt = m_points[m_order[next]].get_point();
+      const float32_t thresh1 = m_query_thresholds[m_order[next]];
+      const float32_t thresh1_2 = thresh1 * thresh1;
+      const auto ref_idx = m_hash_config.index3(pt.x, pt.y, 0.0F);
+      const auto bin_range = m_hash_config.bin_range(ref_idx, thresh1);
+      auto query_idx = bin_range.first;
+      do {
+        Bin * const bin = m_hash_config.is_candidate_bin(ref_idx, query_idx, thresh1_2) ?
+          find_bin(m_component_bins, begin, bins_end, m_hash_config.index(query_idx)) : nullptr;
+        if (nullptr != bin) {
+          // Assigned points are removed from the bin, keeping the order of the others
+          std::size_t kept = bin->begin;
+          for (std::size_t bin_idx = bin->begin; bin_idx < bin->end; ++bin_idx) {
+            const std::size_t nbr = m_bin_members[bin_idx];
+            if (0U != m_assigned[nbr]) {
+              continue;
+            }
+            const float32_t dist2 = m_hash_config.distance_squared(pt.x, pt.y, 0.0F, m_points[nbr]);
+            // Ensure that threshold is satisfied bidirectionally
+            if ((dist2 <= thresh1_2) && (sqrtf(dist2) <= m_thresholds[nbr])) {
+              m_assigned[nbr] = 1U;
+              m_order[last++] = nbr;
+            } else {
+              m_bin_members[kept++] = nbr;
+            }
+          }
+          bin->end = kept;
+        }
+      } while (m_hash_config.next_bin(bin_range, query_idx));
+    }
+    m_cluster_ranges[seed] = {first, last};
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void EuclideanCluster::run_workers(
+  const std::size_t num_tasks,
+  const common::helper_functions::WorkerPool::Work & task)
+{
+  try {
+    m_workers.run(num_tasks, task);
+  } catch (...) {
+    // Don't leave stale points behind for the next scan
+    m_hash.clear();
+    throw;
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+template<typename BinsT>
+auto EuclideanCluster::find_bin(
+  BinsT & bins,
+  const std::size_t begin,
+  const std::size_t end,
+  const autoware::common::geometry::spatial_hash::Index key) -> decltype(&bins[0U])
+{
+  const auto it = std::lower_bound(
+    bins.begin() + static_cast<std::ptrdiff_t>(begin),
+    bins.begin() + static_cast<std::ptrdiff_t>(end), key,
+    [](const Bin & bin, const autoware::common::geometry::spatial_hash::Index k) {
+      return bin.key < k;
+    });
+  const auto bins_end = bins.begin() + static_cast<std::ptrdiff_t>(end);
+  return ((it != bins_end) && (it->key == key)) ? &(*it) : nullptr;
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t EuclideanCluster::find_root(std::size_t idx)
+{
+  while (true) {
+    std::size_t parent = m_parents[idx].load();
+    if (parent == idx) {
+      return idx;
+    }
+    const std::size_t grandparent = m_parents[parent].load();
+    if (grandparent == parent) {
+      return parent;
+    }
+    // Path halving; if the exchange fails, another thread has already shortened the path
+    (void)m_parents[idx].compare_exchange_weak(parent, grandparent);
+    idx = grandparent;
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t EuclideanCluster::join(std::size_t idx1, std::size_t idx2)
+{
+  while (true) {
+    idx1 = find_root(idx1);
+    idx2 = find_root(idx2);
+    if (idx1 == idx2) {
+      return idx1;
+    }
+    if (idx1 > idx2) {
+      std::swap(idx1, idx2);
+    }
+    // Only link a root, i.e. retry if another thread has linked idx2 in the meantime
+    std::size_t expected = idx2;
+    if (m_parents[idx2].compare_exchange_strong(expected, idx1)) {
+      return idx1;
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void EuclideanCluster::start_cluster(Clusters & clusters)
+{
+  // initialize new cluster in clusters
+  if (clusters.cluster_boundary.empty()) {
+    clusters.cluster_boundary.emplace_back(0U);
+  } else {
+    clusters.cluster_boundary.emplace_back(clusters.cluster_boundary.back());
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
 void EuclideanCluster::add_point_to_last_cluster(Clusters & clusters, const PointXYZIR & pt)
 {
   // If there are non-valid points in the container due to rejecting small clusters,
@@ -282,6 +742,32 @@ std::size_t EuclideanCluster::last_cluster_size(const Clusters & clusters)
 ////////////////////////////////////////////////////////////////////////////////
 namespace details
 {
+bool8_t compute_bounding_box(
+  Clusters & clusters, const std::size_t cls_id, const BboxMethod method,
+  const bool8_t compute_height, BoundingBox & box)
+{
+  // The boxes are fit on the points of the message; LFit reorders them in place
+  const common::lidar_utils::MutableSingleClusterView cluster{
+    clusters, static_cast<uint32_t>(cls_id)};
+  if (cluster.empty()) {
+    return false;
+  }
+
+  switch (method) {
+    case BboxMethod::Eigenbox:
+      box = common::geometry::bounding_box::eigenbox_2d(cluster);
+      break;
+    case BboxMethod::LFit:
+      box = common::geometry::bounding_box::lfit_bounding_box_2d(cluster);
+      break;
+  }
+
+  if (compute_height) {
+    common::geometry::bounding_box::compute_height(cluster, box);
+  }
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////
 BoundingBoxArray compute_bounding_boxes(
   Clusters & clusters, const BboxMethod method,
   const bool compute_height)
@@ -289,27 +775,9 @@ BoundingBoxArray compute_bounding_boxes(
   BoundingBoxArray boxes;
   for (uint32_t cls_id = 0U; cls_id < clusters.cluster_boundary.size(); cls_id++) {
     try {
-      const auto iter_pair = common::lidar_utils::get_cluster(clusters, cls_id);
-      if (iter_pair.first == iter_pair.second) {
-        continue;
-      }
-
-      switch (method) {
-        case BboxMethod::Eigenbox: boxes.boxes.push_back(
-            common::geometry::bounding_box::eigenbox_2d(
-              iter_pair.first,
-              iter_pair.second));
-          break;
-        case BboxMethod::LFit:     boxes.boxes.push_back(
-            common::geometry::bounding_box::lfit_bounding_box_2d(
-              iter_pair.first,
-              iter_pair.second));
-          break;
-      }
-
-      if (compute_height) {
-        common::geometry::bounding_box::compute_height(
-          iter_pair.first, iter_pair.second, boxes.boxes.back());
+      BoundingBox box;
+      if (compute_bounding_box(clusters, cls_id, method, compute_height, box)) {
+        boxes.boxes.push_back(box);
       }
     } catch (const std::exception & e) {
       std::cerr << e.what() << std::endl;
@@ -318,20 +786,43 @@ BoundingBoxArray compute_bounding_boxes(
   return boxes;
 }
 ////////////////////////////////////////////////////////////////////////////////
+std::size_t compute_convex_hull(
+  Clusters & clusters, const std::size_t cls_id, const Clusters::_points_type::iterator hull)
+{
+  const auto iter_pair = common::lidar_utils::get_cluster(clusters, cls_id);
+  const auto hull_end =
+    common::geometry::convex_hull(iter_pair.first, iter_pair.second, hull);
+  return static_cast<std::size_t>(std::distance(hull, hull_end));
+}
+////////////////////////////////////////////////////////////////////////////////
+void compute_convex_hulls(Clusters & clusters, Clusters & hulls)
+{
+  const std::size_t num_clusters = clusters.cluster_boundary.size();
+  // Each hull needs room for the points of its cluster plus one, and starts where the previous
+  // one ends, so it never runs past this
+  hulls.points.resize(clusters.points.size() + num_clusters);
+  hulls.cluster_boundary.resize(num_clusters);
+  std::size_t num_points = 0U;
+  for (std::size_t cls_id = 0U; cls_id < num_clusters; ++cls_id) {
+    num_points += compute_convex_hull(
+      clusters, cls_id, hulls.points.begin() + static_cast<std::ptrdiff_t>(num_points));
+    hulls.cluster_boundary[cls_id] = static_cast<uint32_t>(num_points);
+  }
+  hulls.points.resize(num_points);
+}
+////////////////////////////////////////////////////////////////////////////////
 BoundingBoxArray compute_lfit_bounding_boxes(Clusters & clusters, const bool compute_height)
 {
   BoundingBoxArray boxes;
   for (uint32_t cls_id = 0U; cls_id < clusters.cluster_boundary.size(); cls_id++) {
     try {
-      const auto iter_pair = common::lidar_utils::get_cluster(clusters, cls_id);
-      if (iter_pair.first == iter_pair.second) {
+      const common::lidar_utils::MutableSingleClusterView cluster{clusters, cls_id};
+      if (cluster.empty()) {
         continue;
       }
-      boxes.boxes.push_back(
-        common::geometry::bounding_box::lfit_bounding_box_2d(iter_pair.first, iter_pair.second));
+      boxes.boxes.push_back(common::geometry::bounding_box::lfit_bounding_box_2d(cluster));
       if (compute_height) {
-        common::geometry::bounding_box::compute_height(
-          iter_pair.first, iter_pair.second, boxes.boxes.back());
+        common::geometry::bounding_box::compute_height(cluster, boxes.boxes.back());
       }
     } catch (const std::exception & e) {
       std::cerr << e.what() << std::endl;
@@ -0,0 +1,423 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "euclidean_cluster/grid_cluster.hpp"
+
+namespace autoware
+{
+namespace perception
+{
+namespace segmentation
+{
+namespace euclidean_cluster
+{
+using autoware::common::types::float64_t;
+
+namespace
+{
+// Marks cells without points
+constexpr std::size_t NO_SLOT = std::numeric_limits<std::size_t>::max();
+// Upper bound on the number of cells, to catch unreasonable configurations
+constexpr float64_t MAX_NUM_CELLS = 1.0E9;
+
+std::size_t num_cells(const float32_t min, const float32_t max, const float32_t cell_size)
+{
+  const float64_t num = std::ceil(
+    static_cast<float64_t>(max - min) / static_cast<float64_t>(cell_size));
+  // Also catches NaN
+  if (!((num >= 1.0) && (num <= MAX_NUM_CELLS))) {
+    throw std::domain_error{"GridConfig: Bounds and cell size do not define a valid grid"};
+  }
+  return static_cast<std::size_t>(num);
+}
+}  // namespace
+////////////////////////////////////////////////////////////////////////////////
+GridConfig::GridConfig(
+  const float32_t min_x,
+  const float32_t max_x,
+  const float32_t min_y,
+  const float32_t max_y,
+  const float32_t cell_size_m,
+  const std::size_t capacity)
+: m_min_x(min_x),
+  m_min_y(min_y),
+  m_cell_size(cell_size_m),
+  m_width(num_cells(min_x, max_x, cell_size_m)),
+  m_height(num_cells(min_y, max_y, cell_size_m)),
+  m_capacity(capacity)
+{
+  if (!(cell_size_m > 0.0F)) {
+    throw std::domain_error{"GridConfig: Cell size must be positive"};
+  }
+  if ((static_cast<float64_t>(m_width) * static_cast<float64_t>(m_height)) > MAX_NUM_CELLS) {
+    throw std::domain_error{"GridConfig: Too many cells"};
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+float32_t GridConfig::min_x() const
+{
+  return m_min_x;
+}
+////////////////////////////////////////////////////////////////////////////////
+float32_t GridConfig::min_y() const
+{
+  return m_min_y;
+}
+////////////////////////////////////////////////////////////////////////////////
+float32_t GridConfig::cell_size() const
+{
+  return m_cell_size;
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t GridConfig::width() const
+{
+  return m_width;
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t GridConfig::height() const
+{
+  return m_height;
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t GridConfig::capacity() const
+{
+  return m_capacity;
+}
+////////////////////////////////////////////////////////////////////////////////
+GridCluster::GridCluster(const Config & cfg, const GridConfig & grid_cfg)
+: m_config(cfg),
+  m_grid_config(grid_cfg),
+  m_last_error(Error::NONE),
+  m_cell_slots(grid_cfg.width() * grid_cfg.height(), NO_SLOT),
+  m_has_previous(false),
+  m_num_reused_cells(0U)
+{
+  // Preallocate everything which scales with the number of points
+  const std::size_t capacity = m_grid_config.capacity();
+  m_slot_cells.reserve(capacity);
+  m_slot_sizes.reserve(capacity);
+  m_parents.reserve(capacity);
+  m_ranks.reserve(capacity);
+  m_root_labels.reserve(capacity);
+  m_labels.reserve(capacity);
+  m_points.reserve(capacity);
+  m_point_slots.reserve(capacity);
+  m_component_offsets.reserve(capacity);
+  m_prev_cells.reserve(capacity);
+  m_prev_label_sizes.reserve(capacity);
+  m_slot_prev_labels.reserve(capacity);
+  m_prev_label_matches.reserve(capacity);
+  m_prev_label_reusable.reserve(capacity);
+  m_prev_label_roots.reserve(capacity);
+}
+////////////////////////////////////////////////////////////////////////////////
+void GridCluster::insert(const PointXYZIR & pt)
+{
+  if (m_points.size() >= m_grid_config.capacity()) {
+    throw std::length_error{"GridCluster: Capacity exceeded"};
+  }
+  const float32_t inv_cell_size = 1.0F / m_grid_config.cell_size();
+  const float32_t x = std::floor((pt.get_point().x - m_grid_config.min_x()) * inv_cell_size);
+  const float32_t y = std::floor((pt.get_point().y - m_grid_config.min_y()) * inv_cell_size);
+  // Also catches NaN coordinates
+  if (!((x >= 0.0F) && (x < static_cast<float32_t>(m_grid_config.width())) &&
+    (y >= 0.0F) && (y < static_cast<float32_t>(m_grid_config.height()))))
+  {
+    return;
+  }
+  const std::size_t cell =
+    (static_cast<std::size_t>(y) * m_grid_config.width()) + static_cast<std::size_t>(x);
+  std::size_t & slot = m_cell_slots[cell];
+  if (NO_SLOT == slot) {
+    slot = m_slot_cells.size();
+    m_slot_cells.push_back(cell);
+    m_slot_sizes.push_back(0U);
+    m_parents.push_back(slot);
+    m_ranks.push_back(0U);
+  }
+  ++m_slot_sizes[slot];
+  m_points.push_back(pt);
+  m_point_slots.push_back(slot);
+}
+////////////////////////////////////////////////////////////////////////////////
+void GridCluster::cluster(Clusters & clusters)
+{
+  m_has_previous = false;
+  for (std::size_t slot = 0U; slot < m_slot_cells.size(); ++slot) {
+    join_neighbors(slot);
+  }
+  emit(clusters);
+  clear();
+}
+////////////////////////////////////////////////////////////////////////////////
+void GridCluster::cluster(
+  Clusters & clusters,
+  const float32_t displacement_x,
+  const float32_t displacement_y)
+{
+  reuse_previous(displacement_x, displacement_y);
+  // The cells of a reused component have no neighbors outside of it, see reuse_previous
+  for (std::size_t slot = 0U; slot < m_slot_cells.size(); ++slot) {
+    const std::size_t prev_label = m_slot_prev_labels[slot];
+    if ((NO_SLOT == prev_label) || (0U == m_prev_label_reusable[prev_label])) {
+      join_neighbors(slot);
+    }
+  }
+  emit(clusters);
+  store_previous();
+  clear();
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t GridCluster::get_num_reused_cells() const
+{
+  return m_num_reused_cells;
+}
+////////////////////////////////////////////////////////////////////////////////
+void GridCluster::join_neighbors(const std::size_t slot)
+{
+  // Joining with the four neighbors in the next column and the next row visits every pair of
+  // neighboring cells once
+  const std::size_t width = m_grid_config.width();
+  const std::size_t height = m_grid_config.height();
+  const std::size_t cell = m_slot_cells[slot];
+  const std::size_t x = cell % width;
+  const std::size_t y = cell / width;
+  if ((x + 1U) < width) {
+    join(slot, cell + 1U);
+    if (y > 0U) {
+      join(slot, (cell + 1U) - width);
+    }
+    if ((y + 1U) < height) {
+      join(slot, cell + 1U + width);
+    }
+  }
+  if ((y + 1U) < height) {
+    join(slot, cell + width);
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void GridCluster::emit(Clusters & clusters)
+{
+  clusters.points.clear();
+  clusters.cluster_boundary.clear();
+  m_last_error = Error::NONE;
+  const std::size_t num_slots = m_slot_cells.size();
+  // Label the components in the order of their first point, and count their points
+  m_root_labels.assign(num_slots, NO_SLOT);
+  m_labels.resize(num_slots);
+  m_component_offsets.clear();
+  for (std::size_t slot = 0U; slot < num_slots; ++slot) {
+    std::size_t & label = m_root_labels[find_root(slot)];
+    if (NO_SLOT == label) {
+      label = m_component_offsets.size();
+      m_component_offsets.push_back(0U);
+    }
+    m_labels[slot] = label;
+    m_component_offsets[label] += m_slot_sizes[slot];
+  }
+  // Emit large enough components in order, and turn their sizes into write positions
+  std::size_t num_points = 0U;
+  for (auto & offset : m_component_offsets) {
+    const std::size_t size = offset;
+    if (size < m_config.min_cluster_size()) {
+      offset = NO_SLOT;
+    } else if (clusters.cluster_boundary.size() >= m_config.max_num_clusters()) {
+      m_last_error = Error::TOO_MANY_CLUSTERS;
+      offset = NO_SLOT;
+    } else {
+      offset = num_points;
+      num_points += size;
+      clusters.cluster_boundary.emplace_back(static_cast<uint32_t>(num_points));
+    }
+  }
+  clusters.points.resize(num_points);
+  for (std::size_t idx = 0U; idx < m_points.size(); ++idx) {
+    std::size_t & offset = m_component_offsets[m_labels[m_point_slots[idx]]];
+    if (NO_SLOT != offset) {
+      clusters.points[offset] = static_cast<autoware_auto_msgs::msg::PointXYZIF>(m_points[idx]);
+      ++offset;
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void GridCluster::reuse_previous(const float32_t displacement_x, const float32_t displacement_y)
+{
+  const std::size_t num_slots = m_slot_cells.size();
+  m_slot_prev_labels.assign(num_slots, NO_SLOT);
+  m_num_reused_cells = 0U;
+  const std::size_t width = m_grid_config.width();
+  const std::size_t height = m_grid_config.height();
+  const float32_t inv_cell_size = 1.0F / m_grid_config.cell_size();
+  const float32_t shift_x = std::round(displacement_x * inv_cell_size);
+  const float32_t shift_y = std::round(displacement_y * inv_cell_size);
+  // Also catches NaN; with a shift across the whole grid no cell could be reused anyway
+  if (!(m_has_previous && (std::fabs(shift_x) < static_cast<float32_t>(width)) &&
+    (std::fabs(shift_y) < static_cast<float32_t>(height))))
+  {
+    return;
+  }
+  const auto dx = static_cast<int64_t>(shift_x);
+  const auto dy = static_cast<int64_t>(shift_y);
+  // Match the occupied cells with the shifted previous cells, which is one to one. Then the
+  // previous components with all their cells matched are still connected
+  const std::size_t num_labels = m_prev_label_sizes.size();
+  m_prev_label_matches.assign(num_labels, 0U);
+  for (std::size_t slot = 0U; slot < num_slots; ++slot) {
+    const std::size_t cell = m_slot_cells[slot];
+    const int64_t prev_x = static_cast<int64_t>(cell % width) - dx;
+    const int64_t prev_y = static_cast<int64_t>(cell / width) - dy;
+    if ((prev_x >= 0) && (prev_x < static_cast<int64_t>(width)) &&
+      (prev_y >= 0) && (prev_y < static_cast<int64_t>(height)))
+    {
+      const std::size_t prev_label = m_prev_cell_labels[
+        (static_cast<std::size_t>(prev_y) * width) + static_cast<std::size_t>(prev_x)];
+      m_slot_prev_labels[slot] = prev_label;
+      if (NO_SLOT != prev_label) {
+        ++m_prev_label_matches[prev_label];
+      }
+    }
+  }
+  m_prev_label_reusable.resize(num_labels);
+  for (std::size_t label = 0U; label < num_labels; ++label) {
+    m_prev_label_reusable[label] =
+      (m_prev_label_matches[label] == m_prev_label_sizes[label]) ? 1U : 0U;
+  }
+  // A newly occupied cell may join previous components. There are no other joins, because
+  // neighboring matched cells were neighbors before, i.e. of the same component
+  for (std::size_t slot = 0U; slot < num_slots; ++slot) {
+    if (NO_SLOT != m_slot_prev_labels[slot]) {
+      continue;
+    }
+    const std::size_t cell = m_slot_cells[slot];
+    const std::size_t x = cell % width;
+    const std::size_t y = cell / width;
+    for (std::size_t ny = (y > 0U) ? (y - 1U) : y; (ny <= (y + 1U)) && (ny < height); ++ny) {
+      for (std::size_t nx = (x > 0U) ? (x - 1U) : x; (nx <= (x + 1U)) && (nx < width); ++nx) {
+        const std::size_t other_slot = m_cell_slots[(ny * width) + nx];
+        if ((NO_SLOT != other_slot) && (NO_SLOT != m_slot_prev_labels[other_slot])) {
+          m_prev_label_reusable[m_slot_prev_labels[other_slot]] = 0U;
+        }
+      }
+    }
+  }
+  // Join the cells of each reused component directly to its first cell
+  m_prev_label_roots.assign(num_labels, NO_SLOT);
+  for (std::size_t slot = 0U; slot < num_slots; ++slot) {
+    const std::size_t prev_label = m_slot_prev_labels[slot];
+    if ((NO_SLOT == prev_label) || (0U == m_prev_label_reusable[prev_label])) {
+      continue;
+    }
+    std::size_t & root = m_prev_label_roots[prev_label];
+    if (NO_SLOT == root) {
+      root = slot;
+    } else {
+      m_parents[slot] = root;
+      m_ranks[root] = 1U;
+    }
+    ++m_num_reused_cells;
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void GridCluster::store_previous()
+{
+  if (m_prev_cell_labels.empty()) {
+    m_prev_cell_labels.assign(m_cell_slots.size(), NO_SLOT);
+  }
+  for (const auto cell : m_prev_cells) {
+    m_prev_cell_labels[cell] = NO_SLOT;
+  }
+  m_prev_cells = m_slot_cells;
+  m_prev_label_sizes.assign(m_component_offsets.size(), 0U);
+  for (std::size_t slot = 0U; slot < m_slot_cells.size(); ++slot) {
+    m_prev_cell_labels[m_slot_cells[slot]] = m_labels[slot];
+    ++m_prev_label_sizes[m_labels[slot]];
+  }
+  m_has_previous = true;
+}
+////////////////////////////////////////////////////////////////////////////////
+GridCluster::Error GridCluster::get_error() const
+{
+  return m_last_error;
+}
+////////////////////////////////////////////////////////////////////////////////
+const Config & GridCluster::get_config() const
+{
+  return m_config;
+}
+////////////////////////////////////////////////////////////////////////////////
+void GridCluster::throw_stored_error() const
+{
+  switch (get_error()) {
+    case Error::TOO_MANY_CLUSTERS:
+      throw std::runtime_error{"GridCluster: Too many clusters"};
+    case Error::NONE:
+    default:
+      break;
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t GridCluster::find_root(std::size_t slot)
+{
+  while (m_parents[slot] != slot) {
+    m_parents[slot] = m_parents[m_parents[slot]];
+    slot = m_parents[slot];
+  }
+  return slot;
+}
+////////////////////////////////////////////////////////////////////////////////
+void GridCluster::join(const std::size_t slot, const std::size_t cell)
+{
+  const std::size_t other_slot = m_cell_slots[cell];
+  if (NO_SLOT == other_slot) {
+    return;
+  }
+  std::size_t root1 = find_root(slot);
+  std::size_t root2 = find_root(other_slot);
+  if (root1 == root2) {
+    return;
+  }
+  // Union by rank, as in the disjoint set of apollo_lidar_segmentation
+  if (m_ranks[root1] < m_ranks[root2]) {
+    std::swap(root1, root2);
+  } else if (m_ranks[root1] == m_ranks[root2]) {
+    ++m_ranks[root1];
+  }
+  m_parents[root2] = root1;
+}
+////////////////////////////////////////////////////////////////////////////////
+void GridCluster::clear()
+{
+  for (const auto cell : m_slot_cells) {
+    m_cell_slots[cell] = NO_SLOT;
+  }
+  m_slot_cells.clear();
+  m_slot_sizes.clear();
+  m_parents.clear();
+  m_ranks.clear();
+  m_points.clear();
+  m_point_slots.clear();
+}
+}  // namespace euclidean_cluster
+}  // namespace segmentation
+}  // namespace perception
+}  // namespace autoware
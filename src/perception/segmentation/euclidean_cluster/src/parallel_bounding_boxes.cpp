@@ -0,0 +1,144 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "euclidean_cluster/parallel_bounding_boxes.hpp"
+
+namespace autoware
+{
+namespace perception
+{
+namespace segmentation
+{
+namespace euclidean_cluster
+{
+namespace details
+{
+
+////////////////////////////////////////////////////////////////////////////////
+ParallelBoundingBoxes::ParallelBoundingBoxes(const std::size_t num_workers)
+: m_pool(num_workers),
+  m_hulls(nullptr),
+  m_method(BboxMethod::Eigenbox),
+  m_compute_height(false)
+{
+}
+////////////////////////////////////////////////////////////////////////////////
+void ParallelBoundingBoxes::compute(
+  Clusters & clusters,
+  const BboxMethod method,
+  const bool8_t compute_height,
+  BoundingBoxArray & boxes)
+{
+  const auto & boundaries = clusters.cluster_boundary;
+  m_results.resize(boundaries.size());
+  m_hulls = nullptr;
+  m_method = method;
+  m_compute_height = compute_height;
+  run_batch(clusters);
+  // Gather in cluster order
+  boxes.boxes.clear();
+  for (std::size_t cls_id = 0U; cls_id < boundaries.size(); ++cls_id) {
+    if (m_results[cls_id].valid) {
+      boxes.boxes.push_back(m_results[cls_id].box);
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+void ParallelBoundingBoxes::compute_hulls(Clusters & clusters, Clusters & hulls)
+{
+  const auto & boundaries = clusters.cluster_boundary;
+  // Each hull is written at the start of its cluster, shifted by one per previous cluster for the
+  // scratch point of each hull
+  hulls.points.resize(clusters.points.size() + boundaries.size());
+  hulls.cluster_boundary.resize(boundaries.size());
+  m_hull_sizes.resize(boundaries.size());
+  m_hulls = &hulls;
+  run_batch(clusters);
+  m_hulls = nullptr;
+  // Pack in cluster order; hulls only move towards the front
+  std::size_t num_points = 0U;
+  for (std::size_t cls_id = 0U; cls_id < boundaries.size(); ++cls_id) {
+    const auto src = hulls.points.begin() +
+      static_cast<std::ptrdiff_t>(((0U == cls_id) ? 0U : boundaries[cls_id - 1U]) + cls_id);
+    const auto dst = hulls.points.begin() + static_cast<std::ptrdiff_t>(num_points);
+    const auto size = static_cast<std::ptrdiff_t>(m_hull_sizes[cls_id]);
+    if (src != dst) {
+      (void)std::copy(src, src + size, dst);
+    }
+    num_points += m_hull_sizes[cls_id];
+    hulls.cluster_boundary[cls_id] = static_cast<uint32_t>(num_points);
+  }
+  hulls.points.resize(num_points);
+}
+////////////////////////////////////////////////////////////////////////////////
+void ParallelBoundingBoxes::run_batch(Clusters & clusters)
+{
+  // Largest clusters first; ties are broken by index so that the schedule is deterministic
+  const auto & boundaries = clusters.cluster_boundary;
+  const auto cluster_size = [&boundaries](const std::size_t cls_id) {
+      return boundaries[cls_id] - ((0U == cls_id) ? 0U : boundaries[cls_id - 1U]);
+    };
+  m_order.resize(boundaries.size());
+  for (std::size_t cls_id = 0U; cls_id < m_order.size(); ++cls_id) {
+    m_order[cls_id] = cls_id;
+  }
+  std::sort(
+    m_order.begin(), m_order.end(),
+    [&cluster_size](const std::size_t a, const std::size_t b) {
+      const auto size_a = cluster_size(a);
+      const auto size_b = cluster_size(b);
+      return (size_a != size_b) ? (size_a > size_b) : (a < b);
+    });
+  m_pool.run(
+    m_order.size(), [this, &clusters](const std::size_t idx, const std::size_t) {
+      process(clusters, m_order[idx]);
+    });
+}
+////////////////////////////////////////////////////////////////////////////////
+std::size_t ParallelBoundingBoxes::get_num_workers() const
+{
+  return m_pool.get_num_workers();
+}
+////////////////////////////////////////////////////////////////////////////////
+void ParallelBoundingBoxes::process(Clusters & clusters, const std::size_t cls_id)
+{
+  if (nullptr != m_hulls) {
+    const auto & boundaries = clusters.cluster_boundary;
+    const auto offset = ((0U == cls_id) ? 0U : boundaries[cls_id - 1U]) + cls_id;
+    m_hull_sizes[cls_id] = compute_convex_hull(
+      clusters, cls_id, m_hulls->points.begin() + static_cast<std::ptrdiff_t>(offset));
+    return;
+  }
+  Result & result = m_results[cls_id];
+  result.valid = false;
+  try {
+    result.valid = compute_bounding_box(clusters, cls_id, m_method, m_compute_height, result.box);
+  } catch (const std::exception & e) {
+    // Same as compute_bounding_boxes: the cluster is skipped
+    std::lock_guard<std::mutex> lock{m_print_mutex};
+    std::cerr << e.what() << std::endl;
+  }
+}
+
+}  // namespace details
+}  // namespace euclidean_cluster
+}  // namespace segmentation
+}  // namespace perception
+}  // namespace autoware
@@ -0,0 +1,200 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <benchmark/benchmark.h>
+#include <euclidean_cluster/euclidean_cluster.hpp>
+#include <euclidean_cluster/grid_cluster.hpp>
+#include <euclidean_cluster/parallel_bounding_boxes.hpp>
+#include <geometry/convex_hull.hpp>
+#include <lidar_utils/point_cloud_utils.hpp>
+
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr auto kCloudSize = 50000UL;
+
+using autoware::perception::segmentation::euclidean_cluster::Clusters;
+using autoware::perception::segmentation::euclidean_cluster::Config;
+using autoware::perception::segmentation::euclidean_cluster::EuclideanCluster;
+using autoware::perception::segmentation::euclidean_cluster::GridCluster;
+using autoware::perception::segmentation::euclidean_cluster::GridConfig;
+using autoware::perception::segmentation::euclidean_cluster::HashConfig;
+using autoware::perception::segmentation::euclidean_cluster::PointXYZI;
+using autoware::perception::segmentation::euclidean_cluster::details::compute_convex_hulls;
+using autoware::perception::segmentation::euclidean_cluster::details::ParallelBoundingBoxes;
+
+// Objects of up to a few hundred points scattered around the vehicle, and some noise
+std::vector<PointXYZI> create_scene(const std::size_t size)
+{
+  std::mt19937 generator{42U};
+  std::uniform_real_distribution<float> center_distribution{-80.0F, 80.0F};
+  std::uniform_int_distribution<std::size_t> size_distribution{1U, 400U};
+  std::normal_distribution<float> spread_distribution{0.0F, 1.0F};
+  std::vector<PointXYZI> points;
+  points.reserve(size);
+  while (points.size() < ((size * 9U) / 10U)) {
+    const float cx = center_distribution(generator);
+    const float cy = center_distribution(generator);
+    const std::size_t num_points = size_distribution(generator);
+    for (std::size_t i = 0U; (i < num_points) && (points.size() < size); ++i) {
+      points.push_back(
+        PointXYZI{cx + spread_distribution(generator), cy + spread_distribution(generator), 0.0F,
+          0.0F});
+    }
+  }
+  while (points.size() < size) {
+    points.push_back(
+      PointXYZI{center_distribution(generator), center_distribution(generator), 0.0F, 0.0F});
+  }
+  return points;
+}
+
+Clusters create_clusters()
+{
+  const auto points = create_scene(kCloudSize);
+  const Config cfg{"base_link", 10U, 1024U, 0.5F, 1.5F, 60.0F};
+  const HashConfig hash_cfg{-130.0F, 130.0F, -130.0F, 130.0F, 1.0F, kCloudSize};
+  EuclideanCluster cls{cfg, hash_cfg};
+  Clusters clusters;
+  cls.insert(points.begin(), points.end());
+  cls.cluster(clusters);
+  return clusters;
+}
+
+}  // namespace
+
+static void BenchEuclideanCluster(benchmark::State & state)
+{
+  const auto points = create_scene(kCloudSize);
+  const Config cfg{"base_link", 10U, 1024U, 0.5F, 1.5F, 60.0F};
+  const HashConfig hash_cfg{-130.0F, 130.0F, -130.0F, 130.0F, 1.0F, kCloudSize};
+  EuclideanCluster cls{cfg, hash_cfg, static_cast<std::size_t>(state.range(0))};
+  Clusters clusters;
+  clusters.points.reserve(kCloudSize);
+  clusters.cluster_boundary.reserve(cfg.max_num_clusters());
+  for (auto _ : state) {
+    state.PauseTiming();
+    cls.insert(points.begin(), points.end());
+    state.ResumeTiming();
+    cls.cluster(clusters);
+    benchmark::DoNotOptimize(clusters.cluster_boundary.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kCloudSize));
+}
+
+BENCHMARK(BenchEuclideanCluster)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)
+->UseRealTime();
+
+static void BenchGridCluster(benchmark::State & state)
+{
+  const auto points = create_scene(kCloudSize);
+  const Config cfg{"base_link", 10U, 1024U, 0.5F, 1.5F, 60.0F};
+  // Points in neighboring cells are up to 2 * sqrt(2) cell sizes apart
+  const GridConfig grid_cfg{-130.0F, 130.0F, -130.0F, 130.0F, 0.5F, kCloudSize};
+  GridCluster cls{cfg, grid_cfg};
+  Clusters clusters;
+  clusters.points.reserve(kCloudSize);
+  clusters.cluster_boundary.reserve(cfg.max_num_clusters());
+  for (auto _ : state) {
+    state.PauseTiming();
+    cls.insert(points.begin(), points.end());
+    state.ResumeTiming();
+    cls.cluster(clusters);
+    benchmark::DoNotOptimize(clusters.cluster_boundary.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kCloudSize));
+}
+
+// Including the insertion, which does most of the work of GridCluster
+static void BenchGridClusterInsert(benchmark::State & state)
+{
+  const auto points = create_scene(kCloudSize);
+  const Config cfg{"base_link", 10U, 1024U, 0.5F, 1.5F, 60.0F};
+  const GridConfig grid_cfg{-130.0F, 130.0F, -130.0F, 130.0F, 0.5F, kCloudSize};
+  GridCluster cls{cfg, grid_cfg};
+  Clusters clusters;
+  clusters.points.reserve(kCloudSize);
+  clusters.cluster_boundary.reserve(cfg.max_num_clusters());
+  for (auto _ : state) {
+    cls.insert(points.begin(), points.end());
+    cls.cluster(clusters);
+    benchmark::DoNotOptimize(clusters.cluster_boundary.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kCloudSize));
+}
+
+BENCHMARK(BenchGridCluster)->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchGridClusterInsert)->Unit(benchmark::kMillisecond);
+
+// Baseline: the points of each cluster are copied into a list for convex_hull
+static void BenchConvexHullsPerCluster(benchmark::State & state)
+{
+  const auto clusters = create_clusters();
+  Clusters hulls;
+  for (auto _ : state) {
+    hulls.points.clear();
+    hulls.cluster_boundary.clear();
+    for (std::size_t cls_id = 0U; cls_id < clusters.cluster_boundary.size(); ++cls_id) {
+      const auto range = autoware::common::lidar_utils::get_cluster(clusters, cls_id);
+      std::list<autoware_auto_msgs::msg::PointXYZIF> list{range.first, range.second};
+      const auto hull_end = autoware::common::geometry::convex_hull(list);
+      hulls.points.insert(hulls.points.end(), list.cbegin(), hull_end);
+      hulls.cluster_boundary.push_back(static_cast<uint32_t>(hulls.points.size()));
+    }
+    benchmark::DoNotOptimize(hulls.points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(clusters.points.size()));
+}
+
+static void BenchConvexHulls(benchmark::State & state)
+{
+  const auto clusters = create_clusters();
+  Clusters cluster_copy;
+  Clusters hulls;
+  for (auto _ : state) {
+    // The points are sorted in place, start from the unsorted clusters each time
+    state.PauseTiming();
+    cluster_copy = clusters;
+    state.ResumeTiming();
+    compute_convex_hulls(cluster_copy, hulls);
+    benchmark::DoNotOptimize(hulls.points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(clusters.points.size()));
+}
+
+static void BenchParallelConvexHulls(benchmark::State & state)
+{
+  const auto clusters = create_clusters();
+  ParallelBoundingBoxes parallel{static_cast<std::size_t>(state.range(0))};
+  Clusters cluster_copy;
+  Clusters hulls;
+  for (auto _ : state) {
+    state.PauseTiming();
+    cluster_copy = clusters;
+    state.ResumeTiming();
+    parallel.compute_hulls(cluster_copy, hulls);
+    benchmark::DoNotOptimize(hulls.points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(clusters.points.size()));
+}
+
+BENCHMARK(BenchConvexHullsPerCluster)->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchConvexHulls)->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchParallelConvexHulls)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)
+->UseRealTime();
@@ -18,7 +18,13 @@
 #define TEST_BOUNDING_BOX_COMPUTATION_HPP_
 
 #include <euclidean_cluster/euclidean_cluster.hpp>
+#include <euclidean_cluster/parallel_bounding_boxes.hpp>
 
+#include <geometry/convex_hull.hpp>
+#include <lidar_utils/point_cloud_utils.hpp>
+
+#include <list>
+#include <random>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -31,8 +37,10 @@ using DetectedObject = autoware_auto_msgs::msg::DetectedObject;
 using Pt = autoware_auto_msgs::msg::PointXYZIF;
 
 using autoware::perception::segmentation::euclidean_cluster::details::compute_bounding_boxes;
+using autoware::perception::segmentation::euclidean_cluster::details::compute_convex_hulls;
 using autoware::perception::segmentation::euclidean_cluster::details::BboxMethod;
 using autoware::perception::segmentation::euclidean_cluster::details::convert_to_detected_objects;
+using autoware::perception::segmentation::euclidean_cluster::details::ParallelBoundingBoxes;
 
 class BoundingBoxComputationTest : public ::testing::Test
 {
@@ -213,5 +221,106 @@ TEST_F(BoundingBoxComputationTest, BasicEigen3d)
   }
 }
 
+TEST_F(BoundingBoxComputationTest, ParallelMatchesSerial)
+{
+  EXPECT_THROW(ParallelBoundingBoxes{0U}, std::domain_error);
+  std::mt19937 gen{7U};
+  std::uniform_real_distribution<float> coord{-1.0F, 1.0F};
+  std::uniform_int_distribution<size_t> num_points{2U, 300U};
+  const auto random_clusters = [&](const size_t num_clusters) {
+      std::vector<std::vector<Pt>> points_list{};
+      for (size_t idx = 0U; idx < num_clusters; ++idx) {
+        // Includes empty and single point clusters, which are skipped
+        const size_t size = (idx < 2U) ? idx : num_points(gen);
+        const float x0 = 10.0F * coord(gen);
+        const float y0 = 10.0F * coord(gen);
+        std::vector<Pt> points{};
+        for (size_t pdx = 0U; pdx < size; ++pdx) {
+          points.push_back(make_pt(x0 + coord(gen), y0 + (0.5F * coord(gen)), coord(gen)));
+        }
+        points_list.push_back(points);
+      }
+      return make_clusters(points_list);
+    };
+
+  for (const size_t num_workers : {1U, 2U, 4U}) {
+    ParallelBoundingBoxes parallel{num_workers};
+    EXPECT_EQ(parallel.get_num_workers(), num_workers);
+    // Batches of varying size reuse the same instance
+    for (const size_t num_clusters : {40U, 3U, 0U, 100U}) {
+      for (const auto method : {BboxMethod::LFit, BboxMethod::Eigenbox}) {
+        for (const bool compute_height : {false, true}) {
+          const auto clusters = random_clusters(num_clusters);
+          auto serial_clusters = clusters;
+          const auto expected = compute_bounding_boxes(serial_clusters, method, compute_height);
+          auto parallel_clusters = clusters;
+          BoundingBoxArray boxes{};
+          parallel.compute(parallel_clusters, method, compute_height, boxes);
+          ASSERT_EQ(boxes.boxes.size(), expected.boxes.size());
+          EXPECT_EQ(boxes.boxes.size(), (num_clusters < 2U) ? 0U : (num_clusters - 2U));
+          for (size_t idx = 0U; idx < boxes.boxes.size(); ++idx) {
+            EXPECT_EQ(boxes.boxes[idx], expected.boxes[idx]) << idx;
+          }
+        }
+      }
+    }
+  }
+}
+
+// The packed hulls match those computed on a copy of each cluster, serially and in parallel
+TEST_F(BoundingBoxComputationTest, ConvexHulls)
+{
+  std::mt19937 gen{11U};
+  std::uniform_real_distribution<float> coord{-1.0F, 1.0F};
+  std::uniform_int_distribution<size_t> num_points{0U, 200U};
+  std::vector<std::vector<Pt>> points_list{};
+  for (size_t idx = 0U; idx < 60U; ++idx) {
+    std::vector<Pt> points{};
+    const size_t size = num_points(gen);
+    for (size_t pdx = 0U; pdx < size; ++pdx) {
+      points.push_back(make_pt(coord(gen), coord(gen), static_cast<float>(pdx)));
+    }
+    points_list.push_back(points);
+  }
+  // Small clusters are their own hull
+  points_list[3U] = {make_pt(0.0F, 0.0F), make_pt(1.0F, 0.0F), make_pt(0.0F, 1.0F)};
+  points_list[4U] = {};
+  const auto clusters = make_clusters(points_list);
+
+  auto serial_clusters = clusters;
+  Clusters hulls{};
+  compute_convex_hulls(serial_clusters, hulls);
+  ASSERT_EQ(hulls.cluster_boundary.size(), clusters.cluster_boundary.size());
+  for (size_t cls_id = 0U; cls_id < points_list.size(); ++cls_id) {
+    std::list<Pt> list{points_list[cls_id].begin(), points_list[cls_id].end()};
+    const auto list_end = autoware::common::geometry::convex_hull(list);
+    const auto hull = autoware::common::lidar_utils::get_cluster(hulls, cls_id);
+    ASSERT_EQ(
+      std::distance(hull.first, hull.second), std::distance(list.cbegin(), list_end)) << cls_id;
+    auto list_it = list.cbegin();
+    for (auto it = hull.first; it != hull.second; ++it) {
+      EXPECT_FLOAT_EQ(it->x, list_it->x) << cls_id;
+      EXPECT_FLOAT_EQ(it->y, list_it->y) << cls_id;
+      ++list_it;
+    }
+  }
+  EXPECT_EQ(hulls.cluster_boundary[4U], hulls.cluster_boundary[3U]);
+  EXPECT_EQ(hulls.cluster_boundary[3U] - hulls.cluster_boundary[2U], 3U);
+
+  for (const size_t num_workers : {1U, 3U}) {
+    ParallelBoundingBoxes parallel{num_workers};
+    // Reuse of the output, and a batch without clusters
+    Clusters parallel_hulls{};
+    for (const auto & batch : {clusters, Clusters{}, clusters}) {
+      auto parallel_clusters = batch;
+      auto batch_clusters = batch;
+      Clusters expected{};
+      compute_convex_hulls(batch_clusters, expected);
+      parallel.compute_hulls(parallel_clusters, parallel_hulls);
+      EXPECT_EQ(parallel_hulls.cluster_boundary, expected.cluster_boundary);
+      EXPECT_EQ(parallel_hulls.points, expected.points);
+    }
+  }
+}
 
 #endif   // TEST_BOUNDING_BOX_COMPUTATION_HPP_
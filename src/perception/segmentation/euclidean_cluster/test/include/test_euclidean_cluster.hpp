@@ -19,6 +19,8 @@
 
 #include <common/types.hpp>
 
+#include <memory>
+#include <random>
 #include <vector>
 #include <utility>
 
@@ -154,4 +156,103 @@ TEST(EuclideanCluster, NoCluster)
   EXPECT_EQ(res.cluster_boundary.size(), 0U);
   EXPECT_EQ(cls.get_error(), EuclideanCluster::Error::NONE);
 }
+
+/// insert the same random blobs and noise into all clustering objects
+void insert_random_scene(
+  std::mt19937 & gen,
+  const std::vector<EuclideanCluster *> & clss,
+  const uint32_t num_blobs,
+  const uint32_t num_noise_pts)
+{
+  std::uniform_real_distribution<float32_t> center_dist{-60.0F, 60.0F};
+  std::uniform_int_distribution<uint32_t> size_dist{1U, 40U};
+  std::normal_distribution<float32_t> spread_dist{0.0F, 0.8F};
+  for (uint32_t blob = 0U; blob < num_blobs; ++blob) {
+    const float32_t cx = center_dist(gen);
+    const float32_t cy = center_dist(gen);
+    const uint32_t num_pts = size_dist(gen);
+    for (uint32_t idx = 0U; idx < num_pts; ++idx) {
+      const float32_t x = cx + spread_dist(gen);
+      const float32_t y = cy + spread_dist(gen);
+      for (auto cls : clss) {
+        insert_point(*cls, x, y);
+      }
+    }
+  }
+  for (uint32_t idx = 0U; idx < num_noise_pts; ++idx) {
+    const float32_t x = center_dist(gen);
+    const float32_t y = center_dist(gen);
+    for (auto cls : clss) {
+      insert_point(*cls, x, y);
+    }
+  }
+}
+
+/// clusters must be identical, including the order of clusters and points
+void expect_same_clusters(const Clusters & expected, const Clusters & actual)
+{
+  ASSERT_EQ(expected.cluster_boundary, actual.cluster_boundary);
+  ASSERT_EQ(expected.points.size(), actual.points.size());
+  for (std::size_t idx = 0U; idx < expected.points.size(); ++idx) {
+    EXPECT_EQ(expected.points[idx].x, actual.points[idx].x);
+    EXPECT_EQ(expected.points[idx].y, actual.points[idx].y);
+    EXPECT_EQ(expected.points[idx].z, actual.points[idx].z);
+    EXPECT_EQ(expected.points[idx].intensity, actual.points[idx].intensity);
+  }
+}
+
+/// parallel clustering gives the same result as serial clustering
+TEST(EuclideanCluster, ParallelMatchesSerial)
+{
+  // distance dependent threshold, so that connectivity is checked in both directions
+  Config cfg{"foo", 5U, 200U, 0.5F, 1.5F, 60.0F};
+  HashConfig hcfg{-130.0F, 130.0F, -130.0F, 130.0F, 1.0F, 10000U};
+  EuclideanCluster serial{cfg, hcfg};
+  EXPECT_EQ(serial.get_num_threads(), 1U);
+  std::vector<std::unique_ptr<EuclideanCluster>> parallel;
+  std::vector<EuclideanCluster *> clss{&serial};
+  for (const std::size_t num_threads : {2U, 3U, 8U}) {
+    parallel.emplace_back(std::make_unique<EuclideanCluster>(cfg, hcfg, num_threads));
+    EXPECT_EQ(parallel.back()->get_num_threads(), num_threads);
+    clss.push_back(parallel.back().get());
+  }
+  std::mt19937 gen{1234U};
+  // several scans, so that the reuse of internal state is checked as well
+  for (uint32_t scan = 0U; scan < 3U; ++scan) {
+    insert_random_scene(gen, clss, 150U, 1000U);
+    Clusters expected;
+    serial.cluster(expected);
+    ASSERT_GT(expected.cluster_boundary.size(), 10U);
+    for (const auto & cls : parallel) {
+      Clusters actual;
+      cls->cluster(actual);
+      expect_same_clusters(expected, actual);
+      EXPECT_EQ(serial.get_error(), cls->get_error());
+    }
+  }
+}
+
+/// parallel clustering stops at the same cluster as serial clustering
+TEST(EuclideanCluster, ParallelTooManyClusters)
+{
+  Config cfg{"foo", 5U, 4U, 0.5F, 1.5F, 60.0F};
+  HashConfig hcfg{-130.0F, 130.0F, -130.0F, 130.0F, 1.0F, 10000U};
+  EuclideanCluster serial{cfg, hcfg};
+  EuclideanCluster parallel{cfg, hcfg, 4U};
+  std::mt19937 gen{4321U};
+  insert_random_scene(gen, {&serial, &parallel}, 50U, 200U);
+  Clusters expected;
+  Clusters actual;
+  serial.cluster(expected);
+  parallel.cluster(actual);
+  EXPECT_EQ(serial.get_error(), EuclideanCluster::Error::TOO_MANY_CLUSTERS);
+  EXPECT_EQ(parallel.get_error(), EuclideanCluster::Error::TOO_MANY_CLUSTERS);
+  expect_same_clusters(expected, actual);
+
+  // hash is flushed, no point is left for the next scan
+  insert_point(parallel, 0.0F, 0.0F);
+  parallel.cluster(actual);
+  EXPECT_EQ(actual.cluster_boundary.size(), 0U);
+  EXPECT_EQ(parallel.get_error(), EuclideanCluster::Error::NONE);
+}
 #endif  // TEST_EUCLIDEAN_CLUSTER_HPP_
@@ -40,16 +40,18 @@ using autoware::common::lidar_utils::get_cluster;
 using autoware::common::types::bool8_t;
 using autoware::common::types::float32_t;
 
-///
-void insert_point(EuclideanCluster & cls, const float32_t x, const float32_t y)
+/// Insertion helpers work with EuclideanCluster and GridCluster
+template<typename ClusterT>
+void insert_point(ClusterT & cls, const float32_t x, const float32_t y)
 {
   cls.insert(PointXYZIR{PointXYZI{x, y, 0.0F, 0.0F}});
 }
 
 
 ///
+template<typename ClusterT>
 void insert_ring(
-  EuclideanCluster & cls,
+  ClusterT & cls,
   const float32_t r,
   const uint32_t num_pts,
   const float32_t dx = 0.0F,
@@ -65,9 +67,10 @@ void insert_ring(
   }
 }
 ///
+template<typename ClusterT>
 void insert_line(
   std::vector<std::pair<float32_t, float32_t>> & output,
-  EuclideanCluster & cls,
+  ClusterT & cls,
   const float32_t x1, const float32_t y1,
   const float32_t x2, const float32_t y2,
   const float32_t ds)
@@ -85,9 +88,10 @@ void insert_line(
 }
 
 ///
+template<typename ClusterT>
 void insert_mesh(
   std::vector<std::pair<float32_t, float32_t>> & output,
-  EuclideanCluster & cls,
+  ClusterT & cls,
   const float32_t x1, const float32_t y1,
   const float32_t x2, const float32_t y2,
   const float32_t dx, const float32_t dy)
@@ -0,0 +1,280 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#ifndef TEST_GRID_CLUSTER_HPP_
+#define TEST_GRID_CLUSTER_HPP_
+
+#include <common/types.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "euclidean_cluster/grid_cluster.hpp"
+
+#include "test_euclidean_cluster_aux.hpp"
+
+using autoware::perception::segmentation::euclidean_cluster::GridCluster;
+using autoware::perception::segmentation::euclidean_cluster::GridConfig;
+
+TEST(GridCluster, SimpleBar)
+{
+  Config cfg{"foo", 10U, 100U, 1.0F, 1.0F, 10.0F};
+  GridConfig gcfg{-130.0F, 130.0F, -130.0F, 130.0F, 1.0F, 10000U};
+  GridCluster cls{cfg, gcfg};
+  Clusters clusters;
+  std::vector<std::pair<float, float>> output;
+  insert_line(output, cls, -10.0F, -15.0F, -10.0F, 5.0F, 0.9F);
+  cls.cluster(clusters);
+  ASSERT_EQ(clusters.cluster_boundary.size(), 1U);
+  EXPECT_EQ(clusters.cluster_boundary[0U], output.size());
+  EXPECT_EQ(clusters.points.size(), output.size());
+  EXPECT_TRUE(check_cluster(clusters, 0, output));
+  EXPECT_EQ(cls.get_error(), GridCluster::Error::NONE);
+
+  // push another point to check the previous points are gone
+  insert_point(cls, 0.0F, 0.0F);
+  cls.cluster(clusters);
+  EXPECT_EQ(clusters.cluster_boundary.size(), 0U);
+  EXPECT_TRUE(clusters.points.empty());
+  EXPECT_EQ(cls.get_error(), GridCluster::Error::NONE);
+}
+
+// Diagonal neighbors are connected, cells two apart are not
+TEST(GridCluster, Connectivity)
+{
+  Config cfg{"foo", 1U, 100U, 1.0F, 1.0F, 10.0F};
+  GridConfig gcfg{0.0F, 10.0F, 0.0F, 10.0F, 1.0F, 100U};
+  GridCluster cls{cfg, gcfg};
+  Clusters clusters;
+  insert_point(cls, 0.5F, 0.5F);
+  insert_point(cls, 1.5F, 1.5F);
+  insert_point(cls, 2.5F, 0.5F);
+  insert_point(cls, 5.5F, 5.5F);
+  insert_point(cls, 9.5F, 9.5F);
+  insert_point(cls, 7.5F, 5.5F);
+  // Outside of the grid
+  insert_point(cls, 10.5F, 0.5F);
+  insert_point(cls, -0.5F, 0.5F);
+  insert_point(cls, std::numeric_limits<float32_t>::quiet_NaN(), 0.5F);
+  cls.cluster(clusters);
+  ASSERT_EQ(clusters.cluster_boundary.size(), 4U);
+  EXPECT_EQ(clusters.cluster_boundary[0U], 3U);
+  EXPECT_EQ(clusters.cluster_boundary[1U], 4U);
+  EXPECT_EQ(clusters.cluster_boundary[2U], 5U);
+  EXPECT_EQ(clusters.cluster_boundary[3U], 6U);
+  // Clusters are in the order of their first points, and so are their points
+  EXPECT_FLOAT_EQ(clusters.points[2U].x, 2.5F);
+  EXPECT_FLOAT_EQ(clusters.points[3U].x, 5.5F);
+  EXPECT_FLOAT_EQ(clusters.points[4U].x, 9.5F);
+  EXPECT_FLOAT_EQ(clusters.points[5U].x, 7.5F);
+}
+
+// Two components which only join late, after their roots accumulated rank
+TEST(GridCluster, JoinComponents)
+{
+  Config cfg{"foo", 1U, 100U, 1.0F, 1.0F, 10.0F};
+  GridConfig gcfg{0.0F, 20.0F, 0.0F, 20.0F, 1.0F, 100U};
+  GridCluster cls{cfg, gcfg};
+  Clusters clusters;
+  std::vector<std::pair<float, float>> output;
+  insert_line(output, cls, 0.5F, 10.5F, 9.5F, 10.5F, 1.0F);
+  insert_line(output, cls, 19.5F, 0.5F, 19.5F, 10.5F, 1.0F);
+  insert_line(output, cls, 18.5F, 10.5F, 8.5F, 10.5F, 1.0F);
+  cls.cluster(clusters);
+  ASSERT_EQ(clusters.cluster_boundary.size(), 1U);
+  EXPECT_EQ(clusters.cluster_boundary[0U], output.size());
+  EXPECT_TRUE(check_cluster(clusters, 0, output));
+}
+
+// On well separated objects, the result is the same as that of EuclideanCluster
+TEST(GridCluster, MatchesEuclideanCluster)
+{
+  Config cfg{"foo", 5U, 1000U, 1.0F, 1.0F, 10.0F};
+  HashConfig hcfg{-130.0F, 130.0F, -130.0F, 130.0F, 1.0F, 10000U};
+  GridConfig gcfg{-130.0F, 130.0F, -130.0F, 130.0F, 1.0F, 10000U};
+  EuclideanCluster ref_cls{cfg, hcfg};
+  GridCluster cls{cfg, gcfg};
+  std::mt19937 gen{1337U};
+  std::uniform_real_distribution<float32_t> offset{-0.3F, 0.3F};
+  std::uniform_int_distribution<uint32_t> size{1U, 40U};
+  // Blobs at least four cells apart, with points less apart than the threshold of one
+  for (int32_t bx = -10; bx < 10; ++bx) {
+    for (int32_t by = -10; by < 10; ++by) {
+      const uint32_t num_points = size(gen);
+      for (uint32_t idx = 0U; idx < num_points; ++idx) {
+        const float32_t x = (6.0F * static_cast<float32_t>(bx)) + 0.5F + offset(gen);
+        const float32_t y = (6.0F * static_cast<float32_t>(by)) + 0.5F + offset(gen);
+        insert_point(ref_cls, x, y);
+        insert_point(cls, x, y);
+      }
+    }
+  }
+  Clusters ref_clusters;
+  Clusters clusters;
+  ref_cls.cluster(ref_clusters);
+  cls.cluster(clusters);
+  // The order of the clusters differs, compare them as sorted sets of points
+  using PointSet = std::vector<std::pair<float32_t, float32_t>>;
+  const auto to_sets = [](const Clusters & result) {
+      std::vector<PointSet> sets;
+      for (uint32_t cls_id = 0U; cls_id < result.cluster_boundary.size(); ++cls_id) {
+        PointSet set;
+        const auto range = get_cluster(result, cls_id);
+        for (auto it = range.first; it != range.second; ++it) {
+          set.push_back({it->x, it->y});
+        }
+        std::sort(set.begin(), set.end());
+        sets.push_back(set);
+      }
+      std::sort(sets.begin(), sets.end());
+      return sets;
+    };
+  const auto sets = to_sets(clusters);
+  EXPECT_GT(sets.size(), 100U);
+  EXPECT_TRUE(sets == to_sets(ref_clusters));
+}
+
+// Reusing the previous components gives the same clusters as clustering from scratch
+TEST(GridCluster, TemporalMatchesPlain)
+{
+  Config cfg{"foo", 3U, 1000U, 1.0F, 1.0F, 10.0F};
+  GridConfig gcfg{-40.0F, 40.0F, -40.0F, 40.0F, 1.0F, 10000U};
+  GridCluster ref_cls{cfg, gcfg};
+  GridCluster cls{cfg, gcfg};
+  std::mt19937 gen{1337U};
+  std::uniform_real_distribution<float32_t> coord{-45.0F, 45.0F};
+  std::uniform_real_distribution<float32_t> unit{0.0F, 1.0F};
+  // Static points, of which some appear and disappear, e.g. by occlusion, and which form clusters
+  // that may join and split from frame to frame
+  std::vector<std::pair<float32_t, float32_t>> world;
+  for (uint32_t idx = 0U; idx < 3000U; ++idx) {
+    world.push_back({coord(gen), coord(gen)});
+  }
+  float32_t ego_x = 0.0F;
+  float32_t ego_y = 0.0F;
+  float32_t prev_ego_x = 0.0F;
+  float32_t prev_ego_y = 0.0F;
+  std::size_t num_reused_cells = 0U;
+  for (uint32_t frame = 0U; frame < 20U; ++frame) {
+    // Standstill, then slow motion which is not a whole number of cells
+    if (frame >= 5U) {
+      ego_x += 0.7F;
+      ego_y -= 0.2F;
+    }
+    for (const auto & pt : world) {
+      if (unit(gen) < 0.02F) {
+        continue;
+      }
+      insert_point(ref_cls, pt.first - ego_x, pt.second - ego_y);
+      insert_point(cls, pt.first - ego_x, pt.second - ego_y);
+    }
+    Clusters ref_clusters;
+    Clusters clusters;
+    ref_cls.cluster(ref_clusters);
+    cls.cluster(clusters, prev_ego_x - ego_x, prev_ego_y - ego_y);
+    prev_ego_x = ego_x;
+    prev_ego_y = ego_y;
+    ASSERT_GT(ref_clusters.cluster_boundary.size(), 10U);
+    ASSERT_EQ(clusters.cluster_boundary, ref_clusters.cluster_boundary);
+    ASSERT_EQ(clusters.points.size(), ref_clusters.points.size());
+    for (std::size_t idx = 0U; idx < clusters.points.size(); ++idx) {
+      ASSERT_FLOAT_EQ(clusters.points[idx].x, ref_clusters.points[idx].x);
+      ASSERT_FLOAT_EQ(clusters.points[idx].y, ref_clusters.points[idx].y);
+    }
+    if (0U == frame) {
+      EXPECT_EQ(cls.get_num_reused_cells(), 0U);
+    }
+    num_reused_cells += cls.get_num_reused_cells();
+  }
+  EXPECT_GT(num_reused_cells, 0U);
+
+  // The same points again reuse every cell
+  const auto insert_blobs = [&cls]() {
+      for (uint32_t idx = 0U; idx < 10U; ++idx) {
+        const float32_t x = (3.0F * static_cast<float32_t>(idx)) + 0.5F;
+        insert_point(cls, x, 0.5F);
+        insert_point(cls, x, 1.5F);
+        insert_point(cls, x, 2.5F);
+      }
+    };
+  Clusters clusters;
+  insert_blobs();
+  cls.cluster(clusters, 0.0F, 0.0F);
+  insert_blobs();
+  cls.cluster(clusters, 0.0F, 0.0F);
+  EXPECT_EQ(cls.get_num_reused_cells(), 30U);
+  EXPECT_EQ(clusters.cluster_boundary.size(), 10U);
+  // Not after a plain call, nor with an invalid displacement
+  insert_blobs();
+  cls.cluster(clusters);
+  insert_blobs();
+  cls.cluster(clusters, 0.0F, 0.0F);
+  EXPECT_EQ(cls.get_num_reused_cells(), 0U);
+  insert_blobs();
+  cls.cluster(clusters, std::numeric_limits<float32_t>::quiet_NaN(), 0.0F);
+  EXPECT_EQ(cls.get_num_reused_cells(), 0U);
+  EXPECT_EQ(clusters.cluster_boundary.size(), 10U);
+}
+
+TEST(GridCluster, Limits)
+{
+  Config cfg{"foo", 2U, 3U, 1.0F, 1.0F, 10.0F};
+  GridConfig gcfg{0.0F, 10.0F, 0.0F, 10.0F, 1.0F, 9U};
+  GridCluster cls{cfg, gcfg};
+  Clusters clusters;
+  // Too small
+  insert_point(cls, 0.5F, 0.5F);
+  // Four clusters of two points
+  for (uint32_t idx = 0U; idx < 4U; ++idx) {
+    const float32_t x = (2.0F * static_cast<float32_t>(idx + 1U)) + 0.5F;
+    insert_point(cls, x, 5.5F);
+    insert_point(cls, x, 5.6F);
+  }
+  EXPECT_THROW(insert_point(cls, 0.5F, 0.5F), std::length_error);
+  cls.cluster(clusters);
+  ASSERT_EQ(clusters.cluster_boundary.size(), 3U);
+  EXPECT_EQ(clusters.cluster_boundary.back(), 6U);
+  EXPECT_EQ(clusters.points.size(), 6U);
+  EXPECT_EQ(cls.get_error(), GridCluster::Error::TOO_MANY_CLUSTERS);
+  EXPECT_THROW(cls.throw_stored_error(), std::runtime_error);
+  // The points are consumed and the error is reset on the next call
+  const std::vector<PointXYZI> points(9U, PointXYZI{0.5F, 0.5F, 0.0F, 0.0F});
+  cls.insert(points.begin(), points.end());
+  EXPECT_THROW(cls.insert(points.begin(), points.begin() + 1), std::length_error);
+  cls.cluster(clusters);
+  ASSERT_EQ(clusters.cluster_boundary.size(), 1U);
+  EXPECT_EQ(clusters.cluster_boundary[0U], 9U);
+  EXPECT_EQ(cls.get_error(), GridCluster::Error::NONE);
+  EXPECT_NO_THROW(cls.throw_stored_error());
+}
+
+TEST(GridCluster, BadConfig)
+{
+  EXPECT_THROW(GridConfig(0.0F, 10.0F, 0.0F, 10.0F, 0.0F, 10U), std::domain_error);
+  EXPECT_THROW(GridConfig(0.0F, 10.0F, 0.0F, 10.0F, -1.0F, 10U), std::domain_error);
+  EXPECT_THROW(GridConfig(10.0F, 0.0F, 0.0F, 10.0F, 1.0F, 10U), std::domain_error);
+  EXPECT_THROW(GridConfig(0.0F, 10.0F, 0.0F, 0.0F, 1.0F, 10U), std::domain_error);
+  EXPECT_THROW(GridConfig(-1.0E5F, 1.0E5F, -1.0E5F, 1.0E5F, 0.1F, 10U), std::domain_error);
+  const GridConfig cfg{-1.0F, 1.5F, 0.0F, 1.0F, 1.0F, 10U};
+  EXPECT_EQ(cfg.width(), 3U);
+  EXPECT_EQ(cfg.height(), 1U);
+}
+
+#endif  // TEST_GRID_CLUSTER_HPP_
@@ -24,10 +24,18 @@
 #include <euclidean_cluster_nodes/visibility_control.hpp>
 #include <autoware_auto_msgs/msg/bounding_box_array.hpp>
 #include <autoware_auto_msgs/msg/detected_objects.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <euclidean_cluster/euclidean_cluster.hpp>
+#include <euclidean_cluster/grid_cluster.hpp>
+#include <euclidean_cluster/parallel_bounding_boxes.hpp>
+#include <time_utils/latency_histogram.hpp>
+#include <time_utils/trace.hpp>
 #include <visualization_msgs/msg/marker_array.hpp>
 #include <voxel_grid_nodes/algorithm/voxel_cloud_approximate.hpp>
 #include <common/types.hpp>
+#include <tf2/buffer_core.h>
+#include <tf2_ros/transform_listener.h>
+#include <array>
 #include <memory>
 #include <string>
 
@@ -47,6 +55,7 @@ using visualization_msgs::msg::MarkerArray;
 using BoundingBox = autoware_auto_msgs::msg::BoundingBox;
 using BoundingBoxArray = autoware_auto_msgs::msg::BoundingBoxArray;
 using DetectedObjects = autoware_auto_msgs::msg::DetectedObjects;
+using DiagnosticArray = diagnostic_msgs::msg::DiagnosticArray;
 /// \brief Combined object detection node, primarily does clustering, can also do in-place
 ///        downsampling and bounding box formation
 class EUCLIDEAN_CLUSTER_NODES_PUBLIC EuclideanClusterNode : public rclcpp::Node
@@ -59,8 +68,28 @@ public:
   /// \param node_options Additional options to control creation of the node.
   explicit EuclideanClusterNode(
     const rclcpp::NodeOptions & node_options);
+  /// \brief Destructor, logs a summary of the stage latencies if they are measured
+  ~EuclideanClusterNode() override;
 
 private:
+  /// \brief Stages of the main callback whose latencies are measured
+  enum class Stage : std::size_t
+  {
+    DOWNSAMPLE,
+    INSERT,
+    CLUSTER,
+    BBOX,
+    PUBLISH,
+    TOTAL,
+    NUM_STAGES
+  };
+  using Latencies = std::array<common::time_utils::LatencyHistogram,
+      static_cast<std::size_t>(Stage::NUM_STAGES)>;
+
+  /// \brief Get the histogram of a stage, or null if latencies are not measured
+  common::time_utils::LatencyHistogram * EUCLIDEAN_CLUSTER_NODES_LOCAL latency(const Stage stage);
+  /// \brief Summarize the stage latencies in a diagnostic message
+  DiagnosticArray EUCLIDEAN_CLUSTER_NODES_LOCAL make_latency_diagnostics() const;
   /// \brief Main callback function
   void EUCLIDEAN_CLUSTER_NODES_LOCAL handle(const PointCloud2::SharedPtr msg_ptr);
   /// \brief Insert directly into clustering algorithm
@@ -69,6 +98,8 @@ private:
   void EUCLIDEAN_CLUSTER_NODES_LOCAL insert_voxel(const PointCloud2 & cloud);
   /// \brief Dispatch to appropriate insertion method
   void EUCLIDEAN_CLUSTER_NODES_LOCAL insert(const PointCloud2 & cloud);
+  /// \brief Cluster with the grid, reusing the clusters of the previous cloud if it is enabled
+  void EUCLIDEAN_CLUSTER_NODES_LOCAL cluster_grid(const std_msgs::msg::Header & header);
   /// \brief Updates cluster meta-information, and publishes
   void EUCLIDEAN_CLUSTER_NODES_LOCAL publish_clusters(
     Clusters & clusters,
@@ -84,12 +115,28 @@ private:
   const rclcpp::Publisher<BoundingBoxArray>::SharedPtr m_box_pub_ptr;
   const rclcpp::Publisher<DetectedObjects>::SharedPtr m_detected_objects_pub_ptr;
   const rclcpp::Publisher<MarkerArray>::SharedPtr m_marker_pub_ptr;
+  rclcpp::Publisher<DiagnosticArray>::SharedPtr m_diagnostics_pub_ptr;
   // algorithms
   euclidean_cluster::EuclideanCluster m_cluster_alg;
+  // Replaces m_cluster_alg if set
+  std::unique_ptr<euclidean_cluster::GridCluster> m_grid_cluster_ptr;
+  // Ego motion between clouds for the temporal reuse of grid clusters, only set if it is enabled
+  std::unique_ptr<tf2::BufferCore> m_tf_buffer_ptr;
+  std::unique_ptr<tf2_ros::TransformListener> m_tf_listener_ptr;
+  std::string m_temporal_fixed_frame;
+  std_msgs::msg::Header m_previous_header;
+  bool8_t m_has_previous_header;
   Clusters m_clusters;
+  euclidean_cluster::details::ParallelBoundingBoxes m_box_computer;
   std::unique_ptr<VoxelAlgorithm> m_voxel_ptr;
   const bool8_t m_use_lfit;
   const bool8_t m_use_z;
+  // Stage latencies, only measured if set
+  std::unique_ptr<Latencies> m_latencies_ptr;
+  std::size_t m_diagnostics_period;
+  std::size_t m_num_frames;
+  // Records when each cloud enters and leaves the callback, if tracing is switched on
+  const common::time_utils::TracePoint m_trace;
 };  // class EuclideanClusterNode
 }  // namespace euclidean_cluster_nodes
 }  // namespace segmentation
@@ -25,7 +25,12 @@
 #include <lidar_utils/point_cloud_utils.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <time_utils/probe_diagnostics.hpp>
+#include <time_utils/time_utils.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -44,6 +49,18 @@ namespace segmentation
 {
 namespace euclidean_cluster_nodes
 {
+namespace
+{
+// In the order of EuclideanClusterNode::Stage
+constexpr const char * STAGE_NAMES[] = {"downsample", "insert", "cluster", "bbox", "publish",
+  "total"};
+
+int64_t to_us(const std::chrono::nanoseconds duration)
+{
+  return static_cast<int64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+}  // namespace
 ////////////////////////////////////////////////////////////////////////////////
 EuclideanClusterNode::EuclideanClusterNode(
   const rclcpp::NodeOptions & node_options)
@@ -68,6 +85,7 @@ m_marker_pub_ptr{get_parameter("use_box").as_bool() ?
   create_publisher<MarkerArray>(
     "lidar_bounding_boxes_viz", rclcpp::QoS{10}) :
   nullptr},
+m_diagnostics_pub_ptr{nullptr},
 m_cluster_alg{
   euclidean_cluster::Config{
     declare_parameter("cluster.frame_id").get<std::string>().c_str(),
@@ -85,17 +103,57 @@ m_cluster_alg{
     static_cast<float32_t>(declare_parameter("hash.max_y").get<float32_t>()),
     static_cast<float32_t>(declare_parameter("hash.side_length").get<float32_t>()),
     static_cast<std::size_t>(declare_parameter("max_cloud_size").get<std::size_t>())
-  }
+  },
+  static_cast<std::size_t>(std::max(declare_parameter("num_threads", 1), 1))
 },
+m_grid_cluster_ptr{nullptr},
+m_tf_buffer_ptr{nullptr},
+m_tf_listener_ptr{nullptr},
+m_has_previous_header{false},
 m_clusters{},
+// Bounding boxes are computed with as many threads as the clustering, if they are used at all
+m_box_computer{(m_box_pub_ptr || m_detected_objects_pub_ptr) ?
+  m_cluster_alg.get_num_threads() : 1U},
 m_voxel_ptr{nullptr},  // Because voxel config's Point types don't accept positional arguments
 m_use_lfit{declare_parameter("use_lfit").get<bool8_t>()},
-m_use_z{declare_parameter("use_z").get<bool8_t>()}
+m_use_z{declare_parameter("use_z").get<bool8_t>()},
+m_latencies_ptr{nullptr},
+m_diagnostics_period{1U},
+m_num_frames{0U},
+m_trace{get_fully_qualified_name()}
 {
   // Sanity check
   if ((!m_detected_objects_pub_ptr) && (!m_box_pub_ptr) && (!m_cluster_pub_ptr)) {
     throw std::domain_error{"EuclideanClusterNode: No publisher topics provided"};
   }
+  // Initialize grid clustering, which uses the same bounds as the spatial hash
+  if (declare_parameter("use_grid", false)) {
+    m_grid_cluster_ptr = std::make_unique<euclidean_cluster::GridCluster>(
+      m_cluster_alg.get_config(),
+      euclidean_cluster::GridConfig{
+        static_cast<float32_t>(get_parameter("hash.min_x").as_double()),
+        static_cast<float32_t>(get_parameter("hash.max_x").as_double()),
+        static_cast<float32_t>(get_parameter("hash.min_y").as_double()),
+        static_cast<float32_t>(get_parameter("hash.max_y").as_double()),
+        static_cast<float32_t>(declare_parameter("grid.cell_size_m", 0.5)),
+        static_cast<std::size_t>(get_parameter("max_cloud_size").as_int())
+      });
+    RCLCPP_INFO(get_logger(), "Grid clustering is used, cluster thresholds are ignored");
+    // Reuse of the clusters of the previous cloud, shifted by the ego motion
+    if (declare_parameter("grid.temporal.enable", false)) {
+      m_temporal_fixed_frame = declare_parameter("grid.temporal.fixed_frame", std::string{"odom"});
+      m_tf_buffer_ptr = std::make_unique<tf2::BufferCore>();
+      m_tf_listener_ptr = std::make_unique<tf2_ros::TransformListener>(
+        *m_tf_buffer_ptr, std::shared_ptr<rclcpp::Node>(this, [](auto) {}), false);
+    }
+  }
+  // Initialize latency measurement, the hot path only reads the clock if it is enabled
+  if (declare_parameter("diagnostics.enable", false)) {
+    m_latencies_ptr = std::make_unique<Latencies>();
+    m_diagnostics_period =
+      static_cast<std::size_t>(std::max(declare_parameter("diagnostics.period_frames", 100), 1));
+    m_diagnostics_pub_ptr = create_publisher<DiagnosticArray>("diagnostics", rclcpp::QoS{10});
+  }
   // Initialize voxel grid
   if (declare_parameter("downsample").get<bool8_t>()) {
     filters::voxel_grid::PointXYZ min_point;
@@ -125,11 +183,50 @@ m_use_z{declare_parameter("use_z").get<bool8_t>()}
             });
   }
 }
-
+////////////////////////////////////////////////////////////////////////////////
+EuclideanClusterNode::~EuclideanClusterNode()
+{
+  if (!m_latencies_ptr) {
+    return;
+  }
+  for (std::size_t idx = 0U; idx < m_latencies_ptr->size(); ++idx) {
+    const auto & histogram = (*m_latencies_ptr)[idx];
+    if (0U != histogram.count()) {
+      RCLCPP_INFO_STREAM(
+        get_logger(), "Latency of " << STAGE_NAMES[idx] << " over " << histogram.count() <<
+          " frames: mean " << to_us(histogram.mean()) << " us, p50 <= " <<
+          to_us(histogram.quantile_upper_bound(0.5)) << " us, p99 <= " <<
+          to_us(histogram.quantile_upper_bound(0.99)) << " us, max " <<
+          to_us(histogram.max()) << " us");
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+common::time_utils::LatencyHistogram * EuclideanClusterNode::latency(const Stage stage)
+{
+  static_assert(
+    (sizeof(STAGE_NAMES) / sizeof(STAGE_NAMES[0])) == static_cast<std::size_t>(Stage::NUM_STAGES),
+    "Missing name of a stage");
+  return m_latencies_ptr ? &(*m_latencies_ptr)[static_cast<std::size_t>(stage)] : nullptr;
+}
+////////////////////////////////////////////////////////////////////////////////
+DiagnosticArray EuclideanClusterNode::make_latency_diagnostics() const
+{
+  auto status = common::time_utils::make_latency_status(
+    std::string{get_name()} + ": stage latencies", "euclidean_cluster_nodes");
+  for (std::size_t idx = 0U; idx < m_latencies_ptr->size(); ++idx) {
+    common::time_utils::add_latency_values(STAGE_NAMES[idx], (*m_latencies_ptr)[idx], status);
+  }
+  DiagnosticArray diagnostics;
+  diagnostics.header.stamp = now();
+  diagnostics.status.push_back(status);
+  return diagnostics;
+}
 ////////////////////////////////////////////////////////////////////////////////
 void EuclideanClusterNode::insert_plain(const PointCloud2 & cloud)
 {
   using euclidean_cluster::PointXYZI;
+  common::time_utils::ScopedLatency insert_latency{latency(Stage::INSERT)};
   const auto indices = common::lidar_utils::sanitize_point_cloud(cloud);
   if (indices.point_step != cloud.point_step) {
     std::cout << "Using only a subset of Point cloud fields" << std::endl;
@@ -144,14 +241,23 @@ void EuclideanClusterNode::insert_plain(const PointCloud2 & cloud)
     void * const dest = &pt;
     const void * const src = &cloud.data[idx];
     (void)std::memcpy(dest, src, indices.point_step);
-    m_cluster_alg.insert(euclidean_cluster::PointXYZIR{pt});
+    if (m_grid_cluster_ptr) {
+      m_grid_cluster_ptr->insert(euclidean_cluster::PointXYZIR{pt});
+    } else {
+      m_cluster_alg.insert(euclidean_cluster::PointXYZIR{pt});
+    }
   }
 }
 ////////////////////////////////////////////////////////////////////////////////
 void EuclideanClusterNode::insert_voxel(const PointCloud2 & cloud)
 {
-  m_voxel_ptr->insert(cloud);
-  insert_plain(m_voxel_ptr->get());
+  const PointCloud2 * downsampled = nullptr;
+  {
+    common::time_utils::ScopedLatency downsample_latency{latency(Stage::DOWNSAMPLE)};
+    m_voxel_ptr->insert(cloud);
+    downsampled = &m_voxel_ptr->get();
+  }
+  insert_plain(*downsampled);
 }
 ////////////////////////////////////////////////////////////////////////////////
 void EuclideanClusterNode::insert(const PointCloud2 & cloud)
@@ -163,6 +269,35 @@ void EuclideanClusterNode::insert(const PointCloud2 & cloud)
   }
 }
 ////////////////////////////////////////////////////////////////////////////////
+void EuclideanClusterNode::cluster_grid(const std_msgs::msg::Header & header)
+{
+  if (!m_tf_buffer_ptr) {
+    m_grid_cluster_ptr->cluster(m_clusters);
+    return;
+  }
+  try {
+    // How static points moved from the previous cloud to this one; the rotation is ignored since
+    // it only decides how many cells are reused, not the clusters
+    float32_t displacement_x = 0.0F;
+    float32_t displacement_y = 0.0F;
+    if (m_has_previous_header) {
+      const auto translation = m_tf_buffer_ptr->lookupTransform(
+        header.frame_id, time_utils::from_message(header.stamp),
+        m_previous_header.frame_id, time_utils::from_message(m_previous_header.stamp),
+        m_temporal_fixed_frame).transform.translation;
+      displacement_x = static_cast<float32_t>(translation.x);
+      displacement_y = static_cast<float32_t>(translation.y);
+    }
+    m_grid_cluster_ptr->cluster(m_clusters, displacement_x, displacement_y);
+  } catch (const tf2::TransformException & e) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 1000, "Not reusing the previous clusters: %s", e.what());
+    m_grid_cluster_ptr->cluster(m_clusters);
+  }
+  m_previous_header = header;
+  m_has_previous_header = true;
+}
+////////////////////////////////////////////////////////////////////////////////
 void EuclideanClusterNode::publish_clusters(
   Clusters & clusters,
   const std_msgs::msg::Header & header)
@@ -176,6 +311,7 @@ void EuclideanClusterNode::handle_clusters(
   const std_msgs::msg::Header & header)
 {
   if (m_cluster_pub_ptr) {
+    common::time_utils::ScopedLatency publish_latency{latency(Stage::PUBLISH)};
     publish_clusters(clusters, header);
   }
 
@@ -184,15 +320,15 @@ void EuclideanClusterNode::handle_clusters(
   }
 
   BoundingBoxArray boxes;
-  if (m_use_lfit) {
-    boxes = euclidean_cluster::details::compute_bounding_boxes(clusters, BboxMethod::LFit, m_use_z);
-  } else {
-    boxes = euclidean_cluster::details::compute_bounding_boxes(
-      clusters, BboxMethod::Eigenbox,
-      m_use_z);
+  {
+    common::time_utils::ScopedLatency bbox_latency{latency(Stage::BBOX)};
+    m_box_computer.compute(
+      clusters, m_use_lfit ? BboxMethod::LFit : BboxMethod::Eigenbox, m_use_z, boxes);
+    boxes.header.stamp = header.stamp;
+    boxes.header.frame_id = header.frame_id;
   }
-  boxes.header.stamp = header.stamp;
-  boxes.header.frame_id = header.frame_id;
+  // Publishing includes the conversion to the other message types
+  common::time_utils::ScopedLatency publish_latency{latency(Stage::PUBLISH)};
   m_box_pub_ptr->publish(boxes);
 
   if (m_detected_objects_pub_ptr) {
@@ -237,23 +373,42 @@ void EuclideanClusterNode::handle_clusters(
 ////////////////////////////////////////////////////////////////////////////////
 void EuclideanClusterNode::handle(const PointCloud2::SharedPtr msg_ptr)
 {
+  const common::time_utils::ScopedTrace trace{m_trace, msg_ptr->header.stamp};
   try {
+    common::time_utils::ScopedLatency total_latency{latency(Stage::TOTAL)};
     try {
       insert(*msg_ptr);
     } catch (const std::length_error & e) {
       // Hit limits of inserting, can still cluster, but in bad state
       RCLCPP_WARN(get_logger(), e.what());
     }
-    m_cluster_alg.cluster(m_clusters);
+    {
+      common::time_utils::ScopedLatency cluster_latency{latency(Stage::CLUSTER)};
+      if (m_grid_cluster_ptr) {
+        cluster_grid(msg_ptr->header);
+      } else {
+        m_cluster_alg.cluster(m_clusters);
+      }
+    }
     //lint -e{523} NOLINT empty functions to make this modular
     handle_clusters(m_clusters, msg_ptr->header);
-    m_cluster_alg.throw_stored_error();
+    if (m_grid_cluster_ptr) {
+      m_grid_cluster_ptr->throw_stored_error();
+    } else {
+      m_cluster_alg.throw_stored_error();
+    }
   } catch (const std::exception & e) {
     RCLCPP_ERROR(get_logger(), e.what());
   } catch (...) {
     RCLCPP_FATAL(get_logger(), "EuclideanClusterNode: Unexpected error occurred!");
     throw;
   }
+  if (m_diagnostics_pub_ptr) {
+    ++m_num_frames;
+    if (0U == (m_num_frames % m_diagnostics_period)) {
+      m_diagnostics_pub_ptr->publish(make_latency_diagnostics());
+    }
+  }
 }
 }  // namespace euclidean_cluster_nodes
 }  // namespace segmentation
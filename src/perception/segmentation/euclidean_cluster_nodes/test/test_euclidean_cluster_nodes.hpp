@@ -243,4 +243,41 @@ TEST_F(EuclideanClusterNodesTest, InstantiateDownsample)
   ASSERT_NO_THROW(EuclideanClusterNode{node_options});
 }
 
+TEST_F(EuclideanClusterNodesTest, InstantiateDiagnostics)
+{
+  rclcpp::NodeOptions node_options;
+
+  std::vector<rclcpp::Parameter> params{
+    {"use_detected_objects", false},
+    {"use_cluster", true},
+    {"use_box", true},
+    {"max_cloud_size", 55000},
+    {"downsample", false},
+    {"use_lfit", true},
+    {"use_z", true},
+    {"cluster.frame_id", "base_link"},
+    {"cluster.min_cluster_size", 10},
+    {"cluster.max_num_clusters", 256},
+    {"cluster.min_cluster_threshold_m", 0.5},
+    {"cluster.max_cluster_threshold_m", 1.5},
+    {"cluster.threshold_saturation_distance_m", 60.0},
+    {"hash.min_x", -130.0},
+    {"hash.max_x", 130.0},
+    {"hash.min_y", -130.0},
+    {"hash.max_y", 130.0},
+    {"hash.side_length", 1.0},
+    {"diagnostics.enable", true}};
+
+  node_options.parameter_overrides(params);
+  ASSERT_NO_THROW(EuclideanClusterNode{node_options});
+
+  params.emplace_back("diagnostics.period_frames", 0.5);
+  node_options.parameter_overrides(params);
+  ASSERT_THROW(EuclideanClusterNode{node_options}, rclcpp::ParameterTypeException);
+
+  params.back() = rclcpp::Parameter{"diagnostics.period_frames", 10};
+  node_options.parameter_overrides(params);
+  ASSERT_NO_THROW(EuclideanClusterNode{node_options});
+}
+
 #endif  // TEST_EUCLIDEAN_CLUSTER_NODES_HPP_
@@ -24,11 +24,16 @@
 #include <ground_truth_detections/visibility_control.hpp>
 
 #include <autoware_auto_msgs/msg/classified_roi_array.hpp>
+#include <autoware_auto_msgs/msg/detected_object.hpp>
 #include <autoware_auto_msgs/msg/detected_object_kinematics.hpp>
+#include <autoware_auto_msgs/msg/detected_objects.hpp>
 #include <autoware_auto_msgs/msg/shape.hpp>
 #include <geometry_msgs/msg/polygon.hpp>
 #include <lgsvl_msgs/msg/detection2_d_array.hpp>
 #include <lgsvl_msgs/msg/detection3_d_array.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
 #include <string>
 
 namespace autoware
@@ -82,6 +87,64 @@ autoware_auto_msgs::msg::DetectedObjectKinematics GROUND_TRUTH_DETECTIONS_PUBLIC
 autoware_auto_msgs::msg::Shape GROUND_TRUTH_DETECTIONS_PUBLIC make_shape(
   const lgsvl_msgs::msg::Detection3D & detection);
 
+/**
+ * @brief Fill a region of interest from a 2D detection from SVL in place, reusing the storage of
+ * its classifications and polygon.
+ *
+ * @param detection The 2D input detection
+ * @param roi The output region of interest, as if built from `make_classification()` and
+ * `make_polygon()`
+ */
+void GROUND_TRUTH_DETECTIONS_PUBLIC fill_roi(
+  const lgsvl_msgs::msg::Detection2D & detection,
+  autoware_auto_msgs::msg::ClassifiedRoi & roi);
+
+/**
+ * @brief Fill a detected object from a 3D detection from SVL in place, reusing the storage of its
+ * classification and shape.
+ *
+ * @param detection The 3D input detection
+ * @param object The output object, as if built from `make_classification()`, `make_kinematics()`
+ * and `make_shape()`
+ */
+void GROUND_TRUTH_DETECTIONS_PUBLIC fill_detected_object(
+  const lgsvl_msgs::msg::Detection3D & detection,
+  autoware_auto_msgs::msg::DetectedObject & object);
+
+/**
+ * @brief Convert all 2D detections from SVL at once.
+ *
+ * The regions of interest of a previous conversion are overwritten in place, so converting into
+ * the same message again only allocates if there are more detections than ever before. The header
+ * is left to the caller.
+ *
+ * @param detections The 2D input detections
+ * @param rois The output regions of interest, one per detection
+ */
+void GROUND_TRUTH_DETECTIONS_PUBLIC convert_detections(
+  const lgsvl_msgs::msg::Detection2DArray & detections,
+  autoware_auto_msgs::msg::ClassifiedRoiArray & rois);
+
+/**
+ * @brief Convert the 3D detections from SVL within a range around the ego vehicle at once.
+ *
+ * The range is the horizontal distance of the centroid of a detection from the origin of the
+ * frame of the detections, i.e. from the ego vehicle. Detections out of range are dropped before
+ * any conversion, so the cost scales with the visible objects rather than with all objects in the
+ * simulated world. The objects of a previous conversion are overwritten in place, so converting
+ * into the same message again only allocates if there are more visible objects than ever before.
+ * The header is left to the caller.
+ *
+ * @param detections The 3D input detections
+ * @param max_range The maximum range of the kept detections, infinite to keep all
+ * @param objects The output objects, one per kept detection in the order of the input
+ * @return the number of kept detections
+ */
+std::size_t GROUND_TRUTH_DETECTIONS_PUBLIC convert_detections(
+  const lgsvl_msgs::msg::Detection3DArray & detections,
+  const double_t max_range,
+  autoware_auto_msgs::msg::DetectedObjects & objects);
+
 }  // namespace ground_truth_detections
 }  // namespace autoware
 
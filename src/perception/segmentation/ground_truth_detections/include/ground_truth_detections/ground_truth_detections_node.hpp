@@ -42,6 +42,7 @@ class GROUND_TRUTH_DETECTIONS_PUBLIC GroundTruthDetectionsNode : public rclcpp::
 public:
   /// \brief default constructor, starts driver
   /// \throw runtime error if failed to start threads or configure driver
+  /// \throw std::domain_error if the parameter `max_range_m` is negative
   explicit GroundTruthDetectionsNode(const rclcpp::NodeOptions & options);
 
 private:
@@ -56,9 +57,14 @@ private:
   rclcpp::Publisher<autoware_auto_msgs::msg::ClassifiedRoiArray>::SharedPtr m_detection2d_pub{};
   rclcpp::Subscription<lgsvl_msgs::msg::Detection2DArray>::SharedPtr m_detection2d_sub{};
   std::string m_vision_frame_id;
+  // Reused for every message, so that the output only allocates when it grows
+  autoware_auto_msgs::msg::ClassifiedRoiArray m_roi_array{};
 
   rclcpp::Publisher<autoware_auto_msgs::msg::DetectedObjects>::SharedPtr m_detection3d_pub{};
   rclcpp::Subscription<lgsvl_msgs::msg::Detection3DArray>::SharedPtr m_detection3d_sub{};
+  // Range around the ego vehicle of the published 3D detections, infinite to publish all
+  double_t m_max_range;
+  autoware_auto_msgs::msg::DetectedObjects m_detected_objects{};
   static constexpr char kFrameId3d[] = "base_link";
 };
 }  // namespace ground_truth_detections
@@ -20,6 +20,8 @@
 #include <geometry_msgs/msg/vector3.hpp>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <limits>
 #include <string>
 
 namespace
@@ -37,11 +39,11 @@ geometry_msgs::msg::Point32 convert(const geometry_msgs::msg::Vector3 & p_in)
   return p_out;
 }
 
-geometry_msgs::msg::Polygon make_polygon_around_origin(
-  const lgsvl_msgs::msg::Detection3D & detection)
+void fill_polygon_around_origin(
+  const lgsvl_msgs::msg::Detection3D & detection,
+  geometry_msgs::msg::Polygon & polygon)
 {
   // Polygon is 2D rectangle
-  geometry_msgs::msg::Polygon polygon;
   auto & points = polygon.points;
   points.resize(4);
 
@@ -59,8 +61,63 @@ geometry_msgs::msg::Polygon make_polygon_around_origin(
 
   points[3] = points[2];
   points[3].y -= size.y;
+}
 
-  return polygon;
+void fill_polygon(
+  const lgsvl_msgs::msg::Detection2D & detection,
+  geometry_msgs::msg::Polygon & polygon)
+{
+  auto & points = polygon.points;
+  // implicitly assign 0 to z coordinate
+  points.resize(4);
+  const float_t width = detection.bbox.width;
+  const float_t height = detection.bbox.height;
+
+  // clip coordinates to avoid negative values due to rounding.
+  // Can't clip upper bound because image size not known.
+
+  // bbox coordinates (x, y) given at center
+
+  // lower left corner
+  points[0].x = std::max(detection.bbox.x - 0.5F * width, 0.0F);
+  points[0].y = std::max(detection.bbox.y - 0.5F * height, 0.0F);
+  points[0].z = 0.0F;
+
+  // lower right corner
+  points[1] = points[0];
+  points[1].x += width;
+
+  // upper right corner
+  points[2] = points[1];
+  points[2].y += height;
+
+  // upper left corner
+  points[3] = points[2];
+  points[3].x = std::max(points[3].x - width, 0.0F);
+}
+
+void fill_kinematics(
+  const lgsvl_msgs::msg::Detection3D & detection,
+  autoware_auto_msgs::msg::DetectedObjectKinematics & kinematics)
+{
+  kinematics.centroid_position = detection.bbox.position.position;
+  kinematics.position_covariance.fill(0.0);
+  kinematics.has_position_covariance = false;
+  kinematics.orientation = detection.bbox.position.orientation;
+  kinematics.orientation_availability =
+    autoware_auto_msgs::msg::DetectedObjectKinematics::AVAILABLE;
+  kinematics.twist.twist = detection.velocity;
+  kinematics.twist.covariance.fill(0.0);
+  kinematics.has_twist = true;
+  kinematics.has_twist_covariance = false;
+}
+
+void fill_shape(
+  const lgsvl_msgs::msg::Detection3D & detection,
+  autoware_auto_msgs::msg::Shape & shape)
+{
+  fill_polygon_around_origin(detection, shape.polygon);
+  shape.height = static_cast<float_t>(detection.bbox.size.z);
 }
 
 }  // namespace
@@ -95,58 +152,80 @@ autoware_auto_msgs::msg::ObjectClassification make_classification(const std::str
 geometry_msgs::msg::Polygon make_polygon(const lgsvl_msgs::msg::Detection2D & detection)
 {
   geometry_msgs::msg::Polygon polygon;
-  auto & points = polygon.points;
-  // implicitly assign 0 to z coordinate
-  points.resize(4);
-  const float_t width = detection.bbox.width;
-  const float_t height = detection.bbox.height;
-
-  // clip coordinates to avoid negative values due to rounding.
-  // Can't clip upper bound because image size not known.
-
-  // bbox coordinates (x, y) given at center
-
-  // lower left corner
-  points[0].x = std::max(detection.bbox.x - 0.5F * width, 0.0F);
-  points[0].y = std::max(detection.bbox.y - 0.5F * height, 0.0F);
-
-  // lower right corner
-  points[1] = points[0];
-  points[1].x += width;
-
-  // upper right corner
-  points[2] = points[1];
-  points[2].y += height;
-
-  // upper left corner
-  points[3] = points[2];
-  points[3].x = std::max(points[3].x - width, 0.0F);
-
+  fill_polygon(detection, polygon);
   return polygon;
 }
 
 autoware_auto_msgs::msg::DetectedObjectKinematics make_kinematics(
   const lgsvl_msgs::msg::Detection3D & detection)
 {
-  geometry_msgs::msg::TwistWithCovariance twist;
-  twist.twist = detection.velocity;
-
-  return autoware_auto_msgs::build<autoware_auto_msgs::msg::DetectedObjectKinematics>()
-         .centroid_position(detection.bbox.position.position)
-         .position_covariance({})
-         .has_position_covariance(false)
-         .orientation(detection.bbox.position.orientation)
-         .orientation_availability(autoware_auto_msgs::msg::DetectedObjectKinematics::AVAILABLE)
-         .twist(twist)
-         .has_twist(true)
-         .has_twist_covariance(false);
+  autoware_auto_msgs::msg::DetectedObjectKinematics kinematics;
+  fill_kinematics(detection, kinematics);
+  return kinematics;
 }
 
 autoware_auto_msgs::msg::Shape make_shape(const lgsvl_msgs::msg::Detection3D & detection)
 {
-  return autoware_auto_msgs::build<autoware_auto_msgs::msg::Shape>()
-         .polygon(make_polygon_around_origin(detection))
-         .height(static_cast<float_t>(detection.bbox.size.z));
+  autoware_auto_msgs::msg::Shape shape;
+  fill_shape(detection, shape);
+  return shape;
+}
+
+void fill_roi(
+  const lgsvl_msgs::msg::Detection2D & detection,
+  autoware_auto_msgs::msg::ClassifiedRoi & roi)
+{
+  roi.classifications.resize(1U);
+  roi.classifications.front() = make_classification(detection.label);
+  fill_polygon(detection, roi.polygon);
+}
+
+void fill_detected_object(
+  const lgsvl_msgs::msg::Detection3D & detection,
+  autoware_auto_msgs::msg::DetectedObject & object)
+{
+  object.existence_probability = 1.0F;
+  object.classification.resize(1U);
+  object.classification.front() = make_classification(detection.label);
+  fill_kinematics(detection, object.kinematics);
+  fill_shape(detection, object.shape);
+}
+
+void convert_detections(
+  const lgsvl_msgs::msg::Detection2DArray & detections,
+  autoware_auto_msgs::msg::ClassifiedRoiArray & rois)
+{
+  rois.rois.resize(detections.detections.size());
+  for (std::size_t i = 0U; i < detections.detections.size(); ++i) {
+    fill_roi(detections.detections[i], rois.rois[i]);
+  }
+}
+
+std::size_t convert_detections(
+  const lgsvl_msgs::msg::Detection3DArray & detections,
+  const double_t max_range,
+  autoware_auto_msgs::msg::DetectedObjects & objects)
+{
+  const auto keep_all = (max_range == std::numeric_limits<double_t>::infinity());
+  const auto max_range_squared = max_range * max_range;
+  const auto in_range =
+    [keep_all, max_range_squared](const lgsvl_msgs::msg::Detection3D & detection) {
+      const auto & position = detection.bbox.position.position;
+      return keep_all ||
+             (((position.x * position.x) + (position.y * position.y)) <= max_range_squared);
+    };
+  // Count first, so that the objects are resized once and no detection is converted in vain
+  const auto num_kept = static_cast<std::size_t>(
+    std::count_if(detections.detections.begin(), detections.detections.end(), in_range));
+  objects.objects.resize(num_kept);
+  auto object = objects.objects.begin();
+  for (const auto & detection : detections.detections) {
+    if (in_range(detection)) {
+      fill_detected_object(detection, *object);
+      ++object;
+    }
+  }
+  return num_kept;
 }
 
 }  // namespace ground_truth_detections
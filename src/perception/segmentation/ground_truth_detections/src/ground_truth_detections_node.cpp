@@ -18,7 +18,8 @@
 
 #include <autoware_auto_msgs/msg/classified_roi.hpp>
 #include <autoware_auto_msgs/msg/detected_object.hpp>
-#include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 namespace autoware
 {
@@ -41,47 +42,31 @@ GroundTruthDetectionsNode::GroundTruthDetectionsNode(const rclcpp::NodeOptions &
 m_detection3d_sub{create_subscription<lgsvl_msgs::msg::Detection3DArray>(
     "/simulator/ground_truth/detections3D", rclcpp::QoS{10},
     [this](lgsvl_msgs::msg::Detection3DArray::SharedPtr msg) {on_detection(*msg);}
-  )}
+  )},
+  m_max_range{this->declare_parameter("max_range_m", 0.0)}
 {
+  if (m_max_range < 0.0) {
+    throw std::domain_error("max_range_m must not be negative");
+  }
+  if (m_max_range == 0.0) {
+    m_max_range = std::numeric_limits<double_t>::infinity();
+  }
 }
 
 void GroundTruthDetectionsNode::on_detection(const lgsvl_msgs::msg::Detection2DArray & msg)
 {
-  autoware_auto_msgs::msg::ClassifiedRoiArray roi_array;
-  roi_array.header = msg.header;
-  roi_array.header.frame_id = m_vision_frame_id;
-
-  roi_array.rois.resize(msg.detections.size());
-  std::transform(
-    msg.detections.begin(), msg.detections.end(), roi_array.rois.begin(),
-    [](const lgsvl_msgs::msg::Detection2D & detection) {
-      return autoware_auto_msgs::build<autoware_auto_msgs::msg::ClassifiedRoi>()
-      .classifications({make_classification(detection.label)})
-      .polygon(make_polygon(detection));
-    });
-  m_detection2d_pub->publish(roi_array);
+  m_roi_array.header = msg.header;
+  m_roi_array.header.frame_id = m_vision_frame_id;
+  convert_detections(msg, m_roi_array);
+  m_detection2d_pub->publish(m_roi_array);
 }
 
 void GroundTruthDetectionsNode::on_detection(const lgsvl_msgs::msg::Detection3DArray & msg)
 {
-  autoware_auto_msgs::msg::DetectedObjects detected_objects;
-  detected_objects.header = msg.header;
-  detected_objects.header.frame_id = kFrameId3d;
-
-  detected_objects.objects.resize(msg.detections.size());
-  const auto create_detected_object =
-    [](const lgsvl_msgs::msg::Detection3D & detection) {
-      return autoware_auto_msgs::build<autoware_auto_msgs::msg::DetectedObject>()
-             .existence_probability(1.0F)
-             .classification({make_classification(detection.label)})
-             .kinematics(make_kinematics(detection))
-             .shape(make_shape(detection));
-    };
-
-  std::transform(
-    msg.detections.begin(), msg.detections.end(),
-    detected_objects.objects.begin(), create_detected_object);
-  m_detection3d_pub->publish(detected_objects);
+  m_detected_objects.header = msg.header;
+  m_detected_objects.header.frame_id = kFrameId3d;
+  (void)convert_detections(msg, m_max_range, m_detected_objects);
+  m_detection3d_pub->publish(m_detected_objects);
 }
 }  // namespace ground_truth_detections
 }  // namespace autoware
@@ -21,6 +21,7 @@
 #include <fake_test_node/fake_test_node.hpp>
 
 #include <math.h>
+#include <limits>
 #include <memory>
 
 #include "gtest/gtest.h"
@@ -29,6 +30,11 @@ namespace
 {
 
 using autoware::ground_truth_detections::GroundTruthDetectionsNode;
+using autoware::ground_truth_detections::convert_detections;
+using autoware::ground_truth_detections::make_classification;
+using autoware::ground_truth_detections::make_kinematics;
+using autoware::ground_truth_detections::make_polygon;
+using autoware::ground_truth_detections::make_shape;
 using autoware_auto_msgs::msg::ClassifiedRoiArray;
 using autoware_auto_msgs::msg::DetectedObjects;
 using geometry_msgs::msg::Vector3;
@@ -373,4 +379,58 @@ TEST_F(GroundTruth3dDetectionsTest, ReceiveDetections)
   }
 }
 
+TEST(GroundTruthDetectionsConversion, Convert2d)
+{
+  const auto input_msg = make_sample_detections_2d();
+  ClassifiedRoiArray rois;
+  // Converting into a message with more regions and stale values overwrites them
+  rois.rois.resize(input_msg.detections.size() + 3U);
+  rois.rois.back().classifications.resize(2U);
+  convert_detections(input_msg, rois);
+  ASSERT_EQ(rois.rois.size(), input_msg.detections.size());
+  for (std::size_t i = 0U; i < rois.rois.size(); ++i) {
+    const auto & detection = input_msg.detections[i];
+    ASSERT_EQ(rois.rois[i].classifications.size(), 1U);
+    EXPECT_EQ(rois.rois[i].classifications.front(), make_classification(detection.label));
+    EXPECT_EQ(rois.rois[i].polygon, make_polygon(detection));
+  }
+}
+
+TEST(GroundTruthDetectionsConversion, Convert3dInRange)
+{
+  auto input_msg = make_sample_detections_3d();
+  // A crowd of detections along the x axis, every 10 m
+  const auto car = input_msg.detections.front();
+  input_msg.detections.clear();
+  for (int32_t i = -20; i <= 20; ++i) {
+    auto detection = car;
+    detection.id = i;
+    detection.label = ((i % 2) == 0) ? "Pedestrian" : "BoxTruck";
+    detection.bbox.position.position.x = 10.0 * i;
+    detection.bbox.position.position.y = 0.0;
+    input_msg.detections.push_back(detection);
+  }
+
+  DetectedObjects objects;
+  const auto infinity = std::numeric_limits<double_t>::infinity();
+  EXPECT_EQ(convert_detections(input_msg, infinity, objects), input_msg.detections.size());
+  ASSERT_EQ(objects.objects.size(), input_msg.detections.size());
+
+  // Only the detections within 35 m are kept, in the order of the input
+  EXPECT_EQ(convert_detections(input_msg, 35.0, objects), 7U);
+  ASSERT_EQ(objects.objects.size(), 7U);
+  for (std::size_t i = 0U; i < objects.objects.size(); ++i) {
+    const auto & detection = input_msg.detections[i + 17U];
+    const auto & object = objects.objects[i];
+    EXPECT_EQ(object.existence_probability, 1.0F);
+    ASSERT_EQ(object.classification.size(), 1U);
+    EXPECT_EQ(object.classification.front(), make_classification(detection.label));
+    EXPECT_EQ(object.kinematics, make_kinematics(detection));
+    EXPECT_EQ(object.shape, make_shape(detection));
+  }
+
+  EXPECT_EQ(convert_detections(input_msg, 1.0, objects), 1U);
+  EXPECT_EQ(objects.objects.front().kinematics.centroid_position.x, 0.0);
+}
+
 }  // namespace
@@ -101,28 +101,31 @@ public:
       common::state_estimation::LinearMeasurement<ClassificationStateT>::create_with_stddev(
       ClassificationStateT::Vector::Constant(0.0F),
       ClassificationStateT::Vector::Constant(observation_covariance));
-    for (const auto & classification : classification_vector) {
-      // We can use the classification as a direct index into the state because within this class we
-      // guarantee that the variable that corresponds to a certain index within the
-      // ObjectClassification constants is exactly on the same position within the state vector used
-      // here. See autoware::perception::tracking::assert_indices_match_classification_constants.
-      if (std::isnan(classification.probability)) {
-        throw std::domain_error("Provided classification probability is NAN.");
-      }
-      measurement.state()[classification.classification] = classification.probability;
-    }
-    const auto sum = measurement.state().vector().sum();
-    if (sum > 1.0F) {
-      throw std::domain_error("Sum of all probabilities in the classification of an object is > 1");
-    } else if (sum < 1.0F) {
-      // Any gap in the total probability mass contributes to the likelihood of an unknown state.
+    if (!observed_probabilities(classification_vector, measurement.state())) {
       std::cerr << "WARNING: Sum of all classification probabilities is less than one. "
         "Assigning the missing probability to the UNKNOWN class." << std::endl;
-      measurement.state()[autoware_auto_msgs::msg::ObjectClassification::UNKNOWN] = 1.0F - sum;
     }
     m_tracker.correct(measurement);
   }
 
+  ///
+  /// @brief      Gets the largest difference between the probabilities of a classification update
+  ///             and the current state, e.g. to skip updates that would barely change it.
+  ///
+  /// @note       The classification vector is interpreted as in `update`.
+  ///
+  /// @param[in]  classifications  A vector of classifications with their probabilities.
+  ///
+  /// @return     The largest absolute difference over all classes.
+  ///
+  common::types::float32_t max_difference(
+    const autoware_auto_msgs::msg::DetectedObject::_classification_type & classifications) const
+  {
+    ClassificationStateT observed{};
+    observed_probabilities(classifications, observed);
+    return (observed.vector() - m_tracker.state().vector()).cwiseAbs().maxCoeff();
+  }
+
   ///
   /// @brief      Gets the most likely class from the current state vector.
   ///
@@ -163,6 +166,35 @@ public:
   }
 
 private:
+  /// @brief      Write the probabilities of a classification vector into a zeroed state, with the
+  ///             missing probability mass assigned to the UNKNOWN state.
+  /// @return     False if there was missing probability mass.
+  /// @throws     std::domain_error if a probability is NAN or the sum of them is above 1.
+  static bool observed_probabilities(
+    const autoware_auto_msgs::msg::DetectedObject::_classification_type & classification_vector,
+    ClassificationStateT & state)
+  {
+    for (const auto & classification : classification_vector) {
+      // We can use the classification as a direct index into the state because within this class we
+      // guarantee that the variable that corresponds to a certain index within the
+      // ObjectClassification constants is exactly on the same position within the state vector used
+      // here. See autoware::perception::tracking::assert_indices_match_classification_constants.
+      if (std::isnan(classification.probability)) {
+        throw std::domain_error("Provided classification probability is NAN.");
+      }
+      state[classification.classification] = classification.probability;
+    }
+    const auto sum = state.vector().sum();
+    if (sum > 1.0F) {
+      throw std::domain_error("Sum of all probabilities in the classification of an object is > 1");
+    } else if (sum < 1.0F) {
+      // Any gap in the total probability mass contributes to the likelihood of an unknown state.
+      state[autoware_auto_msgs::msg::ObjectClassification::UNKNOWN] = 1.0F - sum;
+      return false;
+    }
+    return true;
+  }
+
   /// @brief      Create an initial classification vector, with 100% probability for the UNKNOWN
   ///             state.
   static ClassificationStateT create_initial_classification_vector()
@@ -18,7 +18,9 @@
 
 #include <autoware_auto_msgs/msg/detected_objects.hpp>
 #include <common/types.hpp>
+#include <geometry/spatial_hash.hpp>
 #include <hungarian_assigner/hungarian_assigner.hpp>
+#include <hungarian_assigner/sparse_assigner.hpp>
 #include <tracking/tracked_object.hpp>
 #include <tracking/tracker_types.hpp>
 
@@ -47,9 +49,17 @@ public:
   /// \param consider_edge_for_big_detections When true, the shortest edge of the detection will
   ///                                         be used as the max distance threshold if it is
   ///                                         greater than the configured threshold
+  /// \param use_sparse_assigner When true, the associator solves the assignment over the gated
+  ///                            pairs only, split into independent clusters, instead of solving
+  ///                            the dense matrix of all tracks and detections
+  /// \param reuse_tolerance When positive, the last solved result is reused without solving if
+  ///                        the gated pairs are the same as for it and none of their weights
+  ///                        changed by more than this. Zero always solves
+  /// \throw std::domain_error if reuse_tolerance is negative
   DataAssociationConfig(
     const float32_t max_distance, const float32_t max_area_ratio,
-    const bool consider_edge_for_big_detections);
+    const bool consider_edge_for_big_detections, const bool use_sparse_assigner = false,
+    const float32_t reuse_tolerance = 0.0F);
 
   inline float32_t get_max_distance() const {return m_max_distance;}
 
@@ -61,20 +71,29 @@ public:
 
   inline bool consider_edge_for_big_detections() const {return m_consider_edge_for_big_detections;}
 
+  inline bool use_sparse_assigner() const {return m_use_sparse_assigner;}
+
+  inline float32_t get_reuse_tolerance() const {return m_reuse_tolerance;}
+
 private:
   float32_t m_max_distance;
   float32_t m_max_distance_squared;
   float32_t m_max_area_ratio;
   float32_t m_max_area_ratio_inv;
   bool m_consider_edge_for_big_detections;
+  bool m_use_sparse_assigner;
+  float32_t m_reuse_tolerance;
 };
 
 /// \brief Class to perform data association between existing tracks and new detections using
-///        mahalanobis distance and hungarian assigner
+///        mahalanobis distance and hungarian assigner. The track centroids are binned in a spatial
+///        hash with cells of the max distance, so that each detection is only compared with the
+///        tracks in the cells around it
 class TRACKING_PUBLIC DetectedObjectAssociator
 {
 public:
   using Assigner = autoware::fusion::hungarian_assigner::hungarian_assigner_c<MAX_NUM_TRACKS>;
+  using SparseAssigner = autoware::fusion::hungarian_assigner::sparse_assigner_c;
   /// \brief Constructor
   /// \param association_cfg Config object containing parameters to be used
   explicit DetectedObjectAssociator(const DataAssociationConfig & association_cfg);
@@ -86,31 +105,82 @@ public:
   AssociatorResult assign(
     const autoware_auto_msgs::msg::DetectedObjects & detections, const TrackedObjects & tracks);
 
+  /// \brief Whether the last call to assign() reused the previous result instead of solving
+  inline bool reused_result() const {return m_reused_result;}
+
 private:
   /// \brief Reset internal states of the associator
   void reset();
 
-  /// \brief Loop through all detections and tracks and set weights between them in the assigner
+  /// \brief Loop through all detections and the tracks near them and set weights between them in
+  ///        the assigner
   void compute_weights(
     const autoware_auto_msgs::msg::DetectedObjects & detections, const TrackedObjects & tracks);
 
+  /// \brief Set the weight between a detection and a track if they pass the gating
+  void compute_weight(
+    const autoware_auto_msgs::msg::DetectedObject & detection, const size_t det_idx,
+    const TrackedObject & track, const size_t track_idx);
+
+  /// \brief Get the squared max distance between the given detection and an associated track
+  float32_t get_distance_threshold_squared(
+    const autoware_auto_msgs::msg::DetectedObject & detection) const;
+
   /// \brief Check if the given track and detection are similar enough to compute weight
   bool consider_associating(
     const autoware_auto_msgs::msg::DetectedObject & detection, const TrackedObject & track) const;
 
-  /// Set weight in the assigner (Has to determine which idx is row and which is column)
+  /// Add a gated pair with its weight (Has to determine which idx is row and which is column)
   void set_weight(const float32_t weight, const size_t det_idx, const size_t track_idx);
 
+  /// \brief Check if the gated pairs and their weights are close enough to the ones of the last
+  ///        solved frame to reuse its result, the pairs must be sorted by row and column
+  bool can_reuse_result() const;
+
+  /// \brief Set the gated pairs in the configured assigner and solve
+  void solve(const assigner_idx_t num_rows, const assigner_idx_t num_cols);
+
+  /// \brief Get the assignment of a row from the configured assigner
+  assigner_idx_t get_assignment(const assigner_idx_t idx) const;
+
   /// \brief Extract result from the assigner and populate the AssociatorResult container
   AssociatorResult extract_result() const;
 
+  /// \brief Track centroid in the spatial hash, relative to the corner of all track centroids
+  struct TrackPoint
+  {
+    float32_t x;
+    float32_t y;
+    float32_t z;
+    size_t track_idx;
+  };
+  using TrackHash = autoware::common::geometry::spatial_hash::SpatialHash2d<TrackPoint>;
+
+  /// \brief A gated pair of a row and a column of the assignment problem
+  struct Edge
+  {
+    assigner_idx_t row;
+    assigner_idx_t col;
+    float32_t weight;
+  };
+
   DataAssociationConfig m_association_cfg;
+  TrackHash m_track_hash;
   Assigner m_assigner;
+  SparseAssigner m_sparse_assigner;
   // Hungarian assigner expects a fat matrix (not tall). Bool tracks if tracks are rows or cols
   bool m_are_tracks_rows;
   size_t m_num_tracks;
   size_t m_num_detections;
   bool m_had_errors = false;
+  // Gated pairs of the current frame, and of the last solved frame with its result
+  std::vector<Edge> m_edges;
+  std::vector<Edge> m_solved_edges;
+  AssociatorResult m_solved_result;
+  bool m_has_solved_result = false;
+  size_t m_solved_num_tracks = 0U;
+  size_t m_solved_num_detections = 0U;
+  bool m_reused_result = false;
 };
 
 
@@ -0,0 +1,93 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 The Autoware Foundation
+/// \file
+/// \brief This file defines a queue that merges the detections of several sources by time.
+
+#ifndef TRACKING__DETECTION_MERGE_QUEUE_HPP_
+#define TRACKING__DETECTION_MERGE_QUEUE_HPP_
+
+#include <autoware_auto_msgs/msg/detected_objects.hpp>
+#include <tracking/visibility_control.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace autoware
+{
+namespace perception
+{
+namespace tracking
+{
+
+/// \brief Merges the detections of several sources, e.g. lidar and radar, into one stream that is
+/// ordered by stamp, as the tracker needs it.
+///
+/// Each source is assumed to publish in the order of its stamps. A message is released once every
+/// source has published a message that is at least as new, so that no older one can follow. To
+/// bound the latency when a source lags behind or stops, a message is also released once the
+/// newest stamp from any source is max_latency ahead of it. The lagging source then skips ahead:
+/// its older messages that arrive afterwards are dropped.
+class TRACKING_PUBLIC DetectionMergeQueue
+{
+public:
+  using DetectedObjects = autoware_auto_msgs::msg::DetectedObjects;
+
+  /// Constructor
+  /// \param num_sources The number of sources of detections.
+  /// \param max_latency The longest time, in stamps, that a message waits for the other sources.
+  /// \throws std::domain_error if there are no sources or the latency is negative.
+  DetectionMergeQueue(std::size_t num_sources, std::chrono::nanoseconds max_latency);
+
+  /// Add a message from a source.
+  /// \param source The index of the source, below the number of sources.
+  /// \param msg The message.
+  /// \return False if the message was dropped because it is older than a released message.
+  /// \throws std::out_of_range if the source does not exist.
+  bool push(std::size_t source, const DetectedObjects::ConstSharedPtr & msg);
+
+  /// Release the oldest message if it is ready.
+  /// \return The message, or null if there is none that is ready.
+  DetectedObjects::ConstSharedPtr pop();
+
+  /// The number of messages that are waiting.
+  std::size_t size() const noexcept {return m_queue.size();}
+
+  /// The number of messages that have been dropped because they were too old.
+  std::size_t num_dropped() const noexcept {return m_num_dropped;}
+
+private:
+  struct Entry
+  {
+    std::chrono::nanoseconds stamp;
+    DetectedObjects::ConstSharedPtr msg;
+  };
+
+  /// Waiting messages, ordered by stamp and then by arrival.
+  std::vector<Entry> m_queue;
+  /// The newest stamp published by each source, or min() for none.
+  std::vector<std::chrono::nanoseconds> m_source_stamps;
+  std::chrono::nanoseconds m_max_latency;
+  std::chrono::nanoseconds m_newest_stamp{std::chrono::nanoseconds::min()};
+  std::chrono::nanoseconds m_released_stamp{std::chrono::nanoseconds::min()};
+  std::size_t m_num_dropped{0U};
+};
+
+}  // namespace tracking
+}  // namespace perception
+}  // namespace autoware
+
+#endif  // TRACKING__DETECTION_MERGE_QUEUE_HPP_
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace autoware
@@ -56,6 +57,55 @@ struct TRACKING_PUBLIC IOUHeuristic
   }
 };
 
+namespace details
+{
+/// \brief Uniform grid over the bounding boxes of the ROIs of an image, to find the ROIs that
+///        can overlap a projection without computing the IoU with every ROI.
+class TRACKING_PUBLIC RoiGrid
+{
+public:
+  using float32_t = autoware::common::types::float32_t;
+  /// Number of cells along each axis of the image.
+  static constexpr std::size_t kCellsPerAxis = 8U;
+
+  /// \brief Bin the bounding boxes of the ROIs into the cells of the grid over their extent.
+  /// \param rois Regions of interest in image space.
+  explicit RoiGrid(const autoware_auto_msgs::msg::ClassifiedRoiArray & rois);
+
+  /// \brief Find the ROIs whose bounding box overlaps a box, which includes all ROIs that can
+  ///        have a nonzero IoU with a shape within the box.
+  /// \param min_x Minimum x coordinate of the box.
+  /// \param min_y Minimum y coordinate of the box.
+  /// \param max_x Maximum x coordinate of the box.
+  /// \param max_y Maximum y coordinate of the box.
+  /// \return Indices of the ROIs in increasing order, valid until the next query.
+  const std::vector<std::size_t> & query(
+    const float32_t min_x, const float32_t min_y, const float32_t max_x, const float32_t max_y);
+
+private:
+  struct Box
+  {
+    float32_t min_x;
+    float32_t min_y;
+    float32_t max_x;
+    float32_t max_y;
+  };
+
+  /// \brief Get the range of the cells along an axis that overlap an interval.
+  std::pair<std::size_t, std::size_t> cell_range(
+    const float32_t min, const float32_t max, const float32_t grid_min,
+    const float32_t cell_size) const;
+
+  std::vector<Box> m_boxes;
+  Box m_bounds{};
+  float32_t m_cell_width{1.0F};
+  float32_t m_cell_height{1.0F};
+  std::vector<std::vector<std::size_t>> m_cells;
+  std::vector<common::types::bool8_t> m_is_visited;
+  std::vector<std::size_t> m_result;
+};
+}  // namespace details
+
 struct GreedyRoiAssociatorConfig
 {
   CameraIntrinsics intrinsics;
@@ -103,12 +153,23 @@ private:
     const std::string & source_frame,
     const tf2::TimePoint & stamp) const;
 
-  // Scan the ROIs to find the best matching roi for a given shape by projecting it onto image
-  // frame
-  std::size_t project_and_match_detection(
-    const std::vector<geometry_msgs::msg::Point32> & object_shape_in_camera_frame,
+  using Vertices = CameraModel::EigPoints;
+
+  // Project the vertices of all objects onto the image in bulk and greedily match each object
+  // to the available ROI with the best IoU. The vertices of object i are in the columns
+  // [vertex_begin[i], vertex_begin[i + 1]) in the source frame.
+  AssociatorResult project_and_match(
+    const autoware_auto_msgs::msg::ClassifiedRoiArray & rois,
+    const std::string & source_frame,
+    const Vertices & vertices,
+    const std::vector<std::size_t> & vertex_begin) const;
+
+  // Scan the ROIs near a projection to find the best matching available roi
+  std::size_t match_projection(
+    const Projection & projection,
     const std::unordered_set<std::size_t> & available_roi_indices,
-    const autoware_auto_msgs::msg::ClassifiedRoiArray & rois) const;
+    const autoware_auto_msgs::msg::ClassifiedRoiArray & rois,
+    details::RoiGrid & roi_grid) const;
 
   CameraModel m_camera;
   IOUHeuristic m_iou_func{};
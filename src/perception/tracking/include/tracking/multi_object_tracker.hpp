@@ -31,6 +31,7 @@
 #include <autoware_auto_msgs/msg/tracked_object.hpp>
 #include <autoware_auto_msgs/msg/tracked_objects.hpp>
 #include <common/types.hpp>
+#include <helper_functions/worker_pool.hpp>
 #include <geometry_msgs/msg/transform_stamped.hpp>
 #include <motion_model/linear_motion_model.hpp>
 #include <nav_msgs/msg/odometry.hpp>
@@ -75,6 +76,23 @@ enum class TrackerUpdateStatus
 };
 
 
+/// \brief Time spent in each stage of MultiObjectTracker::update.
+struct TRACKING_PUBLIC TrackerStageTimings
+{
+  /// Transforming the detections into the tracker frame.
+  std::chrono::nanoseconds transform{};
+  /// Predicting the tracks to the time of the detections.
+  std::chrono::nanoseconds predict{};
+  /// Associating the detections with the tracks.
+  std::chrono::nanoseconds associate{};
+  /// Updating the tracks with their detections.
+  std::chrono::nanoseconds update{};
+  /// Creating tracks from the unassociated detections.
+  std::chrono::nanoseconds create{};
+  /// Pruning unseen tracks.
+  std::chrono::nanoseconds prune{};
+};
+
 /// \brief Output of MultiObjectTracker::update.
 struct TRACKING_PUBLIC DetectedObjectsUpdateResult
 {
@@ -86,6 +104,8 @@ struct TRACKING_PUBLIC DetectedObjectsUpdateResult
   TrackerUpdateStatus status;
   /// Timestamps of ROI msgs used for track creation. Useful for debugging purposes.
   MaybeRoiStampsT maybe_roi_stamps;
+  /// Time spent in each stage of the update, zero for the stages that did not run.
+  TrackerStageTimings timings;
 };
 
 /// \brief Options for object tracking, with sensible defaults.
@@ -103,6 +123,9 @@ struct TRACKING_PUBLIC MultiObjectTrackerOptions
   std::size_t pruning_ticks_threshold = std::numeric_limits<std::size_t>::max();
   /// The frame in which to do tracking.
   std::string frame = "map";
+  /// Number of threads that predict and update the tracks, including the calling thread. Each
+  /// track has its own filter, so the result does not depend on this.
+  std::size_t num_workers = 1U;
 };
 
 /// \brief A class for multi-object tracking.
@@ -144,8 +167,11 @@ private:
     const DetectedObjectsMsg & detections,
     const nav_msgs::msg::Odometry & detection_frame_odometry);
 
+  /// Call the work for each track, on the workers if there are any.
+  void for_each_track(const common::helper_functions::WorkerPool::Work & work);
+
   /// Convert the internal tracked object representation to the ROS message type.
-  TrackedObjectsMsg convert_to_msg(const builtin_interfaces::msg::Time & stamp) const;
+  TrackedObjectsMsg convert_to_msg(const builtin_interfaces::msg::Time & stamp);
 
   /// The tracked objects, also called "tracks".
   TrackedObjects m_tracks;
@@ -163,6 +189,9 @@ private:
 
   /// Creator for creating tracks based on unassociated observations
   TrackCreator m_track_creator;
+
+  /// Workers for predicting and updating the tracks, if there is more than one.
+  std::unique_ptr<common::helper_functions::WorkerPool> m_track_workers;
 };
 
 }  // namespace tracking
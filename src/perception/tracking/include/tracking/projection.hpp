@@ -18,6 +18,8 @@
 #define TRACKING__PROJECTION_HPP_
 
 #include <autoware_auto_msgs/msg/shape.hpp>
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/quaternion.hpp>
 #include <common/types.hpp>
 #include <geometry_msgs/msg/polygon.hpp>
 #include <geometry_msgs/msg/transform.hpp>
@@ -64,6 +66,10 @@ public:
   using Interval = common::geometry::Interval<float32_t>;
   using Point = geometry_msgs::msg::Point32;
   using EigPoint = Eigen::Vector3f;
+  /// Points, one per column.
+  using EigPoints = Eigen::Matrix<float32_t, 3, Eigen::Dynamic>;
+  /// Matrix that projects homogeneous 3D points onto the image plane, scaled by their depth.
+  using Projector = Eigen::Matrix<float32_t, 3, 4>;
 
   /// \brief Cnstructor
   /// \param intrinsics Camera intrinsics
@@ -81,17 +87,56 @@ public:
   std::experimental::optional<Projection>
   project(const std::vector<Point> & points) const;
 
-private:
-  /// \brief Project a 3D point and return the value if the projection is valid (in fron of the
-  // camera)
-  std::experimental::optional<EigPoint> project_point(const EigPoint & pt_3d) const;
+  /// \brief Get the matrix `K * [R | t]` that brings 3D points from another frame to the camera
+  /// frame and projects them onto the image plane, scaled by their depth. The points of many
+  /// shapes can then be projected with one matrix multiplication.
+  /// \param camera_from_frame Transform from the frame of the points to the camera frame.
+  /// \return The projection matrix, to be multiplied with the homogeneous points.
+  Projector projector(const Eigen::Affine3f & camera_from_frame) const;
+
+  /// \brief Outline the points of a shape that were projected with a projector(). This is
+  /// project() of the points, after their projection.
+  /// \param points_2d Projected points scaled by their depth, one per column.
+  /// \return List of points on the camera frame that outline the given 3D object.
+  std::experimental::optional<Projection>
+  outline(const Eigen::Ref<const EigPoints> & points_2d) const;
 
+  /// \brief Project the vertices of many shapes onto the image plane with one matrix
+  /// multiplication and outline each shape. The shapes which are entirely behind the camera or
+  /// beside the image are culled from their projected vertices, without being outlined.
+  /// \param camera_from_frame Transform from the frame of the vertices to the camera frame.
+  /// \param vertices The vertices of all shapes, one per column, see set_shape_vertices().
+  /// \param vertex_begin The vertices of shape i are in the columns
+  /// [vertex_begin[i], vertex_begin[i + 1]).
+  /// \return The outline of each shape on the image, if it is visible.
+  std::vector<std::experimental::optional<Projection>> project_shapes(
+    const Eigen::Affine3f & camera_from_frame, const EigPoints & vertices,
+    const std::vector<std::size_t> & vertex_begin) const;
+
+private:
   Eigen::Matrix3f m_intrinsics;
   Interval m_height_interval;
   Interval m_width_interval;
   std::list<Point> m_corners;
 };
 
+/// \brief Write the vertices of the bottom and top faces of a shape at a pose to the columns of
+/// vertices, starting at a column. A shape has 2 * shape.polygon.points.size() vertices.
+/// \param shape Shape msg with corners in object-local coordinate
+/// \param centroid Centroid of the object whose corners are defined in shape
+/// \param orientation Orientation of the object
+/// \param first_vertex The column of the first vertex
+/// \param vertices The vertices, with enough columns for the shape
+TRACKING_PUBLIC void set_shape_vertices(
+  const autoware_auto_msgs::msg::Shape & shape, const geometry_msgs::msg::Point & centroid,
+  const geometry_msgs::msg::Quaternion & orientation, const std::size_t first_vertex,
+  CameraModel::EigPoints & vertices);
+
+/// \brief Convert a transform msg to an affine transform, to build a CameraModel::projector().
+/// This is the same transform as common::lidar_utils::StaticTransformer.
+/// \throw std::domain_error If the quaternion is not normalized
+TRACKING_PUBLIC Eigen::Affine3f to_affine(const geometry_msgs::msg::Transform & tf);
+
 }  // namespace tracking
 }  // namespace perception
 }  // namespace autoware
@@ -60,6 +60,8 @@ struct TRACKING_PUBLIC TrackCreatorConfig
   float64_t default_variance = -1.0;  // Invalid, to make sure it is set.
   /// The magnitude of the noise in the Kalman filter.
   float64_t noise_variance = -1.0;  // Invalid, to make sure it is set.
+  /// When the new tracks apply the classification and shape of later inputs.
+  TrackedObjectUpdatePolicy update_policy{};
   std::experimental::optional<VisionPolicyConfig> vision_policy_config = std::experimental::nullopt;
 };
 
@@ -86,9 +88,11 @@ public:
   /// \param default_variance Default variance value for tracks to be created
   /// \param noise_variance Default noise variance for tracks to be created
   /// \param tf_buffer tf buffer containing the necessary transforms
+  /// \param update_policy Update policy for tracks to be created
   CreationPolicyBase(
     const float64_t default_variance, const float64_t noise_variance,
-    const tf2::BufferCore & tf_buffer);
+    const tf2::BufferCore & tf_buffer,
+    const TrackedObjectUpdatePolicy & update_policy = TrackedObjectUpdatePolicy{});
 
   /// Function to create new tracks based on previously supplied detection data
   /// \return Struct containing new tracks and unused detections
@@ -122,6 +126,7 @@ public:
 protected:
   float64_t m_default_variance;
   float64_t m_noise_variance;
+  TrackedObjectUpdatePolicy m_update_policy;
   const tf2::BufferCore & m_tf_buffer;
   autoware_auto_msgs::msg::DetectedObjects m_debug_objects;
 };
@@ -132,7 +137,8 @@ class LidarOnlyPolicy : public CreationPolicyBase
 public:
   LidarOnlyPolicy(
     const float64_t default_variance, const float64_t noise_variance,
-    const tf2::BufferCore & tf_buffer);
+    const tf2::BufferCore & tf_buffer,
+    const TrackedObjectUpdatePolicy & update_policy = TrackedObjectUpdatePolicy{});
   TrackCreationResult create() override;
 
   void add_objects(
@@ -156,7 +162,8 @@ class LidarClusterIfVisionPolicy : public CreationPolicyBase
 public:
   LidarClusterIfVisionPolicy(
     const VisionPolicyConfig & cfg, const float64_t default_variance,
-    const float64_t noise_variance, const tf2::BufferCore & tf_buffer);
+    const float64_t noise_variance, const tf2::BufferCore & tf_buffer,
+    const TrackedObjectUpdatePolicy & update_policy = TrackedObjectUpdatePolicy{});
   TrackCreationResult create() override;
 
   void add_objects(
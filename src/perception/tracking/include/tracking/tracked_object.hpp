@@ -44,6 +44,21 @@ namespace perception
 namespace tracking
 {
 
+/// \brief When to apply the classification and shape of the inputs associated with a track. Once
+/// a track has settled, most of them barely change it, so they can be skipped. The defaults apply
+/// every input.
+struct TRACKING_PUBLIC TrackedObjectUpdatePolicy
+{
+  /// Apply every n-th classification update, and the diverging ones in between. 1 applies all.
+  std::size_t classification_update_period = 1U;
+  /// Apply a classification update in between when one of its probabilities differs from the ones
+  /// of the track by more than this.
+  common::types::float32_t classification_divergence = 1.0F;
+  /// Replace the shape of the track with the one of a detection when their IoU is below this. At 1
+  /// the shape is always replaced, without computing the IoU.
+  common::types::float32_t shape_iou_threshold = 1.0F;
+};
+
 /// \brief Internal class containing the object state and other information.
 class TRACKING_PUBLIC TrackedObject
 {
@@ -57,24 +72,53 @@ public:
   using DetectedObjectMsg = autoware_auto_msgs::msg::DetectedObject;
   using ObjectClassifications = autoware_auto_msgs::msg::TrackedObject::_classification_type;
   using ShapeMsg = autoware_auto_msgs::msg::Shape;
+  using StateMatrix = CA::Matrix;
+
+  /// The motion of the tracks over one time step. The motion model is linear, so the transition
+  /// and noise matrices only depend on the time step and can be shared by all tracks.
+  struct TRACKING_PUBLIC Prediction
+  {
+    /// The time step.
+    std::chrono::nanoseconds dt;
+    /// The sigma for the acceleration noise of the tracks this prediction is for.
+    common::types::float64_t noise_variance;
+    /// The state transition matrix over dt.
+    StateMatrix transition;
+    /// The covariance of the process noise over dt.
+    StateMatrix noise_covariance;
+  };
 
   /// Constructor
   /// \param detection A detection from which to initialize this object. Must have a pose.
   /// \param default_variance All variables will initially have this variance where the detection
   /// does not contain one.
   /// \param noise_variance The sigma for the acceleration noise
+  /// \param update_policy When to apply the classification and shape of later inputs.
   /// \throws std::runtime_error if the detection does not have a pose.
+  /// \throws std::domain_error if the classification update period is 0.
   TrackedObject(
     const DetectedObjectMsg & detection, common::types::float64_t default_variance,
-    common::types::float64_t noise_variance);
+    common::types::float64_t noise_variance,
+    const TrackedObjectUpdatePolicy & update_policy = TrackedObjectUpdatePolicy{});
   /// Extrapolate the track forward.
   // TODO(nikolai.morin): Change signature to use absolute time after #1002
   void predict(std::chrono::nanoseconds dt);
 
-  /// Adjust the track to the detection.
+  /// Compute the prediction of all tracks with the same noise variance over a time step.
+  /// \param dt The time step.
+  /// \param noise_variance The sigma for the acceleration noise
+  /// \return The prediction, for predict(const Prediction &).
+  static Prediction make_prediction(
+    std::chrono::nanoseconds dt, common::types::float64_t noise_variance);
+
+  /// Extrapolate the track forward with a shared prediction, which is equivalent to
+  /// predict(prediction.dt). Falls back to it if the prediction is for another noise variance.
+  void predict(const Prediction & prediction);
+
+  /// Adjust the track to the detection. The shape is only replaced as the update policy says.
   void update(const DetectedObjectMsg & detection);
 
-  /// Update just the classification state of the track
+  /// Update just the classification state of the track, if the update policy applies the update.
   void update(
     const ObjectClassifications & obj_type, const common::types::float32_t covariance);
 
@@ -127,8 +171,14 @@ private:
   /// All variables will initially have this variance where the detection
   /// does not contain one.
   common::types::float64_t m_default_variance = -1.0;
+  /// The sigma for the acceleration noise.
+  common::types::float64_t m_noise_variance = -1.0;
   /// Track class classifier.
   ClassificationTracker m_classifier;
+  /// When to apply the classification and shape of the inputs.
+  TrackedObjectUpdatePolicy m_update_policy;
+  /// The number of classification updates since the last applied one.
+  std::size_t m_classification_updates_skipped = 0U;
 };
 
 
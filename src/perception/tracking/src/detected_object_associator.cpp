@@ -21,6 +21,7 @@
 #include <helper_functions/mahalanobis_distance.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <vector>
 
@@ -34,19 +35,47 @@ namespace tracking
 using autoware::common::state_vector::variable::X;
 using autoware::common::state_vector::variable::Y;
 using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
+
+namespace
+{
+// Side of the square around the tracks covered by the spatial hash. Tracks and detections beyond
+// it are clamped to its border cells, which keeps the gating correct but less selective
+constexpr float32_t kHashExtent = 1000.0F;
+constexpr float32_t kMinCellSize = 1.0F;
+// Added to the query radius so that rounding never drops a pair that passes the exact gating
+constexpr float32_t kGateSlack = 0.01F;
+}  // namespace
 
 constexpr std::size_t AssociatorResult::UNASSIGNED;
+static_assert(
+  DetectedObjectAssociator::Assigner::UNASSIGNED ==
+  DetectedObjectAssociator::SparseAssigner::UNASSIGNED,
+  "Both assigners must denote an unassigned row alike");
 
 DataAssociationConfig::DataAssociationConfig(
   const float32_t max_distance,
   const float32_t max_area_ratio,
-  const bool consider_edge_for_big_detections)
+  const bool consider_edge_for_big_detections,
+  const bool use_sparse_assigner,
+  const float32_t reuse_tolerance)
 : m_max_distance(max_distance), m_max_distance_squared(max_distance * max_distance),
   m_max_area_ratio(max_area_ratio), m_max_area_ratio_inv(1.F / max_area_ratio),
-  m_consider_edge_for_big_detections(consider_edge_for_big_detections) {}
+  m_consider_edge_for_big_detections(consider_edge_for_big_detections),
+  m_use_sparse_assigner(use_sparse_assigner),
+  m_reuse_tolerance(reuse_tolerance)
+{
+  if (!(reuse_tolerance >= 0.0F)) {
+    throw std::domain_error("The reuse tolerance of the association must not be negative");
+  }
+}
 
 DetectedObjectAssociator::DetectedObjectAssociator(const DataAssociationConfig & association_cfg)
-: m_association_cfg(association_cfg) {}
+: m_association_cfg(association_cfg),
+  m_track_hash(
+    common::geometry::spatial_hash::Config2d{
+      0.0F, kHashExtent, 0.0F, kHashExtent,
+      std::max(association_cfg.get_max_distance(), kMinCellSize), MAX_NUM_TRACKS}) {}
 
 AssociatorResult DetectedObjectAssociator::assign(
   const autoware_auto_msgs::msg::DetectedObjects & detections,
@@ -60,84 +89,192 @@ AssociatorResult DetectedObjectAssociator::assign(
   m_num_detections = detections.objects.size();
   m_num_tracks = tracks.objects.size();
   m_are_tracks_rows = (m_num_tracks <= m_num_detections);
-  if (m_are_tracks_rows) {
-    m_assigner.set_size(
-      static_cast<assigner_idx_t>(tracks.objects.size()),
-      static_cast<assigner_idx_t>(detections.objects.size()));
-  } else {
-    m_assigner.set_size(
-      static_cast<assigner_idx_t>(detections.objects.size()),
-      static_cast<assigner_idx_t>(tracks.objects.size()));
-  }
+  const auto num_rows = static_cast<assigner_idx_t>(
+    m_are_tracks_rows ? m_num_tracks : m_num_detections);
+  const auto num_cols = static_cast<assigner_idx_t>(
+    m_are_tracks_rows ? m_num_detections : m_num_tracks);
   compute_weights(detections, tracks);
-  // TODO(gowtham.ranganathan): Revisit this after #979 since till then assigner will always
-  //  return true
-  (void)m_assigner.assign();
+  if (m_association_cfg.get_reuse_tolerance() <= 0.0F) {
+    solve(num_rows, num_cols);
+    return extract_result();
+  }
 
-  return extract_result();
+  // The pairs are found in the order of the spatial hash, which may change as the tracks move
+  std::sort(
+    m_edges.begin(), m_edges.end(), [](const Edge & a, const Edge & b) {
+      return (a.row < b.row) || ((a.row == b.row) && (a.col < b.col));
+    });
+  // In steady traffic, the tracks and detections and thus the gated pairs mostly stay the same
+  if (can_reuse_result()) {
+    m_reused_result = true;
+    return m_solved_result;
+  }
+  solve(num_rows, num_cols);
+  m_solved_result = extract_result();
+  m_solved_edges.swap(m_edges);
+  m_has_solved_result = true;
+  m_solved_num_tracks = m_num_tracks;
+  m_solved_num_detections = m_num_detections;
+  return m_solved_result;
 }
 
 void DetectedObjectAssociator::reset()
 {
   m_assigner.reset();
+  m_sparse_assigner.reset();
 
   m_num_tracks = 0U;
   m_num_detections = 0U;
 
   m_had_errors = false;
+  m_edges.clear();
+  m_reused_result = false;
+}
+
+bool DetectedObjectAssociator::can_reuse_result() const
+{
+  // The same numbers of tracks and detections also make the same rows and columns
+  if (!m_has_solved_result ||
+    (m_solved_num_tracks != m_num_tracks) || (m_solved_num_detections != m_num_detections) ||
+    (m_solved_edges.size() != m_edges.size()))
+  {
+    return false;
+  }
+  // Compared with the solved frame, not the previous one, so that slow changes add up
+  return std::equal(
+    m_edges.begin(), m_edges.end(), m_solved_edges.begin(),
+    [this](const Edge & a, const Edge & b) {
+      return (a.row == b.row) && (a.col == b.col) &&
+      (std::fabs(a.weight - b.weight) <= m_association_cfg.get_reuse_tolerance());
+    });
+}
+
+void DetectedObjectAssociator::solve(const assigner_idx_t num_rows, const assigner_idx_t num_cols)
+{
+  // TODO(gowtham.ranganathan): Revisit this after #979 since till then assigner will always
+  //  return true
+  if (m_association_cfg.use_sparse_assigner()) {
+    m_sparse_assigner.set_size(num_rows, num_cols);
+    for (const auto & edge : m_edges) {
+      try {
+        m_sparse_assigner.set_weight(edge.weight, edge.row, edge.col);
+      } catch (const std::domain_error &) {
+        // A weight that is not finite, the pair cannot be associated
+        m_had_errors = true;
+      }
+    }
+    (void)m_sparse_assigner.assign();
+  } else {
+    m_assigner.set_size(num_rows, num_cols);
+    for (const auto & edge : m_edges) {
+      m_assigner.set_weight(edge.weight, edge.row, edge.col);
+    }
+    (void)m_assigner.assign();
+  }
 }
 
 void DetectedObjectAssociator::compute_weights(
   const autoware_auto_msgs::msg::DetectedObjects & detections,
   const TrackedObjects & tracks)
 {
+  if (tracks.objects.empty()) {
+    return;
+  }
+  if (tracks.objects.size() > m_track_hash.capacity()) {
+    // More tracks than the hash can hold, compare all pairs
+    for (size_t det_idx = 0U; det_idx < detections.objects.size(); ++det_idx) {
+      for (size_t track_idx = 0U; track_idx < tracks.objects.size(); ++track_idx) {
+        compute_weight(detections.objects[det_idx], det_idx, tracks.objects[track_idx], track_idx);
+      }
+    }
+    return;
+  }
+
+  // Bin the tracks relative to the corner of their centroids, so that the hash covers them
+  float64_t min_x = std::numeric_limits<float64_t>::max();
+  float64_t min_y = std::numeric_limits<float64_t>::max();
+  for (const auto & track : tracks.objects) {
+    min_x = std::min(min_x, track.centroid().x());
+    min_y = std::min(min_y, track.centroid().y());
+  }
+  m_track_hash.clear();
+  for (size_t track_idx = 0U; track_idx < tracks.objects.size(); ++track_idx) {
+    const auto centroid = tracks.objects[track_idx].centroid();
+    (void)m_track_hash.insert(
+      TrackPoint{static_cast<float32_t>(centroid.x() - min_x),
+        static_cast<float32_t>(centroid.y() - min_y), 0.0F, track_idx});
+  }
+
   for (size_t det_idx = 0U; det_idx < detections.objects.size(); ++det_idx) {
-    for (size_t track_idx = 0U; track_idx < tracks.objects.size(); ++track_idx) {
-      const auto & track = tracks.objects[track_idx];
-      const auto & detection = detections.objects[det_idx];
+    const auto & detection = detections.objects[det_idx];
+    const float32_t radius = std::sqrt(get_distance_threshold_squared(detection)) + kGateSlack;
+    if (radius >= kHashExtent) {
+      // Gated by a huge detection edge, or by none for a degenerate shape, all tracks are near
+      for (size_t track_idx = 0U; track_idx < tracks.objects.size(); ++track_idx) {
+        compute_weight(detection, det_idx, tracks.objects[track_idx], track_idx);
+      }
+      continue;
+    }
+    const auto & near_tracks = m_track_hash.near(
+      static_cast<float32_t>(detection.kinematics.centroid_position.x - min_x),
+      static_cast<float32_t>(detection.kinematics.centroid_position.y - min_y), radius);
+    for (const auto & near_track : near_tracks) {
+      const size_t track_idx = near_track.get_point().track_idx;
+      compute_weight(detection, det_idx, tracks.objects[track_idx], track_idx);
+    }
+  }
+}
 
-      try {
-        if (consider_associating(detection, track)) {
-          Eigen::Matrix<float32_t, NUM_OBJ_POSE_DIM, 1> sample;
-          sample(0, 0) = static_cast<float32_t>(detection.kinematics.centroid_position.x);
-          sample(1, 0) = static_cast<float32_t>(detection.kinematics.centroid_position.y);
+void DetectedObjectAssociator::compute_weight(
+  const autoware_auto_msgs::msg::DetectedObject & detection, const size_t det_idx,
+  const TrackedObject & track, const size_t track_idx)
+{
+  try {
+    if (consider_associating(detection, track)) {
+      Eigen::Matrix<float32_t, NUM_OBJ_POSE_DIM, 1> sample;
+      sample(0, 0) = static_cast<float32_t>(detection.kinematics.centroid_position.x);
+      sample(1, 0) = static_cast<float32_t>(detection.kinematics.centroid_position.y);
 
-          Eigen::Matrix<float32_t, NUM_OBJ_POSE_DIM,
-            1> mean{track.centroid().cast<float32_t>()};
+      Eigen::Matrix<float32_t, NUM_OBJ_POSE_DIM,
+        1> mean{track.centroid().cast<float32_t>()};
 
-          Eigen::Matrix<float32_t, NUM_OBJ_POSE_DIM,
-            NUM_OBJ_POSE_DIM> cov = track.position_covariance().cast<float32_t>();
+      Eigen::Matrix<float32_t, NUM_OBJ_POSE_DIM,
+        NUM_OBJ_POSE_DIM> cov = track.position_covariance().cast<float32_t>();
 
-          const auto dist = autoware::common::helper_functions::calculate_mahalanobis_distance(
-            sample, mean, cov);
+      const auto dist = autoware::common::helper_functions::calculate_mahalanobis_distance(
+        sample, mean, cov);
 
-          set_weight(dist, det_idx, track_idx);
-        }
-      } catch (const std::runtime_error & e) {
-        m_had_errors = true;
-      } catch (const std::domain_error & e) {
-        m_had_errors = true;
-      }
+      set_weight(dist, det_idx, track_idx);
     }
+  } catch (const std::runtime_error & e) {
+    m_had_errors = true;
+  } catch (const std::domain_error & e) {
+    m_had_errors = true;
+  }
+}
+
+float32_t DetectedObjectAssociator::get_distance_threshold_squared(
+  const autoware_auto_msgs::msg::DetectedObject & detection) const
+{
+  if (!m_association_cfg.consider_edge_for_big_detections()) {
+    return m_association_cfg.get_max_distance_squared();
+  }
+  float32_t shortest_edge_squared = std::numeric_limits<float32_t>::max();
+  for (auto current = detection.shape.polygon.points.begin();
+    current != detection.shape.polygon.points.end(); ++current)
+  {
+    auto next = common::geometry::details::circular_next(
+      detection.shape.polygon.points.begin(), detection.shape.polygon.points.end(), current);
+    shortest_edge_squared =
+      std::min(shortest_edge_squared, common::geometry::squared_distance_2d(*current, *next));
   }
+  return std::max(m_association_cfg.get_max_distance_squared(), shortest_edge_squared);
 }
 
 bool DetectedObjectAssociator::consider_associating(
   const autoware_auto_msgs::msg::DetectedObject & detection,
   const TrackedObject & track) const
 {
-  const auto get_shortest_edge_size_squared = [&]() -> float32_t {
-      float32_t retval = std::numeric_limits<float32_t>::max();
-      for (auto current = detection.shape.polygon.points.begin();
-        current != detection.shape.polygon.points.end(); ++current)
-      {
-        auto next = common::geometry::details::circular_next(
-          detection.shape.polygon.points.begin(), detection.shape.polygon.points.end(), current);
-        retval = std::min(retval, common::geometry::squared_distance_2d(*current, *next));
-      }
-      return retval;
-    };
-
   const float32_t det_area = common::geometry::area_checked_2d(
     detection.shape.polygon.points.begin(), detection.shape.polygon.points.end());
 
@@ -158,19 +295,9 @@ bool DetectedObjectAssociator::consider_associating(
   track_centroid.x = track.centroid().x();
   track_centroid.y = track.centroid().y();
 
-  const auto compute_distance_threshold = [&get_shortest_edge_size_squared, this]() -> float32_t {
-      if (m_association_cfg.consider_edge_for_big_detections()) {
-        return std::max(
-          m_association_cfg.get_max_distance_squared(),
-          get_shortest_edge_size_squared());
-      } else {
-        return m_association_cfg.get_max_distance_squared();
-      }
-    };
-
   if (common::geometry::squared_distance_2d(
       detection.kinematics.centroid_position,
-      track_centroid) > compute_distance_threshold())
+      track_centroid) > get_distance_threshold_squared(detection))
   {
     return false;
   }
@@ -187,15 +314,15 @@ void DetectedObjectAssociator::set_weight(
   const float32_t weight,
   const size_t det_idx, const size_t track_idx)
 {
-  if (m_are_tracks_rows) {
-    m_assigner.set_weight(
-      weight, static_cast<assigner_idx_t>(track_idx),
-      static_cast<assigner_idx_t>(det_idx));
-  } else {
-    m_assigner.set_weight(
-      weight, static_cast<assigner_idx_t>(det_idx),
-      static_cast<assigner_idx_t>(track_idx));
-  }
+  const auto row = static_cast<assigner_idx_t>(m_are_tracks_rows ? track_idx : det_idx);
+  const auto col = static_cast<assigner_idx_t>(m_are_tracks_rows ? det_idx : track_idx);
+  m_edges.push_back(Edge{row, col, weight});
+}
+
+assigner_idx_t DetectedObjectAssociator::get_assignment(const assigner_idx_t idx) const
+{
+  return m_association_cfg.use_sparse_assigner() ?
+         m_sparse_assigner.get_assignment(idx) : m_assigner.get_assignment(idx);
 }
 
 AssociatorResult DetectedObjectAssociator::extract_result() const
@@ -210,7 +337,7 @@ AssociatorResult DetectedObjectAssociator::extract_result() const
     std::vector<common::types::bool8_t> detections_assigned(m_num_detections, false);
     for (size_t track_idx = 0U; track_idx < m_num_tracks; track_idx++) {
       const auto det_idx =
-        static_cast<size_t>(m_assigner.get_assignment(static_cast<assigner_idx_t>(track_idx)));
+        static_cast<size_t>(get_assignment(static_cast<assigner_idx_t>(track_idx)));
       if (det_idx != Assigner::UNASSIGNED) {
         ret.track_assignments[track_idx] = det_idx;
         detections_assigned[det_idx] = true;
@@ -228,7 +355,7 @@ AssociatorResult DetectedObjectAssociator::extract_result() const
     std::vector<common::types::bool8_t> tracks_assigned(m_num_tracks, false);
     for (size_t det_idx = 0U; det_idx < m_num_detections; det_idx++) {
       const auto track_idx =
-        static_cast<size_t>(m_assigner.get_assignment(static_cast<assigner_idx_t>(det_idx)));
+        static_cast<size_t>(get_assignment(static_cast<assigner_idx_t>(det_idx)));
       if (track_idx != Assigner::UNASSIGNED) {
         ret.track_assignments[track_idx] = det_idx;
         tracks_assigned[track_idx] = true;
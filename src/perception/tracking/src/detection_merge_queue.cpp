@@ -0,0 +1,82 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <tracking/detection_merge_queue.hpp>
+
+#include <time_utils/time_utils.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace autoware
+{
+namespace perception
+{
+namespace tracking
+{
+
+DetectionMergeQueue::DetectionMergeQueue(
+  const std::size_t num_sources,
+  const std::chrono::nanoseconds max_latency)
+: m_source_stamps(num_sources, std::chrono::nanoseconds::min()),
+  m_max_latency{max_latency}
+{
+  if (num_sources == 0U) {
+    throw std::domain_error("The merge queue needs at least one source");
+  }
+  if (max_latency < std::chrono::nanoseconds::zero()) {
+    throw std::domain_error("The max latency of the merge queue must not be negative");
+  }
+}
+
+bool DetectionMergeQueue::push(
+  const std::size_t source,
+  const DetectedObjects::ConstSharedPtr & msg)
+{
+  const auto stamp = time_utils::from_message(msg->header.stamp).time_since_epoch();
+  auto & source_stamp = m_source_stamps.at(source);
+  source_stamp = std::max(source_stamp, stamp);
+  m_newest_stamp = std::max(m_newest_stamp, stamp);
+  if (stamp < m_released_stamp) {
+    ++m_num_dropped;
+    return false;
+  }
+  // After the messages with the same stamp, to keep the order of arrival for them
+  const auto position = std::upper_bound(
+    m_queue.begin(), m_queue.end(), stamp,
+    [](const std::chrono::nanoseconds value, const Entry & entry) {return value < entry.stamp;});
+  m_queue.insert(position, Entry{stamp, msg});
+  return true;
+}
+
+DetectionMergeQueue::DetectedObjects::ConstSharedPtr DetectionMergeQueue::pop()
+{
+  if (m_queue.empty()) {
+    return nullptr;
+  }
+  const auto stamp = m_queue.front().stamp;
+  const auto all_sources_passed =
+    *std::min_element(m_source_stamps.begin(), m_source_stamps.end()) >= stamp;
+  if (!all_sources_passed && ((m_newest_stamp - stamp) < m_max_latency)) {
+    return nullptr;
+  }
+  auto msg = m_queue.front().msg;
+  m_queue.erase(m_queue.begin());
+  m_released_stamp = stamp;
+  return msg;
+}
+
+}  // namespace tracking
+}  // namespace perception
+}  // namespace autoware
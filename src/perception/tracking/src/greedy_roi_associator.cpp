@@ -20,9 +20,15 @@
 #include <tracking/detected_object_associator.hpp>
 #include <tracking/greedy_roi_associator.hpp>
 
+#include <helper_functions/float_comparisons.hpp>
+
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 #include <unordered_set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace autoware
@@ -81,55 +87,69 @@ AssociatorResult GreedyRoiAssociator::assign(
   const autoware_auto_msgs::msg::ClassifiedRoiArray & rois,
   const TrackedObjects & tracks) const
 {
-  AssociatorResult result = create_and_init_result(rois.rois.size(), tracks.objects.size());
-  geometry_msgs::msg::TransformStamped tf_roi_from_track;
-  try {
-    tf_roi_from_track = lookup_transform_handler(
-      rois.header.frame_id, tracks.frame_id, time_utils::from_message(rois.header.stamp));
-  } catch (const std::exception & e) {
-    std::cerr << "Transform lookup failed with exception: " << e.what() << std::endl;
-    return result;
+  std::vector<std::size_t> vertex_begin{0U};
+  for (const auto & track : tracks.objects) {
+    vertex_begin.push_back(vertex_begin.back() + 2U * track.shape().polygon.points.size());
   }
-  const details::ShapeTransformer transformer{tf_roi_from_track.transform};
+  Vertices vertices{3, static_cast<Eigen::Index>(vertex_begin.back())};
   for (auto track_idx = 0U; track_idx < tracks.objects.size(); ++track_idx) {
-    const auto matched_detection_idx = project_and_match_detection(
-      transformer(
-        tracks.objects[track_idx].shape(),
-        geometry_msgs::msg::Point{}.set__x(
-          tracks.objects[track_idx].centroid().x()).set__y(
-          tracks.objects[track_idx].centroid().y()),
-        tracks.objects[track_idx].orientation()), result
-      .unassigned_detection_indices, rois);
-
-    handle_matching_output(matched_detection_idx, track_idx, result);
+    const auto & track = tracks.objects[track_idx];
+    set_shape_vertices(
+      track.shape(),
+      geometry_msgs::msg::Point{}.set__x(track.centroid().x()).set__y(track.centroid().y()),
+      track.orientation(), vertex_begin[track_idx], vertices);
   }
-
-  return result;
+  return project_and_match(rois, tracks.frame_id, vertices, vertex_begin);
 }
 
 AssociatorResult GreedyRoiAssociator::assign(
   const autoware_auto_msgs::msg::ClassifiedRoiArray & rois,
   const autoware_auto_msgs::msg::DetectedObjects & objects) const
 {
-  AssociatorResult result = create_and_init_result(rois.rois.size(), objects.objects.size());
-  geometry_msgs::msg::TransformStamped tf_roi_from_detection;
+  std::vector<std::size_t> vertex_begin{0U};
+  for (const auto & object : objects.objects) {
+    vertex_begin.push_back(vertex_begin.back() + 2U * object.shape.polygon.points.size());
+  }
+  Vertices vertices{3, static_cast<Eigen::Index>(vertex_begin.back())};
+  for (auto object_idx = 0U; object_idx < objects.objects.size(); ++object_idx) {
+    const auto & object = objects.objects[object_idx];
+    set_shape_vertices(
+      object.shape, object.kinematics.centroid_position, object.kinematics.orientation,
+      vertex_begin[object_idx], vertices);
+  }
+  return project_and_match(rois, objects.header.frame_id, vertices, vertex_begin);
+}
+
+AssociatorResult GreedyRoiAssociator::project_and_match(
+  const autoware_auto_msgs::msg::ClassifiedRoiArray & rois,
+  const std::string & source_frame,
+  const Vertices & vertices,
+  const std::vector<std::size_t> & vertex_begin) const
+{
+  const auto num_objects = vertex_begin.size() - 1U;
+  AssociatorResult result = create_and_init_result(rois.rois.size(), num_objects);
+  geometry_msgs::msg::TransformStamped tf_roi_from_source;
   try {
-    tf_roi_from_detection = lookup_transform_handler(
-      rois.header.frame_id, objects.header.frame_id,
-      time_utils::from_message(rois.header.stamp));
+    tf_roi_from_source = lookup_transform_handler(
+      rois.header.frame_id, source_frame, time_utils::from_message(rois.header.stamp));
   } catch (const std::exception & e) {
     std::cerr << "Transform lookup failed with exception: " << e.what() << std::endl;
     return result;
   }
-  const details::ShapeTransformer transformer{tf_roi_from_detection.transform};
+  // Bring all vertices to the camera frame and onto the image plane with one multiplication
+  const auto projections =
+    m_camera.project_shapes(to_affine(tf_roi_from_source.transform), vertices, vertex_begin);
+  details::RoiGrid roi_grid{rois};
 
-  for (auto object_idx = 0U; object_idx < objects.objects.size(); ++object_idx) {
-    auto & object = objects.objects[object_idx];
-    auto detection_idx = project_and_match_detection(
-      transformer(object.shape, object.kinematics.centroid_position, object.kinematics.orientation),
-      result.unassigned_detection_indices, rois);
+  for (auto object_idx = 0U; object_idx < num_objects; ++object_idx) {
+    const auto & maybe_projection = projections[object_idx];
+    // There is no projection or the projection is collinear
+    const auto matched_detection_idx = maybe_projection ?
+      match_projection(
+      maybe_projection.value(), result.unassigned_detection_indices, rois, roi_grid) :
+      AssociatorResult::UNASSIGNED;
 
-    handle_matching_output(detection_idx, object_idx, result);
+    handle_matching_output(matched_detection_idx, object_idx, result);
   }
 
   return result;
@@ -154,28 +174,131 @@ geometry_msgs::msg::TransformStamped GreedyRoiAssociator::lookup_transform_handl
   return retval;
 }
 
-std::size_t GreedyRoiAssociator::project_and_match_detection(
-  const std::vector<geometry_msgs::msg::Point32> & object_shape_in_camera_frame,
+std::size_t GreedyRoiAssociator::match_projection(
+  const Projection & projection,
   const std::unordered_set<std::size_t> & available_roi_indices,
-  const autoware_auto_msgs::msg::ClassifiedRoiArray & rois) const
+  const autoware_auto_msgs::msg::ClassifiedRoiArray & rois,
+  details::RoiGrid & roi_grid) const
 {
-  const auto & maybe_projection = m_camera.project(object_shape_in_camera_frame);
-
-  // There is no projection or the projection is collinear
-  if (!maybe_projection) {
-    return AssociatorResult::UNASSIGNED;
+  auto min_x = std::numeric_limits<float32_t>::max();
+  auto min_y = std::numeric_limits<float32_t>::max();
+  auto max_x = std::numeric_limits<float32_t>::lowest();
+  auto max_y = std::numeric_limits<float32_t>::lowest();
+  for (const auto & pt : projection.shape) {
+    min_x = std::min(min_x, pt.x);
+    min_y = std::min(min_y, pt.y);
+    max_x = std::max(max_x, pt.x);
+    max_y = std::max(max_y, pt.y);
   }
 
+  // The ROIs that do not overlap the bounding box of the projection have an IoU of zero
   auto max_score = 0.0F;
   std::size_t max_score_idx = AssociatorResult::UNASSIGNED;
-  for (const auto idx : available_roi_indices) {
-    const auto score = m_iou_func(maybe_projection.value().shape, rois.rois[idx].polygon.points);
-    max_score = std::max(score, max_score);
-    max_score_idx = idx;
+  for (const auto idx : roi_grid.query(min_x, min_y, max_x, max_y)) {
+    if (available_roi_indices.find(idx) == available_roi_indices.end()) {
+      continue;
+    }
+    const auto score = m_iou_func(projection.shape, rois.rois[idx].polygon.points);
+    if (score > max_score) {
+      max_score = score;
+      max_score_idx = idx;
+    }
   }
   return max_score > m_iou_threshold ? max_score_idx : AssociatorResult::UNASSIGNED;
 }
 
+namespace details
+{
+constexpr std::size_t RoiGrid::kCellsPerAxis;
+
+RoiGrid::RoiGrid(const autoware_auto_msgs::msg::ClassifiedRoiArray & rois)
+: m_cells(kCellsPerAxis * kCellsPerAxis),
+  m_is_visited(rois.rois.size(), false)
+{
+  m_bounds = Box{std::numeric_limits<float32_t>::max(), std::numeric_limits<float32_t>::max(),
+    std::numeric_limits<float32_t>::lowest(), std::numeric_limits<float32_t>::lowest()};
+  m_boxes.reserve(rois.rois.size());
+  for (const auto & roi : rois.rois) {
+    Box box{std::numeric_limits<float32_t>::max(), std::numeric_limits<float32_t>::max(),
+      std::numeric_limits<float32_t>::lowest(), std::numeric_limits<float32_t>::lowest()};
+    for (const auto & pt : roi.polygon.points) {
+      box.min_x = std::min(box.min_x, pt.x);
+      box.min_y = std::min(box.min_y, pt.y);
+      box.max_x = std::max(box.max_x, pt.x);
+      box.max_y = std::max(box.max_y, pt.y);
+    }
+    m_boxes.push_back(box);
+    m_bounds.min_x = std::min(m_bounds.min_x, box.min_x);
+    m_bounds.min_y = std::min(m_bounds.min_y, box.min_y);
+    m_bounds.max_x = std::max(m_bounds.max_x, box.max_x);
+    m_bounds.max_y = std::max(m_bounds.max_y, box.max_y);
+  }
+  if (m_bounds.min_x > m_bounds.max_x) {
+    // No ROI has a point, so no ROI is binned
+    return;
+  }
+  const auto cells = static_cast<float32_t>(kCellsPerAxis);
+  m_cell_width = std::max((m_bounds.max_x - m_bounds.min_x) / cells, 1.0F);
+  m_cell_height = std::max((m_bounds.max_y - m_bounds.min_y) / cells, 1.0F);
+  for (std::size_t idx = 0U; idx < m_boxes.size(); ++idx) {
+    const auto & box = m_boxes[idx];
+    if (box.min_x > box.max_x) {
+      continue;
+    }
+    const auto x_range = cell_range(box.min_x, box.max_x, m_bounds.min_x, m_cell_width);
+    const auto y_range = cell_range(box.min_y, box.max_y, m_bounds.min_y, m_cell_height);
+    for (auto y = y_range.first; y <= y_range.second; ++y) {
+      for (auto x = x_range.first; x <= x_range.second; ++x) {
+        m_cells[y * kCellsPerAxis + x].push_back(idx);
+      }
+    }
+  }
+}
+
+const std::vector<std::size_t> & RoiGrid::query(
+  const float32_t min_x, const float32_t min_y, const float32_t max_x, const float32_t max_y)
+{
+  m_result.clear();
+  if ((min_x > m_bounds.max_x) || (max_x < m_bounds.min_x) ||
+    (min_y > m_bounds.max_y) || (max_y < m_bounds.min_y))
+  {
+    return m_result;
+  }
+  const auto x_range = cell_range(min_x, max_x, m_bounds.min_x, m_cell_width);
+  const auto y_range = cell_range(min_y, max_y, m_bounds.min_y, m_cell_height);
+  for (auto y = y_range.first; y <= y_range.second; ++y) {
+    for (auto x = x_range.first; x <= x_range.second; ++x) {
+      for (const auto idx : m_cells[y * kCellsPerAxis + x]) {
+        const auto & box = m_boxes[idx];
+        if (!m_is_visited[idx] && (box.min_x <= max_x) && (box.max_x >= min_x) &&
+          (box.min_y <= max_y) && (box.max_y >= min_y))
+        {
+          m_is_visited[idx] = true;
+          m_result.push_back(idx);
+        }
+      }
+    }
+  }
+  for (const auto idx : m_result) {
+    m_is_visited[idx] = false;
+  }
+  std::sort(m_result.begin(), m_result.end());
+  return m_result;
+}
+
+std::pair<std::size_t, std::size_t> RoiGrid::cell_range(
+  const float32_t min, const float32_t max, const float32_t grid_min,
+  const float32_t cell_size) const
+{
+  const auto to_cell = [grid_min, cell_size](const float32_t value) {
+      const auto cell = std::floor((value - grid_min) / cell_size);
+      return static_cast<std::size_t>(
+        std::min(std::max(cell, 0.0F), static_cast<float32_t>(kCellsPerAxis - 1U)));
+    };
+  return {to_cell(min), to_cell(max)};
+}
+}  // namespace details
+
 namespace details
 {
 ShapeTransformer::ShapeTransformer(const geometry_msgs::msg::Transform & tf)
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <cmath>
 #include <memory>
+#include <utility>
 
 using autoware::common::types::float64_t;
 
@@ -66,18 +67,6 @@ bool is_gravity_aligned(const geometry_msgs::msg::Quaternion & quat)
   }
   return true;
 }
-
-geometry_msgs::msg::TransformStamped to_transform(const nav_msgs::msg::Odometry & odometry)
-{
-  geometry_msgs::msg::TransformStamped tfs;
-  tfs.header = odometry.header;
-  tfs.child_frame_id = odometry.child_frame_id;
-  tfs.transform.translation.x = odometry.pose.pose.position.x;
-  tfs.transform.translation.y = odometry.pose.pose.position.y;
-  tfs.transform.translation.z = odometry.pose.pose.position.z;
-  tfs.transform.rotation = odometry.pose.pose.orientation;
-  return tfs;
-}
 }  // anonymous namespace
 
 
@@ -89,6 +78,10 @@ MultiObjectTracker::MultiObjectTracker(
   m_track_creator{options.track_creator_config, buffer}
 {
   m_tracks.frame_id = m_options.frame;
+  if (m_options.num_workers > 1U) {
+    m_track_workers =
+      std::make_unique<common::helper_functions::WorkerPool>(m_options.num_workers);
+  }
 }
 
 DetectedObjectsUpdateResult MultiObjectTracker::update(
@@ -100,11 +93,18 @@ DetectedObjectsUpdateResult MultiObjectTracker::update(
   if (result.status != TrackerUpdateStatus::Ok) {
     return result;
   }
+  auto stage_start = std::chrono::steady_clock::now();
+  const auto end_stage = [&stage_start](std::chrono::nanoseconds & timing) {
+      const auto now = std::chrono::steady_clock::now();
+      timing = now - stage_start;
+      stage_start = now;
+    };
 
   // ==================================
   // Transform detections
   // ==================================
   const auto detection_in_tracker_frame = this->transform(detections, detection_frame_odometry);
+  end_stage(result.timings.transform);
 
   // ==================================
   // Predict tracks forward
@@ -112,9 +112,14 @@ DetectedObjectsUpdateResult MultiObjectTracker::update(
   // TODO(nikolai.morin): Simplify after #1002
   const auto target_time = time_utils::from_message(detection_in_tracker_frame.header.stamp);
   const auto dt = target_time - m_last_update;
-  for (auto & object : m_tracks.objects) {
-    object.predict(dt);
-  }
+  // All tracks are created with the same noise, so they share the prediction matrices
+  const auto prediction = TrackedObject::make_prediction(
+    dt, m_options.track_creator_config.noise_variance);
+  for_each_track(
+    [this, &prediction](const std::size_t track_idx, const std::size_t) {
+      m_tracks.objects[track_idx].predict(prediction);
+    });
+  end_stage(result.timings.predict);
 
   // ==================================
   // Associate observations with tracks
@@ -124,21 +129,23 @@ DetectedObjectsUpdateResult MultiObjectTracker::update(
   if (association.had_errors) {
     result.status = TrackerUpdateStatus::InvalidShape;
   }
+  end_stage(result.timings.associate);
 
   // ==================================
   // Update tracks with observations
   // ==================================
-  for (size_t track_idx = 0; track_idx < m_tracks.objects.size(); ++track_idx) {
-    size_t detection_idx = association.track_assignments[track_idx];
-    if (detection_idx == AssociatorResult::UNASSIGNED) {
-      continue;
-    }
-    const auto & detection = detection_in_tracker_frame.objects[detection_idx];
-    m_tracks.objects[track_idx].update(detection);
-  }
-  for (const size_t track_idx : association.unassigned_track_indices) {
-    m_tracks.objects[track_idx].no_update();
-  }
+  // Tracks without an assigned detection are exactly the unassigned tracks
+  for_each_track(
+    [this, &association, &detection_in_tracker_frame](
+      const std::size_t track_idx, const std::size_t) {
+      const size_t detection_idx = association.track_assignments[track_idx];
+      if (detection_idx == AssociatorResult::UNASSIGNED) {
+        m_tracks.objects[track_idx].no_update();
+      } else {
+        m_tracks.objects[track_idx].update(detection_in_tracker_frame.objects[detection_idx]);
+      }
+    });
+  end_stage(result.timings.update);
 
   // ==================================
   // Initialize new tracks
@@ -153,17 +160,26 @@ DetectedObjectsUpdateResult MultiObjectTracker::update(
     result.unassigned_clusters = ret.detections_leftover;
     result.maybe_roi_stamps = ret.maybe_roi_stamps;
   }
+  end_stage(result.timings.create);
 
   // ==================================
   // Prune tracks
   // ==================================
-  const auto last = std::remove_if(
-    m_tracks.objects.begin(), m_tracks.objects.end(), [this](const auto & object) {
-      return object.should_be_removed(
-        this->m_options.pruning_time_threshold,
-        this->m_options.pruning_ticks_threshold);
-    });
-  m_tracks.objects.erase(last, m_tracks.objects.end());
+  // Swap each removed track with the last one, which only moves as many tracks as are removed.
+  // The order of the tracks is not meaningful, they are identified by their object id.
+  for (std::size_t track_idx = 0U; track_idx < m_tracks.objects.size(); ) {
+    if (m_tracks.objects[track_idx].should_be_removed(
+        m_options.pruning_time_threshold, m_options.pruning_ticks_threshold))
+    {
+      if (track_idx + 1U < m_tracks.objects.size()) {
+        m_tracks.objects[track_idx] = std::move(m_tracks.objects.back());
+      }
+      m_tracks.objects.pop_back();
+    } else {
+      ++track_idx;
+    }
+  }
+  end_stage(result.timings.prune);
   // ==================================
   // Build result
   // ==================================
@@ -182,9 +198,11 @@ void MultiObjectTracker::update(const ClassifiedRoiArrayMsg & rois)
     return;
   }
   const auto dt = target_time - m_last_update;
+  const auto prediction = TrackedObject::make_prediction(
+    dt, m_options.track_creator_config.noise_variance);
   auto tracks_copy = m_tracks;
   for (auto & object : tracks_copy.objects) {
-    object.predict(dt);
+    object.predict(prediction);
   }
   const auto association = m_vision_associator.assign(rois, tracks_copy);
   // Update the original tracks' classification.
@@ -233,11 +251,12 @@ MultiObjectTracker::DetectedObjectsMsg MultiObjectTracker::transform(
   Eigen::Isometry3d tf__tracking__detection = Eigen::Isometry3d::Identity();
   tf2::fromMsg(detection_frame_odometry.pose.pose, tf__tracking__detection);
   const Eigen::Matrix3d rot_d = tf__tracking__detection.linear();
-  // Convert the odometry to TransformStamped for use with tf2::doTransform.
-  const geometry_msgs::msg::TransformStamped tf_msg__tracking__detection = to_transform(
-    detection_frame_odometry);
+  // The rotation is converted once instead of once per detection
+  Eigen::Quaterniond rot_q = Eigen::Quaterniond::Identity();
+  tf2::fromMsg(detection_frame_odometry.pose.pose.orientation, rot_q);
   // Hoisted outside the loop
   Eigen::Vector3d centroid_detection = Eigen::Vector3d::Zero();
+  Eigen::Quaterniond orientation_detection = Eigen::Quaterniond::Identity();
 
   DetectedObjectsMsg result;
   result.header = detections.header;
@@ -251,14 +270,8 @@ MultiObjectTracker::DetectedObjectsMsg MultiObjectTracker::transform(
     const Eigen::Vector3d centroid_tracking = tf__tracking__detection * centroid_detection;
     detection.kinematics.centroid_position = tf2::toMsg(centroid_tracking);
     if (detection.kinematics.orientation_availability != DetectedObjectKinematics::UNAVAILABLE) {
-      geometry_msgs::msg::QuaternionStamped q_out;
-      // Use quaternion stamped because there is no doTransform for quaternion even though
-      // stamp of QuaternionStamped is not being used for anything
-      tf2::doTransform(
-        geometry_msgs::msg::QuaternionStamped{}.set__quaternion(detection.kinematics.orientation),
-        q_out,
-        tf_msg__tracking__detection);
-      detection.kinematics.orientation = q_out.quaternion;
+      tf2::fromMsg(detection.kinematics.orientation, orientation_detection);
+      detection.kinematics.orientation = tf2::toMsg(rot_q * orientation_detection);
     }
     if (detection.kinematics.has_position_covariance) {
       // Doing this properly is difficult. We'll ignore the rotational part. This is a practical
@@ -286,16 +299,28 @@ MultiObjectTracker::DetectedObjectsMsg MultiObjectTracker::transform(
   return result;
 }
 
+void MultiObjectTracker::for_each_track(const common::helper_functions::WorkerPool::Work & work)
+{
+  if (m_track_workers) {
+    m_track_workers->run(m_tracks.objects.size(), work);
+  } else {
+    for (std::size_t track_idx = 0U; track_idx < m_tracks.objects.size(); ++track_idx) {
+      work(track_idx, 0U);
+    }
+  }
+}
+
 MultiObjectTracker::TrackedObjectsMsg MultiObjectTracker::convert_to_msg(
-  const builtin_interfaces::msg::Time & stamp) const
+  const builtin_interfaces::msg::Time & stamp)
 {
+  // The messages are only filled in here, from the tracks in place
   TrackedObjectsMsg array;
   array.header.stamp = stamp;
   array.header.frame_id = m_tracks.frame_id;
   array.objects.reserve(m_tracks.objects.size());
-  std::transform(
-    m_tracks.objects.begin(), m_tracks.objects.end(), std::back_inserter(array.objects), [](
-      TrackedObject o) {return o.msg();});
+  for (auto & object : m_tracks.objects) {
+    array.objects.push_back(object.msg());
+  }
   return array;
 }
 
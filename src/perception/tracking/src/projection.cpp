@@ -15,9 +15,13 @@
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
 #include <tracking/projection.hpp>
+#include <geometry/bounding_box/bounding_box_common.hpp>
 #include <geometry/intersection.hpp>
 #include <geometry/common_2d.hpp>
+#include <helper_functions/float_comparisons.hpp>
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
 namespace autoware
@@ -56,36 +60,37 @@ CameraModel::CameraModel(
     0.0, 0.0, 1.0;
 }
 
-std::experimental::optional<CameraModel::EigPoint>
-CameraModel::project_point(const EigPoint & pt_3d) const
+std::experimental::optional<Projection> CameraModel::project(
+  const std::vector<Point> & points) const
 {
-  // `m_intrinsics * p_3d = p_2d * depth`
-  const auto pt_2d = m_intrinsics * pt_3d;
-  const auto depth = pt_2d.z();
-  // Only accept points are in front of the camera lens
-  if (depth > 0.0F) {
-    return pt_2d / depth;
+  EigPoints points_3d{3, static_cast<Eigen::Index>(points.size())};
+  for (std::size_t i = 0U; i < points.size(); ++i) {
+    points_3d.col(static_cast<Eigen::Index>(i)) << points[i].x, points[i].y, points[i].z;
   }
-  return std::experimental::nullopt;
+  // `m_intrinsics * p_3d = p_2d * depth`
+  return outline(m_intrinsics * points_3d);
 }
 
-std::experimental::optional<Projection> CameraModel::project(
-  const std::vector<Point> & points) const
+CameraModel::Projector CameraModel::projector(const Eigen::Affine3f & camera_from_frame) const
+{
+  return m_intrinsics * camera_from_frame.matrix().topRows<3>();
+}
+
+std::experimental::optional<Projection> CameraModel::outline(
+  const Eigen::Ref<const EigPoints> & points_2d) const
 {
   Projection result;
   auto & points2d = result.shape;
 
-  const auto project_and_append = [&points2d, this](auto x, auto y, auto z) {
-      const auto projected_pt = project_point(Eigen::Vector3f{x, y, z});
-      if (projected_pt) {
-        points2d.emplace_back(
-          Point{}.set__x(projected_pt->x()).
-          set__y(projected_pt->y()).set__z(projected_pt->z()));
-      }
-    };
-
-  for (const auto & pt : points) {
-    project_and_append(pt.x, pt.y, pt.z);
+  for (Eigen::Index i = 0; i < points_2d.cols(); ++i) {
+    const auto depth = points_2d(2, i);
+    // Only accept points are in front of the camera lens
+    if (depth > 0.0F) {
+      const EigPoint projected_pt = points_2d.col(i) / depth;
+      points2d.emplace_back(
+        Point{}.set__x(projected_pt.x()).
+        set__y(projected_pt.y()).set__z(projected_pt.z()));
+    }
   }
 
   // Outline the shape of the projected points in the image
@@ -99,6 +104,85 @@ std::experimental::optional<Projection> CameraModel::project(
          std::experimental::nullopt;
 }
 
+std::vector<std::experimental::optional<Projection>> CameraModel::project_shapes(
+  const Eigen::Affine3f & camera_from_frame, const EigPoints & vertices,
+  const std::vector<std::size_t> & vertex_begin) const
+{
+  std::vector<std::experimental::optional<Projection>> result{};
+  if (vertex_begin.empty()) {
+    return result;
+  }
+  const auto num_shapes = vertex_begin.size() - 1U;
+  result.resize(num_shapes);
+  // `K * [R | t] * p_3d = p_2d * depth` for the vertices of all shapes at once
+  const EigPoints points_2d = projector(camera_from_frame) * vertices.colwise().homogeneous();
+
+  for (std::size_t shape_idx = 0U; shape_idx < num_shapes; ++shape_idx) {
+    const auto begin = static_cast<Eigen::Index>(vertex_begin[shape_idx]);
+    const auto end = static_cast<Eigen::Index>(vertex_begin[shape_idx + 1U]);
+    // Bounds of the vertices in front of the camera, which are the only ones outline() keeps
+    auto min_x = std::numeric_limits<float32_t>::max();
+    auto min_y = std::numeric_limits<float32_t>::max();
+    auto max_x = std::numeric_limits<float32_t>::lowest();
+    auto max_y = std::numeric_limits<float32_t>::lowest();
+    for (Eigen::Index i = begin; i < end; ++i) {
+      const auto depth = points_2d(2, i);
+      if (depth > 0.0F) {
+        const auto x = points_2d(0, i) / depth;
+        const auto y = points_2d(1, i) / depth;
+        min_x = std::min(min_x, x);
+        min_y = std::min(min_y, y);
+        max_x = std::max(max_x, x);
+        max_y = std::max(max_y, y);
+      }
+    }
+    // A shape which is behind the camera or beside the image has no outline on the image
+    if ((max_x < Interval::min(m_width_interval)) || (min_x > Interval::max(m_width_interval)) ||
+      (max_y < Interval::min(m_height_interval)) || (min_y > Interval::max(m_height_interval)))
+    {
+      continue;
+    }
+    result[shape_idx] = outline(points_2d.middleCols(begin, end - begin));
+  }
+  return result;
+}
+
+void set_shape_vertices(
+  const autoware_auto_msgs::msg::Shape & shape, const geometry_msgs::msg::Point & centroid,
+  const geometry_msgs::msg::Quaternion & orientation, const std::size_t first_vertex,
+  CameraModel::EigPoints & vertices)
+{
+  const auto corners = common::geometry::bounding_box::details::get_transformed_corners(
+    shape, centroid, orientation);
+  auto column = static_cast<Eigen::Index>(first_vertex);
+  for (const auto & pt : corners) {
+    // The vertices on the bottom face and on the top face
+    vertices.col(column++) << pt.x, pt.y, pt.z;
+    vertices.col(column++) << pt.x, pt.y, pt.z + shape.height;
+  }
+}
+
+Eigen::Affine3f to_affine(const geometry_msgs::msg::Transform & tf)
+{
+  const Eigen::Quaternionf rotation{
+    static_cast<float32_t>(tf.rotation.w),
+    static_cast<float32_t>(tf.rotation.x),
+    static_cast<float32_t>(tf.rotation.y),
+    static_cast<float32_t>(tf.rotation.z)};
+  if (!common::helper_functions::comparisons::rel_eq(
+      rotation.norm(), 1.0F, std::numeric_limits<float32_t>::epsilon()))
+  {
+    throw std::domain_error("to_affine: quaternion is not normalized");
+  }
+  Eigen::Affine3f affine = Eigen::Affine3f::Identity();
+  affine.linear() = rotation.toRotationMatrix();
+  affine.translation() = Eigen::Vector3f{
+    static_cast<float32_t>(tf.translation.x),
+    static_cast<float32_t>(tf.translation.y),
+    static_cast<float32_t>(tf.translation.z)};
+  return affine;
+}
+
 }  // namespace tracking
 }  // namespace perception
 }  // namespace autoware
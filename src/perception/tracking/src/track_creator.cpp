@@ -18,9 +18,8 @@
 #include <time_utils/time_utils.hpp>
 #include <tracking/track_creator.hpp>
 
-#include <functional>
 #include <memory>
-#include <set>
+#include <utility>
 #include <vector>
 
 namespace autoware
@@ -32,8 +31,10 @@ namespace tracking
 CreationPolicyBase::CreationPolicyBase(
   const float64_t default_variance,
   const float64_t noise_variance,
-  const tf2::BufferCore & tf_buffer)
-: m_default_variance{default_variance}, m_noise_variance{noise_variance}, m_tf_buffer{tf_buffer} {}
+  const tf2::BufferCore & tf_buffer,
+  const TrackedObjectUpdatePolicy & update_policy)
+: m_default_variance{default_variance}, m_noise_variance{noise_variance},
+  m_update_policy{update_policy}, m_tf_buffer{tf_buffer} {}
 
 autoware_auto_msgs::msg::DetectedObjects CreationPolicyBase::populate_unassigned_lidar_detections(
   const autoware_auto_msgs::msg::DetectedObjects & clusters,
@@ -49,8 +50,8 @@ autoware_auto_msgs::msg::DetectedObjects CreationPolicyBase::populate_unassigned
 
 LidarOnlyPolicy::LidarOnlyPolicy(
   const float64_t default_variance, const float64_t noise_variance,
-  const tf2::BufferCore & tf_buffer)
-: CreationPolicyBase(default_variance, noise_variance, tf_buffer) {}
+  const tf2::BufferCore & tf_buffer, const TrackedObjectUpdatePolicy & update_policy)
+: CreationPolicyBase(default_variance, noise_variance, tf_buffer, update_policy) {}
 
 void LidarOnlyPolicy::add_objects(
   const autoware_auto_msgs::msg::DetectedObjects & clusters,
@@ -62,9 +63,9 @@ void LidarOnlyPolicy::add_objects(
 TrackCreationResult LidarOnlyPolicy::create()
 {
   TrackCreationResult retval;
+  retval.tracks.reserve(m_lidar_clusters.objects.size());
   for (const auto & cluster : m_lidar_clusters.objects) {
-    retval.tracks.emplace_back(
-      TrackedObject(cluster, m_default_variance, m_noise_variance));
+    retval.tracks.emplace_back(cluster, m_default_variance, m_noise_variance, m_update_policy);
   }
   return retval;
 }
@@ -73,8 +74,9 @@ constexpr uint32_t LidarClusterIfVisionPolicy::kVisionCacheSize;
 
 LidarClusterIfVisionPolicy::LidarClusterIfVisionPolicy(
   const VisionPolicyConfig & cfg, const float64_t default_variance,
-  const float64_t noise_variance, const tf2::BufferCore & tf_buffer)
-: CreationPolicyBase{default_variance, noise_variance, tf_buffer},
+  const float64_t noise_variance, const tf2::BufferCore & tf_buffer,
+  const TrackedObjectUpdatePolicy & update_policy)
+: CreationPolicyBase{default_variance, noise_variance, tf_buffer, update_policy},
   m_cfg{cfg},
   m_associator{cfg.associator_cfg, tf_buffer}
 {
@@ -133,33 +135,34 @@ void LidarClusterIfVisionPolicy::create_using_cache(
   }
   creator_ret.maybe_roi_stamps->push_back(vision_msg.header.stamp);
 
-  std::set<size_t, std::greater<>> lidar_idx_to_erase;
-
-  for (size_t cluster_idx = 0U; cluster_idx < m_lidar_clusters.objects.size();
-    cluster_idx++)
-  {
-    if (association_result.track_assignments[cluster_idx] != AssociatorResult::UNASSIGNED) {
-      lidar_idx_to_erase.insert(cluster_idx);
+  // Create the tracks of the clusters associated to a vision roi and move the other clusters to
+  // the front in one pass, keeping their order, instead of erasing the associated ones one by one
+  auto & clusters = m_lidar_clusters.objects;
+  std::size_t num_leftover = 0U;
+  for (std::size_t cluster_idx = 0U; cluster_idx < clusters.size(); ++cluster_idx) {
+    const auto roi_idx = association_result.track_assignments[cluster_idx];
+    if (roi_idx == AssociatorResult::UNASSIGNED) {
+      if (num_leftover != cluster_idx) {
+        clusters[num_leftover] = std::move(clusters[cluster_idx]);
+      }
+      ++num_leftover;
+    } else {
       // TrackedObject constructor uses the classification field in the DetectedObject to
       // initialize track class. So assign the class from the associated ROI to the cluster.
-      m_lidar_clusters.objects[cluster_idx].classification = vision_msg.rois[association_result
-          .track_assignments[cluster_idx]].classifications;
+      auto & cluster = clusters[cluster_idx];
+      cluster.classification = vision_msg.rois[roi_idx].classifications;
       creator_ret.tracks.emplace_back(
-        TrackedObject(
-          m_lidar_clusters.objects[cluster_idx],
-          m_default_variance, m_noise_variance));
+        cluster, m_default_variance, m_noise_variance, m_update_policy);
     }
   }
-
-  // Erase lidar clusters that are associated to a vision roi
-  for (const auto idx : lidar_idx_to_erase) {
-    m_lidar_clusters.objects.erase(m_lidar_clusters.objects.begin() + static_cast<int32_t>(idx));
-  }
+  clusters.erase(clusters.begin() + static_cast<std::ptrdiff_t>(num_leftover), clusters.end());
 }
 
 TrackCreationResult LidarClusterIfVisionPolicy::create()
 {
   TrackCreationResult retval;
+  // Every cluster creates at most one track, so the tracks are not reallocated
+  retval.tracks.reserve(m_lidar_clusters.objects.size());
   for (const auto & frame_cache : m_vision_cache_map) {
     create_using_cache(frame_cache.second, retval);
   }
@@ -173,7 +176,7 @@ TrackCreator::TrackCreator(const TrackCreatorConfig & config, const tf2::BufferC
     case TrackCreationPolicy::LidarClusterOnly:
       m_policy_object = std::make_unique<LidarOnlyPolicy>(
         config.default_variance,
-        config.noise_variance, tf_buffer);
+        config.noise_variance, tf_buffer, config.update_policy);
       break;
     case TrackCreationPolicy::LidarClusterIfVision:
       if (config.vision_policy_config == std::experimental::nullopt) {
@@ -184,7 +187,7 @@ TrackCreator::TrackCreator(const TrackCreatorConfig & config, const tf2::BufferC
       m_policy_object = std::make_unique<LidarClusterIfVisionPolicy>(
         config.vision_policy_config.value(),
         config.default_variance,
-        config.noise_variance, tf_buffer);
+        config.noise_variance, tf_buffer, config.update_policy);
       break;
     default:
       throw std::runtime_error("Track creation policy does not exist / not implemented");
@@ -18,6 +18,7 @@
 
 #include <measurement_conversion/measurement_conversion.hpp>
 #include <measurement_conversion/measurement_typedefs.hpp>
+#include <geometry/intersection.hpp>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 
 #include <Eigen/Core>
@@ -111,11 +112,16 @@ EKF init_ekf(
 /// \relates autoware::perception::tracking::TrackedObject
 TrackedObject::TrackedObject(
   const DetectedObjectMsg & detection, float64_t default_variance,
-  float64_t noise_variance)
+  float64_t noise_variance, const TrackedObjectUpdatePolicy & update_policy)
 : m_msg{},
   m_ekf{init_ekf(detection, default_variance, noise_variance)},
-  m_default_variance{default_variance}
+  m_default_variance{default_variance},
+  m_noise_variance{noise_variance},
+  m_update_policy{update_policy}
 {
+  if (update_policy.classification_update_period == 0U) {
+    throw std::domain_error("The classification update period must be at least 1");
+  }
   static uint64_t object_id = 0;
   m_msg.object_id = ++object_id;
   m_msg.existence_probability = detection.existence_probability;
@@ -136,13 +142,42 @@ void TrackedObject::predict(std::chrono::nanoseconds dt)
   m_time_since_last_seen += dt;
 }
 
+TrackedObject::Prediction TrackedObject::make_prediction(
+  std::chrono::nanoseconds dt, float64_t noise_variance)
+{
+  return Prediction{dt, noise_variance, MotionModel{}.jacobian(CA{}, dt),
+    NoiseModel{{noise_variance, noise_variance}}.covariance(dt)};
+}
+
+void TrackedObject::predict(const Prediction & prediction)
+{
+  if (prediction.noise_variance != m_noise_variance) {
+    predict(prediction.dt);
+    return;
+  }
+  // The same as KalmanFilter::predict, without computing the matrices for every track
+  auto & state = m_ekf.state().vector();
+  auto & covariance = m_ekf.covariance();
+  state = prediction.transition * state;
+  covariance = prediction.transition * covariance * prediction.transition.transpose() +
+    prediction.noise_covariance;
+  m_time_since_last_seen += prediction.dt;
+}
+
 void TrackedObject::update(const DetectedObjectMsg & detection)
 {
   m_time_since_last_seen = std::chrono::nanoseconds::zero();
   m_ticks_alive++;
   m_ticks_since_last_seen = 0;
-  // Update the shape
-  m_msg.shape = {detection.shape};
+  // Update the shape, in place to reuse the memory of its polygon
+  if ((m_update_policy.shape_iou_threshold >= 1.0F) ||
+    (common::geometry::convex_intersection_over_union_2d(
+      m_msg.shape.front().polygon.points, detection.shape.polygon.points) <
+    m_update_policy.shape_iou_threshold))
+  {
+    m_msg.shape.resize(1U);
+    m_msg.shape.front() = detection.shape;
+  }
   m_msg.kinematics.orientation = detection.kinematics.orientation;
 
   // It needs to be determined which parts of the DetectedObject message are set, and can be used
@@ -165,7 +200,15 @@ void TrackedObject::update(
   const ObjectClassifications & classification,
   const common::types::float32_t covariance)
 {
-  m_classifier.update(classification, covariance);
+  // Period and divergence are checked in this order, so that the default policy never computes
+  // the divergence
+  ++m_classification_updates_skipped;
+  if ((m_classification_updates_skipped >= m_update_policy.classification_update_period) ||
+    (m_classifier.max_difference(classification) > m_update_policy.classification_divergence))
+  {
+    m_classifier.update(classification, covariance);
+    m_classification_updates_skipped = 0U;
+  }
 }
 
 void TrackedObject::no_update()
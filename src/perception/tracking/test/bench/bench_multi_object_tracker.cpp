@@ -0,0 +1,290 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Replays synthetic traffic through MultiObjectTracker. Besides the time per replay, each
+// benchmark reports the p50/p99/max latency of a frame in microseconds and the heap allocations
+// per frame as counters, e.g. for diffing releases:
+//   bench_multi_object_tracker --benchmark_out=tracker.json --benchmark_out_format=json
+// The traffic is generated with the tracking_test_framework once and cached in a file, see
+// load_traffic.
+#include <autoware_testing/allocation_counter.hpp>
+#include <autoware_testing/latency_recorder.hpp>
+#include <benchmark/benchmark.h>
+#include <time_utils/time_utils.hpp>
+#include <tracking/multi_object_tracker.hpp>
+#include <tracking/projection.hpp>
+#include <tracking_test_framework/frame_cache.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
+using autoware::perception::tracking::CameraIntrinsics;
+using autoware::perception::tracking::CameraModel;
+using autoware::perception::tracking::MultiObjectTracker;
+using autoware::perception::tracking::MultiObjectTrackerOptions;
+using autoware::perception::tracking::TrackCreationPolicy;
+using autoware::perception::tracking::TrackerUpdateStatus;
+using autoware::perception::tracking::VisionPolicyConfig;
+using autoware::tools::autoware_testing::AllocationCounter;
+using autoware::tools::autoware_testing::LatencyRecorder;
+using autoware_auto_msgs::msg::ClassifiedRoi;
+using autoware_auto_msgs::msg::ClassifiedRoiArray;
+using autoware_auto_msgs::msg::DetectedObject;
+using autoware_auto_msgs::msg::DetectedObjects;
+using autoware_auto_msgs::msg::ObjectClassification;
+namespace ttf = autoware::tracking_test_framework;
+
+constexpr std::size_t kNumFrames = 50U;
+constexpr std::chrono::milliseconds kFramePeriod{100};
+constexpr float32_t kObjectHeight = 1.5F;
+constexpr auto kCameraFrame = "camera";
+const CameraIntrinsics kIntrinsics{1920U, 1080U, 1000.0F, 1000.0F, 960.0F, 540.0F, 0.0F};
+
+struct Frame
+{
+  DetectedObjects detections;
+  nav_msgs::msg::Odometry odometry;
+  ClassifiedRoiArray rois;
+};
+
+// The camera is 1.5 m above the tracking frame and looks along its x axis
+Eigen::Affine3f camera_from_map()
+{
+  Eigen::Matrix3f rotation;
+  rotation << 0.0F, -1.0F, 0.0F, 0.0F, 0.0F, -1.0F, 1.0F, 0.0F, 0.0F;
+  Eigen::Affine3f transform{rotation};
+  transform.pretranslate(Eigen::Vector3f{0.0F, kObjectHeight, 0.0F});
+  return transform;
+}
+
+DetectedObject make_detection(const ttf::ObjectState & object)
+{
+  const bool is_car = object.obj_type == ttf::ObjectType::Car;
+  const Eigen::Vector2f size = is_car ? Eigen::Vector2f{4.5F, 1.8F} : Eigen::Vector2f{0.6F, 0.6F};
+  DetectedObject detection;
+  const float32_t c = std::cos(object.orientation);
+  const float32_t s = std::sin(object.orientation);
+  for (const auto & corner : {Eigen::Vector2f{1.0F, 1.0F}, Eigen::Vector2f{-1.0F, 1.0F},
+      Eigen::Vector2f{-1.0F, -1.0F}, Eigen::Vector2f{1.0F, -1.0F}})
+  {
+    const Eigen::Vector2f offset = 0.5F * size.cwiseProduct(corner);
+    detection.shape.polygon.points.push_back(
+      geometry_msgs::msg::Point32{}
+      .set__x(object.position.x() + (c * offset.x()) - (s * offset.y()))
+      .set__y(object.position.y() + (s * offset.x()) + (c * offset.y())));
+  }
+  detection.shape.height = kObjectHeight;
+  detection.kinematics.centroid_position.x = static_cast<float64_t>(object.position.x());
+  detection.kinematics.centroid_position.y = static_cast<float64_t>(object.position.y());
+  detection.existence_probability = 1.0F;
+  const uint8_t classification =
+    is_car ? ObjectClassification::CAR : ObjectClassification::PEDESTRIAN;
+  detection.classification.push_back(
+    ObjectClassification{}.set__classification(classification).set__probability(1.0F));
+  return detection;
+}
+
+// The ROI of a detection is the outline of its prism in the camera
+void add_roi(
+  const DetectedObject & detection, const CameraModel & camera, ClassifiedRoiArray & rois)
+{
+  const Eigen::Affine3f transform = camera_from_map();
+  std::vector<CameraModel::Point> vertices;
+  for (const auto height : {0.0F, kObjectHeight}) {
+    for (const auto & corner : detection.shape.polygon.points) {
+      const Eigen::Vector3f vertex = transform * Eigen::Vector3f{corner.x, corner.y, height};
+      vertices.push_back(
+        geometry_msgs::msg::Point32{}.set__x(vertex.x()).set__y(vertex.y()).set__z(vertex.z()));
+    }
+  }
+  const auto projection = camera.project(vertices);
+  if (projection) {
+    ClassifiedRoi roi;
+    for (const auto & point : projection->shape) {
+      roi.polygon.points.push_back(point);
+    }
+    roi.classifications = detection.classification;
+    rois.rois.push_back(roi);
+  }
+}
+
+// Traffic ahead of the vehicle: lanes of cars every 3.5 m with pedestrians on the sidewalks,
+// moving along the lanes at different speeds
+std::vector<ttf::SceneFrame> record_traffic(const std::size_t num_objects)
+{
+  std::vector<std::unique_ptr<ttf::TrackedObject>> objects;
+  constexpr std::size_t kNumLanes = 10U;
+  for (std::size_t idx = 0U; idx < num_objects; ++idx) {
+    const auto lane = static_cast<float32_t>(idx % kNumLanes);
+    const auto row = static_cast<float32_t>(idx / kNumLanes);
+    const Eigen::Vector2f position{10.0F + (12.0F * row), (3.5F * lane) - 15.75F};
+    if ((idx % 5U) == 4U) {
+      objects.push_back(
+        std::make_unique<ttf::Pedestrian>(
+          position + Eigen::Vector2f{6.0F, 0.0F}, 1.5F, 90.0F * lane, 0.0F));
+    } else {
+      objects.push_back(
+        std::make_unique<ttf::Car>(
+          position, 8.0F + lane, 0.0F, 0.0F, Eigen::Vector2f{4.5F, 1.8F}));
+    }
+  }
+  // The detections are made from the ground truth, so the LiDAR has no beams
+  ttf::Scene scene{ttf::Lidar{Eigen::Vector2f::Zero(), 0U, 0.0F}, std::move(objects)};
+  return ttf::record_frames(scene, kNumFrames, kFramePeriod, true);
+}
+
+// The traffic is recorded once per number of objects into $TRACKING_FRAME_CACHE_DIR, or /tmp,
+// and memory-mapped from there by later runs
+std::unique_ptr<ttf::FrameCache> load_traffic(const std::size_t num_objects)
+{
+  const char * cache_dir = std::getenv("TRACKING_FRAME_CACHE_DIR");
+  const std::string path = std::string{(cache_dir != nullptr) ? cache_dir : "/tmp"} +
+    "/bench_multi_object_tracker_" + std::to_string(num_objects) + ".ttfcache";
+  const auto key = ttf::FrameCacheKey{}.add("bench_multi_object_tracker traffic v1")
+    .add(static_cast<uint64_t>(num_objects)).add(static_cast<uint64_t>(kNumFrames))
+    .add(static_cast<uint64_t>(kFramePeriod.count())).value();
+  return ttf::FrameCache::load_or_record(
+    path, key, [num_objects]() {return record_traffic(num_objects);});
+}
+
+std::vector<Frame> create_frames(const std::size_t num_objects)
+{
+  const auto traffic = load_traffic(num_objects);
+  const CameraModel camera{kIntrinsics};
+  std::vector<Frame> frames(traffic->num_frames());
+  for (std::size_t frame_idx = 0U; frame_idx < frames.size(); ++frame_idx) {
+    auto & frame = frames[frame_idx];
+    const auto stamp = time_utils::to_message(
+      std::chrono::system_clock::time_point{std::chrono::seconds{1000}} +
+      (kFramePeriod * static_cast<int64_t>(frame_idx)));
+    frame.detections.header.stamp = stamp;
+    frame.detections.header.frame_id = "base_link";
+    frame.odometry.header.stamp = stamp;
+    frame.odometry.header.frame_id = "map";
+    frame.odometry.child_frame_id = "base_link";
+    frame.odometry.pose.pose.orientation.w = 1.0;
+    frame.rois.header.stamp = stamp;
+    frame.rois.header.frame_id = kCameraFrame;
+    const auto objects = traffic->frame(frame_idx);
+    for (std::size_t idx = 0U; idx < objects.num_objects(); ++idx) {
+      frame.detections.objects.push_back(make_detection(objects.object_state(idx)));
+      add_roi(frame.detections.objects.back(), camera, frame.rois);
+    }
+  }
+  return frames;
+}
+
+MultiObjectTrackerOptions create_options(const bool use_vision)
+{
+  MultiObjectTrackerOptions options{
+    {2.0F, 2.5F, true}, {kIntrinsics, 0.5F}, {TrackCreationPolicy::LidarClusterOnly, 1.0F, 1.0F}};
+  if (use_vision) {
+    options.track_creator_config.policy = TrackCreationPolicy::LidarClusterIfVision;
+    options.track_creator_config.vision_policy_config =
+      VisionPolicyConfig{options.vision_association_config, std::chrono::milliseconds{20}};
+  }
+  options.pruning_ticks_threshold = 5U;
+  return options;
+}
+
+void set_camera_transform(tf2::BufferCore & tf_buffer)
+{
+  const Eigen::Affine3f transform = camera_from_map();
+  const Eigen::Quaternionf rotation{transform.rotation()};
+  geometry_msgs::msg::TransformStamped tf;
+  tf.header.frame_id = kCameraFrame;
+  tf.child_frame_id = "map";
+  tf.transform.translation.x = static_cast<float64_t>(transform.translation().x());
+  tf.transform.translation.y = static_cast<float64_t>(transform.translation().y());
+  tf.transform.translation.z = static_cast<float64_t>(transform.translation().z());
+  tf.transform.rotation.x = static_cast<float64_t>(rotation.x());
+  tf.transform.rotation.y = static_cast<float64_t>(rotation.y());
+  tf.transform.rotation.z = static_cast<float64_t>(rotation.z());
+  tf.transform.rotation.w = static_cast<float64_t>(rotation.w());
+  (void)tf_buffer.setTransform(tf, "bench_multi_object_tracker", true);
+}
+
+float64_t to_us(const std::chrono::nanoseconds latency)
+{
+  return std::chrono::duration<float64_t, std::micro>(latency).count();
+}
+
+// Replay the frames with a new tracker, timing each frame, optionally with the ROIs of the frame
+// just before its detections
+void replay(benchmark::State & state, const bool use_vision)
+{
+  const auto frames = create_frames(static_cast<std::size_t>(state.range(0)));
+  tf2::BufferCore tf_buffer;
+  set_camera_transform(tf_buffer);
+  const auto options = create_options(use_vision);
+  LatencyRecorder latencies;
+  latencies.reserve(frames.size() * 100U);
+  // Eigen's aligned allocations bypass the counter
+  AllocationCounter allocations;
+  std::size_t num_allocations = 0U;
+  for (auto _ : state) {
+    state.PauseTiming();
+    MultiObjectTracker tracker{options, tf_buffer};
+    state.ResumeTiming();
+    for (const auto & frame : frames) {
+      allocations.reset();
+      const auto start = LatencyRecorder::Clock::now();
+      if (use_vision) {
+        tracker.update(frame.rois);
+      }
+      const auto result = tracker.update(frame.detections, frame.odometry);
+      const auto end = LatencyRecorder::Clock::now();
+      num_allocations += allocations.num_allocations();
+      latencies.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start));
+      if (result.status != TrackerUpdateStatus::Ok) {
+        state.SkipWithError("The tracker did not update");
+        return;
+      }
+      benchmark::DoNotOptimize(result.tracks.objects.data());
+    }
+  }
+  const auto num_updates = static_cast<float64_t>(latencies.num_samples());
+  state.counters["allocations_per_frame"] = static_cast<float64_t>(num_allocations) / num_updates;
+  state.counters["p50_us"] = to_us(latencies.percentile(0.5));
+  state.counters["p99_us"] = to_us(latencies.percentile(0.99));
+  state.counters["max_us"] = to_us(latencies.max());
+  state.SetItemsProcessed(static_cast<int64_t>(num_updates) * state.range(0));
+}
+
+}  // namespace
+
+static void BenchTrackerUpdate(benchmark::State & state)
+{
+  replay(state, false);
+}
+
+static void BenchTrackerUpdateWithRois(benchmark::State & state)
+{
+  replay(state, true);
+}
+
+BENCHMARK(BenchTrackerUpdate)->Arg(10)->Arg(50)->Arg(100)->Arg(200)->Arg(500)
+->Unit(benchmark::kMillisecond);
+BENCHMARK(BenchTrackerUpdateWithRois)->Arg(10)->Arg(50)->Arg(100)->Arg(200)->Arg(500)
+->Unit(benchmark::kMillisecond);
@@ -21,6 +21,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <stdexcept>
 #include <vector>
 
 using autoware::perception::tracking::ClassificationTracker;
@@ -153,3 +154,24 @@ TEST(ClassificaitonTrackerTest, OverconfidentObject) {
   ClassificationTracker tracker;
   EXPECT_THROW(tracker.update(overconfident_object.classification), std::domain_error);
 }
+
+TEST(ClassificaitonTrackerTest, TestMaxDifference) {
+  ClassificationTracker tracker;
+  // The missing probability is counted for the UNKNOWN class, like in an update
+  EXPECT_FLOAT_EQ(
+    tracker.max_difference(
+      create_object({{autoware_auto_msgs::msg::ObjectClassification::CAR, 0.3F}}).classification),
+    0.3F);
+  const DetectedObject car = create_object(
+    {{autoware_auto_msgs::msg::ObjectClassification::CAR, 1.0F}});
+  tracker.update(car.classification);
+  EXPECT_LT(tracker.max_difference(car.classification), 0.01F);
+  const DetectedObject pedestrian = create_object(
+    {{autoware_auto_msgs::msg::ObjectClassification::PEDESTRIAN, 1.0F}});
+  EXPECT_GT(tracker.max_difference(pedestrian.classification), 0.99F);
+  EXPECT_THROW(
+    tracker.max_difference(
+      create_object({{autoware_auto_msgs::msg::ObjectClassification::CAR, 0.7F},
+        {autoware_auto_msgs::msg::ObjectClassification::PEDESTRIAN, 0.7F}}).classification),
+    std::domain_error);
+}
@@ -242,3 +242,155 @@ TEST_F(AssociationTester, AreaGatingFails)
     }
   }
 }
+
+// Tracks along a line with a detection near every other one, and a detection far from all tracks.
+// The sparse assigner finds the same associations as the dense one.
+TEST_F(AssociationTester, SparseAssigner)
+{
+  tracking::DetectedObjectAssociator sparse_associator{
+    tracking::DataAssociationConfig{10.0F, 2.0F, true, true}};
+  const auto num_tracks = 8U;
+
+  std::vector<tracking::TrackedObject> tracked_object_vec{};
+  DetectedObjects detections_msg;
+  for (size_t i = 0U; i < num_tracks; ++i) {
+    DetectedObject current_track;
+    current_track.shape = create_square(4.0F);
+    current_track.kinematics.centroid_position.x = 30.0 * static_cast<double>(i);
+    current_track.kinematics.position_covariance = m_some_covariance;
+    current_track.kinematics.has_position_covariance = true;
+    tracked_object_vec.emplace_back(current_track, 0.0, 0.0);
+
+    if (i % 2 == 0) {
+      DetectedObject current_detection;
+      current_detection.shape = current_track.shape;
+      current_detection.kinematics.centroid_position.x =
+        current_track.kinematics.centroid_position.x + 0.5;
+      current_detection.kinematics.position_covariance = m_some_covariance;
+      detections_msg.objects.push_back(current_detection);
+    }
+  }
+  DetectedObject far_detection;
+  far_detection.shape = create_square(4.0F);
+  far_detection.kinematics.centroid_position.y = 1000.0;
+  detections_msg.objects.push_back(far_detection);
+  detections_msg.header.frame_id = kTrackerFrame;  // Set to the same frame as the tracker.
+
+  tracking::TrackedObjects tracks{tracked_object_vec, kTrackerFrame};
+  const auto ret = sparse_associator.assign(detections_msg, tracks);
+  const auto dense_ret = m_associator.assign(detections_msg, tracks);
+
+  EXPECT_EQ(ret.track_assignments, dense_ret.track_assignments);
+  EXPECT_EQ(ret.unassigned_track_indices, dense_ret.unassigned_track_indices);
+  EXPECT_EQ(ret.unassigned_detection_indices, dense_ret.unassigned_detection_indices);
+  for (size_t track_idx = 0U; track_idx < num_tracks; track_idx++) {
+    if (track_idx % 2 == 0) {
+      EXPECT_EQ(ret.track_assignments[track_idx], track_idx / 2U);
+    } else {
+      EXPECT_EQ(ret.track_assignments[track_idx], tracking::AssociatorResult::UNASSIGNED);
+    }
+  }
+  EXPECT_TRUE(
+    ret.unassigned_detection_indices.find(detections_msg.objects.size() - 1U) !=
+    ret.unassigned_detection_indices.end());
+}
+
+// Detections are only compared with the tracks near them, which must still find pairs across
+// the cells of the spatial hash and beyond the area it covers
+TEST_F(AssociationTester, SpatialGating)
+{
+  const std::vector<double> track_x{0.0, 25.0, 1500.0, -3000.0};
+  const std::vector<double> detection_x{-3000.5, 9.5, 1509.0, 5000.0, 24.0};
+
+  std::vector<tracking::TrackedObject> tracked_object_vec{};
+  for (const auto x : track_x) {
+    DetectedObject current_track;
+    current_track.shape = create_square(4.0F);
+    current_track.kinematics.centroid_position.x = x;
+    current_track.kinematics.position_covariance = m_some_covariance;
+    current_track.kinematics.has_position_covariance = true;
+    tracked_object_vec.emplace_back(current_track, 0.0, 0.0);
+  }
+  DetectedObjects detections_msg;
+  for (const auto x : detection_x) {
+    DetectedObject current_detection;
+    current_detection.shape = create_square(4.0F);
+    current_detection.kinematics.centroid_position.x = x;
+    current_detection.kinematics.position_covariance = m_some_covariance;
+    detections_msg.objects.push_back(current_detection);
+  }
+  detections_msg.header.frame_id = kTrackerFrame;  // Set to the same frame as the tracker.
+
+  tracking::TrackedObjects tracks{tracked_object_vec, kTrackerFrame};
+  const auto ret = m_associator.assign(detections_msg, tracks);
+
+  EXPECT_EQ(ret.track_assignments[0U], 1U);
+  EXPECT_EQ(ret.track_assignments[1U], 4U);
+  EXPECT_EQ(ret.track_assignments[2U], 2U);
+  EXPECT_EQ(ret.track_assignments[3U], 0U);
+  EXPECT_TRUE(ret.unassigned_track_indices.empty());
+  ASSERT_EQ(ret.unassigned_detection_indices.size(), 1U);
+  EXPECT_TRUE(ret.unassigned_detection_indices.find(3U) != ret.unassigned_detection_indices.end());
+}
+
+// A track next to each detection, with the detections moving a little from frame to frame. While
+// the weights stay within the tolerance of the solved frame, its result is reused.
+TEST_F(AssociationTester, ReuseResult)
+{
+  tracking::DetectedObjectAssociator reusing_associator{
+    tracking::DataAssociationConfig{10.0F, 2.0F, true, false, 1.0F}};
+  const auto num_tracks = 6U;
+
+  std::vector<tracking::TrackedObject> tracked_object_vec{};
+  DetectedObjects detections_msg;
+  for (size_t i = 0U; i < num_tracks; ++i) {
+    DetectedObject current_track;
+    current_track.shape = create_square(4.0F);
+    current_track.kinematics.centroid_position.x = 7.0 * static_cast<double>(i);
+    current_track.kinematics.position_covariance = m_some_covariance;
+    current_track.kinematics.has_position_covariance = true;
+    tracked_object_vec.emplace_back(current_track, 0.0, 0.0);
+
+    DetectedObject current_detection;
+    current_detection.shape = current_track.shape;
+    current_detection.kinematics.centroid_position.x =
+      current_track.kinematics.centroid_position.x + 0.5;
+    detections_msg.objects.push_back(current_detection);
+  }
+  detections_msg.header.frame_id = kTrackerFrame;  // Set to the same frame as the tracker.
+  tracking::TrackedObjects tracks{tracked_object_vec, kTrackerFrame};
+
+  const auto expect_same = [this, &tracks](
+    const DetectedObjects & detections, const tracking::AssociatorResult & ret) {
+      const auto solved_ret = m_associator.assign(detections, tracks);
+      EXPECT_EQ(ret.track_assignments, solved_ret.track_assignments);
+      EXPECT_EQ(ret.unassigned_track_indices, solved_ret.unassigned_track_indices);
+      EXPECT_EQ(ret.unassigned_detection_indices, solved_ret.unassigned_detection_indices);
+    };
+
+  auto ret = reusing_associator.assign(detections_msg, tracks);
+  EXPECT_FALSE(reusing_associator.reused_result());
+  expect_same(detections_msg, ret);
+
+  // Small motion of all detections
+  for (auto & detection : detections_msg.objects) {
+    detection.kinematics.centroid_position.x += 0.01;
+  }
+  ret = reusing_associator.assign(detections_msg, tracks);
+  EXPECT_TRUE(reusing_associator.reused_result());
+  expect_same(detections_msg, ret);
+
+  // A detection is now closer to the next track, which changes the gated weights
+  detections_msg.objects[0U].kinematics.centroid_position.x += 5.0;
+  ret = reusing_associator.assign(detections_msg, tracks);
+  EXPECT_FALSE(reusing_associator.reused_result());
+  expect_same(detections_msg, ret);
+
+  // A lost detection changes the problem
+  detections_msg.objects.pop_back();
+  ret = reusing_associator.assign(detections_msg, tracks);
+  EXPECT_FALSE(reusing_associator.reused_result());
+  expect_same(detections_msg, ret);
+
+  EXPECT_THROW(tracking::DataAssociationConfig(10.0F, 2.0F, true, false, -1.0F), std::domain_error);
+}
@@ -0,0 +1,105 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <tracking/detection_merge_queue.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using autoware::perception::tracking::DetectionMergeQueue;
+using autoware_auto_msgs::msg::DetectedObjects;
+using std::chrono::milliseconds;
+
+namespace
+{
+DetectedObjects::ConstSharedPtr make_msg(const std::int32_t stamp_ms)
+{
+  auto msg = std::make_shared<DetectedObjects>();
+  msg->header.stamp.sec = stamp_ms / 1000;
+  msg->header.stamp.nanosec = static_cast<std::uint32_t>(stamp_ms % 1000) * 1000000U;
+  return msg;
+}
+
+std::vector<DetectedObjects::ConstSharedPtr> pop_all(DetectionMergeQueue & queue)
+{
+  std::vector<DetectedObjects::ConstSharedPtr> result;
+  while (const auto msg = queue.pop()) {
+    result.push_back(msg);
+  }
+  return result;
+}
+}  // namespace
+
+// A single source is passed through without waiting.
+TEST(TestDetectionMergeQueue, SingleSource) {
+  DetectionMergeQueue queue{1U, milliseconds{100}};
+  const auto msg = make_msg(1000);
+  EXPECT_TRUE(queue.push(0U, msg));
+  EXPECT_EQ(queue.pop(), msg);
+  EXPECT_EQ(queue.pop(), nullptr);
+  EXPECT_EQ(queue.size(), 0U);
+}
+
+// Messages of two sources are released in the order of their stamps, once both sources passed
+// them.
+TEST(TestDetectionMergeQueue, MergesByStamp) {
+  DetectionMergeQueue queue{2U, milliseconds{1000}};
+  const auto lidar1 = make_msg(1000);
+  const auto lidar2 = make_msg(1100);
+  const auto radar1 = make_msg(1050);
+  const auto radar2 = make_msg(1150);
+  queue.push(0U, lidar1);
+  queue.push(0U, lidar2);
+  // The radar could still publish a message before the first lidar message
+  EXPECT_EQ(queue.pop(), nullptr);
+  queue.push(1U, radar1);
+  EXPECT_EQ(pop_all(queue), (std::vector<DetectedObjects::ConstSharedPtr>{lidar1, radar1}));
+  queue.push(1U, radar2);
+  EXPECT_EQ(pop_all(queue), (std::vector<DetectedObjects::ConstSharedPtr>{lidar2}));
+  EXPECT_EQ(queue.size(), 1U);
+  EXPECT_EQ(queue.num_dropped(), 0U);
+}
+
+// A lagging source is not waited for longer than the max latency, and its older messages are
+// dropped afterwards.
+TEST(TestDetectionMergeQueue, SkipsLaggingSource) {
+  DetectionMergeQueue queue{2U, milliseconds{100}};
+  const auto lidar1 = make_msg(1000);
+  const auto lidar2 = make_msg(1050);
+  const auto lidar3 = make_msg(1100);
+  queue.push(0U, lidar1);
+  queue.push(0U, lidar2);
+  EXPECT_EQ(queue.pop(), nullptr);
+  queue.push(0U, lidar3);
+  EXPECT_EQ(pop_all(queue), (std::vector<DetectedObjects::ConstSharedPtr>{lidar1}));
+  // Older than the released message
+  EXPECT_FALSE(queue.push(1U, make_msg(990)));
+  EXPECT_EQ(queue.num_dropped(), 1U);
+  // As old as the released message
+  const auto radar = make_msg(1000);
+  EXPECT_TRUE(queue.push(1U, radar));
+  EXPECT_EQ(pop_all(queue), (std::vector<DetectedObjects::ConstSharedPtr>{radar}));
+  EXPECT_EQ(queue.size(), 2U);
+}
+
+TEST(TestDetectionMergeQueue, InvalidArguments) {
+  EXPECT_THROW(DetectionMergeQueue(0U, milliseconds{100}), std::domain_error);
+  EXPECT_THROW(DetectionMergeQueue(1U, milliseconds{-1}), std::domain_error);
+  DetectionMergeQueue queue{2U, milliseconds{100}};
+  EXPECT_THROW(queue.push(2U, make_msg(1000)), std::out_of_range);
+}
@@ -60,6 +60,16 @@ geometry_msgs::msg::TransformStamped create_identity_transform(
   return tf;
 }
 
+ClassifiedRoi make_box_roi(float32_t min_x, float32_t min_y, float32_t max_x, float32_t max_y)
+{
+  ClassifiedRoi roi;
+  roi.polygon.points.push_back(Point32{}.set__x(min_x).set__y(min_y));
+  roi.polygon.points.push_back(Point32{}.set__x(max_x).set__y(min_y));
+  roi.polygon.points.push_back(Point32{}.set__x(max_x).set__y(max_y));
+  roi.polygon.points.push_back(Point32{}.set__x(min_x).set__y(max_y));
+  return roi;
+}
+
 }  // namespace
 
 template<typename ObjectsT>
@@ -298,3 +308,49 @@ TYPED_TEST(TestRoiAssociation, CombinedAssociationTest) {
       .unassigned_detection_indices.end());
   }
 }
+
+/// \brief The projection is matched to the available ROI with the best IoU, not to any ROI above
+/// the threshold.
+TYPED_TEST(TestRoiAssociation, BestRoiAssociation) {
+  ClassifiedRoiArray rois;
+  rois.header.frame_id = kCameraFrame;
+
+  const auto tf = create_identity_transform(
+    rois.header.frame_id, kTrackerFrame, rois.header.stamp);
+  this->tf_buffer.setTransform(tf, kDummyTfAuthority, kIsStatic);
+
+  this->add_object(make_pt(10.0F, 10.0F, 10), 5.0F, 5.0F, 2.0F);
+  const auto projection = this->camera.project(expand_shape_to_vector(this->get_ith_shape(0U)));
+  ASSERT_TRUE(projection);
+  // A ROI that overlaps most of the projection, on both sides of the exact one
+  auto shifted_roi = projection_to_roi(projection.value());
+  for (auto & pt : shifted_roi.polygon.points) {
+    pt.x += 1.0F;
+  }
+  rois.rois.push_back(shifted_roi);
+  rois.rois.push_back(projection_to_roi(projection.value()));
+  rois.rois.push_back(shifted_roi);
+  // A ROI far away from the projection
+  rois.rois.push_back(make_box_roi(-100.0F, -100.0F, -90.0F, -90.0F));
+  const auto result = this->associator.assign(rois, this->objects);
+  EXPECT_EQ(result.track_assignments.front(), 1U);
+  EXPECT_EQ(result.unassigned_detection_indices.size(), 3U);
+}
+
+TEST(RoiGrid, Query) {
+  ClassifiedRoiArray rois;
+  rois.rois.push_back(make_box_roi(0.0F, 0.0F, 10.0F, 10.0F));
+  rois.rois.push_back(make_box_roi(100.0F, 100.0F, 120.0F, 150.0F));
+  rois.rois.emplace_back();
+  rois.rois.push_back(make_box_roi(5.0F, 5.0F, 200.0F, 20.0F));
+  tracking::details::RoiGrid grid{rois};
+
+  EXPECT_EQ(grid.query(1.0F, 1.0F, 2.0F, 2.0F), (std::vector<std::size_t>{0U}));
+  EXPECT_EQ(grid.query(6.0F, 6.0F, 110.0F, 110.0F), (std::vector<std::size_t>{0U, 1U, 3U}));
+  EXPECT_EQ(grid.query(150.0F, 15.0F, 160.0F, 16.0F), (std::vector<std::size_t>{3U}));
+  // Touching boxes can overlap with a zero IoU
+  EXPECT_EQ(grid.query(120.0F, 150.0F, 130.0F, 160.0F), (std::vector<std::size_t>{1U}));
+  EXPECT_TRUE(grid.query(30.0F, 30.0F, 90.0F, 90.0F).empty());
+  EXPECT_TRUE(grid.query(-50.0F, -50.0F, -1.0F, -1.0F).empty());
+  EXPECT_TRUE(grid.query(300.0F, 0.0F, 400.0F, 400.0F).empty());
+}
@@ -14,6 +14,8 @@
 //
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
+#include <utility>
+
 #include "gtest/gtest.h"
 #include "autoware_auto_msgs/msg/detected_objects.hpp"
 #include "nav_msgs/msg/odometry.hpp"
@@ -25,6 +27,8 @@ using Options = autoware::perception::tracking::MultiObjectTrackerOptions;
 using Status = autoware::perception::tracking::TrackerUpdateStatus;
 using DetectedObjects = autoware_auto_msgs::msg::DetectedObjects;
 using Odometry = nav_msgs::msg::Odometry;
+using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
 
 class MultiObjectTrackerTest : public ::testing::Test
 {
@@ -69,3 +73,45 @@ TEST_F(MultiObjectTrackerTest, TestFrameOrientationValidation) {
   const auto result = m_tracker.update(m_detections, m_odom);
   EXPECT_EQ(result.status, Status::FrameNotGravityAligned);
 }
+
+// Predicting and updating the tracks on several workers gives the same tracks as doing it serially
+TEST_F(MultiObjectTrackerTest, TestWorkers) {
+  Options options{{2.0F, 2.5F, true}, {}, {CreationPolicies::LidarClusterOnly, 1.0F, 1.0F}};
+  options.num_workers = 4U;
+  Tracker parallel_tracker{options, m_tf_buffer};
+
+  for (std::size_t idx = 0U; idx < 50U; ++idx) {
+    autoware_auto_msgs::msg::DetectedObject detection;
+    const float32_t x = 5.0F * static_cast<float32_t>(idx);
+    for (const auto & corner : {std::make_pair(-1.0F, -1.0F), std::make_pair(1.0F, -1.0F),
+        std::make_pair(1.0F, 1.0F), std::make_pair(-1.0F, 1.0F)})
+    {
+      detection.shape.polygon.points.push_back(
+        geometry_msgs::msg::Point32{}.set__x(x + corner.first).set__y(corner.second));
+    }
+    detection.kinematics.centroid_position.x = static_cast<float64_t>(x);
+    detection.kinematics.position_covariance[0] = 0.5;
+    detection.kinematics.position_covariance[4] = 0.5;
+    detection.kinematics.has_position_covariance = true;
+    m_detections.objects.push_back(detection);
+  }
+  for (int32_t frame = 0; frame < 5; ++frame) {
+    m_detections.header.stamp.sec = 1000 + frame;
+    m_odom.header.stamp = m_detections.header.stamp;
+    for (auto & detection : m_detections.objects) {
+      detection.kinematics.centroid_position.y += 0.2;
+    }
+    const auto serial = m_tracker.update(m_detections, m_odom);
+    const auto parallel = parallel_tracker.update(m_detections, m_odom);
+    ASSERT_EQ(serial.status, Status::Ok);
+    ASSERT_EQ(parallel.status, Status::Ok);
+    ASSERT_EQ(serial.tracks.objects.size(), parallel.tracks.objects.size());
+    for (std::size_t idx = 0U; idx < serial.tracks.objects.size(); ++idx) {
+      const auto & serial_kinematics = serial.tracks.objects[idx].kinematics;
+      const auto & parallel_kinematics = parallel.tracks.objects[idx].kinematics;
+      EXPECT_EQ(serial_kinematics.centroid_position, parallel_kinematics.centroid_position);
+      EXPECT_EQ(serial_kinematics.position_covariance, parallel_kinematics.position_covariance);
+      EXPECT_EQ(serial_kinematics.twist, parallel_kinematics.twist);
+    }
+  }
+}
@@ -170,6 +170,74 @@ TEST_F(PrismProjectionTest, TransformedCameraFrameTest) {
   compare_shapes(x_facade_on_camera_frame, projection.value(), intrinsics);
 }
 
+/// \brief Projecting the vertices in bulk with the projector of the transform gives the same
+/// outline as transforming each vertex and projecting the shape.
+TEST_F(PrismProjectionTest, BulkProjectionTest) {
+  CameraIntrinsics intrinsics{image_width, image_heigth, 0.6F, 1.5F, half_image_width,
+    half_image_height, 0.005F};
+  CameraModel model{intrinsics};
+
+  Eigen::Transform<float32_t, 3U, Eigen::Affine> tf_camera_from_ego;
+  tf_camera_from_ego.setIdentity();
+  tf_camera_from_ego.translate(Eigen::Vector3f{0.5F, -0.2F, 1.0F});
+  tf_camera_from_ego.rotate(Eigen::AngleAxisf(0.1F, Eigen::Vector3f::UnitY()));
+  const auto transform = tf2::eigenToTransform(tf_camera_from_ego.cast<float64_t>()).transform;
+  ShapeTransformer transformer{transform};
+  const auto vertices = expand_shape_to_vector(rectangular_prism);
+  const auto projection = model.project(
+    transformer(rectangular_prism, geometry_msgs::msg::Point{}, geometry_msgs::msg::Quaternion{}));
+  ASSERT_TRUE(projection);
+
+  CameraModel::EigPoints points_3d{3, static_cast<Eigen::Index>(vertices.size())};
+  for (std::size_t i = 0U; i < vertices.size(); ++i) {
+    points_3d.col(static_cast<Eigen::Index>(i)) << vertices[i].x, vertices[i].y, vertices[i].z;
+  }
+  const CameraModel::EigPoints points_2d =
+    model.projector(tf_camera_from_ego) * points_3d.colwise().homogeneous();
+  const auto bulk_projection = model.outline(points_2d);
+  ASSERT_TRUE(bulk_projection);
+
+  ASSERT_EQ(projection->shape.size(), bulk_projection->shape.size());
+  auto bulk_it = bulk_projection->shape.begin();
+  for (const auto & pt : projection->shape) {
+    EXPECT_NEAR(pt.x, bulk_it->x, 1e-3F);
+    EXPECT_NEAR(pt.y, bulk_it->y, 1e-3F);
+    ++bulk_it;
+  }
+}
+
+/// \brief Projecting many shapes in bulk gives the outline of each shape that is visible, and
+/// culls the shapes behind the camera or beside the image.
+TEST_F(PrismProjectionTest, ProjectShapesTest) {
+  CameraIntrinsics intrinsics{image_width, image_heigth, 1.0F, 1.0F, half_image_width,
+    half_image_height};
+  CameraModel model{intrinsics};
+  const std::vector<geometry_msgs::msg::Point> centroids{
+    geometry_msgs::msg::Point{},
+    geometry_msgs::msg::Point{}.set__z(-20.0),
+    geometry_msgs::msg::Point{}.set__x(1000.0)};
+  const auto orientation = geometry_msgs::msg::Quaternion{}.set__w(1.0);
+  const auto num_vertices = 2U * rectangular_prism.polygon.points.size();
+  std::vector<std::size_t> vertex_begin{0U};
+  CameraModel::EigPoints vertices{3, static_cast<Eigen::Index>(num_vertices * centroids.size())};
+  for (std::size_t i = 0U; i < centroids.size(); ++i) {
+    autoware::perception::tracking::set_shape_vertices(
+      rectangular_prism, centroids[i], orientation, vertex_begin.back(), vertices);
+    vertex_begin.push_back(vertex_begin.back() + num_vertices);
+  }
+
+  const auto projections =
+    model.project_shapes(Eigen::Affine3f::Identity(), vertices, vertex_begin);
+  ASSERT_EQ(projections.size(), centroids.size());
+  const auto projection = model.project(expand_shape_to_vector(rectangular_prism));
+  ASSERT_TRUE(projection);
+  ASSERT_TRUE(projections[0U]);
+  EXPECT_EQ(projection->shape.size(), projections[0U]->shape.size());
+  EXPECT_FALSE(projections[1U]);
+  EXPECT_FALSE(projections[2U]);
+  EXPECT_TRUE(model.project_shapes(Eigen::Affine3f::Identity(), vertices, {}).empty());
+}
+
 /// \brief Test to validate that objects behind the camera are not captured.
 TEST_F(PrismProjectionTest, BehindTheImagePlaneTest) {
   CameraIntrinsics intrinsics{image_width, image_heigth, 1.0F, 1.0F, half_image_width,
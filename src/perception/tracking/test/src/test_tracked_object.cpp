@@ -15,6 +15,9 @@
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
 #include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "autoware_auto_msgs/msg/detected_object.hpp"
@@ -22,10 +25,36 @@
 #include "tracking/tracked_object.hpp"
 
 using TrackedObject = autoware::perception::tracking::TrackedObject;
+using TrackedObjectUpdatePolicy = autoware::perception::tracking::TrackedObjectUpdatePolicy;
 using DetectedObjectMsg = autoware_auto_msgs::msg::DetectedObject;
 using TrackedObjectMsg = autoware_auto_msgs::msg::TrackedObject;
 using autoware_auto_msgs::msg::ObjectClassification;
 
+namespace
+{
+TrackedObject::ObjectClassifications make_classifications(const std::uint8_t label)
+{
+  ObjectClassification classification;
+  classification.classification = label;
+  classification.probability = 1.0F;
+  return {classification};
+}
+
+DetectedObjectMsg make_square_detection(const float side)
+{
+  DetectedObjectMsg msg;
+  for (const auto corner : {std::make_pair(1.0F, 1.0F), std::make_pair(-1.0F, 1.0F),
+      std::make_pair(-1.0F, -1.0F), std::make_pair(1.0F, -1.0F)})
+  {
+    geometry_msgs::msg::Point32 point;
+    point.x = 0.5F * side * corner.first;
+    point.y = 0.5F * side * corner.second;
+    msg.shape.polygon.points.push_back(point);
+  }
+  return msg;
+}
+}  // namespace
+
 // Test that the has_twist field is respected when initializing the tracked object.
 TEST(TestTrackedObject, TestOptionalTwist) {
   DetectedObjectMsg msg;
@@ -107,6 +136,24 @@ TEST(TestTrackedObject, TestPredict) {
   EXPECT_NE(object.msg().kinematics.centroid_position.x, 0.0);
 }
 
+// Test that a shared prediction moves the track like its own prediction.
+TEST(TestTrackedObject, TestSharedPredict) {
+  DetectedObjectMsg msg;
+  msg.kinematics.has_twist = true;
+  msg.kinematics.twist.twist.linear.x = 3.0;
+  msg.kinematics.twist.twist.linear.y = -1.0;
+  const auto dt = std::chrono::milliseconds(500);
+  for (const auto noise_variance : {30.0, 5.0}) {
+    TrackedObject own{msg, 1.0, noise_variance};
+    TrackedObject shared{msg, 1.0, noise_variance};
+    own.predict(dt);
+    // The prediction for another noise falls back to the own prediction of the track
+    shared.predict(TrackedObject::make_prediction(dt, 30.0));
+    EXPECT_EQ(own.msg().kinematics, shared.msg().kinematics);
+    EXPECT_EQ(own.should_be_removed(dt, 5U), shared.should_be_removed(dt, 5U));
+  }
+}
+
 // Test that the update() method can handle detected objects with or without twist.
 TEST(TestTrackedObject, TestUpdate) {
   const auto kDefaultVariance = 1.0;
@@ -147,3 +194,58 @@ TEST(TestTrackedObject, TestShouldBeRemoved) {
   object.no_update();
   EXPECT_EQ(object.should_be_removed(std::chrono::milliseconds(1000), 5), true);
 }
+
+// Test that a lazy classification update policy skips updates between the periodic ones, unless
+// they diverge from the classification of the track.
+TEST(TestTrackedObject, TestLazyClassification) {
+  DetectedObjectMsg msg;
+  msg.classification = make_classifications(ObjectClassification::CAR);
+  const auto pedestrian = make_classifications(ObjectClassification::PEDESTRIAN);
+  const auto pedestrian_probability = [](TrackedObject & object) {
+      return object.msg().classification[ObjectClassification::PEDESTRIAN].probability;
+    };
+
+  TrackedObjectUpdatePolicy policy;
+  policy.classification_update_period = 3U;
+  TrackedObject periodic{msg, 1.0, 30.0, policy};
+  TrackedObject eager{msg, 1.0, 30.0};
+  periodic.update(pedestrian, 0.1F);
+  periodic.update(pedestrian, 0.1F);
+  EXPECT_FLOAT_EQ(pedestrian_probability(periodic), 0.0F);
+  periodic.update(pedestrian, 0.1F);
+  eager.update(pedestrian, 0.1F);
+  EXPECT_GT(pedestrian_probability(periodic), 0.0F);
+  EXPECT_EQ(periodic.msg().classification, eager.msg().classification);
+
+  // The update is applied right away when it diverges
+  policy.classification_update_period = 100U;
+  policy.classification_divergence = 0.5F;
+  TrackedObject diverging{msg, 1.0, 30.0, policy};
+  diverging.update(msg.classification, 0.1F);
+  const auto settled = diverging.msg().classification;
+  diverging.update(pedestrian, 0.1F);
+  EXPECT_GT(pedestrian_probability(diverging), 0.0F);
+  EXPECT_NE(diverging.msg().classification, settled);
+
+  policy.classification_update_period = 0U;
+  EXPECT_THROW(TrackedObject(msg, 1.0, 30.0, policy), std::domain_error);
+}
+
+// Test that the shape of a track is only replaced when it differs enough from the detection.
+TEST(TestTrackedObject, TestLazyShape) {
+  TrackedObjectUpdatePolicy policy;
+  policy.shape_iou_threshold = 0.8F;
+  TrackedObject lazy{make_square_detection(2.0F), 1.0, 30.0, policy};
+  TrackedObject eager{make_square_detection(2.0F), 1.0, 30.0};
+  // The IoU of the squares is 0.91
+  const auto similar = make_square_detection(2.1F);
+  lazy.update(similar);
+  eager.update(similar);
+  EXPECT_EQ(lazy.shape(), make_square_detection(2.0F).shape);
+  EXPECT_EQ(eager.shape(), similar.shape);
+  // The IoU of the squares is 0.25
+  const auto different = make_square_detection(4.0F);
+  lazy.update(different);
+  EXPECT_EQ(lazy.shape(), different.shape);
+  EXPECT_EQ(lazy.msg().shape.size(), 1U);
+}
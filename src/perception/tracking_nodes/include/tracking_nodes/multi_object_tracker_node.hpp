@@ -23,6 +23,7 @@
 
 #include <autoware_auto_msgs/msg/detected_objects.hpp>
 #include <autoware_auto_msgs/msg/tracked_objects.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
 #include <message_filters/cache.h>
 #include <message_filters/subscriber.h>
@@ -35,9 +36,12 @@
 #include <tf2/buffer_core.h>
 #include <tf2_msgs/msg/tf_message.hpp>
 #include <tf2_ros/transform_listener.h>
+#include <time_utils/latency_histogram.hpp>
+#include <tracking/detection_merge_queue.hpp>
 #include <tracking/multi_object_tracker.hpp>
 #include <tracking_nodes/visibility_control.hpp>
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -49,7 +53,8 @@ namespace tracking_nodes
 
 /// \class MultiObjectTrackerNode
 /// \brief ROS 2 Node for tracking. Subscribes to DetectedObjects and Odometry or
-///        PoseWithCovairanceStamped (depends on use_ndt param) and produces TrackedObjects
+///        PoseWithCovairanceStamped (depends on use_ndt param) and produces TrackedObjects.
+///        The DetectedObjects of several topics are merged in the order of their stamps.
 class TRACKING_NODES_PUBLIC MultiObjectTrackerNode : public rclcpp::Node
 {
   using DetectedObjects = autoware_auto_msgs::msg::DetectedObjects;
@@ -57,6 +62,9 @@ class TRACKING_NODES_PUBLIC MultiObjectTrackerNode : public rclcpp::Node
   using OdometryMsg = nav_msgs::msg::Odometry;
   using PoseMsg = geometry_msgs::msg::PoseWithCovarianceStamped;
   using OdomCache = message_filters::Cache<OdometryMsg>;
+  using DiagnosticArray = diagnostic_msgs::msg::DiagnosticArray;
+  /// Latency histograms of the stages of a tracker update, in the order of STAGE_NAMES.
+  using Latencies = std::array<common::time_utils::LatencyHistogram, 6U>;
 
 public:
   /// \brief Constructor
@@ -65,22 +73,33 @@ public:
 private:
   void TRACKING_NODES_LOCAL odometry_callback(const OdometryMsg::ConstSharedPtr msg);
   void TRACKING_NODES_LOCAL pose_callback(const PoseMsg::ConstSharedPtr msg);
-  void TRACKING_NODES_LOCAL detected_objects_callback(const DetectedObjects::ConstSharedPtr msg);
+  void TRACKING_NODES_LOCAL detected_objects_callback(
+    const DetectedObjects::ConstSharedPtr msg, const std::size_t source);
+  /// Update the tracker with the detections released by the merge queue.
+  void TRACKING_NODES_LOCAL process_detected_objects(const DetectedObjects::ConstSharedPtr msg);
   void TRACKING_NODES_LOCAL classified_roi_callback(const ClassifiedRoiArray::ConstSharedPtr msg);
+  /// Add the stage timings of an update to the histograms and publish them periodically.
+  void TRACKING_NODES_LOCAL add_latencies(
+    const perception::tracking::TrackerStageTimings & timings);
+  /// Summarize the stage latencies in a diagnostic message.
+  DiagnosticArray TRACKING_NODES_LOCAL make_latency_diagnostics() const;
 
   common::types::bool8_t m_use_ndt{true};
   common::types::bool8_t m_use_vision{true};
   std::size_t m_history_depth{0UL};
+  std::size_t m_num_detection_topics{1UL};
 
   tf2::BufferCore m_tf_buffer;
   tf2_ros::TransformListener m_tf_listener;
 
   /// The actual tracker implementation.
   autoware::perception::tracking::MultiObjectTracker m_tracker;
+  /// Orders the detections of all detection topics by stamp for the tracker.
+  autoware::perception::tracking::DetectionMergeQueue m_merge_queue;
 
   rclcpp::Subscription<PoseMsg>::SharedPtr m_pose_subscription{};
   rclcpp::Subscription<OdometryMsg>::SharedPtr m_odom_subscription{};
-  rclcpp::Subscription<DetectedObjects>::SharedPtr m_detected_objects_subscription{};
+  std::vector<rclcpp::Subscription<DetectedObjects>::SharedPtr> m_detected_objects_subscriptions;
   std::vector<rclcpp::Subscription<ClassifiedRoiArray>::SharedPtr> m_vision_subscriptions;
 
   /// A cache that stores the odometry messages.
@@ -99,6 +118,13 @@ private:
   bool8_t m_visualize_track_creation = false;
 
   rclcpp::Publisher<DetectedObjects>::SharedPtr m_track_creating_clusters_pub;
+
+  /// Stage latencies of the tracker updates, null if diagnostics are disabled.
+  std::unique_ptr<Latencies> m_latencies{};
+  /// Number of tracker updates between two diagnostic messages.
+  std::size_t m_diagnostics_period{1U};
+  std::size_t m_num_updates{0U};
+  rclcpp::Publisher<DiagnosticArray>::SharedPtr m_diagnostics_publisher{};
 };
 
 }  // namespace tracking_nodes
@@ -18,8 +18,10 @@
 
 #include <rclcpp_components/register_node_macro.hpp>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#include <time_utils/probe_diagnostics.hpp>
 #include <time_utils/time_utils.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -40,6 +42,7 @@ using autoware::perception::tracking::MultiObjectTrackerOptions;
 using autoware::perception::tracking::TrackCreatorConfig;
 using autoware::perception::tracking::DetectedObjectsUpdateResult;
 using autoware::perception::tracking::TrackerUpdateStatus;
+using autoware::perception::tracking::TrackerStageTimings;
 using autoware::perception::tracking::GreedyRoiAssociatorConfig;
 using autoware::perception::tracking::CameraIntrinsics;
 using autoware::perception::tracking::VisionPolicyConfig;
@@ -55,6 +58,9 @@ constexpr std::chrono::milliseconds kMaxLidarEgoStateStampDiff{100};
 constexpr std::chrono::milliseconds kMaxVisionEgoStateStampDiff{100};
 constexpr std::int64_t kDefaultHistoryDepth{20};
 constexpr std::int64_t kDefaultPoseHistoryDepth{100};
+constexpr std::int64_t kDefaultMaxMergeLatencyMs{100};
+constexpr const char * STAGE_NAMES[] = {"transform", "predict", "associate", "update", "create",
+  "prune"};
 
 MultiObjectTracker init_tracker(
   rclcpp::Node & node,
@@ -69,6 +75,10 @@ MultiObjectTracker init_tracker(
       "object_association.max_area_ratio").get<float64_t>());
   const bool consider_edge_for_big_detections = node.declare_parameter(
     "object_association.consider_edge_for_big_detection").get<bool>();
+  const bool use_sparse_assigner = node.declare_parameter(
+    "object_association.use_sparse_assigner", false);
+  const float32_t reuse_tolerance = static_cast<float32_t>(node.declare_parameter(
+      "object_association.reuse_tolerance", 0.0));
 
   auto creation_policy = perception::tracking::TrackCreationPolicy::LidarClusterOnly;
   const auto default_variance = node.declare_parameter(
@@ -122,10 +132,20 @@ MultiObjectTracker init_tracker(
   creator_config.policy = creation_policy;
   creator_config.default_variance = default_variance;
   creator_config.noise_variance = noise_variance;
+  creator_config.update_policy.classification_update_period =
+    static_cast<std::size_t>(std::max(
+      node.declare_parameter("track_update.classification_update_period", 1), 1));
+  creator_config.update_policy.classification_divergence = static_cast<float32_t>(
+    node.declare_parameter("track_update.classification_divergence", 1.0));
+  creator_config.update_policy.shape_iou_threshold = static_cast<float32_t>(
+    node.declare_parameter("track_update.shape_iou_threshold", 1.0));
 
   MultiObjectTrackerOptions options{
-    {max_distance, max_area_ratio, consider_edge_for_big_detections}, vision_config,
-    creator_config, pruning_time_threshold, pruning_ticks_threshold, frame};
+    {max_distance, max_area_ratio, consider_edge_for_big_detections, use_sparse_assigner,
+      reuse_tolerance},
+    vision_config, creator_config, pruning_time_threshold, pruning_ticks_threshold, frame};
+  options.num_workers =
+    static_cast<std::size_t>(std::max(node.declare_parameter("num_workers", 1), 1));
   return MultiObjectTracker{options, tf_buffer};
 }
 
@@ -176,7 +196,11 @@ MultiObjectTrackerNode::MultiObjectTrackerNode(const rclcpp::NodeOptions & optio
   m_history_depth{static_cast<std::size_t>(
       declare_parameter("history_depth", kDefaultHistoryDepth))},
   m_tf_listener{m_tf_buffer},
+  m_num_detection_topics{static_cast<std::size_t>(
+      std::max(declare_parameter("num_detection_topics", 1), 1))},
   m_tracker{init_tracker(*this, m_use_vision, m_tf_buffer)},
+  m_merge_queue{m_num_detection_topics, std::chrono::milliseconds{
+      declare_parameter("detection_merge.max_latency_ms", kDefaultMaxMergeLatencyMs)}},
   m_track_publisher{create_publisher<TrackedObjects>("tracked_objects", m_history_depth)},
   m_leftover_publisher{create_publisher<DetectedObjects>("leftover_clusters", m_history_depth)},
   m_visualize_track_creation{this->declare_parameter("visualize_track_creation", false)}
@@ -195,9 +219,17 @@ MultiObjectTrackerNode::MultiObjectTrackerNode(const rclcpp::NodeOptions & optio
       std::bind(&MultiObjectTrackerNode::pose_callback, this, std::placeholders::_1));
   }
 
-  m_detected_objects_subscription = create_subscription<DetectedObjects>(
-    "detected_objects", rclcpp::QoS{m_history_depth},
-    std::bind(&MultiObjectTrackerNode::detected_objects_callback, this, std::placeholders::_1));
+  // A single detection topic keeps its plain name
+  for (std::size_t i = 0U; i < m_num_detection_topics; ++i) {
+    const auto topic_name = (m_num_detection_topics == 1U) ?
+      std::string{"detected_objects"} : "detected_objects" + std::to_string(i + 1);
+    m_detected_objects_subscriptions.push_back(
+      create_subscription<DetectedObjects>(
+        topic_name, rclcpp::QoS{m_history_depth},
+        [this, i](const DetectedObjects::ConstSharedPtr msg) {
+          detected_objects_callback(msg, i);
+        }));
+  }
 
   // Initialize vision callbacks if vision is configured to be used:
   if (m_use_vision) {
@@ -223,6 +255,13 @@ MultiObjectTrackerNode::MultiObjectTrackerNode(const rclcpp::NodeOptions & optio
     m_track_creating_clusters_pub =
       create_publisher<DetectedObjects>("associated_detections", m_history_depth);
   }
+
+  if (declare_parameter("diagnostics.enable", false)) {
+    m_latencies = std::make_unique<Latencies>();
+    m_diagnostics_period =
+      static_cast<std::size_t>(std::max(declare_parameter("diagnostics.period_frames", 100), 1));
+    m_diagnostics_publisher = create_publisher<DiagnosticArray>("diagnostics", rclcpp::QoS{10});
+  }
 }
 
 void MultiObjectTrackerNode::odometry_callback(const OdometryMsg::ConstSharedPtr odom)
@@ -235,7 +274,21 @@ void MultiObjectTrackerNode::pose_callback(const PoseMsg::ConstSharedPtr pose)
   m_odom_cache->add(to_odom(pose));
 }
 
-void MultiObjectTrackerNode::detected_objects_callback(const DetectedObjects::ConstSharedPtr objs)
+void MultiObjectTrackerNode::detected_objects_callback(
+  const DetectedObjects::ConstSharedPtr objs, const std::size_t source)
+{
+  if (!m_merge_queue.push(source, objs)) {
+    RCLCPP_WARN(
+      get_logger(), "Dropped detections at time %d.%d, which are older than the tracks",
+      objs->header.stamp.sec, objs->header.stamp.nanosec);
+    return;
+  }
+  while (const auto released = m_merge_queue.pop()) {
+    process_detected_objects(released);
+  }
+}
+
+void MultiObjectTrackerNode::process_detected_objects(const DetectedObjects::ConstSharedPtr objs)
 {
   const rclcpp::Time msg_stamp{objs->header.stamp.sec, objs->header.stamp.nanosec};
   const auto earliest_time = msg_stamp - kMaxLidarEgoStateStampDiff;
@@ -247,6 +300,9 @@ void MultiObjectTrackerNode::detected_objects_callback(const DetectedObjects::Co
   }
   const auto result = m_tracker.update(
     *objs, *get_closest_match(matched_msgs, objs->header.stamp));
+  if (result.status == TrackerUpdateStatus::Ok) {
+    add_latencies(result.timings);
+  }
   if (result.status == TrackerUpdateStatus::Ok && result.maybe_roi_stamps) {
     m_track_publisher->publish(result.tracks);
     m_leftover_publisher->publish(result.unassigned_clusters);
@@ -264,6 +320,38 @@ void MultiObjectTrackerNode::classified_roi_callback(const ClassifiedRoiArray::C
   m_tracker.update(*rois);
 }
 
+void MultiObjectTrackerNode::add_latencies(const TrackerStageTimings & timings)
+{
+  if (!m_latencies) {
+    return;
+  }
+  const std::array<std::chrono::nanoseconds, std::tuple_size<Latencies>::value> durations{
+    timings.transform, timings.predict, timings.associate, timings.update, timings.create,
+    timings.prune};
+  static_assert(
+    (sizeof(STAGE_NAMES) / sizeof(STAGE_NAMES[0])) == std::tuple_size<Latencies>::value,
+    "Missing name of a stage");
+  for (std::size_t idx = 0U; idx < durations.size(); ++idx) {
+    (*m_latencies)[idx].add(durations[idx]);
+  }
+  if ((++m_num_updates % m_diagnostics_period) == 0U) {
+    m_diagnostics_publisher->publish(make_latency_diagnostics());
+  }
+}
+
+MultiObjectTrackerNode::DiagnosticArray MultiObjectTrackerNode::make_latency_diagnostics() const
+{
+  auto status = common::time_utils::make_latency_status(
+    std::string{get_name()} + ": stage latencies", "tracking_nodes");
+  for (std::size_t idx = 0U; idx < m_latencies->size(); ++idx) {
+    common::time_utils::add_latency_values(STAGE_NAMES[idx], (*m_latencies)[idx], status);
+  }
+  DiagnosticArray diagnostics;
+  diagnostics.header.stamp = now();
+  diagnostics.status.push_back(status);
+  return diagnostics;
+}
+
 void MultiObjectTrackerNode::maybe_visualize(
   const perception::tracking::MaybeRoiStampsT::value_type & roi_stamps,
   DetectedObjects all_objects)
@@ -0,0 +1,182 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+/// \copyright Copyright 2021 The Autoware Foundation
+/// \file
+/// \brief This file defines the cache which stores the frames generated from a Scene in a binary
+/// file, so that they can be memory-mapped instead of being generated again
+
+#ifndef TRACKING_TEST_FRAMEWORK__FRAME_CACHE_HPP_
+#define TRACKING_TEST_FRAMEWORK__FRAME_CACHE_HPP_
+
+#include <tracking_test_framework/scene.hpp>
+
+#include <Eigen/Core>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace tracking_test_framework
+{
+
+/// Struct containing the ground truth and the LiDAR intersections of a Scene at one point in time
+struct SceneFrame
+{
+  EigenStlVector<ObjectState> objects{};
+  std::vector<ObjIntersections> intersections{};
+};
+
+/// \brief Method to record frames of a Scene, moving its objects after each frame
+/// \param[in] scene the Scene to record
+/// \param[in] num_frames number of frames to record
+/// \param[in] dt_in_ms time interval between two frames in milliseconds
+/// \param[in] closest_only the boolean to determine if closest intersection to be
+/// recorded or all
+/// \return returns the recorded frames
+TRACKING_TEST_FRAMEWORK_PUBLIC std::vector<SceneFrame> record_frames(
+  Scene & scene, const std::size_t num_frames, const std::chrono::milliseconds dt_in_ms,
+  const bool closest_only);
+
+/// \brief This is the class which builds the key of a FrameCache from the parameters that the
+/// frames are generated with, by hashing them with 64 bit FNV-1a
+class TRACKING_TEST_FRAMEWORK_PUBLIC FrameCacheKey
+{
+public:
+  /// \brief Add an integer parameter to the key
+  FrameCacheKey & add(const uint64_t value);
+
+  /// \brief Add a floating point parameter to the key
+  FrameCacheKey & add(const autoware::common::types::float32_t value);
+
+  /// \brief Add a string parameter to the key, e.g. the name of the generator
+  FrameCacheKey & add(const std::string & value);
+
+  /// \brief gets the key
+  uint64_t value() const noexcept;
+
+private:
+  void add_bytes(const void * bytes, const std::size_t size);
+
+  uint64_t m_hash{14695981039346656037ULL};
+};
+
+/// \brief This is the class which gives access to one frame of a FrameCache without copying it
+/// out of the memory-mapped file
+class TRACKING_TEST_FRAMEWORK_PUBLIC FrameView
+{
+public:
+  /// Points of an intersection, one column per point
+  using Points = Eigen::Map<const Eigen::Matrix<autoware::common::types::float32_t, 2,
+      Eigen::Dynamic>>;
+
+  /// \brief constructor
+  /// \param[in] data start of the frame in the memory-mapped file
+  explicit FrameView(const uint8_t * data);
+
+  /// \brief gets the number of objects in the frame
+  std::size_t num_objects() const noexcept;
+
+  /// \brief gets the ground truth state of an object
+  ObjectState object_state(const std::size_t index) const;
+
+  /// \brief gets the number of intersections with the LiDAR in the frame
+  std::size_t num_intersections() const noexcept;
+
+  /// \brief gets the type of the object of an intersection
+  ObjectType intersection_type(const std::size_t index) const;
+
+  /// \brief gets the points of an intersection
+  Points intersection_points(const std::size_t index) const;
+
+  /// \brief copies the frame out of the file
+  SceneFrame to_scene_frame() const;
+
+private:
+  const uint32_t * m_header;
+  const uint32_t * m_object_types;
+  const autoware::common::types::float32_t * m_objects;
+  const uint32_t * m_intersection_types;
+  const uint32_t * m_point_begin;
+  const autoware::common::types::float32_t * m_points;
+};
+
+/// \brief This is the class which stores frames in a binary file and memory-maps them back.
+/// \details The file is only meant to be read on the machine that wrote it: numbers are stored
+/// with the byte order of the host. It starts with a header holding the key and the number of
+/// frames, followed by the offset of each frame in the file. Each frame holds its number of
+/// objects and intersections, the type, position and orientation of the objects, the type and
+/// first point of the intersections and finally all points of all intersections.
+class TRACKING_TEST_FRAMEWORK_PUBLIC FrameCache
+{
+public:
+  /// \brief Open and memory-map a cache file
+  /// \param[in] path path of the cache file
+  /// \throw std::runtime_error If the file can not be read or is not a valid cache file
+  explicit FrameCache(const std::string & path);
+
+  FrameCache(const FrameCache &) = delete;
+  FrameCache & operator=(const FrameCache &) = delete;
+
+  /// \brief destructor, unmaps the file
+  ~FrameCache();
+
+  /// \brief Write frames to a cache file, replacing the file atomically
+  /// \param[in] path path of the cache file
+  /// \param[in] key key of the parameters the frames were generated with
+  /// \param[in] frames the frames to write
+  /// \throw std::runtime_error If the file can not be written
+  static void write(
+    const std::string & path, const uint64_t key, const std::vector<SceneFrame> & frames);
+
+  /// \brief Open a cache file, recording and writing its frames first if the file does not
+  /// exist, is not a valid cache file or was written with a different key
+  /// \param[in] path path of the cache file
+  /// \param[in] key key of the parameters the frames are generated with
+  /// \param[in] record function generating the frames
+  /// \return returns the opened cache
+  /// \throw std::runtime_error If the file can not be written
+  static std::unique_ptr<FrameCache> load_or_record(
+    const std::string & path, const uint64_t key,
+    const std::function<std::vector<SceneFrame>()> & record);
+
+  /// \brief gets the key the frames were generated with
+  uint64_t key() const noexcept;
+
+  /// \brief gets the number of frames in the cache
+  std::size_t num_frames() const noexcept;
+
+  /// \brief gets a frame
+  /// \throw std::out_of_range If the index is not smaller than the number of frames
+  FrameView frame(const std::size_t index) const;
+
+private:
+  /// \brief Check that all offsets and counts of the file stay within the file
+  void validate() const;
+
+  const uint8_t * m_data{nullptr};
+  std::size_t m_size{0U};
+};
+
+}  // namespace tracking_test_framework
+}  // namespace autoware
+
+#endif  // TRACKING_TEST_FRAMEWORK__FRAME_CACHE_HPP_
@@ -34,6 +34,13 @@ namespace autoware
 {
 namespace tracking_test_framework
 {
+/// \brief Function to get DetectedObjects from intersection points of TrackedObjects with LiDAR
+/// \param[in] intersections the intersection points, e.g. from
+/// Scene::get_intersections_with_lidar or a FrameCache
+/// \return returns the DetectedObjects with a bounding box fitted to the points of each object
+TRACKING_TEST_FRAMEWORK_PUBLIC autoware_auto_msgs::msg::DetectedObjects to_detected_objects_array(
+  const std::vector<ObjIntersections> & intersections);
+
 /// \brief This is the class which has the APIs to create a representation of Scene
 class TRACKING_TEST_FRAMEWORK_PUBLIC Scene
 {
@@ -55,7 +62,6 @@ public:
   autoware_auto_msgs::msg::DetectedObjects get_detected_objects_array(
     const bool closest_only) const;
 
-private:
   /// \brief Method to get intersection points of the TrackedObject put in the Scene with LiDAR
   /// \param[in] closest_only the boolean to determine if closest intersection to be
   /// returned or all
@@ -63,6 +69,12 @@ private:
   std::vector<ObjIntersections> get_intersections_with_lidar(
     const bool closest_only) const;
 
+  /// \brief Method to get the ground truth state of the TrackedObjects in the Scene
+  /// \return returns the type, position and orientation of each object in the order they were
+  /// passed to the constructor
+  EigenStlVector<ObjectState> get_object_states() const;
+
+private:
   /// Object representing the LiDAR sensor
   Lidar m_lidar;
   /// Vector of TrackedObjects put in the Scene
@@ -44,6 +44,14 @@ struct ObjIntersections
   ObjectType obj_type{};
 };
 
+/// Struct containing the ground truth state of a 2D object at one point in time.
+struct ObjectState
+{
+  ObjectType obj_type{};
+  Eigen::Vector2f position{Eigen::Vector2f::Zero()};
+  autoware::common::types::float32_t orientation{};
+};
+
 /// \brief This is the base class for the Tracked objects
 class TRACKING_TEST_FRAMEWORK_PUBLIC TrackedObject
 {
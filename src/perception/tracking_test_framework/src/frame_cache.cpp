@@ -0,0 +1,359 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <tracking_test_framework/frame_cache.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace tracking_test_framework
+{
+
+using autoware::common::types::float32_t;
+
+namespace
+{
+constexpr char kMagic[8] = {'T', 'T', 'F', 'C', 'A', 'C', 'H', 'E'};
+constexpr uint32_t kVersion = 1U;
+// magic, version, reserved, key and number of frames
+constexpr std::size_t kHeaderSize = 32U;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+// Size of a frame in bytes, see FrameCache for the layout
+uint64_t frame_size(
+  const uint64_t num_objects, const uint64_t num_intersections, const uint64_t num_points)
+{
+  return (2U * sizeof(uint32_t)) + (num_objects * (sizeof(uint32_t) + (3U * sizeof(float32_t)))) +
+         (((2U * num_intersections) + 1U) * sizeof(uint32_t)) +
+         (num_points * 2U * sizeof(float32_t));
+}
+
+template<typename T>
+void write_value(std::ofstream & file, const T & value)
+{
+  file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+bool is_valid_object_type(const uint32_t type)
+{
+  return (type == static_cast<uint32_t>(ObjectType::Car)) ||
+         (type == static_cast<uint32_t>(ObjectType::Pedestrian));
+}
+}  // namespace
+
+std::vector<SceneFrame> record_frames(
+  Scene & scene, const std::size_t num_frames, const std::chrono::milliseconds dt_in_ms,
+  const bool closest_only)
+{
+  std::vector<SceneFrame> frames(num_frames);
+  for (auto & frame : frames) {
+    frame.objects = scene.get_object_states();
+    frame.intersections = scene.get_intersections_with_lidar(closest_only);
+    scene.move_all_objects(dt_in_ms);
+  }
+  return frames;
+}
+
+FrameCacheKey & FrameCacheKey::add(const uint64_t value)
+{
+  add_bytes(&value, sizeof(value));
+  return *this;
+}
+
+FrameCacheKey & FrameCacheKey::add(const float32_t value)
+{
+  add_bytes(&value, sizeof(value));
+  return *this;
+}
+
+FrameCacheKey & FrameCacheKey::add(const std::string & value)
+{
+  // The size separates consecutive strings
+  add(static_cast<uint64_t>(value.size()));
+  add_bytes(value.data(), value.size());
+  return *this;
+}
+
+uint64_t FrameCacheKey::value() const noexcept
+{
+  return m_hash;
+}
+
+void FrameCacheKey::add_bytes(const void * bytes, const std::size_t size)
+{
+  const auto * begin = static_cast<const uint8_t *>(bytes);
+  for (std::size_t i = 0U; i < size; ++i) {
+    m_hash = (m_hash ^ begin[i]) * kFnvPrime;
+  }
+}
+
+FrameView::FrameView(const uint8_t * data)
+: m_header(reinterpret_cast<const uint32_t *>(data))
+{
+  const std::size_t num_objects = m_header[0];
+  const std::size_t num_intersections = m_header[1];
+  m_object_types = m_header + 2U;
+  m_objects = reinterpret_cast<const float32_t *>(m_object_types + num_objects);
+  m_intersection_types = reinterpret_cast<const uint32_t *>(m_objects + (3U * num_objects));
+  m_point_begin = m_intersection_types + num_intersections;
+  m_points = reinterpret_cast<const float32_t *>(m_point_begin + num_intersections + 1U);
+}
+
+std::size_t FrameView::num_objects() const noexcept
+{
+  return m_header[0];
+}
+
+ObjectState FrameView::object_state(const std::size_t index) const
+{
+  if (index >= num_objects()) {
+    throw std::out_of_range{"FrameView: object index out of range"};
+  }
+  const float32_t * values = m_objects + (3U * index);
+  return ObjectState{static_cast<ObjectType>(m_object_types[index]),
+    Eigen::Vector2f{values[0], values[1]}, values[2]};
+}
+
+std::size_t FrameView::num_intersections() const noexcept
+{
+  return m_header[1];
+}
+
+ObjectType FrameView::intersection_type(const std::size_t index) const
+{
+  if (index >= num_intersections()) {
+    throw std::out_of_range{"FrameView: intersection index out of range"};
+  }
+  return static_cast<ObjectType>(m_intersection_types[index]);
+}
+
+FrameView::Points FrameView::intersection_points(const std::size_t index) const
+{
+  if (index >= num_intersections()) {
+    throw std::out_of_range{"FrameView: intersection index out of range"};
+  }
+  const uint32_t begin = m_point_begin[index];
+  return Points{m_points + (2U * begin), 2,
+    static_cast<Eigen::Index>(m_point_begin[index + 1U] - begin)};
+}
+
+SceneFrame FrameView::to_scene_frame() const
+{
+  SceneFrame frame{};
+  frame.objects.reserve(num_objects());
+  for (std::size_t i = 0U; i < num_objects(); ++i) {
+    frame.objects.push_back(object_state(i));
+  }
+  frame.intersections.resize(num_intersections());
+  for (std::size_t i = 0U; i < num_intersections(); ++i) {
+    frame.intersections[i].obj_type = intersection_type(i);
+    const auto points = intersection_points(i);
+    frame.intersections[i].points.reserve(static_cast<std::size_t>(points.cols()));
+    for (Eigen::Index col = 0; col < points.cols(); ++col) {
+      frame.intersections[i].points.emplace_back(points.col(col));
+    }
+  }
+  return frame;
+}
+
+FrameCache::FrameCache(const std::string & path)
+{
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error{"FrameCache: could not open " + path};
+  }
+  struct stat file_stat{};
+  if ((::fstat(fd, &file_stat) != 0) || (file_stat.st_size < static_cast<off_t>(kHeaderSize))) {
+    (void)::close(fd);
+    throw std::runtime_error{"FrameCache: " + path + " is not a frame cache"};
+  }
+  m_size = static_cast<std::size_t>(file_stat.st_size);
+  void * data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the file is closed
+  (void)::close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error{"FrameCache: could not map " + path};
+  }
+  m_data = static_cast<const uint8_t *>(data);
+  try {
+    validate();
+  } catch (const std::runtime_error &) {
+    (void)::munmap(const_cast<uint8_t *>(m_data), m_size);
+    throw std::runtime_error{"FrameCache: " + path + " is not a valid frame cache"};
+  }
+}
+
+FrameCache::~FrameCache()
+{
+  (void)::munmap(const_cast<uint8_t *>(m_data), m_size);
+}
+
+void FrameCache::write(
+  const std::string & path, const uint64_t key, const std::vector<SceneFrame> & frames)
+{
+  // Write to a file of this process first so that a reader never sees a partial file
+  const std::string tmp_path = path + ".tmp" + std::to_string(::getpid());
+  {
+    std::ofstream file{tmp_path, std::ios::binary | std::ios::trunc};
+    if (!file) {
+      throw std::runtime_error{"FrameCache: could not write " + tmp_path};
+    }
+    file.write(kMagic, sizeof(kMagic));
+    write_value(file, kVersion);
+    write_value(file, uint32_t{0U});
+    write_value(file, key);
+    write_value(file, static_cast<uint64_t>(frames.size()));
+    uint64_t offset = kHeaderSize + (frames.size() * sizeof(uint64_t));
+    for (const auto & frame : frames) {
+      write_value(file, offset);
+      std::size_t num_points = 0U;
+      for (const auto & intersection : frame.intersections) {
+        num_points += intersection.points.size();
+      }
+      offset += frame_size(frame.objects.size(), frame.intersections.size(), num_points);
+    }
+    for (const auto & frame : frames) {
+      write_value(file, static_cast<uint32_t>(frame.objects.size()));
+      write_value(file, static_cast<uint32_t>(frame.intersections.size()));
+      for (const auto & object : frame.objects) {
+        write_value(file, static_cast<uint32_t>(object.obj_type));
+      }
+      for (const auto & object : frame.objects) {
+        write_value(file, object.position.x());
+        write_value(file, object.position.y());
+        write_value(file, object.orientation);
+      }
+      for (const auto & intersection : frame.intersections) {
+        write_value(file, static_cast<uint32_t>(intersection.obj_type));
+      }
+      uint32_t point_begin = 0U;
+      write_value(file, point_begin);
+      for (const auto & intersection : frame.intersections) {
+        point_begin += static_cast<uint32_t>(intersection.points.size());
+        write_value(file, point_begin);
+      }
+      for (const auto & intersection : frame.intersections) {
+        for (const auto & point : intersection.points) {
+          write_value(file, point.x());
+          write_value(file, point.y());
+        }
+      }
+    }
+    if (!file) {
+      throw std::runtime_error{"FrameCache: could not write " + tmp_path};
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    (void)std::remove(tmp_path.c_str());
+    throw std::runtime_error{"FrameCache: could not write " + path};
+  }
+}
+
+std::unique_ptr<FrameCache> FrameCache::load_or_record(
+  const std::string & path, const uint64_t key,
+  const std::function<std::vector<SceneFrame>()> & record)
+{
+  try {
+    auto cache = std::make_unique<FrameCache>(path);
+    if (cache->key() == key) {
+      return cache;
+    }
+  } catch (const std::runtime_error &) {
+    // A missing or broken cache is recorded again
+  }
+  write(path, key, record());
+  return std::make_unique<FrameCache>(path);
+}
+
+uint64_t FrameCache::key() const noexcept
+{
+  return *reinterpret_cast<const uint64_t *>(m_data + 16U);
+}
+
+std::size_t FrameCache::num_frames() const noexcept
+{
+  return static_cast<std::size_t>(*reinterpret_cast<const uint64_t *>(m_data + 24U));
+}
+
+FrameView FrameCache::frame(const std::size_t index) const
+{
+  if (index >= num_frames()) {
+    throw std::out_of_range{"FrameCache: frame index out of range"};
+  }
+  const auto * offsets = reinterpret_cast<const uint64_t *>(m_data + kHeaderSize);
+  return FrameView{m_data + offsets[index]};
+}
+
+void FrameCache::validate() const
+{
+  uint32_t version = 0U;
+  std::memcpy(&version, m_data + sizeof(kMagic), sizeof(version));
+  if ((std::memcmp(m_data, kMagic, sizeof(kMagic)) != 0) || (version != kVersion)) {
+    throw std::runtime_error{"wrong magic or version"};
+  }
+  const uint64_t num_frames = *reinterpret_cast<const uint64_t *>(m_data + 24U);
+  if (num_frames > ((m_size - kHeaderSize) / sizeof(uint64_t))) {
+    throw std::runtime_error{"frame offsets out of range"};
+  }
+  const auto * offsets = reinterpret_cast<const uint64_t *>(m_data + kHeaderSize);
+  for (uint64_t i = 0U; i < num_frames; ++i) {
+    const uint64_t offset = offsets[i];
+    if (((offset % sizeof(uint32_t)) != 0U) || (offset > m_size) ||
+      ((m_size - offset) < (2U * sizeof(uint32_t))))
+    {
+      throw std::runtime_error{"frame out of range"};
+    }
+    const auto * header = reinterpret_cast<const uint32_t *>(m_data + offset);
+    // Without points, so that the point offsets can be read once they are known to be in range
+    if (frame_size(header[0], header[1], 0U) > (m_size - offset)) {
+      throw std::runtime_error{"frame out of range"};
+    }
+    const FrameView view{m_data + offset};
+    for (std::size_t j = 0U; j < view.num_objects(); ++j) {
+      if (!is_valid_object_type(header[2U + j])) {
+        throw std::runtime_error{"invalid object type"};
+      }
+    }
+    const auto * intersection_types = header + 2U + (4U * static_cast<uint64_t>(header[0]));
+    const auto * point_begin = intersection_types + header[1];
+    if (point_begin[0] != 0U) {
+      throw std::runtime_error{"invalid point offsets"};
+    }
+    for (std::size_t j = 0U; j < view.num_intersections(); ++j) {
+      if (!is_valid_object_type(intersection_types[j]) || (point_begin[j + 1U] < point_begin[j])) {
+        throw std::runtime_error{"invalid intersection"};
+      }
+    }
+    if (frame_size(header[0], header[1], point_begin[header[1]]) > (m_size - offset)) {
+      throw std::runtime_error{"frame out of range"};
+    }
+  }
+}
+
+}  // namespace tracking_test_framework
+}  // namespace autoware
@@ -46,14 +46,27 @@ std::vector<ObjIntersections> Scene::get_intersections_with_lidar(
   return m_lidar.get_intersections_per_object(m_objects, closest_only);
 }
 
+EigenStlVector<ObjectState> Scene::get_object_states() const
+{
+  EigenStlVector<ObjectState> states{};
+  states.reserve(m_objects.size());
+  for (const auto & object : m_objects) {
+    states.push_back(ObjectState{object->object_type(), object->position(), object->orientation()});
+  }
+  return states;
+}
+
 autoware_auto_msgs::msg::DetectedObjects Scene::get_detected_objects_array(
   const bool closest_only) const
 {
-  std::vector<ObjIntersections> intersections_all_objects =
-    this->get_intersections_with_lidar(closest_only);
+  return to_detected_objects_array(this->get_intersections_with_lidar(closest_only));
+}
 
+autoware_auto_msgs::msg::DetectedObjects to_detected_objects_array(
+  const std::vector<ObjIntersections> & intersections)
+{
   autoware_auto_msgs::msg::DetectedObjects detected_object_msg_array{};
-  for (const auto & intersection_per_object : intersections_all_objects) {
+  for (const auto & intersection_per_object : intersections) {
     /// Fill Shape with all intersections of LiDAR and each object
     geometry_msgs::msg::Polygon polygon{};
     autoware_auto_msgs::msg::BoundingBox bounding_box{};
@@ -17,9 +17,13 @@
 #include <gtest/gtest.h>
 
 #include <geometry/common_2d.hpp>
+#include <tracking_test_framework/frame_cache.hpp>
 #include <tracking_test_framework/scene.hpp>
 
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -216,3 +220,108 @@ TEST(TestTrackingTestFramework, Test1232FixScalingFactor) {
   auto detections_msg = scene.get_detected_objects_array(true);
   ASSERT_EQ(detections_msg.objects.size(), 1U);
 }
+
+namespace
+{
+// Scene with a car and a pedestrian passing by
+autoware::tracking_test_framework::Scene create_scene()
+{
+  autoware::tracking_test_framework::Lidar lidar{Eigen::Vector2f{0.0, 0.0}, 360, 50.0};
+  std::vector<std::unique_ptr<autoware::tracking_test_framework::TrackedObject>> objects;
+  objects.emplace_back(
+    std::make_unique<autoware::tracking_test_framework::Car>(
+      Eigen::Vector2f{10.0, 5.0}, 5, 180.0, 0.0, Eigen::Vector2f{4.5, 1.8}));
+  objects.emplace_back(
+    std::make_unique<autoware::tracking_test_framework::Pedestrian>(
+      Eigen::Vector2f{-5.0, -5.0}, 1, 45.0, 10.0));
+  return autoware::tracking_test_framework::Scene{lidar, std::move(objects)};
+}
+
+std::vector<autoware::tracking_test_framework::SceneFrame> record_scene(std::size_t & num_calls)
+{
+  ++num_calls;
+  auto scene = create_scene();
+  return autoware::tracking_test_framework::record_frames(
+    scene, 10U, std::chrono::milliseconds{100}, false);
+}
+}  // namespace
+
+TEST(TestTrackingTestFramework, TestFrameCacheReplaysRecordedFrames) {
+  using autoware::tracking_test_framework::FrameCache;
+  const std::string path{"/tmp/test_tracking_test_framework_replay.ttfcache"};
+  (void)std::remove(path.c_str());
+  const auto key = autoware::tracking_test_framework::FrameCacheKey{}.add("replay").add(
+    uint64_t{10U}).add(0.1F).value();
+  std::size_t num_calls = 0U;
+  const auto record = [&num_calls]() {return record_scene(num_calls);};
+
+  const auto cache = FrameCache::load_or_record(path, key, record);
+  EXPECT_EQ(num_calls, 1U);
+  EXPECT_EQ(cache->key(), key);
+  ASSERT_EQ(cache->num_frames(), 10U);
+  // A cache with the same key is replayed without recording it again
+  const auto replayed_cache = FrameCache::load_or_record(path, key, record);
+  EXPECT_EQ(num_calls, 1U);
+  EXPECT_THROW(replayed_cache->frame(10U), std::out_of_range);
+
+  auto scene = create_scene();
+  for (std::size_t i = 0U; i < replayed_cache->num_frames(); ++i) {
+    const auto frame = replayed_cache->frame(i);
+    const auto states = scene.get_object_states();
+    ASSERT_EQ(frame.num_objects(), states.size());
+    for (std::size_t j = 0U; j < states.size(); ++j) {
+      EXPECT_EQ(frame.object_state(j).obj_type, states[j].obj_type);
+      EXPECT_EQ(frame.object_state(j).position, states[j].position);
+      EXPECT_EQ(frame.object_state(j).orientation, states[j].orientation);
+    }
+    const auto intersections = scene.get_intersections_with_lidar(false);
+    ASSERT_EQ(frame.num_intersections(), intersections.size());
+    for (std::size_t j = 0U; j < intersections.size(); ++j) {
+      EXPECT_EQ(frame.intersection_type(j), intersections[j].obj_type);
+      const auto points = frame.intersection_points(j);
+      ASSERT_EQ(static_cast<std::size_t>(points.cols()), intersections[j].points.size());
+      for (Eigen::Index col = 0; col < points.cols(); ++col) {
+        EXPECT_EQ(points.col(col), intersections[j].points[static_cast<std::size_t>(col)]);
+      }
+    }
+    // The cached frame gives the same detections as the scene
+    const auto cached_detections = autoware::tracking_test_framework::to_detected_objects_array(
+      frame.to_scene_frame().intersections);
+    const auto detections = scene.get_detected_objects_array(false);
+    ASSERT_EQ(cached_detections.objects.size(), detections.objects.size());
+    for (std::size_t j = 0U; j < detections.objects.size(); ++j) {
+      EXPECT_EQ(
+        cached_detections.objects[j].kinematics.centroid_position.x,
+        detections.objects[j].kinematics.centroid_position.x);
+      EXPECT_EQ(
+        cached_detections.objects[j].kinematics.centroid_position.y,
+        detections.objects[j].kinematics.centroid_position.y);
+    }
+    scene.move_all_objects(std::chrono::milliseconds{100});
+  }
+  (void)std::remove(path.c_str());
+}
+
+TEST(TestTrackingTestFramework, TestFrameCacheRecordsStaleOrBrokenFiles) {
+  using autoware::tracking_test_framework::FrameCache;
+  const std::string path{"/tmp/test_tracking_test_framework_stale.ttfcache"};
+  std::size_t num_calls = 0U;
+  const auto record = [&num_calls]() {return record_scene(num_calls);};
+  FrameCache::write(path, 1U, record());
+  EXPECT_EQ(num_calls, 1U);
+
+  // A different key means that the frames were generated with other parameters
+  EXPECT_EQ(FrameCache::load_or_record(path, 2U, record)->key(), 2U);
+  EXPECT_EQ(num_calls, 2U);
+
+  // A truncated file is not a valid cache
+  {
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    file << "TTFCACHE";
+  }
+  EXPECT_THROW(FrameCache{path}, std::runtime_error);
+  const auto cache = FrameCache::load_or_record(path, 2U, record);
+  EXPECT_EQ(num_calls, 3U);
+  EXPECT_EQ(cache->num_frames(), 10U);
+  (void)std::remove(path.c_str());
+}
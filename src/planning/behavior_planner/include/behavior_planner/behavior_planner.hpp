@@ -104,6 +104,13 @@ public:
   bool8_t is_vehicle_stopped(const State & state);
 
   RouteWithType get_current_subroute(const State & ego_state);
+  /// \brief Whether there is a subroute after the current one
+  bool8_t has_next_subroute() const;
+  /// \brief Subroute after the current one, starting at the goal of the current subroute, which
+  ///        is where the vehicle will be when the next subroute becomes current
+  /// \param[in] ego_state State of the vehicle, for the header of the route
+  /// \return The next subroute, or an empty one if there is none
+  RouteWithType get_next_subroute(const State & ego_state) const;
   PlannerType get_planner_type();
   uchar8_t get_desired_gear(const State & state);
   std::vector<RouteWithType> get_subroutes();
@@ -115,7 +122,8 @@ public:
   size_t get_remaining_length(const State & state);
 
 private:
-  RouteWithType get_current_subroute();
+  /// \brief Goal of the current subroute, without copying the subroute
+  const RoutePoint & get_current_subroute_goal() const;
 
   /// \brief Function to calculate if target parking orientation is HEAD_IN or TOE_IN
   /// \param[in] parking_point RoutePoint with heading for the target parking location
@@ -25,6 +25,7 @@
 #include <autoware_auto_msgs/msg/had_map_route.hpp>
 #include <autoware_auto_msgs/msg/trajectory.hpp>
 #include <autoware_auto_msgs/msg/vehicle_kinematic_state.hpp>
+#include <autoware_auto_msgs/msg/vehicle_state_command.hpp>
 
 #include <iostream>
 #include <vector>
@@ -39,6 +40,7 @@ using autoware_auto_msgs::msg::Trajectory;
 using autoware_auto_msgs::msg::TrajectoryPoint;
 using State = autoware_auto_msgs::msg::VehicleKinematicState;
 
+using autoware::common::types::uchar8_t;
 using autoware::common::types::bool8_t;
 using autoware::common::types::float32_t;
 
@@ -66,12 +68,17 @@ public:
   void set_trajectory(const Trajectory & trajectory);
   Trajectory get_trajectory(const State & state);
   size_t get_remaining_length(const State & state);
+  /// \brief Gear of the trajectory that get_trajectory returns for the state, without building it
+  uchar8_t get_desired_gear(const State & state);
   bool8_t is_trajectory_ready();
   bool8_t has_arrived_subgoal(const State & state);
 
 private:
   void set_sub_trajectories();
+  void set_sub_trajectory_lookups();
+  void select_sub_trajectory(const State & state);
   std::size_t get_closest_state(const State & state, const Trajectory & trajectory);
+  std::size_t get_crop_index(const Trajectory & trajectory, const State & state);
   Trajectory crop_from_current_state(const Trajectory & trajectory, const State & state);
   void set_time_from_start(Trajectory * trajectory);
 
@@ -80,6 +87,12 @@ private:
   Trajectory m_trajectory;
   std::vector<Trajectory> m_sub_trajectories;
   size_t m_selected_trajectory;
+
+  // Lookups that are computed once when the trajectory is set, since they are needed on every
+  // state update: the number of points in the sub trajectories after each sub trajectory, and the
+  // gear to drive with from each point of each sub trajectory on
+  std::vector<size_t> m_remaining_points_after;
+  std::vector<std::vector<uchar8_t>> m_sub_trajectory_gears;
 };
 
 }  // namespace behavior_planner
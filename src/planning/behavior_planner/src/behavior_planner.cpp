@@ -265,12 +265,30 @@ RouteWithType BehaviorPlanner::get_current_subroute(const State & ego_state)
   return updated_subroute;
 }
 
-RouteWithType BehaviorPlanner::get_current_subroute()
+bool8_t BehaviorPlanner::has_next_subroute() const
 {
-  if (!is_route_ready()) {
+  return (m_current_subroute + 1) < m_subroutes.size();
+}
+
+RouteWithType BehaviorPlanner::get_next_subroute(const State & ego_state) const
+{
+  if (!has_next_subroute()) {
     return RouteWithType();
   }
-  return m_subroutes.at(m_current_subroute);
+  // the stored start point is the goal of the current subroute for every planner type
+  auto next_subroute = m_subroutes.at(m_current_subroute + 1);
+  next_subroute.route.header = ego_state.header;
+  return next_subroute;
+}
+
+const RoutePoint & BehaviorPlanner::get_current_subroute_goal() const
+{
+  // goal of an empty subroute when there is no route
+  static const RoutePoint no_goal{};
+  if (m_subroutes.empty()) {
+    return no_goal;
+  }
+  return m_subroutes.at(m_current_subroute).route.goal_point;
 }
 
 ParkingDirection BehaviorPlanner::get_parking_direction(
@@ -335,12 +353,12 @@ bool8_t BehaviorPlanner::has_arrived_subroute_goal(const State & state)
 {
   const auto satisfy_velocity_condition = is_vehicle_stopped(state);
 
-  const auto & route = get_current_subroute().route;
+  const auto & goal_point = get_current_subroute_goal();
   RoutePoint state_route_point;
   state_route_point.heading = state.state.heading;
   state_route_point.position.x = state.state.x;
   state_route_point.position.y = state.state.y;
-  const auto distance = norm_2d(minus_2d(route.goal_point.position, state_route_point.position));
+  const auto distance = norm_2d(minus_2d(goal_point.position, state_route_point.position));
   const auto satsify_distance_condition = distance < m_config.goal_distance_thresh;
 
   return satisfy_velocity_condition && satsify_distance_condition;
@@ -373,12 +391,12 @@ void BehaviorPlanner::set_trajectory(const Trajectory & trajectory)
   m_trajectory_manager.set_trajectory(trajectory);
 
   const auto & last_point = trajectory.points.back();
-  const auto & route = get_current_subroute().route;
+  const auto & goal_point = get_current_subroute_goal();
   RoutePoint last_route_point;
   last_route_point.heading = last_point.heading;
   last_route_point.position.x = last_point.x;
   last_route_point.position.y = last_point.y;
-  const auto distance = norm_2d(minus_2d(route.goal_point.position, last_route_point.position));
+  const auto distance = norm_2d(minus_2d(goal_point.position, last_route_point.position));
   m_is_trajectory_complete = distance < m_config.goal_distance_thresh;
 }
 
@@ -394,16 +412,7 @@ size_t BehaviorPlanner::get_remaining_length(const State & state)
 
 uchar8_t BehaviorPlanner::get_desired_gear(const State & state)
 {
-  const auto trajectory = get_trajectory(state);
-  for (const auto & pt : trajectory.points) {
-    if (pt.longitudinal_velocity_mps > std::numeric_limits<float32_t>::epsilon()) {
-      return VehicleStateCommand::GEAR_DRIVE;
-    }
-    if (pt.longitudinal_velocity_mps < -std::numeric_limits<float32_t>::epsilon()) {
-      return VehicleStateCommand::GEAR_REVERSE;
-    }
-  }
-  return VehicleStateCommand::GEAR_DRIVE;
+  return m_trajectory_manager.get_desired_gear(state);
 }
 
 std::vector<RouteWithType> BehaviorPlanner::get_subroutes()
@@ -27,6 +27,7 @@ namespace behavior_planner
 using autoware::common::geometry::minus_2d;
 using autoware::common::geometry::norm_2d;
 using motion::motion_common::to_angle;
+using autoware_auto_msgs::msg::VehicleStateCommand;
 
 TrajectoryManager::TrajectoryManager(const PlannerConfig & config)
 : m_config(config)
@@ -38,6 +39,8 @@ void TrajectoryManager::clear_trajectory()
   m_trajectory.points.clear();
   m_sub_trajectories.clear();
   m_selected_trajectory = 0;
+  m_remaining_points_after.clear();
+  m_sub_trajectory_gears.clear();
 }
 
 void TrajectoryManager::set_trajectory(const Trajectory & trajectory)
@@ -45,6 +48,34 @@ void TrajectoryManager::set_trajectory(const Trajectory & trajectory)
   clear_trajectory();
   m_trajectory = trajectory;
   set_sub_trajectories();
+  set_sub_trajectory_lookups();
+}
+
+void TrajectoryManager::set_sub_trajectory_lookups()
+{
+  m_remaining_points_after.assign(m_sub_trajectories.size(), 0U);
+  for (size_t i = m_sub_trajectories.size(); i > 1U; i--) {
+    m_remaining_points_after[i - 2U] =
+      m_remaining_points_after[i - 1U] + m_sub_trajectories[i - 1U].points.size();
+  }
+
+  // the gear from a point on is given by the first point that is not at rest
+  m_sub_trajectory_gears.resize(m_sub_trajectories.size());
+  for (size_t i = 0U; i < m_sub_trajectories.size(); i++) {
+    const auto & points = m_sub_trajectories[i].points;
+    auto & gears = m_sub_trajectory_gears[i];
+    gears.resize(points.size());
+    uchar8_t gear = VehicleStateCommand::GEAR_DRIVE;
+    for (size_t j = points.size(); j > 0U; j--) {
+      const auto velocity = points[j - 1U].longitudinal_velocity_mps;
+      if (velocity > std::numeric_limits<float32_t>::epsilon()) {
+        gear = VehicleStateCommand::GEAR_DRIVE;
+      } else if (velocity < -std::numeric_limits<float32_t>::epsilon()) {
+        gear = VehicleStateCommand::GEAR_REVERSE;
+      }
+      gears[j - 1U] = gear;
+    }
+  }
 }
 
 void TrajectoryManager::set_sub_trajectories()
@@ -121,27 +152,29 @@ size_t TrajectoryManager::get_remaining_length(const State & state)
   // remaining length of current selected sub trajectory
   const auto & current_trajectory = m_sub_trajectories.at(m_selected_trajectory);
   const size_t closest_index = get_closest_state(state, current_trajectory);
-  size_t remaining_length = current_trajectory.points.size() - closest_index;
 
   // remaining length including rest of sub trajectories
-  for (size_t i = m_selected_trajectory + 1; i < m_sub_trajectories.size(); i++) {
-    remaining_length += m_sub_trajectories.at(i).points.size();
-  }
-
-  return remaining_length;
+  return current_trajectory.points.size() - closest_index +
+         m_remaining_points_after.at(m_selected_trajectory);
 }
 
-Trajectory TrajectoryManager::crop_from_current_state(
-  const Trajectory & trajectory,
-  const State & state)
+std::size_t TrajectoryManager::get_crop_index(const Trajectory & trajectory, const State & state)
 {
-  if (trajectory.points.empty()) {return trajectory;}
   auto index = get_closest_state(state, trajectory);
 
   // we always want trajectory to start from front of vehicle so increment index
   if (index + 1 < trajectory.points.size()) {
     index += 1;
   }
+  return index;
+}
+
+Trajectory TrajectoryManager::crop_from_current_state(
+  const Trajectory & trajectory,
+  const State & state)
+{
+  if (trajectory.points.empty()) {return trajectory;}
+  const auto index = get_crop_index(trajectory, state);
 
   Trajectory output;
   output.header = trajectory.header;
@@ -179,7 +212,7 @@ void TrajectoryManager::set_time_from_start(Trajectory * trajectory)
   }
 }
 
-Trajectory TrajectoryManager::get_trajectory(const State & state)
+void TrajectoryManager::select_sub_trajectory(const State & state)
 {
   // select new sub_trajectory when vehicle is at stop
   if (std::abs(state.state.longitudinal_velocity_mps) < m_config.stop_velocity_thresh) {
@@ -192,6 +225,11 @@ Trajectory TrajectoryManager::get_trajectory(const State & state)
       m_selected_trajectory = std::min(m_selected_trajectory, m_sub_trajectories.size() - 1);
     }
   }
+}
+
+Trajectory TrajectoryManager::get_trajectory(const State & state)
+{
+  select_sub_trajectory(state);
 
   // TODO(mitsudome-r) implement trajectory refine functions if needed to integrate with controller
   const auto & input = m_sub_trajectories.at(m_selected_trajectory);
@@ -200,5 +238,17 @@ Trajectory TrajectoryManager::get_trajectory(const State & state)
   return output;
 }
 
+uchar8_t TrajectoryManager::get_desired_gear(const State & state)
+{
+  select_sub_trajectory(state);
+
+  // the gear of the cropped trajectory is the gear from its first point on
+  const auto & input = m_sub_trajectories.at(m_selected_trajectory);
+  if (input.points.empty()) {
+    return VehicleStateCommand::GEAR_DRIVE;
+  }
+  return m_sub_trajectory_gears.at(m_selected_trajectory).at(get_crop_index(input, state));
+}
+
 }  // namespace behavior_planner
 }  // namespace autoware
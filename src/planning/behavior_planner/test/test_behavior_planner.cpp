@@ -18,3 +18,37 @@
 TEST(test_behavior_planner, test_hello) {
   // EXPECT_EQ(autoware::behavior_planner::print_hello(), 0);
 }
+
+TEST(test_trajectory_manager, remaining_length_and_gear) {
+  using autoware::behavior_planner::PlannerConfig;
+  using autoware::behavior_planner::State;
+  using autoware::behavior_planner::Trajectory;
+  using autoware::behavior_planner::TrajectoryManager;
+  using autoware::behavior_planner::TrajectoryPoint;
+  using autoware_auto_msgs::msg::VehicleStateCommand;
+
+  const PlannerConfig config{0.5F, 0.1F, 0.1F, 0.0F, 0.0F, 0.0F};
+  TrajectoryManager manager(config);
+
+  // drive forward for 10 points, then reverse for 5 points
+  Trajectory trajectory;
+  for (size_t i = 0; i < 15; i++) {
+    TrajectoryPoint point;
+    point.x = (i < 10) ? static_cast<float32_t>(i) : static_cast<float32_t>(18 - i);
+    point.longitudinal_velocity_mps = (i < 10) ? 1.0F : -1.0F;
+    trajectory.points.push_back(point);
+  }
+  manager.set_trajectory(trajectory);
+
+  // at the start, all points of both sub trajectories remain
+  State state;
+  state.state.longitudinal_velocity_mps = 1.0F;
+  EXPECT_EQ(manager.get_desired_gear(state), VehicleStateCommand::GEAR_DRIVE);
+  EXPECT_EQ(manager.get_remaining_length(state), 15U);
+
+  // stopping at the end of the forward part selects the reverse part
+  state.state.x = 9.0F;
+  state.state.longitudinal_velocity_mps = 0.0F;
+  EXPECT_EQ(manager.get_desired_gear(state), VehicleStateCommand::GEAR_REVERSE);
+  EXPECT_EQ(manager.get_remaining_length(state), 5U);
+}
@@ -109,6 +109,13 @@ private:
   // bools to manage states
   bool8_t m_requesting_trajectory;
 
+  // trajectory of the next subroute, requested while the current subroute is driven
+  enum class PrefetchState {IDLE, REQUESTING, READY, FAILED};
+  bool8_t m_prefetch_next_subroute;
+  float32_t m_prefetch_max_start_drift;
+  PrefetchState m_prefetch_state{PrefetchState::IDLE};
+  Trajectory m_prefetched_trajectory;
+
   // transforms
   std::shared_ptr<tf2_ros::Buffer> m_tf_buffer;
   std::shared_ptr<tf2_ros::TransformListener> m_tf_listener;
@@ -128,12 +135,17 @@ private:
     PlanTrajectoryGoalHandle::SharedPtr goal_handle,
     const std::shared_ptr<const PlanTrajectoryAction::Feedback> feedback);
   void result_callback(const PlanTrajectoryGoalHandle::WrappedResult & result);
+  void prefetch_goal_response_callback(
+    std::shared_future<PlanTrajectoryGoalHandle::SharedPtr> future);
+  void prefetch_result_callback(const PlanTrajectoryGoalHandle::WrappedResult & result);
 
   // other functions
   void init();
   Trajectory refine_trajectory(const State & ego_state, const Trajectory & input);
   State transform_to_map(const State & state);
-  void request_trajectory(const RouteWithType & route_with_type);
+  void request_trajectory(const RouteWithType & route_with_type, const bool8_t prefetch = false);
+  /// \brief Make the next subroute current, with its prefetched trajectory if it is still valid
+  void switch_to_next_subroute();
 };
 }  // namespace behavior_planner_nodes
 }  // namespace autoware
@@ -61,6 +61,10 @@ void BehaviorPlannerNode::init()
 
   m_planner = std::make_unique<behavior_planner::BehaviorPlanner>(config);
 
+  m_prefetch_next_subroute = declare_parameter("prefetch_next_subroute", true);
+  m_prefetch_max_start_drift = static_cast<float32_t>(
+    declare_parameter("prefetch_max_start_drift", 1.0));
+
   // Setup Tf Buffer with listener
   rclcpp::Clock::SharedPtr clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
   m_tf_buffer = std::make_shared<tf2_ros::Buffer>(clock);
@@ -187,6 +191,61 @@ void BehaviorPlannerNode::result_callback(const PlanTrajectoryGoalHandle::Wrappe
   m_requesting_trajectory = false;
 }
 
+void BehaviorPlannerNode::prefetch_goal_response_callback(
+  std::shared_future<PlanTrajectoryGoalHandle::SharedPtr> future)
+{
+  if (!future.get()) {
+    RCLCPP_ERROR(get_logger(), "Prefetch goal was rejected by server");
+    m_prefetch_state = PrefetchState::FAILED;
+  }
+}
+
+void BehaviorPlannerNode::prefetch_result_callback(
+  const PlanTrajectoryGoalHandle::WrappedResult & result)
+{
+  if (result.result->result == PlanTrajectoryAction::Result::SUCCESS &&
+    !result.result->trajectory.points.empty())
+  {
+    RCLCPP_INFO(get_logger(), "Received trajectory of next subroute from planner");
+    m_prefetched_trajectory = result.result->trajectory;
+    m_prefetch_state = PrefetchState::READY;
+  } else {
+    // it is requested again on arrival at the subroute goal
+    RCLCPP_WARN(get_logger(), "Planner failed to calculate trajectory of next subroute");
+    m_prefetch_state = PrefetchState::FAILED;
+  }
+}
+
+void BehaviorPlannerNode::switch_to_next_subroute()
+{
+  m_planner->set_next_subroute();
+  bool8_t use_prefetched = m_prefetch_state == PrefetchState::READY;
+  m_prefetch_state = PrefetchState::IDLE;
+  if (use_prefetched) {
+    // the trajectory starts at the goal of the previous subroute, which the vehicle may have
+    // stopped short of or passed
+    using autoware::common::geometry::minus_2d;
+    using autoware::common::geometry::norm_2d;
+    const auto & start_point = m_prefetched_trajectory.points.front();
+    const auto drift = norm_2d(minus_2d(start_point, m_ego_state.state));
+    use_prefetched = drift < m_prefetch_max_start_drift;
+    if (!use_prefetched) {
+      RCLCPP_INFO(get_logger(), "Vehicle drifted from prefetched trajectory, requesting again");
+    }
+  }
+
+  if (use_prefetched) {
+    auto trajectory = m_prefetched_trajectory;
+    trajectory.header.frame_id = "map";
+    m_debug_trajectory_pub->publish(trajectory);
+    m_planner->set_trajectory(m_prefetched_trajectory);
+    m_debug_subroute_pub->publish(m_planner->get_current_subroute(m_ego_state).route);
+  } else {
+    request_trajectory(m_planner->get_current_subroute(m_ego_state));
+    m_requesting_trajectory = true;
+  }
+}
+
 State BehaviorPlannerNode::transform_to_map(const State & state)
 {
   geometry_msgs::msg::TransformStamped tf;
@@ -207,7 +266,9 @@ State BehaviorPlannerNode::transform_to_map(const State & state)
   return transformed_state;
 }
 
-void BehaviorPlannerNode::request_trajectory(const RouteWithType & route_with_type)
+void BehaviorPlannerNode::request_trajectory(
+  const RouteWithType & route_with_type,
+  const bool8_t prefetch)
 {
   using std::placeholders::_1;
   using std::placeholders::_2;
@@ -220,12 +281,16 @@ void BehaviorPlannerNode::request_trajectory(const RouteWithType & route_with_ty
 
   auto send_goal_options = rclcpp_action::Client<PlanTrajectoryAction>::SendGoalOptions();
   send_goal_options.goal_response_callback = std::bind(
+    prefetch ? &BehaviorPlannerNode::prefetch_goal_response_callback :
     &BehaviorPlannerNode::goal_response_callback,
     this, _1);
   send_goal_options.feedback_callback = std::bind(
     &BehaviorPlannerNode::feedback_callback, this, _1,
     _2);
-  send_goal_options.result_callback = std::bind(&BehaviorPlannerNode::result_callback, this, _1);
+  send_goal_options.result_callback = std::bind(
+    prefetch ? &BehaviorPlannerNode::prefetch_result_callback :
+    &BehaviorPlannerNode::result_callback,
+    this, _1);
 
   switch (planner_type) {
     case behavior_planner::PlannerType::LANE:
@@ -239,7 +304,10 @@ void BehaviorPlannerNode::request_trajectory(const RouteWithType & route_with_ty
     default:
       break;
   }
-  m_debug_subroute_pub->publish(route);
+  // the debug subroute is the driven one, the prefetched one is published when it becomes current
+  if (!prefetch) {
+    m_debug_subroute_pub->publish(route);
+  }
 }
 
 void BehaviorPlannerNode::on_ego_state(const State::SharedPtr & msg)
@@ -271,14 +339,25 @@ void BehaviorPlannerNode::on_ego_state(const State::SharedPtr & msg)
       }
       RCLCPP_INFO_ONCE(get_logger(), "Reached goal. Wait for another route");
     } else if (m_planner->has_arrived_subroute_goal(m_ego_state)) {
-      // send next subroute
-      m_planner->set_next_subroute();
-      request_trajectory(m_planner->get_current_subroute(m_ego_state));
-      m_requesting_trajectory = true;
+      // send next subroute, or wait for it if it is being prefetched already
+      if (m_prefetch_state != PrefetchState::REQUESTING) {
+        switch_to_next_subroute();
+      }
     } else if (m_planner->needs_new_trajectory(m_ego_state)) {
       // update trajectory for current subroute
       request_trajectory(m_planner->get_current_subroute(m_ego_state));
       m_requesting_trajectory = true;
+    } else if (m_prefetch_next_subroute && (m_prefetch_state == PrefetchState::IDLE) &&
+      m_planner->has_next_subroute())
+    {
+      // plan the next subroute while the current one is driven, so that it is ready on arrival
+      const auto next_subroute = m_planner->get_next_subroute(m_ego_state);
+      if (next_subroute.planner_type == PlannerType::UNKNOWN) {
+        m_prefetch_state = PrefetchState::FAILED;
+      } else {
+        request_trajectory(next_subroute, true);
+        m_prefetch_state = PrefetchState::REQUESTING;
+      }
     }
   }
 
@@ -340,7 +419,7 @@ void BehaviorPlannerNode::on_vehicle_state_report(const VehicleStateReport::Shar
 
 void BehaviorPlannerNode::on_route(const HADMapRoute::SharedPtr & msg)
 {
-  if (m_requesting_trajectory) {
+  if (m_requesting_trajectory || (m_prefetch_state == PrefetchState::REQUESTING)) {
     RCLCPP_ERROR(
       get_logger(),
       "Route was rejected. Route cannot be updated while communicating with trajectory planners.");
@@ -393,6 +472,7 @@ void BehaviorPlannerNode::map_response(rclcpp::Client<HADMapService>::SharedFutu
 
   // TODO(mitsudome-r) move to handle_accepted() when synchronous service is available
   m_planner->set_route(*m_route, m_lanelet_map_ptr);
+  m_prefetch_state = PrefetchState::IDLE;
 
   const auto subroutes = m_planner->get_subroutes();
   Trajectory checkpoints;
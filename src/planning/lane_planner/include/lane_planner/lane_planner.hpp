@@ -33,6 +33,7 @@
 #include <lanelet2_core/primitives/Point.h>
 
 #include <iostream>
+#include <unordered_map>
 #include <vector>
 
 namespace autoware
@@ -72,6 +73,17 @@ struct LANE_PLANNER_PUBLIC LanePlannerConfig
   float32_t trajectory_resolution;
 };
 
+/// \brief Fine centerline of a lanelet, which is kept for the following plans on the same route
+struct LANE_PLANNER_PUBLIC LaneletCenterline
+{
+  /// Bounds of the lanelet the centerline was generated from, to detect a change of the map
+  lanelet::BasicLineString3d left_bound;
+  lanelet::BasicLineString3d right_bound;
+  lanelet::LineString3d centerline;
+  /// Length of the centerline up to each point
+  std::vector<float64_t> accumulated_lengths;
+};
+
 /// \brief A class for recording trajectories and replaying them as plans
 class LANE_PLANNER_PUBLIC LanePlanner
 {
@@ -91,6 +103,13 @@ private:
 
   TrajectorySmoother m_trajectory_smoother;
 
+  // Centerlines of the lanelets that the previous plan went through, by lanelet id
+  std::unordered_map<lanelet::Id, LaneletCenterline> m_centerline_cache;
+
+  const LaneletCenterline & get_centerline(
+    const lanelet::ConstLanelet & lanelet,
+    std::unordered_map<lanelet::Id, LaneletCenterline> & centerlines);
+
   // trajectory planning sub functions
   TrajectoryPoints generate_base_trajectory(
     const HADMapRoute & had_map_route,
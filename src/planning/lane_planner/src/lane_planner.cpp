@@ -21,6 +21,8 @@
 #include <geometry/common_2d.hpp>
 #include <limits>
 #include <algorithm>
+#include <unordered_map>
+#include <utility>
 
 namespace autoware
 {
@@ -174,13 +176,17 @@ TrajectoryPoints LanePlanner::generate_base_trajectory(
     lanelet::Locations::Germany,
     lanelet::Participants::Vehicle);
 
+  // Only the points that fit into the trajectory message are needed, plus one that the heading and
+  // the steering angle of the last of them are computed from
+  const auto max_points = static_cast<size_t>(Trajectory::CAPACITY) + 1U;
+  std::unordered_map<lanelet::Id, LaneletCenterline> centerlines;
+
   // set position and velocity
   trajectory_points.push_back(trajectory_start_point);
   for (size_t i = start_index; i < lanelets.size(); i++) {
     const auto & lanelet = lanelets.at(i);
-    const auto & centerline = autoware::common::had_map_utils::generateFineCenterline(
-      lanelet,
-      m_planner_config.trajectory_resolution);
+    const auto & lanelet_centerline = get_centerline(lanelet, centerlines);
+    const auto & centerline = lanelet_centerline.centerline;
     const auto speed_limit =
       static_cast<float32_t>(traffic_rules_ptr->speedLimit(lanelet).speedLimit.value());
 
@@ -197,21 +203,74 @@ TrajectoryPoints LanePlanner::generate_base_trajectory(
       end_length = lanelet::geometry::toArcCoordinates(to2D(centerline), to2D(goal_point)).length;
     }
 
-    float64_t accumulated_length = 0;
     // skip first point to avoid inserting overlaps
     for (size_t j = 1; j < centerline.size(); j++) {
-      const auto llt_prev_pt = centerline[j - 1];
-      const auto llt_pt = centerline[j];
-      accumulated_length += lanelet::geometry::distance2d(to2D(llt_prev_pt), to2D(llt_pt));
+      const auto accumulated_length = lanelet_centerline.accumulated_lengths[j];
       if (accumulated_length < start_length) {continue;}
       if (accumulated_length > end_length) {break;}
-      trajectory_points.push_back(convertToTrajectoryPoint(llt_pt, speed_limit));
+      trajectory_points.push_back(convertToTrajectoryPoint(centerline[j], speed_limit));
+      if (trajectory_points.size() == max_points) {
+        // the rest of the route, including the goal point, would be cut from the message anyway
+        m_centerline_cache = std::move(centerlines);
+        return trajectory_points;
+      }
     }
   }
+  m_centerline_cache = std::move(centerlines);
   trajectory_points.push_back(trajectory_goal_point);
   return trajectory_points;
 }
 
+const LaneletCenterline & LanePlanner::get_centerline(
+  const lanelet::ConstLanelet & lanelet,
+  std::unordered_map<lanelet::Id, LaneletCenterline> & centerlines)
+{
+  using lanelet::utils::to2D;
+
+  const auto to_basic_line_string = [](const lanelet::ConstLineString3d & line_string) {
+      lanelet::BasicLineString3d basic_line_string;
+      basic_line_string.reserve(line_string.size());
+      for (const auto & point : line_string) {
+        basic_line_string.push_back(point.basicPoint());
+      }
+      return basic_line_string;
+    };
+  auto left_bound = to_basic_line_string(lanelet.leftBound());
+  auto right_bound = to_basic_line_string(lanelet.rightBound());
+  const auto has_bounds = [&left_bound, &right_bound](const LaneletCenterline & other) {
+      return other.left_bound == left_bound && other.right_bound == right_bound;
+    };
+
+  // reuse the centerline if the route passed the lanelet before, or if the previous plan went
+  // through it and the lanelet did not change
+  const auto current = centerlines.find(lanelet.id());
+  if (current != centerlines.end() && has_bounds(current->second)) {
+    return current->second;
+  }
+  const auto cached = m_centerline_cache.find(lanelet.id());
+  if (current == centerlines.end() && cached != m_centerline_cache.end() &&
+    has_bounds(cached->second))
+  {
+    return centerlines.emplace(lanelet.id(), std::move(cached->second)).first->second;
+  }
+
+  LaneletCenterline lanelet_centerline;
+  lanelet_centerline.left_bound = std::move(left_bound);
+  lanelet_centerline.right_bound = std::move(right_bound);
+  lanelet_centerline.centerline = autoware::common::had_map_utils::generateFineCenterline(
+    lanelet,
+    m_planner_config.trajectory_resolution);
+  const auto & centerline = lanelet_centerline.centerline;
+  lanelet_centerline.accumulated_lengths.resize(centerline.size(), 0.0);
+  for (size_t j = 1; j < centerline.size(); j++) {
+    lanelet_centerline.accumulated_lengths[j] = lanelet_centerline.accumulated_lengths[j - 1] +
+      lanelet::geometry::distance2d(to2D(centerline[j - 1]), to2D(centerline[j]));
+  }
+  auto & entry = centerlines[lanelet.id()];
+  entry = std::move(lanelet_centerline);
+  return entry;
+}
+
 void LanePlanner::set_angle(TrajectoryPoints * trajectory_points)
 {
   for (size_t i = 0; i < trajectory_points->size(); i++) {
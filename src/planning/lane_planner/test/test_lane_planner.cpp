@@ -188,3 +188,29 @@ TEST_F(LanePlannerTest, PlanInvalidRoute)
   // return trajectory should be empty if there is no valid lane
   ASSERT_TRUE(trajectory.points.empty());
 }
+
+TEST_F(LanePlannerTest, PlanLongTrajectory)
+{
+  using autoware_auto_msgs::msg::Trajectory;
+
+  // create map with a lane that is longer than the trajectory
+  const auto lane_id = lanelet::utils::getId();
+  constexpr float64_t velocity_mps = 1.0;
+  constexpr size_t n_points = 500;
+  const auto lanelet_map_ptr = getALaneletMapWithLaneId(lane_id, velocity_mps, n_points);
+  const auto had_map_route = getARoute(lane_id, 499.0F);
+
+  // the trajectory is cut to the capacity of the message
+  const auto trajectory = m_planner_ptr->plan_trajectory(had_map_route, lanelet_map_ptr);
+  ASSERT_EQ(trajectory.points.size(), static_cast<size_t>(Trajectory::CAPACITY));
+
+  // the next plan reuses the centerline of the lane and gives the same trajectory
+  const auto replanned_trajectory =
+    m_planner_ptr->plan_trajectory(had_map_route, lanelet_map_ptr);
+  EXPECT_TRUE(trajectory == replanned_trajectory);
+
+  // the centerline is generated again when the lane with the same id changes
+  const auto shorter_map_ptr = getALaneletMapWithLaneId(lane_id, velocity_mps, 50U);
+  const auto shorter_trajectory = m_planner_ptr->plan_trajectory(had_map_route, shorter_map_ptr);
+  EXPECT_LT(shorter_trajectory.points.size(), static_cast<size_t>(Trajectory::CAPACITY));
+}
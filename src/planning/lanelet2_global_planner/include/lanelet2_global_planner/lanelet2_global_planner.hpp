@@ -30,10 +30,14 @@
 #include <lanelet2_global_planner/visibility_control.hpp>
 #include <autoware_auto_msgs/msg/trajectory_point.hpp>
 #include <common/types.hpp>
+#include <had_map_utils/had_map_index.hpp>
 // c++
 #include <chrono>
 #include <string>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 #include <cmath>
 #include <unordered_map>
@@ -51,6 +55,14 @@ namespace lanelet2_global_planner
 
 using autoware_auto_msgs::msg::TrajectoryPoint;
 
+/// Numbers of lane routes which were found in the route cache and which were planned, see
+/// Lanelet2GlobalPlanner::get_lane_route()
+struct LANELET2_GLOBAL_PLANNER_PUBLIC RouteCacheStatistics
+{
+  std::size_t hits{0U};
+  std::size_t misses{0U};
+};
+
 class LANELET2_GLOBAL_PLANNER_PUBLIC Lanelet2GlobalPlanner
 {
 public:
@@ -58,6 +70,21 @@ public:
 
   void load_osm_map(const std::string & file, float64_t lat, float64_t lon, float64_t alt);
   void parse_lanelet_element();
+
+  /**
+   * \brief Use the map of a version which a planner of this process parsed last, e.g. before the
+   * planner node was restarted in its container, with the routing graph built for it.
+   *
+   * The map and routing graph of the version last parsed with parse_lanelet_element() are kept for
+   * the lifetime of the process, and parse_lanelet_element() reuses the routing graph instead of
+   * building it again. The shared map must not be modified.
+   *
+   * \param version Version of the map, e.g. the `map_version` of a HADMapBin message. The map of
+   * an empty version, like one loaded by load_osm_map(), is not shared.
+   * \return True if the map was found and set as osm_map, in which case parse_lanelet_element()
+   * still needs to be called.
+   */
+  bool8_t use_shared_map(const std::string & version);
   bool8_t plan_route(
     TrajectoryPoint & start, TrajectoryPoint & end,
     std::vector<lanelet::Id> & route) const;
@@ -106,21 +133,67 @@ public:
   lanelet::Id find_parkingaccess_from_parking(const lanelet::Id & park_id) const;
   std::vector<lanelet::Id> find_lane_from_parkingaccess(const lanelet::Id & parkaccess_id) const;
   lanelet::Id find_lane_id(const lanelet::Id & cad_id) const;
+  /**
+   * \brief Plan the shortest lane route from one of the start lanelets to one of the goal
+   * lanelets.
+   *
+   * The routes of the most recently requested start and goal lanelets are cached, since a fleet
+   * mostly plans between the same pick-up, drop-off and parking spots. The cache is cleared by
+   * parse_lanelet_element(), so that it only holds routes of the current map.
+   *
+   * \param from_id Start lanelets.
+   * \param to Goal lanelets.
+   * \return Lanelets of the route, empty if there is none.
+   */
   std::vector<lanelet::Id> get_lane_route(
     const std::vector<lanelet::Id> & from_id,
     const std::vector<lanelet::Id> & to) const;
+  /**
+   * \brief Set how many routes are cached by get_lane_route(), 0 to disable the cache. The least
+   * recently used routes are dropped if there are more.
+   */
+  void set_route_cache_capacity(std::size_t capacity);
+  RouteCacheStatistics get_route_cache_statistics() const;
   bool8_t compute_parking_center(lanelet::Id & parking_id, lanelet::Point3d & parking_center) const;
   float64_t p2p_euclidean(const lanelet::Point3d & p1, const lanelet::Point3d & p2) const;
   std::vector<lanelet::Id> lanelet_chr2num(const std::string & str) const;
   std::vector<lanelet::Id> lanelet_str2num(const std::string & str) const;
   std::shared_ptr<lanelet::LaneletMap> osm_map;
+  // version of osm_map which it is shared by, see use_shared_map(), empty if it is not shared
+  std::string map_version;
 
 private:
+  lanelet::routing::RoutingGraphPtr build_routing_graph() const;
+  // get the shared routing graph of map_version, or build and share it
+  lanelet::routing::RoutingGraphPtr share_routing_graph() const;
+  void clear_route_cache();
+
+  // start and goal lanelets of a cached route
+  using RouteCacheKey = std::pair<std::vector<lanelet::Id>, std::vector<lanelet::Id>>;
+  struct RouteCacheKeyHash
+  {
+    std::size_t operator()(const RouteCacheKey & key) const;
+  };
+  using RouteCacheList = std::list<std::pair<RouteCacheKey, std::vector<lanelet::Id>>>;
+
   std::vector<lanelet::Id> parking_id_list;
+  // spatial index of the map primitives by subtype, rebuilt by parse_lanelet_element()
+  autoware::common::had_map_utils::PrimitiveIndex primitive_index;
   std::unordered_map<lanelet::Id, std::vector<lanelet::Id>> parking_lane_map;
   std::unordered_map<lanelet::Id, std::vector<lanelet::Id>> parking2access_map;
   std::unordered_map<lanelet::Id, std::vector<lanelet::Id>> access2lane_map;
   std::unordered_map<lanelet::Id, lanelet::Id> near_road_map;
+  // primitive type of the parking spots and accesses, see get_primitive_type()
+  std::unordered_map<lanelet::Id, std::string> area_type_map;
+  // routing graph of the map, built or shared once by parse_lanelet_element()
+  lanelet::routing::RoutingGraphPtr routing_graph;
+  // routes planned by get_lane_route(), the most recently used first, with their index
+  std::size_t route_cache_capacity{32U};
+  mutable RouteCacheList route_cache;
+  mutable std::unordered_map<RouteCacheKey, RouteCacheList::iterator, RouteCacheKeyHash>
+  route_cache_index;
+  mutable RouteCacheStatistics route_cache_statistics;
+  mutable std::mutex route_cache_mutex;
 };
 }  // namespace lanelet2_global_planner
 }  // namespace planning
@@ -22,9 +22,10 @@
 #include <motion_common/motion_common.hpp>
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <memory>
-#include <regex>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -40,6 +41,29 @@ namespace planning
 namespace lanelet2_global_planner
 {
 
+namespace
+{
+// map of the version last parsed by a planner of this process, with its routing graph
+struct SharedMap
+{
+  std::string version;
+  std::shared_ptr<lanelet::LaneletMap> map;
+  lanelet::routing::RoutingGraphPtr routing_graph;
+};
+
+std::mutex & shared_map_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+SharedMap & shared_map()
+{
+  static SharedMap map;
+  return map;
+}
+}  // namespace
+
 void Lanelet2GlobalPlanner::load_osm_map(
   const std::string & file,
   float64_t lat, float64_t lon, float64_t alt)
@@ -47,6 +71,8 @@ void Lanelet2GlobalPlanner::load_osm_map(
   if (osm_map) {
     osm_map.reset();
   }
+  routing_graph.reset();
+  map_version.clear();
   osm_map = load(
     file, lanelet::projection::UtmProjector(
       lanelet::Origin({lat, lon, alt})));
@@ -59,7 +85,20 @@ void Lanelet2GlobalPlanner::load_osm_map(
 
 void Lanelet2GlobalPlanner::parse_lanelet_element()
 {
+  // the tables of a previous map are stale
+  parking_id_list.clear();
+  parking_lane_map.clear();
+  parking2access_map.clear();
+  access2lane_map.clear();
+  near_road_map.clear();
+  area_type_map.clear();
+  routing_graph.reset();
+  clear_route_cache();
+
   if (osm_map) {
+    // index the primitives once per map, for the nearest parking queries
+    primitive_index = autoware::common::had_map_utils::PrimitiveIndex(*osm_map);
+
     // parsing lanelet layer
     typedef std::unordered_map<lanelet::Id, lanelet::Id>::iterator it_lane;
     std::pair<it_lane, bool8_t> result_lane;
@@ -119,6 +158,7 @@ void Lanelet2GlobalPlanner::parse_lanelet_element()
         if (!result.second) {
           throw std::runtime_error("Lanelet2GlobalPlanner: Insert parking2access_map fail");
         }
+        area_type_map.emplace(parking_id, "parking");
       }
 
       // mapping a parking access to lanes
@@ -135,8 +175,12 @@ void Lanelet2GlobalPlanner::parse_lanelet_element()
         if (!result.second) {
           throw std::runtime_error("Lanelet2GlobalPlanner: Insert access2lane_map fail");
         }
+        area_type_map.emplace(parking_access_id, "drivable_area");
       }
     }  // end for
+
+    // build the routing graph once, so that planning a route only searches it
+    routing_graph = share_routing_graph();
   }
 }
 
@@ -315,71 +359,40 @@ std::string Lanelet2GlobalPlanner::get_primitive_type(const lanelet::Id & prim_i
 {
   if (osm_map->laneletLayer.exists(prim_id)) {
     return "lane";
-  } else if (osm_map->areaLayer.exists(prim_id)) {
-    const auto area = osm_map->areaLayer.get(prim_id);
-    if (area.hasAttribute("subtype") &&
-      area.hasAttribute("parking_accesses") &&
-      (area.attribute("subtype") == "parking_spot" ||
-      area.attribute("subtype") == "parking_spot,drop_off,pick_up"))
-    {
-      return "parking";
-    } else if (area.hasAttribute("subtype") &&  // NOLINT
-      area.hasAttribute("ref_lanelet") &&
-      area.attribute("subtype") == "parking_access")
-    {
-      return "drivable_area";
-    } else {
-      return "unknown";
-    }
-  } else {
-    return "unknown";
   }
+  // the types of the areas are resolved by parse_lanelet_element()
+  const auto it = area_type_map.find(prim_id);
+  return (it != area_type_map.end()) ? it->second : "unknown";
 }
 
 lanelet::Id Lanelet2GlobalPlanner::find_nearparking_from_point(const lanelet::Point3d & point)
 const
 {
-  // loop through parking space to find the closest distance error
-  float64_t min_dist = 1e9;
-  auto it = std::min_element(
-    std::begin(parking_id_list),
-    std::end(parking_id_list),
-    [ =, &min_dist](lanelet::Id park_id1, lanelet::Id park_id2)
-    {
-      // compute parking center point
-      lanelet::Point3d p1;
-      lanelet::Point3d p2;
-      if (compute_parking_center(park_id1, p1) &&
-      compute_parking_center(park_id2, p2))
-      {
-        float64_t dist1 = p2p_euclidean(p1, point);
-        float64_t dist2 = p2p_euclidean(p2, point);
-        min_dist = (dist1 < dist2) ? dist1 : dist2;
-        return dist1 < dist2;
-      } else {
-        return false;
-      }
-    });
+  // query the parking center closest to the point among the parsed parking spots
+  const auto parsed_parking = [this](const lanelet::Id park_id) {
+      return (parking_lane_map.count(park_id) > 0U) || (parking2access_map.count(park_id) > 0U);
+    };
+  const auto near_parking = primitive_index.nearest_areas(
+    {"parking", "parking_spot", "parking_spot,drop_off,pick_up"},
+    point.basicPoint(), 1U, parsed_parking);
 
   // get parking id
   // Improvement- Check if the parking point is too far away?
   //              Check if min_dist below the threshold
-  return parking_id_list[static_cast<size_t>(std::distance(std::begin(parking_id_list), it))];
+  return near_parking.empty() ? -1 : near_parking.front();
 }
 
 lanelet::Id Lanelet2GlobalPlanner::find_nearroute_from_parking(const lanelet::Id & park_id)
 const
 {
   lanelet::Id lane_id = -1;
-  if (osm_map->areaLayer.exists(park_id)) {
-    // search the map
-    auto it = parking_lane_map.find(park_id);
-    if (it != parking_lane_map.end()) {
-      // could be more than one id in the vector<Id>
-      // pick the first near road
-      // this version only give the first one for now
-      lane_id = it->second.at(0);
-    }
+  // search the map, which only holds areas of the map
+  auto it = parking_lane_map.find(park_id);
+  if (it != parking_lane_map.end()) {
+    // could be more than one id in the vector<Id>
+    // pick the first near road
+    // this version only give the first one for now
+    lane_id = it->second.at(0);
   }
   return lane_id;
 }
@@ -388,15 +401,13 @@ lanelet::Id Lanelet2GlobalPlanner::find_parkingaccess_from_parking(const lanelet
 const
 {
   lanelet::Id parking_access_id = -1;
-  if (osm_map->areaLayer.exists(park_id)) {
-    // search the map
-    auto it_parking = parking2access_map.find(park_id);
-    if (it_parking != parking2access_map.end()) {
-      // just in case if there is more than one id in the vector<Id>
-      // pick the first parking access for now
-      // it should be one-to-one anyway
-      parking_access_id = it_parking->second.at(0);
-    }
+  // search the map, which only holds areas of the map
+  auto it_parking = parking2access_map.find(park_id);
+  if (it_parking != parking2access_map.end()) {
+    // just in case if there is more than one id in the vector<Id>
+    // pick the first parking access for now
+    // it should be one-to-one anyway
+    parking_access_id = it_parking->second.at(0);
   }
   return parking_access_id;
 }
@@ -405,13 +416,11 @@ std::vector<lanelet::Id> Lanelet2GlobalPlanner::find_lane_from_parkingaccess(
   const lanelet::Id & parkaccess_id) const
 {
   std::vector<lanelet::Id> lane_id{};
-  if (osm_map->areaLayer.exists(parkaccess_id)) {
-    // search the map
-    auto it_lane = access2lane_map.find(parkaccess_id);
-    if (it_lane != access2lane_map.end()) {
-      // return available lane ids
-      lane_id = it_lane->second;
-    }
+  // search the map, which only holds areas of the map
+  auto it_lane = access2lane_map.find(parkaccess_id);
+  if (it_lane != access2lane_map.end()) {
+    // return available lane ids
+    lane_id = it_lane->second;
   }
   return lane_id;
 }
@@ -431,12 +440,22 @@ lanelet::Id Lanelet2GlobalPlanner::find_lane_id(const lanelet::Id & cad_id) cons
 std::vector<lanelet::Id> Lanelet2GlobalPlanner::get_lane_route(
   const std::vector<lanelet::Id> & from_id, const std::vector<lanelet::Id> & to_id) const
 {
-  lanelet::traffic_rules::TrafficRulesPtr trafficRules =
-    lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany,
-    lanelet::Participants::Vehicle);
-  lanelet::routing::RoutingGraphUPtr routingGraph =
-    lanelet::routing::RoutingGraph::build(*osm_map, *trafficRules);
+  RouteCacheKey key{from_id, to_id};
+  {
+    std::lock_guard<std::mutex> lock{route_cache_mutex};
+    const auto cached = route_cache_index.find(key);
+    if (cached != route_cache_index.end()) {
+      // move the route to the front as the most recently used
+      route_cache.splice(route_cache.begin(), route_cache, cached->second);
+      ++route_cache_statistics.hits;
+      return cached->second->second;
+    }
+    ++route_cache_statistics.misses;
+  }
+
+  // the graph is built by parse_lanelet_element(), unless the map was not parsed
+  const lanelet::routing::RoutingGraphPtr routingGraph =
+    routing_graph ? routing_graph : build_routing_graph();
 
   // plan a shortest path without a lane change from the given from:to combination
   float64_t shortest_length = std::numeric_limits<float64_t>::max();
@@ -463,9 +482,99 @@ std::vector<lanelet::Id> Lanelet2GlobalPlanner::get_lane_route(
     }
   }
 
+  std::lock_guard<std::mutex> lock{route_cache_mutex};
+  // the same route may have been planned concurrently
+  if ((route_cache_capacity > 0U) && (route_cache_index.count(key) == 0U)) {
+    route_cache.emplace_front(std::move(key), shortest_route);
+    route_cache_index.emplace(route_cache.front().first, route_cache.begin());
+    if (route_cache.size() > route_cache_capacity) {
+      route_cache_index.erase(route_cache.back().first);
+      route_cache.pop_back();
+    }
+  }
   return shortest_route;
 }
 
+void Lanelet2GlobalPlanner::set_route_cache_capacity(const std::size_t capacity)
+{
+  std::lock_guard<std::mutex> lock{route_cache_mutex};
+  route_cache_capacity = capacity;
+  while (route_cache.size() > route_cache_capacity) {
+    route_cache_index.erase(route_cache.back().first);
+    route_cache.pop_back();
+  }
+}
+
+RouteCacheStatistics Lanelet2GlobalPlanner::get_route_cache_statistics() const
+{
+  std::lock_guard<std::mutex> lock{route_cache_mutex};
+  return route_cache_statistics;
+}
+
+void Lanelet2GlobalPlanner::clear_route_cache()
+{
+  std::lock_guard<std::mutex> lock{route_cache_mutex};
+  route_cache.clear();
+  route_cache_index.clear();
+}
+
+std::size_t Lanelet2GlobalPlanner::RouteCacheKeyHash::operator()(const RouteCacheKey & key) const
+{
+  // combine the hashes of the ids, with a separator between the start and goal lanelets
+  std::size_t seed = key.first.size();
+  const auto combine = [&seed](const lanelet::Id id) {
+      seed ^= std::hash<lanelet::Id>{}(id) + 0x9e3779b9U + (seed << 6U) + (seed >> 2U);
+    };
+  for (const auto id : key.first) {
+    combine(id);
+  }
+  combine(-1);
+  for (const auto id : key.second) {
+    combine(id);
+  }
+  return seed;
+}
+
+bool8_t Lanelet2GlobalPlanner::use_shared_map(const std::string & version)
+{
+  if (version.empty()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock{shared_map_mutex()};
+  const SharedMap & shared = shared_map();
+  if (shared.version != version) {
+    return false;
+  }
+  osm_map = shared.map;
+  map_version = version;
+  routing_graph.reset();
+  return true;
+}
+
+lanelet::routing::RoutingGraphPtr Lanelet2GlobalPlanner::share_routing_graph() const
+{
+  if (map_version.empty()) {
+    return build_routing_graph();
+  }
+  std::lock_guard<std::mutex> lock{shared_map_mutex()};
+  SharedMap & shared = shared_map();
+  // the graph refers to the primitives of the map it was built from, so another copy of the
+  // same version can not use it
+  if ((shared.version != map_version) || (shared.map != osm_map) || !shared.routing_graph) {
+    shared = SharedMap{map_version, osm_map, build_routing_graph()};
+  }
+  return shared.routing_graph;
+}
+
+lanelet::routing::RoutingGraphPtr Lanelet2GlobalPlanner::build_routing_graph() const
+{
+  lanelet::traffic_rules::TrafficRulesPtr trafficRules =
+    lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::Locations::Germany,
+    lanelet::Participants::Vehicle);
+  return lanelet::routing::RoutingGraph::build(*osm_map, *trafficRules);
+}
+
 bool8_t Lanelet2GlobalPlanner::compute_parking_center(
   lanelet::Id & parking_id, lanelet::Point3d & parking_center) const
 {
@@ -531,13 +640,18 @@ std::vector<lanelet::Id> Lanelet2GlobalPlanner::lanelet_chr2num(const std::strin
 std::vector<lanelet::Id> Lanelet2GlobalPlanner::lanelet_str2num(const std::string & str) const
 {
   // expecting no space comma e.g. str = "1523,4789,4852";
+  // split at the commas without a std::regex, which is costly to construct per call
   std::vector<lanelet::Id> result_nums;
-  std::regex delimiter(",");
-  std::sregex_token_iterator first{str.begin(), str.end(), delimiter, -1}, last;
-  std::vector<std::string> tokens{first, last};
-  for (auto t : tokens) {
-    lanelet::Id num_id = static_cast<lanelet::Id>(std::atoi(t.c_str()));
+  size_t start = 0U;
+  while (start < str.size()) {
+    size_t end = str.find(',', start);
+    if (end == std::string::npos) {
+      end = str.size();
+    }
+    const std::string token = str.substr(start, end - start);
+    lanelet::Id num_id = static_cast<lanelet::Id>(std::atoi(token.c_str()));
     result_nums.emplace_back(num_id);
+    start = end + 1U;
   }
   return result_nums;
 }
@@ -285,6 +285,55 @@ TEST_F(TestGlobalPlannerFullMap, TestFindRouteMutipleLanes)
   EXPECT_GT(route_id.size(), 0u);
 }
 
+TEST_F(TestGlobalPlannerFullMap, TestRouteCache)
+{
+  const std::vector<lanelet::Id> start_lane_id{6392};
+  const std::vector<lanelet::Id> end_lane_id{6518};
+  const std::vector<lanelet::Id> other_end_lane_id{6546};
+  node_ptr->set_route_cache_capacity(1U);
+  const auto route_id = node_ptr->get_lane_route(start_lane_id, end_lane_id);
+  EXPECT_GT(route_id.size(), 0u);
+  EXPECT_EQ(route_id, node_ptr->get_lane_route(start_lane_id, end_lane_id));
+  EXPECT_EQ(node_ptr->get_route_cache_statistics().hits, 1u);
+  EXPECT_EQ(node_ptr->get_route_cache_statistics().misses, 1u);
+
+  // the least recently used route is dropped
+  const auto other_route_id = node_ptr->get_lane_route(start_lane_id, other_end_lane_id);
+  EXPECT_NE(other_route_id, route_id);
+  EXPECT_EQ(route_id, node_ptr->get_lane_route(start_lane_id, end_lane_id));
+  EXPECT_EQ(node_ptr->get_route_cache_statistics().hits, 1u);
+  EXPECT_EQ(node_ptr->get_route_cache_statistics().misses, 3u);
+
+  // the routes of a previous map are not used
+  node_ptr->parse_lanelet_element();
+  EXPECT_EQ(route_id, node_ptr->get_lane_route(start_lane_id, end_lane_id));
+  EXPECT_EQ(node_ptr->get_route_cache_statistics().misses, 4u);
+
+  node_ptr->set_route_cache_capacity(0U);
+  EXPECT_EQ(route_id, node_ptr->get_lane_route(start_lane_id, end_lane_id));
+  EXPECT_EQ(node_ptr->get_route_cache_statistics().hits, 1u);
+  EXPECT_EQ(node_ptr->get_route_cache_statistics().misses, 5u);
+}
+
+TEST_F(TestGlobalPlannerFullMap, TestSharedMap)
+{
+  // a map loaded from a file is not shared
+  EXPECT_FALSE(node_ptr->use_shared_map(""));
+  node_ptr->map_version = "shared map test";
+  node_ptr->parse_lanelet_element();
+
+  Lanelet2GlobalPlanner restarted;
+  EXPECT_FALSE(restarted.use_shared_map("another version"));
+  ASSERT_TRUE(restarted.use_shared_map("shared map test"));
+  EXPECT_EQ(restarted.osm_map, node_ptr->osm_map);
+  restarted.parse_lanelet_element();
+  const std::vector<lanelet::Id> start_lane_id{6392};
+  const std::vector<lanelet::Id> end_lane_id{6518};
+  const auto route_id = restarted.get_lane_route(start_lane_id, end_lane_id);
+  EXPECT_GT(route_id.size(), 0u);
+  EXPECT_EQ(route_id, node_ptr->get_lane_route(start_lane_id, end_lane_id));
+}
+
 TEST_F(TestGlobalPlannerFullMap, TestFindParkingFromPoint)
 {
   // Vehicle location in the map frame: -25.9749 102.129 -1.74268
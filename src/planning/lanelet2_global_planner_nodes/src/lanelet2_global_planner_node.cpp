@@ -29,6 +29,7 @@
 #include <std_msgs/msg/string.hpp>
 #include <common/types.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <string>
@@ -70,6 +71,10 @@ Lanelet2GlobalPlannerNode::Lanelet2GlobalPlannerNode(
   start_pose_init = false;
   // Global planner instance init
   lanelet2_global_planner = std::make_shared<Lanelet2GlobalPlanner>();
+  // Routes between the same start and goal lanelets are planned once
+  lanelet2_global_planner->set_route_cache_capacity(
+    static_cast<std::size_t>(std::max(
+      this->declare_parameter("route_cache_capacity", 32), 0)));
   // Subcribers Goal Pose
   goal_pose_sub_ptr =
     this->create_subscription<geometry_msgs::msg::PoseStamped>(
@@ -120,9 +125,18 @@ void Lanelet2GlobalPlannerNode::request_osm_binary_map()
   // copy message to map
   autoware_auto_msgs::msg::HADMapBin msg = result.get()->map;
 
-  // Convert binary map msg to lanelet2 map and set the map for global path planner
-  lanelet2_global_planner->osm_map = std::make_shared<lanelet::LaneletMap>();
-  autoware::common::had_map_utils::fromBinaryMsg(msg, lanelet2_global_planner->osm_map);
+  // A planner of this process which parsed the same map version, e.g. before this node was
+  // restarted in its container, already converted it and built its routing graph
+  if (lanelet2_global_planner->use_shared_map(msg.map_version)) {
+    RCLCPP_INFO(
+      this->get_logger(), "Using the shared routing graph of map version %s",
+      msg.map_version.c_str());
+  } else {
+    // Convert binary map msg to lanelet2 map and set the map for global path planner
+    lanelet2_global_planner->osm_map = std::make_shared<lanelet::LaneletMap>();
+    autoware::common::had_map_utils::fromBinaryMsg(msg, lanelet2_global_planner->osm_map);
+    lanelet2_global_planner->map_version = msg.map_version;
+  }
 
   // parse lanelet global path planner elements
   lanelet2_global_planner->parse_lanelet_element();
@@ -154,7 +168,12 @@ void Lanelet2GlobalPlannerNode::goal_pose_cb(
 
   // get routes
   std::vector<lanelet::Id> route;
-  if (lanelet2_global_planner->plan_route(start, end, route)) {
+  const auto route_found = lanelet2_global_planner->plan_route(start, end, route);
+  const auto route_cache_statistics = lanelet2_global_planner->get_route_cache_statistics();
+  RCLCPP_DEBUG(
+    this->get_logger(), "Route cache hits: %zu, misses: %zu", route_cache_statistics.hits,
+    route_cache_statistics.misses);
+  if (route_found) {
     // send out the global path
     std_msgs::msg::Header msg_header;
     msg_header.stamp = rclcpp::Clock().now();
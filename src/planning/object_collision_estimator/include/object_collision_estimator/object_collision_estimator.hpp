@@ -19,6 +19,8 @@
 #include <autoware_auto_msgs/msg/trajectory_point.hpp>
 #include <autoware_auto_msgs/msg/bounding_box_array.hpp>
 #include <autoware_auto_msgs/msg/bounding_box.hpp>
+#include <geometry/bounding_box/box_overlap.hpp>
+#include <geometry/interval.hpp>
 #include <motion_common/config.hpp>
 #include <trajectory_smoother/trajectory_smoother.hpp>
 #include <common/types.hpp>
@@ -41,6 +43,7 @@ using autoware_auto_msgs::msg::Trajectory;
 using autoware_auto_msgs::msg::TrajectoryPoint;
 using autoware_auto_msgs::msg::BoundingBox;
 using autoware_auto_msgs::msg::BoundingBoxArray;
+using autoware::common::types::bool8_t;
 using autoware::common::types::float32_t;
 using autoware::common::types::PI;
 
@@ -54,8 +57,22 @@ typedef struct
   float32_t safety_factor;
   float32_t stop_margin;
   float32_t min_obstacle_dimension_m;
+
+  // only test the waypoints against the obstacles whose axis-aligned boxes touch the axis-aligned
+  // box around a few consecutive waypoint boxes. This gives the same result with less tests when
+  // most obstacles are away from the trajectory
+  bool8_t use_broad_phase;
 } ObjectCollisionEstimatorConfig;
 
+/// \brief Axis-aligned box around the corners of a bounding box
+typedef struct
+{
+  float32_t min_x;
+  float32_t min_y;
+  float32_t max_x;
+  float32_t max_y;
+} AxisAlignedBox;
+
 /// \brief Given a trajectory and a list of obstacles, detect possible collision points between the
 /// ego vehicle and obstacle along the trajectory. Modify the trajectory so that the vehicle stops
 /// before the collision.
@@ -102,6 +119,19 @@ private:
   BoundingBoxArray m_obstacles{};
   BoundingBoxArray m_trajectory_bboxes{};
   TrajectorySmoother m_smoother;
+  // Footprints for the batched overlap tests, reused across calls
+  autoware::common::geometry::bounding_box::BoxArray m_obstacle_footprints{};
+  autoware::common::geometry::bounding_box::BoxArray m_trajectory_footprints{};
+  std::vector<uint8_t> m_overlaps{};
+  // Extents of the axis-aligned boxes of the obstacles along x and y for the broad phase, their
+  // overlap flags with a group of waypoints, and the obstacles that the broad phase leaves to be
+  // tested for the group, reused across calls
+  autoware::common::geometry::IntervalArray_f m_obstacle_x_intervals{};
+  autoware::common::geometry::IntervalArray_f m_obstacle_y_intervals{};
+  std::vector<uint8_t> m_x_overlaps{};
+  std::vector<uint8_t> m_y_overlaps{};
+  std::vector<BoundingBox> m_candidate_obstacles{};
+  autoware::common::geometry::bounding_box::BoxArray m_candidate_footprints{};
 };
 
 }  // namespace object_collision_estimator
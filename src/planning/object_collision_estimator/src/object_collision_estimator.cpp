@@ -31,8 +31,12 @@ namespace planning
 namespace object_collision_estimator
 {
 
+using autoware::common::geometry::bounding_box::BoxArray;
 using autoware::common::geometry::bounding_box::minimum_perimeter_bounding_box;
+using autoware::common::geometry::bounding_box::overlap_row;
 using autoware::common::geometry::get_normal;
+using autoware::common::geometry::Interval_f;
+using autoware::common::geometry::IntervalArray_f;
 using autoware::common::geometry::minus_2d;
 using autoware::common::geometry::plus_2d;
 using autoware::common::geometry::rotate_2d;
@@ -125,52 +129,91 @@ bool8_t isTooFarAway(
   return is_too_far_away;
 }
 
-/// \brief Detect possible collision between a trajectory and a list of obstacle bounding boxes.
-///        Return the index in the trajectory where the first collision happens.
+/// \brief Compute the bounding boxes around all waypoints of a trajectory and their footprints
 /// \param trajectory Planned trajectory of ego vehicle.
-/// \param obstacles Array of bounding boxes of detected obstacles.
 /// \param vehicle_param Configuration regarding the dimensions of the ego vehicle
 /// \param safety_factor A factor to inflate the size of the vehicle so to avoid getting too close
 ///                      to obstacles.
-/// \param waypoint_bboxes A list of bounding boxes around each waypoint in the trajectory
-/// \return int32_t The index into the trajectory points where the first collision happens. If no
-///         collision is detected, -1 is returned.
-int32_t detectCollision(
+/// \param waypoint_bboxes Gets filled with the bounding box around each waypoint
+/// \param waypoint_footprints Gets filled with the footprints of waypoint_bboxes
+void computeWaypointBoxes(
   const Trajectory & trajectory,
-  const BoundingBoxArray & obstacles,
   const VehicleConfig & vehicle_param,
   const float32_t safety_factor,
-  BoundingBoxArray & waypoint_bboxes)
+  BoundingBoxArray & waypoint_bboxes,
+  BoxArray & waypoint_footprints)
 {
-  // find the dimension of the ego vehicle.
-  const auto vehicle_length =
-    vehicle_param.front_overhang() + vehicle_param.length_cg_front_axel() +
-    vehicle_param.length_cg_rear_axel() + vehicle_param.rear_overhang();
-  const auto vehicle_width = vehicle_param.width();
-  const auto vehicle_diagonal = sqrtf(
-    (vehicle_width * vehicle_width) + (vehicle_length * vehicle_length));
-
-  // define a distance threshold to filter obstacles that are too far away to cause any collision.
-  const float32_t distance_threshold{vehicle_diagonal * safety_factor};
-
-  int32_t collision_index = -1;
-
   waypoint_bboxes.boxes.clear();
   for (std::size_t i = 0; i < trajectory.points.size(); ++i) {
     waypoint_bboxes.boxes.push_back(
       waypointToBox(trajectory.points[i], vehicle_param, safety_factor));
   }
-  for (std::size_t i = 0; (i < trajectory.points.size()) && (collision_index == -1); ++i) {
-    // calculate a bounding box given a trajectory point
-    const auto & waypoint_bbox = waypoint_bboxes.boxes.at(i);
-
-    // Check for collisions with all perceived obstacles
-    for (const auto & obstacle_bbox : obstacles.boxes) {
-      if (!isTooFarAway(
-          trajectory.points[i], obstacle_bbox,
-          distance_threshold) && autoware::common::geometry::intersect(
-          waypoint_bbox.corners.begin(), waypoint_bbox.corners.end(),
-          obstacle_bbox.corners.begin(), obstacle_bbox.corners.end()))
+  waypoint_footprints.assign(waypoint_bboxes.boxes);
+}
+
+/// \brief Compute the axis-aligned box around the corners of a bounding box
+/// \param box A bounding box
+/// \return AxisAlignedBox The axis-aligned box, inflated by a small margin so that it contains
+///         every box that overlap_row finds to overlap despite the rounding of its footprint
+AxisAlignedBox getAxisAlignedBox(const BoundingBox & box) noexcept
+{
+  constexpr float32_t margin = 0.01F;
+  AxisAlignedBox aabb{box.corners[0].x, box.corners[0].y, box.corners[0].x, box.corners[0].y};
+  for (const auto & corner : box.corners) {
+    aabb.min_x = std::min(aabb.min_x, corner.x);
+    aabb.min_y = std::min(aabb.min_y, corner.y);
+    aabb.max_x = std::max(aabb.max_x, corner.x);
+    aabb.max_y = std::max(aabb.max_y, corner.y);
+  }
+  aabb.min_x -= margin;
+  aabb.min_y -= margin;
+  aabb.max_x += margin;
+  aabb.max_y += margin;
+  return aabb;
+}
+
+/// \brief Get the extent of an axis-aligned box along one axis
+/// \param min The minimum of the box along the axis
+/// \param max The maximum of the box along the axis
+/// \return Interval_f The interval [min, max], or an empty interval if a bound is NaN, which
+///         overlaps nothing
+Interval_f getExtent(const float32_t min, const float32_t max) noexcept
+{
+  return (min <= max) ? Interval_f{min, max} : Interval_f{};
+}
+
+/// \brief Detect possible collision between a trajectory and a list of obstacle bounding boxes.
+///        Return the index in the trajectory where the first collision happens.
+/// \param trajectory Planned trajectory of ego vehicle.
+/// \param obstacles Bounding boxes of detected obstacles.
+/// \param obstacle_footprints The footprints of the obstacles, in the same order
+/// \param distance_threshold Obstacles at least this far away from a waypoint do not collide
+/// \param waypoint_footprints The footprints of the boxes around the waypoints
+/// \param begin_index Index of the first waypoint to check
+/// \param end_index Index after the last waypoint to check
+/// \param overlaps Scratch space for the overlap flags of a waypoint with all obstacles
+/// \return int32_t The index into the trajectory points where the first collision happens. If no
+///         collision is detected, -1 is returned.
+int32_t detectCollision(
+  const Trajectory & trajectory,
+  const std::vector<BoundingBox> & obstacles,
+  const BoxArray & obstacle_footprints,
+  const float32_t distance_threshold,
+  const BoxArray & waypoint_footprints,
+  const std::size_t begin_index,
+  const std::size_t end_index,
+  std::vector<uint8_t> & overlaps)
+{
+  int32_t collision_index = -1;
+
+  overlaps.resize(obstacles.size());
+  for (std::size_t i = begin_index; (i < end_index) && (collision_index == -1); ++i) {
+    // Check for collisions with all perceived obstacles at once
+    overlap_row(waypoint_footprints, i, obstacle_footprints, overlaps.data());
+    for (std::size_t j = 0; j < obstacles.size(); ++j) {
+      if ((overlaps[j] != 0U) && !isTooFarAway(
+          trajectory.points[i], obstacles[j],
+          distance_threshold))
       {
         // Collision detected, set end index (non-inclusive), this will end outer loop immediately
         collision_index = static_cast<decltype(collision_index)>(i);
@@ -182,6 +225,80 @@ int32_t detectCollision(
   return collision_index;
 }
 
+/// \brief Detect the first collision like detectCollision, but go through the trajectory in groups
+///        of consecutive waypoints, and only test each group against the obstacles whose
+///        axis-aligned boxes touch the axis-aligned box around the boxes of the group. The groups
+///        after the first collision are not looked at.
+/// \param trajectory Planned trajectory of ego vehicle.
+/// \param obstacles Bounding boxes of detected obstacles.
+/// \param obstacle_x_intervals The x extents of the axis-aligned boxes of the obstacles, in the
+///        same order
+/// \param obstacle_y_intervals The y extents of the axis-aligned boxes of the obstacles, in the
+///        same order
+/// \param distance_threshold Obstacles at least this far away from a waypoint do not collide
+/// \param waypoint_bboxes The bounding boxes around the waypoints
+/// \param waypoint_footprints The footprints of waypoint_bboxes
+/// \param x_overlaps Scratch space for the overlap flags of a group with obstacle_x_intervals
+/// \param y_overlaps Scratch space for the overlap flags of a group with obstacle_y_intervals
+/// \param candidates Scratch space for the obstacles to test against a group
+/// \param candidate_footprints Scratch space for the footprints of candidates
+/// \param overlaps Scratch space for the overlap flags of a waypoint with the candidates
+/// \return int32_t The index into the trajectory points where the first collision happens. If no
+///         collision is detected, -1 is returned.
+int32_t detectCollisionWithBroadPhase(
+  const Trajectory & trajectory,
+  const std::vector<BoundingBox> & obstacles,
+  const IntervalArray_f & obstacle_x_intervals,
+  const IntervalArray_f & obstacle_y_intervals,
+  const float32_t distance_threshold,
+  const BoundingBoxArray & waypoint_bboxes,
+  const BoxArray & waypoint_footprints,
+  std::vector<uint8_t> & x_overlaps,
+  std::vector<uint8_t> & y_overlaps,
+  std::vector<BoundingBox> & candidates,
+  BoxArray & candidate_footprints,
+  std::vector<uint8_t> & overlaps)
+{
+  constexpr std::size_t group_size = 8U;
+  const std::size_t num_waypoints = waypoint_bboxes.boxes.size();
+  x_overlaps.resize(obstacles.size());
+  y_overlaps.resize(obstacles.size());
+  for (std::size_t begin = 0; begin < num_waypoints; begin += group_size) {
+    const std::size_t end = std::min(begin + group_size, num_waypoints);
+    AxisAlignedBox group_aabb = getAxisAlignedBox(waypoint_bboxes.boxes[begin]);
+    for (std::size_t i = begin + 1U; i < end; ++i) {
+      const auto aabb = getAxisAlignedBox(waypoint_bboxes.boxes[i]);
+      group_aabb.min_x = std::min(group_aabb.min_x, aabb.min_x);
+      group_aabb.min_y = std::min(group_aabb.min_y, aabb.min_y);
+      group_aabb.max_x = std::max(group_aabb.max_x, aabb.max_x);
+      group_aabb.max_y = std::max(group_aabb.max_y, aabb.max_y);
+    }
+
+    // Test the extents along both axes against all obstacles at once
+    obstacle_x_intervals.overlaps(getExtent(group_aabb.min_x, group_aabb.max_x), x_overlaps.data());
+    obstacle_y_intervals.overlaps(getExtent(group_aabb.min_y, group_aabb.max_y), y_overlaps.data());
+    candidates.clear();
+    for (std::size_t j = 0; j < obstacles.size(); ++j) {
+      if ((x_overlaps[j] != 0U) && (y_overlaps[j] != 0U)) {
+        candidates.push_back(obstacles[j]);
+      }
+    }
+    if (candidates.empty()) {
+      continue;
+    }
+
+    candidate_footprints.assign(candidates);
+    const auto collision_index = detectCollision(
+      trajectory, candidates, candidate_footprints, distance_threshold,
+      waypoint_footprints, begin, end, overlaps);
+    if (collision_index != -1) {
+      return collision_index;
+    }
+  }
+
+  return -1;
+}
+
 /// \brief Returns the index that vehicle should stop when the object colliding index
 ///        and stop distance is given
 /// \param trajectory Planned trajectory of ego vehicle.
@@ -227,10 +344,30 @@ ObjectCollisionEstimator::ObjectCollisionEstimator(
 
 void ObjectCollisionEstimator::updatePlan(Trajectory & trajectory) noexcept
 {
+  // find the dimension of the ego vehicle.
+  const auto & vehicle_param = m_config.vehicle_config;
+  const auto vehicle_length =
+    vehicle_param.front_overhang() + vehicle_param.length_cg_front_axel() +
+    vehicle_param.length_cg_rear_axel() + vehicle_param.rear_overhang();
+  const auto vehicle_width = vehicle_param.width();
+  const auto vehicle_diagonal = sqrtf(
+    (vehicle_width * vehicle_width) + (vehicle_length * vehicle_length));
+
+  // define a distance threshold to filter obstacles that are too far away to cause any collision.
+  const float32_t distance_threshold{vehicle_diagonal * m_config.safety_factor};
+
   // Collision detection
-  auto collision_index = detectCollision(
-    trajectory, m_obstacles, m_config.vehicle_config,
-    m_config.safety_factor, m_trajectory_bboxes);
+  computeWaypointBoxes(
+    trajectory, vehicle_param, m_config.safety_factor, m_trajectory_bboxes,
+    m_trajectory_footprints);
+  const auto collision_index = m_config.use_broad_phase ?
+    detectCollisionWithBroadPhase(
+    trajectory, m_obstacles.boxes, m_obstacle_x_intervals, m_obstacle_y_intervals,
+    distance_threshold, m_trajectory_bboxes, m_trajectory_footprints, m_x_overlaps, m_y_overlaps,
+    m_candidate_obstacles, m_candidate_footprints, m_overlaps) :
+    detectCollision(
+    trajectory, m_obstacles.boxes, m_obstacle_footprints, distance_threshold,
+    m_trajectory_footprints, 0U, trajectory.points.size(), m_overlaps);
 
   auto trajectory_end_idx = getStopIndex(trajectory, collision_index, m_config.stop_margin);
 
@@ -287,6 +424,14 @@ std::vector<BoundingBox> ObjectCollisionEstimator::updateObstacles(
       modified_obstacles.push_back(box);
     }
   }
+  m_obstacle_footprints.assign(m_obstacles.boxes);
+  m_obstacle_x_intervals.clear();
+  m_obstacle_y_intervals.clear();
+  for (const auto & box : m_obstacles.boxes) {
+    const auto aabb = getAxisAlignedBox(box);
+    m_obstacle_x_intervals.push_back(getExtent(aabb.min_x, aabb.max_x));
+    m_obstacle_y_intervals.push_back(getExtent(aabb.min_y, aabb.max_y));
+  }
 
   return modified_obstacles;
 }
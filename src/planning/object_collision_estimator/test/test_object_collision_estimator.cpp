@@ -42,7 +42,8 @@ const auto make_point(const float32_t x, const float32_t y)
 void object_collision_estimator_test(
   std::size_t trajectory_length,
   std::size_t obstacle_bbox_idx,
-  float32_t generated_obstacle_size = 0.5)
+  float32_t generated_obstacle_size = 0.5,
+  bool use_broad_phase = false)
 {
   // define dummy vehicle dimensions
   ObjectCollisionEstimatorConfig config{
@@ -60,6 +61,7 @@ void object_collision_estimator_test(
     1.1,  // safety factor
     0.0,  // stop_margin
     0.0004,  // min_obstacle_dimension_m
+    use_broad_phase,
   };
   TrajectorySmoother smoother{{5, 25}};
 
@@ -161,3 +163,20 @@ TEST(ObjectCollisionEstimator, NoObstacle) {
 TEST(ObjectCollisionEstimator, SmallObstacle) {
   object_collision_estimator_test(100, 40, 0.0003);
 }
+
+TEST(ObjectCollisionEstimator, BroadPhase) {
+  // the same cases as above, the broad phase must find the same collisions
+  object_collision_estimator_test(100, 40, 0.5, true);
+  object_collision_estimator_test(3, 1, 0.5, true);
+  object_collision_estimator_test(3, 2, 0.5, true);
+  object_collision_estimator_test(2, 2, 0.5, true);
+  object_collision_estimator_test(0, 2, 0.5, true);
+  object_collision_estimator_test(100, 0, 0.5, true);
+  object_collision_estimator_test(100, 1, 0.5, true);
+  object_collision_estimator_test(100, 101, 0.5, true);
+  object_collision_estimator_test(100, 40, 0.0003, true);
+  // collisions in every position of the groups of waypoints
+  for (std::size_t idx = 2; idx < 20; ++idx) {
+    object_collision_estimator_test(100, idx, 0.5, true);
+  }
+}
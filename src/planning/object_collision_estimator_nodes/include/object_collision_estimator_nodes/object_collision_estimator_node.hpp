@@ -19,6 +19,7 @@
 #include <tf2_ros/transform_listener.h>
 #include <tf2_ros/buffer.h>
 #include <rclcpp/rclcpp.hpp>
+#include <time_utils/trace.hpp>
 #include <memory>
 #include <string>
 
@@ -107,6 +108,13 @@ private:
   /// \brief The staleness threshold for objects in milliseconds
   std::chrono::milliseconds m_staleness_threshold_ms{};
 
+  /// \brief Records when each obstacle message is received and stored, if tracing is switched on
+  const autoware::common::time_utils::TracePoint m_obstacles_trace;
+
+  /// \brief Records each collision estimate against the stamp of the obstacles it was based on,
+  ///        if tracing is switched on
+  const autoware::common::time_utils::TracePoint m_plan_trace;
+
   /// \brief Hard coded node name
   static constexpr const char * OBJECT_COLLISION_ESTIMATOR_NODE_NAME =
     "object_collision_estimator_node";
@@ -39,12 +39,15 @@ using motion::planning::trajectory_smoother::TrajectorySmootherConfig;
 using motion::planning::trajectory_smoother::TrajectorySmoother;
 using motion::motion_common::VehicleConfig;
 using motion::motion_common::Real;
+using autoware::common::types::bool8_t;
 using autoware::common::types::float64_t;
 using autoware::common::types::float32_t;
 using rclcpp::QoS;
 
 ObjectCollisionEstimatorNode::ObjectCollisionEstimatorNode(const rclcpp::NodeOptions & node_options)
-: Node(OBJECT_COLLISION_ESTIMATOR_NODE_NAME, node_options)
+: Node(OBJECT_COLLISION_ESTIMATOR_NODE_NAME, node_options),
+  m_obstacles_trace{std::string{get_fully_qualified_name()} + "/obstacles"},
+  m_plan_trace{std::string{get_fully_qualified_name()} + "/estimate_collision"}
 {
   // Declare node parameters. See ObjectCollisionEstimator Class for details of the functions of
   // these parameters.
@@ -90,6 +93,10 @@ ObjectCollisionEstimatorNode::ObjectCollisionEstimatorNode(const rclcpp::NodeOpt
     static_cast<float32_t>(declare_parameter(
       "min_obstacle_dimension_m"
     ).get<float32_t>());
+  const auto use_broad_phase =
+    static_cast<bool8_t>(declare_parameter(
+      "use_broad_phase"
+    ).get<bool8_t>());
   const TrajectorySmootherConfig smoother_config {
     static_cast<float32_t>(declare_parameter(
       "trajectory_smoother.kernel_std"
@@ -114,7 +121,7 @@ ObjectCollisionEstimatorNode::ObjectCollisionEstimatorNode(const rclcpp::NodeOpt
 
   // Create an object collision estimator
   const ObjectCollisionEstimatorConfig config {vehicle_param, safety_factor, stop_margin,
-    min_obstacle_dimension_m};
+    min_obstacle_dimension_m, use_broad_phase};
   const TrajectorySmoother smoother{smoother_config};
   m_estimator = std::make_unique<ObjectCollisionEstimator>(config, smoother);
 
@@ -158,6 +165,7 @@ void ObjectCollisionEstimatorNode::on_bounding_box(const BoundingBoxArray::Share
   // Update most recent bounding boxes internally
   if (msg->header.frame_id == m_target_frame_id) {
     // No transform needed, update bounding boxes directly
+    const autoware::common::time_utils::ScopedTrace trace{m_obstacles_trace, msg->header.stamp};
     update_obstacles(*msg);
 
     // keep track of the timestamp of the lastest successful obstacle message
@@ -176,8 +184,9 @@ void ObjectCollisionEstimatorNode::on_bounding_box(const BoundingBoxArray::Share
     // create a new timer with timeout to check periodically if a valid transform for that timestamp
     // is available.
     const auto start_time = this->now();
+    const auto trace_enter = autoware::common::time_utils::TracePoint::Clock::now();
     m_wall_timer = create_wall_timer(
-      0.02s, [this, msg, start_time]() {
+      0.02s, [this, msg, start_time, trace_enter]() {
         auto elapsed_time = this->now() - start_time;
         const auto timeout = 0.1s;
 
@@ -194,6 +203,9 @@ void ObjectCollisionEstimatorNode::on_bounding_box(const BoundingBoxArray::Share
 
             // keep track of the timestamp of the lastest successful obstacle message
             this->m_last_obstacle_msg_time = msg_transformed.header.stamp;
+            m_obstacles_trace.record(
+              msg->header.stamp, trace_enter,
+              autoware::common::time_utils::TracePoint::Clock::now());
           }
         } else {
           // timeout occurred, clean up timer
@@ -211,6 +223,10 @@ void ObjectCollisionEstimatorNode::estimate_collision(
   const std::shared_ptr<autoware_auto_msgs::srv::ModifyTrajectory::Request> request,
   std::shared_ptr<autoware_auto_msgs::srv::ModifyTrajectory::Response> response)
 {
+  // The trajectory has no stamp of its own sensor data, so the estimate is traced against the
+  // obstacles it is checked with
+  const autoware::common::time_utils::ScopedTrace trace{m_plan_trace,
+    static_cast<builtin_interfaces::msg::Time>(m_last_obstacle_msg_time)};
   rclcpp::Time request_time{request->original_trajectory.header.stamp,
     m_last_obstacle_msg_time.get_clock_type()};
   auto elapsed_time = request_time - m_last_obstacle_msg_time;
@@ -103,6 +103,9 @@ void object_collision_estimator_node_test(
   node_options.append_parameter_override(
     "min_obstacle_dimension_m",
     min_obstacle_dimension_m);
+  node_options.append_parameter_override(
+    "use_broad_phase",
+    true);
   // create collision estimator node
   auto estimator_node = std::make_shared<ObjectCollisionEstimatorNode>(node_options);
 
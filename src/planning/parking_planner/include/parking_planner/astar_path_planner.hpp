@@ -35,19 +35,28 @@ static constexpr float64_t DELTA_LONGITUDINAL = 0.125;
 static const float64_t DELTA_HEADING = MY_PI / 24.0;
 static constexpr float64_t MAX_EXPLORATION_RADIUS = 30.0;
 static constexpr size_t MAX_NUM_EXPLORATION_NODES = 1000000;
+static constexpr float64_t OBSTACLE_GRID_RESOLUTION = 0.25;
 
 class PARKING_PLANNER_PUBLIC AstarPathPlanner
 {
 public:
   /// \brief Create an A* path planner
-  AstarPathPlanner() = default;
+  /// \param[in] use_obstacle_grid Whether plan_astar builds a grid of the distances to the
+  ///            obstacles, so that the states away from them are checked for collisions with
+  ///            a few lookups instead of the polytope intersection with every obstacle. The
+  ///            planned path is the same either way.
+  explicit AstarPathPlanner(const bool use_obstacle_grid = true) noexcept
+  : m_use_obstacle_grid(use_obstacle_grid)
+  {
+  }
 
   /// \brief Plan a collision-free but not necessarily dynamically feasible path from a given
   ///        starting state to a given ending state.
   /// \param[in] current_state Starting vehicle state for the path planning
   /// \param[in] goal_state Desired final state for the path planning
   /// \param[in] vehicle_bounding_box Bounding box of the vehicle, used for collision checking
-  /// \param[in] obstacles List of bounding boxes of the obstacles to be avoided
+  /// \param[in] obstacles List of bounding boxes of the obstacles to be avoided, assumed to be
+  ///            convex
   /// \return A path is returned in all cases. On success, the path starts at current_state
   //          and ends at goal_state. On failure, the path is length 1 and only contains the
   //          current_state.
@@ -59,7 +68,8 @@ public:
     const std::vector<Polytope2D<float64_t>> & obstacles) const;
 
 private:
-  // Currently no state
+  /// Whether the collisions are checked with a grid of the distances to the obstacles first
+  bool m_use_obstacle_grid;
 };
 
 }  // namespace parking_planner
@@ -42,12 +42,17 @@ struct NLPResults
   // cppcheck-suppress syntaxError
   Trajectory<float64_t> m_trajectory;
   casadi::Dict m_solve_info;
+  /// Multipliers of the variable bounds and of the constraints at the solution, empty if the
+  /// solver was not called. They can warm-start the solve of a similar problem.
+  std::vector<float64_t> m_variable_multipliers;
+  std::vector<float64_t> m_constraint_multipliers;
 };
 
 class PARKING_PLANNER_PUBLIC NLPPathPlanner
 {
 public:
-  /// \brief Create an NLP-based trajectory planner
+  /// \brief Create an NLP-based trajectory planner. The solver is loaded from the generated
+  ///        callbacks here once, not for every plan.
   /// \param[in] cost_weights Cost function weight parameters
   /// \param[in] lower_state_bounds Lower bounds on the state variables, valid across the entire
   ///            horizon
@@ -83,6 +88,26 @@ public:
     const BicycleModelParameters<float64_t> & model_parameters
   ) const;
 
+  /// \brief Plan like the plan_nlp above, but start the solver from the multipliers of a
+  ///        previous solution, e.g. when the same maneuver is planned again after the obstacles
+  ///        moved. The solve is started cold if the previous results have no multipliers.
+  /// \param[in] current_state Starting vehicle state for the path planning
+  /// \param[in] goal_state Desired final state for the path planning
+  /// \param[in] initial_guess An initial guess for the trajectory. Does not need to be
+  ///            dynamically feasible.
+  /// \param[in] obstacles The obstacles to avoid
+  /// \param[in] model_parameters Physical model parameters of the vehicle
+  /// \param[in] previous_results Results of the previous solve
+  /// \return Planning results, see the plan_nlp above
+  NLPResults plan_nlp(
+    const VehicleState<float64_t> & current_state,
+    const VehicleState<float64_t> & goal_state,
+    const Trajectory<float64_t> & initial_guess,
+    const std::vector<Polytope2D<float64_t>> & obstacles,
+    const BicycleModelParameters<float64_t> & model_parameters,
+    const NLPResults & previous_results
+  ) const;
+
   /// \brief Check a given trajectory for feasibility in terms of dynamics, variable bounds and
   ///        obstacle avoidance.
   /// \param[in] trajectory The trajectory to check
@@ -107,6 +132,10 @@ private:
   VehicleState<float64_t> m_upper_state_bounds;
   VehicleCommand<float64_t> m_lower_command_bounds;
   VehicleCommand<float64_t> m_upper_command_bounds;
+  /// Solver with the generated callbacks, started from the default multipliers
+  casadi::Function m_solver;
+  /// Solver with the same callbacks, started from given multipliers
+  casadi::Function m_warm_start_solver;
 };
 
 
@@ -16,8 +16,9 @@
 #include <vector>
 #include <utility>
 #include <queue>
-#include <unordered_map>
 #include <algorithm>
+#include <array>
+#include <limits>
 
 #include "parking_planner/astar_path_planner.hpp"
 #include "parking_planner/parking_planner_types.hpp"
@@ -37,8 +38,12 @@ namespace parking_planner
 
 using autoware::common::types::float64_t;
 
-static std::vector<VehicleState<float64_t>> expand_state_longitudinal_with_heading(
-  const VehicleState<float64_t> & from_state)
+/// Number of states that a state is expanded into
+static constexpr size_t NUM_EXPANDED_STATES = 6;
+
+static void expand_state_longitudinal_with_heading(
+  const VehicleState<float64_t> & from_state,
+  std::array<VehicleState<float64_t>, NUM_EXPANDED_STATES> & to_states)
 {
   const float64_t from_x = from_state.get_x();
   const float64_t from_y = from_state.get_y();
@@ -51,7 +56,7 @@ static std::vector<VehicleState<float64_t>> expand_state_longitudinal_with_headi
   const float64_t heading_plus = remainder(
     from_heading + parking_planner::DELTA_HEADING,
     MY_PI * 2.0);
-  std::vector<VehicleState<float64_t>> to_states(6, from_state);
+  to_states.fill(from_state);
   to_states[0].set_x(from_x - delta_x);
   to_states[0].set_y(from_y - delta_y);
   to_states[0].set_heading(heading_minus);
@@ -70,7 +75,6 @@ static std::vector<VehicleState<float64_t>> expand_state_longitudinal_with_headi
   to_states[5].set_x(from_x + delta_x);
   to_states[5].set_y(from_y + delta_y);
   to_states[5].set_heading(heading_plus);
-  return to_states;
 }
 
 static bool check_collision_bounding_box_vs_obstacles(
@@ -90,6 +94,175 @@ static bool check_collision_bounding_box_vs_obstacles(
   return false;
 }
 
+/// \brief Circles that cover the axis-aligned box around a polytope, placed along its longer side
+struct CoveringCircles
+{
+  std::vector<Point2D<float64_t>> centers;
+  float64_t radius;
+};
+
+static CoveringCircles compute_covering_circles(const Polytope2D<float64_t> & polytope)
+{
+  CoveringCircles circles{{}, 0.0};
+  const auto & vertices = polytope.get_vertices();
+  if (vertices.empty()) {
+    return circles;
+  }
+
+  float64_t x_min = std::numeric_limits<float64_t>::max();
+  float64_t x_max = std::numeric_limits<float64_t>::lowest();
+  float64_t y_min = std::numeric_limits<float64_t>::max();
+  float64_t y_max = std::numeric_limits<float64_t>::lowest();
+  for (const auto & vertex : vertices) {
+    x_min = std::min(x_min, vertex.get_coord().first);
+    x_max = std::max(x_max, vertex.get_coord().first);
+    y_min = std::min(y_min, vertex.get_coord().second);
+    y_max = std::max(y_max, vertex.get_coord().second);
+  }
+
+  // One circle per square of the short side, each covering its part of the box
+  const bool along_x = (x_max - x_min) >= (y_max - y_min);
+  const float64_t long_side = along_x ? (x_max - x_min) : (y_max - y_min);
+  const float64_t short_side = along_x ? (y_max - y_min) : (x_max - x_min);
+  const size_t num_circles = (short_side > 0.0) ?
+    std::max(static_cast<size_t>(1), static_cast<size_t>(ceil(long_side / short_side))) : 1U;
+  const float64_t step = long_side / static_cast<float64_t>(num_circles);
+  circles.radius = 0.5 * sqrt(step * step + short_side * short_side);
+  for (size_t i = 0; i < num_circles; ++i) {
+    const float64_t offset = (static_cast<float64_t>(i) + 0.5) * step;
+    circles.centers.push_back(
+      along_x ?
+      Point2D<float64_t>(x_min + offset, 0.5 * (y_min + y_max)) :
+      Point2D<float64_t>(0.5 * (x_min + x_max), y_min + offset));
+  }
+  return circles;
+}
+
+static float64_t compute_distance_point_to_polytope(
+  const Point2D<float64_t> & point,
+  const Polytope2D<float64_t> & polytope)
+{
+  if (polytope.contains_point(point)) {
+    return 0.0;
+  }
+
+  float64_t distance = std::numeric_limits<float64_t>::max();
+  const auto & vertices = polytope.get_vertices();
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    const Point2D<float64_t> & a = vertices[i];
+    const Point2D<float64_t> & b = vertices[(i + 1) % vertices.size()];
+    const Point2D<float64_t> ab = b - a;
+    const Point2D<float64_t> ap = point - a;
+    const float64_t length_squared = ab.dot(ab);
+    const float64_t t = (length_squared > 0.0) ?
+      std::min(1.0, std::max(0.0, ap.dot(ab) / length_squared)) : 0.0;
+    distance = std::min(distance, (ap - ab * t).norm2());
+  }
+  return distance;
+}
+
+/// \brief Square grid of the distances from the cell centers to the nearest obstacle, capped at a
+///        maximum distance. Beyond that distance from the box around an obstacle, the cells are
+///        not computed for it.
+class ObstacleDistanceGrid
+{
+public:
+  /// \brief Create an empty grid, which contains no point
+  ObstacleDistanceGrid() = default;
+
+  /// \brief Create the grid and compute the distances
+  /// \param[in] center Center of the grid
+  /// \param[in] half_size Half of the side length of the grid
+  /// \param[in] max_distance Distance stored in the cells that are farther from all obstacles
+  /// \param[in] obstacles Convex obstacles
+  ObstacleDistanceGrid(
+    const Point2D<float64_t> & center,
+    const float64_t half_size,
+    const float64_t max_distance,
+    const std::vector<Polytope2D<float64_t>> & obstacles)
+  : m_origin(center - Point2D<float64_t>(half_size, half_size)),
+    m_num_cells(static_cast<int64_t>(ceil(2.0 * half_size / OBSTACLE_GRID_RESOLUTION))),
+    m_distances(static_cast<size_t>(m_num_cells * m_num_cells), max_distance)
+  {
+    for (const auto & obstacle : obstacles) {
+      float64_t x_min = std::numeric_limits<float64_t>::max();
+      float64_t x_max = std::numeric_limits<float64_t>::lowest();
+      float64_t y_min = std::numeric_limits<float64_t>::max();
+      float64_t y_max = std::numeric_limits<float64_t>::lowest();
+      for (const auto & vertex : obstacle.get_vertices()) {
+        x_min = std::min(x_min, vertex.get_coord().first);
+        x_max = std::max(x_max, vertex.get_coord().first);
+        y_min = std::min(y_min, vertex.get_coord().second);
+        y_max = std::max(y_max, vertex.get_coord().second);
+      }
+      const int64_t ix_begin = std::max(int64_t{0}, get_cell_index(x_min - max_distance, true));
+      const int64_t ix_end =
+        std::min(m_num_cells - 1, get_cell_index(x_max + max_distance, true));
+      const int64_t iy_begin = std::max(int64_t{0}, get_cell_index(y_min - max_distance, false));
+      const int64_t iy_end =
+        std::min(m_num_cells - 1, get_cell_index(y_max + max_distance, false));
+      for (int64_t iy = iy_begin; iy <= iy_end; ++iy) {
+        for (int64_t ix = ix_begin; ix <= ix_end; ++ix) {
+          const Point2D<float64_t> cell_center = m_origin + Point2D<float64_t>(
+            (static_cast<float64_t>(ix) + 0.5) * OBSTACLE_GRID_RESOLUTION,
+            (static_cast<float64_t>(iy) + 0.5) * OBSTACLE_GRID_RESOLUTION);
+          float64_t & distance = m_distances[static_cast<size_t>(iy * m_num_cells + ix)];
+          distance = std::min(distance, compute_distance_point_to_polytope(cell_center, obstacle));
+        }
+      }
+    }
+  }
+
+  /// \brief Get the distance stored in the cell of a point
+  /// \return The distance, or a negative value if the point is outside of the grid
+  float64_t get_distance(const float64_t x, const float64_t y) const noexcept
+  {
+    const int64_t ix = get_cell_index(x, true);
+    const int64_t iy = get_cell_index(y, false);
+    if ((ix < 0) || (ix >= m_num_cells) || (iy < 0) || (iy >= m_num_cells)) {
+      return -1.0;
+    }
+    return m_distances[static_cast<size_t>(iy * m_num_cells + ix)];
+  }
+
+private:
+  int64_t get_cell_index(const float64_t coordinate, const bool is_x) const noexcept
+  {
+    const float64_t origin = is_x ? m_origin.get_coord().first : m_origin.get_coord().second;
+    return static_cast<int64_t>(floor((coordinate - origin) / OBSTACLE_GRID_RESOLUTION));
+  }
+
+  Point2D<float64_t> m_origin{};
+  int64_t m_num_cells{0};
+  std::vector<float64_t> m_distances{};
+};
+
+/// \brief Check with the obstacle grid that the bounding box of the vehicle in the given state
+///        is away from all obstacles.
+/// \return true if every covering circle is farther from the obstacles than its radius, false if
+///         this cannot be told from the grid and the polytopes need to be checked
+static bool check_free_in_obstacle_grid(
+  const VehicleState<float64_t> & vehicle_state,
+  const CoveringCircles & circles,
+  const ObstacleDistanceGrid & grid)
+{
+  // The distance at a point differs from the one at its cell center by at most half the diagonal
+  const float64_t min_distance = circles.radius + 0.5 * sqrt(2.0) * OBSTACLE_GRID_RESOLUTION;
+  const float64_t cos_heading = cos(vehicle_state.get_heading());
+  const float64_t sin_heading = sin(vehicle_state.get_heading());
+  for (const auto & center : circles.centers) {
+    const float64_t x = center.get_coord().first;
+    const float64_t y = center.get_coord().second;
+    const float64_t distance = grid.get_distance(
+      x * cos_heading - y * sin_heading + vehicle_state.get_x(),
+      x * sin_heading + y * cos_heading + vehicle_state.get_y());
+    if (distance <= min_distance) {
+      return false;
+    }
+  }
+  return true;
+}
+
 static uint64_t map_state_on_discretized_grid(
   const VehicleState<float64_t> & state,
   const VehicleState<float64_t> & reference)
@@ -112,17 +285,91 @@ static uint64_t map_state_on_discretized_grid(
   return h_quant * num_position_steps * num_position_steps + y_quant * num_position_steps + x_quant;
 }
 
+/// \brief Hash map from discretized states to node indices, stored in flat arrays with open
+///        addressing and linear probing. Entries are never removed.
+class ClosedSet
+{
+public:
+  ClosedSet()
+  : m_keys(INITIAL_CAPACITY), m_nodes(INITIAL_CAPACITY, NO_NODE)
+  {
+  }
+
+  /// \brief Check if a discretized state is in the set
+  bool contains(const uint64_t key) const noexcept
+  {
+    return NO_NODE != m_nodes[find_slot(key)];
+  }
+
+  /// \brief Get the node of a discretized state that is in the set
+  size_t at(const uint64_t key) const noexcept
+  {
+    return m_nodes[find_slot(key)];
+  }
+
+  /// \brief Add a discretized state that is not in the set yet
+  void insert(const uint64_t key, const size_t node)
+  {
+    // keep the load at most one half, so that the probe sequences stay short
+    if (2U * (m_size + 1U) > m_keys.size()) {
+      grow();
+    }
+    const size_t slot = find_slot(key);
+    m_keys[slot] = key;
+    m_nodes[slot] = node;
+    ++m_size;
+  }
+
+private:
+  static constexpr size_t INITIAL_CAPACITY = 1024U;
+  static constexpr size_t NO_NODE = std::numeric_limits<size_t>::max();
+
+  size_t find_slot(const uint64_t key) const noexcept
+  {
+    const size_t mask = m_keys.size() - 1U;
+    size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32U) & mask;
+    while ((NO_NODE != m_nodes[slot]) && (m_keys[slot] != key)) {
+      slot = (slot + 1U) & mask;
+    }
+    return slot;
+  }
+
+  void grow()
+  {
+    std::vector<uint64_t> keys(2U * m_keys.size());
+    std::vector<size_t> nodes(2U * m_nodes.size(), NO_NODE);
+    keys.swap(m_keys);
+    nodes.swap(m_nodes);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (NO_NODE != nodes[i]) {
+        const size_t slot = find_slot(keys[i]);
+        m_keys[slot] = keys[i];
+        m_nodes[slot] = nodes[i];
+      }
+    }
+  }
+
+  std::vector<uint64_t> m_keys;
+  std::vector<size_t> m_nodes;
+  size_t m_size{0U};
+};
+
 std::vector<VehicleState<float64_t>> AstarPathPlanner::plan_astar(
   const VehicleState<float64_t> & current_state,
   const VehicleState<float64_t> & goal_state,
   const Polytope2D<float64_t> & vehicle_bounding_box,
   const std::vector<Polytope2D<float64_t>> & obstacles) const
 {
-  // Prepare data structure definitions
-  using StateTransition = std::pair<std::pair<VehicleState<float64_t>, VehicleState<float64_t>>,
-      std::pair<uint64_t, uint64_t>>;
+  // Prepare data structure definitions. The queue only refers to the nodes, which are kept in
+  // one vector, and a node refers to its parent by index.
+  struct Node
+  {
+    VehicleState<float64_t> state;
+    uint64_t discrete;
+    size_t parent;
+  };
   using CostPair = std::pair<float64_t, float64_t>;
-  using QueueElement = std::pair<CostPair, StateTransition>;
+  using QueueElement = std::pair<CostPair, size_t>;
 
   auto my_compare_queue_element =
     [](const QueueElement & e1, const QueueElement & e2)
@@ -134,11 +381,27 @@ std::vector<VehicleState<float64_t>> AstarPathPlanner::plan_astar(
       std::vector<QueueElement>,
       decltype(my_compare_queue_element)>;
 
-  using ClosedSet = std::unordered_map<uint64_t,
-      StateTransition>;
-
+  std::vector<Node> nodes;
   OpenSet open_set(my_compare_queue_element);
   ClosedSet closed_set;
+  std::array<VehicleState<float64_t>, NUM_EXPANDED_STATES> expanded_states;
+
+  // Build the grid of the distances to the obstacles around the goal once, so that only the
+  // states close to an obstacle need the polytope checks
+  const CoveringCircles circles = compute_covering_circles(vehicle_bounding_box);
+  const bool use_obstacle_grid =
+    m_use_obstacle_grid && !obstacles.empty() && !circles.centers.empty();
+  ObstacleDistanceGrid obstacle_grid{};
+  if (use_obstacle_grid) {
+    float64_t max_center_offset = 0.0;
+    for (const auto & center : circles.centers) {
+      max_center_offset = std::max(max_center_offset, center.norm2());
+    }
+    obstacle_grid = ObstacleDistanceGrid(
+      Point2D<float64_t>(goal_state.get_x(), goal_state.get_y()),
+      parking_planner::MAX_EXPLORATION_RADIUS + max_center_offset,
+      circles.radius + parking_planner::OBSTACLE_GRID_RESOLUTION, obstacles);
+  }
 
   // Initialize data structures for the given problem data
   Point2D<float64_t> vect_current_to_goal = Point2D<float64_t>(
@@ -148,32 +411,34 @@ std::vector<VehicleState<float64_t>> AstarPathPlanner::plan_astar(
   float64_t dist_current_to_goal = vect_current_to_goal.norm2();
   uint64_t current_discrete = map_state_on_discretized_grid(current_state, goal_state);
   uint64_t goal_discrete = map_state_on_discretized_grid(goal_state, goal_state);
-  open_set.push(
-    {{dist_current_to_goal, 0},
-      {{current_state, current_state},
-        {current_discrete, current_discrete}}});
+  nodes.push_back({current_state, current_discrete, 0U});
+  open_set.push({{dist_current_to_goal, 0}, 0U});
 
   // Run the main exploration loop
   size_t num_nodes_left = parking_planner::MAX_NUM_EXPLORATION_NODES;
   while (!open_set.empty() && (0 != num_nodes_left--)) {
-    QueueElement top_element = open_set.top();
+    const QueueElement top_element = open_set.top();
     open_set.pop();
-    const float64_t & f_cost = top_element.first.second;
-    const VehicleState<float64_t> & to_state = top_element.second.first.second;
-    const uint64_t & to_discrete = top_element.second.second.second;
+    const float64_t f_cost = top_element.first.second;
+    const size_t to_node = top_element.second;
+    const uint64_t to_discrete = nodes[to_node].discrete;
 
-    if (!closed_set.count(to_discrete)) {
-      closed_set[to_discrete] = top_element.second;
+    if (!closed_set.contains(to_discrete)) {
+      closed_set.insert(to_discrete, to_node);
       if (to_discrete == goal_discrete) {
         break;
       }
 
-      if (!check_collision_bounding_box_vs_obstacles(to_state, vehicle_bounding_box, obstacles)) {
-        const std::vector<VehicleState<float64_t>> expanded_states =
-          expand_state_longitudinal_with_heading(to_state);
+      // copy the state, nodes may reallocate while the expanded states are added
+      const VehicleState<float64_t> to_state = nodes[to_node].state;
+      const bool is_free =
+        (use_obstacle_grid && check_free_in_obstacle_grid(to_state, circles, obstacle_grid)) ||
+        !check_collision_bounding_box_vs_obstacles(to_state, vehicle_bounding_box, obstacles);
+      if (is_free) {
+        expand_state_longitudinal_with_heading(to_state, expanded_states);
         for (const VehicleState<float64_t> & next_state : expanded_states) {
           uint64_t next_discrete = map_state_on_discretized_grid(next_state, goal_state);
-          if (!closed_set.count(next_discrete)) {
+          if (!closed_set.contains(next_discrete)) {
             float64_t next_f_cost = f_cost + parking_planner::DELTA_LONGITUDINAL;
             Point2D<float64_t> vect_to_goal = Point2D<float64_t>(
               next_state.get_x(), next_state.get_y()) -
@@ -181,10 +446,8 @@ std::vector<VehicleState<float64_t>> AstarPathPlanner::plan_astar(
             float64_t dist_to_goal = vect_to_goal.norm2();
             if (dist_to_goal < parking_planner::MAX_EXPLORATION_RADIUS) {
               float64_t next_g_cost = f_cost + dist_to_goal;
-              open_set.push(
-                {{next_g_cost, next_f_cost},
-                  {{to_state, next_state},
-                    {to_discrete, next_discrete}}});
+              nodes.push_back({next_state, next_discrete, to_node});
+              open_set.push({{next_g_cost, next_f_cost}, nodes.size() - 1U});
             }
           }
         }
@@ -194,12 +457,12 @@ std::vector<VehicleState<float64_t>> AstarPathPlanner::plan_astar(
 
   // Done exploring, assemble the output path from the results
   std::vector<VehicleState<float64_t>> result;
-  uint64_t destination_discrete = goal_discrete;
-  while (0 != closed_set.count(destination_discrete) &&
-    (destination_discrete != current_discrete))
-  {
-    result.emplace_back(closed_set[destination_discrete].first.first);
-    destination_discrete = closed_set[destination_discrete].second.first;
+  if (closed_set.contains(goal_discrete)) {
+    size_t node = closed_set.at(goal_discrete);
+    while (nodes[node].discrete != current_discrete) {
+      node = nodes[node].parent;
+      result.emplace_back(nodes[node].state);
+    }
   }
   result.push_back(current_state);
   std::reverse(result.begin(), result.end());
@@ -187,6 +187,25 @@ std::vector<NLPObstacle<double>> create_obstacles_from_polyhedra(
   return nlp_obstacle_list;
 }
 
+// NOTE set print_level to higher for debugging purposes. The hessian approximation has to be
+// kept the same as in generate_nlp_planner_solver, because different settings lead to different
+// callbacks being created. Loading the callbacks and setting up IPOPT is done once per solver.
+static casadi::Function create_solver(const bool warm_start)
+{
+  casadi::Dict ipopt_options = {{"hessian_approximation", "limited-memory"}, {"print_level", 0},
+    {"max_iter", 500}};
+  if (warm_start) {
+    // Keep the given multipliers and the initial guess close to where they are, instead of
+    // pushing them away from the bounds as for a cold start
+    ipopt_options["warm_start_init_point"] = "yes";
+    ipopt_options["warm_start_bound_push"] = 1e-6;
+    ipopt_options["warm_start_mult_bound_push"] = 1e-6;
+  }
+  return casadi::nlpsol(
+    "solver", "ipopt", SHARED_LIBRARY_DIRECTORY + "/" +
+    "libparking_planner_callbacks.so", {{"ipopt", ipopt_options}});
+}
+
 NLPPathPlanner::NLPPathPlanner(
   const NLPCostWeights<double> & cost_weights,
   const VehicleState<double> & lower_state_bounds,
@@ -194,7 +213,9 @@ NLPPathPlanner::NLPPathPlanner(
   const VehicleCommand<double> & lower_command_bounds,
   const VehicleCommand<double> & upper_command_bounds
 )
-: m_cost_weights(cost_weights)
+: m_cost_weights(cost_weights),
+  m_solver(create_solver(false)),
+  m_warm_start_solver(create_solver(true))
 {
   m_lower_state_bounds = lower_state_bounds;
   m_upper_state_bounds = upper_state_bounds;
@@ -320,6 +341,20 @@ NLPResults NLPPathPlanner::plan_nlp(
   const std::vector<Polytope2D<double>> & obstacles,
   const BicycleModelParameters<double> & model_parameters
 ) const
+{
+  return plan_nlp(
+    current_state, goal_state, initial_guess, obstacles, model_parameters,
+    NLPResults{Trajectory<float64_t>{}, casadi::Dict{}, {}, {}});
+}
+
+NLPResults NLPPathPlanner::plan_nlp(
+  const VehicleState<double> & current_state,
+  const VehicleState<double> & goal_state,
+  const Trajectory<double> & initial_guess,
+  const std::vector<Polytope2D<double>> & obstacles,
+  const BicycleModelParameters<double> & model_parameters,
+  const NLPResults & previous_results
+) const
 {
   // Assemble solver inputs
   std::vector<NLPObstacle<double>> nlp_obstacles{};
@@ -327,7 +362,7 @@ NLPResults NLPPathPlanner::plan_nlp(
     nlp_obstacles = create_obstacles_from_polyhedra(obstacles, current_state);
   } catch (const std::length_error & e) {
     std::cout << e.what() << std::endl;
-    return NLPResults{Trajectory<float64_t>{}, casadi::Dict{}};
+    return NLPResults{Trajectory<float64_t>{}, casadi::Dict{}, {}, {}};
   }
   auto p = assemble_parameter_vector(
     current_state, goal_state, model_parameters, nlp_obstacles, m_cost_weights);
@@ -336,25 +371,28 @@ NLPResults NLPPathPlanner::plan_nlp(
     m_lower_state_bounds, m_upper_state_bounds, m_lower_command_bounds, m_upper_command_bounds);
   auto constraint_bounds = create_constraint_bounds();
 
-  // NOTE set print_level to higher for debugging purposes. The hessian approximation has to be
-  // kept the same as in generate_nlp_planner_solver, because different settings lead to different
-  // callbacks being created.
-  casadi::Dict ipopt_options = {{"hessian_approximation", "limited-memory"}, {"print_level", 0},
-    {"max_iter", 500}};
-  casadi::Function solver = casadi::nlpsol(
-    "solver", "ipopt", SHARED_LIBRARY_DIRECTORY + "/" +
-    "libparking_planner_callbacks.so", {{"ipopt", ipopt_options}});
+  casadi::DMDict solver_inputs{
+    {"x0", vars_and_bounds.variables},
+    {"p", p},
+    {"ubg", constraint_bounds.upper},
+    {"lbg", constraint_bounds.lower},
+    {"ubx", vars_and_bounds.upper_bounds},
+    {"lbx", vars_and_bounds.lower_bounds},
+  };
+
+  // Start from the previous multipliers if there are any. The problem dimensions are fixed at
+  // code generation, so they always fit unless the previous solve failed before the solver.
+  const bool warm_start =
+    (previous_results.m_variable_multipliers.size() == vars_and_bounds.variables.size()) &&
+    (previous_results.m_constraint_multipliers.size() == constraint_bounds.upper.size());
+  if (warm_start) {
+    solver_inputs["lam_x0"] = previous_results.m_variable_multipliers;
+    solver_inputs["lam_g0"] = previous_results.m_constraint_multipliers;
+  }
+  const casadi::Function & solver = warm_start ? m_warm_start_solver : m_solver;
 
   // Call solver with the assembled data
-  casadi::DMDict res = solver(
-    casadi::DMDict{
-            {"x0", vars_and_bounds.variables},
-            {"p", p},
-            {"ubg", constraint_bounds.upper},
-            {"lbg", constraint_bounds.lower},
-            {"ubx", vars_and_bounds.upper_bounds},
-            {"lbx", vars_and_bounds.lower_bounds},
-          });
+  casadi::DMDict res = solver(solver_inputs);
 
   // Get some info about the solve
   auto stats = solver.stats();
@@ -362,7 +400,8 @@ NLPResults NLPPathPlanner::plan_nlp(
   // Extract and return results
   std::vector<double> elements = res["x"].get_elements();
   auto resulting_trajectory = disassemble_variable_vector(elements, HORIZON_LENGTH);
-  return NLPResults{resulting_trajectory, stats};
+  return NLPResults{resulting_trajectory, stats, res["lam_x"].get_elements(),
+    res["lam_g"].get_elements()};
 }
 
 }  // namespace parking_planner
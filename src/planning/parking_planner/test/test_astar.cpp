@@ -454,3 +454,45 @@ TEST(AstarPathPlanner, InfeasibleSituationCurrentWalled) {
   EXPECT_EQ(num_collisions, 0);
   EXPECT_EQ(vehicle_states.size(), 1U);
 }
+
+TEST(AstarPathPlanner, ObstacleGridSamePath) {
+  const VehicleState current_state(0.0, 0.0, 0.0, 0, 0.0);
+  const VehicleState goal_state(4.0, -1.5, 0.0, 0, 0.0);
+
+  // Set some parameters, then compute the bounding box from those
+  const auto parameters = BicycleModelParameters(0.8, 0.8, 1.0, 0.1, 0.1);
+  const auto model = BicycleModel(parameters);
+  const auto vehicle_bounding_box = model.compute_bounding_box(VehicleState{});
+
+  // a row of parked cars with a gap at the goal, and another row across the lane
+  std::vector<Polytope2D> obstacles;
+  for (int32_t i = -3; i < 6; ++i) {
+    const float64_t x = 4.0 * static_cast<float64_t>(i);
+    if (i != 1) {
+      obstacles.push_back(
+        Polytope2D(
+          std::vector<Point2D>(
+            {{x + 1.8, -0.8}, {x - 1.8, -0.8}, {x - 1.8, -2.5}, {x + 1.8, -2.5}})));
+    }
+    obstacles.push_back(
+      Polytope2D(
+        std::vector<Point2D>({{x + 1.8, 4.5}, {x - 1.8, 4.5}, {x - 1.8, 2.8}, {x + 1.8, 2.8}})));
+  }
+
+  const auto exact_planner = autoware::motion::planning::parking_planner::AstarPathPlanner(false);
+  const auto grid_planner = autoware::motion::planning::parking_planner::AstarPathPlanner(true);
+
+  const std::vector<VehicleState> exact_states =
+    exact_planner.plan_astar(current_state, goal_state, vehicle_bounding_box, obstacles);
+  const std::vector<VehicleState> grid_states =
+    grid_planner.plan_astar(current_state, goal_state, vehicle_bounding_box, obstacles);
+
+  // the grid only skips the exact checks of states that are away from the obstacles
+  ASSERT_EQ(grid_states.size(), exact_states.size());
+  for (size_t i = 0; i < grid_states.size(); ++i) {
+    EXPECT_EQ(grid_states[i].get_x(), exact_states[i].get_x());
+    EXPECT_EQ(grid_states[i].get_y(), exact_states[i].get_y());
+    EXPECT_EQ(grid_states[i].get_heading(), exact_states[i].get_heading());
+  }
+  EXPECT_GT(grid_states.size(), 1U);
+}
@@ -84,3 +84,37 @@ TEST(BicycleModel, SimpleSolve) {
     parameters);
   const auto trajectory2 = results2.m_trajectory;
 }
+
+TEST(BicycleModel, WarmStartedSolve) {
+  const auto parameters = BicycleModelParameters(1.5, 1.5, 2, 0.5, 0.5);
+  const NLPCostWeights weights(1.0, 1.0, 0.0);
+  const VehicleState lower_state_bounds(-100, -100, -10, -2 * 3.14156, -0.52);
+  const VehicleState upper_state_bounds(+100, +100, +10, +2 * 3.14156, +0.52);
+  const VehicleCommand lower_command_bounds(-3.0, -50);
+  const VehicleCommand upper_command_bounds(+3.0, +50);
+  std::vector<Polytope2D> obstacles{};
+
+  const auto start = VehicleState(5.0, 0.0, 0.0, 0.5, 0.0);
+  const auto goal = VehicleState(-1.0, 1.0, 0.0, 0.0, 0.0);
+  const auto nlp_path_planner = NLPPathPlanner(
+    weights,
+    lower_state_bounds, upper_state_bounds,
+    lower_command_bounds, upper_command_bounds);
+  const auto cold_results = nlp_path_planner.plan_nlp(
+    start, goal, create_dummy_initial_guess(), obstacles,
+    parameters);
+  EXPECT_FALSE(cold_results.m_variable_multipliers.empty());
+  EXPECT_FALSE(cold_results.m_constraint_multipliers.empty());
+
+  // Solving the same problem again from its solution and multipliers takes no more iterations
+  const auto warm_results = nlp_path_planner.plan_nlp(
+    start, goal, cold_results.m_trajectory, obstacles,
+    parameters, cold_results);
+  EXPECT_EQ(
+    warm_results.m_variable_multipliers.size(), cold_results.m_variable_multipliers.size());
+  EXPECT_EQ(
+    warm_results.m_constraint_multipliers.size(), cold_results.m_constraint_multipliers.size());
+  EXPECT_LE(
+    warm_results.m_solve_info.at("iter_count").to_int(),
+    cold_results.m_solve_info.at("iter_count").to_int());
+}
@@ -24,6 +24,7 @@
 #include <deque>
 #include <string>
 #include <map>
+#include <vector>
 
 using autoware::common::types::bool8_t;
 using autoware::common::types::float64_t;
@@ -45,6 +46,29 @@ enum class RecordReplayState
   REPLAYING
 };  // enum class RecordReplayState
 
+/// \brief Formats of the files the recorded trajectory can be written to
+enum class RecordFileFormat
+{
+  /// Comma-separated values with a header line, for interchange with other tools
+  CSV,
+  /// Versioned header followed by the packed points, replayed from a memory mapping
+  BINARY
+};  // enum class RecordFileFormat
+
+/// \brief Grid of the positions of the recorded states, for the search of the closest state
+struct StateGrid
+{
+  float64_t min_x{0.0};
+  float64_t min_y{0.0};
+  float64_t cell_size{1.0};
+  std::size_t num_cells_x{0U};
+  std::size_t num_cells_y{0U};
+  /// Indices of the recorded states, sorted by cell
+  std::vector<std::size_t> state_indices;
+  /// Offset of the first state of each cell in state_indices, with one extra element at the end
+  std::vector<std::size_t> cell_offsets;
+};  // struct StateGrid
+
 /// \brief A class for recording trajectories and replaying them as plans
 class RECORDREPLAY_PLANNER_PUBLIC RecordReplayPlanner
 {
@@ -82,8 +106,21 @@ public:
   void set_min_record_distance(float64_t min_record_distance);
   float64_t get_min_record_distance() const;
 
-  // Writing/Loading buffered trajectory information to/from disk
-  void writeTrajectoryBufferToFile(const std::string & record_path);
+  /// \brief Set the number of states after the closest state of the previous plan that the
+  ///   closest state is searched in, 0 to always search all states
+  void set_search_window_size(std::size_t search_window_size) noexcept;
+  std::size_t get_search_window_size() const noexcept;
+
+  /// \brief Set the distance from the closest state in the search window beyond which all states
+  ///   are searched again, e.g. after the vehicle was moved
+  void set_relocalization_distance(float64_t relocalization_distance);
+  float64_t get_relocalization_distance() const;
+
+  // Writing/Loading buffered trajectory information to/from disk. The format of a file that is
+  // read is detected from its first bytes.
+  void writeTrajectoryBufferToFile(
+    const std::string & record_path,
+    const RecordFileFormat format = RecordFileFormat::CSV);
   void readTrajectoryBufferFromFile(const std::string & replay_path);
 
   /**
@@ -101,10 +138,29 @@ private:
   // Obtain a trajectory from the internally-stored recording buffer
   RECORDREPLAY_PLANNER_LOCAL const Trajectory & from_record(const State & current_state);
   RECORDREPLAY_PLANNER_LOCAL std::size_t get_closest_state(const State & current_state);
+  RECORDREPLAY_PLANNER_LOCAL std::size_t get_closest_state_in_window(
+    const State & current_state) const;
+  RECORDREPLAY_PLANNER_LOCAL std::size_t get_closest_state_in_grid(const State & current_state);
+  RECORDREPLAY_PLANNER_LOCAL void writeTrajectoryBufferToCsvFile(const std::string & record_path);
+  RECORDREPLAY_PLANNER_LOCAL void writeTrajectoryBufferToBinaryFile(
+    const std::string & record_path);
+  RECORDREPLAY_PLANNER_LOCAL void readTrajectoryBufferFromCsvFile(const std::string & replay_path);
+  RECORDREPLAY_PLANNER_LOCAL void readTrajectoryBufferFromBinaryFile(
+    const std::string & replay_path);
 
   // Weight of heading in computations of differences between states
   float64_t m_heading_weight = 0.1;
   float64_t m_min_record_distance = 0.0;
+  std::size_t m_search_window_size = 0U;
+  float64_t m_relocalization_distance = 0.0;
+
+  // Closest state of the previous plan, which the windowed search starts from
+  std::size_t m_closest_state_idx{};
+  bool8_t m_closest_state_valid{false};
+  // Grid of the recorded states, which is rebuilt when the grid search needs it after a change of
+  // the record buffer
+  StateGrid m_state_grid{};
+  bool8_t m_state_grid_valid{false};
 
   std::size_t m_traj_start_idx{};
   std::size_t m_traj_end_idx{};
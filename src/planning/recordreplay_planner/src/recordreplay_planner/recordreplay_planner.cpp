@@ -19,10 +19,17 @@
 #include <motion_common/motion_common.hpp>
 #include <common/types.hpp>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -105,6 +112,91 @@ bool loadData(
 
   return true;
 }
+
+// Layout of the binary trajectory files: a header, then the packed points in recording order.
+// The fields are stored in the byte order of the host, which is little-endian on all supported
+// platforms.
+constexpr char8_t BINARY_MAGIC[8] = {'A', 'W', 'T', 'R', 'A', 'J', '\0', '\0'};
+constexpr uint32_t BINARY_VERSION = 1U;
+
+struct BinaryHeader
+{
+  char8_t magic[8];
+  uint32_t version;
+  uint32_t point_size;
+  uint64_t num_points;
+};
+
+struct BinaryPoint
+{
+  int32_t t_sec;
+  uint32_t t_nanosec;
+  float32_t x;
+  float32_t y;
+  float32_t heading_real;
+  float32_t heading_imag;
+  float32_t longitudinal_velocity_mps;
+  float32_t lateral_velocity_mps;
+  float32_t acceleration_mps2;
+  float32_t heading_rate_rps;
+  float32_t front_wheel_angle_rad;
+  float32_t rear_wheel_angle_rad;
+};
+
+static_assert(sizeof(BinaryHeader) == 24U, "BinaryHeader must be packed");
+static_assert(sizeof(BinaryPoint) == 48U, "BinaryPoint must be packed");
+
+// Read-only memory mapping of a whole file, which is unmapped on destruction
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string & file_name)
+  {
+    const auto fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Could not open " + file_name);
+    }
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Could not stat " + file_name);
+    }
+    m_size = static_cast<std::size_t>(file_stat.st_size);
+    if (m_size > 0U) {
+      m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping stays valid after the file descriptor is closed
+    ::close(fd);
+    if (m_data == MAP_FAILED) {
+      throw std::runtime_error("Could not map " + file_name);
+    }
+  }
+
+  ~MappedFile()
+  {
+    if ((m_data != nullptr) && (m_data != MAP_FAILED)) {
+      ::munmap(m_data, m_size);
+    }
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  const uchar8_t * data() const noexcept {return static_cast<const uchar8_t *>(m_data);}
+  std::size_t size() const noexcept {return m_size;}
+
+private:
+  void * m_data{nullptr};
+  std::size_t m_size{0U};
+};
+
+bool8_t isBinaryTrajectoryFile(const std::string & file_name)
+{
+  std::ifstream ifs(file_name, std::ios::binary);
+  char8_t magic[sizeof(BINARY_MAGIC)] = {};
+  ifs.read(magic, sizeof(magic));
+  return ifs && (std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0);
+}
 }  // namespace
 namespace motion
 {
@@ -115,6 +207,71 @@ namespace recordreplay_planner
 using geometry_msgs::msg::Point32;
 using motion::motion_common::to_angle;
 
+namespace
+{
+// Distance between the current state and a recorded state that the closest state minimizes
+float32_t distance_from_current_state(
+  const State & current_state, const State & other_state, const float64_t heading_weight)
+{
+  const auto s1 = current_state.state, s2 = other_state.state;
+  return (s1.x - s2.x) * (s1.x - s2.x) + (s1.y - s2.y) * (s1.y - s2.y) +
+         static_cast<float32_t>(heading_weight) * std::abs(to_angle(s1.heading - s2.heading));
+}
+
+// Aim for a few cells per recorded state, so that a cell holds a short piece of the route
+constexpr float64_t GRID_CELLS_PER_STATE = 4.0;
+constexpr float64_t GRID_MIN_CELL_SIZE = 1.0;
+
+StateGrid build_state_grid(const std::deque<State> & states)
+{
+  StateGrid grid;
+  if (states.empty()) {
+    return grid;
+  }
+  auto max_x = static_cast<float64_t>(states.front().state.x);
+  auto max_y = static_cast<float64_t>(states.front().state.y);
+  grid.min_x = max_x;
+  grid.min_y = max_y;
+  for (const auto & s : states) {
+    grid.min_x = std::min(grid.min_x, static_cast<float64_t>(s.state.x));
+    grid.min_y = std::min(grid.min_y, static_cast<float64_t>(s.state.y));
+    max_x = std::max(max_x, static_cast<float64_t>(s.state.x));
+    max_y = std::max(max_y, static_cast<float64_t>(s.state.y));
+  }
+  const auto area = (max_x - grid.min_x) * (max_y - grid.min_y);
+  grid.cell_size = std::max(
+    std::sqrt(area / (GRID_CELLS_PER_STATE * static_cast<float64_t>(states.size()))),
+    GRID_MIN_CELL_SIZE);
+  grid.num_cells_x = static_cast<std::size_t>((max_x - grid.min_x) / grid.cell_size) + 1U;
+  grid.num_cells_y = static_cast<std::size_t>((max_y - grid.min_y) / grid.cell_size) + 1U;
+
+  // Sort the states into the cells with a counting sort, which keeps them in recording order in
+  // each cell
+  const auto cell_of = [&grid](const State & s) {
+      const auto i = std::min(
+        static_cast<std::size_t>((static_cast<float64_t>(s.state.x) - grid.min_x) /
+        grid.cell_size), grid.num_cells_x - 1U);
+      const auto j = std::min(
+        static_cast<std::size_t>((static_cast<float64_t>(s.state.y) - grid.min_y) /
+        grid.cell_size), grid.num_cells_y - 1U);
+      return i * grid.num_cells_y + j;
+    };
+  grid.cell_offsets.assign(grid.num_cells_x * grid.num_cells_y + 1U, 0U);
+  for (const auto & s : states) {
+    ++grid.cell_offsets[cell_of(s) + 1U];
+  }
+  for (std::size_t cell = 1U; cell < grid.cell_offsets.size(); ++cell) {
+    grid.cell_offsets[cell] += grid.cell_offsets[cell - 1U];
+  }
+  grid.state_indices.resize(states.size());
+  std::vector<std::size_t> cell_fill{grid.cell_offsets.begin(), grid.cell_offsets.end() - 1};
+  for (std::size_t idx = 0U; idx < states.size(); ++idx) {
+    grid.state_indices[cell_fill[cell_of(states[idx])]++] = idx;
+  }
+  return grid;
+}
+}  // namespace
+
 RecordReplayPlanner::RecordReplayPlanner() {}
 
 // These may do more in the future
@@ -141,6 +298,7 @@ void RecordReplayPlanner::stop_recording() noexcept
 void RecordReplayPlanner::start_replaying() noexcept
 {
   m_recordreplaystate = RecordReplayState::REPLAYING;
+  m_closest_state_valid = false;
 }
 
 void RecordReplayPlanner::stop_replaying() noexcept
@@ -151,6 +309,8 @@ void RecordReplayPlanner::stop_replaying() noexcept
 void RecordReplayPlanner::clear_record() noexcept
 {
   m_record_buffer.clear();
+  m_closest_state_valid = false;
+  m_state_grid_valid = false;
 }
 
 std::size_t RecordReplayPlanner::get_record_length() const noexcept
@@ -185,11 +345,35 @@ float64_t RecordReplayPlanner::get_min_record_distance() const
   return m_min_record_distance;
 }
 
+void RecordReplayPlanner::set_search_window_size(std::size_t search_window_size) noexcept
+{
+  m_search_window_size = search_window_size;
+}
+
+std::size_t RecordReplayPlanner::get_search_window_size() const noexcept
+{
+  return m_search_window_size;
+}
+
+void RecordReplayPlanner::set_relocalization_distance(float64_t relocalization_distance)
+{
+  if (relocalization_distance < 0.0) {
+    throw std::domain_error{"Negative relocalization distance does not make sense"};
+  }
+  m_relocalization_distance = relocalization_distance;
+}
+
+float64_t RecordReplayPlanner::get_relocalization_distance() const
+{
+  return m_relocalization_distance;
+}
+
 
 bool RecordReplayPlanner::record_state(const State & state_to_record)
 {
   if (m_record_buffer.empty()) {
     m_record_buffer.push_back(state_to_record);
+    m_state_grid_valid = false;
     return true;
   }
 
@@ -201,6 +385,7 @@ bool RecordReplayPlanner::record_state(const State & state_to_record)
 
   if (static_cast<float64_t>(distance_sq) >= (m_min_record_distance * m_min_record_distance) ) {
     m_record_buffer.push_back(state_to_record);
+    m_state_grid_valid = false;
     return true;
   } else {
     return false;
@@ -215,25 +400,114 @@ const Trajectory & RecordReplayPlanner::plan(const State & current_state)
 
 std::size_t RecordReplayPlanner::get_closest_state(const State & current_state)
 {
-  // Find the closest point to the current state in the stored states buffer
-  const auto distance_from_current_state =
-    [this, &current_state](State & other_state) {
-      const auto s1 = current_state.state, s2 = other_state.state;
-      return (s1.x - s2.x) * (s1.x - s2.x) + (s1.y - s2.y) * (s1.y - s2.y) +
-             static_cast<float32_t>(m_heading_weight) * std::abs(to_angle(s1.heading - s2.heading));
-    };
-  const auto comparison_function =
-    [&distance_from_current_state](State & one, State & two)
-    {return distance_from_current_state(one) < distance_from_current_state(two);};
+  // Follow the recording forward from the closest state of the previous plan, as long as the
+  // vehicle stays close to it
+  if ((m_search_window_size > 0U) && m_closest_state_valid &&
+    (m_closest_state_idx < m_record_buffer.size()))
+  {
+    const auto window_idx = get_closest_state_in_window(current_state);
+    const auto & s1 = current_state.state;
+    const auto & s2 = m_record_buffer[window_idx].state;
+    const auto dx = static_cast<float64_t>(s1.x - s2.x);
+    const auto dy = static_cast<float64_t>(s1.y - s2.y);
+    if ((dx * dx + dy * dy) <= (m_relocalization_distance * m_relocalization_distance)) {
+      m_closest_state_idx = window_idx;
+      return window_idx;
+    }
+  }
 
+  // Otherwise find the closest state among all recorded states
+  m_closest_state_idx = get_closest_state_in_grid(current_state);
+  m_closest_state_valid = true;
+  return m_closest_state_idx;
+}
 
-  const auto minimum_index_iterator =
-    std::min_element(
-    std::begin(m_record_buffer), std::end(m_record_buffer),
-    comparison_function);
-  auto minimum_idx = std::distance(std::begin(m_record_buffer), minimum_index_iterator);
+std::size_t RecordReplayPlanner::get_closest_state_in_window(const State & current_state) const
+{
+  const auto window_end = m_closest_state_idx +
+    std::min(m_search_window_size, m_record_buffer.size() - m_closest_state_idx);
+  auto minimum_idx = m_closest_state_idx;
+  auto minimum_distance = distance_from_current_state(
+    current_state, m_record_buffer[minimum_idx], m_heading_weight);
+  for (auto idx = m_closest_state_idx + 1U; idx < window_end; ++idx) {
+    const auto distance =
+      distance_from_current_state(current_state, m_record_buffer[idx], m_heading_weight);
+    if (distance < minimum_distance) {
+      minimum_distance = distance;
+      minimum_idx = idx;
+    }
+  }
+  return minimum_idx;
+}
 
-  return static_cast<std::size_t>(minimum_idx);
+std::size_t RecordReplayPlanner::get_closest_state_in_grid(const State & current_state)
+{
+  if (m_record_buffer.empty()) {
+    return 0U;
+  }
+  if (!m_state_grid_valid) {
+    m_state_grid = build_state_grid(m_record_buffer);
+    m_state_grid_valid = true;
+  }
+  const auto & grid = m_state_grid;
+
+  // Visit the rings of cells around the cell of the current state until no state in the next ring
+  // can be closer than the closest state so far. The states of ring k are at least (k - 1) cells
+  // away, and the heading term of the distance is not negative.
+  const auto num_x = static_cast<int64_t>(grid.num_cells_x);
+  const auto num_y = static_cast<int64_t>(grid.num_cells_y);
+  const auto ci = static_cast<int64_t>(
+    std::floor((static_cast<float64_t>(current_state.state.x) - grid.min_x) / grid.cell_size));
+  const auto cj = static_cast<int64_t>(
+    std::floor((static_cast<float64_t>(current_state.state.y) - grid.min_y) / grid.cell_size));
+  const auto first_ring = std::max(
+    {int64_t{0}, -ci, ci - (num_x - 1), -cj, cj - (num_y - 1)});
+  const auto last_ring = std::max({ci, num_x - 1 - ci, cj, num_y - 1 - cj});
+
+  auto minimum_idx = m_record_buffer.size();
+  auto minimum_distance = std::numeric_limits<float32_t>::max();
+  const auto visit_cell = [&](const int64_t i, const int64_t j) {
+      const auto cell = static_cast<std::size_t>(i * num_y + j);
+      for (auto k = grid.cell_offsets[cell]; k < grid.cell_offsets[cell + 1U]; ++k) {
+        const auto idx = grid.state_indices[k];
+        const auto distance =
+          distance_from_current_state(current_state, m_record_buffer[idx], m_heading_weight);
+        // Prefer the earliest state on ties, like a linear search over the recording
+        if ((distance < minimum_distance) ||
+          ((distance == minimum_distance) && (idx < minimum_idx)))
+        {
+          minimum_distance = distance;
+          minimum_idx = idx;
+        }
+      }
+    };
+  for (auto ring = first_ring; ring <= last_ring; ++ring) {
+    if (minimum_idx < m_record_buffer.size()) {
+      const auto ring_distance = static_cast<float64_t>(ring - 1) * grid.cell_size;
+      // Keep a margin for the rounding of the float distances
+      if ((ring > 1) &&
+        ((ring_distance * ring_distance) >
+        (static_cast<float64_t>(minimum_distance) * (1.0 + 1.0e-5) + 1.0e-6)))
+      {
+        break;
+      }
+    }
+    for (auto i = std::max(ci - ring, int64_t{0}); i <= std::min(ci + ring, num_x - 1); ++i) {
+      if ((i == ci - ring) || (i == ci + ring)) {
+        for (auto j = std::max(cj - ring, int64_t{0}); j <= std::min(cj + ring, num_y - 1); ++j) {
+          visit_cell(i, j);
+        }
+      } else {
+        if ((cj - ring) >= 0) {
+          visit_cell(i, cj - ring);
+        }
+        if ((ring > 0) && ((cj + ring) < num_y)) {
+          visit_cell(i, cj + ring);
+        }
+      }
+    }
+  }
+  return minimum_idx;
 }
 
 
@@ -293,12 +567,23 @@ const Trajectory & RecordReplayPlanner::from_record(const State & current_state)
   return trajectory;
 }
 
-void RecordReplayPlanner::writeTrajectoryBufferToFile(const std::string & record_path)
+void RecordReplayPlanner::writeTrajectoryBufferToFile(
+  const std::string & record_path,
+  const RecordFileFormat format)
 {
   if (record_path.empty()) {
     throw std::runtime_error("record_path cannot be empty");
   }
 
+  if (format == RecordFileFormat::BINARY) {
+    writeTrajectoryBufferToBinaryFile(record_path);
+  } else {
+    writeTrajectoryBufferToCsvFile(record_path);
+  }
+}
+
+void RecordReplayPlanner::writeTrajectoryBufferToCsvFile(const std::string & record_path)
+{
   std::ofstream ofs;
   ofs.open(record_path, std::ios::trunc);
   if (!ofs.is_open()) {
@@ -319,6 +604,48 @@ void RecordReplayPlanner::writeTrajectoryBufferToFile(const std::string & record
   ofs.close();
 }
 
+void RecordReplayPlanner::writeTrajectoryBufferToBinaryFile(const std::string & record_path)
+{
+  std::ofstream ofs;
+  ofs.open(record_path, std::ios::trunc | std::ios::binary);
+  if (!ofs.is_open()) {
+    throw std::runtime_error("Could not open file.");
+  }
+
+  BinaryHeader header{};
+  std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  header.version = BINARY_VERSION;
+  header.point_size = static_cast<uint32_t>(sizeof(BinaryPoint));
+  header.num_points = static_cast<uint64_t>(m_record_buffer.size());
+  ofs.write(reinterpret_cast<const char8_t *>(&header), sizeof(header));
+
+  // Write the points in chunks to keep the number of calls into the stream low
+  constexpr std::size_t CHUNK_SIZE = 1024U;
+  std::vector<BinaryPoint> chunk;
+  chunk.reserve(CHUNK_SIZE);
+  for (const auto & trajectory_point : m_record_buffer) {
+    const auto & s = trajectory_point.state;
+    chunk.push_back(
+      BinaryPoint{s.time_from_start.sec, s.time_from_start.nanosec, s.x, s.y,
+        s.heading.real, s.heading.imag, s.longitudinal_velocity_mps, s.lateral_velocity_mps,
+        s.acceleration_mps2, s.heading_rate_rps, s.front_wheel_angle_rad,
+        s.rear_wheel_angle_rad});
+    if (chunk.size() == CHUNK_SIZE) {
+      ofs.write(
+        reinterpret_cast<const char8_t *>(chunk.data()),
+        static_cast<std::streamsize>(chunk.size() * sizeof(BinaryPoint)));
+      chunk.clear();
+    }
+  }
+  ofs.write(
+    reinterpret_cast<const char8_t *>(chunk.data()),
+    static_cast<std::streamsize>(chunk.size() * sizeof(BinaryPoint)));
+  ofs.close();
+  if (!ofs) {
+    throw std::runtime_error("Could not write file.");
+  }
+}
+
 void RecordReplayPlanner::readTrajectoryBufferFromFile(const std::string & replay_path)
 {
   if (replay_path.empty()) {
@@ -328,6 +655,53 @@ void RecordReplayPlanner::readTrajectoryBufferFromFile(const std::string & repla
   // Clear current trajectory deque
   clear_record();
 
+  if (isBinaryTrajectoryFile(replay_path)) {
+    readTrajectoryBufferFromBinaryFile(replay_path);
+  } else {
+    readTrajectoryBufferFromCsvFile(replay_path);
+  }
+}
+
+void RecordReplayPlanner::readTrajectoryBufferFromBinaryFile(const std::string & replay_path)
+{
+  const MappedFile file{replay_path};
+  if (file.size() < sizeof(BinaryHeader)) {
+    throw std::runtime_error("Truncated trajectory file: " + replay_path);
+  }
+  BinaryHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if ((header.version != BINARY_VERSION) || (header.point_size != sizeof(BinaryPoint))) {
+    throw std::runtime_error("Unsupported trajectory file version: " + replay_path);
+  }
+  const auto num_points = static_cast<std::size_t>(header.num_points);
+  if ((file.size() - sizeof(BinaryHeader)) / sizeof(BinaryPoint) < num_points) {
+    throw std::runtime_error("Truncated trajectory file: " + replay_path);
+  }
+
+  // The points are copied out of the mapping field by field, without any parsing
+  const auto points = file.data() + sizeof(BinaryHeader);
+  State s;
+  for (std::size_t i = 0U; i < num_points; ++i) {
+    BinaryPoint p;
+    std::memcpy(&p, points + i * sizeof(BinaryPoint), sizeof(p));
+    s.state.time_from_start.sec = p.t_sec;
+    s.state.time_from_start.nanosec = p.t_nanosec;
+    s.state.x = p.x;
+    s.state.y = p.y;
+    s.state.heading.real = p.heading_real;
+    s.state.heading.imag = p.heading_imag;
+    s.state.longitudinal_velocity_mps = p.longitudinal_velocity_mps;
+    s.state.lateral_velocity_mps = p.lateral_velocity_mps;
+    s.state.acceleration_mps2 = p.acceleration_mps2;
+    s.state.heading_rate_rps = p.heading_rate_rps;
+    s.state.front_wheel_angle_rad = p.front_wheel_angle_rad;
+    s.state.rear_wheel_angle_rad = p.rear_wheel_angle_rad;
+    record_state(s);
+  }
+}
+
+void RecordReplayPlanner::readTrajectoryBufferFromCsvFile(const std::string & replay_path)
+{
   Csv file_data;
   Association map;  // row labeled Association map
   if (!loadData(replay_path, map, file_data)) {
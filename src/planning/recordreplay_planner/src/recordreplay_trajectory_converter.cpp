@@ -0,0 +1,49 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Offline tool to convert a recorded trajectory file between the CSV and the binary format of
+// the record replay planner.
+
+#include <common/types.hpp>
+#include <recordreplay_planner/recordreplay_planner.hpp>
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+using motion::planning::recordreplay_planner::RecordFileFormat;
+using motion::planning::recordreplay_planner::RecordReplayPlanner;
+
+int32_t main(const int32_t argc, char ** const argv)
+{
+  const std::string format = (argc == 4) ? std::string{argv[3]} : std::string{};
+  if ((argc != 4) || ((format != "csv") && (format != "binary"))) {
+    std::cerr << "Usage: " << argv[0] << " <input file> <output file> <csv|binary>" <<
+      std::endl << "The format of the input file is detected." << std::endl;
+    return 1;
+  }
+  try {
+    // The default minimum record distance of 0 keeps every recorded state
+    RecordReplayPlanner planner;
+    planner.readTrajectoryBufferFromFile(argv[1]);
+    planner.writeTrajectoryBufferToFile(
+      argv[2], (format == "binary") ? RecordFileFormat::BINARY : RecordFileFormat::CSV);
+    std::cout << "Wrote " << planner.get_record_length() << " states to " << argv[2] <<
+      std::endl;
+  } catch (const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
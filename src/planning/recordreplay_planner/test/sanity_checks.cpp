@@ -24,6 +24,9 @@
 #include <common/types.hpp>
 
 #include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iterator>
 #include <set>
 #include <algorithm>
 #include <string>
@@ -206,6 +209,48 @@ TEST(RecordreplaySanityChecks, RecedingHorizonCornercases)
   }
 }
 
+//------------------ Test that the windowed search follows a route that passes the same states twice
+TEST(RecordreplaySanityChecks, WindowedSearchFollowsRoute)
+{
+  const auto N = 20U;
+  const auto radius = 5.0F;
+  const auto t0 = system_clock::from_time_t({});
+  const auto state_on_circle = [radius, t0](const uint32_t k) {
+      const auto angle = 2.0F * autoware::common::types::PI * static_cast<float32_t>(k) / N;
+      return make_state(
+        radius * std::cos(angle), radius * std::sin(angle),
+        angle + autoware::common::types::PI_2, 1.0F, 0.0F, 0.0F, t0);
+    };
+
+  // Record two laps of a circle, which pass the same states
+  auto planner = RecordReplayPlanner{};
+  for (uint32_t k = {}; k < 2U * N; ++k) {
+    planner.record_state(state_on_circle(k % N));
+  }
+
+  // Without a window, the states of the second lap are found in the first lap
+  planner.start_replaying();
+  for (uint32_t k = {}; k < 2U * N; ++k) {
+    const auto trajectory = planner.plan(state_on_circle(k % N));
+    EXPECT_EQ(2U * N - k % N, trajectory.points.size());
+  }
+
+  // The window follows the recording into the second lap
+  planner.set_search_window_size(5U);
+  planner.set_relocalization_distance(1.0);
+  planner.start_replaying();
+  for (uint32_t k = {}; k < 2U * N; ++k) {
+    const auto trajectory = planner.plan(state_on_circle(k % N));
+    EXPECT_EQ(2U * N - k, trajectory.points.size());
+  }
+
+  // A state away from the window is searched among all states again
+  const auto trajectory = planner.plan(state_on_circle(5U));
+  EXPECT_EQ(2U * N - 5U, trajectory.points.size());
+
+  EXPECT_THROW(planner.set_relocalization_distance(-1.0), std::domain_error);
+}
+
 TEST(RecordreplaySanityChecks, StateSettingMechanism)
 {
   auto planner = RecordReplayPlanner{};
@@ -275,6 +320,53 @@ TEST(RecordreplayWriteReadTrajectory, WriteReadTrajectory)
   }
 }
 
+TEST(RecordreplayWriteReadTrajectory, WriteReadBinaryTrajectory)
+{
+  using motion::planning::recordreplay_planner::RecordFileFormat;
+  std::string file_name("write_test.bin_trajectory");
+
+  const auto N = 5;
+  auto planner = helper_create_and_record_example(N);
+  planner.writeTrajectoryBufferToFile(file_name, RecordFileFormat::BINARY);
+
+  // The format of the file is detected when it is read
+  auto replay_planner = RecordReplayPlanner{};
+  replay_planner.readTrajectoryBufferFromFile(file_name);
+
+  EXPECT_EQ(std::remove(file_name.c_str()), 0);
+  ASSERT_EQ(replay_planner.get_record_length(), static_cast<std::size_t>(N));
+
+  const auto t0 = system_clock::from_time_t({});
+  const auto current_state = make_state(0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, t0);
+  const auto expected = planner.plan(current_state);
+  const auto trajectory = replay_planner.plan(current_state);
+  ASSERT_EQ(trajectory.points.size(), expected.points.size());
+  for (uint32_t k = {}; k < N; ++k) {
+    EXPECT_EQ(expected.points[k], trajectory.points[k]);
+  }
+}
+
+TEST(RecordreplayWriteReadTrajectory, readTruncatedBinaryTrajectory)
+{
+  using motion::planning::recordreplay_planner::RecordFileFormat;
+  std::string file_name("truncated_test.bin_trajectory");
+
+  const auto N = 5;
+  auto planner = helper_create_and_record_example(N);
+  planner.writeTrajectoryBufferToFile(file_name, RecordFileFormat::BINARY);
+
+  // Drop the last bytes of the last point
+  std::ifstream ifs(file_name, std::ios::binary);
+  std::string content{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+  ifs.close();
+  std::ofstream ofs(file_name, std::ios::binary | std::ios::trunc);
+  ofs << content.substr(0U, content.size() - 4U);
+  ofs.close();
+
+  EXPECT_THROW(planner.readTrajectoryBufferFromFile(file_name), std::runtime_error);
+  EXPECT_EQ(std::remove(file_name.c_str()), 0);
+}
+
 TEST(RecordreplayWriteReadTrajectory, writeTrajectoryEmptyPath)
 {
   const auto N = 5;
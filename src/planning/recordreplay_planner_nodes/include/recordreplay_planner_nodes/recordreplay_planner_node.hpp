@@ -132,6 +132,8 @@ private:
   bool m_enable_object_collision_estimator = false;
   float64_t m_goal_distance_threshold_m = {};
   float64_t m_goal_angle_threshold_rad;
+  recordreplay_planner::RecordFileFormat m_record_file_format{
+    recordreplay_planner::RecordFileFormat::CSV};
 };  // class RecordReplayPlannerNode
 }  // namespace recordreplay_planner_nodes
 }  // namespace planning
@@ -39,8 +39,17 @@ RecordReplayPlannerNode::RecordReplayPlannerNode(const rclcpp::NodeOptions & nod
   const auto trajectory_viz_topic = "planned_trajectory_viz";
   const auto heading_weight = declare_parameter("heading_weight").get<float64_t>();
   const auto min_record_distance = declare_parameter("min_record_distance").get<float64_t>();
+  const auto search_window_size = declare_parameter("search_window_size").get<int64_t>();
+  const auto relocalization_distance =
+    declare_parameter("relocalization_distance").get<float64_t>();
   m_goal_distance_threshold_m = declare_parameter("goal_distance_threshold_m").get<float32_t>();
   m_goal_angle_threshold_rad = declare_parameter("goal_angle_threshold_rad").get<float32_t>();
+  const auto record_file_format = declare_parameter("record_file_format").get<std::string>();
+  if (record_file_format == "binary") {
+    m_record_file_format = recordreplay_planner::RecordFileFormat::BINARY;
+  } else if (record_file_format != "csv") {
+    throw std::domain_error{"record_file_format must be csv or binary"};
+  }
 
   using rclcpp::QoS;
   using namespace std::chrono_literals;
@@ -103,6 +112,11 @@ RecordReplayPlannerNode::RecordReplayPlannerNode(const rclcpp::NodeOptions & nod
   m_planner = std::make_unique<recordreplay_planner::RecordReplayPlanner>();
   m_planner->set_heading_weight(heading_weight);
   m_planner->set_min_record_distance(min_record_distance);
+  if (search_window_size < 0) {
+    throw std::domain_error{"search_window_size cannot be negative"};
+  }
+  m_planner->set_search_window_size(static_cast<std::size_t>(search_window_size));
+  m_planner->set_relocalization_distance(relocalization_distance);
 }
 
 Marker RecordReplayPlannerNode::to_marker(
@@ -273,7 +287,7 @@ rclcpp_action::CancelResponse RecordReplayPlannerNode::record_handle_cancel(
     if (record_path.length() > 0) {
       // Write trajectory to file
       m_planner->writeTrajectoryBufferToFile(
-        goal_handle->get_goal()->record_path);
+        goal_handle->get_goal()->record_path, m_record_file_format);
     }
   }
 
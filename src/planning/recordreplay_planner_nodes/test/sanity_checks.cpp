@@ -54,6 +54,7 @@ TEST(MytestBase, Basic)
   node_options_ob.append_parameter_override("safety_factor", 2.0);
   node_options_ob.append_parameter_override("stop_margin", 5.0);
   node_options_ob.append_parameter_override("min_obstacle_dimension_m", 0.0004);
+  node_options_ob.append_parameter_override("use_broad_phase", true);
   node_options_ob.append_parameter_override("trajectory_smoother.kernel_std", 5.0);
   node_options_ob.append_parameter_override("trajectory_smoother.kernel_size", 25);
   node_options_ob.append_parameter_override("staleness_threshold_ms", 500);
@@ -65,6 +66,9 @@ TEST(MytestBase, Basic)
   node_options_rr.append_parameter_override("min_record_distance", min_record_distance);
   node_options_rr.append_parameter_override("enable_object_collision_estimator", true);
   node_options_rr.append_parameter_override("enable_object_collision_estimator", true);
+  node_options_rr.append_parameter_override("search_window_size", 100);
+  node_options_rr.append_parameter_override("relocalization_distance", 2.0);
+  node_options_rr.append_parameter_override("record_file_format", "csv");
   node_options_rr.append_parameter_override("goal_distance_threshold_m", 0.75);
   node_options_rr.append_parameter_override(
     "goal_angle_threshold_rad",
@@ -28,11 +28,14 @@
 // Autoware Package
 #include <autoware_auto_msgs/srv/had_map_service.hpp>
 #include <autoware_auto_msgs/action/plan_trajectory.hpp>
+#include <autoware_auto_msgs/msg/float32_multi_array_diagnostic.hpp>
 #include <autoware_auto_msgs/msg/had_map_route.hpp>
 #include <common/types.hpp>
 
 // external libraries
 #include <lanelet2_core/LaneletMap.h>
+#include <array>
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -43,6 +46,7 @@ namespace trajectory_planner_node_base
 
 using autoware::common::types::bool8_t;
 
+using Float32MultiArrayDiagnostic = autoware_auto_msgs::msg::Float32MultiArrayDiagnostic;
 using HADMapService = autoware_auto_msgs::srv::HADMapService;
 using HADMapRoute = autoware_auto_msgs::msg::HADMapRoute;
 using Trajectory = autoware_auto_msgs::msg::Trajectory;
@@ -82,9 +86,14 @@ private:
   using PlanTrajectoryAction = autoware_auto_msgs::action::PlanTrajectory;
   using GoalHandle = rclcpp_action::ServerGoalHandle<PlanTrajectoryAction>;
 
+  using SteadyTime = std::chrono::steady_clock::time_point;
+  // Ends of the map request (round trip), map deserialization, planning and reply phases
+  using PhaseEnds = std::array<SteadyTime, 4U>;
+
   // ROS Interface
   rclcpp_action::Server<PlanTrajectoryAction>::SharedPtr m_planner_server;
   rclcpp::Client<HADMapService>::SharedPtr m_map_client;
+  rclcpp::Publisher<Float32MultiArrayDiagnostic>::SharedPtr m_timing_pub;
 
   // callback
   TRAJECTORY_PLANNER_NODE_BASE_LOCAL rclcpp_action::GoalResponse handle_goal(
@@ -99,7 +108,13 @@ private:
   // \brief Validation of trajectory
   bool8_t is_trajectory_valid(const Trajectory & trajectory);
 
+  // \brief Publish the duration of each phase of the current goal, in seconds
+  void publish_timing(const PhaseEnds & phase_ends);
+
   std::shared_ptr<GoalHandle> m_goal_handle{nullptr};
+  // Start of the handling of the current goal
+  rclcpp::Time m_goal_start_stamp{0, 0, RCL_ROS_TIME};
+  SteadyTime m_goal_start_time{};
 
   PlannerState m_planner_state;
   bool8_t is_planning();
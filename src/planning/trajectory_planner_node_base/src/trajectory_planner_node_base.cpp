@@ -36,6 +36,7 @@ TrajectoryPlannerNodeBase::TrajectoryPlannerNodeBase(
 
   // Setup Map Service
   m_map_client = this->create_client<HADMapService>("HAD_Map_Service");
+  m_timing_pub = this->create_publisher<Float32MultiArrayDiagnostic>("planning_timing", 1);
 
   while (!m_map_client->wait_for_service(1s)) {
     if (!rclcpp::ok()) {
@@ -116,6 +117,8 @@ rclcpp_action::CancelResponse TrajectoryPlannerNodeBase::handle_cancel(
 void TrajectoryPlannerNodeBase::handle_accepted(
   const std::shared_ptr<GoalHandle> goal_handle)
 {
+  m_goal_start_time = std::chrono::steady_clock::now();
+  m_goal_start_stamp = this->now();
   // Store the goal handle in order to send result in map_response callback.
   m_goal_handle = goal_handle;
 
@@ -132,12 +135,16 @@ void TrajectoryPlannerNodeBase::handle_accepted(
 
 void TrajectoryPlannerNodeBase::map_response(rclcpp::Client<HADMapService>::SharedFuture future)
 {
+  PhaseEnds phase_ends{};
+  phase_ends[0U] = std::chrono::steady_clock::now();
   auto lanelet_map_ptr = std::make_shared<lanelet::LaneletMap>();
   autoware::common::had_map_utils::fromBinaryMsg(future.get()->map, lanelet_map_ptr);
+  phase_ends[1U] = std::chrono::steady_clock::now();
 
   RCLCPP_INFO(get_logger(), "Start planning");
   const auto & trajectory = plan_trajectory(m_goal_handle->get_goal()->sub_route, lanelet_map_ptr);
   RCLCPP_INFO(get_logger(), "Finished planning");
+  phase_ends[2U] = std::chrono::steady_clock::now();
 
   if (is_trajectory_valid(trajectory)) {
     auto result = std::make_shared<PlanTrajectoryAction::Result>();
@@ -151,7 +158,27 @@ void TrajectoryPlannerNodeBase::map_response(rclcpp::Client<HADMapService>::Shar
     result->result = PlanTrajectoryAction::Result::FAIL;
     m_goal_handle->abort(result);
   }
+  phase_ends[3U] = std::chrono::steady_clock::now();
   stop_planning();
+  publish_timing(phase_ends);
+}
+
+void TrajectoryPlannerNodeBase::publish_timing(const PhaseEnds & phase_ends)
+{
+  Float32MultiArrayDiagnostic timing;
+  timing.diag_header.name = get_name();
+  timing.diag_header.data_stamp = this->now();
+  timing.diag_header.computation_start = m_goal_start_stamp;
+  timing.diag_header.runtime = rclcpp::Duration(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(phase_ends.back() - m_goal_start_time));
+
+  using Seconds = std::chrono::duration<decltype(timing.diag_array.data)::value_type>;
+  auto phase_start = m_goal_start_time;
+  for (const auto & phase_end : phase_ends) {
+    timing.diag_array.data.push_back(Seconds(phase_end - phase_start).count());
+    phase_start = phase_end;
+  }
+  m_timing_pub->publish(timing);
 }
 
 }  // namespace trajectory_planner_node_base
@@ -0,0 +1,102 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 The Autoware Foundation
+/// \file
+/// \brief This file defines the qp_trajectory_smoother class.
+
+#ifndef TRAJECTORY_SMOOTHER__QP_TRAJECTORY_SMOOTHER_HPP_
+#define TRAJECTORY_SMOOTHER__QP_TRAJECTORY_SMOOTHER_HPP_
+
+#include "autoware_auto_msgs/msg/trajectory.hpp"
+#include <common/types.hpp>
+#include <osqp_interface/osqp_interface.hpp>
+#include <vector>
+
+#include "trajectory_smoother/visibility_control.hpp"
+
+namespace motion
+{
+namespace planning
+{
+namespace trajectory_smoother
+{
+
+using autoware_auto_msgs::msg::Trajectory;
+using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
+
+typedef struct
+{
+  float64_t weight_velocity;  // weight of the deviation from the input velocity
+  float64_t weight_acceleration;  // weight of the velocity change between consecutive points
+  float64_t weight_jerk;  // weight of the change of that velocity change
+  // number of points before the first changed point of the input that are smoothed again
+  uint32_t resmooth_margin;
+} QPTrajectorySmootherConfig;
+
+
+/// \brief Smooth over the trajectory by solving a quadratic program for its velocity profile
+/// \details The velocity v_i of every point minimizes
+/// weight_velocity * sum (v_i - r_i)^2 + weight_acceleration * sum (v_i+1 - v_i)^2 +
+/// weight_jerk * sum (v_i+2 - 2 v_i+1 + v_i)^2, where r_i is the input velocity. The first and
+/// last point keep their input velocity, points with a zero input velocity stay at zero, and the
+/// others keep the sign of their input velocity, so that the smoothed profile never moves past a
+/// stop of the input or changes direction.
+/// The solver workspace is kept across calls and reused as long as the number of points does not
+/// change. When the input starts with the same points as the previous input, the velocities of
+/// that prefix, except for the last resmooth_margin points of it, are taken over from the
+/// previous output, and the solve is warm started from the previous solution.
+class TRAJECTORY_SMOOTHER_PUBLIC QPTrajectorySmoother
+{
+public:
+  /// \brief Initialise the cost of the problem in the constructor
+  /// \param[in] config Configuration containing the weights of the cost
+  /// \throw std::domain_error If a weight is negative or weight_velocity is not positive
+  explicit QPTrajectorySmoother(const QPTrajectorySmootherConfig & config);
+
+  /// \brief Make the trajectory velocity smooth by solving the quadratic program.
+  /// \param[inout] trajectory The trajectory to be smoothed. This is modified in place. It is left
+  /// unchanged if the solver fails.
+  void Filter(Trajectory & trajectory);
+
+  /// \brief Get the number of leading points of the last input that were taken over from the
+  /// previous output
+  std::size_t get_reused_prefix_length() const noexcept;
+
+private:
+  /// \brief Number of leading points that the trajectory has in common with the previous input
+  std::size_t get_shared_prefix_length(const Trajectory & trajectory) const;
+
+  /// \brief Build the cost and constraint matrices for the given number of points
+  void set_horizon(const Eigen::Index num_points);
+
+  QPTrajectorySmootherConfig m_config;
+  autoware::common::osqp::OSQPInterface m_solver;
+  Eigen::MatrixXd m_P;
+  Eigen::MatrixXd m_A;
+  std::vector<float64_t> m_q{};
+  std::vector<float64_t> m_l{};
+  std::vector<float64_t> m_u{};
+  // previous input and output, to reuse the velocities of a shared prefix
+  Trajectory m_previous_input{};
+  std::vector<float32_t> m_previous_output{};
+  std::size_t m_reused_prefix_length{0U};
+};
+
+}  // namespace trajectory_smoother
+}  // namespace planning
+}  // namespace motion
+
+#endif  // TRAJECTORY_SMOOTHER__QP_TRAJECTORY_SMOOTHER_HPP_
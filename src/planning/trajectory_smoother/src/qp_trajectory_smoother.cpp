@@ -0,0 +1,169 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "trajectory_smoother/qp_trajectory_smoother.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace motion
+{
+namespace planning
+{
+namespace trajectory_smoother
+{
+
+using autoware::common::osqp::INF;
+
+namespace
+{
+// Absolute convergence tolerance of the solver, [m/s]
+constexpr float64_t kSolverTolerance = 1.0E-5;
+}  // namespace
+
+QPTrajectorySmoother::QPTrajectorySmoother(const QPTrajectorySmootherConfig & config)
+: m_config(config), m_solver(kSolverTolerance)
+{
+  if (m_config.weight_velocity <= 0.0) {
+    throw std::domain_error{"QPTrajectorySmoother: weight_velocity must be positive"};
+  }
+  if ((m_config.weight_acceleration < 0.0) || (m_config.weight_jerk < 0.0)) {
+    throw std::domain_error{"QPTrajectorySmoother: weights must not be negative"};
+  }
+}
+
+void QPTrajectorySmoother::Filter(Trajectory & trajectory)
+{
+  const std::size_t num_points = trajectory.points.size();
+  m_reused_prefix_length = 0U;
+  if (num_points <= 2U) {
+    return;
+  }
+
+  const std::size_t shared_prefix_length = get_shared_prefix_length(trajectory);
+  if ((shared_prefix_length == num_points) && (m_previous_output.size() == num_points)) {
+    // Same input as in the previous call, so the solution is the same as well
+    for (std::size_t i = 0; i < num_points; ++i) {
+      trajectory.points[i].longitudinal_velocity_mps = m_previous_output[i];
+    }
+    m_reused_prefix_length = num_points;
+    return;
+  }
+  // The last points of the shared prefix are smoothed again since they are coupled to the
+  // changed points through the acceleration and jerk terms
+  const std::size_t reused_prefix_length = (shared_prefix_length > m_config.resmooth_margin) ?
+    std::min(shared_prefix_length - m_config.resmooth_margin, num_points - 1U) : 0U;
+
+  set_horizon(static_cast<Eigen::Index>(num_points));
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const auto reference = static_cast<float64_t>(trajectory.points[i].longitudinal_velocity_mps);
+    m_q[i] = -2.0 * m_config.weight_velocity * reference;
+    if (i < reused_prefix_length) {
+      m_l[i] = static_cast<float64_t>(m_previous_output[i]);
+      m_u[i] = m_l[i];
+    } else if ((i == 0U) || (i == num_points - 1U)) {
+      // avoid changing the start and end point of trajectory
+      m_l[i] = reference;
+      m_u[i] = reference;
+    } else {
+      // keep the direction of travel, and stop where the input stops
+      m_l[i] = (reference < 0.0) ? -INF : 0.0;
+      m_u[i] = (reference > 0.0) ? INF : 0.0;
+    }
+  }
+
+  // The workspace of the previous call is kept when the number of points is the same, in which
+  // case the solve is warm started from the previous solution
+  m_solver.updateProblem(m_P, m_A, m_q, m_l, m_u);
+  const auto result = m_solver.optimize();
+  const int64_t status = std::get<3>(result);
+  if ((m_solver.getExitFlag() != 0) ||
+    ((status != OSQP_SOLVED) && (status != OSQP_SOLVED_INACCURATE)))
+  {
+    m_previous_input.points.clear();
+    m_previous_output.clear();
+    return;
+  }
+
+  const std::vector<float64_t> & solution = std::get<0>(result);
+  m_previous_input = trajectory;
+  m_previous_output.resize(num_points);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    // The solution is only feasible up to the tolerance of the solver
+    const auto velocity = static_cast<float32_t>(std::min(std::max(solution[i], m_l[i]), m_u[i]));
+    trajectory.points[i].longitudinal_velocity_mps = velocity;
+    m_previous_output[i] = velocity;
+  }
+  m_reused_prefix_length = reused_prefix_length;
+}
+
+std::size_t QPTrajectorySmoother::get_reused_prefix_length() const noexcept
+{
+  return m_reused_prefix_length;
+}
+
+std::size_t QPTrajectorySmoother::get_shared_prefix_length(const Trajectory & trajectory) const
+{
+  const std::size_t num_points =
+    std::min(std::min(trajectory.points.size(), m_previous_input.points.size()),
+      m_previous_output.size());
+  std::size_t i = 0U;
+  for (; i < num_points; ++i) {
+    const auto & point = trajectory.points[i];
+    const auto & previous_point = m_previous_input.points[i];
+    if ((point.x != previous_point.x) || (point.y != previous_point.y) ||
+      (point.longitudinal_velocity_mps != previous_point.longitudinal_velocity_mps))
+    {
+      break;
+    }
+  }
+  return i;
+}
+
+void QPTrajectorySmoother::set_horizon(const Eigen::Index num_points)
+{
+  if (m_P.rows() == num_points) {
+    return;
+  }
+
+  // Finite differences of the velocity profile, which are proportional to the acceleration and
+  // the jerk for evenly spaced points
+  Eigen::MatrixXd acceleration = Eigen::MatrixXd::Zero(num_points - 1, num_points);
+  for (Eigen::Index i = 0; i + 1 < num_points; ++i) {
+    acceleration(i, i) = -1.0;
+    acceleration(i, i + 1) = 1.0;
+  }
+  Eigen::MatrixXd jerk = Eigen::MatrixXd::Zero(num_points - 2, num_points);
+  for (Eigen::Index i = 0; i + 2 < num_points; ++i) {
+    jerk(i, i) = 1.0;
+    jerk(i, i + 1) = -2.0;
+    jerk(i, i + 2) = 1.0;
+  }
+
+  // The solver minimizes 0.5 x^T P x + q^T x
+  m_P = 2.0 * (m_config.weight_velocity * Eigen::MatrixXd::Identity(num_points, num_points) +
+    m_config.weight_acceleration * acceleration.transpose() * acceleration +
+    m_config.weight_jerk * jerk.transpose() * jerk);
+  m_A = Eigen::MatrixXd::Identity(num_points, num_points);
+  const auto size = static_cast<std::size_t>(num_points);
+  m_q.resize(size);
+  m_l.resize(size);
+  m_u.resize(size);
+}
+
+}  // namespace trajectory_smoother
+}  // namespace planning
+}  // namespace motion
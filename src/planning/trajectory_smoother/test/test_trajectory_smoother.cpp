@@ -14,8 +14,10 @@
 
 #include <motion_testing/motion_testing.hpp>
 #include <cmath>
+#include <stdexcept>
 
 #include "gtest/gtest.h"
+#include "trajectory_smoother/qp_trajectory_smoother.hpp"
 #include "trajectory_smoother/trajectory_smoother.hpp"
 
 #define DT_MS 100
@@ -25,6 +27,9 @@ using motion::motion_testing::constant_acceleration_trajectory;
 using Trajectory = autoware_auto_msgs::msg::Trajectory;
 using TrajectorySmoother = motion::planning::trajectory_smoother::TrajectorySmoother;
 using TrajectorySmootherConfig = motion::planning::trajectory_smoother::TrajectorySmootherConfig;
+using QPTrajectorySmoother = motion::planning::trajectory_smoother::QPTrajectorySmoother;
+using QPTrajectorySmootherConfig =
+  motion::planning::trajectory_smoother::QPTrajectorySmootherConfig;
 
 // Introduce random noise in the velocity values.
 void introduce_noise(Trajectory * trajectory, float range)
@@ -232,3 +237,84 @@ TEST(TrajectorySmoother, DecelerationHalt) {
   // Constants based on Gaussian filter's performance
   assert_trajectory(trajectory, 4, 3);
 }
+
+// Constant speed of 10mps. Random noise added. Last velocity point at 0mps.
+TEST(QPTrajectorySmoother, ConstantWithNoise) {
+  const std::chrono::milliseconds dt(DT_MS);
+  auto trajectory = constant_velocity_trajectory(
+    0, 0, 1, 10,
+    std::chrono::duration_cast<std::chrono::nanoseconds>(dt));
+  trajectory.points.resize(100);
+  introduce_noise(&trajectory, 10);
+  // Zero out last point
+  trajectory.points.back().longitudinal_velocity_mps = 0.0F;
+
+  // Generate QPTrajectorySmoother
+  const QPTrajectorySmootherConfig config{1.0, 100.0, 10000.0, 50U};
+  QPTrajectorySmoother smoother(config);
+
+  // Send through smoother
+  smoother.Filter(trajectory);
+
+  assert_trajectory_stop(trajectory, 10, 2.5F);
+  // The smoothed velocity does not change direction
+  for (const auto & point : trajectory.points) {
+    EXPECT_GE(point.longitudinal_velocity_mps, 0.0F);
+  }
+}
+
+// The velocities of a shared prefix are taken over from the previous output, and the result stays
+// close to the one of a smoother without any history.
+TEST(QPTrajectorySmoother, SharedPrefix) {
+  const std::chrono::milliseconds dt(DT_MS);
+  auto trajectory = constant_velocity_trajectory(
+    0, 0, 1, 10,
+    std::chrono::duration_cast<std::chrono::nanoseconds>(dt));
+  trajectory.points.resize(100);
+  trajectory.points.back().longitudinal_velocity_mps = 0.0F;
+
+  const QPTrajectorySmootherConfig config{1.0, 100.0, 10000.0, 50U};
+  QPTrajectorySmoother smoother(config);
+  auto smoothed = trajectory;
+  smoother.Filter(smoothed);
+  EXPECT_EQ(smoother.get_reused_prefix_length(), 0U);
+
+  // The same input again gives the same output
+  auto smoothed_again = trajectory;
+  smoother.Filter(smoothed_again);
+  EXPECT_EQ(smoother.get_reused_prefix_length(), trajectory.points.size());
+  for (std::size_t i = 0; i < trajectory.points.size(); ++i) {
+    EXPECT_EQ(
+      smoothed_again.points[i].longitudinal_velocity_mps,
+      smoothed.points[i].longitudinal_velocity_mps);
+  }
+
+  // Stop earlier, as the object collision estimator does for an obstacle
+  const std::size_t stop_index = 70U;
+  for (std::size_t i = stop_index; i < trajectory.points.size(); ++i) {
+    trajectory.points[i].longitudinal_velocity_mps = 0.0F;
+  }
+  auto resmoothed = trajectory;
+  smoother.Filter(resmoothed);
+  EXPECT_EQ(smoother.get_reused_prefix_length(), stop_index - config.resmooth_margin);
+  for (std::size_t i = 0; i < smoother.get_reused_prefix_length(); ++i) {
+    EXPECT_EQ(
+      resmoothed.points[i].longitudinal_velocity_mps,
+      smoothed.points[i].longitudinal_velocity_mps);
+  }
+
+  QPTrajectorySmoother fresh_smoother(config);
+  auto expected = trajectory;
+  fresh_smoother.Filter(expected);
+  for (std::size_t i = 0; i < trajectory.points.size(); ++i) {
+    EXPECT_NEAR(
+      resmoothed.points[i].longitudinal_velocity_mps,
+      expected.points[i].longitudinal_velocity_mps, 0.1F);
+  }
+  assert_trajectory_stop(resmoothed, 10, 2.5F);
+}
+
+TEST(QPTrajectorySmoother, BadConfig) {
+  EXPECT_THROW(QPTrajectorySmoother({0.0, 100.0, 10000.0, 50U}), std::domain_error);
+  EXPECT_THROW(QPTrajectorySmoother({1.0, -1.0, 10000.0, 50U}), std::domain_error);
+}
@@ -26,6 +26,7 @@
 
 #include "autoware_auto_msgs/msg/predicted_objects.hpp"
 #include "autoware_auto_msgs/msg/tracked_objects.hpp"
+#include "geometry_msgs/msg/point.hpp"
 
 namespace autoware
 {
@@ -57,6 +58,38 @@ void LONELY_WORLD_PREDICTION_PUBLIC predict_stationary(
   autoware_auto_msgs::msg::PredictedObjects & predicted_objects,
   const autoware::prediction::Parameters & parameters);
 
+/**
+ * \brief Predict all input objects to keep their velocity and yaw rate
+ *
+ * Each object moves with the linear velocity of its initial twist, which is in the body frame of
+ * the object, while its yaw changes with the angular velocity around z. This gives a circular arc
+ * or, without yaw rate, a straight line. The initial pose is assumed to be planar, i.e. only the
+ * yaw of the initial orientation is used, and the height is kept.
+ *
+ * The states of all objects are propagated together, one time step at a time, before they are
+ * written to the paths, so that the cost per predicted state is a few multiplications.
+ *
+ * \param[in,out] predicted_objects Contain the paths on return
+ * \param[in] parameters Define time step and time horizon of the paths, same as for
+ * predict_stationary(). The first predicted state is one time step after the initial state.
+ */
+void LONELY_WORLD_PREDICTION_PUBLIC predict_constant_turn_rate(
+  autoware_auto_msgs::msg::PredictedObjects & predicted_objects,
+  const autoware::prediction::Parameters & parameters);
+
+/**
+ * \brief Remove the objects which are too far away from a reference point, e.g. from the ego
+ * vehicle, to be relevant. Call this before the prediction to not predict them at all.
+ *
+ * \param[in,out] predicted_objects Objects whose initial position is within the distance on return
+ * \param[in] reference Position in the frame of the objects, only x and y are used
+ * \param[in] max_distance Maximum distance of the initial position to the reference
+ * \throw `std::invalid_argument` if the distance is negative or NaN
+ */
+void LONELY_WORLD_PREDICTION_PUBLIC remove_distant_objects(
+  autoware_auto_msgs::msg::PredictedObjects & predicted_objects,
+  const geometry_msgs::msg::Point & reference, double max_distance);
+
 }  // namespace prediction
 }  // namespace autoware
 
@@ -16,7 +16,13 @@
 
 #include "lonely_world_prediction/lonely_world_prediction.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "time_utils/time_utils.hpp"
 
@@ -24,9 +30,9 @@ namespace autoware
 {
 namespace prediction
 {
-void predict_stationary(
-  autoware_auto_msgs::msg::PredictedObject & predicted_object,
-  const autoware::prediction::Parameters & parameters)
+namespace
+{
+std::size_t number_of_steps(const autoware::prediction::Parameters & parameters)
 {
   // need an extra state in the end if the division has remainder
   auto n_steps =
@@ -34,6 +40,15 @@ void predict_stationary(
   if (parameters.time_horizon().count() % parameters.time_step().count()) {
     ++n_steps;
   }
+  return n_steps;
+}
+}  // namespace
+
+void predict_stationary(
+  autoware_auto_msgs::msg::PredictedObject & predicted_object,
+  const autoware::prediction::Parameters & parameters)
+{
+  const auto n_steps = number_of_steps(parameters);
 
   // TODO(frederik.beaujean) predicted path only has one pose, not multiple for each shape
   autoware_auto_msgs::msg::PredictedPath predicted_path;
@@ -57,5 +72,106 @@ void predict_stationary(
     });
 }
 
+void predict_constant_turn_rate(
+  autoware_auto_msgs::msg::PredictedObjects & predicted_objects,
+  const autoware::prediction::Parameters & parameters)
+{
+  auto & objects = predicted_objects.objects;
+  const auto n_objects = objects.size();
+  const auto n_steps = number_of_steps(parameters);
+  const auto dt = std::chrono::duration<double>{parameters.time_step()}.count();
+
+  // Current state of each object, with the yaw as half angle, i.e. the z and w of the quaternion
+  std::vector<double> x(n_objects), y(n_objects), qz(n_objects), qw(n_objects);
+  // Constant per step: displacement in the frame at the start of the step, and the half angle by
+  // which the yaw changes
+  std::vector<double> dx(n_objects), dy(n_objects), sin_half(n_objects), cos_half(n_objects);
+  for (std::size_t i = 0U; i < n_objects; ++i) {
+    const auto & kinematics = objects[i].kinematics;
+    const auto & pose = kinematics.initial_pose.pose;
+    x[i] = pose.position.x;
+    y[i] = pose.position.y;
+    const auto norm = std::hypot(pose.orientation.z, pose.orientation.w);
+    qz[i] = (norm > 0.0) ? (pose.orientation.z / norm) : 0.0;
+    qw[i] = (norm > 0.0) ? (pose.orientation.w / norm) : 1.0;
+
+    const auto & twist = kinematics.initial_twist.twist;
+    const auto yaw_rate = twist.angular.z;
+    sin_half[i] = std::sin(0.5 * yaw_rate * dt);
+    cos_half[i] = std::cos(0.5 * yaw_rate * dt);
+    // Integral of the rotated velocity over a step: sin(a) / w and (1 - cos(a)) / w, a = w * dt
+    const auto scale = (yaw_rate != 0.0) ? ((2.0 * sin_half[i]) / yaw_rate) : dt;
+    const auto along = scale * cos_half[i];
+    const auto across = scale * sin_half[i];
+    dx[i] = (along * twist.linear.x) - (across * twist.linear.y);
+    dy[i] = (across * twist.linear.x) + (along * twist.linear.y);
+  }
+
+  // Propagate all objects by one step at a time, the states are stored step by step
+  std::vector<double> x_out(n_steps * n_objects), y_out(n_steps * n_objects);
+  std::vector<double> qz_out(n_steps * n_objects), qw_out(n_steps * n_objects);
+  for (std::size_t step = 0U; step < n_steps; ++step) {
+    const auto offset = step * n_objects;
+    for (std::size_t i = 0U; i < n_objects; ++i) {
+      const auto cos_yaw = (qw[i] * qw[i]) - (qz[i] * qz[i]);
+      const auto sin_yaw = 2.0 * qw[i] * qz[i];
+      x[i] += (cos_yaw * dx[i]) - (sin_yaw * dy[i]);
+      y[i] += (sin_yaw * dx[i]) + (cos_yaw * dy[i]);
+      const auto qz_next = (qw[i] * sin_half[i]) + (qz[i] * cos_half[i]);
+      qw[i] = (qw[i] * cos_half[i]) - (qz[i] * sin_half[i]);
+      qz[i] = qz_next;
+      x_out[offset + i] = x[i];
+      y_out[offset + i] = y[i];
+      qz_out[offset + i] = qz[i];
+      qw_out[offset + i] = qw[i];
+    }
+  }
+
+  // Fill the paths of the objects
+  const auto time_step = time_utils::to_message(parameters.time_step());
+  for (std::size_t i = 0U; i < n_objects; ++i) {
+    auto & kinematics = objects[i].kinematics;
+    // TODO(frederik.beaujean) predicted path only has one pose, not multiple for each shape
+    autoware_auto_msgs::msg::PredictedPath predicted_path;
+    predicted_path.path = decltype(predicted_path.path) {n_steps, kinematics.initial_pose.pose};
+    for (std::size_t step = 0U; step < n_steps; ++step) {
+      auto & pose = predicted_path.path[step];
+      const auto idx = (step * n_objects) + i;
+      pose.position.x = x_out[idx];
+      pose.position.y = y_out[idx];
+      pose.orientation.x = 0.0;
+      pose.orientation.y = 0.0;
+      pose.orientation.z = qz_out[idx];
+      pose.orientation.w = qw_out[idx];
+    }
+    predicted_path.confidence = 1.0;
+    predicted_path.time_step = time_step;
+    kinematics.predicted_paths.emplace_back(std::move(predicted_path));
+  }
+}
+
+void remove_distant_objects(
+  autoware_auto_msgs::msg::PredictedObjects & predicted_objects,
+  const geometry_msgs::msg::Point & reference, double max_distance)
+{
+  using namespace std::literals;
+  if (!(max_distance >= 0.0)) {
+    throw std::invalid_argument(
+            "maximum distance >= 0 required. Got "s + std::to_string(max_distance));
+  }
+  const auto max_distance_squared = max_distance * max_distance;
+  auto & objects = predicted_objects.objects;
+  objects.erase(
+    std::remove_if(
+      objects.begin(), objects.end(),
+      [&reference, max_distance_squared](const autoware_auto_msgs::msg::PredictedObject & object) {
+        const auto & position = object.kinematics.initial_pose.pose.position;
+        const auto delta_x = position.x - reference.x;
+        const auto delta_y = position.y - reference.y;
+        return ((delta_x * delta_x) + (delta_y * delta_y)) > max_distance_squared;
+      }),
+    objects.end());
+}
+
 }  // namespace prediction
 }  // namespace autoware
@@ -14,6 +14,8 @@
 //
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
+#include <cmath>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "lonely_world_prediction/lonely_world_prediction.hpp"
@@ -90,4 +92,94 @@ TEST(rule_based, stationary)
   EXPECT_THAT(path.confidence, Eq(1.0F));
 }
 
+TEST(rule_based, constant_turn_rate_straight)
+{
+  const auto input = make<autoware_auto_msgs::msg::PredictedObjects>();
+  ASSERT_EQ(input.objects.size(), 1UL);
+
+  Parameters parameters(27ms, 1800ms);
+
+  auto output = input;
+  predict_constant_turn_rate(output, parameters);
+
+  ASSERT_EQ(output.objects.size(), input.objects.size());
+  const auto & obj = output.objects.front();
+  ASSERT_EQ(obj.kinematics.predicted_paths.size(), 1UL);
+  const auto & path = obj.kinematics.predicted_paths.front();
+  EXPECT_THAT(path.time_step, Eq(time_utils::to_message(parameters.time_step())));
+  ASSERT_EQ(path.path.size(), 67UL);
+  EXPECT_THAT(path.confidence, Eq(1.0F));
+
+  // moves along x with 1.1 m/s, without yaw rate
+  const auto & initial_pose = obj.kinematics.initial_pose.pose;
+  for (std::size_t step = 0U; step < path.path.size(); ++step) {
+    const auto & pose = path.path[step];
+    const auto t = 0.027 * static_cast<double>(step + 1U);
+    EXPECT_NEAR(pose.position.x, initial_pose.position.x + 1.1 * t, 1e-12) << step;
+    EXPECT_DOUBLE_EQ(pose.position.y, initial_pose.position.y);
+    EXPECT_DOUBLE_EQ(pose.position.z, initial_pose.position.z);
+    EXPECT_THAT(pose.orientation, Eq(initial_pose.orientation));
+  }
+}
+
+TEST(rule_based, constant_turn_rate_circle)
+{
+  auto input = make<autoware_auto_msgs::msg::PredictedObjects>();
+  ASSERT_EQ(input.objects.size(), 1UL);
+  // second object, starting at (1, 2) facing +y, with the velocity along its body y axis
+  input.objects.push_back(input.objects.front());
+  auto & kinematics = input.objects.back().kinematics;
+  kinematics.initial_pose.pose.position.x = 1.0;
+  kinematics.initial_pose.pose.position.y = 2.0;
+  kinematics.initial_pose.pose.orientation.z = std::sin(M_PI / 4.0);
+  kinematics.initial_pose.pose.orientation.w = std::cos(M_PI / 4.0);
+  kinematics.initial_twist.twist.linear.x = 0.0;
+  kinematics.initial_twist.twist.linear.y = 2.0;
+  for (auto & object : input.objects) {
+    object.kinematics.initial_twist.twist.angular.z = 0.5;
+  }
+
+  Parameters parameters(100ms, 8s);
+  auto output = input;
+  predict_constant_turn_rate(output, parameters);
+  ASSERT_EQ(output.objects.size(), 2UL);
+
+  for (std::size_t step = 0U; step < 80U; ++step) {
+    const auto t = 0.1 * static_cast<double>(step + 1U);
+    // radius 1.1 / 0.5 around (0, 2.2)
+    const auto & first = output.objects[0].kinematics.predicted_paths.front().path.at(step);
+    EXPECT_NEAR(first.position.x, 2.2 * std::sin(0.5 * t), 1e-9) << step;
+    EXPECT_NEAR(first.position.y, 2.2 - 2.2 * std::cos(0.5 * t), 1e-9) << step;
+    EXPECT_NEAR(first.orientation.z, std::sin(0.25 * t), 1e-9) << step;
+    EXPECT_NEAR(first.orientation.w, std::cos(0.25 * t), 1e-9) << step;
+    // moves towards -x initially, radius 2 / 0.5 around (1, -2)
+    const auto & second = output.objects[1].kinematics.predicted_paths.front().path.at(step);
+    EXPECT_NEAR(second.position.x, 1.0 - 4.0 * std::sin(0.5 * t), 1e-9) << step;
+    EXPECT_NEAR(second.position.y, -2.0 + 4.0 * std::cos(0.5 * t), 1e-9) << step;
+  }
+}
+
+TEST(rule_based, remove_distant_objects)
+{
+  auto objects = make<autoware_auto_msgs::msg::PredictedObjects>();
+  ASSERT_EQ(objects.objects.size(), 1UL);
+  objects.objects.push_back(objects.objects.front());
+  objects.objects.back().object_id = 135;
+  objects.objects.back().kinematics.initial_pose.pose.position.x = 30.0;
+  objects.objects.back().kinematics.initial_pose.pose.position.y = 40.0;
+  // the height is ignored
+  objects.objects.back().kinematics.initial_pose.pose.position.z = 100.0;
+
+  geometry_msgs::msg::Point ego;
+  EXPECT_THROW(remove_distant_objects(objects, ego, -1.0), std::invalid_argument);
+  EXPECT_THROW(remove_distant_objects(objects, ego, std::nan("")), std::invalid_argument);
+
+  remove_distant_objects(objects, ego, 50.0);
+  EXPECT_EQ(objects.objects.size(), 2UL);
+  ego.x = -1.0;
+  remove_distant_objects(objects, ego, 50.0);
+  ASSERT_EQ(objects.objects.size(), 1UL);
+  EXPECT_EQ(objects.objects.front().object_id, 134UL);
+}
+
 }  // namespace
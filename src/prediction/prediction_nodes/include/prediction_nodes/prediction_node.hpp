@@ -23,6 +23,7 @@
 
 
 #include <chrono>
+#include <string>
 
 #include "lonely_world_prediction/parameters.hpp"
 #include "prediction_nodes/visibility_control.hpp"
@@ -58,6 +59,11 @@ private:
   void PREDICTION_NODES_LOCAL on_tracked_objects(TrackedMsgT::ConstSharedPtr msg);
 
   Parameters m_parameters;
+  /// Whether the objects keep their velocity and yaw rate, otherwise they are stationary
+  bool m_constant_turn_rate;
+  /// Objects further away from the ego frame are not predicted, disabled if zero
+  double m_max_distance;
+  std::string m_ego_frame;
   rclcpp::Publisher<PredictedMsgT>::SharedPtr m_predicted_objects_pub{};
   rclcpp::Subscription<TrackedMsgT>::SharedPtr m_tracked_dynamic_objects_sub{};
 
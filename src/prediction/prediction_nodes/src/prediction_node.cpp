@@ -20,6 +20,8 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 #include "lonely_world_prediction/init_from_tracked.hpp"
 #include "lonely_world_prediction/lonely_world_prediction.hpp"
@@ -31,9 +33,18 @@ namespace
 {
 constexpr int32_t kDefaultTimeStep_ms{50};
 constexpr int32_t kDefaultTimeHorizon_ms{3000};
+constexpr double kDefaultMaxDistance_m{0.0};
 
 using std::placeholders::_1;
 
+bool is_constant_turn_rate(const std::string & model)
+{
+  if ((model != "stationary") && (model != "constant_turn_rate")) {
+    throw std::invalid_argument("unknown prediction model: " + model);
+  }
+  return model == "constant_turn_rate";
+}
+
 rclcpp::QoS default_qos()
 {
   return rclcpp::QoS{10}.reliable().transient_local();
@@ -50,6 +61,10 @@ PredictionNode::PredictionNode(const rclcpp::NodeOptions & options)
   m_parameters(
     std::chrono::milliseconds{declare_parameter("time_step_ms", kDefaultTimeStep_ms)},
     std::chrono::milliseconds{declare_parameter("time_horizon_ms", kDefaultTimeHorizon_ms)}),
+  m_constant_turn_rate{
+    is_constant_turn_rate(declare_parameter("model", std::string{"stationary"}))},
+  m_max_distance{declare_parameter("max_distance_m", kDefaultMaxDistance_m)},
+  m_ego_frame{declare_parameter("ego_frame", std::string{"base_link"})},
   m_predicted_objects_pub{
     create_publisher<PredictedMsgT>("/prediction/predicted_objects", default_qos())},
   m_tracked_dynamic_objects_sub{create_subscription<TrackedMsgT>(
@@ -58,12 +73,33 @@ PredictionNode::PredictionNode(const rclcpp::NodeOptions & options)
   m_tf_buffer{},
   m_tf_listener(m_tf_buffer, std::shared_ptr<rclcpp::Node>(this, [](auto) {}), false)
 {
+  if (!(m_max_distance >= 0.0)) {
+    throw std::invalid_argument("max_distance_m >= 0 required");
+  }
 }
 
 void PredictionNode::on_tracked_objects(TrackedMsgT::ConstSharedPtr msg)
 {
   PredictedMsgT predicted_objects = from_tracked(*msg);
-  autoware::prediction::predict_stationary(predicted_objects, m_parameters);
+  if (m_max_distance > 0.0) {
+    try {
+      // position of the ego vehicle in the frame of the objects
+      const auto translation = m_tf_buffer.lookupTransform(
+        msg->header.frame_id, m_ego_frame, tf2::TimePointZero).transform.translation;
+      geometry_msgs::msg::Point ego;
+      ego.x = translation.x;
+      ego.y = translation.y;
+      remove_distant_objects(predicted_objects, ego, m_max_distance);
+    } catch (const tf2::TransformException & e) {
+      RCLCPP_WARN_THROTTLE(
+        get_logger(), *get_clock(), 1000, "Not removing distant objects: %s", e.what());
+    }
+  }
+  if (m_constant_turn_rate) {
+    autoware::prediction::predict_constant_turn_rate(predicted_objects, m_parameters);
+  } else {
+    autoware::prediction::predict_stationary(predicted_objects, m_parameters);
+  }
   m_predicted_objects_pub->publish(predicted_objects);
 }
 
@@ -17,7 +17,9 @@
 #ifndef AUTOWARE_STATE_MONITOR__ODOMETRY_BUFFER_HPP_
 #define AUTOWARE_STATE_MONITOR__ODOMETRY_BUFFER_HPP_
 
-#include <deque>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 #include "autoware_auto_msgs/msg/vehicle_odometry.hpp"
 #include "autoware_state_monitor/visibility_control.hpp"
@@ -27,8 +29,92 @@ namespace autoware
 namespace state_monitor
 {
 
-/// \brief Buffer for odometry messages storage
-using OdometryBuffer = std::deque<autoware_auto_msgs::msg::VehicleOdometry::ConstSharedPtr>;
+/// \brief Buffer for odometry samples storage
+///
+/// The samples are stored in a ring of fixed capacity, which is allocated once. When the buffer
+/// is full, adding a sample removes the oldest one. The minimum and the maximum velocity of the
+/// stored samples are tracked with monotonic queues, so that they are available in constant time.
+class AUTOWARE_STATE_MONITOR_PUBLIC OdometryBuffer
+{
+public:
+  /// \brief The part of an odometry message which is stored in the buffer
+  struct Sample
+  {
+    /// Stamp of the message in nanoseconds
+    int64_t stamp_ns;
+    /// Velocity of the vehicle
+    float velocity_mps;
+  };
+
+  /// \brief Default capacity, i.e. 2.56 s of odometry at 100 Hz
+  static constexpr std::size_t kDefaultCapacity = 256U;
+
+  /// \brief Create an empty buffer
+  /// \param capacity maximum number of stored samples, must be positive
+  /// \throw std::domain_error if the capacity is zero
+  explicit OdometryBuffer(std::size_t capacity = kDefaultCapacity);
+
+  /// \brief Add the sample of an odometry message as the newest sample
+  /// \param msg vehicle odometry message, must not be null
+  void push_back(const autoware_auto_msgs::msg::VehicleOdometry::ConstSharedPtr & msg);
+  /// \brief Add a sample as the newest sample
+  /// \param new_sample odometry sample
+  void push_back(const Sample & new_sample);
+  /// \brief Remove the oldest sample, the buffer must not be empty
+  void pop_front();
+  /// \brief Remove all samples
+  void clear() noexcept;
+
+  /// \brief Oldest sample, the buffer must not be empty
+  const Sample & front() const;
+  /// \brief Newest sample, the buffer must not be empty
+  const Sample & back() const;
+  /// \brief Number of stored samples
+  std::size_t size() const noexcept;
+  /// \brief Maximum number of stored samples
+  std::size_t capacity() const noexcept;
+  /// \brief Whether the buffer has no samples
+  bool empty() const noexcept;
+
+  /// \brief Minimum velocity of the stored samples, the buffer must not be empty
+  float min_velocity_mps() const;
+  /// \brief Maximum velocity of the stored samples, the buffer must not be empty
+  float max_velocity_mps() const;
+
+private:
+  /// \brief Ring of the indices of the samples in a monotonic queue
+  ///
+  /// The indices count all samples which have been added, and therefore never wrap around.
+  class IndexQueue
+  {
+public:
+    explicit IndexQueue(std::size_t capacity);
+    void push_back(std::size_t index);
+    void pop_front() noexcept;
+    void pop_back() noexcept;
+    void clear() noexcept;
+    std::size_t front() const noexcept;
+    std::size_t back() const noexcept;
+    bool empty() const noexcept;
+
+private:
+    std::vector<std::size_t> indices_;
+    std::size_t head_{0U};
+    std::size_t size_{0U};
+  };
+
+  const Sample & sample(std::size_t index) const noexcept;
+
+  std::vector<Sample> samples_;
+  /// Index of the oldest sample
+  std::size_t begin_{0U};
+  /// Index of the next sample to be added
+  std::size_t end_{0U};
+  /// Indices of the samples with strictly increasing velocity
+  IndexQueue min_queue_;
+  /// Indices of the samples with strictly decreasing velocity
+  IndexQueue max_queue_;
+};
 
 }  // namespace state_monitor
 }  // namespace autoware
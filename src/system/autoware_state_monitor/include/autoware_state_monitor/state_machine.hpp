@@ -49,7 +49,7 @@ struct StateInput
   autoware_auto_msgs::msg::VehicleStateReport::ConstSharedPtr vehicle_state_report;
   /// Planned global route.
   autoware_auto_msgs::msg::HADMapRoute::ConstSharedPtr route;
-  /// Buffer that stores odometry messages.
+  /// Buffer that stores the velocities of the odometry messages.
   OdometryBuffer odometry_buffer;
   /// Determines if the system should be finalized.
   bool is_finalizing = false;
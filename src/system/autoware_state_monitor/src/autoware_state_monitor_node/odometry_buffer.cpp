@@ -0,0 +1,169 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Robotec.AI sp. z o.o.
+
+#include "autoware_state_monitor/odometry_buffer.hpp"
+
+#include <stdexcept>
+
+#include "rclcpp/time.hpp"
+
+namespace autoware
+{
+namespace state_monitor
+{
+
+constexpr std::size_t OdometryBuffer::kDefaultCapacity;
+
+OdometryBuffer::IndexQueue::IndexQueue(std::size_t capacity)
+: indices_(capacity)
+{}
+
+void OdometryBuffer::IndexQueue::push_back(std::size_t index)
+{
+  indices_[(head_ + size_) % indices_.size()] = index;
+  ++size_;
+}
+
+void OdometryBuffer::IndexQueue::pop_front() noexcept
+{
+  head_ = (head_ + 1U) % indices_.size();
+  --size_;
+}
+
+void OdometryBuffer::IndexQueue::pop_back() noexcept
+{
+  --size_;
+}
+
+void OdometryBuffer::IndexQueue::clear() noexcept
+{
+  head_ = 0U;
+  size_ = 0U;
+}
+
+std::size_t OdometryBuffer::IndexQueue::front() const noexcept
+{
+  return indices_[head_];
+}
+
+std::size_t OdometryBuffer::IndexQueue::back() const noexcept
+{
+  return indices_[(head_ + size_ - 1U) % indices_.size()];
+}
+
+bool OdometryBuffer::IndexQueue::empty() const noexcept
+{
+  return size_ == 0U;
+}
+
+OdometryBuffer::OdometryBuffer(std::size_t capacity)
+: samples_(capacity),
+  min_queue_(capacity),
+  max_queue_(capacity)
+{
+  if (capacity == 0U) {
+    throw std::domain_error("OdometryBuffer: capacity must be positive");
+  }
+}
+
+void OdometryBuffer::push_back(
+  const autoware_auto_msgs::msg::VehicleOdometry::ConstSharedPtr & msg)
+{
+  push_back(Sample{rclcpp::Time(msg->stamp).nanoseconds(), msg->velocity_mps});
+}
+
+void OdometryBuffer::push_back(const Sample & new_sample)
+{
+  if (size() == capacity()) {
+    pop_front();
+  }
+
+  // The samples which are removed from the back of a queue can never become its front, since the
+  // new sample will be removed later than them
+  const float velocity_mps = new_sample.velocity_mps;
+  while (!min_queue_.empty() && (sample(min_queue_.back()).velocity_mps >= velocity_mps)) {
+    min_queue_.pop_back();
+  }
+  while (!max_queue_.empty() && (sample(max_queue_.back()).velocity_mps <= velocity_mps)) {
+    max_queue_.pop_back();
+  }
+
+  samples_[end_ % samples_.size()] = new_sample;
+  min_queue_.push_back(end_);
+  max_queue_.push_back(end_);
+  ++end_;
+}
+
+void OdometryBuffer::pop_front()
+{
+  if (min_queue_.front() == begin_) {
+    min_queue_.pop_front();
+  }
+  if (max_queue_.front() == begin_) {
+    max_queue_.pop_front();
+  }
+  ++begin_;
+}
+
+void OdometryBuffer::clear() noexcept
+{
+  begin_ = end_;
+  min_queue_.clear();
+  max_queue_.clear();
+}
+
+const OdometryBuffer::Sample & OdometryBuffer::front() const
+{
+  return sample(begin_);
+}
+
+const OdometryBuffer::Sample & OdometryBuffer::back() const
+{
+  return sample(end_ - 1U);
+}
+
+std::size_t OdometryBuffer::size() const noexcept
+{
+  return end_ - begin_;
+}
+
+std::size_t OdometryBuffer::capacity() const noexcept
+{
+  return samples_.size();
+}
+
+bool OdometryBuffer::empty() const noexcept
+{
+  return begin_ == end_;
+}
+
+float OdometryBuffer::min_velocity_mps() const
+{
+  return sample(min_queue_.front()).velocity_mps;
+}
+
+float OdometryBuffer::max_velocity_mps() const
+{
+  return sample(max_queue_.front()).velocity_mps;
+}
+
+const OdometryBuffer::Sample & OdometryBuffer::sample(std::size_t index) const noexcept
+{
+  return samples_[index % samples_.size()];
+}
+
+}  // namespace state_monitor
+}  // namespace autoware
@@ -16,7 +16,7 @@
 
 #include "autoware_state_monitor/odometry_updater.hpp"
 
-#include "rclcpp/time.hpp"
+#include <cstdint>
 
 namespace autoware
 {
@@ -40,11 +40,11 @@ void OdometryUpdater::update(
   odometry_buffer_.push_back(msg);
 
   // Delete old data in buffer
+  const int64_t stamp_ns = odometry_buffer_.back().stamp_ns;
   while (true) {
-    const auto time_diff = rclcpp::Time(msg->stamp) -
-      rclcpp::Time(odometry_buffer_.front()->stamp);
+    const auto time_diff_ns = stamp_ns - odometry_buffer_.front().stamp_ns;
 
-    if (time_diff.seconds() <= buffer_length_sec_) {
+    if (static_cast<double>(time_diff_ns) * 1.0e-9 <= buffer_length_sec_) {
       break;
     }
 
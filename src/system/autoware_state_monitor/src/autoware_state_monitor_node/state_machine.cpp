@@ -47,12 +47,12 @@ bool StateMachine::isStopped(
   const OdometryBuffer & odometry_buffer,
   const double stopped_velocity_threshold_mps) const
 {
-  for (const auto & odometry : odometry_buffer) {
-    if (std::abs(static_cast<double>(odometry->velocity_mps)) > stopped_velocity_threshold_mps) {
-      return false;
-    }
+  if (odometry_buffer.empty()) {
+    return true;
   }
-  return true;
+  return
+    (static_cast<double>(odometry_buffer.max_velocity_mps()) <= stopped_velocity_threshold_mps) &&
+    (static_cast<double>(odometry_buffer.min_velocity_mps()) >= -stopped_velocity_threshold_mps);
 }
 
 bool StateMachine::isVehicleInitialized() const
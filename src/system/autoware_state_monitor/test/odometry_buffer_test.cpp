@@ -0,0 +1,86 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_state_monitor/odometry_buffer.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include "test_utils.hpp"
+
+using autoware::state_monitor::OdometryBuffer;
+
+TEST(OdometryBufferTest, zero_capacity)
+{
+  EXPECT_THROW(OdometryBuffer{0U}, std::domain_error);
+}
+
+TEST(OdometryBufferTest, sample_of_message)
+{
+  OdometryBuffer buffer;
+  EXPECT_TRUE(buffer.empty());
+  buffer.push_back(prepareVehicleOdometryMsg(1.5, 0, 0, toTime(2.0)));
+  ASSERT_EQ(buffer.size(), 1U);
+  EXPECT_EQ(buffer.front().stamp_ns, toTime(2.0).nanoseconds());
+  EXPECT_EQ(buffer.front().velocity_mps, 1.5);
+  EXPECT_EQ(buffer.min_velocity_mps(), 1.5);
+  EXPECT_EQ(buffer.max_velocity_mps(), 1.5);
+}
+
+TEST(OdometryBufferTest, full_buffer_removes_oldest_sample)
+{
+  OdometryBuffer buffer{2U};
+  buffer.push_back(OdometryBuffer::Sample{0, 3.0F});
+  buffer.push_back(OdometryBuffer::Sample{1, 1.0F});
+  buffer.push_back(OdometryBuffer::Sample{2, 2.0F});
+  ASSERT_EQ(buffer.size(), 2U);
+  EXPECT_EQ(buffer.front().stamp_ns, 1);
+  EXPECT_EQ(buffer.back().stamp_ns, 2);
+  EXPECT_EQ(buffer.max_velocity_mps(), 2.0F);
+  EXPECT_EQ(buffer.min_velocity_mps(), 1.0F);
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+  buffer.push_back(OdometryBuffer::Sample{3, -1.0F});
+  EXPECT_EQ(buffer.max_velocity_mps(), -1.0F);
+  EXPECT_EQ(buffer.min_velocity_mps(), -1.0F);
+}
+
+TEST(OdometryBufferTest, min_max_match_scan_of_samples)
+{
+  OdometryBuffer buffer{8U};
+  std::deque<float> reference;
+  for (int64_t i = 0; i < 100; ++i) {
+    // Deterministic sequence with repeated values
+    const auto velocity = static_cast<float>((i * 7) % 11) - 5.0F;
+    buffer.push_back(OdometryBuffer::Sample{i, velocity});
+    reference.push_back(velocity);
+    if (reference.size() > buffer.capacity()) {
+      reference.pop_front();
+    }
+    if ((i % 3) == 0) {
+      buffer.pop_front();
+      reference.pop_front();
+    }
+    ASSERT_EQ(buffer.size(), reference.size());
+    if (!reference.empty()) {
+      EXPECT_EQ(buffer.min_velocity_mps(), *std::min_element(reference.begin(), reference.end()));
+      EXPECT_EQ(buffer.max_velocity_mps(), *std::max_element(reference.begin(), reference.end()));
+      EXPECT_EQ(buffer.front().velocity_mps, reference.front());
+    }
+  }
+}
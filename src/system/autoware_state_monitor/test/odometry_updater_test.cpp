@@ -49,18 +49,18 @@ TEST_F(OdometryUpdaterTest, add_new_samples)
   EXPECT_EQ(buffer.size(), 0);
   updater->update(prepareVehicleOdometryMsg(1.0));
   EXPECT_EQ(buffer.size(), 1);
-  EXPECT_EQ(buffer.front()->velocity_mps, 1.0);
-  EXPECT_EQ(buffer.back()->velocity_mps, 1.0);
+  EXPECT_EQ(buffer.front().velocity_mps, 1.0);
+  EXPECT_EQ(buffer.back().velocity_mps, 1.0);
 
   updater->update(prepareVehicleOdometryMsg(-1.0, 0.0));
   EXPECT_EQ(buffer.size(), 2);
-  EXPECT_EQ(buffer.front()->velocity_mps, 1.0);
-  EXPECT_EQ(buffer.back()->velocity_mps, -1.0);
+  EXPECT_EQ(buffer.front().velocity_mps, 1.0);
+  EXPECT_EQ(buffer.back().velocity_mps, -1.0);
 
   updater->update(prepareVehicleOdometryMsg(0.5, 0.0));
   EXPECT_EQ(buffer.size(), 3);
-  EXPECT_EQ(buffer.front()->velocity_mps, 1.0);
-  EXPECT_EQ(buffer.back()->velocity_mps, 0.5);
+  EXPECT_EQ(buffer.front().velocity_mps, 1.0);
+  EXPECT_EQ(buffer.back().velocity_mps, 0.5);
 }
 
 TEST_F(OdometryUpdaterTest, null_message_do_nothing)
@@ -86,19 +86,19 @@ TEST_F(OdometryUpdaterTest, old_messages_removal_to_preserve_length)
   stamp = toTime(1.0);
   updater->update(prepareVehicleOdometryMsg(3.0, 0, 0, stamp));
   EXPECT_EQ(buffer.size(), 3);
-  EXPECT_EQ(buffer.front()->velocity_mps, 1.0);
+  EXPECT_EQ(buffer.front().velocity_mps, 1.0);
 
   // time_diff = 1.1 > buffer_length_sec --> first sample should be removed
   stamp = toTime(1.1);
   updater->update(prepareVehicleOdometryMsg(4.0, 0, 0, stamp));
   EXPECT_EQ(buffer.size(), 3);
-  EXPECT_EQ(buffer.front()->velocity_mps, 2.0);
-  EXPECT_EQ(buffer.back()->velocity_mps, 4.0);
+  EXPECT_EQ(buffer.front().velocity_mps, 2.0);
+  EXPECT_EQ(buffer.back().velocity_mps, 4.0);
 
   // time_diff = 1.5 > buffer_length_sec --> first sample should be removed
   stamp = toTime(2.0);
   updater->update(prepareVehicleOdometryMsg(5.0, 0, 0, stamp));
   EXPECT_EQ(buffer.size(), 3);
-  EXPECT_EQ(buffer.front()->velocity_mps, 3.0);
-  EXPECT_EQ(buffer.back()->velocity_mps, 5.0);
+  EXPECT_EQ(buffer.front().velocity_mps, 3.0);
+  EXPECT_EQ(buffer.back().velocity_mps, 5.0);
 }
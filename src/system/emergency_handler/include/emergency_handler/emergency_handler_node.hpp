@@ -18,8 +18,13 @@
 #define EMERGENCY_HANDLER__EMERGENCY_HANDLER_NODE_HPP_
 
 // Core
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 // ROS
 #include "diagnostic_msgs/msg/diagnostic_array.hpp"
@@ -39,6 +44,7 @@
 
 // Local
 #include "emergency_handler/heartbeat_checker.hpp"
+#include "emergency_handler/latest_message.hpp"
 
 namespace autoware
 {
@@ -50,14 +56,30 @@ namespace emergency_handler
 /// The node deals with emergency state detection based on the provided data.
 /// When the emergency state is detected, then the main purpose of this component is
 /// to generate vehicle velocities commands and state commands to stop the vehicle safelty.
+///
+/// The subscriptions only store the latest messages. The emergency state is evaluated in a
+/// dedicated thread, so that the response time does not depend on the other callbacks of the
+/// executor, e.g. during a burst of messages.
 class EMERGENCY_HANDLER_PUBLIC EmergencyHandlerNode : public rclcpp::Node
 {
 public:
   /// \brief Constructor
   /// \param[in] node_options Node options
   explicit EmergencyHandlerNode(const rclcpp::NodeOptions & node_options);
+  /// \brief Destructor, stops the evaluation thread
+  ~EmergencyHandlerNode() override;
 
 private:
+  /// \brief The latest input messages, loaded once per evaluation
+  struct Inputs
+  {
+    autoware_auto_msgs::msg::AutowareState::ConstSharedPtr autoware_state;
+    autoware_auto_msgs::msg::DrivingCapability::ConstSharedPtr driving_capability;
+    autoware_auto_msgs::msg::VehicleControlCommand::ConstSharedPtr prev_control_command;
+    autoware_auto_msgs::msg::VehicleStateReport::ConstSharedPtr state_report;
+    autoware_auto_msgs::msg::VehicleOdometry::ConstSharedPtr odometry;
+  };
+
   /// \brief The AutowareState callback that saves a received message
   /// \param[in] msg is a received message
   void onAutowareState(const autoware_auto_msgs::msg::AutowareState::ConstSharedPtr msg);
@@ -84,10 +106,11 @@ private:
   /// /param[in] hazard_status is a status that will be propagated to the system
   void publishHazardStatus(const autoware_auto_msgs::msg::HazardStatus & hazard_status);
   /// \brief Publishes control and state commands to the system
-  void publishControlAndStateCommands();
+  /// \param[in] inputs are the latest input messages
+  void publishControlAndStateCommands(const Inputs & inputs);
   /// \brief The emergency clear service callback
   ///
-  /// It allows to clear the held emergency state.
+  /// It allows to clear the held emergency state, which is done by the next evaluation.
   /// It can be called through the ROS service mechanism.
   /// \param[in] request_header is the header of the service request
   /// \param[in] request is the service request
@@ -100,14 +123,22 @@ private:
   /// \brief Checks if the necessary data has been received on specified topics
   ///
   /// It checks the following data: AutowareState, DrivingCapability, VehicleStateReport.
+  /// \param[in] inputs are the latest input messages
   /// \return Returns true if data is available
-  bool isDataReady();
-  /// \brief The main node logic which is called by the node's wall timer
+  bool isDataReady(const Inputs & inputs);
+  /// \brief Loads the latest input messages
+  /// \return Returns the latest input messages
+  Inputs loadInputs() const;
+  /// \brief The main node logic which is called by the evaluation thread or the node's timer
   void onTimer();
+  /// \brief Calls onTimer() with the update rate until the node is destroyed
+  /// \param[in] period is the time between the starts of consecutive evaluations
+  void runEvaluationThread(const std::chrono::nanoseconds period);
   /// \brief Determines if the vehicle has been stopped by checking the current velocities
   ///
+  /// \param[in] inputs are the latest input messages
   /// \return Returns true if the vehicle is stopped
-  bool isStopped();
+  bool isStopped(const Inputs & inputs);
   /// \brief Determines if the system is in emergency state based on the hazard status
   ///
   /// \param[in] hazard_status is the current hazard status
@@ -116,8 +147,9 @@ private:
   bool isEmergency(const autoware_auto_msgs::msg::HazardStatus & hazard_status);
   /// \brief Analyses the system and prepares the hazard status
   ///
+  /// \param[in] inputs are the latest input messages
   /// \return Returns the hazard status of the system
-  autoware_auto_msgs::msg::HazardStatus judgeHazardStatus();
+  autoware_auto_msgs::msg::HazardStatus judgeHazardStatus(const Inputs & inputs);
   /// \brief Helper function used to preparation of the diagnostic status
   ///
   /// \param[in] level the level of the diagnostic status
@@ -147,15 +179,21 @@ private:
   rclcpp::Subscription<autoware_auto_msgs::msg::VehicleStateReport>::SharedPtr sub_state_report_;
   rclcpp::Subscription<autoware_auto_msgs::msg::VehicleOdometry>::SharedPtr sub_odometry_;
 
-  autoware_auto_msgs::msg::AutowareState::ConstSharedPtr autoware_state_;
-  autoware_auto_msgs::msg::DrivingCapability::ConstSharedPtr driving_capability_;
-  autoware_auto_msgs::msg::VehicleControlCommand::ConstSharedPtr prev_control_command_;
-  autoware_auto_msgs::msg::VehicleStateReport::ConstSharedPtr state_report_;
-  autoware_auto_msgs::msg::VehicleOdometry::ConstSharedPtr odometry_;
+  LatestMessage<autoware_auto_msgs::msg::AutowareState> autoware_state_;
+  LatestMessage<autoware_auto_msgs::msg::DrivingCapability> driving_capability_;
+  LatestMessage<autoware_auto_msgs::msg::VehicleControlCommand> prev_control_command_;
+  LatestMessage<autoware_auto_msgs::msg::VehicleStateReport> state_report_;
+  LatestMessage<autoware_auto_msgs::msg::VehicleOdometry> odometry_;
 
-  // Timer
+  // Timer, used instead of the evaluation thread
   rclcpp::TimerBase::SharedPtr timer_;
 
+  // Evaluation thread, stop_evaluation_ is guarded by evaluation_mutex_
+  std::thread evaluation_thread_;
+  std::mutex evaluation_mutex_;
+  std::condition_variable evaluation_cv_;
+  bool stop_evaluation_ = false;
+
   // Parameters
   double update_rate_;
   double data_ready_timeout_;
@@ -165,15 +203,19 @@ private:
   double emergency_stop_acceleration_mps2_;
   bool use_parking_after_stopped_;
   double stopped_velocity_threshold_;
+  bool use_evaluation_thread_;
+  int64_t evaluation_thread_priority_;
 
   // Heartbeat/watchdog
   rclcpp::Time initialized_time_;
   std::shared_ptr<HeartbeatChecker<autoware_auto_msgs::msg::DrivingCapability>>
   heartbeat_driving_capability_;
 
-  // Algorithm
+  // Algorithm, only accessed by the evaluation
   bool is_emergency_ = false;
   autoware_auto_msgs::msg::HazardStatus hazard_status_;
+  // Set by the clear emergency service, reset by the next evaluation
+  std::atomic<bool> clear_requested_{false};
 };
 
 }  // namespace emergency_handler
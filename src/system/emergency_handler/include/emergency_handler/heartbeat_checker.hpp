@@ -17,6 +17,8 @@
 #ifndef EMERGENCY_HANDLER__HEARTBEAT_CHECKER_HPP_
 #define EMERGENCY_HANDLER__HEARTBEAT_CHECKER_HPP_
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 #include "rclcpp/rclcpp.hpp"
@@ -32,6 +34,8 @@ namespace emergency_handler
 ///
 /// It subscribes to specific topic and measures time from the last message received on this topic.
 /// If the measured time is greater than defined timeout value then it returns true on isTimeout().
+/// The time of the last message is held in an atomic, so that isTimeout() can be called from
+/// another thread than the one which runs the subscription.
 template<class MsgType>
 class EMERGENCY_HANDLER_PUBLIC HeartbeatChecker
 {
@@ -56,15 +60,16 @@ public:
   /// \return Returns true if timeout occurred, otherwise false.
   bool isTimeout()
   {
-    const auto time_from_last_heartbeat = clock_->now() - last_heartbeat_time_;
-    return time_from_last_heartbeat.seconds() > timeout_;
+    const int64_t time_from_last_heartbeat_ns =
+      clock_->now().nanoseconds() - last_heartbeat_time_ns_.load();
+    return static_cast<double>(time_from_last_heartbeat_ns) * 1.0e-9 > timeout_;
   }
 
 private:
   void onHeartbeat(const typename MsgType::ConstSharedPtr msg)
   {
     (void)msg;
-    last_heartbeat_time_ = clock_->now();
+    last_heartbeat_time_ns_.store(clock_->now().nanoseconds());
   }
 
   rclcpp::Clock::SharedPtr clock_;
@@ -73,7 +78,7 @@ private:
 
   typename rclcpp::Subscription<MsgType>::SharedPtr sub_heartbeat_;
 
-  rclcpp::Time last_heartbeat_time_ = rclcpp::Time(0);
+  std::atomic<int64_t> last_heartbeat_time_ns_{0};
 };
 
 }  // namespace emergency_handler
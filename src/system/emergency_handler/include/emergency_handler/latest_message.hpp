@@ -0,0 +1,56 @@
+// Copyright 2021 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef EMERGENCY_HANDLER__LATEST_MESSAGE_HPP_
+#define EMERGENCY_HANDLER__LATEST_MESSAGE_HPP_
+
+#include <memory>
+
+namespace autoware
+{
+namespace emergency_handler
+{
+
+/// \brief Holds the latest message received on a topic
+///
+/// The subscription callback stores the message and the evaluation of the emergency state loads
+/// it from another thread. Only the shared pointer is exchanged, so that neither side waits for
+/// a copy of the message, however large it is.
+template<class MsgType>
+class LatestMessage
+{
+public:
+  using ConstSharedPtr = typename MsgType::ConstSharedPtr;
+
+  /// \brief Replaces the held message
+  /// \param[in] msg is the new message
+  void store(ConstSharedPtr msg) noexcept
+  {
+    std::atomic_store(&msg_, std::move(msg));
+  }
+
+  /// \brief Returns the held message, or nullptr if no message has been stored yet
+  ConstSharedPtr load() const noexcept
+  {
+    return std::atomic_load(&msg_);
+  }
+
+private:
+  ConstSharedPtr msg_{};
+};
+
+}  // namespace emergency_handler
+}  // namespace autoware
+
+#endif  // EMERGENCY_HANDLER__LATEST_MESSAGE_HPP_
@@ -14,6 +14,11 @@
 //
 // Co-developed by Tier IV, Inc. and Robotec.AI sp. z o.o.
 
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstring>
+#include <exception>
 #include <memory>
 #include <string>
 #include <utility>
@@ -75,6 +80,8 @@ EmergencyHandlerNode::EmergencyHandlerNode(const rclcpp::NodeOptions & node_opti
   use_parking_after_stopped_ = this->declare_parameter<bool>("use_parking_after_stopped", true);
   stopped_velocity_threshold_ =
     this->declare_parameter<double>("stopped_velocity_threshold", 0.001);
+  use_evaluation_thread_ = this->declare_parameter<bool>("use_evaluation_thread", true);
+  evaluation_thread_priority_ = this->declare_parameter<int>("evaluation_thread_priority", 0);
 
   // Subscribers
   sub_autoware_state_ = create_subscription<autoware_auto_msgs::msg::AutowareState>(
@@ -115,51 +122,106 @@ EmergencyHandlerNode::EmergencyHandlerNode(const rclcpp::NodeOptions & node_opti
     std::bind(&EmergencyHandlerNode::onClearEmergencyService, this, _1, _2, _3));
 
   // Initialize messages
-  odometry_ = autoware_auto_msgs::msg::VehicleOdometry::ConstSharedPtr(
-    new autoware_auto_msgs::msg::VehicleOdometry);
-  prev_control_command_ = autoware_auto_msgs::msg::VehicleControlCommand::ConstSharedPtr(
-    new autoware_auto_msgs::msg::VehicleControlCommand);
+  odometry_.store(std::make_shared<const autoware_auto_msgs::msg::VehicleOdometry>());
+  prev_control_command_.store(
+    std::make_shared<const autoware_auto_msgs::msg::VehicleControlCommand>());
 
   // Timer
   initialized_time_ = this->now();
-  auto timer_callback = std::bind(&EmergencyHandlerNode::onTimer, this);
   auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
     std::chrono::duration<double>(1.0 / update_rate_));
 
-  timer_ = std::make_shared<rclcpp::GenericTimer<decltype(timer_callback)>>(
-    this->get_clock(), period, std::move(timer_callback),
-    this->get_node_base_interface()->get_context());
-  this->get_node_timers_interface()->add_timer(timer_, nullptr);
+  // The evaluation thread runs on the steady clock, so the timer is used with simulated time
+  if (use_evaluation_thread_ && !this->get_parameter("use_sim_time").as_bool()) {
+    evaluation_thread_ = std::thread{[this, period] {runEvaluationThread(period);}};
+  } else {
+    auto timer_callback = std::bind(&EmergencyHandlerNode::onTimer, this);
+    timer_ = std::make_shared<rclcpp::GenericTimer<decltype(timer_callback)>>(
+      this->get_clock(), period, std::move(timer_callback),
+      this->get_node_base_interface()->get_context());
+    this->get_node_timers_interface()->add_timer(timer_, nullptr);
+  }
+}
+
+EmergencyHandlerNode::~EmergencyHandlerNode()
+{
+  if (evaluation_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock{evaluation_mutex_};
+      stop_evaluation_ = true;
+    }
+    evaluation_cv_.notify_all();
+    evaluation_thread_.join();
+  }
+}
+
+void EmergencyHandlerNode::runEvaluationThread(const std::chrono::nanoseconds period)
+{
+  if (evaluation_thread_priority_ > 0) {
+    sched_param param{};
+    param.sched_priority = static_cast<int>(evaluation_thread_priority_);
+    const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error != 0) {
+      RCLCPP_WARN(
+        get_logger(), "Cannot set the priority of the evaluation thread: %s",
+        std::strerror(error));
+    }
+  }
+
+  const auto context = this->get_node_base_interface()->get_context();
+  auto next_evaluation = std::chrono::steady_clock::now() + period;
+  std::unique_lock<std::mutex> lock{evaluation_mutex_};
+  while (!evaluation_cv_.wait_until(lock, next_evaluation, [this] {return stop_evaluation_;})) {
+    lock.unlock();
+    if (rclcpp::ok(context)) {
+      try {
+        onTimer();
+      } catch (const std::exception & e) {
+        RCLCPP_ERROR(get_logger(), "Evaluation of the emergency state failed: %s", e.what());
+      }
+    }
+    lock.lock();
+
+    next_evaluation += period;
+    const auto now = std::chrono::steady_clock::now();
+    if (next_evaluation < now) {
+      // Skip the missed evaluations instead of catching up with them back to back
+      RCLCPP_WARN_THROTTLE(
+        get_logger(), *get_clock(), 1000,
+        "Evaluation of the emergency state took longer than the update period");
+      next_evaluation = now;
+    }
+  }
 }
 
 void EmergencyHandlerNode::onAutowareState(
   const autoware_auto_msgs::msg::AutowareState::ConstSharedPtr msg)
 {
-  autoware_state_ = msg;
+  autoware_state_.store(msg);
 }
 
 void EmergencyHandlerNode::onDrivingCapability(
   const autoware_auto_msgs::msg::DrivingCapability::ConstSharedPtr msg)
 {
-  driving_capability_ = msg;
+  driving_capability_.store(msg);
 }
 
 void EmergencyHandlerNode::onPrevControlCommand(
   const autoware_auto_msgs::msg::VehicleControlCommand::ConstSharedPtr msg)
 {
-  prev_control_command_ = msg;
+  prev_control_command_.store(msg);
 }
 
 void EmergencyHandlerNode::onStateReport(
   const autoware_auto_msgs::msg::VehicleStateReport::ConstSharedPtr msg)
 {
-  state_report_ = msg;
+  state_report_.store(msg);
 }
 
 void EmergencyHandlerNode::onOdometry(
   const autoware_auto_msgs::msg::VehicleOdometry::ConstSharedPtr msg)
 {
-  odometry_ = msg;
+  odometry_.store(msg);
 }
 
 bool EmergencyHandlerNode::onClearEmergencyService(
@@ -170,11 +232,10 @@ bool EmergencyHandlerNode::onClearEmergencyService(
   (void)request_header;
   (void)request;
 
-  const auto hazard_status = judgeHazardStatus();
+  const auto hazard_status = judgeHazardStatus(loadInputs());
 
   if (!isEmergency(hazard_status)) {
-    is_emergency_ = false;
-    hazard_status_ = hazard_status;
+    clear_requested_.store(true);
 
     response->success = true;
     response->message = "Emergency state has been cleared.";
@@ -211,7 +272,7 @@ void EmergencyHandlerNode::publishHazardStatus(
     convertHazardStatusToDiagnosticArray(this->get_clock(), hazard_status_stamped.status));
 }
 
-void EmergencyHandlerNode::publishControlAndStateCommands()
+void EmergencyHandlerNode::publishControlAndStateCommands(const Inputs & inputs)
 {
   const auto stamp = this->now();
 
@@ -219,7 +280,7 @@ void EmergencyHandlerNode::publishControlAndStateCommands()
   {
     autoware_auto_msgs::msg::VehicleControlCommand msg;
     msg.stamp = stamp;
-    msg.front_wheel_angle_rad = prev_control_command_->front_wheel_angle_rad;
+    msg.front_wheel_angle_rad = inputs.prev_control_command->front_wheel_angle_rad;
     msg.velocity_mps = 0.0;
     msg.long_accel_mps2 = static_cast<float>(emergency_stop_acceleration_mps2_);
 
@@ -234,7 +295,7 @@ void EmergencyHandlerNode::publishControlAndStateCommands()
     msg.headlight = autoware_auto_msgs::msg::VehicleStateCommand::HEADLIGHT_NO_COMMAND;
     msg.wiper = autoware_auto_msgs::msg::VehicleStateCommand::WIPER_NO_COMMAND;
 
-    if (use_parking_after_stopped_ && isStopped()) {
+    if (use_parking_after_stopped_ && isStopped(inputs)) {
       msg.gear = autoware_auto_msgs::msg::VehicleStateCommand::GEAR_PARK;
     } else {
       msg.gear = autoware_auto_msgs::msg::VehicleStateCommand::GEAR_NO_COMMAND;
@@ -244,29 +305,43 @@ void EmergencyHandlerNode::publishControlAndStateCommands()
   }
 }
 
-bool EmergencyHandlerNode::isDataReady()
+bool EmergencyHandlerNode::isDataReady(const Inputs & inputs)
 {
-  if (!autoware_state_) {
+  if (!inputs.autoware_state) {
     return false;
   }
 
-  if (!driving_capability_) {
+  if (!inputs.driving_capability) {
     return false;
   }
 
-  if (!state_report_) {
+  if (!inputs.state_report) {
     return false;
   }
 
   return true;
 }
 
+EmergencyHandlerNode::Inputs EmergencyHandlerNode::loadInputs() const
+{
+  Inputs inputs;
+  inputs.autoware_state = autoware_state_.load();
+  inputs.driving_capability = driving_capability_.load();
+  inputs.prev_control_command = prev_control_command_.load();
+  inputs.state_report = state_report_.load();
+  inputs.odometry = odometry_.load();
+  return inputs;
+}
+
 void EmergencyHandlerNode::onTimer()
 {
   using diagnostic_msgs::msg::DiagnosticStatus;
 
+  const auto inputs = loadInputs();
+  const bool clear_requested = clear_requested_.exchange(false);
+
   // Wait for data ready
-  if (!isDataReady()) {
+  if (!isDataReady(inputs)) {
     if ((this->now() - initialized_time_).seconds() > data_ready_timeout_) {
       autoware_auto_msgs::msg::HazardStatus hazard_status;
       hazard_status.level = autoware_auto_msgs::msg::HazardStatus::SINGLE_POINT_FAULT;
@@ -280,13 +355,13 @@ void EmergencyHandlerNode::onTimer()
   } else {
     // Check if emergency
     if (use_emergency_hold_) {
-      if (!is_emergency_) {
-        // Update only when it is not emergency
-        hazard_status_ = judgeHazardStatus();
+      if (!is_emergency_ || clear_requested) {
+        // Update only when it is not emergency or the emergency has been cleared
+        hazard_status_ = judgeHazardStatus(inputs);
       }
     } else {
       // Update always
-      hazard_status_ = judgeHazardStatus();
+      hazard_status_ = judgeHazardStatus(inputs);
     }
   }
 
@@ -295,13 +370,13 @@ void EmergencyHandlerNode::onTimer()
 
   // Handle the emergency state by emergency stopping of the vehicle
   if (is_emergency_) {
-    publishControlAndStateCommands();
+    publishControlAndStateCommands(inputs);
   }
 }
 
-bool EmergencyHandlerNode::isStopped()
+bool EmergencyHandlerNode::isStopped(const Inputs & inputs)
 {
-  if (static_cast<double>(odometry_->velocity_mps) < stopped_velocity_threshold_) {
+  if (static_cast<double>(inputs.odometry->velocity_mps) < stopped_velocity_threshold_) {
     return true;
   }
   return false;
@@ -313,30 +388,31 @@ bool EmergencyHandlerNode::isEmergency(
   return hazard_status.emergency;
 }
 
-autoware_auto_msgs::msg::HazardStatus EmergencyHandlerNode::judgeHazardStatus()
+autoware_auto_msgs::msg::HazardStatus EmergencyHandlerNode::judgeHazardStatus(
+  const Inputs & inputs)
 {
   using autoware_auto_msgs::msg::AutowareState;
   using autoware_auto_msgs::msg::HazardStatus;
   using autoware_auto_msgs::msg::VehicleStateReport;
 
-  if (!state_report_ || !autoware_state_) {
-    throw std::runtime_error(std::string(__func__) + ": No state report or autoware state.");
+  if (!isDataReady(inputs)) {
+    throw std::runtime_error(std::string(__func__) + ": Input data is not ready.");
   }
 
-  const auto vehicle_mode = state_report_->mode;
+  const auto vehicle_mode = inputs.state_report->mode;
 
   // Get hazard status
   auto hazard_status = vehicle_mode == VehicleStateReport::MODE_AUTONOMOUS ?
-    driving_capability_->autonomous_driving :
-    driving_capability_->remote_control;
+    inputs.driving_capability->autonomous_driving :
+    inputs.driving_capability->remote_control;
 
   // Ignore initializing and finalizing state
   {
     const auto is_in_auto_ignore_state =
-      (autoware_state_->state == AutowareState::INITIALIZING) ||
-      (autoware_state_->state == AutowareState::WAITING_FOR_ROUTE) ||
-      (autoware_state_->state == AutowareState::PLANNING) ||
-      (autoware_state_->state == AutowareState::FINALIZING);
+      (inputs.autoware_state->state == AutowareState::INITIALIZING) ||
+      (inputs.autoware_state->state == AutowareState::WAITING_FOR_ROUTE) ||
+      (inputs.autoware_state->state == AutowareState::PLANNING) ||
+      (inputs.autoware_state->state == AutowareState::FINALIZING);
 
     if (vehicle_mode == VehicleStateReport::MODE_AUTONOMOUS && is_in_auto_ignore_state) {
       hazard_status.level = HazardStatus::NO_FAULT;
@@ -344,8 +420,8 @@ autoware_auto_msgs::msg::HazardStatus EmergencyHandlerNode::judgeHazardStatus()
     }
 
     const auto is_in_remote_ignore_state =
-      (autoware_state_->state == AutowareState::INITIALIZING) ||
-      (autoware_state_->state == AutowareState::FINALIZING);
+      (inputs.autoware_state->state == AutowareState::INITIALIZING) ||
+      (inputs.autoware_state->state == AutowareState::FINALIZING);
 
     if (vehicle_mode == VehicleStateReport::MODE_MANUAL && is_in_remote_ignore_state) {
       hazard_status.level = HazardStatus::NO_FAULT;
@@ -358,9 +434,9 @@ autoware_auto_msgs::msg::HazardStatus EmergencyHandlerNode::judgeHazardStatus()
     using diagnostic_msgs::msg::DiagnosticStatus;
 
     const auto is_in_heartbeat_timeout_ignore_state =
-      (autoware_state_->state == AutowareState::INITIALIZING);
+      (inputs.autoware_state->state == AutowareState::INITIALIZING);
 
-    if (!is_in_heartbeat_timeout_ignore_state && heartbeat_driving_capability_->isTimeout()) {
+    if (!is_in_heartbeat_timeout_ignore_state && heartbeat_inputs.driving_capability->isTimeout()) {
       hazard_status.level = HazardStatus::SINGLE_POINT_FAULT;
       hazard_status.emergency = true;
       hazard_status.diag_single_point_fault.push_back(
@@ -0,0 +1,63 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 the Autoware Foundation
+/// \file
+/// \brief This file defines a counter of the heap allocations in a region of a test
+
+#ifndef AUTOWARE_TESTING__ALLOCATION_COUNTER_HPP_
+#define AUTOWARE_TESTING__ALLOCATION_COUNTER_HPP_
+
+#include <autoware_testing/visibility_control.hpp>
+
+#include <cstddef>
+
+namespace autoware
+{
+namespace tools
+{
+namespace autoware_testing
+{
+
+/// \brief Counter of the heap allocations since its construction, e.g. to check that the steady
+///        state of an algorithm does not allocate.
+///
+/// Linking against this library replaces the global operator new with one that counts the
+/// allocations, so that the allocations of all threads through new, including the ones of the
+/// standard containers, are counted. Memory allocated with `std::malloc` directly is not counted.
+class AUTOWARE_TESTING_PUBLIC AllocationCounter
+{
+public:
+  /// \brief Start counting
+  AllocationCounter() noexcept;
+
+  /// \brief Get the number of allocations since the construction or the last reset
+  std::size_t num_allocations() const noexcept;
+
+  /// \brief Get the number of allocated bytes since the construction or the last reset
+  std::size_t num_allocated_bytes() const noexcept;
+
+  /// \brief Restart counting from zero
+  void reset() noexcept;
+
+private:
+  std::size_t m_num_allocations_start;
+  std::size_t m_num_allocated_bytes_start;
+};
+
+}  // namespace autoware_testing
+}  // namespace tools
+}  // namespace autoware
+
+#endif  // AUTOWARE_TESTING__ALLOCATION_COUNTER_HPP_
@@ -0,0 +1,93 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 the Autoware Foundation
+/// \file
+/// \brief This file defines a recorder of the latencies of a region of a test
+
+#ifndef AUTOWARE_TESTING__LATENCY_RECORDER_HPP_
+#define AUTOWARE_TESTING__LATENCY_RECORDER_HPP_
+
+#include <autoware_testing/visibility_control.hpp>
+#include <common/types.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace autoware
+{
+namespace tools
+{
+namespace autoware_testing
+{
+
+/// \brief Recorder of the latencies of repeated runs of a region, e.g. to check the p99 latency
+///        of an algorithm against a budget
+class AUTOWARE_TESTING_PUBLIC LatencyRecorder
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// \brief Reserve memory for the latencies, so that recording them does not allocate
+  /// \param[in] num_samples Number of latencies to reserve memory for
+  void reserve(const std::size_t num_samples);
+
+  /// \brief Run a callable and record its latency
+  /// \tparam CallableT Callable without arguments
+  /// \param[in] callable Region to measure
+  template<typename CallableT>
+  void measure(CallableT && callable)
+  {
+    const auto start = Clock::now();
+    callable();
+    const auto end = Clock::now();
+    record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start));
+  }
+
+  /// \brief Record a latency measured elsewhere
+  /// \param[in] latency The latency
+  void record(const std::chrono::nanoseconds latency);
+
+  /// \brief Get the number of recorded latencies
+  std::size_t num_samples() const noexcept;
+
+  /// \brief Get a percentile of the recorded latencies. It is the nearest rank one, so it is the
+  ///        latency of an actual run.
+  /// \param[in] fraction Share of the latencies at or below the percentile, e.g. 0.99 for the p99
+  ///                     latency
+  /// \return The percentile
+  /// \throw std::domain_error If no latency is recorded or the fraction is not in [0, 1]
+  std::chrono::nanoseconds percentile(const common::types::float64_t fraction) const;
+
+  /// \brief Get the largest recorded latency
+  /// \throw std::domain_error If no latency is recorded
+  std::chrono::nanoseconds max() const;
+
+  /// \brief Get the mean of the recorded latencies
+  /// \throw std::domain_error If no latency is recorded
+  std::chrono::nanoseconds mean() const;
+
+  /// \brief Remove the recorded latencies
+  void clear() noexcept;
+
+private:
+  std::vector<std::chrono::nanoseconds> m_latencies{};
+};
+
+}  // namespace autoware_testing
+}  // namespace tools
+}  // namespace autoware
+
+#endif  // AUTOWARE_TESTING__LATENCY_RECORDER_HPP_
@@ -0,0 +1,121 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 the Autoware Foundation
+/// \file
+/// \brief This file defines a gtest fixture for testing the real-time properties of an algorithm
+
+#ifndef AUTOWARE_TESTING__PERFORMANCE_TEST_HPP_
+#define AUTOWARE_TESTING__PERFORMANCE_TEST_HPP_
+
+#include <autoware_testing/allocation_counter.hpp>
+#include <autoware_testing/latency_recorder.hpp>
+#include <common/types.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace autoware
+{
+namespace tools
+{
+namespace autoware_testing
+{
+
+/// \brief Fixture for tests of the real-time properties of an algorithm, such as that its steady
+///        state does not allocate or that its p99 latency is within a budget.
+///
+/// The measurements are also recorded as properties of the test, so that they show up in the
+/// test results.
+class PerformanceTest : public ::testing::Test
+{
+protected:
+  /// \brief Run a region a number of times and measure the allocations and latencies of the runs
+  /// \tparam CallableT Callable without arguments
+  /// \param[in] callable Region to measure
+  /// \param[in] num_runs Number of measured runs
+  /// \param[in] num_warmup_runs Number of runs before the measured ones, which warm up the caches
+  ///                            and let the algorithm allocate its buffers
+  template<typename CallableT>
+  void measure(
+    CallableT && callable, const std::size_t num_runs, const std::size_t num_warmup_runs = 1U)
+  {
+    for (std::size_t run = 0U; run < num_warmup_runs; ++run) {
+      callable();
+    }
+    m_latencies.clear();
+    // Recording the latencies must not be counted
+    m_latencies.reserve(num_runs);
+    const AllocationCounter counter;
+    for (std::size_t run = 0U; run < num_runs; ++run) {
+      m_latencies.measure(callable);
+    }
+    m_num_allocations = counter.num_allocations();
+    m_num_allocated_bytes = counter.num_allocated_bytes();
+
+    RecordProperty("num_allocations", std::to_string(m_num_allocations));
+    RecordProperty("num_allocated_bytes", std::to_string(m_num_allocated_bytes));
+    if (num_runs > 0U) {
+      RecordProperty("latency_mean_ms", std::to_string(to_ms(m_latencies.mean())));
+      RecordProperty("latency_p50_ms", std::to_string(latency_ms(0.5)));
+      RecordProperty("latency_p99_ms", std::to_string(latency_ms(0.99)));
+      RecordProperty("latency_max_ms", std::to_string(to_ms(m_latencies.max())));
+    }
+  }
+
+  /// \brief Get the number of allocations of the measured runs
+  std::size_t num_allocations() const noexcept
+  {
+    return m_num_allocations;
+  }
+
+  /// \brief Get the number of allocated bytes of the measured runs
+  std::size_t num_allocated_bytes() const noexcept
+  {
+    return m_num_allocated_bytes;
+  }
+
+  /// \brief Get the latencies of the measured runs
+  const LatencyRecorder & latencies() const noexcept
+  {
+    return m_latencies;
+  }
+
+  /// \brief Get a percentile of the latencies of the measured runs in milliseconds
+  /// \param[in] fraction Share of the latencies at or below the percentile, e.g. 0.99 for the p99
+  ///                     latency
+  /// \throw std::domain_error If no run is measured or the fraction is not in [0, 1]
+  common::types::float64_t latency_ms(const common::types::float64_t fraction) const
+  {
+    return to_ms(m_latencies.percentile(fraction));
+  }
+
+private:
+  static common::types::float64_t to_ms(const std::chrono::nanoseconds latency)
+  {
+    return static_cast<common::types::float64_t>(latency.count()) * 1.0E-6;
+  }
+
+  LatencyRecorder m_latencies{};
+  std::size_t m_num_allocations{0U};
+  std::size_t m_num_allocated_bytes{0U};
+};
+
+}  // namespace autoware_testing
+}  // namespace tools
+}  // namespace autoware
+
+#endif  // AUTOWARE_TESTING__PERFORMANCE_TEST_HPP_
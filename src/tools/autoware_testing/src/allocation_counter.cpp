@@ -0,0 +1,80 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_testing/allocation_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<std::size_t> g_num_allocations{0U};
+std::atomic<std::size_t> g_num_allocated_bytes{0U};
+}  // namespace
+
+// The allocation functions are replaced to count the allocations. The array and nothrow forms
+// call these.
+void * operator new(std::size_t size)
+{
+  (void)g_num_allocations.fetch_add(1U, std::memory_order_relaxed);
+  (void)g_num_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  void * const ptr = std::malloc((size > 0U) ? size : 1U);
+  if (nullptr == ptr) {
+    throw std::bad_alloc{};
+  }
+  return ptr;
+}
+
+void operator delete(void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace autoware
+{
+namespace tools
+{
+namespace autoware_testing
+{
+
+AllocationCounter::AllocationCounter() noexcept
+{
+  reset();
+}
+
+std::size_t AllocationCounter::num_allocations() const noexcept
+{
+  return g_num_allocations.load(std::memory_order_relaxed) - m_num_allocations_start;
+}
+
+std::size_t AllocationCounter::num_allocated_bytes() const noexcept
+{
+  return g_num_allocated_bytes.load(std::memory_order_relaxed) - m_num_allocated_bytes_start;
+}
+
+void AllocationCounter::reset() noexcept
+{
+  m_num_allocations_start = g_num_allocations.load(std::memory_order_relaxed);
+  m_num_allocated_bytes_start = g_num_allocated_bytes.load(std::memory_order_relaxed);
+}
+
+}  // namespace autoware_testing
+}  // namespace tools
+}  // namespace autoware
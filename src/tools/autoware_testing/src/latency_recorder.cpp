@@ -0,0 +1,91 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_testing/latency_recorder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace autoware
+{
+namespace tools
+{
+namespace autoware_testing
+{
+
+using common::types::float64_t;
+
+void LatencyRecorder::reserve(const std::size_t num_samples)
+{
+  m_latencies.reserve(num_samples);
+}
+
+void LatencyRecorder::record(const std::chrono::nanoseconds latency)
+{
+  m_latencies.push_back(latency);
+}
+
+std::size_t LatencyRecorder::num_samples() const noexcept
+{
+  return m_latencies.size();
+}
+
+std::chrono::nanoseconds LatencyRecorder::percentile(const float64_t fraction) const
+{
+  if (m_latencies.empty()) {
+    throw std::domain_error{"LatencyRecorder: no latency is recorded"};
+  }
+  if (!(fraction >= 0.0) || (fraction > 1.0)) {
+    throw std::domain_error{"LatencyRecorder: the percentile fraction is not in [0, 1]"};
+  }
+  // Latency with the smallest rank whose share of the latencies is at least the fraction
+  const auto rank = static_cast<std::size_t>(
+    std::ceil(fraction * static_cast<float64_t>(m_latencies.size())));
+  const auto idx = std::min(std::max(rank, std::size_t{1U}), m_latencies.size()) - 1U;
+  std::vector<std::chrono::nanoseconds> latencies{m_latencies};
+  const auto nth = latencies.begin() + static_cast<std::ptrdiff_t>(idx);
+  std::nth_element(latencies.begin(), nth, latencies.end());
+  return *nth;
+}
+
+std::chrono::nanoseconds LatencyRecorder::max() const
+{
+  if (m_latencies.empty()) {
+    throw std::domain_error{"LatencyRecorder: no latency is recorded"};
+  }
+  return *std::max_element(m_latencies.begin(), m_latencies.end());
+}
+
+std::chrono::nanoseconds LatencyRecorder::mean() const
+{
+  if (m_latencies.empty()) {
+    throw std::domain_error{"LatencyRecorder: no latency is recorded"};
+  }
+  std::chrono::nanoseconds total{0};
+  for (const auto latency : m_latencies) {
+    total += latency;
+  }
+  return total / static_cast<int64_t>(m_latencies.size());
+}
+
+void LatencyRecorder::clear() noexcept
+{
+  m_latencies.clear();
+}
+
+}  // namespace autoware_testing
+}  // namespace tools
+}  // namespace autoware
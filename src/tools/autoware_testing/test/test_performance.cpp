@@ -0,0 +1,108 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware_testing/allocation_counter.hpp>
+#include <autoware_testing/latency_recorder.hpp>
+#include <autoware_testing/performance_test.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using autoware::tools::autoware_testing::AllocationCounter;
+using autoware::tools::autoware_testing::LatencyRecorder;
+using autoware::tools::autoware_testing::PerformanceTest;
+
+TEST(AllocationCounter, CountsAllocations)
+{
+  AllocationCounter counter;
+  EXPECT_EQ(counter.num_allocations(), 0U);
+  const auto value = std::make_unique<int64_t>(1);
+  EXPECT_EQ(counter.num_allocations(), 1U);
+  EXPECT_EQ(counter.num_allocated_bytes(), sizeof(int64_t));
+  std::vector<int32_t> values(16U);
+  EXPECT_EQ(counter.num_allocations(), 2U);
+  EXPECT_EQ(counter.num_allocated_bytes(), sizeof(int64_t) + (16U * sizeof(int32_t)));
+  // Array allocations are counted too
+  const auto array = std::make_unique<int32_t[]>(4U);
+  EXPECT_EQ(counter.num_allocations(), 3U);
+  // Reusing the capacity does not allocate
+  counter.reset();
+  values.clear();
+  values.push_back(1);
+  EXPECT_EQ(counter.num_allocations(), 0U);
+  EXPECT_EQ(counter.num_allocated_bytes(), 0U);
+  // Allocations of other threads are counted too
+  std::thread thread{[] {std::vector<int32_t> other_values(8U);}};
+  thread.join();
+  EXPECT_GE(counter.num_allocations(), 1U);
+}
+
+TEST(LatencyRecorder, Percentiles)
+{
+  LatencyRecorder recorder;
+  EXPECT_THROW(recorder.percentile(0.5), std::domain_error);
+  EXPECT_THROW(recorder.max(), std::domain_error);
+  EXPECT_THROW(recorder.mean(), std::domain_error);
+  // Latencies 100us to 1us, recorded out of order
+  for (int64_t latency_us = 100; latency_us > 0; --latency_us) {
+    recorder.record(std::chrono::microseconds{latency_us});
+  }
+  EXPECT_EQ(recorder.num_samples(), 100U);
+  EXPECT_EQ(recorder.percentile(0.0), std::chrono::microseconds{1});
+  EXPECT_EQ(recorder.percentile(0.5), std::chrono::microseconds{50});
+  EXPECT_EQ(recorder.percentile(0.99), std::chrono::microseconds{99});
+  EXPECT_EQ(recorder.percentile(0.995), std::chrono::microseconds{100});
+  EXPECT_EQ(recorder.percentile(1.0), std::chrono::microseconds{100});
+  EXPECT_EQ(recorder.max(), std::chrono::microseconds{100});
+  EXPECT_EQ(recorder.mean(), std::chrono::nanoseconds{50500});
+  EXPECT_THROW(recorder.percentile(1.5), std::domain_error);
+  EXPECT_THROW(recorder.percentile(-0.5), std::domain_error);
+
+  recorder.clear();
+  EXPECT_EQ(recorder.num_samples(), 0U);
+  recorder.measure([] {std::this_thread::sleep_for(std::chrono::milliseconds{2});});
+  EXPECT_EQ(recorder.num_samples(), 1U);
+  EXPECT_GE(recorder.max(), std::chrono::milliseconds{2});
+}
+
+class PerformanceTestTest : public PerformanceTest {};
+
+TEST_F(PerformanceTestTest, SteadyState)
+{
+  std::vector<int32_t> values;
+  const auto fill = [&values] {
+      values.clear();
+      for (int32_t value = 0; value < 100; ++value) {
+        values.push_back(value);
+      }
+    };
+  // The warm-up run lets the vector grow to its steady state capacity
+  measure(fill, 20U);
+  EXPECT_EQ(num_allocations(), 0U);
+  EXPECT_EQ(latencies().num_samples(), 20U);
+  EXPECT_LT(latency_ms(0.99), 1000.0);
+
+  // Without warm-up, the first run allocates
+  values.clear();
+  values.shrink_to_fit();
+  measure(fill, 20U, 0U);
+  EXPECT_GT(num_allocations(), 0U);
+  EXPECT_GE(num_allocated_bytes(), 100U * sizeof(int32_t));
+  EXPECT_EQ(latencies().num_samples(), 20U);
+}
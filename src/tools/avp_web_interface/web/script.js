@@ -67,13 +67,14 @@ document.addEventListener("DOMContentLoaded", function() {
     initialButton.addEventListener('click', setInitialSimPose);
     */
 
-    function publishGoalPose(pos_x, pos_y, orient_z, orient_w) {
-        var goalTopic = new ROSLIB.Topic({
-            ros : ros,
-            name : '/planning/goal_pose',
-            messageType : 'geometry_msgs/msg/PoseStamped'
-        });
+    // advertised once, instead of for every click
+    var goalTopic = new ROSLIB.Topic({
+        ros : ros,
+        name : '/planning/goal_pose',
+        messageType : 'geometry_msgs/msg/PoseStamped'
+    });
 
+    function publishGoalPose(pos_x, pos_y, orient_z, orient_w) {
         // in parsing the pose, 0.0 get converted to an integer leading to problems in publishing the
         // message. So choose something close enough to zero that preserves the float type
         const floatNearZero = 1e-16;
@@ -43,6 +43,8 @@
 #include <numeric>
 #include <string>
 #include <functional>
+#include <mutex>
+#include <thread>
 
 #include "kittiobjevalmodule.hpp"
 
@@ -358,9 +360,23 @@ Polygon toPolygon(const T & g)
   return poly;
 }
 
+// check whether the bird's eye view footprints cannot intersect, using the circles around them
+inline bool8_t groundBoxesDisjoint(const tDetection & d, const tGroundtruth & g)
+{
+  const float64_t reach = 0.5 * (std::hypot(d.l, d.w) + std::hypot(g.l, g.w));
+  const float64_t dx = d.t1 - g.t1;
+  const float64_t dz = d.t3 - g.t3;
+  return (dx * dx + dz * dz) > (reach * reach);
+}
+
 // measure overlap between bird's eye view bounding boxes, parametrized by (ry, l, w, tx, tz)
 inline float64_t groundBoxOverlap(tDetection d, tGroundtruth g, int32_t criterion = -1)
 {
+  // boxes that are far apart have no intersection, spare the polygon clipping for them
+  if (groundBoxesDisjoint(d, g)) {
+    return 0;
+  }
+
   Polygon gp = toPolygon(g);
   Polygon dp = toPolygon(d);
 
@@ -385,6 +401,10 @@ inline float64_t groundBoxOverlap(tDetection d, tGroundtruth g, int32_t criterio
 // measure overlap between 3D bounding boxes, parametrized by (ry, h, w, l, tx, ty, tz)
 inline float64_t box3DOverlap(tDetection d, tGroundtruth g, int32_t criterion = -1)
 {
+  if (groundBoxesDisjoint(d, g)) {
+    return 0;
+  }
+
   Polygon gp = toPolygon(g);
   Polygon dp = toPolygon(d);
 
@@ -723,6 +743,22 @@ tPrData computeStatistics(
 EVALUATE CLASS-WISE
 =======================================================================*/
 
+// call func(begin, end) for contiguous ranges of [0, n) on as many threads as there are cores
+void parallelFor(size_t n, const std::function<void(size_t, size_t)> & func)
+{
+  const size_t n_threads =
+    std::max<size_t>(1U, std::min<size_t>(std::thread::hardware_concurrency(), n));
+  const size_t chunk = (n + n_threads - 1U) / n_threads;
+  std::vector<std::thread> threads;
+  for (size_t begin = chunk; begin < n; begin += chunk) {
+    threads.emplace_back(func, begin, std::min(begin + chunk, n));
+  }
+  func(0U, std::min(chunk, n));
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
+
 bool8_t eval_class(
   FILE * fp_det, FILE * fp_ori, CLASSES current_class,
   const std::vector<std::vector<tGroundtruth>> & groundtruth,
@@ -734,60 +770,89 @@ bool8_t eval_class(
   assert(groundtruth.size() == detections.size());
 
   // init
+  // the frames are evaluated in parallel, and their results are combined in frame order below so
+  // that the floating point sums are the same as for a sequential evaluation
+  const size_t n_frames = groundtruth.size();
   // total no. of gt (denominator of recall)
   int32_t n_gt = 0;
   // detection scores, evaluated for recall discretization
   std::vector<float64_t> v, thresholds;
   // index of ignored gt detection for current class/difficulty
-  std::vector<std::vector<int32_t>> ignored_gt, ignored_det;
+  std::vector<std::vector<int32_t>> ignored_gt(n_frames), ignored_det(n_frames);
   // index of dontcare areas, included in ground truth
-  std::vector<std::vector<tGroundtruth>> dontcare;
+  std::vector<std::vector<tGroundtruth>> dontcare(n_frames);
+  // no. of gt and detection scores of every frame
+  std::vector<int32_t> frame_n_gt(n_frames, 0);
+  std::vector<std::vector<float64_t>> frame_v(n_frames);
 
   // for all test images do
-  for (uint32_t i = 0; i < groundtruth.size(); i++) {
-    // holds ignored ground truth, ignored detections and dontcare areas for current frame
-    std::vector<int32_t> i_gt, i_det;
-    std::vector<tGroundtruth> dc;
-
-    // only evaluate objects of current class and ignore occluded, truncated objects
-    cleanData(current_class, groundtruth[i], detections[i], i_gt, dc, i_det, n_gt, difficulty);
-    ignored_gt.push_back(i_gt);
-    ignored_det.push_back(i_det);
-    dontcare.push_back(dc);
-
-    // compute statistics to get recall values
-    tPrData pr_tmp = tPrData();
-    pr_tmp = computeStatistics(
-      current_class, groundtruth[i], detections[i], dc, i_gt, i_det, false,
-      boxoverlap, metric);
-
-    // add detection scores to vector over all images
-    for (uint32_t j = 0; j < pr_tmp.v.size(); j++) {
-      v.push_back(pr_tmp.v[j]);
-    }
+  parallelFor(
+    n_frames, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        // only evaluate objects of current class and ignore occluded, truncated objects
+        cleanData(
+          current_class, groundtruth[i], detections[i], ignored_gt[i], dontcare[i],
+          ignored_det[i], frame_n_gt[i], difficulty);
+
+        // compute statistics to get recall values
+        frame_v[i] = computeStatistics(
+          current_class, groundtruth[i], detections[i], dontcare[i], ignored_gt[i],
+          ignored_det[i], false, boxoverlap, metric).v;
+      }
+    });
+
+  // add detection scores to vector over all images
+  for (size_t i = 0; i < n_frames; i++) {
+    n_gt += frame_n_gt[i];
+    v.insert(v.end(), frame_v[i].begin(), frame_v[i].end());
   }
 
   // get scores that must be evaluated for recall discretization
   thresholds = getThresholds(v, n_gt);
 
   // compute TP,FP,FN for relevant scores
+  const size_t n_thresholds = thresholds.size();
   std::vector<tPrData> pr;
-  pr.assign(thresholds.size(), tPrData());
-  for (uint32_t i = 0; i < groundtruth.size(); i++) {
-    // for all scores/recall thresholds do:
-    for (uint32_t t = 0; t < thresholds.size(); t++) {
-      tPrData tmp = tPrData();
-      tmp = computeStatistics(
-        current_class, groundtruth[i], detections[i], dontcare[i],
-        ignored_gt[i], ignored_det[i], true, boxoverlap, metric,
-        compute_aos, thresholds[t]);
-
-      // add no. of TP, FP, FN, AOS for current frame to total evaluation for current threshold
-      pr[t].tp += tmp.tp;
-      pr[t].fp += tmp.fp;
-      pr[t].fn += tmp.fn;
-      if (tmp.similarity != -1) {
-        pr[t].similarity += tmp.similarity;
+  pr.assign(n_thresholds, tPrData());
+  // the counts are accumulated per thread, the AOS of every frame and threshold is kept
+  std::vector<std::vector<tPrData>> thread_pr;
+  std::vector<float64_t> frame_similarity(n_frames * n_thresholds, -1);
+  std::mutex thread_pr_mutex;
+  parallelFor(
+    n_frames, [&](size_t begin, size_t end) {
+      std::vector<tPrData> local_pr(n_thresholds);
+      for (size_t i = begin; i < end; i++) {
+        // for all scores/recall thresholds do:
+        for (size_t t = 0; t < n_thresholds; t++) {
+          const tPrData tmp = computeStatistics(
+            current_class, groundtruth[i], detections[i], dontcare[i],
+            ignored_gt[i], ignored_det[i], true, boxoverlap, metric,
+            compute_aos, thresholds[t]);
+
+          // add no. of TP, FP, FN for current frame to evaluation for current threshold
+          local_pr[t].tp += tmp.tp;
+          local_pr[t].fp += tmp.fp;
+          local_pr[t].fn += tmp.fn;
+          frame_similarity[i * n_thresholds + t] = tmp.similarity;
+        }
+      }
+      std::lock_guard<std::mutex> lock(thread_pr_mutex);
+      thread_pr.push_back(std::move(local_pr));
+    });
+
+  // add the counts of all threads and the AOS of all frames to total evaluation
+  for (const auto & local_pr : thread_pr) {
+    for (size_t t = 0; t < n_thresholds; t++) {
+      pr[t].tp += local_pr[t].tp;
+      pr[t].fp += local_pr[t].fp;
+      pr[t].fn += local_pr[t].fn;
+    }
+  }
+  for (size_t i = 0; i < n_frames; i++) {
+    for (size_t t = 0; t < n_thresholds; t++) {
+      const float64_t similarity = frame_similarity[i * n_thresholds + t];
+      if (similarity != -1) {
+        pr[t].similarity += similarity;
       }
     }
   }
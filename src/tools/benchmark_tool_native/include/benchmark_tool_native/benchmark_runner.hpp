@@ -0,0 +1,118 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 the Autoware Foundation
+/// \file
+/// \brief This file defines the loop which runs and measures a benchmark task
+
+#ifndef BENCHMARK_TOOL_NATIVE__BENCHMARK_RUNNER_HPP_
+#define BENCHMARK_TOOL_NATIVE__BENCHMARK_RUNNER_HPP_
+
+#include <autoware_testing/allocation_counter.hpp>
+#include <benchmark_tool_native/visibility_control.hpp>
+#include <common/types.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware
+{
+namespace tools
+{
+namespace benchmark_tool_native
+{
+
+using Clock = std::chrono::steady_clock;
+
+/// \brief Summary of the measured frames of a task
+struct BENCHMARK_TOOL_NATIVE_PUBLIC TaskSummary
+{
+  std::string name;
+  // number of measured frames, over all passes
+  std::size_t num_frames;
+  std::chrono::nanoseconds mean;
+  std::chrono::nanoseconds p50;
+  std::chrono::nanoseconds p99;
+  std::chrono::nanoseconds max;
+  // frames per second of processing time
+  common::types::float64_t throughput_hz;
+  common::types::float64_t allocations_per_frame;
+};
+
+/// \brief Summarize the latencies of the measured frames of a task. The percentiles are the
+///        nearest rank ones, so they are latencies of actual frames.
+/// \param[in] name Name of the task
+/// \param[in] latencies Processing time of every measured frame
+/// \param[in] num_allocations Number of allocations over all measured frames
+/// \return The summary
+/// \throw std::domain_error If there are no latencies
+BENCHMARK_TOOL_NATIVE_PUBLIC TaskSummary summarize(
+  const std::string & name, std::vector<std::chrono::nanoseconds> latencies,
+  const uint64_t num_allocations);
+
+/// \brief Write the summaries as a JSON object with a "tasks" array, with the latencies in
+///        microseconds
+/// \param[in,out] stream The stream to write to
+/// \param[in] summaries The summaries of the tasks
+BENCHMARK_TOOL_NATIVE_PUBLIC void write_json(
+  std::ostream & stream, const std::vector<TaskSummary> & summaries);
+
+/// \brief Process all frames in a tight loop, measuring the processing time and the allocations
+///        of every frame. The allocations are counted by autoware_testing on all threads.
+/// \tparam FrameT Type of a frame
+/// \tparam ProcessT Callable processing a frame
+/// \param[in] name Name of the task
+/// \param[in] frames Frames to process, in memory
+/// \param[in] num_passes Number of measured passes over the frames
+/// \param[in] num_warmup_passes Number of passes before the measured ones, which warm up the caches
+///                              and let the task allocate its buffers
+/// \param[in] process Processing of a frame
+/// \return The summary of the measured frames
+/// \throw std::domain_error If no frame is measured
+template<typename FrameT, typename ProcessT>
+TaskSummary run_task(
+  const std::string & name, const std::vector<FrameT> & frames, const std::size_t num_passes,
+  const std::size_t num_warmup_passes, ProcessT && process)
+{
+  for (std::size_t pass = 0U; pass < num_warmup_passes; ++pass) {
+    for (const auto & frame : frames) {
+      process(frame);
+    }
+  }
+  std::vector<std::chrono::nanoseconds> latencies;
+  latencies.reserve(frames.size() * num_passes);
+  autoware_testing::AllocationCounter allocations;
+  uint64_t num_allocations = 0U;
+  for (std::size_t pass = 0U; pass < num_passes; ++pass) {
+    for (const auto & frame : frames) {
+      allocations.reset();
+      const auto start = Clock::now();
+      process(frame);
+      const auto end = Clock::now();
+      num_allocations += allocations.num_allocations();
+      latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start));
+    }
+  }
+  return summarize(name, std::move(latencies), num_allocations);
+}
+
+}  // namespace benchmark_tool_native
+}  // namespace tools
+}  // namespace autoware
+
+#endif  // BENCHMARK_TOOL_NATIVE__BENCHMARK_RUNNER_HPP_
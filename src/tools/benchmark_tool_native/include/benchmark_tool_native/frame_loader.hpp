@@ -0,0 +1,71 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \copyright Copyright 2021 the Autoware Foundation
+/// \file
+/// \brief This file defines functions to load the frames of a benchmark into memory
+
+#ifndef BENCHMARK_TOOL_NATIVE__FRAME_LOADER_HPP_
+#define BENCHMARK_TOOL_NATIVE__FRAME_LOADER_HPP_
+
+#include <benchmark_tool_native/visibility_control.hpp>
+#include <common/types.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace tools
+{
+/// \brief A native benchmark harness which runs the algorithm libraries without ROS in the loop
+namespace benchmark_tool_native
+{
+
+/// \brief The points of one lidar frame, in the frame of the sensor
+using Frame = std::vector<common::types::PointXYZIF>;
+
+/// \brief Load a point cloud in the binary format of the KITTI velodyne data, which is four
+///        float32 values x, y, z and reflectance per point
+/// \param[in] path Path of the .bin file
+/// \return The points of the file, with the reflectance as intensity
+/// \throw std::runtime_error If the file can not be read or is not a whole number of points
+BENCHMARK_TOOL_NATIVE_PUBLIC Frame load_kitti_frame(const std::string & path);
+
+/// \brief Load the KITTI point clouds of a directory, such as training/velodyne of the KITTI 3D
+///        object detection benchmark, in the order of their file names
+/// \param[in] directory Directory with the .bin files
+/// \param[in] max_frames Maximum number of frames to load
+/// \return The frames
+/// \throw std::runtime_error If the directory can not be read or contains no .bin file
+BENCHMARK_TOOL_NATIVE_PUBLIC std::vector<Frame> load_kitti_frames(
+  const std::string & directory, const std::size_t max_frames);
+
+/// \brief Generate frames of objects scattered on a flat ground around the sensor, to run the
+///        benchmark reproducibly without a dataset
+/// \param[in] num_frames Number of frames
+/// \param[in] frame_size Number of points per frame
+/// \param[in] sensor_height_m Height of the sensor above the ground
+/// \param[in] seed Seed of the random number generator
+/// \return The frames
+BENCHMARK_TOOL_NATIVE_PUBLIC std::vector<Frame> make_synthetic_frames(
+  const std::size_t num_frames, const std::size_t frame_size,
+  const common::types::float32_t sensor_height_m, const uint32_t seed);
+
+}  // namespace benchmark_tool_native
+}  // namespace tools
+}  // namespace autoware
+
+#endif  // BENCHMARK_TOOL_NATIVE__FRAME_LOADER_HPP_
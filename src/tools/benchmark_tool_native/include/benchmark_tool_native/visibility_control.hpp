@@ -0,0 +1,38 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BENCHMARK_TOOL_NATIVE__VISIBILITY_CONTROL_HPP_
+#define BENCHMARK_TOOL_NATIVE__VISIBILITY_CONTROL_HPP_
+
+
+////////////////////////////////////////////////////////////////////////////////
+#if defined(__WIN32)
+  #if defined(BENCHMARK_TOOL_NATIVE_BUILDING_DLL) || defined(BENCHMARK_TOOL_NATIVE_EXPORTS)
+    #define BENCHMARK_TOOL_NATIVE_PUBLIC __declspec(dllexport)
+    #define BENCHMARK_TOOL_NATIVE_LOCAL
+  #else  // defined(BENCHMARK_TOOL_NATIVE_BUILDING_DLL) || defined(BENCHMARK_TOOL_NATIVE_EXPORTS)
+    #define BENCHMARK_TOOL_NATIVE_PUBLIC __declspec(dllimport)
+    #define BENCHMARK_TOOL_NATIVE_LOCAL
+  #endif  // defined(BENCHMARK_TOOL_NATIVE_BUILDING_DLL) || defined(BENCHMARK_TOOL_NATIVE_EXPORTS)
+#elif defined(__linux__)
+  #define BENCHMARK_TOOL_NATIVE_PUBLIC __attribute__((visibility("default")))
+  #define BENCHMARK_TOOL_NATIVE_LOCAL __attribute__((visibility("hidden")))
+#elif defined(__APPLE__)
+  #define BENCHMARK_TOOL_NATIVE_PUBLIC __attribute__((visibility("default")))
+  #define BENCHMARK_TOOL_NATIVE_LOCAL __attribute__((visibility("hidden")))
+#else  // defined(_LINUX)
+  #error "Unsupported Build Configuration"
+#endif  // defined(_WINDOWS)
+
+#endif  // BENCHMARK_TOOL_NATIVE__VISIBILITY_CONTROL_HPP_
@@ -0,0 +1,99 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark_tool_native/benchmark_runner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace tools
+{
+namespace benchmark_tool_native
+{
+
+using common::types::float64_t;
+
+namespace
+{
+// Latency with the smallest rank whose share of the latencies is at least the fraction
+std::chrono::nanoseconds percentile(
+  const std::vector<std::chrono::nanoseconds> & sorted, const float64_t fraction)
+{
+  const auto rank = static_cast<std::size_t>(
+    std::ceil(fraction * static_cast<float64_t>(sorted.size())));
+  return sorted[std::min(std::max(rank, std::size_t{1U}), sorted.size()) - 1U];
+}
+
+float64_t to_us(const std::chrono::nanoseconds duration)
+{
+  return static_cast<float64_t>(duration.count()) * 1.0E-3;
+}
+}  // namespace
+
+TaskSummary summarize(
+  const std::string & name, std::vector<std::chrono::nanoseconds> latencies,
+  const uint64_t num_allocations)
+{
+  if (latencies.empty()) {
+    throw std::domain_error{"summarize: no frame was measured for " + name};
+  }
+  std::sort(latencies.begin(), latencies.end());
+  std::chrono::nanoseconds total{0};
+  for (const auto latency : latencies) {
+    total += latency;
+  }
+  const auto num_frames = static_cast<float64_t>(latencies.size());
+
+  TaskSummary summary{};
+  summary.name = name;
+  summary.num_frames = latencies.size();
+  summary.mean = total / static_cast<int64_t>(latencies.size());
+  summary.p50 = percentile(latencies, 0.5);
+  summary.p99 = percentile(latencies, 0.99);
+  summary.max = latencies.back();
+  summary.throughput_hz = (total.count() > 0) ?
+    (num_frames * 1.0E9 / static_cast<float64_t>(total.count())) : 0.0;
+  summary.allocations_per_frame = static_cast<float64_t>(num_allocations) / num_frames;
+  return summary;
+}
+
+void write_json(std::ostream & stream, const std::vector<TaskSummary> & summaries)
+{
+  stream << "{\n  \"tasks\": [";
+  for (std::size_t idx = 0U; idx < summaries.size(); ++idx) {
+    const auto & summary = summaries[idx];
+    stream << ((idx == 0U) ? "\n" : ",\n") <<
+      "    {\n" <<
+      "      \"name\": \"" << summary.name << "\",\n" <<
+      "      \"frames\": " << summary.num_frames << ",\n" <<
+      "      \"latency_us\": {" <<
+      "\"mean\": " << to_us(summary.mean) << ", " <<
+      "\"p50\": " << to_us(summary.p50) << ", " <<
+      "\"p99\": " << to_us(summary.p99) << ", " <<
+      "\"max\": " << to_us(summary.max) << "},\n" <<
+      "      \"throughput_hz\": " << summary.throughput_hz << ",\n" <<
+      "      \"allocations_per_frame\": " << summary.allocations_per_frame << "\n" <<
+      "    }";
+  }
+  stream << "\n  ]\n}\n";
+}
+
+}  // namespace benchmark_tool_native
+}  // namespace tools
+}  // namespace autoware
@@ -0,0 +1,363 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark_tool_native/benchmark_runner.hpp>
+#include <benchmark_tool_native/frame_loader.hpp>
+#include <common/types.hpp>
+#include <euclidean_cluster/euclidean_cluster.hpp>
+#include <ndt/ndt_localizer.hpp>
+#include <ndt/ndt_map.hpp>
+#include <optimization/line_search/more_thuente_line_search.hpp>
+#include <optimization/newtons_method_optimizer.hpp>
+#include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
+#include <ray_ground_classifier/ray_aggregator.hpp>
+#include <ray_ground_classifier/ray_ground_classifier.hpp>
+#include <rcutils/cmdline_parser.h>
+#include <voxel_grid/config.hpp>
+#include <voxel_grid/voxel_grid.hpp>
+#include <voxel_grid/voxel_storage.hpp>
+#include <voxel_grid/voxels.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using autoware::common::types::char8_t;
+using autoware::common::types::float32_t;
+using autoware::common::types::PointPtrBlock;
+using autoware::common::types::PointXYZI;
+using autoware::common::types::PointXYZIF;
+using autoware::tools::benchmark_tool_native::Frame;
+using autoware::tools::benchmark_tool_native::run_task;
+using autoware::tools::benchmark_tool_native::TaskSummary;
+
+namespace euclidean_cluster = autoware::perception::segmentation::euclidean_cluster;
+namespace ndt = autoware::localization::ndt;
+namespace optimization = autoware::common::optimization;
+namespace ray_ground_classifier = autoware::perception::filters::ray_ground_classifier;
+namespace voxel_grid = autoware::perception::filters::voxel_grid;
+
+// Mounting height of the lidar of the KITTI recording car
+constexpr float32_t kSensorHeightM = 1.73F;
+// Voxel size of the downsampled clouds, which are the scans of the ndt localizer
+constexpr float32_t kScanVoxelSizeM = 1.0F;
+constexpr float32_t kMapVoxelSizeM = 2.0F;
+constexpr float32_t kRangeM = 130.0F;
+
+struct Options
+{
+  std::string kitti_directory{};
+  std::size_t max_frames{100U};
+  std::size_t num_passes{5U};
+  std::size_t num_warmup_passes{1U};
+  std::size_t num_threads{1U};
+  std::string output{};
+};
+
+voxel_grid::Config make_voxel_grid_config(const float32_t voxel_size_m, const std::size_t capacity)
+{
+  voxel_grid::PointXYZ min_point;
+  min_point.x = -kRangeM;
+  min_point.y = -kRangeM;
+  min_point.z = -10.0F;
+  voxel_grid::PointXYZ max_point;
+  max_point.x = kRangeM;
+  max_point.y = kRangeM;
+  max_point.z = 10.0F;
+  voxel_grid::PointXYZ voxel_size;
+  voxel_size.x = voxel_size_m;
+  voxel_size.y = voxel_size_m;
+  voxel_size.z = voxel_size_m;
+  return voxel_grid::Config{min_point, max_point, voxel_size, capacity};
+}
+
+/// The ground classification of the ray ground classifier node, without the output messages
+class GroundClassification
+{
+public:
+  explicit GroundClassification(const std::size_t capacity)
+  : m_classifier{ray_ground_classifier::Config{
+        kSensorHeightM, 40.0F, 17.0F, 70.0F, 0.43F, 3.3F, 3.6F, 5.0F}},
+    m_aggregator{ray_ground_classifier::RayAggregator::Config{-3.14159F, 3.14159F, 0.005F, 512U}}
+  {
+    m_ground.reserve(capacity);
+    m_nonground.reserve(capacity);
+  }
+
+  void operator()(const Frame & frame)
+  {
+    m_aggregator.reset();
+    m_ground.clear();
+    m_nonground.clear();
+    for (const auto & pt : frame) {
+      // Points at the sensor would all go into the first bin of their ray
+      if ((std::fabs(pt.x) > std::numeric_limits<float32_t>::epsilon()) ||
+        (std::fabs(pt.y) > std::numeric_limits<float32_t>::epsilon()))
+      {
+        if (!m_aggregator.insert(&pt)) {
+          m_aggregator.end_of_scan();
+        }
+      } else {
+        m_nonground.push_back(&pt);
+      }
+    }
+    m_aggregator.end_of_scan();
+    const std::size_t num_ready = m_aggregator.get_ready_ray_count();
+    for (std::size_t idx = 0U; idx < num_ready; ++idx) {
+      m_classifier.partition(m_aggregator.get_next_ray(), m_ground, m_nonground);
+    }
+  }
+
+  const PointPtrBlock & nonground() const
+  {
+    return m_nonground;
+  }
+
+private:
+  ray_ground_classifier::RayGroundClassifier m_classifier;
+  ray_ground_classifier::RayAggregator m_aggregator;
+  PointPtrBlock m_ground{};
+  PointPtrBlock m_nonground{};
+};
+
+/// The downsampling of the approximate voxel grid node, without the output message
+class Downsampling
+{
+public:
+  Downsampling(const float32_t voxel_size_m, const std::size_t capacity)
+  : m_grid{make_voxel_grid_config(voxel_size_m, capacity)}
+  {
+    m_output.reserve(capacity);
+  }
+
+  void operator()(const Frame & frame)
+  {
+    m_grid.clear();
+    m_grid.insert(frame.begin(), frame.end());
+    m_output.clear();
+    for (const auto & it : m_grid) {
+      m_output.push_back(it.second.get());
+    }
+  }
+
+  const Frame & output() const
+  {
+    return m_output;
+  }
+
+private:
+  voxel_grid::VoxelGrid<voxel_grid::ApproximateVoxel<PointXYZIF>, voxel_grid::FlatVoxelStorage>
+  m_grid;
+  Frame m_output{};
+};
+
+sensor_msgs::msg::PointCloud2 to_cloud(const Frame & frame)
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> modifier{cloud, "base_link"};
+  modifier.reserve(frame.size());
+  for (const auto & pt : frame) {
+    modifier.push_back(PointXYZI{pt.x, pt.y, pt.z, pt.intensity});
+  }
+  return cloud;
+}
+
+std::size_t max_frame_size(const std::vector<Frame> & frames)
+{
+  std::size_t size = 1U;
+  for (const auto & frame : frames) {
+    size = std::max(size, frame.size());
+  }
+  return size;
+}
+
+TaskSummary run_ray_ground_classifier(const std::vector<Frame> & frames, const Options & options)
+{
+  GroundClassification classification{max_frame_size(frames)};
+  return run_task(
+    "ray_ground_classifier", frames, options.num_passes, options.num_warmup_passes,
+    [&classification](const Frame & frame) {classification(frame);});
+}
+
+TaskSummary run_euclidean_cluster(const std::vector<Frame> & frames, const Options & options)
+{
+  // Clustering runs on the nonground points, as in the lidar detection pipeline
+  std::vector<Frame> nonground_frames;
+  nonground_frames.reserve(frames.size());
+  GroundClassification classification{max_frame_size(frames)};
+  for (const auto & frame : frames) {
+    classification(frame);
+    nonground_frames.emplace_back();
+    for (const auto * const pt : classification.nonground()) {
+      nonground_frames.back().push_back(*pt);
+    }
+  }
+  const std::size_t capacity = max_frame_size(nonground_frames);
+  const euclidean_cluster::Config cfg{"base_link", 10U, 1024U, 0.5F, 1.5F, 60.0F};
+  const euclidean_cluster::HashConfig hash_cfg{-kRangeM, kRangeM, -kRangeM, kRangeM, 1.0F,
+    capacity};
+  euclidean_cluster::EuclideanCluster cls{cfg, hash_cfg, options.num_threads};
+  euclidean_cluster::Clusters clusters;
+  clusters.points.reserve(capacity);
+  clusters.cluster_boundary.reserve(cfg.max_num_clusters());
+  return run_task(
+    "euclidean_cluster", nonground_frames, options.num_passes, options.num_warmup_passes,
+    [&cls, &clusters](const Frame & frame) {
+      cls.insert(frame.begin(), frame.end());
+      cls.cluster(clusters);
+    });
+}
+
+TaskSummary run_voxel_grid(const std::vector<Frame> & frames, const Options & options)
+{
+  Downsampling downsampling{kScanVoxelSizeM, max_frame_size(frames)};
+  return run_task(
+    "voxel_grid", frames, options.num_passes, options.num_warmup_passes,
+    [&downsampling](const Frame & frame) {downsampling(frame);});
+}
+
+TaskSummary run_ndt_localizer(const std::vector<Frame> & frames, const Options & options)
+{
+  using Optimizer = optimization::NewtonsMethodOptimizer<optimization::MoreThuenteLineSearch>;
+  using Localizer = ndt::P2DNDTLocalizer<Optimizer, ndt::StaticNDTMap>;
+
+  // The first frame is the map, and the downsampled frames are registered to it
+  ndt::DynamicNDTMap dynamic_map{make_voxel_grid_config(kMapVoxelSizeM, frames.front().size())};
+  dynamic_map.insert(to_cloud(frames.front()));
+  sensor_msgs::msg::PointCloud2 serialized_map;
+  dynamic_map.serialize_as<ndt::StaticNDTMap>(serialized_map);
+  ndt::StaticNDTMap map{};
+  map.set(serialized_map);
+
+  Downsampling downsampling{kScanVoxelSizeM, max_frame_size(frames)};
+  std::vector<sensor_msgs::msg::PointCloud2> scans;
+  scans.reserve(frames.size());
+  uint32_t scan_capacity = 1U;
+  for (const auto & frame : frames) {
+    downsampling(frame);
+    scans.push_back(to_cloud(downsampling.output()));
+    scan_capacity = std::max(scan_capacity, scans.back().width);
+  }
+
+  Localizer localizer{
+    ndt::P2DNDTLocalizerConfig{
+      scan_capacity, std::chrono::milliseconds{5}, static_cast<uint32_t>(options.num_threads)},
+    Optimizer{
+      optimization::MoreThuenteLineSearch{
+        0.12F, 0.0001F, optimization::MoreThuenteLineSearch::OptimizationDirection::kMaximization},
+      optimization::OptimizationOptions{50U, 0.001, 0.001, 0.001}},
+    0.55};
+  Localizer::Transform guess{};
+  guess.transform.rotation.w = 1.0;
+  std::size_t num_failures = 0U;
+  const auto summary = run_task(
+    "ndt_localizer", scans, options.num_passes, options.num_warmup_passes,
+    [&localizer, &guess, &map, &num_failures](const sensor_msgs::msg::PointCloud2 & scan) {
+      try {
+        (void)localizer.register_measurement(scan, guess, map);
+      } catch (const std::runtime_error &) {
+        // Numerical failures of the optimizer take as long as they take, they are still measured
+        ++num_failures;
+      }
+    });
+  if (num_failures > 0U) {
+    std::cerr << "ndt_localizer: " << num_failures << " registrations failed" << std::endl;
+  }
+  return summary;
+}
+
+std::size_t get_size_option(
+  char8_t ** const begin, char8_t ** const end, const char8_t * const option,
+  const std::size_t default_value)
+{
+  const char8_t * const arg = rcutils_cli_get_option(begin, end, option);
+  return (nullptr != arg) ? static_cast<std::size_t>(std::stoul(arg)) : default_value;
+}
+
+}  // namespace
+
+int32_t main(const int32_t argc, char8_t ** const argv)
+{
+  char8_t ** const args_end = &argv[argc];
+  if (rcutils_cli_option_exist(argv, args_end, "-h") ||
+    rcutils_cli_option_exist(argv, args_end, "--help"))
+  {
+    std::cout << "benchmark_tool_native_exe [OPTION VALUE [...]]" << std::endl;
+    std::cout << "Runs the algorithm libraries on frames in memory and prints JSON" << std::endl;
+    std::cout << "--kitti\tDirectory of KITTI velodyne .bin files\t" <<
+      "Default=synthetic frames" << std::endl;
+    std::cout << "--frames\tMaximum number of frames\tDefault=100" << std::endl;
+    std::cout << "--passes\tMeasured passes over the frames\tDefault=5" << std::endl;
+    std::cout << "--warmup\tPasses over the frames before the measured ones\tDefault=1" <<
+      std::endl;
+    std::cout << "--threads\tThreads of the algorithms that take a number\tDefault=1" <<
+      std::endl;
+    std::cout << "--output\tFile to write the JSON to\tDefault=standard output" << std::endl;
+    return 0;
+  }
+
+  int32_t ret = 0;
+  try {
+    Options options{};
+    const char8_t * arg = rcutils_cli_get_option(argv, args_end, "--kitti");
+    if (nullptr != arg) {
+      options.kitti_directory = arg;
+    }
+    options.max_frames = get_size_option(argv, args_end, "--frames", options.max_frames);
+    options.num_passes = get_size_option(argv, args_end, "--passes", options.num_passes);
+    options.num_warmup_passes =
+      get_size_option(argv, args_end, "--warmup", options.num_warmup_passes);
+    options.num_threads = get_size_option(argv, args_end, "--threads", options.num_threads);
+    arg = rcutils_cli_get_option(argv, args_end, "--output");
+    if (nullptr != arg) {
+      options.output = arg;
+    }
+
+    namespace bench = autoware::tools::benchmark_tool_native;
+    const auto frames = options.kitti_directory.empty() ?
+      bench::make_synthetic_frames(options.max_frames, 100000U, kSensorHeightM, 42U) :
+      bench::load_kitti_frames(options.kitti_directory, options.max_frames);
+    if (frames.empty()) {
+      throw std::runtime_error{"No frames to run the benchmark on"};
+    }
+
+    const std::vector<TaskSummary> summaries{
+      run_ray_ground_classifier(frames, options),
+      run_euclidean_cluster(frames, options),
+      run_voxel_grid(frames, options),
+      run_ndt_localizer(frames, options)};
+
+    if (options.output.empty()) {
+      bench::write_json(std::cout, summaries);
+    } else {
+      std::ofstream file{options.output};
+      bench::write_json(file, summaries);
+    }
+  } catch (const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    ret = 2;
+  } catch (...) {
+    std::cerr << "Unknown error encountered, exiting..." << std::endl;
+    ret = -1;
+  }
+  return ret;
+}
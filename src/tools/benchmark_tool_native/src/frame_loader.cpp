@@ -0,0 +1,145 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark_tool_native/frame_loader.hpp"
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace autoware
+{
+namespace tools
+{
+namespace benchmark_tool_native
+{
+
+using common::types::float32_t;
+using common::types::PointXYZIF;
+
+namespace
+{
+// x, y, z and reflectance
+constexpr std::size_t kKittiPointSize = 4U * sizeof(float32_t);
+
+bool ends_with(const std::string & str, const std::string & suffix)
+{
+  return (str.size() >= suffix.size()) &&
+         (str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+}  // namespace
+
+Frame load_kitti_frame(const std::string & path)
+{
+  std::ifstream file{path, std::ios::binary | std::ios::ate};
+  if (!file) {
+    throw std::runtime_error{"load_kitti_frame: can not open " + path};
+  }
+  const auto size = static_cast<std::size_t>(file.tellg());
+  if ((size % kKittiPointSize) != 0U) {
+    throw std::runtime_error{"load_kitti_frame: " + path + " is not a whole number of points"};
+  }
+  file.seekg(0);
+  Frame frame(size / kKittiPointSize);
+  std::array<float32_t, 4U> values{};
+  for (auto & pt : frame) {
+    if (!file.read(reinterpret_cast<char *>(values.data()), kKittiPointSize)) {
+      throw std::runtime_error{"load_kitti_frame: failed to read " + path};
+    }
+    pt.x = values[0U];
+    pt.y = values[1U];
+    pt.z = values[2U];
+    pt.intensity = values[3U];
+  }
+  return frame;
+}
+
+std::vector<Frame> load_kitti_frames(const std::string & directory, const std::size_t max_frames)
+{
+  DIR * const dir = opendir(directory.c_str());
+  if (nullptr == dir) {
+    throw std::runtime_error{"load_kitti_frames: can not open " + directory};
+  }
+  std::vector<std::string> names;
+  for (const dirent * entry = readdir(dir); nullptr != entry; entry = readdir(dir)) {
+    const std::string name{entry->d_name};
+    if (ends_with(name, ".bin")) {
+      names.push_back(name);
+    }
+  }
+  (void)closedir(dir);
+  if (names.empty()) {
+    throw std::runtime_error{"load_kitti_frames: no .bin file in " + directory};
+  }
+  // KITTI names the frames by their zero padded index
+  std::sort(names.begin(), names.end());
+  names.resize(std::min(names.size(), max_frames));
+
+  std::vector<Frame> frames;
+  frames.reserve(names.size());
+  for (const auto & name : names) {
+    frames.push_back(load_kitti_frame(directory + "/" + name));
+  }
+  return frames;
+}
+
+std::vector<Frame> make_synthetic_frames(
+  const std::size_t num_frames, const std::size_t frame_size, const float32_t sensor_height_m,
+  const uint32_t seed)
+{
+  std::mt19937 generator{seed};
+  std::uniform_real_distribution<float32_t> position_distribution{-60.0F, 60.0F};
+  std::uniform_int_distribution<std::size_t> object_size_distribution{20U, 400U};
+  std::normal_distribution<float32_t> spread_distribution{0.0F, 0.5F};
+  std::uniform_real_distribution<float32_t> height_distribution{0.0F, 2.0F};
+  std::uniform_real_distribution<float32_t> intensity_distribution{0.0F, 1.0F};
+
+  std::vector<Frame> frames(num_frames);
+  for (auto & frame : frames) {
+    frame.reserve(frame_size);
+    // Most of the points of a lidar frame hit the ground
+    while (frame.size() < ((frame_size * 2U) / 3U)) {
+      PointXYZIF pt{};
+      pt.x = position_distribution(generator);
+      pt.y = position_distribution(generator);
+      pt.z = -sensor_height_m;
+      pt.intensity = intensity_distribution(generator);
+      frame.push_back(pt);
+    }
+    while (frame.size() < frame_size) {
+      const float32_t cx = position_distribution(generator);
+      const float32_t cy = position_distribution(generator);
+      const std::size_t object_size = object_size_distribution(generator);
+      for (std::size_t i = 0U; (i < object_size) && (frame.size() < frame_size); ++i) {
+        PointXYZIF pt{};
+        pt.x = cx + spread_distribution(generator);
+        pt.y = cy + spread_distribution(generator);
+        pt.z = height_distribution(generator) - sensor_height_m;
+        pt.intensity = intensity_distribution(generator);
+        frame.push_back(pt);
+      }
+    }
+  }
+  return frames;
+}
+
+}  // namespace benchmark_tool_native
+}  // namespace tools
+}  // namespace autoware
@@ -0,0 +1,135 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <benchmark_tool_native/benchmark_runner.hpp>
+#include <benchmark_tool_native/frame_loader.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using autoware::tools::benchmark_tool_native::Frame;
+using autoware::tools::benchmark_tool_native::load_kitti_frame;
+using autoware::tools::benchmark_tool_native::make_synthetic_frames;
+using autoware::tools::benchmark_tool_native::run_task;
+using autoware::tools::benchmark_tool_native::summarize;
+using autoware::tools::benchmark_tool_native::TaskSummary;
+using autoware::tools::benchmark_tool_native::write_json;
+
+TEST(TestBenchmarkRunner, Summarize)
+{
+  std::vector<std::chrono::nanoseconds> latencies;
+  // 1 to 100 us, shuffled
+  for (int64_t idx = 0; idx < 100; ++idx) {
+    latencies.push_back(std::chrono::microseconds{((idx * 37) % 100) + 1});
+  }
+  const auto summary = summarize("task", latencies, 250U);
+  EXPECT_EQ(summary.name, "task");
+  EXPECT_EQ(summary.num_frames, 100U);
+  EXPECT_EQ(summary.mean, std::chrono::nanoseconds{50500});
+  EXPECT_EQ(summary.p50, std::chrono::microseconds{50});
+  EXPECT_EQ(summary.p99, std::chrono::microseconds{99});
+  EXPECT_EQ(summary.max, std::chrono::microseconds{100});
+  EXPECT_NEAR(summary.throughput_hz, 1.0E9 / 50500.0, 1.0E-6);
+  EXPECT_DOUBLE_EQ(summary.allocations_per_frame, 2.5);
+
+  const auto single = summarize("single", {std::chrono::nanoseconds{7}}, 0U);
+  EXPECT_EQ(single.p50, std::chrono::nanoseconds{7});
+  EXPECT_EQ(single.p99, std::chrono::nanoseconds{7});
+
+  EXPECT_THROW(summarize("empty", {}, 0U), std::domain_error);
+}
+
+TEST(TestBenchmarkRunner, RunTask)
+{
+  const std::vector<int32_t> frames{1, 2, 3};
+  std::size_t num_calls = 0U;
+  const auto summary = run_task(
+    "count", frames, 2U, 1U, [&num_calls](const int32_t) {++num_calls;});
+  // The warmup pass is not measured
+  EXPECT_EQ(num_calls, 9U);
+  EXPECT_EQ(summary.num_frames, 6U);
+  EXPECT_LE(summary.p50, summary.p99);
+  EXPECT_LE(summary.p99, summary.max);
+  // The measured frames do not allocate
+  EXPECT_DOUBLE_EQ(summary.allocations_per_frame, 0.0);
+}
+
+TEST(TestBenchmarkRunner, WriteJson)
+{
+  TaskSummary summary{};
+  summary.name = "voxel_grid";
+  summary.num_frames = 2U;
+  summary.mean = std::chrono::microseconds{3};
+  summary.p50 = std::chrono::microseconds{2};
+  summary.p99 = std::chrono::microseconds{4};
+  summary.max = std::chrono::microseconds{4};
+  summary.throughput_hz = 10.0;
+  summary.allocations_per_frame = 0.5;
+  std::ostringstream stream;
+  write_json(stream, {summary, summary});
+  const std::string json = stream.str();
+  EXPECT_NE(json.find("\"name\": \"voxel_grid\""), std::string::npos);
+  EXPECT_NE(
+    json.find("\"latency_us\": {\"mean\": 3, \"p50\": 2, \"p99\": 4, \"max\": 4}"),
+    std::string::npos);
+  EXPECT_NE(json.find("\"allocations_per_frame\": 0.5"), std::string::npos);
+  EXPECT_NE(json.find("},\n    {"), std::string::npos);
+  EXPECT_EQ(json.back(), '\n');
+}
+
+TEST(TestFrameLoader, KittiFrame)
+{
+  const std::string path{"test_frame_loader.bin"};
+  {
+    std::ofstream file{path, std::ios::binary};
+    const float values[] = {1.0F, 2.0F, 3.0F, 0.5F, -1.0F, -2.0F, -3.0F, 0.25F};
+    file.write(reinterpret_cast<const char *>(values), sizeof(values));
+  }
+  const Frame frame = load_kitti_frame(path);
+  ASSERT_EQ(frame.size(), 2U);
+  EXPECT_FLOAT_EQ(frame[0U].x, 1.0F);
+  EXPECT_FLOAT_EQ(frame[0U].intensity, 0.5F);
+  EXPECT_FLOAT_EQ(frame[1U].z, -3.0F);
+  EXPECT_FLOAT_EQ(frame[1U].intensity, 0.25F);
+
+  // Not a whole number of points
+  {
+    std::ofstream file{path, std::ios::binary | std::ios::app};
+    file.put('x');
+  }
+  EXPECT_THROW(load_kitti_frame(path), std::runtime_error);
+  (void)std::remove(path.c_str());
+  EXPECT_THROW(load_kitti_frame(path), std::runtime_error);
+}
+
+TEST(TestFrameLoader, SyntheticFrames)
+{
+  const auto frames = make_synthetic_frames(3U, 1000U, 1.5F, 42U);
+  ASSERT_EQ(frames.size(), 3U);
+  for (const auto & frame : frames) {
+    EXPECT_EQ(frame.size(), 1000U);
+    for (const auto & pt : frame) {
+      EXPECT_GE(pt.z, -1.5F);
+    }
+  }
+  // Reproducible for the same seed
+  const auto same_frames = make_synthetic_frames(3U, 1000U, 1.5F, 42U);
+  EXPECT_EQ(frames[2U], same_frames[2U]);
+}
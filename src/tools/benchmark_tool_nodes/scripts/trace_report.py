@@ -0,0 +1,125 @@
+#! /usr/bin/env python3
+#
+# Copyright (c) 2021, Arm Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Report the latency of each stage of the stack from the trace files of time_utils::Tracer.
+
+Every traced node writes a trace_<pid>.csv file to the directory given by AUTOWARE_TRACE_DIR.
+The events of all files are grouped by the stamp of the sensor data they processed, so that
+the latency of a stage is measured from the time the data was captured.
+"""
+
+import argparse
+import collections
+import csv
+import glob
+import os
+import sys
+
+
+def read_events(paths):
+    """Return a list of (tracepoint, source_stamp_ns, enter_ns, exit_ns) and the dropped count."""
+    events = []
+    dropped = 0
+    for path in paths:
+        with open(path) as trace_file:
+            lines = []
+            for line in trace_file:
+                if line.startswith('#'):
+                    # '# recorded N, dropped M, capacity C'
+                    for field in line[1:].split(','):
+                        name, _, value = field.strip().partition(' ')
+                        if name == 'dropped':
+                            dropped += int(value)
+                else:
+                    lines.append(line)
+            for row in csv.DictReader(lines):
+                source_stamp = int(row['source_stamp_ns'])
+                if source_stamp == 0:
+                    # No sensor data was processed yet
+                    continue
+                events.append((row['tracepoint'], source_stamp,
+                               int(row['enter_ns']), int(row['exit_ns'])))
+    return events, dropped
+
+
+def percentile(sorted_values, fraction):
+    if not sorted_values:
+        return float('nan')
+    index = min(int(fraction * len(sorted_values)), len(sorted_values) - 1)
+    return sorted_values[index]
+
+
+def format_row(name, values):
+    values = sorted(values)
+    return '{:<60} {:>8} {:>10.3f} {:>10.3f} {:>10.3f}'.format(
+        name, len(values), percentile(values, 0.5) * 1.0E-6,
+        percentile(values, 0.99) * 1.0E-6, values[-1] * 1.0E-6)
+
+
+def print_table(title, rows):
+    print(title)
+    print('{:<60} {:>8} {:>10} {:>10} {:>10}'.format('', 'count', 'p50 [ms]', 'p99 [ms]',
+                                                     'max [ms]'))
+    for name, values in rows:
+        if values:
+            print(format_row(name, values))
+    print()
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('paths', nargs='+',
+                        help='trace files, or directories containing trace_*.csv files')
+    args = parser.parse_args(argv)
+
+    paths = []
+    for path in args.paths:
+        if os.path.isdir(path):
+            paths.extend(sorted(glob.glob(os.path.join(path, 'trace_*.csv'))))
+        else:
+            paths.append(path)
+    events, dropped = read_events(paths)
+    if not events:
+        print('No trace events found')
+        return 1
+    if dropped > 0:
+        print('{} events were dropped, increase AUTOWARE_TRACE_CAPACITY'.format(dropped))
+
+    queue = collections.defaultdict(list)
+    processing = collections.defaultdict(list)
+    since_source = collections.defaultdict(list)
+    last_exit = {}
+    for tracepoint, source_stamp, enter, exit_ in events:
+        queue[tracepoint].append(enter - source_stamp)
+        processing[tracepoint].append(exit_ - enter)
+        since_source[tracepoint].append(exit_ - source_stamp)
+        last_exit[source_stamp] = max(last_exit.get(source_stamp, exit_), exit_)
+    # Order the tracepoints by when they start after the source stamp, which is the order of the
+    # stages of the pipeline
+    order = sorted(queue, key=lambda name: percentile(sorted(queue[name]), 0.5))
+
+    print_table('Time from the source stamp until the stage starts',
+                [(name, queue[name]) for name in order])
+    print_table('Time spent in the stage', [(name, processing[name]) for name in order])
+    print_table('Time from the source stamp until the stage is done',
+                [(name, since_source[name]) for name in order])
+    print_table('End to end, until the last stage is done',
+                [('all', [exit_ - stamp for stamp, exit_ in last_exit.items()])])
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -17,8 +17,9 @@
 #include <cluster_projection_node/cluster_projection_node.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <time_utils/time_utils.hpp>
-#include <tracking/greedy_roi_associator.hpp>  // For the shape transformer
+#include <tracking/projection.hpp>
 #include <string>
+#include <vector>
 
 namespace autoware
 {
@@ -59,33 +60,43 @@ void ClusterProjectionNode::cluster_callback(
   projections.header = objects_msg->header;
   projections.header.frame_id = m_camera_frame;
 
+  // The vertices of object i are in the columns [vertex_begin[i], vertex_begin[i + 1])
+  std::vector<std::size_t> vertex_begin{0U};
   for (const auto & object : objects_msg->objects) {
-    try {
-      const auto tf = m_buffer.lookupTransform(
-        m_camera_frame, objects_msg->header.frame_id,
-        time_utils::from_message(objects_msg->header.stamp));
+    vertex_begin.push_back(vertex_begin.back() + 2U * object.shape.polygon.points.size());
+  }
+  perception::tracking::CameraModel::EigPoints vertices{
+    3, static_cast<Eigen::Index>(vertex_begin.back())};
+  for (std::size_t object_idx = 0U; object_idx < objects_msg->objects.size(); ++object_idx) {
+    const auto & object = objects_msg->objects[object_idx];
+    perception::tracking::set_shape_vertices(
+      object.shape, object.kinematics.centroid_position, object.kinematics.orientation,
+      vertex_begin[object_idx], vertices);
+  }
 
-      autoware_auto_msgs::msg::ClassifiedRoi projection_roi;
+  try {
+    const auto tf = m_buffer.lookupTransform(
+      m_camera_frame, objects_msg->header.frame_id,
+      time_utils::from_message(objects_msg->header.stamp));
 
-      perception::tracking::details::ShapeTransformer transformer{tf.transform};
-      const auto projected_pts = m_camera_model.project(
-        transformer(
-          object.shape, object
-          .kinematics.centroid_position, object.kinematics.orientation));
+    // All objects are projected with one matrix multiplication
+    const auto projected_shapes = m_camera_model.project_shapes(
+      perception::tracking::to_affine(tf.transform), vertices, vertex_begin);
 
+    projections.rois.reserve(projected_shapes.size());
+    for (const auto & projected_pts : projected_shapes) {
       if (!projected_pts) {
         RCLCPP_DEBUG(get_logger(), "could not project an object's shape.");
         continue;
       }
-      std::copy(
-        projected_pts->shape.begin(), projected_pts->shape.end(),
-        std::back_inserter(projection_roi.polygon.points));
-      projections.rois.emplace_back(projection_roi);
-    } catch (const std::exception & e) {
-      RCLCPP_WARN(
-        get_logger(), "Couldn't get the transform with error: " +
-        std::string{e.what()});
+      projections.rois.emplace_back();
+      auto & points = projections.rois.back().polygon.points;
+      points.assign(projected_pts->shape.begin(), projected_pts->shape.end());
     }
+  } catch (const std::exception & e) {
+    RCLCPP_WARN(
+      get_logger(), "Couldn't get the transform with error: " +
+      std::string{e.what()});
   }
   m_projection_pub->publish(projections);
 }
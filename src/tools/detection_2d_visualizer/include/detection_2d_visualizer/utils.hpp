@@ -21,6 +21,7 @@
 #ifndef DETECTION_2D_VISUALIZER__UTILS_HPP_
 #define DETECTION_2D_VISUALIZER__UTILS_HPP_
 
+#include <autoware_auto_msgs/msg/classified_roi_array.hpp>
 #include <cv_bridge/cv_bridge.h>
 #include <detection_2d_visualizer/visibility_control.hpp>
 #include <geometry_msgs/msg/polygon.hpp>
@@ -33,6 +34,11 @@ namespace detection_2d_visualizer
 void DETECTION_2D_VISUALIZER_PUBLIC draw_shape(
   cv_bridge::CvImagePtr & image_ptr, const geometry_msgs::msg::Polygon & polygon,
   const cv::Scalar & color, std::int32_t thickness);
+
+/// \brief Draw the outlines of all ROIs of an array on the image with a single call to OpenCV
+void DETECTION_2D_VISUALIZER_PUBLIC draw_shapes(
+  cv_bridge::CvImagePtr & image_ptr, const autoware_auto_msgs::msg::ClassifiedRoiArray & rois,
+  const cv::Scalar & color, std::int32_t thickness);
 }  // namespace detection_2d_visualizer
 }  // namespace autoware
 
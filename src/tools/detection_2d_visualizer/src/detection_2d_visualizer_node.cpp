@@ -66,13 +66,8 @@ void Detection2dVisualizerNode::process(
     return;
   }
 
-  for (const auto & rect : roi_msg->rois) {
-    draw_shape(cv_img_ptr, rect.polygon, ground_truth_color, thickness);
-  }
-
-  for (const auto & rect : projection_msg->rois) {
-    draw_shape(cv_img_ptr, rect.polygon, projection_color, thickness);
-  }
+  draw_shapes(cv_img_ptr, *roi_msg, ground_truth_color, thickness);
+  draw_shapes(cv_img_ptr, *projection_msg, projection_color, thickness);
 
   m_image_pub->publish(*(cv_img_ptr->toImageMsg()));
 }
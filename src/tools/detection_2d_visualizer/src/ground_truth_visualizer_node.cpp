@@ -56,9 +56,7 @@ void GroundTruthVisualizerNode::process(
     return;
   }
   if (!cv_img_ptr) {return;}
-  for (const auto & rect : roi_msg->rois) {
-    draw_shape(cv_img_ptr, rect.polygon, color, thickness);
-  }
+  draw_shapes(cv_img_ptr, *roi_msg, color, thickness);
   m_image_pub->publish(*(cv_img_ptr->toImageMsg()));
 }
 
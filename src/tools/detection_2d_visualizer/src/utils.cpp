@@ -33,5 +33,22 @@ void  draw_shape(
   }
   cv::polylines(image_ptr->image, pts, is_polyline_closed, color, thickness);
 }
+
+void draw_shapes(
+  cv_bridge::CvImagePtr & image_ptr, const autoware_auto_msgs::msg::ClassifiedRoiArray & rois,
+  const cv::Scalar & color, const std::int32_t thickness)
+{
+  std::vector<std::vector<cv::Point>> shapes(rois.rois.size());
+  constexpr auto is_polyline_closed = true;
+  for (std::size_t i = 0U; i < rois.rois.size(); ++i) {
+    auto & pts = shapes[i];
+    const auto & polygon = rois.rois[i].polygon;
+    pts.reserve(polygon.points.size());
+    for (const auto & pt : polygon.points) {
+      pts.emplace_back(static_cast<std::int32_t>(pt.x), static_cast<std::int32_t>(pt.y));
+    }
+  }
+  cv::polylines(image_ptr->image, shapes, is_polyline_closed, color, thickness);
+}
 }  // namespace detection_2d_visualizer
 }  // namespace autoware
@@ -27,6 +27,7 @@
 #include <rclcpp/subscription.hpp>
 #include <sensor_msgs/msg/nav_sat_fix.hpp>
 
+#include <Eigen/Core>
 #include <GeographicLib/Geocentric.hpp>
 
 #include <tf2/buffer_core.h>
@@ -73,6 +74,16 @@ private:
   rclcpp::Subscription<sensor_msgs::msg::NavSatFix>::SharedPtr m_gnss_nav_fix_subscription{};
   /// Covariances to set in the output message as a diagonal.
   std::vector<common::types::float64_t> m_override_variances_diagonal{};
+  /// The covariance set in the output messages, computed from the variances.
+  Eigen::Matrix3d m_override_covariance{Eigen::Matrix3d::Zero()};
+
+  /// Whether the transform from "earth" to the output frame is looked up once, as it is static.
+  bool m_cache_transform{false};
+  /// Whether the transform below is the cached one.
+  mutable bool m_has_cached_transform{false};
+  /// The last transform from "earth" to the output frame.
+  mutable Eigen::Matrix3d m_rotation__frame_id__earth{Eigen::Matrix3d::Identity()};
+  mutable Eigen::Vector3d m_translation__frame_id__earth{Eigen::Vector3d::Zero()};
 
   /// A converter used for performing the actual conversions.
   GeographicLib::Geocentric m_wgs84_to_ecef_convertor{};
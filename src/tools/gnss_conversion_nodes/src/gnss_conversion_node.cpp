@@ -41,62 +41,29 @@ static constexpr auto kFrameIdTag = "output_frame_id";
 static constexpr auto kChildFrameIdTag = "child_frame_id";
 static constexpr auto kDefaultChildFrameIdTag = "base_link";
 static constexpr auto kOverrideCovarianceTag = "override_variances";
+static constexpr auto kCacheTransformTag = "cache_transform";
 static constexpr auto kDefaultFrameId = "earth";
 static constexpr auto kDefaultLoggingInterval = 1000;  // Milliseconds.
 
 using autoware_auto_msgs::msg::RelativePositionWithCovarianceStamped;
 
-template<typename ArrayT>
-Eigen::Matrix3d to_eigen(const ArrayT & covariance)
-{
-  if (covariance.size() < 9UL) {
-    throw std::domain_error(
-            "The array representing the covariance matrix does not have enough elements. "
-            "Expected " + std::to_string(9UL) + " but has " + std::to_string(covariance.size()));
-  }
-  return Eigen::Matrix3d{Eigen::Map<const Eigen::Matrix3d>{&covariance[0]}};
-}
-
-template<typename ArrayT>
-void fill_covariance_from_eigen(ArrayT & covariance, const Eigen::Matrix3d & matrix)
-{
-  if (covariance.size() < 9UL) {
-    throw std::domain_error(
-            "The array representing the covariance matrix does not have enough elements. "
-            "Expected " + std::to_string(9UL) + " but has " + std::to_string(covariance.size()));
-  }
-  Eigen::Map<Eigen::Matrix3d>{&covariance[0]} = matrix;
-}
-
-Eigen::Matrix3d rotate_covariance(
-  const Eigen::Isometry3d & tf__new__old,
-  const Eigen::Matrix3d & covariance)
-{
-  return tf__new__old.rotation() * covariance * tf__new__old.rotation().transpose();
-}
-
 geometry_msgs::msg::Point to_point(const Eigen::Vector3d & v)
 {
   return geometry_msgs::build<geometry_msgs::msg::Point>().x(v[0]).y(v[1]).z(v[2]);
 }
 
 
-void switch_frames_if_needed(
+void switch_frames(
   autoware_auto_msgs::msg::RelativePositionWithCovarianceStamped & msg,
   const std_msgs::msg::Header::_frame_id_type & new_frame_id,
-  const tf2::BufferCore & buffer)
+  const Eigen::Matrix3d & rotation__new_frame_id__msg_frame_id,
+  const Eigen::Vector3d & translation__new_frame_id__msg_frame_id)
 {
-  if (new_frame_id == msg.header.frame_id) {return;}
-  const Eigen::Isometry3d tf__new_frame_id__msg_frame_id = tf2::transformToEigen(
-    buffer.lookupTransform(
-      new_frame_id, msg.header.frame_id, tf2_ros::fromMsg(msg.header.stamp)));
   Eigen::Vector3d position;
   tf2::fromMsg(msg.position, position);
-  msg.position = to_point(tf__new_frame_id__msg_frame_id * position);
-
-  // Update position covariance
-  fill_covariance_from_eigen(
-    msg.covariance, rotate_covariance(tf__new_frame_id__msg_frame_id, to_eigen(msg.covariance)));
+  msg.position = to_point(
+    rotation__new_frame_id__msg_frame_id * position + translation__new_frame_id__msg_frame_id);
+  // The covariance is set in the new frame afterwards, so it is not rotated
   msg.header.frame_id = new_frame_id;
 }
 
@@ -130,6 +97,10 @@ GnssConversionNode::GnssConversionNode(const rclcpp::NodeOptions & options)
   if (m_override_variances_diagonal.size() != 3UL) {
     throw std::runtime_error("Override covariance must have exactly 3 entries.");
   }
+  m_override_covariance =
+    Eigen::Map<const Eigen::Vector3d>{m_override_variances_diagonal.data()}.array().square().
+    matrix().asDiagonal();
+  m_cache_transform = declare_parameter(kCacheTransformTag, false);
 }
 
 void GnssConversionNode::nav_sat_fix_callback(
@@ -150,27 +121,32 @@ void GnssConversionNode::nav_sat_fix_callback(
   m_wgs84_to_ecef_convertor.Forward(
     msg->latitude, msg->longitude, msg->altitude,
     out_msg.position.x, out_msg.position.y, out_msg.position.z);
-  try {
-    switch_frames_if_needed(out_msg, m_frame_id, m_tf_buffer);
-  } catch (const tf2::LookupException & exception) {
-    RCLCPP_WARN_THROTTLE(
-      get_logger(),
-      m_steady_clock,
-      kDefaultLoggingInterval,
-      "Skipping publishing of a GNSS pose message.\n"
-      "Could not look up transformation between " +
-      out_msg.header.frame_id + " and " +
-      m_frame_id + " with the exception: " + exception.what());
-    return;
-  }
-  if (!m_override_variances_diagonal.empty()) {
-    const Eigen::Vector3d variances_diagonal{
-      Eigen::Map<const Eigen::Vector3d>{m_override_variances_diagonal.data()}};
-    const auto override_covariance = variances_diagonal.array().square().matrix().asDiagonal();
-    auto pose_covariance = Eigen::Map<Eigen::Matrix3d>{&out_msg.covariance.front()};
-    pose_covariance.topLeftCorner(
-      override_covariance.rows(), override_covariance.cols()) = override_covariance;
+  if (m_frame_id != out_msg.header.frame_id) {
+    if (!m_has_cached_transform) {
+      try {
+        // The latest transform is cached, which is the static one if it comes from /tf_static
+        const Eigen::Isometry3d tf__frame_id__earth = tf2::transformToEigen(
+          m_tf_buffer.lookupTransform(
+            m_frame_id, out_msg.header.frame_id,
+            m_cache_transform ? tf2::TimePointZero : tf2_ros::fromMsg(msg->header.stamp)));
+        m_rotation__frame_id__earth = tf__frame_id__earth.rotation();
+        m_translation__frame_id__earth = tf__frame_id__earth.translation();
+      } catch (const tf2::LookupException & exception) {
+        RCLCPP_WARN_THROTTLE(
+          get_logger(),
+          m_steady_clock,
+          kDefaultLoggingInterval,
+          "Skipping publishing of a GNSS pose message.\n"
+          "Could not look up transformation between " +
+          out_msg.header.frame_id + " and " +
+          m_frame_id + " with the exception: " + exception.what());
+        return;
+      }
+      m_has_cached_transform = m_cache_transform;
+    }
+    switch_frames(out_msg, m_frame_id, m_rotation__frame_id__earth, m_translation__frame_id__earth);
   }
+  Eigen::Map<Eigen::Matrix3d>{&out_msg.covariance.front()} = m_override_covariance;
   m_publisher->publish(out_msg);
 }
 
@@ -187,6 +187,68 @@ TEST_F(TestGnssConversionNode, PublishAndReceiveMsgConvertToEnu) {
 }
 
 
+/// @test Test that with cache_transform the transformation is only looked up once.
+TEST_F(TestGnssConversionNode, PublishAndReceiveMsgWithCachedTransform) {
+  sensor_msgs::msg::NavSatFix msg{};
+  msg.header.stamp.set__sec(42).set__nanosec(42);
+  msg.header.frame_id = "fix";
+  msg.position_covariance_type = msg.COVARIANCE_TYPE_DIAGONAL_KNOWN;
+  msg.status.status = msg.status.STATUS_FIX;
+  msg.position_covariance = std::array<autoware::common::types::float64_t, 9UL>{};
+  // Coordinate of the Hofbraeuhaus in Munich.
+  msg.longitude = 11.5777366;
+  msg.latitude = 48.1376098;
+  msg.altitude = 515.0;  // Meters above sea level;
+
+  rclcpp::NodeOptions node_options{};
+  const std::vector<autoware::common::types::float64_t> override_variances{1.0, 2.0, 3.0};
+  node_options.append_parameter_override("override_variances", override_variances);
+  node_options.append_parameter_override("output_frame_id", "map");
+  node_options.append_parameter_override("cache_transform", true);
+  const auto node{std::make_shared<GnssConversionNode>(node_options)};
+  node->tf_buffer().setTransform(get_tf__ecef__enu(msg, "map", "earth"), "test_node", true);
+
+  RelativePositionWithCovarianceStamped::SharedPtr last_msg{};
+  auto publisher = create_publisher<sensor_msgs::msg::NavSatFix>("wgs84_position");
+  auto subscription = create_subscription<RelativePositionWithCovarianceStamped>(
+    "gnss_position", *node,
+    [&last_msg](
+      const RelativePositionWithCovarianceStamped::SharedPtr received_msg) {
+      last_msg = received_msg;
+    });
+
+  const auto receive = [&]() {
+      last_msg.reset();
+      const auto dt{std::chrono::milliseconds{100LL}};
+      const auto max_wait_time{std::chrono::seconds{10LL}};
+      auto time_passed{std::chrono::milliseconds{0LL}};
+      while (!last_msg) {
+        publisher->publish(msg);
+        rclcpp::spin_some(node);
+        rclcpp::spin_some(get_fake_node());
+        std::this_thread::sleep_for(dt);
+        time_passed += dt;
+        if (time_passed > max_wait_time) {
+          return false;
+        }
+      }
+      return true;
+    };
+  ASSERT_TRUE(receive()) << "Did not receive a message soon enough.";
+  EXPECT_EQ("map", last_msg->header.frame_id);
+  EXPECT_NEAR(last_msg->position.x, 0.0, 1.0);
+
+  // Changing the transformation afterwards does not change the output
+  auto moved_tf = get_tf__ecef__enu(msg, "map", "earth");
+  moved_tf.transform.translation.x += 100.0;
+  node->tf_buffer().setTransform(moved_tf, "test_node", true);
+  ASSERT_TRUE(receive()) << "Did not receive a message soon enough.";
+  EXPECT_NEAR(last_msg->position.x, 0.0, 1.0);
+  EXPECT_NEAR(last_msg->position.y, 0.0, 1.0);
+  EXPECT_NEAR(last_msg->position.z, 0.0, 1.0);
+  EXPECT_DOUBLE_EQ(override_variances[0] * override_variances[0], last_msg->covariance[0]);
+}
+
 /// @test Test that when there is no fix the message is not converted.
 TEST_F(TestGnssConversionNode, NoConversionWhenNoGnssFix) {
   sensor_msgs::msg::NavSatFix msg{};
@@ -29,7 +29,10 @@
 #include <std_msgs/msg/u_int8.hpp>
 #include <common/types.hpp>
 
+#include <array>
 #include <map>
+#include <utility>
+#include <vector>
 
 using autoware::common::types::bool8_t;
 
@@ -48,6 +51,9 @@ enum class Axes
   VELOCITY  ///< For nomal control
 };
 
+/// The number of Axes
+static constexpr std::size_t NUM_AXES = static_cast<std::size_t>(Axes::VELOCITY) + 1U;
+
 /// Discretely varying control commands; not all of VehicleStateCommand is here
 enum class Buttons
 {
@@ -127,10 +133,18 @@ private:
   using BasicControl = autoware_auto_msgs::msg::VehicleControlCommand;
   using RawControl = autoware_auto_msgs::msg::RawControlCommand;
 
-  AxisMap m_axis_map{};
-  AxisScaleMap m_axis_scale_map{};
-  AxisScaleMap m_axis_offset_map{};
-  ButtonMap m_button_map{};
+  /// The mapping of an axis, compiled from the maps so that no map is searched per message
+  struct AxisMapping
+  {
+    bool8_t mapped{false};
+    AxisMap::mapped_type index{0U};
+    AxisValue scale{DEFAULT_SCALE};
+    AxisValue offset{DEFAULT_OFFSET};
+  };
+
+  std::array<AxisMapping, NUM_AXES> m_axes{};
+  /// The mapped buttons in the order of the button map
+  std::vector<std::pair<Buttons, ButtonMap::mapped_type>> m_buttons{};
   bool8_t m_autonomous{false};
   bool8_t m_wipers_on{false};
   bool8_t m_headlights_on{false};
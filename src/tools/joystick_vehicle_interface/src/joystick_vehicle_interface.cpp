@@ -23,10 +23,18 @@ JoystickVehicleInterface::JoystickVehicleInterface(
   const AxisScaleMap & axis_offset_map,
   const ButtonMap & button_map)
 {
-  m_axis_map = axis_map;
-  m_axis_scale_map = axis_scale_map;
-  m_axis_offset_map = axis_offset_map;
-  m_button_map = button_map;
+  for (const auto & axis_idx : axis_map) {
+    auto & mapping = m_axes[static_cast<std::size_t>(axis_idx.first)];
+    mapping.mapped = true;
+    mapping.index = axis_idx.second;
+  }
+  for (const auto & axis_scale : axis_scale_map) {
+    m_axes[static_cast<std::size_t>(axis_scale.first)].scale = axis_scale.second;
+  }
+  for (const auto & axis_offset : axis_offset_map) {
+    m_axes[static_cast<std::size_t>(axis_offset.first)].offset = axis_offset.second;
+  }
+  m_buttons.assign(button_map.begin(), button_map.end());
 }
 
 template<typename T>
@@ -34,21 +42,13 @@ void JoystickVehicleInterface::axis_value(
   const sensor_msgs::msg::Joy & msg,
   Axes axis, T & value) const
 {
-  const auto axis_it = m_axis_map.find(axis);
-  if (m_axis_map.end() == axis_it) {
-    return;
-  }
-  const auto axis_idx = axis_it->second;
-  if (axis_idx >= msg.axes.size()) {
+  const auto & mapping = m_axes[static_cast<std::size_t>(axis)];
+  if (!mapping.mapped || (mapping.index >= msg.axes.size())) {
     return;
   }
-  const auto scale_it = m_axis_scale_map.find(axis);
-  const auto scale = m_axis_scale_map.end() == scale_it ? DEFAULT_SCALE : scale_it->second;
-  const auto val_raw = msg.axes[axis_idx] * scale;
-  const auto offset_it = m_axis_offset_map.find(axis);
-  const auto offset = m_axis_offset_map.end() == offset_it ? DEFAULT_OFFSET : offset_it->second;
+  const auto val_raw = msg.axes[mapping.index] * mapping.scale;
   using ValT = std::decay_t<decltype(value)>;
-  value = static_cast<ValT>(val_raw + offset);
+  value = static_cast<ValT>(val_raw + mapping.offset);
 }
 
 template<>
@@ -97,7 +97,7 @@ bool8_t JoystickVehicleInterface::update_state_command(const sensor_msgs::msg::J
   auto ret = false;
   m_state_command = decltype(m_state_command) {};
   m_state_command.stamp = msg.header.stamp;
-  for (const auto & button_idx : m_button_map) {
+  for (const auto & button_idx : m_buttons) {
     const auto idx = button_idx.second;
     // Check if button is in range and active
     if (idx < msg.buttons.size()) {
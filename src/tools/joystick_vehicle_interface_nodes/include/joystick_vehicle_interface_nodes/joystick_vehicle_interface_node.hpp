@@ -70,6 +70,8 @@ private:
   using ControlPub = mpark::variant<PubT<RawControl>, PubT<BasicControl>, PubT<HighLevelControl>>;
 
   ControlPub m_cmd_pub{};
+  /// Whether the commands are published to the subscriptions in the process without DDS
+  bool8_t m_intra_process{false};
   rclcpp::Publisher<autoware_auto_msgs::msg::VehicleStateCommand>::SharedPtr m_state_cmd_pub{};
   rclcpp::Publisher<autoware_auto_msgs::msg::HeadlightsCommand>::SharedPtr m_headlights_cmd_pub{};
   rclcpp::Publisher<std_msgs::msg::UInt8>::SharedPtr m_recordreplay_cmd_pub{};
@@ -0,0 +1,121 @@
+# Copyright 2021 the Autoware Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Launch the joystick translator and the LGSVL interface in a single process."""
+
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.actions import Node
+from launch_ros.descriptions import ComposableNode
+from ament_index_python import get_package_share_directory
+import os
+
+
+def get_share_file(package_name, file_name):
+    return os.path.join(get_package_share_directory(package_name), file_name)
+
+
+def generate_launch_description():
+    """
+    Launch a minimal joystick + LGSVL demo, with the commands handed over without DDS.
+
+    The joystick translator and the LGSVL interface are composed with intra-process communication,
+    so that a control command is passed to the interface as a pointer instead of through the
+    middleware.
+    """
+    # --------------------------------- Params -------------------------------
+
+    control_command_param = DeclareLaunchArgument(
+        'control_command',
+        default_value="raw",  # use "raw", "basic" or "high_level"
+        description='command control mode')
+
+    joy_translator_param = DeclareLaunchArgument(
+        'joy_translator_param',
+        default_value=[
+            get_share_file('joystick_vehicle_interface_nodes',
+                           'param/logitech_f310_raw.param.yaml')
+        ],
+        description='Path to config file for joystick translator')
+
+    lgsvl_interface_param = DeclareLaunchArgument(
+        'lgsvl_interface_param',
+        default_value=[
+            get_share_file('lgsvl_interface', 'param/lgsvl.param.yaml')
+        ],
+        description='Path to config file for lgsvl interface')
+
+    # -------------------------------- Nodes-----------------------------------
+
+    # joystick driver node
+    joy = Node(
+        package='joy_linux',
+        executable='joy_linux_node',
+        output='screen')
+
+    intra_process = [{'use_intra_process_comms': True}]
+    teleop_container = ComposableNodeContainer(
+        name='joystick_teleop_container',
+        namespace='vehicle',
+        package='rclcpp_components',
+        executable='component_container',
+        composable_node_descriptions=[
+            ComposableNode(
+                package='joystick_vehicle_interface_nodes',
+                plugin='joystick_vehicle_interface_nodes::JoystickVehicleInterfaceNode',
+                name='joystick_vehicle_interface_nodes',
+                namespace='',
+                parameters=[
+                    LaunchConfiguration('joy_translator_param'),
+                    {"control_command": LaunchConfiguration('control_command')}
+                ],
+                remappings=[
+                    ("joy", "/joy"),
+                    ("raw_command", "/vehicle/raw_command"),
+                    ("basic_command", "/vehicle/basic_command"),
+                    ("high_level_command", "/vehicle/high_level_command"),
+                    ("state_command", "/vehicle/state_command")
+                ],
+                extra_arguments=intra_process),
+            ComposableNode(
+                package='lgsvl_interface',
+                plugin='lgsvl_interface::LgsvlInterfaceNode',
+                name='lgsvl_interface_node',
+                namespace='vehicle',
+                parameters=[
+                    LaunchConfiguration('lgsvl_interface_param'),
+                    {"control_command": LaunchConfiguration('control_command')}
+                ],
+                remappings=[
+                    ("vehicle_control_cmd", "/lgsvl/vehicle_control_cmd"),
+                    ("vehicle_state_cmd", "/lgsvl/vehicle_state_cmd"),
+                    ("state_report", "/lgsvl/state_report"),
+                    ("state_report_out", "state_report"),
+                    ("gnss_odom", "/lgsvl/gnss_odom"),
+                    ("vehicle_odom", "/lgsvl/vehicle_odom")
+                ],
+                extra_arguments=intra_process),
+        ],
+        output='screen',
+    )
+
+    return LaunchDescription([
+        control_command_param,
+        joy_translator_param,
+        lgsvl_interface_param,
+        joy,
+        teleop_container
+    ])
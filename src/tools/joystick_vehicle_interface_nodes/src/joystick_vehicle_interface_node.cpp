@@ -31,7 +31,8 @@ namespace joystick_vehicle_interface_nodes
 
 JoystickVehicleInterfaceNode::JoystickVehicleInterfaceNode(
   const rclcpp::NodeOptions & node_options)
-: Node{"joystick_vehicle_interface_nodes", node_options}
+: Node{"joystick_vehicle_interface_nodes", node_options},
+  m_intra_process{node_options.use_intra_process_comms()}
 {
   // topics
   const auto control_command =
@@ -159,6 +160,12 @@ void JoystickVehicleInterfaceNode::on_joy(const sensor_msgs::msg::Joy::SharedPtr
   const auto compute_publish_command = [this, &msg](auto && pub) -> void {
       using MessageT =
         typename std::decay_t<decltype(pub)>::element_type::MessageUniquePtr::element_type;
+      if (m_intra_process) {
+        // The subscriptions in the same process, e.g. a composed vehicle interface, take the
+        // command without a copy
+        pub->publish(std::make_unique<MessageT>(m_core->compute_command<MessageT>(*msg)));
+        return;
+      }
       const auto cmd = m_core->compute_command<MessageT>(*msg);
       pub->publish(cmd);
     };
@@ -23,6 +23,7 @@
 #include <lidar_integration/visibility_control.hpp>
 #include <common/types.hpp>
 #include <string>
+#include <vector>
 
 namespace lidar_integration
 {
@@ -43,6 +44,8 @@ class LIDAR_INTEGRATION_PUBLIC LidarIntegrationListener : public rclcpp::Node
     std::chrono::steady_clock::time_point last_pub_time;
     uint32_t total_size;
     uint32_t count;
+    // time from the stamp of every message to its reception
+    std::vector<float32_t> latencies_ms;
   };  // struct Statistics
 
   static void init_statistics(Statistics & stats);
@@ -59,9 +62,16 @@ public:
 
   virtual bool8_t is_success() const = 0;
 
+  /// Print the rate of dropped messages with respect to the expected period, and percentiles
+  /// of the latency of the messages; for stress tests, where the period is not met anyway
+  void report_statistics() const;
+
+  /// Whether at least one message was received
+  bool8_t received_any() const {return m_stats.count > 0U;}
+
 protected:
   // Update the statistics
-  void callback(const uint32_t size);
+  void callback(const uint32_t size, const builtin_interfaces::msg::Time & stamp);
 
   bool8_t is_success(
     const rclcpp::SubscriptionBase * const sub_ptr,
@@ -0,0 +1,97 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIDAR_INTEGRATION__PACKET_REPLAY_SPOOFER_HPP_
+#define LIDAR_INTEGRATION__PACKET_REPLAY_SPOOFER_HPP_
+
+#include <common/types.hpp>
+#include <lidar_integration/visibility_control.hpp>
+#include <lidar_integration/udp_sender.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lidar_integration
+{
+using autoware::common::types::float32_t;
+using autoware::common::types::bool8_t;
+using autoware::common::types::char8_t;
+
+/// \brief UDP payload of a captured packet, with its capture time
+struct CapturedPacket
+{
+  std::chrono::nanoseconds time;
+  std::vector<uint8_t> data;
+};
+using CapturedPackets = std::vector<CapturedPacket>;
+
+/// \brief Read the UDP payloads of IPv4 packets from a pcap file, as written by tcpdump or
+///        wireshark for a sensor. Ethernet, Linux cooked and loopback captures are supported.
+/// \param[in] file_name Path of the capture
+/// \param[in] port Only keep packets sent to this port, keep all if 0
+/// \return The packets in the order of the capture, with times relative to the first packet
+/// \throw std::runtime_error If the file can't be read or is not a pcap file
+LIDAR_INTEGRATION_PUBLIC CapturedPackets load_pcap_packets(
+  const std::string & file_name,
+  const uint16_t port = 0U);
+
+/// \brief Replays captured packets to one UDP port, with the timing of the capture scaled by a
+///        rate multiplier. Packets that fall behind their schedule are sent back to back, so a
+///        high multiplier sends as fast as the socket allows.
+class LIDAR_INTEGRATION_PUBLIC PacketReplaySpoofer
+{
+public:
+  /// \param[in] ip Target ip
+  /// \param[in] port Target port
+  /// \param[in] packets Packets to replay, may be shared between several spoofers
+  /// \param[in] rate_multiplier Replay speed relative to the capture, must be positive
+  /// \param[in] loop Start again at the first packet after the last one
+  /// \throw std::domain_error If there are no packets or the rate multiplier is not positive
+  PacketReplaySpoofer(
+    const char8_t * const ip,
+    const uint16_t port,
+    const std::shared_ptr<const CapturedPackets> & packets,
+    const float32_t rate_multiplier,
+    const bool8_t loop);
+  ~PacketReplaySpoofer();
+
+  void start();
+
+  void stop();
+
+  /// Whether all packets were sent; never true when looping
+  bool8_t done() const {return m_done.load();}
+
+  /// Number of sent packets, only reliable after stop()
+  const uint32_t & send_count() const {return m_send_count;}
+
+private:
+  void task_function();
+
+  RawUdpSender m_udp_sender;
+  std::shared_ptr<const CapturedPackets> m_packets;
+  const float32_t m_rate_multiplier;
+  const bool8_t m_loop;
+  std::atomic_bool m_running;
+  std::atomic_bool m_done;
+  uint32_t m_send_count = 0U;
+  std::thread m_thread;
+};  // PacketReplaySpoofer
+
+}  // namespace lidar_integration
+#endif  // LIDAR_INTEGRATION__PACKET_REPLAY_SPOOFER_HPP_
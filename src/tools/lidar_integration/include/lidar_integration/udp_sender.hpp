@@ -24,6 +24,8 @@
 #include <stdint.h>
 #include <netinet/in.h>
 
+#include <vector>
+
 using autoware::common::types::bool8_t;
 using autoware::common::types::char8_t;
 
@@ -55,4 +57,17 @@ public:
   }
 };
 
+/// Sends packets whose size is only known at runtime, e.g. replayed from a capture
+class RawUdpSender : public UdpSenderBase
+{
+public:
+  using UdpSenderBase::UdpSenderBase;
+
+public:
+  void send(const std::vector<uint8_t> & pkt) const
+  {
+    UdpSenderBase::send(static_cast<const void *>(pkt.data()), pkt.size());
+  }
+};
+
 #endif  // LIDAR_INTEGRATION__UDP_SENDER_HPP_
@@ -15,8 +15,10 @@
 // Co-developed by Tier IV, Inc. and Apex.AI, Inc.
 
 #include <common/types.hpp>
+#include <algorithm>
 #include <cmath>
 #include <string>
+#include <vector>
 #include "lidar_integration/lidar_integration_listener.hpp"
 
 namespace lidar_integration
@@ -36,10 +38,14 @@ void LidarIntegrationListener::init_statistics(Statistics & stats)
   stats.last_pub_time = decltype(stats.last_pub_time)::max();
   stats.count = 0U;
   stats.total_size = 0U;
+  stats.latencies_ms.clear();
 }
 
-void LidarIntegrationListener::callback(const uint32_t size)
+void LidarIntegrationListener::callback(
+  const uint32_t size, const builtin_interfaces::msg::Time & stamp)
 {
+  const auto latency = now() - rclcpp::Time{stamp, get_clock()->get_clock_type()};
+  m_stats.latencies_ms.push_back(static_cast<float32_t>(latency.seconds() * 1000.0));
   if (m_stats.last_failed) {
     RCLCPP_ERROR(get_logger(), "nonterminal fail");
     m_stats.success = false;
@@ -175,6 +181,46 @@ bool8_t LidarIntegrationListener::is_success(
          has_valid_size(m_stats, m_expected_size));
 }
 
+void LidarIntegrationListener::report_statistics() const
+{
+  const auto & stats = m_stats;
+  if (stats.count < 2U) {
+    std::cout << "Received " << stats.count << " messages, no statistics" << std::endl;
+    return;
+  }
+  const float32_t sample_duration_us =
+    std::chrono::duration_cast<std::chrono::duration<float32_t, std::micro>>(
+    stats.last_pub_time - stats.first_pub_time).count();
+  // messages expected between the first and the last received one
+  const float32_t expected_count = (sample_duration_us / m_expected_period_us) + 1.0F;
+  const float32_t drop_rate =
+    std::max(0.0F, 1.0F - (static_cast<float32_t>(stats.count) / expected_count));
+
+  std::vector<float32_t> latencies_ms{stats.latencies_ms};
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+  const auto percentile = [&latencies_ms](const float32_t p) {
+      // nearest rank
+      const auto rank = static_cast<std::size_t>(
+        std::ceil(p * static_cast<float32_t>(latencies_ms.size())));
+      return static_cast<float64_t>(latencies_ms[std::max(rank, std::size_t{1U}) - 1U]);
+    };
+
+  printf("Received: %u
+", stats.count);
+  printf("Expected: %0.0f
+", static_cast<float64_t>(expected_count));
+  printf("Drop rate: %0.4f
+", static_cast<float64_t>(drop_rate));
+  printf(
+    "Latency (ms): p50 %0.2f, p90 %0.2f, p99 %0.2f, max %0.2f
+",
+    percentile(0.5F), percentile(0.9F), percentile(0.99F),
+    static_cast<float64_t>(latencies_ms.back()));
+  RCLCPP_INFO(
+    get_logger(), "Drop rate: %0.4f, latency p50: %0.2f ms, p99: %0.2f ms",
+    static_cast<float64_t>(drop_rate), percentile(0.5F), percentile(0.99F));
+}
+
 void LidarIntegrationListener::console_statistics(
   const Statistics & stat, const char8_t * src) const
 {
@@ -205,7 +251,7 @@ LidarIntegrationPclListener::LidarIntegrationPclListener(
   m_sub_ptr{create_subscription<PointCloud2>(
       topic, rclcpp::QoS(rclcpp::KeepLast(20)),
       [this](const PointCloud2::SharedPtr msg_ptr) {
-        this->callback(msg_ptr->width);
+        this->callback(msg_ptr->width, msg_ptr->header.stamp);
         RCLCPP_INFO(get_logger(), "\tdata length: %u", msg_ptr->data.size());
       })}
 {
@@ -232,7 +278,7 @@ LidarIntegrationBoxListener::LidarIntegrationBoxListener(
   m_sub_ptr{create_subscription<BoundingBoxArray>(
       topic, rclcpp::QoS(rclcpp::KeepLast(20)),
       [this](const BoundingBoxArray::SharedPtr msg_ptr) {
-        this->callback(static_cast<uint32_t>(msg_ptr->boxes.size()));
+        this->callback(static_cast<uint32_t>(msg_ptr->boxes.size()), msg_ptr->header.stamp);
       })}
 {
   RCLCPP_INFO(get_logger(), ("\tbox_topic: " + topic).c_str());
@@ -109,6 +109,9 @@ int32_t main(const int32_t argc, char8_t ** const argv)
       runtime = std::stof(arg);
     }
     help_msg << "--lifecycle_node\tif present, will assume this is a lifecycle node\t" << std::endl;
+    help_msg << "--report_only\tif present, only reports the drop rate and latency, and " <<
+      "succeeds if any message was received\t" << std::endl;
+    const bool8_t report_only = rcutils_cli_option_exist(argv, &argv[argc], "--report_only");
     const bool8_t lifecycle_node = rcutils_cli_option_exist(argv, &argv[argc], "--lifecycle_node");
     bool8_t needs_help = rcutils_cli_option_exist(argv, &argv[argc], "-h");
     needs_help = rcutils_cli_option_exist(argv, &argv[argc], "--help") || needs_help;
@@ -177,7 +180,13 @@ int32_t main(const int32_t argc, char8_t ** const argv)
     LIDAR_INTEGRATION_INFO("Listener done");
     LIDAR_INTEGRATION_INFO("Lidar integration test listener is done.");
     ret = 0;
-    if (!nd_ptr->is_success()) {
+    nd_ptr->report_statistics();
+    if (report_only) {
+      if (!nd_ptr->received_any()) {
+        ret = ret + (1 << 0U);
+        LIDAR_INTEGRATION_FATAL("failed");
+      }
+    } else if (!nd_ptr->is_success()) {
       ret = ret + (1 << 0U);
       LIDAR_INTEGRATION_FATAL("failed");
     }
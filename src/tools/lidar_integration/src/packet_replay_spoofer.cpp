@@ -0,0 +1,244 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <lidar_integration/packet_replay_spoofer.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lidar_integration
+{
+namespace
+{
+// pcap magic numbers for microsecond and nanosecond time stamps
+constexpr uint32_t PCAP_MAGIC_US = 0xA1B2C3D4U;
+constexpr uint32_t PCAP_MAGIC_NS = 0xA1B23C4DU;
+constexpr std::size_t PCAP_HEADER_SIZE = 24U;
+constexpr std::size_t PCAP_RECORD_HEADER_SIZE = 16U;
+// pcap link types
+constexpr uint32_t LINKTYPE_NULL = 0U;
+constexpr uint32_t LINKTYPE_ETHERNET = 1U;
+constexpr uint32_t LINKTYPE_RAW = 101U;
+constexpr uint32_t LINKTYPE_LINUX_SLL = 113U;
+// protocol numbers
+constexpr uint16_t ETHERTYPE_IPV4 = 0x0800U;
+constexpr uint16_t ETHERTYPE_VLAN = 0x8100U;
+constexpr uint8_t IPPROTO_UDP_NUMBER = 17U;
+constexpr std::size_t UDP_HEADER_SIZE = 8U;
+
+uint32_t swap_bytes(const uint32_t val)
+{
+  return ((val & 0xFFU) << 24U) | ((val & 0xFF00U) << 8U) | ((val >> 8U) & 0xFF00U) |
+         (val >> 24U);
+}
+
+uint32_t read_uint32(const uint8_t * const data, const bool8_t swapped)
+{
+  // pcap headers are in the byte order of the capturing machine, this is little endian
+  const uint32_t val = static_cast<uint32_t>(data[0U]) |
+    (static_cast<uint32_t>(data[1U]) << 8U) |
+    (static_cast<uint32_t>(data[2U]) << 16U) |
+    (static_cast<uint32_t>(data[3U]) << 24U);
+  return swapped ? swap_bytes(val) : val;
+}
+
+// packet headers are in network byte order
+uint16_t read_big_endian_uint16(const uint8_t * const data)
+{
+  return static_cast<uint16_t>((data[0U] << 8U) | data[1U]);
+}
+
+// Offset of the IPv4 header in a frame of the given link type, or the frame size if the frame
+// does not contain an IPv4 packet
+std::size_t ip_offset(const uint32_t link_type, const std::vector<uint8_t> & frame)
+{
+  const std::size_t invalid = frame.size();
+  switch (link_type) {
+    case LINKTYPE_NULL:
+      // protocol family in the byte order of the capturing machine, AF_INET is 2 everywhere
+      return ((frame.size() > 4U) && ((frame[0U] == 2U) || (frame[3U] == 2U))) ? 4U : invalid;
+    case LINKTYPE_ETHERNET: {
+        if (frame.size() < 14U) {
+          return invalid;
+        }
+        const uint16_t ethertype = read_big_endian_uint16(&frame[12U]);
+        if ((ethertype == ETHERTYPE_VLAN) && (frame.size() >= 18U)) {
+          return (read_big_endian_uint16(&frame[16U]) == ETHERTYPE_IPV4) ? 18U : invalid;
+        }
+        return (ethertype == ETHERTYPE_IPV4) ? 14U : invalid;
+      }
+    case LINKTYPE_RAW:
+      return 0U;
+    case LINKTYPE_LINUX_SLL:
+      return ((frame.size() >= 16U) &&
+             (read_big_endian_uint16(&frame[14U]) == ETHERTYPE_IPV4)) ? 16U : invalid;
+    default:
+      throw std::runtime_error{"Unsupported pcap link type: " + std::to_string(link_type)};
+  }
+}
+}  // namespace
+
+CapturedPackets load_pcap_packets(const std::string & file_name, const uint16_t port)
+{
+  std::ifstream file{file_name, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error{"Could not open " + file_name};
+  }
+  uint8_t header[PCAP_HEADER_SIZE];
+  if (!file.read(reinterpret_cast<char8_t *>(header), PCAP_HEADER_SIZE)) {
+    throw std::runtime_error{file_name + " is too short for a pcap file"};
+  }
+  const uint32_t magic = read_uint32(header, false);
+  const bool8_t swapped = (magic == swap_bytes(PCAP_MAGIC_US)) ||
+    (magic == swap_bytes(PCAP_MAGIC_NS));
+  const uint32_t native_magic = swapped ? swap_bytes(magic) : magic;
+  if ((native_magic != PCAP_MAGIC_US) && (native_magic != PCAP_MAGIC_NS)) {
+    throw std::runtime_error{file_name + " is not a pcap file"};
+  }
+  const uint64_t frac_to_ns = (native_magic == PCAP_MAGIC_US) ? 1000U : 1U;
+  const uint32_t link_type = read_uint32(&header[20U], swapped);
+
+  CapturedPackets ret;
+  uint8_t record[PCAP_RECORD_HEADER_SIZE];
+  std::vector<uint8_t> frame;
+  std::chrono::nanoseconds first_time{-1};
+  while (file.read(reinterpret_cast<char8_t *>(record), PCAP_RECORD_HEADER_SIZE)) {
+    const std::chrono::nanoseconds time{
+      static_cast<int64_t>(read_uint32(&record[0U], swapped)) * 1000000000LL +
+      static_cast<int64_t>(read_uint32(&record[4U], swapped) * frac_to_ns)};
+    const uint32_t captured_length = read_uint32(&record[8U], swapped);
+    frame.resize(captured_length);
+    if (!file.read(reinterpret_cast<char8_t *>(frame.data()), captured_length)) {
+      break;  // truncated capture, keep what was read so far
+    }
+
+    // IPv4 header: version and header length, fragmentation, protocol
+    const std::size_t ip = ip_offset(link_type, frame);
+    if ((ip + 20U) > frame.size()) {
+      continue;
+    }
+    const std::size_t ip_header_size = 4U * static_cast<std::size_t>(frame[ip] & 0x0FU);
+    const bool8_t fragmented = (read_big_endian_uint16(&frame[ip + 6U]) & 0x3FFFU) != 0U;
+    if (((frame[ip] >> 4U) != 4U) || (frame[ip + 9U] != IPPROTO_UDP_NUMBER) || fragmented) {
+      continue;
+    }
+    // UDP header: destination port and length
+    const std::size_t udp = ip + ip_header_size;
+    if ((udp + UDP_HEADER_SIZE) > frame.size()) {
+      continue;
+    }
+    if ((port != 0U) && (read_big_endian_uint16(&frame[udp + 2U]) != port)) {
+      continue;
+    }
+    const std::size_t udp_length = read_big_endian_uint16(&frame[udp + 4U]);
+    if (udp_length < UDP_HEADER_SIZE) {
+      continue;
+    }
+    const std::size_t payload_size =
+      std::min(udp_length - UDP_HEADER_SIZE, frame.size() - (udp + UDP_HEADER_SIZE));
+
+    if (first_time.count() < 0) {
+      first_time = time;
+    }
+    const auto payload = frame.begin() + static_cast<std::ptrdiff_t>(udp + UDP_HEADER_SIZE);
+    ret.push_back(
+      CapturedPacket{time - first_time,
+        std::vector<uint8_t>{payload, payload + static_cast<std::ptrdiff_t>(payload_size)}});
+  }
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PacketReplaySpoofer::PacketReplaySpoofer(
+  const char8_t * const ip,
+  const uint16_t port,
+  const std::shared_ptr<const CapturedPackets> & packets,
+  const float32_t rate_multiplier,
+  const bool8_t loop)
+: m_udp_sender(ip, port),
+  m_packets(packets),
+  m_rate_multiplier(rate_multiplier),
+  m_loop(loop),
+  m_running(false),
+  m_done(false)
+{
+  if ((!m_packets) || m_packets->empty()) {
+    throw std::domain_error{"PacketReplaySpoofer: no packets to replay"};
+  }
+  if (!(rate_multiplier > 0.0F)) {
+    throw std::domain_error{"PacketReplaySpoofer: rate multiplier must be positive"};
+  }
+}
+
+PacketReplaySpoofer::~PacketReplaySpoofer()
+{
+  stop();
+}
+
+void PacketReplaySpoofer::start()
+{
+  m_running.store(true);
+  m_thread = std::thread{[this] {task_function();}};
+}
+
+void PacketReplaySpoofer::stop()
+{
+  m_running.store(false);
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+void PacketReplaySpoofer::task_function()
+{
+  using std::chrono::steady_clock;
+  const auto scaled = [this](const std::chrono::nanoseconds time) {
+      return std::chrono::duration_cast<steady_clock::duration>(
+        std::chrono::duration<float32_t, std::nano>(
+          static_cast<float32_t>(time.count()) / m_rate_multiplier));
+    };
+  const CapturedPackets & packets = *m_packets;
+  // a loop takes as long as the capture plus the mean gap between two packets
+  const auto capture_duration = packets.back().time +
+    ((packets.size() > 1U) ?
+    (packets.back().time / static_cast<int64_t>(packets.size() - 1U)) :
+    std::chrono::nanoseconds{std::chrono::milliseconds{1LL}});
+
+  steady_clock::time_point loop_start = steady_clock::now();
+  std::size_t idx = 0U;
+  while (m_running.load(std::memory_order_relaxed)) {
+    const auto send_time = loop_start + scaled(packets[idx].time);
+    if (steady_clock::now() < send_time) {
+      std::this_thread::sleep_until(send_time);
+    }
+    m_udp_sender.send(packets[idx].data);
+    ++m_send_count;
+    ++idx;
+    if (idx == packets.size()) {
+      if (!m_loop) {
+        m_done.store(true);
+        break;
+      }
+      idx = 0U;
+      loop_start += scaled(capture_duration);
+    }
+  }
+}
+}  // namespace lidar_integration
@@ -0,0 +1,156 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rclcpp/rclcpp.hpp>
+#include <rcutils/cmdline_parser.h>
+#include <common/types.hpp>
+#include <lidar_integration/lidar_integration_common.hpp>
+#include <lidar_integration/packet_replay_spoofer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using autoware::common::types::float32_t;
+using autoware::common::types::float64_t;
+using autoware::common::types::bool8_t;
+using autoware::common::types::char8_t;
+
+int32_t main(const int32_t argc, char8_t ** const argv)
+{
+  using namespace std::chrono_literals;  // NOLINT
+
+  int32_t ret;
+  try {
+    rclcpp::init(argc, argv);
+
+    const char8_t * arg = rcutils_cli_get_option(argv, &argv[argc], "--pcap");
+    std::string pcap_file;
+    if (nullptr != arg) {
+      pcap_file = arg;
+    }
+    arg = rcutils_cli_get_option(argv, &argv[argc], "--filter_port");
+    uint16_t filter_port = 0U;
+    if (nullptr != arg) {
+      filter_port = static_cast<uint16_t>(std::stoul(arg));
+    }
+    arg = rcutils_cli_get_option(argv, &argv[argc], "--rate");
+    float32_t rate = 1.0F;
+    if (nullptr != arg) {
+      rate = std::stof(arg);
+    }
+    arg = rcutils_cli_get_option(argv, &argv[argc], "--num_sensors");
+    uint32_t num_sensors = 1U;
+    if (nullptr != arg) {
+      num_sensors = static_cast<uint32_t>(std::stoul(arg));
+    }
+    arg = rcutils_cli_get_option(argv, &argv[argc], "--ip");
+    const char8_t * ip = "127.0.0.1";
+    if (nullptr != arg) {
+      ip = arg;
+    }
+    arg = rcutils_cli_get_option(argv, &argv[argc], "--port");
+    uint16_t port = 5001U;
+    if (nullptr != arg) {
+      port = static_cast<uint16_t>(std::stoul(arg));
+    }
+    arg = rcutils_cli_get_option(argv, &argv[argc], "--runtime");
+    uint32_t runtime = 30U;
+    if (nullptr != arg) {
+      runtime = static_cast<uint32_t>(std::stoul(arg));
+    }
+    const bool8_t loop = rcutils_cli_option_exist(argv, &argv[argc], "--loop");
+    // help
+    bool8_t needs_help = rcutils_cli_option_exist(argv, &argv[argc], "-h");
+    needs_help = rcutils_cli_option_exist(argv, &argv[argc], "--help") || needs_help;
+    if (needs_help || pcap_file.empty()) {
+      std::cout << "packet_replay_spoofer --pcap FILE [OPTION VALUE [...]]" << std::endl;
+      std::cout << "Usage:" << std::endl;
+      std::cout << "OPTION" << std::endl;
+      std::cout << "--pcap\tCapture of the sensor packets to replay" << std::endl;
+      std::cout << "--filter_port\tOnly replay packets sent to this port, 0 for all\t" <<
+        "Default=0" << std::endl;
+      std::cout << "--rate\tReplay speed as a multiple of the captured rate\t" <<
+        "Default=1.0" << std::endl;
+      std::cout << "--num_sensors\tNumber of emulated sensors, on consecutive ports\t" <<
+        "Default=1" << std::endl;
+      std::cout << "--ip\tTarget ip of all sensors\t" <<
+        "Default=127.0.0.1" << std::endl;
+      std::cout << "--port\tTarget port of the first sensor\t" <<
+        "Default=5001" << std::endl;
+      std::cout << "--runtime\tApproximate time this executable runs for(s)\t" <<
+        "Default=30" << std::endl;
+      std::cout << "--loop\tIf present, replays the capture again when it ends" << std::endl;
+      throw std::runtime_error{"Exiting due to help"};
+    }
+
+    ret = 0;
+
+    const auto packets = std::make_shared<const lidar_integration::CapturedPackets>(
+      lidar_integration::load_pcap_packets(pcap_file, filter_port));
+    LIDAR_INTEGRATION_INFO("Loaded %zu packets from %s", packets->size(), pcap_file.c_str());
+
+    // every emulated sensor replays the same capture to its own port
+    std::vector<std::unique_ptr<lidar_integration::PacketReplaySpoofer>> spoofers;
+    for (uint32_t idx = 0U; idx < num_sensors; ++idx) {
+      spoofers.emplace_back(
+        std::make_unique<lidar_integration::PacketReplaySpoofer>(
+          ip, static_cast<uint16_t>(port + idx), packets, rate, loop));
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (auto & spoofer : spoofers) {
+      spoofer->start();
+    }
+    LIDAR_INTEGRATION_INFO("Spoofer(s) number is: %u", num_sensors);
+    // FIXME required for integration test due to buffered output
+    std::cout << "Spoofer(s) number is: " << num_sensors << ::std::endl;
+
+    const auto end = start + std::chrono::seconds(runtime);
+    while (rclcpp::ok()) {
+      const auto all_done = std::all_of(
+        spoofers.begin(), spoofers.end(), [](const auto & spoofer) {return spoofer->done();});
+      if (all_done || (end < std::chrono::steady_clock::now())) {
+        break;
+      }
+      std::this_thread::sleep_for(1ms);
+    }
+
+    LIDAR_INTEGRATION_INFO("spoofer done");
+    uint64_t total_send_count = 0U;
+    for (auto & spoofer : spoofers) {
+      spoofer->stop();
+      total_send_count += spoofer->send_count();
+    }
+    const auto elapsed_s = std::chrono::duration_cast<std::chrono::duration<float64_t>>(
+      std::chrono::steady_clock::now() - start).count();
+    std::cout << total_send_count << " replayed UDP packets were sent" << std::endl;
+    std::cout << "Achieved packet rate: " <<
+      (static_cast<float64_t>(total_send_count) / elapsed_s) << " packets/s" << std::endl;
+    LIDAR_INTEGRATION_INFO("Spoofer(s) finished.");
+  } catch (const std::runtime_error & e) {
+    LIDAR_INTEGRATION_ERROR("Got error: %s", e.what());
+    ret = 2;
+  } catch (const std::domain_error & e) {
+    LIDAR_INTEGRATION_ERROR("Got error: %s", e.what());
+    ret = 2;
+  } catch (...) {
+    LIDAR_INTEGRATION_FATAL("Unknown error occured");
+  }
+
+  return ret;
+}
@@ -24,6 +24,7 @@
 #include <common/types.hpp>
 #include <helper_functions/float_comparisons.hpp>
 #include <limits>
+#include <vector>
 #include "point_type_adapter/visibility_control.hpp"
 #include "point_cloud2_intensity_wrapper.hpp"
 
@@ -44,18 +45,57 @@ public:
   explicit PointTypeAdapterNode(const rclcpp::NodeOptions & options);
 
   /// \brief Converts CloudX to CloudXYZI
+  /// \details The byte copies that convert a point are computed from the fields of the first
+  /// cloud and reused until a cloud with a different layout arrives. A cloud that is already in
+  /// the CloudXYZI layout is copied as a whole.
+  /// \throws std::runtime_error if x, y, z or intensity are missing or have an unsupported type
   sensor_msgs::msg::PointCloud2::SharedPtr cloud_in_to_cloud_xyzi(
-    const sensor_msgs::msg::PointCloud2::ConstSharedPtr cloud_in) const;
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr cloud_in);
 
 private:
   using PointCloud2 = sensor_msgs::msg::PointCloud2;
   using float32_t = autoware::common::types::float32_t;
   using float64_t = autoware::common::types::float64_t;
+  using bool8_t = autoware::common::types::bool8_t;
 
   using PointXYZI = common::types::PointXYZI;
 
+  /// \brief Contiguous bytes that are copied from every input point into the output point
+  struct CopyBlock
+  {
+    std::size_t src_offset;
+    std::size_t dst_offset;
+    std::size_t size;
+  };
+
+  /// \brief Byte copies that convert a point of one input layout into a PointXYZI
+  struct CopyPlan
+  {
+    // layout of the input cloud that the plan was computed for
+    std::vector<sensor_msgs::msg::PointField> fields;
+    uint32_t point_step;
+    uint8_t is_bigendian;
+    // whether the input is already in the output layout and can be copied as a whole
+    bool8_t is_pass_through;
+    // FLOAT32 fields, merged when they are adjacent in both the input and the output
+    std::vector<CopyBlock> blocks;
+    // a UINT8 intensity is converted separately
+    bool8_t has_uint8_intensity;
+    std::size_t intensity_offset;
+  };
+
+  /// \brief Get the copy plan for the layout of the cloud, computing it if the layout changed
+  const CopyPlan & get_copy_plan(const PointCloud2 & cloud_in);
+
+  /// \brief Compute the copy plan for the layout of the cloud
+  CopyPlan make_copy_plan(const PointCloud2 & cloud_in) const;
+
   rclcpp::Publisher<PointCloud2>::SharedPtr pub_ptr_cloud_output_;
   rclcpp::Subscription<PointCloud2>::SharedPtr sub_ptr_cloud_input_;
+  // fields of an empty CloudXYZI, to detect inputs that are already in the output layout
+  PointCloud2 cloud_xyzi_layout_;
+  bool8_t has_copy_plan_{false};
+  CopyPlan copy_plan_;
 
   /// \brief Callback for input cloud, converts and publishes.
   /// \throws std::exception if it cannot transform.
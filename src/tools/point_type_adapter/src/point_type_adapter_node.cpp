@@ -13,13 +13,15 @@
 // limitations under the License.
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
-#include <sensor_msgs/point_cloud2_iterator.hpp>
 #include <common/types.hpp>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
+#include <cstddef>
+#include <cstring>
 #include <memory>
 #include <algorithm>
 #include <exception>
 #include <string>
+#include <utility>
 #include <vector>
 #include "point_type_adapter/point_type_adapter_node.hpp"
 
@@ -50,11 +52,17 @@ PointTypeAdapterNode::PointTypeAdapterNode(const rclcpp::NodeOptions & options)
       this,
       std::placeholders::_1)))
 {
+  // The modifier fills in the fields of the PointXYZI layout
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> layout_modifier{cloud_xyzi_layout_, ""};
 }
 
 void PointTypeAdapterNode::callback_cloud_input(const PointCloud2::SharedPtr msg_ptr)
 {
   try {
+    if (get_copy_plan(*msg_ptr).is_pass_through) {
+      pub_ptr_cloud_output_->publish(*msg_ptr);
+      return;
+    }
     PointCloud2::SharedPtr cloud_out = cloud_in_to_cloud_xyzi(msg_ptr);
     pub_ptr_cloud_output_->publish(*cloud_out);
   } catch (std::exception & ex) {
@@ -66,73 +74,136 @@ void PointTypeAdapterNode::callback_cloud_input(const PointCloud2::SharedPtr msg
 }
 
 PointCloud2::SharedPtr PointTypeAdapterNode::cloud_in_to_cloud_xyzi(
-  const PointCloud2::ConstSharedPtr cloud_in) const
+  const PointCloud2::ConstSharedPtr cloud_in)
 {
+  const CopyPlan & plan = get_copy_plan(*cloud_in);
+  if (plan.is_pass_through) {
+    return std::make_shared<PointCloud2>(*cloud_in);
+  }
+
   using CloudModifier = point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI>;
   PointCloud2::SharedPtr cloud_out_ptr = std::make_shared<PointCloud2>();
+  CloudModifier cloud_modifier_out(*cloud_out_ptr, cloud_in->header.frame_id);
+  cloud_out_ptr->header = cloud_in->header;
+
+  const std::size_t num_points = cloud_in->data.size() / cloud_in->point_step;
+  cloud_modifier_out.resize(num_points);
+
+  const uint8_t * src = cloud_in->data.data();
+  uint8_t * dst = cloud_out_ptr->data.data();
+  for (std::size_t i = 0U; i < num_points; ++i) {
+    for (const auto & block : plan.blocks) {
+      std::memcpy(dst + block.dst_offset, src + block.src_offset, block.size);
+    }
+    if (plan.has_uint8_intensity) {
+      const auto intensity = static_cast<float32_t>(src[plan.intensity_offset]);
+      std::memcpy(dst + offsetof(PointXYZI, intensity), &intensity, sizeof(intensity));
+    }
+    src += cloud_in->point_step;
+    dst += sizeof(PointXYZI);
+  }
+
+  return cloud_out_ptr;
+}
+
+const PointTypeAdapterNode::CopyPlan & PointTypeAdapterNode::get_copy_plan(
+  const PointCloud2 & cloud_in)
+{
+  if (!has_copy_plan_ ||
+    (cloud_in.point_step != copy_plan_.point_step) ||
+    (cloud_in.is_bigendian != copy_plan_.is_bigendian) ||
+    (cloud_in.fields != copy_plan_.fields))
+  {
+    // Reset first so that a layout that fails to convert is not cached
+    has_copy_plan_ = false;
+    copy_plan_ = make_copy_plan(cloud_in);
+    has_copy_plan_ = true;
+  }
+  return copy_plan_;
+}
 
-  auto fields_contain_field_with_name_and_datatype = [this](
-    const std::vector<sensor_msgs::msg::PointField> & fields,
-    const std::string & name,
-    uint8_t datatype) {
+PointTypeAdapterNode::CopyPlan PointTypeAdapterNode::make_copy_plan(
+  const PointCloud2 & cloud_in) const
+{
+  using sensor_msgs::msg::PointField;
+  CopyPlan plan{cloud_in.fields, cloud_in.point_step, cloud_in.is_bigendian, false, {}, false, 0U};
+  plan.is_pass_through = (cloud_in.fields == cloud_xyzi_layout_.fields) &&
+    (cloud_in.point_step == cloud_xyzi_layout_.point_step) &&
+    (cloud_in.is_bigendian == cloud_xyzi_layout_.is_bigendian);
+  if (plan.is_pass_through) {
+    return plan;
+  }
+
+  auto find_field = [this, &cloud_in](const std::string & name) {
       auto iter_search = std::find_if(
-        fields.cbegin(), fields.cend(), [&name](
-          const sensor_msgs::msg::PointField & field) {
+        cloud_in.fields.cbegin(), cloud_in.fields.cend(), [&name](
+          const PointField & field) {
           return field.name == name;
         });
-      if (iter_search == fields.cend()) {
+      if (iter_search == cloud_in.fields.cend()) {
         // Given field doesn't exist within given point cloud.
         RCLCPP_ERROR(
           this->get_logger(),
           "Field named \"" + name + "\" doesn't exist within given point cloud.");
-        return false;
       }
-      // Given field exists within given point cloud, check its type.
-      return iter_search->datatype == datatype;
+      return iter_search;
+    };
+  auto field_fits_in_point = [&cloud_in](const PointField & field, const std::size_t size) {
+      return (static_cast<std::size_t>(field.offset) + size) <=
+             static_cast<std::size_t>(cloud_in.point_step);
     };
 
-  if (!fields_contain_field_with_name_and_datatype(
-      cloud_in->fields, "x",
-      sensor_msgs::msg::PointField::FLOAT32) ||
-    !fields_contain_field_with_name_and_datatype(
-      cloud_in->fields, "y",
-      sensor_msgs::msg::PointField::FLOAT32) ||
-    !fields_contain_field_with_name_and_datatype(
-      cloud_in->fields, "z",
-      sensor_msgs::msg::PointField::FLOAT32))
-  {
-    throw std::runtime_error("x,y,z fields either don't exist or they are not FLOAT32");
+  const std::vector<std::pair<std::string, std::size_t>> xyz_fields{
+    {"x", offsetof(PointXYZI, x)}, {"y", offsetof(PointXYZI, y)}, {"z", offsetof(PointXYZI, z)}};
+  for (const auto & name_and_offset : xyz_fields) {
+    const auto iter_field = find_field(name_and_offset.first);
+    if ((iter_field == cloud_in.fields.cend()) ||
+      (iter_field->datatype != PointField::FLOAT32) ||
+      !field_fits_in_point(*iter_field, sizeof(float32_t)))
+    {
+      throw std::runtime_error("x,y,z fields either don't exist or they are not FLOAT32");
+    }
+    plan.blocks.push_back(CopyBlock{iter_field->offset, name_and_offset.second, sizeof(float32_t)});
   }
 
-  // Throws if "intensity" field doesn't exist
-  // or the field isn't with uint8_t or float32_t datatypes
-  IntensityIteratorWrapper intensity_iter_wrapper(*cloud_in);
-
-  sensor_msgs::PointCloud2ConstIterator<float32_t> iter_x(*cloud_in, "x");
-  sensor_msgs::PointCloud2ConstIterator<float32_t> iter_y(*cloud_in, "y");
-  sensor_msgs::PointCloud2ConstIterator<float32_t> iter_z(*cloud_in, "z");
-
-
-  CloudModifier cloud_modifier_out(*cloud_out_ptr, cloud_in->header.frame_id);
-  cloud_out_ptr->header = cloud_in->header;
-
-  cloud_modifier_out.reserve(cloud_in->width);
-
-  while (iter_x != iter_x.end() ||
-    iter_y != iter_y.end() ||
-    iter_z != iter_z.end() ||
-    !intensity_iter_wrapper.is_end())
-  {
-    PointXYZI point_xyzi{*iter_x, *iter_y, *iter_z,
-      intensity_iter_wrapper.get_current_value<float32_t>()};
-    cloud_modifier_out.push_back(point_xyzi);
-    iter_x += 1;
-    iter_y += 1;
-    iter_z += 1;
-    intensity_iter_wrapper.increase();
+  const auto iter_intensity = find_field("intensity");
+  if (iter_intensity == cloud_in.fields.cend()) {
+    throw std::runtime_error("Required field \"intensity\" doesn't exit in the point cloud.");
+  }
+  switch (iter_intensity->datatype) {
+    case PointField::UINT8:
+      plan.has_uint8_intensity = true;
+      plan.intensity_offset = iter_intensity->offset;
+      break;
+    case PointField::FLOAT32:
+      plan.blocks.push_back(
+        CopyBlock{iter_intensity->offset, offsetof(PointXYZI, intensity), sizeof(float32_t)});
+      break;
+    default:
+      throw std::runtime_error(
+              "Intensity type not supported: " + std::to_string(iter_intensity->datatype));
+  }
+  const std::size_t intensity_size =
+    plan.has_uint8_intensity ? sizeof(uint8_t) : sizeof(float32_t);
+  if (!field_fits_in_point(*iter_intensity, intensity_size)) {
+    throw std::runtime_error("Field \"intensity\" doesn't fit in the point step");
   }
 
-  return cloud_out_ptr;
+  // Fields that are adjacent in the input as well as in the output are copied together, e.g. x,y,z
+  // of most drivers become a single 12 byte copy
+  std::vector<CopyBlock> merged_blocks;
+  for (const auto & block : plan.blocks) {
+    if (!merged_blocks.empty() &&
+      (merged_blocks.back().src_offset + merged_blocks.back().size == block.src_offset) &&
+      (merged_blocks.back().dst_offset + merged_blocks.back().size == block.dst_offset))
+    {
+      merged_blocks.back().size += block.size;
+    } else {
+      merged_blocks.push_back(block);
+    }
+  }
+  plan.blocks = merged_blocks;
+  return plan;
 }
 
 }  // namespace point_type_adapter
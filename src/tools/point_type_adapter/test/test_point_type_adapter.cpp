@@ -82,3 +82,53 @@ TEST(TestPointTypeAdapter, TestCloudConverter) {
   EXPECT_EQ(cloud_view_xyzi.at(0), point_xyzi_0);
   EXPECT_EQ(cloud_view_xyzi.at(1), point_xyzi_1);
 }
+
+struct PointIXYZ
+{
+  float32_t intensity{0.0F};
+  float32_t x{0.0F};
+  float32_t y{0.0F};
+  float32_t z{0.0F};
+};
+
+TEST(TestPointTypeAdapter, TestCloudLayoutChanges) {
+  using PointXYZI = autoware::common::types::PointXYZI;
+  using sensor_msgs::msg::PointCloud2;
+  PointCloud2::SharedPtr cloud_xyzi_in_ptr = std::make_shared<PointCloud2>();
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointXYZI> cloud_modifier_xyzi(
+    *cloud_xyzi_in_ptr, "frame_original");
+  cloud_modifier_xyzi.push_back(PointXYZI{3.0F, 4.0F, 5.0F, 100.0F});
+  cloud_modifier_xyzi.push_back(PointXYZI{6.0F, 8.0F, 10.0F, 200.0F});
+
+  PointCloud2::SharedPtr cloud_ixyz_ptr = std::make_shared<PointCloud2>();
+  point_cloud_msg_wrapper::PointCloud2Modifier<PointIXYZ> cloud_modifier_ixyz(
+    *cloud_ixyz_ptr, "frame_original");
+  cloud_modifier_ixyz.push_back(PointIXYZ{100.0F, 3.0F, 4.0F, 5.0F});
+  cloud_modifier_ixyz.push_back(PointIXYZ{200.0F, 6.0F, 8.0F, 10.0F});
+
+  PointXYZI point_xyzi_0{3.0F, 4.0F, 5.0F, 100.0F};
+  PointXYZI point_xyzi_1{6.0F, 8.0F, 10.0F, 200.0F};
+
+  rclcpp::init(0, nullptr);
+  rclcpp::NodeOptions node_options;
+  autoware::tools::point_type_adapter::PointTypeAdapterNode point_type_adapter_node(node_options);
+
+  // A cloud in the output layout is passed through unchanged
+  PointCloud2::SharedPtr cloud_xyzi_out_ptr = point_type_adapter_node.cloud_in_to_cloud_xyzi(
+    cloud_xyzi_in_ptr);
+  EXPECT_EQ(cloud_xyzi_out_ptr->header, cloud_xyzi_in_ptr->header);
+  EXPECT_EQ(cloud_xyzi_out_ptr->fields, cloud_xyzi_in_ptr->fields);
+  EXPECT_EQ(cloud_xyzi_out_ptr->data, cloud_xyzi_in_ptr->data);
+
+  // The conversion follows a change of the layout between two clouds
+  PointCloud2::SharedPtr cloud_converted_ptr = point_type_adapter_node.cloud_in_to_cloud_xyzi(
+    cloud_ixyz_ptr);
+  rclcpp::shutdown();
+
+  using CloudViewXyzi = point_cloud_msg_wrapper::PointCloud2View<PointXYZI>;
+  CloudViewXyzi cloud_view_xyzi(*cloud_converted_ptr);
+  EXPECT_EQ(cloud_converted_ptr->width, cloud_ixyz_ptr->width);
+  EXPECT_EQ(cloud_converted_ptr->fields, cloud_xyzi_in_ptr->fields);
+  EXPECT_EQ(cloud_view_xyzi.at(0), point_xyzi_0);
+  EXPECT_EQ(cloud_view_xyzi.at(1), point_xyzi_1);
+}
@@ -33,6 +33,7 @@
 #include "geometry_msgs/msg/twist.hpp"
 #include "geometry_msgs/msg/twist_stamped.hpp"
 #include "geometry_msgs/msg/transform_stamped.hpp"
+#include "rosgraph_msgs/msg/clock.hpp"
 
 #include "autoware_auto_msgs/msg/ackermann_control_command.hpp"
 #include "autoware_auto_msgs/msg/vehicle_kinematic_state.hpp"
@@ -108,6 +109,7 @@ private:
   rclcpp::Publisher<VehicleStateReport>::SharedPtr pub_state_report_;
   rclcpp::Publisher<tf2_msgs::msg::TFMessage>::SharedPtr pub_tf_;
   rclcpp::Publisher<PoseStamped>::SharedPtr pub_current_pose_;
+  rclcpp::Publisher<rosgraph_msgs::msg::Clock>::SharedPtr pub_clock_;
 
   rclcpp::Subscription<VehicleStateCommand>::SharedPtr sub_state_cmd_;
   rclcpp::Subscription<VehicleControlCommand>::SharedPtr sub_vehicle_cmd_;
@@ -117,6 +119,10 @@ private:
   uint32_t timer_sampling_time_ms_;  //!< @brief timer sampling time
   rclcpp::TimerBase::SharedPtr on_timer_;  //!< @brief timer for simulation
 
+  /* lockstep */
+  bool8_t lockstep_;  //!< @brief flag to step on every control command and publish the time
+  rclcpp::Time sim_time_;  //!< @brief simulated time, published on /clock in lockstep mode
+
   /* tf */
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_;
@@ -191,6 +197,23 @@ private:
    */
   void on_timer();
 
+  /**
+   * @brief advance the simulated time by one sampling time and publish it in lockstep mode
+   * @return the sampling time [s]
+   */
+  float64_t advance_sim_time();
+
+  /**
+   * @brief run one simulation step for a received control command in lockstep mode
+   */
+  void step_lockstep();
+
+  /**
+   * @brief get the time for the published messages
+   * @return the simulated time in lockstep mode, the time of the node clock otherwise
+   */
+  rclcpp::Time get_stamp();
+
   /**
    * @brief initialize vehicle_model_ptr
    */
@@ -0,0 +1,442 @@
+// Copyright 2021 The Autoware Foundation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_BATCH_HPP_
+#define SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_BATCH_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "eigen3/Eigen/Core"
+#include "autoware_auto_msgs/msg/vehicle_state_command.hpp"
+#include "common/types.hpp"
+#include "simple_planning_simulator/visibility_control.hpp"
+
+using autoware::common::types::float64_t;
+using autoware::common::types::bool8_t;
+
+/**
+ * @class SimModelBatchInterface
+ * @brief vehicle model class stepping many vehicles with the same parameters at once, e.g. for
+ * Monte Carlo rollouts outside of the simulator node
+ *
+ * The states and inputs are stored as structure of arrays, i.e. with one row per vehicle and one
+ * column per state or input, so that each step runs over contiguous arrays. The dimensions are
+ * fixed at compile time and the model is bound statically, so unlike SimModelInterface a step
+ * neither calls a virtual function nor allocates.
+ * @tparam DerivedT model class providing update(dt) and calcModel(state, input, d_state)
+ * @tparam DimX dimension of state x
+ * @tparam DimU dimension of input u
+ */
+template<typename DerivedT, int DimX, int DimU>
+class SimModelBatchInterface
+{
+public:
+  static constexpr int DIM_X = DimX;  //!< @brief dimension of state x
+  static constexpr int DIM_U = DimU;  //!< @brief dimension of input u
+
+  //!< @brief states of all vehicles, one row per vehicle
+  using State = Eigen::Array<float64_t, Eigen::Dynamic, DimX>;
+  //!< @brief inputs of all vehicles, one row per vehicle
+  using Input = Eigen::Array<float64_t, Eigen::Dynamic, DimU>;
+  using StateVector = Eigen::Matrix<float64_t, DimX, 1>;  //!< @brief state of one vehicle
+  using InputVector = Eigen::Matrix<float64_t, DimU, 1>;  //!< @brief input of one vehicle
+
+  /**
+   * @brief constructor
+   * @param [in] num_vehicles number of vehicles
+   */
+  explicit SimModelBatchInterface(Eigen::Index num_vehicles)
+  : state_(State::Zero(num_vehicles, DimX)),
+    input_(Input::Zero(num_vehicles, DimU)),
+    gear_(static_cast<std::size_t>(num_vehicles),
+      static_cast<uint8_t>(autoware_auto_msgs::msg::VehicleStateCommand::GEAR_DRIVE)),
+    k1_(num_vehicles, DimX),
+    k2_(num_vehicles, DimX),
+    k3_(num_vehicles, DimX),
+    k4_(num_vehicles, DimX),
+    tmp_(num_vehicles, DimX)
+  {
+  }
+
+  /**
+   * @brief get number of vehicles
+   */
+  inline Eigen::Index getNumVehicles() const {return state_.rows();}
+
+  /**
+   * @brief get states of all vehicles
+   */
+  inline const State & getStates() const {return state_;}
+
+  /**
+   * @brief get inputs of all vehicles
+   */
+  inline const Input & getInputs() const {return input_;}
+
+  /**
+   * @brief set states of all vehicles
+   * @param [in] state states with one row per vehicle
+   */
+  inline void setStates(const State & state) {state_ = state;}
+
+  /**
+   * @brief set inputs of all vehicles
+   * @param [in] input inputs with one row per vehicle
+   */
+  inline void setInputs(const Input & input) {input_ = input;}
+
+  /**
+   * @brief get state vector of one vehicle
+   * @param [in] vehicle index of the vehicle
+   */
+  inline StateVector getState(Eigen::Index vehicle) const
+  {
+    return state_.row(vehicle).transpose().matrix();
+  }
+
+  /**
+   * @brief set state vector of one vehicle
+   * @param [in] vehicle index of the vehicle
+   * @param [in] state state vector
+   */
+  inline void setState(Eigen::Index vehicle, const StateVector & state)
+  {
+    state_.row(vehicle) = state.transpose().array();
+  }
+
+  /**
+   * @brief set input vector of one vehicle
+   * @param [in] vehicle index of the vehicle
+   * @param [in] input input vector
+   */
+  inline void setInput(Eigen::Index vehicle, const InputVector & input)
+  {
+    input_.row(vehicle) = input.transpose().array();
+  }
+
+  /**
+   * @brief set gear of one vehicle, only used by geared models
+   * @param [in] vehicle index of the vehicle
+   * @param [in] gear gear command defined in autoware_auto_msgs/VehicleStateCommand
+   */
+  inline void setGear(Eigen::Index vehicle, const uint8_t gear)
+  {
+    gear_[static_cast<std::size_t>(vehicle)] = gear;
+  }
+
+  /**
+   * @brief get vehicle position x
+   * @param [in] vehicle index of the vehicle
+   */
+  inline float64_t getX(Eigen::Index vehicle) const {return state_(vehicle, 0);}
+
+  /**
+   * @brief get vehicle position y
+   * @param [in] vehicle index of the vehicle
+   */
+  inline float64_t getY(Eigen::Index vehicle) const {return state_(vehicle, 1);}
+
+  /**
+   * @brief get vehicle angle yaw
+   * @param [in] vehicle index of the vehicle
+   */
+  inline float64_t getYaw(Eigen::Index vehicle) const {return state_(vehicle, 2);}
+
+protected:
+  State state_;  //!< @brief vehicle states
+  Input input_;  //!< @brief vehicle inputs
+
+  //!< @brief gear commands defined in autoware_auto_msgs/VehicleStateCommand
+  std::vector<uint8_t> gear_;
+
+  /**
+   * @brief update vehicle states with Runge-Kutta methods
+   * @param [in] dt delta time [s]
+   * @param [in] input vehicle inputs
+   */
+  void updateRungeKutta(const float64_t dt, const Input & input)
+  {
+    auto & model = static_cast<DerivedT &>(*this);
+    model.calcModel(state_, input, k1_);
+    tmp_ = state_ + k1_ * 0.5 * dt;
+    model.calcModel(tmp_, input, k2_);
+    tmp_ = state_ + k2_ * 0.5 * dt;
+    model.calcModel(tmp_, input, k3_);
+    tmp_ = state_ + k3_ * dt;
+    model.calcModel(tmp_, input, k4_);
+
+    state_ += 1.0 / 6.0 * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_) * dt;
+  }
+
+  /**
+   * @brief limit the velocities to the direction allowed by the gear of each vehicle
+   * @param [in] vx_idx column of the velocity in the state
+   */
+  void applyGear(const Eigen::Index vx_idx)
+  {
+    using autoware_auto_msgs::msg::VehicleStateCommand;
+    for (Eigen::Index i = 0; i < state_.rows(); ++i) {
+      const auto gear = gear_[static_cast<std::size_t>(i)];
+      float64_t & vx = state_(i, vx_idx);
+      if (gear == VehicleStateCommand::GEAR_DRIVE ||
+        gear == VehicleStateCommand::GEAR_LOW ||
+        gear == VehicleStateCommand::GEAR_NEUTRAL)
+      {
+        vx = std::max(vx, 0.0);
+      } else if (gear == VehicleStateCommand::GEAR_REVERSE) {
+        vx = std::min(vx, 0.0);
+      } else if (gear == VehicleStateCommand::GEAR_PARK) {
+        vx = 0.0;
+      }
+    }
+  }
+
+private:
+  // Preallocated Runge-Kutta stages
+  State k1_;
+  State k2_;
+  State k3_;
+  State k4_;
+  State tmp_;
+};
+
+/**
+ * @class SimModelBatchIdealSteerVel
+ * @brief batched version of SimModelIdealSteerVel
+ */
+class PLANNING_SIMULATOR_PUBLIC SimModelBatchIdealSteerVel
+  : public SimModelBatchInterface<SimModelBatchIdealSteerVel, 3, 2>
+{
+public:
+  enum IDX
+  {
+    X = 0,
+    Y,
+    YAW,
+  };
+  enum IDX_U
+  {
+    VX_DES = 0,
+    STEER_DES,
+  };
+
+  /**
+   * @brief constructor
+   * @param [in] num_vehicles number of vehicles
+   * @param [in] wheelbase vehicle wheelbase length [m]
+   */
+  SimModelBatchIdealSteerVel(Eigen::Index num_vehicles, float64_t wheelbase);
+
+  /**
+   * @brief update the states of all vehicles
+   * @param [in] dt delta time [s]
+   */
+  void update(const float64_t dt);
+
+  float64_t getVx(Eigen::Index vehicle) const;     //!< @brief get vehicle velocity vx
+  float64_t getAx(Eigen::Index vehicle) const;     //!< @brief get vehicle acceleration
+  float64_t getWz(Eigen::Index vehicle) const;     //!< @brief get vehicle angular-velocity wz
+  float64_t getSteer(Eigen::Index vehicle) const;  //!< @brief get vehicle steering angle
+
+private:
+  friend class SimModelBatchInterface<SimModelBatchIdealSteerVel, 3, 2>;
+
+  const float64_t wheelbase_;  //!< @brief vehicle wheelbase length [m]
+  Eigen::ArrayXd prev_vx_;     //!< @brief previous velocity command of each vehicle
+  Eigen::ArrayXd current_ax_;  //!< @brief acceleration derived from the velocity commands
+
+  /**
+   * @brief calculate derivative of states with ideal steering and velocity
+   * @param [in] state current model states
+   * @param [in] input inputs to model
+   * @param [out] d_state derivative of the states
+   */
+  void calcModel(const State & state, const Input & input, State & d_state) const;
+};
+
+/**
+ * @class SimModelBatchIdealSteerAcc
+ * @brief batched version of SimModelIdealSteerAcc and SimModelIdealSteerAccGeared
+ */
+class PLANNING_SIMULATOR_PUBLIC SimModelBatchIdealSteerAcc
+  : public SimModelBatchInterface<SimModelBatchIdealSteerAcc, 4, 2>
+{
+public:
+  enum IDX
+  {
+    X = 0,
+    Y,
+    YAW,
+    VX,
+  };
+  enum IDX_U
+  {
+    AX_DES = 0,
+    STEER_DES,
+  };
+
+  /**
+   * @brief constructor
+   * @param [in] num_vehicles number of vehicles
+   * @param [in] wheelbase vehicle wheelbase length [m]
+   * @param [in] geared whether the velocity follows the gear, as in SimModelIdealSteerAccGeared
+   */
+  SimModelBatchIdealSteerAcc(Eigen::Index num_vehicles, float64_t wheelbase, bool8_t geared);
+
+  /**
+   * @brief update the states of all vehicles
+   * @param [in] dt delta time [s]
+   */
+  void update(const float64_t dt);
+
+  float64_t getVx(Eigen::Index vehicle) const;     //!< @brief get vehicle velocity vx
+  float64_t getAx(Eigen::Index vehicle) const;     //!< @brief get vehicle acceleration
+  float64_t getWz(Eigen::Index vehicle) const;     //!< @brief get vehicle angular-velocity wz
+  float64_t getSteer(Eigen::Index vehicle) const;  //!< @brief get vehicle steering angle
+
+private:
+  friend class SimModelBatchInterface<SimModelBatchIdealSteerAcc, 4, 2>;
+
+  const float64_t wheelbase_;  //!< @brief vehicle wheelbase length [m]
+  const bool8_t geared_;       //!< @brief whether the velocity follows the gear
+  Eigen::ArrayXd prev_vx_;     //!< @brief velocity of each vehicle before the last update
+  Eigen::ArrayXd current_ax_;  //!< @brief acceleration of the last update with gear
+
+  /**
+   * @brief calculate derivative of states with ideal steering and acceleration
+   * @param [in] state current model states
+   * @param [in] input inputs to model
+   * @param [out] d_state derivative of the states
+   */
+  void calcModel(const State & state, const Input & input, State & d_state) const;
+};
+
+/**
+ * @class SimModelBatchDelaySteerAcc
+ * @brief batched version of SimModelDelaySteerAcc and SimModelDelaySteerAccGeared
+ */
+class PLANNING_SIMULATOR_PUBLIC SimModelBatchDelaySteerAcc
+  : public SimModelBatchInterface<SimModelBatchDelaySteerAcc, 6, 2>
+{
+public:
+  enum IDX
+  {
+    X = 0,
+    Y,
+    YAW,
+    VX,
+    STEER,
+    ACCX,
+  };
+  enum IDX_U
+  {
+    ACCX_DES = 0,
+    STEER_DES,
+  };
+
+  /**
+   * @brief constructor
+   * @param [in] num_vehicles number of vehicles
+   * @param [in] vx_lim velocity limit [m/s]
+   * @param [in] steer_lim steering limit [rad]
+   * @param [in] vx_rate_lim acceleration limit [m/ss]
+   * @param [in] steer_rate_lim steering angular velocity limit [rad/ss]
+   * @param [in] wheelbase vehicle wheelbase length [m]
+   * @param [in] dt delta time information to set input buffer for delay
+   * @param [in] acc_delay time delay for accel command [s]
+   * @param [in] acc_time_constant time constant for 1D model of accel dynamics
+   * @param [in] steer_delay time delay for steering command [s]
+   * @param [in] steer_time_constant time constant for 1D model of steering dynamics
+   * @param [in] geared whether the velocity follows the gear, as in SimModelDelaySteerAccGeared
+   */
+  SimModelBatchDelaySteerAcc(
+    Eigen::Index num_vehicles, float64_t vx_lim, float64_t steer_lim, float64_t vx_rate_lim,
+    float64_t steer_rate_lim, float64_t wheelbase, float64_t dt, float64_t acc_delay,
+    float64_t acc_time_constant, float64_t steer_delay, float64_t steer_time_constant,
+    bool8_t geared);
+
+  /**
+   * @brief update the states of all vehicles
+   * @param [in] dt delta time [s]
+   */
+  void update(const float64_t dt);
+
+  float64_t getVx(Eigen::Index vehicle) const;     //!< @brief get vehicle velocity vx
+  float64_t getAx(Eigen::Index vehicle) const;     //!< @brief get vehicle acceleration
+  float64_t getWz(Eigen::Index vehicle) const;     //!< @brief get vehicle angular-velocity wz
+  float64_t getSteer(Eigen::Index vehicle) const;  //!< @brief get vehicle steering angle
+
+private:
+  friend class SimModelBatchInterface<SimModelBatchDelaySteerAcc, 6, 2>;
+
+  /**
+   * @brief input commands of all vehicles delayed by a fixed number of steps, kept in a ring
+   * buffer with one row per vehicle
+   */
+  class InputDelay
+  {
+public:
+    InputDelay(Eigen::Index num_vehicles, Eigen::Index num_steps);
+
+    /**
+     * @brief store the current commands and get the ones of num_steps before
+     * @param [in] input current commands
+     * @param [out] delayed delayed commands
+     */
+    template<typename InputT, typename DelayedT>
+    void update(const InputT & input, DelayedT && delayed)
+    {
+      if (queue_.cols() == 0) {
+        delayed = input;
+        return;
+      }
+      delayed = queue_.col(head_);
+      queue_.col(head_) = input;
+      head_ = (head_ + 1) % queue_.cols();
+    }
+
+private:
+    Eigen::ArrayXXd queue_;
+    Eigen::Index head_{0};
+  };
+
+  const float64_t MIN_TIME_CONSTANT;  //!< @brief minimum time constant
+
+  const float64_t vx_lim_;          //!< @brief velocity limit [m/s]
+  const float64_t vx_rate_lim_;     //!< @brief acceleration limit [m/ss]
+  const float64_t steer_lim_;       //!< @brief steering limit [rad]
+  const float64_t steer_rate_lim_;  //!< @brief steering angular velocity limit [rad/s]
+  const float64_t wheelbase_;       //!< @brief vehicle wheelbase length [m]
+
+  const float64_t acc_time_constant_;    //!< @brief time constant for accel dynamics
+  const float64_t steer_time_constant_;  //!< @brief time constant for steering dynamics
+  const bool8_t geared_;                 //!< @brief whether the velocity follows the gear
+
+  InputDelay acc_input_delay_;    //!< @brief buffer for accel command
+  InputDelay steer_input_delay_;  //!< @brief buffer for steering command
+  Input delayed_input_;           //!< @brief delayed inputs of the current update
+  Eigen::ArrayXd prev_vx_;        //!< @brief velocity of each vehicle before the last update
+
+  /**
+   * @brief calculate derivative of states with time delay steering model
+   * @param [in] state current model states
+   * @param [in] input inputs to model
+   * @param [out] d_state derivative of the states
+   */
+  void calcModel(const State & state, const Input & input, State & d_state) const;
+};
+
+#endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_BATCH_HPP_
@@ -35,6 +35,12 @@ def generate_launch_description():
         description='Path to config file for vehicle characteristics'
     )
 
+    lockstep_param = DeclareLaunchArgument(
+        'lockstep',
+        default_value='False',
+        description='Step the simulation on every control command and publish /clock'
+    )
+
     simple_planning_simulator_node = launch_ros.actions.Node(
         package='simple_planning_simulator',
         executable='simple_planning_simulator_exe',
@@ -48,6 +54,7 @@ def generate_launch_description():
                 )
             ),
             LaunchConfiguration('vehicle_characteristics_param_file'),
+            {'lockstep': LaunchConfiguration('lockstep')},
         ],
         remappings=[
             ('input/vehicle_control_command', '/vehicle/vehicle_command'),
@@ -68,6 +75,7 @@ def generate_launch_description():
 
     ld = launch.LaunchDescription([
         vehicle_characteristics_param,
+        lockstep_param,
         simple_planning_simulator_node,
         map_to_odom_tf_publisher
     ])
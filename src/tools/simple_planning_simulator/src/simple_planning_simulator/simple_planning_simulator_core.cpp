@@ -105,8 +105,17 @@ SimplePlanningSimulator::SimplePlanningSimulator(const rclcpp::NodeOptions & opt
   pub_tf_ = create_publisher<tf2_msgs::msg::TFMessage>("/tf", QoS{1});
 
   timer_sampling_time_ms_ = static_cast<uint32_t>(declare_parameter("timer_sampling_time_ms", 25));
+  // In lockstep mode the simulation steps for every control command, and the wall timer only
+  // keeps the simulation going when no command arrives within lockstep_timeout_ms
+  lockstep_ = declare_parameter("lockstep", false);
+  const auto lockstep_timeout_ms =
+    static_cast<uint32_t>(declare_parameter("lockstep_timeout_ms", 100));
+  sim_time_ = rclcpp::Time{0, 0U, RCL_ROS_TIME};
+  if (lockstep_) {
+    pub_clock_ = create_publisher<rosgraph_msgs::msg::Clock>("/clock", QoS{1});
+  }
   on_timer_ = create_wall_timer(
-    std::chrono::milliseconds(timer_sampling_time_ms_),
+    std::chrono::milliseconds(lockstep_ ? lockstep_timeout_ms : timer_sampling_time_ms_),
     std::bind(&SimplePlanningSimulator::on_timer, this));
 
 
@@ -195,7 +204,7 @@ void SimplePlanningSimulator::on_timer()
 
   // update vehicle dynamics
   {
-    const float64_t dt = delta_time_.get_dt(get_clock()->now());
+    const float64_t dt = lockstep_ ? advance_sim_time() : delta_time_.get_dt(get_clock()->now());
     vehicle_model_ptr_->update(dt);
   }
 
@@ -212,6 +221,29 @@ void SimplePlanningSimulator::on_timer()
   publish_tf(current_kinematic_state_);
 }
 
+float64_t SimplePlanningSimulator::advance_sim_time()
+{
+  const auto sampling_time = std::chrono::milliseconds(timer_sampling_time_ms_);
+  sim_time_ = sim_time_ + rclcpp::Duration{sampling_time};
+
+  rosgraph_msgs::msg::Clock msg;
+  msg.clock = sim_time_;
+  pub_clock_->publish(msg);
+  return static_cast<float64_t>(timer_sampling_time_ms_) / 1000.0;
+}
+
+void SimplePlanningSimulator::step_lockstep()
+{
+  on_timer();
+  // the next step is triggered by the next command, or by the timer if that does not arrive
+  on_timer_->reset();
+}
+
+rclcpp::Time SimplePlanningSimulator::get_stamp()
+{
+  return lockstep_ ? sim_time_ : get_clock()->now();
+}
+
 void SimplePlanningSimulator::on_initialpose(
   const geometry_msgs::msg::PoseWithCovarianceStamped::ConstSharedPtr msg)
 {
@@ -228,6 +260,9 @@ void SimplePlanningSimulator::on_vehicle_cmd(
 {
   current_vehicle_cmd_ptr_ = msg;
   set_input(msg->front_wheel_angle_rad, msg->velocity_mps, msg->long_accel_mps2);
+  if (lockstep_) {
+    step_lockstep();
+  }
 }
 
 void SimplePlanningSimulator::on_ackermann_cmd(
@@ -237,6 +272,9 @@ void SimplePlanningSimulator::on_ackermann_cmd(
   set_input(
     msg->lateral.steering_tire_angle, msg->longitudinal.speed,
     msg->longitudinal.acceleration);
+  if (lockstep_) {
+    step_lockstep();
+  }
 }
 
 void SimplePlanningSimulator::set_input(const float steer, const float vel, const float accel)
@@ -351,7 +389,7 @@ void SimplePlanningSimulator::publish_kinematic_state(
 {
   VehicleKinematicState msg = state;
   msg.header.frame_id = origin_frame_id_;
-  msg.header.stamp = get_clock()->now();
+  msg.header.stamp = get_stamp();
 
   pub_kinematic_state_->publish(msg);
 }
@@ -359,7 +397,7 @@ void SimplePlanningSimulator::publish_kinematic_state(
 void SimplePlanningSimulator::publish_state_report()
 {
   VehicleStateReport msg;
-  msg.stamp = get_clock()->now();
+  msg.stamp = get_stamp();
   msg.mode = VehicleStateReport::MODE_AUTONOMOUS;
   if (current_vehicle_state_cmd_ptr_) {
     msg.gear = current_vehicle_state_cmd_ptr_->gear;
@@ -370,7 +408,7 @@ void SimplePlanningSimulator::publish_state_report()
 void SimplePlanningSimulator::publish_tf(const VehicleKinematicState & state)
 {
   geometry_msgs::msg::TransformStamped tf;
-  tf.header.stamp = get_clock()->now();
+  tf.header.stamp = get_stamp();
   tf.header.frame_id = origin_frame_id_;
   tf.child_frame_id = simulated_frame_id_;
   tf.transform.translation.x = state.state.x;
@@ -0,0 +1,195 @@
+// Copyright 2021 The Autoware Foundation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "simple_planning_simulator/vehicle_model/sim_model_batch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+SimModelBatchIdealSteerVel::SimModelBatchIdealSteerVel(
+  Eigen::Index num_vehicles, float64_t wheelbase)
+: SimModelBatchInterface(num_vehicles),
+  wheelbase_(wheelbase),
+  prev_vx_(Eigen::ArrayXd::Zero(num_vehicles)),
+  current_ax_(Eigen::ArrayXd::Zero(num_vehicles)) {}
+
+float64_t SimModelBatchIdealSteerVel::getVx(Eigen::Index vehicle) const
+{
+  return input_(vehicle, IDX_U::VX_DES);
+}
+float64_t SimModelBatchIdealSteerVel::getAx(Eigen::Index vehicle) const
+{
+  return current_ax_(vehicle);
+}
+float64_t SimModelBatchIdealSteerVel::getWz(Eigen::Index vehicle) const
+{
+  return input_(vehicle, IDX_U::VX_DES) * std::tan(input_(vehicle, IDX_U::STEER_DES)) /
+         wheelbase_;
+}
+float64_t SimModelBatchIdealSteerVel::getSteer(Eigen::Index vehicle) const
+{
+  return input_(vehicle, IDX_U::STEER_DES);
+}
+void SimModelBatchIdealSteerVel::update(const float64_t dt)
+{
+  updateRungeKutta(dt, input_);
+  current_ax_ = (input_.col(IDX_U::VX_DES) - prev_vx_) / dt;
+  prev_vx_ = input_.col(IDX_U::VX_DES);
+}
+
+void SimModelBatchIdealSteerVel::calcModel(
+  const State & state, const Input & input, State & d_state) const
+{
+  const auto yaw = state.col(IDX::YAW);
+  const auto vx = input.col(IDX_U::VX_DES);
+  const auto steer = input.col(IDX_U::STEER_DES);
+
+  d_state.col(IDX::X) = vx * yaw.cos();
+  d_state.col(IDX::Y) = vx * yaw.sin();
+  d_state.col(IDX::YAW) = vx * steer.tan() / wheelbase_;
+}
+
+SimModelBatchIdealSteerAcc::SimModelBatchIdealSteerAcc(
+  Eigen::Index num_vehicles, float64_t wheelbase, bool8_t geared)
+: SimModelBatchInterface(num_vehicles),
+  wheelbase_(wheelbase),
+  geared_(geared),
+  prev_vx_(Eigen::ArrayXd::Zero(num_vehicles)),
+  current_ax_(Eigen::ArrayXd::Zero(num_vehicles)) {}
+
+float64_t SimModelBatchIdealSteerAcc::getVx(Eigen::Index vehicle) const
+{
+  return state_(vehicle, IDX::VX);
+}
+float64_t SimModelBatchIdealSteerAcc::getAx(Eigen::Index vehicle) const
+{
+  return geared_ ? current_ax_(vehicle) : input_(vehicle, IDX_U::AX_DES);
+}
+float64_t SimModelBatchIdealSteerAcc::getWz(Eigen::Index vehicle) const
+{
+  return state_(vehicle, IDX::VX) * std::tan(input_(vehicle, IDX_U::STEER_DES)) / wheelbase_;
+}
+float64_t SimModelBatchIdealSteerAcc::getSteer(Eigen::Index vehicle) const
+{
+  return input_(vehicle, IDX_U::STEER_DES);
+}
+void SimModelBatchIdealSteerAcc::update(const float64_t dt)
+{
+  if (!geared_) {
+    updateRungeKutta(dt, input_);
+    return;
+  }
+
+  prev_vx_ = state_.col(IDX::VX);
+
+  updateRungeKutta(dt, input_);
+
+  applyGear(IDX::VX);
+
+  current_ax_ = (state_.col(IDX::VX) - prev_vx_) / std::max(dt, 1.0e-5);
+}
+
+void SimModelBatchIdealSteerAcc::calcModel(
+  const State & state, const Input & input, State & d_state) const
+{
+  const auto vx = state.col(IDX::VX);
+  const auto yaw = state.col(IDX::YAW);
+  const auto ax = input.col(IDX_U::AX_DES);
+  const auto steer = input.col(IDX_U::STEER_DES);
+
+  d_state.col(IDX::X) = vx * yaw.cos();
+  d_state.col(IDX::Y) = vx * yaw.sin();
+  d_state.col(IDX::VX) = ax;
+  d_state.col(IDX::YAW) = vx * steer.tan() / wheelbase_;
+}
+
+SimModelBatchDelaySteerAcc::InputDelay::InputDelay(
+  Eigen::Index num_vehicles, Eigen::Index num_steps)
+: queue_(Eigen::ArrayXXd::Zero(num_vehicles, num_steps)) {}
+
+SimModelBatchDelaySteerAcc::SimModelBatchDelaySteerAcc(
+  Eigen::Index num_vehicles, float64_t vx_lim, float64_t steer_lim, float64_t vx_rate_lim,
+  float64_t steer_rate_lim, float64_t wheelbase, float64_t dt, float64_t acc_delay,
+  float64_t acc_time_constant, float64_t steer_delay, float64_t steer_time_constant,
+  bool8_t geared)
+: SimModelBatchInterface(num_vehicles),
+  MIN_TIME_CONSTANT(0.03),
+  vx_lim_(vx_lim),
+  vx_rate_lim_(vx_rate_lim),
+  steer_lim_(steer_lim),
+  steer_rate_lim_(steer_rate_lim),
+  wheelbase_(wheelbase),
+  acc_time_constant_(std::max(acc_time_constant, MIN_TIME_CONSTANT)),
+  steer_time_constant_(std::max(steer_time_constant, MIN_TIME_CONSTANT)),
+  geared_(geared),
+  acc_input_delay_(num_vehicles, static_cast<Eigen::Index>(std::round(acc_delay / dt))),
+  steer_input_delay_(num_vehicles, static_cast<Eigen::Index>(std::round(steer_delay / dt))),
+  delayed_input_(Input::Zero(num_vehicles, DIM_U)),
+  prev_vx_(Eigen::ArrayXd::Zero(num_vehicles)) {}
+
+float64_t SimModelBatchDelaySteerAcc::getVx(Eigen::Index vehicle) const
+{
+  return state_(vehicle, IDX::VX);
+}
+float64_t SimModelBatchDelaySteerAcc::getAx(Eigen::Index vehicle) const
+{
+  return state_(vehicle, IDX::ACCX);
+}
+float64_t SimModelBatchDelaySteerAcc::getWz(Eigen::Index vehicle) const
+{
+  return state_(vehicle, IDX::VX) * std::tan(state_(vehicle, IDX::STEER)) / wheelbase_;
+}
+float64_t SimModelBatchDelaySteerAcc::getSteer(Eigen::Index vehicle) const
+{
+  return state_(vehicle, IDX::STEER);
+}
+void SimModelBatchDelaySteerAcc::update(const float64_t dt)
+{
+  acc_input_delay_.update(input_.col(IDX_U::ACCX_DES), delayed_input_.col(IDX_U::ACCX_DES));
+  steer_input_delay_.update(input_.col(IDX_U::STEER_DES), delayed_input_.col(IDX_U::STEER_DES));
+
+  prev_vx_ = state_.col(IDX::VX);
+
+  updateRungeKutta(dt, delayed_input_);
+
+  // take velocity limit explicitly
+  state_.col(IDX::VX) = state_.col(IDX::VX).min(vx_lim_).max(-vx_lim_);
+
+  if (geared_) {
+    applyGear(IDX::VX);
+
+    // calc acc directly after gear considerataion
+    state_.col(IDX::ACCX) = (state_.col(IDX::VX) - prev_vx_) / std::max(dt, 1.0e-5);
+  }
+}
+
+void SimModelBatchDelaySteerAcc::calcModel(
+  const State & state, const Input & input, State & d_state) const
+{
+  const auto vel = state.col(IDX::VX).min(vx_lim_).max(-vx_lim_);
+  const auto acc = state.col(IDX::ACCX).min(vx_rate_lim_).max(-vx_rate_lim_);
+  const auto yaw = state.col(IDX::YAW);
+  const auto steer = state.col(IDX::STEER);
+  const auto acc_des = input.col(IDX_U::ACCX_DES).min(vx_rate_lim_).max(-vx_rate_lim_);
+  const auto steer_des = input.col(IDX_U::STEER_DES).min(steer_lim_).max(-steer_lim_);
+  const auto steer_rate = (-(steer - steer_des) / steer_time_constant_)
+    .min(steer_rate_lim_).max(-steer_rate_lim_);
+
+  d_state.col(IDX::X) = vel * yaw.cos();
+  d_state.col(IDX::Y) = vel * yaw.sin();
+  d_state.col(IDX::YAW) = vel * steer.tan() / wheelbase_;
+  d_state.col(IDX::VX) = acc;
+  d_state.col(IDX::STEER) = steer_rate;
+  d_state.col(IDX::ACCX) = -(acc - acc_des) / acc_time_constant_;
+}
@@ -16,6 +16,7 @@
 #include "gtest/gtest.h"
 
 #include "simple_planning_simulator/simple_planning_simulator_core.hpp"
+#include "simple_planning_simulator/vehicle_model/sim_model.hpp"
 #include "motion_common/motion_common.hpp"
 
 using autoware_auto_msgs::msg::AckermannControlCommand;
@@ -383,3 +384,141 @@ TEST(test_simple_planning_simulator, test_moving_ackermann)
 
   rclcpp::shutdown();
 }
+
+// In lockstep mode, every control command advances the published time by one sampling time.
+TEST(test_simple_planning_simulator, test_lockstep)
+{
+  rclcpp::init(0, nullptr);
+
+  rclcpp::NodeOptions node_options;
+  node_options.append_parameter_override("initialize_source", "ORIGIN");
+  node_options.append_parameter_override("vehicle_model_type", "IDEAL_STEER_VEL");
+  node_options.append_parameter_override("timer_sampling_time_ms", 25);
+  node_options.append_parameter_override("lockstep", true);
+  // long enough that only the commands step the simulation
+  node_options.append_parameter_override("lockstep_timeout_ms", 60000);
+  const auto sim_node = std::make_shared<SimplePlanningSimulator>(node_options);
+
+  const auto pub_sub_node = std::make_shared<PubSubNode>();
+  size_t num_clocks = 0U;
+  rclcpp::Time last_clock{0, 0U, RCL_ROS_TIME};
+  const auto clock_sub = pub_sub_node->create_subscription<rosgraph_msgs::msg::Clock>(
+    "/clock", rclcpp::QoS{100},
+    [&num_clocks, &last_clock](const rosgraph_msgs::msg::Clock::SharedPtr msg) {
+      ++num_clocks;
+      last_clock = rclcpp::Time{msg->clock, RCL_ROS_TIME};
+    });
+
+  for (int i = 0; i < 20; ++i) {
+    pub_sub_node->pub_control_command_->publish(cmdGen(sim_node->now(), 0.0f, 5.0f, 0.0f));
+    std::this_thread::sleep_for(std::chrono::milliseconds{10LL});
+    rclcpp::spin_some(sim_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds{10LL});
+    rclcpp::spin_some(pub_sub_node);
+  }
+
+  ASSERT_GT(num_clocks, 0U);
+  ASSERT_NE(pub_sub_node->current_state_, nullptr);
+  const auto step = std::chrono::milliseconds{25LL};
+  EXPECT_EQ(
+    last_clock.nanoseconds(),
+    static_cast<int64_t>(num_clocks) * std::chrono::nanoseconds{step}.count());
+  EXPECT_EQ(
+    rclcpp::Time(pub_sub_node->current_state_->header.stamp, RCL_ROS_TIME).nanoseconds(),
+    last_clock.nanoseconds());
+  EXPECT_GT(pub_sub_node->current_state_->state.x, COM_TO_BASELINK);
+
+  rclcpp::shutdown();
+}
+
+/**
+ * @brief Step a batch of vehicles and one single vehicle model per vehicle with the same inputs,
+ * and expect the same states
+ * @param [in] batch batched vehicle model
+ * @param [in] make_model factory of the equivalent single vehicle model
+ */
+template<typename BatchT, typename FactoryT>
+void expectSameAsSingleModels(BatchT & batch, const FactoryT & make_model)
+{
+  constexpr float64_t dt = 0.025;
+  constexpr float64_t TOL = 1.0e-9;
+  const std::vector<uint8_t> gears = {
+    VehicleStateCommand::GEAR_DRIVE, VehicleStateCommand::GEAR_REVERSE,
+    VehicleStateCommand::GEAR_PARK, VehicleStateCommand::GEAR_DRIVE};
+  ASSERT_EQ(batch.getNumVehicles(), static_cast<Eigen::Index>(gears.size()));
+
+  std::vector<std::shared_ptr<SimModelInterface>> models;
+  for (Eigen::Index i = 0; i < batch.getNumVehicles(); ++i) {
+    models.push_back(make_model());
+    Eigen::VectorXd state = Eigen::VectorXd::Zero(BatchT::DIM_X);
+    state(2) = 0.3 * static_cast<float64_t>(i);
+    models.back()->setState(state);
+    models.back()->setGear(gears[static_cast<size_t>(i)]);
+    batch.setState(i, state);
+    batch.setGear(i, gears[static_cast<size_t>(i)]);
+  }
+
+  for (int step = 0; step < 200; ++step) {
+    for (Eigen::Index i = 0; i < batch.getNumVehicles(); ++i) {
+      // a different input for every vehicle and step, beyond the limits of the delay models
+      const auto t = static_cast<float64_t>(step) * dt + static_cast<float64_t>(i);
+      typename BatchT::InputVector input;
+      input << 3.0 * std::sin(t) - static_cast<float64_t>(i), 0.8 * std::cos(2.0 * t);
+      batch.setInput(i, input);
+      models[static_cast<size_t>(i)]->setInput(input);
+      models[static_cast<size_t>(i)]->update(dt);
+    }
+    batch.update(dt);
+
+    for (Eigen::Index i = 0; i < batch.getNumVehicles(); ++i) {
+      const auto & model = models[static_cast<size_t>(i)];
+      EXPECT_NEAR(batch.getX(i), model->getX(), TOL) << "vehicle " << i << ", step " << step;
+      EXPECT_NEAR(batch.getY(i), model->getY(), TOL) << "vehicle " << i << ", step " << step;
+      EXPECT_NEAR(batch.getYaw(i), model->getYaw(), TOL) << "vehicle " << i << ", step " << step;
+      EXPECT_NEAR(batch.getVx(i), model->getVx(), TOL) << "vehicle " << i << ", step " << step;
+      EXPECT_NEAR(batch.getAx(i), model->getAx(), TOL) << "vehicle " << i << ", step " << step;
+      EXPECT_NEAR(batch.getWz(i), model->getWz(), TOL) << "vehicle " << i << ", step " << step;
+      EXPECT_NEAR(batch.getSteer(i), model->getSteer(), TOL) << "vehicle " << i << ", step " <<
+        step;
+    }
+  }
+}
+
+// The batched vehicle models step like one single vehicle model per vehicle.
+TEST(test_simple_planning_simulator, test_batched_models)
+{
+  const Eigen::Index num_vehicles = 4;
+  const float64_t wheelbase = 2.8;
+  const float64_t dt = 0.025;
+  {
+    SCOPED_TRACE("IDEAL_STEER_VEL");
+    SimModelBatchIdealSteerVel batch{num_vehicles, wheelbase};
+    expectSameAsSingleModels(
+      batch, [wheelbase] {return std::make_shared<SimModelIdealSteerVel>(wheelbase);});
+  }
+  for (const bool8_t geared : {false, true}) {
+    SCOPED_TRACE(geared ? "IDEAL_STEER_ACC_GEARED" : "IDEAL_STEER_ACC");
+    SimModelBatchIdealSteerAcc batch{num_vehicles, wheelbase, geared};
+    expectSameAsSingleModels(
+      batch, [geared, wheelbase]() -> std::shared_ptr<SimModelInterface> {
+        if (geared) {
+          return std::make_shared<SimModelIdealSteerAccGeared>(wheelbase);
+        }
+        return std::make_shared<SimModelIdealSteerAcc>(wheelbase);
+      });
+  }
+  for (const bool8_t geared : {false, true}) {
+    SCOPED_TRACE(geared ? "DELAY_STEER_ACC_GEARED" : "DELAY_STEER_ACC");
+    SimModelBatchDelaySteerAcc batch{num_vehicles, 10.0, 0.6, 2.0, 3.0, wheelbase, dt, 0.1,
+      0.1, 0.25, 0.27, geared};
+    expectSameAsSingleModels(
+      batch, [geared, wheelbase, dt]() -> std::shared_ptr<SimModelInterface> {
+        if (geared) {
+          return std::make_shared<SimModelDelaySteerAccGeared>(
+            10.0, 0.6, 2.0, 3.0, wheelbase, dt, 0.1, 0.1, 0.25, 0.27);
+        }
+        return std::make_shared<SimModelDelaySteerAcc>(
+          10.0, 0.6, 2.0, 3.0, wheelbase, dt, 0.1, 0.1, 0.25, 0.27);
+      });
+  }
+}